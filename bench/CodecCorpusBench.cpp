@@ -0,0 +1,212 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/CodecCorpusBench.h"
+
+#include "include/codec/SkAndroidCodec.h"
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkEncodedImageFormat.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkMallocStats.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+SkImageInfo output_info(const SkImageInfo& encodedInfo, SkISize dimensions) {
+    // Decode to N32 without color space conversion, like CodecBench and AndroidCodecBench.
+    SkImageInfo info = encodedInfo.makeDimensions(dimensions)
+                                  .makeColorType(kN32_SkColorType)
+                                  .makeColorSpace(nullptr);
+    if (kUnpremul_SkAlphaType == info.alphaType()) {
+        info = info.makeAlphaType(kPremul_SkAlphaType);
+    }
+    return info;
+}
+
+bool decoded(SkCodec::Result result) {
+    return result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput;
+}
+
+}  // namespace
+
+const char* CodecCorpusBench::FormatName(SkEncodedImageFormat format) {
+    switch (format) {
+        case SkEncodedImageFormat::kBMP:    return "bmp";
+        case SkEncodedImageFormat::kGIF:    return "gif";
+        case SkEncodedImageFormat::kICO:    return "ico";
+        case SkEncodedImageFormat::kJPEG:   return "jpeg";
+        case SkEncodedImageFormat::kPNG:    return "png";
+        case SkEncodedImageFormat::kWBMP:   return "wbmp";
+        case SkEncodedImageFormat::kWEBP:   return "webp";
+        case SkEncodedImageFormat::kPKM:    return "pkm";
+        case SkEncodedImageFormat::kKTX:    return "ktx";
+        case SkEncodedImageFormat::kASTC:   return "astc";
+        case SkEncodedImageFormat::kDNG:    return "dng";
+        case SkEncodedImageFormat::kHEIF:   return "heif";
+        case SkEncodedImageFormat::kAVIF:   return "avif";
+        case SkEncodedImageFormat::kJPEGXL: return "jpegxl";
+    }
+    SkUNREACHABLE;
+}
+
+CodecCorpusBench* CodecCorpusBench::Make(const SkString& baseName, sk_sp<SkData> encoded,
+                                         Mode mode, int sampleSize) {
+    std::unique_ptr<SkAndroidCodec> codec = SkAndroidCodec::MakeFromData(encoded);
+    if (!codec) {
+        return nullptr;
+    }
+    const SkImageInfo& encodedInfo = codec->getInfo();
+
+    SkImageInfo info;
+    SkIRect subset = SkIRect::MakeEmpty();
+    switch (mode) {
+        case Mode::kFull:
+            info = output_info(encodedInfo, encodedInfo.dimensions());
+            break;
+        case Mode::kScanline:
+            if (codec->codec()->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+                return nullptr;
+            }
+            info = output_info(encodedInfo, encodedInfo.dimensions());
+            break;
+        case Mode::kSubset:
+            subset = SkIRect::MakeXYWH(encodedInfo.width() / 4, encodedInfo.height() / 4,
+                                       encodedInfo.width() / 2, encodedInfo.height() / 2);
+            if (subset.isEmpty() || !codec->getSupportedSubset(&subset)) {
+                return nullptr;
+            }
+            info = output_info(encodedInfo, subset.size());
+            break;
+        case Mode::kSampled:
+            if (10 * sampleSize > std::min(encodedInfo.width(), encodedInfo.height())) {
+                // Like AndroidCodecBench, don't bother with sampled decodes of small images.
+                return nullptr;
+            }
+            info = output_info(encodedInfo, codec->getSampledDimensions(sampleSize));
+            break;
+    }
+
+    std::unique_ptr<CodecCorpusBench> bench(new CodecCorpusBench(
+            baseName, std::move(encoded), codec->getEncodedFormat(), mode, sampleSize, info,
+            subset));
+    // Make sure this mode works for this image before we try to time it.
+    bench->fPixelStorage.reset(info.computeMinByteSize());
+    if (!bench->decode()) {
+        return nullptr;
+    }
+    bench->fPixelStorage.reset(0);
+    return bench.release();
+}
+
+CodecCorpusBench::CodecCorpusBench(const SkString& baseName, sk_sp<SkData> encoded,
+                                   SkEncodedImageFormat format, Mode mode, int sampleSize,
+                                   const SkImageInfo& info, const SkIRect& subset)
+        : fData(std::move(encoded))
+        , fMode(mode)
+        , fSampleSize(sampleSize)
+        , fFormatName(FormatName(format))
+        , fInfo(info)
+        , fSubset(subset) {
+    switch (mode) {
+        case Mode::kFull:     fModeName = "full";                               break;
+        case Mode::kScanline: fModeName = "scanline";                           break;
+        case Mode::kSubset:   fModeName = "subset";                             break;
+        case Mode::kSampled:  fModeName.printf("sampled%d", sampleSize);        break;
+    }
+    fName.printf("CodecCorpus_%s_%s_%s", fFormatName, fModeName.c_str(), baseName.c_str());
+}
+
+const char* CodecCorpusBench::onGetName() {
+    return fName.c_str();
+}
+
+bool CodecCorpusBench::isSuitableFor(Backend backend) {
+    return Backend::kNonRendering == backend;
+}
+
+void CodecCorpusBench::onDelayedSetup() {
+    fPixelStorage.reset(fInfo.computeMinByteSize());
+
+    // Count what one decode allocates with sk_malloc, which is Skia's own buffers (swizzlers,
+    // sampling, row storage, ...). The codec libraries' internal allocations are not counted.
+    const bool wasEnabled = SkMallocStats::IsEnabled();
+    SkMallocStats::SetEnabled(true);
+    SkMallocStats::Reset();
+    this->decode();
+    const SkMallocStats::Stats stats = SkMallocStats::Snapshot();
+    SkMallocStats::SetEnabled(wasEnabled);
+
+    fPeakDecodeBytes = stats.fPeakLiveBytes;
+    fDecodeMallocs = stats.fMallocCount;
+}
+
+bool CodecCorpusBench::decode() {
+    void* pixels = fPixelStorage.get();
+    const size_t rowBytes = fInfo.minRowBytes();
+
+    switch (fMode) {
+        case Mode::kFull: {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            return codec && decoded(codec->getPixels(fInfo, pixels, rowBytes));
+        }
+        case Mode::kScanline: {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            if (!codec || codec->startScanlineDecode(fInfo) != SkCodec::kSuccess) {
+                return false;
+            }
+            // Like a client streaming rows out as they are decoded.
+            for (int y = 0; y < fInfo.height(); y++) {
+                if (codec->getScanlines(SkTAddOffset<void>(pixels, y * rowBytes), 1, rowBytes) !=
+                    1) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case Mode::kSubset: {
+            std::unique_ptr<SkAndroidCodec> codec = SkAndroidCodec::MakeFromData(fData);
+            SkAndroidCodec::AndroidOptions options;
+            options.fSubset = &fSubset;
+            return codec && decoded(codec->getAndroidPixels(fInfo, pixels, rowBytes, &options));
+        }
+        case Mode::kSampled: {
+            std::unique_ptr<SkAndroidCodec> codec = SkAndroidCodec::MakeFromData(fData);
+            SkAndroidCodec::AndroidOptions options;
+            options.fSampleSize = fSampleSize;
+            return codec && decoded(codec->getAndroidPixels(fInfo, pixels, rowBytes, &options));
+        }
+    }
+    SkUNREACHABLE;
+}
+
+void CodecCorpusBench::onDraw(int loops, SkCanvas*) {
+    for (int i = 0; i < loops; i++) {
+        SkAssertResult(this->decode());
+    }
+}
+
+void CodecCorpusBench::getMetrics(double msPerLoop,
+                                  skia_private::TArray<SkString>* keys,
+                                  skia_private::TArray<double>* values) {
+    const double megapixels = (double)fInfo.width() * fInfo.height() / 1e6;
+    const double seconds = msPerLoop / 1000;
+
+    keys->push_back(SkString("megapixels"));
+    values->push_back(megapixels);
+    keys->push_back(SkString("mp_per_s"));
+    values->push_back(sk_ieee_double_divide(megapixels, seconds));
+    keys->push_back(SkString("encoded_mb_per_s"));
+    values->push_back(sk_ieee_double_divide(fData->size() / 1e6, seconds));
+    keys->push_back(SkString("dst_bytes"));
+    values->push_back(fInfo.computeMinByteSize());
+    keys->push_back(SkString("peak_decode_heap_bytes"));
+    values->push_back(fPeakDecodeBytes);
+    keys->push_back(SkString("decode_malloc_count"));
+    values->push_back(fDecodeMallocs);
+}
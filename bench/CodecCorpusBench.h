@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef CodecCorpusBench_DEFINED
+#define CodecCorpusBench_DEFINED
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "src/base/SkAutoMalloc.h"
+
+#include <cstdint>
+
+enum class SkEncodedImageFormat;
+
+/**
+ *  Times one way of decoding an image from a corpus (nanobench --images <dir> --codecCorpus), and
+ *  reports throughput and memory along with the time, so that runs over a directory of real-world
+ *  images can be grouped by format and decode mode to track each of them over time.
+ */
+class CodecCorpusBench : public Benchmark {
+public:
+    enum class Mode {
+        kFull,      // SkCodec::getPixels() of the whole image.
+        kScanline,  // SkCodec scanline decode of the whole image, one row at a time.
+        kSubset,    // SkAndroidCodec decode of the middle quarter of the image.
+        kSampled,   // SkAndroidCodec decode of the whole image, downsampled by the sample size.
+    };
+
+    // Returns null if the image can't be decoded in this mode (e.g. the codec has no scanline
+    // decoder, or doesn't support subsets).
+    static CodecCorpusBench* Make(const SkString& baseName, sk_sp<SkData> encoded, Mode,
+                                  int sampleSize);
+
+    // Stable names, for grouping results.
+    static const char* FormatName(SkEncodedImageFormat);
+    const char* formatName() const { return fFormatName; }
+    const char* modeName() const { return fModeName.c_str(); }
+
+    void getMetrics(double msPerLoop,
+                    skia_private::TArray<SkString>* keys,
+                    skia_private::TArray<double>* values) override;
+
+protected:
+    const char* onGetName() override;
+    bool isSuitableFor(Backend backend) override;
+    void onDelayedSetup() override;
+    void onDraw(int loops, SkCanvas*) override;
+
+private:
+    CodecCorpusBench(const SkString& baseName, sk_sp<SkData> encoded, SkEncodedImageFormat, Mode,
+                     int sampleSize, const SkImageInfo& info, const SkIRect& subset);
+
+    // Decodes the image once, into fPixelStorage. Returns false if the decode failed.
+    bool decode();
+
+    const sk_sp<SkData> fData;
+    const Mode          fMode;
+    const int           fSampleSize;
+    const char*         fFormatName;
+    SkString            fModeName;
+    SkString            fName;
+
+    const SkImageInfo   fInfo;
+    SkIRect             fSubset;
+    SkAutoMalloc        fPixelStorage;
+
+    // Measured over one decode in onDelayedSetup().
+    int64_t             fPeakDecodeBytes = 0;
+    uint64_t            fDecodeMallocs = 0;
+};
+
+#endif // CodecCorpusBench_DEFINED
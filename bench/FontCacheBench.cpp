@@ -12,11 +12,15 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/utils/SkTextMeasurer.h"
 #include "src/core/SkChecksum.h"
 #include "tools/fonts/FontToolUtils.h"
 
 #include "bench/gUniqueGlyphIDs.h"
 
+#include <string>
+#include <vector>
+
 #define gUniqueGlyphIDs_Sentinel    0xFFFF
 
 static int count_glyphs(const uint16_t start[]) {
@@ -198,3 +202,81 @@ private:
 };
 DEF_BENCH( return new FontPathBench(true); )
 DEF_BENCH( return new FontPathBench(false); )
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Measures the words of a paragraph one at a time, the way line breaking does, either with
+// SkFont::measureText() or with an SkTextMeasurer that lives across measurements.
+class MeasureWordsBench : public Benchmark {
+    SkFont fFont;
+    std::vector<std::string> fWords;
+    SkString fName;
+    const char* fText;
+    const bool fUseMeasurer;
+
+public:
+    MeasureWordsBench(const char* textName, const char* text, bool useMeasurer)
+            : fText(text), fUseMeasurer(useMeasurer) {
+        fName.printf("measure_words_%s_%s", textName, useMeasurer ? "measurer" : "font");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fFont = ToolUtils::DefaultFont();
+        fFont.setSize(14);
+        std::string text(fText);
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t end = text.find(' ', start);
+            if (end == std::string::npos) {
+                end = text.size();
+            }
+            fWords.push_back(text.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkScalar width = 0;
+        for (int loop = 0; loop < loops; ++loop) {
+            if (fUseMeasurer) {
+                SkTextMeasurer measurer(fFont);
+                for (const std::string& word : fWords) {
+                    width += measurer.measureText(word.data(), word.size(), SkTextEncoding::kUTF8);
+                }
+            } else {
+                for (const std::string& word : fWords) {
+                    width += fFont.measureText(word.data(), word.size(), SkTextEncoding::kUTF8);
+                }
+            }
+        }
+        SkASSERT(width >= 0);
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
+static constexpr char kEnglishWords[] =
+        "It was the best of times, it was the worst of times, it was the age of wisdom, it was "
+        "the age of foolishness, it was the epoch of belief, it was the epoch of incredulity, it "
+        "was the season of Light, it was the season of Darkness, it was the spring of hope, it "
+        "was the winter of despair, we had everything before us, we had nothing before us";
+static constexpr char kFrenchWords[] =
+        "C'\xC3\xA9tait le meilleur et le pire des temps, c'\xC3\xA9tait l'\xC3\xA2ge de la "
+        "sagesse et l'\xC3\xA2ge de la folie, l'\xC3\xA8re de la foi et l'\xC3\xA8re de "
+        "l'incr\xC3\xA9\x64ulit\xC3\xA9, la saison de la lumi\xC3\xA8re et la saison des "
+        "t\xC3\xA9n\xC3\xA8\x62res, le printemps de l'espoir et l'hiver du d\xC3\xA9sespoir";
+
+DEF_BENCH( return new MeasureWordsBench("english", kEnglishWords, false); )
+DEF_BENCH( return new MeasureWordsBench("english", kEnglishWords, true); )
+DEF_BENCH( return new MeasureWordsBench("french", kFrenchWords, false); )
+DEF_BENCH( return new MeasureWordsBench("french", kFrenchWords, true); )
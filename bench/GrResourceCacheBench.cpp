@@ -9,6 +9,7 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/base/SkRandom.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrGpuResource.h"
@@ -157,6 +158,57 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Looks up resources from a key space twice the size of the budget, so that about half of the
+// lookups miss, create a new resource and purge the least recently used one.
+class GrResourceCacheBenchChurn : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+protected:
+    const char* onGetName() override {
+        return "grresourcecache_churn";
+    }
+
+    void onDelayedSetup() override {
+        fContext = GrDirectContext::MakeMock(nullptr);
+        if (!fContext) {
+            return;
+        }
+        // Each BenchResource is 100 bytes.
+        fContext->setResourceCacheLimit(CACHE_SIZE_COUNT * 100);
+
+        GrResourceCache* cache = fContext->priv().getResourceCache();
+        cache->purgeUnlockedResources(GrPurgeResourceOptions::kAllResources);
+        populate_cache(fContext->priv().getGpu(), CACHE_SIZE_COUNT, 1);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        if (!fContext) {
+            return;
+        }
+        GrResourceCache* cache = fContext->priv().getResourceCache();
+        GrGpu* gpu = fContext->priv().getGpu();
+        SkRandom random;
+        for (int i = 0; i < loops; ++i) {
+            for (int k = 0; k < CACHE_SIZE_COUNT; ++k) {
+                skgpu::UniqueKey key;
+                BenchResource::ComputeKey(random.nextULessThan(2 * CACHE_SIZE_COUNT), 1, &key);
+                sk_sp<GrGpuResource> resource(cache->findAndRefUniqueResource(key));
+                if (!resource) {
+                    resource.reset(new BenchResource(gpu, /*label=*/"BenchResource"));
+                    resource->resourcePriv().setUniqueKey(key);
+                }
+            }
+            SkASSERT(cache->getResourceCount() <= CACHE_SIZE_COUNT);
+        }
+    }
+
+private:
+    sk_sp<GrDirectContext> fContext;
+    using INHERITED = Benchmark;
+};
+
 DEF_BENCH( return new GrResourceCacheBenchAdd(1); )
 #ifdef SK_RELEASE
 // Only on release because on debug the SkTDynamicHash validation is too slow.
@@ -183,3 +235,5 @@ DEF_BENCH( return new GrResourceCacheBenchFind(54); )
 DEF_BENCH( return new GrResourceCacheBenchFind(55); )
 DEF_BENCH( return new GrResourceCacheBenchFind(56); )
 #endif
+
+DEF_BENCH( return new GrResourceCacheBenchChurn(); )
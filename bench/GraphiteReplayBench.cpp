@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/GraphiteReplayBench.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "src/core/SkOSFile.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/flags/CommandLineFlags.h"
+
+#if defined(SK_GRAPHITE)
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "tools/GpuToolUtils.h"
+#endif
+
+static DEFINE_string(graphiteCaptureDir, "",
+                     "If set, Graphite replay benches write the pipelines their Recordings need "
+                     "here, for PipelineCapture::Precompile().");
+
+GraphiteReplayBench::GraphiteReplayBench(const char* name, const SkPicture* pic,
+                                         const SkIRect& clip, SkScalar scale)
+        : fPic(SkRef(pic))
+        , fClip(clip)
+        , fScale(scale)
+        , fName(name) {
+    fUniqueName.printf("%s_%.2g_replay", name, scale);
+}
+
+GraphiteReplayBench::~GraphiteReplayBench() = default;
+
+const char* GraphiteReplayBench::onGetName() { return fName.c_str(); }
+
+const char* GraphiteReplayBench::onGetUniqueName() { return fUniqueName.c_str(); }
+
+bool GraphiteReplayBench::isSuitableFor(Backend backend) {
+    return backend == Backend::kGraphite;
+}
+
+SkISize GraphiteReplayBench::onGetSize() { return fClip.size(); }
+
+void GraphiteReplayBench::onPerCanvasPreDraw(SkCanvas* canvas) {
+#if defined(SK_GRAPHITE)
+    SkASSERT(canvas->recorder());
+    fContext = canvas->recorder()->priv().context();
+
+    // The picture is recorded with a Recorder of our own, so that nanobench's per-loop snaps of
+    // the canvas's Recorder don't pick up the draws.
+    skgpu::graphite::RecorderOptions options = ToolUtils::CreateTestingRecorderOptions();
+    options.fCapturePipelines = !FLAGS_graphiteCaptureDir.isEmpty();
+    fRecorder = fContext->makeRecorder(options);
+    if (!fRecorder) {
+        return;
+    }
+    fSurface = SkSurfaces::RenderTarget(fRecorder.get(), canvas->imageInfo());
+    if (!fSurface) {
+        return;
+    }
+
+    SkIRect bounds = canvas->getDeviceClipBounds();
+    bounds.intersect(fClip);
+    bounds.intersect(fPic->cullRect().roundOut());
+    SkCanvas* replayCanvas = fSurface->getCanvas();
+    replayCanvas->clipIRect(bounds);
+    replayCanvas->setMatrix(canvas->getLocalToDevice());
+    replayCanvas->scale(fScale, fScale);
+    replayCanvas->drawPicture(fPic.get());
+    fRecording = fRecorder->snap();
+    if (!fRecording) {
+        return;
+    }
+
+    // Insert the Recording once before timing, so that its pipelines are compiled and its
+    // one-time uploads (images, atlas contents) are done. Later inserts only replay the uploads
+    // that have to happen every time.
+    skgpu::graphite::InsertRecordingInfo info;
+    info.fRecording = fRecording.get();
+    fContext->insertRecording(info);
+    fContext->submit(skgpu::graphite::SyncToCpu::kYes);
+
+    if (!FLAGS_graphiteCaptureDir.isEmpty()) {
+        if (sk_sp<SkData> pipelines = fRecorder->serializeCapturedPipelines()) {
+            sk_mkdir(FLAGS_graphiteCaptureDir[0]);
+            SkString path = SkOSPath::Join(FLAGS_graphiteCaptureDir[0], fUniqueName.c_str());
+            path.append(".pipelines");
+            SkFILEWStream stream(path.c_str());
+            stream.write(pipelines->data(), pipelines->size());
+        }
+    }
+#endif
+}
+
+void GraphiteReplayBench::onPerCanvasPostDraw(SkCanvas*) {
+    // The Recording must go before the Recorder that made it.
+    fRecording.reset();
+    fSurface.reset();
+    fRecorder.reset();
+    fContext = nullptr;
+}
+
+void GraphiteReplayBench::onDraw(int loops, SkCanvas*) {
+#if defined(SK_GRAPHITE)
+    if (!fRecording) {
+        return;
+    }
+    // Submit every loop, like SKPBench does, so that we measure the cost of a submission instead
+    // of amortizing one across all loops.
+    for (int i = 0; i < loops; ++i) {
+        skgpu::graphite::InsertRecordingInfo info;
+        info.fRecording = fRecording.get();
+        fContext->insertRecording(info);
+        fContext->submit();
+    }
+#endif
+}
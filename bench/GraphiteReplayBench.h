@@ -0,0 +1,62 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GraphiteReplayBench_DEFINED
+#define GraphiteReplayBench_DEFINED
+
+#include "bench/Benchmark.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+
+#include <memory>
+
+class SkSurface;
+
+namespace skgpu::graphite {
+class Context;
+class Recorder;
+class Recording;
+}
+
+/**
+ * Records an SkPicture into a Graphite Recording once, outside of timing, and then times inserting
+ * and submitting that same Recording over and over. This measures the cost of turning a
+ * Recording's tasks into backend command buffers and submitting them, in isolation from the cost
+ * of recording the draws, which SKPBench measures together with it.
+ *
+ * If --graphiteCaptureDir is set, the pipelines the Recording needs are written there as
+ * <name>.pipelines, in the format taken by skgpu::graphite::PipelineCapture::Precompile().
+ */
+class GraphiteReplayBench : public Benchmark {
+public:
+    GraphiteReplayBench(const char* name, const SkPicture*, const SkIRect& clip, SkScalar scale);
+    ~GraphiteReplayBench() override;
+
+protected:
+    const char* onGetName() override;
+    const char* onGetUniqueName() override;
+    bool isSuitableFor(Backend) override;
+    SkISize onGetSize() override;
+    void onPerCanvasPreDraw(SkCanvas*) override;
+    void onPerCanvasPostDraw(SkCanvas*) override;
+    void onDraw(int loops, SkCanvas*) override;
+
+private:
+    sk_sp<const SkPicture> fPic;
+    const SkIRect fClip;
+    const SkScalar fScale;
+    SkString fName;
+    SkString fUniqueName;
+
+    skgpu::graphite::Context* fContext = nullptr;
+    std::unique_ptr<skgpu::graphite::Recorder> fRecorder;
+    sk_sp<SkSurface> fSurface;
+    std::unique_ptr<skgpu::graphite::Recording> fRecording;
+};
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTSwissHash.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace skia_private;
+
+namespace {
+
+// Stands in for keys like GrResourceKey or PaintParamsKey: a few words hashed with SkChecksum.
+struct WordsKey {
+    std::array<uint32_t, 8> fWords;
+    bool operator==(const WordsKey& that) const { return fWords == that.fWords; }
+};
+
+template <typename K> K make_key(SkRandom* rand);
+
+// Like SkPackedGlyphIDs and unique IDs.
+template <> uint32_t make_key<uint32_t>(SkRandom* rand) { return rand->nextU(); }
+
+template <> SkString make_key<SkString>(SkRandom* rand) {
+    SkString s;
+    s.printf("key_%08x_%u", rand->nextU(), rand->nextULessThan(1000));
+    return s;
+}
+
+template <> WordsKey make_key<WordsKey>(SkRandom* rand) {
+    WordsKey key;
+    for (uint32_t& w : key.fWords) {
+        w = rand->nextU();
+    }
+    return key;
+}
+
+template <typename K> const char* key_name();
+template <> const char* key_name<uint32_t>() { return "u32"; }
+template <> const char* key_name<SkString>() { return "string"; }
+template <> const char* key_name<WordsKey>() { return "words"; }
+
+enum class Op { kFindHit, kFindMiss, kInsert };
+
+// Looks up keys that are all in the table, none of them, or inserts them into an empty table,
+// with either THashTable or TSwissHashTable under THashMap.
+template <typename K, template <typename, typename, typename> class Table>
+class HashTableBench : public Benchmark {
+public:
+    HashTableBench(const char* tableName, Op op, int count) : fOp(op), fCount(count) {
+        static const char* kOpNames[] = {"find_hit", "find_miss", "insert"};
+        fName.printf("hash_table_%s_%s_%s_%d", tableName, key_name<K>(), kOpNames[(int)op],
+                     count);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (int i = 0; i < fCount; i++) {
+            fKeys.push_back(make_key<K>(&rand));
+            fMap.set(fKeys.back(), i);
+        }
+        for (int i = 0; i < fCount; i++) {
+            fMissingKeys.push_back(make_key<K>(&rand));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        int found = 0;
+        for (int loop = 0; loop < loops; loop++) {
+            switch (fOp) {
+                case Op::kFindHit:
+                    for (const K& key : fKeys) {
+                        found += fMap.find(key) != nullptr;
+                    }
+                    break;
+                case Op::kFindMiss:
+                    for (const K& key : fMissingKeys) {
+                        found += fMap.find(key) != nullptr;
+                    }
+                    break;
+                case Op::kInsert: {
+                    THashMap<K, int, SkGoodHash, Table> map;
+                    for (int i = 0; i < fCount; i++) {
+                        map.set(fKeys[i], i);
+                    }
+                    found += map.count();
+                    break;
+                }
+            }
+        }
+        fFound = found;
+    }
+
+private:
+    const Op fOp;
+    const int fCount;
+    SkString fName;
+    std::vector<K> fKeys, fMissingKeys;
+    THashMap<K, int, SkGoodHash, Table> fMap;
+    volatile int fFound = 0;
+};
+
+}  // namespace
+
+#define DEF_HASH_BENCHES(K, op, count)                                                     \
+    DEF_BENCH(return (new HashTableBench<K, THashTable>("thash", Op::op, count));)         \
+    DEF_BENCH(return (new HashTableBench<K, TSwissHashTable>("swiss", Op::op, count));)
+
+#define DEF_HASH_BENCHES_FOR_KEY(K)        \
+    DEF_HASH_BENCHES(K, kFindHit,  100)    \
+    DEF_HASH_BENCHES(K, kFindHit,  100000) \
+    DEF_HASH_BENCHES(K, kFindMiss, 100)    \
+    DEF_HASH_BENCHES(K, kFindMiss, 100000) \
+    DEF_HASH_BENCHES(K, kInsert,   100)    \
+    DEF_HASH_BENCHES(K, kInsert,   100000)
+
+DEF_HASH_BENCHES_FOR_KEY(uint32_t)
+DEF_HASH_BENCHES_FOR_KEY(SkString)
+DEF_HASH_BENCHES_FOR_KEY(WordsKey)
@@ -25,8 +25,11 @@ typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 // Time how long it takes to build an R-Tree.
 class RTreeBuildBench : public Benchmark {
 public:
-    RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
-        fName.printf("rtree_%s_build", name);
+    RTreeBuildBench(const char* name, MakeRectProc proc,
+                    SkRTreeFactory::BulkLoad bulkLoad = SkRTreeFactory::BulkLoad::kInsertionOrder)
+            : fProc(proc), fBulkLoad(bulkLoad) {
+        fName.printf("rtree_%s%s_build",
+                     bulkLoad == SkRTreeFactory::BulkLoad::kHilbert ? "hilbert_" : "", name);
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -45,12 +48,13 @@ protected:
         }
 
         for (int i = 0; i < loops; ++i) {
-            SkRTree tree;
+            SkRTree tree(fBulkLoad);
             tree.insert(rects.data(), NUM_BUILD_RECTS);
         }
     }
 private:
     MakeRectProc fProc;
+    SkRTreeFactory::BulkLoad fBulkLoad;
     SkString fName;
     using INHERITED = Benchmark;
 };
@@ -58,8 +62,11 @@ private:
 // Time how long it takes to perform queries on an R-Tree.
 class RTreeQueryBench : public Benchmark {
 public:
-    RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
-        fName.printf("rtree_%s_query", name);
+    RTreeQueryBench(const char* name, MakeRectProc proc,
+                    SkRTreeFactory::BulkLoad bulkLoad = SkRTreeFactory::BulkLoad::kInsertionOrder)
+            : fTree(bulkLoad), fProc(proc) {
+        fName.printf("rtree_%s%s_query",
+                     bulkLoad == SkRTreeFactory::BulkLoad::kHilbert ? "hilbert_" : "", name);
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -138,3 +145,8 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects,
+                                     SkRTreeFactory::BulkLoad::kHilbert));
+DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects,
+                                     SkRTreeFactory::BulkLoad::kHilbert));
@@ -7,6 +7,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkRegion.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkRandom.h"
 
 static bool union_proc(SkRegion& a, SkRegion& b) {
@@ -129,3 +130,51 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+// Computes the visible region of every window in a stack of overlapping windows, front to back,
+// the way a window manager clips them every frame. Each op's result is stored back into the same
+// regions, and many bands are covered by only one of the regions being combined.
+class WindowClipRegionBench : public Benchmark {
+public:
+    WindowClipRegionBench(int count) {
+        fName.printf("region_windowclip_%d", count);
+
+        SkRandom rand;
+        for (int i = 0; i < count; ++i) {
+            const int w = 64 + rand.nextULessThan(kW / 2);
+            const int h = 48 + rand.nextULessThan(kH / 2);
+            fWindows.push_back(SkIRect::MakeXYWH(rand.nextULessThan(kW - w),
+                                                 rand.nextULessThan(kH - h), w, h));
+            fVisible.push_back();
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            fUncovered.setRect(SkIRect::MakeWH(kW, kH));
+            for (int j = 0; j < fWindows.size(); ++j) {
+                fVisible[j].op(fUncovered, fWindows[j], SkRegion::kIntersect_Op);
+                fUncovered.op(fWindows[j], SkRegion::kDifference_Op);
+            }
+        }
+    }
+
+private:
+    inline static constexpr int kW = 2560;
+    inline static constexpr int kH = 1440;
+
+    skia_private::TArray<SkIRect> fWindows;
+    skia_private::TArray<SkRegion> fVisible;
+    SkRegion fUncovered;
+    SkString fName;
+};
+
+DEF_BENCH(return new WindowClipRegionBench(16);)
+DEF_BENCH(return new WindowClipRegionBench(64);)
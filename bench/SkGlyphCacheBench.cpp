@@ -22,6 +22,12 @@
 #include "tools/fonts/FontToolUtils.h"
 #include "tools/text/SkTextBlobTrace.h"
 
+#if defined(SK_TYPEFACE_FACTORY_FONTATIONS) && defined(SK_TYPEFACE_FACTORY_FREETYPE)
+#include "include/core/SkStream.h"
+#include "include/ports/SkTypeface_fontations.h"
+#include "src/ports/SkTypeface_FreeType.h"
+#endif
+
 using namespace skia_private;
 
 static void do_font_stuff(SkFont* font) {
@@ -44,13 +50,22 @@ static void do_font_stuff(SkFont* font) {
     }
 }
 
+using TypefaceFactory = sk_sp<SkTypeface> (*)();
+
+static sk_sp<SkTypeface> make_serif_italic() {
+    return ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic());
+}
+
 class SkGlyphCacheBasic : public Benchmark {
 public:
-    explicit SkGlyphCacheBasic(size_t cacheSize) : fCacheSize(cacheSize) { }
+    explicit SkGlyphCacheBasic(size_t cacheSize,
+                               TypefaceFactory makeTypeface = make_serif_italic,
+                               const char* suffix = "")
+            : fCacheSize(cacheSize), fMakeTypeface(makeTypeface), fSuffix(suffix) { }
 
 protected:
     const char* onGetName() override {
-        fName.printf("SkGlyphCacheBasic%dK", (int)(fCacheSize >> 10));
+        fName.printf("SkGlyphCacheBasic%dK%s", (int)(fCacheSize >> 10), fSuffix);
         return fName.c_str();
     }
 
@@ -64,7 +79,7 @@ protected:
         SkFont font = ToolUtils::DefaultFont();
         font.setEdging(SkFont::Edging::kAntiAlias);
         font.setSubpixel(true);
-        font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic()));
+        font.setTypeface(fMakeTypeface());
 
         for (int work = 0; work < loops; work++) {
             do_font_stuff(&font);
@@ -75,6 +90,8 @@ protected:
 private:
     using INHERITED = Benchmark;
     const size_t fCacheSize;
+    const TypefaceFactory fMakeTypeface;
+    const char* const fSuffix;
     SkString fName;
 };
 
@@ -122,6 +139,23 @@ DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
 
+#if defined(SK_TYPEFACE_FACTORY_FONTATIONS) && defined(SK_TYPEFACE_FACTORY_FREETYPE)
+// The same font through each typeface backend. With the small cache most glyphs are made again
+// by the scaler context on every loop, so this compares the backends' glyph generation.
+static sk_sp<SkTypeface> make_freetype_typeface() {
+    return SkTypeface_FreeType::MakeFromStream(GetResourceAsStream("fonts/Roboto-Regular.ttf"),
+                                               SkFontArguments());
+}
+
+static sk_sp<SkTypeface> make_fontations_typeface() {
+    return SkTypeface_Make_Fontations(GetResourceAsStream("fonts/Roboto-Regular.ttf"),
+                                      SkFontArguments());
+}
+
+DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024, make_freetype_typeface, "_freetype"); )
+DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024, make_fontations_typeface, "_fontations"); )
+#endif
+
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
                            public SkStrikeClient::DiscardableHandleManager {
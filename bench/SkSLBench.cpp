@@ -8,12 +8,14 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/mock/GrMockCaps.h"
 #include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLLexer.h"
 #include "src/sksl/SkSLModuleLoader.h"
 #include "src/sksl/SkSLParser.h"
 #include "src/sksl/codegen/SkSLGLSLCodeGenerator.h"
@@ -24,6 +26,7 @@
 #include "src/sksl/codegen/SkSLWGSLCodeGenerator.h"
 #include "src/sksl/ir/SkSLFunctionDeclaration.h"
 #include "src/sksl/ir/SkSLProgram.h"
+#include "tools/Resources.h"
 
 #include <regex>
 
@@ -68,6 +71,13 @@ enum class Output {
     kGrWGSL,
 };
 
+// Which part of the compiler a benchmark measures.
+enum class Phase {
+    kAll,       // Parsing, optimization and code generation.
+    kNoInline,  // The same, with the inliner disabled. Compare with kAll to see the inliner's cost.
+    kCodeGen,   // Code generation only, from a program that is compiled once ahead of time.
+};
+
 class SkSLCompileBench : public Benchmark {
 public:
     static const char* output_string(Output output) {
@@ -83,13 +93,27 @@ public:
         SkUNREACHABLE;
     }
 
-    SkSLCompileBench(std::string name, const char* src, bool optimize, Output output)
-            : fName(std::string("sksl_") + (optimize ? "" : "unoptimized_") +
+    static const char* phase_string(Phase phase) {
+        switch (phase) {
+            case Phase::kAll:      return "";
+            case Phase::kNoInline: return "noinline_";
+            case Phase::kCodeGen:  return "codegen_";
+        }
+        SkUNREACHABLE;
+    }
+
+    SkSLCompileBench(std::string name, const char* src, bool optimize, Output output,
+                     Phase phase = Phase::kAll)
+            : fName(std::string("sksl_") + phase_string(phase) + (optimize ? "" : "unoptimized_") +
                     output_string(output) + name)
             , fSrc(src)
             , fCaps(GrContextOptions(), GrMockOptions())
-            , fOutput(output) {
+            , fOutput(output)
+            , fPhase(phase) {
         fSettings.fOptimize = optimize;
+        if (phase == Phase::kNoInline) {
+            fSettings.fInlineThreshold = 0;
+        }
         // The test programs we compile don't follow Vulkan rules and thus produce invalid SPIR-V.
         // This is harmless, so long as we don't try to validate them.
         fSettings.fValidateSPIRV = false;
@@ -138,50 +162,71 @@ protected:
         }
     }
 
-    void onDraw(int loops, SkCanvas* canvas) override {
-        SkSL::ProgramKind kind;
+    SkSL::ProgramKind programKind() const {
         if (this->usesRuntimeShader()) {
-            kind = SkSL::ProgramKind::kRuntimeShader;
-        } else if (this->usesGraphite()) {
-            kind = SkSL::ProgramKind::kGraphiteFragment;
-        } else {
-            kind = SkSL::ProgramKind::kFragment;
+            return SkSL::ProgramKind::kRuntimeShader;
+        }
+        if (this->usesGraphite()) {
+            return SkSL::ProgramKind::kGraphiteFragment;
+        }
+        return SkSL::ProgramKind::kFragment;
+    }
+
+    std::unique_ptr<SkSL::Program> compile() {
+        std::unique_ptr<SkSL::Program> program =
+                fCompiler.convertProgram(this->programKind(), fSrc, fSettings);
+        if (fCompiler.errorCount()) {
+            SK_ABORT("shader compilation failed: %s\n", fCompiler.errorText().c_str());
+        }
+        return program;
+    }
+
+    void generateCode(SkSL::Program& program) {
+        std::string result;
+        switch (fOutput) {
+            case Output::kNone:
+                break;
+
+            case Output::kGLSL:
+                SkAssertResult(SkSL::ToGLSL(program, fCaps.shaderCaps(), &result));
+                break;
+
+            case Output::kMetal:
+            case Output::kGrMtl:
+                SkAssertResult(SkSL::ToMetal(program, fCaps.shaderCaps(), &result));
+                break;
+
+            case Output::kSPIRV:
+                SkAssertResult(SkSL::ToSPIRV(program, fCaps.shaderCaps(), &result));
+                break;
+
+            case Output::kGrWGSL:
+                SkAssertResult(SkSL::ToWGSL(program, fCaps.shaderCaps(), &result));
+                break;
+
+            case Output::kSkRP:
+                SkAssertResult(CompileToSkRP(program));
+                break;
+        }
+    }
+
+    void onDelayedSetup() override {
+        if (fPhase == Phase::kCodeGen) {
+            fProgram = this->compile();
         }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
         for (int i = 0; i < loops; i++) {
-            std::unique_ptr<SkSL::Program> program = fCompiler.convertProgram(kind, fSrc,
-                                                                              fSettings);
-            if (fCompiler.errorCount()) {
-                SK_ABORT("shader compilation failed: %s\n", fCompiler.errorText().c_str());
-            }
-            std::string result;
-            switch (fOutput) {
-                case Output::kNone:
-                    break;
-
-                case Output::kGLSL:
-                    SkAssertResult(SkSL::ToGLSL(*program, fCaps.shaderCaps(), &result));
-                    break;
-
-                case Output::kMetal:
-                case Output::kGrMtl:
-                    SkAssertResult(SkSL::ToMetal(*program, fCaps.shaderCaps(), &result));
-                    break;
-
-                case Output::kSPIRV:
-                    SkAssertResult(SkSL::ToSPIRV(*program, fCaps.shaderCaps(), &result));
-                    break;
-
-                case Output::kGrWGSL:
-                    SkAssertResult(SkSL::ToWGSL(*program, fCaps.shaderCaps(), &result));
-                    break;
-
-                case Output::kSkRP:
-                    SkAssertResult(CompileToSkRP(*program));
-                    break;
+            if (fProgram) {
+                this->generateCode(*fProgram);
+            } else {
+                this->generateCode(*this->compile());
             }
         }
     }
 
+public:
     static bool CompileToSkRP(const SkSL::Program& program) {
         const SkSL::FunctionDeclaration* main = program.getFunction("main");
         if (!main) {
@@ -219,10 +264,123 @@ private:
     SkSL::Compiler fCompiler;
     SkSL::ProgramSettings fSettings;
     Output fOutput;
+    Phase fPhase;
+    std::unique_ptr<SkSL::Program> fProgram;
 
     using INHERITED = Benchmark;
 };
 
+// Measures how long it takes to split a program into tokens.
+class SkSLLexBench : public Benchmark {
+public:
+    SkSLLexBench(std::string name, const char* src)
+            : fName("sksl_lex_" + name)
+            , fSrc(src) {}
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            SkSL::Lexer lexer;
+            lexer.start(fSrc);
+            while (lexer.next().fKind != SkSL::Token::Kind::TK_END_OF_FILE) {}
+        }
+    }
+
+private:
+    std::string fName;
+    std::string fSrc;
+};
+
+// Runtime effects taken from real applications, in resources/sksl/realistic.
+struct RuntimeEffectSource {
+    const char*       fName;
+    const char*       fResource;
+    SkSL::ProgramKind fKind;
+};
+
+static constexpr RuntimeEffectSource kRealisticRuntimeEffects[] = {
+    {"blue_neurons",         "sksl/realistic/BlueNeurons.rts",
+                             SkSL::ProgramKind::kRuntimeShader},
+    {"ripple_shader",        "sksl/realistic/RippleShader.rts",
+                             SkSL::ProgramKind::kRuntimeShader},
+    {"hsl_color_filter",     "sksl/realistic/HSLColorFilter.rtcf",
+                             SkSL::ProgramKind::kRuntimeColorFilter},
+    {"high_contrast_filter", "sksl/realistic/HighContrastFilter.rtcf",
+                             SkSL::ProgramKind::kRuntimeColorFilter},
+};
+
+static std::string load_runtime_effect(const RuntimeEffectSource& effect) {
+    sk_sp<SkData> data = GetResourceAsData(effect.fResource);
+    return data ? std::string((const char*)data->data(), data->size()) : std::string();
+}
+
+// Compiles a realistic runtime effect, either to IR only (Output::kNone) or all the way to a
+// Raster Pipeline program (Output::kSkRP), the way SkRuntimeEffect does on the CPU backend.
+class SkSLRuntimeEffectBench : public Benchmark {
+public:
+    SkSLRuntimeEffectBench(const RuntimeEffectSource& effect, Output output)
+            : fName(std::string("sksl_rt_") + SkSLCompileBench::output_string(output) +
+                    effect.fName)
+            , fEffect(effect)
+            , fOutput(output) {
+        SkASSERT(output == Output::kNone || output == Output::kSkRP);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fSrc = load_runtime_effect(fEffect);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (fSrc.empty()) {
+            return;  // The resource is not available.
+        }
+        for (int i = 0; i < loops; i++) {
+            std::unique_ptr<SkSL::Program> program =
+                    fCompiler.convertProgram(fEffect.fKind, fSrc, fSettings);
+            if (fCompiler.errorCount()) {
+                SK_ABORT("shader compilation failed: %s\n", fCompiler.errorText().c_str());
+            }
+            if (fOutput == Output::kSkRP) {
+                SkAssertResult(SkSLCompileBench::CompileToSkRP(*program));
+            }
+        }
+    }
+
+private:
+    std::string fName;
+    RuntimeEffectSource fEffect;
+    Output fOutput;
+    std::string fSrc;
+    SkSL::Compiler fCompiler;
+    SkSL::ProgramSettings fSettings;
+};
+
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[0], Output::kNone);)
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[0], Output::kSkRP);)
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[1], Output::kNone);)
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[1], Output::kSkRP);)
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[2], Output::kNone);)
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[2], Output::kSkRP);)
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[3], Output::kNone);)
+DEF_BENCH(return new SkSLRuntimeEffectBench(kRealisticRuntimeEffects[3], Output::kSkRP);)
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #define COMPILER_BENCH(name, text)                                                               \
@@ -232,7 +390,18 @@ private:
   DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kGLSL);)  \
   DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kMetal);) \
   DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kSPIRV);) \
-  DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kSkRP);)
+  DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kSkRP);)  \
+  DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kNone,    \
+                                        Phase::kNoInline);)                                      \
+  DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kGLSL,    \
+                                        Phase::kCodeGen);)                                       \
+  DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kMetal,   \
+                                        Phase::kCodeGen);)                                       \
+  DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kSPIRV,   \
+                                        Phase::kCodeGen);)                                       \
+  DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true,  Output::kSkRP,    \
+                                        Phase::kCodeGen);)                                       \
+  DEF_BENCH(return new SkSLLexBench(#name, name##_SRC);)
 
 // This fragment shader is from the third tile on the top row of GM_gradients_2pt_conical_outside.
 // To get an ES2 compatible shader, nonconstantArrayIndexSupport in GrShaderCaps is forced off.
@@ -513,10 +682,15 @@ void main()
 
 COMPILER_BENCH(tiny, "void main() { sk_FragColor = half4(1); }");
 
-#define GRAPHITE_BENCH(name, text)                                                                \
-    static constexpr char name##_SRC[] = text;                                                    \
-    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrMtl);) \
-    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrWGSL);)
+#define GRAPHITE_BENCH(name, text)                                                                 \
+    static constexpr char name##_SRC[] = text;                                                     \
+    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrMtl);)  \
+    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrWGSL);) \
+    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrMtl,    \
+                                          Phase::kCodeGen);)                                       \
+    DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrWGSL,   \
+                                          Phase::kCodeGen);)                                       \
+    DEF_BENCH(return new SkSLLexBench(#name, name##_SRC);)
 
 // This fragment shader is from the third tile on the top row of GM_gradients_2pt_conical_outside.
 GRAPHITE_BENCH(graphite_large, R"(
@@ -706,6 +880,25 @@ void RunSkSLModuleBenchmarks(NanoJSONResultsWriter* log) {
     }
 #endif
 
+    // Heap used by the IR of each realistic runtime effect. The memory pool is disabled, so that
+    // the program's own allocations are measured rather than the size of the pool's blocks.
+    SkSL::ProgramSettings settings;
+    settings.fUseMemoryPool = false;
+    for (const RuntimeEffectSource& effect : kRealisticRuntimeEffects) {
+        std::string src = load_runtime_effect(effect);
+        if (src.empty()) {
+            continue;
+        }
+        before = heap_bytes_used();
+        std::unique_ptr<SkSL::Program> program =
+                compiler.convertProgram(effect.fKind, src, settings);
+        int64_t programBytes = heap_bytes_used();
+        if (program && programBytes >= 0) {
+            std::string name = std::string("sksl_program_") + effect.fName;
+            bench(log, name.c_str(), programBytes - before);
+        }
+    }
+
     // Report the minified module sizes.
     int compilerGPUBinarySize = std::size(SKSL_MINIFIED_sksl_shared) +
                                 std::size(SKSL_MINIFIED_sksl_gpu) +
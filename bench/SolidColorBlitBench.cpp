@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "src/base/SkRandom.h"
+#include "tools/ToolUtils.h"
+
+extern bool gSkForceRasterPipelineBlitter;
+
+// Draws solid colors into raster surfaces of the color types that have specialized solid color
+// blitters, either with those blitters or forcing SkRasterPipelineBlitter, to compare the two.
+class SolidColorBlitBench : public Benchmark {
+public:
+    enum class Shape { kStrokedCircles, kFilledCircles, kRects };
+
+    SolidColorBlitBench(SkColorType ct, Shape shape, bool forcePipeline)
+            : fColorType(ct), fShape(shape), fForcePipeline(forcePipeline) {
+        static const char* kShapeNames[] = {"stroked_circles", "filled_circles", "rects"};
+        fName.printf("solid_color_blit_%s_%s%s", ToolUtils::colortype_name(ct),
+                     kShapeNames[(int)shape], forcePipeline ? "_pipeline" : "");
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fSurface = SkSurfaces::Raster(SkImageInfo::Make(kSize, kSize, fColorType,
+                                                        kPremul_SkAlphaType,
+                                                        SkColorSpace::MakeSRGB()));
+        SkRandom rand;
+        for (SkRect& r : fRects) {
+            r = SkRect::MakeXYWH(rand.nextRangeF(0, kSize), rand.nextRangeF(0, kSize),
+                                 rand.nextRangeF(2, 60), rand.nextRangeF(2, 60));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const bool wasForced = gSkForceRasterPipelineBlitter;
+        gSkForceRasterPipelineBlitter = fForcePipeline;
+
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(0xc0336699);
+        if (fShape == Shape::kStrokedCircles) {
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(1.5f);
+        }
+        for (int i = 0; i < loops; ++i) {
+            for (const SkRect& r : fRects) {
+                if (fShape == Shape::kRects) {
+                    canvas->drawRect(r, paint);
+                } else {
+                    canvas->drawCircle(r.centerX(), r.centerY(), r.width() / 2, paint);
+                }
+            }
+        }
+
+        gSkForceRasterPipelineBlitter = wasForced;
+    }
+
+private:
+    static constexpr int kSize = 512;
+
+    SkString         fName;
+    SkColorType      fColorType;
+    Shape            fShape;
+    bool             fForcePipeline;
+    sk_sp<SkSurface> fSurface;
+    SkRect           fRects[100];
+};
+
+#define DEF_SOLID_BENCHES(ct)                                                                    \
+    DEF_BENCH(return new SolidColorBlitBench(ct, SolidColorBlitBench::Shape::kStrokedCircles,   \
+                                             false);)                                            \
+    DEF_BENCH(return new SolidColorBlitBench(ct, SolidColorBlitBench::Shape::kStrokedCircles,   \
+                                             true);)                                             \
+    DEF_BENCH(return new SolidColorBlitBench(ct, SolidColorBlitBench::Shape::kFilledCircles,    \
+                                             false);)                                            \
+    DEF_BENCH(return new SolidColorBlitBench(ct, SolidColorBlitBench::Shape::kFilledCircles,    \
+                                             true);)                                             \
+    DEF_BENCH(return new SolidColorBlitBench(ct, SolidColorBlitBench::Shape::kRects, false);)   \
+    DEF_BENCH(return new SolidColorBlitBench(ct, SolidColorBlitBench::Shape::kRects, true);)
+
+DEF_SOLID_BENCHES(kRGBA_1010102_SkColorType)
+DEF_SOLID_BENCHES(kRGB_565_SkColorType)
+DEF_SOLID_BENCHES(kA16_unorm_SkColorType)
+DEF_SOLID_BENCHES(kRGBA_F16Norm_SkColorType)
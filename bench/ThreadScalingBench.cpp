@@ -0,0 +1,294 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTypeface.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "src/core/SkRuntimeEffectPriv.h"
+#include "tools/DecodeUtils.h"
+#include "tools/Resources.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Runs a function on a fixed set of threads, including the calling one, and waits for all of them
+// to finish. The threads are started once, so that timing doesn't include thread creation.
+class ThreadGang {
+public:
+    explicit ThreadGang(int threads) {
+        for (int i = 1; i < threads; i++) {
+            fThreads.emplace_back([this, i] { this->loop(i); });
+        }
+    }
+
+    ~ThreadGang() {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fQuit = true;
+        }
+        fStart.notify_all();
+        for (std::thread& thread : fThreads) {
+            thread.join();
+        }
+    }
+
+    // Calls fn(threadIndex) once on every thread.
+    void run(const std::function<void(int)>& fn) {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fWork = &fn;
+            fPending = (int)fThreads.size();
+            fGeneration++;
+        }
+        fStart.notify_all();
+        fn(0);
+        std::unique_lock<std::mutex> lock(fMutex);
+        fDone.wait(lock, [this] { return fPending == 0; });
+    }
+
+private:
+    void loop(int index) {
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(int)>* work;
+            {
+                std::unique_lock<std::mutex> lock(fMutex);
+                fStart.wait(lock, [&] { return fQuit || fGeneration != seen; });
+                if (fQuit) {
+                    return;
+                }
+                seen = fGeneration;
+                work = fWork;
+            }
+            (*work)(index);
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (--fPending == 0) {
+                fDone.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> fThreads;
+    std::mutex fMutex;
+    std::condition_variable fStart, fDone;
+    const std::function<void(int)>* fWork = nullptr;
+    uint64_t fGeneration = 0;
+    int fPending = 0;
+    bool fQuit = false;
+};
+
+constexpr int kSurfaceSize = 256;
+
+// Runs the same workload on 1..N threads at once, to find where Skia's shared caches (strike,
+// resource, runtime effect) and the SkSL compiler stop scaling. Every thread runs the workload
+// 'loops' times, so the reported time is per workload on one thread: with perfect scaling it stays
+// flat as the thread count grows, and time(1 thread) / time(N threads) is the scaling efficiency.
+class ThreadScalingBench : public Benchmark {
+public:
+    ThreadScalingBench(const char* work, int threads) : fThreads(threads) {
+        fName.printf("thread_scaling_%s_%d", work, threads);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        // Don't bother measuring more threads than there are cores to run them.
+        unsigned cores = std::thread::hardware_concurrency();
+        return backend == Backend::kNonRendering && (cores == 0 || fThreads <= (int)cores);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < fThreads; i++) {
+            fSurfaces.push_back(SkSurfaces::Raster(
+                    SkImageInfo::MakeN32Premul(kSurfaceSize, kSurfaceSize)));
+        }
+        this->setupWork();
+        fGang = std::make_unique<ThreadGang>(fThreads);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        fGang->run([&](int thread) {
+            SkCanvas* canvas = fSurfaces[thread]->getCanvas();
+            for (int i = 0; i < loops; i++) {
+                this->work(canvas, i);
+            }
+        });
+    }
+
+    virtual void setupWork() {}
+    // Runs one workload, drawing into a canvas that belongs to the calling thread.
+    virtual void work(SkCanvas*, int iteration) = 0;
+
+private:
+    const int fThreads;
+    SkString fName;
+    std::vector<sk_sp<SkSurface>> fSurfaces;
+    std::unique_ptr<ThreadGang> fGang;
+};
+
+// Rasterizes text at a range of sizes, which looks up (and sometimes creates) strikes in the
+// global SkStrikeCache.
+class TextScalingBench final : public ThreadScalingBench {
+public:
+    explicit TextScalingBench(int threads) : ThreadScalingBench("text", threads) {}
+
+private:
+    void setupWork() override {
+        fTypeface = ToolUtils::CreatePortableTypeface("serif", SkFontStyle());
+    }
+
+    void work(SkCanvas* canvas, int iteration) override {
+        static constexpr char kText[] = "The quick brown fox jumps over the lazy dog.";
+        SkFont font(fTypeface, 8 + iteration % 32);
+        font.setEdging(SkFont::Edging::kAntiAlias);
+        SkPaint paint;
+        for (int y = 1; y <= 4; y++) {
+            canvas->drawSimpleText(kText, sizeof(kText) - 1, SkTextEncoding::kUTF8,
+                                   0, y * 48, font, paint);
+        }
+    }
+
+    sk_sp<SkTypeface> fTypeface;
+};
+
+// Decodes and downscales an image, then draws a downscaled copy of one lazy image shared by all
+// threads, whose decoded pixels and mipmaps are looked up in the global SkResourceCache.
+class ImageScalingBench final : public ThreadScalingBench {
+public:
+    explicit ImageScalingBench(int threads) : ThreadScalingBench("image", threads) {}
+
+private:
+    void setupWork() override {
+        fData = GetResourceAsData("images/mandrill_256.png");
+        fLazyImage = SkImages::DeferredFromEncodedData(fData);
+    }
+
+    void work(SkCanvas* canvas, int) override {
+        SkBitmap decoded;
+        if (!ToolUtils::DecodeDataToBitmap(fData, &decoded)) {
+            return;
+        }
+        SkBitmap scaled;
+        scaled.allocPixels(decoded.info().makeWH(kSurfaceSize / 2, kSurfaceSize / 2));
+        decoded.pixmap().scalePixels(scaled.pixmap(), SkSamplingOptions(SkFilterMode::kLinear));
+
+        canvas->drawImageRect(fLazyImage, SkRect::MakeWH(kSurfaceSize / 3, kSurfaceSize / 3),
+                              SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kLinear));
+    }
+
+    sk_sp<SkData> fData;
+    sk_sp<SkImage> fLazyImage;
+};
+
+// Plays back one picture shared by all threads, with paths, gradients, text and an image.
+class PictureScalingBench final : public ThreadScalingBench {
+public:
+    explicit PictureScalingBench(int threads) : ThreadScalingBench("picture", threads) {}
+
+private:
+    void setupWork() override {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(kSurfaceSize, kSurfaceSize));
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        const SkPoint pts[] = {{0, 0}, {kSurfaceSize, kSurfaceSize}};
+        const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                     SkTileMode::kClamp));
+        canvas->drawRect(SkRect::MakeWH(kSurfaceSize, kSurfaceSize), paint);
+        paint.setShader(nullptr);
+
+        for (int i = 0; i < 16; i++) {
+            SkPath path;
+            path.moveTo(i * 16, 0);
+            path.cubicTo(i * 16 + 64, 64, i * 8, 128, i * 16, kSurfaceSize);
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(3);
+            paint.setColor(SkColorSetARGB(0xc0, i * 16, 0x80, 0xff - i * 16));
+            canvas->drawPath(path, paint);
+        }
+        paint.setStyle(SkPaint::kFill_Style);
+        for (int i = 0; i < 8; i++) {
+            paint.setColor(SkColorSetARGB(0x80, 0xff, i * 32, 0));
+            canvas->drawCircle(32 + i * 24, 200, 20, paint);
+        }
+
+        SkFont font(ToolUtils::CreatePortableTypeface("sans-serif", SkFontStyle()), 18);
+        paint.setColor(SK_ColorBLACK);
+        canvas->drawString("Picture playback", 16, 40, font, paint);
+
+        SkBitmap bitmap;
+        if (ToolUtils::GetResourceAsBitmap("images/mandrill_128.png", &bitmap)) {
+            canvas->drawImage(bitmap.asImage(), 120, 60);
+        }
+        fPicture = recorder.finishRecordingAsPicture();
+    }
+
+    void work(SkCanvas* canvas, int) override { canvas->drawPicture(fPicture); }
+
+    sk_sp<SkPicture> fPicture;
+};
+
+// Compiles a runtime effect that no other iteration or thread has compiled, which misses in the
+// global runtime effect cache, runs the SkSL compiler and inserts the result into the cache.
+class RuntimeEffectScalingBench final : public ThreadScalingBench {
+public:
+    explicit RuntimeEffectScalingBench(int threads)
+            : ThreadScalingBench("runtime_effect", threads) {}
+
+private:
+    void work(SkCanvas*, int) override {
+        static std::atomic<int> gUniqueID{0};
+        SkString sksl = SkStringPrintf(
+                "uniform half4 color;"
+                "half4 main(float2 p) {"
+                "    half t = fract(half(p.x + p.y) * %d.0 / 1024.0);"
+                "    return mix(color, color.bgra, t);"
+                "}",
+                gUniqueID.fetch_add(1, std::memory_order_relaxed));
+        sk_sp<SkRuntimeEffect> effect =
+                SkMakeCachedRuntimeEffect(SkRuntimeEffect::MakeForShader, std::move(sksl));
+        SkASSERT(effect);
+    }
+};
+
+}  // namespace
+
+#define DEF_THREAD_SCALING_BENCHES(Bench)        \
+    DEF_BENCH(return new Bench(1);)              \
+    DEF_BENCH(return new Bench(2);)              \
+    DEF_BENCH(return new Bench(4);)              \
+    DEF_BENCH(return new Bench(8);)              \
+    DEF_BENCH(return new Bench(16);)             \
+    DEF_BENCH(return new Bench(32);)
+
+DEF_THREAD_SCALING_BENCHES(TextScalingBench)
+DEF_THREAD_SCALING_BENCHES(ImageScalingBench)
+DEF_THREAD_SCALING_BENCHES(PictureScalingBench)
+DEF_THREAD_SCALING_BENCHES(RuntimeEffectScalingBench)
@@ -110,6 +110,23 @@ public:
 
 DEF_BENCH( return new PathToTrianglesBench(); );
 
+class PathToTrianglesScratchBench : public TriangulatorBenchmark {
+public:
+    PathToTrianglesScratchBench() : TriangulatorBenchmark("PathToTrianglesScratch") {}
+
+    void doLoop() override {
+        for (const SkPath& path : fPaths) {
+            bool isLinear;
+            GrTriangulator::PathToTriangles(path, kTigerTolerance, SkRect::MakeEmpty(), this,
+                                            &isLinear, &fScratch);
+        }
+    }
+
+    SkSTArenaAllocWithReset<GrTriangulator::kArenaDefaultChunkSize> fScratch;
+};
+
+DEF_BENCH( return new PathToTrianglesScratchBench(); );
+
 class TriangulateInnerFanBench : public TriangulatorBenchmark {
 public:
     TriangulateInnerFanBench() : TriangulatorBenchmark("TriangulateInnerFan") {}
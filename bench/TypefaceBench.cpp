@@ -10,11 +10,19 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontTypes.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkTypeface.h"
 #include "src/base/SkUTF.h"
 #include "src/base/SkUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#if defined(SK_TYPEFACE_FACTORY_FONTATIONS) && defined(SK_TYPEFACE_FACTORY_FREETYPE)
+#include "include/core/SkStream.h"
+#include "include/ports/SkTypeface_fontations.h"
+#include "src/ports/SkTypeface_FreeType.h"
+#include "tools/Resources.h"
+#endif
+
 // From Project Guttenberg. This is UTF-8 text.
 static const char* atext[] = {
         "Call me Ishmael.  Some years ago--never mind how",
@@ -211,13 +219,21 @@ static const char* ctext[] = {
         "晃亂。旁邊上來四個人，用手挽架下堂。"};
 
 
+using TypefaceFactory = sk_sp<SkTypeface> (*)();
+
+static sk_sp<SkTypeface> make_test_typeface() {
+    return ToolUtils::CreateTestTypeface("monospace", SkFontStyle());
+}
+
 class UtfToGlyph : public Benchmark {
 public:
-    UtfToGlyph(SkTextEncoding encoding, const char* (*text), int lineCount, const char* name)
+    UtfToGlyph(SkTextEncoding encoding, const char* (*text), int lineCount, const char* name,
+               TypefaceFactory makeTypeface = make_test_typeface)
         : fEncoding{encoding}
         , fText{text}
         , fLineCount{lineCount}
-        , fName{name} { }
+        , fName{name}
+        , fMakeTypeface{makeTypeface} { }
 
 protected:
     const char* onGetName() override {
@@ -235,7 +251,7 @@ protected:
             maxGlyphs = std::max(maxGlyphs, fLines.back()->glyphCount);
         }
         fGlyphIds.insert(fGlyphIds.begin(), maxGlyphs, 0);
-        fTypeface = ToolUtils::CreateTestTypeface("monospace", SkFontStyle());
+        fTypeface = fMakeTypeface();
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -298,6 +314,7 @@ private:
     const char** fText;
     int fLineCount;
     const char* fName;
+    TypefaceFactory fMakeTypeface;
 };
 
 DEF_BENCH(return new UtfToGlyph(SkTextEncoding::kUTF32, ctext, std::size(ctext),
@@ -315,5 +332,84 @@ DEF_BENCH(return new UtfToGlyph(SkTextEncoding::kUTF16, atext, std::size(atext),
 DEF_BENCH(return new UtfToGlyph(SkTextEncoding::kUTF8, atext, std::size(atext),
                                 "SkTypefaceUTF8ToGlyphAscii");)
 
+#if defined(SK_TYPEFACE_FACTORY_FONTATIONS) && defined(SK_TYPEFACE_FACTORY_FREETYPE)
+
+// The same font through each typeface backend, to compare what they cost.
+static sk_sp<SkTypeface> make_freetype_typeface() {
+    return SkTypeface_FreeType::MakeFromStream(GetResourceAsStream("fonts/Roboto-Regular.ttf"),
+                                               SkFontArguments());
+}
+
+static sk_sp<SkTypeface> make_fontations_typeface() {
+    return SkTypeface_Make_Fontations(GetResourceAsStream("fonts/Roboto-Regular.ttf"),
+                                      SkFontArguments());
+}
+
+DEF_BENCH(return new UtfToGlyph(SkTextEncoding::kUTF8, atext, std::size(atext),
+                                "SkTypefaceUTF8ToGlyphAscii_freetype", make_freetype_typeface);)
+DEF_BENCH(return new UtfToGlyph(SkTextEncoding::kUTF8, atext, std::size(atext),
+                                "SkTypefaceUTF8ToGlyphAscii_fontations",
+                                make_fontations_typeface);)
+
+// Measures the text at many sizes with an empty glyph cache, so that every glyph's metrics come
+// from the typeface's scaler context rather than the cache.
+class TypefaceGlyphMetrics : public Benchmark {
+public:
+    TypefaceGlyphMetrics(TypefaceFactory makeTypeface, SkFontHinting hinting, const char* name)
+        : fMakeTypeface{makeTypeface}
+        , fHinting{hinting}
+        , fName{name} { }
+
+protected:
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fTypeface = fMakeTypeface();
+        SkFont font(fTypeface);
+        for (const char* line : atext) {
+            const size_t length = strlen(line);
+            const int count = font.countText(line, length, SkTextEncoding::kUTF8);
+            const size_t start = fGlyphIds.size();
+            fGlyphIds.resize(start + count);
+            font.textToGlyphs(line, length, SkTextEncoding::kUTF8, &fGlyphIds[start], count);
+        }
+        fWidths.resize(fGlyphIds.size());
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkFont font(fTypeface);
+        font.setHinting(fHinting);
+        for (int i = 0; i < loops; ++i) {
+            SkGraphics::PurgeFontCache();
+            for (SkScalar size = 8; size < 24; ++size) {
+                font.setSize(size);
+                font.getWidths(fGlyphIds.data(), fGlyphIds.size(), fWidths.data());
+            }
+        }
+    }
+
+private:
+    TypefaceFactory fMakeTypeface;
+    SkFontHinting fHinting;
+    const char* fName;
+    sk_sp<SkTypeface> fTypeface;
+    std::vector<SkGlyphID> fGlyphIds;
+    std::vector<SkScalar> fWidths;
+};
 
+DEF_BENCH(return new TypefaceGlyphMetrics(make_freetype_typeface, SkFontHinting::kNone,
+                                          "SkTypefaceGlyphMetrics_unhinted_freetype");)
+DEF_BENCH(return new TypefaceGlyphMetrics(make_fontations_typeface, SkFontHinting::kNone,
+                                          "SkTypefaceGlyphMetrics_unhinted_fontations");)
+DEF_BENCH(return new TypefaceGlyphMetrics(make_freetype_typeface, SkFontHinting::kFull,
+                                          "SkTypefaceGlyphMetrics_hinted_freetype");)
+DEF_BENCH(return new TypefaceGlyphMetrics(make_fontations_typeface, SkFontHinting::kFull,
+                                          "SkTypefaceGlyphMetrics_hinted_fontations");)
 
+#endif
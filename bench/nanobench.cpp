@@ -12,8 +12,10 @@
 #include "bench/AndroidCodecBench.h"
 #include "bench/Benchmark.h"
 #include "bench/CodecBench.h"
+#include "bench/CodecCorpusBench.h"
 #include "bench/CodecBenchPriv.h"
 #include "bench/GMBench.h"
+#include "bench/GraphiteReplayBench.h"
 #include "bench/MSKPBench.h"
 #include "bench/RecordingBench.h"
 #include "bench/ResultsWriter.h"
@@ -36,9 +38,11 @@
 #include "include/private/base/SkMacros.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/base/SkLeanWindows.h"
+#include "src/base/SkMallocStats.h"
 #include "src/base/SkTime.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkRasterPipelineProfile.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/utils/SkJSONWriter.h"
@@ -144,10 +148,19 @@ static DEFINE_string(zoom, "1.0,0",
                      "function that ping-pongs between 1.0 and zoomMax.");
 static DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
 static DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
+static DEFINE_bool(graphiteReplay, false,
+                   "Also time replaying each SKP's Graphite Recording, without recording it again, "
+                   "as a 'replay' bench. Only Graphite configs run these.");
+static DEFINE_bool(codecCorpus, false,
+                   "Also time full, scanline, subset and sampled decodes of every --images file as "
+                   "'codec_corpus' benches, reporting MP/s and decode memory for each.");
 static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
 static DEFINE_bool(gpuStatsDump, false, "Dump GPU stats after each benchmark to json");
 static DEFINE_bool(dmsaaStatsDump, false, "Dump DMSAA stats after each benchmark to json");
+static DEFINE_bool(memoryStats, false,
+                   "Run each bench once more counting allocations, and write them and the cache "
+                   "sizes to json?");
 static DEFINE_bool(keepAlive, false, "Print a message every so often so that we don't time out");
 static DEFINE_bool(csv, false, "Print status in CSV format");
 static DEFINE_string(sourceType, "",
@@ -158,6 +171,9 @@ static DEFINE_string(benchType,  "",
 
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(forceRasterPipelineHP, false, "sets gSkForceRasterPipelineBlitter and gForceHighPrecisionRasterPipeline");
+static DEFINE_string(rasterPipelineProfile, "",
+        "If given, record every raster pipeline stage list that runs, and write their "
+        "run counts, pixel counts and times here as JSON.");
 
 static DEFINE_bool2(pre_log, p, false,
                     "Log before running each test. May be incomprehensible when threading");
@@ -304,6 +320,12 @@ struct GPUTarget : public Target {
         context->priv().printGpuStats();
         context->priv().printContextStats();
     }
+
+    size_t gpuResourceCacheBytes() const override {
+        size_t bytes = 0;
+        this->contextInfo.directContext()->getResourceCacheUsage(nullptr, &bytes);
+        return bytes;
+    }
 };
 
 #if defined(SK_GRAPHITE)
@@ -388,6 +410,10 @@ struct GraphiteTarget : public Target {
 
     void dumpStats() override {
     }
+
+    size_t gpuResourceCacheBytes() const override {
+        return this->context->currentBudgetedBytes() + this->recorder->currentBudgetedBytes();
+    }
 };
 #endif // SK_GRAPHITE
 
@@ -408,6 +434,43 @@ static double time(int loops, Benchmark* bench, Target* target) {
     return elapsed;
 }
 
+struct MemoryStats {
+    SkMallocStats::Stats fMalloc;
+    size_t fResourceCacheBytes;
+    size_t fFontCacheBytes;
+    size_t fGpuResourceCacheBytes;
+};
+
+// Runs the bench once more with allocation counting on, then reads the sizes of the caches it
+// filled. This is kept out of the timed samples so that counting doesn't skew them.
+static MemoryStats measure_memory(int loops, Benchmark* bench, Target* target) {
+    SkMallocStats::Reset();
+    SkMallocStats::SetEnabled(true);
+    time(loops, bench, target);
+    SkMallocStats::SetEnabled(false);
+
+    return {SkMallocStats::Snapshot(),
+            SkGraphics::GetResourceCacheTotalBytesUsed(),
+            SkGraphics::GetFontCacheUsed(),
+            target->gpuResourceCacheBytes()};
+}
+
+static void append_memory_metrics(NanoJSONResultsWriter* log, const MemoryStats& memory,
+                                  int loops) {
+    // Counts are per loop, like the timings, so they don't depend on how many loops were run.
+    log->appendMetric("malloc_count", (double)memory.fMalloc.fMallocCount / loops);
+    log->appendMetric("malloc_bytes", (double)memory.fMalloc.fMallocBytes / loops);
+    log->appendMetric("free_count", (double)memory.fMalloc.fFreeCount / loops);
+    log->appendMetric("peak_malloc_bytes", memory.fMalloc.fPeakLiveBytes);
+    log->appendMetric("arena_block_count", (double)memory.fMalloc.fArenaBlockCount / loops);
+    log->appendMetric("peak_arena_bytes", memory.fMalloc.fPeakArenaBytes);
+    log->appendMetric("resource_cache_bytes", memory.fResourceCacheBytes);
+    log->appendMetric("font_cache_bytes", memory.fFontCacheBytes);
+    log->appendMetric("gpu_resource_cache_bytes", memory.fGpuResourceCacheBytes);
+    log->appendMetric("rss_mb", sk_tools::getCurrResidentSetSizeMB());
+    log->appendMetric("max_rss_mb", sk_tools::getMaxResidentSetSizeMB());
+}
+
 static double estimate_timer_overhead() {
     double overhead = 0;
     for (int i = 0; i < FLAGS_overheadLoops; i++) {
@@ -1039,6 +1102,21 @@ public:
             }
         }
 
+#if defined(SK_GRAPHITE)
+        // With --graphiteReplay, replay each SKP's Graphite Recording, at the first scale.
+        while (FLAGS_graphiteReplay && fCurrentReplaySKP < fSKPs.size()) {
+            const SkString& path = fSKPs[fCurrentReplaySKP++];
+            sk_sp<SkPicture> pic = ReadPicture(path.c_str());
+            if (!pic) {
+                continue;
+            }
+            SkString name = SkOSPath::Basename(path.c_str());
+            fSourceType = "skp";
+            fBenchType = "replay";
+            return new GraphiteReplayBench(name.c_str(), pic.get(), fClip, fScales[0]);
+        }
+#endif
+
         // Read all MSKPs as benches
         while (fCurrentMSKP < fMSKPs.size()) {
             const SkString& path = fMSKPs[fCurrentMSKP++];
@@ -1160,6 +1238,46 @@ public:
             fCurrentSampleSize = 0;
         }
 
+        // Run the corpus CodecCorpusBenches, every decode mode of every image.
+        if (FLAGS_codecCorpus) {
+            struct CorpusMode {
+                CodecCorpusBench::Mode mode;
+                int sampleSize;
+            };
+            const CorpusMode corpusModes[] = {
+                { CodecCorpusBench::Mode::kFull,     1 },
+                { CodecCorpusBench::Mode::kScanline, 1 },
+                { CodecCorpusBench::Mode::kSubset,   1 },
+                { CodecCorpusBench::Mode::kSampled,  2 },
+                { CodecCorpusBench::Mode::kSampled,  4 },
+                { CodecCorpusBench::Mode::kSampled,  8 },
+            };
+            for (; fCurrentCorpusImage < fImages.size(); fCurrentCorpusImage++) {
+                fSourceType = "image";
+                fBenchType = "codec_corpus";
+
+                const SkString& path = fImages[fCurrentCorpusImage];
+                if (CommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
+                    continue;
+                }
+                sk_sp<SkData> encoded(SkData::MakeFromFileName(path.c_str()));
+                if (!encoded) {
+                    continue;
+                }
+                while (fCurrentCorpusMode < (int) std::size(corpusModes)) {
+                    const CorpusMode& m = corpusModes[fCurrentCorpusMode++];
+                    // Not every codec supports every mode; skip the ones this image can't do.
+                    if (CodecCorpusBench* bench = CodecCorpusBench::Make(
+                                SkOSPath::Basename(path.c_str()), encoded, m.mode, m.sampleSize)) {
+                        fCorpusFormat = bench->formatName();
+                        fCorpusMode = bench->modeName();
+                        return bench;
+                    }
+                }
+                fCurrentCorpusMode = 0;
+            }
+        }
+
 #ifdef SK_ENABLE_ANDROID_UTILS
         // Run the BRDBenches
         // We intend to create benchmarks that model the use cases in
@@ -1259,6 +1377,10 @@ public:
             SkASSERT_RELEASE(fCurrentScale < fScales.size());  // debugging paranoia
             log.appendString("scale", SkStringPrintf("%.2g", fScales[fCurrentScale]));
         }
+        if (0 == strcmp(fBenchType, "codec_corpus")) {
+            log.appendString("codec_format", fCorpusFormat);
+            log.appendString("decode_mode", fCorpusMode);
+        }
     }
 
     void fillCurrentMetrics(NanoJSONResultsWriter& log) const {
@@ -1309,6 +1431,9 @@ private:
     int fCurrentTextBlobTrace = 0;
     int fCurrentCodec = 0;
     int fCurrentAndroidCodec = 0;
+    int fCurrentCorpusImage = 0;
+    int fCurrentCorpusMode = 0;
+    SkString fCorpusFormat, fCorpusMode;
 #ifdef SK_ENABLE_ANDROID_UTILS
     int fCurrentBRDImage = 0;
     int fCurrentSubsetType = 0;
@@ -1317,6 +1442,7 @@ private:
     int fCurrentAlphaType = 0;
     int fCurrentSampleSize = 0;
     int fCurrentAnimSKP = 0;
+    int fCurrentReplaySKP = 0;
 };
 
 // Some runs (mostly, Valgrind) are so slow that the bot framework thinks we've hung.
@@ -1346,6 +1472,27 @@ class NanobenchShaderErrorHandler : public GrContextOptions::ShaderErrorHandler
     }
 };
 
+static void write_raster_pipeline_profile(const char* path) {
+    SkFILEWStream stream(path);
+    if (!stream.isValid()) {
+        SkDebugf("Could not open %s to write the raster pipeline profile.\n", path);
+        return;
+    }
+    SkJSONWriter writer(&stream, SkJSONWriter::Mode::kPretty);
+    writer.beginArray();
+    for (const SkRasterPipelineProfile::Stats& stats : SkRasterPipelineProfile::Snapshot()) {
+        writer.beginObject();
+        writer.appendString("stages", stats.fStages);
+        writer.appendCString("precision", stats.fLowp ? "lowp" : "highp");
+        writer.appendU64("runs", stats.fRuns);
+        writer.appendU64("pixels", stats.fPixels);
+        writer.appendU64("nanoseconds", stats.fNanos);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.flush();
+}
+
 int main(int argc, char** argv) {
     CommandLineFlags::Parse(argc, argv);
 
@@ -1447,6 +1594,7 @@ int main(int argc, char** argv) {
 
     gSkForceRasterPipelineBlitter     = FLAGS_forceRasterPipelineHP || FLAGS_forceRasterPipeline;
     gForceHighPrecisionRasterPipeline = FLAGS_forceRasterPipelineHP;
+    SkRasterPipelineProfile::SetEnabled(!FLAGS_rasterPipelineProfile.isEmpty());
 
     // The SkSL memory benchmark must run before any GPU painting occurs. SkSL allocates memory for
     // its modules the first time they are accessed, and this test is trying to measure the size of
@@ -1557,6 +1705,11 @@ int main(int argc, char** argv) {
                 }
             }
 
+            MemoryStats memory;
+            if (FLAGS_memoryStats) {
+                memory = measure_memory(loops, bench.get(), target);
+            }
+
             bench->perCanvasPostDraw(canvas);
 
             if (Benchmark::Backend::kNonRendering != target->config.backend &&
@@ -1572,6 +1725,7 @@ int main(int argc, char** argv) {
             const bool want_plot = !FLAGS_quiet && !FLAGS_ms;
 
             Stats stats(samples, want_plot);
+            bench->getMetrics(stats.median, &keys, &values);
             log.beginObject(config);
 
             log.beginObject("options");
@@ -1589,12 +1743,15 @@ int main(int argc, char** argv) {
             log.endArray(); // samples
             benchStream.fillCurrentMetrics(log);
             if (!keys.empty()) {
-                // dump to json, only SKPBench currently returns valid keys / values
+                // dump to json, from getGpuStats(), DMSAA stats and getMetrics()
                 SkASSERT(keys.size() == values.size());
                 for (int j = 0; j < keys.size(); j++) {
                     log.appendMetric(keys[j].c_str(), values[j]);
                 }
             }
+            if (FLAGS_memoryStats) {
+                append_memory_metrics(&log, memory, loops);
+            }
 
             log.endObject(); // config
 
@@ -1675,6 +1832,10 @@ int main(int argc, char** argv) {
         combinedDMSAAStats.dump();
     }
 
+    if (!FLAGS_rasterPipelineProfile.isEmpty()) {
+        write_raster_pipeline_profile(FLAGS_rasterPipelineProfile[0]);
+    }
+
     SkGraphics::PurgeAllCaches();
 
     log.beginBench("memory_usage", 0, 0);
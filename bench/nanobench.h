@@ -78,6 +78,9 @@ struct Target {
     /** Writes gathered stats using SkDebugf. */
     virtual void dumpStats() {}
 
+    /** Returns the bytes held by the GPU resource cache, or 0 if there is none. */
+    virtual size_t gpuResourceCacheBytes() const { return 0; }
+
     SkCanvas* getCanvas() const {
         if (!surface) {
             return nullptr;
@@ -57,7 +57,6 @@
 #include "src/gpu/ganesh/image/GrImageUtils.h"
 #include "src/image/SkImage_Base.h"
 #include "src/utils/SkJSONWriter.h"
-#include "src/utils/SkMultiPictureDocumentPriv.h"
 #include "src/utils/SkOSPath.h"
 #include "src/utils/SkTestCanvas.h"
 #include "tools/DDLPromiseImageHelper.h"
@@ -1426,20 +1425,14 @@ bool SVGSrc::veto(SinkFlags flags) const {
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 MSKPSrc::MSKPSrc(Path path) : fPath(path) {
-    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(fPath.c_str());
-    int count = SkMultiPictureDocument::ReadPageCount(stream.get());
-    if (count > 0) {
-        fPages.reset(count);
-        SkASSERT_RELEASE(SkMultiPictureDocument::ReadPageSizes(stream.get(), &fPages[0],
-                                                               fPages.size()));
-    }
+    fReader = SkMultiPictureDocument::Reader::Make(SkData::MakeFromFileName(fPath.c_str()));
 }
 
-int MSKPSrc::pageCount() const { return fPages.size(); }
+int MSKPSrc::pageCount() const { return fReader ? fReader->pageCount() : 0; }
 
 SkISize MSKPSrc::size() const { return this->size(FLAGS_mskpFrame); }
 SkISize MSKPSrc::size(int i) const {
-    return i >= 0 && i < fPages.size() ? fPages[i].fSize.toCeil() : SkISize{0, 0};
+    return i >= 0 && i < this->pageCount() ? fReader->pageSize(i).toCeil() : SkISize{0, 0};
 }
 
 Result MSKPSrc::draw(SkCanvas* c, GraphiteTestContext* testContext) const {
@@ -1449,20 +1442,13 @@ Result MSKPSrc::draw(int i, SkCanvas* canvas, GraphiteTestContext*) const {
     if (this->pageCount() == 0) {
         return Result::Fatal("Unable to parse MultiPictureDocument file: %s", fPath.c_str());
     }
-    if (i >= fPages.size() || i < 0) {
+    if (i >= this->pageCount() || i < 0) {
         return Result::Fatal("MultiPictureDocument page number out of range: %d", i);
     }
-    SkPicture* page = fPages[i].fPicture.get();
+    sk_sp<SkPicture> page = fReader->readPage(i);
     if (!page) {
-        std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(fPath.c_str());
-        if (!stream) {
-            return Result::Fatal("Unable to open file: %s", fPath.c_str());
-        }
-        if (!SkMultiPictureDocument::Read(stream.get(), &fPages[0], fPages.size())) {
-            return Result::Fatal("SkMultiPictureDocument reader failed on page %d: %s", i,
-                                 fPath.c_str());
-        }
-        page = fPages[i].fPicture.get();
+        return Result::Fatal("SkMultiPictureDocument reader failed on page %d: %s", i,
+                             fPath.c_str());
     }
     canvas->drawPicture(page);
     return Result::Ok();
@@ -350,7 +350,7 @@ public:
 
 private:
     Path fPath;
-    mutable skia_private::TArray<SkDocumentPage> fPages;
+    std::unique_ptr<SkMultiPictureDocument::Reader> fReader;
 };
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
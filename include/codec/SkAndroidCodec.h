@@ -13,6 +13,7 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/base/SkNoncopyable.h"
@@ -27,6 +28,8 @@
 #include <memory>
 
 class SkData;
+class SkExecutor;
+class SkPixmap;
 class SkPngChunkReader;
 class SkStream;
 struct SkGainmapInfo;
@@ -261,6 +264,25 @@ public:
         return this->getAndroidPixels(info, pixels, rowBytes);
     }
 
+    /**
+     *  Decodes the image once and resamples it into each of |thumbnails|, which may differ in
+     *  size, color type and color space.
+     *
+     *  The image is decoded at the largest sample size (for JPEG, the largest DCT scale) whose
+     *  output is at least as large as every thumbnail. Each thumbnail is then resampled from the
+     *  smallest halving of that decode which is at least as large as it, so that no thumbnail is
+     *  filtered down by more than a factor of two, and the halvings are shared between thumbnails.
+     *  The thumbnails are in the encoded orientation.
+     *
+     *  If |executor| is not null, the thumbnails are resampled on it in parallel.
+     *
+     *  @return kSuccess, or another value explaining the type of failure. If the input is
+     *          incomplete, the thumbnails are made from what could be decoded and
+     *          kIncompleteInput or kErrorInInput is returned.
+     */
+    SkCodec::Result getThumbnails(SkSpan<const SkPixmap> thumbnails,
+                                  SkExecutor* executor = nullptr);
+
     SkCodec* codec() const { return fCodec.get(); }
 
     /**
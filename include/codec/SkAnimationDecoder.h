@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAnimationDecoder_DEFINED
+#define SkAnimationDecoder_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAPI.h"
+
+#include <memory>
+
+class SkData;
+class SkExecutor;
+class SkImage;
+
+/**
+ *  Decodes the frames of an animated image (e.g. a GIF or an animated WebP) for playback, keeping
+ *  a bounded window of decoded frames ahead of the one being shown.
+ *
+ *  Each decode uses a codec of its own, drawing over a copy of the frame's required frame (see
+ *  SkCodec::FrameInfo::fRequiredFrame), so that frames that don't depend on each other, such as
+ *  frames that follow different key frames, or several frames drawn on top of the same frame,
+ *  are decoded in parallel on the executor.
+ *
+ *  Not thread safe: the decodes run on the executor, but the methods must be called from one
+ *  thread at a time.
+ */
+class SK_API SkAnimationDecoder {
+public:
+    /**
+     *  Returns nullptr if |data| can't be decoded.
+     *
+     *  @param executor     Runs the decodes, if not null. It must outlive the returned object.
+     *                      Without one, getFrame() decodes the frame it returns, and nothing
+     *                      is decoded ahead.
+     *  @param windowSize   The number of frames, starting at the one passed to getFrame(), to
+     *                      decode and keep. Frames outside of the window are freed, except for
+     *                      those required by frames in it that are still being decoded.
+     *
+     *  Frames are decoded to N32 with premultiplied alpha, in the image's color space.
+     */
+    static std::unique_ptr<SkAnimationDecoder> Make(sk_sp<SkData> data,
+                                                    SkExecutor* executor,
+                                                    int windowSize);
+
+    /** Waits for any decodes that are still running. */
+    virtual ~SkAnimationDecoder() = default;
+
+    virtual int getFrameCount() const = 0;
+
+    virtual SkCodec::FrameInfo getFrameInfo(int index) const = 0;
+
+    virtual int getRepetitionCount() const = 0;
+
+    /**
+     *  Returns frame |index|, waiting for it to be decoded if necessary, and moves the window to
+     *  start at |index| and wrap around to the first frame, so that the frames after it are
+     *  decoded ahead of time. A frame that could only be partly decoded is returned as far as it
+     *  goes. Returns nullptr if |index| is out of range or the frame could not be decoded at all.
+     *
+     *  The returned image keeps its pixels after the frame leaves the window.
+     */
+    virtual sk_sp<SkImage> getFrame(int index) = 0;
+
+protected:
+    SkAnimationDecoder() = default;
+};
+
+#endif  // SkAnimationDecoder_DEFINED
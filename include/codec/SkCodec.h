@@ -30,6 +30,7 @@
 #include <vector>
 
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
@@ -324,6 +325,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -367,6 +369,15 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, the codec may split the decode into independent pieces and run them on
+         *  this executor, returning once they are all done. The result is the same as without it.
+         *
+         *  Currently only JPEGs with restart markers are split, and only by getPixels() and
+         *  getYUVAPlanes().
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
@@ -447,7 +458,15 @@ public:
      *  @param yuvaPixmaps  Contains preallocated pixmaps configured according to a successful call
      *                      to queryYUVAInfo().
      */
-    Result getYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps);
+    Result getYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
+        return this->getYUVAPlanes(yuvaPixmaps, Options());
+    }
+
+    /**
+     *  As above, with options for the decode. Only Options::fExecutor is used, and a subset is
+     *  rejected with kInvalidInput.
+     */
+    Result getYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps, const Options& options);
 
     /**
      *  Prepare for an incremental decode with the specified options.
@@ -502,6 +521,15 @@ public:
         return this->onIncrementalDecode(rowsDecoded);
     }
 
+    /**
+     *  Returns true if a call to incrementalDecode() may change rows that an earlier call already
+     *  initialized, as an interlaced image does when each pass refines the whole image. Otherwise
+     *  each call only adds rows below the |rowsDecoded| of the previous call.
+     *
+     *  This is undefined before startIncrementalDecode() is called.
+     */
+    bool incrementalDecodeRewritesRows() const { return this->onIncrementalDecodeRewritesRows(); }
+
     /**
      * The remaining functions revolve around decoding scanlines.
      */
@@ -831,7 +859,7 @@ protected:
     virtual bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
                                  SkYUVAPixmapInfo*) const { return false; }
 
-    virtual Result onGetYUVAPlanes(const SkYUVAPixmaps&) { return kUnimplemented; }
+    virtual Result onGetYUVAPlanes(const SkYUVAPixmaps&, const Options&) { return kUnimplemented; }
 
     virtual bool onGetValidSubset(SkIRect* /*desiredSubset*/) const {
         // By default, subsets are not supported.
@@ -875,6 +903,8 @@ protected:
      */
     virtual SkScanlineOrder onGetScanlineOrder() const { return kTopDown_SkScanlineOrder; }
 
+    virtual bool onIncrementalDecodeRewritesRows() const { return false; }
+
     const SkImageInfo& dstInfo() const { return fDstInfo; }
 
     const Options& options() const { return fOptions; }
@@ -1007,6 +1037,17 @@ private:
 
     virtual int onGetScanlines(void* /*dst*/, int /*countLines*/, size_t /*rowBytes*/) { return 0; }
 
+    /**
+     *  Returns a codec for the rows of this image from *startRow to the bottom, for the last
+     *  *startRow at or above |row| that the encoded data can be decoded from without decoding
+     *  the rows above it. The returned codec's rows from |row| down match this codec's.
+     *
+     *  Returns nullptr if the image can only be decoded from the top. Used by SkRegionDecoder.
+     */
+    virtual std::unique_ptr<SkCodec> onMakeCodecFromRow(int /*row*/, int* /*startRow*/) {
+        return nullptr;
+    }
+
     /**
      * On an incomplete decode, getPixels() and getScanlines() will call this function
      * to fill any uinitialized memory.
@@ -1040,6 +1081,7 @@ private:
     friend class SkIcoCodec;
     friend class SkAndroidCodec; // for fEncodedInfo
     friend class SkPDFBitmap; // for fEncodedInfo
+    friend class SkRegionDecoder; // for onMakeCodecFromRow
 };
 
 namespace SkCodecs {
@@ -1064,6 +1106,41 @@ struct SK_API Decoder {
 // initialization is done before the first call.
 void SK_API Register(Decoder d);
 
+/**
+ *  Decodes some images of a format faster than the format's SkCodec does, e.g. with a hardware
+ *  decoder (VA-API or NVJPEG on Linux, MediaCodec on Android).
+ *
+ *  SkCodec::getPixels() offers whole, first-frame decodes to the accelerator registered for its
+ *  format before decoding in software, and SkCodec::getYUVAPlanes() does the same for YUVA planes
+ *  (which is how GPU-backed lazy images decode JPEGs, converting to RGB on the GPU). If the
+ *  accelerator declines or fails, the codec decodes as if there were none, so an accelerator only
+ *  needs to handle the images and destinations its hardware is good at.
+ *
+ *  An accelerator is called from whichever threads decode, possibly from several at once.
+ */
+class SK_API Accelerator : public SkRefCnt {
+public:
+    /**
+     *  Decodes the encoded image into dst, which has the dimensions, color type, alpha type and
+     *  color space the caller asked the codec for. Like the codec, it must not apply the encoded
+     *  origin. Returns false to have the codec decode instead; dst may have been written to.
+     */
+    virtual bool decode(const SkCodec& codec, SkStream* encoded, const SkPixmap& dst) = 0;
+
+    /**
+     *  Decodes the encoded image into planes laid out as the codec's queryYUVAInfo() described.
+     *  Returns false to have the codec decode instead.
+     */
+    virtual bool decodeYUVA(const SkCodec&, SkStream*, const SkYUVAPixmaps&) {
+        return false;
+    }
+};
+
+// Registers an accelerator for codecs of the format, replacing any already registered for it, or
+// removes it if accelerator is null. Like Register(), this is not thread-safe; register before
+// decoding.
+void SK_API RegisterAccelerator(SkEncodedImageFormat, sk_sp<Accelerator> accelerator);
+
 /**
  *  Return a SkImage produced by the codec, but attempts to defer image allocation until the
  *  image is actually used/drawn. This deferral allows the system to cache the result, either on the
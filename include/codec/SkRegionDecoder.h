@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRegionDecoder_DEFINED
+#define SkRegionDecoder_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAPI.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SkData;
+class SkPixmap;
+struct SkIRect;
+
+/**
+ *  Decodes rectangular regions of a large image, such as the tiles of a map or a slide scan, at
+ *  full resolution.
+ *
+ *  Decoding a region from scratch decodes every row above it. Instead, this keeps the scanline
+ *  decodes of recent regions open as checkpoints, each paused at the row below the region it last
+ *  decoded, and resumes the closest one above a new region, so that panning down an image only
+ *  decodes each row once. Where the encoded data has points that can be decoded from without the
+ *  rows above them (the restart markers of a JPEG), a new decode starts at the last one above the
+ *  region instead of at the top of the image.
+ *
+ *  Codecs that can't decode scanlines (e.g. PNG) decode each region from the top of the image,
+ *  like SkAndroidCodec does for a subset. Images that decode scanlines bottom up are not
+ *  supported. Regions are in the image's encoded orientation. Not thread safe.
+ */
+class SK_API SkRegionDecoder {
+public:
+    /**
+     *  Returns nullptr if |data| can't be decoded a region at a time.
+     *
+     *  @param maxCheckpoints The number of paused decodes to keep. Each one holds a codec and its
+     *                        buffers, for one column of regions and destination format. The least
+     *                        recently used is dropped to make room for a new one.
+     */
+    static std::unique_ptr<SkRegionDecoder> Make(sk_sp<SkData> data, int maxCheckpoints);
+
+    ~SkRegionDecoder();
+
+    const SkImageInfo& getInfo() const { return fInfo; }
+
+    /**
+     *  Decodes |region| of the image into |dst|, which must have the dimensions of |region|, and
+     *  may have any color type, alpha type and color space the codec can decode to.
+     *
+     *  Returns kInvalidParameters if |region| is empty or not inside the image. Returns
+     *  kIncompleteInput if the encoded data ends before the end of |region|, in which case the
+     *  rest of |dst| is filled as SkCodec::getScanlines() does.
+     */
+    SkCodec::Result decodeRegion(const SkPixmap& dst, const SkIRect& region);
+
+private:
+    struct Checkpoint;
+
+    SkRegionDecoder(sk_sp<SkData>, std::unique_ptr<SkCodec>, int maxCheckpoints);
+
+    Checkpoint* findCheckpoint(const SkImageInfo&, const SkIRect& region) const;
+    Checkpoint* startCheckpoint(std::unique_ptr<SkCodec>, int startRow, const SkImageInfo&,
+                                const SkIRect& region, SkCodec::Result*);
+    void removeCheckpoint(Checkpoint*);
+    SkCodec::Result decodeFromTop(const SkPixmap& dst, const SkIRect& region);
+
+    const sk_sp<SkData>                      fData;
+    // Only used to find the info and to start decodes part way down the image.
+    std::unique_ptr<SkCodec>                 fCodec;
+    const SkImageInfo                        fInfo;
+    const int                                fMaxCheckpoints;
+    std::vector<std::unique_ptr<Checkpoint>> fCheckpoints;
+    uint64_t                                 fUseCount = 0;
+    // False if the codec can't decode scanlines, so that every region is decoded from the top.
+    bool                                     fScanlineDecodes = true;
+};
+
+#endif  // SkRegionDecoder_DEFINED
@@ -61,7 +61,23 @@ protected:
 
 class SK_API SkRTreeFactory : public SkBBHFactory {
 public:
+    enum class BulkLoad {
+        // Groups bounds in the order they were inserted. This is the fastest to build, and works
+        // well when draws arrive roughly in x,y order.
+        kInsertionOrder,
+        // Groups bounds by the position of their centers along a Hilbert curve. This costs a sort
+        // at build time, but produces tighter nodes for draws that arrive in arbitrary order,
+        // which makes partial-area playback cheaper.
+        kHilbert,
+    };
+
+    SkRTreeFactory() = default;
+    explicit SkRTreeFactory(BulkLoad bulkLoad) : fBulkLoad(bulkLoad) {}
+
     sk_sp<SkBBoxHierarchy> operator()() const override;
+
+private:
+    BulkLoad fBulkLoad = BulkLoad::kInsertionOrder;
 };
 
 #endif
@@ -1746,6 +1746,22 @@ public:
                                          const SkSamplingOptions&, const SkPaint* paint = nullptr,
                                          SrcRectConstraint constraint = kStrict_SrcRectConstraint);
 
+    /**
+     * This is a bulk variant of experimental_DrawEdgeAAQuad(), without clips, that renders 'cnt'
+     * solid color rectangles. The rectangles and their colors are passed as parallel arrays, so
+     * that callers with many small rects (e.g. a particle system or a chart) can fill them in
+     * place and draw them with one call, instead of paying for a drawRect() per rect.
+     *
+     * 'rects' must be sorted. Every rect uses the same 'aaFlags' and blend mode. If
+     * 'preViewMatrices' is not null, it must have 'cnt' entries, and rect i is drawn as if the
+     * canvas's CTM was canvas->getTotalMatrix() * preViewMatrices[i].
+     *
+     * The set is drawn as if each rect was drawn with experimental_DrawEdgeAAQuad() in order.
+     */
+    void experimental_DrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                        const SkMatrix preViewMatrices[], int cnt,
+                                        QuadAAFlags aaFlags, SkBlendMode mode);
+
     /** Draws text, with origin at (x, y), using clip, SkMatrix, SkFont font,
         and SkPaint paint.
 
@@ -2331,6 +2347,9 @@ protected:
 
     virtual void onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4], QuadAAFlags aaFlags,
                                   const SkColor4f& color, SkBlendMode mode);
+    virtual void onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                     const SkMatrix preViewMatrices[], int count,
+                                     QuadAAFlags aaFlags, SkBlendMode mode);
 
     enum ClipEdgeStyle {
         kHard_ClipEdgeStyle,
@@ -45,9 +45,15 @@ protected:
     // implementations in Android's SkCanvas subclasses until this stabilizes.
     void onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
             SkCanvas::QuadAAFlags aaFlags, const SkColor4f& color, SkBlendMode mode) override {}
+    void onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+            const SkMatrix preViewMatrices[], int count, SkCanvas::QuadAAFlags aaFlags,
+            SkBlendMode mode) override {}
 #else
     void onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
             SkCanvas::QuadAAFlags aaFlags, const SkColor4f& color, SkBlendMode mode) override = 0;
+    void onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+            const SkMatrix preViewMatrices[], int count, SkCanvas::QuadAAFlags aaFlags,
+            SkBlendMode mode) override = 0;
 #endif
 
     void onDrawAnnotation(const SkRect& rect, const char key[], SkData* value) override = 0;
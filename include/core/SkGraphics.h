@@ -126,6 +126,41 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  These functions get/set the memory that the intermediate images of one image filter
+     *  evaluation should stay within. When a filtered draw or a saveLayer with an image filter is
+     *  estimated to need more, its output is split into tiles that are filtered and drawn one at a
+     *  time, each reading only the part of the input it requires.
+     *
+     *  Zero is the default value, meaning image filters are always evaluated in one pass.
+     */
+    static size_t GetImageFilterTileByteLimit();
+    static size_t SetImageFilterTileByteLimit(size_t newLimit);
+
+    /**
+     *  These functions get/set whether anti-aliased path fills on the CPU use the sparse strip
+     *  rasterizer instead of analytic AA. The sparse strip rasterizer bins the path's edges into
+     *  small tiles and only computes coverage in the tiles they cross, which scales better for
+     *  paths with thousands of edges. Inverse fills always use analytic AA.
+     *
+     *  False is the default value. The setter returns the previous value.
+     */
+    static bool GetSparseStripPathRasterizer();
+    static bool SetSparseStripPathRasterizer(bool enabled);
+
+    /**
+     *  These functions get/set the number of compiled effects that SkRuntimeEffect's
+     *  MakeForColorFilter(), MakeForShader() and MakeForBlender() keep, so that compiling the
+     *  same SkSL with the same options again returns the existing effect instead of running the
+     *  compiler. The cache is split into independently locked shards, so effects can be compiled
+     *  on several threads at once. Effects that fail to compile are not cached.
+     *
+     *  Zero is the default value, meaning effects are compiled on every call. The setter returns
+     *  the previous value.
+     */
+    static int GetRuntimeEffectCacheCountLimit();
+    static int SetRuntimeEffectCacheCountLimit(int count);
+
     /**
      *  Dumps memory usage of caches using the SkTraceMemoryDump interface. See SkTraceMemoryDump
      *  for usage of this method.
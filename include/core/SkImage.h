@@ -25,6 +25,7 @@ class GrRecordingContext;
 class SkBitmap;
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkImageFilter;
 class SkImageGenerator;
@@ -122,6 +123,25 @@ SK_API sk_sp<SkImage> DeferredFromEncodedData(sk_sp<SkData> encoded,
 */
 SK_API sk_sp<SkImage> DeferredFromGenerator(std::unique_ptr<SkImageGenerator> imageGenerator);
 
+/** Schedules decodes of the lazy-generated images in images on executor, so that they are in the
+    raster cache by the time they are drawn on the CPU. Images that are not lazy-generated, are
+    already cached, or already have a decode scheduled are skipped.
+
+    A draw of an image whose decode has not started yet decodes it on the drawing thread instead.
+    A draw of an image that is being decoded waits for the decode to finish; use IsDecodePending()
+    to draw a placeholder instead of waiting.
+
+    @param executor  runs the decodes; SkExecutor::GetDefault() if nullptr
+    @param images    images to decode; may contain nullptr
+    @param count     number of entries in images
+    @return          number of decodes scheduled
+*/
+SK_API int PrefetchDecodes(SkExecutor* executor, const sk_sp<SkImage> images[], int count);
+
+/** Returns true if a decode of image scheduled by PrefetchDecodes() has not finished yet.
+*/
+SK_API bool IsDecodePending(const SkImage* image);
+
 enum class BitDepth {
     kU8,   //!< uses 8-bit unsigned int per color component
     kF16,  //!< uses 16-bit float per color component
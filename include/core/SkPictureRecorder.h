@@ -90,6 +90,15 @@ public:
      */
     sk_sp<SkDrawable> finishRecordingAsDrawable();
 
+    /**
+     *  When enabled, the recorder holds on to the storage of the last picture or drawable it
+     *  finished. If that result (and any picture snapshotted from it) has been destroyed by the
+     *  time beginRecording() is called again, its storage is reset and reused for the new
+     *  recording instead of being freed and allocated again. This suits callers that record a
+     *  similar frame over and over. Disabled by default.
+     */
+    void setReuseRecordStorage(bool reuse);
+
 private:
     void reset();
 
@@ -107,6 +116,8 @@ private:
     sk_sp<SkBBoxHierarchy>      fBBH;
     std::unique_ptr<SkRecorder> fRecorder;
     sk_sp<SkRecord>             fRecord;
+    sk_sp<SkRecord>             fRetiredRecord;  // Only set if fReuseRecordStorage is true.
+    bool                        fReuseRecordStorage = false;
 
     SkPictureRecorder(SkPictureRecorder&&) = delete;
     SkPictureRecorder& operator=(SkPictureRecorder&&) = delete;
@@ -15,6 +15,7 @@
 #include <optional>
 
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPicture;
 class SkTypeface;
@@ -92,6 +93,11 @@ struct SK_API SkSerialProcs {
 
     SkSerialTypefaceProc fTypefaceProc = nullptr;
     void*                fTypefaceCtx = nullptr;
+
+    // If set, a picture's images and typefaces are encoded in parallel on this executor before
+    // being written out in order. The procs above must then be safe to call from several threads
+    // at once. Texture-backed images are still encoded on the calling thread.
+    SkExecutor*          fExecutor = nullptr;
 };
 
 struct SK_API SkDeserialProcs {
@@ -112,6 +118,11 @@ struct SK_API SkDeserialProcs {
     // parameters and returns a bool). Given that there are only two valid implementations of that
     // proc, we just insert the bool directly.
     bool                         fAllowSkSL = true;
+
+    // If true, pictures are played back straight from their deserialized op stream each time they
+    // are drawn, rather than being re-recorded up front. This makes deserializing large pictures
+    // much cheaper, at the cost of every draw re-reading the ops.
+    bool                         fLazyPicturePlayback = false;
 };
 
 #endif
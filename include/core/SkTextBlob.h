@@ -315,6 +315,11 @@ public:
     */
     sk_sp<SkTextBlob> make();
 
+    /** Discards the runs added since the last make() without making an SkTextBlob, keeping the
+        storage allocated for them so that the builder can be filled again without allocating.
+    */
+    void reset();
+
     /** \struct SkTextBlobBuilder::RunBuffer
         RunBuffer supplies storage for glyphs and positions within a run.
 
@@ -497,6 +502,7 @@ private:
     bool mergeRun(const SkFont& font, SkTextBlob::GlyphPositioning positioning,
                   uint32_t count, SkPoint offset);
     void updateDeferredBounds();
+    void compactRuns();
 
     static SkRect ConservativeRunBounds(const SkTextBlob::RunRecord&);
     static SkRect TightRunBounds(const SkTextBlob::RunRecord&);
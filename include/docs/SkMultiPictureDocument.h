@@ -10,16 +10,20 @@
 
 #include "include/core/SkPicture.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
 
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
+class SkData;
 class SkDocument;
 class SkStreamSeekable;
 class SkWStream;
-struct SkDeserialProcs;
-struct SkSerialProcs;
 
 struct SkDocumentPage {
     sk_sp<SkPicture> fPicture;
@@ -30,12 +34,16 @@ namespace SkMultiPictureDocument {
 /**
  *  Writes into a file format that is similar to SkPicture::serialize()
  *  Accepts a callback for endPage behavior
+ *
+ *  Each page is serialized to dst when it ends, and a table of where the pages are is written
+ *  when the document is closed.
  */
 SK_API sk_sp<SkDocument> Make(SkWStream* dst, const SkSerialProcs* = nullptr,
                               std::function<void(const SkPicture*)> onEndPage = nullptr);
 
 /**
  *  Returns the number of pages in the SkMultiPictureDocument.
+ *  Documents written by this version of Skia can only be read from streams with a length.
  */
 SK_API int ReadPageCount(SkStreamSeekable* src);
 
@@ -48,6 +56,42 @@ SK_API bool Read(SkStreamSeekable* src,
                  SkDocumentPage* dstArray,
                  int dstArrayCount,
                  const SkDeserialProcs* = nullptr);
+
+/**
+ *  Reads pages on demand, without reading the pages before them. Make the SkData with
+ *  SkData::MakeFromFileName() to map the file into memory, rather than reading it.
+ *
+ *  readPage() may be called from several threads at once, as long as the SkDeserialProcs can be.
+ *  Procs that share data between pages, like SkSharingDeserialContext, need the pages to be read in
+ *  order, on one thread.
+ *
+ *  Documents written before pages were stored separately are read all at once by Make().
+ */
+class SK_API Reader {
+public:
+    // Returns nullptr if data isn't a SkMultiPictureDocument with at least one page.
+    static std::unique_ptr<Reader> Make(sk_sp<SkData> data, const SkDeserialProcs* = nullptr);
+
+    ~Reader();
+
+    int pageCount() const { return static_cast<int>(fSizes.size()); }
+    SkSize pageSize(int index) const;
+
+    // Deserializes the page each time it's called. Returns nullptr if index is out of range or the
+    // page can't be read.
+    sk_sp<SkPicture> readPage(int index) const;
+
+private:
+    explicit Reader(const SkDeserialProcs*);
+
+    const SkDeserialProcs fProcs;
+    std::vector<SkSize> fSizes;
+    // Each page's offset and length in fData.
+    sk_sp<SkData> fData;
+    std::vector<std::pair<size_t, size_t>> fOffsets;
+    // Or, for older documents, every page.
+    std::vector<sk_sp<SkPicture>> fPictures;
+};
 }  // namespace SkMultiPictureDocument
 
 #endif  // SkMultiPictureDocument_DEFINED
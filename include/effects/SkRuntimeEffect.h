@@ -19,6 +19,7 @@
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkSLSampleUsage.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
@@ -33,6 +34,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -514,4 +516,58 @@ public:
     sk_sp<SkBlender> makeBlender() const;
 };
 
+/**
+ * SkRuntimeUniformBlock holds the uniform values of a runtime shader that is animated. Shaders made
+ * with makeShader() read the block's values whenever they are drawn, so changing the uniforms
+ * every frame doesn't mean making a new SkShader (and SkPaint) every frame.
+ *
+ *   auto block = SkRuntimeUniformBlock::Make(effect);
+ *   paint.setShader(block->makeShader());
+ *   for (each frame) {
+ *       block->set("time", t);
+ *       canvas->drawRect(r, paint);
+ *   }
+ *
+ * Each draw uses the values the block had when the draw was made. SkPictures that hold a shader
+ * made from a block use the block's values at playback; serializing the shader records its values
+ * at that time. Setting values doesn't allocate unless a draw still holds on to the previous
+ * values. SkRuntimeUniformBlock is thread safe.
+ */
+class SK_API SkRuntimeUniformBlock : public SkNVRefCnt<SkRuntimeUniformBlock> {
+public:
+    // Returns null if uniforms isn't the effect's uniformSize(). Null uniforms start at zero.
+    static sk_sp<SkRuntimeUniformBlock> Make(sk_sp<SkRuntimeEffect>,
+                                             sk_sp<const SkData> uniforms = nullptr);
+
+    const SkRuntimeEffect* effect() const { return fEffect.get(); }
+
+    // Returns the current values of all of the effect's uniforms.
+    sk_sp<const SkData> uniforms() const;
+
+    // Replaces all of the uniforms. Returns false if uniforms isn't the effect's uniformSize().
+    bool setUniforms(sk_sp<const SkData> uniforms);
+
+    // Sets the named uniform. Returns false if there is no such uniform, or if size isn't its
+    // sizeInBytes().
+    bool set(std::string_view name, const void* data, size_t size);
+
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable_v<T>, bool> set(std::string_view name,
+                                                                 const T& val) {
+        return this->set(name, &val, sizeof(val));
+    }
+
+    // Makes a runtime shader from the block's effect, which draws with the block's uniforms.
+    sk_sp<SkShader> makeShader(SkSpan<const SkRuntimeEffect::ChildPtr> children = {},
+                               const SkMatrix* localMatrix = nullptr);
+
+private:
+    SkRuntimeUniformBlock(sk_sp<SkRuntimeEffect> effect, sk_sp<SkData> uniforms)
+            : fEffect(std::move(effect)), fUniforms(std::move(uniforms)) {}
+
+    const sk_sp<SkRuntimeEffect> fEffect;
+    mutable SkMutex fMutex;
+    sk_sp<SkData> fUniforms SK_GUARDED_BY(fMutex);
+};
+
 #endif  // SkRuntimeEffect_DEFINED
@@ -16,6 +16,7 @@
 class SkColorSpace;
 class SkData;
 class SkEncoder;
+class SkExecutor;
 class SkPixmap;
 class SkWStream;
 class SkImage;
@@ -86,6 +87,15 @@ struct Options {
      */
     const skcms_ICCProfile* fICCProfile = nullptr;
     const char* fICCProfileDescription = nullptr;
+
+    /**
+     *  If non-null, Encode() splits the image into strips of MCU rows that are compressed in
+     *  parallel on this executor, and joins them with restart markers. The strips share the
+     *  standard Huffman tables rather than tables optimized for the image, so the result is
+     *  typically a few percent larger than a serial encode, with the same pixels. This is ignored
+     *  by Make(), which always encodes serially.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
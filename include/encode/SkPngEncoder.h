@@ -19,6 +19,7 @@
 
 class GrDirectContext;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPixmap;
 class SkWStream;
@@ -80,6 +81,15 @@ struct Options {
      */
     const skcms_ICCProfile* fICCProfile = nullptr;
     const char* fICCProfileDescription = nullptr;
+
+    /**
+     *  If non-null, Encode() splits the image into bands of rows that are filtered and
+     *  compressed in parallel on this executor, each band becoming its own IDAT chunk. The
+     *  result is a standard png, typically a fraction of a percent larger than a serial encode.
+     *  This needs memory for the whole filtered image, and is ignored by Make(), which always
+     *  encodes serially.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
@@ -25,6 +25,12 @@ namespace SkWebpEncoder {
 enum class Compression {
     kLossy,
     kLossless,
+    /**
+     *  Lossless, with the least effort libwebp offers (its lossless preset level 0), ignoring
+     *  |fQuality| and |fMethod|. Compresses much faster than kLossless at the default quality, into
+     *  a larger file.
+     */
+    kLosslessFast,
 };
 
 struct SK_API Options {
@@ -43,6 +49,18 @@ struct SK_API Options {
     Compression fCompression = Compression::kLossy;
     float fQuality = 100.0f;
 
+    /**
+     *  libwebp's |method|, in [0, 6], which trades encoding speed for size: 0 is the fastest and
+     *  6 compresses the most. If negative, lossy compression uses 3 and lossless compression
+     *  uses 0, matching Chrome's defaults.
+     */
+    int fMethod = -1;
+
+    /**
+     *  If true, libwebp may use a second thread for parts of the encode (its |thread_level|).
+     */
+    bool fMultithreaded = false;
+
     /**
      * An optional ICC profile to override the default behavior.
      *
@@ -110,6 +110,14 @@ struct SK_API GrContextOptions {
      */
     SkExecutor* fExecutor = nullptr;
 
+    /**
+     * If true, and fExecutor is set, the CPU side of preparing ops at flush time (e.g. triangulating
+     * paths) is done on fExecutor's threads, in parallel, before the ops are prepared and executed
+     * in order on the flushing thread. The flush waits for the workers, so the ops are submitted
+     * in the same order either way.
+     */
+    bool fAllowParallelOpPreparation = false;
+
     /** Construct mipmaps manually, via repeated downsampling draw-calls. This is used when
         the driver's implementation (glGenerateMipmap) contains bugs. This requires mipmap
         level control (ie desktop or ES3). */
@@ -188,6 +196,16 @@ struct SK_API GrContextOptions {
      */
     Enable fReduceOpsTaskSplitting = Enable::kDefault;
 
+    /**
+     * How many earlier draws to the same render target Ganesh looks through for one that a new
+     * draw can be combined with. The search always stops at a draw that overlaps the new one.
+     * Earlier draws of a different kind (e.g. text when recording a rect) are skipped without
+     * counting against this limit, up to four times the limit in total. Larger values can reduce
+     * the number of draw calls for content that interleaves different kinds of draws, at some CPU
+     * cost while recording.
+     */
+    int fMaxOpCombineDistance = 10;
+
     /**
      * Some ES3 contexts report the ES2 external image extension, but not the ES3 version.
      * If support for external images is critical, enabling this option will cause Ganesh to limit
@@ -10,6 +10,7 @@
 
 #include "include/core/SkColor.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrContextOptions.h"
@@ -878,6 +879,13 @@ public:
     // Using cached shader blobs on a different device or driver are undefined.
     bool precompileShader(const SkData& key, const SkData& data);
 
+    // Calls precompileShader for each key/data pair, and returns how many of them succeeded. keys
+    // and data must be the same size. On GL, if the context was created with an fExecutor, the
+    // SkSL in each blob is translated to GLSL on the executor's threads, and only the compile and
+    // link of each program happens on the calling thread. Clients that want to report progress
+    // can call this with smaller batches of their shaders.
+    int precompileShaders(SkSpan<const sk_sp<SkData>> keys, SkSpan<const sk_sp<SkData>> data);
+
 #ifdef SK_ENABLE_DUMP_GPU
     /** Returns a string with detailed information about the context & GPU, in JSON format. */
     SkString dump() const;
@@ -220,6 +220,31 @@ protected:
         int numPathMaskCacheHits() const { return fNumPathMaskCacheHits; }
         void incNumPathMasksCacheHits() { fNumPathMaskCacheHits++; }
 
+        // Path masks rendered into, and reused from, the AtlasPathRenderer's atlas.
+        int numAtlasPathMasksGenerated() const { return fNumAtlasPathMasksGenerated; }
+        void incNumAtlasPathMasksGenerated() { fNumAtlasPathMasksGenerated++; }
+
+        int numAtlasPathMaskCacheHits() const { return fNumAtlasPathMaskCacheHits; }
+        void incNumAtlasPathMaskCacheHits() { fNumAtlasPathMaskCacheHits++; }
+
+        // Recorded ops that were checked against earlier ops to combine with.
+        int numOpCombineAttempts() const { return fNumOpCombineAttempts; }
+        void incNumOpCombineAttempts() { fNumOpCombineAttempts++; }
+
+        // Recorded ops that were merged into or chained with an earlier op.
+        int numOpsCombined() const { return fNumOpsCombined; }
+        void incNumOpsCombined() { fNumOpsCombined++; }
+
+        // Recorded ops that were not combined because they overlap an earlier op that could not
+        // be combined with them.
+        int numOpCombinesBlockedByOverlap() const { return fNumOpCombinesBlockedByOverlap; }
+        void incNumOpCombinesBlockedByOverlap() { fNumOpCombinesBlockedByOverlap++; }
+
+        // Recorded ops that were not combined because no op within
+        // GrContextOptions::fMaxOpCombineDistance could be combined with them.
+        int numOpCombinesOutOfRange() const { return fNumOpCombinesOutOfRange; }
+        void incNumOpCombinesOutOfRange() { fNumOpCombinesOutOfRange++; }
+
 #if defined(GR_TEST_UTILS)
         void dump(SkString* out) const;
         void dumpKeyValuePairs(skia_private::TArray<SkString>* keys,
@@ -229,10 +254,22 @@ protected:
     private:
         int fNumPathMasksGenerated{0};
         int fNumPathMaskCacheHits{0};
+        int fNumAtlasPathMasksGenerated{0};
+        int fNumAtlasPathMaskCacheHits{0};
+        int fNumOpCombineAttempts{0};
+        int fNumOpsCombined{0};
+        int fNumOpCombinesBlockedByOverlap{0};
+        int fNumOpCombinesOutOfRange{0};
 
 #else // GR_GPU_STATS
         void incNumPathMasksGenerated() {}
         void incNumPathMasksCacheHits() {}
+        void incNumAtlasPathMasksGenerated() {}
+        void incNumAtlasPathMaskCacheHits() {}
+        void incNumOpCombineAttempts() {}
+        void incNumOpsCombined() {}
+        void incNumOpCombinesBlockedByOverlap() {}
+        void incNumOpCombinesOutOfRange() {}
 
 #if defined(GR_TEST_UTILS)
         void dump(SkString*) const {}
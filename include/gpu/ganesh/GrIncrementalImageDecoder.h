@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrIncrementalImageDecoder_DEFINED
+#define GrIncrementalImageDecoder_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAPI.h"
+
+#include <memory>
+
+class GrDirectContext;
+class SkImage;
+struct SkImageInfo;
+
+/**
+ *  Decodes an image incrementally (see SkCodec::startIncrementalDecode()) into a texture, for
+ *  images that arrive slowly and should be drawn as they fill in.
+ *
+ *  The texture is uploaded in full once, by the first call to decode(). After that each call
+ *  uploads only the rows it decoded, or for an interlaced image the rows its pass refined.
+ */
+class SK_API GrIncrementalImageDecoder {
+public:
+    /**
+     *  Starts an incremental decode of |codec| to |info|, with |options| as for
+     *  SkCodec::startIncrementalDecode(). Returns nullptr if the decode can't be started, and
+     *  sets |result| (if not null) to the reason.
+     */
+    static std::unique_ptr<GrIncrementalImageDecoder> Make(GrDirectContext*,
+                                                           std::unique_ptr<SkCodec> codec,
+                                                           const SkImageInfo& info,
+                                                           const SkCodec::Options* options = nullptr,
+                                                           SkCodec::Result* result = nullptr);
+
+    virtual ~GrIncrementalImageDecoder() = default;
+
+    /**
+     *  Decodes whatever more of the image the codec's stream has, and uploads the rows that
+     *  changed.
+     *
+     *  @return kIncompleteInput if there is more to decode, in which case this may be called again
+     *          once the stream has more data. kSuccess once the whole image is decoded, and
+     *          kErrorInInput if the rest of the image can't be decoded. kInternalError if the
+     *          upload failed.
+     */
+    virtual SkCodec::Result decode() = 0;
+
+    /**
+     *  Returns an image of everything decoded so far, in which the rows that have not been decoded
+     *  yet are transparent black, or nullptr before the first call to decode(). The image shares
+     *  the texture until a later call to decode() changes it, and is only copied on the GPU if it
+     *  is drawn after that.
+     */
+    virtual sk_sp<SkImage> makeImage() const = 0;
+
+    /** The number of rows, from the top, that have been at least partly decoded. */
+    virtual int rowsDecoded() const = 0;
+
+protected:
+    GrIncrementalImageDecoder() = default;
+};
+
+#endif  // GrIncrementalImageDecoder_DEFINED
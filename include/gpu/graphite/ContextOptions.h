@@ -8,9 +8,12 @@
 #ifndef skgpu_graphite_ContextOptions_DEFINED
 #define skgpu_graphite_ContextOptions_DEFINED
 
+#include "include/core/SkRefCnt.h"
 #include "include/private/base/SkAPI.h"
 #include "include/private/base/SkMath.h"
 
+class SkData;
+class SkExecutor;
 namespace skgpu { class ShaderErrorHandler; }
 
 namespace skgpu::graphite {
@@ -18,6 +21,35 @@ namespace skgpu::graphite {
 struct ContextOptionsPriv;
 
 struct SK_API ContextOptions {
+    /**
+     * Abstract class which stores Skia data in a cache that persists between sessions. Graphite
+     * stores the backend shader code (SPIR-V, MSL, or WGSL) it generates from SkSL here, so a
+     * later session can skip the SkSL compile for pipelines it has created before. On Vulkan, the
+     * VkPipelineCache data of each Recorder is merged into a single entry when the Recorder (or
+     * Context) is destroyed, so that it can be shared between sessions and processes. Keys and data
+     * are opaque; they are only valid for the same build of Skia. Calls may be made from any
+     * thread that creates pipelines, so implementations must be thread safe.
+     */
+    class SK_API PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        /**
+         * Returns the data for the key if it exists in the cache, otherwise returns null.
+         */
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        /**
+         * Stores data in the cache, indexed by key.
+         */
+        virtual void store(const SkData& key, const SkData& data) = 0;
+
+    protected:
+        PersistentCache() = default;
+        PersistentCache(const PersistentCache&) = delete;
+        PersistentCache& operator=(const PersistentCache&) = delete;
+    };
+
     ContextOptions() {}
 
     /**
@@ -33,6 +65,28 @@ struct SK_API ContextOptions {
      */
     skgpu::ShaderErrorHandler* fShaderErrorHandler = nullptr;
 
+    /**
+     * If present, generated backend shader code is looked up in and stored to this cache. The
+     * cache must outlive the Context and any Recorders made from it.
+     */
+    PersistentCache* fPersistentCache = nullptr;
+
+    /**
+     * If present, the graphics pipelines a Recording needs that haven't been created yet are
+     * compiled in parallel on this executor when the Recording is snapped, instead of one after
+     * another on the snapping thread. Snap still waits for them. The executor must outlive the
+     * Context.
+     */
+    SkExecutor* fPipelineCompileExecutor = nullptr;
+
+    /**
+     * If present, CPU work that a Recorder can split up, such as rasterizing path coverage masks
+     * when paths are drawn with the raster path atlas, is done in parallel on this executor. The
+     * Recorder still waits for that work before it records the uploads of its results. The
+     * executor must outlive the Context and any Recorders made from it.
+     */
+    SkExecutor* fExecutor = nullptr;
+
     /**
      * Specifies the number of samples Graphite should use when performing internal draws with MSAA
      * (hardware capabilities permitting).
@@ -96,6 +150,14 @@ struct SK_API ContextOptions {
      */
     size_t fGpuBudgetInBytes = kDefaultContextBudget;
 
+    /**
+     * If non-zero, going over budget frees at most this many bytes of resources at a time, and the
+     * Context may stay over budget until the next performDeferredCleanup() or freeGpuResources()
+     * call. Clients with tight frame deadlines can use this to move the cost of freeing resources
+     * to idle time.
+     */
+    size_t fOverBudgetPurgeLimitInBytes = 0;
+
     /**
      * Whether labels will be set on backend resources.
      */
@@ -9,6 +9,7 @@
 #define skgpu_graphite_GraphiteTypes_DEFINED
 
 #include "include/core/SkPoint.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 
@@ -29,6 +30,23 @@ class Task;
 using GpuFinishedContext = void*;
 using GpuFinishedProc = void (*)(GpuFinishedContext finishedContext, CallbackResult);
 
+/**
+ * The GPU time spent executing one render or compute pass of a Recording, as measured by GPU
+ * timestamp queries.
+ */
+struct GpuPassTiming {
+    enum class Type : uint8_t {
+        kRender,
+        kCompute,
+    };
+    Type fType;
+    uint64_t fElapsedNs;
+};
+
+using GpuTimingsContext = void*;
+using GpuTimingsProc = void (*)(GpuTimingsContext timingsContext,
+                                SkSpan<const GpuPassTiming> passTimings);
+
 /**
  * The fFinishedProc is called when the Recording has been submitted and finished on the GPU, or
  * when there is a failure that caused it not to be submitted. The callback will always be called
@@ -56,6 +74,12 @@ using GpuFinishedProc = void (*)(GpuFinishedContext finishedContext, CallbackRes
  * The client will own and be responsible for deleting the underlying semaphore objects after the
  * submission completes, however the BackendSemaphore objects themselves can be deleted as soon
  * as this function returns.
+ *
+ * If fGpuTimingsProc is set and the backend supports timestamp queries, it is called once the
+ * Recording has finished on the GPU with the time spent in each of the Recording's render and
+ * compute passes, in the order they were executed. It is called before fFinishedProc. It is not
+ * called if the Recording fails or its timings could not be read back, and passes beyond what the
+ * backend can time in a single submission are left out.
  */
 struct InsertRecordingInfo {
     Recording* fRecording = nullptr;
@@ -71,6 +95,9 @@ struct InsertRecordingInfo {
 
     GpuFinishedContext fFinishedContext = nullptr;
     GpuFinishedProc fFinishedProc = nullptr;
+
+    GpuTimingsContext fGpuTimingsContext = nullptr;
+    GpuTimingsProc fGpuTimingsProc = nullptr;
 };
 
 /**
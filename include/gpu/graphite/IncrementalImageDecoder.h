@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_IncrementalImageDecoder_DEFINED
+#define skgpu_graphite_IncrementalImageDecoder_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAPI.h"
+
+#include <memory>
+
+class SkImage;
+struct SkImageInfo;
+
+namespace skgpu::graphite {
+
+class Recorder;
+
+/**
+ *  Decodes an image incrementally (see SkCodec::startIncrementalDecode()) into a texture, for
+ *  images that arrive slowly and should be drawn as they fill in.
+ *
+ *  The texture is uploaded in full once, by the first call to decode(). After that each call
+ *  records an upload of only the rows it decoded, or for an interlaced image the rows its pass
+ *  refined, to the Recorder.
+ */
+class SK_API IncrementalImageDecoder {
+public:
+    /**
+     *  Starts an incremental decode of |codec| to |info|, with |options| as for
+     *  SkCodec::startIncrementalDecode(). The Recorder must outlive the returned object. Returns
+     *  nullptr if the decode can't be started, and sets |result| (if not null) to the reason.
+     */
+    static std::unique_ptr<IncrementalImageDecoder> Make(Recorder*,
+                                                         std::unique_ptr<SkCodec> codec,
+                                                         const SkImageInfo& info,
+                                                         const SkCodec::Options* options = nullptr,
+                                                         SkCodec::Result* result = nullptr);
+
+    virtual ~IncrementalImageDecoder() = default;
+
+    /**
+     *  Decodes whatever more of the image the codec's stream has, and records an upload of the
+     *  rows that changed.
+     *
+     *  @return kIncompleteInput if there is more to decode, in which case this may be called again
+     *          once the stream has more data. kSuccess once the whole image is decoded, and
+     *          kErrorInInput if the rest of the image can't be decoded. kInternalError if the
+     *          upload failed.
+     */
+    virtual SkCodec::Result decode() = 0;
+
+    /**
+     *  Returns an image of everything decoded so far, for use with the Recorder, in which the rows
+     *  that have not been decoded yet are transparent black, or nullptr before the first call to
+     *  decode(). If the image is still referenced when a later call to decode() changes the
+     *  texture, that call first copies the texture on the GPU so that the image keeps its pixels.
+     */
+    virtual sk_sp<SkImage> makeImage() const = 0;
+
+    /** The number of rows, from the top, that have been at least partly decoded. */
+    virtual int rowsDecoded() const = 0;
+
+protected:
+    IncrementalImageDecoder() = default;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_IncrementalImageDecoder_DEFINED
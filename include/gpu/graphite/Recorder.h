@@ -19,6 +19,7 @@
 
 struct AHardwareBuffer;
 class SkCanvas;
+class SkData;
 struct SkImageInfo;
 class SkPixmap;
 class SkTraceMemoryDump;
@@ -41,6 +42,7 @@ class Caps;
 class Context;
 class Device;
 class DrawBufferManager;
+class PipelineCapture;
 class GlobalCache;
 class ImageProvider;
 class ProxyCache;
@@ -70,6 +72,17 @@ struct SK_API RecorderOptions final {
     static constexpr size_t kDefaultRecorderBudget = 256 * (1 << 20);
     // What is the budget for GPU resources allocated and held by this Recorder.
     size_t fGpuBudgetInBytes = kDefaultRecorderBudget;
+
+    // If non-zero, going over budget while recording frees at most this many bytes of resources
+    // at a time, and the Recorder may stay over budget until the next performDeferredCleanup() or
+    // freeGpuResources() call. Clients with tight frame deadlines can use this to move the cost of
+    // freeing resources to idle time.
+    size_t fOverBudgetPurgeLimitInBytes = 0;
+
+    // If true, the Recorder keeps a list of every pipeline its draws required. The list can be
+    // retrieved with Recorder::serializeCapturedPipelines() and handed to Precompile() in a later
+    // run so that those pipelines are compiled before they are first drawn.
+    bool fCapturePipelines = false;
 };
 
 class SK_API Recorder final {
@@ -198,6 +211,13 @@ public:
      */
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    /**
+     * Returns a serialized description of the pipelines required by everything drawn with this
+     * Recorder so far, or null if the Recorder wasn't made with RecorderOptions::fCapturePipelines.
+     * The data is only meaningful to the same build of Skia running on the same device.
+     */
+    sk_sp<SkData> serializeCapturedPipelines() const;
+
     // Provides access to functions that aren't part of the public API.
     RecorderPriv priv();
     const RecorderPriv priv() const;  // NOLINT(readability-const-return-type)
@@ -246,6 +266,7 @@ private:
     std::unique_ptr<DrawBufferManager> fDrawBufferManager;
     std::unique_ptr<UploadBufferManager> fUploadBufferManager;
     std::unique_ptr<ProxyReadCountMap> fProxyReadCounts;
+    std::unique_ptr<PipelineCapture> fPipelineCapture; // Null unless capturing pipelines
 
     // Iterating over tracked devices in flushTrackedDevices() needs to be re-entrant and support
     // additions to fTrackedDevices if registerDevice() is triggered by a temporary device during
@@ -10,6 +10,9 @@
 
 #include "include/gpu/graphite/GraphiteTypes.h"
 
+class SkData;
+class SkExecutor;
+
 namespace skgpu::graphite {
 
 class Context;
@@ -29,6 +32,23 @@ void Precompile(Context* context,
                 const PaintOptions& paintOptions,
                 DrawTypeFlags drawTypes = kMostCommon);
 
+/**
+ * Precompiles exactly the pipelines captured by a Recorder created with
+ * RecorderOptions::fCapturePipelines, as returned by Recorder::serializeCapturedPipelines(). The
+ * capture may come from an earlier run of the same build on the same device.
+ *
+ *   @param context            the Context to which the actual draws will be submitted
+ *   @param capturedPipelines  the serialized capture
+ *   @param executor           if non-null, pipelines are compiled in parallel on this executor;
+ *                             this call still blocks until they are all compiled, so it is
+ *                             intended to be made from a background thread
+ *
+ * Returns false if the capture could not be parsed.
+ */
+bool Precompile(Context* context,
+                const SkData& capturedPipelines,
+                SkExecutor* executor = nullptr);
+
 } // namespace skgpu::graphite
 
 #endif // skgpu_graphite_precompile_Precompile_DEFINED
@@ -12,6 +12,7 @@
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
 
+class SkExecutor;
 struct SkRect;
 
 
@@ -101,6 +102,17 @@ public:
       */
     bool resolve(SkPath* result);
 
+    /** Like resolve(), but when every operator is a union, the paths are split into groups whose
+        bounds overlap, and the groups are resolved concurrently on executor. Within a group,
+        paths are combined pairwise, so the work at each step is independent and can also run
+        concurrently. Otherwise, or if executor is null, this is the same as resolve().
+
+        @param result The product of the operands.
+        @param executor Runs the independent unions.
+        @return True if the operation succeeded.
+      */
+    bool resolve(SkPath* result, SkExecutor* executor);
+
 private:
     skia_private::TArray<SkPath> fPathRefs;
     SkTDArray<SkPathOp> fOps;
@@ -49,6 +49,26 @@ public:
                                 const SkRect& dstRect,
                                 float dstHdrRatio,
                                 sk_sp<SkColorSpace> dstColorSpace);
+
+    /**
+     *  Like Make(), but applies the gainmap to the whole base image once and returns a shader that
+     *  samples the resulting F16 image in dstColorSpace, so drawing it skips the gainmap math.
+     *
+     *  The HDR to SDR ratio is rounded to the nearest eighth of a stop, and the baked image is kept
+     *  in the SkResourceCache, so later draws of the same images at a similar ratio reuse it. This
+     *  suits images that are drawn many times, like the photos of a gallery. If the images can't be
+     *  read on the CPU (e.g. they are texture-backed), this returns the result of Make().
+     */
+    static sk_sp<SkShader> MakeBaked(const sk_sp<const SkImage>& baseImage,
+                                     const SkRect& baseRect,
+                                     const SkSamplingOptions& baseSamplingOptions,
+                                     const sk_sp<const SkImage>& gainmapImage,
+                                     const SkRect& gainmapRect,
+                                     const SkSamplingOptions& gainmapSamplingOptions,
+                                     const SkGainmapInfo& gainmapInfo,
+                                     const SkRect& dstRect,
+                                     float dstHdrRatio,
+                                     sk_sp<SkColorSpace> dstColorSpace);
 };
 
 #endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCostAnalysisCanvas_DEFINED
+#define SkCostAnalysisCanvas_DEFINED
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkCanvasVirtualEnforcer.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypes.h"
+#include "include/utils/SkNoDrawCanvas.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SkData;
+class SkDrawable;
+class SkImage;
+class SkMatrix;
+class SkPaint;
+class SkPath;
+class SkPicture;
+class SkRRect;
+class SkRegion;
+class SkTextBlob;
+class SkVertices;
+enum class SkBlendMode;
+namespace sktext { class GlyphRunList; }
+struct SkDrawShadowRec;
+struct SkPoint;
+struct SkRSXform;
+
+/**
+ *  Estimates what each draw would cost to rasterize, without drawing anything, to find the
+ *  expensive parts of a picture: play the picture back into this canvas, then look at the
+ *  costliest ops and nested pictures, or at a heatmap of where the cost lands.
+ *
+ *  Costs are in "stage-pixels": running one raster pipeline stage over one pixel. A draw costs
+ *  a fixed overhead, plus the device pixels its bounds cover (after clipping) times the number of
+ *  stages its paint needs (shader, color filter, blending), plus extra for path and glyph
+ *  rasterization, mask filters and image filters. A saveLayer costs its pixels again, for
+ *  clearing and compositing the layer. These are estimates of relative cost, meant for ranking
+ *  content, not for predicting time; in particular coverage is taken from bounds, not from the
+ *  exact shape.
+ *
+ *  Counting a shader's stages appends it to a raster pipeline, which can decode the images it
+ *  samples. Each shader is only counted once per canvas.
+ */
+class SK_API SkCostAnalysisCanvas : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
+public:
+    // heatmapCellSize > 0 accumulates a heatmap with one cell per heatmapCellSize square of
+    // device pixels.
+    SkCostAnalysisCanvas(int width, int height, int heatmapCellSize = 0);
+    ~SkCostAnalysisCanvas() override;
+
+    struct Op {
+        int         fIndex;         // In the order drawn.
+        const char* fName;          // e.g. "drawRect", "saveLayer".
+        int         fNode;          // Index of the innermost picture or drawable, or -1.
+        SkIRect     fDeviceBounds;  // Clipped.
+        int64_t     fPixels;
+        int         fStages;        // Per pixel.
+        int         fLayerDepth;    // How many layers it draws into.
+        double      fCost;
+    };
+
+    // A nested picture or drawable, and everything drawn inside it.
+    struct Node {
+        const char* fName;          // "drawPicture" or "drawDrawable".
+        int         fParent;        // Index of the enclosing node, or -1.
+        uint32_t    fUniqueID;      // Of the picture (0 for drawables).
+        SkIRect     fDeviceBounds;  // Union of its ops'.
+        int         fOpCount;
+        double      fCost;
+    };
+
+    const std::vector<Op>& ops() const { return fOps; }
+    const std::vector<Node>& nodes() const { return fNodes; }
+    double totalCost() const { return fTotalCost; }
+
+    // The count costliest ops or nodes, costliest first.
+    std::vector<Op> mostExpensiveOps(int count) const;
+    std::vector<Node> mostExpensiveNodes(int count) const;
+
+    // One kGray_8 pixel per cell, 255 for the costliest cell. Empty without a heatmapCellSize.
+    SkBitmap heatmap() const;
+
+    // A human readable summary: the total, then the count costliest nodes and ops.
+    SkString report(int count = 10) const;
+
+    // Forgets everything analyzed so far, keeping the canvas size.
+    void reset();
+
+protected:
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
+    void willSave() override;
+    void willRestore() override;
+    bool onDoSaveBehind(const SkRect*) override;
+
+    void onDrawTextBlob(const SkTextBlob*, SkScalar, SkScalar, const SkPaint&) override;
+    void onDrawGlyphRunList(const sktext::GlyphRunList&, const SkPaint&) override;
+    void onDrawPatch(const SkPoint[12], const SkColor[4], const SkPoint[4], SkBlendMode,
+                     const SkPaint&) override;
+    void onDrawPaint(const SkPaint&) override;
+    void onDrawBehind(const SkPaint&) override;
+    void onDrawPoints(PointMode, size_t, const SkPoint[], const SkPaint&) override;
+    void onDrawRect(const SkRect&, const SkPaint&) override;
+    void onDrawRegion(const SkRegion&, const SkPaint&) override;
+    void onDrawOval(const SkRect&, const SkPaint&) override;
+    void onDrawArc(const SkRect&, SkScalar, SkScalar, bool, const SkPaint&) override;
+    void onDrawRRect(const SkRRect&, const SkPaint&) override;
+    void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+    void onDrawPath(const SkPath&, const SkPaint&) override;
+
+    void onDrawImage2(const SkImage*, SkScalar, SkScalar, const SkSamplingOptions&,
+                      const SkPaint*) override;
+    void onDrawImageRect2(const SkImage*, const SkRect&, const SkRect&, const SkSamplingOptions&,
+                          const SkPaint*, SrcRectConstraint) override;
+    void onDrawImageLattice2(const SkImage*, const Lattice&, const SkRect&, SkFilterMode,
+                             const SkPaint*) override;
+    void onDrawAtlas2(const SkImage*, const SkRSXform[], const SkRect[], const SkColor[], int,
+                      SkBlendMode, const SkSamplingOptions&, const SkRect*,
+                      const SkPaint*) override;
+
+    void onDrawVerticesObject(const SkVertices*, SkBlendMode, const SkPaint&) override;
+    void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+    void onDrawDrawable(SkDrawable*, const SkMatrix*) override;
+    void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override;
+    void onDrawAnnotation(const SkRect&, const char[], SkData*) override;
+
+    void onDrawEdgeAAQuad(const SkRect&, const SkPoint[4], QuadAAFlags, const SkColor4f&,
+                          SkBlendMode) override;
+    void onDrawEdgeAARectSet(const SkRect[], const SkColor4f[], const SkMatrix[], int,
+                             QuadAAFlags, SkBlendMode) override;
+    void onDrawEdgeAAImageSet2(const ImageSetEntry[], int, const SkPoint[], const SkMatrix[],
+                               const SkSamplingOptions&, const SkPaint*,
+                               SrcRectConstraint) override;
+
+private:
+    struct Draw;
+    class StageCounter;
+
+    void addOp(const char* name, const Draw&);
+    void pushNode(const char* name, uint32_t uniqueID);
+    void popNode();
+
+    const int fHeatmapCellSize;
+    SkISize fHeatmapDimensions;
+    std::vector<double> fHeatmap;
+
+    std::unique_ptr<StageCounter> fStageCounter;
+    std::vector<Op> fOps;
+    std::vector<Node> fNodes;
+    std::vector<bool> fSaveIsLayer;
+    int fLayerDepth = 0;
+    int fCurrentNode = -1;
+    double fTotalCost = 0;
+
+    using INHERITED = SkCanvasVirtualEnforcer<SkNoDrawCanvas>;
+};
+
+#endif  // SkCostAnalysisCanvas_DEFINED
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkImageResize_DEFINED
+#define SkImageResize_DEFINED
+
+#include "include/core/SkTypes.h"
+
+class SkExecutor;
+class SkPixmap;
+
+/**
+ *  A separable resampler for resizing raster images, e.g. to make thumbnails.
+ *
+ *  Unlike SkPixmap::scalePixels(), which draws through an image shader and evaluates a 2D filter
+ *  for every destination pixel, Resize() filters the rows and then the columns with 1D weight
+ *  tables computed once per resize. Its cost grows with the filter's width rather than its area,
+ *  which matters most when shrinking images a lot with a wide filter.
+ */
+namespace SkImageResize {
+
+enum class Filter {
+    kBox,         // Averages the source pixels each destination pixel covers.
+    kTriangle,    // Bilinear when enlarging.
+    kMitchell,    // Cubic, B = C = 1/3.
+    kCatmullRom,  // Cubic, B = 0, C = 1/2. Sharper than Mitchell.
+    kLanczos3,    // Windowed sinc over 3 lobes. The sharpest, and the slowest.
+};
+
+struct Options {
+    Filter fFilter = Filter::kMitchell;
+
+    // Filter light intensities instead of encoded values, by resizing in dst's color space with
+    // a linear transfer function (sRGB's if dst has no color space). This avoids darkening fine
+    // detail, at the cost of converting every pixel to linear and back.
+    bool fLinearLight = false;
+
+    // If non-null, bands of rows are filtered on this executor and the call blocks until they are
+    // done. If null, everything happens on the calling thread.
+    SkExecutor* fExecutor = nullptr;
+};
+
+/**
+ *  Resizes the pixels of src to fill dst, converting them to dst's color type, alpha type and
+ *  color space. Edge pixels are extended past the borders of src. Returns false if either
+ *  pixmap is empty or the conversion is not supported (as for SkPixmap::readPixels()).
+ *
+ *  The pixels of dst must not be accessed by anyone else until this returns.
+ */
+SK_API bool Resize(const SkPixmap& src, const SkPixmap& dst, const Options& options = {});
+
+}  // namespace SkImageResize
+
+#endif
@@ -67,6 +67,8 @@ protected:
 
     void onDrawEdgeAAQuad(const SkRect&, const SkPoint[4], QuadAAFlags, const SkColor4f&,
                           SkBlendMode) override {}
+    void onDrawEdgeAARectSet(const SkRect[], const SkColor4f[], const SkMatrix[], int,
+                             QuadAAFlags, SkBlendMode) override {}
     void onDrawEdgeAAImageSet2(const ImageSetEntry[], int, const SkPoint[], const SkMatrix[],
                                const SkSamplingOptions&, const SkPaint*,
                                SrcRectConstraint) override {}
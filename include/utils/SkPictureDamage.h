@@ -0,0 +1,57 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPictureDamage_DEFINED
+#define SkPictureDamage_DEFINED
+
+#include "include/core/SkColor.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkTypes.h"
+
+class SkCanvas;
+class SkMatrix;
+class SkPicture;
+
+/**
+ *  Helpers for redrawing a retained frame incrementally, when a new picture of it differs from
+ *  the previous one in only a few places.
+ *
+ *  The two pictures are compared op by op. Each draw is identified by a hash of its contents
+ *  and of every matrix, clip and layer that is in effect when it is drawn, together with its
+ *  bounds. Draws that appear in the same order in both pictures are left alone. The bounds of
+ *  every other draw, from either picture, are damaged.
+ */
+namespace SkPictureDamage {
+
+/**
+ *  Returns the region, in the pictures' coordinate space, where drawing after may produce
+ *  different pixels than drawing before. Either picture may be null, which is treated as empty.
+ *
+ *  Images, text blobs, vertices, slugs and nested pictures are compared by their unique IDs, and
+ *  paint effects (shaders, filters, path effects, blenders) by identity, so reusing the same
+ *  objects from frame to frame keeps their draws from being damaged. Drawables, meshes and
+ *  pictures not made by SkPictureRecorder can't be compared, so they damage all of their bounds.
+ */
+SK_API SkRegion Compute(const SkPicture* before, const SkPicture* after);
+
+/**
+ *  Redraws the damaged part of a canvas that currently holds the previous frame drawn as if by
+ *  drawColor(clearColor, SkBlendMode::kSrc) and then drawPicture(before, matrix, nullptr), so
+ *  that it holds the same for picture instead. damage is in the picture's coordinate space, as
+ *  returned by Compute(); it is mapped to the device through the canvas' matrix and matrix.
+ *
+ *  Pictures recorded with an SkBBHFactory only replay the ops that intersect the damage.
+ */
+SK_API void Redraw(SkCanvas* canvas,
+                   const SkPicture* picture,
+                   const SkRegion& damage,
+                   const SkMatrix* matrix = nullptr,
+                   SkColor4f clearColor = SkColors::kTransparent);
+
+}  // namespace SkPictureDamage
+
+#endif  // SkPictureDamage_DEFINED
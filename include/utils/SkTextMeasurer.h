@@ -0,0 +1,59 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTextMeasurer_DEFINED
+#define SkTextMeasurer_DEFINED
+
+#include "include/core/SkFontTypes.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkTypes.h"
+
+#include <cstddef>
+#include <memory>
+
+class SkFont;
+class SkPaint;
+
+/**
+ *  Measures text in one font, many times. This gives the same results as SkFont::measureText()
+ *  (without bounds) and SkFont::getWidths(), but is meant for text layout, which measures many
+ *  short runs in the same font.
+ *
+ *  SkFont looks up the font's strike and converts every character to a glyph on every call.
+ *  SkTextMeasurer holds on to the strike for as long as it lives, and caches the glyph and advance
+ *  of every character it has seen, so that measuring text it has seen before doesn't lock or
+ *  search anything. ASCII and Latin-1 text is measured with a table lookup per character.
+ *
+ *  An SkTextMeasurer is not thread safe. Threads that measure text should each have their own.
+ */
+class SK_API SkTextMeasurer {
+public:
+    explicit SkTextMeasurer(const SkFont&, const SkPaint* paint = nullptr);
+    ~SkTextMeasurer();
+
+    SkTextMeasurer(const SkTextMeasurer&) = delete;
+    SkTextMeasurer& operator=(const SkTextMeasurer&) = delete;
+
+    /** Returns the advance width of text, like SkFont::measureText(). Returns zero if the text
+        isn't valid in encoding.
+    */
+    SkScalar measureText(const void* text, size_t byteLength, SkTextEncoding encoding);
+
+    /** Writes the advance width of each glyph of text to widths, like converting the text with
+        SkFont::textToGlyphs() and calling SkFont::getWidths(). Returns the number of glyphs in
+        text, and writes widths only if that is no more than maxWidthCount. Returns zero if the
+        text isn't valid in encoding.
+    */
+    int getWidths(const void* text, size_t byteLength, SkTextEncoding encoding,
+                  SkScalar widths[], int maxWidthCount);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> fImpl;
+};
+
+#endif
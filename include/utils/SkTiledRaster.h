@@ -0,0 +1,94 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledRaster_DEFINED
+#define SkTiledRaster_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkTypes.h"
+
+#include <functional>
+
+class SkCanvas;
+class SkExecutor;
+class SkMatrix;
+class SkPicture;
+class SkPixmap;
+class SkSurface;
+class SkSurfaceProps;
+
+/**
+ *  Helpers for rasterizing a large SkPicture on the CPU by splitting the destination into tiles
+ *  and playing the picture back once per tile, optionally in parallel.
+ *
+ *  Every tile draws through a canvas that covers the whole destination and is clipped to the
+ *  tile, so device-space effects (dithering, shader coordinates, layer bounds) see the same
+ *  coordinates they would in a single-threaded draw and the output matches it exactly. Pictures
+ *  recorded with an SkBBHFactory only replay the ops that intersect each tile.
+ */
+namespace SkTiledRaster {
+
+struct Options {
+    // Size of each tile in device pixels. Tiles on the right and bottom edges may be smaller.
+    SkISize     fTileSize = {512, 512};
+
+    // If non-null, tiles are rasterized on this executor and the call blocks until all tiles are
+    // done. If null, tiles are drawn serially on the calling thread.
+    SkExecutor* fExecutor = nullptr;
+};
+
+/**
+ *  Draws the picture into the pixels of dst, as if by SkCanvas::drawPicture(picture, matrix,
+ *  nullptr) on a raster canvas wrapping dst. Returns false if dst cannot be drawn into.
+ *
+ *  The pixels of dst must not be accessed by anyone else until this returns.
+ */
+SK_API bool DrawPicture(const SkPicture* picture,
+                        const SkPixmap& dst,
+                        const SkMatrix* matrix,
+                        const SkSurfaceProps* props,
+                        const Options& options = {});
+
+/**
+ *  Draws the picture into a raster surface. Any outstanding snapshot of the surface is preserved
+ *  (the surface's pixels are copied first if needed). Returns false if surface is not a raster
+ *  surface whose pixels can be accessed directly.
+ */
+SK_API bool DrawPicture(const SkPicture* picture,
+                        SkSurface* surface,
+                        const SkMatrix* matrix,
+                        const Options& options = {});
+
+/**
+ *  Returns the canvas to play a tile back into, or nullptr to skip that tile. The canvas is owned
+ *  by the caller and must stay valid until PlaybackTiles() returns. With an executor this is
+ *  called concurrently from several threads, so it must be thread-safe.
+ */
+using TileCanvasFactory = std::function<SkCanvas*(int tileIndex, const SkIRect& tile)>;
+
+/**
+ *  Splits bounds into tiles of options.fTileSize and plays the picture back into a separate
+ *  canvas per tile, as if by SkCanvas::drawPicture(picture, matrix, nullptr). Each canvas is
+ *  translated so that the tile's top left corner is at its origin, and clipped to the tile.
+ *  Tiles are numbered in rows, starting at the top left.
+ *
+ *  Pictures recorded with an SkBBHFactory only replay the ops that intersect each tile. The
+ *  SkDrawables of a finished picture are snapshots, so nested pictures and drawables are safe to
+ *  replay from several tiles at once.
+ *
+ *  Unlike DrawPicture(), device-space effects such as dithering see tile-relative coordinates.
+ */
+SK_API void PlaybackTiles(const SkPicture* picture,
+                          const SkIRect& bounds,
+                          const SkMatrix* matrix,
+                          const TileCanvasFactory& makeCanvas,
+                          const Options& options = {});
+
+}  // namespace SkTiledRaster
+
+#endif
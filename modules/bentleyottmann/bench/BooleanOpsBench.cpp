@@ -0,0 +1,147 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "bench/Benchmark.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkString.h"
+#include "include/pathops/SkPathOps.h"
+#include "modules/bentleyottmann/include/BooleanOps.h"
+#include "src/base/SkRandom.h"
+
+#include <cmath>
+#include <functional>
+#include <utility>
+
+// Compares boolean_op from the Bentley-Ottmann module with Op from SkPathOps, on the same
+// line-only inputs. The inputs of the "ovals" and "rects" benchmarks match the ones in
+// bench/PathOpsBench.cpp, with the ovals flattened.
+namespace {
+SkPath polygon(SkPoint center, SkVector radii, int sides) {
+    SkPathBuilder builder;
+    for (int i = 0; i < sides; ++i) {
+        const float angle = 2 * SK_ScalarPI * i / sides;
+        const SkPoint p = {center.x() + radii.x() * std::cos(angle),
+                           center.y() + radii.y() * std::sin(angle)};
+        i == 0 ? builder.moveTo(p) : builder.lineTo(p);
+    }
+    return builder.close().detach();
+}
+
+enum class Engine {
+    kPathOps,
+    kBentleyOttmann,
+};
+
+class BooleanOpsBench : public Benchmark {
+public:
+    using MakePaths = std::function<void(SkPath* one, SkPath* two)>;
+
+    BooleanOpsBench(Engine engine, const char* suffix, SkPathOp op, int innerLoops,
+                    MakePaths makePaths)
+            : fEngine(engine)
+            , fOp(op)
+            , fInnerLoops(innerLoops)
+            , fMakePaths(std::move(makePaths)) {
+        fName.printf("%s_%s",
+                     engine == Engine::kPathOps ? "pathops_lines" : "bentleyottmann", suffix);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fMakePaths(&fOne, &fTwo);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            for (int j = 0; j < fInnerLoops; ++j) {
+                if (fEngine == Engine::kPathOps) {
+                    SkPath result;
+                    Op(fOne, fTwo, fOp, &result);
+                } else {
+                    bentleyottmann::boolean_op(fOne, fTwo, fOp);
+                }
+            }
+        }
+    }
+
+private:
+    const Engine fEngine;
+    const SkPathOp fOp;
+    const int fInnerLoops;
+    const MakePaths fMakePaths;
+    SkString fName;
+    SkPath fOne, fTwo;
+};
+
+void make_ovals(SkPath* one, SkPath* two) {
+    *one = polygon({0, 0}, {10, 20}, 64);
+    *two = polygon({0, 0}, {20, 10}, 64);
+}
+
+void make_rects(SkPath* one, SkPath* two) {
+    SkRandom rand;
+    SkScalar scale = 100;
+    for (int i = 0; i < 20; ++i) {
+        SkScalar x = rand.nextUScalar1() * scale;
+        SkScalar y = rand.nextUScalar1() * scale;
+        one->addRect({x, y, x + scale, y + scale});
+    }
+    two->reset();
+}
+
+// Neighboring regions of a map share their borders. Alternating rows of a jittered grid of quads
+// are in each path.
+void make_map(SkPath* one, SkPath* two) {
+    constexpr int kSize = 50;
+    SkRandom rand;
+    SkPoint grid[kSize + 1][kSize + 1];
+    for (int i = 0; i <= kSize; ++i) {
+        for (int j = 0; j <= kSize; ++j) {
+            grid[i][j] = {j * 4 + rand.nextRangeF(0, 2), i * 4 + rand.nextRangeF(0, 2)};
+        }
+    }
+    for (int i = 0; i < kSize; ++i) {
+        for (int j = 0; j < kSize; ++j) {
+            SkPath* path = i % 2 ? two : one;
+            path->moveTo(grid[i][j]);
+            path->lineTo(grid[i][j + 1]);
+            path->lineTo(grid[i + 1][j + 1]);
+            path->lineTo(grid[i + 1][j]);
+            path->close();
+        }
+    }
+}
+
+// Many overlapping polygons, where most of the work is finding the crossings.
+void make_hexagons(SkPath* one, SkPath* two) {
+    constexpr int kSize = 30;
+    SkRandom rand;
+    for (int i = 0; i < kSize; ++i) {
+        for (int j = 0; j < kSize; ++j) {
+            one->addPath(polygon({j * 10 + rand.nextRangeF(0, 2), i * 10.f}, {6, 6}, 6));
+            two->addPath(polygon({j * 10 + 4.f, i * 10 + rand.nextRangeF(0, 2)}, {5, 7}, 5));
+        }
+    }
+}
+}  // namespace
+
+#define BOOLEAN_OPS_BENCH(suffix, op, innerLoops, makePaths)                                     \
+    DEF_BENCH(return new BooleanOpsBench(Engine::kPathOps, suffix, op, innerLoops, makePaths);) \
+    DEF_BENCH(return new BooleanOpsBench(Engine::kBentleyOttmann, suffix, op, innerLoops,       \
+                                         makePaths);)
+
+BOOLEAN_OPS_BENCH("ovals_sect", kIntersect_SkPathOp, 100, make_ovals)
+BOOLEAN_OPS_BENCH("ovals_join", kUnion_SkPathOp, 100, make_ovals)
+BOOLEAN_OPS_BENCH("rects_simplify", kUnion_SkPathOp, 100, make_rects)
+BOOLEAN_OPS_BENCH("map_join", kUnion_SkPathOp, 1, make_map)
+BOOLEAN_OPS_BENCH("map_diff", kDifference_SkPathOp, 1, make_map)
+BOOLEAN_OPS_BENCH("hexagons_join", kUnion_SkPathOp, 1, make_hexagons)
@@ -0,0 +1,32 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#ifndef BooleanOps_DEFINED
+#define BooleanOps_DEFINED
+
+#include "include/core/SkPath.h"
+#include "include/pathops/SkPathOps.h"
+
+#include <optional>
+
+namespace bentleyottmann {
+
+// Computes op applied to one and two, honoring their fill types, like Op() from SkPathOps. The
+// paths may only contain lines; flatten any curves beforehand.
+//
+// The points are snapped to a grid of 1/1024 (the same one contour::Contours uses), and the
+// crossings found by the sweep are rounded to that grid. The result has no crossings or
+// overlapping edges, and is filled with the winding rule (inverse winding when the op selects
+// the outside of the paths).
+//
+// A return value of nullopt means that a path contains curves, or that its points are out of range
+// (their magnitude must be less than 2^19). In that case use Op() instead.
+std::optional<SkPath> boolean_op(const SkPath& one, const SkPath& two, SkPathOp op);
+
+// Like Simplify() from SkPathOps: removes the crossings and overlaps from path, with the same
+// restrictions as boolean_op.
+std::optional<SkPath> simplify(const SkPath& path);
+
+}  // namespace bentleyottmann
+
+#endif  // BooleanOps_DEFINED
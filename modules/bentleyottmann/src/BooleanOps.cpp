@@ -0,0 +1,517 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/BooleanOps.h"
+
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTo.h"
+#include "modules/bentleyottmann/include/BentleyOttmann1.h"
+#include "modules/bentleyottmann/include/Point.h"
+#include "modules/bentleyottmann/include/Segment.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace bentleyottmann {
+namespace {
+constexpr double kScaleFactor = 1024;
+
+// Keeps the 64-bit cross products below, and the Int96 comparisons in Segment, from overflowing.
+constexpr double kMaxCoordinate = 1 << 29;
+
+// Rounding a crossing to the grid moves the edges a little, which can make them cross other
+// edges. This bounds how many times the edges are split before giving up.
+constexpr int kMaxSnapRounds = 16;
+
+using Winding = std::array<int32_t, 2>;
+
+// An edge of the arrangement of the two paths. It goes from upper to lower, so it is left to right
+// when it is horizontal. The winding is how much crossing the edge changes the winding number of
+// each path: from left to right, or from above to below for horizontal edges.
+struct Edge {
+    Point upper;
+    Point lower;
+    Winding winding;
+
+    bool isHorizontal() const { return upper.y == lower.y; }
+    Segment segment() const { return {upper, lower}; }
+};
+
+bool operator<(const Edge& e0, const Edge& e1) {
+    return std::tie(e0.upper, e0.lower) < std::tie(e1.upper, e1.lower);
+}
+
+bool same_points(const Edge& e0, const Edge& e1) {
+    return e0.upper == e1.upper && e0.lower == e1.lower;
+}
+
+// Makes the edge for a path going from p0 to p1 with multiplicity times for each path. A path
+// going down changes the winding by +1 from left to right, and a path going right changes it by
+// -1 from above to below.
+Edge make_edge(Point p0, Point p1, Winding multiplicity) {
+    const bool forward = p0 < p1;
+    Edge edge{forward ? p0 : p1, forward ? p1 : p0, multiplicity};
+    const int32_t sign = (forward != edge.isHorizontal()) ? 1 : -1;
+    for (int32_t& w : edge.winding) {
+        w *= sign;
+    }
+    return edge;
+}
+
+// The inverse of make_edge: how many times the paths go from upper to lower.
+Winding multiplicity(const Edge& edge) {
+    return edge.isHorizontal() ? Winding{-edge.winding[0], -edge.winding[1]} : edge.winding;
+}
+
+int64_t cross(Point v0, Point v1) {
+    return SkToS64(v0.x) * v1.y - SkToS64(v0.y) * v1.x;
+}
+
+bool add_path(const SkPath& path, int index, std::vector<Edge>* edges) {
+    auto toGrid = [](SkPoint p, Point* out) {
+        const double x = std::round(p.x() * kScaleFactor),
+                     y = std::round(p.y() * kScaleFactor);
+        // Written so that NaNs fail.
+        if (!(std::abs(x) < kMaxCoordinate && std::abs(y) < kMaxCoordinate)) {
+            return false;
+        }
+        *out = {static_cast<int32_t>(x), static_cast<int32_t>(y)};
+        return true;
+    };
+
+    Winding once = {0, 0};
+    once[index] = 1;
+
+    // Force closing the contours adds the lines that close them.
+    SkPath::Iter iter(path, true);
+    SkPoint pts[4];
+    for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb;) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+            case SkPath::kClose_Verb:
+                break;
+            case SkPath::kLine_Verb: {
+                Point p0, p1;
+                if (!toGrid(pts[0], &p0) || !toGrid(pts[1], &p1)) {
+                    return false;
+                }
+                if (p0 != p1) {
+                    edges->push_back(make_edge(p0, p1, once));
+                }
+                break;
+            }
+            case SkPath::kQuad_Verb:
+            case SkPath::kConic_Verb:
+            case SkPath::kCubic_Verb:
+            case SkPath::kDone_Verb:
+                return false;
+        }
+    }
+    return true;
+}
+
+// Sorts the edges, and merges the edges with the same end points. Edges that no longer change the
+// winding of either path are removed.
+void merge_coincident_edges(std::vector<Edge>* edges) {
+    std::sort(edges->begin(), edges->end());
+    auto out = edges->begin();
+    for (auto e = edges->begin(); e != edges->end(); ++e) {
+        if (out != edges->begin() && same_points(*(out - 1), *e)) {
+            (out - 1)->winding[0] += e->winding[0];
+            (out - 1)->winding[1] += e->winding[1];
+        } else {
+            *out++ = *e;
+        }
+    }
+    edges->erase(out, edges->end());
+
+    auto noWinding = [](const Edge& e) { return e.winding[0] == 0 && e.winding[1] == 0; };
+    edges->erase(std::remove_if(edges->begin(), edges->end(), noWinding), edges->end());
+}
+
+struct Split {
+    size_t edge;
+    Point point;
+};
+
+// Replaces each edge by the chain of edges through its split points. Returns false if no edge
+// was split.
+bool split_edges(std::vector<Split> splits, std::vector<Edge>* edges) {
+    if (splits.empty()) {
+        return false;
+    }
+
+    // Order the split points of each edge from its upper to its lower point. Points rounded to the
+    // same y are ordered in the direction the edge goes along x.
+    auto alongEdge = [edges](const Split& s0, const Split& s1) {
+        if (s0.edge != s1.edge) {
+            return s0.edge < s1.edge;
+        }
+        if (s0.point.y != s1.point.y) {
+            return s0.point.y < s1.point.y;
+        }
+        const Edge& e = (*edges)[s0.edge];
+        return e.lower.x < e.upper.x ? s1.point.x < s0.point.x : s0.point.x < s1.point.x;
+    };
+    std::sort(splits.begin(), splits.end(), alongEdge);
+
+    const size_t originalSize = edges->size();
+    for (auto s = splits.begin(); s != splits.end();) {
+        const size_t index = s->edge;
+        const Edge edge = (*edges)[index];
+        const Winding edgeMultiplicity = multiplicity(edge);
+
+        std::vector<Edge> chain;
+        Point last = edge.upper;
+        for (; s != splits.end() && s->edge == index; ++s) {
+            if (s->point != last && s->point != edge.lower) {
+                chain.push_back(make_edge(last, s->point, edgeMultiplicity));
+                last = s->point;
+            }
+        }
+        if (chain.empty()) {
+            continue;
+        }
+        chain.push_back(make_edge(last, edge.lower, edgeMultiplicity));
+
+        (*edges)[index] = chain.front();
+        edges->insert(edges->end(), chain.begin() + 1, chain.end());
+    }
+    return edges->size() != originalSize;
+}
+
+// Finds the vertices that are in the interior of an edge. A vertex can only be in the interior of
+// an edge if the edge goes through more than two grid points.
+std::vector<Split> find_vertices_on_edges(const std::vector<Edge>& edges) {
+    std::vector<Point> byRow;
+    byRow.reserve(2 * edges.size());
+    for (const Edge& e : edges) {
+        byRow.push_back(e.upper);
+        byRow.push_back(e.lower);
+    }
+    std::sort(byRow.begin(), byRow.end());
+    byRow.erase(std::unique(byRow.begin(), byRow.end()), byRow.end());
+
+    auto columnLess = [](Point p0, Point p1) {
+        return std::tie(p0.x, p0.y) < std::tie(p1.x, p1.y);
+    };
+    std::vector<Point> byColumn = byRow;
+    std::sort(byColumn.begin(), byColumn.end(), columnLess);
+
+    std::vector<Split> splits;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const Edge& e = edges[i];
+        const Point d = e.lower - e.upper;
+        if (d.y == 0 || d.x == 0) {
+            // Horizontal and vertical edges directly find the vertices between their end points.
+            const auto& vertices = d.y == 0 ? byRow : byColumn;
+            auto less = [&](Point p0, Point p1) { return d.y == 0 ? p0 < p1 : columnLess(p0, p1); };
+            auto v = std::upper_bound(vertices.begin(), vertices.end(), e.upper, less);
+            for (; v != vertices.end() && less(*v, e.lower); ++v) {
+                splits.push_back({i, *v});
+            }
+            continue;
+        }
+
+        const int32_t gridPoints = std::gcd(std::abs(d.x), d.y);
+        if (gridPoints == 1) {
+            continue;
+        }
+        const Point step = {d.x / gridPoints, d.y / gridPoints};
+
+        // Either look up each grid point on the edge, or check all the vertices on the rows between
+        // the end points, whichever is fewer.
+        auto rowsBegin = std::upper_bound(byRow.begin(), byRow.end(), Point{INT32_MAX, e.upper.y}),
+             rowsEnd   = std::lower_bound(byRow.begin(), byRow.end(), Point{INT32_MIN, e.lower.y});
+        if (gridPoints - 1 < rowsEnd - rowsBegin) {
+            Point p = e.upper;
+            for (int32_t k = 1; k < gridPoints; ++k) {
+                p = p + step;
+                if (std::binary_search(rowsBegin, rowsEnd, p)) {
+                    splits.push_back({i, p});
+                }
+            }
+        } else {
+            for (auto v = rowsBegin; v != rowsEnd; ++v) {
+                if (cross(step, *v - e.upper) == 0) {
+                    splits.push_back({i, *v});
+                }
+            }
+        }
+    }
+    return splits;
+}
+
+// Splits the edges until none of them cross. Returns false if the crossings can't be found.
+bool split_crossing_edges(std::vector<Edge>* edges) {
+    for (int round = 0;; ++round) {
+        merge_coincident_edges(edges);
+        if (edges->empty()) {
+            return true;
+        }
+
+        // Overlapping collinear edges become coincident edges once they are split at each other's
+        // end points. The sweep only finds crossings of edges that don't overlap.
+        if (split_edges(find_vertices_on_edges(*edges), edges)) {
+            merge_coincident_edges(edges);
+        }
+
+        std::vector<Segment> segments;
+        segments.reserve(edges->size());
+        for (const Edge& e : *edges) {
+            segments.push_back(e.segment());
+        }
+        std::optional<std::vector<Crossing>> crossings = bentley_ottmann_1(segments);
+        if (!crossings) {
+            return false;
+        }
+        if (crossings->empty()) {
+            return true;
+        }
+        if (round + 1 == kMaxSnapRounds) {
+            return false;
+        }
+
+        std::vector<Split> splits;
+        splits.reserve(2 * crossings->size());
+        for (const Crossing& crossing : *crossings) {
+            for (const Segment& s : {crossing.s0, crossing.s1}) {
+                const Edge key{s.upper(), s.lower(), {0, 0}};
+                auto e = std::lower_bound(edges->begin(), edges->end(), key);
+                SkASSERT(e != edges->end() && same_points(*e, key));
+                splits.push_back({SkToSizeT(e - edges->begin()), crossing.crossing});
+            }
+        }
+        split_edges(std::move(splits), edges);
+    }
+}
+
+// The edge of the result from "from" to "to". The result is on the left of the edge, going
+// around the result counterclockwise on the screen.
+struct BoundaryEdge {
+    Point from;
+    Point to;
+};
+
+// Sweeps down the non-crossing edges, and keeps the edges where the winding numbers on their two
+// sides don't select the same side of the result.
+template <typename Inside>
+std::vector<BoundaryEdge> find_boundary(const std::vector<Edge>& edges, Inside inside) {
+    std::vector<int32_t> rows;
+    rows.reserve(2 * edges.size());
+    for (const Edge& e : edges) {
+        rows.push_back(e.upper.y);
+        rows.push_back(e.lower.y);
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    std::vector<BoundaryEdge> boundary;
+    auto addBoundary = [&](const Edge& e, Winding before, bool lowerToUpper) {
+        const Winding after = {before[0] + e.winding[0], before[1] + e.winding[1]};
+        const bool insideBefore = inside(before);
+        if (insideBefore != inside(after)) {
+            if (insideBefore == lowerToUpper) {
+                boundary.push_back({e.lower, e.upper});
+            } else {
+                boundary.push_back({e.upper, e.lower});
+            }
+        }
+    };
+
+    // The active edges in the band below the current row, sorted from left to right, and the
+    // winding numbers to their left.
+    std::vector<size_t> active;
+    std::vector<Winding> windingToTheLeft;
+    auto windingAt = [&](size_t position) {
+        return position == 0 ? Winding{0, 0} : windingToTheLeft[position - 1];
+    };
+
+    SkASSERT(std::is_sorted(edges.begin(), edges.end()));
+    size_t nextEdge = 0;
+    for (int32_t y : rows) {
+        // The horizontal edges on this row are below the band above it.
+        const size_t rowStart = nextEdge;
+        for (; nextEdge < edges.size() && edges[nextEdge].upper.y == y; ++nextEdge) {
+            const Edge& e = edges[nextEdge];
+            if (e.isHorizontal()) {
+                auto notRightOf = [&](size_t i) {
+                    return !point_less_than_segment_in_x(e.upper, edges[i].segment());
+                };
+                auto left = std::partition_point(active.begin(), active.end(), notRightOf);
+                addBoundary(e, windingAt(left - active.begin()), false);
+            }
+        }
+
+        auto ended = [&](size_t i) { return edges[i].lower.y == y; };
+        active.erase(std::remove_if(active.begin(), active.end(), ended), active.end());
+
+        // The order of the edges that continue through this row doesn't change, because none of
+        // the edges cross. Edges that meet on this row are ordered below it.
+        auto leftOf = [&](size_t i0, size_t i1) {
+            const Segment s0 = edges[i0].segment(),
+                          s1 = edges[i1].segment();
+            if (less_than_at(s0, s1, y)) {
+                return true;
+            }
+            if (less_than_at(s1, s0, y)) {
+                return false;
+            }
+            return less_than_at(s0, s1, std::min(s0.p1.y, s1.p1.y));
+        };
+        std::vector<size_t> starting;
+        for (size_t i = rowStart; i < nextEdge; ++i) {
+            if (!edges[i].isHorizontal()) {
+                active.insert(std::upper_bound(active.begin(), active.end(), i, leftOf), i);
+                starting.push_back(i);
+            }
+        }
+
+        windingToTheLeft.resize(active.size());
+        Winding winding = {0, 0};
+        for (size_t position = 0; position < active.size(); ++position) {
+            const Edge& e = edges[active[position]];
+            if (e.upper.y == y) {
+                addBoundary(e, winding, true);
+            }
+            winding[0] += e.winding[0];
+            winding[1] += e.winding[1];
+            windingToTheLeft[position] = winding;
+        }
+    }
+    SkASSERT(active.empty());
+    return boundary;
+}
+
+// Links the boundary edges into contours, dropping the points in the middle of straight lines.
+SkPath link_boundary(std::vector<BoundaryEdge> boundary, SkPathFillType fillType) {
+    auto fromLess = [](const BoundaryEdge& e0, const BoundaryEdge& e1) {
+        return e0.from < e1.from;
+    };
+    std::sort(boundary.begin(), boundary.end(), fromLess);
+    std::vector<bool> used(boundary.size(), false);
+
+    // Every vertex has as many boundary edges going into it as out of it, so following unused
+    // edges always leads back to the start of the contour.
+    auto nextUnused = [&](Point from) -> std::optional<size_t> {
+        auto e = std::lower_bound(boundary.begin(), boundary.end(), BoundaryEdge{from, from},
+                                  fromLess);
+        for (; e != boundary.end() && e->from == from; ++e) {
+            const size_t index = e - boundary.begin();
+            if (!used[index]) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    };
+
+    auto isStraight = [](Point p0, Point p1, Point p2) {
+        const Point d0 = p1 - p0,
+                    d1 = p2 - p1;
+        return cross(d0, d1) == 0 && SkToS64(d0.x) * d1.x + SkToS64(d0.y) * d1.y > 0;
+    };
+
+    SkPathBuilder builder(fillType);
+    std::vector<Point> contour;
+    for (size_t start = 0; start < boundary.size(); ++start) {
+        if (used[start]) {
+            continue;
+        }
+        contour.clear();
+        contour.push_back(boundary[start].from);
+        std::optional<size_t> e = start;
+        while (e) {
+            used[*e] = true;
+            const Point to = boundary[*e].to;
+            if (contour.size() >= 2 && isStraight(contour.end()[-2], contour.back(), to)) {
+                contour.back() = to;
+            } else {
+                contour.push_back(to);
+            }
+            e = to == boundary[start].from ? std::nullopt : nextUnused(to);
+        }
+
+        // The last point is the start point again.
+        contour.pop_back();
+        if (contour.size() >= 3 && isStraight(contour.back(), contour.front(), contour[1])) {
+            contour.erase(contour.begin());
+        }
+        if (contour.size() >= 3 && isStraight(contour.end()[-2], contour.back(), contour.front())) {
+            contour.pop_back();
+        }
+        if (contour.size() < 3) {
+            continue;
+        }
+
+        auto toSkPoint = [](Point p) {
+            return SkPoint::Make(p.x / kScaleFactor, p.y / kScaleFactor);
+        };
+        builder.moveTo(toSkPoint(contour.front()));
+        for (size_t i = 1; i < contour.size(); ++i) {
+            builder.lineTo(toSkPoint(contour[i]));
+        }
+        builder.close();
+    }
+    return builder.detach();
+}
+
+bool is_inside(int32_t winding, SkPathFillType fillType) {
+    return SkPathFillType_IsEvenOdd(fillType) ? (winding & 1) != 0 : winding != 0;
+}
+
+bool apply_op(SkPathOp op, bool one, bool two) {
+    switch (op) {
+        case kDifference_SkPathOp:        return one && !two;
+        case kIntersect_SkPathOp:         return one && two;
+        case kUnion_SkPathOp:             return one || two;
+        case kXOR_SkPathOp:               return one != two;
+        case kReverseDifference_SkPathOp: return two && !one;
+    }
+    SkUNREACHABLE;
+}
+}  // namespace
+
+std::optional<SkPath> boolean_op(const SkPath& one, const SkPath& two, SkPathOp op) {
+    std::vector<Edge> edges;
+    edges.reserve(one.countPoints() + two.countPoints());
+    if (!add_path(one, 0, &edges) || !add_path(two, 1, &edges)) {
+        return std::nullopt;
+    }
+
+    if (!split_crossing_edges(&edges)) {
+        return std::nullopt;
+    }
+
+    // Far away from the paths, only the inverse fills are inside. When the result is inside there,
+    // its outside is found instead, and filled inversely.
+    const SkPathFillType oneFill = one.getFillType(),
+                         twoFill = two.getFillType();
+    const bool inverse = apply_op(op,
+                                  SkPathFillType_IsInverse(oneFill),
+                                  SkPathFillType_IsInverse(twoFill));
+    auto inside = [&](Winding winding) {
+        const bool inOne = is_inside(winding[0], oneFill) != SkPathFillType_IsInverse(oneFill),
+                   inTwo = is_inside(winding[1], twoFill) != SkPathFillType_IsInverse(twoFill);
+        return apply_op(op, inOne, inTwo) != inverse;
+    };
+
+    return link_boundary(find_boundary(edges, inside),
+                         inverse ? SkPathFillType::kInverseWinding : SkPathFillType::kWinding);
+}
+
+std::optional<SkPath> simplify(const SkPath& path) {
+    return boolean_op(path, SkPath(), kUnion_SkPathOp);
+}
+
+}  // namespace bentleyottmann
@@ -47,7 +47,13 @@ void EventQueue::add(const Event& event) {
 }
 
 void EventQueue::addCrossing(Point crossingPoint, const Segment& s0, const Segment& s1) {
-    this->add({crossingPoint, Cross{s0, s1}});
+    // Rounding can move the crossing point to, or before, the current event point, or to, or past,
+    // the end of one of the segments. The crossing is still reported, but the sweep can't handle
+    // it.
+    if (fLastEventPoint < crossingPoint &&
+        crossingPoint < s0.lower() && crossingPoint < s1.lower()) {
+        this->add({crossingPoint, Cross{s0, s1}});
+    }
     fCrossings.push_back({s0, s1, crossingPoint});
 }
 
@@ -39,17 +39,25 @@ void SweepLine::verify(int32_t y) const {
 }
 
 void SweepLine::handleDeletions(Point eventPoint, const DeletionSegmentSet& removing) {
+    // All the segments in the sweep line start before the event point, so the only segments with
+    // an end point at the event point are the ones ending there. Checking the end points directly
+    // avoids finding the lower point of every segment in the sweep line for every event.
+    auto endsAtEvent = [eventPoint](const Segment& s) {
+        return s.p0 == eventPoint || s.p1 == eventPoint;
+    };
+
     std::vector<Segment>::iterator newEnd;
     if (removing.empty()) {
         // Remove ending segments
-        auto toRemove = [eventPoint](Segment s) {
-            return s.lower() == eventPoint;
-        };
-        newEnd = std::remove_if(fSweepLine.begin(), fSweepLine.end(), toRemove);
+        newEnd = std::remove_if(fSweepLine.begin(), fSweepLine.end(), endsAtEvent);
     } else {
-        // Remove all ending and crossing segments.
-        auto toRemove = [eventPoint, &removing](Segment s) {
-            return s.lower() == eventPoint || removing.find(s) != removing.end();
+        // Remove all ending and crossing segments. The crossing segments are copies of segments
+        // in the sweep line, so their end points match exactly.
+        auto toRemove = [&](const Segment& s) {
+            return endsAtEvent(s) || std::any_of(removing.begin(), removing.end(),
+                                                 [&s](const Segment& r) {
+                                                     return r.p0 == s.p0 && r.p1 == s.p1;
+                                                 });
         };
         newEnd = std::remove_if(fSweepLine.begin(), fSweepLine.end(), toRemove);
     }
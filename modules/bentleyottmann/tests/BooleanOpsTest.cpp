@@ -0,0 +1,202 @@
+// Copyright 2026 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/BooleanOps.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkRect.h"
+#include "include/pathops/SkPathOps.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkPathPriv.h"
+#include "tests/Test.h"
+
+#include <cmath>
+#include <optional>
+
+using namespace bentleyottmann;
+
+namespace {
+SkPath polygon(SkPoint center, SkVector radii, int sides, float startAngle = 0,
+               bool reverse = false) {
+    SkPathBuilder builder;
+    for (int i = 0; i < sides; ++i) {
+        const float angle = startAngle + (reverse ? -2 : 2) * SK_ScalarPI * i / sides;
+        const SkPoint p = {center.x() + radii.x() * std::cos(angle),
+                           center.y() + radii.y() * std::sin(angle)};
+        i == 0 ? builder.moveTo(p) : builder.lineTo(p);
+    }
+    return builder.close().detach();
+}
+
+SkPath star(SkPoint center, float radius, SkPathFillType fillType) {
+    SkPathBuilder builder(fillType);
+    for (int i = 0; i < 5; ++i) {
+        const float angle = 4 * SK_ScalarPI * i / 5;
+        const SkPoint p = {center.x() + radius * std::cos(angle),
+                           center.y() + radius * std::sin(angle)};
+        i == 0 ? builder.moveTo(p) : builder.lineTo(p);
+    }
+    return builder.close().detach();
+}
+
+// Counts the points of a grid over bounds where the two paths don't agree. The grid is offset so
+// its points are not on the edges of the paths.
+int count_differences(const SkPath& expected, const SkPath& actual, const SkRect& bounds) {
+    int differences = 0;
+    for (float y = bounds.top() + 0.0137f; y < bounds.bottom(); y += bounds.height() / 101) {
+        for (float x = bounds.left() + 0.0113f; x < bounds.right(); x += bounds.width() / 103) {
+            differences += expected.contains(x, y) != actual.contains(x, y);
+        }
+    }
+    return differences;
+}
+
+void check_ops(skiatest::Reporter* reporter, const SkPath& one, const SkPath& two,
+               const char* name) {
+    SkRect bounds = one.getBounds();
+    bounds.join(two.getBounds());
+    bounds.outset(1, 1);
+    for (SkPathOp op : {kDifference_SkPathOp, kIntersect_SkPathOp, kUnion_SkPathOp,
+                        kXOR_SkPathOp, kReverseDifference_SkPathOp}) {
+        SkPath expected;
+        REPORTER_ASSERT(reporter, Op(one, two, op, &expected));
+        std::optional<SkPath> actual = boolean_op(one, two, op);
+        REPORTER_ASSERT(reporter, actual.has_value(), "%s op %d", name, op);
+        if (actual) {
+            REPORTER_ASSERT(reporter, expected.isInverseFillType() == actual->isInverseFillType(),
+                            "%s op %d", name, op);
+            REPORTER_ASSERT(reporter, count_differences(expected, *actual, bounds) == 0,
+                            "%s op %d", name, op);
+        }
+    }
+}
+}  // namespace
+
+DEF_TEST(BO_boolean_op_Basic, reporter) {
+    check_ops(reporter,
+              SkPath::Rect({0, 0, 10, 10}),
+              SkPath::Rect({5, 5, 15, 15}),
+              "overlapping rects");
+
+    // Edges along the same lines, going in the same and in opposite directions.
+    check_ops(reporter,
+              SkPath::Rect({0, 0, 10, 10}, SkPathDirection::kCCW),
+              SkPath::Rect({0, 5, 10, 15}),
+              "shared edges");
+    check_ops(reporter,
+              SkPath::Rect({0, 0, 10, 10}),
+              SkPath::Rect({2, 0, 8, 10}),
+              "overlapping edges");
+
+    check_ops(reporter,
+              polygon({0, 0}, {10, 20}, 64),
+              polygon({0, 0}, {20, 10}, 64),
+              "ovals");
+
+    // Self-crossing paths with both fill rules, and an inverse fill.
+    check_ops(reporter,
+              star({0, 0}, 50, SkPathFillType::kWinding),
+              polygon({10, 0}, {30, 30}, 7),
+              "winding star");
+    check_ops(reporter,
+              star({0, 0}, 50, SkPathFillType::kEvenOdd),
+              polygon({10, 0}, {30, 30}, 7),
+              "even odd star");
+    SkPath inverse = polygon({0, 0}, {20, 20}, 9, 0.1f);
+    inverse.setFillType(SkPathFillType::kInverseWinding);
+    check_ops(reporter, star({0, 0}, 50, SkPathFillType::kEvenOdd), inverse, "inverse");
+}
+
+DEF_TEST(BO_boolean_op_Random, reporter) {
+    SkRandom random;
+    SkPath one, two;
+    for (int i = 0; i < 20; ++i) {
+        one.addPath(polygon({random.nextRangeF(0, 100), random.nextRangeF(0, 100)},
+                            {random.nextRangeF(5, 35), random.nextRangeF(5, 35)},
+                            random.nextRangeU(3, 12)));
+        two.addPath(polygon({random.nextRangeF(0, 100), random.nextRangeF(0, 100)},
+                            {random.nextRangeF(5, 35), random.nextRangeF(5, 35)},
+                            random.nextRangeU(3, 12),
+                            random.nextRangeF(0, 1),
+                            /*reverse=*/true));
+    }
+    check_ops(reporter, one, two, "random polygons");
+}
+
+DEF_TEST(BO_boolean_op_SharedBorders, reporter) {
+    // A jittered grid of quads where neighbors share their edges, like the regions of a map. The
+    // union of all of them is a single contour through the 40 points around the grid.
+    SkRandom random;
+    SkPoint grid[11][11];
+    for (int i = 0; i <= 10; ++i) {
+        for (int j = 0; j <= 10; ++j) {
+            grid[i][j] = {j * 4 + random.nextRangeF(0, 1), i * 4 + random.nextRangeF(0, 1)};
+        }
+    }
+    SkPath one, two;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            SkPath& path = (i + j) % 3 == 0 ? two : one;
+            path.moveTo(grid[i][j]);
+            path.lineTo(grid[i][j + 1]);
+            path.lineTo(grid[i + 1][j + 1]);
+            path.lineTo(grid[i + 1][j]);
+            path.close();
+        }
+    }
+    check_ops(reporter, one, two, "shared borders");
+
+    std::optional<SkPath> all = boolean_op(one, two, kUnion_SkPathOp);
+    REPORTER_ASSERT(reporter, all.has_value());
+    if (all) {
+        int contours = 0;
+        for (auto [verb, pts, weight] : SkPathPriv::Iterate(*all)) {
+            contours += verb == SkPathVerb::kMove;
+        }
+        REPORTER_ASSERT(reporter, contours == 1);
+        REPORTER_ASSERT(reporter, all->countPoints() == 40);
+    }
+
+    SkPath row;
+    for (int j = 0; j < 10; ++j) {
+        row.addRect({j * 4.f, 0, j * 4.f + 4, 4});
+    }
+    std::optional<SkPath> simplified = simplify(row);
+    REPORTER_ASSERT(reporter, simplified.has_value());
+    if (simplified) {
+        REPORTER_ASSERT(reporter, simplified->countPoints() == 4);
+        REPORTER_ASSERT(reporter, simplified->getBounds() == SkRect::MakeWH(40, 4));
+    }
+}
+
+DEF_TEST(BO_boolean_op_Cancel, reporter) {
+    // Contours going in opposite directions cancel each other with the winding rule.
+    SkPath path = polygon({0, 0}, {20, 20}, 9);
+    path.addPath(SkPath::Rect({-10, -10, 10, 10}));
+    path.addPath(polygon({0, 0}, {20, 20}, 9, 0, /*reverse=*/true));
+    std::optional<SkPath> simplified = simplify(path);
+    REPORTER_ASSERT(reporter, simplified.has_value());
+    if (simplified) {
+        SkPath expected = SkPath::Rect({-10, -10, 10, 10});
+        REPORTER_ASSERT(reporter,
+                        count_differences(expected, *simplified, {-21, -21, 21, 21}) == 0);
+    }
+}
+
+DEF_TEST(BO_boolean_op_Unsupported, reporter) {
+    const SkPath rect = SkPath::Rect({0, 0, 10, 10});
+
+    SkPath curve;
+    curve.quadTo(10, 10, 20, 0);
+    REPORTER_ASSERT(reporter, !boolean_op(curve, rect, kUnion_SkPathOp).has_value());
+    REPORTER_ASSERT(reporter, !boolean_op(rect, SkPath::Circle(0, 0, 5), kUnion_SkPathOp));
+
+    // Too large for the grid.
+    REPORTER_ASSERT(reporter, !boolean_op(SkPath::Rect({0, 0, 1e6f, 1}), rect, kUnion_SkPathOp));
+
+    // Empty paths are fine.
+    std::optional<SkPath> empty = boolean_op(SkPath(), SkPath(), kUnion_SkPathOp);
+    REPORTER_ASSERT(reporter, empty.has_value() && empty->isEmpty());
+}
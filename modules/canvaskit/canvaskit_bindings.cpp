@@ -123,6 +123,13 @@
 #include "include/pathops/SkPathOps.h"
 #endif
 
+#ifdef CK_ENABLE_THREADS
+#include "include/core/SkExecutor.h"
+#include "include/utils/SkTiledRaster.h"
+#include <emscripten/threading.h>
+#include <algorithm>
+#endif
+
 #if defined(CK_INCLUDE_RUNTIME_EFFECT)
 #include "include/sksl/SkSLDebugTrace.h"
 #endif
@@ -207,6 +214,36 @@ std::unique_ptr<SkCodec> DecodeImageData(sk_sp<SkData> data) {
     return nullptr;
 }
 
+#ifdef CK_ENABLE_THREADS
+// The workers are started with the module (see PTHREAD_POOL_SIZE in BUILD.gn), because a worker
+// created later does not run until the main thread returns to the browser's event loop.
+static SkExecutor* ThreadPool() {
+    static SkExecutor* pool = [] {
+        int threads = std::min(emscripten_num_logical_cores() - 1, CK_WORKER_THREADS);
+        return threads > 0 ? SkExecutor::MakeFIFOThreadPool(threads).release() : nullptr;
+    }();
+    return pool;
+}
+
+// Pictures drawn into a raster surface outside of any save() or clip are rasterized in tiles on
+// the workers. Anything else is drawn on the calling thread, as in the single-threaded build.
+static void DrawPicture(SkCanvas& canvas, const sk_sp<SkPicture>& picture) {
+    SkSurface* surface = canvas.getSurface();
+    SkExecutor* executor = ThreadPool();
+    if (picture && executor && surface && canvas.getSaveCount() == 1 &&
+        canvas.isClipRect() && canvas.getDeviceClipBounds() == surface->imageInfo().bounds()) {
+        SkTiledRaster::Options options;
+        options.fTileSize = {256, 256};
+        options.fExecutor = executor;
+        SkMatrix matrix = canvas.getTotalMatrix();
+        if (SkTiledRaster::DrawPicture(picture.get(), surface, &matrix, options)) {
+            return;
+        }
+    }
+    canvas.drawPicture(picture);
+}
+#endif // CK_ENABLE_THREADS
+
 struct OptionalMatrix : SkMatrix {
     OptionalMatrix(WASMPointerF32 mPtr) {
         if (mPtr) {
@@ -1044,6 +1081,15 @@ static Uint8Array encodeImage(GrDirectContext* dContext,
 }
 
 EMSCRIPTEN_BINDINGS(Skia) {
+#ifdef CK_ENABLE_THREADS
+    constant("threads", true);
+    // Work split up with SkTaskGroup (blurs, pixel conversion, codecs, rescaling) uses the
+    // default executor.
+    if (SkExecutor* executor = ThreadPool()) {
+        SkExecutor::SetDefault(executor);
+    }
+#endif // CK_ENABLE_THREADS
+
 #ifdef ENABLE_GPU
     constant("gpu", true);
     function("_MakeGrContext", &MakeGrContext);
@@ -1370,7 +1416,11 @@ EMSCRIPTEN_BINDINGS(Skia) {
         }))
         // Of note, picture is *not* what is colloquially thought of as a "picture", what we call
         // a bitmap. An SkPicture is a series of draw commands.
+#ifdef CK_ENABLE_THREADS
+        .function("_drawPicture", &DrawPicture)
+#else
         .function("_drawPicture", select_overload<void (const sk_sp<SkPicture>&)>(&SkCanvas::drawPicture))
+#endif
         .function("_drawPoints", optional_override([](SkCanvas& self, SkCanvas::PointMode mode,
                                                      WASMPointerF32 pptr,
                                                      int count, SkPaint& paint)->void {
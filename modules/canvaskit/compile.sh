@@ -140,6 +140,19 @@ if [[ $@ == *enable_debugger* ]]; then
   DEBUGGER_ENABLED="true"
 fi
 
+ENABLE_SIMD="false"
+if [[ $@ == *simd* ]]; then
+  echo "Building with WebAssembly SIMD128"
+  ENABLE_SIMD="true"
+fi
+
+ENABLE_THREADS="false"
+if [[ $@ == *threads* ]]; then
+  # Needs SharedArrayBuffer, i.e. a cross-origin isolated page.
+  echo "Building with pthreads for multi-threaded CPU rendering"
+  ENABLE_THREADS="true"
+fi
+
 GN_SHAPER="skia_use_icu=true skia_use_client_icu=false skia_use_libgrapheme=false skia_use_icu4x=false skia_use_system_icu=false skia_use_harfbuzz=true skia_use_system_harfbuzz=false"
 if [[ $@ == *primitive_shaper* ]] || [[ $@ == *no_font* ]]; then
   echo "Using the primitive shaper instead of the harfbuzz/icu one"
@@ -258,6 +271,8 @@ echo "Compiling"
   skia_canvaskit_enable_embedded_font=${ENABLE_EMBEDDED_FONT} \
   skia_canvaskit_enable_alias_font=${ENABLE_ALIAS_FONT} \
   skia_canvaskit_legacy_draw_vertices_blend_mode=${LEGACY_DRAW_VERTICES} \
+  skia_canvaskit_enable_threads=${ENABLE_THREADS} \
+  skia_canvaskit_enable_simd=${ENABLE_SIMD} \
   skia_canvaskit_enable_debugger=${DEBUGGER_ENABLED} \
   skia_canvaskit_enable_paragraph=${ENABLE_PARAGRAPH} \
   skia_canvaskit_enable_webgl=${ENABLE_WEBGL} \
@@ -80,6 +80,10 @@
       // We will not have a canvas if this a GPU build, for example.
       if (this._canvas) {
         var pixels = new Uint8ClampedArray(CanvasKit.HEAPU8.buffer, this._pixelPtr, this._pixelLen);
+        // In threaded builds the heap is a SharedArrayBuffer, which ImageData does not accept.
+        if (CanvasKit.threads) {
+          pixels = pixels.slice();
+        }
         var imageData = new ImageData(pixels, this._width, this._height);
 
         if (!dirtyRect) {
@@ -852,6 +852,7 @@ var CanvasKit = {
   // Constants and Enums
   gpu: {},
   skottie: {},
+  threads: {},
 
   TRANSPARENT: {},
   BLACK: {},
@@ -407,7 +407,7 @@ CanvasKit.onRuntimeInitialized = function() {
     return this._makeShaderOptions(xTileMode, yTileMode, filterMode, mipmapMode, localMatrixPtr);
   };
 
-  function readPixels(source, srcX, srcY, imageInfo, destMallocObj, bytesPerRow, grCtx) {
+  function readPixels(source, srcX, srcY, imageInfo, dest, bytesPerRow, grCtx) {
     if (!bytesPerRow) {
       bytesPerRow = 4 * imageInfo['width'];
       if (imageInfo['colorType'] === CanvasKit.ColorType.RGBA_F16) {
@@ -418,9 +418,18 @@ CanvasKit.onRuntimeInitialized = function() {
       }
     }
     var pBytes = bytesPerRow * imageInfo.height;
+    // dest can be a Malloc obj or a TypedArray on the WASM heap, which are read into directly,
+    // or any other TypedArray, which is filled from a scratch buffer that is reused across calls.
+    var inHeap = wasMalloced(dest);
     var pPtr;
-    if (destMallocObj) {
-      pPtr = destMallocObj['byteOffset'];
+    if (inHeap) {
+      pPtr = dest['byteOffset'];
+    } else if (dest) {
+      if (dest.byteLength < pBytes) {
+        Debug('dest is too small to hold the pixels');
+        return null;
+      }
+      pPtr = scratchPixelsPtr(pBytes);
     } else {
       pPtr = CanvasKit._malloc(pBytes);
     }
@@ -433,15 +442,21 @@ CanvasKit.onRuntimeInitialized = function() {
     }
     if (!rv) {
       Debug('Could not read pixels with the given inputs');
-      if (!destMallocObj) {
+      if (!dest) {
         CanvasKit._free(pPtr);
       }
       return null;
     }
 
     // If the user provided us a buffer to copy into, we don't need to allocate a new TypedArray.
-    if (destMallocObj) {
-      return destMallocObj['toTypedArray'](); // Return the typed array wrapper w/o allocating.
+    if (dest) {
+      if (!inHeap) {
+        new Uint8Array(dest.buffer, dest.byteOffset, pBytes).set(
+            CanvasKit.HEAPU8.subarray(pPtr, pPtr + pBytes));
+        return dest;
+      }
+      // Return the typed array wrapper w/o allocating.
+      return dest['toTypedArray'] ? dest['toTypedArray']() : dest;
     }
 
     // Put those pixels into a typed array of the right format and then
@@ -465,10 +480,10 @@ CanvasKit.onRuntimeInitialized = function() {
     return retVal;
   }
 
-  CanvasKit.Image.prototype.readPixels = function(srcX, srcY, imageInfo, destMallocObj,
+  CanvasKit.Image.prototype.readPixels = function(srcX, srcY, imageInfo, dest,
                                                   bytesPerRow) {
     var grCtx = CanvasKit.getCurrentGrDirectContext();
-    return readPixels(this, srcX, srcY, imageInfo, destMallocObj, bytesPerRow, grCtx);
+    return readPixels(this, srcX, srcY, imageInfo, dest, bytesPerRow, grCtx);
   };
 
   // Accepts an array of four numbers in the range of 0-1 representing a 4f color
@@ -805,10 +820,10 @@ CanvasKit.onRuntimeInitialized = function() {
     return s;
   };
 
-  CanvasKit.Canvas.prototype.readPixels = function(srcX, srcY, imageInfo, destMallocObj,
+  CanvasKit.Canvas.prototype.readPixels = function(srcX, srcY, imageInfo, dest,
                                                    bytesPerRow) {
     CanvasKit.setCurrentContext(this._context);
-    return readPixels(this, srcX, srcY, imageInfo, destMallocObj, bytesPerRow);
+    return readPixels(this, srcX, srcY, imageInfo, dest, bytesPerRow);
   };
 
   CanvasKit.Canvas.prototype.saveLayer = function(paint, boundsRect, backdrop, flags) {
@@ -72,9 +72,12 @@ function freeArraysThatAreNotMallocedByUsers(ptr, arr) {
 }
 
 // wasMalloced returns true if the object was created by a call to Malloc. This is determined
-// by looking at a property that was added to our Malloc obj and typed arrays.
+// by looking at a property that was added to our Malloc obj and typed arrays. TypedArrays that
+// view the WASM heap directly (e.g. a subarray() of a Malloced array, which loses the property)
+// count too, so they are passed to C++ without a copy.
 function wasMalloced(obj) {
-  return obj && obj['_ck'];
+  return obj && (obj['_ck'] ||
+                 (ArrayBuffer.isView(obj) && obj.buffer === CanvasKit.HEAPU8.buffer));
 }
 
 // We define some "scratch" variables which will house both the pointer to
@@ -111,6 +114,20 @@ var _scratchRRectPtr = nullptr;
 var _scratchRRect2;
 var _scratchRRect2Ptr = nullptr;
 
+// Pixels read into a TypedArray outside of the WASM heap go through this buffer, which only
+// grows, so that reading every frame does not malloc and free each time.
+var _scratchPixelsPtr = nullptr;
+var _scratchPixelsBytes = 0;
+
+function scratchPixelsPtr(bytes) {
+  if (bytes > _scratchPixelsBytes) {
+    CanvasKit._free(_scratchPixelsPtr);
+    _scratchPixelsPtr = CanvasKit._malloc(bytes);
+    _scratchPixelsBytes = bytes;
+  }
+  return _scratchPixelsPtr;
+}
+
 // arr can be a normal JS array or a TypedArray
 // dest is a string like 'HEAPU32' that specifies the type the src array
 // should be copied into.
@@ -163,6 +163,11 @@ export interface CanvasKit {
      * // eventually...
      * CanvasKit.Free(mObj);
      *
+     * Allocating once and refilling the same memory every frame avoids a malloc and copy per
+     * call for batched APIs like drawPoints, drawAtlas and Path.MakeFromCmds. Views made with
+     * subarray() of the TypedArray are still read from the WASM heap without copying, so one
+     * buffer can hold the data for several calls.
+     *
      * @param typedArray - constructor for the typedArray.
      * @param len - number of *elements* to store.
      */
@@ -547,6 +552,7 @@ export interface CanvasKit {
     readonly managed_skottie?: boolean; // true if advanced (managed) Skottie code was compiled in
     readonly rt_effect?: boolean; // true if RuntimeEffect was compiled in
     readonly skottie?: boolean; // true if base Skottie code was compiled in
+    readonly threads?: boolean; // true if built with pthreads for multi-threaded CPU rendering
 
     // Paragraph Enums
     readonly Affinity: AffinityEnumValues;
@@ -1766,14 +1772,16 @@ export interface Canvas extends EmbindObject<"Canvas"> {
      * @param srcY
      * @param imageInfo - describes the destination format of the pixels.
      * @param dest - If provided, the pixels will be copied into the allocated buffer allowing
-     *        access to the pixels without allocating a new TypedArray.
+     *        access to the pixels without allocating a new TypedArray. A MallocObj or a
+     *        TypedArray view of the WASM heap (e.g. a subarray of one) is written to directly;
+     *        any other TypedArray is filled through a scratch buffer and returned.
      * @param bytesPerRow - number of bytes per row. Must be provided if dest is set. This
      *        depends on destination ColorType. For example, it must be at least 4 * width for
      *        the 8888 color type.
      * @returns a TypedArray appropriate for the specified ColorType. Note that 16 bit floats are
      *          not supported in JS, so that colorType corresponds to raw bytes Uint8Array.
      */
-    readPixels(srcX: number, srcY: number, imageInfo: ImageInfo, dest?: MallocObj,
+    readPixels(srcX: number, srcY: number, imageInfo: ImageInfo, dest?: MallocObj | TypedArray,
                bytesPerRow?: number): Float32Array | Uint8Array | null;
 
     /**
@@ -2148,14 +2156,16 @@ export interface Image extends EmbindObject<"Image"> {
      * @param srcY
      * @param imageInfo - describes the destination format of the pixels.
      * @param dest - If provided, the pixels will be copied into the allocated buffer allowing
-     *        access to the pixels without allocating a new TypedArray.
+     *        access to the pixels without allocating a new TypedArray. A MallocObj or a
+     *        TypedArray view of the WASM heap (e.g. a subarray of one) is written to directly;
+     *        any other TypedArray is filled through a scratch buffer and returned.
      * @param bytesPerRow - number of bytes per row. Must be provided if dest is set. This
      *        depends on destination ColorType. For example, it must be at least 4 * width for
      *        the 8888 color type.
      * @returns a TypedArray appropriate for the specified ColorType. Note that 16 bit floats are
      *          not supported in JS, so that colorType corresponds to raw bytes Uint8Array.
      */
-    readPixels(srcX: number, srcY: number, imageInfo: ImageInfo, dest?: MallocObj,
+    readPixels(srcX: number, srcY: number, imageInfo: ImageInfo, dest?: MallocObj | TypedArray,
                bytesPerRow?: number): Float32Array | Uint8Array | null;
 
     /**
@@ -32,7 +32,7 @@ CanvasKit._extraInitializations.push(function() {
   CanvasKit.RuntimeEffect.prototype.makeShader = function(floats, localMatrix) {
     // If the uniforms were set in a MallocObj, we don't want the shader to take ownership of
     // them (and free the memory when the shader is freed).
-    var shouldOwnUniforms = !floats['_ck'];
+    var shouldOwnUniforms = !wasMalloced(floats);
     var fptr = copy1dArray(floats, 'HEAPF32');
     var localMatrixPtr = copy3x3MatrixToWasm(localMatrix);
     // Our array has 4 bytes per float, so be sure to account for that before
@@ -44,7 +44,7 @@ CanvasKit._extraInitializations.push(function() {
   CanvasKit.RuntimeEffect.prototype.makeShaderWithChildren = function(floats, childrenShaders, localMatrix) {
     // If the uniforms were set in a MallocObj, we don't want the shader to take ownership of
     // them (and free the memory when the shader is freed).
-    var shouldOwnUniforms = !floats['_ck'];
+    var shouldOwnUniforms = !wasMalloced(floats);
     var fptr = copy1dArray(floats, 'HEAPF32');
     var localMatrixPtr = copy3x3MatrixToWasm(localMatrix);
     var barePointers = [];
@@ -63,7 +63,7 @@ CanvasKit._extraInitializations.push(function() {
   CanvasKit.RuntimeEffect.prototype.makeBlender = function(floats) {
     // If the uniforms were set in a MallocObj, we don't want the shader to take ownership of
     // them (and free the memory when the blender is freed).
-    var shouldOwnUniforms = !floats['_ck'];
+    var shouldOwnUniforms = !wasMalloced(floats);
     var fptr = copy1dArray(floats, 'HEAPF32');
     return this._makeBlender(fptr, floats.length * 4, shouldOwnUniforms);
   }
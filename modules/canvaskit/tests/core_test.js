@@ -1321,6 +1321,41 @@ describe('Core canvas behavior', () => {
         CanvasKit.Free(mThings);
     });
 
+    it('can read pixels into plain and heap-backed TypedArrays', () => {
+        const surface = CanvasKit.MakeSurface(4, 4);
+        expect(surface).toBeTruthy('Could not make surface');
+        const canvas = surface.getCanvas();
+        canvas.clear(CanvasKit.RED);
+        const info = {
+            width: 2,
+            height: 2,
+            colorType: CanvasKit.ColorType.RGBA_8888,
+            alphaType: CanvasKit.AlphaType.Unpremul,
+            colorSpace: CanvasKit.ColorSpace.SRGB,
+        };
+
+        // Not on the WASM heap, so it is filled and returned as is.
+        const plain = new Uint8Array(2 * 2 * 4);
+        const fromPlain = canvas.readPixels(0, 0, info, plain, 2 * 4);
+        expect(fromPlain).toBe(plain);
+        expectTypedArraysToEqual(Uint8Array.of(255, 0, 0, 255), plain.subarray(0, 4));
+
+        // Too small to hold the pixels.
+        expect(canvas.readPixels(0, 0, info, new Uint8Array(4), 2 * 4)).toBeNull();
+
+        // A subarray of a Malloced object is read into directly.
+        const mObj = CanvasKit.Malloc(Uint8Array, 2 * 2 * 4 * 2);
+        mObj.toTypedArray().fill(0);
+        const second = mObj.toTypedArray().subarray(2 * 2 * 4);
+        const fromHeap = canvas.readPixels(0, 0, info, second, 2 * 4);
+        expect(fromHeap).toBe(second);
+        expectTypedArraysToEqual(Uint8Array.of(0, 0, 0, 0), mObj.toTypedArray().subarray(0, 4));
+        expectTypedArraysToEqual(Uint8Array.of(255, 0, 0, 255), second.subarray(0, 4));
+
+        CanvasKit.Free(mObj);
+        surface.delete();
+    });
+
     function expectTypedArraysToEqual(expected, actual) {
         expect(expected.constructor.name).toEqual(actual.constructor.name);
         expect(expected.length).toEqual(actual.length);
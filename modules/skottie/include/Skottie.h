@@ -8,6 +8,7 @@
 #ifndef Skottie_DEFINED
 #define Skottie_DEFINED
 
+#include "include/core/SkColor.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
@@ -23,9 +24,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 class SkCanvas;
+class SkPicture;
 class SkStream;
 struct SkRect;
 
@@ -40,7 +43,10 @@ namespace SkShapers { class Factory; }
 
 namespace skottie {
 
-namespace internal { class Animator; }
+namespace internal {
+class Animator;
+class LayerChangeLog;
+} // namespace internal
 
 using ImageAsset = skresources::ImageAsset;
 using ResourceProvider = skresources::ResourceProvider;
@@ -100,6 +106,13 @@ public:
                                          // frames are only resolved when needed, at seek() time.
             kPreferEmbeddedFonts = 0x02, // Attempt to use the embedded fonts (glyph paths,
                                          // normally used as fallback) over native Skia typefaces.
+            kTrackLayerChanges   = 0x04, // Record which layers change on each seek, as reported
+                                         // by Animation::changedLayers().
+            kPreloadImageAssets  = 0x08, // Request all image assets used by image layers from the
+                                         // ResourceProvider upfront, before building any layers,
+                                         // so that asynchronous providers (e.g.
+                                         // skresources::AsyncResourceProviderProxy) can load
+                                         // them in parallel.
         };
 
         explicit Builder(uint32_t flags = 0);
@@ -169,6 +182,17 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * Enables caching rasterized copies of precomp and static shape layer content, which is
+         * then redrawn from the cache for as long as it doesn't change.  bytes is the total size
+         * of the cached pixels, the least recently drawn of which are evicted to fit it.
+         *
+         * Cached content is composited as a whole, so it can differ slightly from direct drawing
+         * (rounding, or blend modes other than source-over within the content).  It is only used
+         * with scale/translate device transforms.  Caching is disabled by default (0).
+         */
+        Builder& setRasterCacheBudget(size_t bytes);
+
         /**
          * Animation factories.
          */
@@ -193,6 +217,7 @@ public:
         sk_sp<ExpressionManager>  fExpressionManager;
         sk_sp<SkShapers::Factory> fShapingFactory;
         sk_sp<SlotManager>        fSlotManager;
+        size_t                    fRasterCacheBudget = 0;
         Stats                     fStats;
     };
 
@@ -232,6 +257,35 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Redraws only the parts of the current frame that changed since the previous one.
+     *
+     * The canvas must still hold the previous frame, drawn as if by clearing it to clearColor
+     * and then calling render() with the same dst and flags. The damaged area is cleared to
+     * clearColor again and the current frame is drawn into it; everything else is left alone.
+     *
+     * @param damage      the controller passed to the seek() that moved to the current frame,
+     *                    reset() before that seek. The bounds it collects account for layer
+     *                    effects, mattes and motion blur.
+     * @param clearColor  the background behind the animation
+     */
+    void render(SkCanvas* canvas, const SkRect* dst, RenderFlags,
+                const sksg::InvalidationController& damage,
+                SkColor4f clearColor = SkColors::kTransparent) const;
+
+    /**
+     * Records the current animation frame into a picture, as if by render().
+     *
+     * Unlike the animation, the picture is immutable: it can be played back on any thread,
+     * concurrently with later seeks, and it shares the animation's images, typefaces and paths
+     * rather than copying them. Exporters can seek on one thread and rasterize the resulting
+     * pictures on several others, instead of building one Animation per thread.
+     *
+     * @param dst      optional destination rect, which also becomes the picture's cull rect
+     * @param flags    optional RenderFlags
+     */
+    sk_sp<SkPicture> makeFramePicture(const SkRect* dst = nullptr, RenderFlags = 0) const;
+
     /**
      * [Deprecated: use one of the other versions.]
      *
@@ -262,6 +316,15 @@ public:
      */
     void seekFrameTime(double t, sksg::InvalidationController* = nullptr);
 
+    /**
+     * Returns the names of the layers whose content, transform or visibility changed during the
+     * last seek, including layers nested in precomps. Each layer is listed once, in no
+     * particular order.
+     *
+     * Always empty unless the animation was built with Builder::kTrackLayerChanges.
+     */
+    const std::vector<SkString>& changedLayers() const;
+
     /**
      * Returns the animation duration in seconds.
      */
@@ -293,7 +356,8 @@ private:
     Animation(sk_sp<sksg::RenderNode>,
               std::vector<sk_sp<internal::Animator>>&&,
               SkString ver, const SkSize& size,
-              double inPoint, double outPoint, double duration, double fps, uint32_t flags);
+              double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+              std::unique_ptr<internal::LayerChangeLog>);
 
     const sk_sp<sksg::RenderNode>                fSceneRoot;
     const std::vector<sk_sp<internal::Animator>> fAnimators;
@@ -304,6 +368,7 @@ private:
                                                  fDuration,
                                                  fFPS;
     const uint32_t                               fFlags;
+    const std::unique_ptr<internal::LayerChangeLog> fLayerChanges;
 
     using INHERITED = SkNVRefCnt<Animation>;
 };
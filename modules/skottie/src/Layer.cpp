@@ -20,6 +20,7 @@
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/src/Composition.h"
+#include "modules/skottie/src/RasterCache.h"
 #include "modules/skottie/src/SkottieJson.h"
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/skottie/src/animator/Animator.h"
@@ -268,12 +269,15 @@ class LayerController final : public Animator {
 public:
     LayerController(AnimatorScope&& layer_animators,
                     sk_sp<sksg::RenderNode> layer,
-                    size_t tanim_count, float in, float out)
+                    size_t tanim_count, float in, float out,
+                    LayerChangeLog* change_log, SkString name)
         : fLayerAnimators(std::move(layer_animators))
         , fLayerNode(std::move(layer))
         , fTransformAnimatorsCount(tanim_count)
         , fIn(in)
-        , fOut(out) {}
+        , fOut(out)
+        , fChangeLog(change_log)
+        , fName(std::move(name)) {}
 
 protected:
     StateChanged onSeek(float t) override {
@@ -295,6 +299,10 @@ protected:
             changed |= fLayerAnimators[i]->seek(t);
         }
 
+        if (changed && fChangeLog) {
+            fChangeLog->log(fName, &fLoggedGeneration);
+        }
+
         return changed;
     }
 
@@ -304,6 +312,9 @@ private:
     const size_t                  fTransformAnimatorsCount;
     const float                   fIn,
                                   fOut;
+    LayerChangeLog*               fChangeLog;
+    const SkString                fName;
+    uint32_t                      fLoggedGeneration = 0;
 };
 
 class MotionBlurController final : public Animator {
@@ -482,10 +493,21 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
     sk_sp<sksg::RenderNode> layer;
 
     // Build the layer content fragment.
+    const auto pre_content_animator_count = abuilder.fCurrentAnimatorScope->size();
     if (build_info.fBuilder) {
         layer = (abuilder.*(build_info.fBuilder))(fJlayer, &fInfo);
     }
 
+    // Shape layers without content animators and precomp layers (whose nested layers always
+    // register animators, at least for their in/out points) are candidates for raster caching.
+    // Either way, content is only cached while it remains unchanged.
+    const auto cache_content =
+            (fType == 0) ||
+            (fType == 4 && abuilder.fCurrentAnimatorScope->size() == pre_content_animator_count);
+    if (cache_content) {
+        layer = RasterCache::Attach(abuilder.fRasterCache, std::move(layer));
+    }
+
     // Clip layers with explicit dimensions.
     float w = 0, h = 0;
     if (::skottie::Parse<float>(fJlayer["w"], &w) && ::skottie::Parse<float>(fJlayer["h"], &h)) {
@@ -544,11 +566,17 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
             ? abuilder.fCurrentAnimatorScope->size()
             : fTransformAnimatorCount;
 
+    // Layer names are only needed to report changes.
+    auto name = abuilder.fLayerChanges ? ParseDefault<SkString>(fJlayer["nm"], SkString())
+                                       : SkString();
+
     sk_sp<Animator> controller = sk_make_sp<LayerController>(ascope.release(),
                                                              layer,
                                                              force_seek_count,
                                                              fInfo.fInPoint,
-                                                             fInfo.fOutPoint);
+                                                             fInfo.fOutPoint,
+                                                             abuilder.fLayerChanges.get(),
+                                                             std::move(name));
 
     // Optional motion blur.
     if (layer && has_animators && this->hasMotionBlur(cbuilder)) {
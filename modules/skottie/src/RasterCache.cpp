@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/skottie/src/RasterCache.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
+#include "modules/sksg/include/SkSGEffectNode.h"
+#include "modules/sksg/include/SkSGRenderNode.h"
+
+#include <limits>
+#include <utility>
+
+namespace skottie {
+namespace internal {
+
+class RasterCache::CachedContent final : public sksg::EffectNode {
+public:
+    CachedContent(sk_sp<sksg::RenderNode> content, sk_sp<RasterCache> cache)
+        : INHERITED(std::move(content))
+        , fCache(std::move(cache)) {}
+
+    ~CachedContent() override {
+        fCache->purge(this);
+    }
+
+protected:
+    SkRect onRevalidate(sksg::InvalidationController* ic, const SkMatrix& ctm) override {
+        // Revalidation only reaches this node when something in the content has changed.
+        fCache->purge(this);
+
+        return this->INHERITED::onRevalidate(ic, ctm);
+    }
+
+    void onRender(SkCanvas* canvas, const RenderContext* ctx) const override {
+        // Paint overrides from ancestors apply to the individual content draws, which is not the
+        // same as applying them to the content pixels as a whole.
+        const auto has_overrides = ctx && (ctx->requiresIsolation() || ctx->fShader);
+
+        const auto render = [this](SkCanvas* c) { this->INHERITED::onRender(c, nullptr); };
+        if (has_overrides || !fCache->draw(this, this->bounds(), canvas, render)) {
+            this->INHERITED::onRender(canvas, ctx);
+        }
+    }
+
+private:
+    const sk_sp<RasterCache> fCache;
+
+    using INHERITED = sksg::EffectNode;
+};
+
+RasterCache::RasterCache(size_t budget)
+    : fBudget(budget)
+    , fEntries(std::numeric_limits<int>::max()) {}
+
+RasterCache::~RasterCache() = default;
+
+sk_sp<sksg::RenderNode> RasterCache::Attach(sk_sp<RasterCache> cache,
+                                            sk_sp<sksg::RenderNode> content) {
+    if (!cache || !content) {
+        return content;
+    }
+
+    return sk_make_sp<CachedContent>(std::move(content), std::move(cache));
+}
+
+size_t RasterCache::bytesUsed() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fBytesUsed;
+}
+
+bool RasterCache::draw(const void* content, const SkRect& bounds, SkCanvas* canvas,
+                       const std::function<void(SkCanvas*)>& render) {
+    const auto ctm = canvas->getTotalMatrix();
+    if (!ctm.isScaleTranslate() || canvas->imageInfo().colorType() == kUnknown_SkColorType) {
+        return false;
+    }
+
+    const auto device_bounds = ctm.mapRect(bounds);
+    if (!device_bounds.isFinite()) {
+        return false;
+    }
+
+    // The pixels cover the whole content, so they don't depend on the canvas clip.
+    const auto pixel_bounds = device_bounds.roundOut();
+    if (pixel_bounds.isEmpty()) {
+        return false;
+    }
+
+    const void* context = canvas->recordingContext();
+    if (!context) {
+        context = canvas->recorder();
+    }
+
+    const Key key = {
+        canvas->imageInfo().makeDimensions(pixel_bounds.size())
+                           .makeAlphaType(kPremul_SkAlphaType),
+        SkMatrix(ctm).postTranslate(-pixel_bounds.left(), -pixel_bounds.top()),
+        context,
+    };
+    const auto bytes = key.fInfo.computeMinByteSize();
+    if (bytes > fBudget) {
+        return false;
+    }
+
+    sk_sp<SkImage> image;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+
+        Entry* entry = fEntries.find(content);
+        if (!entry || entry->fKey != key) {
+            // Only content drawn the same way twice in a row is cached.
+            if (entry) {
+                fBytesUsed -= entry->fBytes;
+            }
+            fEntries.insert_or_update(content, {key, nullptr, 0});
+            return false;
+        }
+        image = entry->fImage;
+    }
+
+    if (!image) {
+        auto surface = canvas->makeSurface(key.fInfo);
+        if (!surface) {
+            return false;
+        }
+
+        auto* cache_canvas = surface->getCanvas();
+        cache_canvas->clear(SK_ColorTRANSPARENT);
+        cache_canvas->setMatrix(key.fMatrix);
+        render(cache_canvas);
+        image = surface->makeImageSnapshot();
+        if (!image) {
+            return false;
+        }
+
+        SkAutoMutexExclusive lock(fMutex);
+
+        // The content may have changed while it was being drawn.
+        const Entry* entry = fEntries.find(content);
+        if (entry && entry->fKey == key && !entry->fImage) {
+            this->evict(bytes);
+            fEntries.insert_or_update(content, {key, image, bytes});
+            fBytesUsed += bytes;
+        }
+    }
+
+    // Device space offsets are integral, so the pixels are copied as they are.
+    canvas->save();
+    canvas->resetMatrix();
+    canvas->drawImage(image, pixel_bounds.left(), pixel_bounds.top());
+    canvas->restore();
+
+    return true;
+}
+
+void RasterCache::purge(const void* content) {
+    SkAutoMutexExclusive lock(fMutex);
+
+    if (const Entry* entry = fEntries.find(content)) {
+        fBytesUsed -= entry->fBytes;
+        fEntries.remove(content);
+    }
+}
+
+void RasterCache::evict(size_t bytes) {
+    while (fBytesUsed + bytes > fBudget) {
+        const Entry* lru = fEntries.peekLRU();
+        SkASSERT(lru);
+        fBytesUsed -= lru->fBytes;
+        fEntries.removeLRU();
+    }
+}
+
+}  // namespace internal
+}  // namespace skottie
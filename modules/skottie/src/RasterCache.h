@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkottieRasterCache_DEFINED
+#define SkottieRasterCache_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
+
+#include <cstddef>
+#include <functional>
+
+class SkCanvas;
+struct SkRect;
+
+namespace sksg {
+class RenderNode;
+}  // namespace sksg
+
+namespace skottie {
+namespace internal {
+
+// Keeps rasterized copies of layer content that doesn't change from frame to frame, for all the
+// layers of an animation and within a common memory budget (Builder::setRasterCacheBudget).
+//
+// Content is considered static for as long as its scene graph fragment is not invalidated. It is
+// cached once it has been drawn twice in a row with the same device transform (up to integer
+// translation), which keeps moving or animated layers from churning the cache.  Cached pixels
+// share the destination canvas' color type, color space and GPU context (as textures, when
+// drawing to a GPU canvas), and are drawn back at integer device offsets.
+class RasterCache final : public SkRefCnt {
+public:
+    explicit RasterCache(size_t budget);
+    ~RasterCache() override;
+
+    // Wraps layer content so that it is drawn from the cache while it stays unchanged.
+    static sk_sp<sksg::RenderNode> Attach(sk_sp<RasterCache>, sk_sp<sksg::RenderNode> content);
+
+    size_t bytesUsed() const;
+
+private:
+    class CachedContent;
+
+    // Draws the cached pixels for content, or returns false when the caller should draw it
+    // directly instead.  render draws the content (with the given local bounds) to a canvas.
+    bool draw(const void* content, const SkRect& bounds, SkCanvas*,
+              const std::function<void(SkCanvas*)>& render);
+
+    void purge(const void* content);
+
+    struct Key {
+        SkImageInfo fInfo;
+        SkMatrix    fMatrix;    // From content to cached pixels.
+        const void* fContext;   // The GPU context or recorder that owns the pixels, if any.
+
+        bool operator==(const Key& other) const {
+            return fInfo == other.fInfo && fMatrix == other.fMatrix && fContext == other.fContext;
+        }
+        bool operator!=(const Key& other) const { return !(*this == other); }
+    };
+
+    struct Entry {
+        Key            fKey;
+        sk_sp<SkImage> fImage;   // Null until the content has been drawn twice with fKey.
+        size_t         fBytes;
+    };
+
+    void evict(size_t bytes) SK_REQUIRES(fMutex);
+
+    const size_t fBudget;
+
+    mutable SkMutex                  fMutex;
+    SkLRUCache<const void*, Entry>   fEntries SK_GUARDED_BY(fMutex);
+    size_t                           fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+};
+
+}  // namespace internal
+}  // namespace skottie
+
+#endif  // SkottieRasterCache_DEFINED
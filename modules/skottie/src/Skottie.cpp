@@ -7,11 +7,15 @@
 
 #include "modules/skottie/include/Skottie.h"
 
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
@@ -22,12 +26,14 @@
 #include "modules/skottie/include/SlotManager.h"
 #include "modules/skottie/src/Adapter.h"
 #include "modules/skottie/src/Composition.h"
+#include "modules/skottie/src/RasterCache.h"
 #include "modules/skottie/src/SkottieJson.h"
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/skottie/src/Transform.h"  // IWYU pragma: keep
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/skottie/src/text/TextAdapter.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
 #include "modules/sksg/include/SkSGOpacityEffect.h"
 #include "modules/sksg/include/SkSGRenderNode.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
@@ -144,7 +150,7 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
                                    sk_sp<SkShapers::Factory> shapingFactory,
                                    Animation::Builder::Stats* stats,
                                    const SkSize& comp_size, float duration, float framerate,
-                                   uint32_t flags)
+                                   uint32_t flags, size_t raster_cache_budget)
     : fResourceProvider(std::move(rp))
     , fFontMgr(std::move(fontmgr))
     , fPropertyObserver(std::move(pobserver))
@@ -160,7 +166,14 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
     , fDuration(duration)
     , fFrameRate(framerate)
     , fFlags(flags)
-    , fHasNontrivialBlending(false) {}
+    , fHasNontrivialBlending(false)
+    , fLayerChanges(flags & Animation::Builder::kTrackLayerChanges
+                            ? std::make_unique<LayerChangeLog>()
+                            : nullptr)
+    , fRasterCache(raster_cache_budget ? sk_make_sp<RasterCache>(raster_cache_budget)
+                                       : nullptr) {}
+
+AnimationBuilder::~AnimationBuilder() = default;
 
 AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValue& jroot) {
     this->dispatchMarkers(jroot["markers"]);
@@ -172,6 +185,10 @@ AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValu
     this->parseFonts(jroot["fonts"], jroot["chars"]);
     fSlotsRoot = jroot["slots"];
 
+    if (fFlags & Animation::Builder::kPreloadImageAssets) {
+        this->preloadImageAssets(jroot);
+    }
+
     auto root = CompositionBuilder(*this, fCompSize, jroot).build(*this);
 
     auto animators = ascope.release();
@@ -181,7 +198,8 @@ AnimationBuilder::AnimationInfo AnimationBuilder::parse(const skjson::ObjectValu
     fRevalidator->setRoot(root);
     fRevalidator->revalidate();
 
-    return { std::move(root), std::move(animators), std::move(fSlotManager)};
+    return { std::move(root), std::move(animators), std::move(fSlotManager),
+             std::move(fLayerChanges) };
 }
 
 void AnimationBuilder::parseAssets(const skjson::ArrayValue* jassets) {
@@ -346,6 +364,11 @@ Animation::Builder& Animation::Builder::setTextShapingFactory(sk_sp<SkShapers::F
     return *this;
 }
 
+Animation::Builder& Animation::Builder::setRasterCacheBudget(size_t bytes) {
+    fRasterCacheBudget = bytes;
+    return *this;
+}
+
 sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     if (!stream->hasLength()) {
         // TODO: handle explicit buffering?
@@ -427,7 +450,8 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                        std::move(fPrecompInterceptor),
                                        std::move(fExpressionManager),
                                        std::move(factory),
-                                       &fStats, size, duration, fps, fFlags);
+                                       &fStats, size, duration, fps, fFlags,
+                                       fRasterCacheBudget);
     auto ainfo = builder.parse(json);
 
     fSlotManager = ainfo.fSlotManager;
@@ -453,7 +477,8 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                           outPoint,
                                           duration,
                                           fps,
-                                          flags));
+                                          flags,
+                                          std::move(ainfo.fLayerChanges)));
 }
 
 sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
@@ -466,7 +491,8 @@ sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
 Animation::Animation(sk_sp<sksg::RenderNode> scene_root,
                      std::vector<sk_sp<internal::Animator>>&& animators,
                      SkString version, const SkSize& size,
-                     double inPoint, double outPoint, double duration, double fps, uint32_t flags)
+                     double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+                     std::unique_ptr<internal::LayerChangeLog> layer_changes)
     : fSceneRoot(std::move(scene_root))
     , fAnimators(std::move(animators))
     , fVersion(std::move(version))
@@ -475,7 +501,8 @@ Animation::Animation(sk_sp<sksg::RenderNode> scene_root,
     , fOutPoint(outPoint)
     , fDuration(duration)
     , fFPS(fps)
-    , fFlags(flags) {}
+    , fFlags(flags)
+    , fLayerChanges(std::move(layer_changes)) {}
 
 Animation::~Animation() = default;
 
@@ -510,6 +537,56 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
     fSceneRoot->render(canvas);
 }
 
+void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags,
+                       const sksg::InvalidationController& damage, SkColor4f clearColor) const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    if (!fSceneRoot)
+        return;
+
+    // Damage is collected in animation coordinates.
+    const SkRect srcR = SkRect::MakeSize(this->size());
+    SkMatrix toDevice = canvas->getTotalMatrix();
+    if (dstR) {
+        toDevice.preConcat(SkMatrix::RectToRect(srcR, *dstR, SkMatrix::kCenter_ScaleToFit));
+    }
+
+    const SkIRect deviceClip = canvas->getDeviceClipBounds();
+    std::vector<SkIRect> deviceDamage;
+    for (SkRect rect : damage) {
+        if (!(renderFlags & RenderFlag::kDisableTopLevelClipping) && !rect.intersect(srcR)) {
+            continue;
+        }
+        SkIRect deviceRect = toDevice.mapRect(rect).roundOut();
+        if (deviceRect.intersect(deviceClip)) {
+            deviceDamage.push_back(deviceRect);
+        }
+    }
+    if (deviceDamage.empty()) {
+        return;
+    }
+
+    SkRegion region;
+    region.setRects(deviceDamage.data(), SkToInt(deviceDamage.size()));
+
+    SkAutoCanvasRestore restore(canvas, true);
+    canvas->clipRegion(region);
+    canvas->drawColor(clearColor, SkBlendMode::kSrc);
+    this->render(canvas, dstR, renderFlags);
+}
+
+sk_sp<SkPicture> Animation::makeFramePicture(const SkRect* dstR, RenderFlags renderFlags) const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    // Rendering copies paths and refs images, shaders and typefaces into the recording, so
+    // nothing in it changes when the scene graph is revalidated for another frame.
+    SkPictureRecorder recorder;
+    const SkRect bounds = dstR ? *dstR : SkRect::MakeSize(this->size());
+    this->render(recorder.beginRecording(bounds), dstR, renderFlags);
+
+    return recorder.finishRecordingAsPicture();
+}
+
 void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
@@ -520,6 +597,10 @@ void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     const auto kLastValidFrame = std::nextafterf(fOutPoint, fInPoint),
                      comp_time = SkTPin<float>(fInPoint + t, fInPoint, kLastValidFrame);
 
+    if (fLayerChanges) {
+        fLayerChanges->reset();
+    }
+
     for (const auto& anim : fAnimators) {
         anim->seek(comp_time);
     }
@@ -527,6 +608,11 @@ void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     fSceneRoot->revalidate(ic, SkMatrix::I());
 }
 
+const std::vector<SkString>& Animation::changedLayers() const {
+    static const std::vector<SkString> kNoLayers;
+    return fLayerChanges ? fLayerChanges->names() : kNoLayers;
+}
+
 void Animation::seekFrameTime(double t, sksg::InvalidationController* ic) {
     this->seekFrame(t * fFPS, ic);
 }
@@ -25,6 +25,8 @@
 
 #include "modules/skshaper/include/SkShaper_factory.h"
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace skjson {
@@ -50,6 +52,7 @@ class TextAdapter;
 class TransformAdapter2D;
 class TransformAdapter3D;
 class OpacityAdapter;
+class RasterCache;
 
 
 using AnimatorScope = std::vector<sk_sp<Animator>>;
@@ -63,18 +66,45 @@ private:
     sk_sp<sksg::RenderNode> fRoot;
 };
 
+// Collects the names of the layers that change during a seek (Builder::kTrackLayerChanges).
+class LayerChangeLog final {
+public:
+    // Starts a new seek.
+    void reset() {
+        fNames.clear();
+        fGeneration++;
+    }
+
+    // Layers pass the generation they were last logged in, so each is logged once per seek.
+    void log(const SkString& name, uint32_t* loggedGeneration) {
+        if (*loggedGeneration != fGeneration) {
+            *loggedGeneration = fGeneration;
+            fNames.push_back(name);
+        }
+    }
+
+    const std::vector<SkString>& names() const { return fNames; }
+
+private:
+    std::vector<SkString> fNames;
+    uint32_t              fGeneration = 1;
+};
+
 class AnimationBuilder final : public SkNoncopyable {
 public:
     AnimationBuilder(sk_sp<ResourceProvider>, sk_sp<SkFontMgr>, sk_sp<PropertyObserver>,
                      sk_sp<Logger>, sk_sp<MarkerObserver>, sk_sp<PrecompInterceptor>,
                      sk_sp<ExpressionManager>, sk_sp<SkShapers::Factory>,
                      Animation::Builder::Stats*, const SkSize& comp_size,
-                     float duration, float framerate, uint32_t flags);
+                     float duration, float framerate, uint32_t flags,
+                     size_t raster_cache_budget);
+    ~AnimationBuilder();
 
     struct AnimationInfo {
-        sk_sp<sksg::RenderNode> fSceneRoot;
-        AnimatorScope           fAnimators;
-        sk_sp<SlotManager>      fSlotManager;
+        sk_sp<sksg::RenderNode>         fSceneRoot;
+        AnimatorScope                   fAnimators;
+        sk_sp<SlotManager>              fSlotManager;
+        std::unique_ptr<LayerChangeLog> fLayerChanges;
     };
 
     AnimationInfo parse(const skjson::ObjectValue&);
@@ -212,6 +242,7 @@ private:
     struct LayerInfo;
 
     void parseAssets(const skjson::ArrayValue*);
+    void preloadImageAssets(const skjson::ObjectValue& jroot) const;
 
     // Return true iff all fonts were resolved.
     bool resolveNativeTypefaces();
@@ -256,6 +287,8 @@ private:
     mutable AnimatorScope*       fCurrentAnimatorScope;
     mutable const char*          fPropertyObserverContext = nullptr;
     mutable bool                 fHasNontrivialBlending : 1;
+    std::unique_ptr<LayerChangeLog> fLayerChanges;  // Only with Builder::kTrackLayerChanges.
+    sk_sp<RasterCache>           fRasterCache;   // Only with Builder::setRasterCacheBudget().
 
     struct LayerInfo {
         SkSize      fSize;
@@ -5,12 +5,28 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/src/RasterCache.h"
+#include "modules/skresources/include/SkResources.h"
+#include "modules/sksg/include/SkSGDraw.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
+#include "modules/sksg/include/SkSGPaint.h"
+#include "modules/sksg/include/SkSGRect.h"
+#include "modules/sksg/include/SkSGRenderNode.h"
 #include "tests/Test.h"
 
+#include <atomic>
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -244,6 +260,82 @@ DEF_TEST(Skottie_Image_Loading, reporter) {
     }
 }
 
+DEF_TEST(Skottie_Image_AsyncLoading, reporter) {
+    class TestAsset final : public skresources::ImageAsset {
+    public:
+        int frameRequests() const { return fFrameRequests; }
+
+    private:
+        bool isMultiFrame() override { return false; }
+
+        sk_sp<SkImage> getFrame(float) override {
+            fFrameRequests++;
+            return SkSurfaces::Raster(SkImageInfo::MakeN32Premul(10, 10))->makeImageSnapshot();
+        }
+
+        std::atomic<int> fFrameRequests = 0;
+    };
+
+    class TestResourceProvider final : public skresources::ResourceProvider {
+    public:
+        sk_sp<ImageAsset> loadImageAsset(const char[], const char[],
+                                         const char id[]) const override {
+            fLoads++;
+            return strcmp(id, "root_image") ? fPrecompAsset : fRootAsset;
+        }
+
+        const sk_sp<TestAsset> fRootAsset    = sk_make_sp<TestAsset>(),
+                               fPrecompAsset = sk_make_sp<TestAsset>();
+        mutable std::atomic<int> fLoads = 0;
+    };
+
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 100,
+                                     "assets": [
+                                       { "id": "root_image", "p": "a.png", "u": "" },
+                                       { "id": "precomp_image", "p": "b.png", "u": "" },
+                                       {
+                                         "id": "precomp",
+                                         "layers": [
+                                           { "ty": 2, "refId": "precomp_image", "ind": 0,
+                                             "ip": 0, "op": 100, "ks": {} }
+                                         ]
+                                       }
+                                     ],
+                                     "layers": [
+                                       { "ty": 2, "refId": "root_image", "ind": 0,
+                                         "ip": 0, "op": 100, "ks": {} },
+                                       { "ty": 0, "refId": "precomp", "ind": 1, "w": 100, "h": 100,
+                                         "ip": 0, "op": 100, "ks": {} }
+                                     ]
+                                   })";
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(2);
+    auto provider = sk_make_sp<TestResourceProvider>();
+
+    SkMemoryStream stream(json, strlen(json));
+    auto animation =
+        skottie::Animation::Builder(skottie::Animation::Builder::kPreloadImageAssets)
+            .setResourceProvider(skresources::AsyncResourceProviderProxy::Make(provider,
+                                                                               executor.get()))
+            .make(&stream);
+    REPORTER_ASSERT(reporter, animation);
+
+    // Each image is loaded once, and its only frame is resolved once (on the executor).
+    REPORTER_ASSERT(reporter, provider->fLoads == 2);
+    REPORTER_ASSERT(reporter, provider->fRootAsset->frameRequests() == 1);
+    REPORTER_ASSERT(reporter, provider->fPrecompAsset->frameRequests() == 1);
+
+    animation->seekFrameTime(1);
+    REPORTER_ASSERT(reporter, provider->fRootAsset->frameRequests() == 1);
+    REPORTER_ASSERT(reporter, provider->fPrecompAsset->frameRequests() == 1);
+}
+
 DEF_TEST(Skottie_Layer_NoType, r) {
     static constexpr char json[] =
         R"({
@@ -269,3 +361,265 @@ DEF_TEST(Skottie_Layer_NoType, r) {
     // passes if we don't crash
     REPORTER_ASSERT(r, anim);
 }
+
+DEF_TEST(Skottie_FramePicture, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "ty": 1,
+                 "sw": 50,
+                 "sh": 50,
+                 "sc": "#ff0000",
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t":   0, "s": [  0,  0 ] },
+                                         { "t": 100, "s": [ 50, 50 ] } ] }
+                 }
+               }
+             ]
+           })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto anim = Animation::Make(&stream);
+    REPORTER_ASSERT(r, anim);
+    if (!anim) {
+        return;
+    }
+
+    auto render = [](const std::function<void(SkCanvas*)>& draw) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(100, 100);
+        bitmap.eraseColor(SK_ColorWHITE);
+        SkCanvas canvas(bitmap);
+        draw(&canvas);
+        return bitmap;
+    };
+    auto equal = [](const SkBitmap& a, const SkBitmap& b) {
+        return 0 == memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+    };
+
+    std::vector<sk_sp<SkPicture>> pictures;
+    std::vector<SkBitmap> expected;
+    for (double frame : {0.0, 40.0, 80.0}) {
+        anim->seekFrame(frame);
+        pictures.push_back(anim->makeFramePicture());
+        expected.push_back(render([&](SkCanvas* canvas) { anim->render(canvas); }));
+    }
+    REPORTER_ASSERT(r, !equal(expected[0], expected[2]));
+
+    // Each picture still draws its own frame after the animation has moved on.
+    for (size_t i = 0; i < pictures.size(); ++i) {
+        REPORTER_ASSERT(r, pictures[i]->cullRect() == SkRect::MakeWH(100, 100));
+        SkBitmap actual = render([&](SkCanvas* canvas) { canvas->drawPicture(pictures[i]); });
+        REPORTER_ASSERT(r, equal(expected[i], actual), "frame %zu", i);
+    }
+}
+
+DEF_TEST(Skottie_PartialRedraw, r) {
+    // A small square moving over a static one.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "layers": [
+               {
+                 "nm": "mover",
+                 "ty": 1,
+                 "sw": 20,
+                 "sh": 20,
+                 "sc": "#ff0000",
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t":   0, "s": [ 10, 10 ] },
+                                         { "t": 100, "s": [ 70, 70 ] } ] }
+                 }
+               },
+               {
+                 "nm": "background",
+                 "ty": 1,
+                 "sw": 60,
+                 "sh": 60,
+                 "sc": "#0000ff",
+                 "ip": 0,
+                 "op": 100,
+                 "ks": { "p": { "a": 0, "k": [ 50, 50 ] } }
+               }
+             ]
+           })";
+
+    auto anim = Animation::Builder(Animation::Builder::kTrackLayerChanges)
+                        .make(json, strlen(json));
+    REPORTER_ASSERT(r, anim);
+    if (!anim) {
+        return;
+    }
+
+    SkBitmap retained, expected;
+    retained.allocN32Pixels(200, 200);
+    expected.allocN32Pixels(200, 200);
+    SkCanvas retainedCanvas(retained),
+             expectedCanvas(expected);
+    const SkRect dst = SkRect::MakeWH(200, 200);
+
+    anim->seekFrame(0);
+    retainedCanvas.clear(SK_ColorWHITE);
+    anim->render(&retainedCanvas, &dst);
+
+    sksg::InvalidationController ic;
+    for (double frame : {5.0, 30.0, 31.0, 90.0}) {
+        ic.reset();
+        anim->seekFrame(frame, &ic);
+        REPORTER_ASSERT(r, anim->changedLayers().size() == 1 &&
+                           anim->changedLayers()[0].equals("mover"));
+        REPORTER_ASSERT(r, !ic.bounds().isEmpty() &&
+                           !ic.bounds().contains(SkRect::MakeWH(100, 100)));
+
+        anim->render(&retainedCanvas, &dst, 0, ic, SkColors::kWhite);
+
+        expectedCanvas.clear(SK_ColorWHITE);
+        anim->render(&expectedCanvas, &dst);
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), retained.getPixels(),
+                                       expected.computeByteSize()), "frame %g", frame);
+    }
+
+    // Seeking to the same frame again changes nothing.
+    anim->seekFrame(90);
+    REPORTER_ASSERT(r, anim->changedLayers().empty());
+}
+
+DEF_TEST(Skottie_RasterCache, r) {
+    // A static precomp under a small moving square.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 100,
+             "assets": [
+               {
+                 "id": "artwork",
+                 "layers": [
+                   { "ty": 1, "sw": 30, "sh": 30, "sc": "#00ff00", "ip": 0, "op": 100,
+                     "ks": { "p": { "a": 0, "k": [ 20, 20 ] } } },
+                   { "ty": 1, "sw": 60, "sh": 60, "sc": "#0000ff", "ip": 0, "op": 100,
+                     "ks": { "p": { "a": 0, "k": [ 40, 40 ] } } }
+                 ]
+               }
+             ],
+             "layers": [
+               {
+                 "ty": 1,
+                 "sw": 20,
+                 "sh": 20,
+                 "sc": "#ff0000",
+                 "ip": 0,
+                 "op": 100,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t":   0, "s": [ 10, 10 ] },
+                                         { "t": 100, "s": [ 70, 70 ] } ] }
+                 }
+               },
+               { "ty": 0, "refId": "artwork", "w": 100, "h": 100, "ip": 0, "op": 100 }
+             ]
+           })";
+
+    auto cached   = Animation::Builder().setRasterCacheBudget(1 << 20).make(json, strlen(json)),
+         uncached = Animation::Builder().make(json, strlen(json));
+    REPORTER_ASSERT(r, cached && uncached);
+    if (!cached || !uncached) {
+        return;
+    }
+
+    auto render = [](const Animation* anim, const SkRect& dst) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(200, 200);
+        SkCanvas canvas(bitmap);
+        canvas.clear(SK_ColorWHITE);
+        anim->render(&canvas, &dst);
+        return bitmap;
+    };
+
+    for (const SkRect& dst : {SkRect::MakeWH(100, 100), SkRect::MakeXYWH(20, 20, 150, 150)}) {
+        for (double frame : {0.0, 10.0, 11.0, 12.0, 50.0}) {
+            cached->seekFrame(frame);
+            uncached->seekFrame(frame);
+            const SkBitmap expected = render(uncached.get(), dst),
+                           actual   = render(cached.get(), dst);
+            REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                           expected.computeByteSize()), "frame %g", frame);
+        }
+    }
+}
+
+DEF_TEST(Skottie_RasterCache_Budget, r) {
+    using skottie::internal::RasterCache;
+
+    auto color = sksg::Color::Make(SK_ColorRED);
+    auto make_content = [&](const SkRect& rect) {
+        return sksg::Draw::Make(sksg::Rect::Make(rect), color);
+    };
+
+    // Room for a single 20x20 N32 copy.
+    auto cache = sk_make_sp<RasterCache>(2000);
+    auto content1 = RasterCache::Attach(cache, make_content(SkRect::MakeXYWH(10, 10, 20, 20))),
+         content2 = RasterCache::Attach(cache, make_content(SkRect::MakeXYWH(50, 50, 20, 20)));
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(100, 100);
+    SkCanvas canvas(bitmap);
+    auto draw = [&](const sk_sp<sksg::RenderNode>& content, SkScalar dx = 0) {
+        content->revalidate(nullptr, SkMatrix::I());
+        bitmap.eraseColor(SK_ColorWHITE);
+        canvas.save();
+        canvas.translate(dx, 0);
+        content->render(&canvas);
+        canvas.restore();
+    };
+
+    // Content is cached the second time it is drawn the same way.
+    draw(content1);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 0);
+    draw(content1);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 20 * 20 * 4);
+    REPORTER_ASSERT(r, bitmap.getColor(20, 20) == SK_ColorRED);
+
+    // Integer translations reuse the cached pixels.
+    draw(content1, 30);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 20 * 20 * 4);
+    REPORTER_ASSERT(r, bitmap.getColor(20, 20) == SK_ColorWHITE);
+    REPORTER_ASSERT(r, bitmap.getColor(50, 20) == SK_ColorRED);
+
+    // Changing the content drops its pixels.
+    color->setColor(SK_ColorBLUE);
+    draw(content1);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 0);
+    REPORTER_ASSERT(r, bitmap.getColor(20, 20) == SK_ColorBLUE);
+    draw(content1);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 20 * 20 * 4);
+
+    // Caching more content than the budget allows evicts the least recently drawn.
+    draw(content2);
+    draw(content2);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 20 * 20 * 4);
+    REPORTER_ASSERT(r, bitmap.getColor(60, 60) == SK_ColorBLUE);
+    draw(content1);
+    REPORTER_ASSERT(r, bitmap.getColor(20, 20) == SK_ColorBLUE);
+    draw(content1);
+    REPORTER_ASSERT(r, cache->bytesUsed() == 20 * 20 * 4);
+    REPORTER_ASSERT(r, bitmap.getColor(20, 20) == SK_ColorBLUE);
+}
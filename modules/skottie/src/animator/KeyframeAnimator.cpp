@@ -54,6 +54,18 @@ KeyframeAnimator::KFSegment KeyframeAnimator::find_segment(float t) const {
     SkASSERT(t > fKFs.front().t);
     SkASSERT(t < fKFs.back().t);
 
+    // Sequential playback normally moves on to an adjacent segment, so check that first.
+    // t is within the keyframe range, so a cached segment that doesn't contain it always has a
+    // neighbor in the direction of t.
+    if (fCurrentSegment.kf0) {
+        const auto* kf = t < fCurrentSegment.kf0->t ? fCurrentSegment.kf0 - 1
+                                                     : fCurrentSegment.kf1;
+        const KFSegment adjacent = {kf, kf + 1};
+        if (adjacent.contains(t)) {
+            return adjacent;
+        }
+    }
+
     auto kf0 = &fKFs.front(),
          kf1 = &fKFs.back();
 
@@ -104,7 +104,7 @@ private:
         }
     };
 
-    // Find the KFSegment containing |t|.
+    // Find the KFSegment containing |t|, starting from the cached segment.
     KFSegment find_segment(float t) const;
 
     // Given a |t| and a containing KFSegment, compute the local interpolation weight.
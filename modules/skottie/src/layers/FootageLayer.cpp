@@ -140,6 +140,37 @@ AnimationBuilder::loadFootageAsset(const skjson::ObjectValue& defaultJImage) con
     return fImageAssetCache.set(res_id, { std::move(asset), size });
 }
 
+void AnimationBuilder::preloadImageAssets(const skjson::ObjectValue& jroot) const {
+    // Image layers can be nested in precomps, so we visit the layers of all compositions.
+    const auto preload_layers = [this](const skjson::ArrayValue* jlayers) {
+        if (!jlayers) {
+            return;
+        }
+
+        for (const skjson::ObjectValue* jlayer : *jlayers) {
+            if (!jlayer) {
+                continue;
+            }
+
+            // 'ty': 2 -> image, 9 -> video
+            const auto type = ParseDefault<int>((*jlayer)["ty"], -1);
+            if (type != 2 && type != 9) {
+                continue;
+            }
+
+            const auto ref_id = ParseDefault<SkString>((*jlayer)["refId"], SkString());
+            if (const auto* asset_info = fAssets.find(ref_id)) {
+                this->loadFootageAsset(*asset_info->fAsset);
+            }
+        }
+    };
+
+    preload_layers(jroot["layers"]);
+    fAssets.foreach([&](const SkString&, const AssetInfo& asset_info) {
+        preload_layers((*asset_info.fAsset)["layers"]);
+    });
+}
+
 sk_sp<sksg::RenderNode> AnimationBuilder::attachFootageAsset(const skjson::ObjectValue& jimage,
                                                              LayerInfo* layer_info) const {
     const auto* asset_info = this->loadFootageAsset(jimage);
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkString.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/SkottieValue.h"
@@ -25,7 +26,7 @@ public:
     explicit MockProperty(const char* jprop) {
         AnimationBuilder abuilder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
                                   nullptr, nullptr,
-                                  {100, 100}, 10, 1, 0);
+                                  {100, 100}, 10, 1, 0, 0);
         skjson::DOM json_dom(jprop, strlen(jprop));
 
         fDidBind = this->bind(abuilder, json_dom.root(), &fValue);
@@ -198,3 +199,28 @@ DEF_TEST(Skottie_Keyframe, reporter) {
         REPORTER_ASSERT(reporter, prop(0.85f).y > 200);
     }
 }
+
+DEF_TEST(Skottie_Keyframe_Sequential, reporter) {
+    // v(t) = t * t at integer ts, linearly interpolated.
+    SkString json(R"({ "a": 1, "k": [)");
+    for (int i = 0; i <= 20; ++i) {
+        json.appendf(R"(%s{ "t": %d, "s": %d })", i ? "," : "", i, i * i);
+    }
+    json.append("]}");
+
+    MockProperty<ScalarValue> prop(json.c_str());
+    REPORTER_ASSERT(reporter, prop);
+
+    const auto expected = [](float t) {
+        const auto t0 = std::floor(t);
+        return t0 * t0 + (t - t0) * (2 * t0 + 1);
+    };
+
+    // Forward and backward playback, small and large steps.
+    for (float step : {0.25f, -0.25f, 0.5f, -0.75f, 3.5f, -7.25f}) {
+        for (float t = step > 0 ? 0 : 19.9f; t >= 0 && t < 20; t += step) {
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(prop(t), expected(t), 0.001f),
+                            "t: %f", t);
+        }
+    }
+}
@@ -8,11 +8,17 @@
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSpan.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "modules/skparagraph/include/FontArguments.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/include/TextStyle.h"
 #include "src/core/SkTHash.h"
 
+namespace SkShapers::HB {
+class RunCache;
+}
+
 namespace skia {
 namespace textlayout {
 
@@ -21,6 +27,7 @@ class Paragraph;
 class FontCollection : public SkRefCnt {
 public:
     FontCollection();
+    ~FontCollection() override;
 
     size_t getFontManagersCount() const;
 
@@ -46,6 +53,11 @@ public:
 
     ParagraphCache* getParagraphCache() { return &fParagraphCache; }
 
+    // Keeps up to |byteBudget| bytes of shaped text runs, so that paragraphs which repeat text
+    // only shape it once. Off by default; a budget of 0 turns it off again.
+    void setShapedRunCacheLimit(size_t byteBudget);
+    sk_sp<SkShapers::HB::RunCache> getShapedRunCache() const;
+
     void clearCaches();
 
 private:
@@ -71,7 +83,10 @@ private:
     };
 
     bool fEnableFontFallback;
-    skia_private::THashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces;
+    // Paragraphs laid out on different threads may look up typefaces at the same time.
+    SkMutex fTypefacesMutex;
+    skia_private::THashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces
+            SK_GUARDED_BY(fTypefacesMutex);
     sk_sp<SkFontMgr> fDefaultFontManager;
     sk_sp<SkFontMgr> fAssetFontManager;
     sk_sp<SkFontMgr> fDynamicFontManager;
@@ -79,6 +94,7 @@ private:
 
     std::vector<SkString> fDefaultFamilyNames;
     ParagraphCache fParagraphCache;
+    sk_sp<SkShapers::HB::RunCache> fShapedRunCache;
 };
 }  // namespace textlayout
 }  // namespace skia
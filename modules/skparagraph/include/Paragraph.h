@@ -3,6 +3,7 @@
 #define Paragraph_DEFINED
 
 #include "include/core/SkPath.h"
+#include "include/core/SkSpan.h"
 #include "modules/skparagraph/include/FontCollection.h"
 #include "modules/skparagraph/include/Metrics.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
@@ -10,6 +11,7 @@
 #include <unordered_set>
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -41,6 +43,16 @@ public:
 
     virtual void layout(SkScalar width) = 0;
 
+    /**
+     *  Lays out each of |paragraphs| at |width| as layout() does, on |executor|'s threads, and
+     *  returns once they are all laid out. The paragraphs may share a FontCollection and an
+     *  SkUnicode, but the FontCollection's font managers must not be changed while they are laid
+     *  out. Without an executor the paragraphs are laid out on the calling thread.
+     */
+    static void LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkScalar width,
+                          SkExecutor* executor);
+
     virtual void paint(SkCanvas* canvas, SkScalar x, SkScalar y) = 0;
 
     virtual void paint(ParagraphPainter* painter, SkScalar x, SkScalar y) = 0;
@@ -80,6 +92,13 @@ public:
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
 
+    // Experimental API that replaces the UTF-8 text in [from, to) with |utf8|, which takes the
+    // style of the text before it. Returns false and leaves the paragraph unchanged if the edit
+    // would remove a whole style block or change a placeholder; build a new paragraph instead.
+    // Once edited, a paragraph shapes each line separately and keeps the shaped runs, so the
+    // next layout only reshapes the lines the edit changed.
+    virtual bool updateText(size_t from, size_t to, const char* utf8, size_t utf8Bytes) = 0;
+
     enum VisitorFlags {
         kWhiteSpace_VisitorFlag = 1 << 0,
     };
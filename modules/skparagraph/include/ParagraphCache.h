@@ -3,10 +3,13 @@
 #define ParagraphCache_DEFINED
 
 #include "include/private/base/SkMutex.h"
-#include "src/core/SkLRUCache.h"
-#include <functional>  // std::function
+#include "include/private/base/SkThreadAnnotations.h"
 
-#define PARAGRAPH_CACHE_STATS
+#include <cstddef>
+#include <cstdint>
+#include <functional>  // std::function
+#include <memory>
+#include <string>
 
 namespace skia {
 namespace textlayout {
@@ -25,40 +28,56 @@ public:
     bool updateParagraph(ParagraphImpl* paragraph);
     bool findParagraph(ParagraphImpl* paragraph);
 
+    // Sets the approximate number of bytes the cached paragraphs may use, dropping the least
+    // recently used ones if they use more. The budget is split between the shards, so a paragraph
+    // bigger than a shard's share is not cached.
+    void setByteLimit(size_t byteLimit);
+    size_t getByteLimit() const;
+
+    struct Stats {
+        int64_t fHits = 0;
+        int64_t fMisses = 0;
+        int64_t fEvictions = 0;
+        size_t fBytes = 0;
+        int fCount = 0;
+    };
+    Stats stats() const;
+
     // For testing
     void setChecker(std::function<void(ParagraphImpl* impl, const char*, bool)> checker) {
         fChecker = std::move(checker);
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count() { return this->stats().fCount; }
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
  private:
 
     struct Entry;
+    struct Shard;
     void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
 
-     mutable SkMutex fParagraphMutex;
-     std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
-
-    static const int kMaxEntries = 128;
+    Shard& shardFor(const ParagraphCacheKey& key) const;
 
     struct KeyHash {
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
+    static constexpr size_t kDefaultByteLimit = 4 * 1024 * 1024;
+    // Each shard has its own lock, so that layouts on different threads rarely wait on each other.
+    static constexpr int kShardCount = 8;
+
+    std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
+    std::unique_ptr<Shard[]> fShards;
     bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
 
-#ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
-#endif
+    // The ends of the text of the last paragraph added, for isPossiblyTextEditing().
+    mutable SkMutex fLastTextMutex;
+    std::string fLastTextPrefix SK_GUARDED_BY(fLastTextMutex);
+    std::string fLastTextSuffix SK_GUARDED_BY(fLastTextMutex);
 };
 
 }  // namespace textlayout
@@ -544,6 +544,17 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
     size_t bidiIndex = 0;
 
     SkScalar advanceX = 0;
+    auto shapeRange = [&](TextRange textRange, uint8_t bidiLevel) {
+        // Set up the iterators (the style iterator points to a bigger region that it could
+        auto blockRange = fParagraph->findAllBlocks(textRange);
+        if (blockRange.empty()) {
+            return true;
+        }
+        SkSpan<Block> styleSpan(fParagraph->blocks(blockRange));
+
+        // Shape the text between placeholders
+        return shape(textRange, styleSpan, advanceX, textRange.start, bidiLevel) != 0;
+    };
     for (auto& placeholder : fParagraph->fPlaceholders) {
 
         if (placeholder.fTextBefore.width() > 0) {
@@ -553,16 +564,20 @@ bool OneLineShaper::iterateThroughShapingRegions(const ShapeVisitor& shape) {
                 auto start = std::max(bidiRegion.start, placeholder.fTextBefore.start);
                 auto end = std::min(bidiRegion.end, placeholder.fTextBefore.end);
 
-                // Set up the iterators (the style iterator points to a bigger region that it could
-                TextRange textRange(start, end);
-                auto blockRange = fParagraph->findAllBlocks(textRange);
-                if (!blockRange.empty()) {
-                    SkSpan<Block> styleSpan(fParagraph->blocks(blockRange));
-
-                    // Shape the text between placeholders
-                    if (!shape(textRange, styleSpan, advanceX, start, bidiRegion.level)) {
-                        return false;
+                // An edited paragraph shapes each hard line on its own, so that the lines the
+                // edit didn't touch are found in the shaped run cache
+                if (fParagraph->shapeLinesSeparately()) {
+                    for (auto lineStart = start, i = start + 1; i <= end; ++i) {
+                        if (i == end || fParagraph->codeUnitHasProperty(
+                                i, SkUnicode::CodeUnitFlags::kHardLineBreakBefore)) {
+                            if (!shapeRange(TextRange(lineStart, i), bidiRegion.level)) {
+                                return false;
+                            }
+                            lineStart = i;
+                        }
                     }
+                } else if (!shapeRange(TextRange(start, end), bidiRegion.level)) {
+                    return false;
                 }
 
                 if (end == bidiRegion.end) {
@@ -625,8 +640,10 @@ bool OneLineShaper::shape() {
             (TextRange textRange, SkSpan<Block> styleSpan, SkScalar& advanceX, TextIndex textStart, uint8_t defaultBidiLevel) {
 
         // Set up the shaper and shape the next
-        auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(fParagraph->fUnicode,
-                                                            SkFontMgr::RefEmpty());  // no fallback
+        auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(
+                fParagraph->fUnicode,
+                SkFontMgr::RefEmpty(),  // no fallback
+                fParagraph->shapedRunCache());
         if (shaper == nullptr) {
             // For instance, loadICU does not work. We have to stop the process
             return false;
@@ -1,10 +1,13 @@
 // Copyright 2019 Google LLC.
+#include <cstring>
+#include <limits>
 #include <memory>
 
 #include "modules/skparagraph/include/FontArguments.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
 #include "modules/skparagraph/src/ParagraphImpl.h"
 #include "src/base/SkFloatBits.h"
+#include "src/core/SkLRUCache.h"
 
 using namespace skia_private;
 
@@ -28,6 +31,8 @@ namespace {
 
 }  // namespace
 
+#define NOCACHE_PREFIX_LENGTH 40
+
 class ParagraphCacheKey {
 public:
     ParagraphCacheKey(const ParagraphImpl* paragraph)
@@ -80,6 +85,21 @@ public:
         , fHasWhitespacesInside(paragraph->fHasWhitespacesInside)
         , fTrailingSpaces(paragraph->fTrailingSpaces) { }
 
+    // Roughly the memory used by the key and the copies of the paragraph's data.
+    size_t approximateBytes() const {
+        size_t bytes = sizeof(ParagraphCacheValue) + fKey.text().size();
+        for (const Run& run : fRuns) {
+            bytes += sizeof(Run) +
+                     run.size() * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) + sizeof(uint32_t));
+        }
+        bytes += fClusters.size() * sizeof(Cluster);
+        bytes += fClustersIndexFromCodeUnit.size() * sizeof(size_t);
+        bytes += fCodeUnitProperties.size() * sizeof(SkUnicode::CodeUnitFlags);
+        bytes += fWords.size() * sizeof(size_t);
+        bytes += fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+        return bytes;
+    }
+
     // Input == key
     ParagraphCacheKey fKey;
 
@@ -234,24 +254,77 @@ bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
 
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    Entry(ParagraphCacheValue* value) : fValue(value), fBytes(value->approximateBytes()) {}
     std::unique_ptr<ParagraphCacheValue> fValue;
+    const size_t fBytes;
+};
+
+struct ParagraphCache::Shard {
+    Shard() : fLRUCacheMap(std::numeric_limits<int>::max()) {}
+
+    void evictToLimit() SK_REQUIRES(fMutex) {
+        while (fBytes > fByteLimit) {
+            fBytes -= (*fLRUCacheMap.peekLRU())->fBytes;
+            fLRUCacheMap.removeLRU();
+            ++fEvictions;
+        }
+    }
+
+    SkMutex fMutex;
+    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap
+            SK_GUARDED_BY(fMutex);
+    size_t fBytes SK_GUARDED_BY(fMutex) = 0;
+    size_t fByteLimit SK_GUARDED_BY(fMutex) = kDefaultByteLimit / kShardCount;
+    int64_t fHits SK_GUARDED_BY(fMutex) = 0;
+    int64_t fMisses SK_GUARDED_BY(fMutex) = 0;
+    int64_t fEvictions SK_GUARDED_BY(fMutex) = 0;
 };
 
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
+    , fShards(new Shard[kShardCount])
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
-#ifdef PARAGRAPH_CACHE_STATS
-    , fTotalRequests(0)
-    , fCacheMisses(0)
-    , fHashMisses(0)
-#endif
 { }
 
 ParagraphCache::~ParagraphCache() { }
 
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) const {
+    return fShards[key.hash() % kShardCount];
+}
+
+void ParagraphCache::setByteLimit(size_t byteLimit) {
+    for (int i = 0; i < kShardCount; ++i) {
+        Shard& shard = fShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fByteLimit = byteLimit / kShardCount;
+        shard.evictToLimit();
+    }
+}
+
+size_t ParagraphCache::getByteLimit() const {
+    size_t byteLimit = 0;
+    for (int i = 0; i < kShardCount; ++i) {
+        Shard& shard = fShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        byteLimit += shard.fByteLimit;
+    }
+    return byteLimit;
+}
+
+ParagraphCache::Stats ParagraphCache::stats() const {
+    Stats stats;
+    for (int i = 0; i < kShardCount; ++i) {
+        Shard& shard = fShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        stats.fHits += shard.fHits;
+        stats.fMisses += shard.fMisses;
+        stats.fEvictions += shard.fEvictions;
+        stats.fBytes += shard.fBytes;
+        stats.fCount += shard.fLRUCacheMap.count();
+    }
+    return stats;
+}
+
 void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
     paragraph->fRuns.clear();
@@ -273,12 +346,15 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 }
 
 void ParagraphCache::printStatistics() {
+    Stats stats = this->stats();
+    int64_t totalRequests = stats.fHits + stats.fMisses;
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
-    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Total requests: %lld\n", (long long)totalRequests);
+    SkDebugf("Cache misses: %lld\n", (long long)stats.fMisses);
+    SkDebugf("Cache miss %%: %f\n",
+             (totalRequests > 0) ? 100.f * stats.fMisses / totalRequests : 0.f);
+    SkDebugf("Evictions: %lld\n", (long long)stats.fEvictions);
+    SkDebugf("Entries: %d, bytes: %zu\n", stats.fCount, stats.fBytes);
     SkDebugf("---------------------\n");
 }
 
@@ -287,35 +363,36 @@ void ParagraphCache::abandon() {
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
-#ifdef PARAGRAPH_CACHE_STATS
-    fTotalRequests = 0;
-    fCacheMisses = 0;
-    fHashMisses = 0;
-#endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    for (int i = 0; i < kShardCount; ++i) {
+        Shard& shard = fShards[i];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fLRUCacheMap.reset();
+        shard.fBytes = 0;
+        shard.fHits = 0;
+        shard.fMisses = 0;
+        shard.fEvictions = 0;
+    }
+    SkAutoMutexExclusive lock(fLastTextMutex);
+    fLastTextPrefix.clear();
+    fLastTextSuffix.clear();
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
 
     if (!entry) {
         // We have a cache miss
-#ifdef PARAGRAPH_CACHE_STATS
-        ++fCacheMisses;
-#endif
+        ++shard.fMisses;
         fChecker(paragraph, "missingParagraph", true);
         return false;
     }
+    ++shard.fHits;
     updateTo(paragraph, entry->get());
     fChecker(paragraph, "foundParagraph", true);
     return true;
@@ -325,51 +402,64 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
-
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
-    if (!entry) {
-        // isTooMuchMemoryWasted(paragraph) not needed for now
-        if (isPossiblyTextEditing(paragraph)) {
-            // Skip this paragraph
+    Shard& shard = this->shardFor(key);
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (shard.fLRUCacheMap.find(key)) {
+            // We do not have to update the paragraph
+            return false;
+        }
+    }
+
+    // isTooMuchMemoryWasted(paragraph) not needed for now
+    if (isPossiblyTextEditing(paragraph)) {
+        // Skip this paragraph
+        return false;
+    }
+    auto entry = std::make_unique<Entry>(new ParagraphCacheValue(std::move(key), paragraph));
+    {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (entry->fBytes > shard.fByteLimit || shard.fLRUCacheMap.find(entry->fValue->fKey)) {
+            // Too big to cache, or another thread added it first.
             return false;
         }
-        ParagraphCacheValue* value = new ParagraphCacheValue(std::move(key), paragraph);
-        fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value));
+        shard.fBytes += entry->fBytes;
+        const ParagraphCacheKey& entryKey = entry->fValue->fKey;
+        shard.fLRUCacheMap.insert(entryKey, std::move(entry));
+        shard.evictToLimit();
         fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
-        return true;
+    }
+
+    const SkString& text = paragraph->fText;
+    SkAutoMutexExclusive lock(fLastTextMutex);
+    if (text.size() < NOCACHE_PREFIX_LENGTH) {
+        fLastTextPrefix.clear();
+        fLastTextSuffix.clear();
     } else {
-        // We do not have to update the paragraph
-        return false;
+        fLastTextPrefix.assign(text.c_str(), NOCACHE_PREFIX_LENGTH);
+        fLastTextSuffix.assign(text.c_str() + text.size() - NOCACHE_PREFIX_LENGTH,
+                               NOCACHE_PREFIX_LENGTH);
     }
+    return true;
 }
 
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
-#define NOCACHE_PREFIX_LENGTH 40
 bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
-        return false;
-    }
-
-    auto& lastText = fLastCachedValue->fKey.text();
+    SkAutoMutexExclusive lock(fLastTextMutex);
     auto& text = paragraph->fText;
 
-    if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
+    if (fLastTextPrefix.empty() || (text.size() < NOCACHE_PREFIX_LENGTH)) {
         // Either last text or the current are too short
         return false;
     }
 
-    if (std::strncmp(lastText.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
+    if (std::strncmp(fLastTextPrefix.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
         // Texts have the same starts
         return true;
     }
 
-    if (std::strncmp(lastText.c_str() + lastText.size() - NOCACHE_PREFIX_LENGTH, &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
+    if (std::strncmp(fLastTextSuffix.c_str(), &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
         // Texts have the same ends
         return true;
     }
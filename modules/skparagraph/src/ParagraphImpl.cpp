@@ -1,5 +1,6 @@
 // Copyright 2019 Google LLC.
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
@@ -21,6 +22,7 @@
 #include "modules/skparagraph/src/TextWrapper.h"
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTextBlobPriv.h"
 
 #include <algorithm>
@@ -70,6 +72,22 @@ Paragraph::Paragraph(ParagraphStyle style, sk_sp<FontCollection> fonts)
     SkASSERT(fFontCollection);
 }
 
+void Paragraph::LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkScalar width,
+                          SkExecutor* executor) {
+    if (!executor || paragraphs.size() < 2) {
+        for (Paragraph* paragraph : paragraphs) {
+            paragraph->layout(width);
+        }
+        return;
+    }
+    SkTaskGroup taskGroup(*executor);
+    for (Paragraph* paragraph : paragraphs) {
+        taskGroup.add([paragraph, width] { paragraph->layout(width); });
+    }
+    taskGroup.wait();
+}
+
 ParagraphImpl::ParagraphImpl(const SkString& text,
                              ParagraphStyle style,
                              TArray<Block, true> blocks,
@@ -1120,6 +1138,108 @@ void ParagraphImpl::updateBackgroundPaint(size_t from, size_t to, SkPaint paint)
     }
 }
 
+bool ParagraphImpl::updateText(size_t from, size_t to, const char* utf8, size_t utf8Bytes) {
+    auto isCodepointStart = [this](size_t index) {
+        return index == fText.size() || (fText[index] & 0xC0) != 0x80;
+    };
+    if (from > to || to > fText.size() || !isCodepointStart(from) || !isCodepointStart(to) ||
+        SkUTF::CountUTF8(utf8, utf8Bytes) < 0) {
+        return false;
+    }
+    for (const Placeholder& placeholder : fPlaceholders) {
+        if (placeholder.fRange.width() > 0 &&
+            from < placeholder.fRange.end && placeholder.fRange.start < to) {
+            return false;
+        }
+    }
+
+    // The new text takes the style of the first character it replaces, or of the one before it.
+    const size_t styledBy = (to > from || from == 0) ? from : from - 1;
+    int anchor = 0;
+    while (anchor < fTextStyles.size() && !(fTextStyles[anchor].fRange.start <= styledBy &&
+                                            styledBy < fTextStyles[anchor].fRange.end)) {
+        ++anchor;
+    }
+    if (anchor < fTextStyles.size() && fTextStyles[anchor].fStyle.isPlaceholder() &&
+        from == to && anchor + 1 < fTextStyles.size() &&
+        fTextStyles[anchor + 1].fRange.start == from) {
+        // Typing right after a placeholder.
+        ++anchor;
+    }
+    if (anchor == fTextStyles.size() || fTextStyles[anchor].fStyle.isPlaceholder()) {
+        return false;
+    }
+    for (int i = 0; i < fTextStyles.size(); ++i) {
+        const TextRange range = fTextStyles[i].fRange;
+        if (range.width() > 0 && from <= range.start && range.end <= to &&
+            (i != anchor || utf8Bytes == 0)) {
+            return false;
+        }
+    }
+
+    // Ranges before the new text keep their positions, ranges after it move with it.
+    const TextRange anchorRange = fTextStyles[anchor].fRange;
+    const size_t insertedEnd = from + utf8Bytes;
+    auto moveAfter = [&](size_t index) { return index >= to ? index - to + insertedEnd
+                                                            : insertedEnd; };
+    auto moveRange = [&](TextRange range) {
+        if (range.end <= anchorRange.start) {
+            return range;
+        }
+        return TextRange(moveAfter(range.start), moveAfter(range.end));
+    };
+    for (int i = 0; i < fTextStyles.size(); ++i) {
+        TextRange& range = fTextStyles[i].fRange;
+        range = i == anchor ? TextRange(range.start, moveAfter(range.end)) : moveRange(range);
+    }
+    TextIndex textBefore = 0;
+    for (Placeholder& placeholder : fPlaceholders) {
+        placeholder.fRange = moveRange(placeholder.fRange);
+        placeholder.fTextBefore = TextRange(textBefore, placeholder.fRange.start);
+        textBefore = placeholder.fRange.end;
+    }
+
+    fText.remove(from, to - from);
+    fText.insert(from, utf8, utf8Bytes);
+
+    // Everything derived from the text is computed again by the next layout.
+    fState = kUnknown;
+    fRuns.clear();
+    fClusters.clear();
+    fClustersIndexFromCodeUnit.clear();
+    fLines.clear();
+    fCodeUnitProperties.clear();
+    fBidiRegions.clear();
+    fWords.clear();
+    fHasLineBreaks = false;
+    fHasWhitespacesInside = false;
+    fPicture = nullptr;
+    fOldWidth = 0;
+    fOldHeight = 0;
+    if (!fUTF8IndexForUTF16Index.empty()) {
+        // The mapping was already filled once, so it has to be refilled here.
+        fUTF8IndexForUTF16Index.clear();
+        fUTF16IndexForUTF8Index.clear();
+        SkUnicode::extractUtfConversionMapping(
+                this->text(),
+                [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
+                [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+    }
+
+    fShapeLinesSeparately = true;
+    if (!fFontCollection->getShapedRunCache() && !fEditRunCache) {
+        fEditRunCache = SkShapers::HB::RunCache::Make(kEditRunCacheBytes);
+    }
+    return true;
+}
+
+sk_sp<SkShapers::HB::RunCache> ParagraphImpl::shapedRunCache() const {
+    if (sk_sp<SkShapers::HB::RunCache> cache = fFontCollection->getShapedRunCache()) {
+        return cache;
+    }
+    return fEditRunCache;
+}
+
 TArray<TextIndex> ParagraphImpl::countSurroundingGraphemes(TextRange textRange) const {
     textRange = textRange.intersection({0, fText.size()});
     TArray<TextIndex> graphemes;
@@ -24,6 +24,7 @@
 #include "modules/skparagraph/include/TextStyle.h"
 #include "modules/skparagraph/src/Run.h"
 #include "modules/skparagraph/src/TextLine.h"
+#include "modules/skshaper/include/SkShaper_harfbuzz.h"
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkBitmaskEnum.h"
 #include "src/core/SkTHash.h"
@@ -207,6 +208,12 @@ public:
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
+    bool updateText(size_t from, size_t to, const char* utf8, size_t utf8Bytes) override;
+
+    // The cache to shape with: one of the paragraph's own once it has been edited, if the font
+    // collection has none.
+    sk_sp<SkShapers::HB::RunCache> shapedRunCache() const;
+    bool shapeLinesSeparately() const { return fShapeLinesSeparately; }
 
     void visit(const Visitor&) override;
     void extendedVisit(const ExtendedVisitor&) override;
@@ -300,6 +307,11 @@ private:
     bool fHasLineBreaks;
     bool fHasWhitespacesInside;
     TextIndex fTrailingSpaces;
+
+    // Set by updateText(), so that editing one line doesn't reshape the others.
+    static constexpr size_t kEditRunCacheBytes = 256 * 1024;
+    bool fShapeLinesSeparately = false;
+    sk_sp<SkShapers::HB::RunCache> fEditRunCache;
 };
 }  // namespace textlayout
 }  // namespace skia
@@ -7,6 +7,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkPaint.h"
@@ -5483,6 +5484,147 @@ UNIX_ONLY_TEST(SkParagraph_CacheText, reporter) {
     test("text3", 2, false);
 }
 
+UNIX_ONLY_TEST(SkParagraph_CacheByteLimit, reporter) {
+    ParagraphCache cache;
+    cache.turnOn(true);
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+    builder.pushStyle(text_style);
+    builder.addText("text1");
+    builder.pop();
+    auto paragraph = builder.Build();
+    auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+
+    REPORTER_ASSERT(reporter, !cache.findParagraph(impl));
+    REPORTER_ASSERT(reporter, cache.updateParagraph(impl));
+    REPORTER_ASSERT(reporter, cache.findParagraph(impl));
+    ParagraphCache::Stats stats = cache.stats();
+    REPORTER_ASSERT(reporter, stats.fHits == 1);
+    REPORTER_ASSERT(reporter, stats.fMisses == 1);
+    REPORTER_ASSERT(reporter, stats.fEvictions == 0);
+    REPORTER_ASSERT(reporter, stats.fCount == 1);
+    REPORTER_ASSERT(reporter, stats.fBytes > 0 && stats.fBytes <= cache.getByteLimit());
+
+    // Shrinking the budget drops the paragraph, and it no longer fits.
+    cache.setByteLimit(stats.fBytes - 1);
+    stats = cache.stats();
+    REPORTER_ASSERT(reporter, stats.fEvictions == 1);
+    REPORTER_ASSERT(reporter, stats.fCount == 0);
+    REPORTER_ASSERT(reporter, stats.fBytes == 0);
+    REPORTER_ASSERT(reporter, !cache.updateParagraph(impl));
+    REPORTER_ASSERT(reporter, cache.count() == 0);
+}
+
+UNIX_ONLY_TEST(SkParagraph_LayoutAll, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+    text_style.setFontSize(20);
+
+    auto build = [&](int i) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        SkString text = SkStringPrintf("Paragraph %d has a few words that wrap %d times", i, i);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    constexpr int kCount = 32;
+    constexpr SkScalar kWidth = 150;
+    std::vector<std::unique_ptr<Paragraph>> expected, actual;
+    std::vector<Paragraph*> paragraphs;
+    for (int i = 0; i < kCount; ++i) {
+        expected.push_back(build(i));
+        expected.back()->layout(kWidth);
+        actual.push_back(build(i));
+        paragraphs.push_back(actual.back().get());
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    Paragraph::LayoutAll(paragraphs, kWidth, executor.get());
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, actual[i]->getHeight() == expected[i]->getHeight());
+        REPORTER_ASSERT(reporter, actual[i]->getLongestLine() == expected[i]->getLongestLine());
+        REPORTER_ASSERT(reporter, actual[i]->lineNumber() == expected[i]->lineNumber());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_UpdateText, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->getParagraphCache()->turnOn(false);
+
+    ParagraphStyle paragraph_style;
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+    text_style.setFontSize(20);
+    TextStyle bold_style = text_style;
+    bold_style.setFontStyle(SkFontStyle::Bold());
+
+    auto build = [&](const char* first, const char* second) {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection, get_unicode());
+        builder.pushStyle(text_style);
+        builder.addText(first);
+        builder.pushStyle(bold_style);
+        builder.addText(second);
+        builder.pop();
+        builder.addPlaceholder(PlaceholderStyle(20, 20, PlaceholderAlignment::kBaseline,
+                                                TextBaseline::kAlphabetic, 0));
+        builder.addText("end");
+        return builder.Build();
+    };
+
+    constexpr SkScalar kWidth = 200;
+    auto paragraph = build("First line\n" "Second line\n", "Third line");
+    paragraph->layout(kWidth);
+
+    // Replace "Second" with words long enough to wrap.
+    REPORTER_ASSERT(reporter, paragraph->updateText(11, 17, "Secondsecondsecond second", 25));
+    paragraph->layout(kWidth);
+    auto expected = build("First line\n" "Secondsecondsecond second line\n", "Third line");
+    expected->layout(kWidth);
+    REPORTER_ASSERT(reporter, paragraph->lineNumber() == expected->lineNumber());
+    REPORTER_ASSERT(reporter, paragraph->getHeight() == expected->getHeight());
+    REPORTER_ASSERT(reporter, paragraph->getLongestLine() == expected->getLongestLine());
+
+    // Remove the first line, then add a word that takes the bold style of the one before it.
+    REPORTER_ASSERT(reporter, paragraph->updateText(0, 11, "", 0));
+    const size_t thirdEnd = strlen("Secondsecondsecond second line\n" "Third");
+    REPORTER_ASSERT(reporter, paragraph->updateText(thirdEnd, thirdEnd, " bold", 5));
+    paragraph->layout(kWidth);
+    expected = build("Secondsecondsecond second line\n", "Third bold line");
+    expected->layout(kWidth);
+    REPORTER_ASSERT(reporter, paragraph->lineNumber() == expected->lineNumber());
+    REPORTER_ASSERT(reporter, paragraph->getHeight() == expected->getHeight());
+    REPORTER_ASSERT(reporter, paragraph->getLongestLine() == expected->getLongestLine());
+    auto boxes = paragraph->getRectsForPlaceholders();
+    auto expectedBoxes = expected->getRectsForPlaceholders();
+    REPORTER_ASSERT(reporter, boxes.size() == 1 && expectedBoxes.size() == 1 &&
+                              boxes[0].rect == expectedBoxes[0].rect);
+
+    // Edits that would remove a placeholder or a style block are refused.
+    const size_t placeholderStart =
+            strlen("Secondsecondsecond second line\n" "Third bold line");
+    REPORTER_ASSERT(reporter,
+                    !paragraph->updateText(placeholderStart, placeholderStart + 3, "", 0));
+    REPORTER_ASSERT(reporter, !paragraph->updateText(thirdEnd - 6, placeholderStart, "x", 1));
+    REPORTER_ASSERT(reporter, !paragraph->updateText(1, 0, "x", 1));
+}
+
 UNIX_ONLY_TEST(SkParagraph_CacheFonts, reporter) {
     ParagraphCache cache;
     cache.turnOn(true);
@@ -22,6 +22,7 @@
 
 class SkAnimCodecPlayer;
 class SkCodec;
+class SkExecutor;
 class SkImage;
 
 namespace skresources {
@@ -284,6 +285,37 @@ private:
     using INHERITED = ResourceProviderProxyBase;
 };
 
+/**
+ * Loads image assets asynchronously, on an SkExecutor.
+ *
+ * loadImageAsset() returns immediately, with a proxy asset.  The wrapped provider's
+ * loadImageAsset() runs on the executor, along with the first frame resolution (and decode, for
+ * ImageDecodeStrategy::kPreDecode) of static images.  Using the proxy asset waits for its
+ * load to complete.
+ *
+ * When many image assets are requested before any of them are used (e.g. Skottie with
+ * Animation::Builder::kPreloadImageAssets), they are all loaded and decoded in parallel.
+ *
+ * The wrapped provider's loadImageAsset() is called concurrently from the executor threads, and
+ * must be thread safe.  The other resource types are loaded synchronously.
+ */
+class SK_API AsyncResourceProviderProxy final : public ResourceProviderProxyBase {
+public:
+    // Loads image assets on |executor|, or on SkExecutor::GetDefault() if null.  The executor must
+    // outlive the provider and any assets it returns.
+    static sk_sp<AsyncResourceProviderProxy> Make(sk_sp<ResourceProvider> rp,
+                                                  SkExecutor* executor = nullptr);
+
+private:
+    AsyncResourceProviderProxy(sk_sp<ResourceProvider>, SkExecutor*);
+
+    sk_sp<ImageAsset> loadImageAsset(const char[], const char[], const char[]) const override;
+
+    SkExecutor* fExecutor;
+
+    using INHERITED = ResourceProviderProxyBase;
+};
+
 } // namespace skresources
 
 #endif // SkResources_DEFINED
@@ -10,8 +10,11 @@
 #include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkImage.h"
+#include "include/private/base/SkOnce.h"
+#include "include/private/base/SkSemaphore.h"
 #include "include/private/base/SkTPin.h"
 #include "modules/skresources/src/SkAnimCodecPlayer.h"
 #include "src/base/SkBase64.h"
@@ -91,6 +94,61 @@ private:
 
 #endif // defined(HAVE_VIDEO_DECODER)
 
+// Image asset proxy, loaded on an executor.
+class AsyncImageAsset final : public ImageAsset {
+public:
+    static sk_sp<AsyncImageAsset> Make(SkExecutor* executor, sk_sp<ResourceProvider> rp,
+                                       const char path[], const char name[], const char id[]) {
+        sk_sp<AsyncImageAsset> asset(new AsyncImageAsset());
+
+        executor->add([asset, rp = std::move(rp),
+                       path = SkString(path), name = SkString(name), id = SkString(id)]() {
+            asset->load(*rp, path.c_str(), name.c_str(), id.c_str());
+        });
+
+        return asset;
+    }
+
+private:
+    AsyncImageAsset() = default;
+
+    void load(const ResourceProvider& rp, const char path[], const char name[], const char id[]) {
+        fAsset = rp.loadImageAsset(path, name, id);
+        fIsMultiFrame = fAsset && fAsset->isMultiFrame();
+        if (fAsset && !fIsMultiFrame) {
+            // Static images resolve their only frame upfront, which is where they are decoded.
+            fStaticFrame = fAsset->getFrameData(0);
+        }
+        fLoaded.signal();
+    }
+
+    void waitForLoad() {
+        fWaitOnce([this] { fLoaded.wait(); });
+    }
+
+    bool isMultiFrame() override {
+        this->waitForLoad();
+        return fIsMultiFrame;
+    }
+
+    FrameData getFrameData(float t) override {
+        this->waitForLoad();
+        if (!fAsset) {
+            return {};
+        }
+
+        return fIsMultiFrame ? fAsset->getFrameData(t) : fStaticFrame;
+    }
+
+    // Written on the executor, before fLoaded is signaled.
+    sk_sp<ImageAsset> fAsset;
+    bool              fIsMultiFrame = false;
+    FrameData         fStaticFrame;
+
+    SkSemaphore       fLoaded;
+    SkOnce            fWaitOnce;
+};
+
 } // namespace
 
 sk_sp<SkImage> ImageAsset::getFrame(float t) {
@@ -334,4 +392,21 @@ sk_sp<SkTypeface> DataURIResourceProviderProxy::loadTypeface(const char name[],
     return this->INHERITED::loadTypeface(name, url);
 }
 
+sk_sp<AsyncResourceProviderProxy> AsyncResourceProviderProxy::Make(sk_sp<ResourceProvider> rp,
+                                                                   SkExecutor* executor) {
+    return rp ? sk_sp<AsyncResourceProviderProxy>(new AsyncResourceProviderProxy(
+                        std::move(rp), executor ? executor : &SkExecutor::GetDefault()))
+              : nullptr;
+}
+
+AsyncResourceProviderProxy::AsyncResourceProviderProxy(sk_sp<ResourceProvider> rp,
+                                                       SkExecutor* executor)
+        : INHERITED(std::move(rp)), fExecutor(executor) {}
+
+sk_sp<ImageAsset> AsyncResourceProviderProxy::loadImageAsset(const char rpath[],
+                                                             const char rname[],
+                                                             const char rid[]) const {
+    return AsyncImageAsset::Make(fExecutor, fProxy, rpath, rname, rid);
+}
+
 } // namespace skresources
@@ -26,6 +26,7 @@
 
 class SkCanvas;
 class SkMatrix;
+class SkPicture;
 
 // TODO: merge EffectNode.h with this header
 
@@ -278,6 +279,32 @@ private:
     using INHERITED = EffectNode;
 };
 
+/**
+ * Caches the rendered content of a (mostly static) sub-DAG as an SkPicture.
+ *
+ * The picture is recorded on first render, and replayed on subsequent renders until a descendant
+ * is invalidated.  Ancestor transform and opacity changes don't invalidate the descendants, so
+ * animating those only recomposites the cached content.
+ */
+class CacheEffect final : public EffectNode {
+public:
+    ~CacheEffect() override;
+
+    static sk_sp<CacheEffect> Make(sk_sp<RenderNode> child);
+
+protected:
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    explicit CacheEffect(sk_sp<RenderNode> child);
+
+    mutable sk_sp<SkPicture> fPicture;
+
+    using INHERITED = EffectNode;
+};
+
 } // namespace sksg
 
 #endif // SkSGRenderEffect_DEFINED
@@ -10,6 +10,8 @@
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkTileMode.h"
 #include "include/effects/SkImageFilters.h"
@@ -249,4 +251,42 @@ void LayerEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
     this->INHERITED::onRender(canvas, nullptr);
 }
 
+sk_sp<CacheEffect> CacheEffect::Make(sk_sp<RenderNode> child) {
+    return child ? sk_sp<CacheEffect>(new CacheEffect(std::move(child)))
+                 : nullptr;
+}
+
+CacheEffect::CacheEffect(sk_sp<RenderNode> child)
+    : INHERITED(std::move(child)) {}
+
+CacheEffect::~CacheEffect() = default;
+
+void CacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    if (ctx && ctx->fShader) {
+        // Shader overrides are applied to the individual draw paints, and cannot be deferred to
+        // the picture draw.
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    if (!fPicture) {
+        SkPictureRecorder recorder;
+        this->INHERITED::onRender(recorder.beginRecording(this->bounds()), nullptr);
+        fPicture = recorder.finishRecordingAsPicture();
+    }
+
+    // Any remaining paint overrides are applied to the cached content as a whole.
+    const auto local_ctx = ScopedRenderContext(canvas, ctx).setIsolation(this->bounds(),
+                                                                         canvas->getTotalMatrix(),
+                                                                         true);
+    canvas->drawPicture(fPicture);
+}
+
+SkRect CacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    // Only invalidated descendants trigger revalidation here, and they may have changed content.
+    fPicture.reset();
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
 } // namespace sksg
@@ -9,11 +9,17 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkRect.h"
 #include "include/private/base/SkTo.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
+#include "modules/sksg/include/SkSGOpacityEffect.h"
 #include "modules/sksg/include/SkSGPaint.h"
 #include "modules/sksg/include/SkSGRect.h"
 #include "modules/sksg/include/SkSGRenderEffect.h"
@@ -355,4 +361,78 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+namespace {
+
+// Rect render node which counts its renders.
+class CountingRect final : public sksg::RenderNode {
+public:
+    CountingRect(const SkRect& rect, SkColor color) : fRect(rect), fColor(color) {}
+
+    SG_ATTRIBUTE(Color, SkColor, fColor)
+
+    int renderCount() const { return fRenderCount; }
+
+protected:
+    void onRender(SkCanvas* canvas, const RenderContext* ctx) const override {
+        fRenderCount++;
+
+        SkPaint paint;
+        paint.setColor(fColor);
+        if (ctx) {
+            ctx->modulatePaint(canvas->getTotalMatrix(), &paint);
+        }
+        canvas->drawRect(fRect, paint);
+    }
+
+    const RenderNode* onNodeAt(const SkPoint&) const override { return this; }
+
+    SkRect onRevalidate(sksg::InvalidationController*, const SkMatrix&) override { return fRect; }
+
+private:
+    const SkRect fRect;
+    SkColor      fColor;
+    mutable int  fRenderCount = 0;
+};
+
+} // namespace
+
+DEF_TEST(SGCacheEffect, reporter) {
+    auto rect = sk_make_sp<CountingRect>(SkRect::MakeWH(10, 10), SK_ColorRED);
+    auto matrix = sksg::Matrix<SkMatrix>::Make(SkMatrix::I());
+    auto opacity = sksg::OpacityEffect::Make(sksg::CacheEffect::Make(rect));
+    auto root = sksg::TransformEffect::Make(opacity, matrix);
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(20, 20);
+    SkCanvas canvas(bitmap);
+
+    auto render = [&]() {
+        root->revalidate(nullptr, SkMatrix::I());
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+        root->render(&canvas);
+    };
+
+    render();
+    render();
+    REPORTER_ASSERT(reporter, rect->renderCount() == 1);
+    REPORTER_ASSERT(reporter, bitmap.getColor(5, 5) == SK_ColorRED);
+
+    // Transform and opacity changes recomposite the cached content.
+    matrix->setMatrix(SkMatrix::Translate(10, 10));
+    opacity->setOpacity(0.5f);
+    render();
+    REPORTER_ASSERT(reporter, rect->renderCount() == 1);
+    REPORTER_ASSERT(reporter, bitmap.getColor(5, 5) == SK_ColorTRANSPARENT);
+    const auto color = bitmap.getColor(15, 15);
+    REPORTER_ASSERT(reporter, SkColorGetR(color) == 0xff && SkColorGetG(color) == 0);
+    REPORTER_ASSERT(reporter, SkColorGetA(color) >= 0x7f && SkColorGetA(color) <= 0x80);
+
+    // Content changes re-record it.
+    rect->setColor(SK_ColorBLUE);
+    opacity->setOpacity(1);
+    render();
+    REPORTER_ASSERT(reporter, rect->renderCount() == 2);
+    REPORTER_ASSERT(reporter, bitmap.getColor(15, 15) == SK_ColorBLUE);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -19,12 +19,33 @@ class SkFontMgr;
 class SkUnicode;
 
 namespace SkShapers::HB {
+/**
+ *  Keeps the glyphs of runs shaped by the shapers made with it, so that a run with the same text,
+ *  font, features, script, language and direction isn't passed to HarfBuzz again. The text
+ *  includes the few characters on either side of the run that HarfBuzz looks at. The least
+ *  recently used runs are dropped to stay under the byte budget. May be shared by shapers on
+ *  different threads.
+ */
+class SKSHAPER_API RunCache : public SkRefCnt {
+public:
+    static sk_sp<RunCache> Make(size_t byteBudget);
+
+    virtual size_t bytesUsed() const = 0;
+    virtual void purge() = 0;
+
+protected:
+    RunCache() = default;
+};
+
 SKSHAPER_API std::unique_ptr<SkShaper> ShaperDrivenWrapper(sk_sp<SkUnicode> unicode,
-                                                           sk_sp<SkFontMgr> fallback);
+                                                           sk_sp<SkFontMgr> fallback,
+                                                           sk_sp<RunCache> runCache = nullptr);
 SKSHAPER_API std::unique_ptr<SkShaper> ShapeThenWrap(sk_sp<SkUnicode> unicode,
-                                                     sk_sp<SkFontMgr> fallback);
+                                                     sk_sp<SkFontMgr> fallback,
+                                                     sk_sp<RunCache> runCache = nullptr);
 SKSHAPER_API std::unique_ptr<SkShaper> ShapeDontWrapOrReorder(sk_sp<SkUnicode> unicode,
-                                                              sk_sp<SkFontMgr> fallback);
+                                                              sk_sp<SkFontMgr> fallback,
+                                                              sk_sp<RunCache> runCache = nullptr);
 
 SKSHAPER_API std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8,
                                                                             size_t utf8Bytes);
@@ -34,6 +34,7 @@
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkTDPQueue.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkLRUCache.h"
 
 #if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
@@ -43,8 +44,10 @@
 #include <hb-ot.h>
 #include <hb.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -499,6 +502,131 @@ struct ShapedLine {
     SkVector fAdvance = { 0, 0 };
 };
 
+// HarfBuzz looks at up to 5 characters on either side of the text it shapes, each of which is at
+// most 4 bytes of UTF-8.
+constexpr size_t kMaxContextBytes = 5 * 4;
+
+// The inputs which decide how HarfBuzz shapes a run.
+class RunKey {
+public:
+    template <typename T>
+    void add(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value);
+        this->addBytes(&value, sizeof(T));
+    }
+    void addBytes(const void* bytes, size_t count) {
+        this->add(count);
+        fData.push_back_n(SkToInt(count), static_cast<const uint8_t*>(bytes));
+    }
+    void finish() { fHash = SkChecksum::Hash32(fData.data(), fData.size()); }
+
+    size_t size() const { return sizeof(RunKey) + fData.size(); }
+
+    bool operator==(const RunKey& that) const {
+        return fHash == that.fHash &&
+               fData.size() == that.fData.size() &&
+               !memcmp(fData.data(), that.fData.data(), fData.size());
+    }
+
+    struct Hash {
+        uint32_t operator()(const RunKey& key) const { return key.fHash; }
+    };
+
+private:
+    TArray<uint8_t> fData;
+    uint32_t fHash = 0;
+};
+
+class ShapedRunCache final : public SkShapers::HB::RunCache {
+public:
+    explicit ShapedRunCache(size_t byteBudget) : fShardBudget(byteBudget / kShardCount) {}
+
+    // Copies the cached glyphs for |key| into |run|, moving their clusters to |clusterOffset|.
+    bool find(const RunKey& key, uint32_t clusterOffset, ShapedRun* run) {
+        Shard& shard = this->shardFor(key);
+        SkAutoMutexExclusive lock(shard.fMutex);
+        const CachedRun* cached = shard.fRuns.find(key);
+        if (!cached) {
+            return false;
+        }
+        run->fGlyphs.reset(new ShapedGlyph[cached->fNumGlyphs]);
+        run->fNumGlyphs = cached->fNumGlyphs;
+        run->fAdvance = cached->fAdvance;
+        for (size_t i = 0; i < cached->fNumGlyphs; ++i) {
+            run->fGlyphs[i] = cached->fGlyphs[i];
+            run->fGlyphs[i].fCluster += clusterOffset;
+        }
+        return true;
+    }
+
+    void insert(const RunKey& key, const ShapedRun& run, uint32_t clusterOffset) {
+        const size_t bytes = sizeof(CachedRun) + key.size() + run.fNumGlyphs * sizeof(ShapedGlyph);
+        if (bytes > fShardBudget) {
+            return;
+        }
+        CachedRun cached{std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[run.fNumGlyphs]),
+                         run.fNumGlyphs, run.fAdvance, bytes};
+        for (size_t i = 0; i < run.fNumGlyphs; ++i) {
+            cached.fGlyphs[i] = run.fGlyphs[i];
+            cached.fGlyphs[i].fCluster -= clusterOffset;
+        }
+
+        Shard& shard = this->shardFor(key);
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (shard.fRuns.find(key)) {
+            // Another shaper added it while this one was shaping.
+            return;
+        }
+        shard.fRuns.insert(key, std::move(cached));
+        shard.fBytes += bytes;
+        while (shard.fBytes > fShardBudget) {
+            shard.fBytes -= shard.fRuns.peekLRU()->fBytes;
+            shard.fRuns.removeLRU();
+        }
+    }
+
+    size_t bytesUsed() const override {
+        size_t bytes = 0;
+        for (Shard& shard : fShards) {
+            SkAutoMutexExclusive lock(shard.fMutex);
+            bytes += shard.fBytes;
+        }
+        return bytes;
+    }
+
+    void purge() override {
+        for (Shard& shard : fShards) {
+            SkAutoMutexExclusive lock(shard.fMutex);
+            shard.fRuns.reset();
+            shard.fBytes = 0;
+        }
+    }
+
+private:
+    struct CachedRun {
+        std::unique_ptr<ShapedGlyph[]> fGlyphs;
+        size_t fNumGlyphs;
+        SkVector fAdvance;
+        size_t fBytes;
+    };
+
+    // Each shard has its own lock so that shapers on different threads rarely wait on each other.
+    struct Shard {
+        SkMutex fMutex;
+        SkLRUCache<RunKey, CachedRun, RunKey::Hash> fRuns SK_GUARDED_BY(fMutex){
+                std::numeric_limits<int>::max()};
+        size_t fBytes SK_GUARDED_BY(fMutex) = 0;
+    };
+    static constexpr int kShardCount = 8;
+
+    Shard& shardFor(const RunKey& key) const {
+        return fShards[RunKey::Hash()(key) % kShardCount];
+    }
+
+    const size_t fShardBudget;
+    mutable Shard fShards[kShardCount];
+};
+
 constexpr bool is_LTR(SkBidiIterator::Level level) {
     return (level & 1) == 0;
 }
@@ -626,7 +754,8 @@ class ShaperHarfBuzz : public SkShaper {
 public:
     ShaperHarfBuzz(sk_sp<SkUnicode>,
                    HBBuffer,
-                   sk_sp<SkFontMgr>);
+                   sk_sp<SkFontMgr>,
+                   sk_sp<ShapedRunCache>);
 
 protected:
     sk_sp<SkUnicode> fUnicode;
@@ -643,6 +772,7 @@ private:
     const sk_sp<SkFontMgr> fFontMgr; // for fallback
     HBBuffer               fBuffer;
     hb_language_t          fUndefinedLanguage;
+    const sk_sp<ShapedRunCache> fRunCache;
 
 #if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
     void shape(const char* utf8, size_t utf8Bytes,
@@ -727,11 +857,13 @@ private:
 
 ShaperHarfBuzz::ShaperHarfBuzz(sk_sp<SkUnicode> unicode,
                                HBBuffer buffer,
-                               sk_sp<SkFontMgr> fallback)
+                               sk_sp<SkFontMgr> fallback,
+                               sk_sp<ShapedRunCache> runCache)
     : fUnicode(unicode)
     , fFontMgr(fallback ? std::move(fallback) : SkFontMgr::RefEmpty())
     , fBuffer(std::move(buffer))
-    , fUndefinedLanguage(hb_language_from_string("und", -1)) {
+    , fUndefinedLanguage(hb_language_from_string("und", -1))
+    , fRunCache(std::move(runCache)) {
 #if defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
     SkASSERT(fUnicode);
 #endif
@@ -1289,6 +1421,78 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
                   font.currentFont(), bidi.currentLevel(), nullptr, 0);
 
+    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
+    hb_script_t hbScript = hb_script_from_iso15924_tag((hb_tag_t)script.currentScript());
+    // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
+    // The user must provide a language, but may provide data hb_language_from_string cannot use.
+    // Use "und" for the undefined language in this case (RFC5646 4.1 5).
+    hb_language_t hbLanguage = hb_language_from_string(language.currentLanguage(), -1);
+    if (hbLanguage == HB_LANGUAGE_INVALID) {
+        hbLanguage = fUndefinedLanguage;
+    }
+
+    STArray<32, hb_feature_t> hbFeatures;
+    for (const auto& feature : SkSpan(features, featuresSize)) {
+        if (feature.end < SkTo<size_t>(utf8Start - utf8) ||
+                          SkTo<size_t>(utf8End   - utf8)  <= feature.start)
+        {
+            continue;
+        }
+        if (feature.start <= SkTo<size_t>(utf8Start - utf8) &&
+                             SkTo<size_t>(utf8End   - utf8) <= feature.end)
+        {
+            hbFeatures.push_back({ (hb_tag_t)feature.tag, feature.value,
+                                   HB_FEATURE_GLOBAL_START, HB_FEATURE_GLOBAL_END});
+        } else {
+            hbFeatures.push_back({ (hb_tag_t)feature.tag, feature.value,
+                                   SkTo<unsigned>(feature.start), SkTo<unsigned>(feature.end)});
+        }
+    }
+
+    // Clusters are offsets into utf8, so the cache keeps them relative to the start of the run.
+    const uint32_t clusterOffset = SkTo<uint32_t>(utf8Start - utf8);
+    RunKey runKey;
+    if (fRunCache) {
+        const SkFont& skFont = font.currentFont();
+        runKey.add(skFont.getTypeface()->uniqueID());
+        runKey.add(skFont.getSize());
+        runKey.add(skFont.getScaleX());
+        runKey.add(skFont.getSkewX());
+        runKey.add(skFont.getEdging());
+        runKey.add(skFont.getHinting());
+        runKey.add((skFont.isForceAutoHinting() << 0) | (skFont.isEmbeddedBitmaps() << 1) |
+                   (skFont.isSubpixel()         << 2) | (skFont.isLinearMetrics()   << 3) |
+                   (skFont.isEmbolden()         << 4) | (skFont.isBaselineSnap()    << 5));
+        runKey.add(direction);
+        runKey.add(hbScript);
+        runKey.add(hbLanguage);
+        for (const hb_feature_t& feature : hbFeatures) {
+            runKey.add(feature.tag);
+            runKey.add(feature.value);
+            if (feature.start == HB_FEATURE_GLOBAL_START && feature.end == HB_FEATURE_GLOBAL_END) {
+                runKey.add(feature.start);
+                runKey.add(feature.end);
+            } else {
+                const unsigned runEnd = clusterOffset + utf8runLength;
+                unsigned start = std::clamp<unsigned>(feature.start, clusterOffset, runEnd);
+                unsigned end = std::clamp<unsigned>(feature.end, clusterOffset, runEnd);
+                runKey.add(start - clusterOffset);
+                runKey.add(end - clusterOffset);
+            }
+        }
+        const char* preContext = utf8Start - std::min<size_t>(utf8Start - utf8, kMaxContextBytes);
+        const size_t postContextBytes = std::min<size_t>(utf8 + utf8Bytes - utf8End,
+                                                         kMaxContextBytes);
+        runKey.addBytes(preContext, utf8Start - preContext);
+        runKey.addBytes(utf8Start, utf8runLength);
+        runKey.addBytes(utf8End, postContextBytes);
+        runKey.finish();
+
+        if (fRunCache->find(runKey, clusterOffset, &run)) {
+            return run;
+        }
+    }
+
     hb_buffer_t* buffer = fBuffer.get();
     SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
     hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
@@ -1313,16 +1517,8 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     // Add postcontext.
     hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
 
-    hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
     hb_buffer_set_direction(buffer, direction);
-    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
-    // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
-    // The user must provide a language, but may provide data hb_language_from_string cannot use.
-    // Use "und" for the undefined language in this case (RFC5646 4.1 5).
-    hb_language_t hbLanguage = hb_language_from_string(language.currentLanguage(), -1);
-    if (hbLanguage == HB_LANGUAGE_INVALID) {
-        hbLanguage = fUndefinedLanguage;
-    }
+    hb_buffer_set_script(buffer, hbScript);
     hb_buffer_set_language(buffer, hbLanguage);
     hb_buffer_guess_segment_properties(buffer);
 
@@ -1346,24 +1542,6 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         return run;
     }
 
-    STArray<32, hb_feature_t> hbFeatures;
-    for (const auto& feature : SkSpan(features, featuresSize)) {
-        if (feature.end < SkTo<size_t>(utf8Start - utf8) ||
-                          SkTo<size_t>(utf8End   - utf8)  <= feature.start)
-        {
-            continue;
-        }
-        if (feature.start <= SkTo<size_t>(utf8Start - utf8) &&
-                             SkTo<size_t>(utf8End   - utf8) <= feature.end)
-        {
-            hbFeatures.push_back({ (hb_tag_t)feature.tag, feature.value,
-                                   HB_FEATURE_GLOBAL_START, HB_FEATURE_GLOBAL_END});
-        } else {
-            hbFeatures.push_back({ (hb_tag_t)feature.tag, feature.value,
-                                   SkTo<unsigned>(feature.start), SkTo<unsigned>(feature.end)});
-        }
-    }
-
     hb_shape(hbFont.get(), buffer, hbFeatures.data(), hbFeatures.size());
     unsigned len = hb_buffer_get_length(buffer);
     if (len == 0) {
@@ -1415,6 +1593,9 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
     run.fAdvance = runAdvance;
 
+    if (fRunCache) {
+        fRunCache->insert(runKey, run, clusterOffset);
+    }
     return run;
 }
 }  // namespace
@@ -1480,7 +1661,8 @@ void SkShaper::PurgeHarfBuzzCache() { SkShapers::HB::PurgeCaches(); }
 
 namespace SkShapers::HB {
 std::unique_ptr<SkShaper> ShaperDrivenWrapper(sk_sp<SkUnicode> unicode,
-                                              sk_sp<SkFontMgr> fallback) {
+                                              sk_sp<SkFontMgr> fallback,
+                                              sk_sp<RunCache> runCache) {
     if (!unicode) {
         return nullptr;
     }
@@ -1490,11 +1672,13 @@ std::unique_ptr<SkShaper> ShaperDrivenWrapper(sk_sp<SkUnicode> unicode,
         return nullptr;
     }
     return std::make_unique<::ShaperDrivenWrapper>(
-            unicode, std::move(buffer), std::move(fallback));
+            unicode, std::move(buffer), std::move(fallback),
+            sk_ref_sp(static_cast<ShapedRunCache*>(runCache.get())));
 }
 
 std::unique_ptr<SkShaper> ShapeThenWrap(sk_sp<SkUnicode> unicode,
-                                        sk_sp<SkFontMgr> fallback) {
+                                        sk_sp<SkFontMgr> fallback,
+                                        sk_sp<RunCache> runCache) {
     if (!unicode) {
         return nullptr;
     }
@@ -1504,11 +1688,13 @@ std::unique_ptr<SkShaper> ShapeThenWrap(sk_sp<SkUnicode> unicode,
         return nullptr;
     }
     return std::make_unique<::ShapeThenWrap>(
-            unicode, std::move(buffer), std::move(fallback));
+            unicode, std::move(buffer), std::move(fallback),
+            sk_ref_sp(static_cast<ShapedRunCache*>(runCache.get())));
 }
 
 std::unique_ptr<SkShaper> ShapeDontWrapOrReorder(sk_sp<SkUnicode> unicode,
-                                                 sk_sp<SkFontMgr> fallback) {
+                                                 sk_sp<SkFontMgr> fallback,
+                                                 sk_sp<RunCache> runCache) {
     if (!unicode) {
         return nullptr;
     }
@@ -1518,7 +1704,8 @@ std::unique_ptr<SkShaper> ShapeDontWrapOrReorder(sk_sp<SkUnicode> unicode,
         return nullptr;
     }
     return std::make_unique<::ShapeDontWrapOrReorder>(
-            unicode, std::move(buffer), std::move(fallback));
+            unicode, std::move(buffer), std::move(fallback),
+            sk_ref_sp(static_cast<ShapedRunCache*>(runCache.get())));
 }
 
 std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8, size_t utf8Bytes) {
@@ -1531,6 +1718,10 @@ std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8,
             utf8, utf8Bytes, hb_script_from_iso15924_tag((hb_tag_t)script));
 }
 
+sk_sp<RunCache> RunCache::Make(size_t byteBudget) {
+    return sk_make_sp<ShapedRunCache>(byteBudget);
+}
+
 void PurgeCaches() {
     HBLockedFaceCache cache = get_hbFace_cache();
     cache.reset();
@@ -22,7 +22,10 @@
 
 #include <cinttypes>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <vector>
 
 #if defined(SK_UNICODE_ICU_IMPLEMENTATION)
 #include "modules/skunicode/include/SkUnicode_icu.h"
@@ -226,12 +229,82 @@ void cluster_test(skiatest::Reporter* reporter, const char* resource) {
     shaper_test(reporter, resource, data.get());
 }
 
+struct GlyphCollector final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+    std::unique_ptr<SkGlyphID[]> fRunGlyphs;
+    std::unique_ptr<SkPoint[]> fRunPositions;
+    std::unique_ptr<uint32_t[]> fRunClusters;
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        fRunGlyphs = std::make_unique<SkGlyphID[]>(info.glyphCount);
+        fRunPositions = std::make_unique<SkPoint[]>(info.glyphCount);
+        fRunClusters = std::make_unique<uint32_t[]>(info.glyphCount);
+        return {fRunGlyphs.get(), fRunPositions.get(), nullptr, fRunClusters.get(), {0, 0}};
+    }
+    void commitRunBuffer(const RunInfo& info) override {
+        fGlyphs.insert(fGlyphs.end(), fRunGlyphs.get(), fRunGlyphs.get() + info.glyphCount);
+        fPositions.insert(fPositions.end(),
+                          fRunPositions.get(), fRunPositions.get() + info.glyphCount);
+        fClusters.insert(fClusters.end(), fRunClusters.get(), fRunClusters.get() + info.glyphCount);
+    }
+    void commitLine() override {}
+};
+
+void shape_run_cache(SkShaper* shaper, const char* utf8, GlyphCollector* collector) {
+    constexpr SkFourByteTag latn = SkSetFourByteTag('l','a','t','n');
+    const size_t utf8Bytes = strlen(utf8);
+    SkShaper::TrivialFontRunIterator fontIterator(ToolUtils::DefaultFont(), utf8Bytes);
+    SkShaper::TrivialBiDiRunIterator bidiIterator(0, utf8Bytes);
+    SkShaper::TrivialScriptRunIterator scriptIterator(latn, utf8Bytes);
+    SkShaper::TrivialLanguageRunIterator languageIterator("en-US", utf8Bytes);
+    shaper->shape(utf8, utf8Bytes, fontIterator, bidiIterator, scriptIterator, languageIterator,
+                  nullptr, 0, std::numeric_limits<SkScalar>::max(), collector);
+}
+
 #endif  // defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
 
 }  // namespace
 
 #if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
 
+DEF_TEST(Shaper_RunCache, r) {
+    auto unicode = get_unicode();
+    if (!unicode) {
+        ERRORF(r, "Could not create unicode.");
+        return;
+    }
+    sk_sp<SkShapers::HB::RunCache> runCache = SkShapers::HB::RunCache::Make(1 << 20);
+    auto uncached = SkShapers::HB::ShapeDontWrapOrReorder(unicode, SkFontMgr::RefEmpty());
+    auto cached = SkShapers::HB::ShapeDontWrapOrReorder(unicode, SkFontMgr::RefEmpty(), runCache);
+    if (!uncached || !cached) {
+        ERRORF(r, "Could not create shapers.");
+        return;
+    }
+
+    // The second run of the same text is found in the cache.
+    GlyphCollector expected, first, second;
+    shape_run_cache(uncached.get(), "office waffle", &expected);
+    shape_run_cache(cached.get(), "office waffle", &first);
+    const size_t bytesUsed = runCache->bytesUsed();
+    REPORTER_ASSERT(r, bytesUsed > 0);
+    shape_run_cache(cached.get(), "office waffle", &second);
+    REPORTER_ASSERT(r, runCache->bytesUsed() == bytesUsed);
+
+    for (const GlyphCollector* actual : {&first, &second}) {
+        REPORTER_ASSERT(r, actual->fGlyphs == expected.fGlyphs);
+        REPORTER_ASSERT(r, actual->fPositions == expected.fPositions);
+        REPORTER_ASSERT(r, actual->fClusters == expected.fClusters);
+    }
+
+    runCache->purge();
+    REPORTER_ASSERT(r, runCache->bytesUsed() == 0);
+}
+
 DEF_TEST(Shaper_cluster_empty, r) { shaper_test(r, "empty", SkData::MakeEmpty().get()); }
 
 #define SHAPER_TEST(X) DEF_TEST(Shaper_cluster_ ## X, r) { cluster_test(r, "text/" #X ".txt"); }
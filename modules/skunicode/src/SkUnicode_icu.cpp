@@ -22,6 +22,7 @@
 #include "src/base/SkBitmaskEnum.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkChecksum.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkTHash.h"
 
 #include <unicode/ubrk.h>
@@ -333,15 +334,113 @@ class SkIcuBreakIteratorCache final {
 };
 /*static*/ int32_t SkIcuBreakIteratorCache::BreakIteratorRef::Instances{0};
 
+/* Borrows a break iterator from the ones this thread has used before, so that analyzing text
+ * doesn't take the cache's lock, look up the locale and clone an iterator every time.
+ * The iterator goes back to the thread's pool when this is destroyed.
+ */
+class SkIcuPooledBreakIterator final {
+    struct Entry {
+        SkUnicode::BreakType fType;
+        SkString fLocale;
+        ICUBreakIterator fIterator;
+    };
+    // A paragraph uses the line, grapheme and word iterators for one locale.
+    static constexpr size_t kMaxPooled = 8;
+
+    static std::vector<Entry>& ThreadPool() {
+        static thread_local std::vector<Entry> pool;
+        return pool;
+    }
+
+public:
+    SkIcuPooledBreakIterator(SkUnicode::BreakType type, const char* bcp47)
+            : fType(type)
+            , fLocale(bcp47 ? bcp47 : "") {
+        std::vector<Entry>& pool = ThreadPool();
+        for (auto entry = pool.begin(); entry != pool.end(); ++entry) {
+            if (entry->fType == fType && entry->fLocale == fLocale) {
+                fIterator = std::move(entry->fIterator);
+                pool.erase(entry);
+                return;
+            }
+        }
+        fIterator = SkIcuBreakIteratorCache::get().makeBreakIterator(type, bcp47);
+    }
+
+    ~SkIcuPooledBreakIterator() {
+        if (!fIterator) {
+            return;
+        }
+        std::vector<Entry>& pool = ThreadPool();
+        if (pool.size() >= kMaxPooled) {
+            pool.erase(pool.begin());
+        }
+        pool.push_back({fType, std::move(fLocale), std::move(fIterator)});
+    }
+
+    UBreakIterator* get() const { return fIterator.get(); }
+    explicit operator bool() const { return fIterator != nullptr; }
+
+private:
+    const SkUnicode::BreakType fType;
+    SkString fLocale;
+    ICUBreakIterator fIterator;
+};
+
+static bool is_ascii(const char utf8[], int utf8Units) {
+    for (int i = 0; i < utf8Units; ++i) {
+        if (static_cast<unsigned char>(utf8[i]) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// What u_isspace(), u_isWhitespace() and u_iscntrl() return for ASCII.
+static SkUnicode::CodeUnitFlags ascii_code_unit_flags(char c) {
+    SkUnicode::CodeUnitFlags flags = SkUnicode::kNoCodeUnitFlag;
+    if ((c >= 0x09 && c <= 0x0D) || (c >= 0x1C && c <= 0x20)) {
+        flags |= SkUnicode::kPartOfIntraWordBreak | SkUnicode::kPartOfWhiteSpaceBreak;
+    }
+    if (c < 0x20 || c == 0x7F) {
+        flags |= SkUnicode::kControl;
+    }
+    return flags;
+}
+
 class SkUnicode_icu : public SkUnicode {
+    using CodeUnitFlagsArray = TArray<SkUnicode::CodeUnitFlags, true>;
+
+    struct CodeUnitFlagsKey {
+        CodeUnitFlagsKey(const char utf8[], int utf8Units, bool replaceTabs)
+                : fText(utf8, utf8Units)
+                , fReplaceTabs(replaceTabs)
+                , fHash(SkChecksum::Hash32(utf8, utf8Units, replaceTabs)) {}
+
+        bool operator==(const CodeUnitFlagsKey& that) const {
+            return fHash == that.fHash && fReplaceTabs == that.fReplaceTabs &&
+                   fText == that.fText;
+        }
+
+        struct Hash {
+            uint32_t operator()(const CodeUnitFlagsKey& key) const { return key.fHash; }
+        };
+
+        SkString fText;
+        bool fReplaceTabs;
+        uint32_t fHash;
+    };
+
+    static constexpr int kMaxCachedFlagsText = 4096;
+    static constexpr int kMaxCachedFlags = 64;
+
 
     static bool extractWords(uint16_t utf16[], int utf16Units, const char* locale,
                              std::vector<Position>* words) {
 
         UErrorCode status = U_ZERO_ERROR;
 
-        const BreakType type = BreakType::kWords;
-        ICUBreakIterator iterator = SkIcuBreakIteratorCache::get().makeBreakIterator(type, locale);
+        SkIcuPooledBreakIterator iterator(BreakType::kWords, locale);
         if (!iterator) {
             SkDEBUGF("Break error: %s", sk_u_errorName(status));
             return false;
@@ -382,7 +481,7 @@ class SkUnicode_icu : public SkUnicode {
         }
         SkASSERT(text);
 
-        ICUBreakIterator iterator = SkIcuBreakIteratorCache::get().makeBreakIterator(type, locale);
+        SkIcuPooledBreakIterator iterator(type, locale);
         if (!iterator) {
             return false;
         }
@@ -420,6 +519,74 @@ class SkUnicode_icu : public SkUnicode {
         return true;
     }
 
+    bool analyzeCodeUnits(char utf8[], int utf8Units, bool replaceTabs,
+                          TArray<SkUnicode::CodeUnitFlags, true>* results) {
+        results->clear();
+        results->push_back_n(utf8Units + 1, CodeUnitFlags::kNoCodeUnitFlag);
+
+        SkUnicode_icu::extractPositions(utf8, utf8Units, BreakType::kLines, nullptr, // TODO: locale
+                                        [&](int pos, int status) {
+            (*results)[pos] |= status == UBRK_LINE_HARD
+                                       ? CodeUnitFlags::kHardLineBreakBefore
+                                       : CodeUnitFlags::kSoftLineBreakBefore;
+        });
+
+        if (is_ascii(utf8, utf8Units)) {
+            // Every ASCII character is a grapheme, except that CR LF is one. The properties
+            // match ICU's for ASCII; none of it is ideographic.
+            for (int i = 0; i <= utf8Units; ++i) {
+                if (i == 0 || i == utf8Units || utf8[i - 1] != '\r' || utf8[i] != '\n') {
+                    (*results)[i] |= CodeUnitFlags::kGraphemeStart;
+                }
+            }
+            for (int i = 0; i < utf8Units; ++i) {
+                if (replaceTabs && utf8[i] == '\t') {
+                    utf8[i] = ' ';
+                    (*results)[i] |= SkUnicode::kTabulation;
+                }
+                (*results)[i] |= ascii_code_unit_flags(utf8[i]);
+            }
+            return true;
+        }
+
+        SkUnicode_icu::extractPositions(utf8, utf8Units, BreakType::kGraphemes, nullptr, //TODO
+                                        [&](int pos, int status) {
+            (*results)[pos] |= CodeUnitFlags::kGraphemeStart;
+        });
+
+        const char* current = utf8;
+        const char* end = utf8 + utf8Units;
+        while (current < end) {
+            auto before = current - utf8;
+            SkUnichar unichar = SkUTF::NextUTF8(&current, end);
+            if (unichar < 0) unichar = 0xFFFD;
+            auto after = current - utf8;
+            if (replaceTabs && this->isTabulation(unichar)) {
+                results->at(before) |= SkUnicode::kTabulation;
+                if (replaceTabs) {
+                    unichar = ' ';
+                    utf8[before] = ' ';
+                }
+            }
+            for (auto i = before; i < after; ++i) {
+                if (this->isSpace(unichar)) {
+                    results->at(i) |= SkUnicode::kPartOfIntraWordBreak;
+                }
+                if (this->isWhitespace(unichar)) {
+                    results->at(i) |= SkUnicode::kPartOfWhiteSpaceBreak;
+                }
+                if (this->isControl(unichar)) {
+                    results->at(i) |= SkUnicode::kControl;
+                }
+                if (this->isIdeographic(unichar)) {
+                    results->at(i) |= SkUnicode::kIdeographic;
+                }
+            }
+        }
+
+        return true;
+    }
+
     bool isControl(SkUnichar utf8) override {
         return sk_u_iscntrl(utf8);
     }
@@ -465,6 +632,10 @@ class SkUnicode_icu : public SkUnicode {
     }
 
     static bool isHardLineBreak(SkUnichar utf8) {
+        if (utf8 < 0x80) {
+            // Line feed, line tabulation and form feed
+            return utf8 >= 0x0A && utf8 <= 0x0C;
+        }
         auto property = sk_u_getIntPropertyValue(utf8, UCHAR_LINE_BREAK);
         return property == U_LB_LINE_FEED || property == U_LB_MANDATORY_BREAK;
     }
@@ -570,51 +741,30 @@ public:
 
     bool computeCodeUnitFlags(char utf8[], int utf8Units, bool replaceTabs,
                               TArray<SkUnicode::CodeUnitFlags, true>* results) override {
-        results->clear();
-        results->push_back_n(utf8Units + 1, CodeUnitFlags::kNoCodeUnitFlag);
-
-        SkUnicode_icu::extractPositions(utf8, utf8Units, BreakType::kLines, nullptr, // TODO: locale
-                                        [&](int pos, int status) {
-            (*results)[pos] |= status == UBRK_LINE_HARD
-                                       ? CodeUnitFlags::kHardLineBreakBefore
-                                       : CodeUnitFlags::kSoftLineBreakBefore;
-        });
-
-        SkUnicode_icu::extractPositions(utf8, utf8Units, BreakType::kGraphemes, nullptr, //TODO
-                                        [&](int pos, int status) {
-            (*results)[pos] |= CodeUnitFlags::kGraphemeStart;
-        });
-
-        const char* current = utf8;
-        const char* end = utf8 + utf8Units;
-        while (current < end) {
-            auto before = current - utf8;
-            SkUnichar unichar = SkUTF::NextUTF8(&current, end);
-            if (unichar < 0) unichar = 0xFFFD;
-            auto after = current - utf8;
-            if (replaceTabs && this->isTabulation(unichar)) {
-                results->at(before) |= SkUnicode::kTabulation;
+        // The same text is often analyzed again, e.g. when a paragraph is rebuilt every frame.
+        if (utf8Units > kMaxCachedFlagsText) {
+            return this->analyzeCodeUnits(utf8, utf8Units, replaceTabs, results);
+        }
+        const CodeUnitFlagsKey key(utf8, utf8Units, replaceTabs);
+        {
+            SkAutoMutexExclusive lock(fFlagsCacheMutex);
+            if (const CodeUnitFlagsArray* cached = fFlagsCache.find(key)) {
+                *results = *cached;
                 if (replaceTabs) {
-                    unichar = ' ';
-                    utf8[before] = ' ';
-                }
-            }
-            for (auto i = before; i < after; ++i) {
-                if (this->isSpace(unichar)) {
-                    results->at(i) |= SkUnicode::kPartOfIntraWordBreak;
-                }
-                if (this->isWhitespace(unichar)) {
-                    results->at(i) |= SkUnicode::kPartOfWhiteSpaceBreak;
-                }
-                if (this->isControl(unichar)) {
-                    results->at(i) |= SkUnicode::kControl;
-                }
-                if (this->isIdeographic(unichar)) {
-                    results->at(i) |= SkUnicode::kIdeographic;
+                    for (int i = 0; i < utf8Units; ++i) {
+                        if ((*results)[i] & SkUnicode::kTabulation) {
+                            utf8[i] = ' ';
+                        }
+                    }
                 }
+                return true;
             }
         }
-
+        if (!this->analyzeCodeUnits(utf8, utf8Units, replaceTabs, results)) {
+            return false;
+        }
+        SkAutoMutexExclusive lock(fFlagsCacheMutex);
+        fFlagsCache.insert(key, *results);
         return true;
     }
 
@@ -679,6 +829,10 @@ public:
 
 private:
     sk_sp<SkBidiFactory> fBidiFact = sk_make_sp<SkBidiICUFactory>();
+
+    SkMutex fFlagsCacheMutex;
+    SkLRUCache<CodeUnitFlagsKey, CodeUnitFlagsArray, CodeUnitFlagsKey::Hash>
+            fFlagsCache SK_GUARDED_BY(fFlagsCacheMutex){kMaxCachedFlags};
 };
 
 namespace SkUnicodes::ICU {
@@ -283,6 +283,42 @@ DEF_TEST_ICU_UNICODES(SkUnicode_ComputeCodeUnitFlags, reporter) {
     }
 }
 
+#if defined(SK_UNICODE_ICU_IMPLEMENTATION)
+UNIX_ONLY_TEST(SkUnicode_Compiled_ComputeCodeUnitFlagsAscii, reporter) {
+    auto icu = SkUnicodes::ICU::Make();
+    if (!icu) {
+        REPORTER_ASSERT(reporter, icu);
+        return;
+    }
+    // ASCII text skips ICU for graphemes and character properties; appending a non-ASCII
+    // character makes ICU analyze the same characters.
+    const SkString ascii("Tab\tCR LF\r\nform\ffeed\x1f\x7f\v(1.5) e-mail end");
+    const SkString mixed = SkStringPrintf("%s\u00e9", ascii.c_str());
+    auto flags = [&](SkString text, bool replaceTabs, SkString* replaced) {
+        TArray<SkUnicode::CodeUnitFlags, true> results;
+        REPORTER_ASSERT(reporter,
+                        icu->computeCodeUnitFlags(text.data(), text.size(), replaceTabs, &results));
+        *replaced = text;
+        return results;
+    };
+    for (bool replaceTabs : {false, true}) {
+        SkString asciiReplaced, mixedReplaced, cachedReplaced;
+        auto asciiFlags = flags(ascii, replaceTabs, &asciiReplaced);
+        auto mixedFlags = flags(mixed, replaceTabs, &mixedReplaced);
+        REPORTER_ASSERT(reporter, asciiFlags.size() == SkToInt(ascii.size() + 1));
+        for (size_t i = 0; i < ascii.size(); ++i) {
+            REPORTER_ASSERT(reporter, asciiFlags[i] == mixedFlags[i], "%zu", i);
+        }
+        REPORTER_ASSERT(reporter, asciiReplaced.equals(mixedReplaced.c_str(), ascii.size()));
+
+        // The second analysis of the same text comes from the cache.
+        auto cachedFlags = flags(ascii, replaceTabs, &cachedReplaced);
+        REPORTER_ASSERT(reporter, cachedFlags == asciiFlags);
+        REPORTER_ASSERT(reporter, cachedReplaced == asciiReplaced);
+    }
+}
+#endif
+
 DEF_TEST_UNICODES(SkUnicode_ReorderVisual, reporter) {
     if (!unicode) {
         return;
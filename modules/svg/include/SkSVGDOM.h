@@ -16,10 +16,14 @@
 #include "modules/skshaper/include/SkShaper_factory.h"
 #include "modules/svg/include/SkSVGIDMapper.h"
 
+#include <memory>
+
 class SkCanvas;
 class SkDOM;
 class SkStream;
 class SkSVGNode;
+class SkSVGRenderCache;
+class SkSVGRenderContext;
 struct SkSVGPresentationContext;
 class SkSVGSVG;
 
@@ -46,14 +50,26 @@ public:
          */
         Builder& setTextShapingFactory(sk_sp<SkShapers::Factory>);
 
+        /**
+         * Cache the rendering of each child of the root element as a picture, which render()
+         * then replays instead of walking the subtree again.
+         *
+         * Clients that modify the DOM after it is built must then call invalidate() (or use
+         * setAttribute()) for their changes to be rendered.
+         */
+        Builder& setRenderCaching(bool);
+
         sk_sp<SkSVGDOM> make(SkStream&) const;
 
     private:
         sk_sp<SkFontMgr>                             fFontMgr;
         sk_sp<skresources::ResourceProvider>         fResourceProvider;
         sk_sp<SkShapers::Factory>                    fTextShapingFactory;
+        bool                                         fRenderCaching = false;
     };
 
+    ~SkSVGDOM() override;
+
     static sk_sp<SkSVGDOM> MakeFromStream(SkStream& str) {
         return Builder().make(str);
     }
@@ -93,6 +109,22 @@ public:
 
     void render(SkCanvas*) const;
 
+    /**
+     * With render caching (see Builder::setRenderCaching), drops the cached rendering of the
+     * subtree that node belongs to, so that changes to it show up in the next render().
+     *
+     * Elements referenced from other elements (e.g. gradients, clip paths or <use> targets) and
+     * their descendants, the root, and nodes added after the DOM was built can affect any
+     * subtree: for those, and when node is null, all cached renderings are dropped.
+     */
+    void invalidate(const SkSVGNode* node = nullptr);
+
+    /**
+     * Sets an attribute of the node with the given id, and invalidates its cached rendering.
+     * Returns false if there is no such node, or if the attribute could not be set.
+     */
+    bool setAttribute(const char* id, const char* name, const char* value);
+
     /** Render the node with the given id as if it were the only child of the root. */
     void renderNode(SkCanvas*, SkSVGPresentationContext&, const char* id) const;
 
@@ -101,7 +133,10 @@ private:
              sk_sp<SkFontMgr>,
              sk_sp<skresources::ResourceProvider>,
              SkSVGIDMapper&&,
-             sk_sp<SkShapers::Factory>);
+             sk_sp<SkShapers::Factory>,
+             std::unique_ptr<SkSVGRenderCache>);
+
+    void renderCached(const SkSVGRenderContext&, const SkSVGNode&) const;
 
     const sk_sp<SkSVGSVG>                       fRoot;
     const sk_sp<SkFontMgr>                      fFontMgr;
@@ -109,6 +144,7 @@ private:
     const sk_sp<skresources::ResourceProvider>  fResourceProvider;
     const SkSVGIDMapper                         fIDMapper;
     SkSize                                      fContainerSize;
+    const std::unique_ptr<SkSVGRenderCache>     fRenderCache; // Only with render caching.
 };
 
 #endif // SkSVGDOM_DEFINED
@@ -12,6 +12,8 @@
 #include "modules/svg/include/SkSVGTypes.h"
 #include "src/base/SkTLazy.h"
 
+#include <functional>
+
 class SkSVGLengthContext;
 
 class SK_API SkSVGSVG : public SkSVGContainer {
@@ -34,6 +36,11 @@ public:
 
     void renderNode(const SkSVGRenderContext&, const SkSVGIRI& iri) const;
 
+    // Renders the children with renderChild, in the context of this element.
+    void renderChildren(const SkSVGRenderContext&,
+                        const std::function<void(const SkSVGRenderContext&,
+                                                 const SkSVGNode&)>& renderChild) const;
+
 protected:
     bool onPrepareToRender(SkSVGRenderContext*) const override;
 
@@ -9,6 +9,8 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkTo.h"
 #include "modules/skshaper/include/SkShaper_factory.h"
@@ -51,8 +53,34 @@
 #include "modules/svg/include/SkSVGUse.h"
 #include "modules/svg/include/SkSVGValue.h"
 #include "src/base/SkTSearch.h"
+#include "src/core/SkRectPriv.h"
+#include "src/core/SkTHash.h"
 #include "src/core/SkTraceEvent.h"
-#include "src/xml/SkDOM.h"
+#include "src/xml/SkXMLParser.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Bookkeeping for SkSVGDOM::Builder::setRenderCaching().
+class SkSVGRenderCache {
+public:
+    struct NodeInfo {
+        const SkSVGNode* fSubtree;  // The child of the root that the node descends from.
+        const SkSVGNode* fScope;    // The closest element with an id, from the node up.
+    };
+
+    // All the nodes below the root, as parsed.
+    skia_private::THashMap<const SkSVGNode*, NodeInfo>         fNodes;
+    // The scope enclosing each element with an id, if any.
+    skia_private::THashMap<const SkSVGNode*, const SkSVGNode*> fOuterScopes;
+    // The ids referenced by any attribute, and the elements they resolve to.
+    skia_private::THashSet<SkString>                           fReferencedIds;
+    skia_private::THashSet<const SkSVGNode*>                   fReferenced;
+
+    // The rendering of each child of the root, recorded on demand.
+    skia_private::THashMap<const SkSVGNode*, sk_sp<SkPicture>> fPictures;
+};
 
 namespace {
 
@@ -287,14 +315,60 @@ SortedDictionaryEntry<sk_sp<SkSVGNode>(*)()> gTagFactories[] = {
 };
 
 struct ConstructionContext {
-    ConstructionContext(SkSVGIDMapper* mapper) : fParent(nullptr), fIDMapper(mapper) {}
-    ConstructionContext(const ConstructionContext& other, const sk_sp<SkSVGNode>& newParent)
-        : fParent(newParent.get()), fIDMapper(other.fIDMapper) {}
-
-    SkSVGNode*     fParent;
-    SkSVGIDMapper* fIDMapper;
+    ConstructionContext(SkSVGIDMapper* mapper, SkSVGRenderCache* cache)
+        : fParent(nullptr), fIDMapper(mapper), fRenderCache(cache) {}
+    ConstructionContext(const ConstructionContext& other, const sk_sp<SkSVGNode>& newParent,
+                        const SkSVGNode* scope)
+        : fParent(newParent.get())
+        , fIDMapper(other.fIDMapper)
+        , fRenderCache(other.fRenderCache)
+        , fSubtree(other.fSubtree ? other.fSubtree
+                                  : other.fParent ? newParent.get() : nullptr)
+        , fScope(scope) {}
+
+    SkSVGNode*        fParent;
+    SkSVGIDMapper*    fIDMapper;
+
+    // Render caching only.
+    SkSVGRenderCache* fRenderCache;
+    const SkSVGNode*  fSubtree = nullptr; // The child of the root that fParent descends from.
+    const SkSVGNode*  fScope   = nullptr; // The closest element with an id, from fParent up.
+
+    // Returns the scope of node's children.
+    const SkSVGNode* recordNode(const SkSVGNode* node, bool has_id) const {
+        const SkSVGNode* scope = has_id ? node : fScope;
+        if (fRenderCache && fSubtree) {
+            fRenderCache->fNodes.set(node, {fSubtree, scope});
+            if (has_id) {
+                fRenderCache->fOuterScopes.set(node, fScope);
+            }
+        }
+        return scope;
+    }
 };
 
+// Collects the ids referenced by an attribute: "#id" links and "url(#id)" functional IRIs.
+void collect_references(const char* name, const char* value,
+                        skia_private::THashSet<SkString>* ids) {
+    if ((!strcmp(name, "href") || !strcmp(name, "xlink:href")) && value[0] == '#') {
+        ids->add(SkString(value + 1));
+    }
+
+    for (const char* p = strstr(value, "url("); p; p = strstr(p, "url(")) {
+        p += 4;
+        while (*p == ' ' || *p == '\'' || *p == '"') {
+            ++p;
+        }
+        if (*p == '#') {
+            const char* id = ++p;
+            while (*p && *p != ')' && *p != ' ' && *p != '\'' && *p != '"') {
+                ++p;
+            }
+            ids->add(SkString(id, p - id));
+        }
+    }
+}
+
 bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value) {
     if (node->parseAndSetAttribute(name, value)) {
         // Handled by new code path
@@ -323,76 +397,141 @@ bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     return true;
 }
 
-void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
-                           const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
-    const char* name, *value;
-    SkDOM::AttrIter attrIter(xmlDom, xmlNode);
-    while ((name = attrIter.next(&value))) {
-        // We're handling id attributes out of band for now.
-        if (!strcmp(name, "id")) {
-            mapper->set(SkString(value), svgNode);
-            continue;
-        }
-        set_string_attribute(svgNode, name, value);
+sk_sp<SkSVGNode> make_node(const ConstructionContext& ctx, const char* elem) {
+    if (strcmp(elem, "svg") == 0) {
+        // Outermost SVG element must be tagged as such.
+        return SkSVGSVG::Make(ctx.fParent ? SkSVGSVG::Type::kInner
+                                          : SkSVGSVG::Type::kRoot);
     }
+
+    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
+                                     SkTo<int>(std::size(gTagFactories)),
+                                     elem, sizeof(gTagFactories[0]));
+    if (tagIndex < 0) {
+#if defined(SK_VERBOSE_SVG_PARSING)
+        SkDebugf("unhandled element: <%s>\n", elem);
+#endif
+        return nullptr;
+    }
+    SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+
+    return gTagFactories[tagIndex].fValue();
 }
 
-sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext& ctx,
-                                    const SkDOM::Node* xmlNode) {
-    const char* elem = dom.getName(xmlNode);
-    const SkDOM::Type elemType = dom.getType(xmlNode);
+// Returns true if the attribute is the node's id.
+bool parse_node_attribute(const sk_sp<SkSVGNode>& svgNode, const char* name, const char* value,
+                          const ConstructionContext& ctx) {
+    // We're handling id attributes out of band for now.
+    if (!strcmp(name, "id")) {
+        ctx.fIDMapper->set(SkString(value), svgNode);
+        return true;
+    }
+    if (ctx.fRenderCache) {
+        collect_references(name, value, &ctx.fRenderCache->fReferencedIds);
+    }
+    set_string_attribute(svgNode, name, value);
 
-    if (elemType == SkDOM::kText_Type) {
-        // Text literals require special handling.
-        SkASSERT(dom.countChildren(xmlNode) == 0);
-        auto txt = SkSVGTextLiteral::Make();
-        txt->setText(SkString(dom.getName(xmlNode)));
-        ctx.fParent->appendChild(std::move(txt));
+    return false;
+}
 
-        return nullptr;
+// Builds the SVG node tree straight from the XML parser callbacks, without holding on to the
+// whole document as an SkDOM first.
+class SVGTreeBuilder final : public SkXMLParser {
+public:
+    explicit SVGTreeBuilder(const ConstructionContext& ctx) : fRootContext(ctx) {}
+
+    sk_sp<SkSVGNode> detachRoot() { return std::move(fRoot); }
+
+protected:
+    bool onStartElement(const char elem[]) override {
+        this->finishAttributes();
+
+        if (fSkipDepth) {
+            fSkipDepth++;
+            return false;
+        }
+
+        const ConstructionContext& ctx = fStack.empty() ? fRootContext : fStack.back().fContext;
+        auto node = make_node(ctx, elem);
+        if (!node) {
+            // Unsupported elements are dropped along with their whole subtree.
+            fSkipDepth = 1;
+            return false;
+        }
+
+        // Until the attributes are done, the context is that of the node's parent.
+        fStack.push_back({std::move(node), ctx});
+        fInAttributes = true;
+        return false;
     }
 
-    SkASSERT(elemType == SkDOM::kElement_Type);
+    bool onAddAttribute(const char name[], const char value[]) override {
+        if (fInAttributes) {
+            Element& e = fStack.back();
+            e.fHasId |= parse_node_attribute(e.fNode, name, value, e.fContext);
+        }
+        return false;
+    }
 
-    auto make_node = [](const ConstructionContext& ctx, const char* elem) -> sk_sp<SkSVGNode> {
-        if (strcmp(elem, "svg") == 0) {
-            // Outermost SVG element must be tagged as such.
-            return SkSVGSVG::Make(ctx.fParent ? SkSVGSVG::Type::kInner
-                                              : SkSVGSVG::Type::kRoot);
+    bool onEndElement(const char[]) override {
+        this->finishAttributes();
+
+        if (fSkipDepth) {
+            fSkipDepth--;
+            return false;
         }
 
-        const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                         SkTo<int>(std::size(gTagFactories)),
-                                         elem, sizeof(gTagFactories[0]));
-        if (tagIndex < 0) {
-#if defined(SK_VERBOSE_SVG_PARSING)
-            SkDebugf("unhandled element: <%s>\n", elem);
-#endif
-            return nullptr;
+        SkASSERT(!fStack.empty());
+        sk_sp<SkSVGNode> node = std::move(fStack.back().fNode);
+        fStack.pop_back();
+        if (fStack.empty()) {
+            fRoot = std::move(node);
+        } else {
+            fStack.back().fNode->appendChild(std::move(node));
         }
-        SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+        return false;
+    }
 
-        return gTagFactories[tagIndex].fValue();
-    };
+    bool onText(const char text[], int len) override {
+        this->finishAttributes();
 
-    auto node = make_node(ctx, elem);
-    if (!node) {
-        return nullptr;
+        if (fSkipDepth || fStack.empty()) {
+            return false;
+        }
+
+        // Text literals require special handling.
+        const Element& e = fStack.back();
+        auto txt = SkSVGTextLiteral::Make();
+        txt->setText(SkString(text, len));
+        e.fContext.recordNode(txt.get(), /*has_id=*/false);
+        e.fNode->appendChild(std::move(txt));
+        return false;
     }
 
-    parse_node_attributes(dom, xmlNode, node, ctx.fIDMapper);
+private:
+    struct Element {
+        sk_sp<SkSVGNode>    fNode;
+        ConstructionContext fContext;
+        bool                fHasId = false;
+    };
 
-    ConstructionContext localCtx(ctx, node);
-    for (auto* child = dom.getFirstChild(xmlNode, nullptr); child;
-         child = dom.getNextSibling(child)) {
-        sk_sp<SkSVGNode> childNode = construct_svg_node(dom, localCtx, child);
-        if (childNode) {
-            node->appendChild(std::move(childNode));
+    // Switches the current element over to the context of its children, once its attributes
+    // (which always come right after the start tag) have all been parsed.
+    void finishAttributes() {
+        if (fInAttributes) {
+            Element& e = fStack.back();
+            const SkSVGNode* scope = e.fContext.recordNode(e.fNode.get(), e.fHasId);
+            e.fContext = ConstructionContext(e.fContext, e.fNode, scope);
+            fInAttributes = false;
         }
     }
 
-    return node;
-}
+    const ConstructionContext fRootContext;
+    std::vector<Element>      fStack;
+    sk_sp<SkSVGNode>          fRoot;
+    int                       fSkipDepth = 0;
+    bool                      fInAttributes = false;
+};
 
 } // anonymous namespace
 
@@ -411,21 +550,34 @@ SkSVGDOM::Builder& SkSVGDOM::Builder::setTextShapingFactory(sk_sp<SkShapers::Fac
     return *this;
 }
 
+SkSVGDOM::Builder& SkSVGDOM::Builder::setRenderCaching(bool enabled) {
+    fRenderCaching = enabled;
+    return *this;
+}
+
 sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
-    SkDOM xmlDom;
-    if (!xmlDom.build(str)) {
+    SkSVGIDMapper mapper;
+    auto render_cache = fRenderCaching ? std::make_unique<SkSVGRenderCache>() : nullptr;
+
+    SVGTreeBuilder builder(ConstructionContext(&mapper, render_cache.get()));
+    if (!builder.parse(str)) {
         return nullptr;
     }
 
-    SkSVGIDMapper mapper;
-    ConstructionContext ctx(&mapper);
-
-    auto root = construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
+    auto root = builder.detachRoot();
     if (!root || root->tag() != SkSVGTag::kSvg) {
         return nullptr;
     }
 
+    if (render_cache) {
+        render_cache->fReferencedIds.foreach([&](const SkString& id) {
+            if (const sk_sp<SkSVGNode>* node = mapper.find(id)) {
+                render_cache->fReferenced.add(node->get());
+            }
+        });
+    }
+
     class NullResourceProvider final : public skresources::ResourceProvider {
         sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
     };
@@ -439,38 +591,99 @@ sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
                                         std::move(fFontMgr),
                                         std::move(resource_provider),
                                         std::move(mapper),
-                                        std::move(factory)));
+                                        std::move(factory),
+                                        std::move(render_cache)));
 }
 
 SkSVGDOM::SkSVGDOM(sk_sp<SkSVGSVG> root,
                    sk_sp<SkFontMgr> fmgr,
                    sk_sp<skresources::ResourceProvider> rp,
                    SkSVGIDMapper&& mapper,
-                   sk_sp<SkShapers::Factory> fact)
+                   sk_sp<SkShapers::Factory> fact,
+                   std::unique_ptr<SkSVGRenderCache> render_cache)
         : fRoot(std::move(root))
         , fFontMgr(std::move(fmgr))
         , fTextShapingFactory(std::move(fact))
         , fResourceProvider(std::move(rp))
         , fIDMapper(std::move(mapper))
-        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0)))) {
+        , fContainerSize(fRoot->intrinsicSize(SkSVGLengthContext(SkSize::Make(0, 0))))
+        , fRenderCache(std::move(render_cache)) {
     SkASSERT(fResourceProvider);
     SkASSERT(fTextShapingFactory);
 }
 
+SkSVGDOM::~SkSVGDOM() = default;
+
 void SkSVGDOM::render(SkCanvas* canvas) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
     if (fRoot) {
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
-        fRoot->render(SkSVGRenderContext(canvas,
-                                         fFontMgr,
-                                         fResourceProvider,
-                                         fIDMapper,
-                                         lctx,
-                                         pctx,
-                                         {nullptr, nullptr},
-                                         fTextShapingFactory));
+        const SkSVGRenderContext ctx(canvas,
+                                     fFontMgr,
+                                     fResourceProvider,
+                                     fIDMapper,
+                                     lctx,
+                                     pctx,
+                                     {nullptr, nullptr},
+                                     fTextShapingFactory);
+        if (fRenderCache) {
+            fRoot->renderChildren(ctx, [this](const SkSVGRenderContext& ctx,
+                                              const SkSVGNode& child) {
+                this->renderCached(ctx, child);
+            });
+        } else {
+            fRoot->render(ctx);
+        }
+    }
+}
+
+void SkSVGDOM::renderCached(const SkSVGRenderContext& ctx, const SkSVGNode& child) const {
+    SkASSERT(fRenderCache);
+
+    sk_sp<SkPicture>* picture = fRenderCache->fPictures.find(&child);
+    if (!picture) {
+        // Subtrees are recorded in the local space of the root content, which needs no bounds.
+        SkPictureRecorder recorder;
+        child.render(SkSVGRenderContext(ctx, recorder.beginRecording(SkRectPriv::MakeLargest())));
+        picture = fRenderCache->fPictures.set(&child, recorder.finishRecordingAsPicture());
     }
+
+    ctx.canvas()->drawPicture(*picture);
+}
+
+void SkSVGDOM::invalidate(const SkSVGNode* node) {
+    if (!fRenderCache) {
+        return;
+    }
+
+    const SkSVGRenderCache::NodeInfo* info = node ? fRenderCache->fNodes.find(node) : nullptr;
+    if (!info) {
+        fRenderCache->fPictures.reset();
+        return;
+    }
+
+    // Referenced elements and their descendants can affect the rendering of any subtree.
+    for (const SkSVGNode* scope = info->fScope; scope;) {
+        if (fRenderCache->fReferenced.contains(scope)) {
+            fRenderCache->fPictures.reset();
+            return;
+        }
+        const SkSVGNode* const* outer = fRenderCache->fOuterScopes.find(scope);
+        scope = outer ? *outer : nullptr;
+    }
+
+    fRenderCache->fPictures.removeIfExists(info->fSubtree);
+}
+
+bool SkSVGDOM::setAttribute(const char* id, const char* name, const char* value) {
+    sk_sp<SkSVGNode>* node = this->findNodeById(id);
+    if (!node || !(*node)->setAttribute(name, value)) {
+        return false;
+    }
+
+    this->invalidate(node->get());
+    return true;
 }
 
 void SkSVGDOM::renderNode(SkCanvas* canvas, SkSVGPresentationContext& pctx, const char* id) const {
@@ -495,7 +708,9 @@ const SkSize& SkSVGDOM::containerSize() const {
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
+    if (containerSize != fContainerSize) {
+        this->invalidate();
+    }
     fContainerSize = containerSize;
 }
 
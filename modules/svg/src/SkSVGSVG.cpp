@@ -26,6 +26,18 @@ void SkSVGSVG::renderNode(const SkSVGRenderContext& ctx, const SkSVGIRI& iri) co
     }
 }
 
+void SkSVGSVG::renderChildren(const SkSVGRenderContext& ctx,
+                              const std::function<void(const SkSVGRenderContext&,
+                                                       const SkSVGNode&)>& renderChild) const {
+    SkSVGRenderContext localContext(ctx, this);
+
+    if (this->onPrepareToRender(&localContext)) {
+        for (const auto& child : fChildren) {
+            renderChild(localContext, *child);
+        }
+    }
+}
+
 bool SkSVGSVG::onPrepareToRender(SkSVGRenderContext* ctx) const {
     // x/y are ignored for outermost svg elements
     const auto x = fType == Type::kInner ? fX : SkSVGLength(0);
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace {
+
+sk_sp<SkSVGDOM> make_dom(const std::string& svgText) {
+    auto str = SkMemoryStream::MakeDirect(svgText.c_str(), svgText.size());
+    return SkSVGDOM::Builder().make(*str);
+}
+
+// A stream without a memory base, which the parser consumes in chunks.
+class ChunkedStream final : public SkStream {
+public:
+    explicit ChunkedStream(const std::string& text) : fText(text) {}
+
+    size_t read(void* buffer, size_t size) override {
+        size = std::min(size, fText.size() - fOffset);
+        if (buffer) {
+            memcpy(buffer, fText.data() + fOffset, size);
+        }
+        fOffset += size;
+        return size;
+    }
+
+    bool isAtEnd() const override { return fOffset == fText.size(); }
+
+private:
+    const std::string fText;
+    size_t            fOffset = 0;
+};
+
+}  // namespace
+
+DEF_TEST(Svg_Parse_Elements, r) {
+    // Unsupported elements are dropped along with everything in them.
+    auto dom = make_dom("<svg xmlns='http://www.w3.org/2000/svg'>"
+                        "  <unsupported><rect id='inside'/></unsupported>"
+                        "  <rect id='outside' width='10' height='10'/>"
+                        "  <svg id='inner'><rect id='nested'/></svg>"
+                        "  <text id='text'>Hello</text>"
+                        "</svg>");
+    REPORTER_ASSERT(r, dom);
+    REPORTER_ASSERT(r, !dom->findNodeById("inside"));
+    REPORTER_ASSERT(r, dom->findNodeById("outside"));
+
+    sk_sp<SkSVGNode>* inner = dom->findNodeById("inner");
+    REPORTER_ASSERT(r, inner && (*inner)->tag() == SkSVGTag::kSvg);
+    REPORTER_ASSERT(r, dom->findNodeById("nested"));
+
+    sk_sp<SkSVGNode>* text = dom->findNodeById("text");
+    REPORTER_ASSERT(r, text && (*text)->tag() == SkSVGTag::kText);
+}
+
+DEF_TEST(Svg_Parse_Invalid, r) {
+    REPORTER_ASSERT(r, !make_dom(""));
+    REPORTER_ASSERT(r, !make_dom("<rect width='10' height='10'/>"));
+    REPORTER_ASSERT(r, !make_dom("<svg><rect></svg>"));
+    REPORTER_ASSERT(r, !make_dom("<unsupported><svg/></unsupported>"));
+}
+
+DEF_TEST(Svg_Parse_Chunked, r) {
+    std::string svgText = "<svg xmlns='http://www.w3.org/2000/svg' width='100' height='100'>";
+    for (int i = 0; i < 1000; ++i) {
+        svgText += "<rect id='r" + std::to_string(i) + "' x='1' y='2' width='3' height='4'/>";
+    }
+    svgText += "</svg>";
+
+    ChunkedStream stream(svgText);
+    auto dom = SkSVGDOM::Builder().make(stream);
+    REPORTER_ASSERT(r, dom);
+    for (int i = 0; i < 1000; ++i) {
+        sk_sp<SkSVGNode>* rect = dom->findNodeById(("r" + std::to_string(i)).c_str());
+        REPORTER_ASSERT(r, rect && (*rect)->tag() == SkSVGTag::kRect, "rect %d", i);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <string>
+
+namespace {
+
+sk_sp<SkSVGDOM> make_dom(const std::string& svgText, bool cached) {
+    auto str = SkMemoryStream::MakeDirect(svgText.c_str(), svgText.size());
+    return SkSVGDOM::Builder().setRenderCaching(cached).make(*str);
+}
+
+SkBitmap render(const SkSVGDOM& dom) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(100, 100);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    dom.render(&canvas);
+    return bitmap;
+}
+
+bool equal(const SkBitmap& a, const SkBitmap& b) {
+    return 0 == memcmp(a.getPixels(), b.getPixels(), a.computeByteSize());
+}
+
+}  // namespace
+
+DEF_TEST(Svg_RenderCache, r) {
+    const std::string svgText = R"EOF(
+    <svg width="100" height="100" viewBox="0 0 50 50" xmlns="http://www.w3.org/2000/svg">
+        <defs>
+            <linearGradient id="g">
+                <stop id="stop" offset="0" stop-color="red"/>
+                <stop offset="1" stop-color="blue"/>
+            </linearGradient>
+        </defs>
+        <rect id="plain" x="5" y="5" width="15" height="15" fill="green"/>
+        <g id="group" opacity="0.5">
+            <rect id="nested" x="25" y="5" width="15" height="15" fill="black"/>
+        </g>
+        <rect x="5" y="25" width="40" height="15" fill="url(#g)"/>
+    </svg>
+    )EOF";
+
+    auto cached = make_dom(svgText, true),
+         direct = make_dom(svgText, false);
+    REPORTER_ASSERT(r, cached && direct);
+    if (!cached || !direct) {
+        return;
+    }
+
+    REPORTER_ASSERT(r, equal(render(*cached), render(*direct)));
+    REPORTER_ASSERT(r, equal(render(*cached), render(*direct)));
+
+    // Changes show up through setAttribute(), for subtrees and referenced elements alike.
+    for (const char* id : {"plain", "nested", "stop"}) {
+        const char* name = strcmp(id, "stop") ? "fill" : "stop-color";
+        REPORTER_ASSERT(r, cached->setAttribute(id, name, "yellow"));
+        REPORTER_ASSERT(r, direct->setAttribute(id, name, "yellow"));
+        REPORTER_ASSERT(r, equal(render(*cached), render(*direct)), "%s", id);
+    }
+    REPORTER_ASSERT(r, !cached->setAttribute("missing", "fill", "yellow"));
+
+    // Nodes modified directly keep rendering from the cache until they are invalidated.
+    for (SkSVGDOM* dom : {cached.get(), direct.get()}) {
+        sk_sp<SkSVGNode>* node = dom->findNodeById("group");
+        REPORTER_ASSERT(r, node && (*node)->setAttribute("opacity", "1"));
+    }
+    REPORTER_ASSERT(r, !equal(render(*cached), render(*direct)));
+    cached->invalidate(cached->findNodeById("group")->get());
+    REPORTER_ASSERT(r, equal(render(*cached), render(*direct)));
+}
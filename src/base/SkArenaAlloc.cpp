@@ -8,10 +8,12 @@
 #include "src/base/SkArenaAlloc.h"
 
 #include "include/private/base/SkMalloc.h"
+#include "src/base/SkMallocStats.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <utility>
 
 static char* end_chain(char*) { return nullptr; }
 
@@ -33,6 +35,9 @@ SkArenaAlloc::SkArenaAlloc(char* block, size_t size, size_t firstHeapAllocation)
 
 SkArenaAlloc::~SkArenaAlloc() {
     RunDtorsOnBlock(fDtorCursor);
+    if (fTotalHeapBytes > 0 && SkMallocStats::IsEnabled()) {
+        SkMallocStats::RecordArenaRelease(fTotalHeapBytes);
+    }
 }
 
 void SkArenaAlloc::installFooter(FooterAction* action, uint32_t padding) {
@@ -93,6 +98,11 @@ void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
     }
 
     char* newBlock = static_cast<char*>(sk_malloc_throw(allocationSize));
+    if (SkMallocStats::IsEnabled()) {
+        SkMallocStats::RecordArenaBlock(allocationSize);
+    }
+    fTotalHeapBytes = allocationSize > maxSize - fTotalHeapBytes ? maxSize
+                                                                 : fTotalHeapBytes + allocationSize;
 
     auto previousDtor = fDtorCursor;
     fCursor = newBlock;
@@ -146,22 +156,45 @@ restart:
 SkArenaAllocWithReset::SkArenaAllocWithReset(char* block,
                                              size_t size,
                                              size_t firstHeapAllocation)
-        : SkArenaAlloc(block, size, firstHeapAllocation)
+        : SkArenaAllocWithReset(block, SkToU32(size), SkToU32(firstHeapAllocation), nullptr, 0) {}
+
+SkArenaAllocWithReset::SkArenaAllocWithReset(char* block,
+                                             uint32_t size,
+                                             uint32_t firstHeapAllocation,
+                                             skia_private::UniqueVoidPtr retainedBlock,
+                                             uint32_t retainedSize)
+        : SkArenaAllocRetainedBlock{std::move(retainedBlock), retainedSize}
+        , SkArenaAlloc(fRetainedBlock ? static_cast<char*>(fRetainedBlock.get()) : block,
+                       fRetainedBlock ? fRetainedSize : size,
+                       firstHeapAllocation)
         , fFirstBlock{block}
-        , fFirstSize{SkToU32(size)}
-        , fFirstHeapAllocationSize{SkToU32(firstHeapAllocation)} {}
+        , fFirstSize{size}
+        , fFirstHeapAllocationSize{firstHeapAllocation} {}
 
 void SkArenaAllocWithReset::reset() {
     char* const    firstBlock              = fFirstBlock;
     const uint32_t firstSize               = fFirstSize;
     const uint32_t firstHeapAllocationSize = fFirstHeapAllocationSize;
+
+    // The retained block has to stay alive while the destructor runs, since objects may be in it.
+    skia_private::UniqueVoidPtr retainedBlock = std::move(fRetainedBlock);
+    uint32_t retainedSize = fRetainedSize;
+    const size_t capacity = (size_t)(retainedBlock ? retainedSize : firstSize) +
+                            this->totalHeapBytes();
+    const bool grow = this->totalHeapBytes() > 0 && capacity <= kMaxRetainedBlockSize;
+
     this->~SkArenaAllocWithReset();
-    new (this) SkArenaAllocWithReset{firstBlock, firstSize, firstHeapAllocationSize};
+    if (grow) {
+        retainedBlock.reset(sk_malloc_throw(capacity));
+        retainedSize = SkToU32(capacity);
+    }
+    new (this) SkArenaAllocWithReset{firstBlock, firstSize, firstHeapAllocationSize,
+                                     std::move(retainedBlock), retainedSize};
 }
 
 bool SkArenaAllocWithReset::isEmpty() {
     return this->cursor() == nullptr ||
-           this->cursor() == fFirstBlock + sizeof(Footer);
+           this->cursor() == this->firstBlock() + sizeof(Footer);
 }
 
 // SkFibonacci47 is the first 47 Fibonacci numbers. Fib(47) is the largest value less than 2 ^ 32.
@@ -11,6 +11,7 @@
 #include "include/private/base/SkASAN.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTFitsIn.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 
 #include <algorithm>
@@ -215,6 +216,9 @@ protected:
     char* cursor() { return fCursor; }
     char* end() { return fEnd; }
 
+    // The total size of the blocks allocated from the heap, saturating at 4GB.
+    uint32_t totalHeapBytes() const { return fTotalHeapBytes; }
+
 private:
     static void AssertRelease(bool cond) { if (!cond) { ::abort(); } }
 
@@ -302,22 +306,42 @@ private:
     char*          fEnd;
 
     SkFibBlockSizes<std::numeric_limits<uint32_t>::max()> fFibonacciProgression;
+    uint32_t fTotalHeapBytes = 0;
+};
+
+// The heap block an SkArenaAllocWithReset keeps across resets. It is a base class of the arena so
+// that, like inline storage, it outlives the SkArenaAlloc that runs destructors in it.
+struct SkArenaAllocRetainedBlock {
+    skia_private::UniqueVoidPtr fRetainedBlock;
+    uint32_t                    fRetainedSize = 0;
 };
 
-class SkArenaAllocWithReset : public SkArenaAlloc {
+class SkArenaAllocWithReset : private SkArenaAllocRetainedBlock, public SkArenaAlloc {
 public:
     SkArenaAllocWithReset(char* block, size_t blockSize, size_t firstHeapAllocation);
 
     explicit SkArenaAllocWithReset(size_t firstHeapAllocation)
             : SkArenaAllocWithReset(nullptr, 0, firstHeapAllocation) {}
 
-    // Destroy all allocated objects, free any heap allocations.
+    // Destroy all allocated objects, free any heap allocations. If the arena needed heap blocks
+    // since the last reset, they are replaced by a single block big enough for all of them (up
+    // to kMaxRetainedBlockSize), which is kept and used first from then on. An arena that is
+    // filled the same way every frame then stops allocating after the first.
     void reset();
 
     // Returns true if the alloc has never made any objects.
     bool isEmpty();
 
+    static constexpr uint32_t kMaxRetainedBlockSize = 1 << 20;
+
 private:
+    SkArenaAllocWithReset(char* block, uint32_t blockSize, uint32_t firstHeapAllocation,
+                          skia_private::UniqueVoidPtr retainedBlock, uint32_t retainedSize);
+
+    char* firstBlock() {
+        return fRetainedBlock ? static_cast<char*>(fRetainedBlock.get()) : fFirstBlock;
+    }
+
     char* const    fFirstBlock;
     const uint32_t fFirstSize;
     const uint32_t fFirstHeapAllocationSize;
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMallocStats_DEFINED
+#define SkMallocStats_DEFINED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Opt-in counters of the memory Skia allocates with sk_malloc and friends, and of the heap blocks
+ * SkArenaAllocs hold, so that tools like nanobench (--memoryStats) can report allocation
+ * regressions along with time regressions. Allocations made with operator new are not counted.
+ *
+ * The counters are only updated by SkMemory_malloc.cpp; other sk_malloc ports leave them at zero.
+ * Byte counts are the usable sizes of the blocks, where the allocator reports them. Live bytes are
+ * relative to the last Reset(), so freeing blocks allocated before it can make them negative.
+ *
+ * While disabled, the only cost is one relaxed atomic load per allocation and free.
+ */
+class SkMallocStats {
+public:
+    static void SetEnabled(bool enabled) {
+        gEnabled.store(enabled, std::memory_order_relaxed);
+    }
+    static bool IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+    struct Stats {
+        uint64_t fMallocCount;
+        uint64_t fMallocBytes;
+        uint64_t fFreeCount;
+        int64_t  fPeakLiveBytes;
+        uint64_t fArenaBlockCount;
+        int64_t  fPeakArenaBytes;
+    };
+
+    // Zeroes every counter. The peaks start again from the current (zero) live byte counts.
+    static void Reset() {
+        gMallocCount.store(0, std::memory_order_relaxed);
+        gMallocBytes.store(0, std::memory_order_relaxed);
+        gFreeCount.store(0, std::memory_order_relaxed);
+        gLiveBytes.store(0, std::memory_order_relaxed);
+        gPeakLiveBytes.store(0, std::memory_order_relaxed);
+        gArenaBlockCount.store(0, std::memory_order_relaxed);
+        gArenaBytes.store(0, std::memory_order_relaxed);
+        gPeakArenaBytes.store(0, std::memory_order_relaxed);
+    }
+
+    static Stats Snapshot() {
+        return {gMallocCount.load(std::memory_order_relaxed),
+                gMallocBytes.load(std::memory_order_relaxed),
+                gFreeCount.load(std::memory_order_relaxed),
+                gPeakLiveBytes.load(std::memory_order_relaxed),
+                gArenaBlockCount.load(std::memory_order_relaxed),
+                gPeakArenaBytes.load(std::memory_order_relaxed)};
+    }
+
+    // Callers check IsEnabled() first, so that measuring block sizes is only paid when enabled.
+    static void RecordMalloc(size_t bytes) {
+        gMallocCount.fetch_add(1, std::memory_order_relaxed);
+        gMallocBytes.fetch_add(bytes, std::memory_order_relaxed);
+        UpdatePeak(&gPeakLiveBytes,
+                   gLiveBytes.fetch_add((int64_t)bytes, std::memory_order_relaxed) + bytes);
+    }
+    static void RecordFree(size_t bytes) {
+        gFreeCount.fetch_add(1, std::memory_order_relaxed);
+        gLiveBytes.fetch_sub((int64_t)bytes, std::memory_order_relaxed);
+    }
+
+    static void RecordArenaBlock(size_t bytes) {
+        gArenaBlockCount.fetch_add(1, std::memory_order_relaxed);
+        UpdatePeak(&gPeakArenaBytes,
+                   gArenaBytes.fetch_add((int64_t)bytes, std::memory_order_relaxed) + bytes);
+    }
+    static void RecordArenaRelease(size_t bytes) {
+        gArenaBytes.fetch_sub((int64_t)bytes, std::memory_order_relaxed);
+    }
+
+private:
+    static void UpdatePeak(std::atomic<int64_t>* peak, int64_t value) {
+        int64_t prev = peak->load(std::memory_order_relaxed);
+        while (prev < value &&
+               !peak->compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+    }
+
+    inline static std::atomic<bool>     gEnabled{false};
+    inline static std::atomic<uint64_t> gMallocCount{0};
+    inline static std::atomic<uint64_t> gMallocBytes{0};
+    inline static std::atomic<uint64_t> gFreeCount{0};
+    inline static std::atomic<int64_t>  gLiveBytes{0};
+    inline static std::atomic<int64_t>  gPeakLiveBytes{0};
+    inline static std::atomic<uint64_t> gArenaBlockCount{0};
+    inline static std::atomic<int64_t>  gArenaBytes{0};
+    inline static std::atomic<int64_t>  gPeakArenaBytes{0};
+};
+
+#endif  // SkMallocStats_DEFINED
@@ -4,6 +4,9 @@
 #include "src/base/SkUTF.h"
 
 #include "include/private/base/SkTFitsIn.h"
+#include "src/base/SkVx.h"
+
+#include <algorithm>
 
 static constexpr inline int32_t left_shift(int32_t value, int32_t shift) {
     return (int32_t) ((uint32_t) value << shift);
@@ -42,6 +45,23 @@ static bool utf8_type_is_valid_leading_byte(int type) { return type > 0; }
 
 static bool utf8_byte_is_continuation(uint8_t c) { return utf8_byte_type(c) == 0; }
 
+// Text is mostly runs of ASCII (or at least of characters outside the surrogate range), which are
+// checked a block at a time and need no decoding. skvx compiles these to SSE2 or NEON compares.
+using UTF8Block = skvx::Vec<16, uint8_t>;
+using UTF16Block = skvx::Vec<8, uint16_t>;
+
+static bool utf8_block_is_ascii(const char* utf8) {
+    return !any(UTF8Block::Load(utf8) & 0x80);
+}
+
+static bool utf16_block_is_ascii(const uint16_t* utf16) {
+    return !any(UTF16Block::Load(utf16) & 0xFF80);
+}
+
+static bool utf16_block_has_surrogate(const uint16_t* utf16) {
+    return any((UTF16Block::Load(utf16) & 0xF800) == 0xD800);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int SkUTF::CountUTF8(const char* utf8, size_t byteLength) {
@@ -51,6 +71,11 @@ int SkUTF::CountUTF8(const char* utf8, size_t byteLength) {
     int count = 0;
     const char* stop = utf8 + byteLength;
     while (utf8 < stop) {
+        if (stop - utf8 >= 16 && utf8_block_is_ascii(utf8)) {
+            utf8 += 16;
+            count += 16;
+            continue;
+        }
         int type = utf8_byte_type(*(const uint8_t*)utf8);
         if (!utf8_type_is_valid_leading_byte(type) || utf8 + type > stop) {
             return -1;  // Sequence extends beyond end.
@@ -75,6 +100,11 @@ int SkUTF::CountUTF16(const uint16_t* utf16, size_t byteLength) {
     const uint16_t* stop = src + (byteLength >> 1);
     int count = 0;
     while (src < stop) {
+        if (stop - src >= 8 && !utf16_block_has_surrogate(src)) {
+            src += 8;
+            count += 8;
+            continue;
+        }
         unsigned c = *src++;
         if (utf16_is_low_surrogate(c)) {
             return -1;
@@ -126,6 +156,10 @@ SkUnichar SkUTF::NextUTF8(const char** ptr, const char* end) {
     int             c = *p;
     int             hic = c << 24;
 
+    if (c < 0x80) {
+        *ptr = (const char*)p + 1;
+        return c;
+    }
     if (!utf8_type_is_valid_leading_byte(utf8_byte_type(c))) {
         return next_fail(ptr, end);
     }
@@ -265,6 +299,17 @@ int SkUTF::UTF8ToUTF16(uint16_t dst[], int dstCapacity, const char src[], size_t
     uint16_t* endDst = dst + dstCapacity;
     const char* endSrc = src + srcByteLength;
     while (src < endSrc) {
+        if (endSrc - src >= 16 && utf8_block_is_ascii(src)) {
+            if (dst && endDst - dst >= 16) {
+                skvx::cast<uint16_t>(UTF8Block::Load(src)).store(dst);
+                dst += 16;
+            } else if (dst) {
+                dst = std::copy(src, src + std::min<ptrdiff_t>(endDst - dst, 16), dst);
+            }
+            src += 16;
+            dstLength += 16;
+            continue;
+        }
         SkUnichar uni = NextUTF8(&src, endSrc);
         if (uni < 0) {
             return -1;
@@ -297,6 +342,17 @@ int SkUTF::UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], size_t
     const char* endDst = dst + dstCapacity;
     const uint16_t* endSrc = src + srcLength;
     while (src < endSrc) {
+        if (endSrc - src >= 8 && utf16_block_is_ascii(src)) {
+            if (dst && endDst - dst >= 8) {
+                skvx::cast<uint8_t>(UTF16Block::Load(src)).store(dst);
+                dst += 8;
+            } else if (dst) {
+                dst = std::copy(src, src + std::min<ptrdiff_t>(endDst - dst, 8), dst);
+            }
+            src += 8;
+            dstLength += 8;
+            continue;
+        }
         SkUnichar uni = NextUTF16(&src, endSrc);
         if (uni < 0) {
             return -1;
@@ -10,16 +10,23 @@
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedImageFormat.h"
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkStream.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkAndroidCodecAdapter.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkSampledCodec.h"
+#include "src/core/SkMipmap.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <utility>
@@ -541,6 +548,82 @@ SkCodec::Result SkAndroidCodec::getAndroidPixels(const SkImageInfo& info, void*
     return this->getAndroidPixels(info, pixels, rowBytes, nullptr);
 }
 
+SkCodec::Result SkAndroidCodec::getThumbnails(SkSpan<const SkPixmap> thumbnails,
+                                              SkExecutor* executor) {
+    if (thumbnails.empty()) {
+        return SkCodec::kInvalidParameters;
+    }
+    SkISize largest = {0, 0};
+    for (const SkPixmap& thumbnail : thumbnails) {
+        if (!thumbnail.addr() || thumbnail.width() < 1 || thumbnail.height() < 1) {
+            return SkCodec::kInvalidParameters;
+        }
+        largest = {std::max(largest.width(), thumbnail.width()),
+                   std::max(largest.height(), thumbnail.height())};
+    }
+
+    // Decode once, at the smallest size the codec can scale to natively that covers every
+    // thumbnail. Premultiplied pixels are needed to filter them.
+    SkISize decodeSize = largest;
+    AndroidOptions options;
+    options.fSampleSize = this->computeSampleSize(&decodeSize);
+    const SkColorType colorType = this->computeOutputColorType(thumbnails[0].colorType());
+    const SkImageInfo decodeInfo = SkImageInfo::Make(
+            decodeSize,
+            colorType,
+            this->computeOutputAlphaType(false),
+            this->computeOutputColorSpace(colorType, thumbnails[0].refColorSpace()));
+    SkBitmap decoded;
+    if (!decoded.tryAllocPixels(decodeInfo)) {
+        return SkCodec::kInternalError;
+    }
+    const SkCodec::Result result = this->getAndroidPixels(
+            decodeInfo, decoded.getPixels(), decoded.rowBytes(), &options);
+    switch (result) {
+        case SkCodec::kSuccess:
+        case SkCodec::kIncompleteInput:
+        case SkCodec::kErrorInInput:
+            break;
+        default:
+            return result;
+    }
+    decoded.setImmutable();
+
+    // Each level of the mipmap halves the one above it with a box filter, and is only built if a
+    // thumbnail needs it or a smaller level.
+    sk_sp<SkMipmap> mipmap(SkMipmap::BuildLazy(decoded, nullptr));
+    std::atomic<bool> converted{true};
+    auto resample = [&](int i) {
+        const SkPixmap& thumbnail = thumbnails[i];
+        SkPixmap src = decoded.pixmap();
+        if (mipmap) {
+            for (int level = 0; level < mipmap->countLevels(); ++level) {
+                SkISize levelSize = SkMipmap::ComputeLevelSize(decodeSize, level);
+                SkMipmap::Level mipLevel;
+                if (levelSize.width() < thumbnail.width() ||
+                    levelSize.height() < thumbnail.height() ||
+                    !mipmap->getLevel(level, &mipLevel)) {
+                    break;
+                }
+                src = mipLevel.fPixmap;
+            }
+        }
+        if (!src.scalePixels(thumbnail, SkSamplingOptions(SkCubicResampler::Mitchell()))) {
+            converted = false;
+        }
+    };
+    if (executor && thumbnails.size() > 1) {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(SkToInt(thumbnails.size()), resample);
+        taskGroup.wait();
+    } else {
+        for (int i = 0; i < SkToInt(thumbnails.size()); ++i) {
+            resample(i);
+        }
+    }
+    return converted ? result : SkCodec::kInvalidConversion;
+}
+
 bool SkAndroidCodec::getAndroidGainmap(SkGainmapInfo* info,
                                        std::unique_ptr<SkStream>* outGainmapImageStream) {
     return fCodec->onGetGainmapInfo(info, outGainmapImageStream);
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkAnimationDecoder.h"
+
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkCodecAnimation.h"
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSemaphore.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+class AnimationDecoder final : public SkAnimationDecoder {
+public:
+    AnimationDecoder(sk_sp<SkData> data,
+                     std::unique_ptr<SkCodec> codec,
+                     SkExecutor* executor,
+                     int windowSize)
+            : fData(std::move(data))
+            , fInfo(codec->getInfo()
+                            .makeColorType(kN32_SkColorType)
+                            .makeAlphaType(kPremul_SkAlphaType))
+            , fFrameInfos(codec->getFrameInfo())
+            , fRepetitionCount(codec->getRepetitionCount())
+            , fExecutor(executor) {
+        if (fFrameInfos.empty()) {
+            // A still image is one independent frame.
+            SkCodec::FrameInfo frameInfo;
+            frameInfo.fRequiredFrame = SkCodec::kNoFrame;
+            frameInfo.fDuration = 0;
+            frameInfo.fFullyReceived = true;
+            frameInfo.fAlphaType = codec->getInfo().alphaType();
+            frameInfo.fHasAlphaWithinBounds = !codec->getInfo().isOpaque();
+            frameInfo.fDisposalMethod = SkCodecAnimation::DisposalMethod::kKeep;
+            frameInfo.fBlend = SkCodecAnimation::Blend::kSrc;
+            frameInfo.fFrameRect = SkIRect::MakeSize(codec->dimensions());
+            fFrameInfos.push_back(frameInfo);
+        }
+        fSlots.resize(fFrameInfos.size());
+        fWindowSize = std::clamp(windowSize, 1, this->getFrameCount());
+        fCodecs.push_back(std::move(codec));
+        if (fExecutor) {
+            fTaskGroup = std::make_unique<SkTaskGroup>(*fExecutor);
+        }
+    }
+
+    ~AnimationDecoder() override {
+        if (fTaskGroup) {
+            fTaskGroup->wait();
+        }
+    }
+
+    int getFrameCount() const override { return SkToInt(fFrameInfos.size()); }
+
+    SkCodec::FrameInfo getFrameInfo(int index) const override {
+        SkASSERT(index >= 0 && index < this->getFrameCount());
+        return fFrameInfos[index];
+    }
+
+    int getRepetitionCount() const override { return fRepetitionCount; }
+
+    sk_sp<SkImage> getFrame(int index) override {
+        if (index < 0 || index >= this->getFrameCount()) {
+            return nullptr;
+        }
+        std::vector<Decode> decodes;
+        bool wait = false;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            fWindowStart = index;
+            this->evictLocked();
+            if (fExecutor) {
+                this->scheduleLocked(&decodes);
+            } else if (fSlots[index].fState == State::kEmpty) {
+                // Without an executor, only the requested frame is decoded, drawing over its
+                // required frame if that is still around.
+                decodes.push_back(this->startLocked(index));
+            }
+            if (fSlots[index].fState != State::kDone) {
+                fWaitingFor = index;
+                wait = true;
+            }
+        }
+        this->run(decodes);
+        if (wait) {
+            fFrameDone.wait();
+        }
+
+        SkAutoMutexExclusive lock(fMutex);
+        SkASSERT(fSlots[index].fState == State::kDone);
+        const SkBitmap& bitmap = fSlots[index].fBitmap;
+        return bitmap.drawsNothing() ? nullptr : bitmap.asImage();
+    }
+
+private:
+    enum class State {
+        kEmpty,
+        kDecoding,
+        kDone,
+    };
+
+    struct Slot {
+        State fState = State::kEmpty;
+        // Empty if the frame could not be decoded.
+        SkBitmap fBitmap;
+    };
+
+    struct Decode {
+        int fIndex;
+        // The frame whose pixels to draw over, or kNoFrame to let the codec decode the frame's
+        // required frame itself.
+        int fPriorFrame;
+        SkBitmap fPrior;
+    };
+
+    bool inWindow(int index) const SK_REQUIRES(fMutex) {
+        const int count = this->getFrameCount();
+        return (index - fWindowStart + count) % count < fWindowSize;
+    }
+
+    // Whether a frame in the window is waiting to draw over |index|.
+    bool isRequiredLocked(int index) const SK_REQUIRES(fMutex) {
+        for (int i = 0; i < fWindowSize; ++i) {
+            const int frame = (fWindowStart + i) % this->getFrameCount();
+            if (fSlots[frame].fState != State::kDone &&
+                fFrameInfos[frame].fRequiredFrame == index) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void evictLocked() SK_REQUIRES(fMutex) {
+        for (int i = 0; i < this->getFrameCount(); ++i) {
+            Slot& slot = fSlots[i];
+            if (slot.fState == State::kDone && !this->inWindow(i) && !this->isRequiredLocked(i)) {
+                slot.fState = State::kEmpty;
+                slot.fBitmap.reset();
+            }
+        }
+    }
+
+    Decode startLocked(int index) SK_REQUIRES(fMutex) {
+        SkASSERT(fSlots[index].fState == State::kEmpty);
+        fSlots[index].fState = State::kDecoding;
+        const int required = fFrameInfos[index].fRequiredFrame;
+        if (required != SkCodec::kNoFrame && fSlots[required].fState == State::kDone &&
+            !fSlots[required].fBitmap.drawsNothing()) {
+            return {index, required, fSlots[required].fBitmap};
+        }
+        return {index, SkCodec::kNoFrame, SkBitmap()};
+    }
+
+    // Starts decoding every frame in the window that isn't decoded or decoding, unless its
+    // required frame is still to come, in which case it starts when that frame is done.
+    void scheduleLocked(std::vector<Decode>* decodes) SK_REQUIRES(fMutex) {
+        for (int i = 0; i < fWindowSize; ++i) {
+            const int frame = (fWindowStart + i) % this->getFrameCount();
+            if (fSlots[frame].fState != State::kEmpty) {
+                continue;
+            }
+            const int required = fFrameInfos[frame].fRequiredFrame;
+            if (required != SkCodec::kNoFrame && (fSlots[required].fState == State::kDecoding ||
+                                                  (fSlots[required].fState == State::kEmpty &&
+                                                   this->inWindow(required)))) {
+                continue;
+            }
+            decodes->push_back(this->startLocked(frame));
+        }
+    }
+
+    void run(std::vector<Decode>& decodes) {
+        for (Decode& job : decodes) {
+            if (fTaskGroup) {
+                fTaskGroup->add([this, job{std::move(job)}] { this->decode(job); });
+            } else {
+                this->decode(job);
+            }
+        }
+    }
+
+    std::unique_ptr<SkCodec> takeCodec() {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (!fCodecs.empty()) {
+                std::unique_ptr<SkCodec> codec = std::move(fCodecs.back());
+                fCodecs.pop_back();
+                return codec;
+            }
+        }
+        return SkCodec::MakeFromData(fData);
+    }
+
+    void decode(const Decode& job) {
+        std::unique_ptr<SkCodec> codec = this->takeCodec();
+        SkBitmap bitmap;
+        if (codec && bitmap.tryAllocPixels(fInfo)) {
+            if (job.fPriorFrame == SkCodec::kNoFrame) {
+                bitmap.eraseColor(SK_ColorTRANSPARENT);
+            } else {
+                SkAssertResult(job.fPrior.readPixels(bitmap.pixmap()));
+            }
+            SkCodec::Options options;
+            options.fFrameIndex = job.fIndex;
+            options.fPriorFrame = job.fPriorFrame;
+            switch (codec->getPixels(bitmap.pixmap(), &options)) {
+                case SkCodec::kSuccess:
+                case SkCodec::kIncompleteInput:
+                case SkCodec::kErrorInInput:
+                    bitmap.setImmutable();
+                    break;
+                default:
+                    bitmap.reset();
+                    break;
+            }
+        } else {
+            bitmap.reset();
+        }
+
+        std::vector<Decode> decodes;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (codec) {
+                fCodecs.push_back(std::move(codec));
+            }
+            Slot& slot = fSlots[job.fIndex];
+            slot.fState = State::kDone;
+            slot.fBitmap = std::move(bitmap);
+            if (fExecutor) {
+                // Start the frames in the window that were waiting for this one.
+                for (int i = 0; i < fWindowSize; ++i) {
+                    const int frame = (fWindowStart + i) % this->getFrameCount();
+                    if (fSlots[frame].fState == State::kEmpty &&
+                        fFrameInfos[frame].fRequiredFrame == job.fIndex) {
+                        decodes.push_back(this->startLocked(frame));
+                    }
+                }
+            }
+            if (fWaitingFor == job.fIndex) {
+                fWaitingFor = -1;
+                fFrameDone.signal();
+            }
+        }
+        this->run(decodes);
+    }
+
+    const sk_sp<SkData>                   fData;
+    const SkImageInfo                     fInfo;
+    std::vector<SkCodec::FrameInfo>       fFrameInfos;
+    const int                             fRepetitionCount;
+    int                                   fWindowSize;
+    SkExecutor* const                     fExecutor;
+    std::unique_ptr<SkTaskGroup>          fTaskGroup;
+
+    mutable SkMutex                       fMutex;
+    std::vector<Slot>                     fSlots SK_GUARDED_BY(fMutex);
+    std::vector<std::unique_ptr<SkCodec>> fCodecs SK_GUARDED_BY(fMutex);
+    int                                   fWindowStart SK_GUARDED_BY(fMutex) = 0;
+    int                                   fWaitingFor SK_GUARDED_BY(fMutex) = -1;
+    SkSemaphore                           fFrameDone;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<SkAnimationDecoder> SkAnimationDecoder::Make(sk_sp<SkData> data,
+                                                             SkExecutor* executor,
+                                                             int windowSize) {
+    if (!data) {
+        return nullptr;
+    }
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec) {
+        return nullptr;
+    }
+    return std::make_unique<AnimationDecoder>(std::move(data), std::move(codec), executor,
+                                              windowSize);
+}
@@ -143,6 +143,38 @@ void Register(Decoder d) {
     decoders->push_back(d);
 }
 
+static std::vector<std::pair<SkEncodedImageFormat, sk_sp<Accelerator>>>* get_accelerators() {
+    static SkNoDestructor<std::vector<std::pair<SkEncodedImageFormat, sk_sp<Accelerator>>>>
+            accelerators;
+    return accelerators.get();
+}
+
+void RegisterAccelerator(SkEncodedImageFormat format, sk_sp<Accelerator> accelerator) {
+    auto accelerators = get_accelerators();
+    for (size_t i = 0; i < accelerators->size(); i++) {
+        if ((*accelerators)[i].first == format) {
+            if (accelerator) {
+                (*accelerators)[i].second = std::move(accelerator);
+            } else {
+                accelerators->erase(accelerators->begin() + i);
+            }
+            return;
+        }
+    }
+    if (accelerator) {
+        accelerators->emplace_back(format, std::move(accelerator));
+    }
+}
+
+Accelerator* FindAccelerator(SkEncodedImageFormat format) {
+    for (const auto& [acceleratedFormat, accelerator] : *get_accelerators()) {
+        if (acceleratedFormat == format) {
+            return accelerator.get();
+        }
+    }
+    return nullptr;
+}
+
 bool HasDecoder(std::string_view id) {
     for (const SkCodecs::Decoder& decoder : get_decoders()) {
         if (decoder.id == id) {
@@ -273,14 +305,22 @@ bool SkCodec::queryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supporte
            yuvaPixmapInfo->isSupported(supportedDataTypes);
 }
 
-SkCodec::Result SkCodec::getYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
-    if (!yuvaPixmaps.isValid()) {
+SkCodec::Result SkCodec::getYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps,
+                                       const Options& options) {
+    if (!yuvaPixmaps.isValid() || options.fSubset) {
         return kInvalidInput;
     }
     if (!this->rewindIfNeeded()) {
         return kCouldNotRewind;
     }
-    return this->onGetYUVAPlanes(yuvaPixmaps);
+    if (SkCodecs::Accelerator* accelerator = SkCodecs::FindAccelerator(this->getEncodedFormat())) {
+        if (std::unique_ptr<SkStream> encoded = this->getEncodedData()) {
+            if (accelerator->decodeYUVA(*this, encoded.get(), yuvaPixmaps)) {
+                return kSuccess;
+            }
+        }
+    }
+    return this->onGetYUVAPlanes(yuvaPixmaps, options);
 }
 
 bool SkCodec::conversionSupported(const SkImageInfo& dst, bool srcIsOpaque, bool needsColorXform) {
@@ -503,6 +543,19 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& info, void* pixels, size_t
         return kInvalidScale;
     }
 
+    if (options->fFrameIndex == 0 && !options->fSubset) {
+        if (SkCodecs::Accelerator* accelerator =
+                    SkCodecs::FindAccelerator(this->getEncodedFormat())) {
+            // Offered a duplicate of the stream, so the codec's own stream is where it was if the
+            // accelerator declines.
+            if (std::unique_ptr<SkStream> encoded = this->getEncodedData()) {
+                if (accelerator->decode(*this, encoded.get(), SkPixmap(info, pixels, rowBytes))) {
+                    return kSuccess;
+                }
+            }
+        }
+    }
+
     fDstInfo = info;
     fOptions = *options;
 
@@ -17,6 +17,8 @@
 
 #include <string_view>
 
+enum class SkEncodedImageFormat;
+
 #ifdef SK_PRINT_CODEC_MESSAGES
     #define SkCodecPrintf SkDebugf
 #else
@@ -256,7 +258,12 @@ static inline PackColorProc choose_pack_color_proc(bool isPremul, SkColorType co
 }
 
 namespace SkCodecs {
+class Accelerator;
+
 bool HasDecoder(std::string_view id);
+
+// The accelerator registered for the format, if any.
+Accelerator* FindAccelerator(SkEncodedImageFormat format);
 }
 
 #endif // SkCodecPriv_DEFINED
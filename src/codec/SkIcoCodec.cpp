@@ -401,6 +401,13 @@ SkCodec::SkScanlineOrder SkIcoCodec::onGetScanlineOrder() const {
     return INHERITED::onGetScanlineOrder();
 }
 
+bool SkIcoCodec::onIncrementalDecodeRewritesRows() const {
+    if (fCurrCodec) {
+        return fCurrCodec->incrementalDecodeRewritesRows();
+    }
+    return INHERITED::onIncrementalDecodeRewritesRows();
+}
+
 SkSampler* SkIcoCodec::getSampler(bool createIfNecessary) {
     if (fCurrCodec) {
         return fCurrCodec->getSampler(createIfNecessary);
@@ -56,6 +56,8 @@ protected:
 
     SkScanlineOrder onGetScanlineOrder() const override;
 
+    bool onIncrementalDecodeRewritesRows() const override;
+
     bool conversionSupported(const SkImageInfo&, bool, bool) override {
         // This will be checked by the embedded codec.
         return true;
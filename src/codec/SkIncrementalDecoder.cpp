@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkIncrementalDecoder.h"
+
+#include "include/core/SkImageInfo.h"
+#include "include/private/base/SkTPin.h"
+
+#include <algorithm>
+#include <utility>
+
+std::unique_ptr<SkIncrementalDecoder> SkIncrementalDecoder::Make(std::unique_ptr<SkCodec> codec,
+                                                                 const SkImageInfo& info,
+                                                                 const SkCodec::Options* options,
+                                                                 SkCodec::Result* result) {
+    SkCodec::Result resultStorage;
+    if (!result) {
+        result = &resultStorage;
+    }
+    if (!codec) {
+        *result = SkCodec::kInvalidInput;
+        return nullptr;
+    }
+
+    // SkBitmap allocates zeroed pixels, so the rows that have not been decoded are transparent.
+    // The codec is still told they are not zero initialized, since a pass of an interlaced image
+    // must also overwrite the pixels an earlier pass wrote.
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(info)) {
+        *result = SkCodec::kInternalError;
+        return nullptr;
+    }
+    SkCodec::Options decodeOptions = options ? *options : SkCodec::Options();
+    decodeOptions.fZeroInitialized = SkCodec::kNo_ZeroInitialized;
+
+    *result = codec->startIncrementalDecode(
+            bitmap.info(), bitmap.getPixels(), bitmap.rowBytes(), &decodeOptions);
+    if (*result != SkCodec::kSuccess) {
+        return nullptr;
+    }
+    return std::unique_ptr<SkIncrementalDecoder>(
+            new SkIncrementalDecoder(std::move(codec), std::move(bitmap)));
+}
+
+SkIncrementalDecoder::SkIncrementalDecoder(std::unique_ptr<SkCodec> codec, SkBitmap bitmap)
+        : fCodec(std::move(codec)), fBitmap(std::move(bitmap)) {}
+
+SkCodec::Result SkIncrementalDecoder::decode(SkIRect* changed) {
+    SkASSERT(changed);
+    *changed = SkIRect::MakeEmpty();
+    if (fFinished) {
+        return fResult;
+    }
+
+    const int height = fBitmap.height();
+    int rowsDecoded = 0;
+    fResult = fCodec->incrementalDecode(&rowsDecoded);
+    switch (fResult) {
+        case SkCodec::kSuccess:
+            rowsDecoded = height;
+            fFinished = true;
+            break;
+        case SkCodec::kIncompleteInput:
+            break;
+        case SkCodec::kErrorInInput:
+            // The rows before the error are still valid.
+            fFinished = true;
+            break;
+        default:
+            fFinished = true;
+            return fResult;
+    }
+    rowsDecoded = SkTPin(rowsDecoded, 0, height);
+
+    const int top = fCodec->incrementalDecodeRewritesRows() ? 0 : fRowsDecoded;
+    if (rowsDecoded > top) {
+        *changed = SkIRect::MakeLTRB(0, top, fBitmap.width(), rowsDecoded);
+    }
+    fRowsDecoded = std::max(fRowsDecoded, rowsDecoded);
+    return fResult;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkIncrementalDecoder_DEFINED
+#define SkIncrementalDecoder_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkRect.h"
+
+#include <memory>
+
+struct SkImageInfo;
+
+/*
+ * Runs an incremental decode into a zero-initialized bitmap that it owns, and reports the rows
+ * that each step changed, so that a copy of the pixels (e.g. a texture) can be kept up to date by
+ * copying only those rows.
+ */
+class SkIncrementalDecoder {
+public:
+    /*
+     * Starts an incremental decode of |codec| to |info|. Returns nullptr, and sets |result| if it
+     * is not null, if the codec can't start one. Any fSubset in |options| must outlive the
+     * returned object.
+     */
+    static std::unique_ptr<SkIncrementalDecoder> Make(std::unique_ptr<SkCodec> codec,
+                                                      const SkImageInfo& info,
+                                                      const SkCodec::Options* options,
+                                                      SkCodec::Result* result);
+
+    /*
+     * Decodes whatever more of the image the codec's stream has, and sets |changed| to the rows
+     * that changed since the last call, which may be empty.
+     *
+     * Returns kIncompleteInput if there is more to decode, after which this may be called again
+     * once the stream has more data. Once the decode has finished, or failed, this returns the
+     * same result again without changing any rows.
+     */
+    SkCodec::Result decode(SkIRect* changed);
+
+    // The decoded pixels. Rows that have not been decoded yet are zero.
+    const SkBitmap& bitmap() const { return fBitmap; }
+
+    // The number of rows, from the top, that have been at least partly initialized.
+    int rowsDecoded() const { return fRowsDecoded; }
+
+    bool isFinished() const { return fFinished; }
+
+private:
+    SkIncrementalDecoder(std::unique_ptr<SkCodec>, SkBitmap);
+
+    std::unique_ptr<SkCodec> fCodec;
+    SkBitmap                 fBitmap;
+    int                      fRowsDecoded = 0;
+    bool                     fFinished = false;
+    SkCodec::Result          fResult = SkCodec::kIncompleteInput;
+};
+
+#endif
@@ -21,23 +21,29 @@
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkJpegMetadataDecoderImpl.h"
 #include "src/codec/SkJpegPriv.h"
+#include "src/codec/SkJpegRestartSlices.h"
 #include "src/codec/SkParseEncodedOrigin.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkTaskGroup.h"
 
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
 #include "include/private/SkGainmapInfo.h"
 #endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <csetjmp>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -478,6 +484,12 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    if (std::unique_ptr<SkJpegRestartSlices> slices = this->makeRestartSlices(options)) {
+        if (this->decodeRestartSlices(*slices, dstInfo, dst, dstRowBytes, options)) {
+            return kSuccess;
+        }
+    }
+
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -789,41 +801,13 @@ bool SkJpegCodec::onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& su
     return is_yuv_supported(dinfo, *this, &supportedDataTypes, yuvaPixmapInfo);
 }
 
-SkCodec::Result SkJpegCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
-    // Get a pointer to the decompress info since we will use it quite frequently
-    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
-    if (!is_yuv_supported(dinfo, *this, nullptr, nullptr)) {
-        return fDecoderMgr->returnFailure("onGetYUVAPlanes", kInvalidInput);
-    }
-    // Set the jump location for libjpeg errors
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
-    if (setjmp(jmp)) {
-        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
-    }
-
-    dinfo->raw_data_out = TRUE;
-    if (!jpeg_start_decompress(dinfo)) {
-        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
-    }
-
-    const std::array<SkPixmap, SkYUVAPixmaps::kMaxPlanes>& planes = yuvaPixmaps.planes();
-
-#ifdef SK_DEBUG
-    {
-        // A previous implementation claims that the return value of is_yuv_supported()
-        // may change after calling jpeg_start_decompress().  It looks to me like this
-        // was caused by a bug in the old code, but we'll be safe and check here.
-        // Also check that pixmap properties agree with expectations.
-        SkYUVAPixmapInfo info;
-        SkASSERT(is_yuv_supported(dinfo, *this, nullptr, &info));
-        SkASSERT(info.yuvaInfo() == yuvaPixmaps.yuvaInfo());
-        for (int i = 0; i < info.numPlanes(); ++i) {
-            SkASSERT(planes[i].colorType() == kAlpha_8_SkColorType);
-            SkASSERT(info.planeInfo(i) == planes[i].info());
-        }
-    }
-#endif
-
+/*
+ * Reads the Y, U and V rows of a raw data decode into the three planes, which start at the
+ * first row the decode will output.
+ */
+static bool read_yuv_planes(jpeg_decompress_struct* dinfo,
+                            JSAMPLE* const planes[3],
+                            const size_t planeRowBytes[3]) {
     // Build a JSAMPIMAGE to handle output from libjpeg-turbo.  A JSAMPIMAGE has
     // a 2-D array of pixels for each of the components (Y, U, V) in the image.
     // Cheat Sheet:
@@ -840,19 +824,17 @@ SkCodec::Result SkJpegCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
     int numYRowsPerBlock = DCTSIZE * dinfo->comp_info[0].v_samp_factor;
     static_assert(sizeof(JSAMPLE) == 1);
     for (int i = 0; i < numYRowsPerBlock; i++) {
-        rowptrs[i] = static_cast<JSAMPLE*>(planes[0].writable_addr()) + i* planes[0].rowBytes();
+        rowptrs[i] = planes[0] + i * planeRowBytes[0];
     }
     for (int i = 0; i < DCTSIZE; i++) {
-        rowptrs[i + 2 * DCTSIZE] =
-                static_cast<JSAMPLE*>(planes[1].writable_addr()) + i* planes[1].rowBytes();
-        rowptrs[i + 3 * DCTSIZE] =
-                static_cast<JSAMPLE*>(planes[2].writable_addr()) + i* planes[2].rowBytes();
+        rowptrs[i + 2 * DCTSIZE] = planes[1] + i * planeRowBytes[1];
+        rowptrs[i + 3 * DCTSIZE] = planes[2] + i * planeRowBytes[2];
     }
 
     // After each loop iteration, we will increment pointers to Y, U, and V.
-    size_t blockIncrementY = numYRowsPerBlock * planes[0].rowBytes();
-    size_t blockIncrementU = DCTSIZE * planes[1].rowBytes();
-    size_t blockIncrementV = DCTSIZE * planes[2].rowBytes();
+    size_t blockIncrementY = numYRowsPerBlock * planeRowBytes[0];
+    size_t blockIncrementU = DCTSIZE * planeRowBytes[1];
+    size_t blockIncrementV = DCTSIZE * planeRowBytes[2];
 
     uint32_t numRowsPerBlock = numYRowsPerBlock;
 
@@ -864,7 +846,7 @@ SkCodec::Result SkJpegCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
         JDIMENSION linesRead = jpeg_read_raw_data(dinfo, yuv, numRowsPerBlock);
         if (linesRead < numRowsPerBlock) {
             // FIXME: Handle incomplete YUV decodes without signalling an error.
-            return kInvalidInput;
+            return false;
         }
 
         // Update rowptrs.
@@ -885,7 +867,7 @@ SkCodec::Result SkJpegCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
         // this requirement using an extra row buffer.
         // FIXME: Should SkCodec have an extra memory buffer that can be shared among
         //        all of the implementations that use temporary/garbage memory?
-        AutoTMalloc<JSAMPLE> extraRow(planes[0].rowBytes());
+        AutoTMalloc<JSAMPLE> extraRow(planeRowBytes[0]);
         for (int i = remainingRows; i < numYRowsPerBlock; i++) {
             rowptrs[i] = extraRow.get();
         }
@@ -898,13 +880,284 @@ SkCodec::Result SkJpegCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
         JDIMENSION linesRead = jpeg_read_raw_data(dinfo, yuv, numRowsPerBlock);
         if (linesRead < remainingRows) {
             // FIXME: Handle incomplete YUV decodes without signalling an error.
-            return kInvalidInput;
+            return false;
         }
     }
 
+    return true;
+}
+
+SkCodec::Result SkJpegCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps,
+                                             const Options& options) {
+    // Get a pointer to the decompress info since we will use it quite frequently
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (!is_yuv_supported(dinfo, *this, nullptr, nullptr)) {
+        return fDecoderMgr->returnFailure("onGetYUVAPlanes", kInvalidInput);
+    }
+
+    if (std::unique_ptr<SkJpegRestartSlices> slices = this->makeRestartSlices(options)) {
+        if (this->decodeRestartSlicesToYUV(*slices, yuvaPixmaps, options)) {
+            return kSuccess;
+        }
+    }
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
+    }
+
+    dinfo->raw_data_out = TRUE;
+    if (!jpeg_start_decompress(dinfo)) {
+        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
+    }
+
+    const std::array<SkPixmap, SkYUVAPixmaps::kMaxPlanes>& planes = yuvaPixmaps.planes();
+
+#ifdef SK_DEBUG
+    {
+        // A previous implementation claims that the return value of is_yuv_supported()
+        // may change after calling jpeg_start_decompress().  It looks to me like this
+        // was caused by a bug in the old code, but we'll be safe and check here.
+        // Also check that pixmap properties agree with expectations.
+        SkYUVAPixmapInfo info;
+        SkASSERT(is_yuv_supported(dinfo, *this, nullptr, &info));
+        SkASSERT(info.yuvaInfo() == yuvaPixmaps.yuvaInfo());
+        for (int i = 0; i < info.numPlanes(); ++i) {
+            SkASSERT(planes[i].colorType() == kAlpha_8_SkColorType);
+            SkASSERT(info.planeInfo(i) == planes[i].info());
+        }
+    }
+#endif
+
+    JSAMPLE* planeAddrs[3];
+    size_t planeRowBytes[3];
+    for (int i = 0; i < 3; ++i) {
+        planeAddrs[i] = static_cast<JSAMPLE*>(planes[i].writable_addr());
+        planeRowBytes[i] = planes[i].rowBytes();
+    }
+    if (!read_yuv_planes(dinfo, planeAddrs, planeRowBytes)) {
+        return kInvalidInput;
+    }
+
     return kSuccess;
 }
 
+// Each slice pays for a decompress struct of its own and, if the chroma planes are subsampled
+// vertically, for decoding the MCU rows just above and below it. Slices smaller than this would
+// spend more time on that than they save.
+static constexpr int kMinRestartSliceRows = 256;
+
+// Returns the boundaries to split the image at, including the start and end of the image.
+static std::vector<int> choose_restart_slices(const SkJpegRestartSlices& slices) {
+    std::vector<int> boundaries = {0};
+    const int last = slices.boundaryCount() - 1;
+    for (int i = 1; i < last; ++i) {
+        const int row = slices.boundaryRow(i);
+        if (row - slices.boundaryRow(boundaries.back()) >= kMinRestartSliceRows &&
+            slices.height() - row >= kMinRestartSliceRows / 2) {
+            boundaries.push_back(i);
+        }
+    }
+    boundaries.push_back(last);
+    return boundaries;
+}
+
+std::unique_ptr<SkJpegRestartSlices> SkJpegCodec::makeRestartSlices(const Options& options) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (!options.fExecutor || options.fSubset || dinfo->scale_num != dinfo->scale_denom ||
+        dinfo->progressive_mode || dinfo->restart_interval == 0) {
+        return nullptr;
+    }
+    // Slicing reads the whole image up front, which is only free if it is already in memory.
+    SkStream* stream = this->stream();
+    const void* data = stream->getMemoryBase();
+    if (!data || !stream->hasLength()) {
+        return nullptr;
+    }
+    std::unique_ptr<SkJpegRestartSlices> slices =
+            SkJpegRestartSlices::Make(static_cast<const uint8_t*>(data), stream->getLength());
+    if (!slices || slices->width() != SkToInt(dinfo->image_width) ||
+        slices->height() != SkToInt(dinfo->image_height) ||
+        choose_restart_slices(*slices).size() < 3) {
+        return nullptr;
+    }
+    return slices;
+}
+
+namespace {
+
+// Starts decoding a slice made by SkJpegRestartSlices. Must be called after setting the jump
+// buffer of the decoder's error manager.
+bool start_restart_slice(JpegDecoderMgr* slice, jpeg_decompress_struct* image, bool rawData) {
+    slice->init();
+    jpeg_decompress_struct* dinfo = slice->dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, TRUE)) {
+        return false;
+    }
+    // Match the parameters chosen for the whole image.
+    dinfo->out_color_space = image->out_color_space;
+    dinfo->dither_mode = image->dither_mode;
+    dinfo->dct_method = image->dct_method;
+    dinfo->do_fancy_upsampling = image->do_fancy_upsampling;
+    dinfo->raw_data_out = rawData;
+    return jpeg_start_decompress(dinfo);
+}
+
+}  // namespace
+
+bool SkJpegCodec::decodeRestartSlices(const SkJpegRestartSlices& slices,
+                                      const SkImageInfo& dstInfo,
+                                      void* dst,
+                                      size_t rowBytes,
+                                      const Options& options) {
+    if (needs_swizzler_to_convert_from_cmyk(fDecoderMgr->dinfo()->out_color_space,
+                                            this->getEncodedInfo().profile(),
+                                            this->colorXform())) {
+        return false;
+    }
+    const std::vector<int> boundaries = choose_restart_slices(slices);
+    const int sliceCount = SkToInt(boundaries.size()) - 1;
+    // Rows of the MCU rows above and below a slice change the upsampled rows at its edges. These
+    // are decoded too, and the rows above are thrown away.
+    const int context = slices.needsVerticalContext() ? 1 : 0;
+    const bool xformInPlace = dstInfo.bytesPerPixel() == sizeof(uint32_t);
+
+    std::atomic<bool> succeeded{true};
+    SkTaskGroup taskGroup(*options.fExecutor);
+    taskGroup.batch(sliceCount, [&](int i) {
+        const int first = std::max(boundaries[i] - context, 0);
+        const int last = std::min(boundaries[i + 1] + context, slices.boundaryCount() - 1);
+        const int skipRows = slices.boundaryRow(boundaries[i]) - slices.boundaryRow(first);
+        const int top = slices.boundaryRow(boundaries[i]);
+        const int rows = slices.boundaryRow(boundaries[i + 1]) - top;
+
+        std::unique_ptr<SkStream> stream = SkMemoryStream::Make(slices.makeSlice(first, last));
+        JpegDecoderMgr decoderMgr(stream.get());
+        AutoTMalloc<JSAMPLE> storage;
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+        if (setjmp(jmp)) {
+            succeeded = false;
+            return;
+        }
+        if (!start_restart_slice(&decoderMgr, fDecoderMgr->dinfo(), /*rawData=*/false)) {
+            succeeded = false;
+            return;
+        }
+        jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+
+        // Rows above the slice, and rows that are color transformed into a wider destination,
+        // are decoded into storage.
+        storage.reset(get_row_bytes(dinfo));
+        for (int y = 0; y < skipRows; y++) {
+            JSAMPLE* decodeDst = storage.get();
+            if (1 != jpeg_read_scanlines(dinfo, &decodeDst, 1)) {
+                succeeded = false;
+                return;
+            }
+        }
+        void* dstRow = SkTAddOffset<void>(dst, top * rowBytes);
+        for (int y = 0; y < rows; y++) {
+            JSAMPLE* decodeDst = this->colorXform() && !xformInPlace
+                                         ? storage.get()
+                                         : static_cast<JSAMPLE*>(dstRow);
+            if (1 != jpeg_read_scanlines(dinfo, &decodeDst, 1)) {
+                succeeded = false;
+                return;
+            }
+            if (this->colorXform()) {
+                this->applyColorXform(dstRow, decodeDst, dstInfo.width());
+            }
+            dstRow = SkTAddOffset<void>(dstRow, rowBytes);
+        }
+    });
+    taskGroup.wait();
+    return succeeded;
+}
+
+std::unique_ptr<SkCodec> SkJpegCodec::onMakeCodecFromRow(int row, int* startRow) {
+    if (!fFoundRowSlices) {
+        fFoundRowSlices = true;
+        jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+        SkStream* stream = this->stream();
+        const void* data = stream->getMemoryBase();
+        if (dinfo->progressive_mode || dinfo->restart_interval == 0 || !data ||
+            !stream->hasLength()) {
+            return nullptr;
+        }
+        fRowSlices = SkJpegRestartSlices::Make(static_cast<const uint8_t*>(data),
+                                               stream->getLength());
+        if (fRowSlices && (fRowSlices->width() != SkToInt(dinfo->image_width) ||
+                           fRowSlices->height() != SkToInt(dinfo->image_height))) {
+            fRowSlices.reset();
+        }
+    }
+    if (!fRowSlices) {
+        return nullptr;
+    }
+
+    // Like decodeRestartSlices, leave the MCU row above |row| in the slice, so that the rows
+    // upsampled from it match the whole image.
+    const int context = fRowSlices->needsVerticalContext() ? fRowSlices->mcuHeight() : 0;
+    const int last = fRowSlices->boundaryCount() - 1;
+    int first = 0;
+    for (int i = 1; i < last && fRowSlices->boundaryRow(i) + context <= row; ++i) {
+        first = i;
+    }
+    if (first == 0) {
+        return nullptr;
+    }
+
+    Result result;
+    std::unique_ptr<SkCodec> codec = MakeFromStream(
+            SkMemoryStream::Make(fRowSlices->makeSlice(first, last)), &result);
+    if (!codec) {
+        return nullptr;
+    }
+    *startRow = fRowSlices->boundaryRow(first);
+    return codec;
+}
+
+bool SkJpegCodec::decodeRestartSlicesToYUV(const SkJpegRestartSlices& slices,
+                                           const SkYUVAPixmaps& yuvaPixmaps,
+                                           const Options& options) {
+    // Raw data is not upsampled, so the slices don't need any rows around them.
+    const std::vector<int> boundaries = choose_restart_slices(slices);
+    const int sliceCount = SkToInt(boundaries.size()) - 1;
+    const std::array<SkPixmap, SkYUVAPixmaps::kMaxPlanes>& planes = yuvaPixmaps.planes();
+    const int vSampY = fDecoderMgr->dinfo()->comp_info[0].v_samp_factor;
+
+    std::atomic<bool> succeeded{true};
+    SkTaskGroup taskGroup(*options.fExecutor);
+    taskGroup.batch(sliceCount, [&](int i) {
+        // Slices start on MCU rows, which are a whole number of U and V rows.
+        const int top = slices.boundaryRow(boundaries[i]);
+        SkASSERT(top % slices.mcuHeight() == 0);
+        JSAMPLE* planeAddrs[3];
+        size_t planeRowBytes[3];
+        for (int p = 0; p < 3; ++p) {
+            const int planeTop = p == 0 ? top : top / vSampY;
+            planeAddrs[p] = static_cast<JSAMPLE*>(planes[p].writable_addr(0, planeTop));
+            planeRowBytes[p] = planes[p].rowBytes();
+        }
+
+        std::unique_ptr<SkStream> stream =
+                SkMemoryStream::Make(slices.makeSlice(boundaries[i], boundaries[i + 1]));
+        JpegDecoderMgr decoderMgr(stream.get());
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+        if (setjmp(jmp)) {
+            succeeded = false;
+            return;
+        }
+        if (!start_restart_slice(&decoderMgr, fDecoderMgr->dinfo(), /*rawData=*/true) ||
+            !read_yuv_planes(decoderMgr.dinfo(), planeAddrs, planeRowBytes)) {
+            succeeded = false;
+        }
+    });
+    taskGroup.wait();
+    return succeeded;
+}
+
 bool SkJpegCodec::onGetGainmapInfo(SkGainmapInfo* info,
                                    std::unique_ptr<SkStream>* gainmapImageStream) {
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
@@ -23,6 +23,7 @@
 #include <memory>
 
 class JpegDecoderMgr;
+class SkJpegRestartSlices;
 class SkSampler;
 class SkStream;
 class SkSwizzler;
@@ -62,7 +63,7 @@ protected:
     bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
                          SkYUVAPixmapInfo*) const override;
 
-    Result onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override;
+    Result onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps, const Options&) override;
 
     SkEncodedImageFormat onGetEncodedFormat() const override {
         return SkEncodedImageFormat::kJPEG;
@@ -131,6 +132,24 @@ private:
     [[nodiscard]] bool allocateStorage(const SkImageInfo& dstInfo);
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
+    /*
+     * Parallel decoding of images with restart markers.
+     *
+     * Returns nullptr unless options.fExecutor is set and the encoded data is in memory and can be
+     * split into more than one slice.
+     */
+    std::unique_ptr<SkJpegRestartSlices> makeRestartSlices(const Options& options);
+
+    /*
+     * Decode each slice with its own decompress struct on options.fExecutor. These return false
+     * if any slice fails, without having started fDecoderMgr's decompress struct, so that the
+     * caller can fall back to decoding the image as a whole.
+     */
+    bool decodeRestartSlices(const SkJpegRestartSlices&, const SkImageInfo& dstInfo, void* dst,
+                             size_t rowBytes, const Options&);
+    bool decodeRestartSlicesToYUV(const SkJpegRestartSlices&, const SkYUVAPixmaps&,
+                                  const Options&);
+
     /*
      * Scanline decoding.
      */
@@ -140,6 +159,11 @@ private:
     int onGetScanlines(void* dst, int count, size_t rowBytes) override;
     bool onSkipScanlines(int count) override;
 
+    /*
+     * Starts a slice at the last restart boundary far enough above |row|.
+     */
+    std::unique_ptr<SkCodec> onMakeCodecFromRow(int row, int* startRow) override;
+
     std::unique_ptr<JpegDecoderMgr>    fDecoderMgr;
 
     // We will save the state of the decompress struct after reading the header.
@@ -158,6 +182,10 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // The restart boundaries for onMakeCodecFromRow, found the first time it is called.
+    std::unique_ptr<SkJpegRestartSlices> fRowSlices;
+    bool                               fFoundRowSlices = false;
+
     friend class SkRawCodec;
 
     using INHERITED = SkCodec;
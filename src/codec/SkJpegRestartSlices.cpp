@@ -0,0 +1,235 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkJpegRestartSlices.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkTo.h"
+#include "src/codec/SkJpegConstants.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint8_t kMarkerRestart0 = 0xD0;
+constexpr uint8_t kMarkerRestart7 = 0xD7;
+constexpr uint8_t kMarkerDefineRestartInterval = 0xDD;
+
+uint16_t read_u16(const uint8_t* data) {
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+// True for the start of frame markers, which are 0xC0 through 0xCF except for DHT (0xC4), JPG
+// (0xC8) and DAC (0xCC).
+bool is_start_of_frame(uint8_t marker) {
+    return marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+}
+
+// Baseline, extended sequential Huffman and extended sequential arithmetic frames. Progressive,
+// lossless and hierarchical frames can't be split at restart markers.
+bool is_sequential(uint8_t marker) {
+    return marker == 0xC0 || marker == 0xC1 || marker == 0xC9;
+}
+
+}  // namespace
+
+std::unique_ptr<SkJpegRestartSlices> SkJpegRestartSlices::Make(const uint8_t* data, size_t size) {
+    if (size < kJpegMarkerCodeSize || data[0] != 0xFF || data[1] != kJpegMarkerStartOfImage) {
+        return nullptr;
+    }
+    std::unique_ptr<SkJpegRestartSlices> slices(new SkJpegRestartSlices);
+    slices->fData = data;
+
+    // Read the segments up to and including the start of scan.
+    int componentCount = 0;
+    int scanComponentCount = 0;
+    int maxHSamp = 0;
+    size_t offset = kJpegMarkerCodeSize;
+    while (true) {
+        if (offset >= size || data[offset] != 0xFF) {
+            return nullptr;
+        }
+        // Skip fill bytes.
+        while (offset < size && data[offset] == 0xFF) {
+            offset++;
+        }
+        if (offset + 1 + kJpegSegmentParameterLengthSize > size) {
+            return nullptr;
+        }
+        const uint8_t marker = data[offset++];
+        const uint16_t length = read_u16(data + offset);
+        if (length < kJpegSegmentParameterLengthSize || offset + length > size) {
+            return nullptr;
+        }
+        const uint8_t* params = data + offset + kJpegSegmentParameterLengthSize;
+
+        if (is_start_of_frame(marker)) {
+            if (!is_sequential(marker) || componentCount) {
+                return nullptr;
+            }
+            // P, Y, X, Nf and then Ci, HiVi, Tqi for each component.
+            if (length < 8) {
+                return nullptr;
+            }
+            slices->fHeightOffset = offset + kJpegSegmentParameterLengthSize + 1;
+            slices->fHeight = read_u16(params + 1);
+            slices->fWidth = read_u16(params + 3);
+            componentCount = params[5];
+            if (componentCount == 0 || length < 8 + 3 * componentCount) {
+                return nullptr;
+            }
+            slices->fMinVSamp = 0xF;
+            for (int i = 0; i < componentCount; ++i) {
+                const int hSamp = params[6 + 3 * i + 1] >> 4;
+                const int vSamp = params[6 + 3 * i + 1] & 0xF;
+                if (hSamp == 0 || vSamp == 0) {
+                    return nullptr;
+                }
+                maxHSamp = std::max(maxHSamp, hSamp);
+                slices->fMaxVSamp = std::max(slices->fMaxVSamp, vSamp);
+                slices->fMinVSamp = std::min(slices->fMinVSamp, vSamp);
+            }
+        } else if (marker == kMarkerDefineRestartInterval) {
+            if (length != 4) {
+                return nullptr;
+            }
+            slices->fRestartInterval = read_u16(params);
+        } else if (marker == kJpegMarkerStartOfScan) {
+            if (length < 3) {
+                return nullptr;
+            }
+            scanComponentCount = params[0];
+            slices->fHeaderSize = offset + length;
+            break;
+        } else if (marker >= kMarkerRestart0 && marker <= kJpegMarkerEndOfImage) {
+            // These stand alone, and are not expected before the scan.
+            return nullptr;
+        }
+        offset += length;
+    }
+
+    // An image with one scan must have all of its components in that scan. A height of zero means
+    // the height is defined by a DNL marker after the scan.
+    if (!componentCount || scanComponentCount != componentCount || slices->fRestartInterval == 0 ||
+        slices->fWidth == 0 || slices->fHeight == 0) {
+        return nullptr;
+    }
+
+    // A scan of one component is not interleaved, and its MCU is a single block.
+    int mcuWidth = 8;
+    slices->fMCUHeight = 8;
+    if (componentCount > 1) {
+        mcuWidth = 8 * maxHSamp;
+        slices->fMCUHeight = 8 * slices->fMaxVSamp;
+    } else {
+        slices->fMinVSamp = slices->fMaxVSamp;
+    }
+    slices->fMCUsPerRow = (slices->fWidth + mcuWidth - 1) / mcuWidth;
+    const int64_t mcuRows = (slices->fHeight + slices->fMCUHeight - 1) / slices->fMCUHeight;
+    const int64_t mcuCount = mcuRows * slices->fMCUsPerRow;
+    const int64_t intervalCount =
+            (mcuCount + slices->fRestartInterval - 1) / slices->fRestartInterval;
+
+    // Find the restart markers in the entropy-coded data. Any 0xFF in the data itself is followed
+    // by 0x00, and restart markers must count up from RST0 to RST7 and then wrap around.
+    size_t start = slices->fHeaderSize;
+    offset = start;
+    while (true) {
+        const void* ff = memchr(data + offset, 0xFF, size - offset);
+        if (!ff) {
+            // The image is truncated.
+            return nullptr;
+        }
+        const size_t end = static_cast<const uint8_t*>(ff) - data;
+        size_t markerOffset = end;
+        while (markerOffset < size && data[markerOffset] == 0xFF) {
+            markerOffset++;
+        }
+        if (markerOffset >= size) {
+            return nullptr;
+        }
+        const uint8_t marker = data[markerOffset];
+        if (marker == 0x00) {
+            offset = markerOffset + 1;
+            continue;
+        }
+        if (marker == kJpegMarkerEndOfImage) {
+            slices->fIntervals.push_back({start, end});
+            break;
+        }
+        if (marker < kMarkerRestart0 || marker > kMarkerRestart7 ||
+            marker != kMarkerRestart0 + (slices->fIntervals.size() & 7)) {
+            // Another scan, a DNL marker or a corrupt stream.
+            return nullptr;
+        }
+        slices->fIntervals.push_back({start, end});
+        if (SkToS64(slices->fIntervals.size()) >= intervalCount) {
+            return nullptr;
+        }
+        start = markerOffset + 1;
+        offset = start;
+    }
+    if (SkToS64(slices->fIntervals.size()) != intervalCount) {
+        return nullptr;
+    }
+
+    for (int i = 0; i < SkToInt(slices->fIntervals.size()); ++i) {
+        if ((int64_t)i * slices->fRestartInterval % slices->fMCUsPerRow == 0) {
+            slices->fBoundaries.push_back(i);
+        }
+    }
+    slices->fBoundaries.push_back(SkToInt(slices->fIntervals.size()));
+    if (slices->boundaryCount() < 3) {
+        // There is no way to make more than one slice.
+        return nullptr;
+    }
+    return slices;
+}
+
+int SkJpegRestartSlices::boundaryRow(int index) const {
+    SkASSERT(index >= 0 && index < this->boundaryCount());
+    const int interval = fBoundaries[index];
+    if (interval == SkToInt(fIntervals.size())) {
+        return fHeight;
+    }
+    const int64_t mcuRow = (int64_t)interval * fRestartInterval / fMCUsPerRow;
+    return SkToInt(std::min<int64_t>(fHeight, mcuRow * fMCUHeight));
+}
+
+sk_sp<SkData> SkJpegRestartSlices::makeSlice(int first, int last) const {
+    SkASSERT(first >= 0 && first < last && last < this->boundaryCount());
+    const int firstInterval = fBoundaries[first];
+    const int lastInterval = fBoundaries[last];
+    const int height = this->boundaryRow(last) - this->boundaryRow(first);
+
+    // The headers, the intervals with a restart marker between each, and the end of image marker.
+    size_t size = fHeaderSize + kJpegMarkerCodeSize * (lastInterval - firstInterval);
+    for (int i = firstInterval; i < lastInterval; ++i) {
+        size += fIntervals[i].fEnd - fIntervals[i].fStart;
+    }
+    sk_sp<SkData> slice = SkData::MakeUninitialized(size);
+    uint8_t* dst = static_cast<uint8_t*>(slice->writable_data());
+
+    memcpy(dst, fData, fHeaderSize);
+    dst[fHeightOffset] = static_cast<uint8_t>(height >> 8);
+    dst[fHeightOffset + 1] = static_cast<uint8_t>(height);
+    dst += fHeaderSize;
+
+    for (int i = firstInterval; i < lastInterval; ++i) {
+        const Interval& interval = fIntervals[i];
+        memcpy(dst, fData + interval.fStart, interval.fEnd - interval.fStart);
+        dst += interval.fEnd - interval.fStart;
+        // The decoder expects the restart markers of each slice to start over at RST0.
+        *dst++ = 0xFF;
+        *dst++ = i + 1 < lastInterval ? kMarkerRestart0 + ((i - firstInterval) & 7)
+                                      : kJpegMarkerEndOfImage;
+    }
+    SkASSERT(dst == slice->bytes() + size);
+    return slice;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkJpegRestartSlices_codec_DEFINED
+#define SkJpegRestartSlices_codec_DEFINED
+
+#include "include/core/SkRefCnt.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SkData;
+
+/*
+ * Splits a sequential, single scan JPEG at its restart markers. The entropy-coded data between two
+ * restart markers (a restart interval) can be decoded without the data before it, so a run of
+ * intervals that starts and ends on MCU row boundaries can be wrapped in a copy of the image's
+ * headers and decoded on its own, as an image of just those rows.
+ *
+ * A boundary is the start of an interval that begins an MCU row, or the end of the image. Slices
+ * are made between two boundaries.
+ */
+class SkJpegRestartSlices {
+public:
+    /*
+     * Returns nullptr if |data| is not a complete sequential JPEG with one scan and restart
+     * intervals that line up with MCU rows at least once. Does not copy |data|, which must outlive
+     * the returned object.
+     */
+    static std::unique_ptr<SkJpegRestartSlices> Make(const uint8_t* data, size_t size);
+
+    int width() const { return fWidth; }
+    int height() const { return fHeight; }
+
+    // The number of boundaries, including the start and the end of the image.
+    int boundaryCount() const { return static_cast<int>(fBoundaries.size()); }
+
+    // The first pixel row after boundary |index|.
+    int boundaryRow(int index) const;
+
+    // True if upsampling the chroma planes reads rows of the MCU rows above and below, so that
+    // the edge rows of a slice differ from the same rows of the whole image.
+    bool needsVerticalContext() const { return fMinVSamp != fMaxVSamp; }
+
+    // The number of pixel rows in an MCU row.
+    int mcuHeight() const { return fMCUHeight; }
+
+    /*
+     * Returns a JPEG of the rows between boundaries |first| and |last|, with the same headers
+     * as the whole image.
+     */
+    sk_sp<SkData> makeSlice(int first, int last) const;
+
+private:
+    SkJpegRestartSlices() = default;
+
+    const uint8_t* fData = nullptr;
+
+    // Everything up to the end of the start of scan segment, which is copied into each slice.
+    size_t fHeaderSize = 0;
+    // The offset of the image height in the start of frame segment.
+    size_t fHeightOffset = 0;
+
+    // The entropy-coded data of each restart interval, without the restart markers.
+    struct Interval {
+        size_t fStart;
+        size_t fEnd;
+    };
+    std::vector<Interval> fIntervals;
+
+    // The index of the first interval after each boundary, which is fIntervals.size() for the
+    // end of the image.
+    std::vector<int> fBoundaries;
+
+    int fWidth = 0;
+    int fHeight = 0;
+    int fMCUHeight = 0;
+    int fMCUsPerRow = 0;
+    int fRestartInterval = 0;
+    int fMinVSamp = 0;
+    int fMaxVSamp = 0;
+};
+
+#endif
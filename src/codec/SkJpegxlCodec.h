@@ -57,7 +57,7 @@ protected:
                             SkYUVAPixmapInfo*) const override; */
 
     /* TODO(eustas): add support for transcoded JPEG images? */
-    /* Result onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override; */
+    /* Result onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps, const Options&) override; */
 
     /* TODO(eustas): implement when cropped output is supported. */
     /* bool onGetValidSubset(SkIRect* desiredSubset) const override; */
@@ -37,6 +37,10 @@
 #include <png.h>
 #include <pngconf.h>
 
+#if defined(SK_CODEC_DECODES_PNG_WITH_WUFFS)
+#include "src/codec/SkWuffsPngCodec.h"
+#endif
+
 using namespace skia_private;
 
 class SkSampler;
@@ -150,6 +154,22 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
 
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
         SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
+    // Streams held in memory, including files opened with SkStream::MakeFromFile (which maps
+    // them), are handed to libpng in place rather than copied into the buffer.
+    if (const void* base = stream->getMemoryBase();
+            base && stream->hasPosition() && stream->hasLength()) {
+        const size_t position = stream->getPosition();
+        const size_t available = stream->getLength() - std::min(position, stream->getLength());
+        const size_t bytesToProcess = std::min(length, available);
+        // Consume the bytes before libpng sees them, as if they had been read. libpng may
+        // longjmp out once it has decoded the rows it needs.
+        stream->skip(bytesToProcess);
+        png_process_data(png_ptr, info_ptr,
+                         static_cast<png_bytep>(const_cast<void*>(base)) + position,
+                         bytesToProcess);
+        return bytesToProcess == length;
+    }
+
     while (length > 0) {
         const size_t bytesToProcess = std::min(bufferSize, length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
@@ -641,6 +661,10 @@ public:
         decoder->interlacedRowCallback(row, rowNum, pass);
     }
 
+protected:
+    // Each pass rewrites every row decoded so far.
+    bool onIncrementalDecodeRewritesRows() const override { return true; }
+
 private:
     const int               fNumberPasses;
     int                     fFirstRow;
@@ -1246,7 +1270,11 @@ std::unique_ptr<SkCodec> Decode(std::unique_ptr<SkStream> stream,
     if (ctx) {
         chunkReader = static_cast<SkPngChunkReader*>(ctx);
     }
+#if defined(SK_CODEC_DECODES_PNG_WITH_WUFFS)
+    return SkWuffsPngCodec::MakeFromStream(std::move(stream), outResult, chunkReader);
+#else
     return SkPngCodec::MakeFromStream(std::move(stream), outResult, chunkReader);
+#endif
 }
 
 std::unique_ptr<SkCodec> Decode(sk_sp<SkData> data,
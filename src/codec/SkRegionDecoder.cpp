@@ -0,0 +1,217 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkRegionDecoder.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTo.h"
+#include "src/codec/SkSampler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+// A cropped JPEG decode upsamples the chroma planes at the edges of the crop as if they were the
+// edges of the image. Decoding this many more columns on each side keeps the edge columns of a
+// region the same as in the whole image.
+static constexpr int kContextColumns = 16;
+
+// A scanline decode of one column of regions, paused before fNextRow.
+struct SkRegionDecoder::Checkpoint {
+    std::unique_ptr<SkCodec>   fCodec;
+    // The info the decode was started with, which is as wide as the image.
+    SkImageInfo                fInfo;
+    // The columns of the regions this decodes.
+    int                        fLeft;
+    int                        fRight;
+    // The columns decoded, including context. SkCodec keeps a pointer to this for the whole
+    // decode.
+    SkIRect                    fSubset;
+    // Holds a row of fSubset when it is wider than the regions.
+    std::unique_ptr<uint8_t[]> fRow;
+    // An image row, which is not a row of the codec if it only decodes the bottom of the image.
+    int                        fNextRow;
+    uint64_t                   fLastUse = 0;
+};
+
+std::unique_ptr<SkRegionDecoder> SkRegionDecoder::Make(sk_sp<SkData> data, int maxCheckpoints) {
+    if (!data || maxCheckpoints < 1) {
+        return nullptr;
+    }
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec || codec->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+        return nullptr;
+    }
+    return std::unique_ptr<SkRegionDecoder>(
+            new SkRegionDecoder(std::move(data), std::move(codec), maxCheckpoints));
+}
+
+SkRegionDecoder::SkRegionDecoder(sk_sp<SkData> data,
+                                 std::unique_ptr<SkCodec> codec,
+                                 int maxCheckpoints)
+        : fData(std::move(data))
+        , fCodec(std::move(codec))
+        , fInfo(fCodec->getInfo())
+        , fMaxCheckpoints(maxCheckpoints) {}
+
+SkRegionDecoder::~SkRegionDecoder() = default;
+
+SkRegionDecoder::Checkpoint* SkRegionDecoder::findCheckpoint(const SkImageInfo& info,
+                                                             const SkIRect& region) const {
+    Checkpoint* best = nullptr;
+    for (const std::unique_ptr<Checkpoint>& checkpoint : fCheckpoints) {
+        if (checkpoint->fLeft != region.left() || checkpoint->fRight != region.right() ||
+            checkpoint->fNextRow > region.top() ||
+            checkpoint->fInfo.colorType() != info.colorType() ||
+            checkpoint->fInfo.alphaType() != info.alphaType() ||
+            !SkColorSpace::Equals(checkpoint->fInfo.colorSpace(), info.colorSpace())) {
+            continue;
+        }
+        if (!best || checkpoint->fNextRow > best->fNextRow) {
+            best = checkpoint.get();
+        }
+    }
+    return best;
+}
+
+SkRegionDecoder::Checkpoint* SkRegionDecoder::startCheckpoint(std::unique_ptr<SkCodec> codec,
+                                                              int startRow,
+                                                              const SkImageInfo& info,
+                                                              const SkIRect& region,
+                                                              SkCodec::Result* result) {
+    auto checkpoint = std::make_unique<Checkpoint>();
+    checkpoint->fInfo = info.makeDimensions(codec->dimensions());
+    checkpoint->fLeft = region.left();
+    checkpoint->fRight = region.right();
+    checkpoint->fSubset = SkIRect::MakeLTRB(std::max(region.left() - kContextColumns, 0),
+                                            0,
+                                            std::min(region.right() + kContextColumns,
+                                                     info.width()),
+                                            codec->dimensions().height());
+    if (checkpoint->fSubset.width() != region.width()) {
+        checkpoint->fRow.reset(new uint8_t[checkpoint->fSubset.width() * info.bytesPerPixel()]);
+    }
+    checkpoint->fNextRow = startRow;
+
+    SkCodec::Options options;
+    options.fSubset = &checkpoint->fSubset;
+    *result = codec->startScanlineDecode(checkpoint->fInfo, &options);
+    if (*result != SkCodec::kSuccess) {
+        return nullptr;
+    }
+    checkpoint->fCodec = std::move(codec);
+
+    if (SkToInt(fCheckpoints.size()) >= fMaxCheckpoints) {
+        auto oldest = std::min_element(fCheckpoints.begin(), fCheckpoints.end(),
+                                       [](const auto& a, const auto& b) {
+                                           return a->fLastUse < b->fLastUse;
+                                       });
+        fCheckpoints.erase(oldest);
+    }
+    fCheckpoints.push_back(std::move(checkpoint));
+    return fCheckpoints.back().get();
+}
+
+void SkRegionDecoder::removeCheckpoint(Checkpoint* checkpoint) {
+    fCheckpoints.erase(std::find_if(fCheckpoints.begin(), fCheckpoints.end(),
+                                    [checkpoint](const auto& c) { return c.get() == checkpoint; }));
+}
+
+SkCodec::Result SkRegionDecoder::decodeFromTop(const SkPixmap& dst, const SkIRect& region) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+    if (!codec) {
+        return SkCodec::kInternalError;
+    }
+    SkCodec::Options options;
+    options.fSubset = &region;
+    const SkImageInfo info = dst.info().makeDimensions(fInfo.dimensions());
+    SkCodec::Result result =
+            codec->startIncrementalDecode(info, dst.writable_addr(), dst.rowBytes(), &options);
+    if (result != SkCodec::kSuccess) {
+        return result;
+    }
+    int rowsDecoded = 0;
+    result = codec->incrementalDecode(&rowsDecoded);
+    if (result == SkCodec::kIncompleteInput || result == SkCodec::kErrorInInput) {
+        SkSampler::Fill(dst.info().makeWH(dst.width(), dst.height() - rowsDecoded),
+                        dst.writable_addr(0, rowsDecoded), dst.rowBytes(),
+                        SkCodec::kNo_ZeroInitialized);
+    }
+    return result;
+}
+
+SkCodec::Result SkRegionDecoder::decodeRegion(const SkPixmap& dst, const SkIRect& region) {
+    if (region.isEmpty() || !SkIRect::MakeSize(fInfo.dimensions()).contains(region) ||
+        dst.dimensions() != region.size() || !dst.addr()) {
+        return SkCodec::kInvalidParameters;
+    }
+    if (!fScanlineDecodes) {
+        return this->decodeFromTop(dst, region);
+    }
+    const SkImageInfo info = dst.info().makeDimensions(fInfo.dimensions());
+
+    Checkpoint* checkpoint = this->findCheckpoint(info, region);
+    if (!checkpoint || checkpoint->fNextRow < region.top()) {
+        // Starting part way down the image may skip fewer rows than resuming.
+        int startRow = 0;
+        std::unique_ptr<SkCodec> codec = fCodec->onMakeCodecFromRow(region.top(), &startRow);
+        if (codec && checkpoint && startRow <= checkpoint->fNextRow) {
+            codec.reset();
+        }
+        if (!codec && !checkpoint) {
+            codec = SkCodec::MakeFromData(fData);
+            startRow = 0;
+            if (!codec) {
+                return SkCodec::kInternalError;
+            }
+        }
+        if (codec) {
+            const bool fromTop = startRow == 0;
+            SkCodec::Result result;
+            Checkpoint* started =
+                    this->startCheckpoint(std::move(codec), startRow, info, region, &result);
+            if (started) {
+                checkpoint = started;
+            } else if (!checkpoint) {
+                if (fromTop && result == SkCodec::kUnimplemented) {
+                    // e.g. PNG, which is decoded by libpng's progressive reader, and can't be
+                    // paused between rows.
+                    fScanlineDecodes = false;
+                    return this->decodeFromTop(dst, region);
+                }
+                return result;
+            }
+        }
+    }
+    checkpoint->fLastUse = ++fUseCount;
+
+    SkCodec* codec = checkpoint->fCodec.get();
+    const int skip = region.top() - checkpoint->fNextRow;
+    bool succeeded = skip == 0 || codec->skipScanlines(skip);
+    // On failure, getScanlines() still fills the rows it could not decode.
+    if (!checkpoint->fRow) {
+        succeeded &= region.height() ==
+                     codec->getScanlines(dst.writable_addr(), region.height(), dst.rowBytes());
+    } else {
+        const size_t offset =
+                (region.left() - checkpoint->fSubset.left()) * dst.info().bytesPerPixel();
+        for (int y = 0; y < region.height(); ++y) {
+            succeeded &= 1 == codec->getScanlines(checkpoint->fRow.get(), 1, 0);
+            memcpy(dst.writable_addr(0, y), checkpoint->fRow.get() + offset,
+                   dst.info().minRowBytes());
+        }
+    }
+    checkpoint->fNextRow = region.bottom();
+    if (!succeeded) {
+        this->removeCheckpoint(checkpoint);
+        return SkCodec::kIncompleteInput;
+    }
+    return SkCodec::kSuccess;
+}
@@ -0,0 +1,708 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkWuffsPngCodec.h"
+
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkEncodedImageFormat.h"
+#include "include/codec/SkPngChunkReader.h"
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkEncodedInfo.h"
+#include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkTo.h"
+#include "modules/skcms/skcms.h"
+#include "src/codec/SkCodecPriv.h"
+#include "src/codec/SkPngCodec.h"
+#include "src/codec/SkPngPriv.h"
+#include "src/codec/SkSampler.h"
+#include "src/codec/SkWuffsPriv.h"
+#include "src/core/SkConvertPixels.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// The PNG signature and the IHDR chunk, which must come first.
+constexpr size_t kSignatureAndIHDRLength = 8 + 8 + 13 + 4;
+
+// libpng's default limit on the size of a chunk that is read into memory
+// (PNG_USER_CHUNK_MALLOC_MAX), which also limits the inflated size of an iCCP chunk.
+constexpr size_t kMaxChunkLength = 8000000;
+
+enum PngColorType : uint8_t {
+    kGray_PngColorType      = 0,
+    kRGB_PngColorType       = 2,
+    kPalette_PngColorType   = 3,
+    kGrayAlpha_PngColorType = 4,
+    kRGBA_PngColorType      = 6,
+};
+
+uint32_t read_u32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+bool is_chunk(const char* tag, const char* name) { return 0 == memcmp(tag, name, 4); }
+
+// The chunks that libpng reads itself. SkPngCodec passes all others to the SkPngChunkReader.
+bool is_known_chunk(const char* tag) {
+    static constexpr const char* kKnown[] = {
+            "IHDR", "PLTE", "IDAT", "IEND", "bKGD", "cHRM", "eXIf", "gAMA", "hIST", "iCCP",
+            "iTXt", "oFFs", "pCAL", "pHYs", "sBIT", "sCAL", "sPLT", "sRGB", "tEXt", "tIME",
+            "tRNS", "zTXt",
+    };
+    for (const char* known : kKnown) {
+        if (is_chunk(tag, known)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// What SkPngCodec gets from libpng before the first IDAT chunk.
+struct PngHeader {
+    uint32_t      fWidth;
+    uint32_t      fHeight;
+    uint8_t       fBitDepth;
+    uint8_t       fColorType;
+    bool          fInterlaced;
+    bool          fHasTRNS = false;
+    bool          fHasSRGB = false;
+    // The gAMA chunk stores 100000 / gamma.
+    uint32_t      fGamma = 0;
+    bool          fHasCHRM = false;
+    // White, red, green and blue x and y, times 100000.
+    uint32_t      fCHRM[8];
+    uint8_t       fSigBits[4] = {0, 0, 0, 0};
+    bool          fHasSBIT = false;
+    sk_sp<SkData> fICC;
+};
+
+bool valid_bit_depth(uint8_t colorType, uint8_t bitDepth) {
+    switch (colorType) {
+        case kGray_PngColorType:
+            return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 ||
+                   bitDepth == 16;
+        case kPalette_PngColorType:
+            return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+        case kRGB_PngColorType:
+        case kGrayAlpha_PngColorType:
+        case kRGBA_PngColorType:
+            return bitDepth == 8 || bitDepth == 16;
+        default:
+            return false;
+    }
+}
+
+SkCodec::Result read_ihdr(SkStream* stream, PngHeader* header) {
+    uint8_t bytes[kSignatureAndIHDRLength];
+    if (stream->read(bytes, sizeof(bytes)) != sizeof(bytes)) {
+        return SkCodec::kIncompleteInput;
+    }
+    const uint8_t* ihdr = bytes + 8;
+    if (read_u32(ihdr) != 13 || !is_chunk(reinterpret_cast<const char*>(ihdr + 4), "IHDR")) {
+        return SkCodec::kInvalidInput;
+    }
+    header->fWidth = read_u32(ihdr + 8);
+    header->fHeight = read_u32(ihdr + 12);
+    header->fBitDepth = ihdr[16];
+    header->fColorType = ihdr[17];
+    header->fInterlaced = ihdr[20] == 1;
+    if (header->fWidth == 0 || header->fWidth > INT_MAX || header->fHeight == 0 ||
+        header->fHeight > INT_MAX || !valid_bit_depth(header->fColorType, header->fBitDepth) ||
+        ihdr[20] > 1) {
+        return SkCodec::kInvalidInput;
+    }
+    return SkCodec::kSuccess;
+}
+
+// Returns nullptr if |src| is not a zlib stream that inflates to at most kMaxChunkLength bytes.
+sk_sp<SkData> inflate(const uint8_t* src, size_t length) {
+    std::unique_ptr<wuffs_zlib__decoder, decltype(&sk_free)> decoder(
+            reinterpret_cast<wuffs_zlib__decoder*>(
+                    sk_malloc_canfail(sizeof__wuffs_zlib__decoder())),
+            &sk_free);
+    if (!decoder ||
+        decoder->initialize(sizeof__wuffs_zlib__decoder(), WUFFS_VERSION,
+                            SK_WUFFS_INITIALIZE_FLAGS)
+                .repr != nullptr) {
+        return nullptr;
+    }
+    std::vector<uint8_t> workbuf(decoder->workbuf_len().max_incl);
+    wuffs_base__io_buffer in =
+            wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(const_cast<uint8_t*>(src), length),
+                                       wuffs_base__make_io_buffer_meta(length, 0, 0, true));
+    std::vector<uint8_t> out(std::min(std::max<size_t>(length * 4, 1024), kMaxChunkLength));
+    wuffs_base__io_buffer outBuffer =
+            wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(out.data(), out.size()),
+                                       wuffs_base__empty_io_buffer_meta());
+    while (true) {
+        wuffs_base__status status = decoder->transform_io(
+                &outBuffer, &in, wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()));
+        if (status.repr == nullptr) {
+            break;
+        }
+        if (status.repr != wuffs_base__suspension__short_write || out.size() >= kMaxChunkLength) {
+            SkCodecPrintf("inflate iCCP: %s", status.message());
+            return nullptr;
+        }
+        out.resize(std::min(out.size() * 2, kMaxChunkLength));
+        outBuffer.data = wuffs_base__make_slice_u8(out.data(), out.size());
+    }
+    return SkData::MakeWithCopy(out.data(), outBuffer.meta.wi);
+}
+
+// Reads the chunks after IHDR up to the first IDAT chunk, passing the ones that libpng does not
+// know to |chunkReader|, and keeping the ones that SkPngCodec uses for the encoded info.
+SkCodec::Result read_chunks(SkStream* stream, SkPngChunkReader* chunkReader, PngHeader* header) {
+    std::vector<uint8_t> data;
+    while (true) {
+        uint8_t chunkHeader[8];
+        if (stream->read(chunkHeader, sizeof(chunkHeader)) != sizeof(chunkHeader)) {
+            return SkCodec::kIncompleteInput;
+        }
+        const size_t length = read_u32(chunkHeader);
+        const char tag[5] = {static_cast<char>(chunkHeader[4]), static_cast<char>(chunkHeader[5]),
+                             static_cast<char>(chunkHeader[6]), static_cast<char>(chunkHeader[7]),
+                             '\0'};
+        if (length > INT32_MAX || is_chunk(tag, "IEND")) {
+            return SkCodec::kInvalidInput;
+        }
+        if (is_chunk(tag, "IDAT")) {
+            return SkCodec::kSuccess;
+        }
+
+        const bool unknown = !is_known_chunk(tag);
+        if (!(unknown && chunkReader) && !is_chunk(tag, "tRNS") && !is_chunk(tag, "sBIT") &&
+            !is_chunk(tag, "iCCP") && !is_chunk(tag, "sRGB") && !is_chunk(tag, "gAMA") &&
+            !is_chunk(tag, "cHRM")) {
+            // Skip the data and the CRC.
+            if (stream->skip(length + 4) != length + 4) {
+                return SkCodec::kIncompleteInput;
+            }
+            continue;
+        }
+        if (length > kMaxChunkLength) {
+            return SkCodec::kInvalidInput;
+        }
+        data.resize(length);
+        if (stream->read(data.data(), length) != length || stream->skip(4) != 4) {
+            return SkCodec::kIncompleteInput;
+        }
+
+        if (unknown) {
+            if (!chunkReader->readChunk(tag, data.data(), length)) {
+                return SkCodec::kInvalidInput;
+            }
+        } else if (is_chunk(tag, "tRNS")) {
+            // Like libpng, ignore tRNS in images that have an alpha channel.
+            header->fHasTRNS = length > 0 && header->fColorType != kGrayAlpha_PngColorType &&
+                               header->fColorType != kRGBA_PngColorType;
+        } else if (is_chunk(tag, "sBIT")) {
+            header->fHasSBIT = length >= 1 && length <= 4;
+            if (header->fHasSBIT) {
+                memcpy(header->fSigBits, data.data(), length);
+            }
+        } else if (is_chunk(tag, "iCCP")) {
+            // A profile name of 1 to 79 bytes, a null, the compression method (0 is zlib) and the
+            // compressed profile.
+            const uint8_t* begin = data.data();
+            const uint8_t* end = begin + length;
+            const uint8_t* nameEnd = std::find(begin, begin + std::min<size_t>(length, 80), 0);
+            if (nameEnd != begin && end - nameEnd >= 2 && nameEnd[1] == 0) {
+                header->fICC = inflate(nameEnd + 2, end - nameEnd - 2);
+            }
+        } else if (is_chunk(tag, "sRGB")) {
+            header->fHasSRGB = length == 1;
+        } else if (is_chunk(tag, "gAMA")) {
+            header->fGamma = length == 4 ? read_u32(data.data()) : 0;
+        } else if (is_chunk(tag, "cHRM")) {
+            header->fHasCHRM = length == 32;
+            for (int i = 0; header->fHasCHRM && i < 8; ++i) {
+                header->fCHRM[i] = read_u32(data.data() + 4 * i);
+            }
+        }
+    }
+}
+
+// Matches read_color_profile() in SkPngCodec.cpp.
+std::unique_ptr<SkEncodedInfo::ICCProfile> read_color_profile(const PngHeader& header) {
+    if (header.fICC) {
+        if (auto profile = SkEncodedInfo::ICCProfile::Make(header.fICC)) {
+            return profile;
+        }
+    }
+    if (header.fHasSRGB) {
+        return nullptr;
+    }
+
+    skcms_Matrix3x3 toXYZD50 = skcms_sRGB_profile()->toXYZD50;
+    if (header.fHasCHRM) {
+        float chrm[8];
+        for (int i = 0; i < 8; ++i) {
+            chrm[i] = header.fCHRM[i] * 0.00001f;
+        }
+        skcms_Matrix3x3 tmp;
+        if (skcms_PrimariesToXYZD50(chrm[2], chrm[3], chrm[4], chrm[5], chrm[6], chrm[7],
+                                    chrm[0], chrm[1], &tmp)) {
+            toXYZD50 = tmp;
+        }
+    }
+
+    skcms_TransferFunction fn;
+    if (header.fGamma) {
+        fn.a = 1.0f;
+        fn.b = fn.c = fn.d = fn.e = fn.f = 0.0f;
+        fn.g = 1.0f / (header.fGamma * 0.00001f);
+    } else {
+        fn = *skcms_sRGB_TransferFunction();
+    }
+
+    skcms_ICCProfile skcmsProfile;
+    skcms_Init(&skcmsProfile);
+    skcms_SetTransferFunction(&skcmsProfile, &fn);
+    skcms_SetXYZD50(&skcmsProfile, &toXYZD50);
+    return SkEncodedInfo::ICCProfile::Make(skcmsProfile);
+}
+
+// Matches AutoCleanPng::infoCallback() in SkPngCodec.cpp, except that palette images are
+// reported as the RGB or RGBA that Wuffs expands them to, and that all images are 8 bit.
+SkEncodedInfo make_encoded_info(const PngHeader& header) {
+    SkEncodedInfo::Color color;
+    SkEncodedInfo::Alpha alpha;
+    switch (header.fColorType) {
+        case kGray_PngColorType:
+            color = header.fHasTRNS ? SkEncodedInfo::kGrayAlpha_Color : SkEncodedInfo::kGray_Color;
+            alpha = header.fHasTRNS ? SkEncodedInfo::kBinary_Alpha : SkEncodedInfo::kOpaque_Alpha;
+            break;
+        case kRGB_PngColorType:
+            if (header.fHasTRNS) {
+                color = SkEncodedInfo::kRGBA_Color;
+                alpha = SkEncodedInfo::kBinary_Alpha;
+            } else {
+                // Recommend a decode to 565 if the sBIT indicates 565.
+                const uint8_t* sigBits = header.fSigBits;
+                color = header.fHasSBIT && sigBits[0] == 5 && sigBits[1] == 6 && sigBits[2] == 5
+                                ? SkEncodedInfo::k565_Color
+                                : SkEncodedInfo::kRGB_Color;
+                alpha = SkEncodedInfo::kOpaque_Alpha;
+            }
+            break;
+        case kPalette_PngColorType:
+            color = header.fHasTRNS ? SkEncodedInfo::kRGBA_Color : SkEncodedInfo::kRGB_Color;
+            alpha = header.fHasTRNS ? SkEncodedInfo::kUnpremul_Alpha
+                                    : SkEncodedInfo::kOpaque_Alpha;
+            break;
+        case kGrayAlpha_PngColorType:
+            color = header.fHasSBIT && header.fSigBits[0] == kGraySigBit_GrayAlphaIsJustAlpha &&
+                                    header.fSigBits[1] == 8
+                            ? SkEncodedInfo::kXAlpha_Color
+                            : SkEncodedInfo::kGrayAlpha_Color;
+            alpha = SkEncodedInfo::kUnpremul_Alpha;
+            break;
+        default:
+            SkASSERT(header.fColorType == kRGBA_PngColorType);
+            color = SkEncodedInfo::kRGBA_Color;
+            alpha = SkEncodedInfo::kUnpremul_Alpha;
+            break;
+    }
+
+    auto profile = read_color_profile(header);
+    if (profile) {
+        switch (profile->profile()->data_color_space) {
+            case skcms_Signature_CMYK:
+                profile = nullptr;
+                break;
+            case skcms_Signature_Gray:
+                if (SkEncodedInfo::kGray_Color != color &&
+                    SkEncodedInfo::kGrayAlpha_Color != color) {
+                    profile = nullptr;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return SkEncodedInfo::Make(header.fWidth, header.fHeight, color, alpha, 8, std::move(profile));
+}
+
+class WuffsPngCodec final : public SkCodec {
+public:
+    WuffsPngCodec(SkEncodedInfo&& encodedInfo, std::unique_ptr<SkStream> stream, bool interlaced)
+            : SkCodec(std::move(encodedInfo), skcms_PixelFormat_RGBA_8888, std::move(stream))
+            , fInterlaced(interlaced)
+            , fDecoder(nullptr, &sk_free)
+            , fWorkbuf(nullptr, &sk_free)
+            , fPixelBuffer(wuffs_base__null_pixel_buffer())
+            , fIntermediate(nullptr, &sk_free) {}
+
+protected:
+    SkEncodedImageFormat onGetEncodedFormat() const override { return SkEncodedImageFormat::kPNG; }
+
+    Result onGetPixels(const SkImageInfo& dstInfo,
+                       void* dst,
+                       size_t rowBytes,
+                       const Options& options,
+                       int* rowsDecoded) override {
+        Result result = this->startDecode(dstInfo, dst, rowBytes, options);
+        if (result != kSuccess) {
+            return result;
+        }
+        return this->decode(rowsDecoded);
+    }
+
+    Result onStartIncrementalDecode(const SkImageInfo& dstInfo,
+                                    void* dst,
+                                    size_t rowBytes,
+                                    const Options& options) override {
+        return this->startDecode(dstInfo, dst, rowBytes, options);
+    }
+
+    Result onIncrementalDecode(int* rowsDecoded) override { return this->decode(rowsDecoded); }
+
+    // An interlaced image's rows are decoded once per pass.
+    bool onIncrementalDecodeRewritesRows() const override { return true; }
+
+    SkSampler* getSampler(bool createIfNecessary) override {
+        if (!fSampler && createIfNecessary) {
+            fSampler = std::make_unique<Sampler>(fSubset.width());
+        }
+        return fSampler.get();
+    }
+
+private:
+    class Sampler final : public SkSampler {
+    public:
+        explicit Sampler(int width) : fWidth(width) {}
+
+        int sampleX() const { return fSampleX; }
+
+        int fillWidth() const override { return get_scaled_dimension(fWidth, fSampleX); }
+
+    private:
+        int onSetSampleX(int sampleX) override {
+            fSampleX = sampleX;
+            return this->fillWidth();
+        }
+
+        const int fWidth;
+        int       fSampleX = 1;
+    };
+
+    Result startDecode(const SkImageInfo& dstInfo,
+                       void* dst,
+                       size_t rowBytes,
+                       const Options& options) {
+        fDst = static_cast<uint8_t*>(dst);
+        fDstRowBytes = rowBytes;
+        fSubset = options.fSubset ? *options.fSubset : SkIRect::MakeSize(this->dimensions());
+        fSampler.reset();
+        fIntermediate.reset();
+        fSampledRow.reset();
+        fStarted = false;
+        fFilled = false;
+        fRowsConverted = 0;
+
+        // SkCodec rewinds the stream before every decode but the first, which starts where
+        // MakeFromStream left it.
+        if (!reset_buffer_in_place(&fIOBuffer, this->stream())) {
+            fIOBuffer = wuffs_base__make_io_buffer(
+                    wuffs_base__make_slice_u8(fBuffer, SK_WUFFS_CODEC_BUFFER_SIZE),
+                    wuffs_base__empty_io_buffer_meta());
+        }
+
+        if (!fDecoder) {
+            fDecoder.reset(reinterpret_cast<wuffs_png__decoder*>(
+                    sk_malloc_canfail(sizeof__wuffs_png__decoder())));
+            if (!fDecoder) {
+                return kInternalError;
+            }
+        }
+        wuffs_base__status status = fDecoder->initialize(
+                sizeof__wuffs_png__decoder(), WUFFS_VERSION, SK_WUFFS_INITIALIZE_FLAGS);
+        if (status.repr != nullptr) {
+            SkCodecPrintf("initialize: %s", status.message());
+            return kInternalError;
+        }
+
+        wuffs_base__image_config imageConfig;
+        while (true) {
+            status = fDecoder->decode_image_config(&imageConfig, &fIOBuffer);
+            if (status.repr == nullptr) {
+                break;
+            } else if (status.repr != wuffs_base__suspension__short_read) {
+                SkCodecPrintf("decode_image_config: %s", status.message());
+                return kErrorInInput;
+            } else if (!fill_buffer(&fIOBuffer, this->stream())) {
+                return kIncompleteInput;
+            }
+        }
+        if (imageConfig.pixcfg.width() != SkToU32(this->dimensions().width()) ||
+            imageConfig.pixcfg.height() != SkToU32(this->dimensions().height())) {
+            return kInvalidInput;
+        }
+        const uint64_t workbufLength = fDecoder->workbuf_len().max_incl;
+        if (workbufLength > SIZE_MAX) {
+            return kInternalError;
+        }
+        fWorkbufLength = SkToSizeT(workbufLength);
+        fWorkbuf.reset(static_cast<uint8_t*>(sk_malloc_canfail(fWorkbufLength)));
+        if (fWorkbufLength && !fWorkbuf) {
+            return kInternalError;
+        }
+        return kSuccess;
+    }
+
+    // Chooses between decoding into the destination and decoding into a buffer with rows to
+    // convert, which must wait for the first call to decode(), after SkSampledCodec has set up
+    // the sampler.
+    Result setUpPixelBuffer() {
+        const SkImageInfo& dstInfo = this->dstInfo();
+        const SkEncodedInfo& encodedInfo = this->getEncodedInfo();
+        const bool sampled = fSampler && (fSampler->sampleX() != 1 || fSampler->sampleY() != 1);
+        const bool opaque = encodedInfo.opaque();
+
+        uint32_t pixelFormat = WUFFS_BASE__PIXEL_FORMAT__INVALID;
+        if (!this->colorXform() && !sampled && fSubset == SkIRect::MakeSize(this->dimensions())) {
+            const bool premul = !opaque && dstInfo.alphaType() == kPremul_SkAlphaType;
+            switch (dstInfo.colorType()) {
+                case kRGBA_8888_SkColorType:
+                    pixelFormat = premul ? WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL
+                                         : WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL;
+                    break;
+                case kBGRA_8888_SkColorType:
+                    pixelFormat = premul ? WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL
+                                         : WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL;
+                    break;
+                case kGray_8_SkColorType:
+                    pixelFormat = WUFFS_BASE__PIXEL_FORMAT__Y;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        wuffs_base__table_u8 table;
+        if (pixelFormat != WUFFS_BASE__PIXEL_FORMAT__INVALID) {
+            table.ptr = fDst;
+            table.width = dstInfo.minRowBytes();
+            table.height = dstInfo.height();
+            table.stride = fDstRowBytes;
+            if (fInterlaced) {
+                // The passes before the last leave gaps between the rows that they write.
+                SkSampler::Fill(dstInfo, fDst, fDstRowBytes, this->options().fZeroInitialized);
+                fFilled = true;
+            }
+        } else {
+            // Gray images are converted from one byte per pixel, and everything else from
+            // unpremultiplied RGBA.
+            const bool gray = encodedInfo.color() == SkEncodedInfo::kGray_Color;
+            pixelFormat = gray ? WUFFS_BASE__PIXEL_FORMAT__Y
+                               : WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL;
+            this->setSrcXformFormat(gray ? skcms_PixelFormat_G_8 : skcms_PixelFormat_RGBA_8888);
+            fIntermediateInfo = SkImageInfo::Make(
+                    this->dimensions(),
+                    gray ? kGray_8_SkColorType : kRGBA_8888_SkColorType,
+                    opaque ? kOpaque_SkAlphaType : kUnpremul_SkAlphaType);
+            const size_t size = fIntermediateInfo.computeMinByteSize();
+            if (SkImageInfo::ByteSizeOverflowed(size)) {
+                return kInternalError;
+            }
+            // Zeroed, so that rows that are converted before they are fully decoded (such as
+            // those of an interlaced image) hold no uninitialized memory.
+            fIntermediate.reset(static_cast<uint8_t*>(sk_calloc_canfail(size)));
+            if (!fIntermediate) {
+                return kInternalError;
+            }
+            table.ptr = fIntermediate.get();
+            table.width = fIntermediateInfo.minRowBytes();
+            table.height = fIntermediateInfo.height();
+            table.stride = fIntermediateInfo.minRowBytes();
+        }
+
+        wuffs_base__pixel_config pixelConfig;
+        pixelConfig.set(pixelFormat, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+                        this->dimensions().width(), this->dimensions().height());
+        wuffs_base__status status = fPixelBuffer.set_from_table(&pixelConfig, table);
+        if (status.repr != nullptr) {
+            SkCodecPrintf("set_from_table: %s", status.message());
+            return kInternalError;
+        }
+        return kSuccess;
+    }
+
+    // Converts the rows [top, bottom) of the image from the intermediate buffer, if they are
+    // in the subset and not skipped by the sampler.
+    void convertRows(int top, int bottom) {
+        const int sampleX = fSampler ? fSampler->sampleX() : 1;
+        const int sampleY = fSampler ? fSampler->sampleY() : 1;
+        const int dstWidth = get_scaled_dimension(fSubset.width(), sampleX);
+        const size_t bytesPerPixel = fIntermediateInfo.bytesPerPixel();
+        const SkImageInfo dstRowInfo =
+                this->dstInfo().makeWH(dstWidth, 1).makeColorSpace(nullptr);
+        const SkImageInfo srcRowInfo = fIntermediateInfo.makeWH(dstWidth, 1);
+
+        top = std::max(top, fSubset.top());
+        bottom = std::min(bottom, fSubset.bottom());
+        for (int y = top; y < bottom; ++y) {
+            const int row = y - fSubset.top();
+            if (fSampler && !fSampler->rowNeeded(row)) {
+                continue;
+            }
+            const uint8_t* src = fIntermediate.get() + y * fIntermediateInfo.minRowBytes() +
+                                 fSubset.left() * bytesPerPixel;
+            if (sampleX != 1) {
+                if (!fSampledRow) {
+                    fSampledRow.reset(new uint8_t[dstWidth * bytesPerPixel]);
+                }
+                const uint8_t* first = src + get_start_coord(sampleX) * bytesPerPixel;
+                for (int x = 0; x < dstWidth; ++x) {
+                    memcpy(fSampledRow.get() + x * bytesPerPixel,
+                           first + x * sampleX * bytesPerPixel, bytesPerPixel);
+                }
+                src = fSampledRow.get();
+            }
+            void* dst = fDst + (row - get_start_coord(sampleY)) / sampleY * fDstRowBytes;
+            if (this->colorXform()) {
+                this->applyColorXform(dst, src, dstWidth);
+            } else {
+                SkAssertResult(SkConvertPixels(dstRowInfo, dst, fDstRowBytes, srcRowInfo, src,
+                                               fIntermediateInfo.minRowBytes()));
+            }
+        }
+    }
+
+    // The number of destination rows in the image's rows [0, bottom).
+    int dstRowsIn(int bottom) const {
+        const int sampleY = fSampler ? fSampler->sampleY() : 1;
+        const int rows = std::min(bottom, fSubset.bottom()) - fSubset.top();
+        const int start = get_start_coord(sampleY);
+        return rows <= start ? 0 : (rows - start - 1) / sampleY + 1;
+    }
+
+    Result decode(int* rowsDecoded) {
+        if (!fStarted) {
+            Result result = this->setUpPixelBuffer();
+            if (result != kSuccess) {
+                return result;
+            }
+            fStarted = true;
+        }
+
+        wuffs_base__status status;
+        while (true) {
+            status = fDecoder->decode_frame(&fPixelBuffer, &fIOBuffer,
+                                            WUFFS_BASE__PIXEL_BLEND__SRC,
+                                            wuffs_base__make_slice_u8(fWorkbuf.get(),
+                                                                      fWorkbufLength),
+                                            nullptr);
+            if (status.repr != wuffs_base__suspension__short_read ||
+                !fill_buffer(&fIOBuffer, this->stream())) {
+                break;
+            }
+        }
+
+        // The rows that Wuffs has written, which for an interlaced image may include rows that
+        // later passes will write again.
+        const int decodedBottom = status.repr == nullptr
+                                          ? this->dimensions().height()
+                                          : SkToInt(fDecoder->frame_dirty_rect().max_excl_y);
+        if (fIntermediate) {
+            // Each pass of an interlaced image writes rows throughout the image.
+            this->convertRows(fInterlaced ? 0 : fRowsConverted, decodedBottom);
+        }
+        fRowsConverted = decodedBottom;
+        *rowsDecoded = fFilled ? this->dstInfo().height() : this->dstRowsIn(decodedBottom);
+
+        if (status.repr == nullptr) {
+            fWorkbuf.reset();
+            fIntermediate.reset();
+            fSampledRow.reset();
+            return kSuccess;
+        }
+        if (status.repr == wuffs_base__suspension__short_read) {
+            return kIncompleteInput;
+        }
+        SkCodecPrintf("decode_frame: %s", status.message());
+        return kErrorInInput;
+    }
+
+    const bool                                              fInterlaced;
+    std::unique_ptr<wuffs_png__decoder, decltype(&sk_free)> fDecoder;
+    std::unique_ptr<uint8_t, decltype(&sk_free)>            fWorkbuf;
+    size_t                                                  fWorkbufLength = 0;
+    wuffs_base__io_buffer                                   fIOBuffer;
+    uint8_t                                                 fBuffer[SK_WUFFS_CODEC_BUFFER_SIZE];
+
+    // Set for each decode.
+    uint8_t*                                                fDst = nullptr;
+    size_t                                                  fDstRowBytes = 0;
+    SkIRect                                                 fSubset;
+    std::unique_ptr<Sampler>                                fSampler;
+    bool                                                    fStarted = false;
+    // Whether the destination was filled before decoding into it.
+    bool                                                    fFilled = false;
+    wuffs_base__pixel_buffer                                fPixelBuffer;
+    // The image, when it is decoded into a buffer rather than into the destination.
+    SkImageInfo                                             fIntermediateInfo;
+    std::unique_ptr<uint8_t, decltype(&sk_free)>            fIntermediate;
+    std::unique_ptr<uint8_t[]>                              fSampledRow;
+    int                                                     fRowsConverted = 0;
+};
+
+}  // namespace
+
+namespace SkWuffsPngCodec {
+
+std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream> stream,
+                                        SkCodec::Result* result,
+                                        SkPngChunkReader* chunkReader) {
+    SkASSERT(result);
+    if (!stream) {
+        *result = SkCodec::kInvalidInput;
+        return nullptr;
+    }
+
+    PngHeader header;
+    *result = read_ihdr(stream.get(), &header);
+    if (*result != SkCodec::kSuccess) {
+        return nullptr;
+    }
+    if (header.fBitDepth == 16 && header.fColorType != kGray_PngColorType &&
+        header.fColorType != kGrayAlpha_PngColorType) {
+        if (!stream->rewind()) {
+            *result = SkCodec::kCouldNotRewind;
+            return nullptr;
+        }
+        return SkPngCodec::MakeFromStream(std::move(stream), result, chunkReader);
+    }
+
+    *result = read_chunks(stream.get(), chunkReader, &header);
+    if (*result != SkCodec::kSuccess) {
+        return nullptr;
+    }
+    if (!stream->rewind()) {
+        *result = SkCodec::kCouldNotRewind;
+        return nullptr;
+    }
+    return std::make_unique<WuffsPngCodec>(make_encoded_info(header), std::move(stream),
+                                           header.fInterlaced);
+}
+
+}  // namespace SkWuffsPngCodec
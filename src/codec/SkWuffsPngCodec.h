@@ -0,0 +1,36 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkWuffsPngCodec_DEFINED
+#define SkWuffsPngCodec_DEFINED
+
+#include "include/codec/SkCodec.h"
+
+#include <memory>
+
+class SkPngChunkReader;
+class SkStream;
+
+namespace SkWuffsPngCodec {
+
+/**
+ *  Decodes a PNG with Wuffs instead of libpng. Used by SkPngDecoder in builds that define
+ *  SK_CODEC_DECODES_PNG_WITH_WUFFS.
+ *
+ *  The chunks before the image data are read here, so that the encoded info, the color profile
+ *  and the chunks passed to |chunkReader| match SkPngCodec's. Images with 16 bit color channels
+ *  are passed to SkPngCodec, which can decode them at full precision.
+ *
+ *  Assumes SkPngCodec::IsPng() returned true for the stream.
+ */
+std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream>,
+                                        SkCodec::Result*,
+                                        SkPngChunkReader* chunkReader = nullptr);
+
+}  // namespace SkWuffsPngCodec
+
+#endif  // SkWuffsPngCodec_DEFINED
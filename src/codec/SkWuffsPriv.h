@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkWuffsPriv_DEFINED
+#define SkWuffsPriv_DEFINED
+
+#include "include/core/SkStream.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Shared by the Wuffs GIF and PNG codecs.
+
+// Documentation on the Wuffs language and standard library (in general) and
+// its image decoding API (in particular) is at:
+//
+//  - https://github.com/google/wuffs/tree/master/doc
+//  - https://github.com/google/wuffs/blob/master/doc/std/image-decoders.md
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// As we have not #define'd WUFFS_IMPLEMENTATION, the #include here is
+// including a header file, even though that file name ends in ".c".
+#if defined(WUFFS_IMPLEMENTATION)
+#error "Skia's Wuffs codecs should not #define WUFFS_IMPLEMENTATION"
+#endif
+#include "wuffs-v0.3.c"  // NO_G3_REWRITE
+// Commit count 2514 is Wuffs 0.3.0-alpha.4.
+#if WUFFS_VERSION_BUILD_METADATA_COMMIT_COUNT < 2514
+#error "Wuffs version is too old. Upgrade to the latest version."
+#endif
+
+#define SK_WUFFS_CODEC_BUFFER_SIZE 4096
+
+// Configuring a Skia build with
+// SK_WUFFS_FAVORS_PERFORMANCE_OVER_ADDITIONAL_MEMORY_SAFETY can improve decode
+// performance by some fixed amount (independent of the image size), which can
+// be a noticeable proportional improvement if the input is relatively small.
+//
+// The Wuffs library is still memory-safe either way, in that there are no
+// out-of-bounds reads or writes, and the library endeavours not to read
+// uninitialized memory. There are just fewer compiler-enforced guarantees
+// against reading uninitialized memory. For more detail, see
+// https://github.com/google/wuffs/blob/master/doc/note/initialization.md#partial-zero-initialization
+#if defined(SK_WUFFS_FAVORS_PERFORMANCE_OVER_ADDITIONAL_MEMORY_SAFETY)
+#define SK_WUFFS_INITIALIZE_FLAGS WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED
+#else
+#define SK_WUFFS_INITIALIZE_FLAGS WUFFS_INITIALIZE__DEFAULT_OPTIONS
+#endif
+
+// Streams held in memory, including files opened with SkStream::MakeFromFile (which maps them),
+// are decoded in place: the io_buffer covers all of the stream's bytes, instead of holding a copy
+// of up to SK_WUFFS_CODEC_BUFFER_SIZE of them at a time. The memory may be read-only, so such a
+// buffer is never compacted or refilled.
+inline bool reset_buffer_in_place(wuffs_base__io_buffer* b, SkStream* s) {
+    const void* base = s->getMemoryBase();
+    if (!base || !s->hasPosition() || !s->hasLength() || s->getPosition() > s->getLength()) {
+        return false;
+    }
+    b->data = wuffs_base__make_slice_u8(static_cast<uint8_t*>(const_cast<void*>(base)),
+                                        s->getLength());
+    b->meta = wuffs_base__make_io_buffer_meta(s->getLength(), s->getPosition(), 0, false);
+    return true;
+}
+
+inline bool is_in_place(const wuffs_base__io_buffer* b, SkStream* s) {
+    return b->data.ptr && b->data.ptr == s->getMemoryBase();
+}
+
+inline bool fill_buffer(wuffs_base__io_buffer* b, SkStream* s) {
+    if (is_in_place(b, s)) {
+        // There is nothing more to read.
+        return false;
+    }
+    b->compact();
+    size_t num_read = s->read(b->data.ptr + b->meta.wi, b->data.len - b->meta.wi);
+    b->meta.wi += num_read;
+    // We hard-code false instead of s->isAtEnd(). In theory, Skia's
+    // SkStream::isAtEnd() method has the same semantics as Wuffs'
+    // wuffs_base__io_buffer_meta::closed field. Specifically, both are false
+    // when reading from a network socket when all bytes *available right now*
+    // have been read but there might be more later.
+    //
+    // However, SkStream is designed around synchronous I/O. The SkStream::read
+    // method does not take a callback and, per its documentation comments, a
+    // read request for N bytes should block until a full N bytes are
+    // available. In practice, Blink's SkStream subclass builds on top of async
+    // I/O and cannot afford to block. While it satisfies "the letter of the
+    // law", in terms of what the C++ compiler needs, it does not satisfy "the
+    // spirit of the law". Its read() can return short without blocking and its
+    // isAtEnd() can return false positives.
+    //
+    // When closed is true, Wuffs treats incomplete input as a fatal error
+    // instead of a recoverable "short read" suspension. We therefore hard-code
+    // false and return kIncompleteInput (instead of kErrorInInput) up the call
+    // stack even if the SkStream isAtEnd. The caller usually has more context
+    // (more than what's in the SkStream) to differentiate the two, like this:
+    // https://source.chromium.org/chromium/chromium/src/+/main:third_party/blink/renderer/platform/image-decoders/gif/gif_image_decoder.cc;l=115;drc=277dcc4d810ae4c0286d8af96d270ed9b686c5ff
+    b->meta.closed = false;
+    return num_read > 0;
+}
+
+inline bool seek_buffer(wuffs_base__io_buffer* b, SkStream* s, uint64_t pos) {
+    // Try to re-position the io_buffer's meta.ri read-index first, which is
+    // cheaper than seeking in the backing SkStream.
+    if ((pos >= b->meta.pos) && (pos - b->meta.pos <= b->meta.wi)) {
+        b->meta.ri = pos - b->meta.pos;
+        return true;
+    }
+    if (is_in_place(b, s)) {
+        return false;
+    }
+    // Seek in the backing SkStream.
+    if ((pos > SIZE_MAX) || (!s->seek(pos))) {
+        return false;
+    }
+    b->meta.wi = 0;
+    b->meta.ri = 0;
+    b->meta.pos = pos;
+    b->meta.closed = false;
+    return true;
+}
+
+#endif  // SkWuffsPriv_DEFINED
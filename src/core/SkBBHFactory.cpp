@@ -11,7 +11,7 @@
 #include "src/core/SkRTree.h"
 
 sk_sp<SkBBoxHierarchy> SkRTreeFactory::operator()() const {
-    return sk_make_sp<SkRTree>();
+    return sk_make_sp<SkRTree>(fBulkLoad);
 }
 
 void SkBBoxHierarchy::insert(const SkRect rects[], const Metadata[], int N) {
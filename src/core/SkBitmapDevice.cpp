@@ -27,8 +27,13 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTileMode.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkMathPriv.h"
 #include "src/base/SkTLazy.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkImagePriv.h"
@@ -38,6 +43,9 @@
 #include "src/image/SkImage_Base.h"
 #include "src/text/GlyphRun.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <utility>
 
 class SkVertices;
@@ -289,6 +297,109 @@ void SkBitmapDevice::replaceBitmapBackendForRasterSurface(const SkBitmap& bm) {
     fBitmap = bm;   // intent is to use bm's pixelRef (and rowbytes/config)
 }
 
+namespace {
+
+// Keeps the pixel memory of restored layers so that later layers of a similar size, in this frame
+// or the next, can reuse it instead of going back to calloc and free. Blocks are sized in classes
+// of a quarter of a power of two, so a block serves layers up to 25% smaller than the one it was
+// made for. The pool is shared by all raster canvases, and is capped in both block size and total
+// size so that a burst of large layers does not keep memory around.
+class LayerPixelPool {
+public:
+    static constexpr size_t kMaxBlockSize = 8 << 20;
+    static constexpr size_t kMaxPooledBytes = 32 << 20;
+
+    static LayerPixelPool* Get() {
+        static LayerPixelPool* pool = new LayerPixelPool;
+        return pool;
+    }
+
+    static size_t SizeClass(size_t size) {
+        SkASSERT(size > 0 && size <= kMaxBlockSize);
+        size_t step = std::max<size_t>(SkPrevPow2(SkToInt(size)) / 4, 4096);
+        return SkAlignTo(size, step);
+    }
+
+    // Returns a block of 'blockSize' bytes, with the first 'usedSize' bytes zeroed if 'zero' is
+    // true. New blocks come zeroed from calloc; reused ones only clear the bytes the layer covers.
+    void* acquire(size_t blockSize, size_t usedSize, bool zero) {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            for (int i = fFreeBlocks.size() - 1; i >= 0; --i) {
+                if (fFreeBlocks[i].fSize == blockSize) {
+                    void* pixels = fFreeBlocks[i].fPixels;
+                    fFreeBlocks.removeShuffle(i);
+                    fFreeBytes -= blockSize;
+                    if (zero) {
+                        memset(pixels, 0, usedSize);
+                    }
+                    return pixels;
+                }
+            }
+        }
+        return zero ? sk_calloc_canfail(blockSize) : sk_malloc_canfail(blockSize);
+    }
+
+    void release(void* pixels, size_t blockSize) {
+        SkAutoMutexExclusive lock(fMutex);
+        // Drop the oldest blocks first, since the newest ones match the layers drawn recently.
+        while (!fFreeBlocks.empty() && fFreeBytes + blockSize > kMaxPooledBytes) {
+            sk_free(fFreeBlocks.front().fPixels);
+            fFreeBytes -= fFreeBlocks.front().fSize;
+            fFreeBlocks.removeShuffle(0);
+        }
+        fFreeBlocks.push_back({pixels, blockSize});
+        fFreeBytes += blockSize;
+    }
+
+private:
+    struct Block {
+        void* fPixels;
+        size_t fSize;
+    };
+
+    SkMutex fMutex;
+    skia_private::TArray<Block> fFreeBlocks SK_GUARDED_BY(fMutex);
+    size_t fFreeBytes SK_GUARDED_BY(fMutex) = 0;
+};
+
+void release_layer_pixels(void* pixels, void* blockSize) {
+    LayerPixelPool::Get()->release(pixels, reinterpret_cast<uintptr_t>(blockSize));
+}
+
+// Returns a layer device whose pixels come from the LayerPixelPool, or nullptr if the layer is
+// not suitable for the pool and should be made by SkBitmapDevice::Create() instead.
+sk_sp<SkBitmapDevice> make_pooled_layer_device(const SkImageInfo& origInfo,
+                                               const SkSurfaceProps& surfaceProps) {
+    SkAlphaType newAT = origInfo.alphaType();
+    if (!valid_for_bitmap_device(origInfo, &newAT) ||
+        origInfo.colorType() == kUnknown_SkColorType) {
+        return nullptr;
+    }
+    const SkImageInfo info = origInfo.makeAlphaType(newAT);
+    const size_t rowBytes = info.minRowBytes();
+    const size_t usedSize = info.computeByteSize(rowBytes);
+    if (SkImageInfo::ByteSizeOverflowed(usedSize) || usedSize == 0 ||
+        usedSize > LayerPixelPool::kMaxBlockSize) {
+        return nullptr;
+    }
+
+    const size_t blockSize = LayerPixelPool::SizeClass(usedSize);
+    // Like Create(), opaque layers have no sensible default color and are left uninitialized.
+    void* pixels = LayerPixelPool::Get()->acquire(blockSize, usedSize, !info.isOpaque());
+    if (!pixels) {
+        return nullptr;
+    }
+    SkBitmap bitmap;
+    if (!bitmap.installPixels(info, pixels, rowBytes, release_layer_pixels,
+                              reinterpret_cast<void*>(static_cast<uintptr_t>(blockSize)))) {
+        return nullptr;
+    }
+    return sk_make_sp<SkBitmapDevice>(bitmap, surfaceProps);
+}
+
+}  // namespace
+
 sk_sp<SkDevice> SkBitmapDevice::createDevice(const CreateInfo& cinfo, const SkPaint* layerPaint) {
     const SkSurfaceProps surfaceProps =
         this->surfaceProps().cloneWithPixelGeometry(cinfo.fPixelGeometry);
@@ -302,6 +413,11 @@ sk_sp<SkDevice> SkBitmapDevice::createDevice(const CreateInfo& cinfo, const SkPa
         info = info.makeColorType(kN32_SkColorType);
     }
 
+    if (!cinfo.fAllocator) {
+        if (sk_sp<SkBitmapDevice> device = make_pooled_layer_device(info, surfaceProps)) {
+            return device;
+        }
+    }
     return SkBitmapDevice::Create(info, surfaceProps, cinfo.fAllocator);
 }
 
@@ -748,6 +748,13 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
 
     // We'll end here for many interesting cases: color spaces, color filters, most color types.
     if (clipShader || !UseLegacyBlitter(device, *paint, ctm)) {
+#if !defined(SK_FORCE_RASTER_PIPELINE_BLITTER)
+        if (!clipShader && !gSkForceRasterPipelineBlitter) {
+            if (auto blitter = SkCreateSolidColorBlitter(device, *paint, alloc)) {
+                return blitter;
+            }
+        }
+#endif
         return CreateSkRPBlitter();
     }
 
@@ -851,4 +858,10 @@ void SkRectClipCheckBlitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
     fBlitter->blitAntiV2(x, y, a0, a1);
 }
 
+void SkRectClipCheckBlitter::blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                                           size_t rowBytes) {
+    SkASSERT(fClipRect.contains(SkIRect::MakeXYWH(x, y, count, 2)));
+    fBlitter->blitAntiV2Run(x, y, count, coverage, rowBytes);
+}
+
 #endif
@@ -106,6 +106,17 @@ public:
         this->blitAntiH(x, y + 1, aa, runs);
     }
 
+    // (x, y) ... (x + count - 1, y), (x, y + 1) ... (x + count - 1, y + 1)
+    // Blits count columns of two pixels each, like blitAntiV2() for each column. coverage[] holds
+    // the alphas of row y, and coverage + rowBytes those of row y + 1. Antialiased hairlines that
+    // are mostly horizontal blit through this, so blitters can blend all of a run's pixels in one
+    // call.
+    virtual void blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[], size_t rowBytes) {
+        for (int i = 0; i < count; ++i) {
+            this->blitAntiV2(x + i, y, coverage[i], coverage[rowBytes + i]);
+        }
+    }
+
     /**
      *  Special method just to identify the null blitter, which is returned
      *  from Choose() if the request cannot be fulfilled. Default impl
@@ -260,6 +271,8 @@ public:
     void blitMask(const SkMask&, const SkIRect& clip) override;
     void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override;
     void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override;
+    void blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                       size_t rowBytes) override;
 
     int requestRowsPreserved() const override {
         return fBlitter->requestRowsPreserved();
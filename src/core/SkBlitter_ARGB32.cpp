@@ -1516,6 +1516,43 @@ void SkARGB32_Blitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
     device[0] = SkBlendARGB32(fPMColor, device[0], a1);
 }
 
+// Blends the two rows of a blitAntiV2Run() four pixels at a time. blend(dst, aa) must do the same
+// math for each pixel as the blitter's blitAntiV2().
+template <typename Blend>
+static void blend_anti_v2_run(const SkPixmap& device, int x, int y, int count,
+                              const SkAlpha coverage[], size_t rowBytes, Blend&& blend) {
+    using U32x4 = skvx::Vec<4, uint32_t>;
+    for (int row = 0; row < 2; ++row) {
+        uint32_t* dst = device.writable_addr32(x, y + row);
+        SkDEBUGCODE((void)device.writable_addr32(x + count - 1, y + row);)
+        const SkAlpha* aa = coverage + row * rowBytes;
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            U32x4 a = skvx::cast<uint32_t>(skvx::Vec<4, uint8_t>::Load(aa + i));
+            blend(U32x4::Load(dst + i), a).store(dst + i);
+        }
+        for (; i < count; ++i) {
+            dst[i] = blend(U32x4(dst[i]), U32x4(aa[i]))[0];
+        }
+    }
+}
+
+void SkARGB32_Blitter::blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                                     size_t rowBytes) {
+    // SkBlendARGB32()
+    const uint32_t mask = 0xFF00FF;
+    const uint32_t srcA = SkGetPackedA32(fPMColor),
+                   srcRB = fPMColor & mask,
+                   srcAG = (fPMColor >> 8) & mask;
+    blend_anti_v2_run(fDevice, x, y, count, coverage, rowBytes, [&](auto dst, auto aa) {
+        auto srcScale = aa + 1;
+        auto prod = 0xFFFF - srcA * srcScale;
+        auto dstScale = (prod + (prod >> 8)) >> 8;
+        return (((srcRB * srcScale + (dst & mask) * dstScale) >> 8) & mask) |
+               ((srcAG * srcScale + ((dst >> 8) & mask) * dstScale) & ~mask);
+    });
+}
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 #define solid_8_pixels(mask, dst, color)    \
@@ -1617,6 +1654,19 @@ void SkARGB32_Opaque_Blitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
     device[0] = SkFastFourByteInterp(fPMColor, device[0], a1);
 }
 
+void SkARGB32_Opaque_Blitter::blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                                            size_t rowBytes) {
+    // SkFastFourByteInterp()
+    const uint32_t mask = 0xFF00FF;
+    const uint32_t srcRB = fPMColor & mask,
+                   srcAG = (fPMColor >> 8) & mask;
+    blend_anti_v2_run(fDevice, x, y, count, coverage, rowBytes, [&](auto dst, auto aa) {
+        auto scale = aa + (aa >> 7);
+        return (((srcRB * scale + (dst & mask) * (256 - scale)) >> 8) & mask) |
+               ((srcAG * scale + ((dst >> 8) & mask) * (256 - scale)) & ~mask);
+    });
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkARGB32_Blitter::blitV(int x, int y, int height, SkAlpha alpha) {
@@ -1714,6 +1764,17 @@ void SkARGB32_Black_Blitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
     device[0] = (a1 << SK_A32_SHIFT) + SkAlphaMulQ(device[0], 256 - a1);
 }
 
+void SkARGB32_Black_Blitter::blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                                           size_t rowBytes) {
+    // (aa << SK_A32_SHIFT) + SkAlphaMulQ(dst, 256 - aa)
+    const uint32_t mask = 0xFF00FF;
+    blend_anti_v2_run(fDevice, x, y, count, coverage, rowBytes, [&](auto dst, auto aa) {
+        auto scale = 256 - aa;
+        return (aa << SK_A32_SHIFT) + ((((dst & mask) * scale >> 8) & mask) |
+                                       (((dst >> 8) & mask) * scale & ~mask));
+    });
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 SkARGB32_Shader_Blitter::SkARGB32_Shader_Blitter(const SkPixmap& device,
@@ -0,0 +1,341 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkShader.h" // IWYU pragma: keep
+#include "include/core/SkSurfaceProps.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkCoreBlitters.h"
+#include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkMemset.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+// Blitters for drawing a single color with kSrc or kSrcOver into the color types that have no
+// legacy blitter, specialized at compile time on the pixel format and the blend mode. Drawing a
+// solid color is most of what draws into these formats do (think HDR10 surfaces in 1010102), and
+// most of the spans such a draw blits are only a pixel or two wide: antialiased edges, blitV(),
+// blitAntiH2(). Running those through SkRasterPipelineBlitter costs a pipeline call per span,
+// which dominates the work of blending one or two pixels. Here short spans are blended a pixel at
+// a time with a handful of skvx::float4 ops, using the same math (and rounding) as the raster
+// pipeline, opaque spans are memset, and long spans that need blending still go to the pipeline.
+
+namespace {
+
+using skvx::float4;
+
+// to_unorm() from SkRasterPipeline_opts.h.
+uint32_t to_unorm(float v, float scale) {
+    return (uint32_t)(std::min(std::max(0.0f, v), 1.0f) * scale + 0.5f);
+}
+
+// Each format converts one pixel to and from premul RGBA floats.
+template <bool kOpaque>
+struct Format_1010102 {
+    using Pixel = uint32_t;
+    static float4 Load(Pixel px) {
+        return float4{(float)(px       & 0x3ff),
+                      (float)(px >> 10 & 0x3ff),
+                      (float)(px >> 20 & 0x3ff),
+                      kOpaque ? 3.0f : (float)(px >> 30)} * float4{1/1023.0f, 1/1023.0f,
+                                                                  1/1023.0f, 1/   3.0f};
+    }
+    static Pixel Store(const float4& c) {
+        return to_unorm(c[0], 1023)
+             | to_unorm(c[1], 1023) << 10
+             | to_unorm(c[2], 1023) << 20
+             | (kOpaque ? 3 : to_unorm(c[3], 3)) << 30;
+    }
+};
+
+struct Format_565 {
+    using Pixel = uint16_t;
+    static float4 Load(Pixel px) {
+        return float4{(float)(px >> 11), (float)(px >> 5 & 63), (float)(px & 31), 1.0f}
+             * float4{1/31.0f, 1/63.0f, 1/31.0f, 1.0f};
+    }
+    static Pixel Store(const float4& c) {
+        return (Pixel)(to_unorm(c[0], 31) << 11
+                     | to_unorm(c[1], 63) <<  5
+                     | to_unorm(c[2], 31));
+    }
+};
+
+struct Format_A16 {
+    using Pixel = uint16_t;
+    static float4 Load(Pixel px) { return float4{0, 0, 0, px * (1/65535.0f)}; }
+    static Pixel Store(const float4& c) { return (Pixel)to_unorm(c[3], 65535); }
+};
+
+struct Format_F16 {
+    using Pixel = uint64_t;
+    static float4 Load(Pixel px) { return skvx::from_half(skvx::Vec<4,uint16_t>::Load(&px)); }
+    static Pixel Store(const float4& c) {
+        Pixel px;
+        skvx::to_half(c).store(&px);
+        return px;
+    }
+};
+
+template <typename Format, SkBlendMode kMode>
+class SkSolidColorBlitter final : public SkBlitter {
+    static_assert(kMode == SkBlendMode::kSrc || kMode == SkBlendMode::kSrcOver);
+    using Pixel = typename Format::Pixel;
+
+public:
+    SkSolidColorBlitter(const SkPixmap& dst, const float4& color, const SkPaint& paint,
+                        SkArenaAlloc* alloc)
+        : fDst(dst)
+        , fColor(color)
+        , fInvAlpha(1 - color[3])
+        , fPixel(Format::Store(color))
+        , fPaint(paint)
+        , fAlloc(alloc) {}
+
+    void blitH(int x, int y, int width) override {
+        this->blitRect(x, y, width, 1);
+    }
+
+    void blitRect(int x, int y, int width, int height) override {
+        if constexpr (kMode == SkBlendMode::kSrc) {
+            size_t rowBytes = fDst.rowBytes();
+            if constexpr (sizeof(Pixel) == 2) {
+                SkOpts::rect_memset16(this->addr(x, y), fPixel, width, rowBytes, height);
+            } else if constexpr (sizeof(Pixel) == 4) {
+                SkOpts::rect_memset32(this->addr(x, y), fPixel, width, rowBytes, height);
+            } else {
+                SkOpts::rect_memset64(this->addr(x, y), fPixel, width, rowBytes, height);
+            }
+        } else if (SkBlitter* pipeline = this->pipelineFor(width)) {
+            pipeline->blitRect(x, y, width, height);
+        } else {
+            while (height --> 0) {
+                Pixel* px = this->addr(x, y++);
+                for (int i = 0; i < width; ++i) {
+                    px[i] = this->blend(px[i]);
+                }
+            }
+        }
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        // Rows with a long run that needs blending go to the raster pipeline whole, which
+        // batches their runs.
+        for (int i = 0; runs[i] > 0; i += runs[i]) {
+            const bool memset = kMode == SkBlendMode::kSrc && antialias[i] == 0xff;
+            if (!memset && antialias[i] != 0x00) {
+                if (SkBlitter* pipeline = this->pipelineFor(runs[i])) {
+                    pipeline->blitAntiH(x, y, antialias, runs);
+                    return;
+                }
+            }
+        }
+
+        Pixel* px = this->addr(x, y);
+        for (int count = *runs; count > 0; count = *runs) {
+            if (SkAlpha aa = *antialias; aa == 0xff) {
+                this->blitRect(x, y, count, 1);
+            } else if (aa != 0) {
+                const float coverage = aa * (1/255.0f);
+                for (int i = 0; i < count; ++i) {
+                    px[i] = this->blend(px[i], coverage);
+                }
+            }
+            x         += count;
+            px        += count;
+            runs      += count;
+            antialias += count;
+        }
+    }
+
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        if (alpha == 0) {
+            return;
+        }
+        if (alpha == 0xff) {
+            this->blitRect(x, y, 1, height);
+            return;
+        }
+        const float coverage = alpha * (1/255.0f);
+        while (height --> 0) {
+            Pixel* px = this->addr(x, y++);
+            *px = this->blend(*px, coverage);
+        }
+    }
+
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+        Pixel* px = this->addr(x, y);
+        px[0] = this->blend(px[0], a0 * (1/255.0f));
+        px[1] = this->blend(px[1], a1 * (1/255.0f));
+    }
+
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+        Pixel* px = this->addr(x, y);
+        *px = this->blend(*px, a0 * (1/255.0f));
+        px = this->addr(x, y + 1);
+        *px = this->blend(*px, a1 * (1/255.0f));
+    }
+
+    void blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                       size_t rowBytes) override {
+        for (int row = 0; row < 2; ++row) {
+            Pixel* px = this->addr(x, y + row);
+            const SkAlpha* aa = coverage + row * rowBytes;
+            for (int i = 0; i < count; ++i) {
+                px[i] = this->blend(px[i], aa[i] * (1/255.0f));
+            }
+        }
+    }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        if (mask.fFormat == SkMask::kBW_Format) {
+            return SkBlitter::blitMask(mask, clip);
+        }
+        // LCD and 3D masks are rare enough here to leave to the raster pipeline too.
+        const int width = mask.fFormat == SkMask::kA8_Format ? clip.width() : kMinPipelineSpan;
+        if (SkBlitter* pipeline = this->pipelineFor(width)) {
+            pipeline->blitMask(mask, clip);
+            return;
+        }
+        if (mask.fFormat != SkMask::kA8_Format) {
+            return;
+        }
+        for (int y = clip.fTop; y < clip.fBottom; ++y) {
+            const uint8_t* aa = mask.getAddr8(clip.fLeft, y);
+            Pixel* px = this->addr(clip.fLeft, y);
+            for (int i = 0; i < width; ++i) {
+                if (aa[i] == 0xff) {
+                    px[i] = this->blend(px[i]);
+                } else if (aa[i] != 0) {
+                    px[i] = this->blend(px[i], aa[i] * (1/255.0f));
+                }
+            }
+        }
+    }
+
+private:
+    Pixel* addr(int x, int y) {
+        return static_cast<Pixel*>(fDst.writable_addr(x, y));
+    }
+
+    // Full coverage.
+    Pixel blend(Pixel px) const {
+        if constexpr (kMode == SkBlendMode::kSrc) {
+            return fPixel;
+        } else {
+            return Format::Store(fColor + Format::Load(px) * fInvAlpha);
+        }
+    }
+
+    // Partial coverage, as the raster pipeline does it: kSrc lerps towards the color, and the
+    // color is scaled by coverage before kSrcOver.
+    Pixel blend(Pixel px, float coverage) const {
+        const float4 d = Format::Load(px);
+        if constexpr (kMode == SkBlendMode::kSrc) {
+            return Format::Store(d + (fColor - d) * coverage);
+        } else {
+            return Format::Store(fColor * coverage + d * (1 - fColor[3] * coverage));
+        }
+    }
+
+    // Blending a pixel at a time is cheaper than a call into the raster pipeline only for short
+    // spans. The pipeline's wide stages win past this many pixels.
+    static constexpr int kMinPipelineSpan = 16;
+
+    // Returns the raster pipeline blitter for the same paint if a span this wide should use it.
+    SkBlitter* pipelineFor(int width) {
+        if (width < kMinPipelineSpan) {
+            return nullptr;
+        }
+        if (!fPipeline) {
+            fPipeline = SkCreateRasterPipelineBlitter(fDst, fPaint, SkMatrix::I(), fAlloc,
+                                                      nullptr, SkSurfaceProps());
+        }
+        return fPipeline;
+    }
+
+    const SkPixmap fDst;
+    const float4   fColor;     // premul, in dst's color space and channel order
+    const float    fInvAlpha;
+    const Pixel    fPixel;     // fColor stored as a dst pixel
+    const SkPaint  fPaint;
+    SkArenaAlloc*  fAlloc;
+    SkBlitter*     fPipeline = nullptr;
+};
+
+template <typename Format>
+SkBlitter* make_blitter(const SkPixmap& dst, const float4& color, SkBlendMode mode,
+                        const SkPaint& paint, SkArenaAlloc* alloc) {
+    if (mode == SkBlendMode::kSrc) {
+        return alloc->make<SkSolidColorBlitter<Format, SkBlendMode::kSrc>>(dst, color, paint,
+                                                                            alloc);
+    }
+    return alloc->make<SkSolidColorBlitter<Format, SkBlendMode::kSrcOver>>(dst, color, paint,
+                                                                            alloc);
+}
+
+}  // namespace
+
+SkBlitter* SkCreateSolidColorBlitter(const SkPixmap& dst, const SkPaint& paint,
+                                     SkArenaAlloc* alloc) {
+    std::optional<SkBlendMode> mode = paint.asBlendMode();
+    if (paint.getShader() || paint.getColorFilter() ||
+        (mode != SkBlendMode::kSrc && mode != SkBlendMode::kSrcOver) ||
+        dst.alphaType() == kUnpremul_SkAlphaType) {
+        return nullptr;
+    }
+
+    // The paint color in dst's color space, as SkRasterPipelineBlitter sees it.
+    SkColor4f color = paint.getColor4f();
+    SkColorSpaceXformSteps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                           dst.colorSpace(),    kUnpremul_SkAlphaType).apply(color.vec());
+    float4 premul = float4::Load(color.premul().vec());
+    if (SkColorTypeIsNormalized(dst.colorType())) {
+        premul = skvx::pin(premul, float4(0), float4(1));
+    }
+    // We can strength-reduce kSrcOver into kSrc when opaque.
+    if (premul[3] == 1) {
+        mode = SkBlendMode::kSrc;
+    }
+    auto bgr = [](float4 c) { return skvx::shuffle<2,1,0,3>(c); };
+
+    switch (dst.colorType()) {
+        case kRGBA_1010102_SkColorType:
+            return make_blitter<Format_1010102<false>>(dst, premul, *mode, paint, alloc);
+        case kBGRA_1010102_SkColorType:
+            return make_blitter<Format_1010102<false>>(dst, bgr(premul), *mode, paint, alloc);
+        case kRGB_101010x_SkColorType:
+            return make_blitter<Format_1010102<true>>(dst, premul, *mode, paint, alloc);
+        case kBGR_101010x_SkColorType:
+            return make_blitter<Format_1010102<true>>(dst, bgr(premul), *mode, paint, alloc);
+        case kRGB_565_SkColorType:
+            return make_blitter<Format_565>(dst, premul, *mode, paint, alloc);
+        case kA16_unorm_SkColorType:
+            return make_blitter<Format_A16>(dst, premul, *mode, paint, alloc);
+        case kRGBA_F16Norm_SkColorType:
+        case kRGBA_F16_SkColorType:
+            return make_blitter<Format_F16>(dst, premul, *mode, paint, alloc);
+        default:
+            return nullptr;
+    }
+}
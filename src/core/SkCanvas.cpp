@@ -15,6 +15,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkMaskFilter.h"
@@ -840,32 +841,56 @@ void SkCanvas::internalDrawDeviceWithFilter(SkDevice* src,
         }
     } // else leave 'source' as the empty image
 
-    // Evaluate the image filter, with a context pointing to the source snapped from 'src' and
-    // possibly transformed into the intermediate layer coordinate space.
-    ctx = ctx.withNewDesiredOutput(mapping.deviceToLayer(outputBounds))
-             .withNewSource(source);
-
     // Here, we allow a single-element FilterSpan with a null entry, to simplify the loop:
     sk_sp<SkImageFilter> nullFilter;
     FilterSpan filtersOrNull = filters.empty() ? FilterSpan{&nullFilter, 1} : filters;
 
-    for (const sk_sp<SkImageFilter>& filter : filtersOrNull) {
-        auto result = filter ? as_IFB(filter)->filterImage(ctx) : source;
-
-        if (srcIsCoverageLayer) {
-            SkASSERT(dst->useDrawCoverageMaskForMaskFilters());
-            // TODO: Can FilterResult optimize this in any meaningful way if it still has to go
-            // through drawCoverageMask that requires an image (vs a coverage shader)?
-            auto [coverageMask, origin] = result.imageAndOffset(ctx);
-            if (coverageMask) {
-                SkMatrix deviceMatrixWithOffset = mapping.layerToDevice();
-                deviceMatrixWithOffset.preTranslate(origin.x(), origin.y());
-                dst->drawCoverageMask(
-                        coverageMask.get(), deviceMatrixWithOffset, result.sampling(), paint);
+    // When filtering all of 'outputBounds' at once would need more intermediate memory than
+    // allowed, filter and draw it in tiles that each only require part of the source.
+    auto tiles = skif::ChooseOutputTiles(filtersOrNull,
+                                         mapping,
+                                         outputBounds,
+                                         source ? source.layerBounds()
+                                                : skif::LayerSpace<SkIRect>::Empty(),
+                                         filterColorType,
+                                         SkGraphics::GetImageFilterTileByteLimit());
+    stats.fNumOutputTiles = tiles.size();
+
+    for (const skif::DeviceSpace<SkIRect>& tile : tiles) {
+        // Evaluate the image filter, with a context pointing to the source snapped from 'src' and
+        // possibly transformed into the intermediate layer coordinate space.
+        skif::Context tileCtx = ctx.withNewDesiredOutput(mapping.deviceToLayer(tile))
+                                   .withNewSource(source);
+        if (tiles.size() > 1) {
+            // The tile's layer-space output can extend past it after rounding out, so clip to
+            // keep neighboring tiles from drawing over each other.
+            SkAutoDeviceTransformRestore adtr{dst, SkMatrix::I()};
+            dst->pushClipStack();
+            dst->clipRect(SkRect::Make(SkIRect(tile)), SkClipOp::kIntersect, /*aa=*/false);
+        }
+
+        for (const sk_sp<SkImageFilter>& filter : filtersOrNull) {
+            auto result = filter ? as_IFB(filter)->filterImage(tileCtx) : source;
+
+            if (srcIsCoverageLayer) {
+                SkASSERT(dst->useDrawCoverageMaskForMaskFilters());
+                // TODO: Can FilterResult optimize this in any meaningful way if it still has to go
+                // through drawCoverageMask that requires an image (vs a coverage shader)?
+                auto [coverageMask, origin] = result.imageAndOffset(tileCtx);
+                if (coverageMask) {
+                    SkMatrix deviceMatrixWithOffset = mapping.layerToDevice();
+                    deviceMatrixWithOffset.preTranslate(origin.x(), origin.y());
+                    dst->drawCoverageMask(
+                            coverageMask.get(), deviceMatrixWithOffset, result.sampling(), paint);
+                }
+            } else {
+                result = apply_alpha_and_colorfilter(tileCtx, result, paint);
+                result.draw(tileCtx, dst, paint.getBlender());
             }
-        } else {
-            result = apply_alpha_and_colorfilter(ctx, result, paint);
-            result.draw(ctx, dst, paint.getBlender());
+        }
+
+        if (tiles.size() > 1) {
+            dst->popClipStack();
         }
     }
 
@@ -1644,7 +1669,7 @@ skgpu::graphite::Recorder* SkCanvas::recorder() const {
 
 void SkCanvas::drawDRRect(const SkRRect& outer, const SkRRect& inner,
                           const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (outer.isEmpty()) {
         return;
     }
@@ -1666,24 +1691,24 @@ void SkCanvas::drawDRRect(const SkRRect& outer, const SkRRect& inner,
 }
 
 void SkCanvas::drawPaint(const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     this->onDrawPaint(paint);
 }
 
 void SkCanvas::drawRect(const SkRect& r, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     // To avoid redundant logic in our culling code and various backends, we always sort rects
     // before passing them along.
     this->onDrawRect(r.makeSorted(), paint);
 }
 
 void SkCanvas::drawClippedToSaveBehind(const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     this->onDrawBehind(paint);
 }
 
 void SkCanvas::drawRegion(const SkRegion& region, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (region.isEmpty()) {
         return;
     }
@@ -1696,19 +1721,19 @@ void SkCanvas::drawRegion(const SkRegion& region, const SkPaint& paint) {
 }
 
 void SkCanvas::drawOval(const SkRect& r, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     // To avoid redundant logic in our culling code and various backends, we always sort rects
     // before passing them along.
     this->onDrawOval(r.makeSorted(), paint);
 }
 
 void SkCanvas::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     this->onDrawRRect(rrect, paint);
 }
 
 void SkCanvas::drawPoints(PointMode mode, size_t count, const SkPoint pts[], const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     this->onDrawPoints(mode, count, pts, paint);
 }
 
@@ -1718,7 +1743,7 @@ void SkCanvas::drawVertices(const sk_sp<SkVertices>& vertices, SkBlendMode mode,
 }
 
 void SkCanvas::drawVertices(const SkVertices* vertices, SkBlendMode mode, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     RETURN_ON_NULL(vertices);
 
     // We expect fans to be converted to triangles when building or deserializing SkVertices.
@@ -1737,7 +1762,7 @@ void SkCanvas::drawVertices(const SkVertices* vertices, SkBlendMode mode, const
 }
 
 void SkCanvas::drawMesh(const SkMesh& mesh, sk_sp<SkBlender> blender, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (!blender) {
         blender = SkBlender::Mode(SkBlendMode::kModulate);
     }
@@ -1745,7 +1770,7 @@ void SkCanvas::drawMesh(const SkMesh& mesh, sk_sp<SkBlender> blender, const SkPa
 }
 
 void SkCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     this->onDrawPath(path, paint);
 }
 
@@ -1785,7 +1810,7 @@ void SkCanvas::drawImageNine(const SkImage* image, const SkIRect& center, const
 
 void SkCanvas::drawImageLattice(const SkImage* image, const Lattice& lattice, const SkRect& dst,
                                 SkFilterMode filter, const SkPaint* paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     RETURN_ON_NULL(image);
     if (dst.isEmpty()) {
         return;
@@ -1811,7 +1836,7 @@ void SkCanvas::drawAtlas(const SkImage* atlas, const SkRSXform xform[], const Sk
                          const SkColor colors[], int count, SkBlendMode mode,
                          const SkSamplingOptions& sampling, const SkRect* cull,
                          const SkPaint* paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     RETURN_ON_NULL(atlas);
     if (count <= 0) {
         return;
@@ -1822,14 +1847,14 @@ void SkCanvas::drawAtlas(const SkImage* atlas, const SkRSXform xform[], const Sk
 }
 
 void SkCanvas::drawAnnotation(const SkRect& rect, const char key[], SkData* value) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (key) {
         this->onDrawAnnotation(rect, key, value);
     }
 }
 
 void SkCanvas::private_draw_shadow_rec(const SkPath& path, const SkDrawShadowRec& rec) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     this->onDrawShadowRec(path, rec);
 }
 
@@ -1845,18 +1870,28 @@ void SkCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
 void SkCanvas::experimental_DrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
                                            QuadAAFlags aaFlags, const SkColor4f& color,
                                            SkBlendMode mode) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     // Make sure the rect is sorted before passing it along
     this->onDrawEdgeAAQuad(rect.makeSorted(), clip, aaFlags, color, mode);
 }
 
+void SkCanvas::experimental_DrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                              const SkMatrix preViewMatrices[], int cnt,
+                                              QuadAAFlags aaFlags, SkBlendMode mode) {
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
+    if (cnt <= 0) {
+        return;
+    }
+    this->onDrawEdgeAARectSet(rects, colors, preViewMatrices, cnt, aaFlags, mode);
+}
+
 void SkCanvas::experimental_DrawEdgeAAImageSet(const ImageSetEntry imageSet[], int cnt,
                                                const SkPoint dstClips[],
                                                const SkMatrix preViewMatrices[],
                                                const SkSamplingOptions& sampling,
                                                const SkPaint* paint,
                                                SrcRectConstraint constraint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     // Route single, rectangular quads to drawImageRect() to take advantage of image filter
     // optimizations that avoid a layer.
     if (paint && paint->getImageFilter() && cnt == 1) {
@@ -2319,7 +2354,7 @@ void SkCanvas::onDrawImageLattice2(const SkImage* image, const Lattice& lattice,
 
 void SkCanvas::drawImage(const SkImage* image, SkScalar x, SkScalar y,
                          const SkSamplingOptions& sampling, const SkPaint* paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     RETURN_ON_NULL(image);
 
     this->drawImageRect(image,
@@ -2391,7 +2426,7 @@ sk_sp<Slug> SkCanvas::onConvertGlyphRunListToSlug(const sktext::GlyphRunList& gl
 }
 
 void SkCanvas::drawSlug(const Slug* slug, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (slug) {
         this->onDrawSlug(slug, paint);
     }
@@ -2412,7 +2447,7 @@ void SkCanvas::onDrawSlug(const Slug* slug, const SkPaint& paint) {
 // These call the (virtual) onDraw... method
 void SkCanvas::drawSimpleText(const void* text, size_t byteLength, SkTextEncoding encoding,
                               SkScalar x, SkScalar y, const SkFont& font, const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (byteLength) {
         sk_msan_assert_initialized(text, SkTAddOffset<const void>(text, byteLength));
         const sktext::GlyphRunList& glyphRunList =
@@ -2483,7 +2518,7 @@ void SkCanvas::drawGlyphs(int count, const SkGlyphID glyphs[], const SkRSXform x
 
 void SkCanvas::drawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
                             const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     RETURN_ON_NULL(blob);
     RETURN_ON_FALSE(blob->bounds().makeOffset(x, y).isFinite());
 
@@ -2529,7 +2564,7 @@ void SkCanvas::onDrawMesh(const SkMesh& mesh, sk_sp<SkBlender> blender, const Sk
 void SkCanvas::drawPatch(const SkPoint cubics[12], const SkColor colors[4],
                          const SkPoint texCoords[4], SkBlendMode bmode,
                          const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (nullptr == cubics) {
         return;
     }
@@ -2635,6 +2670,32 @@ void SkCanvas::onDrawEdgeAAQuad(const SkRect& r, const SkPoint clip[4], QuadAAFl
     }
 }
 
+void SkCanvas::onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                   const SkMatrix preViewMatrices[], int count,
+                                   QuadAAFlags aaFlags, SkBlendMode mode) {
+    // The whole point of the set is to pay for the canvas's per-draw work once, so the set is
+    // rejected as a whole and the device clips each rect.
+    SkRect setBounds = SkRect::MakeEmpty();
+    for (int i = 0; i < count; ++i) {
+        SkASSERT(rects[i].isSorted());
+        SkRect entryBounds = rects[i];
+        if (preViewMatrices) {
+            preViewMatrices[i].mapRect(&entryBounds);
+        }
+        setBounds.joinPossiblyEmptyRect(entryBounds);
+    }
+
+    SkPaint paint;
+    paint.setBlendMode(mode);
+    if (this->internalQuickReject(setBounds, paint)) {
+        return;
+    }
+
+    if (this->predrawNotify()) {
+        this->topDevice()->drawEdgeAARectSet(rects, colors, preViewMatrices, count, aaFlags, mode);
+    }
+}
+
 void SkCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry imageSet[], int count,
                                      const SkPoint dstClips[], const SkMatrix preViewMatrices[],
                                      const SkSamplingOptions& sampling, const SkPaint* paint,
@@ -2728,7 +2789,7 @@ void SkCanvas::drawRoundRect(const SkRect& r, SkScalar rx, SkScalar ry,
 void SkCanvas::drawArc(const SkRect& oval, SkScalar startAngle,
                        SkScalar sweepAngle, bool useCenter,
                        const SkPaint& paint) {
-    TRACE_EVENT0("skia", TRACE_FUNC);
+    TRACE_EVENT0_HOT("skia", TRACE_FUNC);
     if (oval.isEmpty() || !sweepAngle) {
         return;
     }
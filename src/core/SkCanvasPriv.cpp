@@ -115,6 +115,22 @@ void SkCanvasPriv::GetDstClipAndMatrixCounts(const SkCanvas::ImageSetEntry set[]
     *totalMatrixCount = maxMatrixIndex + 1;
 }
 
+void SkCanvasPriv::DrawEdgeAARectSetAsQuads(SkCanvas* canvas, const SkRect rects[],
+                                            const SkColor4f colors[],
+                                            const SkMatrix preViewMatrices[], int count,
+                                            SkCanvas::QuadAAFlags aaFlags, SkBlendMode mode) {
+    for (int i = 0; i < count; ++i) {
+        if (preViewMatrices) {
+            canvas->save();
+            canvas->concat(preViewMatrices[i]);
+        }
+        canvas->experimental_DrawEdgeAAQuad(rects[i], nullptr, aaFlags, colors[i], mode);
+        if (preViewMatrices) {
+            canvas->restore();
+        }
+    }
+}
+
 // Attempts to convert an image filter to its equivalent color filter, which if possible, modifies
 // the paint to compose the image filter's color filter into the paint's color filter slot. Returns
 // true if the paint has been modified. Requires the paint to have an image filter.
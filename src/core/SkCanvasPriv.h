@@ -72,6 +72,14 @@ public:
     static void GetDstClipAndMatrixCounts(const SkCanvas::ImageSetEntry set[], int count,
                                           int* totalDstClipCount, int* totalMatrixCount);
 
+    // Draws an experimental_DrawEdgeAARectSet() as one experimental_DrawEdgeAAQuad() per rect,
+    // wrapped in save/concat/restore when the rect has a pre-view matrix. For canvases that record
+    // or forward draws instead of drawing the set with a device.
+    static void DrawEdgeAARectSetAsQuads(SkCanvas*, const SkRect rects[],
+                                         const SkColor4f colors[],
+                                         const SkMatrix preViewMatrices[], int count,
+                                         SkCanvas::QuadAAFlags aaFlags, SkBlendMode mode);
+
     static SkCanvas::SaveLayerRec ScaledBackdropLayer(const SkRect* bounds,
                                                       const SkPaint* paint,
                                                       const SkImageFilter* backdrop,
@@ -640,6 +640,13 @@ bool SkClipStack::internalQuickContains(const SkRect& rect) const {
     Iter iter(*this, Iter::kTop_IterStart);
     const Element* element = iter.prev();
     while (element != nullptr) {
+        // Deep stacks of nested rect clips (e.g. scroll views) are common. When this element and
+        // everything under it are intersected rects, its finite bound is exactly their
+        // intersection, so there is no need to visit the rest of the stack.
+        if (element->fIsIntersectionOfRects) {
+            SkASSERT(kNormal_BoundsType == element->fFiniteBoundType);
+            return element->fFiniteBound.contains(rect);
+        }
         // TODO: Once expanding ops are removed, this condition is equiv. to op == kDifference.
         if (SkClipOp::kIntersect != element->getOp() && !element->isReplaceOp()) {
             return false;
@@ -666,6 +673,11 @@ bool SkClipStack::internalQuickContains(const SkRRect& rrect) const {
     Iter iter(*this, Iter::kTop_IterStart);
     const Element* element = iter.prev();
     while (element != nullptr) {
+        // See above; a rect element contains an rrect when it contains the rrect's bounds.
+        if (element->fIsIntersectionOfRects) {
+            SkASSERT(kNormal_BoundsType == element->fFiniteBoundType);
+            return element->fFiniteBound.contains(rrect.getBounds());
+        }
         // TODO: Once expanding ops are removed, this condition is equiv. to op == kDifference.
         if (SkClipOp::kIntersect != element->getOp() && !element->isReplaceOp()) {
             return false;
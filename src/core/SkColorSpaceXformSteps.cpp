@@ -11,12 +11,14 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkMutex.h"
 #include "modules/skcms/skcms.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpList.h"
 
 #include <cstring>
+#include <iterator>
 
 // See skia.org/user/color  (== site/user/color.md).
 
@@ -143,3 +145,48 @@ void SkColorSpaceXformSteps::apply(SkRasterPipeline* p) const {
     if (flags.encode)          { p->appendTransferFunction(dstTFInv); }
     if (flags.premul)          { p->append(SkRasterPipelineOp::premul); }
 }
+
+// Transfer functions of 8-bit sources only ever see 256 distinct inputs, so we evaluate them once.
+// Tables are never freed, since pipelines point at them; there are only ever a few distinct source
+// transfer functions, and any beyond kMaxTables fall back to evaluating per pixel.
+static const float* unorm8_transfer_fn_table(const skcms_TransferFunction& tf) {
+    struct Table {
+        skcms_TransferFunction tf;
+        float                  values[256];
+    };
+    static constexpr int kMaxTables = 8;
+    static Table* gTables[kMaxTables];
+    static int gTableCount = 0;
+    static SkMutex& mutex = *(new SkMutex);
+
+    SkAutoMutexExclusive lock(mutex);
+    for (int i = 0; i < gTableCount; ++i) {
+        if (0 == memcmp(&gTables[i]->tf, &tf, sizeof(tf))) {
+            return gTables[i]->values;
+        }
+    }
+    if (gTableCount == kMaxTables) {
+        return nullptr;
+    }
+    Table* table = new Table;
+    table->tf = tf;
+    for (int i = 0; i < (int)std::size(table->values); ++i) {
+        table->values[i] = skcms_TransferFunction_eval(&tf, i * (1/255.0f));
+    }
+    gTables[gTableCount++] = table;
+    return table->values;
+}
+
+void SkColorSpaceXformSteps::applyToUnorm8(SkRasterPipeline* p) const {
+    // Unpremul would leave values between the 256 the table holds.
+    const float* table = flags.linearize && !flags.unpremul ? unorm8_transfer_fn_table(srcTF)
+                                                            : nullptr;
+    if (!table) {
+        this->apply(p);
+        return;
+    }
+    p->append(SkRasterPipelineOp::byte_tf, table);
+    if (flags.gamut_transform) { p->append(SkRasterPipelineOp::matrix_3x3, &src_to_dst_matrix); }
+    if (flags.encode)          { p->appendTransferFunction(dstTFInv); }
+    if (flags.premul)          { p->append(SkRasterPipelineOp::premul); }
+}
@@ -46,6 +46,11 @@ struct SkColorSpaceXformSteps {
     void apply(float rgba[4]) const;
     void apply(SkRasterPipeline*) const;
 
+    // Like apply(SkRasterPipeline*), for colors that were just loaded or gathered unchanged from
+    // 8-bit unorm channels. The source transfer function is then read from a cached table of its
+    // 256 possible results instead of being evaluated per pixel.
+    void applyToUnorm8(SkRasterPipeline*) const;
+
     Flags flags;
 
     skcms_TransferFunction srcTF,     // Apply for linearize.
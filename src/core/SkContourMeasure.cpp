@@ -10,9 +10,11 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPathMeasurePriv.h"
 #include "src/core/SkPathPriv.h"
@@ -163,21 +165,14 @@ static bool conic_too_curvy(const SkPoint& firstPt, const SkPoint& midTPt,
     return dist > tolerance;
 }
 
-static bool cheap_dist_exceeds_limit(const SkPoint& pt, SkScalar x, SkScalar y,
-                                     SkScalar tolerance) {
-    SkScalar dist = std::max(SkScalarAbs(x - pt.fX), SkScalarAbs(y - pt.fY));
-    // just made up the 1/2
-    return dist > tolerance;
-}
-
 static bool cubic_too_curvy(const SkPoint pts[4], SkScalar tolerance) {
-    return  cheap_dist_exceeds_limit(pts[1],
-                         SkScalarInterp(pts[0].fX, pts[3].fX, SK_Scalar1/3),
-                         SkScalarInterp(pts[0].fY, pts[3].fY, SK_Scalar1/3), tolerance)
-                         ||
-            cheap_dist_exceeds_limit(pts[2],
-                         SkScalarInterp(pts[0].fX, pts[3].fX, SK_Scalar1*2/3),
-                         SkScalarInterp(pts[0].fY, pts[3].fY, SK_Scalar1*2/3), tolerance);
+    // Compares both control points with the points at 1/3 and 2/3 of the chord, at once.
+    const skvx::float4 p0 = skvx::float2::Load(&pts[0]).xyxy();
+    const skvx::float4 p3 = skvx::float2::Load(&pts[3]).xyxy();
+    const skvx::float4 ctrl = skvx::float4::Load(&pts[1]);
+    const skvx::float4 onChord = p0 + (p3 - p0) * skvx::float4{SK_Scalar1/3, SK_Scalar1/3,
+                                                               SK_Scalar1*2/3, SK_Scalar1*2/3};
+    return any(abs(ctrl - onChord) > tolerance);
 }
 
 // puts a cap on the total size of our output, since the client can pass in
@@ -205,21 +200,86 @@ private:
     SkTDArray<SkContourMeasure::Segment>  fSegments;
     SkTDArray<SkPoint>  fPts; // Points used to define the segments
 
+    // The chords a curve is subdivided into, in order. Their lengths are computed four at a time
+    // once the subdivision is done.
+    static constexpr int kMaxChords = 1 << kMaxRecursionDepth;
+    static_assert(kMaxChords % 4 == 0);
+    SkScalar fChordDX[kMaxChords];
+    SkScalar fChordDY[kMaxChords];
+    int      fChordTValues[kMaxChords];
+    int      fChordCount = 0;
+
     SkDEBUGCODE(void validate() const;)
     SkScalar compute_line_seg(SkPoint p0, SkPoint p1, SkScalar distance, unsigned ptIndex);
-    SkScalar compute_quad_segs(const SkPoint pts[3], SkScalar distance,
-                               int mint, int maxt, unsigned ptIndex, int recursionDepth = 0);
-    SkScalar compute_conic_segs(const SkConic& conic, SkScalar distance,
-                                                         int mint, const SkPoint& minPt,
-                                                         int maxt, const SkPoint& maxPt,
-                                unsigned ptIndex, int recursionDepth = 0);
-    SkScalar compute_cubic_segs(const SkPoint pts[4], SkScalar distance,
-                                int mint, int maxt, unsigned ptIndex, int recursionDepth = 0);
+    SkScalar compute_quad_segs(const SkPoint pts[3], SkScalar distance, unsigned ptIndex);
+    SkScalar compute_conic_segs(const SkConic& conic, SkScalar distance, unsigned ptIndex);
+    SkScalar compute_cubic_segs(const SkPoint pts[4], SkScalar distance, unsigned ptIndex);
+
+    void add_chord(const SkPoint& p0, const SkPoint& p1, int maxt);
+    SkScalar compute_chord_segs(SkScalar distance, unsigned ptIndex, unsigned segType);
+    void subdivide_quad(const SkPoint pts[3], int mint, int maxt, int recursionDepth);
+    void subdivide_conic(const SkConic& conic, int mint, const SkPoint& minPt,
+                                               int maxt, const SkPoint& maxPt,
+                         int recursionDepth);
+    void subdivide_cubic(const SkPoint pts[4], int mint, int maxt, int recursionDepth);
 };
 
-SkScalar SkContourMeasureIter::Impl::compute_quad_segs(const SkPoint pts[3], SkScalar distance,
-                                                       int mint, int maxt, unsigned ptIndex,
-                                                       int recursionDepth) {
+void SkContourMeasureIter::Impl::add_chord(const SkPoint& p0, const SkPoint& p1, int maxt) {
+    SkASSERT(fChordCount < kMaxChords);
+    fChordDX[fChordCount] = p0.fX - p1.fX;
+    fChordDY[fChordCount] = p0.fY - p1.fY;
+    fChordTValues[fChordCount] = maxt;
+    fChordCount += 1;
+}
+
+// Appends a segment for each chord added since the last call, and returns the accumulated distance.
+SkScalar SkContourMeasureIter::Impl::compute_chord_segs(SkScalar distance, unsigned ptIndex,
+                                                        unsigned segType) {
+    SkASSERT(ptIndex < (unsigned)fPts.size());
+    const int count = fChordCount;
+    fChordCount = 0;
+
+    // Pad the chords with empty ones so they can be loaded as vectors, then replace the deltas in
+    // fChordDX with the lengths of the chords.
+    for (int i = count; i < SkAlign4(count); ++i) {
+        fChordDX[i] = fChordDY[i] = 0;
+    }
+    for (int i = 0; i < count; i += 4) {
+        const skvx::float4 dx = skvx::float4::Load(fChordDX + i);
+        const skvx::float4 dy = skvx::float4::Load(fChordDY + i);
+        const skvx::float4 lengths = sqrt(dx * dx + dy * dy);
+        if (!all(lengths < SK_FloatInfinity)) {
+            // A squared length overflowed (or is NaN); SkPoint::Length handles that.
+            for (int j = i; j < std::min(i + 4, count); ++j) {
+                fChordDX[j] = SkPoint::Length(fChordDX[j], fChordDY[j]);
+            }
+        } else {
+            lengths.store(fChordDX + i);
+        }
+    }
+
+    // The distances have to be accumulated in order, skipping the chords that are too short to
+    // make a difference.
+    const int oldSize = fSegments.size();
+    SkContourMeasure::Segment* segs = fSegments.append(count);
+    int segCount = 0;
+    for (int i = 0; i < count; ++i) {
+        SkScalar prevD = distance;
+        distance += fChordDX[i];
+        if (distance > prevD) {
+            SkContourMeasure::Segment* seg = &segs[segCount++];
+            seg->fDistance = distance;
+            seg->fPtIndex = ptIndex;
+            seg->fType = segType;
+            seg->fTValue = fChordTValues[i];
+        }
+    }
+    fSegments.resize(oldSize + segCount);
+    return distance;
+}
+
+void SkContourMeasureIter::Impl::subdivide_quad(const SkPoint pts[3], int mint, int maxt,
+                                                int recursionDepth) {
     if (recursionDepth < kMaxRecursionDepth &&
         tspan_big_enough(maxt - mint) && quad_too_curvy(pts, fTolerance)) {
         SkPoint tmp[5];
@@ -227,60 +287,47 @@ SkScalar SkContourMeasureIter::Impl::compute_quad_segs(const SkPoint pts[3], SkS
 
         SkChopQuadAtHalf(pts, tmp);
         recursionDepth += 1;
-        distance = this->compute_quad_segs(tmp, distance, mint, halft, ptIndex, recursionDepth);
-        distance = this->compute_quad_segs(&tmp[2], distance, halft, maxt, ptIndex, recursionDepth);
+        this->subdivide_quad(tmp, mint, halft, recursionDepth);
+        this->subdivide_quad(&tmp[2], halft, maxt, recursionDepth);
     } else {
-        SkScalar d = SkPoint::Distance(pts[0], pts[2]);
-        SkScalar prevD = distance;
-        distance += d;
-        if (distance > prevD) {
-            SkASSERT(ptIndex < (unsigned)fPts.size());
-            SkContourMeasure::Segment* seg = fSegments.append();
-            seg->fDistance = distance;
-            seg->fPtIndex = ptIndex;
-            seg->fType = kQuad_SegType;
-            seg->fTValue = maxt;
-        }
+        this->add_chord(pts[0], pts[2], maxt);
     }
-    return distance;
 }
 
-SkScalar SkContourMeasureIter::Impl::compute_conic_segs(const SkConic& conic, SkScalar distance,
-                                                        int mint, const SkPoint& minPt,
-                                                        int maxt, const SkPoint& maxPt,
-                                                        unsigned ptIndex, int recursionDepth) {
+SkScalar SkContourMeasureIter::Impl::compute_quad_segs(const SkPoint pts[3], SkScalar distance,
+                                                       unsigned ptIndex) {
+    this->subdivide_quad(pts, 0, kMaxTValue, 0);
+    return this->compute_chord_segs(distance, ptIndex, kQuad_SegType);
+}
+
+void SkContourMeasureIter::Impl::subdivide_conic(const SkConic& conic,
+                                                 int mint, const SkPoint& minPt,
+                                                 int maxt, const SkPoint& maxPt,
+                                                 int recursionDepth) {
     int halft = (mint + maxt) >> 1;
     SkPoint halfPt = conic.evalAt(tValue2Scalar(halft));
     if (!halfPt.isFinite()) {
-        return distance;
+        return;
     }
     if (recursionDepth < kMaxRecursionDepth &&
         tspan_big_enough(maxt - mint) && conic_too_curvy(minPt, halfPt, maxPt, fTolerance))
     {
         recursionDepth += 1;
-        distance = this->compute_conic_segs(conic, distance, mint, minPt, halft, halfPt,
-                                            ptIndex, recursionDepth);
-        distance = this->compute_conic_segs(conic, distance, halft, halfPt, maxt, maxPt,
-                                            ptIndex, recursionDepth);
+        this->subdivide_conic(conic, mint, minPt, halft, halfPt, recursionDepth);
+        this->subdivide_conic(conic, halft, halfPt, maxt, maxPt, recursionDepth);
     } else {
-        SkScalar d = SkPoint::Distance(minPt, maxPt);
-        SkScalar prevD = distance;
-        distance += d;
-        if (distance > prevD) {
-            SkASSERT(ptIndex < (unsigned)fPts.size());
-            SkContourMeasure::Segment* seg = fSegments.append();
-            seg->fDistance = distance;
-            seg->fPtIndex = ptIndex;
-            seg->fType = kConic_SegType;
-            seg->fTValue = maxt;
-        }
+        this->add_chord(minPt, maxPt, maxt);
     }
-    return distance;
 }
 
-SkScalar SkContourMeasureIter::Impl::compute_cubic_segs(const SkPoint pts[4], SkScalar distance,
-                                                        int mint, int maxt, unsigned ptIndex,
-                                                        int recursionDepth) {
+SkScalar SkContourMeasureIter::Impl::compute_conic_segs(const SkConic& conic, SkScalar distance,
+                                                        unsigned ptIndex) {
+    this->subdivide_conic(conic, 0, conic.fPts[0], kMaxTValue, conic.fPts[2], 0);
+    return this->compute_chord_segs(distance, ptIndex, kConic_SegType);
+}
+
+void SkContourMeasureIter::Impl::subdivide_cubic(const SkPoint pts[4], int mint, int maxt,
+                                                 int recursionDepth) {
     if (recursionDepth < kMaxRecursionDepth &&
         tspan_big_enough(maxt - mint) && cubic_too_curvy(pts, fTolerance))
     {
@@ -289,24 +336,17 @@ SkScalar SkContourMeasureIter::Impl::compute_cubic_segs(const SkPoint pts[4], Sk
 
         SkChopCubicAtHalf(pts, tmp);
         recursionDepth += 1;
-        distance = this->compute_cubic_segs(tmp, distance, mint, halft,
-                                            ptIndex, recursionDepth);
-        distance = this->compute_cubic_segs(&tmp[3], distance, halft, maxt,
-                                            ptIndex, recursionDepth);
+        this->subdivide_cubic(tmp, mint, halft, recursionDepth);
+        this->subdivide_cubic(&tmp[3], halft, maxt, recursionDepth);
     } else {
-        SkScalar d = SkPoint::Distance(pts[0], pts[3]);
-        SkScalar prevD = distance;
-        distance += d;
-        if (distance > prevD) {
-            SkASSERT(ptIndex < (unsigned)fPts.size());
-            SkContourMeasure::Segment* seg = fSegments.append();
-            seg->fDistance = distance;
-            seg->fPtIndex = ptIndex;
-            seg->fType = kCubic_SegType;
-            seg->fTValue = maxt;
-        }
+        this->add_chord(pts[0], pts[3], maxt);
     }
-    return distance;
+}
+
+SkScalar SkContourMeasureIter::Impl::compute_cubic_segs(const SkPoint pts[4], SkScalar distance,
+                                                        unsigned ptIndex) {
+    this->subdivide_cubic(pts, 0, kMaxTValue, 0);
+    return this->compute_chord_segs(distance, ptIndex, kCubic_SegType);
 }
 
 SkScalar SkContourMeasureIter::Impl::compute_line_seg(SkPoint p0, SkPoint p1, SkScalar distance,
@@ -397,7 +437,7 @@ SkContourMeasure* SkContourMeasureIter::Impl::buildSegments() {
             case SkPathVerb::kQuad: {
                 SkASSERT(haveSeenMoveTo);
                 SkScalar prevD = distance;
-                distance = this->compute_quad_segs(pts, distance, 0, kMaxTValue, ptIndex);
+                distance = this->compute_quad_segs(pts, distance, ptIndex);
                 if (distance > prevD) {
                     fPts.append(2, pts + 1);
                     ptIndex += 2;
@@ -408,8 +448,7 @@ SkContourMeasure* SkContourMeasureIter::Impl::buildSegments() {
                 SkASSERT(haveSeenMoveTo);
                 const SkConic conic(pts, *w);
                 SkScalar prevD = distance;
-                distance = this->compute_conic_segs(conic, distance, 0, conic.fPts[0],
-                                                    kMaxTValue, conic.fPts[2], ptIndex);
+                distance = this->compute_conic_segs(conic, distance, ptIndex);
                 if (distance > prevD) {
                     // we store the conic weight in our next point, followed by the last 2 pts
                     // thus to reconstitue a conic, you'd need to say
@@ -423,7 +462,7 @@ SkContourMeasure* SkContourMeasureIter::Impl::buildSegments() {
             case SkPathVerb::kCubic: {
                 SkASSERT(haveSeenMoveTo);
                 SkScalar prevD = distance;
-                distance = this->compute_cubic_segs(pts, distance, 0, kMaxTValue, ptIndex);
+                distance = this->compute_cubic_segs(pts, distance, ptIndex);
                 if (distance > prevD) {
                     fPts.append(3, pts + 1);
                     ptIndex += 3;
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkContourMeasureCache.h"
+
+#include "include/core/SkPath.h"
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkPathMeasurePriv.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+using namespace skia_private;
+
+namespace {
+static unsigned gMeasuredPathKeyNamespaceLabel;
+
+struct MeasuredPathKey : public SkResourceCache::Key {
+public:
+    MeasuredPathKey(uint32_t genID, bool forceClosed, SkScalar resScale)
+            : fGenID(genID), fForceClosed(forceClosed), fResScale(resScale) {
+        this->init(&gMeasuredPathKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fForceClosed) + sizeof(fResScale));
+    }
+
+    const uint32_t fGenID;
+    const uint32_t fForceClosed;
+    const SkScalar fResScale;
+};
+
+class MeasuredPathRec : public SkResourceCache::Rec {
+public:
+    MeasuredPathRec(const MeasuredPathKey& key, sk_sp<const SkMeasuredPath> measured)
+            : fKey(key), fMeasured(std::move(measured)) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fMeasured->approximateBytesUsed();
+    }
+    const char* getCategory() const override { return "contour-measure"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        auto* result = static_cast<sk_sp<const SkMeasuredPath>*>(context);
+        *result = static_cast<const MeasuredPathRec&>(baseRec).fMeasured;
+        return true;
+    }
+
+private:
+    const MeasuredPathKey fKey;
+    const sk_sp<const SkMeasuredPath> fMeasured;
+};
+
+// When the SkPathRef genID changes, purge the contours measured for it.
+class MeasuredPathInvalidator : public SkIDChangeListener {
+public:
+    MeasuredPathInvalidator(const MeasuredPathKey& key) : fKey(key) {}
+
+private:
+    // always purge
+    static bool FindVisitor(const SkResourceCache::Rec&, void*) {
+        return false;
+    }
+
+    void changed() override {
+        SkResourceCache::Find(fKey, MeasuredPathInvalidator::FindVisitor, nullptr);
+    }
+
+    const MeasuredPathKey fKey;
+};
+}  // namespace
+
+sk_sp<const SkMeasuredPath> SkMeasuredPath::MakeUncached(const SkPath& path, bool forceClosed,
+                                                         SkScalar resScale) {
+    TArray<sk_sp<SkContourMeasure>> contours;
+    SkScalar length = 0;
+    SkContourMeasureIter iter(path, forceClosed, resScale);
+    while (sk_sp<SkContourMeasure> contour = iter.next()) {
+        length += contour->length();
+        contours.push_back(std::move(contour));
+    }
+    return sk_sp<const SkMeasuredPath>(new SkMeasuredPath(std::move(contours), length));
+}
+
+sk_sp<const SkMeasuredPath> SkMeasuredPath::Make(const SkPath& path, bool forceClosed,
+                                                 SkScalar resScale) {
+    if (path.isEmpty() || path.isVolatile()) {
+        return MakeUncached(path, forceClosed, resScale);
+    }
+
+    const MeasuredPathKey key(path.getGenerationID(), forceClosed, resScale);
+    sk_sp<const SkMeasuredPath> measured;
+    if (SkResourceCache::Find(key, MeasuredPathRec::Visitor, &measured)) {
+        return measured;
+    }
+
+    measured = MakeUncached(path, forceClosed, resScale);
+    SkPathPriv::AddGenIDChangeListener(path, sk_make_sp<MeasuredPathInvalidator>(key));
+    SkResourceCache::Add(new MeasuredPathRec(key, measured));
+    return measured;
+}
+
+size_t SkMeasuredPath::approximateBytesUsed() const {
+    size_t bytes = sizeof(*this) + fContours.size_bytes();
+    for (const sk_sp<SkContourMeasure>& contour : fContours) {
+        bytes += SkPathMeasurePriv::ApproximateBytesUsed(*contour);
+    }
+    return bytes;
+}
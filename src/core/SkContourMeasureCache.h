@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkContourMeasureCache_DEFINED
+#define SkContourMeasureCache_DEFINED
+
+#include "include/core/SkContourMeasure.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "include/private/base/SkTArray.h"
+
+#include <cstddef>
+
+class SkPath;
+
+/**
+ *  The non-zero length contours of a path, as SkContourMeasureIter returns them.
+ *
+ *  Path effects that measure their source (dash, trim, 1D) are often applied to the same path on
+ *  every frame of an animation, with only their own parameters changing. Make() keeps the measured
+ *  contours in SkResourceCache, keyed by the path's genID, so those draws only measure the path
+ *  once. The contours are immutable, and can be shared across threads.
+ */
+class SkMeasuredPath final : public SkNVRefCnt<SkMeasuredPath> {
+public:
+    /**
+     *  Returns the contours of path. Unless the path is empty or volatile, they are looked up in and
+     *  added to SkResourceCache, and purged from it when the path changes.
+     */
+    static sk_sp<const SkMeasuredPath> Make(const SkPath& path, bool forceClosed,
+                                            SkScalar resScale = 1);
+
+    /** Measures the contours of path, without the cache. For paths that are not drawn again. */
+    static sk_sp<const SkMeasuredPath> MakeUncached(const SkPath& path, bool forceClosed,
+                                                    SkScalar resScale = 1);
+
+    const sk_sp<SkContourMeasure>* begin() const { return fContours.begin(); }
+    const sk_sp<SkContourMeasure>* end() const { return fContours.end(); }
+    int count() const { return fContours.size(); }
+
+    /** The sum of the lengths of the contours. */
+    SkScalar length() const { return fLength; }
+
+    size_t approximateBytesUsed() const;
+
+private:
+    SkMeasuredPath(skia_private::TArray<sk_sp<SkContourMeasure>>&& contours, SkScalar length)
+            : fContours(std::move(contours)), fLength(length) {}
+
+    const skia_private::TArray<sk_sp<SkContourMeasure>> fContours;
+    const SkScalar fLength;
+};
+
+#endif
@@ -20,7 +20,9 @@
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkSwizzlePriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <initializer_list>
@@ -251,11 +253,33 @@ static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, int
 
     SkRasterPipeline_<256> pipeline;
     pipeline.appendLoad(srcInfo.colorType(), &src);
-    steps.apply(&pipeline);
+    switch (srcInfo.colorType()) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kRGB_888x_SkColorType:
+            steps.applyToUnorm8(&pipeline);
+            break;
+        default:
+            steps.apply(&pipeline);
+            break;
+    }
     pipeline.appendStore(dstInfo.colorType(), &dst);
     pipeline.run(0,0, srcInfo.width(), srcInfo.height());
 }
 
+static void convert_rows(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                         int dstStride,
+                         const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                         int srcStride,
+                         const SkColorSpaceXformSteps& steps) {
+    for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_alpha8}) {
+        if (fn(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps)) {
+            return;
+        }
+    }
+    convert_with_pipeline(dstInfo, dstPixels, dstStride, srcInfo, srcPixels, srcStride, steps);
+}
+
 bool SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
                      const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB) {
     SkASSERT(dstInfo.dimensions() == srcInfo.dimensions());
@@ -271,11 +295,30 @@ bool SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t d
     SkColorSpaceXformSteps steps{srcInfo.colorSpace(), srcInfo.alphaType(),
                                  dstInfo.colorSpace(), dstInfo.alphaType()};
 
-    for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_alpha8}) {
-        if (fn(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps)) {
-            return true;
-        }
+    // Every row converts independently, so large images are split into bands of rows that are
+    // converted in parallel on the default SkExecutor. The steps are only read by each band.
+    constexpr int kMinPixelsPerBand = 256 * 1024;
+    const int width = srcInfo.width(),
+              height = srcInfo.height();
+    const int rowsPerBand = std::max(1, kMinPixelsPerBand / std::max(1, width));
+    const int bandCount = (height + rowsPerBand - 1) / rowsPerBand;
+    if (bandCount <= 1) {
+        convert_rows(dstInfo, dstPixels, dstRB, dstStride,
+                     srcInfo, srcPixels, srcRB, srcStride, steps);
+        return true;
     }
-    convert_with_pipeline(dstInfo, dstPixels, dstStride, srcInfo, srcPixels, srcStride, steps);
+
+    auto convertBand = [&](int band) {
+        const int top = band * rowsPerBand;
+        const SkISize bandSize = {width, std::min(rowsPerBand, height - top)};
+        convert_rows(dstInfo.makeDimensions(bandSize),
+                     SkTAddOffset<void>(dstPixels, top * dstRB), dstRB, dstStride,
+                     srcInfo.makeDimensions(bandSize),
+                     SkTAddOffset<const void>(srcPixels, top * srcRB), srcRB, srcStride,
+                     steps);
+    };
+    SkTaskGroup bands;
+    bands.batch(bandCount, convertBand);
+    bands.wait();
     return true;
 }
@@ -73,6 +73,8 @@ public:
     void blitMask(const SkMask&, const SkIRect&) override;
     void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override;
     void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override;
+    void blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                       size_t rowBytes) override;
 
 protected:
     SkColor                fColor;
@@ -94,6 +96,8 @@ public:
     void blitMask(const SkMask&, const SkIRect&) override;
     void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override;
     void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override;
+    void blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                       size_t rowBytes) override;
 
 private:
     using INHERITED = SkARGB32_Blitter;
@@ -106,6 +110,8 @@ public:
     void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override;
     void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override;
     void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override;
+    void blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                       size_t rowBytes) override;
 
 private:
     using INHERITED = SkARGB32_Opaque_Blitter;
@@ -148,4 +154,8 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap&, const SkPaint&,
                                          bool shader_is_opaque,
                                          SkArenaAlloc*, sk_sp<SkShader> clipShader);
 
+// Returns a blitter specialized for drawing the paint's color with kSrc or kSrcOver into dst, or
+// nullptr if dst's color type or the paint is not one it handles.
+SkBlitter* SkCreateSolidColorBlitter(const SkPixmap&, const SkPaint&, SkArenaAlloc*);
+
 #endif
@@ -12,6 +12,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkDrawable.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
@@ -250,6 +251,21 @@ void SkDevice::drawEdgeAAQuad(const SkRect& r, const SkPoint clip[4], SkCanvas::
     }
 }
 
+void SkDevice::drawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                 const SkMatrix preViewMatrices[], int count,
+                                 SkCanvas::QuadAAFlags aa, SkBlendMode mode) {
+    const SkM44 baseLocalToDevice = this->localToDevice44();
+    for (int i = 0; i < count; ++i) {
+        if (preViewMatrices) {
+            this->setLocalToDevice(baseLocalToDevice * SkM44(preViewMatrices[i]));
+        }
+        this->drawEdgeAAQuad(rects[i], nullptr, aa, colors[i], mode);
+    }
+    if (preViewMatrices) {
+        this->setLocalToDevice(baseLocalToDevice);
+    }
+}
+
 void SkDevice::drawEdgeAAImageSet(const SkCanvas::ImageSetEntry images[], int count,
                                   const SkPoint dstClips[], const SkMatrix preViewMatrices[],
                                   const SkSamplingOptions& sampling, const SkPaint& paint,
@@ -368,14 +384,38 @@ void SkDevice::drawFilteredImage(const skif::Mapping& mapping,
                       this->imageInfo().colorSpace(),
                       &stats};
 
-    SkIPoint offset;
-    sk_sp<SkSpecialImage> result = as_IFB(filter)->filterImage(ctx).imageAndOffset(ctx, &offset);
-    stats.reportStats();
-    if (result) {
-        SkMatrix deviceMatrixWithOffset = mapping.layerToDevice();
-        deviceMatrixWithOffset.preTranslate(offset.fX, offset.fY);
-        this->drawSpecial(result.get(), deviceMatrixWithOffset, sampling, paint);
+    // Bound the intermediate memory by filtering and drawing the output in tiles when needed.
+    sk_sp<SkImageFilter> filterRef = sk_ref_sp(filter);
+    auto tiles = skif::ChooseOutputTiles({&filterRef, 1},
+                                         mapping,
+                                         skif::DeviceSpace<SkIRect>(this->devClipBounds()),
+                                         ctx.source().layerBounds(),
+                                         colorType,
+                                         SkGraphics::GetImageFilterTileByteLimit());
+    stats.fNumOutputTiles = tiles.size();
+
+    for (const skif::DeviceSpace<SkIRect>& tile : tiles) {
+        skif::Context tileCtx = ctx.withNewDesiredOutput(mapping.deviceToLayer(tile));
+        if (tiles.size() > 1) {
+            SkAutoDeviceTransformRestore adtr{this, SkMatrix::I()};
+            this->pushClipStack();
+            this->clipRect(SkRect::Make(SkIRect(tile)), SkClipOp::kIntersect, /*aa=*/false);
+        }
+
+        SkIPoint offset;
+        sk_sp<SkSpecialImage> result =
+                as_IFB(filter)->filterImage(tileCtx).imageAndOffset(tileCtx, &offset);
+        if (result) {
+            SkMatrix deviceMatrixWithOffset = mapping.layerToDevice();
+            deviceMatrixWithOffset.preTranslate(offset.fX, offset.fY);
+            this->drawSpecial(result.get(), deviceMatrixWithOffset, sampling, paint);
+        }
+
+        if (tiles.size() > 1) {
+            this->popClipStack();
+        }
     }
+    stats.reportStats();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
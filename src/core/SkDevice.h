@@ -404,6 +404,11 @@ public:
     virtual void drawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
                                 SkCanvas::QuadAAFlags aaFlags, const SkColor4f& color,
                                 SkBlendMode mode);
+    // Default impl calls drawEdgeAAQuad() per rect, applying each rect's pre-view matrix to the
+    // device's transform.
+    virtual void drawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                   const SkMatrix preViewMatrices[], int count,
+                                   SkCanvas::QuadAAFlags aaFlags, SkBlendMode mode);
     // Default impl uses drawImageRect per entry, being anti-aliased only when an entry's edge flags
     // are all set. If there's a clip region, it will be applied using clipPath().
     virtual void drawEdgeAAImageSet(const SkCanvas::ImageSetEntry[], int count,
@@ -54,6 +54,16 @@ static void fill_rect(const SkMatrix& ctm, const SkRasterClip& rc,
         r.toQuad(pts);
         ctm.mapPoints(pts, pts, 4);
 
+        if (!ctm.hasPerspective()) {
+            // An affine map keeps the quad convex, so two triangles sharing a diagonal cover it
+            // exactly; the scan converter gives the pixels along their shared edge to just one of
+            // them. That's much cheaper than building and filling a path for every sprite.
+            SkScan::FillTriangle(pts, rc, blitter);
+            pts[1] = pts[0];
+            SkScan::FillTriangle(pts + 1, rc, blitter);
+            return;
+        }
+
         scratchPath->rewind();
         scratchPath->addPoly(pts, 4, true);
         SkScan::FillPath(*scratchPath, rc, blitter);
@@ -128,18 +138,25 @@ void SkDraw::drawAtlas(const SkRSXform xform[],
         return;
     }
     SkPath scratchPath;
+    const SkRect clipBounds = SkRect::Make(fRC->getBounds());
 
     for (int i = 0; i < count; ++i) {
+        SkMatrix mx;
+        mx.setRSXform(xform[i]);
+        mx.preTranslate(-textures[i].fLeft, -textures[i].fTop);
+        mx.postConcat(*fCTM);
+        if (!perspective && !clipBounds.intersects(mx.mapRect(textures[i]))) {
+            // Sprites that miss the clip are common (think particles), so skip them before
+            // paying for their inverse and shader updates.
+            continue;
+        }
+
         if (colors) {
             SkColor4f c4 = SkColor4f::FromColor(colors[i]);
             steps.apply(c4.vec());
             load_color(uniformCtx, c4.premul().vec());
         }
 
-        SkMatrix mx;
-        mx.setRSXform(xform[i]);
-        mx.preTranslate(-textures[i].fLeft, -textures[i].fTop);
-        mx.postConcat(*fCTM);
         SkMatrix inv;
         if (!mx.invert(&inv)) {
             return;
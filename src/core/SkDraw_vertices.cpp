@@ -292,7 +292,17 @@ void SkDraw::drawFixedVertices(const SkVertices* vertices,
     if (!blitter) {
         return;
     }
+    const SkRect clipBounds = SkRect::Make(fRC->getBounds());
     while (vertProc(&state)) {
+        if (dev2) {
+            // Skip triangles that miss the clip before paying for their shader updates.
+            SkRect bounds;
+            SkPoint pts[] = {dev2[state.f0], dev2[state.f1], dev2[state.f2]};
+            bounds.setBounds(pts, 3);
+            if (!clipBounds.intersects(bounds)) {
+                continue;
+            }
+        }
         if (triColorShader && !triColorShader->update(ctmInverse, positions, dstColors,
                                                       state.f0, state.f1, state.f2)) {
             continue;
@@ -0,0 +1,309 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkDynamicRTree.h"
+
+#include "include/private/base/SkAssert.h"
+#include "src/base/SkVx.h"
+
+#include <algorithm>
+#include <limits>
+
+void SkDynamicRTree::insert(const SkRect boundsArray[], int N) {
+    for (int i = 0; i < N; ++i) {
+        this->insert(i, boundsArray[i]);
+    }
+}
+
+void SkDynamicRTree::insert(int index, const SkRect& bounds) {
+    SkASSERT(!fLeafForIndex.find(index));
+    if (bounds.isEmpty()) {
+        return;
+    }
+
+    if (fRoot < 0) {
+        fRoot = this->allocateNodeAtLevel(0);
+    }
+
+    int node = this->chooseLeaf(bounds);
+    int sibling = this->addChild(node, bounds, index);
+
+    // Walk up to the root, refreshing the bounds on the way and attaching any split-off sibling.
+    while (fNodes[node].fParent >= 0) {
+        const int parent = fNodes[node].fParent;
+        this->setSlot(parent, this->slotOf(parent, node), this->nodeBounds(node), node);
+        if (sibling >= 0) {
+            sibling = this->addChild(parent, this->nodeBounds(sibling), sibling);
+        }
+        node = parent;
+    }
+
+    if (sibling >= 0) {
+        // The root was split, so the tree grows by a level.
+        const int root = this->allocateNodeAtLevel(fNodes[node].fLevel + 1);
+        this->addChild(root, this->nodeBounds(node), node);
+        this->addChild(root, this->nodeBounds(sibling), sibling);
+        fRoot = root;
+    }
+}
+
+bool SkDynamicRTree::remove(int index) {
+    const int* found = fLeafForIndex.find(index);
+    if (!found) {
+        return false;
+    }
+    const int leaf = *found;
+    fLeafForIndex.remove(index);
+    this->removeSlot(leaf, this->slotOf(leaf, index));
+
+    // Walk up to the root, detaching underfull nodes and refreshing the bounds of the rest.
+    std::vector<std::pair<int, SkRect>> orphans;
+    int node = leaf;
+    while (node != fRoot) {
+        const int parent = fNodes[node].fParent;
+        const int slot = this->slotOf(parent, node);
+        if (fNodes[node].fCount < kMinChildren) {
+            this->removeSlot(parent, slot);
+            this->detachSubtree(node, &orphans);
+        } else {
+            this->setSlot(parent, slot, this->nodeBounds(node), node);
+        }
+        node = parent;
+    }
+
+    // Shrink the tree while the root has a single child.
+    while (fNodes[fRoot].fLevel > 0 && fNodes[fRoot].fCount == 1) {
+        const int child = fNodes[fRoot].fChildren[0];
+        this->freeNode(fRoot);
+        fRoot = child;
+        fNodes[fRoot].fParent = -1;
+    }
+    if (fNodes[fRoot].fCount == 0) {
+        this->freeNode(fRoot);
+        fRoot = -1;
+    }
+
+    for (const auto& [orphan, bounds] : orphans) {
+        this->insert(orphan, bounds);
+    }
+    return true;
+}
+
+void SkDynamicRTree::update(int index, const SkRect& bounds) {
+    this->remove(index);
+    this->insert(index, bounds);
+}
+
+void SkDynamicRTree::search(const SkRect& query, std::vector<int>* results) const {
+    // Rejecting empty queries here lets the per-node test assume a sorted query.
+    if (fRoot < 0 || query.isEmpty()) {
+        return;
+    }
+    const size_t start = results->size();
+    this->search(fRoot, query, results);
+    // Callers play back ops in the order we return them, so they must be increasing.
+    std::sort(results->begin() + start, results->end());
+}
+
+void SkDynamicRTree::search(int nodeIndex, const SkRect& query, std::vector<int>* results) const {
+    const Node& node = fNodes[nodeIndex];
+    const skvx::float4 qLeft(query.fLeft), qTop(query.fTop),
+                       qRight(query.fRight), qBottom(query.fBottom);
+    for (int i = 0; i < kMaxChildren; i += 4) {
+        // Same as SkRect::Intersects for a sorted, non-empty query.
+        const auto hits = (skvx::float4::Load(node.fLeft + i) < qRight) &
+                          (skvx::float4::Load(node.fTop + i) < qBottom) &
+                          (qLeft < skvx::float4::Load(node.fRight + i)) &
+                          (qTop < skvx::float4::Load(node.fBottom + i));
+        if (!any(hits)) {
+            continue;
+        }
+        for (int j = 0; j < 4; ++j) {
+            if (hits[j]) {
+                if (0 == node.fLevel) {
+                    results->push_back(node.fChildren[i + j]);
+                } else {
+                    this->search(node.fChildren[i + j], query, results);
+                }
+            }
+        }
+    }
+}
+
+size_t SkDynamicRTree::bytesUsed() const {
+    return sizeof(SkDynamicRTree) +
+           fNodes.capacity() * sizeof(Node) +
+           fFreeNodes.capacity() * sizeof(int) +
+           fLeafForIndex.approxBytesUsed();
+}
+
+int SkDynamicRTree::allocateNodeAtLevel(int level) {
+    int node;
+    if (!fFreeNodes.empty()) {
+        node = fFreeNodes.back();
+        fFreeNodes.pop_back();
+    } else {
+        node = (int)fNodes.size();
+        fNodes.emplace_back();
+    }
+    Node& n = fNodes[node];
+    n.fCount = 0;
+    n.fLevel = level;
+    n.fParent = -1;
+    for (int i = 0; i < kMaxChildren; ++i) {
+        this->clearSlot(node, i);
+    }
+    return node;
+}
+
+void SkDynamicRTree::freeNode(int node) {
+    fFreeNodes.push_back(node);
+}
+
+SkRect SkDynamicRTree::nodeBounds(int node) const {
+    const Node& n = fNodes[node];
+    SkASSERT(n.fCount > 0);
+    SkRect bounds = n.bounds(0);
+    for (int i = 1; i < n.fCount; ++i) {
+        bounds.join(n.bounds(i));
+    }
+    return bounds;
+}
+
+int SkDynamicRTree::slotOf(int node, int child) const {
+    const Node& n = fNodes[node];
+    for (int i = 0; i < n.fCount; ++i) {
+        if (n.fChildren[i] == child) {
+            return i;
+        }
+    }
+    SkUNREACHABLE;
+}
+
+int SkDynamicRTree::chooseLeaf(const SkRect& bounds) const {
+    int node = fRoot;
+    while (fNodes[node].fLevel > 0) {
+        const Node& n = fNodes[node];
+        int best = 0;
+        float bestGrowth = std::numeric_limits<float>::infinity(),
+              bestArea   = std::numeric_limits<float>::infinity();
+        for (int i = 0; i < n.fCount; ++i) {
+            const SkRect child = n.bounds(i);
+            SkRect joined = child;
+            joined.join(bounds);
+            const float area = child.width() * child.height();
+            const float growth = joined.width() * joined.height() - area;
+            if (growth < bestGrowth || (growth == bestGrowth && area < bestArea)) {
+                best = i;
+                bestGrowth = growth;
+                bestArea = area;
+            }
+        }
+        node = n.fChildren[best];
+    }
+    return node;
+}
+
+void SkDynamicRTree::setSlot(int node, int slot, const SkRect& bounds, int child) {
+    Node& n = fNodes[node];
+    n.fLeft[slot]   = bounds.fLeft;
+    n.fTop[slot]    = bounds.fTop;
+    n.fRight[slot]  = bounds.fRight;
+    n.fBottom[slot] = bounds.fBottom;
+    n.fChildren[slot] = child;
+    if (0 == n.fLevel) {
+        fLeafForIndex.set(child, node);
+    } else {
+        fNodes[child].fParent = node;
+    }
+}
+
+void SkDynamicRTree::clearSlot(int node, int slot) {
+    static constexpr float kInf = std::numeric_limits<float>::infinity();
+    Node& n = fNodes[node];
+    n.fLeft[slot] = n.fTop[slot] = kInf;
+    n.fRight[slot] = n.fBottom[slot] = -kInf;
+    n.fChildren[slot] = -1;
+}
+
+void SkDynamicRTree::removeSlot(int node, int slot) {
+    Node& n = fNodes[node];
+    const int last = --n.fCount;
+    if (slot != last) {
+        n.fLeft[slot]     = n.fLeft[last];
+        n.fTop[slot]      = n.fTop[last];
+        n.fRight[slot]    = n.fRight[last];
+        n.fBottom[slot]   = n.fBottom[last];
+        n.fChildren[slot] = n.fChildren[last];
+    }
+    this->clearSlot(node, last);
+}
+
+int SkDynamicRTree::addChild(int node, const SkRect& bounds, int child) {
+    if (fNodes[node].fCount < kMaxChildren) {
+        this->setSlot(node, fNodes[node].fCount++, bounds, child);
+        return -1;
+    }
+
+    // Split the full node plus the new child in half along the axis where their centers are
+    // most spread out.
+    struct Entry {
+        SkRect fBounds;
+        int fChild;
+    };
+    Entry entries[kMaxChildren + 1];
+    SkRect centers = SkRect::MakeEmpty();
+    for (int i = 0; i <= kMaxChildren; ++i) {
+        entries[i] = i < kMaxChildren ? Entry{fNodes[node].bounds(i), fNodes[node].fChildren[i]}
+                                      : Entry{bounds, child};
+        const SkPoint c = entries[i].fBounds.center();
+        if (i == 0) {
+            centers.setLTRB(c.fX, c.fY, c.fX, c.fY);
+        } else {
+            centers.fLeft   = std::min(centers.fLeft,   c.fX);
+            centers.fTop    = std::min(centers.fTop,    c.fY);
+            centers.fRight  = std::max(centers.fRight,  c.fX);
+            centers.fBottom = std::max(centers.fBottom, c.fY);
+        }
+    }
+    if (centers.width() >= centers.height()) {
+        std::sort(entries, entries + kMaxChildren + 1, [](const Entry& a, const Entry& b) {
+            return a.fBounds.centerX() < b.fBounds.centerX();
+        });
+    } else {
+        std::sort(entries, entries + kMaxChildren + 1, [](const Entry& a, const Entry& b) {
+            return a.fBounds.centerY() < b.fBounds.centerY();
+        });
+    }
+
+    const int sibling = this->allocateNodeAtLevel(fNodes[node].fLevel);
+    for (int i = 0; i < kMaxChildren; ++i) {
+        this->clearSlot(node, i);
+    }
+    fNodes[node].fCount = 0;
+
+    static constexpr int kKept = (kMaxChildren + 1) / 2;
+    static_assert(kKept >= kMinChildren && kMaxChildren + 1 - kKept >= kMinChildren);
+    for (int i = 0; i <= kMaxChildren; ++i) {
+        const int target = i < kKept ? node : sibling;
+        this->setSlot(target, fNodes[target].fCount++, entries[i].fBounds, entries[i].fChild);
+    }
+    return sibling;
+}
+
+void SkDynamicRTree::detachSubtree(int node, std::vector<std::pair<int, SkRect>>* orphans) {
+    const Node& n = fNodes[node];
+    for (int i = 0; i < n.fCount; ++i) {
+        if (0 == n.fLevel) {
+            fLeafForIndex.remove(n.fChildren[i]);
+            orphans->push_back({n.fChildren[i], n.bounds(i)});
+        } else {
+            this->detachSubtree(n.fChildren[i], orphans);
+        }
+    }
+    this->freeNode(node);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDynamicRTree_DEFINED
+#define SkDynamicRTree_DEFINED
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkRect.h"
+#include "src/core/SkTHash.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * An R-Tree that, unlike SkRTree, can be updated one bounding box at a time. This lets a client
+ * that re-records a small part of a scene update the index for just those draws instead of
+ * rebuilding it from scratch.
+ *
+ * Insertion descends to the leaf whose bounds grow least and splits full nodes in half along the
+ * axis where their children's centers are most spread out. Removal reinserts the entries of nodes
+ * that become underfull. Each node stores its children's bounds as separate edge arrays so that
+ * search can test four children per compare.
+ *
+ * Building from a batch is slower than SkRTree's bulk load, so prefer SkRTree for bounds that
+ * never change.
+ *
+ * For more details see:
+ *
+ *  Guttman, A. (1984). "R-Trees: A Dynamic Index Structure for Spatial Searching"
+ */
+class SkDynamicRTree final : public SkBBoxHierarchy {
+public:
+    SkDynamicRTree() = default;
+
+    // Inserts each rect with its position in the array as its index.
+    void insert(const SkRect[], int N) override;
+    using SkBBoxHierarchy::insert;
+
+    // Inserts a single bounding box. 'index' must not already be in the tree. Empty rects are
+    // ignored, as they are by SkRTree.
+    void insert(int index, const SkRect& bounds);
+
+    // Removes 'index' from the tree. Returns false if it was not in the tree.
+    bool remove(int index);
+
+    // Moves 'index' to new bounds, inserting it if it was not in the tree.
+    void update(int index, const SkRect& bounds);
+
+    // Results are in increasing index order.
+    void search(const SkRect& query, std::vector<int>* results) const override;
+    size_t bytesUsed() const override;
+
+    // Methods and constants below here are only public for tests.
+
+    // Return the depth of the tree structure.
+    int getDepth() const { return fRoot >= 0 ? fNodes[fRoot].fLevel + 1 : 0; }
+    // Number of indices in the tree.
+    int getCount() const { return fLeafForIndex.count(); }
+
+    // A multiple of four, so that search can test a node's children four at a time.
+    static constexpr int kMinChildren = 4,
+                         kMaxChildren = 12;
+
+private:
+    static_assert(kMaxChildren % 4 == 0);
+
+    struct Node {
+        int fCount;
+        int fLevel;   // 0 for leaves.
+        int fParent;  // -1 for the root.
+        // Unused slots hold inverted, infinite bounds that never intersect a query.
+        float fLeft[kMaxChildren];
+        float fTop[kMaxChildren];
+        float fRight[kMaxChildren];
+        float fBottom[kMaxChildren];
+        // Op indices in leaves; node indices above them.
+        int fChildren[kMaxChildren];
+
+        SkRect bounds(int slot) const {
+            return {fLeft[slot], fTop[slot], fRight[slot], fBottom[slot]};
+        }
+    };
+
+    int allocateNodeAtLevel(int level);
+    void freeNode(int node);
+
+    SkRect nodeBounds(int node) const;
+    int slotOf(int node, int child) const;
+    int chooseLeaf(const SkRect& bounds) const;
+
+    void setSlot(int node, int slot, const SkRect& bounds, int child);
+    void clearSlot(int node, int slot);
+    void removeSlot(int node, int slot);
+
+    // Adds a child to a node. If the node was full it is split, and the new sibling (which has
+    // not been attached to a parent yet) is returned. Otherwise returns -1.
+    int addChild(int node, const SkRect& bounds, int child);
+
+    // Removes a subtree, appending the entries of its leaves to 'orphans'.
+    void detachSubtree(int node, std::vector<std::pair<int, SkRect>>* orphans);
+
+    void search(int node, const SkRect& query, std::vector<int>* results) const;
+
+    std::vector<Node> fNodes;
+    std::vector<int> fFreeNodes;
+    int fRoot = -1;
+    skia_private::THashMap<int, int> fLeafForIndex;
+};
+
+#endif
@@ -24,6 +24,52 @@
 #include "src/core/SkLineClipper.h"
 #include "src/core/SkPathPriv.h"
 
+#include <type_traits>
+
+SkEdgeBuilder::SkEdgeBuilder()
+        : fStorage(AcquireStorage(&fOwnedStorage))
+        , fList(fStorage->fList) {}
+
+SkEdgeBuilder::~SkEdgeBuilder() {
+    // Keep the storage for the next fill, unless this fill needed much more than most do.
+    constexpr int    kMaxRetainedEdges     = 16 * 1024;
+    constexpr size_t kMaxRetainedPolyBytes = 1024 * 1024;
+    for (SkTDArray<void*>* edges : {&fStorage->fList, &fStorage->fSorted}) {
+        if (edges->capacity() > kMaxRetainedEdges) {
+            edges->reset();
+        }
+        edges->clear();
+    }
+    if (fStorage->fRowEnds.capacity() > 4 * kMaxRetainedEdges) {
+        fStorage->fRowEnds.reset();
+    }
+    fStorage->fRowEnds.clear();
+    if (fStorage->fPolyEdgesSize > kMaxRetainedPolyBytes) {
+        fStorage->fPolyEdges.reset();
+        fStorage->fPolyEdgesSize = 0;
+    }
+    fStorage->fInUse = false;
+}
+
+SkEdgeBuilder::Storage* SkEdgeBuilder::AcquireStorage(std::unique_ptr<Storage>* owned) {
+    static thread_local Storage gThreadStorage;
+    if (gThreadStorage.fInUse) {
+        *owned = std::make_unique<Storage>();
+        (*owned)->fInUse = true;
+        return owned->get();
+    }
+    gThreadStorage.fInUse = true;
+    return &gThreadStorage;
+}
+
+char* SkEdgeBuilder::Storage::polyEdges(size_t size) {
+    if (size > fPolyEdgesSize) {
+        fPolyEdges.reset(new char[size]);
+        fPolyEdgesSize = size;
+    }
+    return fPolyEdges.get();
+}
+
 SkEdgeBuilder::Combine SkBasicEdgeBuilder::combineVertical(const SkEdge* edge, SkEdge* last) {
     // We only consider edges that were originally lines to be vertical to avoid numerical issues
     // (crbug.com/1154864).
@@ -222,13 +268,17 @@ SkRect SkAnalyticEdgeBuilder::recoverClip(const SkIRect& src) const {
     return SkRect::Make(src);
 }
 
-char* SkBasicEdgeBuilder::allocEdges(size_t n, size_t* size) {
-    *size = sizeof(SkEdge);
-    return (char*)fAlloc.makeArrayDefault<SkEdge>(n);
+// Polygon edges are set up in place in fStorage, without being constructed.
+static_assert(std::is_trivially_default_constructible<SkEdge>::value);
+static_assert(std::is_trivially_default_constructible<SkAnalyticEdge>::value);
+static_assert(sizeof(SkEdge) % alignof(char*) == 0);
+static_assert(sizeof(SkAnalyticEdge) % alignof(char*) == 0);
+
+size_t SkBasicEdgeBuilder::edgeSize() const {
+    return sizeof(SkEdge);
 }
-char* SkAnalyticEdgeBuilder::allocEdges(size_t n, size_t* size) {
-    *size = sizeof(SkAnalyticEdge);
-    return (char*)fAlloc.makeArrayDefault<SkAnalyticEdge>(n);
+size_t SkAnalyticEdgeBuilder::edgeSize() const {
+    return sizeof(SkAnalyticEdge);
 }
 
 // TODO: maybe get rid of buildPoly() entirely?
@@ -245,11 +295,17 @@ int SkEdgeBuilder::buildPoly(const SkPath& path, const SkIRect* iclip, bool canC
         }
     }
 
-    size_t edgeSize;
-    char* edge = this->allocEdges(maxEdgeCount, &edgeSize);
+    // The edges, followed by the list of pointers to them.
+    const size_t edgeSize = this->edgeSize();
+    SkSafeMath safe;
+    const size_t storageSize = safe.mul(maxEdgeCount, edgeSize + sizeof(char*));
+    if (!safe) {
+        return 0;
+    }
+    char* edge = fStorage->polyEdges(storageSize);
 
     SkDEBUGCODE(char* edgeStart = edge);
-    char** edgePtr = fAlloc.makeArrayDefault<char*>(maxEdgeCount);
+    char** edgePtr = reinterpret_cast<char**>(edge + maxEdgeCount * edgeSize);
     fEdgeList = (void**)edgePtr;
 
     SkPathEdgeIter iter(path);
@@ -9,9 +9,15 @@
 
 #include "include/core/SkRect.h"
 #include "include/private/base/SkTDArray.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkTSort.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 
 class SkPath;
 struct SkAnalyticEdge;
@@ -23,14 +29,37 @@ public:
     int buildEdges(const SkPath& path,
                    const SkIRect* shiftedClip);
 
+    // Sorts the count edges from buildEdges() by their top row, and then within each row with
+    // lessThan(). When there are many edges they are first bucketed by row with a counting sort,
+    // so that only the edges that start on the same row are compared with each other.
+    template <typename Edge, typename TopRow, typename LessThan>
+    void sortEdges(int count, TopRow topRow, LessThan lessThan);
+
 protected:
-    SkEdgeBuilder() = default;
-    virtual ~SkEdgeBuilder() = default;
+    SkEdgeBuilder();
+    virtual ~SkEdgeBuilder();
+
+    // The edge lists, polygon edges and sorting buckets of each fill are kept by the thread for
+    // the next fill, so that filling many paths doesn't allocate them again each time.
+    struct Storage {
+        SkTDArray<void*>        fList;
+        SkTDArray<void*>        fSorted;
+        SkTDArray<int>          fRowEnds;
+        std::unique_ptr<char[]> fPolyEdges;
+        size_t                  fPolyEdgesSize = 0;
+        bool                    fInUse = false;
+
+        char* polyEdges(size_t size);
+    };
+
+    // Only used if another builder on this thread is already using the thread's storage.
+    std::unique_ptr<Storage> fOwnedStorage;
+    Storage*                 fStorage;
 
     // In general mode we allocate pointers in fList and fEdgeList points to its head.
-    // In polygon mode we preallocated edges contiguously in fAlloc and fEdgeList points there.
+    // In polygon mode we preallocated edges contiguously in fStorage and fEdgeList points there.
     void**              fEdgeList = nullptr;
-    SkTDArray<void*>    fList;
+    SkTDArray<void*>&   fList;
     SkSTArenaAlloc<512> fAlloc;
 
     enum Combine {
@@ -40,10 +69,12 @@ protected:
     };
 
 private:
+    static Storage* AcquireStorage(std::unique_ptr<Storage>* owned);
+
     int build    (const SkPath& path, const SkIRect* clip, bool clipToTheRight);
     int buildPoly(const SkPath& path, const SkIRect* clip, bool clipToTheRight);
 
-    virtual char* allocEdges(size_t n, size_t* sizeof_edge) = 0;
+    virtual size_t edgeSize() const = 0;
     virtual SkRect recoverClip(const SkIRect&) const = 0;
 
     virtual void addLine (const SkPoint pts[]) = 0;
@@ -52,6 +83,54 @@ private:
     virtual Combine addPolyLine(const SkPoint pts[], char* edge, char** edgePtr) = 0;
 };
 
+template <typename Edge, typename TopRow, typename LessThan>
+void SkEdgeBuilder::sortEdges(int count, TopRow topRow, LessThan lessThan) {
+    Edge** list = reinterpret_cast<Edge**>(fEdgeList);
+
+    // Below this, or when the edges are spread over too many rows, quicksort is faster.
+    constexpr int kMinBucketSortCount = 64;
+    if (count >= kMinBucketSortCount) {
+        int minRow = topRow(list[0]),
+            maxRow = minRow;
+        for (int i = 1; i < count; ++i) {
+            const int row = topRow(list[i]);
+            minRow = std::min(minRow, row);
+            maxRow = std::max(maxRow, row);
+        }
+        const int64_t rowCount = (int64_t)maxRow - minRow + 1;
+        if (rowCount <= 4 * (int64_t)count) {
+            SkTDArray<int>& rowEnds = fStorage->fRowEnds;
+            rowEnds.resize(SkToInt(rowCount));
+            memset(rowEnds.begin(), 0, rowEnds.size_bytes());
+            for (int i = 0; i < count; ++i) {
+                rowEnds[topRow(list[i]) - minRow] += 1;
+            }
+            int start = 0;
+            for (int& end : rowEnds) {
+                start += end;
+                end = start - end;  // The start of the row, for now.
+            }
+
+            SkTDArray<void*>& sorted = fStorage->fSorted;
+            sorted.resize(count);
+            Edge** buckets = reinterpret_cast<Edge**>(sorted.begin());
+            for (int i = 0; i < count; ++i) {
+                buckets[rowEnds[topRow(list[i]) - minRow]++] = list[i];
+            }
+            start = 0;
+            for (int end : rowEnds) {
+                if (end - start > 1) {
+                    SkTQSort(buckets + start, buckets + end, lessThan);
+                }
+                start = end;
+            }
+            memcpy(list, buckets, count * sizeof(Edge*));
+            return;
+        }
+    }
+    SkTQSort(list, list + count, lessThan);
+}
+
 class SkBasicEdgeBuilder final : public SkEdgeBuilder {
 public:
     explicit SkBasicEdgeBuilder(int clipShift) : fClipShift(clipShift) {}
@@ -61,7 +140,7 @@ public:
 private:
     Combine combineVertical(const SkEdge* edge, SkEdge* last);
 
-    char* allocEdges(size_t, size_t*) override;
+    size_t edgeSize() const override;
     SkRect recoverClip(const SkIRect&) const override;
 
     void addLine (const SkPoint pts[]) override;
@@ -81,7 +160,7 @@ public:
 private:
     Combine combineVertical(const SkAnalyticEdge* edge, SkAnalyticEdge* last);
 
-    char* allocEdges(size_t, size_t*) override;
+    size_t edgeSize() const override;
     SkRect recoverClip(const SkIRect&) const override;
 
     void addLine (const SkPoint pts[]) override;
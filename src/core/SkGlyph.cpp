@@ -16,14 +16,17 @@
 #include "include/core/SkSpan.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTFitsIn.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkBezierCurves.h"
+#include "src/core/SkPathPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include <tuple>
@@ -256,6 +259,8 @@ void SkGlyph::installPath(SkArenaAlloc* alloc, const SkPath* path, bool hairline
     fPathData = alloc->make<SkGlyph::PathData>();
     if (path != nullptr) {
         fPathData->fPath = *path;
+        // Glyph paths live as long as the strike, so don't keep any unused capacity.
+        SkPathPriv::ShrinkToFit(&fPathData->fPath);
         fPathData->fPath.updateBoundsCache();
         fPathData->fPath.getGenerationID();
         fPathData->fHasPath = true;
@@ -346,12 +351,98 @@ void SkGlyph::flattenMetrics(SkWriteBuffer& buffer) const {
     buffer.writeUInt(SkTo<uint32_t>(fMaskFormat));
 }
 
+namespace {
+// Glyph masks are mostly runs of empty or fully covered pixels, so images are run-length encoded
+// when sent to another process. The encoding is a sequence of control bytes, each followed by:
+//   - control < 128: control + 1 literal bytes.
+//   - control >= 128: one byte to repeat (control - 128) + kMinRun times.
+constexpr size_t kMinRun = 3;
+constexpr size_t kMaxRun = 127 + kMinRun;
+constexpr size_t kMaxLiterals = 128;
+
+// Encodes 'size' bytes of 'src' into 'dst', which holds 'size' bytes. Returns the encoded size, or
+// 0 if the encoding would not be smaller than 'src'.
+size_t encode_image_runs(const uint8_t* src, size_t size, uint8_t* dst) {
+    size_t out = 0;
+    size_t literalStart = 0;
+    auto flushLiterals = [&](size_t end) {
+        while (literalStart < end) {
+            size_t count = std::min(end - literalStart, kMaxLiterals);
+            if (out + 1 + count >= size) {
+                return false;
+            }
+            dst[out++] = SkTo<uint8_t>(count - 1);
+            memcpy(dst + out, src + literalStart, count);
+            out += count;
+            literalStart += count;
+        }
+        return true;
+    };
+
+    size_t i = 0;
+    while (i < size) {
+        size_t run = 1;
+        while (i + run < size && run < kMaxRun && src[i + run] == src[i]) {
+            run++;
+        }
+        if (run < kMinRun) {
+            i += run;
+            continue;
+        }
+        if (!flushLiterals(i) || out + 2 >= size) {
+            return 0;
+        }
+        dst[out++] = SkTo<uint8_t>(128 + run - kMinRun);
+        dst[out++] = src[i];
+        i += run;
+        literalStart = i;
+    }
+    return flushLiterals(size) ? out : 0;
+}
+
+// Decodes 'srcSize' bytes of runs into exactly 'dstSize' bytes of 'dst'.
+bool decode_image_runs(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < srcSize) {
+        const uint8_t control = src[in++];
+        if (control < 128) {
+            size_t count = control + 1;
+            if (count > srcSize - in || count > dstSize - out) {
+                return false;
+            }
+            memcpy(dst + out, src + in, count);
+            in += count;
+            out += count;
+        } else {
+            size_t count = control - 128 + kMinRun;
+            if (in == srcSize || count > dstSize - out) {
+                return false;
+            }
+            memset(dst + out, src[in++], count);
+            out += count;
+        }
+    }
+    return out == dstSize;
+}
+}  // namespace
+
 void SkGlyph::flattenImage(SkWriteBuffer& buffer) const {
     SkASSERT(this->setImageHasBeenCalled());
 
     // If the glyph is empty or too big, then no image data is sent.
     if (!this->isEmpty() && SkGlyphDigest::FitsInAtlas(*this)) {
-        buffer.writeByteArray(this->image(), this->imageSize());
+        // The image is sent as is when the runs don't make it smaller, which the reader can tell
+        // by the array having the full size of the image.
+        const size_t imageSize = this->imageSize();
+        skia_private::AutoSTMalloc<1024, uint8_t> runs(imageSize);
+        const size_t runsSize =
+                encode_image_runs(static_cast<const uint8_t*>(this->image()), imageSize, runs.get());
+        if (runsSize > 0) {
+            buffer.writeByteArray(runs.get(), runsSize);
+        } else {
+            buffer.writeByteArray(this->image(), imageSize);
+        }
     }
 }
 
@@ -365,8 +456,19 @@ size_t SkGlyph::addImageFromBuffer(SkReadBuffer& buffer, SkArenaAlloc* alloc) {
 
     size_t memoryIncrease = 0;
 
-    void* imageData = alloc->makeBytesAlignedTo(this->imageSize(), this->formatAlignment());
-    buffer.readByteArray(imageData, this->imageSize());
+    const size_t imageSize = this->imageSize();
+    size_t dataSize;
+    const void* data = buffer.skipByteArray(&dataSize);
+    if (!buffer.isValid()) {
+        return 0;
+    }
+    void* imageData = alloc->makeBytesAlignedTo(imageSize, this->formatAlignment());
+    if (dataSize == imageSize) {
+        memcpy(imageData, data, imageSize);
+    } else {
+        buffer.validate(decode_image_runs(static_cast<const uint8_t*>(data), dataSize,
+                                          static_cast<uint8_t*>(imageData), imageSize));
+    }
     if (buffer.isValid()) {
         this->installImage(imageData);
         memoryIncrease += this->imageSize();
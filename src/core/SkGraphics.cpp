@@ -11,14 +11,19 @@
 #include "src/core/SkBlitMask.h"
 #include "src/core/SkBlitRow.h"
 #include "src/core/SkCpu.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkRasterPipelineProfile.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "src/core/SkTypefaceCache.h"
 
+#include <atomic>
+
 void SkGraphics::Init() {
     // SkGraphics::Init() must be thread-safe and idempotent.
     SkCpu::CacheRuntimeFeatures();
@@ -35,12 +40,15 @@ void SkGraphics::Init() {
 void SkGraphics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
   SkResourceCache::DumpMemoryStatistics(dump);
   SkStrikeCache::DumpMemoryStatistics(dump);
+  SkRasterPipelineProfile::DumpStatistics(dump);
+  SkImageFilterCache::DumpMemoryStatistics(dump);
 }
 
 void SkGraphics::PurgeAllCaches() {
     SkGraphics::PurgeFontCache();
     SkGraphics::PurgeResourceCache();
     SkImageFilter_Base::PurgeCache();
+    SkRuntimeEffectPriv::PurgeCache();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -90,6 +98,34 @@ int SkGraphics::SetTypefaceCacheCountLimit(int count) {
     return prev;
 }
 
+static std::atomic<size_t> gImageFilterTileByteLimit{0};
+
+size_t SkGraphics::GetImageFilterTileByteLimit() {
+    return gImageFilterTileByteLimit.load(std::memory_order_relaxed);
+}
+
+size_t SkGraphics::SetImageFilterTileByteLimit(size_t newLimit) {
+    return gImageFilterTileByteLimit.exchange(newLimit, std::memory_order_relaxed);
+}
+
+static std::atomic<bool> gSparseStripPathRasterizer{false};
+
+bool SkGraphics::GetSparseStripPathRasterizer() {
+    return gSparseStripPathRasterizer.load(std::memory_order_relaxed);
+}
+
+bool SkGraphics::SetSparseStripPathRasterizer(bool enabled) {
+    return gSparseStripPathRasterizer.exchange(enabled, std::memory_order_relaxed);
+}
+
+int SkGraphics::GetRuntimeEffectCacheCountLimit() {
+    return SkRuntimeEffectPriv::GetCacheCountLimit();
+}
+
+int SkGraphics::SetRuntimeEffectCacheCountLimit(int count) {
+    return SkRuntimeEffectPriv::SetCacheCountLimit(count);
+}
+
 static SkGraphics::OpenTypeSVGDecoderFactory gSVGDecoderFactory = nullptr;
 
 SkGraphics::OpenTypeSVGDecoderFactory
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkImageContentHash.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+
+namespace {
+
+// Pixmaps are hashed in bands of about this many bytes, which can be hashed in parallel.
+constexpr size_t kBandBytes = 1 << 20;
+
+// The seeds keep the hashes of encoded data and of pixels apart.
+enum Seed : uint64_t {
+    kPixelsSeed = 1,
+    kEncodedSeed = 2,
+};
+
+uint64_t hash_info(const SkImageInfo& info, uint64_t seed) {
+    const SkColorSpace* cs = info.colorSpace();
+    const uint32_t header[] = {
+        static_cast<uint32_t>(info.width()),
+        static_cast<uint32_t>(info.height()),
+        static_cast<uint32_t>(info.colorType()),
+        static_cast<uint32_t>(info.alphaType()),
+        cs ? cs->toXYZD50Hash() : 0,
+        cs ? cs->transferFnHash() : 0,
+    };
+    return SkChecksum::Hash64(header, sizeof(header), seed);
+}
+
+}  // namespace
+
+namespace SkImageContentHash {
+
+uint64_t Hash(const SkPixmap& pm, SkExecutor* executor) {
+    const uint64_t infoHash = hash_info(pm.info(), kPixelsSeed);
+    const size_t rowBytes = pm.info().minRowBytes();
+    if (pm.addr() == nullptr || rowBytes == 0) {
+        return infoHash;
+    }
+
+    const int rowsPerBand = std::max<int>(1, kBandBytes / rowBytes);
+    const int bandCount = (pm.height() + rowsPerBand - 1) / rowsPerBand;
+    skia_private::AutoSTArray<16, uint64_t> bandHashes(bandCount);
+    auto hashBand = [&](int band) {
+        const int top = band * rowsPerBand;
+        const int bottom = std::min(top + rowsPerBand, pm.height());
+        // Row by row, so that padding doesn't change the hash.
+        uint64_t hash = 0;
+        for (int y = top; y < bottom; ++y) {
+            hash = SkChecksum::Hash64(pm.addr(0, y), rowBytes, hash);
+        }
+        bandHashes[band] = hash;
+    };
+
+    if (executor && bandCount > 1) {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(bandCount, hashBand);
+        taskGroup.wait();
+    } else {
+        for (int band = 0; band < bandCount; ++band) {
+            hashBand(band);
+        }
+    }
+    return SkChecksum::Hash64(bandHashes.get(), bandCount * sizeof(uint64_t), infoHash);
+}
+
+std::optional<uint64_t> Hash(const SkImage* image, SkExecutor* executor) {
+    if (!image) {
+        return std::nullopt;
+    }
+    if (sk_sp<SkData> encoded = image->refEncodedData()) {
+        return SkChecksum::Hash64(encoded->data(), encoded->size(),
+                                  hash_info(image->imageInfo(), kEncodedSeed));
+    }
+    SkPixmap pm;
+    if (image->peekPixels(&pm)) {
+        return Hash(pm, executor);
+    }
+    return std::nullopt;
+}
+
+}  // namespace SkImageContentHash
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkImageContentHash_DEFINED
+#define SkImageContentHash_DEFINED
+
+#include <cstdint>
+#include <optional>
+
+class SkExecutor;
+class SkImage;
+class SkPixmap;
+
+/**
+ *  Hashes of what images look like, rather than which SkImage they are, for finding distinct
+ *  images with the same content (e.g. the same file decoded twice) when writing documents.
+ *
+ *  These are SkChecksum::Hash64(), which is much faster than a cryptographic hash, but makes no
+ *  promise of being stable over time. Only compare them within a process.
+ */
+namespace SkImageContentHash {
+
+// Hashes the pixels, dimensions, color type, alpha type and color space of the pixmap. Row padding
+// isn't hashed. Big pixmaps are hashed in bands of rows, run on the executor if there is one; the
+// hash is the same either way.
+uint64_t Hash(const SkPixmap&, SkExecutor* = nullptr);
+
+// Hashes an image's encoded data (along with its SkImageInfo) if it has any, otherwise its pixels
+// if they can be read without decoding or drawing anything. Returns nothing for other images, e.g.
+// texture-backed or picture-backed images. An image with encoded data doesn't hash the same as the
+// same pixels without it.
+std::optional<uint64_t> Hash(const SkImage*, SkExecutor* = nullptr);
+
+}  // namespace SkImageContentHash
+
+#endif  // SkImageContentHash_DEFINED
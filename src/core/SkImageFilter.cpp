@@ -8,14 +8,20 @@
 #include "include/core/SkImageFilter.h"
 
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImageFilter_Base.h"
@@ -24,6 +30,7 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTHash.h"
 #include "src/core/SkValidationUtils.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/effects/colorfilters/SkColorFilterBase.h"
@@ -160,8 +167,102 @@ SkImageFilter_Base::SkImageFilter_Base(sk_sp<SkImageFilter> const* inputs,
     }
 }
 
+namespace {
+
+// Interns the serialized form of image filter DAGs, so that separately created filters with the
+// same parameters and inputs get the same content ID. An ID is released once every filter that
+// acquired it has been destroyed.
+class ContentIDRegistry {
+public:
+    static ContentIDRegistry& Get() {
+        static ContentIDRegistry* gRegistry = new ContentIDRegistry;
+        return *gRegistry;
+    }
+
+    uint32_t acquire(sk_sp<SkData> data) {
+        SkAutoMutexExclusive lock(fMutex);
+        DataKey key{std::move(data)};
+        if (Entry* entry = fEntries.find(key)) {
+            entry->fRefs++;
+            return entry->fID;
+        }
+        uint32_t id = next_image_filter_unique_id();
+        fEntries.set(key, {id, 1});
+        fKeys.set(id, key);
+        return id;
+    }
+
+    // Returns true if 'id' is no longer used by any filter.
+    bool release(uint32_t id) {
+        SkAutoMutexExclusive lock(fMutex);
+        DataKey* key = fKeys.find(id);
+        if (!key) {
+            // Not interned, so 'id' was the filter's own unique ID.
+            return true;
+        }
+        Entry* entry = fEntries.find(*key);
+        SkASSERT(entry && entry->fID == id);
+        if (--entry->fRefs > 0) {
+            return false;
+        }
+        fEntries.remove(*key);
+        fKeys.remove(id);
+        return true;
+    }
+
+private:
+    struct DataKey {
+        sk_sp<SkData> fData;
+        bool operator==(const DataKey& other) const { return fData->equals(other.fData.get()); }
+    };
+    struct DataKeyHash {
+        uint32_t operator()(const DataKey& key) const {
+            return SkChecksum::Hash32(key.fData->data(), key.fData->size());
+        }
+    };
+    struct Entry {
+        uint32_t fID;
+        int      fRefs;
+    };
+
+    SkMutex fMutex;
+    skia_private::THashMap<DataKey, Entry, DataKeyHash> fEntries SK_GUARDED_BY(fMutex);
+    skia_private::THashMap<uint32_t, DataKey> fKeys SK_GUARDED_BY(fMutex);
+};
+
+sk_sp<SkData> serialize_unique_id(uint32_t id) {
+    return SkData::MakeWithCopy(&id, sizeof(id));
+}
+
+} // anonymous namespace
+
 SkImageFilter_Base::~SkImageFilter_Base() {
-    SkImageFilterCache::Get()->purgeByImageFilter(this);
+    // Filters only key cache entries once they've computed their content ID.
+    if (fContentID && ContentIDRegistry::Get().release(fContentID)) {
+        if (auto cache = SkImageFilterCache::Get(SkImageFilterCache::CreateIfNecessary::kNo)) {
+            cache->purgeByFilterID(fContentID);
+        }
+    }
+}
+
+uint32_t SkImageFilter_Base::contentID() const {
+    fContentIDOnce([this] {
+        // Images, pictures and typefaces are immutable, so their IDs identify them as well as
+        // their contents would, and are much cheaper to write.
+        SkSerialProcs procs;
+        procs.fImageProc = [](SkImage* image, void*) {
+            return serialize_unique_id(image->uniqueID());
+        };
+        procs.fPictureProc = [](SkPicture* picture, void*) {
+            return serialize_unique_id(picture->uniqueID());
+        };
+        procs.fTypefaceProc = [](SkTypeface* typeface, void*) {
+            return serialize_unique_id(typeface->uniqueID());
+        };
+        sk_sp<SkData> data = this->serialize(&procs);
+        fContentID = data ? ContentIDRegistry::Get().acquire(std::move(data)) : fUniqueID;
+    });
+    return fContentID;
 }
 
 std::pair<sk_sp<SkImageFilter>, std::optional<SkRect>>
@@ -241,13 +342,25 @@ skif::FilterResult SkImageFilter_Base::filterImage(const skif::Context& context)
     // need to run the filter on it. This means `fUsesSrcInput` is not equivalent to the source
     // being non-null.
     const bool srcInKey = fUsesSrcInput && context.source();
-    uint32_t srcGenID = srcInKey ? context.source().image()->uniqueID() : SK_InvalidUniqueID;
-    const SkIRect srcSubset = srcInKey ? context.source().image()->subset() : SkIRect::MakeWH(0, 0);
+    uint64_t srcID = SK_InvalidUniqueID;
+    SkIRect srcSubset = SkIRect::MakeWH(0, 0);
+    if (srcInKey) {
+        const SkSpecialImage* srcImage = context.source().image();
+        srcID = srcImage->contentID();
+        // A unique ID names the backing store, so the subset picks out the pixels within it. A
+        // content hash names the pixels themselves, which may be placed anywhere in the layer.
+        srcSubset = srcID == srcImage->uniqueID() ? srcImage->subset()
+                                                 : SkIRect(context.source().layerBounds());
+    }
+    // The cache may be shared by surfaces with different color spaces.
+    const SkColorSpace* colorSpace = context.colorSpace();
+    const uint64_t colorSpaceHash = colorSpace ? colorSpace->hash() : 0;
 
-    SkImageFilterCacheKey key(fUniqueID,
+    SkImageFilterCacheKey key(this->contentID(),
                               context.mapping().layerMatrix(),
                               SkIRect(context.desiredOutput()),
-                              srcGenID, srcSubset);
+                              srcID, srcSubset,
+                              SkChecksum::Hash32(&colorSpaceHash, sizeof(colorSpaceHash)));
     if (context.backend()->cache() && context.backend()->cache()->get(key, &result)) {
         context.markCacheHit();
         return result;
@@ -256,7 +369,7 @@ skif::FilterResult SkImageFilter_Base::filterImage(const skif::Context& context)
     result = this->onFilterImage(context);
 
     if (context.backend()->cache()) {
-        context.backend()->cache()->set(key, this, result);
+        context.backend()->cache()->set(key, result);
     }
 
     return result;
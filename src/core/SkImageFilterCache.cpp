@@ -7,6 +7,7 @@
 
 #include "src/core/SkImageFilterCache.h"
 
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
 #include "src/base/SkTInternalLList.h"
@@ -36,13 +37,11 @@ public:
         fLookup.foreach([&](Value* v) { delete v; });
     }
     struct Value {
-        Value(const Key& key, const skif::FilterResult& image,
-              const SkImageFilter* filter)
-            : fKey(key), fImage(image), fFilter(filter) {}
+        Value(const Key& key, const skif::FilterResult& image)
+            : fKey(key), fImage(image) {}
 
         Key fKey;
         skif::FilterResult fImage;
-        const SkImageFilter* fFilter;
         static const Key& GetKey(const Value& v) {
             return v.fKey;
         }
@@ -63,25 +62,33 @@ public:
             }
 
             *result = v->fImage;
+            fHits++;
             return true;
         }
+        fMisses++;
         return false;
     }
 
-    void set(const Key& key, const SkImageFilter* filter,
-             const skif::FilterResult& result) override {
+    void set(const Key& key, const skif::FilterResult& result) override {
+        const size_t bytes = image_size(result);
+
         SkAutoMutexExclusive mutex(fMutex);
         if (Value* v = fLookup.find(key)) {
             this->removeInternal(v);
         }
-        Value* v = new Value(key, result, filter);
+        if (bytes > fMaxBytes) {
+            fRejections++;
+            return;
+        }
+
+        Value* v = new Value(key, result);
         fLookup.add(v);
         fLRU.addToHead(v);
-        fCurrentBytes += result.image() ? result.image()->getSize() : 0;
-        if (auto* values = fImageFilterValues.find(filter)) {
+        fCurrentBytes += bytes;
+        if (auto* values = fFilterValues.find(key.fUniqueID)) {
             values->push_back(v);
         } else {
-            fImageFilterValues.set(filter, {v});
+            fFilterValues.set(key.fUniqueID, {v});
         }
 
         while (fCurrentBytes > fMaxBytes) {
@@ -91,63 +98,80 @@ public:
                 break;
             }
             this->removeInternal(tail);
+            fEvictions++;
         }
     }
 
     void purge() override {
         SkAutoMutexExclusive mutex(fMutex);
-        while (fCurrentBytes > 0) {
-            Value* tail = fLRU.tail();
-            SkASSERT(tail);
+        while (Value* tail = fLRU.tail()) {
             this->removeInternal(tail);
         }
     }
 
-    void purgeByImageFilter(const SkImageFilter* filter) override {
+    void purgeByFilterID(uint32_t filterID) override {
         SkAutoMutexExclusive mutex(fMutex);
-        auto* values = fImageFilterValues.find(filter);
+        auto* values = fFilterValues.find(filterID);
         if (!values) {
             return;
         }
-        for (Value* v : *values) {
-            // We set the filter to be null so that removeInternal() won't delete from values while
-            // we're iterating over it.
-            v->fFilter = nullptr;
+        // Detach the list first so that removeInternal() won't modify it while we iterate over it.
+        std::vector<Value*> detached = std::move(*values);
+        fFilterValues.remove(filterID);
+        for (Value* v : detached) {
             this->removeInternal(v);
         }
-        fImageFilterValues.remove(filter);
+    }
+
+    Stats stats() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        Stats stats;
+        stats.fEntryCount = fLookup.count();
+        stats.fBytesUsed = fCurrentBytes;
+        stats.fByteLimit = fMaxBytes;
+        stats.fHits = fHits;
+        stats.fMisses = fMisses;
+        stats.fEvictions = fEvictions;
+        stats.fRejections = fRejections;
+        return stats;
     }
 
     SkDEBUGCODE(int count() const override { return fLookup.count(); })
 private:
+    static size_t image_size(const skif::FilterResult& result) {
+        return result.image() ? result.image()->getSize() : 0;
+    }
+
     void removeInternal(Value* v) {
-        if (v->fFilter) {
-            if (auto* values = fImageFilterValues.find(v->fFilter)) {
-                if (values->size() == 1 && (*values)[0] == v) {
-                    fImageFilterValues.remove(v->fFilter);
-                } else {
-                    for (auto it = values->begin(); it != values->end(); ++it) {
-                        if (*it == v) {
-                            values->erase(it);
-                            break;
-                        }
+        if (auto* values = fFilterValues.find(v->fKey.fUniqueID)) {
+            if (values->size() == 1 && (*values)[0] == v) {
+                fFilterValues.remove(v->fKey.fUniqueID);
+            } else {
+                for (auto it = values->begin(); it != values->end(); ++it) {
+                    if (*it == v) {
+                        values->erase(it);
+                        break;
                     }
                 }
             }
         }
-        fCurrentBytes -= v->fImage.image() ? v->fImage.image()->getSize() : 0;
+        fCurrentBytes -= image_size(v->fImage);
         fLRU.remove(v);
         fLookup.remove(v->fKey);
         delete v;
     }
 private:
-    SkTDynamicHash<Value, Key>                          fLookup;
-    mutable SkTInternalLList<Value>                     fLRU;
+    SkTDynamicHash<Value, Key>                fLookup;
+    mutable SkTInternalLList<Value>           fLRU;
     // Value* always points to an item in fLookup.
-    THashMap<const SkImageFilter*, std::vector<Value*>> fImageFilterValues;
-    size_t                                              fMaxBytes;
-    size_t                                              fCurrentBytes;
-    mutable SkMutex                                     fMutex;
+    THashMap<uint32_t, std::vector<Value*>>   fFilterValues;
+    size_t                                    fMaxBytes;
+    size_t                                    fCurrentBytes;
+    mutable uint64_t                          fHits = 0;
+    mutable uint64_t                          fMisses = 0;
+    uint64_t                                  fEvictions = 0;
+    uint64_t                                  fRejections = 0;
+    mutable SkMutex                           fMutex;
 };
 
 } // namespace
@@ -167,3 +191,19 @@ sk_sp<SkImageFilterCache> SkImageFilterCache::Get(CreateIfNecessary createIfNece
     once([]{ cache = SkImageFilterCache::Create(kDefaultCacheSize); });
     return cache;
 }
+
+void SkImageFilterCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    sk_sp<SkImageFilterCache> cache = Get(CreateIfNecessary::kNo);
+    if (!cache) {
+        return;
+    }
+    Stats stats = cache->stats();
+    static const char* kName = "skia/image_filter_cache";
+    dump->dumpNumericValue(kName, "size", "bytes", stats.fBytesUsed);
+    dump->dumpNumericValue(kName, "budget_size", "bytes", stats.fByteLimit);
+    dump->dumpNumericValue(kName, "entries", "objects", stats.fEntryCount);
+    dump->dumpNumericValue(kName, "hits", "objects", stats.fHits);
+    dump->dumpNumericValue(kName, "misses", "objects", stats.fMisses);
+    dump->dumpNumericValue(kName, "evictions", "objects", stats.fEvictions);
+    dump->dumpNumericValue(kName, "rejections", "objects", stats.fRejections);
+}
@@ -17,43 +17,49 @@
 #include <cstddef>
 #include <cstdint>
 
-class SkImageFilter;
+class SkTraceMemoryDump;
 namespace skif { class FilterResult; }
 
 struct SkImageFilterCacheKey {
     SkImageFilterCacheKey(const uint32_t uniqueID, const SkMatrix& matrix,
-        const SkIRect& clipBounds, uint32_t srcGenID, const SkIRect& srcSubset)
-        : fUniqueID(uniqueID)
+        const SkIRect& clipBounds, uint64_t srcID, const SkIRect& srcSubset,
+        uint32_t colorSpaceHash = 0)
+        : fSrcID(srcID)
+        , fUniqueID(uniqueID)
+        , fColorSpaceHash(colorSpaceHash)
         , fMatrix(matrix)
         , fClipBounds(clipBounds)
-        , fSrcGenID(srcGenID)
         , fSrcSubset(srcSubset) {
         // Assert that Key is tightly-packed, since it is hashed.
-        static_assert(sizeof(SkImageFilterCacheKey) == sizeof(uint32_t) + sizeof(SkMatrix) +
-                                     sizeof(SkIRect) + sizeof(uint32_t) + 4 * sizeof(int32_t),
+        static_assert(sizeof(SkImageFilterCacheKey) == sizeof(uint64_t) + 2 * sizeof(uint32_t) +
+                                     sizeof(SkMatrix) + sizeof(SkIRect) + 4 * sizeof(int32_t),
                                      "image_filter_key_tight_packing");
         fMatrix.getType();  // force initialization of type, so hashes match
         SkASSERT(fMatrix.isFinite());   // otherwise we can't rely on == self when comparing keys
     }
 
-    uint32_t fUniqueID;
+    uint64_t fSrcID;          // SkSpecialImage::contentID() of the source, if it's used
+    uint32_t fUniqueID;       // SkImageFilter_Base::contentID() of the filter
+    uint32_t fColorSpaceHash; // of the color space the filter is evaluated in
     SkMatrix fMatrix;
     SkIRect fClipBounds;
-    uint32_t fSrcGenID;
     SkIRect fSrcSubset;
 
     bool operator==(const SkImageFilterCacheKey& other) const {
-        return fUniqueID == other.fUniqueID &&
+        return fSrcID == other.fSrcID &&
+               fUniqueID == other.fUniqueID &&
+               fColorSpaceHash == other.fColorSpaceHash &&
                fMatrix == other.fMatrix &&
                fClipBounds == other.fClipBounds &&
-               fSrcGenID == other.fSrcGenID &&
                fSrcSubset == other.fSrcSubset;
     }
 };
 
-// This cache maps from (filter's unique ID + CTM + clipBounds + src bitmap generation ID) to result
-// NOTE: this is the _specific_ unique ID of the image filter, so refiltering the same image with a
-// copy of the image filter (with exactly the same parameters) will not yield a cache hit.
+// This cache maps from (filter's content ID + CTM + clipBounds + source content ID) to result.
+// The filter's content ID is shared by every image filter with the same parameters and inputs (see
+// SkImageFilter_Base::contentID()), and raster sources are identified by their pixels (see
+// SkSpecialImage::contentID()), so a filter re-created for each frame and applied to unchanged
+// content in a new layer still finds its previous results.
 class SkImageFilterCache : public SkRefCnt {
 public:
     static constexpr size_t kDefaultTransientSize = 32 * 1024 * 1024;
@@ -63,18 +69,36 @@ public:
 
     // Whether to create the cache if it doesn't yet exist.
     enum class CreateIfNecessary : bool { kNo, kYes };
+    // The process-wide cache, which every raster surface shares.
     static sk_sp<SkImageFilterCache> Get(CreateIfNecessary = CreateIfNecessary::kYes);
 
+    // Reports the process-wide cache's stats, if it has been created.
+    static void DumpMemoryStatistics(SkTraceMemoryDump*);
+
     // Returns true on cache hit and updates 'result' to be the cached result. Returns false when
     // not in the cache, in which case 'result' is not modified.
     virtual bool get(const SkImageFilterCacheKey& key,
                      skif::FilterResult* result) const = 0;
-    // 'filter' is included in the caching to allow the purging of all of an image filter's cached
-    // results when it is destroyed.
-    virtual void set(const SkImageFilterCacheKey& key, const SkImageFilter* filter,
-                     const skif::FilterResult& result) = 0;
+    // Entries are weighed by the bytes of their images: the least recently used entries are purged
+    // until the new one fits. A result larger than the cache's whole limit is not added, rather
+    // than purging everything else and still not fitting.
+    virtual void set(const SkImageFilterCacheKey& key, const skif::FilterResult& result) = 0;
     virtual void purge() = 0;
-    virtual void purgeByImageFilter(const SkImageFilter*) = 0;
+    // Purges the results keyed by 'filterID'. SkImageFilter_Base calls this when the last filter
+    // with that content ID is destroyed.
+    virtual void purgeByFilterID(uint32_t filterID) = 0;
+
+    struct Stats {
+        int      fEntryCount = 0;
+        size_t   fBytesUsed = 0;
+        size_t   fByteLimit = 0;
+        uint64_t fHits = 0;
+        uint64_t fMisses = 0;
+        uint64_t fEvictions = 0;    // purged to make room for newer entries
+        uint64_t fRejections = 0;   // results too large to add
+    };
+    virtual Stats stats() const = 0;
+
     SkDEBUGCODE(virtual int count() const = 0;)
 };
 
@@ -230,12 +230,14 @@ void Stats::dumpStats() const {
              "           # cache hits: %d\n"
              "   # offscreen surfaces: %d\n"
              " # shader-clamped draws: %d\n"
-             "   # shader-tiled draws: %d\n",
+             "   # shader-tiled draws: %d\n"
+             "         # output tiles: %d\n",
              fNumVisitedImageFilters,
              fNumCacheHits,
              fNumOffscreenSurfaces,
              fNumShaderClampedDraws,
-             fNumShaderBasedTilingDraws);
+             fNumShaderBasedTilingDraws,
+             fNumOutputTiles);
 }
 
 void Stats::reportStats() const {
@@ -245,6 +247,69 @@ void Stats::reportStats() const {
                          "count", fNumOffscreenSurfaces);
     TRACE_EVENT_INSTANT2("skia", "ImageFilter Shader Tiling", TRACE_EVENT_SCOPE_THREAD,
                          "clamp", fNumShaderClampedDraws, "other", fNumShaderBasedTilingDraws);
+    TRACE_EVENT_INSTANT1("skia", "ImageFilter Output Tiles", TRACE_EVENT_SCOPE_THREAD,
+                         "count", fNumOutputTiles);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Output tiling
+
+skia_private::TArray<DeviceSpace<SkIRect>> ChooseOutputTiles(
+        SkSpan<const sk_sp<SkImageFilter>> filters,
+        const Mapping& mapping,
+        const DeviceSpace<SkIRect>& deviceOutput,
+        const LayerSpace<SkIRect>& sourceBounds,
+        SkColorType colorType,
+        size_t maxBytes) {
+    // Below this, the margins a blur or morphology reads around each tile would dominate the work
+    // of filtering it.
+    static constexpr int kMinTileSize = 256;
+
+    const SkIRect output = SkIRect(deviceOutput);
+    skia_private::TArray<DeviceSpace<SkIRect>> tiles;
+    tiles.push_back(deviceOutput);
+    if (maxBytes == 0 || output.isEmpty()) {
+        return tiles;
+    }
+
+    const uint64_t bytesPerPixel = SkColorTypeBytesPerPixel(colorType);
+    auto estimatedBytes = [&](const SkIRect& tile) {
+        LayerSpace<SkIRect> layerTile = mapping.deviceToLayer(DeviceSpace<SkIRect>(tile));
+        uint64_t pixels = 0;
+        for (const sk_sp<SkImageFilter>& filter : filters) {
+            LayerSpace<SkIRect> input = filter ? as_IFB(filter)->getInputBounds(
+                                                         mapping, DeviceSpace<SkIRect>(tile), {})
+                                               : layerTile;
+            if (!input.intersect(sourceBounds)) {
+                input = LayerSpace<SkIRect>::Empty();
+            }
+            pixels = std::max(pixels, SkToU64(input.width()) * SkToU64(input.height()));
+        }
+        pixels += SkToU64(layerTile.width()) * SkToU64(layerTile.height());
+        return pixels * bytesPerPixel;
+    };
+
+    // Halve the tile size in both dimensions until the largest (first) tile fits.
+    int tileW = output.width(), tileH = output.height();
+    while (estimatedBytes(SkIRect::MakeXYWH(output.fLeft, output.fTop, tileW, tileH)) > maxBytes) {
+        if (tileW <= kMinTileSize && tileH <= kMinTileSize) {
+            break;
+        }
+        tileW = std::max(kMinTileSize, tileW / 2);
+        tileH = std::max(kMinTileSize, tileH / 2);
+    }
+    if (tileW >= output.width() && tileH >= output.height()) {
+        return tiles;
+    }
+
+    tiles.clear();
+    for (int y = output.fTop; y < output.fBottom; y += tileH) {
+        for (int x = output.fLeft; x < output.fRight; x += tileW) {
+            tiles.push_back(DeviceSpace<SkIRect>(SkIRect::MakeLTRB(
+                    x, y, std::min(x + tileW, output.fRight), std::min(y + tileH, output.fBottom))));
+        }
+    }
+    return tiles;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1132,6 +1132,7 @@ struct Stats {
     int fNumOffscreenSurfaces = 0; // difference to the # of visited filters shows deferred steps
     int fNumShaderClampedDraws = 0; // shader-emulated clamp is fairly cheap but HW tiling is best
     int fNumShaderBasedTilingDraws = 0; // shader-emulated decal, mirror, repeat are expensive
+    int fNumOutputTiles = 0; // more than 1 when the output was split to bound intermediate memory
 
     void dumpStats() const;   // log to std out
     void reportStats() const; // trace event counters
@@ -1257,6 +1258,25 @@ private:
     Stats* fStats;
 };
 
+// Splits 'deviceOutput' into a row-major grid of tiles when evaluating 'filters' over all of it at
+// once is estimated to need more than 'maxBytes' of intermediate images. A tile's estimate is the
+// area of the layer-space input it requires (limited to 'sourceBounds') plus its own layer-space
+// output, at 'colorType's bytes per pixel. Each tile can then be filtered on its own with a
+// context whose desired output is the tile mapped to layer space, and drawn clipped to the tile;
+// doing so one tile at a time bounds the peak memory of the intermediates, and gives each tile
+// its own SkImageFilterCache entries since the cache keys include the desired output.
+//
+// Returns just 'deviceOutput' when 'maxBytes' is 0, when everything already fits, or when the
+// estimate cannot be met without making the tiles impractically small. Null entries in 'filters'
+// require exactly their output.
+skia_private::TArray<DeviceSpace<SkIRect>> ChooseOutputTiles(
+        SkSpan<const sk_sp<SkImageFilter>> filters,
+        const Mapping& mapping,
+        const DeviceSpace<SkIRect>& deviceOutput,
+        const LayerSpace<SkIRect>& sourceBounds,
+        SkColorType colorType,
+        size_t maxBytes);
+
 } // end namespace skif
 
 #endif // SkImageFilterTypes_DEFINED
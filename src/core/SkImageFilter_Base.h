@@ -11,6 +11,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
 
@@ -129,6 +130,12 @@ public:
 
     uint32_t uniqueID() const { return fUniqueID; }
 
+    // Identifies this filter's parameters and inputs in SkImageFilterCache keys. Filters that
+    // serialize the same way (with images, pictures and typefaces identified by their unique IDs)
+    // share a content ID, so a DAG that's re-created for each frame still finds the results cached
+    // for its predecessor. Filters that can't be serialized use their unique ID.
+    uint32_t contentID() const;
+
     static SkFlattenable::Type GetFlattenableType() {
         return kSkImageFilter_Type;
     }
@@ -304,6 +311,9 @@ private:
     bool fUsesSrcInput;
     uint32_t fUniqueID; // Globally unique
 
+    mutable SkOnce fContentIDOnce;
+    mutable uint32_t fContentID = 0;
+
     using INHERITED = SkImageFilter;
 };
 
@@ -84,6 +84,30 @@ public:
         return fMap.count();
     }
 
+    // Returns the least recently used value, or nullptr if the cache is empty.
+    V* peekLRU() {
+        Entry* entry = fLRU.tail();
+        return entry ? &entry->fValue : nullptr;
+    }
+
+    // Removes the least recently used entry, if there is one.
+    void removeLRU() {
+        if (Entry* entry = fLRU.tail()) {
+            this->remove(entry->fKey);
+        }
+    }
+
+    // Removes the entry for key, which must be in the cache.
+    void remove(const K& key) {
+        Entry** value = fMap.find(key);
+        SkASSERT(value);
+        Entry* entry = *value;
+        SkASSERT(key == entry->fKey);
+        fMap.remove(key);
+        fLRU.remove(entry);
+        delete entry;
+    }
+
     template <typename Fn>  // f(K*, V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
@@ -112,16 +136,6 @@ private:
         }
     };
 
-    void remove(const K& key) {
-        Entry** value = fMap.find(key);
-        SkASSERT(value);
-        Entry* entry = *value;
-        SkASSERT(key == entry->fKey);
-        fMap.remove(key);
-        fLRU.remove(entry);
-        delete entry;
-    }
-
     int                                         fMaxCount;
     skia_private::THashTable<Entry*, K, Traits> fMap;
     SkTInternalLList<Entry>                     fLRU;
@@ -8,6 +8,7 @@
 #include "src/core/SkMaskBlurFilter.h"
 
 #include "include/core/SkColorPriv.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTemplates.h"
@@ -15,9 +16,13 @@
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkGaussFilter.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <cmath>
 #include <climits>
+#include <functional>
+#include <limits>
 
 namespace {
 static const double kPi = 3.14159265358979323846264338327950288;
@@ -212,6 +217,96 @@ public:
         uint32_t* fBuffer2End;
     };
 
+    // The number of bytes of buffer blurColumns<N>() needs.
+    template <int N> size_t columnBufferBytes() const {
+        return this->bufferSize() * sizeof(skvx::Vec<N, uint32_t>);
+    }
+
+    // Blurs N adjacent columns of A8 pixels at a time, with each column in its own vector lane.
+    // Each column gets exactly the result Scan::blur() gives it, but the pixels of one step are
+    // contiguous in memory, so they are loaded and stored as a vector.
+    template <int N> void blurColumns(const uint8_t* src, size_t srcStride, int srcCount,
+                                      uint8_t* dst, size_t dstStride, int dstCount,
+                                      void* buffer) const {
+        using V = skvx::Vec<N, uint32_t>;
+        V* buffer0 = static_cast<V*>(buffer);
+        V* buffer0End = buffer0 + fPass0Size;
+        V* buffer1 = buffer0End;
+        V* buffer1End = buffer1 + fPass1Size;
+        V* buffer2 = buffer1End;
+        V* buffer2End = buffer2 + fPass2Size;
+        const int noChangeCount = fSlidingWindow > srcCount ? fSlidingWindow - srcCount : 0;
+
+        V* buffer0Cursor = buffer0;
+        V* buffer1Cursor = buffer1;
+        V* buffer2Cursor = buffer2;
+        V sum0 = 0, sum1 = 0, sum2 = 0;
+
+        // The sums are kept in locals, rather than behind a helper, so they stay in registers.
+        constexpr uint64_t kHalf = static_cast<uint64_t>(1) << 31;
+        auto finalScale = [this](V sum) {
+            return skvx::cast<uint8_t>((skvx::cast<uint64_t>(sum) * fWeight + kHalf) >> 32);
+        };
+        auto load = [](const uint8_t* from) {
+            return skvx::cast<uint32_t>(skvx::Vec<N, uint8_t>::Load(from));
+        };
+
+        // Consume the source generating pixels, then continue past the end of the source.
+        std::fill(buffer0, buffer2End, V(0));
+        uint8_t* dstCursor = dst;
+        for (int i = 0; i < srcCount + noChangeCount; ++i, dstCursor += dstStride) {
+            V leadingEdge = 0;
+            if (i < srcCount) {
+                leadingEdge = load(src);
+                src += srcStride;
+            }
+            sum0 += leadingEdge;
+            sum1 += sum0;
+            sum2 += sum1;
+
+            finalScale(sum2).store(dstCursor);
+
+            sum2 -= *buffer2Cursor;
+            *buffer2Cursor = sum1;
+            buffer2Cursor = (buffer2Cursor + 1) < buffer2End ? buffer2Cursor + 1 : buffer2;
+
+            sum1 -= *buffer1Cursor;
+            *buffer1Cursor = sum0;
+            buffer1Cursor = (buffer1Cursor + 1) < buffer1End ? buffer1Cursor + 1 : buffer1;
+
+            sum0 -= *buffer0Cursor;
+            *buffer0Cursor = leadingEdge;
+            buffer0Cursor = (buffer0Cursor + 1) < buffer0End ? buffer0Cursor + 1 : buffer0;
+        }
+
+        // Starting from the bottom, fill in the rest of the destination.
+        std::fill(buffer0, buffer2End, V(0));
+        sum0 = sum1 = sum2 = 0;
+        uint8_t* dstEnd = dst + dstCount * dstStride;
+        while (dstEnd > dstCursor) {
+            dstEnd -= dstStride;
+            src -= srcStride;
+            V leadingEdge = load(src);
+            sum0 += leadingEdge;
+            sum1 += sum0;
+            sum2 += sum1;
+
+            finalScale(sum2).store(dstEnd);
+
+            sum2 -= *buffer2Cursor;
+            *buffer2Cursor = sum1;
+            buffer2Cursor = (buffer2Cursor + 1) < buffer2End ? buffer2Cursor + 1 : buffer2;
+
+            sum1 -= *buffer1Cursor;
+            *buffer1Cursor = sum0;
+            buffer1Cursor = (buffer1Cursor + 1) < buffer1End ? buffer1Cursor + 1 : buffer1;
+
+            sum0 -= *buffer0Cursor;
+            *buffer0Cursor = leadingEdge;
+            buffer0Cursor = (buffer0Cursor + 1) < buffer0End ? buffer0Cursor + 1 : buffer0;
+        }
+    }
+
     Scan makeBlurScan(int width, uint32_t* buffer) const {
         uint32_t* buffer0, *buffer0End, *buffer1, *buffer1End, *buffer2, *buffer2End;
         buffer0 = buffer;
@@ -983,72 +1078,97 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMaskBuilder* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
-    auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
-
-    // Blur both directions.
-    int tmpW = srcH,
-        tmpH = dstW;
-
+    // Blur horizontally into tmp, which holds a blurred row of dstW pixels for each src row.
     // Make sure not to overflow the multiply for the tmp buffer size.
-    if (tmpH > std::numeric_limits<int>::max() / tmpW) {
+    if (srcH > 0 && dstW > std::numeric_limits<int>::max() / srcH) {
         return {0, 0};
     }
-    auto tmp = alloc.makeArrayDefault<uint8_t>(tmpW * tmpH);
+    auto tmp = alloc.makeArrayDefault<uint8_t>(srcH * dstW);
+
+    // Each row of the horizontal pass, and each column of the vertical pass, is independent.
+    // Large masks are split into bands that are blurred in parallel on the default SkExecutor.
+    // Every band gets its own scan buffers, allocated up front since the arena isn't thread safe.
+    constexpr int kMinPixelsPerBand = 64 * 1024;
+    auto runBands = [](int bandCount, const std::function<void(int)>& blurBand) {
+        if (bandCount > 1) {
+            SkTaskGroup bands;
+            bands.batch(bandCount, blurBand);
+            bands.wait();
+        } else {
+            blurBand(0);
+        }
+    };
 
-    // Blur horizontally, and transpose.
-    const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
-    switch (src.fFormat) {
-        case SkMask::kBW_Format: {
-            const uint8_t* bwStart = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
-            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kA8_Format: {
-            const uint8_t* a8Start = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
-            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kARGB32_Format: {
-            const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
-            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kLCD16_Format: {
-            const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
-            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+    const int rowsPerBand = std::max(1, kMinPixelsPerBand / std::max(1, dstW));
+    const int rowBandCount = std::max(1, (srcH + rowsPerBand - 1) / rowsPerBand);
+    uint32_t* rowBuffers = alloc.makeArrayDefault<uint32_t>(planW.bufferSize() * rowBandCount);
+
+    auto blurRows = [&](int band) {
+        const PlanGauss::Scan& scanW =
+                planW.makeBlurScan(srcW, rowBuffers + planW.bufferSize() * band);
+        const int y0 = band * rowsPerBand,
+                  y1 = std::min(y0 + rowsPerBand, srcH);
+        auto blurFormat = [&](auto start, auto end) {
+            const uint32_t bandOffset = SkToU32(y0 * src.fRowBytes);
+            start >>= bandOffset;
+            end >>= bandOffset;
+            for (int y = y0; y < y1; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+                auto tmpStart = &tmp[y * dstW];
+                scanW.blur(start, end, tmpStart, 1, tmpStart + dstW);
             }
-        } break;
-        default:
-            SK_ABORT("Unhandled format.");
-    }
-
-    // Blur vertically (scan in memory order because of the transposition),
-    // and transpose back to the original orientation.
-    const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
-        auto tmpStart = &tmp[y * tmpW];
-        auto dstStart = &dst->image()[y];
-
-        scanH.blur(tmpStart, tmpStart + tmpW,
-                   dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
-    }
+        };
+        switch (src.fFormat) {
+            case SkMask::kBW_Format: {
+                const uint8_t* bwStart = src.fImage;
+                blurFormat(SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0),
+                           SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8));
+            } break;
+            case SkMask::kA8_Format: {
+                const uint8_t* a8Start = src.fImage;
+                blurFormat(SkMask::AlphaIter<SkMask::kA8_Format>(a8Start),
+                           SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW));
+            } break;
+            case SkMask::kARGB32_Format: {
+                const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
+                blurFormat(SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart),
+                           SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW));
+            } break;
+            case SkMask::kLCD16_Format: {
+                const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
+                blurFormat(SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart),
+                           SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW));
+            } break;
+            default:
+                SK_ABORT("Unhandled format.");
+        }
+    };
+    runBands(rowBandCount, blurRows);
+
+    // Blur vertically from tmp into the destination. Going down the columns of tmp, rather than
+    // transposing it, lets each step load and store sixteen adjacent columns at once. Column bands
+    // are a multiple of sixteen wide, so neighboring bands only meet at vector boundaries.
+    constexpr int kLanes = 16;
+    const int colsPerBand =
+            SkToInt(SkAlignTo(std::max(1, kMinPixelsPerBand / std::max(1, dstH)), kLanes));
+    const int colBandCount = std::max(1, (dstW + colsPerBand - 1) / colsPerBand);
+    const size_t colBufferBytes = planH.columnBufferBytes<kLanes>();
+    char* colBuffers = static_cast<char*>(alloc.makeBytesAlignedTo(
+            colBufferBytes * colBandCount, alignof(skvx::Vec<kLanes, uint32_t>)));
+
+    auto blurCols = [&](int band) {
+        void* buffer = colBuffers + colBufferBytes * band;
+        const int x1 = std::min((band + 1) * colsPerBand, dstW);
+        int x = band * colsPerBand;
+        for (; x + kLanes <= x1; x += kLanes) {
+            planH.blurColumns<kLanes>(&tmp[x], dstW, srcH,
+                                      &dst->image()[x], dst->fRowBytes, dstH, buffer);
+        }
+        for (; x < x1; ++x) {
+            planH.blurColumns<1>(&tmp[x], dstW, srcH,
+                                 &dst->image()[x], dst->fRowBytes, dstH, buffer);
+        }
+    };
+    runBands(colBandCount, blurCols);
 
     return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
 }
@@ -10,12 +10,15 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkMathPriv.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMipmapBuilder.h"
 
+#include <memory>
 #include <new>
+#include <utility>
 
 //
 // ColorTypeFilter is the "Type" we pass to some downsample template functions.
@@ -42,8 +45,56 @@ size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return SkTo<int32_t>(size);
 }
 
+// The pixels of a BuildLazy() mipmap's levels are computed on first use by ensureLevel().
+struct SkMipmap::LazyState {
+    SkBitmap                             fSource;  // released once level 0 has been built
+    std::unique_ptr<SkMipmapDownSampler> fDownSampler;
+    std::unique_ptr<SkOnce[]>            fBuilt;   // one per level
+};
+
 SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
                           bool computeContents) {
+    std::unique_ptr<SkMipmapDownSampler> downsampler;
+    if (computeContents) {
+        downsampler = MakeDownSampler(src);
+        if (!downsampler) {
+            return nullptr;
+        }
+    }
+
+    SkMipmap* mipmap = Allocate(src, fact);
+    if (mipmap && downsampler) {
+        SkPixmap srcPM(src);
+        for (int i = 0; i < mipmap->fCount; ++i) {
+            const SkPixmap& dstPM = mipmap->fLevels[i].fPixmap;
+            downsampler->buildLevel(dstPM, srcPM);
+            srcPM = dstPM;
+        }
+    }
+    return mipmap;
+}
+
+SkMipmap* SkMipmap::BuildLazy(const SkBitmap& src, SkDiscardableFactoryProc fact) {
+    SkPixmap srcPM;
+    if (!src.peekPixels(&srcPM)) {
+        return nullptr;
+    }
+    std::unique_ptr<SkMipmapDownSampler> downsampler = MakeDownSampler(srcPM);
+    if (!downsampler) {
+        return nullptr;
+    }
+
+    SkMipmap* mipmap = Allocate(srcPM, fact);
+    if (mipmap) {
+        mipmap->fLazy = std::make_unique<LazyState>();
+        mipmap->fLazy->fSource = src;
+        mipmap->fLazy->fDownSampler = std::move(downsampler);
+        mipmap->fLazy->fBuilt = std::make_unique<SkOnce[]>(mipmap->fCount);
+    }
+    return mipmap;
+}
+
+SkMipmap* SkMipmap::Allocate(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     if (src.width() <= 1 && src.height() <= 1) {
         return nullptr;
     }
@@ -92,20 +143,11 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
     int         width = src.width();
     int         height = src.height();
     uint32_t    rowBytes;
-    SkPixmap    srcPM(src);
 
     // Depending on architecture and other factors, the pixel data alignment may need to be as
     // large as 8 (for F16 pixels). See the comment on SkMipmap::Level.
     SkASSERT(SkIsAlign8((uintptr_t)addr));
 
-    std::unique_ptr<SkMipmapDownSampler> downsampler;
-    if (computeContents) {
-        downsampler = MakeDownSampler(src);
-        if (!downsampler) {
-            return nullptr;
-        }
-    }
-
     for (int i = 0; i < countLevels; ++i) {
         width = std::max(1, width >> 1);
         height = std::max(1, height >> 1);
@@ -117,12 +159,6 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
         new (&levels[i].fPixmap) SkPixmap(SkImageInfo::Make(width, height, ct, at), addr, rowBytes);
         levels[i].fScale  = SkSize::Make(SkIntToScalar(width)  / src.width(),
                                          SkIntToScalar(height) / src.height());
-
-        const SkPixmap& dstPM = levels[i].fPixmap;
-        if (downsampler) {
-            downsampler->buildLevel(dstPM, srcPM);
-        }
-        srcPM = dstPM;
         addr += height * rowBytes;
     }
     SkASSERT(addr == baseAddr + size);
@@ -131,6 +167,28 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
     return mipmap;
 }
 
+void SkMipmap::ensureLevel(int index) const {
+    SkASSERT(fLazy && fLevels);
+    SkASSERT(index >= 0 && index < fCount);
+
+    // Each level is built from the one above it, so building a level builds every larger level
+    // that hasn't been built yet. This also means no two levels are ever built at the same time.
+    fLazy->fBuilt[index]([&] {
+        SkPixmap srcPM;
+        if (index == 0) {
+            srcPM = fLazy->fSource.pixmap();
+        } else {
+            this->ensureLevel(index - 1);
+            srcPM = fLevels[index - 1].fPixmap;
+        }
+        fLazy->fDownSampler->buildLevel(fLevels[index].fPixmap, srcPM);
+        if (index == 0) {
+            // From here on, levels are built from other levels.
+            fLazy->fSource.reset();
+        }
+    });
+}
+
 int SkMipmap::ComputeLevelCount(int baseWidth, int baseHeight) {
     if (baseWidth < 1 || baseHeight < 1) {
         return 0;
@@ -232,6 +290,9 @@ bool SkMipmap::extractLevel(SkSize scaleSize, Level* levelPtr) const {
         level = fCount;
     }
     if (levelPtr) {
+        if (fLazy) {
+            this->ensureLevel(level - 1);
+        }
         *levelPtr = fLevels[level - 1];
         // need to augment with our colorspace
         levelPtr->fPixmap.setColorSpace(fCS);
@@ -288,6 +349,9 @@ bool SkMipmap::getLevel(int index, Level* levelPtr) const {
         return false;
     }
     if (levelPtr) {
+        if (fLazy) {
+            this->ensureLevel(index);
+        }
         *levelPtr = fLevels[index];
         // need to augment with our colorspace
         levelPtr->fPixmap.setColorSpace(fCS);
@@ -46,6 +46,11 @@ public:
 
     static SkMipmap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
 
+    // Allocate a mipmap whose levels are only computed the first time getLevel() or extractLevel()
+    // returns them, so levels that are never sampled are never built. The mipmap refs src's pixels
+    // until its first level has been built.
+    static SkMipmap* BuildLazy(const SkBitmap& src, SkDiscardableFactoryProc);
+
     // Determines how many levels a SkMipmap will have without creating that mipmap.
     // This does not include the base mipmap level that the user provided when
     // creating the SkMipmap.
@@ -92,14 +97,20 @@ protected:
     }
 
 private:
+    struct LazyState;
+
     sk_sp<SkColorSpace> fCS;
     Level*              fLevels;    // managed by the baseclass, may be null due to onDataChanged.
     int                 fCount;
+    std::unique_ptr<LazyState> fLazy;  // only set by BuildLazy()
 
     SkMipmap(void* malloc, size_t size);
     SkMipmap(size_t size, SkDiscardableMemory* dm);
 
     static size_t AllocLevelsSize(int levelCount, size_t pixelSize);
+    // Allocates the mipmap and sets up its levels, without computing their pixels.
+    static SkMipmap* Allocate(const SkPixmap& src, SkDiscardableFactoryProc);
+    void ensureLevel(int index) const;
 };
 
 #endif
@@ -22,6 +22,7 @@
 #include "include/private/base/SkPoint_impl.h"
 #include "include/private/base/SkTDArray.h"
 #include "src/base/SkZip.h"
+#include "src/core/SkCanvasPriv.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDrawShadowInfo.h"
 #include "src/core/SkGlyph.h"
@@ -238,6 +239,12 @@ void SkOverdrawCanvas::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4
     }
 }
 
+void SkOverdrawCanvas::onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                           const SkMatrix preViewMatrices[], int count,
+                                           QuadAAFlags aa, SkBlendMode mode) {
+    SkCanvasPriv::DrawEdgeAARectSetAsQuads(this, rects, colors, preViewMatrices, count, aa, mode);
+}
+
 void SkOverdrawCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry set[], int count,
                                              const SkPoint dstClips[],
                                              const SkMatrix preViewMatrices[],
@@ -3224,6 +3224,17 @@ void SkPath::shrinkToFit() {
     // we're not the only owner of the pathref... since relocating the arrays will invalidate
     // any existing iterators.
     if (!fPathRef->unique()) {
+        // Paths from SkPath::Make, deserialization and detached builders are (nearly) tight
+        // already. Copying them would cost memory rather than save it, since the other owners keep
+        // the original.
+        constexpr size_t kMaxSharedSlack = 64;
+        const size_t tightBytes = sizeof(SkPathRef) +
+                                  fPathRef->fPoints.size() * sizeof(SkPoint) +
+                                  fPathRef->fVerbs.size() * sizeof(uint8_t) +
+                                  fPathRef->fConicWeights.size() * sizeof(SkScalar);
+        if (fPathRef->approximateBytesUsed() - tightBytes <= kMaxSharedSlack) {
+            return;
+        }
         SkPathRef* pr = new SkPathRef;
         pr->copy(*fPathRef, 0, 0, 0);
         fPathRef.reset(pr);
@@ -236,7 +236,22 @@ SkPath SkPathBuilder::snapshot() const {
                                                      fSegmentMask)));
 }
 
+// Detached paths are usually kept as they are (e.g., in pictures and caches), so they shouldn't
+// hold on to the growth slack of the builder's arrays. Trimming a little slack isn't worth the
+// reallocation.
+template <typename Array>
+static void trim_growth_slack(Array* array) {
+    constexpr int kMinTrimmedBytes = 64;
+    const int slack = array->capacity() - array->size();
+    if (slack * (int)sizeof((*array)[0]) > kMinTrimmedBytes && slack > array->size() / 8) {
+        array->shrink_to_fit();
+    }
+}
+
 SkPath SkPathBuilder::detach() {
+    trim_growth_slack(&fPts);
+    trim_growth_slack(&fVerbs);
+    trim_growth_slack(&fConicWeights);
     auto path = this->make(sk_sp<SkPathRef>(new SkPathRef(std::move(fPts),
                                                           std::move(fVerbs),
                                                           std::move(fConicWeights),
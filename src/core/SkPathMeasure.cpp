@@ -70,3 +70,7 @@ size_t SkPathMeasurePriv::CountSegments(const SkPathMeasure& meas) {
     }
     return 0;
 }
+
+size_t SkPathMeasurePriv::ApproximateBytesUsed(const SkContourMeasure& contour) {
+    return sizeof(contour) + contour.fSegments.size_bytes() + contour.fPts.size_bytes();
+}
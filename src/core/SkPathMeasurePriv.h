@@ -28,11 +28,14 @@ void SkPathMeasure_segTo(const SkPoint pts[], unsigned segType,
 
 // for testing
 
+class SkContourMeasure;
 class SkPathMeasure;
 
 class SkPathMeasurePriv {
 public:
     static size_t CountSegments(const SkPathMeasure&);
+
+    static size_t ApproximateBytesUsed(const SkContourMeasure&);
 };
 
 #endif  // SkPathMeasurePriv_DEFINED
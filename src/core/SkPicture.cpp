@@ -142,6 +142,53 @@ sk_sp<SkPicture> SkPicture::Forwardport(const SkPictInfo& info,
     return r.finishRecordingAsPicture();
 }
 
+// Plays back deserialized SkPictureData directly, skipping the trip through SkRecord.
+class SkPlaybackPicture final : public SkPicture {
+public:
+    SkPlaybackPicture(std::unique_ptr<SkPictureData> data)
+            : fData(std::move(data))
+            , fOpCount(CountOps(*fData->opData())) {}
+
+    void playback(SkCanvas* canvas, AbortCallback* callback) const override {
+        SkPicturePlayback playback(fData.get());
+        playback.draw(canvas, callback, nullptr);
+    }
+
+    SkRect cullRect() const override { return fData->info().fCullRect; }
+
+    // Nested pictures are not counted, since that would mean walking their ops too.
+    int approximateOpCount(bool) const override { return fOpCount; }
+
+    size_t approximateBytesUsed() const override {
+        return sizeof(*this) + sizeof(SkPictureData) + fData->opData()->size();
+    }
+
+private:
+    // Walks the op headers written by SkPictureRecord::addDraw().
+    static int CountOps(const SkData& ops) {
+        SkReadBuffer reader(ops.data(), ops.size());
+        int count = 0;
+        while (!reader.eof() && reader.isValid()) {
+            size_t start = reader.offset();
+            uint32_t bits = reader.readInt();
+            size_t size = bits & 0xffffff;
+            if (size == 0xffffff) {
+                // The size includes one byte for the extra word, which is four bytes long.
+                size = reader.readInt() + 3;
+            }
+            if (!reader.validate(size >= reader.offset() - start)) {
+                break;
+            }
+            reader.skip(size - (reader.offset() - start));
+            ++count;
+        }
+        return count;
+    }
+
+    std::unique_ptr<SkPictureData> fData;
+    int fOpCount;
+};
+
 static const int kNestedSKPLimit = 100; // Arbitrarily set
 
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procs) {
@@ -187,6 +234,9 @@ sk_sp<SkPicture> SkPicture::MakeFromStreamPriv(SkStream* stream, const SkDeseria
             std::unique_ptr<SkPictureData> data(
                     SkPictureData::CreateFromStream(stream, info, procs, typefaces,
                                                     recursionLimit));
+            if (procs.fLazyPicturePlayback && data && data->opData()) {
+                return sk_make_sp<SkPlaybackPicture>(std::move(data));
+            }
             return Forwardport(info, data.get(), nullptr);
         }
         case kCustom_TrailingStreamByteAfterPictInfo: {
@@ -313,7 +363,6 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
 
 void SkPicturePriv::Flatten(const sk_sp<const SkPicture> picture, SkWriteBuffer& buffer) {
     SkPictInfo info = picture->createHeader();
-    std::unique_ptr<SkPictureData> data(picture->backport());
 
     buffer.writeByteArray(&info.fMagic, sizeof(info.fMagic));
     buffer.writeUInt(info.getVersion());
@@ -326,6 +375,8 @@ void SkPicturePriv::Flatten(const sk_sp<const SkPicture> picture, SkWriteBuffer&
         return;
     }
 
+    // Only backport once we know the custom format isn't used, since it copies every op.
+    std::unique_ptr<SkPictureData> data(picture->backport());
     if (data) {
         buffer.write32(1); // special size meaning SkPictureData
         data->flatten(buffer);
@@ -7,6 +7,7 @@
 
 #include "src/core/SkPictureData.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkSerialProcs.h"
@@ -23,6 +24,7 @@
 #include "src/core/SkPtrRecorder.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkStreamPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTHash.h"
 #include "src/core/SkTextBlobPriv.h"
 #include "src/core/SkVerticesPriv.h"
@@ -129,6 +131,17 @@ void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     SkASSERT(size == (stream->bytesWritten() - start));
 }
 
+static sk_sp<SkData> serialize_typeface(SkTypeface* tf, const SkSerialProcs& procs) {
+    if (procs.fTypefaceProc) {
+        if (auto data = procs.fTypefaceProc(tf, procs.fTypefaceCtx)) {
+            return data;
+        }
+    }
+    SkDynamicMemoryWStream stream;
+    tf->serialize(&stream, SkTypeface::SerializeBehavior::kDoIncludeData);
+    return stream.detachAsData();
+}
+
 void SkPictureData::WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec,
                                    const SkSerialProcs& procs) {
     int count = rec.count();
@@ -139,6 +152,18 @@ void SkPictureData::WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec,
     SkTypeface** array = (SkTypeface**)storage.get();
     rec.copyToArray((SkRefCnt**)array);
 
+    if (procs.fExecutor && count > 1) {
+        // Encode them all at once, then write them in order.
+        AutoSTArray<16, sk_sp<SkData>> encoded(count);
+        SkTaskGroup taskGroup(*procs.fExecutor);
+        taskGroup.batch(count, [&](int i) { encoded[i] = serialize_typeface(array[i], procs); });
+        taskGroup.wait();
+        for (int i = 0; i < count; i++) {
+            stream->write(encoded[i]->data(), encoded[i]->size());
+        }
+        return;
+    }
+
     for (int i = 0; i < count; i++) {
         SkTypeface* tf = array[i];
         if (procs.fTypefaceProc) {
@@ -240,6 +265,9 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     SkBinaryWriteBuffer buffer(skip_typeface_proc(procs));
     buffer.setFactoryRecorder(sk_ref_sp(&factSet));
     buffer.setTypefaceRecorder(sk_ref_sp(typefaceSet));
+    if (procs.fExecutor && !textBlobsOnly) {
+        buffer.preEncodeImages(fImages, procs.fExecutor);
+    }
     this->flattenToBuffer(buffer, textBlobsOnly);
 
     // Pretend to serialize our sub-pictures for the side effect of filling typefaceSet
@@ -785,6 +785,13 @@ void SkPictureRecord::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4]
     this->validate(initialOffset, size);
 }
 
+void SkPictureRecord::onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                          const SkMatrix preViewMatrices[], int count,
+                                          SkCanvas::QuadAAFlags aa, SkBlendMode mode) {
+    // Serialized as the quads it draws, so that older readers can still play it back.
+    SkCanvasPriv::DrawEdgeAARectSetAsQuads(this, rects, colors, preViewMatrices, count, aa, mode);
+}
+
 void SkPictureRecord::onDrawEdgeAAImageSet2(const SkCanvas::ImageSetEntry set[], int count,
                                             const SkPoint dstClips[],
                                             const SkMatrix preViewMatrices[],
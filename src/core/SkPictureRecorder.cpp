@@ -40,7 +40,14 @@ SkCanvas* SkPictureRecorder::beginRecording(const SkRect& userCullRect,
     fBBH = std::move(bbh);
 
     if (!fRecord) {
-        fRecord.reset(new SkRecord);
+        if (fRetiredRecord && fRetiredRecord->unique()) {
+            // Whatever we handed the last recording to is gone; record into its storage again.
+            fRetiredRecord->reset();
+            fRecord = std::move(fRetiredRecord);
+        } else {
+            fRetiredRecord.reset();
+            fRecord.reset(new SkRecord);
+        }
     }
     fRecorder->reset(fRecord.get(), cullRect);
     fActivelyRecording = true;
@@ -51,6 +58,13 @@ SkCanvas* SkPictureRecorder::beginRecording(const SkRect& bounds, SkBBHFactory*
     return this->beginRecording(bounds, factory ? (*factory)() : nullptr);
 }
 
+void SkPictureRecorder::setReuseRecordStorage(bool reuse) {
+    fReuseRecordStorage = reuse;
+    if (!reuse) {
+        fRetiredRecord.reset();
+    }
+}
+
 SkCanvas* SkPictureRecorder::getRecordingCanvas() {
     return fActivelyRecording ? fRecorder.get() : nullptr;
 }
@@ -101,6 +115,9 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture() {
     for (int i = 0; pictList && i < pictList->count(); i++) {
         subPictureBytes += pictList->begin()[i]->approximateBytesUsed();
     }
+    if (fReuseRecordStorage) {
+        fRetiredRecord = fRecord;
+    }
     return sk_make_sp<SkBigPicture>(fCullRect,
                                     std::move(fRecord),
                                     std::move(pictList),
@@ -142,6 +159,9 @@ sk_sp<SkDrawable> SkPictureRecorder::finishRecordingAsDrawable() {
         fBBH->insert(bounds.data(), meta, fRecord->count());
     }
 
+    if (fReuseRecordStorage) {
+        fRetiredRecord = fRecord;
+    }
     sk_sp<SkDrawable> drawable =
          sk_make_sp<SkRecordedDrawable>(std::move(fRecord), std::move(fBBH),
                                         fRecorder->detachDrawableList(), fCullRect);
@@ -9,8 +9,12 @@
 
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
+#include "src/base/SkVx.h"
 
-SkRTree::SkRTree() : fCount(0) {}
+#include <algorithm>
+#include <utility>
+
+SkRTree::SkRTree(SkRTreeFactory::BulkLoad bulkLoad) : fBulkLoad(bulkLoad), fCount(0) {}
 
 void SkRTree::insert(const SkRect boundsArray[], int N) {
     SkASSERT(0 == fCount);
@@ -40,12 +44,65 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
             fRoot.fSubtree = n;
             fRoot.fBounds  = branches[0].fBounds;
         } else {
+            if (fBulkLoad == SkRTreeFactory::BulkLoad::kHilbert) {
+                SkRect bounds = branches[0].fBounds;
+                for (const Branch& b : branches) {
+                    bounds.join(b.fBounds);
+                }
+                HilbertSort(&branches, bounds);
+            }
             fNodes.reserve(CountNodes(fCount));
             fRoot = this->bulkLoad(&branches);
         }
     }
 }
 
+// Returns the distance along a Hilbert curve filling a 2^16 x 2^16 grid to the cell (x, y).
+static uint32_t hilbert_index(uint32_t x, uint32_t y) {
+    static constexpr uint32_t kN = 1 << 16;
+    uint32_t d = 0;
+    for (uint32_t s = kN / 2; s > 0; s /= 2) {
+        const uint32_t rx = (x & s) ? 1 : 0;
+        const uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so the curve's sub-pattern lines up.
+        if (ry == 0) {
+            if (rx == 1) {
+                x = kN - 1 - x;
+                y = kN - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+void SkRTree::HilbertSort(std::vector<Branch>* branches, const SkRect& bounds) {
+    static constexpr float kMaxCell = (1 << 16) - 1;
+    const float sx = bounds.width()  > 0 ? kMaxCell / bounds.width()  : 0;
+    const float sy = bounds.height() > 0 ? kMaxCell / bounds.height() : 0;
+
+    // Sort on the curve index in the high bits, with the original position as a tie-break so the
+    // result doesn't depend on the sort's stability.
+    std::vector<uint64_t> keys(branches->size());
+    for (size_t i = 0; i < branches->size(); ++i) {
+        const SkRect& r = (*branches)[i].fBounds;
+        const float cx = (r.centerX() - bounds.fLeft) * sx;
+        const float cy = (r.centerY() - bounds.fTop)  * sy;
+        const uint32_t x = (uint32_t)std::clamp(cx, 0.f, kMaxCell);
+        const uint32_t y = (uint32_t)std::clamp(cy, 0.f, kMaxCell);
+        keys[i] = (uint64_t)hilbert_index(x, y) << 32 | i;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<Branch> sorted;
+    sorted.reserve(branches->size());
+    for (uint64_t key : keys) {
+        sorted.push_back((*branches)[(uint32_t)key]);
+    }
+    *branches = std::move(sorted);
+}
+
 SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkDEBUGCODE(Node* p = fNodes.data());
     fNodes.push_back(Node{});
@@ -146,13 +203,25 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
 
 void SkRTree::search(const SkRect& query, std::vector<int>* results) const {
     if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
+        const size_t start = results->size();
         this->search(fRoot.fSubtree, query, results);
+        if (fBulkLoad == SkRTreeFactory::BulkLoad::kHilbert) {
+            // Callers play back ops in the order we return them, so they must be increasing.
+            std::sort(results->begin() + start, results->end());
+        }
     }
 }
 
 void SkRTree::search(Node* node, const SkRect& query, std::vector<int>* results) const {
+    // The query is known to be sorted and non-empty here (it intersects the root), so testing a
+    // child for overlap is a single 4-wide compare:
+    //     { L, T, -R, -B } < { query.R, query.B, -query.L, -query.T }
+    const skvx::float4 q = skvx::float4(query.fRight, query.fBottom, query.fLeft, query.fTop) *
+                           skvx::float4(1, 1, -1, -1);
     for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
+        const skvx::float4 b = skvx::float4::Load(&node->fChildren[i].fBounds) *
+                               skvx::float4(1, 1, -1, -1);
+        if (all(b < q)) {
             if (0 == node->fLevel) {
                 results->push_back(node->fChildren[i].fOpIndex);
             } else {
@@ -20,11 +20,11 @@
  * bounding rectangles.
  *
  * It only supports bulk-loading, i.e. creation from a batch of bounding rectangles.
- * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm.
+ * This performs a bottom-up bulk load, packing rects into nodes either in insertion order (STR,
+ * sort-tile-recursive, without the sort) or in the order of their centers along a Hilbert curve.
+ * See SkDynamicRTree for a variant that supports inserting and removing rects one at a time.
  *
- * TODO: Experiment with other bulk-load algorithms (in particular the Hilbert pack variant,
- * which groups rects by position on the Hilbert curve, is probably worth a look). There also
- * exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc).
+ * TODO: There also exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc).
  *
  * For more details see:
  *
@@ -33,7 +33,7 @@
  */
 class SkRTree : public SkBBoxHierarchy {
 public:
-    SkRTree();
+    explicit SkRTree(SkRTreeFactory::BulkLoad = SkRTreeFactory::BulkLoad::kInsertionOrder);
 
     void insert(const SkRect[], int N) override;
     void search(const SkRect& query, std::vector<int>* results) const override;
@@ -72,11 +72,16 @@ private:
     // Consumes the input array.
     Branch bulkLoad(std::vector<Branch>* branches, int level = 0);
 
+    // Reorders leaf branches by the Hilbert index of their centers within 'bounds'.
+    static void HilbertSort(std::vector<Branch>* branches, const SkRect& bounds);
+
     // How many times will bulkLoad() call allocateNodeAtLevel()?
     static int CountNodes(int branches);
 
     Node* allocateNodeAtLevel(uint16_t level);
 
+    const SkRTreeFactory::BulkLoad fBulkLoad;
+
     // This is the count of data elements (rather than total nodes in the tree)
     int fCount;
     Branch fRoot;
@@ -13,11 +13,13 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTemplates.h"
 #include "modules/skcms/skcms.h"
+#include "src/base/SkTime.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
+#include "src/core/SkRasterPipelineProfile.h"
 
 #include <algorithm>
 #include <cstring>
@@ -64,7 +66,73 @@ uint8_t* SkRasterPipeline::tailPointer() {
     return fTailPointer;
 }
 
+void SkRasterPipeline::popStage() {
+    SkASSERT(fStages);
+    // The popped StageList may be shared with a copy of this pipeline, so leave it untouched.
+    fStages = fStages->prev;
+    fNumStages -= 1;
+}
+
+bool SkRasterPipeline::appendFused(SkRasterPipelineOp op, void* ctx) {
+    // Each stage boundary costs an indirect call per N pixels, so common short sequences are
+    // replaced here by a single stage which runs the same code. The fused stages are exact in
+    // both lowp and highp; they exist purely to drop the calls in between.
+    if (!fStages) {
+        return false;
+    }
+    const StageList* last = fStages;
+
+    switch (op) {
+        case Op::clamp_01:
+            // Constant colors are already in [0,1].
+            return last->stage == Op::uniform_color ||
+                   last->stage == Op::black_color ||
+                   last->stage == Op::white_color;
+
+        case Op::matrix_scale_translate:
+        case Op::matrix_2x3:
+            if (last->stage == Op::seed_shader) {
+                this->popStage();
+                this->uncheckedAppend(op == Op::matrix_2x3 ? Op::seed_shader_matrix_2x3
+                                                           : Op::seed_shader_matrix_scale_translate,
+                                      ctx);
+                return true;
+            }
+            return false;
+
+        case Op::srcover_rgba_8888:
+            // Solid-color SrcOver blits.
+            if (last->stage == Op::uniform_color) {
+                auto fusedCtx = fAlloc->make<SkRasterPipeline_UniformSrcoverCtx>();
+                fusedCtx->color = (const SkRasterPipeline_UniformColorCtx*)last->ctx;
+                fusedCtx->dst = (SkRasterPipeline_MemoryCtx*)ctx;
+                this->popStage();
+                this->uncheckedAppend(Op::uniform_srcover_rgba_8888, fusedCtx);
+                return true;
+            }
+            return false;
+
+        case Op::store_8888:
+            // Anti-aliased and masked SrcOver blits into 8888, with coverage already applied.
+            if (last->stage == Op::srcover && last->prev &&
+                last->prev->stage == Op::load_8888_dst && last->prev->ctx == ctx) {
+                this->popStage();
+                this->popStage();
+                this->uncheckedAppend(Op::load_dst_srcover_store_8888, ctx);
+                return true;
+            }
+            return false;
+
+        default:
+            return false;
+    }
+}
+
 void SkRasterPipeline::uncheckedAppend(SkRasterPipelineOp op, void* ctx) {
+    if (this->appendFused(op, ctx)) {
+        return;
+    }
+
     bool isLoad = false, isStore = false;
     SkColorType ct = kUnknown_SkColorType;
 
@@ -105,12 +173,20 @@ void SkRasterPipeline::uncheckedAppend(SkRasterPipelineOp op, void* ctx) {
             isStore = true;
             break;
         }
-        case Op::srcover_rgba_8888: {
+        case Op::srcover_rgba_8888:
+        case Op::load_dst_srcover_store_8888: {
             ct = kRGBA_8888_SkColorType;
             isLoad = true;
             isStore = true;
             break;
         }
+        case Op::uniform_srcover_rgba_8888: {
+            auto* fusedCtx = (SkRasterPipeline_UniformSrcoverCtx*)ctx;
+            this->addMemoryContext(fusedCtx->dst,
+                                   SkColorTypeBytesPerPixel(kRGBA_8888_SkColorType),
+                                   /*load=*/true, /*store=*/true);
+            break;
+        }
         case Op::scale_u8:
         case Op::lerp_u8: {
             ct = kAlpha_8_SkColorType;
@@ -626,6 +702,16 @@ void SkRasterPipeline::run(size_t x, size_t y, size_t w, size_t h) const {
     }
 
     auto start_pipeline = this->buildPipeline(program.get() + stagesNeeded);
+    if (SkRasterPipelineProfile::IsEnabled()) {
+        SkRasterPipelineProfile::Entry* entry = SkRasterPipelineProfile::FindOrCreate(
+                *this, start_pipeline == SkOpts::start_pipeline_lowp);
+        double start = SkTime::GetNSecs();
+        start_pipeline(x, y, x + w, y + h, program.get(),
+                       SkSpan{patches.data(), numMemoryCtxs},
+                       fTailPointer);
+        entry->record(w * h, (uint64_t)(SkTime::GetNSecs() - start));
+        return;
+    }
     start_pipeline(x, y, x + w, y + h, program.get(),
                    SkSpan{patches.data(), numMemoryCtxs},
                    fTailPointer);
@@ -651,6 +737,17 @@ std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile()
     uint8_t* tailPointer = fTailPointer;
 
     auto start_pipeline = this->buildPipeline(program + stagesNeeded);
+    if (SkRasterPipelineProfile::IsEnabled()) {
+        SkRasterPipelineProfile::Entry* entry = SkRasterPipelineProfile::FindOrCreate(
+                *this, start_pipeline == SkOpts::start_pipeline_lowp);
+        return [=](size_t x, size_t y, size_t w, size_t h) {
+            double start = SkTime::GetNSecs();
+            start_pipeline(x, y, x + w, y + h, program,
+                           SkSpan{patches, numMemoryCtxs},
+                           tailPointer);
+            entry->record(w * h, (uint64_t)(SkTime::GetNSecs() - start));
+        };
+    }
     return [=](size_t x, size_t y, size_t w, size_t h) {
         start_pipeline(x, y, x + w, y + h, program,
                        SkSpan{patches, numMemoryCtxs},
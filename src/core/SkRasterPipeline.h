@@ -146,6 +146,9 @@ private:
     StartPipelineFn buildPipeline(SkRasterPipelineStage*) const;
 
     void uncheckedAppend(SkRasterPipelineOp, void*);
+    // Replaces the tail of the stage list plus `op` with an equivalent fused stage, if one exists.
+    bool appendFused(SkRasterPipelineOp, void*);
+    void popStage();
     int stagesNeeded() const;
 
     void addMemoryContext(SkRasterPipeline_MemoryCtx*, int bytesPerPixel, bool load, bool store);
@@ -20,6 +20,7 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkCPUTypes.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlenderBase.h"
@@ -68,6 +69,8 @@ public:
     void blitAntiH (int x, int y, const SkAlpha[], const int16_t[]) override;
     void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1)               override;
     void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1)               override;
+    void blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                       size_t rowBytes)                                 override;
     void blitMask  (const SkMask&, const SkIRect& clip)             override;
     void blitRect  (int x, int y, int width, int height)            override;
     void blitV     (int x, int y, int height, SkAlpha alpha)        override;
@@ -101,15 +104,16 @@ private:
 
     // Built lazily on first use.
     std::function<void(size_t, size_t, size_t, size_t)> fBlitRect,
-                                                        fBlitAntiH,
                                                         fBlitMaskA8,
                                                         fBlitMaskLCD16,
                                                         fBlitMask3D;
 
+    // One row of coverage gathered by blitAntiH(), allocated on first use.
+    uint8_t* fAntiHCoverage = nullptr;
+
     // These values are pointed to by the blit pipelines above,
     // which allows us to adjust them from call to call.
-    float fCurrentCoverage = 0.0f;
-    float fDitherRate      = 0.0f;
+    float fDitherRate = 0.0f;
 
     using INHERITED = SkBlitter;
 };
@@ -431,39 +435,45 @@ void SkRasterPipelineBlitter::blitRectWithTrace(int x, int y, int w, int h, bool
 }
 
 void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
-    if (!fBlitAntiH) {
-        SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
-        p.appendClampIfNormalized(fDst.info());
-        if (fBlendMode.has_value() &&
-            SkBlendMode_ShouldPreScaleCoverage(*fBlendMode, /*rgb_coverage=*/false)) {
-            p.append(SkRasterPipelineOp::scale_1_float, &fCurrentCoverage);
-            this->appendClipScale(&p);
-            this->appendLoadDst(&p);
-            p.extend(fBlendPipeline);
-        } else {
-            this->appendLoadDst(&p);
-            p.extend(fBlendPipeline);
-            p.append(SkRasterPipelineOp::lerp_1_float, &fCurrentCoverage);
-            this->appendClipLerp(&p);
-        }
+    // Opaque runs at least this long are worth blitting on their own with blitRect(), which may be
+    // able to memset. All other adjacent non-zero runs are gathered into one row of coverage and
+    // blitted with a single A8 mask pipeline call, rather than one call per (often 1-pixel) run.
+    static constexpr int kMinOpaqueRunForBlitRect = 16;
 
-        this->appendStore(&p);
-        fBlitAntiH = p.compile();
+    if (!fAntiHCoverage) {
+        fAntiHCoverage = fAlloc->makeArrayDefault<uint8_t>(fDst.width());
     }
 
+    int batchX = x,
+        batchWidth = 0;
+    auto flush = [&] {
+        if (batchWidth > 0) {
+            SkIRect bounds = {batchX, y, batchX + batchWidth, y + 1};
+            this->blitMask(SkMask(fAntiHCoverage, bounds, batchWidth, SkMask::kA8_Format),
+                           bounds);
+            batchWidth = 0;
+        }
+    };
+
     for (int16_t run = *runs; run > 0; run = *runs) {
-        switch (*aa) {
-            case 0x00:                                break;
-            case 0xff:this->blitRectWithTrace(x,y,run, 1, false); break;
-            default:
-                fCurrentCoverage = *aa * (1/255.0f);
-                fBlitAntiH(x,y,run,1);
+        if (*aa == 0x00) {
+            flush();
+        } else if (*aa == 0xff && run >= kMinOpaqueRunForBlitRect) {
+            flush();
+            this->blitRectWithTrace(x,y,run, 1, false);
+        } else {
+            if (batchWidth == 0) {
+                batchX = x;
+            }
+            SkASSERT(batchWidth + run <= fDst.width());
+            memset(fAntiHCoverage + batchWidth, *aa, run);
+            batchWidth += run;
         }
         x    += run;
         runs += run;
         aa   += run;
     }
+    flush();
 }
 
 void SkRasterPipelineBlitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
@@ -480,6 +490,13 @@ void SkRasterPipelineBlitter::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
     this->blitMask(mask, clip);
 }
 
+void SkRasterPipelineBlitter::blitAntiV2Run(int x, int y, int count, const SkAlpha coverage[],
+                                            size_t rowBytes) {
+    SkIRect clip = {x,y, x+count,y+2};
+    SkMask mask(coverage, clip, SkToU32(rowBytes), SkMask::kA8_Format);
+    this->blitMask(mask, clip);
+}
+
 void SkRasterPipelineBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
     SkIRect clip = {x,y, x+1,y+height};
     SkMask mask(&alpha, clip,
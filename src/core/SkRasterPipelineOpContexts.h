@@ -182,6 +182,13 @@ struct SkRasterPipeline_EvenlySpaced2StopGradientCtx {
     float b[4];
 };
 
+// Colors sampled at `count` evenly spaced t in [0,1], one array per channel. Each array holds one
+// more entry, a copy of the last, so that lerping towards the next entry never reads past the end.
+struct SkRasterPipeline_GradientRampCtx {
+    int          count;
+    const float* rgba[4];
+};
+
 struct SkRasterPipeline_2PtConicalCtx {
     uint32_t fMask[SkRasterPipeline_kMaxStride_highp];
     float    fP0,
@@ -193,6 +200,13 @@ struct SkRasterPipeline_UniformColorCtx {
     uint16_t rgba[4];  // [0,255] in a 16-bit lane.
 };
 
+// Used by uniform_srcover_rgba_8888, which SkRasterPipeline fuses from uniform_color followed by
+// srcover_rgba_8888.
+struct SkRasterPipeline_UniformSrcoverCtx {
+    const SkRasterPipeline_UniformColorCtx* color;
+    SkRasterPipeline_MemoryCtx*             dst;
+};
+
 struct SkRasterPipeline_EmbossCtx {
     SkRasterPipeline_MemoryCtx mul,
                                add;
@@ -213,6 +227,12 @@ struct SkRasterPipeline_ConstantCtx {
     SkRPOffset dst;
 };
 
+struct SkRasterPipeline_MultiplyAddConstantCtx {
+    int32_t mul;
+    int32_t add;
+    SkRPOffset dst;
+};
+
 struct SkRasterPipeline_UniformCtx {
     int32_t* dst;
     const int32_t* src;
@@ -18,6 +18,8 @@
     M(black_color) M(white_color)                                  \
     M(uniform_color) M(uniform_color_dst)                          \
     M(seed_shader)                                                 \
+    M(seed_shader_matrix_scale_translate)                          \
+    M(seed_shader_matrix_2x3)                                      \
     M(load_a8)     M(load_a8_dst)   M(store_a8)    M(gather_a8)    \
     M(load_565)    M(load_565_dst)  M(store_565)   M(gather_565)   \
     M(load_4444)   M(load_4444_dst) M(store_4444)  M(gather_4444)  \
@@ -36,7 +38,8 @@
     M(clear) M(modulate) M(multiply) M(plus_) M(screen) M(xor_)    \
     M(darken) M(difference)                                        \
     M(exclusion) M(hardlight) M(lighten) M(overlay)                \
-    M(srcover_rgba_8888)                                           \
+    M(srcover_rgba_8888) M(uniform_srcover_rgba_8888)              \
+    M(load_dst_srcover_store_8888)                                 \
     M(matrix_translate) M(matrix_scale_translate)                  \
     M(matrix_2x3)                                                  \
     M(matrix_perspective)                                          \
@@ -47,6 +50,7 @@
     M(evenly_spaced_gradient)                                      \
     M(gradient)                                                    \
     M(evenly_spaced_2_stop_gradient)                               \
+    M(gradient_ramp)                                               \
     M(xy_to_unit_angle)                                            \
     M(xy_to_radius)                                                \
     M(emboss)                                                      \
@@ -102,6 +106,7 @@
     M(swizzle_1) M(swizzle_2) M(swizzle_3) M(swizzle_4) M(shuffle)                              \
     M(matrix_multiply_2) M(matrix_multiply_3) M(matrix_multiply_4)                              \
     M(smoothstep_n_floats) M(dot_2_floats) M(dot_3_floats) M(dot_4_floats)                      \
+    M(mad_imm_float)                                                                            \
     M(add_imm_float)                                                                            \
         M(add_n_floats)   M(add_float)    M(add_2_floats)   M(add_3_floats)   M(add_4_floats)   \
     M(add_imm_int)                                                                              \
@@ -169,7 +174,7 @@
     M(gather_10101010_xr) M(load_10101010_xr) M(load_10101010_xr_dst)          \
     M(store_10101010_xr)                                                       \
     M(store_src_rg) M(load_src_rg)                                             \
-    M(byte_tables)                                                             \
+    M(byte_tables) M(byte_tf)                                                  \
     M(colorburn) M(colordodge) M(softlight)                                    \
     M(hue) M(saturation) M(color) M(luminosity)                                \
     M(matrix_3x3) M(matrix_3x4) M(matrix_4x5) M(matrix_4x3)                    \
@@ -183,7 +188,7 @@
     M(mirror_x)   M(repeat_x)                                                  \
     M(mirror_y)   M(repeat_y)                                                  \
     M(negate_x)                                                                \
-    M(bicubic_clamp_8888)                                                      \
+    M(bicubic_clamp_8888) M(bilerp_clamp_f16) M(bicubic_clamp_f16)             \
     M(bilinear_setup)                                                          \
     M(bilinear_nx) M(bilinear_px) M(bilinear_ny) M(bilinear_py)                \
     M(bicubic_setup)                                                           \
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkRasterPipelineProfile.h"
+
+#include "include/core/SkTraceMemoryDump.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkTHash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+std::atomic<bool> SkRasterPipelineProfile::gEnabled{false};
+
+namespace {
+
+struct Registry {
+    SkMutex fMutex;
+    // Keyed by precision and stage list, so one stage list may appear once for each precision.
+    skia_private::THashMap<SkString, std::unique_ptr<SkRasterPipelineProfile::Entry>> fEntries
+            SK_GUARDED_BY(fMutex);
+};
+
+Registry& registry() {
+    static Registry* gRegistry = new Registry;
+    return *gRegistry;
+}
+
+}  // anonymous namespace
+
+SkRasterPipelineProfile::Entry* SkRasterPipelineProfile::FindOrCreate(const SkRasterPipeline& p,
+                                                                      bool lowp) {
+    // The stage list is stored backwards.
+    skia_private::STArray<32, SkRasterPipelineOp> ops;
+    for (const SkRasterPipeline::StageList* st = p.getStageList(); st; st = st->prev) {
+        ops.push_back(st->stage);
+    }
+    SkString stages;
+    for (int i = ops.size(); i --> 0;) {
+        stages.append(SkRasterPipeline::GetOpName(ops[i]));
+        if (i > 0) {
+            stages.append(",");
+        }
+    }
+    SkString key = SkStringPrintf("%s:%s", lowp ? "lowp" : "highp", stages.c_str());
+
+    Registry& reg = registry();
+    SkAutoMutexExclusive lock(reg.fMutex);
+    if (std::unique_ptr<Entry>* entry = reg.fEntries.find(key)) {
+        return entry->get();
+    }
+    return reg.fEntries.set(key, std::unique_ptr<Entry>(new Entry(std::move(stages), lowp)))
+            ->get();
+}
+
+void SkRasterPipelineProfile::Reset() {
+    Registry& reg = registry();
+    SkAutoMutexExclusive lock(reg.fMutex);
+    reg.fEntries.foreach([](const SkString&, const std::unique_ptr<Entry>* entry) {
+        (*entry)->fRuns.store(0, std::memory_order_relaxed);
+        (*entry)->fPixels.store(0, std::memory_order_relaxed);
+        (*entry)->fNanos.store(0, std::memory_order_relaxed);
+    });
+}
+
+std::vector<SkRasterPipelineProfile::Stats> SkRasterPipelineProfile::Snapshot() {
+    std::vector<Stats> stats;
+    {
+        Registry& reg = registry();
+        SkAutoMutexExclusive lock(reg.fMutex);
+        reg.fEntries.foreach([&](const SkString&, const std::unique_ptr<Entry>* entry) {
+            const Entry& e = **entry;
+            uint64_t runs = e.fRuns.load(std::memory_order_relaxed);
+            if (runs > 0) {
+                stats.push_back({e.fStages,
+                                 e.fLowp,
+                                 runs,
+                                 e.fPixels.load(std::memory_order_relaxed),
+                                 e.fNanos.load(std::memory_order_relaxed)});
+            }
+        });
+    }
+    std::sort(stats.begin(), stats.end(), [](const Stats& a, const Stats& b) {
+        return a.fNanos != b.fNanos ? a.fNanos > b.fNanos
+                                   : strcmp(a.fStages.c_str(), b.fStages.c_str()) < 0;
+    });
+    return stats;
+}
+
+void SkRasterPipelineProfile::DumpStatistics(SkTraceMemoryDump* dump) {
+    std::vector<Stats> stats = Snapshot();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        SkString dumpName = SkStringPrintf("skia/raster_pipeline/%zu", i);
+        dump->dumpStringValue(dumpName.c_str(), "stages", stats[i].fStages.c_str());
+        dump->dumpStringValue(dumpName.c_str(), "precision", stats[i].fLowp ? "lowp" : "highp");
+        dump->dumpNumericValue(dumpName.c_str(), "runs", "objects", stats[i].fRuns);
+        dump->dumpNumericValue(dumpName.c_str(), "pixels", "objects", stats[i].fPixels);
+        dump->dumpNumericValue(dumpName.c_str(), "time", "nanoseconds", stats[i].fNanos);
+    }
+}
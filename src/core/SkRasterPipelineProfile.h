@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRasterPipelineProfile_DEFINED
+#define SkRasterPipelineProfile_DEFINED
+
+#include "include/core/SkString.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class SkRasterPipeline;
+class SkTraceMemoryDump;
+
+/**
+ * An opt-in record of every stage list SkRasterPipeline runs, with how many times each was run,
+ * how many pixels it covered, and how long it took. This is meant to find the pipelines a workload
+ * actually spends its time in (e.g. via nanobench --rasterPipelineProfile), so that they can be
+ * targeted for fusion or specialization.
+ *
+ * While disabled, the only cost to SkRasterPipeline is one relaxed atomic load per run() or
+ * compile(). Pipelines compiled while profiling was disabled are never recorded.
+ */
+class SkRasterPipelineProfile {
+public:
+    static void SetEnabled(bool enabled) {
+        gEnabled.store(enabled, std::memory_order_relaxed);
+    }
+    static bool IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+    // Zeroes the counts of every recorded pipeline. Pipelines that haven't run since are left out
+    // of Snapshot() and DumpStatistics().
+    static void Reset();
+
+    struct Stats {
+        SkString fStages;  // comma-separated op names, in execution order
+        bool     fLowp;
+        uint64_t fRuns;
+        uint64_t fPixels;
+        uint64_t fNanos;
+    };
+
+    // Returns the recorded pipelines, most expensive first.
+    static std::vector<Stats> Snapshot();
+
+    // Reports each recorded pipeline as skia/raster_pipeline/<rank>, with the stage list as a
+    // string value and numeric runs, pixels and time values.
+    static void DumpStatistics(SkTraceMemoryDump*);
+
+    // One recorded stage list. Entries are never freed, so a compiled pipeline can hold on to
+    // its entry.
+    class Entry {
+    public:
+        void record(uint64_t pixels, uint64_t nanos) {
+            fRuns.fetch_add(1, std::memory_order_relaxed);
+            fPixels.fetch_add(pixels, std::memory_order_relaxed);
+            fNanos.fetch_add(nanos, std::memory_order_relaxed);
+        }
+
+    private:
+        friend class SkRasterPipelineProfile;
+
+        Entry(SkString stages, bool lowp) : fStages(std::move(stages)), fLowp(lowp) {}
+
+        const SkString fStages;
+        const bool fLowp;
+        std::atomic<uint64_t> fRuns{0};
+        std::atomic<uint64_t> fPixels{0};
+        std::atomic<uint64_t> fNanos{0};
+    };
+
+    // Returns the entry for the pipeline's stage list, creating it if needed.
+    static Entry* FindOrCreate(const SkRasterPipeline&, bool lowp);
+
+private:
+    static std::atomic<bool> gEnabled;
+};
+
+#endif  // SkRasterPipelineProfile_DEFINED
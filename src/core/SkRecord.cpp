@@ -8,6 +8,9 @@
 #include "src/core/SkRecord.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <new>
 
 SkRecord::~SkRecord() {
     Destroyer destroyer;
@@ -16,6 +19,22 @@ SkRecord::~SkRecord() {
     }
 }
 
+void SkRecord::reset() {
+    Destroyer destroyer;
+    for (int i = 0; i < this->count(); i++) {
+        this->mutate(i, destroyer);
+    }
+    fCount = 0;
+
+    // Ops hold no pointers into each other, so the arena can be replaced wholesale.
+    const size_t firstHeapAllocation =
+            std::min<size_t>(std::max<size_t>(fApproxBytesAllocated, 256),
+                             std::numeric_limits<uint32_t>::max() / 2);
+    fAlloc.~SkArenaAlloc();
+    new (&fAlloc) SkArenaAlloc{firstHeapAllocation};
+    fApproxBytesAllocated = 0;
+}
+
 void SkRecord::grow() {
     SkASSERT(fCount == fReserved);
     fReserved = fReserved ? fReserved * 2 : 4;
@@ -97,6 +97,11 @@ public:
     // May change count() and the indices of ops, but preserves their order.
     void defrag();
 
+    // Destroy all commands, leaving this SkRecord empty and ready to be recorded into again.
+    // The command array keeps its capacity, and the arena's first block is sized to hold what
+    // was recorded before, so recording a similar frame again should need few allocations.
+    void reset();
+
 private:
     // An SkRecord is structured as an array of pointers into a big chunk of memory where
     // records representing each canvas draw call are stored:
@@ -167,6 +167,8 @@ DRAW(DrawAnnotation, drawAnnotation(r.rect, r.key.c_str(), r.value.get()))
 
 DRAW(DrawEdgeAAQuad, experimental_DrawEdgeAAQuad(
         r.rect, r.clip, r.aa, r.color, r.mode))
+DRAW(DrawEdgeAARectSet, experimental_DrawEdgeAARectSet(
+        r.rects, r.colors, r.preViewMatrices, r.count, r.aa, r.mode))
 DRAW(DrawEdgeAAImageSet, experimental_DrawEdgeAAImageSet(
         r.set.get(), r.count, r.dstClips, r.preViewMatrices, r.sampling, r.paint, r.constraint))
 
@@ -508,6 +510,17 @@ private:
         }
         return this->adjustAndMap(bounds, nullptr);
     }
+    Bounds bounds(const DrawEdgeAARectSet& op) const {
+        SkRect rect = SkRect::MakeEmpty();
+        for (int i = 0; i < op.count; ++i) {
+            SkRect entryBounds = op.rects[i];
+            if (op.preViewMatrices) {
+                op.preViewMatrices[i].mapRect(&entryBounds);
+            }
+            rect.join(this->adjustAndMap(entryBounds, nullptr));
+        }
+        return rect;
+    }
     Bounds bounds(const DrawEdgeAAImageSet& op) const {
         SkRect rect = SkRect::MakeEmpty();
         int clipIndex = 0;
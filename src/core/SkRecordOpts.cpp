@@ -18,6 +18,7 @@
 #include "src/core/SkRecordPattern.h"
 #include "src/core/SkRecords.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 
@@ -266,7 +267,164 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-void SkRecordOptimize(SkRecord* record) {
+// A paint that replaces every pixel it covers with an opaque color.
+static bool is_opaque_fill(const SkPaint& paint) {
+    return 0xFF == paint.getAlpha() &&
+           SkPaint::kFill_Style == paint.getStyle() &&
+           !paint.getShader() && !paint.getColorFilter() && !paint.getMaskFilter() &&
+           !paint.getImageFilter() && !paint.getPathEffect() &&
+           (paint.isSrcOver() || paint.asBlendMode() == SkBlendMode::kSrc);
+}
+
+// A paint whose aliased fill touches exactly the pixels its geometry covers.
+static bool is_aliased_fill(const SkPaint& paint) {
+    return !paint.isAntiAlias() &&
+           SkPaint::kFill_Style == paint.getStyle() &&
+           !paint.getMaskFilter() && !paint.getImageFilter() && !paint.getPathEffect();
+}
+
+namespace {
+
+struct IsNoOp {
+    template <typename T>
+    bool operator()(const T&) { return T::kType == NoOp_Type; }
+};
+
+// Classifies commands for SkRecordCullOccludedDraws().
+struct OcclusionInfo {
+    enum class Kind {
+        kBreak,       // Changes state or does more than draw pixels: ends the run.
+        kDraw,        // A draw that can be culled if it is painted over completely.
+        kCoverRect,   // Also paints over everything inside fBounds.
+        kCoverAll,    // Also paints over everything inside the clip.
+    };
+    Kind fKind = Kind::kBreak;
+    // For kDraw and kCoverRect, the area an aliased draw touches, if it is simple enough.
+    std::optional<SkRect> fBounds;
+};
+
+struct ClassifyForOcclusion {
+    template <typename T>
+    OcclusionInfo operator()(const T&) { return {}; }
+
+    OcclusionInfo operator()(const NoOp&) { return {OcclusionInfo::Kind::kDraw, {}}; }
+
+    OcclusionInfo operator()(const DrawRect& op) {
+        if (is_aliased_fill(op.paint)) {
+            return {is_opaque_fill(op.paint) ? OcclusionInfo::Kind::kCoverRect
+                                             : OcclusionInfo::Kind::kDraw,
+                    op.rect.makeSorted()};
+        }
+        return {OcclusionInfo::Kind::kDraw, {}};
+    }
+    OcclusionInfo operator()(const DrawImageRect& op) {
+        if (!op.paint || is_aliased_fill(*op.paint)) {
+            return {OcclusionInfo::Kind::kDraw, op.dst.makeSorted()};
+        }
+        return {OcclusionInfo::Kind::kDraw, {}};
+    }
+    OcclusionInfo operator()(const DrawPaint& op) {
+        return {is_opaque_fill(op.paint) ? OcclusionInfo::Kind::kCoverAll
+                                         : OcclusionInfo::Kind::kDraw, {}};
+    }
+
+    // These only draw pixels inside their own geometry, and never read them from elsewhere.
+    OcclusionInfo operator()(const DrawArc&)      { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawDRRect&)   { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawImage&)    { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawOval&)     { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawPath&)     { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawPoints&)   { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawRRect&)    { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawRegion&)   { return {OcclusionInfo::Kind::kDraw, {}}; }
+    OcclusionInfo operator()(const DrawTextBlob&) { return {OcclusionInfo::Kind::kDraw, {}}; }
+};
+
+}  // namespace
+
+// How far back an opaque rect looks for draws to cull, to keep long runs linear.
+static constexpr int kMaxOcclusionLookback = 64;
+
+int SkRecordCullOccludedDraws(SkRecord* record) {
+    int culled = 0;
+    int runStart = 0;
+    for (int i = 0; i < record->count(); ++i) {
+        OcclusionInfo cover = record->visit(i, ClassifyForOcclusion());
+        switch (cover.fKind) {
+            case OcclusionInfo::Kind::kBreak:
+                runStart = i + 1;
+                break;
+            case OcclusionInfo::Kind::kDraw:
+                break;
+            case OcclusionInfo::Kind::kCoverAll:
+                for (int j = runStart; j < i; ++j) {
+                    if (!record->visit(j, IsNoOp())) {
+                        record->replace<NoOp>(j);
+                        ++culled;
+                    }
+                }
+                runStart = i;
+                break;
+            case OcclusionInfo::Kind::kCoverRect:
+                // Both draws are aliased and share a matrix, so every pixel center inside the
+                // earlier draw is also inside this one, whatever the matrix is.
+                for (int j = std::max(runStart, i - kMaxOcclusionLookback); j < i; ++j) {
+                    OcclusionInfo draw = record->visit(j, ClassifyForOcclusion());
+                    if (draw.fBounds && cover.fBounds->contains(*draw.fBounds)) {
+                        record->replace<NoOp>(j);
+                        ++culled;
+                    }
+                }
+                break;
+        }
+    }
+    return culled;
+}
+
+namespace {
+
+// Returns the command if it is an aliased intersect ClipRect, nullptr otherwise.
+struct AsAliasedClipRect {
+    template <typename T>
+    const ClipRect* operator()(const T&) { return nullptr; }
+
+    const ClipRect* operator()(const ClipRect& op) {
+        return !op.opAA.aa() && op.opAA.op() == SkClipOp::kIntersect ? &op : nullptr;
+    }
+};
+
+}  // namespace
+
+int SkRecordNoopRedundantClips(SkRecord* record) {
+    int removed = 0;
+    const ClipRect* previous = nullptr;
+    for (int i = 0; i < record->count(); ++i) {
+        if (record->visit(i, IsNoOp())) {
+            continue;
+        }
+        const ClipRect* clip = record->visit(i, AsAliasedClipRect());
+        // The clip is already inside this rect, so intersecting with it changes nothing.
+        if (clip && previous && clip->rect.makeSorted().contains(previous->rect.makeSorted())) {
+            record->replace<NoOp>(i);
+            ++removed;
+            continue;
+        }
+        previous = clip;
+    }
+    return removed;
+}
+
+static int count_noops(const SkRecord& record) {
+    int count = 0;
+    for (int i = 0; i < record.count(); ++i) {
+        count += record.visit(i, IsNoOp()) ? 1 : 0;
+    }
+    return count;
+}
+
+void SkRecordOptimize(SkRecord* record, SkRecordOptimizeStats* stats) {
+    const int initialNoOps = stats ? count_noops(*record) : 0;
+
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
     // and the bounding box hierarchy will do the work of skipping no-op
@@ -284,5 +442,13 @@ void SkRecordOptimize(SkRecord* record) {
 #endif
     SkRecordMergeSvgOpacityAndFilterLayers(record);
 
+    int removedClips = SkRecordNoopRedundantClips(record);
+    int culledDraws = SkRecordCullOccludedDraws(record);
+    if (stats) {
+        stats->fRemovedOps += count_noops(*record) - initialNoOps;
+        stats->fCulledDraws += culledDraws;
+        stats->fRemovedClips += removedClips;
+    }
+
     record->defrag();
 }
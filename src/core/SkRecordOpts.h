@@ -10,8 +10,15 @@
 
 class SkRecord;
 
+// Counts of the commands removed by SkRecordOptimize().
+struct SkRecordOptimizeStats {
+    int fRemovedOps = 0;     // All commands turned into NoOps, including those below.
+    int fCulledDraws = 0;    // Draws hidden by a later opaque draw.
+    int fRemovedClips = 0;   // Clips that could not shrink the clip any further.
+};
+
 // Run all optimizations in recommended order.
-void SkRecordOptimize(SkRecord*);
+void SkRecordOptimize(SkRecord*, SkRecordOptimizeStats* = nullptr);
 
 // Turns logical no-op Save-[non-drawing command]*-Restore patterns into actual no-ops.
 void SkRecordNoopSaveRestores(SkRecord*);
@@ -26,4 +33,13 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Within a run of plain draws that share the same matrix and clip, no-ops the draws which are
+// entirely painted over by a later opaque DrawPaint or aliased DrawRect. Returns the number of
+// draws removed.
+int SkRecordCullOccludedDraws(SkRecord*);
+
+// No-ops an aliased intersect ClipRect that directly follows one it contains. Returns the number
+// of clips removed.
+int SkRecordNoopRedundantClips(SkRecord*);
+
 #endif//SkRecordOpts_DEFINED
@@ -319,6 +319,14 @@ void SkRecorder::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
             rect, this->copy(clip, 4), aa, color, mode);
 }
 
+void SkRecorder::onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                     const SkMatrix preViewMatrices[], int count,
+                                     QuadAAFlags aa, SkBlendMode mode) {
+    this->append<SkRecords::DrawEdgeAARectSet>(
+            this->copy(rects, count), this->copy(colors, count),
+            this->copy(preViewMatrices, count), count, aa, mode);
+}
+
 void SkRecorder::onDrawEdgeAAImageSet2(const ImageSetEntry set[], int count,
                                        const SkPoint dstClips[], const SkMatrix preViewMatrices[],
                                        const SkSamplingOptions& sampling, const SkPaint* paint,
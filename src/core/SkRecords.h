@@ -95,6 +95,7 @@ namespace SkRecords {
     M(DrawShadowRec)                                                \
     M(DrawAnnotation)                                               \
     M(DrawEdgeAAQuad)                                               \
+    M(DrawEdgeAARectSet)                                            \
     M(DrawEdgeAAImageSet)
 
 
@@ -357,6 +358,13 @@ RECORD(DrawEdgeAAQuad, kDraw_Tag,
        SkCanvas::QuadAAFlags aa;
        SkColor4f color;
        SkBlendMode mode)
+RECORD(DrawEdgeAARectSet, kDraw_Tag|kMultiDraw_Tag,
+       PODArray<SkRect> rects;
+       PODArray<SkColor4f> colors;
+       PODArray<SkMatrix> preViewMatrices;
+       int count;
+       SkCanvas::QuadAAFlags aa;
+       SkBlendMode mode)
 RECORD(DrawEdgeAAImageSet, kDraw_Tag|kHasImage_Tag|kHasPaint_Tag|kMultiDraw_Tag,
        Optional<SkPaint> paint;
        skia_private::AutoTArray<SkCanvas::ImageSetEntry> set;
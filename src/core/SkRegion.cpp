@@ -328,10 +328,19 @@ bool SkRegion::setRuns(RunType runs[], int count) {
 
     //  if we get here, we need to become a complex region
 
-    if (!this->isComplex() || fRunHead->fRunCount != count) {
-        this->freeRuns();
+    if (!this->isComplex()) {
         this->allocateRuns(count);
         SkASSERT(this->isComplex());
+    } else if (fRunHead->fRunCount != count) {
+        if (fRunHead->fRefCnt == 1) {
+            // We are the only owner, so resize our runs in place. Regions that are repeatedly
+            // the result of an op, like a clip updated every frame, keep their storage.
+            fRunHead = RunHead::Realloc(fRunHead, count);
+        } else {
+            this->freeRuns();
+            this->allocateRuns(count);
+        }
+        SkASSERT(this->isComplex());
     }
 
     // must call this before we can write directly into runs()
@@ -779,15 +788,44 @@ static int distance_to_sentinel(const SkRegionPriv::RunType* runs) {
     return ptr - runs;
 }
 
+static bool span_is_inside(int inside, int min, int max) {
+    return (unsigned)(inside - min) <= (unsigned)(max - min);
+}
+
 static int operate_on_span(const SkRegionPriv::RunType a_runs[],
                            const SkRegionPriv::RunType b_runs[],
                            RunArray* array, int dstOffset,
                            int min, int max) {
+    const int a_count = distance_to_sentinel(a_runs);
+    const int b_count = distance_to_sentinel(b_runs);
+
     // This is a worst-case for this span plus two for TWO terminating sentinels.
-    array->resizeToAtLeast(
-            dstOffset + distance_to_sentinel(a_runs) + distance_to_sentinel(b_runs) + 2);
+    array->resizeToAtLeast(dstOffset + a_count + b_count + 2);
     SkRegionPriv::RunType* dst = &(*array)[dstOffset]; // get pointer AFTER resizing.
 
+    // If the intervals of a and b do not overlap or touch (including when either is empty), the
+    // result is just the intervals of each side that the op keeps, in x order. Copy them whole
+    // instead of merging them edge by edge. This is the common case for bands covered by only one
+    // of the regions, and for regions side by side.
+    const bool a_first = a_count == 0 || (b_count > 0 && a_runs[a_count - 1] < b_runs[0]);
+    const bool b_first = b_count == 0 || (a_count > 0 && b_runs[b_count - 1] < a_runs[0]);
+    if (a_first || b_first) {
+        const struct {
+            const SkRegionPriv::RunType* fRuns;
+            int fCount;
+            int fInside;
+        } sides[] = {{a_runs, a_count, 1}, {b_runs, b_count, 2}};
+        for (int i = 0; i < 2; ++i) {
+            const auto& side = sides[a_first ? i : 1 - i];
+            if (side.fCount > 0 && span_is_inside(side.fInside, min, max)) {
+                memcpy(dst, side.fRuns, side.fCount * sizeof(SkRegionPriv::RunType));
+                dst += side.fCount;
+            }
+        }
+        *dst++ = SkRegion_kRunTypeSentinel;
+        return dst - &(*array)[0];
+    }
+
     spanRec rec;
     bool    firstInterval = true;
 
@@ -800,8 +838,7 @@ static int operate_on_span(const SkRegionPriv::RunType a_runs[],
         int rite = rec.fRite;
 
         // add left,rite to our dst buffer (checking for coincidence
-        if ((unsigned)(rec.fInside - min) <= (unsigned)(max - min) &&
-                left < rite) {    // skip if equal
+        if (span_is_inside(rec.fInside, min, max) && left < rite) {    // skip if equal
             if (firstInterval || *(dst - 1) < left) {
                 *dst++ = (SkRegionPriv::RunType)(left);
                 *dst++ = (SkRegionPriv::RunType)(rite);
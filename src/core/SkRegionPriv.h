@@ -99,6 +99,21 @@ public:
         return head;
     }
 
+    // Resizes the runs of a head that is not shared. The runs must be filled in again.
+    static RunHead* Realloc(RunHead* head, int count) {
+        SkASSERT(head->fRefCnt == 1);
+        SkASSERT(count >= SkRegion::kRectRegionRuns);
+
+        const int64_t size = sk_64_mul(count, sizeof(RunType)) + sizeof(RunHead);
+        if (!SkTFitsIn<int32_t>(size)) { SK_ABORT("Invalid Size"); }
+
+        head = (RunHead*)sk_realloc_throw(head, size);
+        head->fRunCount = count;
+        head->fYSpanCount = 0;
+        head->fIntervalCount = 0;
+        return head;
+    }
+
     static RunHead* Alloc(int count, int yspancount, int intervalCount) {
         if (yspancount <= 0 || intervalCount <= 1) {
             return nullptr;
@@ -23,6 +23,7 @@
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkTHash.h"
+#include "src/core/SkTraceEvent.h"
 
 #if defined(SK_USE_DISCARDABLE_SCALEDIMAGECACHE)
 #include "include/private/chromium/SkDiscardableMemory.h"
@@ -52,6 +53,10 @@ static inline bool SkShouldPostMessageToBus(
     #define SK_DEFAULT_IMAGE_CACHE_LIMIT     (32 * 1024 * 1024)
 #endif
 
+#ifndef SK_DEFAULT_IMAGE_CACHE_SHARDS
+    #define SK_DEFAULT_IMAGE_CACHE_SHARDS    8
+#endif
+
 void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t dataSize) {
     SkASSERT(SkAlign4(dataSize) == dataSize);
 
@@ -89,10 +94,14 @@ class SkResourceCache::Hash :
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void SkResourceCache::init() {
-    fHead = nullptr;
-    fTail = nullptr;
-    fHash = new Hash;
+void SkResourceCache::init(int shardCount) {
+    SkASSERT(shardCount > 0);
+    fShardCount = std::max(shardCount, 1);
+    fShards = std::make_unique<Shard[]>(fShardCount);
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fHash = new Hash;
+    }
     fTotalBytesUsed = 0;
     fCount = 0;
     fSingleAllocationByteLimit = 0;
@@ -102,26 +111,36 @@ void SkResourceCache::init() {
     fDiscardableFactory = nullptr;
 }
 
-SkResourceCache::SkResourceCache(DiscardableFactory factory)
+SkResourceCache::SkResourceCache(DiscardableFactory factory, int shardCount)
         : fPurgeSharedIDInbox(SK_InvalidUniqueID) {
-    this->init();
+    this->init(shardCount);
     fDiscardableFactory = factory;
 }
 
-SkResourceCache::SkResourceCache(size_t byteLimit)
+SkResourceCache::SkResourceCache(size_t byteLimit, int shardCount)
         : fPurgeSharedIDInbox(SK_InvalidUniqueID) {
-    this->init();
+    this->init(shardCount);
     fTotalByteLimit = byteLimit;
 }
 
 SkResourceCache::~SkResourceCache() {
-    Rec* rec = fHead;
-    while (rec) {
-        Rec* next = rec->fNext;
-        delete rec;
-        rec = next;
+    for (int i = 0; i < fShardCount; ++i) {
+        Shard* shard = &fShards[i];
+        SkAutoMutexExclusive am(shard->fMutex);
+        Rec* rec = shard->fHead;
+        while (rec) {
+            Rec* next = rec->fNext;
+            delete rec;
+            rec = next;
+        }
+        delete shard->fHash;
     }
-    delete fHash;
+}
+
+SkResourceCache::Shard* SkResourceCache::shardFor(const Key& key) const {
+    // Use the top bits of the hash; the bottom bits pick the slot in the shard's hash table, and
+    // sharding on them would leave most of each table's slots unused.
+    return &fShards[(uint64_t)key.hash() * fShardCount >> 32];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -129,17 +148,20 @@ SkResourceCache::~SkResourceCache() {
 bool SkResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
     this->checkMessages();
 
-    if (auto found = fHash->find(key)) {
+    Shard* shard = this->shardFor(key);
+    SkAutoMutexExclusive am(shard->fMutex);
+    bool hit = false;
+    if (auto found = shard->fHash->find(key)) {
         Rec* rec = *found;
         if (visitor(*rec, context)) {
-            this->moveToHead(rec);  // for our LRU
-            return true;
+            this->moveToHead(shard, rec);  // for our LRU
+            hit = true;
         } else {
-            this->remove(rec);  // stale
-            return false;
+            this->remove(shard, rec);  // stale
         }
     }
-    return false;
+    TRACE_CACHE_LOOKUP("skia", "SkResourceCache lookups", hit);
+    return hit;
 }
 
 static void make_size_str(size_t size, SkString* str) {
@@ -158,12 +180,14 @@ void SkResourceCache::add(Rec* rec, void* payload) {
     this->checkMessages();
 
     SkASSERT(rec);
+    Shard* shard = this->shardFor(rec->getKey());
+    SkAutoMutexExclusive am(shard->fMutex);
     // See if we already have this key (racy inserts, etc.)
-    if (Rec** preexisting = fHash->find(rec->getKey())) {
+    if (Rec** preexisting = shard->fHash->find(rec->getKey())) {
         Rec* prev = *preexisting;
         if (prev->canBePurged()) {
             // if it can be purged, the install may fail, so we have to remove it
-            this->remove(prev);
+            this->remove(shard, prev);
         } else {
             // if it cannot be purged, we reuse it and delete the new one
             prev->postAddInstall(payload);
@@ -172,47 +196,58 @@ void SkResourceCache::add(Rec* rec, void* payload) {
         }
     }
 
-    this->addToHead(rec);
-    fHash->set(rec);
+    this->addToHead(shard, rec);
+    shard->fHash->set(rec);
     rec->postAddInstall(payload);
+    TRACE_COUNTER2("skia", "SkResourceCache", "bytes", this->getTotalBytesUsed(),
+                   "count", fCount.load(std::memory_order_relaxed));
 
     if (gDumpCacheTransactions) {
         SkString bytesStr, totalStr;
         make_size_str(rec->bytesUsed(), &bytesStr);
-        make_size_str(fTotalBytesUsed, &totalStr);
+        make_size_str(this->getTotalBytesUsed(), &totalStr);
         SkDebugf("RC:    add %5s %12p key %08x -- total %5s, count %d\n",
-                 bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount);
+                 bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount.load());
     }
 
     // since the new rec may push us over-budget, we perform a purge check now
-    this->purgeAsNeeded();
+    this->purgeAsNeeded(shard, false);
 }
 
-void SkResourceCache::remove(Rec* rec) {
+void SkResourceCache::remove(Shard* shard, Rec* rec) {
     SkASSERT(rec->canBePurged());
     size_t used = rec->bytesUsed();
-    SkASSERT(used <= fTotalBytesUsed);
+    SkASSERT(used <= shard->fBytesUsed);
 
-    this->release(rec);
-    fHash->remove(rec->getKey());
+    this->release(shard, rec);
+    shard->fHash->remove(rec->getKey());
 
-    fTotalBytesUsed -= used;
-    fCount -= 1;
+    shard->fBytesUsed -= used;
+    shard->fCount -= 1;
+    fTotalBytesUsed.fetch_sub(used, std::memory_order_relaxed);
+    fCount.fetch_sub(1, std::memory_order_relaxed);
 
     //SkDebugf("-RC count [%3d] bytes %d\n", fCount, fTotalBytesUsed);
 
     if (gDumpCacheTransactions) {
         SkString bytesStr, totalStr;
         make_size_str(used, &bytesStr);
-        make_size_str(fTotalBytesUsed, &totalStr);
+        make_size_str(this->getTotalBytesUsed(), &totalStr);
         SkDebugf("RC: remove %5s %12p key %08x -- total %5s, count %d\n",
-                 bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount);
+                 bytesStr.c_str(), rec, rec->getHash(), totalStr.c_str(), fCount.load());
     }
 
     delete rec;
 }
 
 void SkResourceCache::purgeAsNeeded(bool forcePurge) {
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        this->purgeAsNeeded(&fShards[i], forcePurge);
+    }
+}
+
+void SkResourceCache::purgeAsNeeded(Shard* shard, bool forcePurge) {
     size_t byteLimit;
     int    countLimit;
 
@@ -221,18 +256,27 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
         byteLimit = UINT32_MAX;  // no limit based on bytes
     } else {
         countLimit = SK_MaxS32; // no limit based on count
-        byteLimit = fTotalByteLimit;
+        byteLimit = this->getTotalByteLimit();
     }
 
-    Rec* rec = fTail;
+    // A shard is only purged down to its share of a budget while the whole cache is over that
+    // budget, so a large rec that happens to land in a shard isn't evicted while there's room.
+    const size_t shardByteLimit = byteLimit / fShardCount;
+    const int    shardCountLimit = countLimit / fShardCount;
+
+    Rec* rec = shard->fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        const bool underByteLimit = this->getTotalBytesUsed() < byteLimit ||
+                                    shard->fBytesUsed < shardByteLimit;
+        const bool underCountLimit = fCount.load(std::memory_order_relaxed) < countLimit ||
+                                     shard->fCount < shardCountLimit;
+        if (!forcePurge && underByteLimit && underCountLimit) {
             break;
         }
 
         Rec* prev = rec->fPrev;
         if (rec->canBePurged()) {
-            this->remove(rec);
+            this->remove(shard, rec);
         }
         rec = prev;
     }
@@ -252,51 +296,59 @@ void SkResourceCache::purgeSharedID(uint64_t sharedID) {
 
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
     gPurgeCallCounter += 1;
-    bool found = false;
+    int found = fCount;
 #endif
+    // The sharedID is part of the hashed key, so recs sharing one can be in any shard.
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        this->purgeSharedID(&fShards[i], sharedID);
+    }
+
+#ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
+    if (found != fCount) {
+        gPurgeHitCounter += 1;
+    }
+
+    SkDebugf("PurgeShared calls=%d hits=%d rate=%g\n", gPurgeCallCounter, gPurgeHitCounter,
+             gPurgeHitCounter * 100.0 / gPurgeCallCounter);
+#endif
+}
+
+void SkResourceCache::purgeSharedID(Shard* shard, uint64_t sharedID) {
     // go backwards, just like purgeAsNeeded, just to make the code similar.
     // could iterate either direction and still be correct.
-    Rec* rec = fTail;
+    Rec* rec = shard->fTail;
     while (rec) {
         Rec* prev = rec->fPrev;
         if (rec->getKey().getSharedID() == sharedID) {
             // even though the "src" is now dead, caches could still be in-flight, so
             // we have to check if it can be removed.
             if (rec->canBePurged()) {
-                this->remove(rec);
+                this->remove(shard, rec);
             }
-#ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
-            found = true;
-#endif
         }
         rec = prev;
     }
-
-#ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
-    if (found) {
-        gPurgeHitCounter += 1;
-    }
-
-    SkDebugf("PurgeShared calls=%d hits=%d rate=%g\n", gPurgeCallCounter, gPurgeHitCounter,
-             gPurgeHitCounter * 100.0 / gPurgeCallCounter);
-#endif
 }
 
 void SkResourceCache::visitAll(Visitor visitor, void* context) {
-    // go backwards, just like purgeAsNeeded, just to make the code similar.
-    // could iterate either direction and still be correct.
-    Rec* rec = fTail;
-    while (rec) {
-        visitor(*rec, context);
-        rec = rec->fPrev;
+    for (int i = 0; i < fShardCount; ++i) {
+        Shard* shard = &fShards[i];
+        SkAutoMutexExclusive am(shard->fMutex);
+        // go backwards, just like purgeAsNeeded, just to make the code similar.
+        // could iterate either direction and still be correct.
+        Rec* rec = shard->fTail;
+        while (rec) {
+            visitor(*rec, context);
+            rec = rec->fPrev;
+        }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 size_t SkResourceCache::setTotalByteLimit(size_t newLimit) {
-    size_t prevLimit = fTotalByteLimit;
-    fTotalByteLimit = newLimit;
+    size_t prevLimit = fTotalByteLimit.exchange(newLimit, std::memory_order_relaxed);
     if (newLimit < prevLimit) {
         this->purgeAsNeeded();
     }
@@ -316,19 +368,19 @@ SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void SkResourceCache::release(Rec* rec) {
+void SkResourceCache::release(Shard* shard, Rec* rec) {
     Rec* prev = rec->fPrev;
     Rec* next = rec->fNext;
 
     if (!prev) {
-        SkASSERT(fHead == rec);
-        fHead = next;
+        SkASSERT(shard->fHead == rec);
+        shard->fHead = next;
     } else {
         prev->fNext = next;
     }
 
     if (!next) {
-        fTail = prev;
+        shard->fTail = prev;
     } else {
         next->fPrev = prev;
     }
@@ -336,77 +388,81 @@ void SkResourceCache::release(Rec* rec) {
     rec->fNext = rec->fPrev = nullptr;
 }
 
-void SkResourceCache::moveToHead(Rec* rec) {
-    if (fHead == rec) {
+void SkResourceCache::moveToHead(Shard* shard, Rec* rec) {
+    if (shard->fHead == rec) {
         return;
     }
 
-    SkASSERT(fHead);
-    SkASSERT(fTail);
+    SkASSERT(shard->fHead);
+    SkASSERT(shard->fTail);
 
-    this->validate();
+    this->validate(shard);
 
-    this->release(rec);
+    this->release(shard, rec);
 
-    fHead->fPrev = rec;
-    rec->fNext = fHead;
-    fHead = rec;
+    shard->fHead->fPrev = rec;
+    rec->fNext = shard->fHead;
+    shard->fHead = rec;
 
-    this->validate();
+    this->validate(shard);
 }
 
-void SkResourceCache::addToHead(Rec* rec) {
-    this->validate();
+void SkResourceCache::addToHead(Shard* shard, Rec* rec) {
+    this->validate(shard);
 
     rec->fPrev = nullptr;
-    rec->fNext = fHead;
-    if (fHead) {
-        fHead->fPrev = rec;
+    rec->fNext = shard->fHead;
+    if (shard->fHead) {
+        shard->fHead->fPrev = rec;
     }
-    fHead = rec;
-    if (!fTail) {
-        fTail = rec;
+    shard->fHead = rec;
+    if (!shard->fTail) {
+        shard->fTail = rec;
     }
-    fTotalBytesUsed += rec->bytesUsed();
-    fCount += 1;
+    shard->fBytesUsed += rec->bytesUsed();
+    shard->fCount += 1;
+    fTotalBytesUsed.fetch_add(rec->bytesUsed(), std::memory_order_relaxed);
+    fCount.fetch_add(1, std::memory_order_relaxed);
 
-    this->validate();
+    this->validate(shard);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef SK_DEBUG
-void SkResourceCache::validate() const {
-    if (nullptr == fHead) {
-        SkASSERT(nullptr == fTail);
-        SkASSERT(0 == fTotalBytesUsed);
+void SkResourceCache::validate(const Shard* shard) const {
+    const Rec* head = shard->fHead;
+    const Rec* tail = shard->fTail;
+    if (nullptr == head) {
+        SkASSERT(nullptr == tail);
+        SkASSERT(0 == shard->fBytesUsed);
         return;
     }
 
-    if (fHead == fTail) {
-        SkASSERT(nullptr == fHead->fPrev);
-        SkASSERT(nullptr == fHead->fNext);
-        SkASSERT(fHead->bytesUsed() == fTotalBytesUsed);
+    if (head == tail) {
+        SkASSERT(nullptr == head->fPrev);
+        SkASSERT(nullptr == head->fNext);
+        SkASSERT(head->bytesUsed() == shard->fBytesUsed);
         return;
     }
 
-    SkASSERT(nullptr == fHead->fPrev);
-    SkASSERT(fHead->fNext);
-    SkASSERT(nullptr == fTail->fNext);
-    SkASSERT(fTail->fPrev);
+    SkASSERT(nullptr == head->fPrev);
+    SkASSERT(head->fNext);
+    SkASSERT(nullptr == tail->fNext);
+    SkASSERT(tail->fPrev);
 
     size_t used = 0;
     int count = 0;
-    const Rec* rec = fHead;
+    const Rec* rec = head;
     while (rec) {
         count += 1;
         used += rec->bytesUsed();
-        SkASSERT(used <= fTotalBytesUsed);
+        SkASSERT(used <= shard->fBytesUsed);
         rec = rec->fNext;
     }
-    SkASSERT(fCount == count);
+    SkASSERT(shard->fCount == count);
 
-    rec = fTail;
+    rec = tail;
     while (rec) {
         SkASSERT(count > 0);
         count -= 1;
@@ -421,33 +477,54 @@ void SkResourceCache::validate() const {
 #endif
 
 void SkResourceCache::dump() const {
-    this->validate();
+    for (int i = 0; i < fShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        this->validate(&fShards[i]);
+    }
 
-    SkDebugf("SkResourceCache: count=%d bytes=%zu %s\n",
-             fCount, fTotalBytesUsed, fDiscardableFactory ? "discardable" : "malloc");
+    SkDebugf("SkResourceCache: count=%d bytes=%zu shards=%d %s\n",
+             fCount.load(), this->getTotalBytesUsed(), fShardCount,
+             fDiscardableFactory ? "discardable" : "malloc");
+}
+
+void SkResourceCache::dumpShardStatistics(SkTraceMemoryDump* dump) const {
+    for (int i = 0; i < fShardCount; ++i) {
+        const Shard& shard = fShards[i];
+        size_t bytesUsed;
+        int count;
+        {
+            SkAutoMutexExclusive am(shard.fMutex);
+            bytesUsed = shard.fBytesUsed;
+            count = shard.fCount;
+        }
+        // The recs themselves are dumped with their backing, so these are reported under names
+        // that don't add to the cache's size.
+        SkString dumpName = SkStringPrintf("skia/sk_resource_cache/shard_%d", i);
+        dump->dumpNumericValue(dumpName.c_str(), "bytes_used", "bytes", bytesUsed);
+        dump->dumpNumericValue(dumpName.c_str(), "rec_count", "objects", count);
+    }
 }
 
 size_t SkResourceCache::setSingleAllocationByteLimit(size_t newLimit) {
-    size_t oldLimit = fSingleAllocationByteLimit;
-    fSingleAllocationByteLimit = newLimit;
-    return oldLimit;
+    return fSingleAllocationByteLimit.exchange(newLimit, std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::getSingleAllocationByteLimit() const {
-    return fSingleAllocationByteLimit;
+    return fSingleAllocationByteLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkResourceCache::getEffectiveSingleAllocationByteLimit() const {
     // fSingleAllocationByteLimit == 0 means the caller is asking for our default
-    size_t limit = fSingleAllocationByteLimit;
+    size_t limit = this->getSingleAllocationByteLimit();
 
     // if we're not discardable (i.e. we are fixed-budget) then cap the single-limit
     // to our budget.
     if (nullptr == fDiscardableFactory) {
+        const size_t totalByteLimit = this->getTotalByteLimit();
         if (0 == limit) {
-            limit = fTotalByteLimit;
+            limit = totalByteLimit;
         } else {
-            limit = std::min(limit, fTotalByteLimit);
+            limit = std::min(limit, totalByteLimit);
         }
     }
     return limit;
@@ -463,93 +540,71 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
-    return mutex;
-}
-
-/** Must hold resource_cache_mutex() when calling. */
 static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    if (nullptr == gResourceCache) {
+    // The cache is internally synchronized, so it only needs a thread-safe initialization.
+    static SkResourceCache* gResourceCache = [] {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        return new SkResourceCache(SkDiscardableMemory::Create, SK_DEFAULT_IMAGE_CACHE_SHARDS);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        return new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT, SK_DEFAULT_IMAGE_CACHE_SHARDS);
 #endif
-    }
+    }();
     return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getTotalBytesUsed();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getTotalByteLimit();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->setTotalByteLimit(newLimit);
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     get_cache()->dump();
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->setSingleAllocationByteLimit(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->purgeAll();
 }
 
 void SkResourceCache::CheckMessages() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->checkMessages();
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     return get_cache()->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     get_cache()->add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
     get_cache()->visitAll(visitor, context);
 }
 
@@ -617,4 +672,5 @@ void SkResourceCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
     // Since resource could be backed by malloc or discardable, the cache always dumps detailed
     // stats to be accurate.
     VisitAll(sk_trace_dump_visitor, dump);
+    get_cache()->dumpShardStatistics(dump);
 }
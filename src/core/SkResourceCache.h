@@ -9,10 +9,13 @@
 #define SkResourceCache_DEFINED
 
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkMutex.h"
 #include "src/core/SkMessageBus.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 class SkCachedData;
 class SkDiscardableMemory;
@@ -21,12 +24,15 @@ class SkTraceMemoryDump;
 /**
  *  Cache object for bitmaps (with possible scale in X Y as part of the key).
  *
- *  Multiple caches can be instantiated, but each instance is not implicitly
- *  thread-safe, so if a given instance is to be shared across threads, the
- *  caller must manage the access itself (e.g. via a mutex).
+ *  Multiple caches can be instantiated, and each instance is thread-safe. Recs
+ *  are spread over one or more shards by key hash; each shard has its own lock
+ *  and LRU list, so threads working with keys in different shards don't wait
+ *  on each other. The byte and count budgets apply to the whole cache: once the
+ *  cache is over budget, a shard being added to is purged down to its share.
+ *  With more than one shard the budget is therefore only enforced approximately.
  *
- *  As a convenience, a global instance is also defined, which can be safely
- *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  As a convenience, a global, sharded instance is also defined, which can be
+ *  accessed via the static methods (e.g. Find, Add, etc.).
  */
 class SkResourceCache {
 public:
@@ -199,7 +205,7 @@ public:
      *  and getTotalByteLimit() will return 0, and setTotalByteLimit
      *  will ignore its argument and return 0.
      */
-    SkResourceCache(DiscardableFactory);
+    SkResourceCache(DiscardableFactory, int shardCount = 1);
 
     /**
      *  Construct the cache, allocating memory with malloc, and respect the
@@ -207,7 +213,7 @@ public:
      *  that pushes the total bytesUsed over the limit. Note: The limit can be
      *  changed at runtime with setTotalByteLimit.
      */
-    explicit SkResourceCache(size_t byteLimit);
+    explicit SkResourceCache(size_t byteLimit, int shardCount = 1);
     ~SkResourceCache();
 
     /**
@@ -223,8 +229,9 @@ public:
     void add(Rec*, void* payload = nullptr);
     void visitAll(Visitor, void* context);
 
-    size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
-    size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    size_t getTotalBytesUsed() const { return fTotalBytesUsed.load(std::memory_order_relaxed); }
+    size_t getTotalByteLimit() const { return fTotalByteLimit.load(std::memory_order_relaxed); }
+    int shardCount() const { return fShardCount; }
 
     /**
      *  This is respected by SkBitmapProcState::possiblyScaleImage.
@@ -259,37 +266,58 @@ public:
      */
     void dump() const;
 
-private:
-    Rec*    fHead;
-    Rec*    fTail;
+    /**
+     *  Dump the byte and rec counts of each shard using the SkTraceMemoryDump interface.
+     */
+    void dumpShardStatistics(SkTraceMemoryDump*) const;
 
+private:
     class Hash;
-    Hash*   fHash;
+
+    struct Shard {
+        mutable SkMutex fMutex;
+
+        Rec*    fHead SK_GUARDED_BY(fMutex) = nullptr;
+        Rec*    fTail SK_GUARDED_BY(fMutex) = nullptr;
+        Hash*   fHash SK_GUARDED_BY(fMutex) = nullptr;
+
+        size_t  fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+        int     fCount SK_GUARDED_BY(fMutex) = 0;
+    };
+
+    std::unique_ptr<Shard[]> fShards;
+    int                      fShardCount;
 
     DiscardableFactory  fDiscardableFactory;
 
-    size_t  fTotalBytesUsed;
-    size_t  fTotalByteLimit;
-    size_t  fSingleAllocationByteLimit;
-    int     fCount;
+    // Totals across all shards, updated under the lock of the shard that changed.
+    std::atomic<size_t> fTotalBytesUsed;
+    std::atomic<int>    fCount;
+
+    std::atomic<size_t> fTotalByteLimit;
+    std::atomic<size_t> fSingleAllocationByteLimit;
 
     SkMessageBus<PurgeSharedIDMessage, uint32_t>::Inbox fPurgeSharedIDInbox;
 
+    Shard* shardFor(const Key&) const;
+
     void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
+    void purgeAsNeeded(Shard* shard, bool forcePurge) SK_REQUIRES(shard->fMutex);
+    void purgeSharedID(Shard* shard, uint64_t sharedID) SK_REQUIRES(shard->fMutex);
 
     // linklist management
-    void moveToHead(Rec*);
-    void addToHead(Rec*);
-    void release(Rec*);
-    void remove(Rec*);
+    void moveToHead(Shard* shard, Rec*) SK_REQUIRES(shard->fMutex);
+    void addToHead(Shard* shard, Rec*) SK_REQUIRES(shard->fMutex);
+    void release(Shard* shard, Rec*) SK_REQUIRES(shard->fMutex);
+    void remove(Shard* shard, Rec*) SK_REQUIRES(shard->fMutex);
 
-    void init();    // called by constructors
+    void init(int shardCount);    // called by constructors
 
 #ifdef SK_DEBUG
-    void validate() const;
+    void validate(const Shard* shard) const SK_REQUIRES(shard->fMutex);
 #else
-    void validate() const {}
+    void validate(const Shard*) const {}
 #endif
 };
 #endif
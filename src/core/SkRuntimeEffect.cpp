@@ -61,6 +61,8 @@
 #include "src/sksl/tracing/SkSLDebugTracePriv.h"
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
 
 using namespace skia_private;
 
@@ -464,9 +466,152 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
 // in the IR generator would provide better errors messages (with locations).
 #define RETURN_FAILURE(...) return Result{nullptr, SkStringPrintf(__VA_ARGS__)}
 
+namespace {
+
+// Everything besides the SkSL that affects how an effect is compiled. (No padding, so that it can
+// be hashed as bytes.)
+struct EffectCacheOptions {
+    int32_t  fKind;
+    int32_t  fMaxVersionAllowed;
+    uint32_t fStableKey;
+    uint32_t fFlags;
+
+    enum : uint32_t {
+        kForceUnoptimized   = 1 << 0,
+        kAllowPrivateAccess = 1 << 1,
+    };
+
+    bool operator==(const EffectCacheOptions& that) const {
+        return fKind == that.fKind &&
+               fMaxVersionAllowed == that.fMaxVersionAllowed &&
+               fStableKey == that.fStableKey &&
+               fFlags == that.fFlags;
+    }
+};
+static_assert(sizeof(EffectCacheOptions) == 4 * sizeof(uint32_t));
+
+// The compiled effects kept for SkGraphics::SetRuntimeEffectCacheCountLimit(). The effects are
+// spread over independently locked shards, so that threads compiling different effects rarely
+// wait on each other; each shard holds an equal share of the limit.
+class EffectCache {
+public:
+    static EffectCache* Get() {
+        static SkNoDestructor<EffectCache> gCache;
+        return gCache.get();
+    }
+
+    int countLimit() const { return fCountLimit.load(std::memory_order_relaxed); }
+
+    int setCountLimit(int count) {
+        count = std::max(count, 0);
+        const int prev = fCountLimit.exchange(count, std::memory_order_relaxed);
+        if (count < prev) {
+            for (Shard& shard : fShards) {
+                SkAutoMutexExclusive lock(shard.fMutex);
+                shard.purgeAbove(shard_limit(count));
+            }
+        }
+        return prev;
+    }
+
+    void purge() {
+        for (Shard& shard : fShards) {
+            SkAutoMutexExclusive lock(shard.fMutex);
+            shard.fEntries.reset();
+        }
+    }
+
+    sk_sp<SkRuntimeEffect> find(uint64_t key, const SkString& sksl,
+                                const EffectCacheOptions& options) {
+        Shard& shard = fShards[key % kShardCount];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        if (const Entry* entry = shard.fEntries.find(key)) {
+            if (entry->fOptions == options && entry->fSkSL == sksl) {
+                return entry->fEffect;
+            }
+        }
+        return nullptr;
+    }
+
+    void add(uint64_t key, SkString sksl, const EffectCacheOptions& options,
+             sk_sp<SkRuntimeEffect> effect) {
+        const int limit = shard_limit(this->countLimit());
+        if (limit == 0) {
+            return;
+        }
+
+        Shard& shard = fShards[key % kShardCount];
+        SkAutoMutexExclusive lock(shard.fMutex);
+        // With a 64-bit key, a collision replaces the other effect rather than being chained.
+        shard.fEntries.insert_or_update(key, {std::move(sksl), options, std::move(effect)});
+        shard.purgeAbove(limit);
+    }
+
+private:
+    static constexpr int kShardCount = 16;
+
+    static int shard_limit(int countLimit) {
+        return (countLimit + kShardCount - 1) / kShardCount;
+    }
+
+    struct Entry {
+        SkString               fSkSL;
+        EffectCacheOptions     fOptions;
+        sk_sp<SkRuntimeEffect> fEffect;
+    };
+
+    struct Shard {
+        Shard() : fEntries(INT_MAX) {}
+
+        void purgeAbove(int count) SK_REQUIRES(fMutex) {
+            while (fEntries.count() > count) {
+                fEntries.removeLRU();
+            }
+        }
+
+        SkMutex                      fMutex;
+        SkLRUCache<uint64_t, Entry>  fEntries SK_GUARDED_BY(fMutex);
+    };
+
+    std::atomic<int> fCountLimit{0};
+    Shard            fShards[kShardCount];
+};
+
+}  // namespace
+
+int SkRuntimeEffectPriv::GetCacheCountLimit() {
+    return EffectCache::Get()->countLimit();
+}
+
+int SkRuntimeEffectPriv::SetCacheCountLimit(int count) {
+    return EffectCache::Get()->setCountLimit(count);
+}
+
+void SkRuntimeEffectPriv::PurgeCache() {
+    EffectCache::Get()->purge();
+}
+
 SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
                                                         const Options& options,
                                                         SkSL::ProgramKind kind) {
+    EffectCache* cache = EffectCache::Get();
+    const bool useCache = cache->countLimit() > 0;
+
+    const EffectCacheOptions cacheOptions = {
+            (int32_t)kind,
+            (int32_t)options.maxVersionAllowed,
+            options.fStableKey,
+            (options.forceUnoptimized   ? EffectCacheOptions::kForceUnoptimized   : 0u) |
+            (options.allowPrivateAccess ? EffectCacheOptions::kAllowPrivateAccess : 0u)};
+    uint64_t cacheKey = 0;
+    if (useCache) {
+        cacheKey = SkChecksum::Hash64(sksl.c_str(), sksl.size(),
+                                      SkChecksum::Hash64(&cacheOptions, sizeof(cacheOptions)));
+        if (sk_sp<SkRuntimeEffect> effect = cache->find(cacheKey, sksl, cacheOptions)) {
+            return Result{std::move(effect), SkString()};
+        }
+    }
+
     SkSL::Compiler compiler;
     SkSL::ProgramSettings settings = MakeSettings(options);
     std::unique_ptr<SkSL::Program> program =
@@ -476,7 +621,11 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
         RETURN_FAILURE("%s", compiler.errorText().c_str());
     }
 
-    return MakeInternal(std::move(program), options, kind);
+    Result result = MakeInternal(std::move(program), options, kind);
+    if (useCache && result.effect) {
+        cache->add(cacheKey, std::move(sksl), cacheOptions, result.effect);
+    }
+    return result;
 }
 
 SkRuntimeEffect::Result SkRuntimeEffect::MakeInternal(std::unique_ptr<SkSL::Program> program,
@@ -985,3 +1134,65 @@ SkRuntimeColorFilterBuilder::~SkRuntimeColorFilterBuilder() = default;
 sk_sp<SkColorFilter> SkRuntimeColorFilterBuilder::makeColorFilter() const {
     return this->effect()->makeColorFilter(this->uniforms(), this->children());
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+sk_sp<SkRuntimeUniformBlock> SkRuntimeUniformBlock::Make(sk_sp<SkRuntimeEffect> effect,
+                                                         sk_sp<const SkData> uniforms) {
+    if (!effect) {
+        return nullptr;
+    }
+    sk_sp<SkData> data;
+    if (!uniforms) {
+        data = SkData::MakeZeroInitialized(effect->uniformSize());
+    } else if (uniforms->size() == effect->uniformSize()) {
+        data = SkData::MakeWithCopy(uniforms->data(), uniforms->size());
+    } else {
+        return nullptr;
+    }
+    return sk_sp<SkRuntimeUniformBlock>(new SkRuntimeUniformBlock(std::move(effect),
+                                                                  std::move(data)));
+}
+
+sk_sp<const SkData> SkRuntimeUniformBlock::uniforms() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fUniforms;
+}
+
+bool SkRuntimeUniformBlock::setUniforms(sk_sp<const SkData> uniforms) {
+    if (!uniforms || uniforms->size() != fEffect->uniformSize()) {
+        return false;
+    }
+    SkAutoMutexExclusive lock(fMutex);
+    if (fUniforms->unique()) {
+        memcpy(fUniforms->writable_data(), uniforms->data(), uniforms->size());
+    } else {
+        fUniforms = SkData::MakeWithCopy(uniforms->data(), uniforms->size());
+    }
+    return true;
+}
+
+bool SkRuntimeUniformBlock::set(std::string_view name, const void* data, size_t size) {
+    const SkRuntimeEffect::Uniform* uniform = fEffect->findUniform(name);
+    if (!uniform || uniform->sizeInBytes() != size) {
+        return false;
+    }
+    SkAutoMutexExclusive lock(fMutex);
+    // Draws that were already made keep the values they were made with.
+    if (!fUniforms->unique()) {
+        fUniforms = SkData::MakeWithCopy(fUniforms->data(), fUniforms->size());
+    }
+    memcpy(SkTAddOffset<void>(fUniforms->writable_data(), uniform->offset), data, size);
+    return true;
+}
+
+sk_sp<SkShader> SkRuntimeUniformBlock::makeShader(SkSpan<const SkRuntimeEffect::ChildPtr> children,
+                                                  const SkMatrix* localMatrix) {
+    return SkRuntimeEffectPriv::MakeDeferredShader(
+            fEffect.get(),
+            [block = sk_ref_sp(this)](const SkRuntimeEffectPriv::UniformsCallbackContext&) {
+                return block->uniforms();
+            },
+            children,
+            localMatrix);
+}
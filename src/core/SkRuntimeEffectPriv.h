@@ -137,6 +137,11 @@ public:
     static bool UsesColorTransform(const SkRuntimeEffect* effect) {
         return effect->usesColorTransform();
     }
+
+    // The cache of effects compiled from SkSL, see SkGraphics::SetRuntimeEffectCacheCountLimit().
+    static int GetCacheCountLimit();
+    static int SetCacheCountLimit(int count);
+    static void PurgeCache();
 };
 
 // These internal APIs for creating runtime effects vary from the public API in two ways:
@@ -89,6 +89,10 @@ private:
     static void AntiHairLineRgn(const SkPoint[], int count, const SkRegion*, SkBlitter*);
     static void AAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    // Used instead of AAAFillPath for non-inverse fills when SkGraphics enables the sparse strip
+    // rasterizer.
+    static void SparseStripFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                                    const SkIRect& clipBounds);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
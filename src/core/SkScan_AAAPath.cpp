@@ -16,7 +16,7 @@
 #include "include/private/base/SkMath.h"
 #include "include/private/base/SkSafe32.h"
 #include "include/private/base/SkTo.h"
-#include "src/base/SkTSort.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkAlphaRuns.h"
 #include "src/core/SkAnalyticEdge.h"
 #include "src/core/SkBlitter.h"
@@ -97,6 +97,67 @@ static void safely_add_alpha(SkAlpha* alpha, SkAlpha delta) {
     *alpha = std::min(0xFF, *alpha + delta);
 }
 
+// The span helpers below process 16 alphas at a time with skvx, and finish with the scalar code.
+static constexpr int kAlphaLanes = 16;
+using Alphas = skvx::Vec<kAlphaLanes, SkAlpha>;
+
+// Equivalent to calling safely_add_alpha() for each alpha. Since add_alpha() assumes that the sum
+// is at most 256 and turns 256 into 255, this also matches add_alpha().
+static void safely_add_alphas(SkAlpha* alphas, const SkAlpha* deltas, int len) {
+    int i = 0;
+    for (; i + kAlphaLanes <= len; i += kAlphaLanes) {
+        skvx::saturated_add(Alphas::Load(alphas + i), Alphas::Load(deltas + i)).store(alphas + i);
+    }
+    for (; i < len; ++i) {
+        safely_add_alpha(&alphas[i], deltas[i]);
+    }
+}
+
+static void safely_add_alphas(SkAlpha* alphas, SkAlpha delta, int len) {
+    int i = 0;
+    for (; i + kAlphaLanes <= len; i += kAlphaLanes) {
+        skvx::saturated_add(Alphas::Load(alphas + i), Alphas(delta)).store(alphas + i);
+    }
+    for (; i < len; ++i) {
+        safely_add_alpha(&alphas[i], delta);
+    }
+}
+
+// alphas[i] = max(alphas[i] - deltas[i], 0)
+static void subtract_alphas(SkAlpha* alphas, const SkAlpha* deltas, int len) {
+    int i = 0;
+    for (; i + kAlphaLanes <= len; i += kAlphaLanes) {
+        Alphas a = Alphas::Load(alphas + i);
+        (a - min(a, Alphas::Load(deltas + i))).store(alphas + i);
+    }
+    for (; i < len; ++i) {
+        alphas[i] = alphas[i] > deltas[i] ? alphas[i] - deltas[i] : 0;
+    }
+}
+
+// Stores the high byte of each step of the 16.16 ramp alpha16, alpha16 + dY, ... to 'alphas',
+// in order if 'forward', or else from alphas[len - 1] down to alphas[0]. Just like the scalar
+// loops this replaces, only the low 8 bits of each step are kept.
+static void store_alpha_ramp(SkAlpha* alphas, SkFixed alpha16, SkFixed dY, int len, bool forward) {
+    constexpr int kSteps = 8;
+    using Steps = skvx::Vec<kSteps, int32_t>;
+    const Steps kIota = {0, 1, 2, 3, 4, 5, 6, 7};
+    int i = 0;
+    for (; i + kSteps <= len; i += kSteps) {
+        auto ramp = skvx::cast<uint8_t>((alpha16 + kIota * dY) >> 8);
+        if (forward) {
+            ramp.store(alphas + i);
+        } else {
+            skvx::shuffle<7, 6, 5, 4, 3, 2, 1, 0>(ramp).store(alphas + len - kSteps - i);
+        }
+        alpha16 += kSteps * dY;
+    }
+    for (; i < len; ++i) {
+        alphas[forward ? i : len - 1 - i] = (alpha16 >> 8) & 0xFF;
+        alpha16 += dY;
+    }
+}
+
 class AdditiveBlitter : public SkBlitter {
 public:
     ~AdditiveBlitter() override {}
@@ -424,9 +485,7 @@ void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        add_alpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    safely_add_alphas(fRuns.fAlpha + x, antialias, len);
 }
 
 void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
@@ -494,9 +553,7 @@ void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i = 0; i < len; ++i) {
-        safely_add_alpha(&fRuns.fAlpha[x + i], antialias[i]);
-    }
+    safely_add_alphas(fRuns.fAlpha + x, antialias, len);
 }
 
 void SafeRLEAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
@@ -605,10 +662,7 @@ static void compute_alpha_above_line(SkAlpha* alphas,
         SkFixed firstH  = SkFixedMul(first, dY);  // vertical edge of the left-most triangle
         alphas[0]       = SkFixedMul(first, firstH) >> 9;  // triangle alpha
         SkFixed alpha16 = firstH + (dY >> 1);              // rectangle plus triangle
-        for (int i = 1; i < R - 1; ++i) {
-            alphas[i] = alpha16 >> 8;
-            alpha16 += dY;
-        }
+        store_alpha_ramp(alphas + 1, alpha16, dY, R - 2, /*forward=*/true);
         alphas[R - 1] = fullAlpha - partial_triangle_to_alpha(last, dY);
     }
 }
@@ -632,10 +686,7 @@ static void compute_alpha_below_line(SkAlpha* alphas,
         SkFixed lastH   = SkFixedMul(last, dY);          // vertical edge of the right-most triangle
         alphas[R - 1]   = SkFixedMul(last, lastH) >> 9;  // triangle alpha
         SkFixed alpha16 = lastH + (dY >> 1);             // rectangle plus triangle
-        for (int i = R - 2; i > 0; i--) {
-            alphas[i] = (alpha16 >> 8) & 0xFF;
-            alpha16 += dY;
-        }
+        store_alpha_ramp(alphas + 1, alpha16, dY, R - 2, /*forward=*/false);
         alphas[0] = fullAlpha - partial_triangle_to_alpha(first, dY);
     }
 }
@@ -692,9 +743,7 @@ static void blit_full_alpha(AdditiveBlitter* blitter,
                             SkAlpha* maskRow,
                             bool noRealBlitter) {
     if (maskRow) {
-        for (int i = 0; i < len; ++i) {
-            safely_add_alpha(&maskRow[x + i], fullAlpha);
-        }
+        safely_add_alphas(maskRow + x, fullAlpha, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             blitter->getRealBlitter()->blitH(x, y, len);
@@ -755,13 +804,7 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     } else {
         compute_alpha_below_line(
                 tempAlphas + uL - L, ul - SkIntToFixed(uL), ll - SkIntToFixed(uL), lDY, fullAlpha);
-        for (int i = uL; i < lL; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subtract_alphas(alphas + uL - L, tempAlphas + uL - L, lL - uL);
     }
 
     int uR = SkFixedFloorToInt(ur);
@@ -776,19 +819,11 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter,
     } else {
         compute_alpha_above_line(
                 tempAlphas + uR - L, ur - SkIntToFixed(uR), lr - SkIntToFixed(uR), rDY, fullAlpha);
-        for (int i = uR; i < lR; ++i) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subtract_alphas(alphas + uR - L, tempAlphas + uR - L, lR - uR);
     }
 
     if (maskRow) {
-        for (int i = 0; i < len; ++i) {
-            safely_add_alpha(&maskRow[L + i], alphas[i]);
-        }
+        safely_add_alphas(maskRow + L, alphas, len);
     } else {
         if (fullAlpha == 0xFF && !noRealBlitter) {
             // Real blitter is faster than RunBasedAdditiveBlitter
@@ -963,10 +998,8 @@ static bool operator<(const SkAnalyticEdge& a, const SkAnalyticEdge& b) {
     return valuea < valueb;
 }
 
-static SkAnalyticEdge* sort_edges(SkAnalyticEdge* list[], int count, SkAnalyticEdge** last) {
-    SkTQSort(list, list + count);
-
-    // now make the edges linked in sorted order
+static SkAnalyticEdge* link_edges(SkAnalyticEdge* list[], int count, SkAnalyticEdge** last) {
+    // make the edges linked in sorted order
     for (int i = 1; i < count; ++i) {
         list[i - 1]->fNext = list[i];
         list[i]->fPrev     = list[i - 1];
@@ -1643,8 +1676,12 @@ static void aaa_fill_path(const SkPath& path,
     }
 
     SkAnalyticEdge headEdge, tailEdge, *last;
-    // this returns the first and last edge after they're sorted into a dlink list
-    SkAnalyticEdge* edge = sort_edges(list, count, &last);
+    builder.sortEdges<SkAnalyticEdge>(
+            count,
+            [](const SkAnalyticEdge* edge) { return SkFixedFloorToInt(edge->fUpperY); },
+            [](const SkAnalyticEdge* a, const SkAnalyticEdge* b) { return *a < *b; });
+    // this returns the first and last edge after they're linked into a dlink list
+    SkAnalyticEdge* edge = link_edges(list, count, &last);
 
     headEdge.fPrev   = nullptr;
     headEdge.fNext   = edge;
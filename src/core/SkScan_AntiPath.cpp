@@ -7,6 +7,7 @@
 
 #include "include/core/SkPath.h"
 
+#include "include/core/SkGraphics.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRegion.h"
 #include "include/private/base/SkAssert.h"
@@ -126,7 +127,11 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
         sk_blit_above(blitter, ir, *clipRgn);
     }
 
-    SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    if (!isInverse && SkGraphics::GetSparseStripPathRasterizer()) {
+        SkScan::SparseStripFillPath(path, blitter, ir, clipRgn->getBounds());
+    } else {
+        SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    }
 
     if (isInverse) {
         sk_blit_below(blitter, ir, *clipRgn);
@@ -17,6 +17,7 @@
 #include "include/private/base/SkMath.h"
 #include "include/private/base/SkSafe32.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkFDot6.h"
 #include "src/core/SkLineClipper.h"
@@ -185,17 +186,52 @@ public:
     SkFixed drawLine(int x, int stopx, SkFixed fy, SkFixed dy) override {
         SkASSERT(x < stopx);
 
+        // The line covers the same two rows for about 1/|dy| columns at a time. Each of those
+        // stretches has its coverage computed together, and is blitted with one call.
         fy += SK_Fixed1/2;
         SkBlitter* blitter = this->getBlitter();
         do {
-            int lower_y = fy >> 16;
-            uint8_t  a = (uint8_t)((fy >> 8) & 0xFF);
-            blitter->blitAntiV2(x, lower_y - 1, 255 - a, a);
-            fy += dy;
-        } while (++x < stopx);
+            const int lower_y = fy >> 16;
+            // The number of columns before fy leaves this row.
+            int n = std::min(stopx - x, kMaxRun);
+            if (dy > 0) {
+                n = std::min(n, (((lower_y + 1) << 16) - fy + dy - 1) / dy);
+            } else if (dy < 0) {
+                n = std::min(n, (fy - (lower_y << 16) - dy) / -dy);
+            }
+            SkASSERT(n >= 1 && ((fy + (n - 1) * dy) >> 16) == lower_y);
+            if (n < kMinRun) {
+                for (int i = 0; i < n; ++i) {
+                    uint8_t  a = (uint8_t)(((fy + i * dy) >> 8) & 0xFF);
+                    blitter->blitAntiV2(x + i, lower_y - 1, 255 - a, a);
+                }
+            } else {
+                using I32 = skvx::Vec<kLanes, int32_t>;
+                using U8  = skvx::Vec<kLanes, uint8_t>;
+                const I32 iota = {0, 1, 2, 3, 4, 5, 6, 7};
+                for (int i = 0; i < n; i += kLanes) {
+                    U8 a = skvx::cast<uint8_t>(((fy + (iota + i) * dy) >> 8) & 0xFF);
+                    (255 - a).store(fCoverage[0] + i);
+                    a.store(fCoverage[1] + i);
+                }
+                blitter->blitAntiV2Run(x, lower_y - 1, n, fCoverage[0], sizeof(fCoverage[0]));
+            }
+            fy += n * dy;
+            x += n;
+        } while (x < stopx);
 
         return fy - SK_Fixed1/2;
     }
+
+private:
+    static constexpr int kLanes = 8;
+    // Shorter stretches (steeper lines) are cheaper to blit a column at a time.
+    static constexpr int kMinRun = 8;
+    static constexpr int kMaxRun = 128;
+
+    // The coverage of the upper and lower rows. Stores are a whole vector at a time, so each row
+    // has room for a vector past the longest run.
+    uint8_t fCoverage[2][kMaxRun + kLanes];
 };
 
 class VLine_SkAntiHairBlitter : public SkAntiHairBlitter {
@@ -539,6 +575,12 @@ static void do_anti_hairline(SkFDot6 x0, SkFDot6 y0, SkFDot6 x1, SkFDot6 y1,
     }
 }
 
+// Like SkRect::contains(), but true for empty inner rects (e.g. the bounds of a horizontal line).
+static bool contains_inclusive(const SkRect& outer, const SkRect& inner) {
+    return outer.fLeft <= inner.fLeft && outer.fTop <= inner.fTop &&
+           outer.fRight >= inner.fRight && outer.fBottom >= inner.fBottom;
+}
+
 void SkScan::AntiHairLineRgn(const SkPoint array[], int arrayCount, const SkRegion* clip,
                              SkBlitter* blitter) {
     if (clip && clip->isEmpty()) {
@@ -569,6 +611,31 @@ void SkScan::AntiHairLineRgn(const SkPoint array[], int arrayCount, const SkRegi
         clipBounds.outset(SK_Scalar1, SK_Scalar1);
     }
 
+    // Polylines (e.g. drawPoints() with kPolygon_PointMode) that lie entirely within the fixed
+    // point range and the clip draw each of their segments as is. Their points are checked and
+    // converted to dot6 once, rather than clipped and converted again for each segment.
+    if (arrayCount > 2) {
+        SkRect bounds;
+        if (bounds.setBoundsCheck(array, arrayCount) && contains_inclusive(fixedBounds, bounds) &&
+            (!clip || (contains_inclusive(clipBounds, bounds) &&
+                       clip->quickContains(SkIRect::MakeLTRB(
+                               SkFDot6Floor(SkScalarToFDot6(bounds.fLeft)) - 1,
+                               SkFDot6Floor(SkScalarToFDot6(bounds.fTop)) - 1,
+                               SkFDot6Ceil(SkScalarToFDot6(bounds.fRight)) + 1,
+                               SkFDot6Ceil(SkScalarToFDot6(bounds.fBottom)) + 1))))) {
+            SkFDot6 x0 = SkScalarToFDot6(array[0].fX);
+            SkFDot6 y0 = SkScalarToFDot6(array[0].fY);
+            for (int i = 1; i < arrayCount; ++i) {
+                SkFDot6 x1 = SkScalarToFDot6(array[i].fX);
+                SkFDot6 y1 = SkScalarToFDot6(array[i].fY);
+                do_anti_hairline(x0, y0, x1, y1, nullptr, blitter);
+                x0 = x1;
+                y0 = y1;
+            }
+            return;
+        }
+    }
+
     for (int i = 0; i < arrayCount - 1; ++i) {
         SkPoint pts[2];
 
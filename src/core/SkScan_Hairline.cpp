@@ -37,10 +37,17 @@ static void horiline(int x, int stopx, SkFixed fy, SkFixed dy,
                      SkBlitter* blitter) {
     SkASSERT(x < stopx);
 
+    // Blit each stretch of columns that stays on one row as a single span.
     do {
-        blitter->blitH(x, fy >> 16, 1);
-        fy += dy;
-    } while (++x < stopx);
+        const int y = fy >> 16;
+        int n = 1;
+        while (x + n < stopx && ((fy + n * dy) >> 16) == y) {
+            n += 1;
+        }
+        blitter->blitH(x, y, n);
+        fy += n * dy;
+        x += n;
+    } while (x < stopx);
 }
 
 static void vertline(int y, int stopy, SkFixed fx, SkFixed dx,
@@ -387,10 +387,8 @@ static bool operator<(const SkEdge& a, const SkEdge& b) {
     return valuea < valueb;
 }
 
-static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last) {
-    SkTQSort(list, list + count);
-
-    // now make the edges linked in sorted order
+static SkEdge* link_edges(SkEdge* list[], int count, SkEdge** last) {
+    // make the edges linked in sorted order
     for (int i = 1; i < count; i++) {
         list[i - 1]->fNext = list[i];
         list[i]->fPrev = list[i - 1];
@@ -400,6 +398,11 @@ static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last) {
     return list[0];
 }
 
+static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last) {
+    SkTQSort(list, list + count);
+    return link_edges(list, count, last);
+}
+
 // clipRect has not been shifted up
 void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitter,
                   int start_y, int stop_y, int shiftEdgesUp, bool pathContainedInClip) {
@@ -441,8 +444,10 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitte
     }
 
     SkEdge headEdge, tailEdge, *last;
-    // this returns the first and last edge after they're sorted into a dlink list
-    SkEdge* edge = sort_edges(list, count, &last);
+    builder.sortEdges<SkEdge>(count, [](const SkEdge* edge) { return edge->fFirstY; },
+                              [](const SkEdge* a, const SkEdge* b) { return *a < *b; });
+    // this returns the first and last edge after they're linked into a dlink list
+    SkEdge* edge = link_edges(list, count, &last);
 
     headEdge.fPrev = nullptr;
     headEdge.fNext = edge;
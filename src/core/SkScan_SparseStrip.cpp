@@ -0,0 +1,515 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkTSort.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+/*
+
+The sparse strip rasterizer fills a path in four steps:
+
+1. Flatten the path into lines, with the number of segments for each curve picked by Wang's
+   formula. The lines are clipped horizontally to the fill bounds: the parts to the left of the
+   bounds are moved onto its left edge, where they still contribute winding to every pixel, and
+   the parts to the right are dropped.
+
+2. Bin the lines into 4x4 pixel tiles. A line is added to every tile that one of its per-pixel-row
+   pieces touches. Tiles are bucketed by tile row and then sorted by x within each row.
+
+3. For each run of tiles with the same position, compute the exact signed area that each line
+   covers in each pixel, four pixels at a time. A pixel's winding is the sum of the areas of the
+   lines crossing its row in and to the left of the pixel. The winding at the right edge of a
+   tile (its "backdrop") carries over to the pixels to its right, so the pixels between tiles
+   have a constant coverage that needs no work at all. Each pixel row is split into sub-rows that
+   apply the fill rule separately, since applying it to the whole pixel's winding would be wrong
+   wherever edges cross inside the pixel.
+
+4. Turn each pixel row of a tile row into alpha runs, with one run per gap between tiles, and hand
+   them to the blitter's blitAntiH().
+
+The only per-pixel work is in the tiles that lines pass through, so the cost follows the number of
+edges and the path's perimeter rather than its area. Tile rows are independent once the tiles are
+binned, so large paths sort and compute their tile rows in parallel, and only blit serially.
+
+*/
+
+namespace {
+
+constexpr int kTileSize = 4;
+using float4 = skvx::Vec<kTileSize, float>;
+
+// Flattening tolerance in pixels.
+constexpr float kTolerance = 1.0f / 16;
+
+struct Line {
+    SkPoint fP0, fP1;
+};
+
+struct Tile {
+    uint16_t fX;
+    uint16_t fY;
+    uint32_t fLine;
+};
+
+// Coverage is evaluated on this many rows within each pixel row. The fill rule is applied to the
+// winding of each of them, which keeps pixels where edges cross close to their true coverage.
+constexpr int kSubRows = 4;
+
+// The piece of a line inside the row [top, top + height]: its endpoints' x and its signed height.
+// Returns false if the line doesn't cross the row.
+bool row_segment(const Line& line, float top, float height, float* xa, float* xb, float* dy) {
+    const float y0 = std::clamp(line.fP0.fY, top, top + height),
+                y1 = std::clamp(line.fP1.fY, top, top + height);
+    if (y0 == y1) {
+        return false;
+    }
+    const float dxdy = (line.fP1.fX - line.fP0.fX) / (line.fP1.fY - line.fP0.fY);
+    *xa = line.fP0.fX + (y0 - line.fP0.fY) * dxdy;
+    *xb = line.fP0.fX + (y1 - line.fP0.fY) * dxdy;
+    *dy = y1 - y0;
+    return true;
+}
+
+int tile_x(float x, int tileCountX) {
+    return std::clamp((int)x / kTileSize, 0, tileCountX - 1);
+}
+
+// The antiderivative (in x) of the part of the pixel column [L, L + 1] to the right of x, given
+// t = x - L.
+float4 coverage_integral(float4 t) {
+    const float4 u = skvx::pin(t, float4(0), float4(1));
+    return min(t, 0) + u - 0.5f * u * u;
+}
+
+// The average fraction of each pixel column [L, L + 1] to the right of the line from xa to xb.
+float4 average_coverage(float xa, float xb, float4 L) {
+    if (std::abs(xb - xa) < 1.0f / 1024) {
+        return skvx::pin(L + 1 - 0.5f * (xa + xb), float4(0), float4(1));
+    }
+    return (coverage_integral(xb - L) - coverage_integral(xa - L)) / (xb - xa);
+}
+
+class Rasterizer {
+public:
+    Rasterizer(const SkIRect& bounds, SkPathFillType fillType)
+            : fBounds(bounds)
+            , fWidth(bounds.width())
+            , fHeight(bounds.height())
+            , fTileCountX((fWidth + kTileSize - 1) / kTileSize)
+            , fTileCountY((fHeight + kTileSize - 1) / kTileSize)
+            , fEvenOdd(SkPathFillType_IsEvenOdd(fillType)) {}
+
+    void flatten(const SkPath& path) {
+        const SkPoint origin = SkPoint::Make(fBounds.fLeft, fBounds.fTop);
+        SkPathEdgeIter iter(path);
+        while (auto e = iter.next()) {
+            const int count = SkPathPriv::PtsInIter((unsigned)e.fEdge);
+            SkPoint pts[4];
+            for (int i = 0; i < count; ++i) {
+                pts[i] = e.fPts[i] - origin;
+            }
+            switch (e.fEdge) {
+                case SkPathEdgeIter::Edge::kLine:
+                    this->addLine(pts[0], pts[1]);
+                    break;
+                case SkPathEdgeIter::Edge::kQuad:
+                    this->addQuad(pts);
+                    break;
+                case SkPathEdgeIter::Edge::kConic: {
+                    SkAutoConicToQuads quadder;
+                    const SkPoint* quads = quadder.computeQuads(pts, iter.conicWeight(), kTolerance);
+                    for (int i = 0; i < quadder.countQuads(); ++i) {
+                        this->addQuad(quads + 2 * i);
+                    }
+                } break;
+                case SkPathEdgeIter::Edge::kCubic:
+                    this->addCubic(pts);
+                    break;
+            }
+        }
+    }
+
+    void binTiles() {
+        for (int i = 0; i < fLines.size(); ++i) {
+            const Line& line = fLines[i];
+            const float top = std::max(0.f, std::min(line.fP0.fY, line.fP1.fY)),
+                        bot = std::min((float)fHeight, std::max(line.fP0.fY, line.fP1.fY));
+            if (top >= bot) {
+                continue;
+            }
+            const int rowTop = (int)top,
+                      rowBot = std::min(fHeight, sk_float_ceil2int(bot));
+            // Add the line to every tile touched by one of its row pieces, visiting each tile row
+            // at most once. The same row_segment() and tile_x() the coverage pass uses decide
+            // which tiles those are, so the two passes always agree.
+            int tileY   = -1,
+                minTile = 0,
+                maxTile = 0;
+            auto addTiles = [&]() {
+                for (int tx = minTile; tx <= maxTile; ++tx) {
+                    fTiles.push_back({SkTo<uint16_t>(tx), SkTo<uint16_t>(tileY), SkToU32(i)});
+                }
+            };
+            for (int y = rowTop; y < rowBot; ++y) {
+                float xa, xb, dy;
+                if (!row_segment(line, y, 1, &xa, &xb, &dy)) {
+                    continue;
+                }
+                const int lo = tile_x(std::min(xa, xb), fTileCountX),
+                          hi = tile_x(std::max(xa, xb), fTileCountX);
+                if (y / kTileSize != tileY) {
+                    if (tileY >= 0) {
+                        addTiles();
+                    }
+                    tileY = y / kTileSize;
+                    minTile = lo;
+                    maxTile = hi;
+                } else {
+                    minTile = std::min(minTile, lo);
+                    maxTile = std::max(maxTile, hi);
+                }
+            }
+            if (tileY >= 0) {
+                addTiles();
+            }
+        }
+
+        // Bucket the tiles by row. Each row is sorted by x when it is rasterized.
+        fRowStarts.resize(fTileCountY + 1);
+        std::fill(fRowStarts.begin(), fRowStarts.end(), 0);
+        for (const Tile& tile : fTiles) {
+            fRowStarts[tile.fY + 1]++;
+        }
+        for (int ty = 0; ty < fTileCountY; ++ty) {
+            fRowStarts[ty + 1] += fRowStarts[ty];
+        }
+        skia_private::TArray<Tile> sorted;
+        sorted.resize_back(fTiles.size());
+        skia_private::TArray<int> cursors(fRowStarts.data(), fTileCountY);
+        for (const Tile& tile : fTiles) {
+            sorted[cursors[tile.fY]++] = tile;
+        }
+        fTiles = std::move(sorted);
+    }
+
+    void blit(SkBlitter* blitter) {
+        // Each tile row gets its own run buffers, so that a batch of tile rows can be computed in
+        // parallel before they are blitted in order.
+        constexpr int kMinTilesPerBatch = 8 * 1024;
+        constexpr int kMaxTileRowsPerBatch = 16;
+        const bool parallel = fTiles.size() >= kMinTilesPerBatch && fTileCountY > 1;
+        const int rowsPerBatch = parallel ? std::min(kMaxTileRowsPerBatch, fTileCountY) : 1;
+
+        const size_t rowStride = fWidth + 1;
+        const size_t batchRows = rowsPerBatch * kTileSize;
+        std::unique_ptr<int16_t[]> runs(new int16_t[batchRows * rowStride]);
+        std::unique_ptr<SkAlpha[]> alphas(new SkAlpha[batchRows * rowStride]);
+        std::unique_ptr<Span[]> spans(new Span[batchRows]);
+
+        for (int batchTop = 0; batchTop < fTileCountY; batchTop += rowsPerBatch) {
+            const int batchCount = std::min(rowsPerBatch, fTileCountY - batchTop);
+            auto rasterizeRow = [&](int i) {
+                const int offset = i * kTileSize;
+                this->rasterizeTileRow(batchTop + i,
+                                       runs.get() + offset * rowStride,
+                                       alphas.get() + offset * rowStride,
+                                       rowStride,
+                                       spans.get() + offset);
+            };
+            if (batchCount > 1) {
+                SkTaskGroup rows;
+                rows.batch(batchCount, rasterizeRow);
+                rows.wait();
+            } else {
+                rasterizeRow(0);
+            }
+
+            for (int r = 0; r < batchCount * kTileSize; ++r) {
+                const int y = batchTop * kTileSize + r;
+                if (y >= fHeight) {
+                    break;
+                }
+                const Span& span = spans[r];
+                if (span.fLeft < span.fRight) {
+                    blitter->blitAntiH(fBounds.fLeft + span.fLeft,
+                                       fBounds.fTop + y,
+                                       alphas.get() + r * rowStride,
+                                       runs.get() + r * rowStride);
+                }
+            }
+        }
+    }
+
+private:
+    // The pixels of one row that have runs, relative to fBounds.
+    struct Span {
+        int fLeft, fRight;
+    };
+
+    // Builds one pixel row's alpha runs, merging neighbouring runs with the same alpha.
+    class RunBuilder {
+    public:
+        RunBuilder(int16_t* runs, SkAlpha* alphas, int left)
+                : fRuns(runs), fAlphas(alphas), fLeft(left), fCursor(left), fLastRun(-1) {}
+
+        int cursor() const { return fCursor; }
+
+        void append(SkAlpha alpha, int count) {
+            if (count <= 0) {
+                return;
+            }
+            if (fLastRun >= 0 && fAlphas[fLastRun] == alpha) {
+                fRuns[fLastRun] += count;
+            } else {
+                fLastRun = fCursor - fLeft;
+                fRuns[fLastRun] = SkToS16(count);
+                fAlphas[fLastRun] = alpha;
+            }
+            fCursor += count;
+        }
+
+        // Terminates the runs, dropping a trailing transparent run, and returns the pixels they
+        // cover.
+        Span finish() {
+            int right = fCursor;
+            if (fLastRun >= 0 && fAlphas[fLastRun] == 0) {
+                right = fLeft + fLastRun;
+            }
+            fRuns[right - fLeft] = 0;
+            return {fLeft, right};
+        }
+
+    private:
+        int16_t* fRuns;
+        SkAlpha* fAlphas;
+        int fLeft;
+        int fCursor;
+        int fLastRun;
+    };
+
+    // Applies the fill rule to each winding.
+    float4 coverage(float4 winding) const {
+        float4 w = abs(winding);
+        if (fEvenOdd) {
+            w = 1 - abs(w - 2 * floor(0.5f * w) - 1);
+        }
+        return min(w, 1);
+    }
+
+    // The alpha of a pixel, given the winding of each of its sub-rows.
+    SkAlpha alpha(float4 subRowWinding) const {
+        static_assert(kSubRows == kTileSize, "the sub-rows' windings share one float4");
+        const float4 c = this->coverage(subRowWinding);
+        return (SkAlpha)((c[0] + c[1] + c[2] + c[3]) * (255.0f / kSubRows) + 0.5f);
+    }
+
+    void rasterizeTileRow(int ty, int16_t* runs, SkAlpha* alphas, size_t rowStride, Span* spans) {
+        Tile* begin = fTiles.begin() + fRowStarts[ty];
+        Tile* end   = fTiles.begin() + fRowStarts[ty + 1];
+        const int rowCount = std::min(kTileSize, fHeight - ty * kTileSize);
+        if (begin == end) {
+            for (int r = 0; r < rowCount; ++r) {
+                spans[r] = {0, 0};
+            }
+            return;
+        }
+        SkTQSort(begin, end, [](const Tile& a, const Tile& b) { return a.fX < b.fX; });
+
+        const int left = begin->fX * kTileSize;
+        RunBuilder builders[kTileSize] = {
+                {runs + 0 * rowStride, alphas + 0 * rowStride, left},
+                {runs + 1 * rowStride, alphas + 1 * rowStride, left},
+                {runs + 2 * rowStride, alphas + 2 * rowStride, left},
+                {runs + 3 * rowStride, alphas + 3 * rowStride, left},
+        };
+        // The winding of each sub-row to the right of the tiles visited so far.
+        float4 backdrop[kTileSize] = {0, 0, 0, 0};
+        const float4 columns = {0, 1, 2, 3};
+
+        for (const Tile* tile = begin; tile != end;) {
+            const int tx = tile->fX;
+            const int tileLeft = tx * kTileSize;
+            const int tileWidth = std::min(kTileSize, fWidth - tileLeft);
+            const float4 L = columns + tileLeft;
+
+            // The pixels between the previous tile and this one are covered by the backdrop.
+            float4 winding[kTileSize][kSubRows];
+            for (int r = 0; r < rowCount; ++r) {
+                builders[r].append(this->alpha(backdrop[r]), tileLeft - builders[r].cursor());
+                for (int s = 0; s < kSubRows; ++s) {
+                    winding[r][s] = backdrop[r][s];
+                }
+            }
+            const Tile* next = tile;
+            for (; next != end && next->fX == tx; ++next) {
+                const Line& line = fLines[next->fLine];
+                for (int r = 0; r < rowCount; ++r) {
+                    const float rowTop = ty * kTileSize + r;
+                    float xa, xb, dy;
+                    if (!row_segment(line, rowTop, 1, &xa, &xb, &dy)) {
+                        continue;
+                    }
+                    // The piece's winding joins the backdrop in the tile holding its right end.
+                    // Tiles to its left only see the part of each pixel it covers, and tiles to
+                    // its right already have it in their backdrop.
+                    const int lastTile = tile_x(std::max(xa, xb), fTileCountX);
+                    if (tx > lastTile) {
+                        continue;
+                    }
+                    for (int s = 0; s < kSubRows; ++s) {
+                        if (!row_segment(line, rowTop + (float)s / kSubRows, 1.0f / kSubRows,
+                                         &xa, &xb, &dy)) {
+                            continue;
+                        }
+                        // Scale each sub-row's area up to what it would add to a whole pixel.
+                        winding[r][s] += (kSubRows * dy) * average_coverage(xa, xb, L);
+                        if (tx == lastTile) {
+                            backdrop[r][s] += kSubRows * dy;
+                        }
+                    }
+                }
+            }
+
+            for (int r = 0; r < rowCount; ++r) {
+                float4 c = 0;
+                for (int s = 0; s < kSubRows; ++s) {
+                    c += this->coverage(winding[r][s]);
+                }
+                c = c * (255.0f / kSubRows) + 0.5f;
+                for (int i = 0; i < tileWidth; ++i) {
+                    builders[r].append((SkAlpha)c[i], 1);
+                }
+            }
+            tile = next;
+        }
+
+        for (int r = 0; r < rowCount; ++r) {
+            builders[r].append(this->alpha(backdrop[r]), fWidth - builders[r].cursor());
+            spans[r] = builders[r].finish();
+        }
+    }
+
+    void addLine(SkPoint p0, SkPoint p1) {
+        if (p0.fY == p1.fY || !SkIsFinite(p0.fX, p0.fY, p1.fX, p1.fY)) {
+            return;
+        }
+        // Split the line where it crosses the left and right edges of the bounds. Pieces to the
+        // left still wind every pixel in their rows, so they move onto the left edge. Pieces to
+        // the right only affect pixels outside of the bounds.
+        const float W = fWidth;
+        float ts[4] = {0, 0, 0, 1};
+        int count = 1;
+        const float dx = p1.fX - p0.fX;
+        if (dx != 0) {
+            for (float edge : {0.f, W}) {
+                const float t = (edge - p0.fX) / dx;
+                if (t > 0 && t < 1) {
+                    ts[count++] = t;
+                }
+            }
+            std::sort(ts + 1, ts + count);
+        }
+        ts[count] = 1;
+        for (int i = 0; i < count; ++i) {
+            SkPoint a = p0 + (p1 - p0) * ts[i],
+                    b = p0 + (p1 - p0) * ts[i + 1];
+            if (i == 0) {
+                a = p0;
+            }
+            if (i == count - 1) {
+                b = p1;
+            }
+            if (a.fY == b.fY || std::min(a.fX, b.fX) >= W) {
+                continue;
+            }
+            a.fX = std::max(a.fX, 0.f);
+            b.fX = std::max(b.fX, 0.f);
+            fLines.push_back({a, b});
+        }
+    }
+
+    void addQuad(const SkPoint pts[3]) {
+        // Wang's formula for a quadratic: n = sqrt(|p0 - 2p1 + p2| / (4 * tolerance)).
+        const float m = (pts[0] - pts[1] * 2 + pts[2]).length();
+        const int n = std::clamp(sk_float_ceil2int(std::sqrt(m * (1 / (4 * kTolerance)))),
+                                 1, kMaxSegments);
+        SkPoint prev = pts[0];
+        for (int i = 1; i <= n; ++i) {
+            const SkPoint pt = i == n ? pts[2] : SkEvalQuadAt(pts, (float)i / n);
+            this->addLine(prev, pt);
+            prev = pt;
+        }
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        // Wang's formula for a cubic: n = sqrt(3 * max|p_i - 2p_{i+1} + p_{i+2}| / (4 * tolerance)).
+        const float m = std::max((pts[0] - pts[1] * 2 + pts[2]).length(),
+                                 (pts[1] - pts[2] * 2 + pts[3]).length());
+        const int n = std::clamp(sk_float_ceil2int(std::sqrt(m * (3 / (4 * kTolerance)))),
+                                 1, kMaxSegments);
+        SkPoint prev = pts[0];
+        for (int i = 1; i <= n; ++i) {
+            SkPoint pt;
+            if (i == n) {
+                pt = pts[3];
+            } else {
+                SkEvalCubicAt(pts, (float)i / n, &pt, nullptr, nullptr);
+            }
+            this->addLine(prev, pt);
+            prev = pt;
+        }
+    }
+
+    static constexpr int kMaxSegments = 1024;
+
+    const SkIRect fBounds;
+    const int fWidth, fHeight;
+    const int fTileCountX, fTileCountY;
+    const bool fEvenOdd;
+
+    skia_private::TArray<Line> fLines;
+    skia_private::TArray<Tile> fTiles;
+    skia_private::TArray<int> fRowStarts;
+};
+
+}  // anonymous namespace
+
+void SkScan::SparseStripFillPath(const SkPath& path,
+                                 SkBlitter* blitter,
+                                 const SkIRect& ir,
+                                 const SkIRect& clipBounds) {
+    SkASSERT(!path.isInverseFillType());
+    SkIRect bounds;
+    if (!bounds.intersect(ir, clipBounds)) {
+        return;
+    }
+    // Tile coordinates are stored in 16 bits, and run lengths in int16_t.
+    SkASSERT(bounds.width() <= SK_MaxS16 && bounds.height() <= SK_MaxS16);
+
+    Rasterizer rasterizer(bounds, path.getFillType());
+    rasterizer.flatten(path);
+    rasterizer.binTiles();
+    rasterizer.blit(blitter);
+}
@@ -9,12 +9,16 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkShader.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkOnce.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkNextID.h"
 #include "src/image/SkImage_Base.h"
 #include "src/shaders/SkImageShader.h"
@@ -90,6 +94,33 @@ public:
 
     size_t getSize() const override { return fBitmap.computeByteSize(); }
 
+    uint64_t contentID() const override {
+        if (fBitmap.isImmutable()) {
+            // The generation ID already identifies the pixels.
+            return this->uniqueID();
+        }
+        fContentHashOnce([this] {
+            SkPixmap backing, pixmap;
+            SkAssertResult(fBitmap.peekPixels(&backing));
+            SkAssertResult(backing.extractSubset(&pixmap, this->subset()));
+
+            const SkColorInfo& colorInfo = this->colorInfo();
+            SkColorSpace* colorSpace = colorInfo.colorSpace();
+            const uint64_t format[] = {(uint64_t)colorInfo.colorType(),
+                                       (uint64_t)colorInfo.alphaType(),
+                                       colorSpace ? colorSpace->hash() : 0,
+                                       (uint64_t)pixmap.width(),
+                                       (uint64_t)pixmap.height()};
+            uint64_t hash = SkChecksum::Hash64(format, sizeof(format));
+            const size_t rowBytes = pixmap.info().minRowBytes();
+            for (int y = 0; y < pixmap.height(); ++y) {
+                hash = SkChecksum::Hash64(pixmap.addr(0, y), rowBytes, hash);
+            }
+            fContentHash = hash | (uint64_t(1) << 63);
+        });
+        return fContentHash;
+    }
+
     sk_sp<SkImage> asImage() const override { return fBitmap.asImage(); }
 
     sk_sp<SkSpecialImage> onMakeBackingStoreSubset(const SkIRect& subset) const override {
@@ -121,6 +152,9 @@ public:
 
 private:
     SkBitmap fBitmap;
+
+    mutable SkOnce fContentHashOnce;
+    mutable uint64_t fContentHash = 0;
 };
 
 namespace SkSpecialImages {
@@ -60,6 +60,12 @@ public:
 
     uint32_t uniqueID() const { return fUniqueID; }
 
+    // Identifies the image's contents in SkImageFilterCache keys. By default this is the unique
+    // ID. Raster images whose pixels may still change (e.g. snapped layers) instead hash the pixels
+    // of their subset, so that layers re-rendered with the same content share cached filter
+    // results. Content hashes always have the high bit set, so they can't equal a unique ID.
+    virtual uint64_t contentID() const { return fUniqueID; }
+
     virtual SkISize backingStoreDimensions() const = 0;
 
     virtual size_t getSize() const = 0;
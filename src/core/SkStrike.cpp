@@ -21,13 +21,16 @@
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <algorithm>
 #include <cctype>
 #include <new>
 #include <optional>
 #include <utility>
+#include <vector>
 
 using namespace skglyph;
 
@@ -240,6 +243,51 @@ SkSpan<const SkGlyph*> SkStrike::prepareImages(
     return {results, glyphIDs.size()};
 }
 
+void SkStrike::prerasterizeImages(SkSpan<const SkPackedGlyphID> glyphIDs, SkExecutor* executor) {
+    // Copy the glyphs that still need an image, so that the tasks don't touch the strike.
+    std::vector<SkGlyph> pending;
+    {
+        Monitor m{this};
+        skia_private::THashSet<SkPackedGlyphID> seen;
+        for (auto glyphID : glyphIDs) {
+            SkGlyph* glyph = this->glyph(glyphID);
+            if (glyph->setImageHasBeenCalled() || seen.contains(glyphID)) {
+                continue;
+            }
+            if (executor == nullptr || glyphIDs.size() < kGlyphsPerRasterTask) {
+                this->prepareForImage(glyph);
+                continue;
+            }
+            seen.add(glyphID);
+            pending.push_back(*glyph);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    const size_t taskCount = std::min(kMaxRasterTasks,
+                                      (pending.size() + kGlyphsPerRasterTask - 1) /
+                                              kGlyphsPerRasterTask);
+    std::vector<std::unique_ptr<SkArenaAlloc>> images(taskCount);
+    SkTaskGroup(*executor).batch(SkToInt(taskCount), [&](int task) {
+        std::unique_ptr<SkScalerContext> scaler = fStrikeSpec.createScalerContext();
+        images[task] = std::make_unique<SkArenaAlloc>(kMinAllocAmount);
+        for (size_t i = task; i < pending.size(); i += taskCount) {
+            pending[i].setImage(images[task].get(), scaler.get());
+        }
+    });
+
+    // Another thread may have added some of the images in the meantime.
+    Monitor m{this};
+    for (const SkGlyph& rasterized : pending) {
+        SkGlyph* glyph = this->glyph(rasterized.getPackedID());
+        if (glyph->setImage(&fAlloc, rasterized.image())) {
+            fMemoryIncrease += glyph->imageSize();
+        }
+    }
+}
+
 SkSpan<const SkGlyph*> SkStrike::prepareDrawables(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
     const SkGlyph** cursor = results;
@@ -445,12 +493,14 @@ SkSpan<const SkGlyph*> SkStrike::internalPrepare(
 
 void SkStrike::updateMemoryUsage(size_t increase) {
     if (increase > 0) {
-        // fRemoved and the cache's total memory are managed under the cache's lock. This allows
-        // them to be accessed under LRU operation.
-        SkAutoMutexExclusive lock{fStrikeCache->fLock};
+        // fRemoved and the shard's total memory are managed under the lock of the cache shard
+        // holding this strike. This allows them to be accessed under LRU operation.
+        SkStrikeCache::Shard* shard = fStrikeCache->shardFor(this->getDescriptor());
+        SkStrikeCache::AutoShardLock lock{fStrikeCache, shard};
         fMemoryUsed += increase;
         if (!fRemoved) {
-            fStrikeCache->fTotalMemoryUsed += increase;
+            shard->fMemoryUsed += increase;
+            fStrikeCache->fTotalMemoryUsed.fetch_add(increase, std::memory_order_relaxed);
         }
     }
 }
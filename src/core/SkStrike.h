@@ -27,6 +27,7 @@
 
 class SkDescriptor;
 class SkDrawable;
+class SkExecutor;
 class SkPath;
 class SkReadBuffer;
 class SkStrikeCache;
@@ -96,6 +97,13 @@ public:
     SkSpan<const SkGlyph*> prepareImages(SkSpan<const SkPackedGlyphID> glyphIDs,
                                          const SkGlyph* results[]) SK_EXCLUDES(fStrikeLock);
 
+    // Rasterize the images of the glyphs that don't have one yet on the executor's threads, each
+    // with its own scaler context, and add them to the strike together. The strike is not locked
+    // while the images are rasterized. Without an executor, or for a few glyphs, the images are
+    // rasterized by the strike's scaler context.
+    void prerasterizeImages(SkSpan<const SkPackedGlyphID> glyphIDs,
+                            SkExecutor* executor) SK_EXCLUDES(fStrikeLock);
+
     SkSpan<const SkGlyph*> prepareDrawables(
             SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) SK_EXCLUDES(fStrikeLock);
 
@@ -195,9 +203,14 @@ private:
     inline static constexpr size_t kMinGlyphImageSize = 16 /* height */ * 8 /* width */;
     inline static constexpr size_t kMinAllocAmount = kMinGlyphImageSize * kMinGlyphCount;
 
+    // prerasterizeImages() gives each task at least this many glyphs, and uses at most
+    // kMaxRasterTasks scaler contexts.
+    inline static constexpr size_t kGlyphsPerRasterTask = 16;
+    inline static constexpr size_t kMaxRasterTasks = 8;
+
     SkArenaAlloc            fAlloc SK_GUARDED_BY(fStrikeLock) {kMinAllocAmount};
 
-    // The following are protected by the SkStrikeCache's mutex.
+    // The following are protected by the mutex of the SkStrikeCache shard holding this strike.
     SkStrike*                       fNext{nullptr};
     SkStrike*                       fPrev{nullptr};
     std::unique_ptr<SkStrikePinner> fPinner;
@@ -16,6 +16,7 @@
 #include "src/core/SkDescriptor.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTraceEvent.h"
 
 #include <algorithm>
 #include <utility>
@@ -36,13 +37,26 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     return cache;
 }
 
+auto SkStrikeCache::shardFor(const SkDescriptor& desc) -> Shard* {
+    // Use the top bits of the checksum; the bottom bits pick the slot in the shard's hash table,
+    // and sharding on them would leave most of each table's slots unused.
+    return &fShards[desc.getChecksum() >> (32 - kShardBits)];
+}
+
+void SkStrikeCache::noteContendedLock() const {
+    const int64_t count = fContendedLockCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    TRACE_COUNTER1("skia", "SkStrikeCache contended locks", count);
+}
+
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
+    Shard* shard = this->shardFor(strikeSpec.descriptor());
+    AutoShardLock ac(this, shard);
+    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(shard, strikeSpec.descriptor());
+    TRACE_CACHE_LOOKUP("skia", "SkStrikeCache lookups", strike != nullptr);
     if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+        strike = this->internalCreateStrike(shard, strikeSpec);
     }
-    this->internalPurge();
+    this->internalPurge(shard);
     return strike;
 }
 
@@ -90,34 +104,38 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
-    this->internalPurge();
+    Shard* shard = this->shardFor(desc);
+    AutoShardLock ac(this, shard);
+    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(shard, desc);
+    TRACE_CACHE_LOOKUP("skia", "SkStrikeCache lookups", result != nullptr);
+    this->internalPurge(shard);
     return result;
 }
 
-auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
+auto SkStrikeCache::internalFindStrikeOrNull(Shard* shard, const SkDescriptor& desc)
+        -> sk_sp<SkStrike> {
+    SkStrike*& head = shard->fHead;
 
     // Check head because it is likely the strike we are looking for.
-    if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
+    if (head != nullptr && head->getDescriptor() == desc) { return sk_ref_sp(head); }
 
     // Do the heavy search looking for the strike.
-    sk_sp<SkStrike>* strikeHandle = fStrikeLookup.find(desc);
+    sk_sp<SkStrike>* strikeHandle = shard->fStrikeLookup.find(desc);
     if (strikeHandle == nullptr) { return nullptr; }
     SkStrike* strikePtr = strikeHandle->get();
     SkASSERT(strikePtr != nullptr);
-    if (fHead != strikePtr) {
+    if (head != strikePtr) {
         // Make most recently used
         strikePtr->fPrev->fNext = strikePtr->fNext;
         if (strikePtr->fNext != nullptr) {
             strikePtr->fNext->fPrev = strikePtr->fPrev;
         } else {
-            fTail = strikePtr->fPrev;
+            shard->fTail = strikePtr->fPrev;
         }
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+        head->fPrev = strikePtr;
+        strikePtr->fNext = head;
         strikePtr->fPrev = nullptr;
-        fHead = strikePtr;
+        head = strikePtr;
     }
     return sk_ref_sp(strikePtr);
 }
@@ -126,58 +144,63 @@ sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
-    SkAutoMutexExclusive ac(fLock);
-    return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+    Shard* shard = this->shardFor(strikeSpec.descriptor());
+    AutoShardLock ac(this, shard);
+    return this->internalCreateStrike(shard, strikeSpec, maybeMetrics, std::move(pinner));
 }
 
 auto SkStrikeCache::internalCreateStrike(
+        Shard* shard,
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<SkStrike> {
     std::unique_ptr<SkScalerContext> scaler = strikeSpec.createScalerContext();
     auto strike =
         sk_make_sp<SkStrike>(this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
+    this->internalAttachToHead(shard, strike);
     return strike;
 }
 
 void SkStrikeCache::purgePinned(size_t minBytesNeeded) {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(minBytesNeeded, /* checkPinners= */ true);
+    size_t bytesFreed = 0;
+    for (Shard& shard : fShards) {
+        AutoShardLock ac(this, &shard);
+        const size_t shardBytesNeeded = minBytesNeeded > bytesFreed ? minBytesNeeded - bytesFreed
+                                                                    : 0;
+        bytesFreed += this->internalPurge(&shard, shardBytesNeeded, /* checkPinners= */ true);
+    }
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed, /* checkPinners= */ true);
+    for (Shard& shard : fShards) {
+        AutoShardLock ac(this, &shard);
+        this->internalPurge(&shard, shard.fMemoryUsed, /* checkPinners= */ true);
+    }
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fTotalMemoryUsed;
+    return fTotalMemoryUsed.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCount;
+    return fCacheCount.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCountLimit;
+    return fCacheCountLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoMutexExclusive ac(fLock);
-
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
-    this->internalPurge();
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit, std::memory_order_relaxed);
+    for (Shard& shard : fShards) {
+        AutoShardLock ac(this, &shard);
+        this->internalPurge(&shard);
+    }
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheSizeLimit;
+    return fCacheSizeLimit.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::setCacheCountLimit(int newCount) {
@@ -185,48 +208,62 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoMutexExclusive ac(fLock);
-
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
-    this->internalPurge();
+    int prevCount = fCacheCountLimit.exchange(newCount, std::memory_order_relaxed);
+    for (Shard& shard : fShards) {
+        AutoShardLock ac(this, &shard);
+        this->internalPurge(&shard);
+    }
     return prevCount;
 }
 
+int64_t SkStrikeCache::getContendedLockCount() const {
+    return fContendedLockCount.load(std::memory_order_relaxed);
+}
+
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoMutexExclusive ac(fLock);
+    for (const Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
 
-    this->validate();
+        shard.validate();
 
-    for (SkStrike* strike = fHead; strike != nullptr; strike = strike->fNext) {
-        visitor(*strike);
+        for (SkStrike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            visitor(*strike);
+        }
     }
 }
 
-size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
+size_t SkStrikeCache::internalPurge(Shard* shard, size_t minBytesNeeded, bool checkPinners) {
 #ifndef SK_STRIKE_CACHE_DOESNT_AUTO_CHECK_PINNERS
     // Temporarily default to checking pinners, for staging.
     checkPinners = true;
 #endif
 
-    if (fPinnerCount == fCacheCount && !checkPinners)
+    if (shard->fPinnerCount == shard->fCacheCount && !checkPinners)
         return 0;
 
+    // A shard is only trimmed to its share of a budget when the whole cache is over that budget,
+    // so a few large strikes that happen to land in the same shard aren't purged needlessly.
+    const size_t cacheSizeLimit = fCacheSizeLimit.load(std::memory_order_relaxed);
+    const size_t shardSizeLimit = cacheSizeLimit / kShardCount;
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (fTotalMemoryUsed.load(std::memory_order_relaxed) > cacheSizeLimit &&
+        shard->fMemoryUsed > shardSizeLimit) {
+        bytesNeeded = shard->fMemoryUsed - shardSizeLimit;
     }
     bytesNeeded = std::max(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = std::max(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = std::max(bytesNeeded, shard->fMemoryUsed >> 2);
     }
 
+    const int32_t cacheCountLimit = fCacheCountLimit.load(std::memory_order_relaxed);
+    const int32_t shardCountLimit = cacheCountLimit / kShardCount;
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (fCacheCount.load(std::memory_order_relaxed) > cacheCountLimit &&
+        shard->fCacheCount > shardCountLimit) {
+        countNeeded = shard->fCacheCount - shardCountLimit;
         // no small purges!
-        countNeeded = std::max(countNeeded, fCacheCount >> 2);
+        countNeeded = std::max(countNeeded, shard->fCacheCount >> 2);
     }
 
     // early exit
@@ -239,7 +276,7 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
 
     // Start at the tail and proceed backwards deleting; the list is in LRU
     // order, with unimportant entries at the tail.
-    SkStrike* strike = fTail;
+    SkStrike* strike = shard->fTail;
     while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
         SkStrike* prev = strike->fPrev;
 
@@ -247,12 +284,12 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
         if (strike->fPinner == nullptr || (checkPinners && strike->fPinner->canDelete())) {
             bytesFreed += strike->fMemoryUsed;
             countFreed += 1;
-            this->internalRemoveStrike(strike);
+            this->internalRemoveStrike(shard, strike);
         }
         strike = prev;
     }
 
-    this->validate();
+    shard->validate();
 
 #ifdef SPEW_PURGE_STATUS
     if (countFreed) {
@@ -261,54 +298,60 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
     }
 #endif
 
+    TRACE_COUNTER1("skia", "SkStrikeCache bytes", fTotalMemoryUsed.load(std::memory_order_relaxed));
+    TRACE_COUNTER1("skia", "SkStrikeCache strikes", fCacheCount.load(std::memory_order_relaxed));
     return bytesFreed;
 }
 
-void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
-    SkASSERT(fStrikeLookup.find(strike->getDescriptor()) == nullptr);
+void SkStrikeCache::internalAttachToHead(Shard* shard, sk_sp<SkStrike> strike) {
+    SkASSERT(shard->fStrikeLookup.find(strike->getDescriptor()) == nullptr);
     SkStrike* strikePtr = strike.get();
-    fStrikeLookup.set(std::move(strike));
+    shard->fStrikeLookup.set(std::move(strike));
     SkASSERT(nullptr == strikePtr->fPrev && nullptr == strikePtr->fNext);
 
-    fCacheCount += 1;
-    fPinnerCount += strikePtr->fPinner != nullptr ? 1 : 0;
-    fTotalMemoryUsed += strikePtr->fMemoryUsed;
+    shard->fCacheCount += 1;
+    shard->fPinnerCount += strikePtr->fPinner != nullptr ? 1 : 0;
+    shard->fMemoryUsed += strikePtr->fMemoryUsed;
+    fCacheCount.fetch_add(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_add(strikePtr->fMemoryUsed, std::memory_order_relaxed);
 
-    if (fHead != nullptr) {
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+    if (shard->fHead != nullptr) {
+        shard->fHead->fPrev = strikePtr;
+        strikePtr->fNext = shard->fHead;
     }
 
-    if (fTail == nullptr) {
-        fTail = strikePtr;
+    if (shard->fTail == nullptr) {
+        shard->fTail = strikePtr;
     }
 
-    fHead = strikePtr; // Transfer ownership of strike to the cache list.
+    shard->fHead = strikePtr; // Transfer ownership of strike to the cache list.
 }
 
-void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
-    SkASSERT(fCacheCount > 0);
-    fCacheCount -= 1;
-    fPinnerCount -= strike->fPinner != nullptr ? 1 : 0;
-    fTotalMemoryUsed -= strike->fMemoryUsed;
+void SkStrikeCache::internalRemoveStrike(Shard* shard, SkStrike* strike) {
+    SkASSERT(shard->fCacheCount > 0);
+    shard->fCacheCount -= 1;
+    shard->fPinnerCount -= strike->fPinner != nullptr ? 1 : 0;
+    shard->fMemoryUsed -= strike->fMemoryUsed;
+    fCacheCount.fetch_sub(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_sub(strike->fMemoryUsed, std::memory_order_relaxed);
 
     if (strike->fPrev) {
         strike->fPrev->fNext = strike->fNext;
     } else {
-        fHead = strike->fNext;
+        shard->fHead = strike->fNext;
     }
     if (strike->fNext) {
         strike->fNext->fPrev = strike->fPrev;
     } else {
-        fTail = strike->fPrev;
+        shard->fTail = strike->fPrev;
     }
 
     strike->fPrev = strike->fNext = nullptr;
     strike->fRemoved = true;
-    fStrikeLookup.remove(strike->getDescriptor());
+    shard->fStrikeLookup.remove(strike->getDescriptor());
 }
 
-void SkStrikeCache::validate() const {
+void SkStrikeCache::Shard::validate() const {
 #ifdef SK_DEBUG
     size_t computedBytes = 0;
     int computedCount = 0;
@@ -325,9 +368,9 @@ void SkStrikeCache::validate() const {
         SkDebugf("fCacheCount: %d, computedCount: %d", fCacheCount, computedCount);
         SK_ABORT("fCacheCount != computedCount");
     }
-    if (fTotalMemoryUsed != computedBytes) {
-        SkDebugf("fTotalMemoryUsed: %zu, computedBytes: %zu", fTotalMemoryUsed, computedBytes);
-        SK_ABORT("fTotalMemoryUsed == computedBytes");
+    if (fMemoryUsed != computedBytes) {
+        SkDebugf("fMemoryUsed: %zu, computedBytes: %zu", fMemoryUsed, computedBytes);
+        SK_ABORT("fMemoryUsed == computedBytes");
     }
 #endif
 }
@@ -340,4 +383,3 @@ uint32_t SkStrikeCache::StrikeTraits::Hash(const SkDescriptor& descriptor) {
     return descriptor.getChecksum();
 }
 
-
@@ -253,6 +253,11 @@ const SkGlyph* SkBulkGlyphMetricsAndImages::glyph(SkPackedGlyphID packedID) {
     return this->glyphs(SkSpan<const SkPackedGlyphID>{&packedID, 1})[0];
 }
 
+void SkBulkGlyphMetricsAndImages::prerasterize(SkSpan<const SkPackedGlyphID> packedIDs,
+                                               SkExecutor* executor) {
+    fStrike->prerasterizeImages(packedIDs, executor);
+}
+
 const SkDescriptor& SkBulkGlyphMetricsAndImages::descriptor() const {
     return fStrike->getDescriptor();
 }
@@ -23,6 +23,7 @@
 #include <memory>
 #include <tuple>
 
+class SkExecutor;
 class SkFont;
 class SkGlyph;
 class SkMatrix;
@@ -164,6 +165,10 @@ public:
     const SkGlyph* glyph(SkPackedGlyphID packedID);
     const SkDescriptor& descriptor() const;
 
+    // Rasterize the missing images of packedIDs in parallel on executor, so that glyphs() and
+    // glyph() find them. See SkStrike::prerasterizeImages().
+    void prerasterize(SkSpan<const SkPackedGlyphID> packedIDs, SkExecutor* executor);
+
 private:
     inline static constexpr int kTypicalGlyphCount = 64;
     skia_private::AutoSTArray<kTypicalGlyphCount, const SkGlyph*> fGlyphs;
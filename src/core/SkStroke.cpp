@@ -19,9 +19,11 @@
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkPointPriv.h"
 #include "src/core/SkStrokerPriv.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
 #include <array>
+#include <vector>
 
 enum {
     kTangent_RecursiveLimit,
@@ -1430,40 +1432,11 @@ private:
     bool            fSwapWithSrc;
 };
 
-void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
-    SkASSERT(dst);
-
-    SkScalar radius = SkScalarHalf(fWidth);
-
-    AutoTmpPath tmp(src, &dst);
-
-    if (radius <= 0) {
-        return;
-    }
-
-    // If src is really a rect, call our specialty strokeRect() method
-    {
-        SkRect rect;
-        bool isClosed = false;
-        SkPathDirection dir;
-        if (src.isRect(&rect, &isClosed, &dir) && isClosed) {
-            this->strokeRect(rect, dst, dir);
-            // our answer should preserve the inverseness of the src
-            if (src.isInverseFillType()) {
-                SkASSERT(!dst->isInverseFillType());
-                dst->toggleInverseFillType();
-            }
-            return;
-        }
-    }
-
-    // We can always ignore centers for stroke and fill convex line-only paths
-    // TODO: remove the line-only restriction
-    bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) &&
-                        src.isLastContourClosed() && src.isConvex();
-
-    SkPathStroker   stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
-                            fResScale, ignoreCenter);
+// Strokes the contours of src into dst. If src doesn't end the path being stroked (i.e. it is
+// followed by more contours), its last contour is finished as if by the next moveTo.
+static void stroke_contours(SkPathStroker* strokerPtr, const SkPath& src, SkPaint::Cap cap,
+                            bool endsPath, SkPath* dst) {
+    SkPathStroker&  stroker = *strokerPtr;
     SkPath::Iter    iter(src, false);
     SkPath::Verb    lastSegment = SkPath::kMove_Verb;
 
@@ -1490,7 +1463,7 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
                 lastSegment = SkPath::kCubic_Verb;
                 break;
             case SkPath::kClose_Verb:
-                if (SkPaint::kButt_Cap != this->getCap()) {
+                if (SkPaint::kButt_Cap != cap) {
                     /* If the stroke consists of a moveTo followed by a close, treat it
                        as if it were followed by a zero-length line. Lines without length
                        can have square and round end caps. */
@@ -1514,7 +1487,118 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
         }
     }
 DONE:
-    stroker.done(dst, lastSegment == SkPath::kLine_Verb);
+    stroker.done(dst, endsPath && lastSegment == SkPath::kLine_Verb);
+}
+
+bool SkStroke::strokeContoursInParallel(const SkPath& src, SkScalar radius, bool ignoreCenter,
+                                        SkPath* dst) const {
+    // Each contour is stroked on its own, so a path with many contours can be split at its
+    // moveTos into parts that are stroked in parallel on the default SkExecutor. Appending the
+    // strokes of the parts, in order, gives exactly the stroke of the whole path.
+    constexpr int kMinVerbsPerPart = 1024;
+    constexpr int kMaxParts = 64;
+    const int verbCount = src.countVerbs();
+    if (verbCount < 2 * kMinVerbsPerPart || !src.isFinite()) {
+        return false;
+    }
+    const int verbsPerPart = std::max(kMinVerbsPerPart, verbCount / kMaxParts);
+
+    struct Part {
+        int firstVerb, verbCount;
+        int firstPoint, pointCount;
+        int firstWeight, weightCount;
+        SkPath stroke;
+    };
+    std::vector<Part> parts;
+    const uint8_t* verbs = SkPathPriv::VerbData(src);
+    int pointIndex = 0,
+        weightIndex = 0;
+    parts.push_back({0, 0, 0, 0, 0, 0, SkPath()});
+    for (int i = 0; i < verbCount; ++i) {
+        Part* part = &parts.back();
+        if (verbs[i] == (uint8_t)SkPathVerb::kMove && i - part->firstVerb >= verbsPerPart) {
+            part->verbCount = i - part->firstVerb;
+            part->pointCount = pointIndex - part->firstPoint;
+            part->weightCount = weightIndex - part->firstWeight;
+            parts.push_back({i, 0, pointIndex, 0, weightIndex, 0, SkPath()});
+        }
+        pointIndex += SkPathPriv::PtsInVerb(verbs[i]);
+        weightIndex += verbs[i] == (uint8_t)SkPathVerb::kConic;
+    }
+    if (parts.size() < 2) {
+        return false;
+    }
+    Part* last = &parts.back();
+    last->verbCount = verbCount - last->firstVerb;
+    last->pointCount = pointIndex - last->firstPoint;
+    last->weightCount = weightIndex - last->firstWeight;
+
+    const SkPoint* points = SkPathPriv::PointData(src);
+    const SkScalar* weights = SkPathPriv::ConicWeightData(src);
+    auto strokePart = [&](int index) {
+        Part& part = parts[index];
+        SkPath contours = SkPath::Make(points + part.firstPoint, part.pointCount,
+                                       verbs + part.firstVerb, part.verbCount,
+                                       weights + part.firstWeight, part.weightCount,
+                                       src.getFillType(), /*isVolatile=*/true);
+        SkPathStroker stroker(contours, radius, fMiterLimit, this->getCap(), this->getJoin(),
+                              fResScale, ignoreCenter);
+        stroke_contours(&stroker, contours, this->getCap(),
+                        /*endsPath=*/index == SkToInt(parts.size()) - 1, &part.stroke);
+    };
+    SkTaskGroup group;
+    group.batch(SkToInt(parts.size()), strokePart);
+    group.wait();
+
+    int strokePoints = 0;
+    for (const Part& part : parts) {
+        strokePoints += part.stroke.countPoints();
+    }
+    dst->incReserve(strokePoints);
+    for (const Part& part : parts) {
+        dst->addPath(part.stroke, SkPath::kAppend_AddPathMode);
+    }
+    dst->setIsVolatile(true);
+    return true;
+}
+
+void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
+    SkASSERT(dst);
+
+    SkScalar radius = SkScalarHalf(fWidth);
+
+    AutoTmpPath tmp(src, &dst);
+
+    if (radius <= 0) {
+        return;
+    }
+
+    // If src is really a rect, call our specialty strokeRect() method
+    {
+        SkRect rect;
+        bool isClosed = false;
+        SkPathDirection dir;
+        if (src.isRect(&rect, &isClosed, &dir) && isClosed) {
+            this->strokeRect(rect, dst, dir);
+            // our answer should preserve the inverseness of the src
+            if (src.isInverseFillType()) {
+                SkASSERT(!dst->isInverseFillType());
+                dst->toggleInverseFillType();
+            }
+            return;
+        }
+    }
+
+    // We can always ignore centers for stroke and fill convex line-only paths
+    // TODO: remove the line-only restriction
+    bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) &&
+                        src.isLastContourClosed() && src.isConvex();
+
+    if (!this->strokeContoursInParallel(src, radius, ignoreCenter, dst)) {
+        SkPathStroker stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
+                              fResScale, ignoreCenter);
+        stroke_contours(&stroker, src, this->getCap(), /*endsPath=*/true, dst);
+    }
 
     if (fDoFill && !ignoreCenter) {
         if (SkPathPriv::ComputeFirstDirection(src) == SkPathFirstDirection::kCCW) {
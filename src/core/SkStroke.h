@@ -75,6 +75,11 @@ public:
     ////////////////////////////////////////////////////////////////
 
 private:
+    // Strokes large paths with many contours in parallel. Returns false (without touching dst) if
+    // the path should be stroked serially instead.
+    bool    strokeContoursInParallel(const SkPath& src, SkScalar radius, bool ignoreCenter,
+                                     SkPath* dst) const;
+
     SkScalar    fWidth, fMiterLimit;
     SkScalar    fResScale;
     uint8_t     fCap, fJoin;
@@ -34,6 +34,11 @@ namespace SkOpts {
         gray_to_RGB1          = hsw::gray_to_RGB1;
         grayA_to_RGBA         = hsw::grayA_to_RGBA;
         grayA_to_rgbA         = hsw::grayA_to_rgbA;
+        RGBA16_to_RGBA        = hsw::RGBA16_to_RGBA;
+        RGBA16_to_BGRA        = hsw::RGBA16_to_BGRA;
+        RGB16_to_RGB1         = hsw::RGB16_to_RGB1;
+        RGB16_to_BGR1         = hsw::RGB16_to_BGR1;
+        index_to_8888         = hsw::index_to_8888;
         inverted_CMYK_to_RGB1 = hsw::inverted_CMYK_to_RGB1;
         inverted_CMYK_to_BGR1 = hsw::inverted_CMYK_to_BGR1;
     }
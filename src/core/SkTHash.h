@@ -438,17 +438,19 @@ private:
 
 // Maps K->V.  A more user-friendly wrapper around THashTable, suitable for most use cases.
 // K and V are treated as ordinary copyable C++ types, with no assumed relationship between the two.
-template <typename K, typename V, typename HashK = SkGoodHash>
+// Table may be any class template with THashTable's API, e.g. TSwissHashTable.
+template <typename K, typename V, typename HashK = SkGoodHash,
+          template <typename, typename, typename> class Table = THashTable>
 class THashMap {
 public:
     // Allow default construction and assignment.
     THashMap() = default;
 
-    THashMap(THashMap<K, V, HashK>&& that) = default;
-    THashMap(const THashMap<K, V, HashK>& that) = default;
+    THashMap(THashMap&& that) = default;
+    THashMap(const THashMap& that) = default;
 
-    THashMap<K, V, HashK>& operator=(THashMap<K, V, HashK>&& that) = default;
-    THashMap<K, V, HashK>& operator=(const THashMap<K, V, HashK>& that) = default;
+    THashMap& operator=(THashMap&& that) = default;
+    THashMap& operator=(const THashMap& that) = default;
 
     // Construct with an initializer list of key-value pairs.
     struct Pair : public std::pair<K, V> {
@@ -537,7 +539,7 @@ public:
     }
 
     // Dereferencing an iterator gives back a key-value pair, suitable for structured binding.
-    using Iter = typename THashTable<Pair, K>::template Iter<std::pair<K, V>>;
+    using Iter = typename Table<Pair, K, Pair>::template Iter<std::pair<K, V>>;
 
     Iter begin() const {
         return Iter::MakeBegin(&fTable);
@@ -548,21 +550,22 @@ public:
     }
 
 private:
-    THashTable<Pair, K> fTable;
+    Table<Pair, K, Pair> fTable;
 };
 
 // A set of T.  T is treated as an ordinary copyable C++ type.
-template <typename T, typename HashT = SkGoodHash>
+template <typename T, typename HashT = SkGoodHash,
+          template <typename, typename, typename> class Table = THashTable>
 class THashSet {
 public:
     // Allow default construction and assignment.
     THashSet() = default;
 
-    THashSet(THashSet<T, HashT>&& that) = default;
-    THashSet(const THashSet<T, HashT>& that) = default;
+    THashSet(THashSet&& that) = default;
+    THashSet(const THashSet& that) = default;
 
-    THashSet<T, HashT>& operator=(THashSet<T, HashT>&& that) = default;
-    THashSet<T, HashT>& operator=(const THashSet<T, HashT>& that) = default;
+    THashSet& operator=(THashSet&& that) = default;
+    THashSet& operator=(const THashSet& that) = default;
 
     // Construct with an initializer list of Ts.
     THashSet(std::initializer_list<T> vals) {
@@ -617,7 +620,7 @@ private:
     };
 
 public:
-    using Iter = typename THashTable<T, T, Traits>::template Iter<T>;
+    using Iter = typename Table<T, T, Traits>::template Iter<T>;
 
     Iter begin() const {
         return Iter::MakeBegin(&fTable);
@@ -628,7 +631,7 @@ public:
     }
 
 private:
-    THashTable<T, T, Traits> fTable;
+    Table<T, T, Traits> fTable;
 };
 
 }  // namespace skia_private
@@ -0,0 +1,476 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTSwissHash_DEFINED
+#define SkTSwissHash_DEFINED
+
+#include "include/core/SkTypes.h"
+#include "src/base/SkMathPriv.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace skia_private {
+
+// A group of consecutive control bytes, one per slot of a TSwissHashTable, which are compared all
+// at once. A control byte is kEmpty, kDeleted, or for a full slot the low 7 bits of its hash.
+class SwissGroup {
+public:
+    static constexpr uint8_t kEmpty   = 0x80;
+    static constexpr uint8_t kDeleted = 0xfe;
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    static constexpr int kWidth = 16;
+    static constexpr int kShift = 0;  // Lane i is bit (i << kShift) of a Mask.
+#elif defined(SK_ARM_HAS_NEON)
+    static constexpr int kWidth = 16;
+    static constexpr int kShift = 2;
+#else
+    static constexpr int kWidth = 8;
+    static constexpr int kShift = 3;
+#endif
+
+    // The lanes that matched, to be visited from the lowest up.
+    class Mask {
+    public:
+        explicit Mask(uint64_t bits) : fBits(bits) {}
+
+        explicit operator bool() const { return fBits != 0; }
+
+        int lowest() const {
+            const uint32_t lo = (uint32_t)fBits;
+            return (lo ? SkCTZ(lo) : 32 + SkCTZ((uint32_t)(fBits >> 32))) >> kShift;
+        }
+
+        void clearLowest() { fBits &= fBits - 1; }
+
+    private:
+        uint64_t fBits;
+    };
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    explicit SwissGroup(const uint8_t* ctrl)
+            : fCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    Mask match(uint8_t h2) const { return Mask(Bits(_mm_cmpeq_epi8(fCtrl, Splat(h2)))); }
+    Mask matchEmpty() const { return Mask(Bits(_mm_cmpeq_epi8(fCtrl, Splat(kEmpty)))); }
+    // Full slots are the only ones without their top bit set.
+    Mask matchEmptyOrDeleted() const { return Mask(Bits(fCtrl)); }
+
+private:
+    static __m128i Splat(uint8_t v) { return _mm_set1_epi8((char)v); }
+    static uint64_t Bits(__m128i v) { return (uint32_t)_mm_movemask_epi8(v); }
+
+    __m128i fCtrl;
+#elif defined(SK_ARM_HAS_NEON)
+    explicit SwissGroup(const uint8_t* ctrl) : fCtrl(vld1q_u8(ctrl)) {}
+
+    Mask match(uint8_t h2) const { return Mask(Bits(vceqq_u8(fCtrl, vdupq_n_u8(h2)))); }
+    Mask matchEmpty() const { return Mask(Bits(vceqq_u8(fCtrl, vdupq_n_u8(kEmpty)))); }
+    Mask matchEmptyOrDeleted() const {
+        return Mask(Bits(vcltq_s8(vreinterpretq_s8_u8(fCtrl), vdupq_n_s8(0))));
+    }
+
+private:
+    // NEON has no movemask, but narrowing each pair of lanes leaves a nibble per lane.
+    static uint64_t Bits(uint8x16_t v) {
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+    }
+
+    uint8x16_t fCtrl;
+#else
+    explicit SwissGroup(const uint8_t* ctrl) { memcpy(&fCtrl, ctrl, sizeof(fCtrl)); }
+
+    // This may also report lanes just above a real match, which is fine as keys are compared.
+    Mask match(uint8_t h2) const {
+        const uint64_t x = fCtrl ^ (kLsbs * h2);
+        return Mask((x - kLsbs) & ~x & kMsbs);
+    }
+    // kEmpty and kDeleted have the top bit set, and differ in the bottom two.
+    Mask matchEmpty() const { return Mask(fCtrl & ~(fCtrl << 6) & kMsbs); }
+    Mask matchEmptyOrDeleted() const { return Mask(fCtrl & ~(fCtrl << 7) & kMsbs); }
+
+private:
+    static constexpr uint64_t kLsbs = 0x0101010101010101ull,
+                              kMsbs = 0x8080808080808080ull;
+
+    uint64_t fCtrl;
+#endif
+};
+
+// A drop-in replacement for THashTable, laid out like Abseil's SwissTable. Each slot has a control
+// byte holding 7 bits of its hash, and lookups compare a whole group of them with SIMD, touching
+// the slots themselves only for likely matches. That makes misses and collisions much cheaper than
+// THashTable's slot-by-slot probing, and allows a higher load factor (7/8 rather than 3/4), at the
+// cost of tables holding at least one group of slots.
+//
+// T, K and Traits are as for THashTable, and so are the API and its caveats. Removals leave
+// tombstones in groups that have been full, which are cleared when the table is next rehashed.
+template <typename T, typename K, typename Traits = T>
+class TSwissHashTable {
+public:
+    TSwissHashTable()  = default;
+    ~TSwissHashTable() { this->destroyAll(); }
+
+    TSwissHashTable(const TSwissHashTable&  that) { *this = that; }
+    TSwissHashTable(      TSwissHashTable&& that) { *this = std::move(that); }
+
+    TSwissHashTable& operator=(const TSwissHashTable& that) {
+        if (this != &that) {
+            this->destroyAll();
+            this->allocate(that.fCapacity);
+            fCount      = that.fCount;
+            fGrowthLeft = that.fGrowthLeft;
+            if (fCapacity > 0) {
+                memcpy(fCtrl.get(), that.fCtrl.get(), fCapacity);
+            }
+            for (int i = 0; i < fCapacity; i++) {
+                if (IsFull(fCtrl[i])) {
+                    new (&fSlots[i].fVal) T(that.fSlots[i].fVal);
+                }
+            }
+        }
+        return *this;
+    }
+
+    TSwissHashTable& operator=(TSwissHashTable&& that) {
+        if (this != &that) {
+            this->destroyAll();
+            fCount      = that.fCount;
+            fCapacity   = that.fCapacity;
+            fGrowthLeft = that.fGrowthLeft;
+            fCtrl       = std::move(that.fCtrl);
+            fSlots      = std::move(that.fSlots);
+
+            that.fCount = that.fCapacity = that.fGrowthLeft = 0;
+        }
+        return *this;
+    }
+
+    // Clear the table.
+    void reset() { *this = TSwissHashTable(); }
+
+    // How many entries are in the table?
+    int count() const { return fCount; }
+
+    // How many slots does the table contain?
+    int capacity() const { return fCapacity; }
+
+    // Approximately how many bytes of memory do we use beyond sizeof(*this)?
+    size_t approxBytesUsed() const { return fCapacity * (sizeof(Slot) + 1); }
+
+    // Exchange two hash tables.
+    void swap(TSwissHashTable& that) {
+        std::swap(fCount, that.fCount);
+        std::swap(fCapacity, that.fCapacity);
+        std::swap(fGrowthLeft, that.fGrowthLeft);
+        std::swap(fCtrl, that.fCtrl);
+        std::swap(fSlots, that.fSlots);
+    }
+
+    void swap(TSwissHashTable&& that) {
+        *this = std::move(that);
+    }
+
+    // Copy val into the hash table, returning a pointer to the copy now in the table.
+    // If there already is an entry in the table with the same key, we overwrite it.
+    T* set(T val) {
+        const uint32_t hash = Hash(Traits::GetKey(val));
+        if (T* existing = this->find(Traits::GetKey(val), hash)) {
+            existing->~T();
+            return new (existing) T(std::move(val));
+        }
+        if (fGrowthLeft == 0) {
+            // Make room, either by clearing out tombstones or by growing.
+            this->resize(fCount < MaxLoad(fCapacity) / 2 ? fCapacity : 2 * fCapacity);
+        }
+        return this->insertNew(std::move(val), hash);
+    }
+
+    // If there is an entry in the table with this key, return a pointer to it.  If not, null.
+    T* find(const K& key) const {
+        return this->find(key, Hash(key));
+    }
+
+    // If there is an entry in the table with this key, return it.  If not, null.
+    // This only works for pointer type T, and cannot be used to find an nullptr entry.
+    T findOrNull(const K& key) const {
+        if (T* p = this->find(key)) {
+            return *p;
+        }
+        return nullptr;
+    }
+
+    // If a value with this key exists in the hash table, removes it and returns true.
+    // Otherwise, returns false.
+    bool removeIfExists(const K& key) {
+        T* found = this->find(key);
+        if (!found) {
+            return false;
+        }
+        const int index = SkToInt(reinterpret_cast<Slot*>(found) - fSlots.get());
+        found->~T();
+        fCount--;
+        // A lookup only moves past a group once it has been full. Until then, no key can have
+        // been placed beyond it, and the slot may be marked empty rather than deleted.
+        const int group = index & ~(kWidth - 1);
+        if (SwissGroup(fCtrl.get() + group).matchEmpty()) {
+            fCtrl[index] = SwissGroup::kEmpty;
+            fGrowthLeft++;
+        } else {
+            fCtrl[index] = SwissGroup::kDeleted;
+        }
+        if (4 * fCount <= fCapacity && fCapacity > kWidth) {
+            this->resize(fCapacity / 2);
+        }
+        return true;
+    }
+
+    // Removes the value with this key from the hash table. Asserts if it is missing.
+    void remove(const K& key) {
+        SkAssertResult(this->removeIfExists(key));
+    }
+
+    // Hash tables will automatically resize themselves when set() and remove() are called, but
+    // resize() can be called to manually grow capacity before a bulk insertion. The capacity is
+    // rounded up to a power of two number of groups with room for every entry.
+    void resize(int capacity) {
+        SkASSERT(capacity >= fCount);
+        int newCapacity = kWidth;
+        while (newCapacity < capacity || MaxLoad(newCapacity) <= fCount) {
+            newCapacity *= 2;
+        }
+
+        const int oldCapacity = fCapacity;
+        SkDEBUGCODE(const int oldCount = fCount;)
+        std::unique_ptr<uint8_t[]> oldCtrl = std::move(fCtrl);
+        std::unique_ptr<Slot[]> oldSlots = std::move(fSlots);
+        this->allocate(newCapacity);
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (IsFull(oldCtrl[i])) {
+                T& val = oldSlots[i].fVal;
+                this->insertNew(std::move(val), Hash(Traits::GetKey(val)));
+                val.~T();
+            }
+        }
+        SkASSERT(fCount == oldCount);
+    }
+
+    // Call fn on every entry in the table.  You may mutate the entries, but be very careful.
+    template <typename Fn>  // f(T*)
+    void foreach(Fn&& fn) {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(&fSlots[i].fVal);
+            }
+        }
+    }
+
+    // Call fn on every entry in the table.  You may not mutate anything.
+    template <typename Fn>  // f(T) or f(const T&)
+    void foreach(Fn&& fn) const {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(fSlots[i].fVal);
+            }
+        }
+    }
+
+    // A basic iterator-like class which disallows mutation; sufficient for range-based for loops.
+    // Intended for use by THashMap and THashSet via begin() and end().
+    // Adding or removing elements may invalidate all iterators.
+    template <typename SlotVal>
+    class Iter {
+    public:
+        using TTable = TSwissHashTable<T, K, Traits>;
+
+        Iter(const TTable* table, int slot) : fTable(table), fSlot(slot) {}
+
+        static Iter MakeBegin(const TTable* table) {
+            return Iter{table, table->nextPopulatedSlot(-1)};
+        }
+
+        static Iter MakeEnd(const TTable* table) {
+            return Iter{table, table->capacity()};
+        }
+
+        const SlotVal& operator*() const {
+            return *fTable->slot(fSlot);
+        }
+
+        const SlotVal* operator->() const {
+            return fTable->slot(fSlot);
+        }
+
+        bool operator==(const Iter& that) const {
+            // Iterators from different tables shouldn't be compared against each other.
+            SkASSERT(fTable == that.fTable);
+            return fSlot == that.fSlot;
+        }
+
+        bool operator!=(const Iter& that) const {
+            return !(*this == that);
+        }
+
+        Iter& operator++() {
+            fSlot = fTable->nextPopulatedSlot(fSlot);
+            return *this;
+        }
+
+        Iter operator++(int) {
+            Iter old = *this;
+            this->operator++();
+            return old;
+        }
+
+    protected:
+        const TTable* fTable;
+        int fSlot;
+    };
+
+private:
+    static constexpr int kWidth = SwissGroup::kWidth;
+
+    static bool IsFull(uint8_t ctrl) { return ctrl < SwissGroup::kEmpty; }
+
+    // The most entries (including tombstones) a table of this capacity may hold.
+    static int MaxLoad(int capacity) { return capacity - capacity / 8; }
+
+    static uint32_t Hash(const K& key) { return Traits::Hash(key) & 0xffffffff; }
+
+    // The low 7 bits of the hash go in the control byte, and the rest pick the first group.
+    static uint8_t H2(uint32_t hash) { return hash & 0x7f; }
+
+    // Calls fn(firstSlotOfGroup) for each group in the probe sequence of hash, until it returns
+    // true. The groups are visited with quadratic (triangular) probing, which reaches every group
+    // in a power of two number of them.
+    template <typename Fn>
+    void probe(uint32_t hash, Fn&& fn) const {
+        const int groupMask = fCapacity / kWidth - 1;
+        int group = (hash >> 7) & groupMask;
+        for (int n = 0; n <= groupMask; n++) {
+            if (fn(group * kWidth)) {
+                return;
+            }
+            group = (group + n + 1) & groupMask;
+        }
+    }
+
+    T* find(const K& key, uint32_t hash) const {
+        if (fCapacity == 0) {
+            return nullptr;
+        }
+        T* found = nullptr;
+        this->probe(hash, [&](int first) {
+            const SwissGroup group(fCtrl.get() + first);
+            for (SwissGroup::Mask m = group.match(H2(hash)); m; m.clearLowest()) {
+                T& val = fSlots[first + m.lowest()].fVal;
+                if (key == Traits::GetKey(val)) {
+                    found = &val;
+                    return true;
+                }
+            }
+            // Had the key been added, it would have gone in the first empty slot.
+            return (bool)group.matchEmpty();
+        });
+        return found;
+    }
+
+    // Adds val, which is not already in the table, to the first free slot in its probe sequence.
+    T* insertNew(T&& val, uint32_t hash) {
+        SkASSERT(fGrowthLeft > 0);
+        int index = -1;
+        this->probe(hash, [&](int first) {
+            if (SwissGroup::Mask m = SwissGroup(fCtrl.get() + first).matchEmptyOrDeleted()) {
+                index = first + m.lowest();
+                return true;
+            }
+            return false;
+        });
+        SkASSERT(index >= 0);
+        if (fCtrl[index] == SwissGroup::kEmpty) {
+            fGrowthLeft--;
+        }
+        fCtrl[index] = H2(hash);
+        fCount++;
+        return new (&fSlots[index].fVal) T(std::move(val));
+    }
+
+    void allocate(int capacity) {
+        fCount      = 0;
+        fCapacity   = capacity;
+        fGrowthLeft = MaxLoad(capacity);
+        fCtrl.reset(capacity > 0 ? new uint8_t[capacity] : nullptr);
+        fSlots.reset(capacity > 0 ? new Slot[capacity] : nullptr);
+        if (capacity > 0) {
+            memset(fCtrl.get(), SwissGroup::kEmpty, capacity);
+        }
+    }
+
+    void destroyAll() {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fSlots[i].fVal.~T();
+                fCtrl[i] = SwissGroup::kEmpty;
+            }
+        }
+        fCount = 0;
+        fGrowthLeft = MaxLoad(fCapacity);
+    }
+
+    // Finds the next non-empty slot after currentSlot for an iterator.
+    int nextPopulatedSlot(int currentSlot) const {
+        for (int i = currentSlot + 1; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                return i;
+            }
+        }
+        return fCapacity;
+    }
+
+    // Reads from an iterator's slot.
+    const T* slot(int i) const {
+        SkASSERT(IsFull(fCtrl[i]));
+        return &fSlots[i].fVal;
+    }
+
+    // Storage for a T, which is constructed and destroyed according to the control bytes.
+    union Slot {
+        T fVal;
+        Slot() {}
+        ~Slot() {}
+    };
+
+    int fCount      = 0,
+        fCapacity   = 0,
+        fGrowthLeft = 0;
+    std::unique_ptr<uint8_t[]> fCtrl;
+    std::unique_ptr<Slot[]>    fSlots;
+};
+
+// THashMap and THashSet on top of TSwissHashTable.
+template <typename K, typename V, typename HashK = SkGoodHash>
+using TSwissHashMap = THashMap<K, V, HashK, TSwissHashTable>;
+
+template <typename T, typename HashT = SkGoodHash>
+using TSwissHashSet = THashSet<T, HashT, TSwissHashTable>;
+
+}  // namespace skia_private
+
+#endif  // SkTSwissHash_DEFINED
@@ -143,6 +143,7 @@ void SkTextBlob::RunRecord::grow(uint32_t count) {
     memmove(posBuffer(), initialPosBuffer, copySize);
 }
 
+
 static uint32_t next_id() {
     static std::atomic<uint32_t> nextID{1};
     uint32_t id;
@@ -207,6 +208,33 @@ unsigned SkTextBlob::ScalarsPerGlyph(GlyphPositioning pos) {
     return gScalarsPerPositioning[pos];
 }
 
+void SkTextBlob::RunRecord::makeHorizontal() {
+    SkASSERT(this->positioning() == kFull_Positioning);
+    SkASSERT(fCount > 0 && fOffset.isZero());
+
+    const uint8_t* initialTail = nullptr;
+    size_t tailSize = 0;
+    if (this->isExtended()) {
+        initialTail = reinterpret_cast<const uint8_t*>(this->textSizePtr());
+        tailSize = sizeof(uint32_t) + fCount * sizeof(uint32_t) + this->textSize();
+    }
+
+    // The x of each point moves down to its index in the buffer, which never overwrites a point
+    // that hasn't been read yet.
+    const SkPoint* points = this->pointBuffer();
+    fOffset.fY = points[0].fY;
+    SkScalar* xs = this->posBuffer();
+    for (uint32_t i = 0; i < fCount; ++i) {
+        xs[i] = points[i].fX;
+    }
+    fFlags = (fFlags & ~kPositioning_Mask) | kHorizontal_Positioning;
+
+    if (tailSize) {
+        // memmove, as the buffers may overlap
+        memmove(this->textSizePtr(), initialTail, tailSize);
+    }
+}
+
 void SkTextBlob::operator delete(void* p) {
     sk_free(p);
 }
@@ -265,11 +293,27 @@ SkTextBlobBuilder::SkTextBlobBuilder()
 }
 
 SkTextBlobBuilder::~SkTextBlobBuilder() {
-    if (nullptr != fStorage.get()) {
-        // We are abandoning runs and must destruct the associated font data.
-        // The easiest way to accomplish that is to use the blob destructor.
-        this->make();
+    this->reset();
+}
+
+void SkTextBlobBuilder::reset() {
+    // We are abandoning runs and must destruct the associated font data.
+    if (fRunCount > 0) {
+        auto* run = reinterpret_cast<SkTextBlob::RunRecord*>(fStorage.get() +
+                                                             SkAlignPtr(sizeof(SkTextBlob)));
+        for (int i = 0; i < fRunCount; ++i) {
+            auto* next = const_cast<SkTextBlob::RunRecord*>(
+                    SkTextBlob::RunRecord::NextUnchecked(run));
+            run->~RunRecord();
+            run = next;
+        }
     }
+
+    fStorageUsed = 0;
+    fRunCount = 0;
+    fLastRun = 0;
+    fDeferredBounds = false;
+    fBounds.setEmpty();
 }
 
 static SkRect map_quad_to_rect(const SkRSXform& xform, const SkRect& rect) {
@@ -403,28 +447,62 @@ void SkTextBlobBuilder::updateDeferredBounds() {
 void SkTextBlobBuilder::reserve(size_t size) {
     SkSafeMath safe;
 
-    // We don't currently pre-allocate, but maybe someday...
-    if (safe.add(fStorageUsed, size) <= fStorageSize && safe) {
-        return;
-    }
-
     if (0 == fRunCount) {
-        SkASSERT(nullptr == fStorage.get());
-        SkASSERT(0 == fStorageSize);
         SkASSERT(0 == fStorageUsed);
 
-        // the first allocation also includes blob storage
+        // the first run also includes blob storage
         // aligned up to a pointer alignment so SkTextBlob::RunRecords after it stay aligned.
         fStorageUsed = SkAlignPtr(sizeof(SkTextBlob));
     }
 
-    fStorageSize = safe.add(fStorageUsed, size);
+    const size_t needed = safe.add(fStorageUsed, size);
+    if (needed <= fStorageSize && safe) {
+        return;
+    }
+
+    // Grow by at least half again, so that adding runs one at a time doesn't realloc for each.
+    // The first run is allocated exactly, since most blobs have only one.
+    fStorageSize = 0 == fRunCount ? needed : std::max(needed, fStorageSize + fStorageSize / 2);
 
     // FYI: This relies on everything we store being relocatable, particularly SkPaint.
     //      Also, this is counting on the underlying realloc to throw when passed max().
     fStorage.realloc(safe ? fStorageSize : std::numeric_limits<size_t>::max());
 }
 
+void SkTextBlobBuilder::compactRuns() {
+    // Full positioned runs with every glyph at the same y (which is nearly all shaped text, and
+    // all text from SkTextBlob::MakeFromText()) are stored with horizontal positioning instead,
+    // which needs half the position storage. Later runs move down into the space this frees.
+    uint8_t* storage = fStorage.get();
+    size_t readOffset = SkAlignPtr(sizeof(SkTextBlob));
+    size_t writeOffset = readOffset;
+    for (int i = 0; i < fRunCount; ++i) {
+        SkSafeMath safe;
+        auto* run = reinterpret_cast<SkTextBlob::RunRecord*>(storage + readOffset);
+        const size_t runSize = SkTextBlob::RunRecord::StorageSize(
+                run->glyphCount(), run->textSize(), run->positioning(), &safe);
+        if (writeOffset != readOffset) {
+            memmove(storage + writeOffset, run, runSize);
+            run = reinterpret_cast<SkTextBlob::RunRecord*>(storage + writeOffset);
+        }
+        readOffset += runSize;
+
+        if (SkTextBlob::kFull_Positioning == run->positioning() && run->offset().isZero()) {
+            const SkPoint* points = run->pointBuffer();
+            const SkScalar y = points[0].fY;
+            if (std::all_of(points + 1, points + run->glyphCount(),
+                            [y](const SkPoint& point) { return point.fY == y; })) {
+                run->makeHorizontal();
+            }
+        }
+        writeOffset += SkTextBlob::RunRecord::StorageSize(
+                run->glyphCount(), run->textSize(), run->positioning(), &safe);
+        SkASSERT(safe);
+    }
+    SkASSERT(readOffset == fStorageUsed);
+    fStorageUsed = writeOffset;
+}
+
 bool SkTextBlobBuilder::mergeRun(const SkFont& font, SkTextBlob::GlyphPositioning positioning,
                                  uint32_t count, SkPoint offset) {
     if (0 == fLastRun) {
@@ -617,9 +695,7 @@ const SkTextBlobBuilder::RunBuffer& SkTextBlobBuilder::allocRunTextRSXform(const
 sk_sp<SkTextBlob> SkTextBlobBuilder::make() {
     if (!fRunCount) {
         // We don't instantiate empty blobs.
-        SkASSERT(!fStorage.get());
         SkASSERT(fStorageUsed == 0);
-        SkASSERT(fStorageSize == 0);
         SkASSERT(fLastRun == 0);
         SkASSERT(fBounds.isEmpty());
         return nullptr;
@@ -631,8 +707,23 @@ sk_sp<SkTextBlob> SkTextBlobBuilder::make() {
     auto* lastRun = reinterpret_cast<SkTextBlob::RunRecord*>(fStorage.get() + fLastRun);
     lastRun->fFlags |= SkTextBlob::RunRecord::kLast_Flag;
 
-    SkTextBlob* blob = new (fStorage.release()) SkTextBlob(fBounds);
-    SkDEBUGCODE(const_cast<SkTextBlob*>(blob)->fStorageSize = fStorageSize;)
+    this->compactRuns();
+
+    // If the blob needs most of the storage, the blob takes it over. Otherwise the blob is copied
+    // out to an allocation of its own size, and the builder keeps the storage for the next blob,
+    // so that a builder that is reused for blobs of many runs stops allocating for each run.
+    void* blobStorage;
+    if (fStorageSize - fStorageUsed <= fStorageUsed / 4) {
+        fStorage.realloc(fStorageUsed);
+        blobStorage = fStorage.release();
+        fStorageSize = 0;
+    } else {
+        // The runs are relocated (like realloc does), so they aren't destroyed here.
+        blobStorage = sk_malloc_throw(fStorageUsed);
+        memcpy(blobStorage, fStorage.get(), fStorageUsed);
+    }
+    SkTextBlob* blob = new (blobStorage) SkTextBlob(fBounds);
+    SkDEBUGCODE(const_cast<SkTextBlob*>(blob)->fStorageSize = fStorageUsed;)
 
     SkDEBUGCODE(
         SkSafeMath safe;
@@ -650,7 +741,6 @@ sk_sp<SkTextBlob> SkTextBlobBuilder::make() {
     )
 
     fStorageUsed = 0;
-    fStorageSize = 0;
     fRunCount = 0;
     fLastRun = 0;
     fBounds.setEmpty();
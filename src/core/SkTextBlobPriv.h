@@ -164,6 +164,10 @@ private:
 
     void grow(uint32_t count);
 
+    // Converts a full positioned run whose glyphs all have the same y to horizontal positioning,
+    // moving its text down to follow the smaller position buffer.
+    void makeHorizontal();
+
     bool isExtended() const {
         return fFlags & kExtended_Flag;
     }
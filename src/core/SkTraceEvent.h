@@ -398,6 +398,31 @@ class TRACE_EVENT_API_CLASS_EXPORT ScopedTracer {
   Data data_;
 };
 
+// Used by TRACE_CACHE_LOOKUP. Do not use directly.
+class TraceHitRateSampler {
+ public:
+  static constexpr uint32_t kPeriod = 256;
+
+  // Counts one lookup. Returns true once every kPeriod lookups, with the hits and misses among
+  // them. The lookup and hit counts share one atomic, so that concurrent lookups are neither lost
+  // nor reported twice.
+  bool sample(bool hit, int* hits, int* misses) {
+    const uint64_t delta = (uint64_t{1} << 32) | (hit ? 1 : 0);
+    const uint64_t counts = counts_.fetch_add(delta, std::memory_order_relaxed) + delta;
+    if ((counts >> 32) != kPeriod) {
+      return false;
+    }
+    // Lookups counted since the fetch_add above stay in counts_ for the next period.
+    counts_.fetch_sub(counts, std::memory_order_relaxed);
+    *hits = static_cast<int>(counts & 0xffffffff);
+    *misses = static_cast<int>(kPeriod) - *hits;
+    return true;
+  }
+
+ private:
+  std::atomic<uint64_t> counts_{0};
+};
+
 }  // namespace skia_private
 
 #endif
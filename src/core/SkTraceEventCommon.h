@@ -228,6 +228,17 @@ static inline void sk_noop(Args...) {}
 #define TRACE_EMPTY_FMT(fmt, ...) do {} while (0)
 #endif
 
+// SK_TRACE_LEVEL selects at compile time which tracepoints are built, when tracing is enabled:
+//   1: the regular tracepoints, around work that is large compared to the cost of a disabled event
+//      (flushes, uploads, shader compiles, ...).
+//   2: also the *_HOT tracepoints, which are in code that runs for every draw, glyph run or cache
+//      lookup. Even disabled, each one costs a load and a branch, and keeps its callers from being
+//      inlined. This is the default.
+// Builds that leave tracing on in production should use level 1 (skia_trace_level=1 in GN).
+#if !defined(SK_TRACE_LEVEL)
+    #define SK_TRACE_LEVEL 2
+#endif
+
 #if defined(SK_DISABLE_TRACING) || \
         (defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_ANDROID_FRAMEWORK_USE_PERFETTO))
 
@@ -696,6 +707,41 @@ namespace skia_private {
 #define TRACE_EVENT_SCOPE_PROCESS (static_cast<unsigned char>(1 << 3))
 #define TRACE_EVENT_SCOPE_THREAD (static_cast<unsigned char>(2 << 3))
 
+// Hot-path variants of TRACE_EVENT[0-2], which are compiled out below SK_TRACE_LEVEL 2.
+#if SK_TRACE_LEVEL >= 2
+    #define TRACE_EVENT0_HOT(cg, n) TRACE_EVENT0(cg, n)
+    #define TRACE_EVENT1_HOT(cg, n, a1n, a1v) TRACE_EVENT1(cg, n, a1n, a1v)
+    #define TRACE_EVENT2_HOT(cg, n, a1n, a1v, a2n, a2v) TRACE_EVENT2(cg, n, a1n, a1v, a2n, a2v)
+#else
+    #define TRACE_EVENT0_HOT(cg, n) TRACE_EMPTY(cg, n)
+    #define TRACE_EVENT1_HOT(cg, n, a1n, a1v) TRACE_EMPTY(cg, n, a1n, a1v)
+    #define TRACE_EVENT2_HOT(cg, n, a1n, a1v, a2n, a2v) TRACE_EMPTY(cg, n, a1n, a1v, a2n, a2v)
+#endif
+
+// Counts one lookup in a cache called "name", which hit if "hit" is true. Lookups are only counted
+// while the category is enabled, and every kPeriod of them the hits and misses among them are
+// recorded as a two-part counter, so a trace shows the hit rate over time without an event per
+// lookup. "name" must be a string literal. Compiled out below SK_TRACE_LEVEL 2.
+#if SK_TRACE_LEVEL >= 2 && !defined(SK_DISABLE_TRACING) && \
+        (!defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) || defined(SK_ANDROID_FRAMEWORK_USE_PERFETTO))
+    #define TRACE_CACHE_LOOKUP(category_group, name, hit)                                    \
+        do {                                                                                 \
+            bool trace_cache_lookup_enabled;                                                 \
+            TRACE_EVENT_CATEGORY_GROUP_ENABLED(category_group, &trace_cache_lookup_enabled); \
+            if (trace_cache_lookup_enabled) {                                                \
+                static skia_private::TraceHitRateSampler trace_cache_lookup_sampler;         \
+                int trace_cache_hits, trace_cache_misses;                                    \
+                if (trace_cache_lookup_sampler.sample(hit, &trace_cache_hits,                \
+                                                      &trace_cache_misses)) {                \
+                    TRACE_COUNTER2(category_group, name, "hits", trace_cache_hits,           \
+                                   "misses", trace_cache_misses);                            \
+                }                                                                            \
+            }                                                                                \
+        } while (0)
+#else
+    #define TRACE_CACHE_LOOKUP(category_group, name, hit) TRACE_EMPTY(category_group, name, hit)
+#endif
+
 #define TRACE_EVENT_SCOPE_NAME_GLOBAL ('g')
 #define TRACE_EVENT_SCOPE_NAME_PROCESS ('p')
 #define TRACE_EVENT_SCOPE_NAME_THREAD ('t')
@@ -15,13 +15,16 @@
 #include "include/core/SkPoint3.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkPaintPriv.h"
 #include "src/core/SkPtrRecorder.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/image/SkImage_Base.h"
 
 #if !defined(SK_DISABLE_LEGACY_PNG_WRITEBUFFER)
@@ -230,7 +233,12 @@ void SkBinaryWriteBuffer::writeImage(const SkImage* image) {
 
     this->write32(flags);
 
-    sk_sp<SkData> data = serialize_image(image, fProcs);
+    sk_sp<SkData> data;
+    if (sk_sp<SkData>* encoded = fEncodedImages.find(image)) {
+        data = *encoded;
+    } else {
+        data = serialize_image(image, fProcs);
+    }
     SkASSERT(data);
     this->writeDataAsByteArray(data.get());
 
@@ -240,6 +248,43 @@ void SkBinaryWriteBuffer::writeImage(const SkImage* image) {
     }
 }
 
+void SkBinaryWriteBuffer::preEncodeImages(SkSpan<const sk_sp<const SkImage>> images,
+                                          SkExecutor* executor) {
+    skia_private::TArray<const SkImage*> toEncode;
+    for (const sk_sp<const SkImage>& image : images) {
+        // Reading back a texture needs its context, which belongs to this thread.
+        if (image && !image->isTextureBacked() && !fEncodedImages.find(image.get())) {
+            toEncode.push_back(image.get());
+        }
+    }
+    if (toEncode.empty()) {
+        return;
+    }
+
+    skia_private::TArray<sk_sp<SkData>> encoded(toEncode.size());
+    encoded.push_back_n(toEncode.size());
+    auto encode = [&](int i) { encoded[i] = serialize_image(toEncode[i], fProcs); };
+    if (executor && toEncode.size() > 1) {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(toEncode.size(), encode);
+        taskGroup.wait();
+    } else {
+        for (int i = 0; i < toEncode.size(); ++i) {
+            encode(i);
+        }
+    }
+
+    // Flags, size and padded data for each.
+    size_t bytes = 0;
+    for (int i = 0; i < toEncode.size(); ++i) {
+        if (encoded[i]) {
+            bytes += 2 * sizeof(uint32_t) + SkAlign4(encoded[i]->size());
+            fEncodedImages.set(toEncode[i], std::move(encoded[i]));
+        }
+    }
+    fWriter.reserveCapacity(fWriter.bytesWritten() + bytes);
+}
+
 void SkBinaryWriteBuffer::writeTypeface(SkTypeface* obj) {
     // Write 32 bits (signed)
     //   0 -- empty font
@@ -14,6 +14,7 @@
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSerialProcs.h"
+#include "include/core/SkSpan.h"
 #include "src/core/SkTHash.h"
 #include "src/core/SkWriter32.h"
 
@@ -21,6 +22,7 @@
 #include <cstdint>
 #include <string_view>
 
+class SkExecutor;
 class SkFactorySet;
 class SkFlattenable;
 class SkImage;
@@ -153,12 +155,19 @@ public:
     void setFactoryRecorder(sk_sp<SkFactorySet>);
     void setTypefaceRecorder(sk_sp<SkRefCntSet>);
 
+    // Encodes images on the executor ahead of writeImage(), which then uses the encoded data, and
+    // makes room for it all in the buffer. Images that can't be encoded off of this thread, and
+    // their mipmaps, are left for writeImage().
+    void preEncodeImages(SkSpan<const sk_sp<const SkImage>>, SkExecutor*);
+
 private:
     sk_sp<SkFactorySet> fFactorySet;
     sk_sp<SkRefCntSet> fTFSet;
 
     SkWriter32 fWriter;
 
+    skia_private::THashMap<const SkImage*, sk_sp<SkData>> fEncodedImages;
+
     // Only used if we do not have an fFactorySet
     skia_private::THashMap<const char*, uint32_t> fFlattenableDict;
 };
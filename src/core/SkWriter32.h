@@ -63,6 +63,13 @@ public:
         fExternal = external;
     }
 
+    // Makes room for at least size bytes in total, so that writing that much won't reallocate.
+    void reserveCapacity(size_t size) {
+        if (size > fCapacity) {
+            this->growToAtLeast(size);
+        }
+    }
+
     // size MUST be multiple of 4
     uint32_t* reserve(size_t size) {
         SkASSERT(SkAlign4(size) == size);
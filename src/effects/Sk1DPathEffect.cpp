@@ -7,17 +7,18 @@
 
 #include "include/effects/Sk1DPathEffect.h"
 
+#include "include/core/SkContourMeasure.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
-#include "include/core/SkPathMeasure.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkStrokeRec.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "src/core/SkContourMeasureCache.h"
 #include "src/core/SkPathEffectBase.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
@@ -33,13 +34,13 @@ public:
 protected:
     bool onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec*, const SkRect*,
                       const SkMatrix&) const override {
-        SkPathMeasure   meas(src, false);
-        do {
+        const sk_sp<const SkMeasuredPath> measured = SkMeasuredPath::Make(src, false);
+        for (const sk_sp<SkContourMeasure>& meas : *measured) {
             int governor = MAX_REASONABLE_ITERATIONS;
-            SkScalar    length = meas.getLength();
+            SkScalar    length = meas->length();
             SkScalar    distance = this->begin(length);
             while (distance < length && --governor >= 0) {
-                SkScalar delta = this->next(dst, distance, meas);
+                SkScalar delta = this->next(dst, distance, *meas);
                 if (delta <= 0) {
                     break;
                 }
@@ -48,7 +49,7 @@ protected:
             if (governor < 0) {
                 return false;
             }
-        } while (meas.nextContour());
+        }
         return true;
     }
 
@@ -61,7 +62,7 @@ protected:
         Return the distance to travel for the next call. If return <= 0, then that
         contour is done.
     */
-    virtual SkScalar next(SkPath* dst, SkScalar dist, SkPathMeasure&) const = 0;
+    virtual SkScalar next(SkPath* dst, SkScalar dist, const SkContourMeasure&) const = 0;
 
 private:
     // For simplicity, assume fast bounds cannot be computed
@@ -114,7 +115,7 @@ public:
         return fInitialOffset;
     }
 
-    SkScalar next(SkPath*, SkScalar, SkPathMeasure&) const override;
+    SkScalar next(SkPath*, SkScalar, const SkContourMeasure&) const override;
 
     static sk_sp<SkFlattenable> CreateProc(SkReadBuffer& buffer) {
         SkScalar advance = buffer.readScalar();
@@ -145,7 +146,7 @@ private:
 };
 
 static bool morphpoints(SkPoint dst[], const SkPoint src[], int count,
-                        SkPathMeasure& meas, SkScalar dist) {
+                        const SkContourMeasure& meas, SkScalar dist) {
     for (int i = 0; i < count; i++) {
         SkPoint pos;
         SkVector tangent;
@@ -175,7 +176,7 @@ Need differentially more subdivisions when the follow-path is curvy. Not sure ho
 determine that, but we need it. I guess a cheap answer is let the caller tell us,
 but that seems like a cop-out. Another answer is to get Rob Johnson to figure it out.
 */
-static void morphpath(SkPath* dst, const SkPath& src, SkPathMeasure& meas,
+static void morphpath(SkPath* dst, const SkPath& src, const SkContourMeasure& meas,
                       SkScalar dist) {
     SkPath::Iter    iter(src, false);
     SkPoint         srcP[4], dstP[3];
@@ -219,7 +220,7 @@ static void morphpath(SkPath* dst, const SkPath& src, SkPathMeasure& meas,
 }
 
 SkScalar SkPath1DPathEffectImpl::next(SkPath* dst, SkScalar distance,
-                                      SkPathMeasure& meas) const {
+                                      const SkContourMeasure& meas) const {
 #if defined(SK_BUILD_FOR_FUZZER)
     if (dst->countPoints() > 100000) {
         return fAdvance;
@@ -15,19 +15,24 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkStrokeRec.h"
+#include "include/private/SkIDChangeListener.h"
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
+#include "src/core/SkPathPriv.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/effects/SkDashImpl.h"
 #include "src/utils/SkDashPathPriv.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 
 using namespace skia_private;
 
@@ -54,11 +59,101 @@ SkDashImpl::~SkDashImpl() {
     sk_free(fIntervals);
 }
 
+namespace {
+// Dashing a long curve measures it and extracts every dash, which dominates the cost of drawing
+// dashed curves and rrects. Those results are kept in SkResourceCache, keyed by the source path's
+// genID and the dash, so later draws of the same path reuse them. Lines and rects are culled to
+// the draw's bounds before dashing and are cheap, so they are always dashed directly.
+static void* kDashedPathNamespace;
+
+class DashedPathRec : public SkResourceCache::Rec {
+public:
+    DashedPathRec(const SkResourceCache::Key& key, const SkPath& dashed)
+            : fKeyStorage(new uint8_t[key.size()]), fDashed(dashed) {
+        memcpy(fKeyStorage.get(), &key, key.size());
+    }
+
+    const Key& getKey() const override {
+        return *reinterpret_cast<SkResourceCache::Key*>(fKeyStorage.get());
+    }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + this->getKey().size() + fDashed.approximateBytesUsed();
+    }
+    const char* getCategory() const override { return "dashed-path"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        *static_cast<SkPath*>(context) = static_cast<const DashedPathRec&>(baseRec).fDashed;
+        return true;
+    }
+
+private:
+    std::unique_ptr<uint8_t[]> fKeyStorage;
+    SkPath fDashed;
+};
+
+// When the SkPathRef genID changes, purge the dashed path described by key.
+class DashedPathInvalidator : public SkIDChangeListener {
+public:
+    DashedPathInvalidator(const SkResourceCache::Key& key) : fKeyStorage(new uint8_t[key.size()]) {
+        memcpy(fKeyStorage.get(), &key, key.size());
+    }
+
+private:
+    // always purge
+    static bool FindVisitor(const SkResourceCache::Rec&, void*) {
+        return false;
+    }
+
+    void changed() override {
+        SkResourceCache::Find(*reinterpret_cast<SkResourceCache::Key*>(fKeyStorage.get()),
+                              DashedPathInvalidator::FindVisitor, nullptr);
+    }
+
+    std::unique_ptr<uint8_t[]> fKeyStorage;
+};
+}  // namespace
+
 bool SkDashImpl::onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
                               const SkRect* cullRect, const SkMatrix&) const {
-    return SkDashPath::InternalFilter(dst, src, rec, cullRect, fIntervals, fCount,
-                                      fInitialDashLength, fInitialDashIndex, fIntervalLength,
-                                      fPhase);
+    const SkStrokeRec::Style style = rec->getStyle();
+    const float resScale = rec->getResScale();
+    if (!dst->isEmpty() || src.isVolatile() || src.isLine(nullptr) || src.isRect(nullptr) ||
+        (style != SkStrokeRec::kStroke_Style && style != SkStrokeRec::kHairline_Style) ||
+        !(resScale > 0) || !SkIsFinite(resScale)) {
+        return SkDashPath::InternalFilter(dst, src, rec, cullRect, fIntervals, fCount,
+                                          fInitialDashLength, fInitialDashIndex, fIntervalLength,
+                                          fPhase);
+    }
+
+    // Measure with the power of two above the stroke's resScale, so that draws at similar scales
+    // share an entry. A larger resScale only makes the dashes more precise.
+    const float cacheResScale = std::exp2(std::ceil(std::log2(resScale)));
+    SkStrokeRec cacheRec(*rec);
+    cacheRec.setResScale(cacheResScale);
+
+    // The key is the genID, the resScale, the phase, and the intervals.
+    const size_t keyDataBytes = (3 + fCount) * sizeof(uint32_t);
+    AutoSTArray<32 * 4, uint8_t> keyStorage(sizeof(SkResourceCache::Key) + keyDataBytes);
+    auto* key = new (keyStorage.begin()) SkResourceCache::Key();
+    uint32_t* keyData = reinterpret_cast<uint32_t*>(keyStorage.begin() + sizeof(*key));
+    keyData[0] = src.getGenerationID();
+    memcpy(&keyData[1], &cacheResScale, sizeof(float));
+    memcpy(&keyData[2], &fPhase, sizeof(float));
+    memcpy(&keyData[3], fIntervals, fCount * sizeof(float));
+    key->init(&kDashedPathNamespace, 0, keyDataBytes);
+
+    if (SkResourceCache::Find(*key, DashedPathRec::Visitor, dst)) {
+        return true;
+    }
+    if (!SkDashPath::InternalFilter(dst, src, &cacheRec, cullRect, fIntervals, fCount,
+                                    fInitialDashLength, fInitialDashIndex, fIntervalLength,
+                                    fPhase)) {
+        return false;
+    }
+    SkPathPriv::ShrinkToFit(dst);
+    SkPathPriv::AddGenIDChangeListener(src, sk_make_sp<DashedPathInvalidator>(*key));
+    SkResourceCache::Add(new DashedPathRec(*key, *dst));
+    return true;
 }
 
 static void outset_for_stroke(SkRect* rect, const SkStrokeRec& rec) {
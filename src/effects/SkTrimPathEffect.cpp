@@ -7,15 +7,16 @@
 
 #include "include/effects/SkTrimPathEffect.h"
 
+#include "include/core/SkContourMeasure.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
-#include "include/core/SkPathMeasure.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTPin.h"
+#include "src/core/SkContourMeasureCache.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/effects/SkTrimPE.h"
@@ -30,22 +31,20 @@ struct SkRect;
 namespace {
 
 // Returns the number of contours iterated to satisfy the request.
-static size_t add_segments(const SkPath& src, SkScalar start, SkScalar stop, SkPath* dst,
-                           bool requires_moveto = true) {
+static size_t add_segments(const SkMeasuredPath& measured, SkScalar start, SkScalar stop,
+                           SkPath* dst, bool requires_moveto = true) {
     SkASSERT(start < stop);
 
-    SkPathMeasure measure(src, false);
-
     SkScalar current_segment_offset = 0;
     size_t            contour_count = 1;
 
-    do {
-        const auto next_offset = current_segment_offset + measure.getLength();
+    for (const sk_sp<SkContourMeasure>& contour : measured) {
+        const auto next_offset = current_segment_offset + contour->length();
 
         if (start < next_offset) {
-            measure.getSegment(start - current_segment_offset,
-                               stop  - current_segment_offset,
-                               dst, requires_moveto);
+            (void)contour->getSegment(start - current_segment_offset,
+                                      stop  - current_segment_offset,
+                                      dst, requires_moveto);
 
             if (stop <= next_offset)
                 break;
@@ -53,7 +52,7 @@ static size_t add_segments(const SkPath& src, SkScalar start, SkScalar stop, SkP
 
         contour_count++;
         current_segment_offset = next_offset;
-    } while (measure.nextContour());
+    }
 
     return contour_count;
 }
@@ -70,12 +69,10 @@ bool SkTrimPE::onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec*, const
         return true;
     }
 
-    // First pass: compute the total len.
-    SkScalar len = 0;
-    SkPathMeasure meas(src, false);
-    do {
-        len += meas.getLength();
-    } while (meas.nextContour());
+    // First pass: compute the total len. The contours are measured once and shared by every trim
+    // of the same path, as in an animated trim.
+    const sk_sp<const SkMeasuredPath> measured = SkMeasuredPath::Make(src, false);
+    const SkScalar len = measured->length();
 
     const auto arcStart = len * fStartT,
                arcStop  = len * fStopT;
@@ -84,7 +81,7 @@ bool SkTrimPE::onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec*, const
     if (fMode == SkTrimPathEffect::Mode::kNormal) {
         // Normal mode -> one span.
         if (arcStart < arcStop) {
-            add_segments(src, arcStart, arcStop, dst);
+            add_segments(*measured, arcStart, arcStop, dst);
         }
     } else {
         // Inverted mode -> one logical span which wraps around at the end -> two actual spans.
@@ -97,7 +94,7 @@ bool SkTrimPE::onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec*, const
         bool requires_moveto = true;
         if (arcStop < len) {
             // since we're adding the "tail" first, this is the total number of contours
-            const auto contour_count = add_segments(src, arcStop, len, dst);
+            const auto contour_count = add_segments(*measured, arcStop, len, dst);
 
             // if the path consists of a single closed contour, we don't want to disconnect
             // the two parts with a moveto.
@@ -106,7 +103,7 @@ bool SkTrimPE::onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec*, const
             }
         }
         if (0 <  arcStart) {
-            add_segments(src, 0, arcStart, dst, requires_moveto);
+            add_segments(*measured, 0, arcStart, dst, requires_moveto);
         }
     }
 
@@ -19,6 +19,7 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
@@ -28,12 +29,14 @@
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <optional>
 #include <utility>
 
@@ -833,9 +836,35 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
     }
     dst.eraseColor(SK_ColorTRANSPARENT);
 
-    auto buffer = alloc.makeBytesAlignedTo(std::max(makerX->bufferSizeBytes(),
-                                                    makerY->bufferSizeBytes()),
-                                           alignof(skvx::Vec<4, uint32_t>));
+    // Every row of the X pass, and every column of the Y pass, is blurred independently. Large
+    // passes are split into bands of lines that are blurred in parallel on the default SkExecutor.
+    // Each band gets its own Pass and buffer, made up front since the arena isn't thread safe.
+    auto blurInBands = [&alloc](const PassMaker* maker, int lineCount, int lineLength,
+                                const std::function<void(Pass*, int, int)>& blurLines) {
+        constexpr int kMinPixelsPerBand = 64 * 1024;
+        // Keep bands a multiple of 16 lines, so column bands never share a cache line.
+        const int linesPerBand =
+                SkToInt(SkAlignTo(std::max(1, kMinPixelsPerBand / std::max(1, lineLength)), 16));
+        const int bandCount = std::max(1, (lineCount + linesPerBand - 1) / linesPerBand);
+
+        Pass** passes = alloc.makeArrayDefault<Pass*>(bandCount);
+        for (int i = 0; i < bandCount; ++i) {
+            void* buffer = alloc.makeBytesAlignedTo(maker->bufferSizeBytes(),
+                                                    alignof(skvx::Vec<4, uint32_t>));
+            passes[i] = maker->makePass(buffer, &alloc);
+        }
+
+        auto blurBand = [&](int i) {
+            blurLines(passes[i], i * linesPerBand, std::min((i + 1) * linesPerBand, lineCount));
+        };
+        if (bandCount > 1) {
+            SkTaskGroup bands;
+            bands.batch(bandCount, blurBand);
+            bands.wait();
+        } else {
+            blurBand(0);
+        }
+    };
 
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
@@ -854,20 +883,21 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
         loopStart = std::max(srcBounds.top(),    dstBounds.top());
         loopEnd   = std::min(srcBounds.bottom(), dstBounds.bottom());
 
-        auto srcAddr = src.getAddr32(0, loopStart - srcBounds.top());
-        auto dstAddr = dst.getAddr32(0, loopStart - dstBounds.top());
-
         // Iterate over each row to calculate 1D blur along X.
-        Pass* pass = makerX->makePass(buffer, &alloc);
-        for (int y = loopStart; y < loopEnd; ++y) {
-            pass->blur(srcBounds.left()  - dstBounds.left(),
-                       srcBounds.right() - dstBounds.left(),
-                       dstBounds.width(),
-                       srcAddr, 1,
-                       dstAddr, 1);
-            srcAddr += src.rowBytesAsPixels();
-            dstAddr += dst.rowBytesAsPixels();
-        }
+        blurInBands(makerX, loopEnd - loopStart, dstBounds.width(),
+                    [&](Pass* pass, int start, int end) {
+            auto srcAddr = src.getAddr32(0, loopStart + start - srcBounds.top());
+            auto dstAddr = dst.getAddr32(0, loopStart + start - dstBounds.top());
+            for (int y = start; y < end; ++y) {
+                pass->blur(srcBounds.left()  - dstBounds.left(),
+                           srcBounds.right() - dstBounds.left(),
+                           dstBounds.width(),
+                           srcAddr, 1,
+                           dstAddr, 1);
+                srcAddr += src.rowBytesAsPixels();
+                dstAddr += dst.rowBytesAsPixels();
+            }
+        });
 
         // Set up the Y pass to blur from the full dst into the non-outset portion of dst
         src = dst;
@@ -885,19 +915,20 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
     // Iterate over each column to calculate 1D blur along Y. This is either blurring from src into
     // dst for a 1D blur; or it's blurring from dst into dst for the second pass of a 2D blur.
     if (makerY->window() > 1) {
-        auto srcAddr = src.getAddr32(loopStart - srcBounds.left(), 0);
-        auto dstAddr = dst.getAddr32(loopStart - dstBounds.left(), dstYOffset);
-
-        Pass* pass = makerY->makePass(buffer, &alloc);
-        for (int x = loopStart; x < loopEnd; ++x) {
-            pass->blur(srcBounds.top()    - dstBounds.top(),
-                       srcBounds.bottom() - dstBounds.top(),
-                       dstBounds.height(),
-                       srcAddr, src.rowBytesAsPixels(),
-                       dstAddr, dst.rowBytesAsPixels());
-            srcAddr += 1;
-            dstAddr += 1;
-        }
+        blurInBands(makerY, loopEnd - loopStart, dstBounds.height(),
+                    [&](Pass* pass, int start, int end) {
+            auto srcAddr = src.getAddr32(loopStart + start - srcBounds.left(), 0);
+            auto dstAddr = dst.getAddr32(loopStart + start - dstBounds.left(), dstYOffset);
+            for (int x = start; x < end; ++x) {
+                pass->blur(srcBounds.top()    - dstBounds.top(),
+                           srcBounds.bottom() - dstBounds.top(),
+                           dstBounds.height(),
+                           srcAddr, src.rowBytesAsPixels(),
+                           dstAddr, dst.rowBytesAsPixels());
+                srcAddr += 1;
+                dstAddr += 1;
+            }
+        });
     }
 
     originalDstBounds.offset(-dstOrigin); // Make relative to dst's pixels
@@ -11,9 +11,12 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
@@ -25,16 +28,20 @@
 #include "src/base/SkMSAN.h"
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/encode/SkJPEGWriteUtility.h"
 #include "src/image/SkImage_Base.h"
 
+#include <algorithm>
 #include <csetjmp>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 class GrDirectContext;
 class SkColorSpace;
@@ -56,10 +63,16 @@ public:
 
     bool initializeRGB(const SkImageInfo&,
                        const SkJpegEncoder::Options&,
-                       const SkJpegMetadataEncoder::SegmentList&);
+                       const SkJpegMetadataEncoder::SegmentList&,
+                       int restartInterval);
     bool initializeYUV(const SkYUVAPixmapInfo&,
                        const SkJpegEncoder::Options&,
-                       const SkJpegMetadataEncoder::SegmentList&);
+                       const SkJpegMetadataEncoder::SegmentList&,
+                       int restartInterval);
+
+    // Writes the rows of |src| up to |endRow| that fill whole iMCU rows, or all of the remaining
+    // rows if |endRow| is the last row.
+    void writeYUVRows(const SkYUVAPixmaps& src, int endRow);
 
     jpeg_compress_struct* cinfo() { return &fCInfo; }
 
@@ -76,17 +89,27 @@ private:
         jpeg_create_compress(&fCInfo);
         fCInfo.dest = &fDstMgr;
     }
-    void initializeCommon(const SkJpegEncoder::Options&, const SkJpegMetadataEncoder::SegmentList&);
+    void initializeCommon(const SkJpegEncoder::Options&,
+                          const SkJpegMetadataEncoder::SegmentList&,
+                          int restartInterval);
 
     jpeg_compress_struct fCInfo;
     skjpeg_error_mgr fErrMgr;
     skjpeg_destination_mgr fDstMgr;
     transform_scanline_proc fProc;
+
+    // For YUV sources, the rows of one iMCU row of each component, which are passed to
+    // jpeg_write_raw_data() padded to whole blocks.
+    skia_private::AutoTMalloc<JSAMPLE> fRawStorage;
+    skia_private::AutoTMalloc<JSAMPROW> fRawRows;
+    JSAMPARRAY fRawPlanes[3] = {};
+    int fRawRowsWritten = 0;
 };
 
 bool SkJpegEncoderMgr::initializeRGB(const SkImageInfo& srcInfo,
                                      const SkJpegEncoder::Options& options,
-                                     const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+                                     const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+                                     int restartInterval) {
     auto chooseProc8888 = [&]() {
         if (kUnpremul_SkAlphaType == srcInfo.alphaType() &&
             options.fAlphaOption == SkJpegEncoder::AlphaOption::kBlendOnBlack) {
@@ -177,50 +200,14 @@ bool SkJpegEncoderMgr::initializeRGB(const SkImageInfo& srcInfo,
         }
     }
 
-    initializeCommon(options, metadataSegments);
+    initializeCommon(options, metadataSegments, restartInterval);
     return true;
 }
 
-// Convert a row of an SkYUVAPixmaps to a row of Y,U,V triples.
-// TODO(ccameron): This is horribly inefficient.
-static void yuva_copy_row(const SkYUVAPixmaps& src, int row, uint8_t* dst) {
-    int width = src.plane(0).width();
-    switch (src.yuvaInfo().planeConfig()) {
-        case SkYUVAInfo::PlaneConfig::kY_U_V: {
-            auto [ssWidthU, ssHeightU] = src.yuvaInfo().planeSubsamplingFactors(1);
-            auto [ssWidthV, ssHeightV] = src.yuvaInfo().planeSubsamplingFactors(2);
-            const uint8_t* srcY = reinterpret_cast<const uint8_t*>(src.plane(0).addr(0, row));
-            const uint8_t* srcU =
-                    reinterpret_cast<const uint8_t*>(src.plane(1).addr(0, row / ssHeightU));
-            const uint8_t* srcV =
-                    reinterpret_cast<const uint8_t*>(src.plane(2).addr(0, row / ssHeightV));
-            for (int col = 0; col < width; ++col) {
-                dst[3 * col + 0] = srcY[col];
-                dst[3 * col + 1] = srcU[col / ssWidthU];
-                dst[3 * col + 2] = srcV[col / ssWidthV];
-            }
-            break;
-        }
-        case SkYUVAInfo::PlaneConfig::kY_UV: {
-            auto [ssWidthUV, ssHeightUV] = src.yuvaInfo().planeSubsamplingFactors(1);
-            const uint8_t* srcY = reinterpret_cast<const uint8_t*>(src.plane(0).addr(0, row));
-            const uint8_t* srcUV =
-                    reinterpret_cast<const uint8_t*>(src.plane(1).addr(0, row / ssHeightUV));
-            for (int col = 0; col < width; ++col) {
-                dst[3 * col + 0] = srcY[col];
-                dst[3 * col + 1] = srcUV[2 * (col / ssWidthUV) + 0];
-                dst[3 * col + 2] = srcUV[2 * (col / ssWidthUV) + 1];
-            }
-            break;
-        }
-        default:
-            break;
-    }
-}
-
 bool SkJpegEncoderMgr::initializeYUV(const SkYUVAPixmapInfo& srcInfo,
                                      const SkJpegEncoder::Options& options,
-                                     const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+                                     const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+                                     int restartInterval) {
     fCInfo.image_width = srcInfo.yuvaInfo().width();
     fCInfo.image_height = srcInfo.yuvaInfo().height();
     fCInfo.in_color_space = JCS_YCbCr;
@@ -241,7 +228,7 @@ bool SkJpegEncoderMgr::initializeYUV(const SkYUVAPixmapInfo& srcInfo,
     }
 
     // Support only Y,U,V and Y,UV configurations (they are the only ones supported by
-    // yuva_copy_row).
+    // writeYUVRows).
     switch (srcInfo.yuvaInfo().planeConfig()) {
         case SkYUVAInfo::PlaneConfig::kY_U_V:
         case SkYUVAInfo::PlaneConfig::kY_UV:
@@ -256,17 +243,87 @@ bool SkJpegEncoderMgr::initializeYUV(const SkYUVAPixmapInfo& srcInfo,
     fCInfo.comp_info[0].h_samp_factor = ssHoriz;
     fCInfo.comp_info[0].v_samp_factor = ssVert;
 
-    initializeCommon(options, metadataSegments);
+    // The planes are already downsampled, so pass them to libjpeg as they are, rather than
+    // upsampling the chroma to interleave it with Y only for libjpeg to downsample it again.
+    fCInfo.raw_data_in = TRUE;
+
+    initializeCommon(options, metadataSegments, restartInterval);
+
+    size_t storageSize = 0;
+    size_t rowCount = 0;
+    for (int i = 0; i < 3; ++i) {
+        const jpeg_component_info& component = fCInfo.comp_info[i];
+        storageSize += component.v_samp_factor * DCTSIZE * component.width_in_blocks * DCTSIZE;
+        rowCount += component.v_samp_factor * DCTSIZE;
+    }
+    fRawStorage.reset(storageSize);
+    fRawRows.reset(rowCount);
+    JSAMPLE* storage = fRawStorage.get();
+    JSAMPROW* rows = fRawRows.get();
+    for (int i = 0; i < 3; ++i) {
+        const jpeg_component_info& component = fCInfo.comp_info[i];
+        fRawPlanes[i] = rows;
+        for (int y = 0; y < component.v_samp_factor * DCTSIZE; ++y) {
+            *rows++ = storage;
+            storage += component.width_in_blocks * DCTSIZE;
+        }
+    }
     return true;
 }
 
+void SkJpegEncoderMgr::writeYUVRows(const SkYUVAPixmaps& src, int endRow) {
+    const int height = src.yuvaInfo().height();
+    const int groupRows = fCInfo.max_v_samp_factor * DCTSIZE;
+    while (fRawRowsWritten < height &&
+           (fRawRowsWritten + groupRows <= endRow || endRow == height)) {
+        for (int i = 0; i < 3; ++i) {
+            const jpeg_component_info& component = fCInfo.comp_info[i];
+            // U and V are either planes of their own or interleaved in one plane.
+            const bool interleaved =
+                    i > 0 && src.yuvaInfo().planeConfig() == SkYUVAInfo::PlaneConfig::kY_UV;
+            const SkPixmap& plane = src.plane(interleaved ? 1 : i);
+            const int step = interleaved ? 2 : 1;
+            const int offset = interleaved ? i - 1 : 0;
+            const int rows = component.v_samp_factor * DCTSIZE;
+            const int top = fRawRowsWritten / groupRows * rows;
+            const int width = component.width_in_blocks * DCTSIZE;
+            const int srcWidth = std::min(plane.width(), width);
+
+            // Pad the rows to whole blocks by repeating the last column and row, as libjpeg does
+            // for scanlines.
+            for (int y = 0; y < rows; ++y) {
+                const uint8_t* srcRow = static_cast<const uint8_t*>(
+                        plane.addr(0, std::min(top + y, plane.height() - 1)));
+                JSAMPLE* dstRow = fRawPlanes[i][y];
+                if (step == 1) {
+                    memcpy(dstRow, srcRow, srcWidth);
+                } else {
+                    for (int x = 0; x < srcWidth; ++x) {
+                        dstRow[x] = srcRow[step * x + offset];
+                    }
+                }
+                memset(dstRow + srcWidth, dstRow[srcWidth - 1], width - srcWidth);
+            }
+        }
+        jpeg_write_raw_data(&fCInfo, fRawPlanes, groupRows);
+        fRawRowsWritten += groupRows;
+    }
+}
+
 void SkJpegEncoderMgr::initializeCommon(
         const SkJpegEncoder::Options& options,
-        const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
-    // Tells libjpeg-turbo to compute optimal Huffman coding tables
-    // for the image.  This improves compression at the cost of
-    // slower encode performance.
-    fCInfo.optimize_coding = TRUE;
+        const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+        int restartInterval) {
+    if (restartInterval) {
+        // The strips of a parallel encode must share their Huffman tables, so they use the
+        // standard ones.
+        fCInfo.restart_interval = restartInterval;
+    } else {
+        // Tells libjpeg-turbo to compute optimal Huffman coding tables
+        // for the image.  This improves compression at the cost of
+        // slower encode performance.
+        fCInfo.optimize_coding = TRUE;
+    }
 
     jpeg_set_quality(&fCInfo, options.fQuality, TRUE);
     jpeg_start_compress(&fCInfo, TRUE);
@@ -284,7 +341,8 @@ std::unique_ptr<SkEncoder> SkJpegEncoderImpl::MakeYUV(
         const SkYUVAPixmaps& srcYUVA,
         const SkColorSpace* srcYUVAColorSpace,
         const SkJpegEncoder::Options& options,
-        const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+        const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+        int restartInterval) {
     if (!srcYUVA.isValid()) {
         return nullptr;
     }
@@ -294,7 +352,8 @@ std::unique_ptr<SkEncoder> SkJpegEncoderImpl::MakeYUV(
         return nullptr;
     }
 
-    if (!encoderMgr->initializeYUV(srcYUVA.pixmapsInfo(), options, metadataSegments)) {
+    if (!encoderMgr->initializeYUV(
+                srcYUVA.pixmapsInfo(), options, metadataSegments, restartInterval)) {
         return nullptr;
     }
     return std::unique_ptr<SkJpegEncoderImpl>(
@@ -305,7 +364,8 @@ std::unique_ptr<SkEncoder> SkJpegEncoderImpl::MakeRGB(
         SkWStream* dst,
         const SkPixmap& src,
         const SkJpegEncoder::Options& options,
-        const SkJpegMetadataEncoder::SegmentList& metadataSegments) {
+        const SkJpegMetadataEncoder::SegmentList& metadataSegments,
+        int restartInterval) {
     if (!SkPixmapIsValid(src)) {
         return nullptr;
     }
@@ -315,7 +375,7 @@ std::unique_ptr<SkEncoder> SkJpegEncoderImpl::MakeRGB(
         return nullptr;
     }
 
-    if (!encoderMgr->initializeRGB(src.info(), options, metadataSegments)) {
+    if (!encoderMgr->initializeRGB(src.info(), options, metadataSegments, restartInterval)) {
         return nullptr;
     }
     return std::unique_ptr<SkJpegEncoderImpl>(new SkJpegEncoderImpl(std::move(encoderMgr), src));
@@ -329,7 +389,7 @@ SkJpegEncoderImpl::SkJpegEncoderImpl(std::unique_ptr<SkJpegEncoderMgr> encoderMg
 
 SkJpegEncoderImpl::SkJpegEncoderImpl(std::unique_ptr<SkJpegEncoderMgr> encoderMgr,
                                      const SkYUVAPixmaps& src)
-        : SkEncoder(src.plane(0), encoderMgr->cinfo()->input_components * src.yuvaInfo().width())
+        : SkEncoder(src.plane(0), 0)
         , fEncoderMgr(std::move(encoderMgr))
         , fSrcYUVA(src) {}
 
@@ -342,12 +402,9 @@ bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
     }
 
     if (fSrcYUVA) {
-        // TODO(ccameron): Consider using jpeg_write_raw_data, to avoid having to re-pack the data.
-        for (int i = 0; i < numRows; i++) {
-            yuva_copy_row(*fSrcYUVA, fCurrRow + i, fStorage.get());
-            JSAMPLE* jpegSrcRow = fStorage.get();
-            jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-        }
+        // Raw data is written in whole iMCU rows, so rows at the end of this call that don't fill
+        // one are written by the next call.
+        fEncoderMgr->writeYUVRows(*fSrcYUVA, fCurrRow + numRows);
     } else {
         const size_t srcBytes = SkColorTypeBytesPerPixel(fSrc.colorType()) * fSrc.width();
         const size_t jpegSrcBytes = fEncoderMgr->cinfo()->input_components * fSrc.width();
@@ -383,9 +440,170 @@ bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
     return true;
 }
 
+// Each strip of a parallel encode pays for a compress struct and headers of its own. Strips smaller
+// than this would spend more time on that than they save.
+static constexpr int kMinStripRows = 256;
+
+// The restart interval is stored in 16 bits.
+static constexpr int kMaxRestartInterval = 0xFFFF;
+
+// Makes an encoder for |rows| rows starting at |top|, which has a restart marker every
+// |restartInterval| MCUs.
+using MakeStripProc = std::function<std::unique_ptr<SkEncoder>(
+        SkWStream*, int top, int rows, int restartInterval)>;
+
+// Encodes strips of whole MCU rows in parallel, each as a JPEG of its own whose entropy-coded data
+// is a single restart interval. Returns nothing if the image is too small or too wide to split, or
+// any strip fails.
+static std::vector<sk_sp<SkData>> encode_strips(SkISize dimensions,
+                                                SkISize mcuSize,
+                                                SkExecutor& executor,
+                                                const MakeStripProc& makeStrip) {
+    const int mcusPerRow = (dimensions.width() + mcuSize.width() - 1) / mcuSize.width();
+    const int stripMCURows = std::min((kMinStripRows + mcuSize.height() - 1) / mcuSize.height(),
+                                      kMaxRestartInterval / mcusPerRow);
+    if (stripMCURows < 1) {
+        return {};
+    }
+    const int stripRows = stripMCURows * mcuSize.height();
+    const int stripCount = (dimensions.height() + stripRows - 1) / stripRows;
+    if (stripCount < 2) {
+        return {};
+    }
+
+    std::vector<sk_sp<SkData>> strips(stripCount);
+    SkTaskGroup taskGroup(executor);
+    taskGroup.batch(stripCount, [&](int i) {
+        const int top = i * stripRows;
+        const int rows = std::min(stripRows, dimensions.height() - top);
+        SkDynamicMemoryWStream stream;
+        std::unique_ptr<SkEncoder> encoder =
+                makeStrip(&stream, top, rows, stripMCURows * mcusPerRow);
+        if (encoder && encoder->encodeRows(rows)) {
+            strips[i] = stream.detachAsData();
+        }
+    });
+    taskGroup.wait();
+    for (const sk_sp<SkData>& strip : strips) {
+        if (!strip) {
+            return {};
+        }
+    }
+    return strips;
+}
+
+// Finds the image height in the start of frame segment of a JPEG written by libjpeg, and the
+// start of its entropy-coded data, which runs up to the end of image marker.
+static bool find_scan(const SkData& jpeg, size_t* heightOffset, size_t* scanOffset) {
+    const uint8_t* data = jpeg.bytes();
+    const size_t size = jpeg.size();
+    if (size < 2 * kJpegMarkerCodeSize || data[size - 2] != 0xFF ||
+        data[size - 1] != kJpegMarkerEndOfImage) {
+        return false;
+    }
+    *heightOffset = 0;
+    size_t offset = kJpegMarkerCodeSize;
+    while (offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize <= size) {
+        if (data[offset] != 0xFF) {
+            return false;
+        }
+        const uint8_t marker = data[offset + 1];
+        const size_t length = (data[offset + 2] << 8) | data[offset + 3];
+        const size_t end = offset + kJpegMarkerCodeSize + length;
+        if (end > size - kJpegMarkerCodeSize) {
+            return false;
+        }
+        if (marker == 0xC0 || marker == 0xC1) {
+            // P, then Y.
+            *heightOffset = offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize + 1;
+        } else if (marker == kJpegMarkerStartOfScan) {
+            *scanOffset = end;
+            return *heightOffset != 0;
+        }
+        offset = end;
+    }
+    return false;
+}
+
+// Writes the headers of the first strip, with the height of the whole image, followed by the
+// entropy-coded data of each strip, separated by restart markers.
+static bool write_strips(SkWStream* dst, const std::vector<sk_sp<SkData>>& strips, int height) {
+    size_t heightOffset = 0;
+    size_t scanOffset = 0;
+    if (!find_scan(*strips[0], &heightOffset, &scanOffset)) {
+        return false;
+    }
+    const uint8_t heightBytes[] = {static_cast<uint8_t>(height >> 8),
+                                   static_cast<uint8_t>(height)};
+    bool success = dst->write(strips[0]->bytes(), heightOffset) &&
+                   dst->write(heightBytes, sizeof(heightBytes)) &&
+                   dst->write(strips[0]->bytes() + heightOffset + sizeof(heightBytes),
+                              scanOffset - heightOffset - sizeof(heightBytes));
+    for (size_t i = 0; i < strips.size() && success; ++i) {
+        size_t stripHeightOffset;
+        if (i > 0 && !find_scan(*strips[i], &stripHeightOffset, &scanOffset)) {
+            return false;
+        }
+        const uint8_t marker[] = {
+                0xFF,
+                static_cast<uint8_t>(i + 1 < strips.size() ? 0xD0 + (i & 7)
+                                                           : kJpegMarkerEndOfImage)};
+        success = dst->write(strips[i]->bytes() + scanOffset,
+                             strips[i]->size() - scanOffset - kJpegMarkerCodeSize) &&
+                  dst->write(marker, sizeof(marker));
+    }
+    return success;
+}
+
+static SkISize mcu_size(const SkImageInfo& info, const SkJpegEncoder::Options& options) {
+    switch (info.colorType()) {
+        case kGray_8_SkColorType:
+        case kAlpha_8_SkColorType:
+        case kR8_unorm_SkColorType:
+            return {DCTSIZE, DCTSIZE};
+        default:
+            break;
+    }
+    switch (options.fDownsample) {
+        case SkJpegEncoder::Downsample::k420:
+            return {2 * DCTSIZE, 2 * DCTSIZE};
+        case SkJpegEncoder::Downsample::k422:
+            return {2 * DCTSIZE, DCTSIZE};
+        case SkJpegEncoder::Downsample::k444:
+            return {DCTSIZE, DCTSIZE};
+    }
+    SkUNREACHABLE;
+}
+
+static SkJpegMetadataEncoder::SegmentList metadata_segments(const SkJpegEncoder::Options& options,
+                                                            const SkColorSpace* colorSpace) {
+    SkJpegMetadataEncoder::SegmentList metadataSegments;
+    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
+    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, colorSpace);
+    return metadataSegments;
+}
+
 namespace SkJpegEncoder {
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
+    if (options.fExecutor && SkPixmapIsValid(src)) {
+        const SkJpegMetadataEncoder::SegmentList metadataSegments =
+                metadata_segments(options, src.colorSpace());
+        std::vector<sk_sp<SkData>> strips = encode_strips(
+                src.dimensions(), mcu_size(src.info(), options), *options.fExecutor,
+                [&](SkWStream* stream, int top, int rows, int restartInterval) {
+                    SkPixmap strip;
+                    SkAssertResult(src.extractSubset(
+                            &strip, SkIRect::MakeXYWH(0, top, src.width(), rows)));
+                    return SkJpegEncoderImpl::MakeRGB(
+                            stream, strip, options,
+                            top == 0 ? metadataSegments : SkJpegMetadataEncoder::SegmentList(),
+                            restartInterval);
+                });
+        if (!strips.empty()) {
+            return write_strips(dst, strips, src.height());
+        }
+    }
     auto encoder = Make(dst, src, options);
     return encoder.get() && encoder->encodeRows(src.height());
 }
@@ -394,6 +612,36 @@ bool Encode(SkWStream* dst,
             const SkYUVAPixmaps& src,
             const SkColorSpace* srcColorSpace,
             const Options& options) {
+    // Strips of the planes are only whole rows of the image when it isn't rotated.
+    if (options.fExecutor && src.isValid() && src.yuvaInfo().origin() == kTopLeft_SkEncodedOrigin) {
+        const SkJpegMetadataEncoder::SegmentList metadataSegments =
+                metadata_segments(options, srcColorSpace);
+        const SkYUVAInfo& yuvaInfo = src.yuvaInfo();
+        auto [ssHoriz, ssVert] = SkYUVAInfo::SubsamplingFactors(yuvaInfo.subsampling());
+        std::vector<sk_sp<SkData>> strips = encode_strips(
+                yuvaInfo.dimensions(), {ssHoriz * DCTSIZE, ssVert * DCTSIZE}, *options.fExecutor,
+                [&](SkWStream* stream, int top, int rows, int restartInterval) {
+                    const SkYUVAInfo stripInfo =
+                            yuvaInfo.makeDimensions({yuvaInfo.width(), rows});
+                    SkISize planeDimensions[SkYUVAInfo::kMaxPlanes];
+                    const int planeCount = stripInfo.planeDimensions(planeDimensions);
+                    SkPixmap planes[SkYUVAInfo::kMaxPlanes];
+                    for (int i = 0; i < planeCount; ++i) {
+                        auto [planeSSHoriz, planeSSVert] = stripInfo.planeSubsamplingFactors(i);
+                        SkAssertResult(src.plane(i).extractSubset(
+                                &planes[i],
+                                SkIRect::MakePtSize({0, top / planeSSVert}, planeDimensions[i])));
+                    }
+                    return SkJpegEncoderImpl::MakeYUV(
+                            stream, SkYUVAPixmaps::FromExternalPixmaps(stripInfo, planes),
+                            srcColorSpace, options,
+                            top == 0 ? metadataSegments : SkJpegMetadataEncoder::SegmentList(),
+                            restartInterval);
+                });
+        if (!strips.empty()) {
+            return write_strips(dst, strips, yuvaInfo.height());
+        }
+    }
     auto encoder = Make(dst, src, srcColorSpace, options);
     return encoder.get() && encoder->encodeRows(src.yuvaInfo().height());
 }
@@ -414,20 +662,16 @@ sk_sp<SkData> Encode(GrDirectContext* ctx, const SkImage* img, const Options& op
 }
 
 std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Options& options) {
-    SkJpegMetadataEncoder::SegmentList metadataSegments;
-    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
-    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, src.colorSpace());
-    return SkJpegEncoderImpl::MakeRGB(dst, src, options, metadataSegments);
+    return SkJpegEncoderImpl::MakeRGB(dst, src, options,
+                                      metadata_segments(options, src.colorSpace()));
 }
 
 std::unique_ptr<SkEncoder> Make(SkWStream* dst,
                                 const SkYUVAPixmaps& src,
                                 const SkColorSpace* srcColorSpace,
                                 const Options& options) {
-    SkJpegMetadataEncoder::SegmentList metadataSegments;
-    SkJpegMetadataEncoder::AppendXMPStandard(metadataSegments, options.xmpMetadata);
-    SkJpegMetadataEncoder::AppendICC(metadataSegments, options, srcColorSpace);
-    return SkJpegEncoderImpl::MakeYUV(dst, src, srcColorSpace, options, metadataSegments);
+    return SkJpegEncoderImpl::MakeYUV(dst, src, srcColorSpace, options,
+                                      metadata_segments(options, srcColorSpace));
 }
 
 }  // namespace SkJpegEncoder
@@ -59,15 +59,21 @@ public:
     // Make an encoder from RGB or YUV data. Encoding options are specified in |options|. Metadata
     // markers are listed in |metadata|. The ICC profile and XMP metadata are read from |metadata|
     // and not from |options|.
+    //
+    // If |restartInterval| is not zero, the image has a restart marker every that many MCUs and
+    // uses the standard Huffman tables, so that the entropy-coded data of images encoded with the
+    // same options can be joined.
     static std::unique_ptr<SkEncoder> MakeRGB(SkWStream* dst,
                                               const SkPixmap& src,
                                               const SkJpegEncoder::Options& options,
-                                              const SkJpegMetadataEncoder::SegmentList& metadata);
+                                              const SkJpegMetadataEncoder::SegmentList& metadata,
+                                              int restartInterval = 0);
     static std::unique_ptr<SkEncoder> MakeYUV(SkWStream* dst,
                                               const SkYUVAPixmaps& srcYUVA,
                                               const SkColorSpace* srcYUVAColorSpace,
                                               const SkJpegEncoder::Options& options,
-                                              const SkJpegMetadataEncoder::SegmentList& metadata);
+                                              const SkJpegMetadataEncoder::SegmentList& metadata,
+                                              int restartInterval = 0);
 
     ~SkJpegEncoderImpl() override;
 
@@ -13,6 +13,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -23,10 +24,13 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkNoncopyable.h"
+#include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/base/SkMSAN.h"
 #include "src/codec/SkPngPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/image/SkImage_Base.h"
@@ -34,14 +38,18 @@
 #include <algorithm>
 #include <csetjmp>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <utility>
 #include <vector>
 
 #include <png.h>
 #include <pngconf.h>
 
+#include "zlib.h"  // NO_G3_REWRITE
+
 class GrDirectContext;
 class SkImage;
 
@@ -86,6 +94,8 @@ public:
     png_infop infoPtr() { return fInfoPtr; }
     int pngBytesPerPixel() const { return fPngBytesPerPixel; }
     transform_scanline_proc proc() const { return fProc; }
+    int filters() const { return fFilters; }
+    int zlibLevel() const { return fZLibLevel; }
 
     ~SkPngEncoderMgr() { png_destroy_write_struct(&fPngPtr, &fInfoPtr); }
 
@@ -96,6 +106,8 @@ private:
     png_infop fInfoPtr;
     int fPngBytesPerPixel;
     transform_scanline_proc fProc;
+    int fFilters = PNG_ALL_FILTERS;
+    int fZLibLevel = 6;
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -229,10 +241,12 @@ bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::
     int filters = (int)options.fFilterFlags & (int)SkPngEncoder::FilterFlag::kAll;
     SkASSERT(filters == (int)options.fFilterFlags);
     png_set_filter(fPngPtr, PNG_FILTER_TYPE_BASE, filters);
+    fFilters = filters;
 
     int zlibLevel = std::min(std::max(0, options.fZLibLevel), 9);
     SkASSERT(zlibLevel == options.fZLibLevel);
     png_set_compression_level(fPngPtr, zlibLevel);
+    fZLibLevel = zlibLevel;
 
     // Set comments in tEXt chunk
     const sk_sp<SkDataTable>& comments = options.fComments;
@@ -477,6 +491,231 @@ bool SkPngEncoderImpl::onEncodeRows(int numRows) {
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// The PNG filter types (as opposed to the PNG_FILTER_* flags), from section 9.2 of the spec.
+enum PngFilterType : uint8_t { kNone = 0, kSub = 1, kUp = 2, kAvg = 3, kPaeth = 4 };
+
+uint8_t paeth_predictor(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+// Filters one row; prev is the previous unfiltered row (all zeros for the first row).
+void filter_row(PngFilterType type, const uint8_t* row, const uint8_t* prev, size_t len, int bpp,
+                uint8_t* dst) {
+    for (size_t i = 0; i < len; ++i) {
+        int a = i >= (size_t)bpp ? row[i - bpp]  : 0,
+            b = prev[i],
+            c = i >= (size_t)bpp ? prev[i - bpp] : 0;
+        switch (type) {
+            case kNone:  dst[i] = row[i];                              break;
+            case kSub:   dst[i] = row[i] - a;                          break;
+            case kUp:    dst[i] = row[i] - b;                          break;
+            case kAvg:   dst[i] = row[i] - ((a + b) >> 1);             break;
+            case kPaeth: dst[i] = row[i] - paeth_predictor(a, b, c);   break;
+        }
+    }
+}
+
+// libpng's heuristic for choosing between filters: the sum of the filtered bytes, each treated
+// as a signed value.
+uint64_t filter_cost(const uint8_t* filtered, size_t len) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < len; ++i) {
+        sum += std::abs((int)(int8_t)filtered[i]);
+    }
+    return sum;
+}
+
+// Different zlib implementations use different T.
+template <typename T> void* png_zlib_alloc(void*, T items, T size) {
+    return sk_calloc_throw(SkToSizeT(items) * SkToSizeT(size));
+}
+void png_zlib_free(void*, void* address) { sk_free(address); }
+
+// Compresses one band as raw deflate data, primed with the band's preceding bytes. Every band
+// but the last ends with a sync flush so the bands can be concatenated into one zlib stream.
+bool deflate_band(const uint8_t* src, size_t size, const uint8_t* dictionary,
+                  size_t dictionarySize, bool last, int level, SkDynamicMemoryWStream* out) {
+    z_stream zStream;
+    zStream.zalloc = &png_zlib_alloc;
+    zStream.zfree = &png_zlib_free;
+    zStream.opaque = nullptr;
+    zStream.next_in = nullptr;
+    zStream.avail_in = 0;
+    if (Z_OK != deflateInit2(&zStream, level, Z_DEFLATED, -15, 8, Z_FILTERED)) {
+        return false;
+    }
+    bool ok = dictionarySize == 0 ||
+              Z_OK == deflateSetDictionary(&zStream, dictionary, SkToUInt(dictionarySize));
+    zStream.next_in = const_cast<uint8_t*>(src);
+    zStream.avail_in = SkToUInt(size);
+    uint8_t buffer[16384];
+    while (ok) {
+        zStream.next_out = buffer;
+        zStream.avail_out = sizeof(buffer);
+        int r = deflate(&zStream, last ? Z_FINISH : Z_SYNC_FLUSH);
+        ok = (r == Z_OK || r == Z_STREAM_END || r == Z_BUF_ERROR) &&
+             out->write(buffer, sizeof(buffer) - zStream.avail_out);
+        if (r == Z_STREAM_END || (zStream.avail_in == 0 && zStream.avail_out != 0)) {
+            break;
+        }
+    }
+    (void)deflateEnd(&zStream);
+    return ok;
+}
+
+}  // namespace
+
+bool SkPngEncoderImpl::encodeAllRows(SkExecutor& executor) {
+    SkASSERT(fCurrRow == 0);
+    SkPngEncoderMgr* mgr = fEncoderMgr.get();
+    const int height = fSrc.height();
+    const size_t rowBytes = (size_t)mgr->pngBytesPerPixel() * fSrc.width();
+    // We filter rows exactly as we hand them to libpng. If libpng would transform them first
+    // (e.g. stripping the filler from opaque F16), let it encode them serially.
+    if (png_get_rowbytes(mgr->pngPtr(), mgr->infoPtr()) != rowBytes) {
+        return this->encodeRows(height);
+    }
+    const size_t filteredRowBytes = rowBytes + 1;  // Each row is prefixed by its filter type.
+    // Bands of about 256KB, but at least 16 rows to keep the per-band overhead low.
+    const int bandRows = std::max(16, SkToInt(std::min<size_t>(height,
+                                                               (256 << 10) / filteredRowBytes)));
+    const int bandCount = (height + bandRows - 1) / bandRows;
+
+    int filters = mgr->filters();
+    if (filters == 0) {
+        // Like libpng, treat an empty set of filters as its default.
+        filters = PNG_ALL_FILTERS;
+    }
+    if (height == 1) {
+        filters &= ~(PNG_FILTER_UP | PNG_FILTER_AVG | PNG_FILTER_PAETH);
+    }
+    if (fSrc.width() == 1) {
+        filters &= ~(PNG_FILTER_SUB | PNG_FILTER_AVG | PNG_FILTER_PAETH);
+    }
+    if (filters == 0) {
+        filters = PNG_FILTER_NONE;
+    }
+    // libpng filters on whole pixels, or bytes for images with less than a byte per pixel.
+    const int bpp = std::max(1, mgr->pngBytesPerPixel());
+
+    // Pass 1: convert and filter each band into its slice of one buffer.
+    size_t filteredSize = filteredRowBytes * height;
+    std::unique_ptr<uint8_t[]> filtered(new (std::nothrow) uint8_t[filteredSize]);
+    if (!filtered) {
+        return this->encodeRows(height);
+    }
+    auto filterBand = [&](int band) {
+        skia_private::AutoTMalloc<uint8_t> rows(3 * rowBytes);
+        uint8_t* prev = rows.get();
+        uint8_t* curr = prev + rowBytes;
+        uint8_t* scratch = curr + rowBytes;
+        int y0 = band * bandRows,
+            y1 = std::min(height, y0 + bandRows);
+        if (y0 == 0) {
+            memset(prev, 0, rowBytes);
+        } else {
+            mgr->proc()((char*)prev, (const char*)fSrc.addr(0, y0 - 1), fSrc.width(),
+                        SkColorTypeBytesPerPixel(fSrc.colorType()));
+        }
+        for (int y = y0; y < y1; ++y) {
+            const void* srcRow = fSrc.addr(0, y);
+            sk_msan_assert_initialized(srcRow, (const uint8_t*)srcRow +
+                                                       (fSrc.width() << fSrc.shiftPerPixel()));
+            mgr->proc()((char*)curr, (const char*)srcRow, fSrc.width(),
+                        SkColorTypeBytesPerPixel(fSrc.colorType()));
+
+            uint8_t* dst = filtered.get() + y * filteredRowBytes;
+            uint64_t bestCost = UINT64_MAX;
+            for (PngFilterType type : {kNone, kSub, kUp, kAvg, kPaeth}) {
+                if (!(filters & (PNG_FILTER_NONE << type))) {
+                    continue;
+                }
+                filter_row(type, curr, prev, rowBytes, bpp, scratch);
+                uint64_t cost = (filters == (PNG_FILTER_NONE << type))
+                                        ? 0 : filter_cost(scratch, rowBytes);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    dst[0] = type;
+                    memcpy(dst + 1, scratch, rowBytes);
+                }
+            }
+            std::swap(prev, curr);
+        }
+    };
+
+    // Pass 2: compress each band, primed with the 32KB of filtered data that precedes it.
+    struct Band {
+        SkDynamicMemoryWStream fCompressed;
+        uLong fAdler = 0;
+        bool fOk = false;
+    };
+    auto bands = std::make_unique<Band[]>(bandCount);
+    auto compressBand = [&](int band) {
+        size_t offset = (size_t)band * bandRows * filteredRowBytes;
+        size_t size = std::min(filteredSize - offset, (size_t)bandRows * filteredRowBytes);
+        size_t dictionarySize = std::min<size_t>(offset, 32 << 10);
+        Band& b = bands[band];
+        if (band == 0) {
+            // The zlib header (RFC 1950) that zlib would write for this level.
+            const int level = mgr->zlibLevel();
+            uint8_t header[2] = {0x78, level <= 1 ? (uint8_t)0x01 :
+                                       level <= 5 ? (uint8_t)0x5E :
+                                       level == 6 ? (uint8_t)0x9C : (uint8_t)0xDA};
+            b.fCompressed.write(header, sizeof(header));
+        }
+        b.fOk = deflate_band(filtered.get() + offset, size,
+                             filtered.get() + offset - dictionarySize, dictionarySize,
+                             band == bandCount - 1, mgr->zlibLevel(), &b.fCompressed);
+        b.fAdler = adler32(1, filtered.get() + offset, SkToUInt(size));
+    };
+
+    {
+        SkTaskGroup tasks(executor);
+        tasks.batch(bandCount, filterBand);
+        tasks.wait();
+        tasks.batch(bandCount, compressBand);
+        tasks.wait();
+    }
+
+    uLong adler = 1;
+    for (int band = 0; band < bandCount; ++band) {
+        size_t offset = (size_t)band * bandRows * filteredRowBytes;
+        size_t size = std::min(filteredSize - offset, (size_t)bandRows * filteredRowBytes);
+        if (!bands[band].fOk) {
+            return false;
+        }
+        adler = band == 0 ? bands[band].fAdler
+                          : adler32_combine(adler, bands[band].fAdler, (z_off_t)size);
+    }
+    const uint8_t trailer[4] = {
+        (uint8_t)(adler >> 24), (uint8_t)(adler >> 16), (uint8_t)(adler >> 8), (uint8_t)adler,
+    };
+    bands[bandCount - 1].fCompressed.write(trailer, sizeof(trailer));
+
+    png_structp png = mgr->pngPtr();
+    if (setjmp(png_jmpbuf(png))) {
+        return false;
+    }
+    for (int band = 0; band < bandCount; ++band) {
+        sk_sp<SkData> idat = bands[band].fCompressed.detachAsData();
+        png_write_chunk(png, (png_const_bytep)"IDAT", idat->bytes(), idat->size());
+    }
+    // We wrote the IDATs ourselves, so libpng does not know to let us call png_write_end().
+    // Everything else was written by png_write_info(), so all that remains is IEND.
+    png_write_chunk(png, (png_const_bytep)"IEND", nullptr, 0);
+    fCurrRow = height;
+    return true;
+}
+
 namespace SkPngEncoder {
 std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Options& options) {
     if (!SkPixmapIsValid(src)) {
@@ -507,7 +746,13 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Optio
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
     auto encoder = Make(dst, src, options);
-    return encoder.get() && encoder->encodeRows(src.height());
+    if (!encoder) {
+        return false;
+    }
+    if (options.fExecutor) {
+        return static_cast<SkPngEncoderImpl*>(encoder.get())->encodeAllRows(*options.fExecutor);
+    }
+    return encoder->encodeRows(src.height());
 }
 
 sk_sp<SkData> Encode(GrDirectContext* ctx, const SkImage* img, const Options& options) {
@@ -12,6 +12,7 @@
 
 #include <memory>
 
+class SkExecutor;
 class SkPixmap;
 class SkPngEncoderMgr;
 
@@ -22,6 +23,10 @@ public:
     SkPngEncoderImpl(std::unique_ptr<SkPngEncoderMgr>, const SkPixmap& src);
     ~SkPngEncoderImpl() override;
 
+    // Encodes all of the rows, filtering and compressing bands of rows on the executor.
+    // Must be called before any rows have been encoded.
+    bool encodeAllRows(SkExecutor&);
+
 protected:
     bool onEncodeRows(int numRows) override;
     std::unique_ptr<SkPngEncoderMgr> fEncoderMgr;
@@ -74,55 +74,68 @@ static bool preprocess_webp_picture(WebPPicture* pic,
 
     // Set compression, method, and pixel format.
     // libwebp recommends using BGRA for lossless and YUV for lossy.
-    // The choices of |webp_config.method| currently just match Chrome's defaults.  We
-    // could potentially expose this decision to the client.
     if (SkWebpEncoder::Compression::kLossy == opts.fCompression) {
         webp_config->lossless = 0;
 #ifndef SK_WEBP_ENCODER_USE_DEFAULT_METHOD
         webp_config->method = 3;
 #endif
         pic->use_argb = 0;
+    } else if (SkWebpEncoder::Compression::kLosslessFast == opts.fCompression) {
+        if (!WebPConfigLosslessPreset(webp_config, 0)) {
+            return false;
+        }
+        pic->use_argb = 1;
     } else {
         webp_config->lossless = 1;
         webp_config->method = 0;
         pic->use_argb = 1;
     }
-
-    {
-        const SkColorType ct = pixmap.colorType();
-        const bool premul = pixmap.alphaType() == kPremul_SkAlphaType;
-
-        SkBitmap tmpBm;
-        WebPPictureImportProc importProc = nullptr;
-        const SkPixmap* src = &pixmap;
-        if (ct == kRGB_888x_SkColorType) {
-            importProc = WebPPictureImportRGBX;
-        } else if (!premul && ct == kRGBA_8888_SkColorType) {
-            importProc = WebPPictureImportRGBA;
-        }
-#ifdef WebPPictureImportBGRA
-        else if (!premul && ct == kBGRA_8888_SkColorType) {
-            importProc = WebPPictureImportBGRA;
-        }
-#endif
-        else {
-            importProc = WebPPictureImportRGBA;
-            auto info = pixmap.info()
-                                .makeColorType(kRGBA_8888_SkColorType)
-                                .makeAlphaType(kUnpremul_SkAlphaType);
-            if (!tmpBm.tryAllocPixels(info) ||
-                !pixmap.readPixels(tmpBm.info(), tmpBm.getPixels(), tmpBm.rowBytes())) {
-                return false;
-            }
-            src = &tmpBm.pixmap();
-        }
-
-        if (!importProc(pic, reinterpret_cast<const uint8_t*>(src->addr()), src->rowBytes())) {
-            return false;
-        }
+    // An out of range method fails WebPEncode()'s validation of the config.
+    if (opts.fMethod >= 0 && SkWebpEncoder::Compression::kLosslessFast != opts.fCompression) {
+        webp_config->method = opts.fMethod;
+    }
+    webp_config->thread_level = opts.fMultithreaded ? 1 : 0;
+
+    const SkColorType ct = pixmap.colorType();
+    const bool premul = pixmap.alphaType() == kPremul_SkAlphaType;
+
+    WebPPictureImportProc importProc = nullptr;
+    if (ct == kRGB_888x_SkColorType) {
+        importProc = WebPPictureImportRGBX;
+    } else if (!premul && ct == kRGBA_8888_SkColorType) {
+        importProc = WebPPictureImportRGBA;
+    } else if (!premul && ct == kBGRA_8888_SkColorType) {
+        importProc = WebPPictureImportBGRA;
+    }
+    if (importProc) {
+        return importProc(pic, reinterpret_cast<const uint8_t*>(pixmap.addr()), pixmap.rowBytes());
     }
 
-    return true;
+#ifdef SK_CPU_LENDIAN
+    // Convert the pixels (e.g. unpremultiply them) straight into the picture's ARGB buffer, which
+    // holds BGRA bytes on little endian machines, rather than into a copy to import. For lossy
+    // compression, WebPEncode() converts the buffer to YUV.
+    pic->use_argb = 1;
+    if (!WebPPictureAlloc(pic)) {
+        return false;
+    }
+    const SkImageInfo argbInfo = pixmap.info()
+                                         .makeColorType(kBGRA_8888_SkColorType)
+                                         .makeAlphaType(kUnpremul_SkAlphaType);
+    return pixmap.readPixels(argbInfo, pic->argb, pic->argb_stride * sizeof(uint32_t));
+#else
+    SkBitmap tmpBm;
+    auto info = pixmap.info()
+                        .makeColorType(kRGBA_8888_SkColorType)
+                        .makeAlphaType(kUnpremul_SkAlphaType);
+    if (!tmpBm.tryAllocPixels(info) ||
+        !pixmap.readPixels(tmpBm.info(), tmpBm.getPixels(), tmpBm.rowBytes())) {
+        return false;
+    }
+    return WebPPictureImportRGBA(pic,
+                                 reinterpret_cast<const uint8_t*>(tmpBm.getPixels()),
+                                 tmpBm.rowBytes());
+#endif
 }
 
 namespace SkWebpEncoder {
@@ -369,6 +369,24 @@ public:
     virtual void evict(PlotLocator) = 0;
 };
 
+/**
+ * Occupancy and churn counters reported by the multi-page atlases. The counters are cumulative
+ * over the atlas' lifetime, while the occupancy values describe the active pages right now.
+ */
+struct AtlasStats {
+    uint32_t fActivePages = 0;
+    // Plots in the active pages that hold at least one subimage.
+    uint32_t fPlotsInUse = 0;
+    // Fraction of the active pages' area covered by subimages, in [0, 1].
+    float fOccupancy = 0.f;
+    uint64_t fEvictedPlots = 0;
+    // Aged out plots that were reused rather than activating another page.
+    uint64_t fRecycledPlots = 0;
+    uint64_t fPagesActivated = 0;
+    // Number of times the caller was asked to flush because every plot was in use.
+    uint64_t fTryAgainCount = 0;
+};
+
 /**
  * A class which can be handed back to an atlas for updating plots in bulk.  The
  * current max number of plots per page an atlas can handle is 32. If in the future
@@ -485,6 +503,8 @@ public:
     void incFlushesSinceLastUsed() { fFlushesSinceLastUse++; }
 
     bool needsUpload() { return !fDirtyRect.isEmpty(); }
+    // Fraction of this Plot's area taken by subimages since the last resetRects().
+    float percentFull() const { return fRectanizer.percentFull(); }
     std::pair<const void*, SkIRect> prepareForUpload();
     void resetRects();
 
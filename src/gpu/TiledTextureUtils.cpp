@@ -9,16 +9,28 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageGenerator.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSamplingOptions.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/private/base/SkMutex.h"
 #include "src/base/SkSafeMath.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkSamplingPriv.h"
+#include "src/core/SkTHash.h"
 #include "src/image/SkImage_Base.h"
+#include "src/image/SkImage_Lazy.h"
+
+#include <memory>
+#include <utility>
 
 //////////////////////////////////////////////////////////////////////////////
 //  Helper functions for tiling a large SkBitmap
@@ -82,9 +94,109 @@ SkIRect determine_clipped_src_rect(SkIRect clippedSrcIRect,
     return clippedSrcIRect;
 }
 
-int draw_tiled_bitmap(SkCanvas* canvas,
-                      const SkBitmap& bitmap,
-                      int tileSize,
+// Pixels of a lazy image that is drawn in tiles. The image is decoded at most once per draw, no
+// matter how many of its tiles have to be uploaded, and the pixels are dropped after the draw.
+class LazyTileSource : public SkRefCnt {
+public:
+    explicit LazyTileSource(sk_sp<SkImage> image) : fImage(std::move(image)) {}
+
+    bool readTile(const SkPixmap& dst, SkIPoint origin) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fPixels.drawsNothing() && !as_IB(fImage)->getROPixels(nullptr, &fPixels)) {
+            return false;
+        }
+        return fPixels.readPixels(dst, origin.fX, origin.fY);
+    }
+
+    void releasePixels() {
+        SkAutoMutexExclusive lock(fMutex);
+        fPixels.reset();
+    }
+
+private:
+    const sk_sp<SkImage> fImage;
+    SkMutex fMutex;
+    SkBitmap fPixels;
+};
+
+class LazyTileGenerator : public SkImageGenerator {
+public:
+    LazyTileGenerator(sk_sp<LazyTileSource> source, const SkImageInfo& info, SkIPoint origin)
+            : SkImageGenerator(info), fSource(std::move(source)), fOrigin(origin) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        return fSource->readTile(SkPixmap(info, pixels, rowBytes), fOrigin);
+    }
+
+private:
+    const sk_sp<LazyTileSource> fSource;
+    const SkIPoint fOrigin;
+};
+
+// The tiles of a lazy image, as lazy images themselves. A tile keeps its unique ID from one draw
+// to the next, so the GPU backends find its texture by that ID and only decode the image again if
+// some visible tile is not already uploaded. Bitmap-backed images don't need this, since their
+// tiles share the bitmap's pixel ref and are cached by its generation ID.
+class LazyTiledImage : public SkRefCnt {
+public:
+    explicit LazyTiledImage(sk_sp<SkImage> image)
+            : fInfo(image->imageInfo())
+            , fSource(sk_make_sp<LazyTileSource>(std::move(image))) {}
+
+    sk_sp<SkImage> tile(const SkIRect& subset) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (sk_sp<SkImage>* tile = fTiles.find(subset)) {
+            return *tile;
+        }
+        sk_sp<SkImage> tile = SkImages::DeferredFromGenerator(std::make_unique<LazyTileGenerator>(
+                fSource, fInfo.makeDimensions(subset.size()), subset.topLeft()));
+        if (tile) {
+            fTiles.set(subset, tile);
+        }
+        return tile;
+    }
+
+    LazyTileSource* source() const { return fSource.get(); }
+
+private:
+    const SkImageInfo fInfo;
+    const sk_sp<LazyTileSource> fSource;
+    SkMutex fMutex;
+    skia_private::THashMap<SkIRect, sk_sp<SkImage>> fTiles;
+};
+
+// Keeps the tiles of the most recently drawn lazy images, keyed by image unique ID.
+class LazyTiledImageCache {
+public:
+    static LazyTiledImageCache* Get() {
+        static LazyTiledImageCache* cache = new LazyTiledImageCache;
+        return cache;
+    }
+
+    sk_sp<LazyTiledImage> findOrCreate(const SkImage* image) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (sk_sp<LazyTiledImage>* tiled = fImages.find(image->uniqueID())) {
+            return *tiled;
+        }
+        return *fImages.insert(image->uniqueID(), sk_make_sp<LazyTiledImage>(sk_ref_sp(image)));
+    }
+
+private:
+    static constexpr int kMaxImages = 4;
+
+    SkMutex fMutex;
+    SkLRUCache<uint32_t, sk_sp<LazyTiledImage>> fImages SK_GUARDED_BY(fMutex){kMaxImages};
+};
+
+// Draws the tiles of an image of 'imageSize' that are visible, making the image for each tile
+// with 'makeTile', which is passed the tile's subset of the image.
+template <typename MakeTileFn>
+int draw_tiled_image(SkCanvas* canvas,
+                     const SkISize& imageSize,
+                     MakeTileFn&& makeTile,
+                     int tileSize,
                       const SkMatrix& srcToDst,
                       const SkRect& srcRect,
                       const SkIRect& clippedSrcIRect,
@@ -97,8 +209,8 @@ int draw_tiled_bitmap(SkCanvas* canvas,
     }
     SkRect clippedSrcRect = SkRect::Make(clippedSrcIRect);
 
-    int nx = bitmap.width() / tileSize;
-    int ny = bitmap.height() / tileSize;
+    int nx = imageSize.width() / tileSize;
+    int ny = imageSize.height() / tileSize;
 
     int numTilesDrawn = 0;
 
@@ -128,32 +240,17 @@ int draw_tiled_bitmap(SkCanvas* canvas,
             }
 
             if (sampling.filter != SkFilterMode::kNearest || sampling.useCubic) {
-                SkIRect iClampRect;
-
-                if (SkCanvas::kFast_SrcRectConstraint == constraint) {
-                    // In bleed mode we want to always expand the tile on all edges
-                    // but stay within the bitmap bounds
-                    iClampRect = SkIRect::MakeWH(bitmap.width(), bitmap.height());
-                } else {
-                    // In texture-domain/clamp mode we only want to expand the
-                    // tile on edges interior to "srcRect" (i.e., we want to
-                    // not bleed across the original clamped edges)
-                    srcRect.roundOut(&iClampRect);
-                }
+                // Expand the tile on all edges but stay within the image bounds. In strict mode
+                // the draw itself keeps the sampling within "srcRect", so the tile doesn't need to
+                // stop at its edges, and the tile's subset stays the same whatever "srcRect" is.
+                // That lets the tile's texture be found in the cache when "srcRect" changes.
+                SkIRect iClampRect = SkIRect::MakeSize(imageSize);
                 int outset = sampling.useCubic ? kBicubicFilterTexelPad : 1;
                 skgpu::TiledTextureUtils::ClampedOutsetWithOffset(&iTileR, outset, &offset,
                                                                   iClampRect);
             }
 
-            // We must subset as a bitmap and then turn it into an SkImage if we want caching to
-            // work. Image subsets always make a copy of the pixels and lose the association with
-            // the original's SkPixelRef.
-            if (SkBitmap subsetBmp; bitmap.extractSubset(&subsetBmp, iTileR)) {
-                sk_sp<SkImage> image = SkMakeImageFromRasterBitmap(subsetBmp,
-                                                                   kNever_SkCopyPixelsMode);
-                if (!image) {
-                    continue;
-                }
+            if (sk_sp<SkImage> image = makeTile(iTileR)) {
 
                 unsigned aaFlags = SkCanvas::kNone_QuadAAFlags;
                 // Preserve the original edge AA flags for the exterior tile edges.
@@ -417,19 +514,51 @@ std::tuple<bool, size_t> TiledTextureUtils::DrawAsTiledImageRect(
                             cacheSize,
                             &tileSize,
                             &clippedSubset)) {
+            if (image->isLazyGenerated() &&
+                !static_cast<const SkImage_Lazy*>(image)->generator()->isTextureGenerator()) {
+                // Only decode the image if one of the visible tiles has to be uploaded.
+                sk_sp<LazyTiledImage> tiled = LazyTiledImageCache::Get()->findOrCreate(image);
+                size_t tiles = draw_tiled_image(canvas,
+                                                image->dimensions(),
+                                                [&](const SkIRect& subset) {
+                                                    return tiled->tile(subset);
+                                                },
+                                                tileSize,
+                                                srcToDst,
+                                                src,
+                                                clippedSubset,
+                                                paint,
+                                                aaFlags,
+                                                constraint,
+                                                sampling);
+                tiled->source()->releasePixels();
+                return {true, tiles};
+            }
+
             // Extract pixels on the CPU, since we have to split into separate textures before
             // sending to the GPU if tiling.
             if (SkBitmap bm; as_IB(image)->getROPixels(nullptr, &bm)) {
-                size_t tiles = draw_tiled_bitmap(canvas,
-                                                 bm,
-                                                 tileSize,
-                                                 srcToDst,
-                                                 src,
-                                                 clippedSubset,
-                                                 paint,
-                                                 aaFlags,
-                                                 constraint,
-                                                 sampling);
+                // We must subset as a bitmap and then turn it into an SkImage if we want caching
+                // to work. Image subsets always make a copy of the pixels and lose the association
+                // with the original's SkPixelRef.
+                auto makeTile = [&bm](const SkIRect& subset) -> sk_sp<SkImage> {
+                    SkBitmap subsetBmp;
+                    if (!bm.extractSubset(&subsetBmp, subset)) {
+                        return nullptr;
+                    }
+                    return SkMakeImageFromRasterBitmap(subsetBmp, kNever_SkCopyPixelsMode);
+                };
+                size_t tiles = draw_tiled_image(canvas,
+                                                bm.dimensions(),
+                                                makeTile,
+                                                tileSize,
+                                                srcToDst,
+                                                src,
+                                                clippedSubset,
+                                                paint,
+                                                aaFlags,
+                                                constraint,
+                                                sampling);
                 return {true, tiles};
             }
         }
@@ -50,6 +50,7 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "include/private/chromium/Slug.h"  // IWYU pragma: keep
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
@@ -78,6 +79,7 @@
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
 #include "src/gpu/ganesh/GrFragmentProcessors.h"
 #include "src/gpu/ganesh/GrImageInfo.h"
+#include "src/gpu/ganesh/GrOpsTypes.h"
 #include "src/gpu/ganesh/GrPaint.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
@@ -629,6 +631,39 @@ void Device::drawEdgeAAQuad(const SkRect& rect,
     }
 }
 
+void Device::drawEdgeAARectSet(const SkRect rects[],
+                               const SkColor4f colors[],
+                               const SkMatrix preViewMatrices[],
+                               int count,
+                               SkCanvas::QuadAAFlags aaFlags,
+                               SkBlendMode mode) {
+    if (preViewMatrices) {
+        // GrQuadSetEntry only has a local matrix, so rects with their own view matrices are drawn
+        // one at a time. They still batch into the same FillRectOps when they can.
+        this->SkDevice::drawEdgeAARectSet(rects, colors, preViewMatrices, count, aaFlags, mode);
+        return;
+    }
+
+    ASSERT_SINGLE_OWNER
+    GR_CREATE_TRACE_MARKER_CONTEXT("skgpu::ganesh::Device", "drawEdgeAARectSet", fContext.get());
+
+    const GrQuadAAFlags grAAFlags = SkToGrQuadAAFlags(aaFlags);
+    AutoTArray<GrQuadSetEntry> quads(count);
+    for (int i = 0; i < count; ++i) {
+        quads[i] = {rects[i],
+                    SkColor4fPrepForDst(colors[i], fSurfaceDrawContext->colorInfo()).premul(),
+                    SkMatrix::I(),
+                    grAAFlags};
+    }
+
+    GrPaint grPaint;
+    if (mode != SkBlendMode::kSrcOver) {
+        grPaint.setXPFactory(GrXPFactory::FromBlendMode(mode));
+    }
+    fSurfaceDrawContext->drawQuadSet(this->clip(), std::move(grPaint), this->localToDevice(),
+                                     quads.get(), count);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void Device::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
@@ -218,6 +218,9 @@ public:
 
     void drawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4], SkCanvas::QuadAAFlags aaFlags,
                         const SkColor4f& color, SkBlendMode mode) override;
+    void drawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                           const SkMatrix preViewMatrices[], int count,
+                           SkCanvas::QuadAAFlags aaFlags, SkBlendMode mode) override;
     void drawEdgeAAImageSet(const SkCanvas::ImageSetEntry[], int count, const SkPoint dstClips[],
                             const SkMatrix preViewMatrices[], const SkSamplingOptions&,
                             const SkPaint&, SkCanvas::SrcRectConstraint) override;
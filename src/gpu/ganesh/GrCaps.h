@@ -119,14 +119,10 @@ public:
 
     // Should we discard stencil values after a render pass? (Tilers get better performance if we
     // always load stencil buffers with a "clear" op, and then discard the content when finished.)
+    // This is off by default (b/160958008) and only enabled by backends where it has been verified,
+    // such as Vulkan devices that keep stencil attachments in lazily allocated memory.
     bool discardStencilValuesAfterRenderPass() const {
-        // b/160958008
-        return false;
-#if 0
-        // This method is actually just a duplicate of preferFullscreenClears(), with a descriptive
-        // name for the sake of readability.
-        return this->preferFullscreenClears();
-#endif
+        return fDiscardStencilValuesAfterRenderPass;
     }
 
     // D3D does not allow the refs or masks to differ on a two-sided stencil draw.
@@ -602,6 +598,7 @@ protected:
     bool fUsePrimitiveRestart                        : 1;
     bool fPreferClientSideDynamicBuffers             : 1;
     bool fPreferFullscreenClears                     : 1;
+    bool fDiscardStencilValuesAfterRenderPass        : 1;
     bool fTwoSidedStencilRefsAndMasksMustMatch       : 1;
     bool fMustClearUploadedBufferData                : 1;
     bool fBuffersAreInitiallyZero                    : 1;
@@ -1127,6 +1127,14 @@ bool GrDirectContext::precompileShader(const SkData& key, const SkData& data) {
     return fGpu->precompileShader(key, data);
 }
 
+int GrDirectContext::precompileShaders(SkSpan<const sk_sp<SkData>> keys,
+                                       SkSpan<const sk_sp<SkData>> data) {
+    if (this->abandoned() || keys.size() != data.size()) {
+        return 0;
+    }
+    return fGpu->precompileShaders(keys, data);
+}
+
 #ifdef SK_ENABLE_DUMP_GPU
 #include "include/core/SkString.h"
 #include "src/utils/SkJSONWriter.h"
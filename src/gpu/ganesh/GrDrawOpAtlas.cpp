@@ -129,6 +129,7 @@ inline void GrDrawOpAtlas::processEviction(PlotLocator plotLocator) {
     }
 
     fAtlasGeneration = fGenerationCounter->next();
+    ++fEvictedPlots;
 }
 
 void GrDrawOpAtlas::uploadPlotToTexture(GrDeferredTextureUploadWritePixelsFn& writePixels,
@@ -245,6 +246,20 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
             }
         }
     } else {
+        // Before growing, reuse a plot that hasn't been drawn from in a long time. Otherwise a
+        // long running session activates every page for content that is no longer used and is
+        // left with only the per-page LRU plots to evict from.
+        if (Plot* plot = this->findAgedOutPlot(target->tokenTracker()->nextFlushToken())) {
+            this->processEvictionAndResetRects(plot);
+            SkDEBUGCODE(bool verify = )plot->addSubImage(width, height, image, atlasLocator);
+            SkASSERT(verify);
+            if (!this->updatePlot(target, atlasLocator, plot)) {
+                return ErrorCode::kError;
+            }
+            ++fRecycledPlots;
+            return ErrorCode::kSucceeded;
+        }
+
         // If we haven't activated all the available pages, try to create a new one and add to it
         if (!this->activateNewPage(resourceProvider)) {
             return ErrorCode::kError;
@@ -280,6 +295,7 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
     // continue past this branch and prepare an inline upload that will occur after the enqueued
     // draw which references the plot's pre-upload content.
     if (!plot) {
+        ++fTryAgainCount;
         return ErrorCode::kTryAgain;
     }
 
@@ -315,6 +331,19 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
     return ErrorCode::kSucceeded;
 }
 
+Plot* GrDrawOpAtlas::findAgedOutPlot(AtlasToken nextFlushToken) {
+    // Only the LRU plot of each page needs to be checked, the rest were used more recently.
+    for (unsigned int pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
+        Plot* plot = fPages[pageIdx].fPlotList.tail();
+        SkASSERT(plot);
+        if (plot->flushesSinceLastUsed() > kPlotRecentlyUsedCount &&
+            plot->lastUseToken() < nextFlushToken) {
+            return plot;
+        }
+    }
+    return nullptr;
+}
+
 void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
     if (fNumActivePages < 1) {
         fPrevFlushToken = startTokenForNextFlush;
@@ -525,6 +554,7 @@ bool GrDrawOpAtlas::activateNewPage(GrResourceProvider* resourceProvider) {
     }
 
     ++fNumActivePages;
+    ++fPagesActivated;
     return true;
 }
 
@@ -556,6 +586,29 @@ inline void GrDrawOpAtlas::deactivateLastPage() {
     --fNumActivePages;
 }
 
+skgpu::AtlasStats GrDrawOpAtlas::stats() const {
+    skgpu::AtlasStats stats;
+    stats.fActivePages = fNumActivePages;
+    float occupiedPlots = 0.f;
+    for (uint32_t pageIndex = 0; pageIndex < fNumActivePages; ++pageIndex) {
+        for (uint32_t plotIndex = 0; plotIndex < fNumPlots; ++plotIndex) {
+            float percentFull = fPages[pageIndex].fPlotArray[plotIndex]->percentFull();
+            if (percentFull > 0.f) {
+                ++stats.fPlotsInUse;
+                occupiedPlots += percentFull;
+            }
+        }
+    }
+    if (fNumActivePages) {
+        stats.fOccupancy = occupiedPlots / (fNumActivePages * fNumPlots);
+    }
+    stats.fEvictedPlots = fEvictedPlots;
+    stats.fRecycledPlots = fRecycledPlots;
+    stats.fPagesActivated = fPagesActivated;
+    stats.fTryAgainCount = fTryAgainCount;
+    return stats;
+}
+
 GrDrawOpAtlasConfig::GrDrawOpAtlasConfig(int maxTextureSize, size_t maxBytes) {
     static const SkISize kARGBDimensions[] = {
         {256, 256},   // maxBytes < 2^19
@@ -162,6 +162,9 @@ public:
         return fMaxPages;
     }
 
+    // Walks the active pages, so this is meant for diagnostics rather than every draw.
+    skgpu::AtlasStats stats() const;
+
 private:
     friend class GrDrawOpAtlasTools;
 
@@ -186,6 +189,7 @@ private:
 
     bool uploadToPage(unsigned int pageIdx, GrDeferredUploadTarget*, int width, int height,
                       const void* image, skgpu::AtlasLocator*);
+    skgpu::Plot* findAgedOutPlot(skgpu::AtlasToken nextFlushToken);
 
     void uploadPlotToTexture(GrDeferredTextureUploadWritePixelsFn& writePixels,
                              GrTextureProxy* proxy,
@@ -240,6 +244,12 @@ private:
 
     uint32_t fNumActivePages;
 
+    // Cumulative counters reported by stats()
+    uint64_t fEvictedPlots = 0;
+    uint64_t fRecycledPlots = 0;
+    uint64_t fPagesActivated = 0;
+    uint64_t fTryAgainCount = 0;
+
     SkDEBUGCODE(void validate(const skgpu::AtlasLocator& atlasLocator) const;)
 };
 
@@ -15,6 +15,7 @@
 #include "include/gpu/GrRecordingContext.h"
 #include "include/private/chromium/GrDeferredDisplayList.h"
 #include "src/base/SkTInternalLList.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/ganesh/GrBufferTransferRenderTask.h"
 #include "src/gpu/ganesh/GrBufferUpdateRenderTask.h"
 #include "src/gpu/ganesh/GrClientMappedBufferManager.h"
@@ -227,6 +228,35 @@ bool GrDrawingManager::submitToGpu(GrSyncCpu sync) {
     return gpu->submitToGpu(sync);
 }
 
+void GrDrawingManager::prepareOpsOnWorkers() {
+    SkExecutor* executor = fContext->priv().options().fExecutor;
+    if (!executor || !fContext->priv().options().fAllowParallelOpPreparation ||
+        !fContext->asDirectContext()) {
+        return;
+    }
+
+    TArray<GrOp*> ops;
+    for (const auto& renderTask : fDAG) {
+        if (renderTask && renderTask->isInstantiated()) {
+            renderTask->gatherOpsToPrepareOnWorker(&ops);
+        }
+    }
+    if (ops.empty()) {
+        return;
+    }
+    TRACE_EVENT1("skia.gpu", TRACE_FUNC, "ops", ops.size());
+
+    GrRecordingContext* context = fContext;
+    if (ops.size() == 1) {
+        ops[0]->prepareOnWorker(context);
+        return;
+    }
+    // The ops are then prepared and executed in order, so only the CPU work is reordered.
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(ops.size(), [&ops, context](int i) { ops[i]->prepareOnWorker(context); });
+    taskGroup.wait();
+}
+
 bool GrDrawingManager::executeRenderTasks(GrOpFlushState* flushState) {
 #if GR_FLUSH_TIME_OP_SPEW
     SkDebugf("Flushing %d opsTasks\n", fDAG.size());
@@ -241,6 +271,8 @@ bool GrDrawingManager::executeRenderTasks(GrOpFlushState* flushState) {
 
     bool anyRenderTasksExecuted = false;
 
+    this->prepareOpsOnWorkers();
+
     for (const auto& renderTask : fDAG) {
         if (!renderTask || !renderTask->isInstantiated()) {
              continue;
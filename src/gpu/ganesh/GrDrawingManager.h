@@ -194,6 +194,10 @@ private:
 
     void closeActiveOpsTask();
 
+    // Called by executeRenderTasks() to do the ops' CPU work on the context's executor, if
+    // GrContextOptions allow it, before the ops are prepared.
+    void prepareOpsOnWorkers();
+
     // return true if any GrRenderTasks were actually executed; false otherwise
     bool executeRenderTasks(GrOpFlushState*);
 
@@ -828,6 +828,8 @@ void GrGpu::Stats::dump(SkString* out) {
                  fNumScratchMSAAAttachmentsReused);
     out->appendf("Number of Render Passes: %d\n", fRenderPasses);
     out->appendf("Reordered DAGs Over Budget: %d\n", fNumReorderedDAGsOverBudget);
+    out->appendf("Uniform Uploads: %d\n", fNumUniformUploads);
+    out->appendf("Redundant Uniform Uploads Skipped: %d\n", fNumUniformUploadsSkipped);
 
     // enable this block to output CSV-style stats for program pre-compilation
 #if 0
@@ -850,6 +852,10 @@ void GrGpu::Stats::dumpKeyValuePairs(TArray<SkString>* keys, TArray<double>* val
     values->push_back(fRenderPasses);
     keys->push_back(SkString("reordered_dags_over_budget"));
     values->push_back(fNumReorderedDAGsOverBudget);
+    keys->push_back(SkString("uniform_uploads"));
+    values->push_back(fNumUniformUploads);
+    keys->push_back(SkString("uniform_uploads_skipped"));
+    values->push_back(fNumUniformUploadsSkipped);
 }
 
 #endif // GR_GPU_STATS
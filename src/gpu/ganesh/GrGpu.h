@@ -504,6 +504,12 @@ public:
         int numReorderedDAGsOverBudget() const { return fNumReorderedDAGsOverBudget; }
         void incNumReorderedDAGsOverBudget() { fNumReorderedDAGsOverBudget++; }
 
+        int numUniformUploads() const { return fNumUniformUploads; }
+        void incNumUniformUploads() { fNumUniformUploads++; }
+
+        int numUniformUploadsSkipped() const { return fNumUniformUploadsSkipped; }
+        void incNumUniformUploadsSkipped() { fNumUniformUploadsSkipped++; }
+
 #if defined(GR_TEST_UTILS)
         void dump(SkString*);
         void dumpKeyValuePairs(
@@ -524,6 +530,8 @@ public:
         int fNumScratchMSAAAttachmentsReused = 0;
         int fRenderPasses = 0;
         int fNumReorderedDAGsOverBudget = 0;
+        int fNumUniformUploads = 0;
+        int fNumUniformUploadsSkipped = 0;
 
 #else  // !GR_GPU_STATS
 
@@ -545,6 +553,8 @@ public:
         void incNumScratchMSAAAttachmentsReused() {}
         void incRenderPasses() {}
         void incNumReorderedDAGsOverBudget() {}
+        void incNumUniformUploads() {}
+        void incNumUniformUploadsSkipped() {}
 #endif
     };
 
@@ -620,6 +630,17 @@ public:
 
     virtual bool precompileShader(const SkData& key, const SkData& data) { return false; }
 
+    // Precompiles each key/data pair and returns the number that succeeded.
+    virtual int precompileShaders(SkSpan<const sk_sp<SkData>> keys,
+                                  SkSpan<const sk_sp<SkData>> data) {
+        SkASSERT(keys.size() == data.size());
+        int count = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            count += this->precompileShader(*keys[i], *data[i]) ? 1 : 0;
+        }
+        return count;
+    }
+
 #if defined(GR_TEST_UTILS)
     /** Check a handle represents an actual texture in the backend API that has not been freed. */
     virtual bool isTestingOnlyBackendTexture(const GrBackendTexture&) const = 0;
@@ -13,6 +13,7 @@
 #include "include/private/base/SkNoncopyable.h"
 #include "include/private/base/SkTo.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/base/SkTInternalLList.h"
 #include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/ResourceKey.h"
 
@@ -320,9 +321,11 @@ private:
     friend class GrGpu;  // for assert in GrGpu to access getGpu
 #endif
 
-    // An index into a heap when this resource is purgeable or an array when not. This is maintained
-    // by the cache.
+    // An index into an array when this resource is not purgeable. This is maintained by the cache.
     int fCacheArrayIndex;
+    // Links in the cache's list of purgeable resources, which is ordered from least to most
+    // recently used.
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(GrGpuResource);
     // This value reflects how recently this resource was accessed in the cache. This is maintained
     // by the cache.
     uint32_t fTimestamp;
@@ -12,6 +12,7 @@
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/ganesh/SkMeshGanesh.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkMeshPriv.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -23,6 +24,7 @@
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrStagingBufferManager.h"
 
+#include <algorithm>
 #include <cstring>
 #include <utility>
 
@@ -63,6 +65,61 @@ bool GrMeshBuffer<Base, Type>::onUpdate(GrDirectContext* dc,
     }
     SkASSERT(!dc->abandoned());  // If dc is abandoned then fBuffer->getContext() should be null.
 
+    // Merge the pending ranges that overlap or touch this one into it.
+    size_t start = offset;
+    size_t end = offset + size;
+    bool merging = false;
+    for (const PendingUpdate& pending : fPendingUpdates) {
+        if (pending.fOffset <= end && pending.fOffset + pending.fData->size() >= start) {
+            start = std::min(start, pending.fOffset);
+            end = std::max(end, pending.fOffset + pending.fData->size());
+            merging = true;
+        }
+    }
+    if (!merging) {
+        if (fPendingUpdates.size() == kMaxPendingUpdates) {
+            this->flushPendingUpdates(dc);
+        }
+        fPendingUpdates.push_back({offset, SkData::MakeWithCopy(data, size)});
+        return true;
+    }
+
+    sk_sp<SkData> merged = SkData::MakeUninitialized(end - start);
+    for (int i = fPendingUpdates.size() - 1; i >= 0; --i) {
+        const PendingUpdate& pending = fPendingUpdates[i];
+        if (pending.fOffset >= start && pending.fOffset + pending.fData->size() <= end) {
+            std::memcpy(SkTAddOffset<void>(merged->writable_data(), pending.fOffset - start),
+                        pending.fData->data(),
+                        pending.fData->size());
+            fPendingUpdates.removeShuffle(i);
+        }
+    }
+    std::memcpy(SkTAddOffset<void>(merged->writable_data(), offset - start), data, size);
+    fPendingUpdates.push_back({start, std::move(merged)});
+    return true;
+}
+
+template <typename Base, GrGpuBufferType Type>
+void GrMeshBuffer<Base, Type>::flushPendingUpdates(GrRecordingContext* rContext) {
+    if (fPendingUpdates.empty()) {
+        return;
+    }
+    GrDirectContext* dc = rContext ? rContext->asDirectContext() : nullptr;
+    if (!dc || dc != fBuffer->getContext()) {
+        return;
+    }
+    for (const PendingUpdate& pending : fPendingUpdates) {
+        // If an upload fails there's no one to report it to. The buffer keeps its old contents.
+        this->upload(dc, pending.fData->data(), pending.fOffset, pending.fData->size());
+    }
+    fPendingUpdates.clear();
+}
+
+template <typename Base, GrGpuBufferType Type>
+bool GrMeshBuffer<Base, Type>::upload(GrDirectContext* dc,
+                                      const void* data,
+                                      size_t offset,
+                                      size_t size) {
     if (!dc->priv().caps()->transferFromBufferToBufferSupport()) {
         auto ownedData = SkData::MakeWithCopy(data, size);
         dc->priv().drawingManager()->newBufferUpdateTask(
@@ -101,6 +158,10 @@ bool GrMeshBuffer<Base, Type>::onUpdate(GrDirectContext* dc,
     return true;
 }
 
+// flushPendingUpdates() is called from the code that records mesh draws.
+template class GrMeshBuffer<SkMeshPriv::IB, GrGpuBufferType::kIndex>;
+template class GrMeshBuffer<SkMeshPriv::VB, GrGpuBufferType::kVertex>;
+
 namespace SkMeshes {
 sk_sp<SkMesh::IndexBuffer> MakeIndexBuffer(GrDirectContext* dc, const void* data, size_t size) {
     if (!dc) {
@@ -8,9 +8,11 @@
 #ifndef GrMeshBuffers_DEFINED
 #define GrMeshBuffers_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkMeshPriv.h"
 #include "src/gpu/ganesh/GrGpuBuffer.h"
@@ -34,11 +36,31 @@ public:
 
     sk_sp<const GrGpuBuffer> asGpuBuffer() const { return fBuffer; }
 
+    // Uploads the updates made since the buffer was last drawn. This must be called before
+    // recording a draw that reads the buffer.
+    void flushPendingUpdates(GrRecordingContext*);
+
 private:
+    // update() doesn't upload right away. Every upload closes the active ops task, so a mesh that
+    // is updated in many small pieces (e.g. a particle at a time) would split the frame's render
+    // pass once per update. Instead, updates are gathered into non-overlapping ranges, merging
+    // ranges that overlap or touch so that later data replaces earlier data, and each range is
+    // uploaded once, when the buffer is next drawn.
+    struct PendingUpdate {
+        size_t fOffset;
+        sk_sp<SkData> fData;
+    };
+
+    // Past this many disjoint ranges, the pending updates are uploaded right away.
+    static constexpr int kMaxPendingUpdates = 16;
+
     bool onUpdate(GrDirectContext*, const void* data, size_t offset, size_t size) override;
 
+    bool upload(GrDirectContext*, const void* data, size_t offset, size_t size);
+
     sk_sp<GrGpuBuffer> fBuffer;
     GrDirectContext::DirectContextID fContextID;
+    skia_private::STArray<1, PendingUpdate> fPendingUpdates;
 };
 
 namespace SkMeshPriv {
@@ -179,6 +179,10 @@ public:
     virtual GrDeferredUploadTarget* deferredUploadTarget() = 0;
 
     virtual SkArenaAlloc* allocator() = 0;
+
+    // Memory for temporary work (e.g. triangulating a path) during an op's onPrepareDraws. It is
+    // shared by all the ops of the flush, so the caller must reset() it before returning.
+    virtual SkArenaAllocWithReset* scratchAllocator() = 0;
 };
 
 #endif
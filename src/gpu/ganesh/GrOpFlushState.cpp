@@ -229,6 +229,15 @@ GrAtlasManager* GrOpFlushState::atlasManager() const {
     return fGpu->getContext()->priv().getAtlasManager();
 }
 
+SkArenaAllocWithReset* GrOpFlushState::scratchAllocator() {
+    if (!fScratchAllocator) {
+        fScratchBlock.reset(new char[kScratchBlockSize]);
+        fScratchAllocator.emplace(fScratchBlock.get(), kScratchBlockSize, kScratchBlockSize);
+    }
+    SkASSERT(fScratchAllocator->isEmpty());
+    return &*fScratchAllocator;
+}
+
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 skgpu::ganesh::SmallPathAtlasMgr* GrOpFlushState::smallPathAtlasManager() const {
     return fGpu->getContext()->priv().getSmallPathAtlasMgr();
@@ -31,6 +31,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <utility>
 
 class GrAtlasManager;
@@ -221,6 +223,7 @@ public:
 
     /** GrMeshDrawTarget override. */
     SkArenaAlloc* allocator() override { return &fArena; }
+    SkArenaAllocWithReset* scratchAllocator() override;
 
     // This is a convenience method that binds the given pipeline, and then, if our applied clip has
     // a scissor, sets the scissor rect from the applied clip.
@@ -322,6 +325,12 @@ private:
     // Storage for ops' pipelines, draws, and inline uploads.
     SkArenaAllocWithReset fArena{sizeof(GrPipeline) * 100};
 
+    // Scratch memory that ops reset after each use. Its first block is allocated on first use and
+    // then reused for the rest of the flush.
+    static constexpr size_t kScratchBlockSize = 64 * 1024;
+    std::unique_ptr<char[]> fScratchBlock;
+    std::optional<SkArenaAllocWithReset> fScratchAllocator;
+
     // Store vertex and index data on behalf of ops that are flushed.
     GrVertexBufferAllocPool fVertexPool;
     GrIndexBufferAllocPool fIndexPool;
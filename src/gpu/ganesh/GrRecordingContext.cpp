@@ -190,6 +190,9 @@ void GrRecordingContext::dumpJSON(SkJSONWriter* writer) const {
 #if GR_GPU_STATS
     writer->appendS32("path_masks_generated", this->stats()->numPathMasksGenerated());
     writer->appendS32("path_mask_cache_hits", this->stats()->numPathMaskCacheHits());
+    writer->appendS32("atlas_path_masks_generated",
+                      this->stats()->numAtlasPathMasksGenerated());
+    writer->appendS32("atlas_path_mask_cache_hits", this->stats()->numAtlasPathMaskCacheHits());
 #endif
 
     writer->endObject();
@@ -205,6 +208,12 @@ void GrRecordingContext::dumpJSON(SkJSONWriter*) const { }
 void GrRecordingContext::Stats::dump(SkString* out) const {
     out->appendf("Num Path Masks Generated: %d\n", fNumPathMasksGenerated);
     out->appendf("Num Path Mask Cache Hits: %d\n", fNumPathMaskCacheHits);
+    out->appendf("Num Atlas Path Masks Generated: %d\n", fNumAtlasPathMasksGenerated);
+    out->appendf("Num Atlas Path Mask Cache Hits: %d\n", fNumAtlasPathMaskCacheHits);
+    out->appendf("Num Op Combine Attempts: %d\n", fNumOpCombineAttempts);
+    out->appendf("Num Ops Combined: %d\n", fNumOpsCombined);
+    out->appendf("Num Op Combines Blocked By Overlap: %d\n", fNumOpCombinesBlockedByOverlap);
+    out->appendf("Num Op Combines Out Of Range: %d\n", fNumOpCombinesOutOfRange);
 }
 
 void GrRecordingContext::Stats::dumpKeyValuePairs(TArray<SkString>* keys,
@@ -214,6 +223,24 @@ void GrRecordingContext::Stats::dumpKeyValuePairs(TArray<SkString>* keys,
 
     keys->push_back(SkString("path_mask_cache_hits"));
     values->push_back(fNumPathMaskCacheHits);
+
+    keys->push_back(SkString("atlas_path_masks_generated"));
+    values->push_back(fNumAtlasPathMasksGenerated);
+
+    keys->push_back(SkString("atlas_path_mask_cache_hits"));
+    values->push_back(fNumAtlasPathMaskCacheHits);
+
+    keys->push_back(SkString("op_combine_attempts"));
+    values->push_back(fNumOpCombineAttempts);
+
+    keys->push_back(SkString("ops_combined"));
+    values->push_back(fNumOpsCombined);
+
+    keys->push_back(SkString("op_combines_blocked_by_overlap"));
+    values->push_back(fNumOpCombinesBlockedByOverlap);
+
+    keys->push_back(SkString("op_combines_out_of_range"));
+    values->push_back(fNumOpCombinesOutOfRange);
 }
 
 void GrRecordingContext::DMSAAStats::dumpKeyValuePairs(TArray<SkString>* keys,
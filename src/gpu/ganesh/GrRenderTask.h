@@ -16,6 +16,7 @@
 #include "src/gpu/ganesh/GrTextureResolveManager.h"
 
 class GrMockRenderTask;
+class GrOp;
 class GrOpFlushState;
 class GrResourceAllocator;
 class GrTextureResolveRenderTask;
@@ -41,6 +42,9 @@ public:
     void prepare(GrOpFlushState* flushState);
     bool execute(GrOpFlushState* flushState) { return this->onExecute(flushState); }
 
+    // Adds the ops that prepare() will prepare and that have work for GrOp::prepareOnWorker().
+    virtual void gatherOpsToPrepareOnWorker(skia_private::TArray<GrOp*>*) const {}
+
     virtual bool requiresExplicitCleanup() const { return false; }
 
     // Called when this class will survive a flush and needs to truncate its ops and start over.
@@ -109,7 +109,7 @@ void GrResourceCache::removeResource(GrGpuResource* resource) {
 
     size_t size = resource->gpuMemorySize();
     if (resource->resourcePriv().isPurgeable()) {
-        fPurgeableQueue.remove(resource);
+        this->removeFromPurgeableList(resource);
         fPurgeableBytes -= size;
     } else {
         this->removeFromNonpurgeableArray(resource);
@@ -142,8 +142,8 @@ void GrResourceCache::abandonAll() {
         back->cacheAccess().abandon();
     }
 
-    while (fPurgeableQueue.count()) {
-        GrGpuResource* top = fPurgeableQueue.peek();
+    while (!fPurgeableList.isEmpty()) {
+        GrGpuResource* top = fPurgeableList.head();
         SkASSERT(!top->wasDestroyed());
         top->cacheAccess().abandon();
     }
@@ -180,8 +180,8 @@ void GrResourceCache::releaseAll() {
         back->cacheAccess().release();
     }
 
-    while (fPurgeableQueue.count()) {
-        GrGpuResource* top = fPurgeableQueue.peek();
+    while (!fPurgeableList.isEmpty()) {
+        GrGpuResource* top = fPurgeableList.head();
         SkASSERT(!top->wasDestroyed());
         top->cacheAccess().release();
     }
@@ -211,6 +211,7 @@ GrGpuResource* GrResourceCache::findAndRefScratchResource(const skgpu::ScratchKe
     SkASSERT(scratchKey.isValid());
 
     GrGpuResource* resource = fScratchMap.find(scratchKey);
+    TRACE_CACHE_LOOKUP("skia.gpu.cache", "GrResourceCache scratch lookups", resource != nullptr);
     if (resource) {
         fScratchMap.remove(scratchKey, resource);
         this->refAndMakeResourceMRU(resource);
@@ -297,7 +298,7 @@ void GrResourceCache::refAndMakeResourceMRU(GrGpuResource* resource) {
     if (resource->resourcePriv().isPurgeable()) {
         // It's about to become unpurgeable.
         fPurgeableBytes -= resource->gpuMemorySize();
-        fPurgeableQueue.remove(resource);
+        this->removeFromPurgeableList(resource);
         this->addToNonpurgeableArray(resource);
     } else if (!resource->cacheAccess().hasRefOrCommandBufferUsage() &&
                resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted) {
@@ -317,7 +318,7 @@ void GrResourceCache::notifyARefCntReachedZero(GrGpuResource* resource,
     SkASSERT(!resource->wasDestroyed());
     SkASSERT(this->isInCache(resource));
     // This resource should always be in the nonpurgeable array when this function is called. It
-    // will be moved to the queue if it is newly purgeable.
+    // will be moved to the purgeable list if it is newly purgeable.
     SkASSERT(fNonpurgeableResources[*resource->cacheAccess().accessCacheIndex()] == resource);
 
     if (removedRef == GrGpuResource::LastRemovedRef::kMainRef) {
@@ -334,7 +335,7 @@ void GrResourceCache::notifyARefCntReachedZero(GrGpuResource* resource,
 #ifdef SK_DEBUG
     // When the timestamp overflows validate() is called. validate() checks that resources in
     // the nonpurgeable array are indeed not purgeable. However, the movement from the array to
-    // the purgeable queue happens just below in this function. So we mark it as an exception.
+    // the purgeable list happens just below in this function. So we mark it as an exception.
     if (resource->resourcePriv().isPurgeable()) {
         fNewlyPurgeableResourceForValidation = resource;
     }
@@ -353,7 +354,7 @@ void GrResourceCache::notifyARefCntReachedZero(GrGpuResource* resource,
     }
 
     this->removeFromNonpurgeableArray(resource);
-    fPurgeableQueue.insert(resource);
+    this->addToPurgeableList(resource);
     resource->cacheAccess().setTimeWhenResourceBecomePurgeable();
     fPurgeableBytes += resource->gpuMemorySize();
 
@@ -369,7 +370,7 @@ void GrResourceCache::notifyARefCntReachedZero(GrGpuResource* resource,
             return;
         }
     } else {
-        // We keep unbudgeted resources with a unique key in the purgeable queue of the cache so
+        // We keep unbudgeted resources with a unique key in the purgeable list of the cache so
         // they can be reused again by the image connected to the unique key.
         if (hasUniqueKey && budgetedType == GrBudgetedType::kUnbudgetedCacheable) {
             return;
@@ -460,8 +461,8 @@ void GrResourceCache::purgeAsNeeded() {
     this->processFreedGpuResources();
 
     bool stillOverbudget = this->overBudget();
-    while (stillOverbudget && fPurgeableQueue.count()) {
-        GrGpuResource* resource = fPurgeableQueue.peek();
+    while (stillOverbudget && !fPurgeableList.isEmpty()) {
+        GrGpuResource* resource = fPurgeableList.head();
         SkASSERT(resource->resourcePriv().isPurgeable());
         resource->cacheAccess().release();
         stillOverbudget = this->overBudget();
@@ -471,8 +472,8 @@ void GrResourceCache::purgeAsNeeded() {
         fThreadSafeCache->dropUniqueRefs(this);
 
         stillOverbudget = this->overBudget();
-        while (stillOverbudget && fPurgeableQueue.count()) {
-            GrGpuResource* resource = fPurgeableQueue.peek();
+        while (stillOverbudget && !fPurgeableList.isEmpty()) {
+            GrGpuResource* resource = fPurgeableList.head();
             SkASSERT(resource->resourcePriv().isPurgeable());
             resource->cacheAccess().release();
             stillOverbudget = this->overBudget();
@@ -491,10 +492,8 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
             fThreadSafeCache->dropUniqueRefs(nullptr);
         }
 
-        // We could disable maintaining the heap property here, but it would add a lot of
-        // complexity. Moreover, this is rarely called.
-        while (fPurgeableQueue.count()) {
-            GrGpuResource* resource = fPurgeableQueue.peek();
+        while (!fPurgeableList.isEmpty()) {
+            GrGpuResource* resource = fPurgeableList.head();
 
             const skgpu::StdSteadyClock::time_point resourceTime =
                     resource->cacheAccess().timeWhenResourceBecamePurgeable();
@@ -502,7 +501,7 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
                 // Resources were given both LRU timestamps and tagged with a frame number when
                 // they first became purgeable. The LRU timestamp won't change again until the
                 // resource is made non-purgeable again. So, at this point all the remaining
-                // resources in the timestamp-sorted queue will have a frame number >= to this
+                // resources in the timestamp-sorted list will have a frame number >= to this
                 // one.
                 break;
             }
@@ -512,21 +511,9 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
         }
     } else {
         SkASSERT(opts == GrPurgeResourceOptions::kScratchResourcesOnly);
-        // Early out if the very first item is too new to purge to avoid sorting the queue when
-        // nothing will be deleted.
-        if (purgeTime && fPurgeableQueue.count() &&
-            fPurgeableQueue.peek()->cacheAccess().timeWhenResourceBecamePurgeable() >= *purgeTime) {
-            return;
-        }
-
-        // Sort the queue
-        fPurgeableQueue.sort();
-
         // Make a list of the scratch resources to delete
         SkTDArray<GrGpuResource*> scratchResources;
-        for (int i = 0; i < fPurgeableQueue.count(); i++) {
-            GrGpuResource* resource = fPurgeableQueue.at(i);
-
+        for (GrGpuResource* resource : fPurgeableList) {
             const skgpu::StdSteadyClock::time_point resourceTime =
                     resource->cacheAccess().timeWhenResourceBecamePurgeable();
             if (purgeTime && resourceTime >= *purgeTime) {
@@ -539,8 +526,8 @@ void GrResourceCache::purgeUnlockedResources(const skgpu::StdSteadyClock::time_p
             }
         }
 
-        // Delete the scratch resources. This must be done as a separate pass
-        // to avoid messing up the sorted order of the queue
+        // Delete the scratch resources. This must be done as a separate pass, since releasing
+        // resources changes the list.
         for (int i = 0; i < scratchResources.size(); i++) {
             scratchResources[i]->cacheAccess().release();
         }
@@ -557,35 +544,23 @@ bool GrResourceCache::purgeToMakeHeadroom(size_t desiredHeadroomBytes) {
     if (this->wouldFit(desiredHeadroomBytes)) {
         return true;
     }
-    fPurgeableQueue.sort();
-
     size_t projectedBudget = fBudgetedBytes;
-    int purgeCnt = 0;
-    for (int i = 0; i < fPurgeableQueue.count(); i++) {
-        GrGpuResource* resource = fPurgeableQueue.at(i);
+    // Copy to an array first so we don't mess with the list.
+    std::vector<GrGpuResource*> resources;
+    for (GrGpuResource* resource : fPurgeableList) {
         if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
             projectedBudget -= resource->gpuMemorySize();
         }
+        resources.push_back(resource);
         if (projectedBudget + desiredHeadroomBytes <= fMaxBytes) {
-            purgeCnt = i + 1;
-            break;
+            // Success! Release the resources.
+            for (GrGpuResource* r : resources) {
+                r->cacheAccess().release();
+            }
+            return true;
         }
     }
-    if (purgeCnt == 0) {
-        return false;
-    }
-
-    // Success! Release the resources.
-    // Copy to array first so we don't mess with the queue.
-    std::vector<GrGpuResource*> resources;
-    resources.reserve(purgeCnt);
-    for (int i = 0; i < purgeCnt; i++) {
-        resources.push_back(fPurgeableQueue.at(i));
-    }
-    for (GrGpuResource* resource : resources) {
-        resource->cacheAccess().release();
-    }
-    return true;
+    return false;
 }
 
 void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScratchResources) {
@@ -594,14 +569,13 @@ void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScr
     bool stillOverbudget = tmpByteBudget < fBytes;
 
     if (preferScratchResources && bytesToPurge < fPurgeableBytes) {
-        // Sort the queue
-        fPurgeableQueue.sort();
-
         // Make a list of the scratch resources to delete
         SkTDArray<GrGpuResource*> scratchResources;
         size_t scratchByteCount = 0;
-        for (int i = 0; i < fPurgeableQueue.count() && stillOverbudget; i++) {
-            GrGpuResource* resource = fPurgeableQueue.at(i);
+        for (GrGpuResource* resource : fPurgeableList) {
+            if (!stillOverbudget) {
+                break;
+            }
             SkASSERT(resource->resourcePriv().isPurgeable());
             if (!resource->getUniqueKey().isValid()) {
                 *scratchResources.append() = resource;
@@ -610,8 +584,8 @@ void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScr
             }
         }
 
-        // Delete the scratch resources. This must be done as a separate pass
-        // to avoid messing up the sorted order of the queue
+        // Delete the scratch resources. This must be done as a separate pass, since releasing
+        // resources changes the list.
         for (int i = 0; i < scratchResources.size(); i++) {
             scratchResources[i]->cacheAccess().release();
         }
@@ -630,7 +604,7 @@ void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScr
 }
 
 bool GrResourceCache::requestsFlush() const {
-    return this->overBudget() && !fPurgeableQueue.count() &&
+    return this->overBudget() && fPurgeableList.isEmpty() &&
            fNumBudgetedResourcesFlushWillMakePurgeable > 0;
 }
 
@@ -658,6 +632,19 @@ void GrResourceCache::removeFromNonpurgeableArray(GrGpuResource* resource) {
     SkDEBUGCODE(*index = -1);
 }
 
+void GrResourceCache::addToPurgeableList(GrGpuResource* resource) {
+    // Resources get a new timestamp as they become purgeable, so this one is the most recent.
+    SkASSERT(fPurgeableList.isEmpty() || CompareTimestamp(fPurgeableList.tail(), resource));
+    SkASSERT(*resource->cacheAccess().accessCacheIndex() == -1);
+    fPurgeableList.addToTail(resource);
+    ++fPurgeableCount;
+}
+
+void GrResourceCache::removeFromPurgeableList(GrGpuResource* resource) {
+    fPurgeableList.remove(resource);
+    --fPurgeableCount;
+}
+
 uint32_t GrResourceCache::getNextTimestamp() {
     // If we wrap then all the existing resources will appear older than any resources that get
     // a timestamp after the wrap.
@@ -667,12 +654,11 @@ uint32_t GrResourceCache::getNextTimestamp() {
             // Reset all the timestamps. We sort the resources by timestamp and then assign
             // sequential timestamps beginning with 0. This is O(n*lg(n)) but it should be extremely
             // rare.
+            // The purgeable resources are already in order.
             SkTDArray<GrGpuResource*> sortedPurgeableResources;
-            sortedPurgeableResources.reserve(fPurgeableQueue.count());
-
-            while (fPurgeableQueue.count()) {
-                *sortedPurgeableResources.append() = fPurgeableQueue.peek();
-                fPurgeableQueue.pop();
+            sortedPurgeableResources.reserve(fPurgeableCount);
+            for (GrGpuResource* resource : fPurgeableList) {
+                *sortedPurgeableResources.append() = resource;
             }
 
             SkTQSort(fNonpurgeableResources.begin(), fNonpurgeableResources.end(),
@@ -705,11 +691,6 @@ uint32_t GrResourceCache::getNextTimestamp() {
                 fNonpurgeableResources[currNP++]->cacheAccess().setTimestamp(fTimestamp++);
             }
 
-            // Rebuild the queue.
-            for (int i = 0; i < sortedPurgeableResources.size(); ++i) {
-                fPurgeableQueue.insert(sortedPurgeableResources[i]);
-            }
-
             this->validate();
             SkASSERT(count == this->getResourceCount());
 
@@ -724,8 +705,8 @@ void GrResourceCache::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) c
     for (int i = 0; i < fNonpurgeableResources.size(); ++i) {
         fNonpurgeableResources[i]->dumpMemoryStatistics(traceMemoryDump);
     }
-    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
-        fPurgeableQueue.at(i)->dumpMemoryStatistics(traceMemoryDump);
+    for (GrGpuResource* resource : fPurgeableList) {
+        resource->dumpMemoryStatistics(traceMemoryDump);
     }
 }
 
@@ -735,13 +716,13 @@ void GrResourceCache::getStats(Stats* stats) const {
 
     stats->fTotal = this->getResourceCount();
     stats->fNumNonPurgeable = fNonpurgeableResources.size();
-    stats->fNumPurgeable = fPurgeableQueue.count();
+    stats->fNumPurgeable = fPurgeableCount;
 
     for (int i = 0; i < fNonpurgeableResources.size(); ++i) {
         stats->update(fNonpurgeableResources[i]);
     }
-    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
-        stats->update(fPurgeableQueue.at(i));
+    for (GrGpuResource* resource : fPurgeableList) {
+        stats->update(resource);
     }
 }
 
@@ -865,13 +846,20 @@ void GrResourceCache::validate() const {
         }
         stats.update(fNonpurgeableResources[i]);
     }
-    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
-        SkASSERT(fPurgeableQueue.at(i)->resourcePriv().isPurgeable());
-        SkASSERT(*fPurgeableQueue.at(i)->cacheAccess().accessCacheIndex() == i);
-        SkASSERT(!fPurgeableQueue.at(i)->wasDestroyed());
-        stats.update(fPurgeableQueue.at(i));
-        purgeableBytes += fPurgeableQueue.at(i)->gpuMemorySize();
+    fPurgeableList.validate();
+    int purgeableCount = 0;
+    GrGpuResource* prev = nullptr;
+    for (GrGpuResource* resource : fPurgeableList) {
+        SkASSERT(resource->resourcePriv().isPurgeable());
+        SkASSERT(*resource->cacheAccess().accessCacheIndex() == -1);
+        SkASSERT(!resource->wasDestroyed());
+        SkASSERT(!prev || CompareTimestamp(prev, resource));
+        stats.update(resource);
+        purgeableBytes += resource->gpuMemorySize();
+        ++purgeableCount;
+        prev = resource;
     }
+    SkASSERT(purgeableCount == fPurgeableCount);
 
     SkASSERT(fCount == this->getResourceCount());
     SkASSERT(fBudgetedCount <= fCount);
@@ -900,13 +888,13 @@ void GrResourceCache::validate() const {
 }
 
 bool GrResourceCache::isInCache(const GrGpuResource* resource) const {
+    if (fPurgeableList.isInList(resource)) {
+        return true;
+    }
     int index = *resource->cacheAccess().accessCacheIndex();
     if (index < 0) {
         return false;
     }
-    if (index < fPurgeableQueue.count() && fPurgeableQueue.at(index) == resource) {
-        return true;
-    }
     if (index < fNonpurgeableResources.size() && fNonpurgeableResources[index] == resource) {
         return true;
     }
@@ -940,8 +928,8 @@ void GrResourceCache::visitSurfaces(
             func(surf, /* purgeable= */ false);
         }
     }
-    for (int i = 0; i < fPurgeableQueue.count(); ++i) {
-        if (const GrSurface* surf = fPurgeableQueue.at(i)->asSurface()) {
+    for (GrGpuResource* resource : fPurgeableList) {
+        if (const GrSurface* surf = resource->asSurface()) {
             func(surf, /* purgeable= */ true);
         }
     }
@@ -12,7 +12,6 @@
 #include "include/core/SkTypes.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/base/SkTArray.h"
-#include "src/base/SkTDPQueue.h"
 #include "src/base/SkTInternalLList.h"
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkTHash.h"
@@ -93,7 +92,7 @@ public:
      * Returns the number of resources.
      */
     int getResourceCount() const {
-        return fPurgeableQueue.count() + fNonpurgeableResources.size();
+        return fPurgeableCount + fNonpurgeableResources.size();
     }
 
     /**
@@ -311,6 +310,8 @@ private:
     void processFreedGpuResources();
     void addToNonpurgeableArray(GrGpuResource*);
     void removeFromNonpurgeableArray(GrGpuResource*);
+    void addToPurgeableList(GrGpuResource*);
+    void removeFromPurgeableList(GrGpuResource*);
 
     bool wouldFit(size_t bytes) const { return fBudgetedBytes+bytes <= fMaxBytes; }
 
@@ -349,22 +350,20 @@ private:
         return a->cacheAccess().timestamp() < b->cacheAccess().timestamp();
     }
 
-    static int* AccessResourceIndex(GrGpuResource* const& res) {
-        return res->cacheAccess().accessCacheIndex();
-    }
-
     typedef SkMessageBus<skgpu::UniqueKeyInvalidatedMessage, uint32_t>::Inbox InvalidUniqueKeyInbox;
-    typedef SkTDPQueue<GrGpuResource*, CompareTimestamp, AccessResourceIndex> PurgeableQueue;
+    typedef SkTInternalLList<GrGpuResource> PurgeableList;
     typedef SkTDArray<GrGpuResource*> ResourceArray;
 
     GrProxyProvider*                    fProxyProvider = nullptr;
     GrThreadSafeCache*                  fThreadSafeCache = nullptr;
 
     // Whenever a resource is added to the cache or the result of a cache lookup, fTimestamp is
-    // assigned as the resource's timestamp and then incremented. fPurgeableQueue orders the
-    // purgeable resources by this value, and thus is used to purge resources in LRU order.
+    // assigned as the resource's timestamp and then incremented. Resources also get a new
+    // timestamp as they become purgeable, so appending them to fPurgeableList keeps it sorted by
+    // this value, and it is used to purge resources in LRU order without a priority queue.
     uint32_t                            fTimestamp = 0;
-    PurgeableQueue                      fPurgeableQueue;
+    PurgeableList                       fPurgeableList;
+    int                                 fPurgeableCount = 0;
     ResourceArray                       fNonpurgeableResources;
 
     // This map holds all resources that can be used as scratch resources.
@@ -51,7 +51,11 @@ PathRendererChain::PathRendererChain(GrRecordingContext* context, const Options&
     }
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
     if (options.fGpuPathRenderers & GpuPathRenderers::kSmall) {
-        fChain.push_back(sk_make_sp<SmallPathRenderer>());
+        auto smallPathRenderer = sk_make_sp<SmallPathRenderer>();
+        if (fAtlasPathRenderer) {
+            fAtlasPathRenderer->setRepeatedPathRenderer(smallPathRenderer.get());
+        }
+        fChain.push_back(std::move(smallPathRenderer));
     }
     if (options.fGpuPathRenderers & GpuPathRenderers::kTriangulating) {
         fChain.push_back(sk_make_sp<TriangulatingPathRenderer>());
@@ -29,15 +29,16 @@ public:
     static int PathToAATriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
                                  GrEagerVertexAllocator* vertexAllocator) {
         SkArenaAlloc alloc(kArenaDefaultChunkSize);
-        GrAATriangulator aaTriangulator(path, &alloc);
-        aaTriangulator.fRoundVerticesToQuarterPixel = true;
-        aaTriangulator.fEmitCoverage = true;
-        bool isLinear;
-        auto [ polys, success ] = aaTriangulator.pathToPolys(tolerance, clipBounds, &isLinear);
-        if (!success) {
-            return 0;
-        }
-        return aaTriangulator.polysToAATriangles(polys, vertexAllocator);
+        return PathToAATrianglesInArena(path, tolerance, clipBounds, vertexAllocator, &alloc);
+    }
+
+    // Same as above, but builds the mesh in 'scratch', which is reset before returning.
+    static int PathToAATriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                                 GrEagerVertexAllocator* vertexAllocator,
+                                 SkArenaAllocWithReset* scratch) {
+        int count = PathToAATrianglesInArena(path, tolerance, clipBounds, vertexAllocator, scratch);
+        scratch->reset();
+        return count;
     }
 
     // Structs used by GrAATriangulator internals.
@@ -64,6 +65,21 @@ public:
 private:
     GrAATriangulator(const SkPath& path, SkArenaAlloc* alloc) : GrTriangulator(path, alloc) {}
 
+    static int PathToAATrianglesInArena(const SkPath& path, SkScalar tolerance,
+                                        const SkRect& clipBounds,
+                                        GrEagerVertexAllocator* vertexAllocator,
+                                        SkArenaAlloc* alloc) {
+        GrAATriangulator aaTriangulator(path, alloc);
+        aaTriangulator.fRoundVerticesToQuarterPixel = true;
+        aaTriangulator.fEmitCoverage = true;
+        bool isLinear;
+        auto [ polys, success ] = aaTriangulator.pathToPolys(tolerance, clipBounds, &isLinear);
+        if (!success) {
+            return 0;
+        }
+        return aaTriangulator.polysToAATriangles(polys, vertexAllocator);
+    }
+
     // For screenspace antialiasing, the algorithm is modified as follows:
     //
     // Run steps 1-5 above to produce polygons.
@@ -169,6 +169,12 @@ public:
     // Can this shape be drawn as a pair of filled nested rectangles?
     bool asNestedRects(SkRect rects[2]) const;
 
+    /**
+     * Is the unstyled geometry a path? Other shapes are converted to a new path, with a new genID,
+     * on every call to asPath().
+     */
+    bool isPath() const { return fShape.isPath(); }
+
     /** Returns the unstyled geometry as a path. */
     void asPath(SkPath* out) const {
         fShape.asPath(out, fStyle.isSimpleFill());
@@ -1694,6 +1694,14 @@ std::tuple<Poly*, bool> GrTriangulator::contoursToPolys(VertexList* contours, in
     this->mergeCoincidentVertices(&mesh, c);
     TESS_LOG("\nsorted+merged mesh:\n");
     DUMP_MESH(mesh);
+    // A single convex polygon can't intersect itself, so the mesh is already simple and goes
+    // straight to the monotone tessellation. This doesn't hold for curves, whose flattened points
+    // can fold back at the joins, or once the vertices are rounded.
+    if (contourCnt == 1 && !fRoundVerticesToQuarterPixel &&
+        fPath.getSegmentMasks() == SkPath::kLine_SegmentMask && fPath.isConvex()) {
+        TESS_LOG("\nconvex contour, skipping simplification\n");
+        return this->tessellate(mesh, c);
+    }
     auto result = this->simplify(&mesh, c);
     if (result == SimplifyResult::kFailed) {
         return { nullptr, false };
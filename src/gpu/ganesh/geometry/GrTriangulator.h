@@ -38,16 +38,20 @@ public:
 
     static int PathToTriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
                                GrEagerVertexAllocator* vertexAllocator, bool* isLinear) {
-        if (!path.isFinite()) {
-            return 0;
-        }
         SkArenaAlloc alloc(kArenaDefaultChunkSize);
-        GrTriangulator triangulator(path, &alloc);
-        auto [ polys, success ] = triangulator.pathToPolys(tolerance, clipBounds, isLinear);
-        if (!success) {
-            return 0;
-        }
-        int count = triangulator.polysToTriangles(polys, vertexAllocator);
+        return PathToTrianglesInArena(path, tolerance, clipBounds, vertexAllocator, isLinear,
+                                      &alloc);
+    }
+
+    // Same as above, but builds the mesh in 'scratch', which is reset before returning. Callers
+    // that triangulate many paths can pass the same arena each time, so that its first block is
+    // reused instead of allocating a new one per path.
+    static int PathToTriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                               GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                               SkArenaAllocWithReset* scratch) {
+        int count = PathToTrianglesInArena(path, tolerance, clipBounds, vertexAllocator, isLinear,
+                                           scratch);
+        scratch->reset();
         return count;
     }
 
@@ -200,6 +204,24 @@ protected:
     static int64_t CountPoints(Poly* polys, SkPathFillType overrideFillType);
     int polysToTriangles(Poly*, GrEagerVertexAllocator*) const;
 
+private:
+    static int PathToTrianglesInArena(const SkPath& path, SkScalar tolerance,
+                                      const SkRect& clipBounds,
+                                      GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                                      SkArenaAlloc* alloc) {
+        if (!path.isFinite()) {
+            return 0;
+        }
+        GrTriangulator triangulator(path, alloc);
+        auto [ polys, success ] = triangulator.pathToPolys(tolerance, clipBounds, isLinear);
+        if (!success) {
+            return 0;
+        }
+        int count = triangulator.polysToTriangles(polys, vertexAllocator);
+        return count;
+    }
+
+protected:
     // FIXME: fPath should be plumbed through function parameters instead.
     const SkPath fPath;
     SkArenaAlloc* const fAlloc;
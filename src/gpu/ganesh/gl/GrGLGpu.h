@@ -223,6 +223,11 @@ public:
         return fProgramCache->precompileShader(this->getContext(), key, data);
     }
 
+    int precompileShaders(SkSpan<const sk_sp<SkData>> keys,
+                          SkSpan<const sk_sp<SkData>> data) override {
+        return fProgramCache->precompileShaders(this->getContext(), keys, data);
+    }
+
 #if defined(GR_TEST_UTILS)
     bool isTestingOnlyBackendTexture(const GrBackendTexture&) const override;
 
@@ -476,6 +481,9 @@ private:
                                                const GrProgramInfo&,
                                                Stats::ProgramCacheResult*);
         bool precompileShader(GrDirectContext*, const SkData& key, const SkData& data);
+        int precompileShaders(GrDirectContext*,
+                              SkSpan<const sk_sp<SkData>> keys,
+                              SkSpan<const sk_sp<SkData>> data);
 
     private:
         struct Entry;
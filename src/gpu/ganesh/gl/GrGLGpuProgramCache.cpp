@@ -11,6 +11,8 @@
 
 #include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
 #include "src/gpu/ganesh/GrProcessor.h"
@@ -64,6 +66,8 @@ sk_sp<GrGLProgram> GrGLGpu::ProgramCache::findOrCreateProgram(GrDirectContext* d
         fStats.incNumInlineCompilationFailures();
     } else {
         fStats.incNumInlineProgramCacheResult(stat);
+        TRACE_CACHE_LOOKUP("skia.gpu.cache", "GrGLProgram cache lookups",
+                           stat == Stats::ProgramCacheResult::kHit);
     }
 
     return tmp;
@@ -140,3 +144,61 @@ bool GrGLGpu::ProgramCache::precompileShader(GrDirectContext* dContext,
     fMap.insert(desc, std::make_unique<Entry>(precompiledProgram));
     return true;
 }
+
+int GrGLGpu::ProgramCache::precompileShaders(GrDirectContext* dContext,
+                                             SkSpan<const sk_sp<SkData>> keys,
+                                             SkSpan<const sk_sp<SkData>> data) {
+    SkASSERT(keys.size() == data.size());
+
+    struct Pending {
+        GrProgramDesc         fDesc;
+        const SkData*         fData;
+        GrGLTranslatedProgram fTranslated;
+        bool                  fTranslatedOK = false;
+    };
+
+    int count = 0;
+    skia_private::TArray<Pending> pending;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        GrProgramDesc desc;
+        if (!GrProgramDesc::BuildFromData(&desc, keys[i]->data(), keys[i]->size())) {
+            continue;
+        }
+        if (fMap.find(desc)) {
+            // We've already seen/compiled this shader
+            ++count;
+            continue;
+        }
+        pending.push_back({std::move(desc), data[i].get(), {}});
+    }
+
+    // Translating SkSL to GLSL doesn't need the GL context, so it can happen on other threads.
+    auto translate = [dContext](Pending* p) {
+        p->fTranslatedOK = GrGLProgramBuilder::TranslateCachedProgram(dContext, *p->fData,
+                                                                      &p->fTranslated);
+    };
+    if (SkTaskGroup* taskGroup = dContext->priv().getTaskGroup(); taskGroup && pending.size() > 1) {
+        for (Pending& p : pending) {
+            taskGroup->add([&translate, &p] { translate(&p); });
+        }
+        taskGroup->wait();
+    } else {
+        for (Pending& p : pending) {
+            translate(&p);
+        }
+    }
+
+    for (Pending& p : pending) {
+        // The same program may appear more than once in the batch.
+        if (!p.fTranslatedOK || fMap.find(p.fDesc)) {
+            count += p.fTranslatedOK ? 1 : 0;
+            continue;
+        }
+        GrGLPrecompiledProgram precompiledProgram;
+        if (GrGLProgramBuilder::PrecompileProgram(dContext, &precompiledProgram, p.fTranslated)) {
+            fMap.insert(p.fDesc, std::make_unique<Entry>(precompiledProgram));
+            ++count;
+        }
+    }
+    return count;
+}
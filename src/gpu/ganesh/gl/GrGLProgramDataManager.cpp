@@ -10,6 +10,9 @@
 #include "src/gpu/ganesh/gl/GrGLProgramDataManager.h"
 #include "src/gpu/ganesh/glsl/GrGLSLUniformHandler.h"
 
+#include <algorithm>
+#include <cstring>
+
 #define ASSERT_ARRAY_UPLOAD_IN_BOUNDS(UNI, COUNT) \
          SkASSERT((COUNT) <= (UNI).fArrayCount || \
                   (1 == (COUNT) && GrShaderVar::kNonArray == (UNI).fArrayCount))
@@ -18,6 +21,7 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, const UniformInfoAr
         : fGpu(gpu) {
     fUniforms.push_back_n(uniforms.count());
     int i = 0;
+    int shadowWordCount = 0;
     for (const GLUniformInfo& builderUniform : uniforms.items()) {
         Uniform& uniform = fUniforms[i++];
         SkASSERT(GrShaderVar::kNonArray == builderUniform.fVariable.getArrayCount() ||
@@ -27,7 +31,40 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, const UniformInfoAr
             uniform.fType = builderUniform.fVariable.getType();
         )
         uniform.fLocation = builderUniform.fLocation;
+
+        // Each element of the uniform takes as many 32-bit words as it has components.
+        SkSLType type = builderUniform.fVariable.getType();
+        int matrixSize = SkSLTypeMatrixSize(type);
+        int elementWordCount = matrixSize > 0 ? matrixSize * matrixSize : SkSLTypeVecLength(type);
+        SkASSERT(elementWordCount > 0);
+        uniform.fShadowOffset = shadowWordCount;
+        shadowWordCount += elementWordCount *
+                           std::max(builderUniform.fVariable.getArrayCount(), 1);
+    }
+    fShadowValues.push_back_n(shadowWordCount, 0u);
+    fUploadedWordCounts.push_back_n(fUniforms.size(), 0);
+}
+
+bool GrGLProgramDataManager::needsUpload(UniformHandle u,
+                                         const void* values,
+                                         int wordCount) const {
+    const Uniform& uni = fUniforms[u.toIndex()];
+    if (kUnusedUniform == uni.fLocation) {
+        return false;
+    }
+    // Uniform values are part of the GL program object, so they are still set from the last time
+    // this program was used. Only the first 'uploadedWordCount' words of the shadow are known.
+    uint32_t* shadow = fShadowValues.begin() + uni.fShadowOffset;
+    int& uploadedWordCount = fUploadedWordCounts[u.toIndex()];
+    size_t size = wordCount * sizeof(uint32_t);
+    if (wordCount <= uploadedWordCount && !memcmp(shadow, values, size)) {
+        fGpu->stats()->incNumUniformUploadsSkipped();
+        return false;
     }
+    memcpy(shadow, values, size);
+    uploadedWordCount = std::max(uploadedWordCount, wordCount);
+    fGpu->stats()->incNumUniformUploads();
+    return true;
 }
 
 void GrGLProgramDataManager::setSamplerUniforms(const UniformInfoArray& samplers,
@@ -46,7 +83,8 @@ void GrGLProgramDataManager::set1i(UniformHandle u, int32_t i) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kInt || uni.fType == SkSLType::kShort);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i};
+    if (this->needsUpload(u, v, 1)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1i(uni.fLocation, i));
     }
 }
@@ -58,7 +96,7 @@ void GrGLProgramDataManager::set1iv(UniformHandle u,
     SkASSERT(uni.fType == SkSLType::kInt || uni.fType == SkSLType::kShort);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -67,7 +105,8 @@ void GrGLProgramDataManager::set1f(UniformHandle u, float v0) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kFloat || uni.fType == SkSLType::kHalf);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0};
+    if (this->needsUpload(u, v, 1)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1f(uni.fLocation, v0));
     }
 }
@@ -83,7 +122,7 @@ void GrGLProgramDataManager::set1fv(UniformHandle u,
     // Once the uniform manager is responsible for inserting the duplicate uniform
     // arrays in VS and FS driver bug workaround, this can be enabled.
     // this->printUni(uni);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -92,7 +131,8 @@ void GrGLProgramDataManager::set2i(UniformHandle u, int32_t i0, int32_t i1) cons
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kInt2 || uni.fType == SkSLType::kShort2);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1};
+    if (this->needsUpload(u, v, 2)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2i(uni.fLocation, i0, i1));
     }
 }
@@ -104,7 +144,7 @@ void GrGLProgramDataManager::set2iv(UniformHandle u,
     SkASSERT(uni.fType == SkSLType::kInt2 || uni.fType == SkSLType::kShort2);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, 2 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -113,7 +153,8 @@ void GrGLProgramDataManager::set2f(UniformHandle u, float v0, float v1) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kFloat2 || uni.fType == SkSLType::kHalf2);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1};
+    if (this->needsUpload(u, v, 2)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2f(uni.fLocation, v0, v1));
     }
 }
@@ -125,7 +166,7 @@ void GrGLProgramDataManager::set2fv(UniformHandle u,
     SkASSERT(uni.fType == SkSLType::kFloat2 || uni.fType == SkSLType::kHalf2);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, 2 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -134,7 +175,8 @@ void GrGLProgramDataManager::set3i(UniformHandle u, int32_t i0, int32_t i1, int3
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kInt3 || uni.fType == SkSLType::kShort3);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1, i2};
+    if (this->needsUpload(u, v, 3)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3i(uni.fLocation, i0, i1, i2));
     }
 }
@@ -146,7 +188,7 @@ void GrGLProgramDataManager::set3iv(UniformHandle u,
     SkASSERT(uni.fType == SkSLType::kInt3 || uni.fType == SkSLType::kShort3);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, 3 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -155,7 +197,8 @@ void GrGLProgramDataManager::set3f(UniformHandle u, float v0, float v1, float v2
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kFloat3 || uni.fType == SkSLType::kHalf3);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1, v2};
+    if (this->needsUpload(u, v, 3)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3f(uni.fLocation, v0, v1, v2));
     }
 }
@@ -167,7 +210,7 @@ void GrGLProgramDataManager::set3fv(UniformHandle u,
     SkASSERT(uni.fType == SkSLType::kFloat3 || uni.fType == SkSLType::kHalf3);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, 3 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -180,7 +223,8 @@ void GrGLProgramDataManager::set4i(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kInt4 || uni.fType == SkSLType::kShort4);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1, i2, i3};
+    if (this->needsUpload(u, v, 4)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4i(uni.fLocation, i0, i1, i2, i3));
     }
 }
@@ -192,7 +236,7 @@ void GrGLProgramDataManager::set4iv(UniformHandle u,
     SkASSERT(uni.fType == SkSLType::kInt4 || uni.fType == SkSLType::kShort4);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, 4 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -205,7 +249,8 @@ void GrGLProgramDataManager::set4f(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == SkSLType::kFloat4 || uni.fType == SkSLType::kHalf4);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1, v2, v3};
+    if (this->needsUpload(u, v, 4)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4f(uni.fLocation, v0, v1, v2, v3));
     }
 }
@@ -217,7 +262,7 @@ void GrGLProgramDataManager::set4fv(UniformHandle u,
     SkASSERT(uni.fType == SkSLType::kFloat4 || uni.fType == SkSLType::kHalf4);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, v, 4 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -256,7 +301,7 @@ template<int N> inline void GrGLProgramDataManager::setMatrices(UniformHandle u,
              static_cast<int>(uni.fType) == static_cast<int>(SkSLType::kHalf2x2) + (N - 2));
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (this->needsUpload(u, matrices, N * N * arrayCount)) {
         set_uniform_matrix<N>::set(fGpu->glInterface(), uni.fLocation, arrayCount, matrices);
     }
 }
@@ -80,16 +80,27 @@ private:
 
     struct Uniform {
         GrGLint     fLocation;
+        // Where the last uploaded value of the uniform is kept in fShadowValues.
+        int         fShadowOffset;
 #ifdef SK_DEBUG
         SkSLType    fType;
         int         fArrayCount;
 #endif
     };
 
+    // Returns whether 'wordCount' 32-bit words at 'values' must be sent to the uniform, which is
+    // false if it is unused or already holds them. Otherwise they are recorded as its new value.
+    bool needsUpload(UniformHandle, const void* values, int wordCount) const;
+
     template<int N> inline void setMatrices(UniformHandle, int arrayCount,
                                             const float matrices[]) const;
 
     skia_private::TArray<Uniform, true> fUniforms;
+    // A copy of each uniform's value in the GL program, used to skip redundant glUniform* calls.
+    // The set* functions are const, so these are mutable.
+    mutable skia_private::TArray<uint32_t, true> fShadowValues;
+    // How many words at the start of each uniform's shadow value are known to match the program.
+    mutable skia_private::TArray<int, true> fUploadedWordCounts;
     GrGLGpu* fGpu;
 
     using INHERITED = GrGLSLProgramDataManager;
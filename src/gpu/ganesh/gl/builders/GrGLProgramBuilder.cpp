@@ -453,6 +453,14 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::createProgram(GrGLuint programID) {
 bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
                                            GrGLPrecompiledProgram* precompiledProgram,
                                            const SkData& cachedData) {
+    GrGLTranslatedProgram translatedProgram;
+    return TranslateCachedProgram(dContext, cachedData, &translatedProgram) &&
+           PrecompileProgram(dContext, precompiledProgram, translatedProgram);
+}
+
+bool GrGLProgramBuilder::TranslateCachedProgram(GrDirectContext* dContext,
+                                                const SkData& cachedData,
+                                                GrGLTranslatedProgram* translatedProgram) {
     SkReadBuffer reader(cachedData.data(), cachedData.size());
     SkFourByteTag shaderType = GrPersistentCacheUtils::GetType(&reader);
     if (shaderType != kSKSL_Tag) {
@@ -460,9 +468,7 @@ bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
         return false;
     }
 
-    GrGLGpu* glGpu = static_cast<GrGLGpu*>(dContext->priv().getGpu());
-
-    const GrGLInterface* gl = glGpu->glInterface();
+    const GrGLGpu* glGpu = static_cast<GrGLGpu*>(dContext->priv().getGpu());
     auto errorHandler = dContext->priv().getShaderErrorHandler();
 
     SkSL::ProgramSettings settings;
@@ -471,11 +477,40 @@ bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
     meta.fSettings = &settings;
 
     std::string shaders[kGrShaderTypeCount];
-    SkSL::Program::Interface interface;
-    if (!GrPersistentCacheUtils::UnpackCachedShaders(&reader, shaders, &interface, 1, &meta)) {
+    if (!GrPersistentCacheUtils::UnpackCachedShaders(&reader, shaders,
+                                                     &translatedProgram->fInterface, 1, &meta)) {
+        return false;
+    }
+
+    auto translateShader = [&](SkSL::ProgramKind kind, GrShaderType type) {
+        SkSL::Program::Interface unusedInterface;
+        return skgpu::SkSLToGLSL(glGpu->caps()->shaderCaps(),
+                                 shaders[type],
+                                 kind,
+                                 settings,
+                                 &translatedProgram->fGLSL[type],
+                                 &unusedInterface,
+                                 errorHandler);
+    };
+
+    if (!translateShader(SkSL::ProgramKind::kFragment, kFragment_GrShaderType) ||
+        !translateShader(SkSL::ProgramKind::kVertex, kVertex_GrShaderType)) {
         return false;
     }
 
+    translatedProgram->fAttributeNames = std::move(meta.fAttributeNames);
+    translatedProgram->fHasSecondaryColorOutput = meta.fHasSecondaryColorOutput;
+    return true;
+}
+
+bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
+                                           GrGLPrecompiledProgram* precompiledProgram,
+                                           const GrGLTranslatedProgram& translatedProgram) {
+    GrGLGpu* glGpu = static_cast<GrGLGpu*>(dContext->priv().getGpu());
+
+    const GrGLInterface* gl = glGpu->glInterface();
+    auto errorHandler = dContext->priv().getShaderErrorHandler();
+
     GrGLuint programID;
     GR_GL_CALL_RET(gl, programID, CreateProgram());
     if (0 == programID) {
@@ -484,23 +519,11 @@ bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
 
     SkTDArray<GrGLuint> shadersToDelete;
 
-    auto compileShader = [&](SkSL::ProgramKind kind, const std::string& sksl, GrGLenum type) {
-        std::string glsl;
-        SkSL::Program::Interface unusedInterface;
-        if (!skgpu::SkSLToGLSL(glGpu->caps()->shaderCaps(),
-                               sksl,
-                               kind,
-                               settings,
-                               &glsl,
-                               &unusedInterface,
-                               errorHandler)) {
-            return false;
-        }
-
+    auto compileShader = [&](GrShaderType shaderType, GrGLenum type) {
         if (GrGLuint shaderID = GrGLCompileAndAttachShader(glGpu->glContext(),
                                                            programID,
                                                            type,
-                                                           glsl,
+                                                           translatedProgram.fGLSL[shaderType],
                                                            /*shaderWasCached=*/false,
                                                            glGpu->pipelineBuilder()->stats(),
                                                            errorHandler)) {
@@ -511,19 +534,15 @@ bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
         }
     };
 
-    if (!compileShader(SkSL::ProgramKind::kFragment,
-                       shaders[kFragment_GrShaderType],
-                       GR_GL_FRAGMENT_SHADER) ||
-        !compileShader(SkSL::ProgramKind::kVertex,
-                       shaders[kVertex_GrShaderType],
-                       GR_GL_VERTEX_SHADER)) {
+    if (!compileShader(kFragment_GrShaderType, GR_GL_FRAGMENT_SHADER) ||
+        !compileShader(kVertex_GrShaderType, GR_GL_VERTEX_SHADER)) {
         cleanup_program(glGpu, programID, shadersToDelete);
         return false;
     }
 
-    for (int i = 0; i < meta.fAttributeNames.size(); ++i) {
-        GR_GL_CALL(glGpu->glInterface(), BindAttribLocation(programID, i,
-                                                          meta.fAttributeNames[i].c_str()));
+    for (int i = 0; i < translatedProgram.fAttributeNames.size(); ++i) {
+        GR_GL_CALL(glGpu->glInterface(),
+                   BindAttribLocation(programID, i, translatedProgram.fAttributeNames[i].c_str()));
     }
 
     const GrGLCaps& caps = glGpu->glCaps();
@@ -533,7 +552,7 @@ bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
                    BindFragDataLocation(programID, 0,
                                         GrGLSLFragmentShaderBuilder::DeclaredColorOutputName()));
 
-        if (meta.fHasSecondaryColorOutput) {
+        if (translatedProgram.fHasSecondaryColorOutput) {
             GR_GL_CALL(glGpu->glInterface(),
                        BindFragDataLocationIndexed(programID, 0, 1,
                                   GrGLSLFragmentShaderBuilder::DeclaredSecondaryColorOutputName()));
@@ -551,6 +570,6 @@ bool GrGLProgramBuilder::PrecompileProgram(GrDirectContext* dContext,
     cleanup_shaders(glGpu, shadersToDelete);
 
     precompiledProgram->fProgramID = programID;
-    precompiledProgram->fInterface = interface;
+    precompiledProgram->fInterface = translatedProgram.fInterface;
     return true;
 }
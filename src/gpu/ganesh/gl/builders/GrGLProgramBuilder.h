@@ -34,6 +34,15 @@ struct GrGLPrecompiledProgram {
     SkSL::Program::Interface fInterface;
 };
 
+// A program from the persistent cache whose shaders have been translated from SkSL to GLSL, but
+// not yet compiled. Translation doesn't use the GL context, so it can happen on any thread.
+struct GrGLTranslatedProgram {
+    std::string fGLSL[kGrShaderTypeCount];
+    SkSL::Program::Interface fInterface;
+    skia_private::TArray<std::string> fAttributeNames;
+    bool fHasSecondaryColorOutput = false;
+};
+
 class GrGLProgramBuilder : public GrGLSLProgramBuilder {
 public:
     /** Generates a shader program.
@@ -52,6 +61,13 @@ public:
 
     static bool PrecompileProgram(GrDirectContext*, GrGLPrecompiledProgram*, const SkData&);
 
+    // The two halves of PrecompileProgram. TranslateCachedProgram may be called from any thread,
+    // PrecompileProgram must be called on the thread that owns the GL context.
+    static bool TranslateCachedProgram(GrDirectContext*, const SkData&, GrGLTranslatedProgram*);
+    static bool PrecompileProgram(GrDirectContext*,
+                                  GrGLPrecompiledProgram*,
+                                  const GrGLTranslatedProgram&);
+
     const GrCaps* caps() const override;
 
     GrGLGpu* gpu() const { return fGpu; }
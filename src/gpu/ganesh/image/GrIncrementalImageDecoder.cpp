@@ -0,0 +1,130 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/gpu/ganesh/GrIncrementalImageDecoder.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/codec/SkIncrementalDecoder.h"
+#include "src/gpu/ganesh/GrColorInfo.h"
+#include "src/gpu/ganesh/GrImageInfo.h"
+#include "src/gpu/ganesh/GrPixmap.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrSurfaceProxyView.h"
+#include "src/gpu/ganesh/SkGr.h"
+#include "src/gpu/ganesh/SurfaceContext.h"
+#include "src/gpu/ganesh/image/SkImage_Ganesh.h"
+
+#include <utility>
+
+namespace {
+
+class IncrementalImageDecoder final : public GrIncrementalImageDecoder {
+public:
+    IncrementalImageDecoder(sk_sp<GrDirectContext> context,
+                            std::unique_ptr<SkIncrementalDecoder> decoder)
+            : fContext(std::move(context)), fDecoder(std::move(decoder)) {}
+
+    SkCodec::Result decode() override {
+        if (fContext->abandoned()) {
+            return SkCodec::kInternalError;
+        }
+        SkIRect changed;
+        const SkCodec::Result result = fDecoder->decode(&changed);
+        switch (result) {
+            case SkCodec::kSuccess:
+            case SkCodec::kIncompleteInput:
+            case SkCodec::kErrorInInput:
+                break;
+            default:
+                return result;
+        }
+        return this->upload(changed) ? result : SkCodec::kInternalError;
+    }
+
+    sk_sp<SkImage> makeImage() const override {
+        if (!fView) {
+            return nullptr;
+        }
+        // The image uses the texture until it is written to again, and a copy of it after that.
+        return SkImage_Ganesh::MakeWithVolatileSrc(fContext, fView, fColorInfo);
+    }
+
+    int rowsDecoded() const override { return fDecoder->rowsDecoded(); }
+
+private:
+    bool upload(const SkIRect& changed) {
+        const SkBitmap& bitmap = fDecoder->bitmap();
+        if (!fView) {
+            // The rows that haven't been decoded yet are zero in the bitmap, so the first upload
+            // is of all of it rather than leaving the rest of the texture uninitialized.
+            auto [view, ct] = GrMakeUncachedBitmapProxyView(fContext.get(),
+                                                            bitmap,
+                                                            skgpu::Mipmapped::kNo,
+                                                            SkBackingFit::kExact,
+                                                            skgpu::Budgeted::kYes);
+            if (!view) {
+                return false;
+            }
+            fView = std::move(view);
+            fColorInfo = SkColorInfo(GrColorTypeToSkColorType(ct),
+                                     bitmap.alphaType(),
+                                     bitmap.refColorSpace());
+            return true;
+        }
+        if (changed.isEmpty()) {
+            return true;
+        }
+
+        // Copy the rows out, since the codec keeps writing to the bitmap. A pixmap that owns its
+        // pixels also lets the write be deferred rather than flushing the surface.
+        SkPixmap rows;
+        SkAssertResult(bitmap.pixmap().extractSubset(&rows, changed));
+        GrPixmap copy = GrPixmap::Allocate(GrImageInfo(rows.info()));
+        if (!copy.hasPixels() ||
+            !rows.readPixels(SkPixmap(rows.info(), copy.addr(), copy.rowBytes()))) {
+            return false;
+        }
+        auto surfaceContext = fContext->priv().makeSC(fView, GrColorInfo(fColorInfo));
+        return surfaceContext &&
+               surfaceContext->writePixels(fContext.get(), copy, changed.topLeft());
+    }
+
+    sk_sp<GrDirectContext>                fContext;
+    std::unique_ptr<SkIncrementalDecoder> fDecoder;
+    GrSurfaceProxyView                    fView;
+    SkColorInfo                           fColorInfo;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<GrIncrementalImageDecoder> GrIncrementalImageDecoder::Make(
+        GrDirectContext* context,
+        std::unique_ptr<SkCodec> codec,
+        const SkImageInfo& info,
+        const SkCodec::Options* options,
+        SkCodec::Result* result) {
+    SkCodec::Result resultStorage;
+    if (!result) {
+        result = &resultStorage;
+    }
+    if (!context || context->abandoned()) {
+        *result = SkCodec::kInvalidParameters;
+        return nullptr;
+    }
+    auto decoder = SkIncrementalDecoder::Make(std::move(codec), info, options, result);
+    if (!decoder) {
+        return nullptr;
+    }
+    return std::make_unique<IncrementalImageDecoder>(sk_ref_sp(context), std::move(decoder));
+}
@@ -67,6 +67,7 @@ public:
 #endif
     void resetAllocator() { fAllocator.reset(); }
     SkArenaAlloc* allocator() override { return &fAllocator; }
+    SkArenaAllocWithReset* scratchAllocator() override { return &fScratchAllocator; }
     void putBackVertices(int vertices, size_t vertexStride) override { /* no-op */ }
     GrAppliedClip detachAppliedClip() override { return GrAppliedClip::Disabled(); }
     const GrDstProxyView& dstProxyView() const override { return fDstProxyView; }
@@ -151,6 +152,7 @@ private:
     char fStaticIndirectData[sizeof(GrDrawIndexedIndirectCommand) * 32];
     sk_sp<GrGpuBuffer> fStaticIndirectBuffer;
     SkSTArenaAllocWithReset<1024 * 1024> fAllocator;
+    SkSTArenaAllocWithReset<64 * 1024> fScratchAllocator;
     GrDstProxyView fDstProxyView;
 };
 
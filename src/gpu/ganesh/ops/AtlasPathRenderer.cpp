@@ -21,6 +21,8 @@
 #include "src/gpu/ganesh/ops/TessellationPathRenderer.h"
 #include "src/gpu/ganesh/tessellate/GrTessellationShader.h"
 
+#include <cmath>
+
 using namespace skia_private;
 
 namespace {
@@ -167,10 +169,11 @@ void AtlasPathRenderer::AtlasPathKey::set(const SkMatrix& m, const SkPath& path)
     fPathGenID = path.getGenerationID();
     fAffineMatrix[0] = m.getScaleX();
     fAffineMatrix[1] = m.getSkewX();
-    fAffineMatrix[2] = m.getTranslateX();
+    // Only the subpixel part of the translate changes the mask.
+    fAffineMatrix[2] = m.getTranslateX() - std::floor(m.getTranslateX());
     fAffineMatrix[3] = m.getSkewY();
     fAffineMatrix[4] = m.getScaleY();
-    fAffineMatrix[5] = m.getTranslateY();
+    fAffineMatrix[5] = m.getTranslateY() - std::floor(m.getTranslateY());
     fFillRule = (uint32_t)GrFillRuleForSkPath(path);  // Fill rule doesn't affect the path's genID.
 }
 
@@ -216,10 +219,16 @@ bool AtlasPathRenderer::addPathToAtlas(GrRecordingContext* rContext,
 
     // Check if this path is already in the atlas. This is mainly for clip paths.
     AtlasPathKey atlasPathKey;
+    SkRect relativeDevIBounds;
     if (!path.isVolatile()) {
         atlasPathKey.set(viewMatrix, path);
-        if (const SkIPoint16* existingLocation = fAtlasPathCache.find(atlasPathKey)) {
-            *locationInAtlas = *existingLocation;
+        // Computed in float, since the translate might not fit in an int.
+        relativeDevIBounds = SkRect::Make(*devIBounds).makeOffset(
+                -std::floor(viewMatrix.getTranslateX()), -std::floor(viewMatrix.getTranslateY()));
+        if (const AtlasPathEntry* entry = fAtlasPathCache.find(atlasPathKey);
+            entry && entry->fRelativeDevIBounds == relativeDevIBounds) {
+            *locationInAtlas = entry->fLocationInAtlas;
+            rContext->priv().stats()->incNumAtlasPathMaskCacheHits();
             return true;
         }
     }
@@ -254,8 +263,9 @@ bool AtlasPathRenderer::addPathToAtlas(GrRecordingContext* rContext,
 
     // Remember this path's location in the atlas, in case it gets drawn again.
     if (!path.isVolatile()) {
-        fAtlasPathCache.set(atlasPathKey, *locationInAtlas);
+        fAtlasPathCache.set(atlasPathKey, {*locationInAtlas, relativeDevIBounds});
     }
+    rContext->priv().stats()->incNumAtlasPathMasksGenerated();
     return true;
 }
 
@@ -286,7 +296,27 @@ PathRenderer::CanDrawPath AtlasPathRenderer::onCanDrawPath(const CanDrawPathArgs
                        !args.fViewMatrix->hasPerspective() &&
                        this->pathFitsInAtlas(args.fViewMatrix->mapRect(args.fShape->bounds()),
                                              args.fAAType);
-    return canDrawPath ? CanDrawPath::kYes : CanDrawPath::kNo;
+    if (!canDrawPath) {
+        return CanDrawPath::kNo;
+    }
+
+    // Leave paths we drew in an earlier flush to fRepeatedPathRenderer, so they stop being
+    // rendered again into every flush's atlas. Only paths have genIDs that last across draws.
+    if (fRepeatedPathRenderer && args.fAAType == GrAAType::kCoverage &&
+        args.fShape->isPath() && !fRecentPaths.empty()) {
+        SkPath path;
+        args.fShape->asPath(&path);
+        AtlasPathKey atlasPathKey;
+        atlasPathKey.set(*args.fViewMatrix, path);
+        int* lastFlush = path.isVolatile() ? nullptr : fRecentPaths.find(atlasPathKey);
+        if (lastFlush && *lastFlush != fFlushCount &&
+            fRepeatedPathRenderer->canDrawPath(args) == CanDrawPath::kYes) {
+            // Keep it in fRecentPaths for as long as it keeps getting drawn.
+            *lastFlush = fFlushCount;
+            return CanDrawPath::kNo;
+        }
+    }
+    return CanDrawPath::kYes;
 }
 
 bool AtlasPathRenderer::onDrawPath(const DrawPathArgs& args) {
@@ -311,6 +341,12 @@ bool AtlasPathRenderer::onDrawPath(const DrawPathArgs& args) {
     SkAssertResult(this->addPathToAtlas(args.fContext, *args.fViewMatrix, path, pathDevBounds,
                                         &devIBounds, &locationInAtlas, &transposedInAtlas,
                                         nullptr/*DrawRefsAtlasCallback -- see onCanDrawPath()*/));
+    if (fRepeatedPathRenderer && args.fAAType == GrAAType::kCoverage &&
+        args.fShape->isPath() && !path.isVolatile()) {
+        AtlasPathKey atlasPathKey;
+        atlasPathKey.set(*args.fViewMatrix, path);
+        fRecentPaths.set(atlasPathKey, fFlushCount);
+    }
 
     const SkIRect& fillBounds = args.fShape->inverseFilled()
             ? (args.fClip
@@ -397,7 +433,25 @@ GrFPResult AtlasPathRenderer::makeAtlasClipEffect(const SurfaceDrawContext* sdc,
                                                                        atlasMatrix, devIBounds));
 }
 
+void AtlasPathRenderer::pruneRecentPaths() {
+    // Forget paths that weren't drawn in this flush or the one before. If too many paths are still
+    // being drawn, start over rather than paying to look them all up.
+    static constexpr int kMaxRecentPaths = 1024;
+    THashMap<AtlasPathKey, int, AtlasPathKey::Hash> recentPaths;
+    if (fRecentPaths.count() <= kMaxRecentPaths) {
+        fRecentPaths.foreach([&](const AtlasPathKey& key, int lastFlush) {
+            if (lastFlush >= fFlushCount - 1) {
+                recentPaths.set(key, lastFlush);
+            }
+        });
+    }
+    fRecentPaths = std::move(recentPaths);
+    ++fFlushCount;
+}
+
 bool AtlasPathRenderer::preFlush(GrOnFlushResourceProvider* onFlushRP) {
+    this->pruneRecentPaths();
+
     if (fAtlasRenderTasks.empty()) {
         SkASSERT(fAtlasPathCache.count() == 0);
         return true;
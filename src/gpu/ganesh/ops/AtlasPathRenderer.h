@@ -33,6 +33,13 @@ public:
 
     const char* name() const override { return "GrAtlasPathRenderer"; }
 
+    // Our atlas is rebuilt every flush. Coverage AA paths that were already drawn in an earlier
+    // flush are left to the given path renderer instead, if it can draw them, so that they are
+    // cached in its atlas, which persists across flushes. (This is the SmallPathRenderer.)
+    void setRepeatedPathRenderer(PathRenderer* pathRenderer) {
+        fRepeatedPathRenderer = pathRenderer;
+    }
+
     // Returns a fragment processor that modulates inputFP by the given deviceSpacePath's coverage,
     // implemented using an internal atlas.
     //
@@ -89,6 +96,9 @@ private:
     // the same size will be instantiated with the same backing texture.
     bool preFlush(GrOnFlushResourceProvider*) override;
 
+    // Drops fRecentPaths that are no longer being drawn, and starts the next flush.
+    void pruneRecentPaths();
+
     float fAtlasMaxSize = 0;
     float fAtlasMaxPathWidth = 0;
     int fAtlasInitialSize = 0;
@@ -98,7 +108,8 @@ private:
     skia_private::STArray<4, sk_sp<AtlasRenderTask>> fAtlasRenderTasks;
 
     // This simple cache remembers the locations of cacheable path masks in the most recent atlas.
-    // Its main motivation is for clip paths.
+    // Its main motivation is for clip paths. The key only has the fractional part of the matrix's
+    // translate, so a mask is reused when the same path is drawn at a whole-pixel offset.
     struct AtlasPathKey {
         void set(const SkMatrix&, const SkPath&);
         bool operator==(const AtlasPathKey& k) const {
@@ -112,7 +123,21 @@ private:
         using Hash = SkForceDirectHash<AtlasPathKey>;
     };
 
-    skia_private::THashMap<AtlasPathKey, SkIPoint16, AtlasPathKey::Hash> fAtlasPathCache;
+    struct AtlasPathEntry {
+        SkIPoint16 fLocationInAtlas;
+        // The mask's device bounds, relative to the integer part of the matrix's translate. A mask
+        // is only reused if these match, so that it lines up with the path to the pixel.
+        SkRect fRelativeDevIBounds;
+    };
+
+    skia_private::THashMap<AtlasPathKey, AtlasPathEntry, AtlasPathKey::Hash> fAtlasPathCache;
+
+    PathRenderer* fRepeatedPathRenderer = nullptr;
+
+    // The number of the flush each coverage AA path we've drawn was last drawn in, for deciding
+    // which paths to leave to fRepeatedPathRenderer. Pruned in preFlush().
+    mutable skia_private::THashMap<AtlasPathKey, int, AtlasPathKey::Hash> fRecentPaths;
+    int fFlushCount = 0;
 };
 
 }  // namespace skgpu::ganesh
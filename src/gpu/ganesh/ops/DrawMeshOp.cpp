@@ -1236,6 +1236,15 @@ GrOp::Owner Make(GrRecordingContext* context,
                  const SkMatrix& viewMatrix,
                  GrAAType aaType,
                  sk_sp<GrColorSpaceXform> colorSpaceXform) {
+    // Upload the buffers' pending updates before the draw that reads them.
+    auto vb = static_cast<SkMeshPriv::VB*>(mesh.vertexBuffer());
+    if (vb->isGaneshBacked()) {
+        static_cast<SkMeshPriv::GaneshVertexBuffer*>(vb)->flushPendingUpdates(context);
+    }
+    auto ib = static_cast<SkMeshPriv::IB*>(mesh.indexBuffer());
+    if (ib && ib->isGaneshBacked()) {
+        static_cast<SkMeshPriv::GaneshIndexBuffer*>(ib)->flushPendingUpdates(context);
+    }
     return GrSimpleMeshDrawOpHelper::FactoryHelper<MeshOp>(context,
                                                            std::move(paint),
                                                            mesh,
@@ -187,9 +187,10 @@ private:
     int numQuads() const final { return fQuads.count(); }
 #endif
 
-    VertexSpec vertexSpec() const {
+    VertexSpec vertexSpec(const GrCaps& caps) const {
         auto indexBufferOption = skgpu::ganesh::QuadPerEdgeAA::CalcIndexBufferOption(
-                fHelper.aaType(), fQuads.count());
+                caps, fHelper.aaType(), fQuads.count(), fQuads.deviceQuadType(),
+                fHelper.usesLocalCoords() ? fQuads.localQuadType() : GrQuad::Type::kAxisAligned);
 
         return VertexSpec(fQuads.deviceQuadType(), fColorType, fQuads.localQuadType(),
                           fHelper.usesLocalCoords(), Subset::kNo, fHelper.aaType(),
@@ -208,7 +209,7 @@ private:
                              const GrDstProxyView& dstProxyView,
                              GrXferBarrierFlags renderPassXferBarriers,
                              GrLoadOp colorLoadOp) override {
-        const VertexSpec vertexSpec = this->vertexSpec();
+        const VertexSpec vertexSpec = this->vertexSpec(*caps);
 
         GrGeometryProcessor* gp = skgpu::ganesh::QuadPerEdgeAA::MakeProcessor(arena, vertexSpec);
         SkASSERT(gp->vertexStride() == vertexSpec.vertexSize());
@@ -235,7 +236,7 @@ private:
 
         SkArenaAlloc* arena = rContext->priv().recordTimeAllocator();
 
-        const VertexSpec vertexSpec = this->vertexSpec();
+        const VertexSpec vertexSpec = this->vertexSpec(*rContext->priv().caps());
 
         const int totalNumVertices = fQuads.count() * vertexSpec.verticesPerQuad();
         const size_t totalVertexSizeInBytes = vertexSpec.vertexSize() * totalNumVertices;
@@ -263,7 +264,7 @@ private:
     void onPrepareDraws(GrMeshDrawTarget* target) override {
         TRACE_EVENT0("skia.gpu", TRACE_FUNC);
 
-        const VertexSpec vertexSpec = this->vertexSpec();
+        const VertexSpec vertexSpec = this->vertexSpec(target->caps());
 
         // Make sure that if the op thought it was a solid color, the vertex spec does not use
         // local coords.
@@ -302,7 +303,7 @@ private:
             return;
         }
 
-        const VertexSpec vertexSpec = this->vertexSpec();
+        const VertexSpec vertexSpec = this->vertexSpec(flushState->caps());
 
         if (vertexSpec.needsIndexBuffer() && !fIndexBuffer) {
             return;
@@ -315,7 +316,11 @@ private:
         const int totalNumVertices = fQuads.count() * vertexSpec.verticesPerQuad();
 
         flushState->bindPipelineAndScissorClip(*fProgramInfo, chainBounds);
-        flushState->bindBuffers(std::move(fIndexBuffer), nullptr, std::move(fVertexBuffer));
+        if (vertexSpec.instanced()) {
+            flushState->bindBuffers(nullptr, std::move(fVertexBuffer), nullptr);
+        } else {
+            flushState->bindBuffers(std::move(fIndexBuffer), nullptr, std::move(fVertexBuffer));
+        }
         flushState->bindTextures(fProgramInfo->geomProc(), nullptr, fProgramInfo->pipeline());
         skgpu::ganesh::QuadPerEdgeAA::IssueDraw(flushState->caps(),
                                                 flushState->opsRenderPass(),
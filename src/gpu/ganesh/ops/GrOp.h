@@ -187,6 +187,24 @@ public:
         this->onPrepare(state);
     }
 
+    /**
+     * Returns true if the op has CPU work to do at flush time that prepareOnWorker() can do ahead
+     * of prepare().
+     */
+    virtual bool usesWorkerPrepare() const { return false; }
+
+    /**
+     * When GrContextOptions::fAllowParallelOpPreparation is set, this is called at flush time,
+     * before 'prepare', for the ops that return true from usesWorkerPrepare(). It may be called on
+     * a worker thread, in parallel with other ops, so it may only use the parts of the context that
+     * are thread safe (e.g., the caps and the GrThreadSafeCache). 'prepare' must still work when
+     * this has not been called.
+     */
+    void prepareOnWorker(GrRecordingContext* context) {
+        TRACE_EVENT0_ALWAYS("skia.gpu", TRACE_STR_STATIC(name()));
+        this->onPrepareOnWorker(context);
+    }
+
     /** Issues the op's commands to GrGpu. */
     void execute(GrOpFlushState* state, const SkRect& chainBounds) {
         TRACE_EVENT0_ALWAYS("skia.gpu", TRACE_STR_STATIC(name()));
@@ -313,6 +331,7 @@ private:
                               const GrDstProxyView&,
                               GrXferBarrierFlags renderPassXferBarriers,
                               GrLoadOp colorLoadOp) = 0;
+    virtual void onPrepareOnWorker(GrRecordingContext*) {}
     virtual void onPrepare(GrOpFlushState*) = 0;
     // If this op is chained then chainBounds is the union of the bounds of all ops in the chain.
     // Otherwise, this op's bounds.
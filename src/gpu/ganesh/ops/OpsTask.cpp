@@ -34,7 +34,10 @@ namespace {
 
 // Experimentally we have found that most combining occurs within the first 10 comparisons.
 static const int kMaxOpMergeDistance = 10;
-static const int kMaxOpChainDistance = 10;
+// Chains headed by a different class of op than the one being combined are rejected with a single
+// comparison, so they don't count against fMaxOpCombineDistance. This bounds how many of them may
+// be skipped in total, as a multiple of the distance.
+static const int kMaxOpChainSkipFactor = 4;
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -395,6 +398,8 @@ OpsTask::OpsTask(GrDrawingManager* drawingMgr,
                  sk_sp<GrArenas> arenas)
         : GrRenderTask()
         , fAuditTrail(auditTrail)
+        , fContext(drawingMgr->getContext())
+        , fMaxOpCombineDistance(std::max(fContext->priv().options().fMaxOpCombineDistance, 0))
         , fUsesMSAASurface(view.asRenderTargetProxy()->numSamples() > 1)
         , fTargetSwizzle(view.swizzle())
         , fTargetOrigin(view.origin())
@@ -493,6 +498,19 @@ void OpsTask::onPrePrepare(GrRecordingContext* context) {
     }
 }
 
+void OpsTask::gatherOpsToPrepareOnWorker(TArray<GrOp*>* ops) const {
+    // These are the ops that onPrepare() will prepare.
+    if (this->isColorNoOp() ||
+        (fClippedContentBounds.isEmpty() && fColorLoadOp != GrLoadOp::kDiscard)) {
+        return;
+    }
+    for (const auto& chain : fOpChains) {
+        if (chain.shouldExecute() && chain.head()->usesWorkerPrepare()) {
+            ops->push_back(chain.head());
+        }
+    }
+}
+
 void OpsTask::onPrepare(GrOpFlushState* flushState) {
     SkASSERT(this->target(0)->peekRenderTarget());
     SkASSERT(this->isClosed());
@@ -992,24 +1010,36 @@ void OpsTask::recordOp(
                op->bounds().fRight, op->bounds().fBottom);
     GrOP_INFO(SkTabString(op->dumpInfo(), 1).c_str());
     GrOP_INFO("\tOutcome:\n");
-    int maxCandidates = std::min(kMaxOpChainDistance, fOpChains.size());
+    int maxCandidates = std::min(kMaxOpChainSkipFactor * fMaxOpCombineDistance,
+                                 fOpChains.size());
     if (maxCandidates) {
+        auto stats = fContext->priv().stats();
+        stats->incNumOpCombineAttempts();
         int i = 0;
+        int distance = 0;
         while (true) {
             OpChain& candidate = fOpChains.fromBack(i);
+            bool sameClass = candidate.head()->classID() == op->classID();
             op = candidate.appendOp(std::move(op), processorAnalysis, dstProxyView, clip, caps,
                                     fArenas->arenaAlloc(), fAuditTrail);
             if (!op) {
+                stats->incNumOpsCombined();
                 return;
             }
             // Stop going backwards if we would cause a painter's order violation.
             if (!can_reorder(candidate.bounds(), op->bounds())) {
                 GrOP_INFO("\t\tBackward: Intersects with chain (%s, head opID: %u)\n",
                           candidate.head()->name(), candidate.head()->uniqueID());
+                stats->incNumOpCombinesBlockedByOverlap();
+                break;
+            }
+            if (++i == fOpChains.size()) {
+                GrOP_INFO("\t\tBackward: Reached beginning of op array %d\n", i);
                 break;
             }
-            if (++i == maxCandidates) {
-                GrOP_INFO("\t\tBackward: Reached max lookback or beginning of op array %d\n", i);
+            if ((sameClass && ++distance == fMaxOpCombineDistance) || i == maxCandidates) {
+                GrOP_INFO("\t\tBackward: Reached max lookback %d\n", i);
+                stats->incNumOpCombinesOutOfRange();
                 break;
             }
         }
@@ -1026,13 +1056,19 @@ void OpsTask::recordOp(
 void OpsTask::forwardCombine(const GrCaps& caps) {
     SkASSERT(!this->isClosed());
     GrOP_INFO("opsTask: %d ForwardCombine %d ops:\n", this->uniqueID(), fOpChains.size());
+    if (!fMaxOpCombineDistance) {
+        return;
+    }
 
     for (int i = 0; i < fOpChains.size() - 1; ++i) {
         OpChain& chain = fOpChains[i];
-        int maxCandidateIdx = std::min(i + kMaxOpChainDistance, fOpChains.size() - 1);
+        int maxCandidateIdx = std::min(i + kMaxOpChainSkipFactor * fMaxOpCombineDistance,
+                                       fOpChains.size() - 1);
         int j = i + 1;
+        int distance = 0;
         while (true) {
             OpChain& candidate = fOpChains[j];
+            bool sameClass = candidate.head()->classID() == chain.head()->classID();
             if (candidate.prependChain(&chain, caps, fArenas->arenaAlloc(), fAuditTrail)) {
                 break;
             }
@@ -1045,7 +1081,7 @@ void OpsTask::forwardCombine(const GrCaps& caps) {
                         candidate.head()->uniqueID());
                 break;
             }
-            if (++j > maxCandidateIdx) {
+            if ((sameClass && ++distance == fMaxOpCombineDistance) || ++j > maxCandidateIdx) {
                 GrOP_INFO("\t\t%d: chain (%s opID: %u) -> Reached max lookahead or end of array\n",
                           i, chain.head()->name(), chain.head()->uniqueID());
                 break;
@@ -56,6 +56,8 @@ public:
      */
     void endFlush(GrDrawingManager*) override;
 
+    void gatherOpsToPrepareOnWorker(skia_private::TArray<GrOp*>*) const override;
+
     void onPrePrepare(GrRecordingContext*) override;
     /**
      * Together these two functions flush all queued up draws to GrCommandBuffer. The return value
@@ -270,6 +272,10 @@ private:
     friend class skgpu::ganesh::SurfaceDrawContext;
 
     GrAuditTrail* fAuditTrail;
+    // Used to record how often ops are combined, in the context's stats.
+    GrRecordingContext* fContext;
+    // See GrContextOptions::fMaxOpCombineDistance.
+    int fMaxOpCombineDistance;
 
     bool fUsesMSAASurface;
     skgpu::Swizzle fTargetSwizzle;
@@ -300,6 +300,43 @@ void write_2d_cov_uv_strict(VertexWriter* vb,
     }
 }
 
+// Writes the whole quad as one instance, rather than as four vertices that each repeat its color
+// and subset. The vertex shader selects each vertex's corner from the x and y of all four.
+void write_2d_instance(VertexWriter* vb,
+                       const VertexSpec& spec,
+                       const GrQuad* deviceQuad,
+                       const GrQuad* localQuad,
+                       const float coverage[4],
+                       const SkPMColor4f& color,
+                       const SkRect& geomSubset,
+                       const SkRect& texSubset) {
+    // Instanced quads are never anti-aliased with coverage, nor in perspective
+    SkASSERT(spec.instanced());
+    SkASSERT(spec.coverageMode() == CoverageMode::kNone && !spec.requiresGeometrySubset());
+    SkASSERT(spec.deviceQuadType() != GrQuad::Type::kPerspective);
+    SkASSERT(!spec.hasLocalCoords() || spec.localQuadType() != GrQuad::Type::kPerspective);
+
+    *vb << deviceQuad->x4f()
+        << deviceQuad->y4f();
+
+    if (spec.hasVertexColors()) {
+        *vb << VertexColor(color, spec.colorType() == ColorType::kFloat);
+    }
+
+    if (spec.hasLocalCoords()) {
+        *vb << localQuad->x4f()
+            << localQuad->y4f();
+    }
+
+    if (spec.hasSubset()) {
+        *vb << texSubset;
+    }
+}
+
+// Batches with fewer quads than this keep drawing with indexed vertices, which don't need another
+// program.
+constexpr int kMinInstancedQuads = 16;
+
 } // anonymous namespace
 
 IndexBufferOption CalcIndexBufferOption(GrAAType aa, int numQuads) {
@@ -312,6 +349,19 @@ IndexBufferOption CalcIndexBufferOption(GrAAType aa, int numQuads) {
     }
 }
 
+IndexBufferOption CalcIndexBufferOption(const GrCaps& caps, GrAAType aa, int numQuads,
+                                        GrQuad::Type deviceQuadType, GrQuad::Type localQuadType) {
+    // Anti-aliased quads need their inset and outset geometry computed on the CPU, so only non-AA
+    // and MSAA quads can be expanded by the vertex shader.
+    if (aa != GrAAType::kCoverage && numQuads >= kMinInstancedQuads &&
+        deviceQuadType != GrQuad::Type::kPerspective &&
+        localQuadType != GrQuad::Type::kPerspective &&
+        caps.drawInstancedSupport() && caps.shaderCaps()->fVertexIDSupport) {
+        return IndexBufferOption::kInstanced;
+    }
+    return CalcIndexBufferOption(aa, numQuads);
+}
+
 // This is a more elaborate version of fitsInBytes() that allows "no color" for white
 ColorType MinColorType(SkPMColor4f color) {
     if (color == SK_PMColor4fWHITE) {
@@ -324,6 +374,10 @@ ColorType MinColorType(SkPMColor4f color) {
 ////////////////// Tessellator Implementation
 
 Tessellator::WriteQuadProc Tessellator::GetWriteQuadProc(const VertexSpec& spec) {
+    if (spec.instanced()) {
+        return write_2d_instance;
+    }
+
     // All specialized writing functions requires 2D geometry and no geometry subset. This is not
     // the same as just checking device type vs. kRectilinear since non-AA general 2D quads do not
     // require a geometry subset and could then go through a fast path.
@@ -465,6 +519,7 @@ sk_sp<const GrBuffer> GetIndexBuffer(GrMeshDrawTarget* target,
         case IndexBufferOption::kPictureFramed: return resourceProvider->refAAQuadIndexBuffer();
         case IndexBufferOption::kIndexedRects:  return resourceProvider->refNonAAQuadIndexBuffer();
         case IndexBufferOption::kTriStrips:     // fall through
+        case IndexBufferOption::kInstanced:     // fall through
         default:                                return nullptr;
     }
 }
@@ -474,6 +529,7 @@ int QuadLimit(IndexBufferOption option) {
         case IndexBufferOption::kPictureFramed: return GrResourceProvider::MaxNumAAQuads();
         case IndexBufferOption::kIndexedRects:  return GrResourceProvider::MaxNumNonAAQuads();
         case IndexBufferOption::kTriStrips:     return SK_MaxS32; // not limited by an indexBuffer
+        case IndexBufferOption::kInstanced:     return SK_MaxS32;
     }
 
     SkUNREACHABLE;
@@ -481,6 +537,12 @@ int QuadLimit(IndexBufferOption option) {
 
 void IssueDraw(const GrCaps& caps, GrOpsRenderPass* renderPass, const VertexSpec& spec,
                int runningQuadCount, int quadsInDraw, int maxVerts, int absVertBufferOffset) {
+    if (spec.instanced()) {
+        // Each instance is drawn as a 4 vertex triangle strip, one vertex per corner
+        renderPass->drawInstanced(quadsInDraw, absVertBufferOffset + runningQuadCount, 4, 0);
+        return;
+    }
+
     if (spec.indexBufferOption() == IndexBufferOption::kTriStrips) {
         int offset = absVertBufferOffset +
                                     runningQuadCount * GrResourceProvider::NumVertsPerNonAAQuad();
@@ -555,6 +617,23 @@ CoverageMode VertexSpec::coverageMode() const {
 
 // This needs to stay in sync w/ QuadPerEdgeAAGeometryProcessor::initializeAttrs
 size_t VertexSpec::vertexSize() const {
+    if (this->instanced()) {
+        // The x and y of the four device corners, and of the four local corners
+        size_t count = 2 * GrVertexAttribTypeSize(kFloat4_GrVertexAttribType);
+        if (this->hasLocalCoords()) {
+            count += 2 * GrVertexAttribTypeSize(kFloat4_GrVertexAttribType);
+        }
+        if (ColorType::kByte == this->colorType()) {
+            count += GrVertexAttribTypeSize(kUByte4_norm_GrVertexAttribType);
+        } else if (ColorType::kFloat == this->colorType()) {
+            count += GrVertexAttribTypeSize(kFloat4_GrVertexAttribType);
+        }
+        if (this->hasSubset()) {
+            count += GrVertexAttribTypeSize(kFloat4_GrVertexAttribType);
+        }
+        return count;
+    }
+
     bool needsPerspective = (this->deviceDimensionality() == 3);
     CoverageMode coverageMode = this->coverageMode();
 
@@ -626,9 +705,10 @@ public:
         b->addBool(fTexSubset.isInitialized(),    "subset");
         b->addBool(fSampler.isInitialized(),      "textured");
         b->addBool(fNeedsPerspective,             "perspective");
+        b->addBool(fInstanced,                    "instanced");
         b->addBool((fSaturate == Saturate::kYes), "saturate");
 
-        b->addBool(fLocalCoord.isInitialized(),   "hasLocalCoords");
+        b->addBool(fLocalCoord.isInitialized() || fLocalX.isInitialized(), "hasLocalCoords");
         if (fLocalCoord.isInitialized()) {
             // 2D (0) or 3D (1)
             b->addBits(1, (kFloat3_GrVertexAttribType == fLocalCoord.cpuType()), "localCoordsType");
@@ -672,7 +752,28 @@ public:
 
                 args.fVaryingHandler->emitAttributes(gp);
 
-                if (gp.fCoverageMode == CoverageMode::kWithPosition) {
+                // Instanced quads select their vertex's corner of the device and local quads.
+                // The corners are in triangle strip order, like the vertices of the other modes.
+                GrShaderVar localCoordVar = gp.fLocalCoord.asShaderVar();
+                if (gp.fInstanced) {
+                    SkASSERT(gp.fCoverageMode == CoverageMode::kNone && !gp.fNeedsPerspective);
+                    args.fVertBuilder->codeAppend(
+                            "float2 uv = float2(sk_VertexID >> 1, sk_VertexID & 1);"
+                            "float4 corner = float4((1 - uv.x) * (1 - uv.y), (1 - uv.x) * uv.y, "
+                                                   "uv.x * (1 - uv.y), uv.x * uv.y);");
+                    args.fVertBuilder->codeAppendf(
+                            "float2 position = float2(dot(%s, corner), dot(%s, corner));",
+                            gp.fDevX.name(), gp.fDevY.name());
+                    gpArgs->fPositionVar = {"position", SkSLType::kFloat2,
+                                            GrShaderVar::TypeModifier::None};
+                    if (gp.fLocalX.isInitialized()) {
+                        args.fVertBuilder->codeAppendf(
+                                "float2 localCoord = float2(dot(%s, corner), dot(%s, corner));",
+                                gp.fLocalX.name(), gp.fLocalY.name());
+                        localCoordVar = {"localCoord", SkSLType::kFloat2,
+                                         GrShaderVar::TypeModifier::None};
+                    }
+                } else if (gp.fCoverageMode == CoverageMode::kWithPosition) {
                     // Strip last channel from the vertex attribute to remove coverage and get the
                     // actual position
                     if (gp.fNeedsPerspective) {
@@ -694,7 +795,7 @@ public:
                 // This attribute will be uninitialized if earlier FP analysis determined no
                 // local coordinates are needed (and this will not include the inline texture
                 // fetch this GP does before invoking FPs).
-                gpArgs->fLocalCoordVar = gp.fLocalCoord.asShaderVar();
+                gpArgs->fLocalCoordVar = localCoordVar;
 
                 // Solid color before any texturing gets modulated in
                 const char* blendDst;
@@ -721,7 +822,7 @@ public:
                     // Texture coordinates clamped by the subset on the fragment shader; if the GP
                     // has a texture, it's guaranteed to have local coordinates
                     args.fFragBuilder->codeAppend("float2 texCoord;");
-                    if (gp.fLocalCoord.cpuType() == kFloat3_GrVertexAttribType) {
+                    if (!gp.fInstanced && gp.fLocalCoord.cpuType() == kFloat3_GrVertexAttribType) {
                         // Can't do a pass through since we need to perform perspective division
                         GrGLSLVarying v(gp.fLocalCoord.gpuType());
                         args.fVaryingHandler->addVarying(gp.fLocalCoord.name(), &v);
@@ -730,8 +831,7 @@ public:
                         args.fFragBuilder->codeAppendf("texCoord = %s.xy / %s.z;",
                                                        v.fsIn(), v.fsIn());
                     } else {
-                        args.fVaryingHandler->addPassThroughAttribute(gp.fLocalCoord.asShaderVar(),
-                                                                      "texCoord");
+                        args.fVaryingHandler->addPassThroughAttribute(localCoordVar, "texCoord");
                     }
 
                     // Clamp the now 2D localCoordName variable by the subset if it is provided
@@ -842,6 +942,12 @@ private:
     void initializeAttrs(const VertexSpec& spec) {
         fNeedsPerspective = spec.deviceDimensionality() == 3;
         fCoverageMode = spec.coverageMode();
+        fInstanced = spec.instanced();
+
+        if (fInstanced) {
+            this->initializeInstanceAttrs(spec);
+            return;
+        }
 
         if (fCoverageMode == CoverageMode::kWithPosition) {
             if (fNeedsPerspective) {
@@ -882,6 +988,35 @@ private:
         this->setVertexAttributesWithImplicitOffsets(&fPosition, 6);
     }
 
+    // This needs to stay in sync w/ VertexSpec::vertexSize and write_2d_instance
+    void initializeInstanceAttrs(const VertexSpec& spec) {
+        SkASSERT(fCoverageMode == CoverageMode::kNone && !fNeedsPerspective);
+        SkASSERT(!spec.requiresGeometrySubset() && spec.localDimensionality() != 3);
+
+        fDevX = {"devX", kFloat4_GrVertexAttribType, SkSLType::kFloat4};
+        fDevY = {"devY", kFloat4_GrVertexAttribType, SkSLType::kFloat4};
+        if (spec.hasVertexColors()) {
+            fColor = MakeColorAttribute("color", ColorType::kFloat == spec.colorType());
+        }
+        if (spec.hasLocalCoords()) {
+            fLocalX = {"localX", kFloat4_GrVertexAttribType, SkSLType::kFloat4};
+            fLocalY = {"localY", kFloat4_GrVertexAttribType, SkSLType::kFloat4};
+        }
+        if (spec.hasSubset()) {
+            fTexSubset = {"texSubset", kFloat4_GrVertexAttribType, SkSLType::kFloat4};
+        }
+
+        // Attributes that are left uninitialized are skipped.
+        fInstanceAttribs[0] = fDevX;
+        fInstanceAttribs[1] = fDevY;
+        fInstanceAttribs[2] = fColor;
+        fInstanceAttribs[3] = fLocalX;
+        fInstanceAttribs[4] = fLocalY;
+        fInstanceAttribs[5] = fTexSubset;
+        this->setInstanceAttributesWithImplicitOffsets(fInstanceAttribs,
+                                                       std::size(fInstanceAttribs));
+    }
+
     const TextureSampler& onTextureSampler(int) const override { return fSampler; }
 
     Attribute fPosition; // May contain coverage as last channel
@@ -891,9 +1026,17 @@ private:
     Attribute fGeomSubset; // Screen-space bounding box on geometry+aa outset
     Attribute fTexSubset; // Texture-space bounding box on local coords
 
+    // Only used when instanced, in place of fPosition and fLocalCoord
+    Attribute fDevX;
+    Attribute fDevY;
+    Attribute fLocalX;
+    Attribute fLocalY;
+    Attribute fInstanceAttribs[6];
+
     // The positions attribute may have coverage built into it, so float3 is an ambiguous type
     // and may mean 2d with coverage, or 3d with no coverage
     bool fNeedsPerspective;
+    bool fInstanced;
     // Should saturate() be called on the color? Only relevant when created with a texture.
     Saturate fSaturate = Saturate::kNo;
     CoverageMode fCoverageMode;
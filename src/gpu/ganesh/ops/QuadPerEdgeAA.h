@@ -38,12 +38,19 @@ enum class IndexBufferOption {
     kPictureFramed,  // geometrically AA'd   -> 8 verts/quad + an index buffer
     kIndexedRects,   // non-AA'd but indexed -> 4 verts/quad + an index buffer
     kTriStrips,      // non-AA'd             -> 4 verts/quad but no index buffer
-    kLast = kTriStrips
+    kInstanced,      // non-AA'd, 2D         -> 1 instance/quad, expanded by the vertex shader
+    kLast = kInstanced
 };
 static const int kIndexBufferOptionCount = static_cast<int>(IndexBufferOption::kLast) + 1;
 
 IndexBufferOption CalcIndexBufferOption(GrAAType aa, int numQuads);
 
+// Like CalcIndexBufferOption(), but returns kInstanced when the caps can draw the quads as instances
+// and there are enough of them for that to pay off. Quad limits should still be checked against
+// the non-instanced option, which is never more permissive.
+IndexBufferOption CalcIndexBufferOption(const GrCaps&, GrAAType aa, int numQuads,
+                                        GrQuad::Type deviceQuadType, GrQuad::Type localQuadType);
+
 // Gets the minimum ColorType that can represent a color.
 ColorType MinColorType(SkPMColor4f);
 
@@ -51,6 +58,9 @@ ColorType MinColorType(SkPMColor4f);
 // order (when enabled) is device position, color, local position, subset, aa edge equations.
 // This order matches the constructor argument order of VertexSpec and is the order that
 // GPAttributes maintains. If hasLocalCoords is false, then the local quad type can be ignored.
+//
+// When instanced, each quad is written as a single instance instead: the x and y of its four
+// device corners, color, the x and y of its four local corners, and subset.
 struct VertexSpec {
 public:
     VertexSpec()
@@ -81,13 +91,18 @@ public:
             , fUsesCoverageAA(aa == GrAAType::kCoverage)
             , fCompatibleWithCoverageAsAlpha(coverageAsAlpha)
             , fRequiresGeometrySubset(aa == GrAAType::kCoverage &&
-                                      deviceQuadType > GrQuad::Type::kRectilinear) {}
+                                      deviceQuadType > GrQuad::Type::kRectilinear) {
+        SkASSERT(!this->instanced() ||
+                 (aa != GrAAType::kCoverage && deviceQuadType != GrQuad::Type::kPerspective &&
+                  (!hasLocalCoords || localQuadType != GrQuad::Type::kPerspective)));
+    }
 
     GrQuad::Type deviceQuadType() const { return static_cast<GrQuad::Type>(fDeviceQuadType); }
     GrQuad::Type localQuadType() const { return static_cast<GrQuad::Type>(fLocalQuadType); }
     IndexBufferOption indexBufferOption() const {
         return static_cast<IndexBufferOption>(fIndexBufferOption);
     }
+    bool instanced() const { return this->indexBufferOption() == IndexBufferOption::kInstanced; }
     bool hasLocalCoords() const { return fHasLocalCoords; }
     ColorType colorType() const { return static_cast<ColorType>(fColorType); }
     bool hasVertexColors() const { return ColorType::kNone != this->colorType(); }
@@ -100,13 +115,18 @@ public:
     // Will always be 0 if hasLocalCoords is false, otherwise will be 2 or 3
     int localDimensionality() const;
 
-    int verticesPerQuad() const { return fUsesCoverageAA ? 8 : 4; }
+    // The number of vertices written per quad, or 1 when each quad is written as an instance.
+    int verticesPerQuad() const {
+        return this->instanced() ? 1 : (fUsesCoverageAA ? 8 : 4);
+    }
 
     CoverageMode coverageMode() const;
+    // The size of a vertex, or of an instance when instanced.
     size_t vertexSize() const;
 
     bool needsIndexBuffer() const {
-        return this->indexBufferOption() != IndexBufferOption::kTriStrips;
+        return this->indexBufferOption() != IndexBufferOption::kTriStrips &&
+               this->indexBufferOption() != IndexBufferOption::kInstanced;
     }
 
     GrPrimitiveType primitiveType() const {
@@ -117,6 +137,8 @@ public:
                 return GrPrimitiveType::kTriangles;
             case IndexBufferOption::kTriStrips:
                 return GrPrimitiveType::kTriangleStrip;
+            case IndexBufferOption::kInstanced:
+                return GrPrimitiveType::kTriangleStrip;
         }
 
         SkUNREACHABLE;
@@ -186,7 +208,7 @@ private:
                                                Saturate);
 
     // This method will return the correct index buffer for the specified indexBufferOption.
-    // It will, correctly, return nullptr if the indexBufferOption is kTriStrips.
+    // It will, correctly, return nullptr if the indexBufferOption is kTriStrips or kInstanced.
     sk_sp<const GrBuffer> GetIndexBuffer(GrMeshDrawTarget*, IndexBufferOption);
 
     // What is the maximum number of quads allowed for the specified indexBuffer option?
@@ -195,7 +217,9 @@ private:
     // This method will issue the draw call on the provided GrOpsRenderPass, as specified by the
     // indexing method in vertexSpec. It is up to the calling code to allocate, fill in, and bind a
     // vertex buffer, and to acquire and bind the correct index buffer (if needed) with
-    // GrPrimitiveRestart::kNo.
+    // GrPrimitiveRestart::kNo. When vertexSpec is instanced, the data is bound as the instance
+    // buffer instead, with no vertex or index buffer, and the vertex counts and offset below are
+    // counted in instances.
     //
     // @param runningQuadCount  the number of quads already stored in 'vertexBuffer' and
     //                          'indexBuffer' e.g., different GrMeshes have already been placed in
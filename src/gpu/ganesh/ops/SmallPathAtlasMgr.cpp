@@ -90,8 +90,12 @@ SmallPathShapeData* SmallPathAtlasMgr::findOrCreate(const SmallPathShapeDataKey&
 #ifdef DF_PATH_TRACKING
         ++g_NumCachedShapes;
 #endif
+        ++fNumCacheMisses;
     } else if (!fAtlas->hasID(shapeData->fAtlasLocator.plotLocator())) {
         shapeData->fAtlasLocator.invalidatePlotLocator();
+        ++fNumCacheMisses;
+    } else {
+        ++fNumCacheHits;
     }
 
     return shapeData;
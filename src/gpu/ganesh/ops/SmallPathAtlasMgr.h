@@ -82,6 +82,11 @@ public:
 
     void deleteCacheEntry(SmallPathShapeData*);
 
+    // Lookups that found the shape still in the atlas, and lookups that have to render it. The
+    // atlas persists across flushes, so paths drawn every frame should mostly be hits.
+    int numCacheHits() const { return fNumCacheHits; }
+    int numCacheMisses() const { return fNumCacheMisses; }
+
 private:
     SmallPathShapeData* findOrCreate(const SmallPathShapeDataKey&);
 
@@ -93,6 +98,8 @@ private:
     std::unique_ptr<GrDrawOpAtlas> fAtlas;
     ShapeCache                     fShapeCache;
     ShapeDataList                  fShapeList;
+    int                            fNumCacheHits = 0;
+    int                            fNumCacheMisses = 0;
 };
 
 }  // namespace skgpu::ganesh
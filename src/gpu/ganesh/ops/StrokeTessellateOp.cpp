@@ -19,13 +19,18 @@ namespace skgpu::ganesh {
 
 StrokeTessellateOp::StrokeTessellateOp(GrAAType aaType, const SkMatrix& viewMatrix,
                                        const SkPath& path, const SkStrokeRec& stroke,
-                                       GrPaint&& paint)
+                                       GrPaint&& paint,
+                                       const GrStyledShape* keyedShape)
         : GrDrawOp(ClassID())
         , fAAType(aaType)
         , fViewMatrix(viewMatrix)
         , fPathStrokeList(path, stroke, paint.getColor4f())
         , fTotalCombinedVerbCnt(path.countVerbs())
         , fProcessors(std::move(paint)) {
+    if (keyedShape) {
+        SkASSERT(keyedShape->hasUnstyledKey());
+        fKeyedShape = *keyedShape;
+    }
     if (!this->headColor().fitsInBytes()) {
         fPatchAttribs |= PatchAttribs::kWideColorIfEnabled;
     }
@@ -219,6 +224,10 @@ void StrokeTessellateOp::onPrepare(GrOpFlushState* flushState) {
                                     &flushState->caps()}, flushState->detachAppliedClip());
     }
     SkASSERT(fTessellator);
+    if (fKeyedShape && !fPathStrokeList.fNext &&
+        fTessellator->prepareCached(flushState, fViewMatrix, fPathStrokeList, *fKeyedShape)) {
+        return;
+    }
     fTessellator->prepare(flushState,
                           fViewMatrix,
                           &fPathStrokeList,
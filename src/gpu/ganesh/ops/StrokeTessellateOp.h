@@ -9,10 +9,13 @@
 #define StrokeTessellateOp_DEFINED
 
 #include "include/core/SkStrokeRec.h"
+#include "src/gpu/ganesh/geometry/GrStyledShape.h"
 #include "src/gpu/ganesh/ops/GrDrawOp.h"
 #include "src/gpu/ganesh/tessellate/GrTessellationShader.h"
 #include "src/gpu/ganesh/tessellate/StrokeTessellator.h"
 
+#include <optional>
+
 class GrRecordingContext;
 class GrStrokeTessellationShader;
 
@@ -22,7 +25,11 @@ namespace skgpu::ganesh {
 // GrStrokeTessellationShader.
 class StrokeTessellateOp final : public GrDrawOp {
 public:
-    StrokeTessellateOp(GrAAType, const SkMatrix&, const SkPath&, const SkStrokeRec&, GrPaint&&);
+    // If 'keyedShape' is not null, 'path' must be its (unchopped) path. The stroke's patches are
+    // then kept in the GrThreadSafeCache, keyed by the shape and stroke, and later draws of the same
+    // shape skip the CPU work. Ops that end up combined with others are not cached.
+    StrokeTessellateOp(GrAAType, const SkMatrix&, const SkPath&, const SkStrokeRec&, GrPaint&&,
+                       const GrStyledShape* keyedShape = nullptr);
 
 private:
     using PatchAttribs = StrokeTessellator::PatchAttribs;
@@ -72,6 +79,7 @@ private:
     PathStrokeList fPathStrokeList;
     PathStrokeList** fPathStrokeTail = &fPathStrokeList.fNext;
     int fTotalCombinedVerbCnt = 0;
+    std::optional<GrStyledShape> fKeyedShape;
     GrProcessorSet fProcessors;
     bool fNeedsStencil;
 
@@ -181,6 +181,7 @@ bool TessellationPathRenderer::onDrawPath(const DrawPathArgs& args) {
 
     SkPath path;
     args.fShape->asPath(&path);
+    const uint32_t unchoppedGenID = path.getGenerationID();
 
     // onDrawPath() should only be called if ChopPathIfNecessary() succeeded.
     SkAssertResult(ChopPathIfNecessary(*args.fViewMatrix, *args.fShape,
@@ -193,8 +194,14 @@ bool TessellationPathRenderer::onDrawPath(const DrawPathArgs& args) {
         SkASSERT(args.fUserStencilSettings->isUnused());
         const SkStrokeRec& stroke = args.fShape->style().strokeRec();
         SkASSERT(stroke.getStyle() != SkStrokeRec::kStrokeAndFill_Style);
+        // A pre-chopped path depends on the viewport, so only strokes of the shape itself can be
+        // cached.
+        const GrStyledShape* keyedShape =
+                path.getGenerationID() == unchoppedGenID && args.fShape->hasUnstyledKey()
+                        ? args.fShape
+                        : nullptr;
         auto op = GrOp::Make<StrokeTessellateOp>(args.fContext, args.fAAType, *args.fViewMatrix,
-                                                 path, stroke, std::move(args.fPaint));
+                                                 path, stroke, std::move(args.fPaint), keyedShape);
         sdc->addDrawOp(args.fClip, std::move(op));
         return true;
     }
@@ -682,7 +682,7 @@ private:
         SkArenaAlloc* arena = context->priv().recordTimeAllocator();
 
         fDesc = arena->make<Desc>();
-        this->characterize(fDesc);
+        this->characterize(*context->priv().caps(), fDesc);
         fDesc->allocatePrePreparedVertices(arena);
         FillInVertices(*context->priv().caps(), this, fDesc, fDesc->fPrePreparedVertices);
 
@@ -781,7 +781,7 @@ private:
     int numQuads() const final { return this->totNumQuads(); }
 #endif
 
-    void characterize(Desc* desc) const {
+    void characterize(const GrCaps& caps, Desc* desc) const {
         SkDEBUGCODE(this->validate();)
 
         GrQuad::Type quadType = GrQuad::Type::kAxisAligned;
@@ -821,8 +821,8 @@ private:
 
         SkASSERT(!CombinedQuadCountWillOverflow(overallAAType, false, desc->fNumTotalQuads));
 
-        auto indexBufferOption =
-                skgpu::ganesh::QuadPerEdgeAA::CalcIndexBufferOption(overallAAType, maxQuadsPerMesh);
+        auto indexBufferOption = skgpu::ganesh::QuadPerEdgeAA::CalcIndexBufferOption(
+                caps, overallAAType, maxQuadsPerMesh, quadType, srcQuadType);
 
         desc->fVertexSpec = VertexSpec(quadType, colorType, srcQuadType, /* hasLocal */ true,
                                        subset, overallAAType, /* alpha as coverage */ true,
@@ -869,7 +869,7 @@ private:
         if (!fDesc) {
             SkArenaAlloc* arena = target->allocator();
             fDesc = arena->make<Desc>();
-            this->characterize(fDesc);
+            this->characterize(target->caps(), fDesc);
             SkASSERT(!fDesc->fPrePreparedVertices);
         }
 
@@ -913,8 +913,12 @@ private:
         }
 
         flushState->bindPipelineAndScissorClip(*fDesc->fProgramInfo, chainBounds);
-        flushState->bindBuffers(std::move(fDesc->fIndexBuffer), nullptr,
-                                std::move(fDesc->fVertexBuffer));
+        if (fDesc->fVertexSpec.instanced()) {
+            flushState->bindBuffers(nullptr, std::move(fDesc->fVertexBuffer), nullptr);
+        } else {
+            flushState->bindBuffers(std::move(fDesc->fIndexBuffer), nullptr,
+                                    std::move(fDesc->fVertexBuffer));
+        }
 
         int totQuadsSeen = 0;
         SkDEBUGCODE(int numDraws = 0;)
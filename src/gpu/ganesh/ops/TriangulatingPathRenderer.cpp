@@ -42,14 +42,16 @@
 /*
  * This path renderer linearizes and decomposes the path into triangles using GrTriangulator,
  * uploads the triangles to a vertex buffer, and renders them with a single draw call. It can do
- * screenspace antialiasing with a one-pixel coverage ramp.
+ * screenspace antialiasing with a one-pixel coverage ramp. The vertex buffers of paths with keys are
+ * kept in the GrThreadSafeCache, so that later draws of the path can reuse them.
  */
 namespace {
 
 // The TessInfo struct contains ancillary data not specifically required for the triangle
 // data (which is stored in a GrThreadSafeCache::VertexData object).
 // The 'fNumVertices' field is a temporary exception. It is still needed to support the
-// AA triangulated path case - which doesn't use the GrThreadSafeCache nor the VertexData object).
+// AA triangulated paths that can't be cached - which use neither the GrThreadSafeCache nor the
+// VertexData object).
 // When there is an associated VertexData, its numVertices should always match the TessInfo's
 // value.
 struct TessInfo {
@@ -210,7 +212,17 @@ public:
             , fShape(shape)
             , fViewMatrix(viewMatrix)
             , fDevClipBounds(devClipBounds)
-            , fAntiAlias(GrAAType::kCoverage == aaType) {
+            , fAntiAlias(GrAAType::kCoverage == aaType)
+            , fCached(!fAntiAlias || (shape.hasUnstyledKey() && !shape.inverseFilled() &&
+                                      !viewMatrix.hasPerspective())) {
+        if (fAntiAlias && fCached) {
+            // GrAATriangulator rounds its vertices to quarter pixels, so the triangulation can be
+            // moved by whole quarter pixels. The shader applies that part of the translation.
+            fAATranslate = {SkScalarFloorToScalar(viewMatrix.getTranslateX() * 4) * 0.25f,
+                            SkScalarFloorToScalar(viewMatrix.getTranslateY() * 4) * 0.25f};
+            fAAMatrix = viewMatrix;
+            fAAMatrix.postTranslate(-fAATranslate.fX, -fAATranslate.fY);
+        }
         SkRect devBounds;
         viewMatrix.mapRect(&devBounds, shape.bounds());
         if (shape.inverseFilled()) {
@@ -262,14 +274,38 @@ private:
         builder.finish();
     }
 
+    // The AA triangulation is done after mapping the path with 'aaMatrix', which is part of the key.
+    static void CreateAAKey(skgpu::UniqueKey* key,
+                            const GrStyledShape& shape,
+                            const SkMatrix& aaMatrix) {
+        static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
+
+        SkASSERT(!shape.inverseFilled());
+        SkASSERT(!aaMatrix.hasPerspective());
+
+        const float affine[6] = {aaMatrix.getScaleX(), aaMatrix.getSkewX(),
+                                 aaMatrix.getTranslateX(), aaMatrix.getSkewY(),
+                                 aaMatrix.getScaleY(), aaMatrix.getTranslateY()};
+        static constexpr int kMatrixCnt = sizeof(affine) / sizeof(uint32_t);
+        int shapeKeyDataCnt = shape.unstyledKeySize();
+        SkASSERT(shapeKeyDataCnt >= 0);
+        skgpu::UniqueKey::Builder builder(key, kDomain, shapeKeyDataCnt + kMatrixCnt, "AA Path");
+        shape.writeUnstyledKey(&builder[0]);
+        memcpy(&builder[shapeKeyDataCnt], affine, sizeof(affine));
+
+        builder.finish();
+    }
+
     // Triangulate the provided 'shape' in the shape's coordinate space. 'tol' should already
-    // have been mapped back from device space.
+    // have been mapped back from device space. If 'scratch' is not null, the triangulator builds
+    // its mesh there instead of in an arena of its own.
     static int Triangulate(GrEagerVertexAllocator* allocator,
                            const SkMatrix& viewMatrix,
                            const GrStyledShape& shape,
                            const SkIRect& devClipBounds,
                            SkScalar tol,
-                           bool* isLinear) {
+                           bool* isLinear,
+                           SkArenaAllocWithReset* scratch) {
         SkRect clipBounds = SkRect::Make(devClipBounds);
 
         SkMatrix vmi;
@@ -282,19 +318,64 @@ private:
         SkPath path;
         shape.asPath(&path);
 
+        if (scratch) {
+            return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear,
+                                                   scratch);
+        }
         return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear);
     }
 
-    void createNonAAMesh(GrMeshDrawTarget* target) {
-        SkASSERT(!fAntiAlias);
+    // Triangulates the path with a coverage ramp, after mapping it with 'matrix'. Returns the
+    // number of vertices.
+    int triangulateAA(const SkMatrix& matrix, GrEagerVertexAllocator* allocator,
+                      SkArenaAllocWithReset* scratch) const {
+        SkPath path = this->getPath();
+        if (path.isEmpty()) {
+            return 0;
+        }
+        path.transform(matrix);
+        SkRect clipBounds = SkRect::Make(fDevClipBounds);
+        SkScalar tol = GrPathUtils::kDefaultTolerance;
+        if (scratch) {
+            return GrAATriangulator::PathToAATriangles(path, tol, clipBounds, allocator, scratch);
+        }
+        return GrAATriangulator::PathToAATriangles(path, tol, clipBounds, allocator);
+    }
+
+    // Creates the key and the tolerance of the triangulation shared through the thread safe cache.
+    void createCacheKey(skgpu::UniqueKey* key, SkScalar* tol) const {
+        SkASSERT(fCached);
+        if (fAntiAlias) {
+            CreateAAKey(key, fShape, fAAMatrix);
+            *tol = GrPathUtils::kDefaultTolerance;
+        } else {
+            CreateKey(key, fShape, fDevClipBounds);
+            *tol = GrPathUtils::scaleToleranceToSrc(GrPathUtils::kDefaultTolerance,
+                                                    fViewMatrix, fShape.bounds());
+        }
+    }
+
+    int triangulateForCache(GrEagerVertexAllocator* allocator, SkScalar tol, bool* isLinear,
+                            SkArenaAllocWithReset* scratch) const {
+        SkASSERT(fCached);
+        if (fAntiAlias) {
+            // The AA triangulator doesn't report whether the path was linear. This only means the
+            // triangulation won't be used at other tolerances, which the key rules out anyway.
+            *isLinear = false;
+            return this->triangulateAA(fAAMatrix, allocator, scratch);
+        }
+        return Triangulate(allocator, fViewMatrix, fShape, fDevClipBounds, tol, isLinear,
+                           scratch);
+    }
+
+    void createCachedMesh(GrMeshDrawTarget* target) {
+        SkASSERT(fCached);
         GrResourceProvider* rp = target->resourceProvider();
         auto threadSafeCache = target->threadSafeCache();
 
         skgpu::UniqueKey key;
-        CreateKey(&key, fShape, fDevClipBounds);
-
-        SkScalar tol = GrPathUtils::scaleToleranceToSrc(GrPathUtils::kDefaultTolerance,
-                                                        fViewMatrix, fShape.bounds());
+        SkScalar tol;
+        this->createCacheKey(&key, &tol);
 
         if (!fVertexData) {
             auto [cachedVerts, data] = threadSafeCache->findVertsWithData(key);
@@ -326,8 +407,8 @@ private:
         StaticVertexAllocator allocator(rp, canMapVB);
 
         bool isLinear;
-        int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol,
-                                      &isLinear);
+        int vertexCount = this->triangulateForCache(&allocator, tol, &isLinear,
+                                                    target->scratchAllocator());
         if (vertexCount == 0) {
             return;
         }
@@ -353,25 +434,88 @@ private:
     }
 
     void createAAMesh(GrMeshDrawTarget* target) {
-        SkASSERT(!fVertexData);
-        SkASSERT(fAntiAlias);
-        SkPath path = this->getPath();
-        if (path.isEmpty()) {
-            return;
-        }
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-        path.transform(fViewMatrix);
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
+        SkASSERT(fAntiAlias && !fCached);
         sk_sp<const GrBuffer> vertexBuffer;
         int firstVertex;
+        if (fVertexData) {
+            // The path was triangulated ahead of time, into CPU memory.
+            void* vertices = target->makeVertexSpace(fVertexData->vertexSize(),
+                                                     fVertexData->numVertices(),
+                                                     &vertexBuffer,
+                                                     &firstVertex);
+            if (!vertices) {
+                return;
+            }
+            memcpy(vertices, fVertexData->vertices(), fVertexData->size());
+            fMesh = CreateMesh(target, std::move(vertexBuffer), firstVertex,
+                               fVertexData->numVertices());
+            return;
+        }
         GrEagerDynamicVertexAllocator allocator(target, &vertexBuffer, &firstVertex);
-        int vertexCount = GrAATriangulator::PathToAATriangles(path, tol, clipBounds, &allocator);
+        int vertexCount = this->triangulateAA(fViewMatrix, &allocator,
+                                              target->scratchAllocator());
         if (vertexCount == 0) {
             return;
         }
         fMesh = CreateMesh(target, std::move(vertexBuffer), firstVertex, vertexCount);
     }
 
+    // Triangulates the path into CPU memory, so that onPrepareDraws() only has to copy the
+    // vertices, or finds the triangulation in the thread safe cache. Cached vertices are uploaded
+    // once, to a static buffer. This may run on a recording thread, so it doesn't use the flush's
+    // scratch memory.
+    void triangulateOnCpu(GrThreadSafeCache* threadSafeCache, uint32_t contextID) {
+        SkASSERT(!fVertexData);
+        if (!fCached) {
+            GrCpuVertexAllocator allocator;
+            if (this->triangulateAA(fViewMatrix, &allocator, /*scratch=*/nullptr) == 0) {
+                return;
+            }
+            fVertexData = allocator.detachVertexData();
+            return;
+        }
+
+        skgpu::UniqueKey key;
+        SkScalar tol;
+        this->createCacheKey(&key, &tol);
+
+        auto [cachedVerts, data] = threadSafeCache->findVertsWithData(key);
+        if (cachedVerts && cache_match(data.get(), tol)) {
+            fVertexData = std::move(cachedVerts);
+            return;
+        }
+
+        GrCpuVertexAllocator allocator;
+
+        bool isLinear;
+        int vertexCount = this->triangulateForCache(&allocator, tol, &isLinear,
+                                                    /*scratch=*/nullptr);
+        if (vertexCount == 0) {
+            return;
+        }
+
+        fVertexData = allocator.detachVertexData();
+
+        key.setCustomData(create_data(vertexCount, isLinear, tol));
+
+        // If some other thread created and cached its own triangulation, the 'is_newer_better'
+        // predicate will replace the version in the cache if 'fVertexData' is a more accurate
+        // triangulation. This will leave some other recording threads using a poorer triangulation
+        // but will result in a version with greater applicability being in the cache.
+        auto [tmpV, tmpD] = threadSafeCache->addVertsWithData(key, fVertexData, is_newer_better);
+        if (tmpV != fVertexData) {
+            // Someone beat us to creating the triangulation (and it is better than ours) so
+            // just go ahead and use it.
+            SkASSERT(cache_match(tmpD.get(), tol));
+            fVertexData = std::move(tmpV);
+        } else {
+            // This isn't perfect. The current triangulation is in the cache but it may have
+            // replaced a pre-existing one. A duplicated listener is unlikely and not that
+            // expensive so we just roll with it.
+            fShape.addGenIDChangeListener(sk_make_sp<UniqueKeyInvalidator>(key, contextID));
+        }
+    }
+
     GrProgramInfo* programInfo() override { return fProgramInfo; }
 
     void onCreateProgramInfo(const GrCaps* caps,
@@ -400,7 +544,20 @@ private:
             } else {
                 coverageType = Coverage::kSolid_Type;
             }
-            if (fAntiAlias) {
+            if (fAntiAlias && fCached) {
+                // The vertices are in the space of fAAMatrix, and are moved to device space by
+                // fAATranslate.
+                SkMatrix localMatrix = SkMatrix::I();
+                if (localCoordsType != LocalCoords::kUnused_Type &&
+                    !fAAMatrix.invert(&localMatrix)) {
+                    return;
+                }
+                LocalCoords localCoords = localCoordsType == LocalCoords::kUnused_Type
+                                                  ? LocalCoords(localCoordsType)
+                                                  : LocalCoords(localCoordsType, &localMatrix);
+                gp = GrDefaultGeoProcFactory::Make(arena, color, coverageType, localCoords,
+                                                   SkMatrix::Translate(fAATranslate));
+            } else if (fAntiAlias) {
                 gp = GrDefaultGeoProcFactory::MakeForDeviceSpace(arena, color, coverageType,
                                                                  localCoordsType, fViewMatrix);
             } else {
@@ -441,64 +598,26 @@ private:
         INHERITED::onPrePrepareDraws(rContext, writeView, clip, dstProxyView,
                                      renderPassXferBarriers, colorLoadOp);
 
-        if (fAntiAlias) {
-            // TODO: pull the triangulation work forward to the recording thread for the AA case
-            // too.
-            return;
-        }
-
-        auto threadSafeViewCache = rContext->priv().threadSafeCache();
-
-        skgpu::UniqueKey key;
-        CreateKey(&key, fShape, fDevClipBounds);
-
-        SkScalar tol = GrPathUtils::scaleToleranceToSrc(GrPathUtils::kDefaultTolerance,
-                                                        fViewMatrix, fShape.bounds());
-
-        auto [cachedVerts, data] = threadSafeViewCache->findVertsWithData(key);
-        if (cachedVerts && cache_match(data.get(), tol)) {
-            fVertexData = std::move(cachedVerts);
-            return;
-        }
-
-        GrCpuVertexAllocator allocator;
-
-        bool isLinear;
-        int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol,
-                                      &isLinear);
-        if (vertexCount == 0) {
-            return;
+        if (!fVertexData) {
+            this->triangulateOnCpu(rContext->priv().threadSafeCache(),
+                                   rContext->priv().contextID());
         }
+    }
 
-        fVertexData = allocator.detachVertexData();
-
-        key.setCustomData(create_data(vertexCount, isLinear, tol));
+    bool usesWorkerPrepare() const override { return !fVertexData; }
 
-        // If some other thread created and cached its own triangulation, the 'is_newer_better'
-        // predicate will replace the version in the cache if 'fVertexData' is a more accurate
-        // triangulation. This will leave some other recording threads using a poorer triangulation
-        // but will result in a version with greater applicability being in the cache.
-        auto [tmpV, tmpD] = threadSafeViewCache->addVertsWithData(key, fVertexData,
-                                                                  is_newer_better);
-        if (tmpV != fVertexData) {
-            // Someone beat us to creating the triangulation (and it is better than ours) so
-            // just go ahead and use it.
-            SkASSERT(cache_match(tmpD.get(), tol));
-            fVertexData = std::move(tmpV);
-        } else {
-            // This isn't perfect. The current triangulation is in the cache but it may have
-            // replaced a pre-existing one. A duplicated listener is unlikely and not that
-            // expensive so we just roll with it.
-            fShape.addGenIDChangeListener(
-                    sk_make_sp<UniqueKeyInvalidator>(key, rContext->priv().contextID()));
+    void onPrepareOnWorker(GrRecordingContext* rContext) override {
+        if (!fVertexData) {
+            this->triangulateOnCpu(rContext->priv().threadSafeCache(),
+                                   rContext->priv().contextID());
         }
     }
 
     void onPrepareDraws(GrMeshDrawTarget* target) override {
-        if (fAntiAlias) {
-            this->createAAMesh(target);
+        if (fCached) {
+            this->createCachedMesh(target);
         } else {
-            this->createNonAAMesh(target);
+            this->createAAMesh(target);
         }
     }
 
@@ -538,6 +657,13 @@ private:
     SkMatrix       fViewMatrix;
     SkIRect        fDevClipBounds;
     bool           fAntiAlias;
+    // True if the triangulation is shared with other draws of the path, through the thread safe
+    // cache. The AA triangulation is in device space, so it is only shared when the view matrices
+    // differ by a translation of whole quarter pixels.
+    bool           fCached;
+    // Maps the path to the cached AA vertices, and the vertices to device space.
+    SkMatrix       fAAMatrix;
+    SkVector       fAATranslate = {0, 0};
 
     GrSimpleMesh*  fMesh = nullptr;
     GrProgramInfo* fProgramInfo = nullptr;
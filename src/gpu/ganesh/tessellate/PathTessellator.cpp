@@ -32,6 +32,31 @@ using CurveWriter = PatchWriter<VertexChunkPatchAllocator,
                                 AddTrianglesWhenChopping,
                                 DiscardFlatCurves>;
 
+// Maps a run of 'count' consecutive quads (ptsPerCurve=2) or cubics (ptsPerCurve=3) and writes
+// them as strips, so that Wang's formula is evaluated for several curves at once.
+void write_curve_strip(CurveWriter& patchWriter,
+                       const AffineMatrix& m,
+                       const SkPoint pts[],
+                       int count,
+                       int ptsPerCurve) {
+    static constexpr int kMaxCurvesPerChunk = 16;
+    SkPoint mapped[kMaxCurvesPerChunk * 3 + 1];
+    while (count > 0) {
+        const int chunkCount = std::min(count, kMaxCurvesPerChunk);
+        const int numPts = chunkCount * ptsPerCurve + 1;
+        for (int i = 0; i < numPts; ++i) {
+            mapped[i] = m.mapPoint(pts[i]);
+        }
+        if (ptsPerCurve == 2) {
+            patchWriter.writeQuadraticStrip(mapped, chunkCount);
+        } else {
+            patchWriter.writeCubicStrip(mapped, chunkCount);
+        }
+        pts += chunkCount * ptsPerCurve;
+        count -= chunkCount;
+    }
+}
+
 void write_curve_patches(CurveWriter&& patchWriter,
                          const SkMatrix& shaderMatrix,
                          const PathTessellator::PathDrawList& pathDrawList) {
@@ -41,35 +66,34 @@ void write_curve_patches(CurveWriter&& patchWriter,
         if (patchWriter.attribs() & PatchAttribs::kColor) {
             patchWriter.updateColorAttrib(color);
         }
+        // Consecutive quads or cubics share their end points in the path's point array, so each
+        // run of them is written as a strip.
+        const SkPoint* stripPts = nullptr;
+        int stripCount = 0;
+        int stripPtsPerCurve = 0;
         for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
-            switch (verb) {
-                case SkPathVerb::kQuad: {
-                    auto [p0, p1] = m.map2Points(pts);
-                    auto p2 = m.map1Point(pts+2);
-
-                    patchWriter.writeQuadratic(p0, p1, p2);
-                    break;
-                }
-
-                case SkPathVerb::kConic: {
-                    auto [p0, p1] = m.map2Points(pts);
-                    auto p2 = m.map1Point(pts+2);
-
-                    patchWriter.writeConic(p0, p1, p2, *w);
-                    break;
-                }
-
-                case SkPathVerb::kCubic: {
-                    auto [p0, p1] = m.map2Points(pts);
-                    auto [p2, p3] = m.map2Points(pts+2);
-
-                    patchWriter.writeCubic(p0, p1, p2, p3);
-                    break;
+            if (verb == SkPathVerb::kQuad || verb == SkPathVerb::kCubic) {
+                const int ptsPerCurve = verb == SkPathVerb::kQuad ? 2 : 3;
+                if (stripCount == 0 || ptsPerCurve != stripPtsPerCurve ||
+                    pts != stripPts + stripCount * ptsPerCurve) {
+                    write_curve_strip(patchWriter, m, stripPts, stripCount, stripPtsPerCurve);
+                    stripPts = pts;
+                    stripCount = 0;
+                    stripPtsPerCurve = ptsPerCurve;
                 }
+                ++stripCount;
+                continue;
+            }
+            write_curve_strip(patchWriter, m, stripPts, stripCount, stripPtsPerCurve);
+            stripCount = 0;
+            if (verb == SkPathVerb::kConic) {
+                auto [p0, p1] = m.map2Points(pts);
+                auto p2 = m.map1Point(pts+2);
 
-                default: break;
+                patchWriter.writeConic(p0, p1, p2, *w);
             }
         }
+        write_curve_strip(patchWriter, m, stripPts, stripCount, stripPtsPerCurve);
     }
 }
 
@@ -7,13 +7,18 @@
 
 #include "src/gpu/ganesh/tessellate/StrokeTessellator.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkMatrix.h"
+#include "include/private/SkIDChangeListener.h"
 #include "include/private/base/SkAlignedStorage.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkOnce.h"
 #include "include/private/base/SkPoint_impl.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/base/SkFloatBits.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkMessageBus.h"
 #include "src/gpu/ResourceKey.h"
 #include "src/gpu/ganesh/GrBuffer.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -21,6 +26,8 @@
 #include "src/gpu/ganesh/GrOpFlushState.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrShaderCaps.h"
+#include "src/gpu/ganesh/GrThreadSafeCache.h"
+#include "src/gpu/ganesh/geometry/GrStyledShape.h"
 #include "src/gpu/ganesh/tessellate/VertexChunkPatchAllocator.h"
 #include "src/gpu/tessellate/FixedCountBufferUtils.h"
 #include "src/gpu/tessellate/LinearTolerances.h"
@@ -30,6 +37,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <utility>
 
 namespace skgpu::ganesh {
@@ -38,18 +46,61 @@ namespace {
 
 using namespace skgpu::tess;
 
-using StrokeWriter = PatchWriter<VertexChunkPatchAllocator,
-                                 Required<PatchAttribs::kJoinControlPoint>,
-                                 Optional<PatchAttribs::kStrokeParams>,
-                                 Optional<PatchAttribs::kColor>,
-                                 Optional<PatchAttribs::kWideColorIfEnabled>,
-                                 Optional<PatchAttribs::kExplicitCurveType>,
-                                 ReplicateLineEndPoints,
-                                 TrackJoinControlPoints>;
+template <typename PatchAllocator>
+using StrokeWriterWith = PatchWriter<PatchAllocator,
+                                     Required<PatchAttribs::kJoinControlPoint>,
+                                     Optional<PatchAttribs::kStrokeParams>,
+                                     Optional<PatchAttribs::kColor>,
+                                     Optional<PatchAttribs::kWideColorIfEnabled>,
+                                     Optional<PatchAttribs::kExplicitCurveType>,
+                                     ReplicateLineEndPoints,
+                                     TrackJoinControlPoints>;
 
-void write_fixed_count_patches(StrokeWriter&& patchWriter,
+// Patches written to CPU memory, which becomes the GrThreadSafeCache::VertexData that caches them.
+struct CpuPatches {
+    skia_private::AutoTMalloc<char> fData;
+    int fCount = 0;
+};
+
+// Fits the API requirements of skgpu::tess::PatchWriter's PatchAllocator template parameter, and
+// appends the patches to a CpuPatches.
+class CpuPatchAllocator {
+public:
+    CpuPatchAllocator(size_t stride,
+                      LinearTolerances* worstCaseTolerances,
+                      CpuPatches* patches,
+                      int preallocCount)
+            : fStride(stride)
+            , fWorstCaseTolerances(worstCaseTolerances)
+            , fPatches(patches)
+            , fCapacity(std::max(preallocCount, 1)) {
+        SkASSERT(!fPatches->fData && !fPatches->fCount);
+        fPatches->fData.realloc(fCapacity * fStride);
+    }
+
+    VertexWriter append(const LinearTolerances& tolerances) {
+        fWorstCaseTolerances->accumulate(tolerances);
+        if (fPatches->fCount == fCapacity) {
+            fCapacity *= 2;
+            fPatches->fData.realloc(fCapacity * fStride);
+        }
+        return {fPatches->fData.get() + fStride * fPatches->fCount++, fStride};
+    }
+
+private:
+    const size_t fStride;
+    LinearTolerances* const fWorstCaseTolerances;
+    CpuPatches* const fPatches;
+    int fCapacity;
+};
+
+using StrokeWriter = StrokeWriterWith<VertexChunkPatchAllocator>;
+using CpuStrokeWriter = StrokeWriterWith<CpuPatchAllocator>;
+
+template <typename Writer>
+void write_fixed_count_patches(Writer&& patchWriter,
                                const SkMatrix& shaderMatrix,
-                               StrokeTessellator::PathStrokeList* pathStrokeList) {
+                               const StrokeTessellator::PathStrokeList* pathStrokeList) {
     // The vector xform approximates how the control points are transformed by the shader to
     // more accurately compute how many *parametric* segments are needed.
     // getMaxScale() returns -1 if it can't compute a scale factor (e.g. perspective), taking the
@@ -157,6 +208,30 @@ void write_fixed_count_patches(StrokeWriter&& patchWriter,
     }
 }
 
+// Cached strokes are tessellated for the power of two above the matrix's scale, and are reused for
+// any matrix with a scale in [2^(scaleLog2 - 1), 2^scaleLog2]. Smaller scales use the first bucket.
+constexpr int kMinCachedScaleLog2 = -8;
+constexpr int kMaxCachedScaleLog2 = 16;
+
+// When the SkPathRef genID changes, invalidate the cached patches described by key.
+class UniqueKeyInvalidator : public SkIDChangeListener {
+public:
+    UniqueKeyInvalidator(const skgpu::UniqueKey& key, uint32_t contextUniqueID)
+            : fMsg(key, contextUniqueID, /* inThreadSafeCache */ true) {}
+
+private:
+    skgpu::UniqueKeyInvalidatedMessage fMsg;
+
+    void changed() override {
+        SkMessageBus<skgpu::UniqueKeyInvalidatedMessage, uint32_t>::Post(fMsg);
+    }
+};
+
+// All entries with the same key hold the same patches.
+bool is_newer_better(SkData* /*incumbent*/, SkData* /*challenger*/) {
+    return false;
+}
+
 }  // namespace
 
 
@@ -173,6 +248,106 @@ void StrokeTessellator::prepare(GrMeshDrawTarget* target,
     write_fixed_count_patches(std::move(patchWriter), shaderMatrix, pathStrokeList);
     fVertexCount = FixedCountStrokes::VertexCount(worstCase);
 
+    this->prepareVertexIDFallbackIfNeeded(target);
+}
+
+bool StrokeTessellator::prepareCached(GrMeshDrawTarget* target,
+                                      const SkMatrix& shaderMatrix,
+                                      const PathStrokeList& pathStroke,
+                                      const GrStyledShape& keyedShape) {
+    SkASSERT(!pathStroke.fNext);
+    // These are only enabled when ops combine.
+    SkASSERT(!(fAttribs & (PatchAttribs::kStrokeParams | PatchAttribs::kColor)));
+
+    const SkStrokeRec& stroke = pathStroke.fStroke;
+    if (stroke.isHairlineStyle() ||  // Hairlines are stroked in device space.
+        shaderMatrix.hasPerspective() ||
+        !keyedShape.hasUnstyledKey()) {
+        return false;
+    }
+    const float maxScale = shaderMatrix.getMaxScale();
+    int scaleLog2 = kMinCachedScaleLog2;
+    if (maxScale > std::ldexp(1.f, kMinCachedScaleLog2)) {
+        scaleLog2 = (int)std::ceil(std::log2(maxScale));
+    }
+    if (scaleLog2 > kMaxCachedScaleLog2) {
+        return false;
+    }
+
+    static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
+    static constexpr int kStrokeKeyCnt = 5;
+    const int shapeKeyCnt = keyedShape.unstyledKeySize();
+    skgpu::UniqueKey key;
+    skgpu::UniqueKey::Builder builder(&key, kDomain, shapeKeyCnt + kStrokeKeyCnt,
+                                      "Stroke Patches");
+    keyedShape.writeUnstyledKey(&builder[0]);
+    builder[shapeKeyCnt + 0] = SkFloat2Bits(stroke.getWidth());
+    builder[shapeKeyCnt + 1] = SkFloat2Bits(stroke.getMiter());
+    builder[shapeKeyCnt + 2] = stroke.getJoin() | (stroke.getCap() << 2) |
+                               (stroke.getStyle() << 4);
+    builder[shapeKeyCnt + 3] = scaleLog2;
+    builder[shapeKeyCnt + 4] = (uint32_t)fAttribs;
+    builder.finish();
+
+    GrThreadSafeCache* threadSafeCache = target->threadSafeCache();
+    auto [vertexData, data] = threadSafeCache->findVertsWithData(key);
+    if (!vertexData) {
+        // Tessellate for a uniform scale that is at least the matrix's. Since it bounds how much
+        // the matrix stretches any vector, the curves get at least as many segments (and chops)
+        // as they would with the matrix itself.
+        const float bucketScale = std::ldexp(1.f, scaleLog2);
+        LinearTolerances worstCase;
+        CpuPatches patches;
+        {
+            const int preallocCount =
+                    FixedCountStrokes::PreallocCount(pathStroke.fPath.countVerbs());
+            CpuStrokeWriter patchWriter{fAttribs, &worstCase, &patches, preallocCount};
+            write_fixed_count_patches(std::move(patchWriter),
+                                      SkMatrix::Scale(bucketScale, bucketScale),
+                                      &pathStroke);
+        }
+        if (!patches.fCount) {
+            return true;  // Nothing to draw.
+        }
+
+        const int vertexCount = FixedCountStrokes::VertexCount(worstCase);
+        data = SkData::MakeWithCopy(&vertexCount, sizeof(vertexCount));
+        key.setCustomData(data);
+        sk_sp<GrThreadSafeCache::VertexData> newVertexData =
+                GrThreadSafeCache::MakeVertexData(patches.fData.release(), patches.fCount,
+                                                  PatchStride(fAttribs));
+        std::tie(vertexData, data) =
+                threadSafeCache->addVertsWithData(key, newVertexData, is_newer_better);
+        if (vertexData == newVertexData) {
+            keyedShape.addGenIDChangeListener(
+                    sk_make_sp<UniqueKeyInvalidator>(key, target->contextUniqueID()));
+        }
+    }
+    SkASSERT(data && data->size() == sizeof(int));
+
+    if (!vertexData->gpuBuffer()) {
+        sk_sp<GrGpuBuffer> buffer = target->resourceProvider()->createBuffer(
+                vertexData->vertices(),
+                vertexData->size(),
+                GrGpuBufferType::kVertex,
+                kStatic_GrAccessPattern);
+        if (!buffer) {
+            return false;
+        }
+        // Since we have a direct context and a ref on 'vertexData' we need not worry about any
+        // threading issues in this call.
+        vertexData->setGpuBuffer(std::move(buffer));
+    }
+
+    fCachedPatchBuffer = vertexData->refGpuBuffer();
+    fCachedPatchCount = vertexData->numVertices();
+    memcpy(&fVertexCount, data->data(), sizeof(fVertexCount));
+
+    this->prepareVertexIDFallbackIfNeeded(target);
+    return true;
+}
+
+void StrokeTessellator::prepareVertexIDFallbackIfNeeded(GrMeshDrawTarget* target) {
     if (!target->caps().shaderCaps()->fVertexIDSupport) {
         // Our shader won't be able to use sk_VertexID. Bind a fallback vertex buffer with the IDs
         // in it instead.
@@ -189,13 +364,18 @@ void StrokeTessellator::prepare(GrMeshDrawTarget* target,
 }
 
 void StrokeTessellator::draw(GrOpFlushState* flushState) const {
-    if (fVertexChunkArray.empty() || fVertexCount <= 0) {
+    if ((fVertexChunkArray.empty() && !fCachedPatchBuffer) || fVertexCount <= 0) {
         return;
     }
     if (!flushState->caps().shaderCaps()->fVertexIDSupport &&
         !fVertexBufferIfNoIDSupport) {
         return;
     }
+    if (fCachedPatchBuffer) {
+        flushState->bindBuffers(nullptr, fCachedPatchBuffer, fVertexBufferIfNoIDSupport);
+        flushState->drawInstanced(fCachedPatchCount, 0, fVertexCount, 0);
+        return;
+    }
     for (const auto& instanceChunk : fVertexChunkArray) {
         flushState->bindBuffers(nullptr, instanceChunk.fBuffer, fVertexBufferIfNoIDSupport);
         flushState->drawInstanced(instanceChunk.fCount,
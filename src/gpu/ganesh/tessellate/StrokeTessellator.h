@@ -18,6 +18,7 @@
 
 class GrMeshDrawTarget;
 class GrOpFlushState;
+class GrStyledShape;
 class SkMatrix;
 
 namespace skgpu::ganesh {
@@ -48,15 +49,33 @@ public:
                  PathStrokeList*,
                  int totalCombinedStrokeVerbCnt);
 
+    // Called before draw() instead of prepare(), for a single stroked shape. The patches are kept
+    // in the GrThreadSafeCache, keyed by the shape, the stroke, and the power of two above the
+    // matrix's scale, so later draws of the same shape and stroke skip the CPU work and reuse the
+    // GPU buffer. The patches are in the shape's local space, and their tolerances hold for any
+    // matrix of that scale.
+    //
+    // Returns false, without preparing anything, if the stroke can't be cached (e.g., hairlines).
+    bool prepareCached(GrMeshDrawTarget*,
+                       const SkMatrix& shaderMatrix,
+                       const PathStrokeList&,
+                       const GrStyledShape& keyedShape);
+
     // Issues draw calls for the tessellated stroke. The caller is responsible for creating and
     // binding a pipeline that uses this class's shader() before calling draw().
     void draw(GrOpFlushState*) const;
 
 protected:
+    void prepareVertexIDFallbackIfNeeded(GrMeshDrawTarget*);
+
     const PatchAttribs fAttribs;
 
     GrVertexChunkArray fVertexChunkArray;
 
+    // Used instead of fVertexChunkArray when the patches come from the GrThreadSafeCache.
+    sk_sp<const GrBuffer> fCachedPatchBuffer;
+    int fCachedPatchCount = 0;
+
     int fVertexCount = 0;
 
     // Only used if sk_VertexID is not supported.
@@ -423,6 +423,10 @@ void GrVkCaps::init(const GrContextOptions& contextOptions,
         // and see if any support both flags.
         fPreferDiscardableMSAAAttachment = !fSupportsProtectedContent;
         fSupportsMemorylessAttachments = !fSupportsProtectedContent;
+        // Stencil attachments can only live in lazily allocated memory if their values are never
+        // loaded from memory, so always clear them at the start of a render pass and discard them
+        // at the end.
+        fDiscardStencilValuesAfterRenderPass = fSupportsMemorylessAttachments;
     }
 
     this->initGrCaps(vkInterface, physDev, properties, memoryProperties, features, extensions);
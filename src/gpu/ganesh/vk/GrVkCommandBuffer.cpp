@@ -29,6 +29,9 @@ void GrVkCommandBuffer::invalidateState() {
     }
     fBoundIndexBuffer = VK_NULL_HANDLE;
 
+    fBoundPipeline = VK_NULL_HANDLE;
+    this->invalidateBoundDescriptorSets();
+
     memset(&fCachedViewport, 0, sizeof(VkViewport));
     fCachedViewport.width = - 1.0f; // Viewport must have a width greater than 0
 
@@ -40,6 +43,13 @@ void GrVkCommandBuffer::invalidateState() {
     }
 }
 
+void GrVkCommandBuffer::invalidateBoundDescriptorSets() {
+    fBoundDescriptorSetLayout = VK_NULL_HANDLE;
+    for (auto& boundDescriptorSet : fBoundDescriptorSets) {
+        boundDescriptorSet = VK_NULL_HANDLE;
+    }
+}
+
 void GrVkCommandBuffer::freeGPUData(const GrGpu* gpu, VkCommandPool cmdPool) const {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
     SkASSERT(!fIsActive);
@@ -259,6 +269,23 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
                                            uint32_t dynamicOffsetCount,
                                            const uint32_t* dynamicOffsets) {
     SkASSERT(fIsActive);
+    if (layout != fBoundDescriptorSetLayout) {
+        this->invalidateBoundDescriptorSets();
+        fBoundDescriptorSetLayout = layout;
+    }
+    bool tracked = !dynamicOffsetCount && firstSet + setCount <= kMaxBoundDescriptorSets;
+    if (tracked) {
+        bool alreadyBound = true;
+        for (uint32_t i = 0; i < setCount; ++i) {
+            alreadyBound &= fBoundDescriptorSets[firstSet + i] == descriptorSets[i];
+            fBoundDescriptorSets[firstSet + i] = descriptorSets[i];
+        }
+        if (alreadyBound) {
+            return;
+        }
+    } else {
+        this->invalidateBoundDescriptorSets();
+    }
     GR_VK_CALL(gpu->vkInterface(), CmdBindDescriptorSets(fCmdBuffer,
                                                          VK_PIPELINE_BIND_POINT_GRAPHICS,
                                                          layout,
@@ -271,6 +298,11 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
 
 void GrVkCommandBuffer::bindPipeline(const GrVkGpu* gpu, sk_sp<const GrVkPipeline> pipeline) {
     SkASSERT(fIsActive);
+    // The command buffer already holds a ref on the bound pipeline, so its handle can't be reused.
+    if (pipeline->pipeline() == fBoundPipeline) {
+        return;
+    }
+    fBoundPipeline = pipeline->pipeline();
     GR_VK_CALL(gpu->vkInterface(), CmdBindPipeline(fCmdBuffer,
                                                    VK_PIPELINE_BIND_POINT_GRAPHICS,
                                                    pipeline->pipeline()));
@@ -284,6 +316,10 @@ void GrVkCommandBuffer::pushConstants(const GrVkGpu* gpu, VkPipelineLayout layou
     // offset and size must be a multiple of 4
     SkASSERT(!SkToBool(offset & 0x3));
     SkASSERT(!SkToBool(size & 0x3));
+    if (layout != fBoundDescriptorSetLayout) {
+        // Push constants with an incompatible layout may disturb the bound descriptor sets.
+        this->invalidateBoundDescriptorSets();
+    }
     GR_VK_CALL(gpu->vkInterface(), CmdPushConstants(fCmdBuffer,
                                                     layout,
                                                     stageFlags,
@@ -13,6 +13,7 @@
 #include "src/gpu/ganesh/GrManagedResource.h"
 #include "src/gpu/ganesh/vk/GrVkGpu.h"
 #include "src/gpu/ganesh/vk/GrVkSemaphore.h"
+#include "src/gpu/ganesh/vk/GrVkUniformHandler.h"
 #include "src/gpu/ganesh/vk/GrVkUtil.h"
 
 class GrVkFramebuffer;
@@ -158,6 +159,8 @@ protected:
 private:
     static constexpr int kInitialTrackedResourcesCount = 32;
 
+    void invalidateBoundDescriptorSets();
+
 protected:
     template <typename T>
     using TrackedResourceArray = skia_private::STArray<kInitialTrackedResourcesCount, T>;
@@ -186,6 +189,14 @@ protected:
     VkBuffer fBoundInputBuffers[kMaxInputBuffers];
     VkBuffer fBoundIndexBuffer;
 
+    // The pipeline and descriptor sets last bound, so that rebinding the same ones for consecutive
+    // draws can be skipped. The sets are only tracked while they are all bound with the same
+    // pipeline layout, since binding with another layout may disturb them.
+    static constexpr uint32_t kMaxBoundDescriptorSets = GrVkUniformHandler::kDescSetCount;
+    VkPipeline fBoundPipeline;
+    VkPipelineLayout fBoundDescriptorSetLayout;
+    VkDescriptorSet fBoundDescriptorSets[kMaxBoundDescriptorSets];
+
     // Cached values used for dynamic state updates
     VkViewport fCachedViewport;
     VkRect2D   fCachedScissor;
@@ -1601,9 +1601,14 @@ bool GrVkGpu::onRegenerateMipMapLevels(GrTexture* tex) {
 sk_sp<GrAttachment> GrVkGpu::makeStencilAttachment(const GrBackendFormat& /*colorFormat*/,
                                                    SkISize dimensions, int numStencilSamples) {
     VkFormat sFmt = this->vkCaps().preferredStencilFormat();
+    // Stencil values are only kept in memory between render passes if they are not discarded.
+    GrMemoryless memoryless = this->vkCaps().supportsMemorylessAttachments() &&
+                                      this->vkCaps().discardStencilValuesAfterRenderPass()
+                                      ? GrMemoryless::kYes
+                                      : GrMemoryless::kNo;
 
     fStats.incStencilAttachmentCreates();
-    return GrVkImage::MakeStencil(this, dimensions, numStencilSamples, sFmt);
+    return GrVkImage::MakeStencil(this, dimensions, numStencilSamples, sFmt, memoryless);
 }
 
 sk_sp<GrAttachment> GrVkGpu::makeMSAAAttachment(SkISize dimensions,
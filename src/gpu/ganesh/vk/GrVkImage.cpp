@@ -21,9 +21,14 @@
 sk_sp<GrVkImage> GrVkImage::MakeStencil(GrVkGpu* gpu,
                                         SkISize dimensions,
                                         int sampleCnt,
-                                        VkFormat format) {
-    VkImageUsageFlags vkUsageFlags =
-            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+                                        VkFormat format,
+                                        GrMemoryless memoryless) {
+    VkImageUsageFlags vkUsageFlags = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    if (memoryless == GrMemoryless::kYes) {
+        vkUsageFlags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    } else {
+        vkUsageFlags |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
     return GrVkImage::Make(gpu,
                            dimensions,
                            UsageFlags::kStencilAttachment,
@@ -32,7 +37,7 @@ sk_sp<GrVkImage> GrVkImage::MakeStencil(GrVkGpu* gpu,
                            /*mipLevels=*/1,
                            vkUsageFlags,
                            GrProtected::kNo,
-                           GrMemoryless::kNo,
+                           memoryless,
                            skgpu::Budgeted::kYes);
 }
 
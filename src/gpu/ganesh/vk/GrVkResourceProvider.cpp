@@ -19,6 +19,7 @@
 #include "src/gpu/ganesh/vk/GrVkPipeline.h"
 #include "src/gpu/ganesh/vk/GrVkRenderTarget.h"
 #include "src/gpu/ganesh/vk/GrVkUtil.h"
+#include "src/gpu/vk/VulkanUtilsPriv.h"
 
 GrVkResourceProvider::GrVkResourceProvider(GrVkGpu* gpu)
     : fGpu(gpu)
@@ -49,22 +50,11 @@ VkPipelineCache GrVkResourceProvider::pipelineCache() {
             cached = persistentCache->load(*keyData);
         }
         bool usedCached = false;
-        if (cached) {
-            const uint32_t* cacheHeader = (const uint32_t*)cached->data();
-            if (cacheHeader[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
-                // For version one of the header, the total header size is 16 bytes plus
-                // VK_UUID_SIZE bytes. See Section 9.6 (Pipeline Cache) in the vulkan spec to see
-                // the breakdown of these bytes.
-                SkASSERT(cacheHeader[0] == 16 + VK_UUID_SIZE);
-                const VkPhysicalDeviceProperties& devProps = fGpu->physicalDeviceProperties();
-                const uint8_t* supportedPipelineCacheUUID = devProps.pipelineCacheUUID;
-                if (cacheHeader[2] == devProps.vendorID && cacheHeader[3] == devProps.deviceID &&
-                    !memcmp(&cacheHeader[4], supportedPipelineCacheUUID, VK_UUID_SIZE)) {
-                    createInfo.initialDataSize = cached->size();
-                    createInfo.pInitialData = cached->data();
-                    usedCached = true;
-                }
-            }
+        if (cached && skgpu::VulkanPipelineCacheDataIsCompatible(
+                              *cached, fGpu->physicalDeviceProperties())) {
+            createInfo.initialDataSize = cached->size();
+            createInfo.pInitialData = cached->data();
+            usedCached = true;
         }
         if (!usedCached) {
             createInfo.initialDataSize = 0;
@@ -81,6 +71,11 @@ VkPipelineCache GrVkResourceProvider::pipelineCache() {
     return fPipelineCache;
 }
 
+VkPipelineCache GrVkResourceProvider::pipelineCacheForNewPipeline() {
+    fPipelineCacheNeedsStore = true;
+    return this->pipelineCache();
+}
+
 void GrVkResourceProvider::init() {
     // Init uniform descriptor objects
     GrVkDescriptorSetManager* dsm = GrVkDescriptorSetManager::CreateUniformManager(fGpu);
@@ -101,7 +96,8 @@ sk_sp<const GrVkPipeline> GrVkResourceProvider::makePipeline(
         VkPipelineLayout layout,
         uint32_t subpass) {
     return GrVkPipeline::Make(fGpu, programInfo, shaderStageInfo, shaderStageCount,
-                              compatibleRenderPass, layout, this->pipelineCache(), subpass);
+                              compatibleRenderPass, layout, this->pipelineCacheForNewPipeline(),
+                              subpass);
 }
 
 // To create framebuffers, we first need to create a simple RenderPass that is
@@ -313,7 +309,7 @@ sk_sp<const GrVkPipeline> GrVkResourceProvider::findOrCreateMSAALoadPipeline(
                 renderPass.vkRenderPass(),
                 pipelineLayout,
                 /*ownsLayout=*/false,
-                this->pipelineCache());
+                this->pipelineCacheForNewPipeline());
         if (!pipeline) {
             return nullptr;
         }
@@ -540,30 +536,34 @@ void GrVkResourceProvider::releaseUnlockedBackendObjects() {
 }
 
 void GrVkResourceProvider::storePipelineCacheData() {
-    if (this->pipelineCache() == VK_NULL_HANDLE) {
-        return;
-    }
-    size_t dataSize = 0;
-    VkResult result;
-    GR_VK_CALL_RESULT(fGpu, result, GetPipelineCacheData(fGpu->device(), this->pipelineCache(),
-                                                         &dataSize, nullptr));
-    if (result != VK_SUCCESS) {
-        return;
-    }
-
-    std::unique_ptr<uint8_t[]> data(new uint8_t[dataSize]);
-
-    GR_VK_CALL_RESULT(fGpu, result, GetPipelineCacheData(fGpu->device(), this->pipelineCache(),
-                                                         &dataSize, (void*)data.get()));
-    if (result != VK_SUCCESS) {
+    // The cache only changes when pipelines are created, so there is nothing new to store
+    // otherwise.
+    if (!fPipelineCacheNeedsStore || this->pipelineCache() == VK_NULL_HANDLE) {
         return;
     }
 
+    auto persistentCache = fGpu->getContext()->priv().getPersistentCache();
     uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
     sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
 
-    fGpu->getContext()->priv().getPersistentCache()->store(
-            *keyData, *SkData::MakeWithoutCopy(data.get(), dataSize), SkString("VkPipelineCache"));
+    // Other processes or contexts that share the persistent cache may have stored pipelines since
+    // this cache was loaded. Merge those in, so that storing this cache doesn't throw them away.
+    if (sk_sp<SkData> stored = persistentCache->load(*keyData)) {
+        skgpu::MergeVulkanPipelineCacheData(fGpu->vkInterface(),
+                                            fGpu->device(),
+                                            fGpu->physicalDeviceProperties(),
+                                            *stored,
+                                            fPipelineCache);
+    }
+
+    sk_sp<SkData> data = skgpu::GetVulkanPipelineCacheData(fGpu->vkInterface(),
+                                                           fGpu->device(),
+                                                           fPipelineCache);
+    if (!data) {
+        return;
+    }
+    persistentCache->store(*keyData, *data, SkString("VkPipelineCache"));
+    fPipelineCacheNeedsStore = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
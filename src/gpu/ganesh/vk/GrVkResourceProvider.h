@@ -291,11 +291,14 @@ private:
     };
 
     VkPipelineCache pipelineCache();
+    // Returns pipelineCache() and notes that it may have new pipelines that haven't been stored.
+    VkPipelineCache pipelineCacheForNewPipeline();
 
     GrVkGpu* fGpu;
 
     // Central cache for creating pipelines
     VkPipelineCache fPipelineCache;
+    bool fPipelineCacheNeedsStore = false;
 
     struct MSAALoadPipeline {
         sk_sp<const GrVkPipeline> fPipeline;
@@ -10,6 +10,7 @@
 #include "include/gpu/graphite/Recorder.h"
 #include "src/gpu/graphite/ComputePathAtlas.h"
 #include "src/gpu/graphite/DrawContext.h"
+#include "src/gpu/graphite/ImageAtlas.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/RasterPathAtlas.h"
 #include "src/gpu/graphite/RecorderPriv.h"
@@ -31,8 +32,11 @@ AtlasProvider::PathAtlasFlagsBitMask AtlasProvider::QueryPathAtlasSupport(const
 AtlasProvider::AtlasProvider(Recorder* recorder)
         : fTextAtlasManager(std::make_unique<TextAtlasManager>(recorder))
         , fRasterPathAtlas(std::make_unique<RasterPathAtlas>(recorder))
+        , fImageAtlas(std::make_unique<ImageAtlas>(recorder))
         , fPathAtlasFlags(QueryPathAtlasSupport(recorder->priv().caps())) {}
 
+AtlasProvider::~AtlasProvider() = default;
+
 std::unique_ptr<ComputePathAtlas> AtlasProvider::createComputePathAtlas(Recorder* recorder) const {
     if (this->isAvailable(PathAtlasFlags::kCompute)) {
         return ComputePathAtlas::CreateDefault(recorder);
@@ -95,6 +99,10 @@ void AtlasProvider::recordUploads(DrawContext* dc) {
     if (fRasterPathAtlas) {
         fRasterPathAtlas->recordUploads(dc);
     }
+
+    if (!fImageAtlas->recordUploads(dc)) {
+        SKGPU_LOG_E("ImageAtlas uploads have failed -- may see invalid results.");
+    }
 }
 
 void AtlasProvider::postFlush() {
@@ -102,6 +110,7 @@ void AtlasProvider::postFlush() {
     if (fRasterPathAtlas) {
         fRasterPathAtlas->postFlush();
     }
+    fImageAtlas->postFlush();
 }
 
 }  // namespace skgpu::graphite
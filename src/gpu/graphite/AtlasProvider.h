@@ -21,6 +21,7 @@ namespace skgpu::graphite {
 class Caps;
 class ComputePathAtlas;
 class DrawContext;
+class ImageAtlas;
 class PathAtlas;
 class RasterPathAtlas;
 class Recorder;
@@ -46,7 +47,7 @@ public:
     static PathAtlasFlagsBitMask QueryPathAtlasSupport(const Caps*);
 
     explicit AtlasProvider(Recorder*);
-    ~AtlasProvider() = default;
+    ~AtlasProvider();
 
     // Returns the TextAtlasManager that provides access to persistent DrawAtlas instances used in
     // glyph rendering. This TextAtlasManager is always available.
@@ -67,6 +68,10 @@ public:
     // for path rendering.
     RasterPathAtlas* getRasterPathAtlas() const;
 
+    // Gets the atlas that small images are copied into, so that draws of different images can
+    // share a texture.
+    ImageAtlas* getImageAtlas() const { return fImageAtlas.get(); }
+
     // Return a TextureProxy with the given dimensions and color type.
     sk_sp<TextureProxy> getAtlasTexture(
             Recorder*, uint16_t width, uint16_t height, SkColorType, uint16_t identifier,
@@ -95,6 +100,8 @@ private:
     // upload.
     std::unique_ptr<RasterPathAtlas> fRasterPathAtlas;
 
+    std::unique_ptr<ImageAtlas> fImageAtlas;
+
     // Allocated and cached texture proxies shared by all PathAtlas instances. It is possible for
     // the same texture to be bound to multiple DispatchGroups and DrawPasses across flushes. The
     // owning Recorder must guarantee that any uploads or compute dispatches are scheduled to remain
@@ -75,6 +75,7 @@ enum class BuiltInCodeSnippetID : int32_t {
     // Clip shader snippet
     // TODO(b/238763003): Avoid incorporating clip shaders into the actual shader code.
     kClipShader,
+    kAnalyticClip,
 
     kCompose,
 
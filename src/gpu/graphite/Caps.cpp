@@ -36,6 +36,9 @@ void Caps::finishInitialization(const ContextOptions& options) {
     } else {
         fShaderErrorHandler = DefaultShaderErrorHandler();
     }
+    fPersistentCache = options.fPersistentCache;
+    fPipelineCompileExecutor = options.fPipelineCompileExecutor;
+    fExecutor = options.fExecutor;
 
 #if defined(GRAPHITE_TEST_UTILS)
     if (options.fOptionsPriv) {
@@ -14,6 +14,7 @@
 
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
+#include "include/gpu/graphite/ContextOptions.h"
 #include "include/private/base/SkAlign.h"
 #include "src/base/SkEnumBitMask.h"
 #include "src/gpu/ResourceKey.h"
@@ -29,6 +30,7 @@
 enum class SkBlendMode;
 enum class SkTextureCompressionType;
 class SkCapabilities;
+class SkExecutor;
 
 namespace SkSL { struct ShaderCaps; }
 
@@ -37,7 +39,6 @@ namespace skgpu { class ShaderErrorHandler; }
 namespace skgpu::graphite {
 
 enum class BufferType : int;
-struct ContextOptions;
 class ComputePipelineDesc;
 class GraphicsPipelineDesc;
 class GraphiteResourceKey;
@@ -256,6 +257,10 @@ public:
     // Returns whether compute shaders are supported.
     bool computeSupport() const { return fComputeSupport; }
 
+    // Returns whether the GPU time of render and compute passes can be measured with timestamp
+    // queries.
+    bool timestampQuerySupport() const { return fTimestampQuerySupport; }
+
     /**
      * Returns true if the given backend supports importing AHardwareBuffers. This will only
      * ever be supported on Android devices with API level >= 26.
@@ -272,6 +277,12 @@ public:
 
     skgpu::ShaderErrorHandler* shaderErrorHandler() const { return fShaderErrorHandler; }
 
+    ContextOptions::PersistentCache* persistentCache() const { return fPersistentCache; }
+
+    SkExecutor* pipelineCompileExecutor() const { return fPipelineCompileExecutor; }
+
+    SkExecutor* executor() const { return fExecutor; }
+
     // Returns what method of dst read is required for a draw using the dst color.
     DstReadRequirement getDstReadRequirement() const;
 
@@ -373,6 +384,7 @@ protected:
     bool fMSAARenderToSingleSampledSupport = false;
 
     bool fComputeSupport = false;
+    bool fTimestampQuerySupport = false;
     bool fSupportsAHardwareBufferImages = false;
     bool fFullCompressedUploadSizeMustAlignToBlockDims = false;
 
@@ -391,6 +403,21 @@ protected:
      */
     ShaderErrorHandler* fShaderErrorHandler = nullptr;
 
+    /**
+     * If present, backend shader code generated from SkSL is cached here across sessions.
+     */
+    ContextOptions::PersistentCache* fPersistentCache = nullptr;
+
+    /**
+     * If present, missing graphics pipelines are compiled in parallel on this executor.
+     */
+    SkExecutor* fPipelineCompileExecutor = nullptr;
+
+    /**
+     * If present, CPU work such as rasterizing path masks is done in parallel on this executor.
+     */
+    SkExecutor* fExecutor = nullptr;
+
 #if defined(GRAPHITE_TEST_UTILS)
     std::string fDeviceName;
     int fMaxTextureAtlasSize = 2048;
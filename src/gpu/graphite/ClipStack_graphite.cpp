@@ -80,6 +80,40 @@ bool oriented_bbox_intersection(const Rect& a, const Transform& aXform,
     return all(overlaps); // any non-overlapping interval would imply no intersection
 }
 
+// Returns the device-space analytic form of a clip element, or an empty AnalyticClip if the
+// element is not a rect or a circular rrect that stays axis-aligned and circular on the device.
+AnalyticClip analytic_clip(const Transform& localToDevice, const Shape& shape, SkClipOp op) {
+    if (localToDevice.type() > Transform::Type::kSimpleRectStaysRect) {
+        return {};
+    }
+
+    Rect bounds;
+    float radius;
+    if (shape.isRect()) {
+        bounds = shape.rect();
+        radius = 0.f;
+    } else if (shape.isRRect() && (shape.rrect().isRect() ||
+                                   SkRRectPriv::IsSimpleCircular(shape.rrect()) ||
+                                   SkRRectPriv::IsCircle(shape.rrect()))) {
+        bounds = shape.rrect().rect();
+        radius = shape.rrect().radii(SkRRect::kUpperLeft_Corner).fX;
+    } else {
+        return {};
+    }
+
+    if (localToDevice.type() == Transform::Type::kSimpleRectStaysRect && radius > 0.f) {
+        // Scale-and-translate only, so the corners stay circular if both axes scale alike.
+        const float sx = localToDevice.matrix().rc(0, 0);
+        const float sy = localToDevice.matrix().rc(1, 1);
+        if (!SkScalarNearlyEqual(sx, sy)) {
+            return {};
+        }
+        radius *= sx;
+    }
+
+    return {localToDevice.mapRect(bounds), radius, op == SkClipOp::kDifference};
+}
+
 static constexpr Transform kIdentity = Transform::Identity();
 
 } // anonymous namespace
@@ -1243,6 +1277,22 @@ Clip ClipStack::visitClipStackForDraw(const Transform& localToDevice,
         }
     }
 
+    // A single rect or circular rrect element can be applied in the draw's fragment shader, which
+    // is cheaper than recording a depth-only draw of the element. This isn't done if the element
+    // already has a depth draw pending for earlier draws, since testing against it is then free,
+    // or if there is a clip shader, since a draw can only have one of them.
+    if (outEffectiveElements->size() == 1 && !cs.shader()) {
+        const RawElement* e = static_cast<const RawElement*>(outEffectiveElements->front());
+        if (!e->hasPendingDraw()) {
+            AnalyticClip analyticClip = analytic_clip(e->localToDevice(), e->shape(), e->op());
+            if (!analyticClip.isEmpty()) {
+                outEffectiveElements->clear();
+                return Clip(drawBounds, transformedShapeBounds, scissor.asSkIRect(),
+                            /*shader=*/nullptr, analyticClip);
+            }
+        }
+    }
+
     return Clip(drawBounds, transformedShapeBounds, scissor.asSkIRect(), cs.shader());
 }
 
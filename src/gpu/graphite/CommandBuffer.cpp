@@ -7,6 +7,7 @@
 
 #include "src/gpu/graphite/CommandBuffer.h"
 
+#include "include/private/base/SkTemplates.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/graphite/Buffer.h"
@@ -38,6 +39,9 @@ void CommandBuffer::resetCommandBuffer() {
     this->releaseResources();
     this->onResetCommandBuffer();
     fBuffersToAsyncMap.clear();
+    fPassTimingRequests.clear();
+    fTimedPassTypes.clear();
+    fTimingPasses = false;
 }
 
 void CommandBuffer::trackResource(sk_sp<Resource> resource) {
@@ -53,14 +57,73 @@ void CommandBuffer::addFinishedProc(sk_sp<RefCntedCallback> finishedProc) {
 }
 
 void CommandBuffer::callFinishedProcs(bool success) {
-    if (!success) {
+    if (success) {
+        this->reportPassTimings();
+    } else {
         for (int i = 0; i < fFinishedProcs.size(); ++i) {
             fFinishedProcs[i]->setFailureResult();
         }
     }
+    fPassTimingRequests.clear();
     fFinishedProcs.clear();
 }
 
+void CommandBuffer::beginPassTimings(GpuTimingsProc proc, GpuTimingsContext context) {
+    SkASSERT(proc);
+    SkASSERT(!fTimingPasses);
+    fPassTimingRequests.push_back({proc, context, fTimedPassTypes.size(), /*fNumPasses=*/0});
+    fTimingPasses = true;
+}
+
+void CommandBuffer::endPassTimings(bool succeeded) {
+    SkASSERT(fTimingPasses);
+    if (!succeeded) {
+        fPassTimingRequests.back().fProc = nullptr;
+    }
+    fTimingPasses = false;
+}
+
+bool CommandBuffer::beginTimedPass() {
+    return fTimingPasses && this->onWriteTimestamp(2 * fTimedPassTypes.size());
+}
+
+void CommandBuffer::endTimedPass(GpuPassTiming::Type type) {
+    SkAssertResult(this->onWriteTimestamp(2 * fTimedPassTypes.size() + 1));
+    fTimedPassTypes.push_back(type);
+    fPassTimingRequests.back().fNumPasses++;
+}
+
+void CommandBuffer::reportPassTimings() {
+    if (fPassTimingRequests.empty()) {
+        return;
+    }
+    int numTimestamps = 2 * fTimedPassTypes.size();
+    skia_private::AutoTMalloc<uint64_t> timestamps(numTimestamps);
+    if (numTimestamps && !this->onReadTimestamps(numTimestamps, timestamps.get())) {
+        return;
+    }
+
+    skia_private::STArray<8, GpuPassTiming> timings;
+    for (const PassTimingRequest& request : fPassTimingRequests) {
+        if (!request.fProc) {
+            continue;
+        }
+        timings.clear();
+        uint64_t renderNs = 0, computeNs = 0;
+        for (int i = request.fFirstPass; i < request.fFirstPass + request.fNumPasses; ++i) {
+            uint64_t start = timestamps[2 * i];
+            uint64_t end = timestamps[2 * i + 1];
+            uint64_t elapsedNs = end > start ? end - start : 0;
+            timings.push_back({fTimedPassTypes[i], elapsedNs});
+            (fTimedPassTypes[i] == GpuPassTiming::Type::kRender ? renderNs : computeNs) +=
+                    elapsedNs;
+        }
+        TRACE_COUNTER2("skia.gpu", "Recording GPU time (us)",
+                       "render", renderNs / 1000, "compute", computeNs / 1000);
+        request.fProc(request.fContext, timings);
+    }
+}
+
 void CommandBuffer::addBuffersToAsyncMapOnSubmit(SkSpan<const sk_sp<Buffer>> buffers) {
     for (size_t i = 0; i < buffers.size(); ++i) {
         SkASSERT(buffers[i]);
@@ -81,12 +144,18 @@ bool CommandBuffer::addRenderPass(const RenderPassDesc& renderPassDesc,
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
 
     fRenderPassSize = colorTexture->dimensions();
-    if (!this->onAddRenderPass(renderPassDesc,
-                               colorTexture.get(),
-                               resolveTexture.get(),
-                               depthStencilTexture.get(),
-                               viewport,
-                               drawPasses)) {
+    bool timed = this->beginTimedPass();
+    bool succeeded = this->onAddRenderPass(renderPassDesc,
+                                           colorTexture.get(),
+                                           resolveTexture.get(),
+                                           depthStencilTexture.get(),
+                                           viewport,
+                                           drawPasses);
+    // The end timestamp is written even on failure, so that every query is written at most once.
+    if (timed) {
+        this->endTimedPass(GpuPassTiming::Type::kRender);
+    }
+    if (!succeeded) {
         return false;
     }
 
@@ -110,7 +179,12 @@ bool CommandBuffer::addRenderPass(const RenderPassDesc& renderPassDesc,
 bool CommandBuffer::addComputePass(DispatchGroupSpan dispatchGroups) {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
 
-    if (!this->onAddComputePass(dispatchGroups)) {
+    bool timed = this->beginTimedPass();
+    bool succeeded = this->onAddComputePass(dispatchGroups);
+    if (timed) {
+        this->endTimedPass(GpuPassTiming::Type::kCompute);
+    }
+    if (!succeeded) {
         return false;
     }
 
@@ -11,6 +11,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/private/base/SkTArray.h"
 #include "src/gpu/GpuRefCnt.h"
 #include "src/gpu/graphite/CommandTypes.h"
@@ -63,6 +64,13 @@ public:
     void addFinishedProc(sk_sp<RefCntedCallback> finishedProc);
     void callFinishedProcs(bool success);
 
+    // Measures the GPU time of each render and compute pass added until endPassTimings(). Once the
+    // command buffer has finished, the timings are passed to 'proc' in callFinishedProcs(). This
+    // should only be used if Caps::timestampQuerySupport() is true.
+    void beginPassTimings(GpuTimingsProc proc, GpuTimingsContext context);
+    // If 'succeeded' is false, the passes timed since beginPassTimings() are not reported.
+    void endPassTimings(bool succeeded);
+
     virtual void addWaitSemaphores(size_t numWaitSemaphores,
                                    const BackendSemaphore* waitSemaphores) {}
     virtual void addSignalSemaphores(size_t numWaitSemaphores,
@@ -122,8 +130,22 @@ private:
     // Release all tracked Resources
     void releaseResources();
 
+    // Returns whether the pass about to be added should be timed, and writes its start timestamp.
+    bool beginTimedPass();
+    void endTimedPass(GpuPassTiming::Type);
+    void reportPassTimings();
+
     virtual void onResetCommandBuffer() = 0;
 
+    // Writes a timestamp into query 'index' once the GPU has finished all previously recorded
+    // commands. Indices start at zero for each command buffer and increase by one with each call.
+    // Returns false if no more timestamps can be written to this command buffer; backends that
+    // support timestamp queries must then still accept the odd index following an even one.
+    virtual bool onWriteTimestamp(int index) { return false; }
+    // Reads back the first 'count' timestamps written to this command buffer, in nanoseconds. This
+    // is only called once the command buffer has finished on the GPU.
+    virtual bool onReadTimestamps(int count, uint64_t* outNanoseconds) { return false; }
+
     virtual bool onAddRenderPass(const RenderPassDesc&,
                                  const Texture* colorTexture,
                                  const Texture* resolveTexture,
@@ -164,6 +186,18 @@ private:
     TrackedResourceArray<sk_sp<Resource>> fTrackedUsageResources;
     TrackedResourceArray<gr_cb<Resource>> fCommandBufferResources;
     skia_private::TArray<sk_sp<RefCntedCallback>> fFinishedProcs;
+
+    // The passes timed by each beginPassTimings()/endPassTimings() pair. Pass i is timed by
+    // timestamps 2i and 2i + 1.
+    struct PassTimingRequest {
+        GpuTimingsProc fProc;
+        GpuTimingsContext fContext;
+        int fFirstPass;
+        int fNumPasses;
+    };
+    skia_private::TArray<PassTimingRequest> fPassTimingRequests;
+    skia_private::TArray<GpuPassTiming::Type> fTimedPassTypes;
+    bool fTimingPasses = false;
     skia_private::TArray<sk_sp<Buffer>> fBuffersToAsyncMap;
 };
 
@@ -17,6 +17,7 @@
 #include "src/gpu/graphite/RendererProvider.h"
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/TextureUtils.h"
+#include "src/gpu/graphite/geom/Shape.h"
 #include "src/gpu/graphite/geom/Transform_graphite.h"
 
 #ifdef SK_ENABLE_VELLO_SHADERS
@@ -35,6 +36,12 @@ constexpr uint16_t kComputeAtlasDim = 4096;
 // dispatches to render multiple atlas pages can be prohibitive.
 constexpr size_t kBboxAreaThreshold = 1024 * 512;
 
+// Paths with at least this many verbs are CPU-bound when they are tessellated, since the
+// tessellating renderers prepare every curve on the CPU and stencil the path before covering it.
+// For these it's worth taking up more of an atlas page, up to a quarter of it.
+constexpr int kComplexPathVerbCount = 256;
+constexpr size_t kComplexPathBboxAreaThreshold = (kComputeAtlasDim / 2) * (kComputeAtlasDim / 2);
+
 // Coordinate size that is too large for vello to handle efficiently. See the discussion on
 // https://github.com/linebender/vello/pull/542.
 constexpr float kCoordinateThreshold = 1e10;
@@ -59,7 +66,8 @@ bool ComputePathAtlas::initializeTextureIfNeeded() {
 }
 
 bool ComputePathAtlas::isSuitableForAtlasing(const Rect& transformedShapeBounds,
-                                             const Rect& clipBounds) const {
+                                             const Rect& clipBounds,
+                                             const Shape& shape) const {
     Rect shapeBounds = transformedShapeBounds.makeRoundOut();
     Rect maskBounds = shapeBounds.makeIntersect(clipBounds);
     skvx::float2 maskSize = maskBounds.size();
@@ -71,8 +79,11 @@ bool ComputePathAtlas::isSuitableForAtlasing(const Rect& transformedShapeBounds,
 
     // For now we're allowing paths that are smaller than 1/32nd of the full 4096x4096 atlas size
     // to prevent the atlas texture from filling up too often. There are several approaches we
-    // should explore to alleviate the cost of atlasing large paths.
-    if (width * height > kBboxAreaThreshold) {
+    // should explore to alleviate the cost of atlasing large paths. Complex paths are allowed to
+    // be larger as the alternative is usually slower still.
+    const bool isComplexPath =
+            shape.isPath() && shape.path().countVerbs() >= kComplexPathVerbCount;
+    if (width * height > (isComplexPath ? kComplexPathBboxAreaThreshold : kBboxAreaThreshold)) {
         return false;
     }
 
@@ -162,7 +173,8 @@ private:
                           const Transform& transform,
                           const SkStrokeRec&,
                           SkIRect shapeBounds,
-                          const AtlasLocator&) override;
+                          const AtlasLocator&,
+                          const skgpu::UniqueKey* maskKey) override;
 
     private:
         VelloScene fScenes[PlotLocator::kMaxMultitexturePages];
@@ -361,7 +373,8 @@ bool VelloComputePathAtlas::VelloAtlasMgr::onAddToAtlas(const Shape& shape,
                                                         const Transform& transform,
                                                         const SkStrokeRec& style,
                                                         SkIRect shapeBounds,
-                                                        const AtlasLocator& locator) {
+                                                        const AtlasLocator& locator,
+                                                        const skgpu::UniqueKey*) {
     uint32_t index = locator.pageIndex();
     const TextureProxy* texProxy = fDrawAtlas->getProxies()[index].get();
     if (!texProxy) {
@@ -59,7 +59,8 @@ protected:
     const TextureProxy* addRect(skvx::half2 maskSize,
                                 SkIPoint16* outPos);
     bool isSuitableForAtlasing(const Rect& transformedShapeBounds,
-                               const Rect& clipBounds) const override;
+                               const Rect& clipBounds,
+                               const Shape& shape) const override;
 
     virtual void onReset() = 0;
 
@@ -20,6 +20,7 @@
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkColorFilterPriv.h"
 #include "src/core/SkConvertPixels.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/core/SkYUVMath.h"
 #include "src/gpu/RefCntedCallback.h"
@@ -88,6 +89,7 @@ Context::Context(sk_sp<SharedContext> sharedContext,
     fResourceProvider = fSharedContext->makeResourceProvider(&fSingleOwner,
                                                              SK_InvalidGenID,
                                                              options.fGpuBudgetInBytes);
+    fResourceProvider->setResourceCacheOverBudgetPurgeLimit(options.fOverBudgetPurgeLimitInBytes);
     fMappedBufferManager = std::make_unique<ClientMappedBufferManager>(this->contextID());
 #if defined(GRAPHITE_TEST_UTILS)
     if (options.fOptionsPriv) {
@@ -629,6 +631,28 @@ void Context::finalizeAsyncReadPixels(std::unique_ptr<Recorder> recorder,
     }
 }
 
+// Returns true if pixels read back as |readInfo| can be handed to the client as |dstInfo| without
+// changing them, so that the mapped transfer buffer can be used directly.
+static bool read_matches_dst(const SkColorInfo& readInfo, const SkColorInfo& dstInfo) {
+    if (readInfo == dstInfo) {
+        return true;
+    }
+    const SkColorType colorType = readInfo.colorType();
+    if (colorType != dstInfo.colorType()) {
+        return false;
+    }
+    const uint32_t channels = SkColorTypeChannelFlags(colorType);
+    if ((channels & ~kAlpha_SkColorChannelFlag) &&
+        !SkColorSpace::Equals(readInfo.colorSpace(), dstInfo.colorSpace())) {
+        return false;
+    }
+    // Converting between alpha types only changes pixels that have color and aren't opaque.
+    return readInfo.alphaType() == dstInfo.alphaType() ||
+           readInfo.alphaType() == kOpaque_SkAlphaType ||
+           SkColorTypeIsAlwaysOpaque(colorType) ||
+           channels == kAlpha_SkColorChannelFlag;
+}
+
 Context::PixelTransferResult Context::transferPixels(Recorder* recorder,
                                                      const TextureProxy* srcProxy,
                                                      const SkColorInfo& srcColorInfo,
@@ -701,7 +725,7 @@ Context::PixelTransferResult Context::transferPixels(Recorder* recorder,
     // which may be different; dstColorInfo is what we have to transform it into when invoking the
     // async callbacks.
     SkColorInfo readColorInfo = srcColorInfo.makeColorType(supportedColorType);
-    if (readColorInfo != dstColorInfo || isRGB888Format) {
+    if (isRGB888Format || !read_matches_dst(readColorInfo, dstColorInfo)) {
         SkISize dims = srcRect.size();
         SkImageInfo srcInfo = SkImageInfo::Make(dims, readColorInfo);
         SkImageInfo dstInfo = SkImageInfo::Make(dims, dstColorInfo);
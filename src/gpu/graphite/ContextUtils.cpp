@@ -7,8 +7,12 @@
 
 #include "src/gpu/graphite/ContextUtils.h"
 
+#include <cstring>
 #include <string>
+#include "include/core/SkData.h"
+#include "include/private/base/SkTemplates.h"
 #include "src/core/SkBlenderBase.h"
+#include "src/core/SkChecksum.h"
 #include "src/gpu/BlendFormula.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
@@ -24,8 +28,11 @@
 #include "src/gpu/graphite/UniquePaintParamsID.h"
 #include "src/gpu/graphite/compute/ComputeStep.h"
 #include "src/gpu/graphite/geom/Geometry.h"
+#include "src/sksl/SkSLProgramKind.h"
+#include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/SkSLString.h"
 #include "src/sksl/SkSLUtil.h"
+#include "src/sksl/ir/SkSLProgram.h"
 
 namespace skgpu::graphite {
 
@@ -668,4 +675,123 @@ std::string BuildComputeSkSL(const Caps* caps, const ComputeStep* step) {
     return sksl;
 }
 
+namespace {
+
+// Bump when the key or data layout changes, or when SkSL codegen changes in a way that the key
+// does not capture.
+static constexpr uint32_t kPersistentCacheVersion = 1;
+
+sk_sp<SkData> make_persistent_cache_key(const char* backendLabel,
+                                        const std::string& sksl,
+                                        SkSL::ProgramKind kind,
+                                        const SkSL::ProgramSettings& settings) {
+    const uint32_t flags = (settings.fFragColorIsInOut          << 0) |
+                           (settings.fForceHighPrecision        << 1) |
+                           (settings.fSharpenTextures           << 2) |
+                           (settings.fForceNoRTFlip             << 3) |
+                           (settings.fOptimize                  << 4) |
+                           (settings.fRemoveDeadFunctions       << 5) |
+                           (settings.fRemoveDeadVariables       << 6) |
+                           (settings.fForceNoInline             << 7) |
+                           (settings.fAllowNarrowingConversions << 8) |
+                           (settings.fUsePushConstants          << 9);
+    // The SkSL text itself is a deterministic function of the PaintParamsKey, RenderStep and Caps,
+    // so hashing it (rather than embedding it) keeps keys small without losing anything.
+    const uint64_t skslHashes[2] = {SkChecksum::Hash64(sksl.data(), sksl.size(), 0),
+                                    SkChecksum::Hash64(sksl.data(), sksl.size(), 1)};
+    const uint32_t fields[] = {
+            kPersistentCacheVersion,
+            SkChecksum::Hash32(backendLabel, strlen(backendLabel)),
+            static_cast<uint32_t>(kind),
+            flags,
+            static_cast<uint32_t>(settings.fRTFlipOffset),
+            static_cast<uint32_t>(settings.fRTFlipBinding),
+            static_cast<uint32_t>(settings.fRTFlipSet),
+            static_cast<uint32_t>(settings.fDefaultUniformSet),
+            static_cast<uint32_t>(settings.fDefaultUniformBinding),
+            static_cast<uint32_t>(settings.fInlineThreshold),
+            static_cast<uint32_t>(settings.fMaxVersionAllowed),
+            static_cast<uint32_t>(sksl.size()),
+    };
+    sk_sp<SkData> key = SkData::MakeUninitialized(sizeof(fields) + sizeof(skslHashes));
+    memcpy(key->writable_data(), fields, sizeof(fields));
+    memcpy(SkTAddOffset<void>(key->writable_data(), sizeof(fields)), skslHashes,
+           sizeof(skslHashes));
+    return key;
+}
+
+// The cached data is a small header holding the program interface, followed by the backend code.
+struct PersistentCacheHeader {
+    uint32_t fVersion;
+    uint8_t fRTFlipUniform;
+    uint8_t fUseLastFragColor;
+    uint8_t fOutputSecondaryColor;
+    uint8_t fPad;
+};
+
+bool unpack_persistent_cache_data(const SkData& data,
+                                  std::string* output,
+                                  SkSL::ProgramInterface* outInterface) {
+    PersistentCacheHeader header;
+    if (data.size() <= sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.fVersion != kPersistentCacheVersion) {
+        return false;
+    }
+    outInterface->fRTFlipUniform = header.fRTFlipUniform;
+    outInterface->fUseLastFragColor = header.fUseLastFragColor;
+    outInterface->fOutputSecondaryColor = header.fOutputSecondaryColor;
+    output->assign(SkTAddOffset<const char>(data.data(), sizeof(header)),
+                   data.size() - sizeof(header));
+    return true;
+}
+
+sk_sp<SkData> pack_persistent_cache_data(const std::string& output,
+                                         const SkSL::ProgramInterface& interface) {
+    PersistentCacheHeader header = {kPersistentCacheVersion,
+                                    interface.fRTFlipUniform,
+                                    interface.fUseLastFragColor,
+                                    interface.fOutputSecondaryColor,
+                                    0};
+    sk_sp<SkData> data = SkData::MakeUninitialized(sizeof(header) + output.size());
+    memcpy(data->writable_data(), &header, sizeof(header));
+    memcpy(SkTAddOffset<void>(data->writable_data(), sizeof(header)), output.data(),
+           output.size());
+    return data;
+}
+
+}  // anonymous namespace
+
+bool SkSLToBackendCached(const Caps* caps,
+                         SkSLToBackendFn toBackend,
+                         const char* backendLabel,
+                         const std::string& sksl,
+                         SkSL::ProgramKind kind,
+                         const SkSL::ProgramSettings& settings,
+                         std::string* output,
+                         SkSL::ProgramInterface* outInterface) {
+    ContextOptions::PersistentCache* cache = caps->persistentCache();
+    sk_sp<SkData> key;
+    if (cache) {
+        key = make_persistent_cache_key(backendLabel, sksl, kind, settings);
+        if (sk_sp<SkData> data = cache->load(*key)) {
+            if (unpack_persistent_cache_data(*data, output, outInterface)) {
+                return true;
+            }
+        }
+    }
+
+    if (!toBackend(caps->shaderCaps(), sksl, kind, settings, output, outInterface,
+                   caps->shaderErrorHandler())) {
+        return false;
+    }
+
+    if (cache && !output->empty()) {
+        cache->store(*key, *pack_persistent_cache_data(*output, *outInterface));
+    }
+    return true;
+}
+
 } // namespace skgpu::graphite
@@ -19,7 +19,15 @@ class SkColorInfo;
 class SkM44;
 class SkPaint;
 
+namespace SkSL {
+enum class ProgramKind : int8_t;
+struct ProgramInterface;
+struct ProgramSettings;
+struct ShaderCaps;
+}  // namespace SkSL
+
 namespace skgpu {
+class ShaderErrorHandler;
 class Swizzle;
 }
 
@@ -106,6 +114,26 @@ std::string GetPipelineLabel(const ShaderCodeDictionary*,
 
 std::string BuildComputeSkSL(const Caps*, const ComputeStep*);
 
+// Matches skgpu::SkSLToSPIRV, SkSLToMSL, and SkSLToWGSL.
+using SkSLToBackendFn = bool (*)(const SkSL::ShaderCaps*,
+                                 const std::string& sksl,
+                                 SkSL::ProgramKind,
+                                 const SkSL::ProgramSettings&,
+                                 std::string* output,
+                                 SkSL::ProgramInterface* outInterface,
+                                 skgpu::ShaderErrorHandler*);
+
+// Compiles `sksl` with `toBackend`. If the Context was given a PersistentCache, the backend code
+// and program interface are loaded from it when present, and stored to it after a compile.
+bool SkSLToBackendCached(const Caps*,
+                         SkSLToBackendFn toBackend,
+                         const char* backendLabel,
+                         const std::string& sksl,
+                         SkSL::ProgramKind,
+                         const SkSL::ProgramSettings&,
+                         std::string* output,
+                         SkSL::ProgramInterface* outInterface);
+
 std::string EmitPaintParamsUniforms(int bufferID,
                                     const Layout layout,
                                     SkSpan<const ShaderNode*> nodes,
@@ -23,9 +23,12 @@
 #include "src/gpu/graphite/DrawContext.h"
 #include "src/gpu/graphite/DrawList.h"
 #include "src/gpu/graphite/DrawParams.h"
+#include "src/gpu/graphite/ImageAtlas.h"
 #include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/Image_YUVA_Graphite.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/PathAtlas.h"
+#include "src/gpu/graphite/ProxyCache.h"
 #include "src/gpu/graphite/RasterPathAtlas.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/Renderer.h"
@@ -63,6 +66,7 @@
 #include "src/core/SkTraceEvent.h"
 #include "src/core/SkVerticesPriv.h"
 #include "src/gpu/TiledTextureUtils.h"
+#include "src/shaders/SkImageShader.h"
 #include "src/text/GlyphRun.h"
 #include "src/text/gpu/GlyphVector.h"
 #include "src/text/gpu/SlugImpl.h"
@@ -189,6 +193,45 @@ bool use_compute_atlas_when_available(PathRendererStrategy strategy) {
            strategy == PathRendererStrategy::kDefault;
 }
 
+bool can_draw_from_image_atlas(const SkImage* image, const SkSamplingOptions& sampling) {
+    // The atlas has no mipmaps, and cubic and anisotropic filtering are left to the image's own
+    // texture.
+    return sampling.mipmap == SkMipmapMode::kNone && !sampling.useCubic && !sampling.isAniso() &&
+           ImageAtlas::IsSuitable(image);
+}
+
+// Like SkModifyPaintAndDstForDrawImageRect(), but for an image that was copied to 'atlasPos' in
+// 'atlasImage'. The shader is restricted to the image's pixels in the atlas, or to 'src' for a
+// strict draw, so that filtering never reads the neighboring images.
+SkRect modify_paint_and_dst_for_atlased_image(const Image* atlasImage,
+                                              SkIPoint atlasPos,
+                                              SkISize imageSize,
+                                              const SkSamplingOptions& sampling,
+                                              SkRect src,
+                                              SkRect dst,
+                                              bool strictSrcSubset,
+                                              SkPaint* paint) {
+    SkRect imgBounds = SkRect::Make(imageSize);
+    SkMatrix localMatrix = SkMatrix::RectToRect(src, dst);
+    if (!imgBounds.contains(src)) {
+        if (!src.intersect(imgBounds)) {
+            return SkRect::MakeEmpty();
+        }
+        dst = localMatrix.mapRect(src);
+    }
+
+    SkRect subset = (strictSrcSubset ? src : imgBounds).makeOffset(atlasPos.x(), atlasPos.y());
+    localMatrix.preTranslate(-atlasPos.x(), -atlasPos.y());
+    sk_sp<SkShader> imgShader = SkImageShader::MakeSubset(sk_ref_sp(atlasImage), subset,
+                                                          SkTileMode::kClamp, SkTileMode::kClamp,
+                                                          sampling, &localMatrix);
+    if (!imgShader) {
+        return SkRect::MakeEmpty();
+    }
+    paint->setShader(std::move(imgShader));
+    return dst;
+}
+
 } // anonymous namespace
 
 /**
@@ -839,21 +882,45 @@ void Device::drawEdgeAAImageSet(const SkCanvas::ImageSetEntry set[], int count,
         // Similarly, if it has an extra transform, those must be provided
         SkASSERT(set[i].fMatrixIndex < 0 || preViewMatrices);
 
-        auto [ imageToDraw, newSampling ] =
-                skgpu::graphite::GetGraphiteBacked(this->recorder(), set[i].fImage.get(), sampling);
-        if (!imageToDraw) {
-            SKGPU_LOG_W("Device::drawImageRect: Creation of Graphite-backed image failed");
-            return;
-        }
-
         // TODO: Produce an image shading paint key and data directly without having to reconstruct
         // the equivalent SkPaint for each entry. Reuse the key and data between entries if possible
         paintWithShader.setShader(paint.refShader());
         paintWithShader.setAlphaf(paint.getAlphaf() * set[i].fAlpha);
-        SkRect dst = SkModifyPaintAndDstForDrawImageRect(
-                    imageToDraw.get(), newSampling, set[i].fSrcRect, set[i].fDstRect,
-                    constraint == SkCanvas::kStrict_SrcRectConstraint,
-                    &paintWithShader);
+        const bool strict = constraint == SkCanvas::kStrict_SrcRectConstraint;
+
+        // Small images are drawn from a shared atlas instead of a texture of their own.
+        SkIPoint atlasPos;
+        sk_sp<Image> atlasImage;
+        if (can_draw_from_image_atlas(set[i].fImage.get(), sampling)) {
+            atlasImage = fRecorder->priv().atlasProvider()->getImageAtlas()->findOrAddImage(
+                    set[i].fImage.get(), &atlasPos);
+        }
+
+        SkRect dst;
+        if (atlasImage) {
+            dst = modify_paint_and_dst_for_atlased_image(
+                    atlasImage.get(), atlasPos, set[i].fImage->dimensions(), sampling,
+                    set[i].fSrcRect, set[i].fDstRect, strict, &paintWithShader);
+        } else {
+            auto [ imageToDraw, newSampling ] = skgpu::graphite::GetGraphiteBacked(
+                    this->recorder(), set[i].fImage.get(), sampling);
+            if (!imageToDraw) {
+                SKGPU_LOG_W("Device::drawImageRect: Creation of Graphite-backed image failed");
+                return;
+            }
+            // YUVA images that are drawn repeatedly are converted to RGBA once, instead of
+            // converting from their planes in every draw.
+            if (as_IB(imageToDraw)->isYUVA() && newSampling.mipmap == SkMipmapMode::kNone) {
+                if (sk_sp<Image> converted = fRecorder->priv().proxyCache()
+                            ->findOrCreateConvertedYUVA(
+                                    fRecorder, static_cast<const Image_YUVA*>(imageToDraw.get()))) {
+                    imageToDraw = std::move(converted);
+                }
+            }
+            dst = SkModifyPaintAndDstForDrawImageRect(
+                        imageToDraw.get(), newSampling, set[i].fSrcRect, set[i].fDstRect, strict,
+                        &paintWithShader);
+        }
         if (dst.isEmpty()) {
             return;
         }
@@ -1195,8 +1262,12 @@ void Device::drawGeometry(const Transform& localToDevice,
                         std::move(primitiveBlender),
                         sk_ref_sp(clip.shader()),
                         dstReadReq,
-                        skipColorXform};
-    const bool dependsOnDst = rendererCoverage != Coverage::kNone || paint_depends_on_dst(shading);
+                        skipColorXform,
+                        clip.analyticClip()};
+    // An analytic clip adds coverage to the draw, like a renderer's coverage does.
+    const bool dependsOnDst = rendererCoverage != Coverage::kNone ||
+                              !clip.analyticClip().isEmpty() ||
+                              paint_depends_on_dst(shading);
     if (dependsOnDst) {
         CompressedPaintersOrder prevDraw =
             fColorDepthBoundsManager->getMostRecentDraw(clip.drawBounds());
@@ -1243,12 +1314,29 @@ void Device::drawGeometry(const Transform& localToDevice,
         }
     }
 
-    // TODO: If 'fullyOpaque' is true, it might be useful to store the draw bounds and Z in a
-    // special occluders list for filtering the DrawList/DrawPass when flushing.
-    // const bool fullyOpaque = !dependsOnDst &&
-    //                          clipOrder == DrawOrder::kNoIntersection &&
-    //                          shape.isRect() &&
-    //                          localToDevice.type() <= Transform::Type::kRectStaysRect;
+    // An opaque, filled rectangle that isn't clipped by anything but the scissor overwrites the
+    // pixels it fully covers, so the DrawList can skip earlier draws within them when flushing.
+    // Rounding in excludes the partially covered pixels of anti-aliased or fractional edges.
+    if (pathAtlas == nullptr &&
+        styleType == SkStrokeRec::kFill_Style &&
+        !paint_depends_on_dst(shading) &&
+        !clip.shader() &&
+        clip.analyticClip().isEmpty() &&
+        clipOrder == DrawOrder::kNoIntersection &&
+        localToDevice.type() <= Transform::Type::kRectStaysRect) {
+        std::optional<Rect> localBounds;
+        if (geometry.isShape() && geometry.shape().isRect() && !geometry.shape().inverted()) {
+            localBounds = geometry.shape().rect();
+        } else if (geometry.isEdgeAAQuad() && geometry.edgeAAQuad().isRect()) {
+            localBounds = geometry.edgeAAQuad().bounds();
+        }
+        if (localBounds.has_value()) {
+            Rect occluderBounds = localToDevice.mapRect(*localBounds)
+                                               .makeIntersect(SkRect::Make(clip.scissor()))
+                                               .makeRoundIn();
+            fDC->recordOccluder(occluderBounds, order.depth());
+        }
+    }
 
     // Post-draw book keeping (bounds manager, depth tracking, etc.)
     fColorDepthBoundsManager->recordDraw(clip.drawBounds(), order.paintOrder());
@@ -1357,7 +1445,8 @@ std::pair<const Renderer*, PathAtlas*> Device::chooseRenderer(const Transform& l
     // II: otherwise:
     //    1. Always use compute AA if supported unless it was excluded by ContextOptions or the
     //       compute renderer cannot render the shape efficiently yet (based on the result of
-    //       `isSuitableForAtlasing`).
+    //       `isSuitableForAtlasing`, which accepts larger masks for paths with many verbs since
+    //       those are the most expensive to tessellate).
     //    2. Fall back to CPU raster AA if hardware MSAA is disabled or it was explicitly requested
     //       via ContextOptions.
     //    3. Otherwise use tessellation.
@@ -1385,7 +1474,7 @@ std::pair<const Renderer*, PathAtlas*> Device::chooseRenderer(const Transform& l
         // having to evaluate the entire clip stack before choosing the renderer as it will have to
         // get evaluated again if we fall back to a different renderer).
         drawBounds = localToDevice.mapRect(shape.bounds());
-        if (atlas->isSuitableForAtlasing(*drawBounds, fClip.conservativeBounds())) {
+        if (atlas->isSuitableForAtlasing(*drawBounds, fClip.conservativeBounds(), shape)) {
             pathAtlas = atlas;
         }
     }
@@ -115,6 +115,7 @@ inline void DrawAtlas::processEviction(PlotLocator plotLocator) {
     }
 
     fAtlasGeneration = fGenerationCounter->next();
+    ++fEvictedPlots;
 }
 
 inline void DrawAtlas::updatePlot(Plot* plot, AtlasLocator* atlasLocator) {
@@ -235,6 +236,19 @@ DrawAtlas::ErrorCode DrawAtlas::addRect(Recorder* recorder,
             }
         }
     } else {
+        // Before growing, reuse a plot that hasn't been drawn from in a long time. Otherwise a
+        // long running session activates every page for content that is no longer used and is
+        // left with only the per-page LRU plots to evict from.
+        AtlasToken nextFlushToken = recorder->priv().tokenTracker()->nextFlushToken();
+        if (Plot* plot = this->findAgedOutPlot(nextFlushToken)) {
+            this->processEvictionAndResetRects(plot);
+            SkDEBUGCODE(bool verify = )plot->addRect(width, height, atlasLocator);
+            SkASSERT(verify);
+            this->updatePlot(plot, atlasLocator);
+            ++fRecycledPlots;
+            return ErrorCode::kSucceeded;
+        }
+
         // If we haven't activated all the available pages, try to create a new one and add to it
         if (!this->activateNewPage(recorder)) {
             return ErrorCode::kError;
@@ -257,9 +271,23 @@ DrawAtlas::ErrorCode DrawAtlas::addRect(Recorder* recorder,
     // gives the Device a chance to snap the current set of uploads and draws, advance the draw
     // token, and call back into this function. The subsequent call will have plots available
     // for fresh uploads.
+    ++fTryAgainCount;
     return ErrorCode::kTryAgain;
 }
 
+Plot* DrawAtlas::findAgedOutPlot(AtlasToken nextFlushToken) {
+    // Only the LRU plot of each page needs to be checked, the rest were used more recently.
+    for (unsigned int pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
+        Plot* plot = fPages[pageIdx].fPlotList.tail();
+        SkASSERT(plot);
+        if (plot->flushesSinceLastUsed() > kPlotRecentlyUsedCount &&
+            plot->lastUseToken() < nextFlushToken) {
+            return plot;
+        }
+    }
+    return nullptr;
+}
+
 DrawAtlas::ErrorCode DrawAtlas::addToAtlas(Recorder* recorder,
                                            int width, int height, const void* image,
                                            AtlasLocator* atlasLocator) {
@@ -477,6 +505,7 @@ bool DrawAtlas::activateNewPage(Recorder* recorder) {
     }
 
     ++fNumActivePages;
+    ++fPagesActivated;
     return true;
 }
 
@@ -530,6 +559,29 @@ void DrawAtlas::evictAllPlots() {
     }
 }
 
+AtlasStats DrawAtlas::stats() const {
+    AtlasStats stats;
+    stats.fActivePages = fNumActivePages;
+    float occupiedPlots = 0.f;
+    for (uint32_t pageIndex = 0; pageIndex < fNumActivePages; ++pageIndex) {
+        for (uint32_t plotIndex = 0; plotIndex < fNumPlots; ++plotIndex) {
+            float percentFull = fPages[pageIndex].fPlotArray[plotIndex]->percentFull();
+            if (percentFull > 0.f) {
+                ++stats.fPlotsInUse;
+                occupiedPlots += percentFull;
+            }
+        }
+    }
+    if (fNumActivePages) {
+        stats.fOccupancy = occupiedPlots / (fNumActivePages * fNumPlots);
+    }
+    stats.fEvictedPlots = fEvictedPlots;
+    stats.fRecycledPlots = fRecycledPlots;
+    stats.fPagesActivated = fPagesActivated;
+    stats.fTryAgainCount = fTryAgainCount;
+    return stats;
+}
+
 DrawAtlasConfig::DrawAtlasConfig(int maxTextureSize, size_t maxBytes) {
     static const SkISize kARGBDimensions[] = {
         {256, 256},   // maxBytes < 2^19
@@ -169,6 +169,9 @@ public:
         return fMaxPages;
     }
 
+    // Walks the active pages, so this is meant for diagnostics rather than every draw.
+    AtlasStats stats() const;
+
     int numAllocated_TestingOnly() const;
     void setMaxPages_TestingOnly(uint32_t maxPages);
 
@@ -181,6 +184,7 @@ private:
               std::string_view label);
 
     bool addRectToPage(unsigned int pageIdx, int width, int height, AtlasLocator*);
+    Plot* findAgedOutPlot(AtlasToken nextFlushToken);
 
     void updatePlot(Plot* plot, AtlasLocator*);
 
@@ -260,6 +264,12 @@ private:
 
     uint32_t fNumActivePages;
 
+    // Cumulative counters reported by stats()
+    uint64_t fEvictedPlots = 0;
+    uint64_t fRecycledPlots = 0;
+    uint64_t fPagesActivated = 0;
+    uint64_t fTryAgainCount = 0;
+
     SkDEBUGCODE(void validate(const AtlasLocator& atlasLocator) const;)
 };
 
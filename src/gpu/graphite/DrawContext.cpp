@@ -23,6 +23,7 @@
 #include "src/gpu/graphite/DrawList.h"
 #include "src/gpu/graphite/DrawPass.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PipelineCapture.h"
 #include "src/gpu/graphite/RasterPathAtlas.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/RenderPassDesc.h"
@@ -280,6 +281,16 @@ void DrawContext::flush(Recorder* recorder) {
         auto writeSwizzle = caps->getWriteSwizzle(this->colorInfo().colorType(),
                                                   fTarget->textureInfo());
 
+        if (PipelineCapture* capture = recorder->priv().pipelineCapture()) {
+            capture->add(recorder->priv().shaderCodeDictionary(),
+                         recorder->priv().rendererProvider(),
+                         pass->pipelineDescs(),
+                         this->colorInfo().colorType(),
+                         fTarget->textureInfo(),
+                         pass->depthStencilFlags(),
+                         pass->requiresMSAA());
+        }
+
         RenderPassDesc desc = RenderPassDesc::Make(caps, fTarget->textureInfo(), loadOp, storeOp,
                                                    pass->depthStencilFlags(),
                                                    pass->clearColor(),
@@ -74,6 +74,10 @@ public:
                     DrawOrder ordering,
                     const PaintParams* paint,
                     const StrokeStyle* stroke);
+    // See DrawList::recordOccluder().
+    void recordOccluder(const Rect& bounds, PaintersDepth depth) {
+        fPendingDraws->recordOccluder(bounds, depth);
+    }
 
     bool recordUpload(Recorder* recorder,
                       sk_sp<TextureProxy> targetProxy,
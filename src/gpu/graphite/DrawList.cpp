@@ -11,6 +11,8 @@
 #include "src/gpu/graphite/Renderer.h"
 #include "src/gpu/graphite/geom/Shape.h"
 
+#include <algorithm>
+
 namespace skgpu::graphite {
 
 const Transform& DrawList::deduplicateTransform(const Transform& localToDevice) {
@@ -51,4 +53,42 @@ void DrawList::recordDraw(const Renderer* renderer,
     }
 }
 
+void DrawList::recordOccluder(const Rect& bounds, PaintersDepth depth) {
+    if (bounds.isEmptyNegativeOrNaN()) {
+        return;
+    }
+    // A later occluder hides everything that an earlier occluder inside of it does.
+    for (Occluder& occluder : fOccluders) {
+        if (bounds.contains(occluder.fBounds)) {
+            occluder = {bounds, depth};
+            return;
+        }
+    }
+    if (fOccluders.size() < kMaxOccluders) {
+        fOccluders.push_back({bounds, depth});
+        return;
+    }
+    Occluder* smallest = std::min_element(fOccluders.begin(), fOccluders.end(),
+                                          [](const Occluder& a, const Occluder& b) {
+                                              return a.fBounds.area() < b.fBounds.area();
+                                          });
+    if (smallest->fBounds.area() < bounds.area()) {
+        *smallest = {bounds, depth};
+    }
+}
+
+bool DrawList::isOccluded(const Draw& draw) const {
+    if (!draw.fPaintParams.has_value()) {
+        return false;
+    }
+    const Rect& drawBounds = draw.fDrawParams.clip().drawBounds();
+    const PaintersDepth depth = draw.fDrawParams.order().depth();
+    for (const Occluder& occluder : fOccluders) {
+        if (occluder.fDepth > depth && occluder.fBounds.contains(drawBounds)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace skgpu::graphite
@@ -9,6 +9,7 @@
 #define skgpu_graphite_DrawList_DEFINED
 
 #include "include/core/SkPaint.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkTBlockList.h"
 
 #include "src/gpu/graphite/DrawOrder.h"
@@ -81,6 +82,12 @@ public:
                     const PaintParams* paint,
                     const StrokeStyle* stroke);
 
+    // Records that every pixel in the device-space 'bounds' is overwritten with opaque color by a
+    // draw with the given depth, so that earlier draws with color that lie entirely within the
+    // bounds can be skipped when the list is converted to a DrawPass. Depth-only draws are never
+    // skipped since their depth values can still affect draws after the occluder.
+    void recordOccluder(const Rect& bounds, PaintersDepth depth);
+
     int renderStepCount() const { return fRenderStepCount; }
 
     // Bounds for a dst copy required by this DrawList.
@@ -107,6 +114,17 @@ private:
     // The returned Transform reference remains valid for the lifetime of the DrawList.
     const Transform& deduplicateTransform(const Transform&);
 
+    // Returns true if the draw's color is hidden by a later occluder.
+    bool isOccluded(const Draw&) const;
+
+    // Only a few of the largest occluders are kept, since every draw is tested against each one.
+    struct Occluder {
+        Rect          fBounds;
+        PaintersDepth fDepth;
+    };
+    static constexpr int kMaxOccluders = 4;
+    skia_private::STArray<kMaxOccluders, Occluder> fOccluders;
+
     SkTBlockList<Transform, 16> fTransforms{SkBlockAllocator::GrowthPolicy::kFibonacci};
     SkTBlockList<Draw, 16>      fDraws{SkBlockAllocator::GrowthPolicy::kFibonacci};
 
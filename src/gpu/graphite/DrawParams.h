@@ -61,17 +61,36 @@ private:
 
 // TBD: Separate DashParams extracted from an SkDashPathEffect? Or folded into StrokeStyle?
 
+// A device-space rect with circular corners of a single radius (zero for a plain rect) whose
+// coverage is evaluated in the fragment shader, instead of drawing the clip element to the depth
+// buffer. If inverted, the area outside of the rrect is kept (a difference clip).
+struct AnalyticClip {
+    Rect  fBounds = Rect::InfiniteInverted();
+    float fRadius = 0.f;
+    bool  fInverted = false;
+
+    bool isEmpty() const { return fBounds.isEmptyNegativeOrNaN(); }
+
+    bool operator==(const AnalyticClip& o) const {
+        return (this->isEmpty() && o.isEmpty()) ||
+               (fBounds == o.fBounds && fRadius == o.fRadius && fInverted == o.fInverted);
+    }
+    bool operator!=(const AnalyticClip& o) const { return !(*this == o); }
+};
+
 class Clip {
 public:
     Clip() = default;
     Clip(const Rect& drawBounds,
          const Rect& shapeBounds,
          const SkIRect& scissor,
-         const SkShader* shader)
+         const SkShader* shader,
+         const AnalyticClip& analyticClip = {})
             : fDrawBounds(drawBounds)
             , fTransformedShapeBounds(shapeBounds)
             , fScissor(scissor)
-            , fShader(shader) {}
+            , fShader(shader)
+            , fAnalyticClip(analyticClip) {}
 
     // Tight bounds of the draw, including any padding/outset for stroking and expansion due to
     // inverse fill and intersected with the scissor.
@@ -90,6 +109,9 @@ public:
     // If set, the clip shader's output alpha is further used to clip the draw.
     const SkShader* shader() const { return fShader; }
 
+    // If not empty, the draw's coverage is further multiplied by this clip's analytic coverage.
+    const AnalyticClip& analyticClip() const { return fAnalyticClip; }
+
     bool isClippedOut() const { return fDrawBounds.isEmptyNegativeOrNaN(); }
 
 private:
@@ -99,9 +121,7 @@ private:
     Rect            fTransformedShapeBounds;
     SkIRect         fScissor;
     const SkShader* fShader;
-
-    // TODO: If we add more complex analytic shapes for clipping, e.g. coverage rrect, it should
-    // go here.
+    AnalyticClip    fAnalyticClip;
 };
 
 // Encapsulates all geometric state for a single high-level draw call. RenderSteps are responsible
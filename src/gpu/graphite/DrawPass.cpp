@@ -342,6 +342,22 @@ private:
     bool fHasData = false;
 };
 
+// Returns true if ExtractPaintData() would produce the same paint ID and data for a draw as it did
+// for the previous draw, by comparing what ExtractPaintData() passes on to the KeyContext.
+bool same_paint_data(const PaintParams& prevPaint, const DrawParams& prevParams,
+                     const PaintParams& paint, const DrawParams& params) {
+    if (!paint.hasSameShading(prevPaint)) {
+        return false;
+    }
+    auto optimizesSampling = [](const Geometry& geometry) {
+        return geometry.isShape() || geometry.isEdgeAAQuad();
+    };
+    if (optimizesSampling(prevParams.geometry()) != optimizesSampling(params.geometry())) {
+        return false;
+    }
+    return !paint.usesLocalToDevice() || prevParams.transform() == params.transform();
+}
+
 } // namespace
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -527,7 +543,21 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     std::vector<SortKey> keys;
     keys.reserve(draws->renderStepCount());
 
+    // Consecutive draws often use the same paint (e.g. the solid rects and text of a simple UI), so
+    // the last paint's ID and data are reused for a draw whose paint produces the same key and
+    // uniforms, skipping key building and the dictionary and data cache lookups.
+    const DrawList::Draw* lastPaintDraw = nullptr;
+    UniquePaintParamsID lastShaderID;
+    const UniformDataBlock* lastShadingUniforms = nullptr;
+    const TextureDataBlock* lastPaintTextures = nullptr;
+
+    int occludedDrawCount = 0;
     for (const DrawList::Draw& draw : draws->fDraws.items()) {
+        if (draws->isOccluded(draw)) {
+            ++occludedDrawCount;
+            continue;
+        }
+
         // If we have two different descriptors, such that the uniforms from the PaintParams can be
         // bound independently of those used by the rest of the RenderStep, then we can upload now
         // and remember the location for re-use on any RenderStep that does shading.
@@ -540,17 +570,30 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
                     draw.fPaintParams->dstReadRequirement() == DstReadRequirement::kTextureCopy
                             ? dstCopy
                             : nullptr;
-            std::tie(shaderID, shadingUniforms, paintTextures) =
-                    ExtractPaintData(recorder,
-                                     &gatherer,
-                                     &builder,
-                                     uniformLayout,
-                                     draw.fDrawParams.transform(),
-                                     draw.fPaintParams.value(),
-                                     draw.fDrawParams.geometry(),
-                                     curDst,
-                                     dstCopyOffset,
-                                     targetInfo.colorInfo());
+            if (lastPaintDraw && same_paint_data(lastPaintDraw->fPaintParams.value(),
+                                                 lastPaintDraw->fDrawParams,
+                                                 draw.fPaintParams.value(),
+                                                 draw.fDrawParams)) {
+                shaderID = lastShaderID;
+                shadingUniforms = lastShadingUniforms;
+                paintTextures = lastPaintTextures;
+            } else {
+                std::tie(shaderID, shadingUniforms, paintTextures) =
+                        ExtractPaintData(recorder,
+                                         &gatherer,
+                                         &builder,
+                                         uniformLayout,
+                                         draw.fDrawParams.transform(),
+                                         draw.fPaintParams.value(),
+                                         draw.fDrawParams.geometry(),
+                                         curDst,
+                                         dstCopyOffset,
+                                         targetInfo.colorInfo());
+                lastPaintDraw = &draw;
+                lastShaderID = shaderID;
+                lastShadingUniforms = shadingUniforms;
+                lastPaintTextures = paintTextures;
+            }
         } // else depth-only
 
         for (int stepIndex = 0; stepIndex < draw.fRenderer->numRenderSteps(); ++stepIndex) {
@@ -590,14 +633,16 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
         return nullptr;
     }
 
-    // TODO: Explore sorting algorithms; in all likelihood this will be mostly sorted already, so
-    // algorithms that approach O(n) in that condition may be favorable. Alternatively, could
-    // explore radix sort that is always O(n). Brief testing suggested std::sort was faster than
-    // std::stable_sort and SkTQSort on my [ml]'s Windows desktop. Also worth considering in-place
-    // vs. algorithms that require an extra O(n) storage.
+    // Brief testing suggested std::sort was faster than std::stable_sort and SkTQSort on my [ml]'s
+    // Windows desktop. An LSD radix sort over the bytes of the keys that differ was also 2-3x
+    // slower than std::sort from 1k to 64k keys, since the uniform and texture indices leave few
+    // bytes to skip and each pass moves the whole 24 byte key. Draws that each get a new painter's
+    // order often produce keys that are already sorted, which is cheap to check for.
     // TODO: It's not strictly necessary, but would a stable sort be useful or just end up hiding
     // bugs in the DrawOrder determination code?
-    std::sort(keys.begin(), keys.end());
+    if (!std::is_sorted(keys.begin(), keys.end())) {
+        std::sort(keys.begin(), keys.end());
+    }
 
     // Used to record vertex/instance data, buffer binds, and draw calls
     DrawWriter drawWriter(&drawPass->fCommandList, bufferMgr);
@@ -673,6 +718,12 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
                         ? 0
                         : key.shadingUniformIndex();
         skvx::ushort2 ssboIndices = {SkToU16(geometrySsboIndex), SkToU16(shadingSsboIndex)};
+        // NOTE: Instanced RenderSteps append to the same DrawWriter template for every draw that
+        // doesn't change state, so a run of compatible keys becomes a single drawInstanced()
+        // regardless of how many primitives it holds. Issuing those runs as indirect draws would
+        // not remove any CPU work here, which is dominated by extracting paint data, sorting keys,
+        // and writing each instance. DrawIndirect and DrawIndexedIndirect are only worthwhile for
+        // instance data and counts produced on the GPU, e.g. by a compute culling pass.
         renderStep.writeVertices(&drawWriter, draw.fDrawParams, ssboIndices);
 
         if (bufferMgr->hasMappingFailed()) {
@@ -692,6 +743,7 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     TRACE_COUNTER1("skia.gpu", "# pipelines", drawPass->fPipelineDescs.size());
     TRACE_COUNTER1("skia.gpu", "# textures", drawPass->fSampledTextures.size());
     TRACE_COUNTER1("skia.gpu", "# commands", drawPass->fCommandList.count());
+    TRACE_COUNTER1("skia.gpu", "# occluded draws", occludedDrawCount);
 
     return drawPass;
 }
@@ -701,6 +753,8 @@ bool DrawPass::prepareResources(ResourceProvider* resourceProvider,
                                 const RenderPassDesc& renderPassDesc) {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
 
+    // Recorder::snap() has already compiled the missing pipelines of every DrawPass in the
+    // Recording in parallel, if the Context has an executor for it, so this mostly looks them up.
     fFullPipelines.reserve(fFullPipelines.size() + fPipelineDescs.size());
     for (const GraphicsPipelineDesc& pipelineDesc : fPipelineDescs) {
         auto pipeline = resourceProvider->findOrCreateGraphicsPipeline(runtimeDict,
@@ -79,6 +79,9 @@ public:
 
     SkEnumBitMask<DepthStencilFlags> depthStencilFlags() const { return fDepthStencilFlags; }
 
+    // The pipelines the DrawPass requires. Empty once prepareResources() has been called.
+    SkSpan<const GraphicsPipelineDesc> pipelineDescs() const { return fPipelineDescs; }
+
     size_t vertexBufferSize()  const { return 0; }
     size_t uniformBufferSize() const { return 0; }
 
@@ -7,6 +7,7 @@
 
 #include "src/gpu/graphite/GlobalCache.h"
 
+#include "src/core/SkTraceEvent.h"
 #include "src/gpu/graphite/ComputePipeline.h"
 #include "src/gpu/graphite/ContextUtils.h"
 #include "src/gpu/graphite/GraphicsPipeline.h"
@@ -16,7 +17,9 @@ namespace skgpu::graphite {
 
 GlobalCache::GlobalCache()
         : fGraphicsPipelineCache(256)  // TODO: find a good value for these limits
-        , fComputePipelineCache(256) {}
+        , fComputePipelineCache(256)
+        // Small path masks are at most 162x162, so this holds at most ~6.5MB of masks.
+        , fPathMaskCache(256) {}
 
 GlobalCache::~GlobalCache() {
     // These should have been cleared out earlier by deleteResources().
@@ -24,6 +27,7 @@ GlobalCache::~GlobalCache() {
     SkASSERT(fGraphicsPipelineCache.count() == 0);
     SkASSERT(fComputePipelineCache.count() == 0);
     SkASSERT(fStaticResource.size() == 0);
+    SkASSERT(fPathMaskCache.count() == 0);
 }
 
 void GlobalCache::deleteResources() {
@@ -32,12 +36,14 @@ void GlobalCache::deleteResources() {
     fGraphicsPipelineCache.reset();
     fComputePipelineCache.reset();
     fStaticResource.clear();
+    fPathMaskCache.reset();
 }
 
 sk_sp<GraphicsPipeline> GlobalCache::findGraphicsPipeline(const UniqueKey& key) {
     SkAutoSpinlock lock{fSpinLock};
 
     sk_sp<GraphicsPipeline>* entry = fGraphicsPipelineCache.find(key);
+    TRACE_CACHE_LOOKUP("skia.gpu.cache", "GraphicsPipeline cache lookups", entry != nullptr);
     return entry ? *entry : nullptr;
 }
 
@@ -99,4 +105,19 @@ void GlobalCache::addStaticResource(sk_sp<Resource> resource) {
     fStaticResource.push_back(std::move(resource));
 }
 
+sk_sp<SkData> GlobalCache::findPathMask(const UniqueKey& key) {
+    SkAutoSpinlock lock{fSpinLock};
+    sk_sp<SkData>* entry = fPathMaskCache.find(key);
+    return entry ? *entry : nullptr;
+}
+
+sk_sp<SkData> GlobalCache::addPathMask(const UniqueKey& key, sk_sp<SkData> mask) {
+    SkAutoSpinlock lock{fSpinLock};
+    sk_sp<SkData>* entry = fPathMaskCache.find(key);
+    if (!entry) {
+        entry = fPathMaskCache.insert(key, std::move(mask));
+    }
+    return *entry;
+}
+
 } // namespace skgpu::graphite
@@ -8,6 +8,7 @@
 #ifndef skgpu_graphite_GlobalCache_DEFINED
 #define skgpu_graphite_GlobalCache_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkSpinlock.h"
@@ -69,6 +70,13 @@ public:
     // or reference tracking.
     void addStaticResource(sk_sp<Resource>) SK_EXCLUDES(fSpinLock);
 
+    // Find and add operations for the coverage masks of small shapes that a RasterPathAtlas has
+    // rasterized, with the same pattern as GraphicsPipelines. Each Recorder still uploads the mask
+    // into its own atlas, but Recorders drawing the same shapes in parallel only rasterize them
+    // once. The data holds the mask's A8 rows with no padding; its key records the mask size.
+    sk_sp<SkData> findPathMask(const UniqueKey&) SK_EXCLUDES(fSpinLock);
+    sk_sp<SkData> addPathMask(const UniqueKey&, sk_sp<SkData>) SK_EXCLUDES(fSpinLock);
+
 private:
     struct KeyHash {
         uint32_t operator()(const UniqueKey& key) const { return key.hash(); }
@@ -76,6 +84,7 @@ private:
 
     using GraphicsPipelineCache = SkLRUCache<UniqueKey, sk_sp<GraphicsPipeline>, KeyHash>;
     using ComputePipelineCache  = SkLRUCache<UniqueKey, sk_sp<ComputePipeline>,  KeyHash>;
+    using PathMaskCache         = SkLRUCache<UniqueKey, sk_sp<SkData>,           KeyHash>;
 
     // TODO: can we do something better given this should have write-seldom/read-often behavior?
     mutable SkSpinlock fSpinLock;
@@ -87,6 +96,8 @@ private:
     ComputePipelineCache  fComputePipelineCache  SK_GUARDED_BY(fSpinLock);
 
     skia_private::TArray<sk_sp<Resource>> fStaticResource SK_GUARDED_BY(fSpinLock);
+
+    PathMaskCache fPathMaskCache SK_GUARDED_BY(fSpinLock);
 };
 
 }  // namespace skgpu::graphite
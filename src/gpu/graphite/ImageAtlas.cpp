@@ -0,0 +1,126 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/ImageAtlas.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "src/core/SkAutoPixmapStorage.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/TextureProxy.h"
+#include "src/gpu/graphite/TextureProxyView.h"
+#include "src/image/SkImage_Base.h"
+
+namespace skgpu::graphite {
+
+namespace {
+// Each page holds 16 Plots of 256x256, so at least 16 of the largest images.
+constexpr int kAtlasSize = 1024;
+constexpr int kPlotSize = 256;
+// Plots are filled and uploaded as RGBA; copySubImage() swizzles N32 data to match.
+constexpr SkColorType kAtlasColorType = kRGBA_8888_SkColorType;
+
+int plot_index(const PlotLocator& locator, const DrawAtlas* drawAtlas) {
+    return locator.pageIndex() * drawAtlas->numPlots() + locator.plotIndex();
+}
+}  // namespace
+
+ImageAtlas::ImageAtlas(Recorder* recorder) : fRecorder(recorder) {
+    const Caps* caps = recorder->priv().caps();
+    fDrawAtlas = DrawAtlas::Make(kAtlasColorType,
+                                 SkColorTypeBytesPerPixel(kAtlasColorType),
+                                 kAtlasSize, kAtlasSize,
+                                 kPlotSize, kPlotSize,
+                                 /*generationCounter=*/this,
+                                 caps->allowMultipleAtlasTextures() ?
+                                         DrawAtlas::AllowMultitexturing::kYes :
+                                         DrawAtlas::AllowMultitexturing::kNo,
+                                 DrawAtlas::UseStorageTextures::kNo,
+                                 /*evictor=*/this,
+                                 /*label=*/"ImageAtlas");
+    SkASSERT(fDrawAtlas);
+    fPlotImageIDs.resize(fDrawAtlas->numPlots() * fDrawAtlas->maxPages());
+}
+
+ImageAtlas::~ImageAtlas() = default;
+
+bool ImageAtlas::IsSuitable(const SkImage* image) {
+    if (image->width() > kMaxImageSize || image->height() > kMaxImageSize) {
+        return false;
+    }
+    // Alpha-only images are drawn with the paint's color or shader, which the RGBA copy would lose.
+    if (SkColorTypeIsAlphaOnly(image->colorType())) {
+        return false;
+    }
+    // Pictures are drawn by the GPU, and copying them to the atlas would rasterize them instead.
+    SkImage_Base::Type type = as_IB(image)->type();
+    return as_IB(image)->isRasterBacked() || type == SkImage_Base::Type::kLazy;
+}
+
+sk_sp<Image> ImageAtlas::findOrAddImage(const SkImage* image, SkIPoint* outPos) {
+    SkASSERT(IsSuitable(image));
+    AtlasToken nextFlushToken = fRecorder->priv().tokenTracker()->nextFlushToken();
+
+    if (const AtlasLocator* locator = fImageLocators.find(image->uniqueID())) {
+        fDrawAtlas->setLastUseToken(*locator, nextFlushToken);
+        *outPos = locator->topLeft();
+        return this->makeAtlasImage(*locator, image);
+    }
+
+    // Read the image in N32 so that copySubImage() stores it in the atlas as RGBA, keeping its
+    // color space. The atlas holds premultiplied colors, like the textures of other images.
+    SkAutoPixmapStorage pixels;
+    pixels.alloc(SkImageInfo::Make(image->dimensions(), kN32_SkColorType, kPremul_SkAlphaType,
+                                   image->refColorSpace()));
+    if (!image->readPixels(/*context=*/nullptr, pixels, 0, 0, SkImage::kDisallow_CachingHint)) {
+        return nullptr;
+    }
+
+    AtlasLocator locator;
+    if (fDrawAtlas->addToAtlas(fRecorder, image->width(), image->height(), pixels.addr(),
+                               &locator) != DrawAtlas::ErrorCode::kSucceeded) {
+        return nullptr;
+    }
+    fImageLocators.set(image->uniqueID(), locator);
+    fPlotImageIDs[plot_index(locator.plotLocator(), fDrawAtlas.get())].push_back(
+            image->uniqueID());
+
+    fDrawAtlas->setLastUseToken(locator, nextFlushToken);
+    *outPos = locator.topLeft();
+    return this->makeAtlasImage(locator, image);
+}
+
+sk_sp<Image> ImageAtlas::makeAtlasImage(const AtlasLocator& locator, const SkImage* image) {
+    const sk_sp<TextureProxy>& proxy = fDrawAtlas->getProxies()[locator.pageIndex()];
+    skgpu::Swizzle swizzle =
+            fRecorder->priv().caps()->getReadSwizzle(kAtlasColorType, proxy->textureInfo());
+    SkAlphaType alphaType = image->isOpaque() ? kOpaque_SkAlphaType : kPremul_SkAlphaType;
+    return sk_make_sp<Image>(TextureProxyView(proxy, swizzle),
+                             SkColorInfo(kAtlasColorType, alphaType, image->refColorSpace()));
+}
+
+bool ImageAtlas::recordUploads(DrawContext* dc) {
+    return fDrawAtlas->recordUploads(dc, fRecorder);
+}
+
+void ImageAtlas::evict(PlotLocator plotLocator) {
+    skia_private::TArray<uint32_t>& ids = fPlotImageIDs[plot_index(plotLocator, fDrawAtlas.get())];
+    for (uint32_t id : ids) {
+        fImageLocators.remove(id);
+    }
+    ids.clear();
+}
+
+void ImageAtlas::postFlush() {
+    fDrawAtlas->compact(fRecorder->priv().tokenTracker()->nextFlushToken());
+}
+
+}  // namespace skgpu::graphite
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_ImageAtlas_DEFINED
+#define skgpu_graphite_ImageAtlas_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkTHash.h"
+#include "src/gpu/AtlasTypes.h"
+#include "src/gpu/graphite/DrawAtlas.h"
+
+#include <memory>
+
+class SkImage;
+struct SkIPoint;
+
+namespace skgpu::graphite {
+
+class DrawContext;
+class Image;
+class Recorder;
+
+/**
+ * ImageAtlas packs small raster images into shared RGBA textures, so that draws of many different
+ * images (like the icons of a UI) read from the same few textures instead of one texture each.
+ * This saves a texture allocation per image and lets those draws sort together without texture
+ * bind changes.
+ *
+ * Images are copied into the atlas the first time they are drawn and found by their unique ID
+ * afterwards. When the atlas is full, the least recently used Plot that is not read by any pending
+ * draw is evicted, and the images in it will be copied in again if they are drawn later.
+ */
+class ImageAtlas : public AtlasGenerationCounter, public PlotEvictionCallback {
+public:
+    // Images can be atlased if neither dimension is larger than this.
+    static constexpr int kMaxImageSize = 64;
+
+    explicit ImageAtlas(Recorder*);
+    ~ImageAtlas() override;
+
+    // Returns whether 'image' is a kind of image that can be put in the atlas.
+    static bool IsSuitable(const SkImage* image);
+
+    // Returns an Image of the atlas texture holding a copy of 'image', with the same color space
+    // and alpha type as 'image', and writes the image's top-left corner within it to 'outPos'.
+    // Returns nullptr if the image could not be added to the atlas, in which case it should be
+    // drawn from its own texture. The atlas texture and position are only valid for draws recorded
+    // before the next flush.
+    sk_sp<Image> findOrAddImage(const SkImage* image, SkIPoint* outPos);
+
+    bool recordUploads(DrawContext*);
+    void evict(PlotLocator) override;
+    void postFlush();
+
+private:
+    sk_sp<Image> makeAtlasImage(const AtlasLocator&, const SkImage*);
+
+    Recorder* fRecorder;
+    std::unique_ptr<DrawAtlas> fDrawAtlas;
+
+    // Where each image is in the atlas, keyed by the image's unique ID.
+    skia_private::THashMap<uint32_t, AtlasLocator> fImageLocators;
+    // The IDs of the images in each Plot, indexed by page and Plot, so that evict() can remove them
+    // from fImageLocators.
+    skia_private::TArray<skia_private::TArray<uint32_t>> fPlotImageIDs;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_ImageAtlas_DEFINED
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/gpu/graphite/IncrementalImageDecoder.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "src/codec/SkIncrementalDecoder.h"
+#include "src/gpu/SkBackingFit.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/TextureProxyView.h"
+#include "src/gpu/graphite/TextureUtils.h"
+#include "src/gpu/graphite/task/UploadTask.h"
+
+#include <utility>
+
+namespace skgpu::graphite {
+
+namespace {
+
+class IncrementalImageDecoderImpl final : public IncrementalImageDecoder {
+public:
+    IncrementalImageDecoderImpl(Recorder* recorder, std::unique_ptr<SkIncrementalDecoder> decoder)
+            : fRecorder(recorder), fDecoder(std::move(decoder)) {}
+
+    SkCodec::Result decode() override {
+        SkIRect changed;
+        const SkCodec::Result result = fDecoder->decode(&changed);
+        switch (result) {
+            case SkCodec::kSuccess:
+            case SkCodec::kIncompleteInput:
+            case SkCodec::kErrorInInput:
+                break;
+            default:
+                return result;
+        }
+        return this->upload(changed) ? result : SkCodec::kInternalError;
+    }
+
+    sk_sp<SkImage> makeImage() const override {
+        if (!fView) {
+            return nullptr;
+        }
+        if (!fImage) {
+            fImage = sk_make_sp<Image>(fView, fColorInfo);
+        }
+        return fImage;
+    }
+
+    int rowsDecoded() const override { return fDecoder->rowsDecoded(); }
+
+private:
+    bool upload(const SkIRect& changed) {
+        const SkBitmap& bitmap = fDecoder->bitmap();
+        if (!fView) {
+            // The rows that haven't been decoded yet are zero in the bitmap, so the first upload
+            // is of all of it rather than leaving the rest of the texture uninitialized.
+            auto [view, ct] = MakeBitmapProxyView(fRecorder,
+                                                  bitmap,
+                                                  /*mipmapsIn=*/nullptr,
+                                                  Mipmapped::kNo,
+                                                  Budgeted::kYes,
+                                                  "IncrementalImageDecoderTexture");
+            if (!view) {
+                return false;
+            }
+            fView = std::move(view);
+            fColorInfo = bitmap.info().colorInfo().makeColorType(ct);
+            return true;
+        }
+        if (changed.isEmpty()) {
+            return true;
+        }
+
+        if (fImage) {
+            if (!fImage->unique()) {
+                // The image is still in use, so it keeps this texture and we continue in a copy.
+                sk_sp<Image> copy = Image::Copy(fRecorder,
+                                                fView,
+                                                fColorInfo,
+                                                SkIRect::MakeSize(fView.dimensions()),
+                                                Budgeted::kYes,
+                                                Mipmapped::kNo,
+                                                SkBackingFit::kExact,
+                                                "IncrementalImageDecoderCopy");
+                if (!copy) {
+                    return false;
+                }
+                fView = copy->textureProxyView();
+            }
+            fImage.reset();
+        }
+
+        // The upload copies the rows into a transfer buffer right away.
+        MipLevel level;
+        level.fPixels = bitmap.getAddr(0, changed.top());
+        level.fRowBytes = bitmap.rowBytes();
+        UploadInstance upload = UploadInstance::Make(fRecorder,
+                                                     fView.refProxy(),
+                                                     bitmap.info().colorInfo(),
+                                                     fColorInfo,
+                                                     {&level, 1},
+                                                     changed,
+                                                     std::make_unique<ImageUploadContext>());
+        if (!upload.isValid()) {
+            SKGPU_LOG_E("IncrementalImageDecoder: Could not create UploadInstance");
+            return false;
+        }
+        // Draws that sampled the texture before this change must be recorded ahead of it.
+        fRecorder->priv().flushTrackedDevices();
+        fRecorder->priv().add(UploadTask::Make(std::move(upload)));
+        return true;
+    }
+
+    Recorder*                             fRecorder;
+    std::unique_ptr<SkIncrementalDecoder> fDecoder;
+    TextureProxyView                      fView;
+    SkColorInfo                           fColorInfo;
+    mutable sk_sp<Image>                  fImage;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<IncrementalImageDecoder> IncrementalImageDecoder::Make(
+        Recorder* recorder,
+        std::unique_ptr<SkCodec> codec,
+        const SkImageInfo& info,
+        const SkCodec::Options* options,
+        SkCodec::Result* result) {
+    SkCodec::Result resultStorage;
+    if (!result) {
+        result = &resultStorage;
+    }
+    if (!recorder) {
+        *result = SkCodec::kInvalidParameters;
+        return nullptr;
+    }
+    auto decoder = SkIncrementalDecoder::Make(std::move(codec), info, options, result);
+    if (!decoder) {
+        return nullptr;
+    }
+    return std::make_unique<IncrementalImageDecoderImpl>(recorder, std::move(decoder));
+}
+
+}  // namespace skgpu::graphite
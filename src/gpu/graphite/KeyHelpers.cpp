@@ -37,6 +37,7 @@
 #include "src/gpu/Swizzle.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/DrawContext.h"
+#include "src/gpu/graphite/DrawParams.h"
 #include "src/gpu/graphite/Image_Base_Graphite.h"
 #include "src/gpu/graphite/Image_Graphite.h"
 #include "src/gpu/graphite/Image_YUVA_Graphite.h"
@@ -942,6 +943,31 @@ void ClipShaderBlock::BeginBlock(const KeyContext& keyContext,
 
 //--------------------------------------------------------------------------------------------------
 
+namespace {
+
+void add_analytic_clip_uniform_data(const ShaderCodeDictionary* dict,
+                                    const AnalyticClip& clip,
+                                    PipelineDataGatherer* gatherer) {
+    VALIDATE_UNIFORMS(gatherer, dict, BuiltInCodeSnippetID::kAnalyticClip)
+    gatherer->write(clip.fBounds.asSkRect());
+    gatherer->write(clip.fRadius);
+    gatherer->write(clip.fInverted ? 1.f : 0.f);
+}
+
+} // anonymous namespace
+
+void AnalyticClipBlock::AddBlock(const KeyContext& keyContext,
+                                 PaintParamsKeyBuilder* builder,
+                                 PipelineDataGatherer* gatherer,
+                                 const AnalyticClip& clip) {
+    SkASSERT(!clip.isEmpty());
+    add_analytic_clip_uniform_data(keyContext.dict(), clip, gatherer);
+
+    builder->addBlock(BuiltInCodeSnippetID::kAnalyticClip);
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void ComposeBlock::BeginBlock(const KeyContext& keyContext,
                               PaintParamsKeyBuilder* builder,
                               PipelineDataGatherer* gatherer) {
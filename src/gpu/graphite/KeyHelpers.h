@@ -32,6 +32,7 @@ namespace skgpu::graphite {
 
 class DrawContext;
 class KeyContext;
+struct AnalyticClip;
 class PaintParamsKeyBuilder;
 class PipelineDataGatherer;
 class UniquePaintParamsID;
@@ -308,6 +309,15 @@ struct ClipShaderBlock {
                            PipelineDataGatherer*);
 };
 
+// Evaluates the coverage of a device-space rect or circular rrect at the fragment's position. This
+// is meant to be the child of a ClipShaderBlock.
+struct AnalyticClipBlock {
+    static void AddBlock(const KeyContext&,
+                         PaintParamsKeyBuilder*,
+                         PipelineDataGatherer*,
+                         const AnalyticClip&);
+};
+
 struct ComposeBlock {
     static void BeginBlock(const KeyContext&,
                            PaintParamsKeyBuilder*,
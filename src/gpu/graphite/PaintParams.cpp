@@ -54,13 +54,15 @@ PaintParams::PaintParams(const SkPaint& paint,
                          sk_sp<SkBlender> primitiveBlender,
                          sk_sp<SkShader> clipShader,
                          DstReadRequirement dstReadReq,
-                         bool skipColorXform)
+                         bool skipColorXform,
+                         const AnalyticClip& analyticClip)
         : fColor(paint.getColor4f())
         , fFinalBlender(paint.refBlender())
         , fShader(paint.refShader())
         , fColorFilter(paint.refColorFilter())
         , fPrimitiveBlender(std::move(primitiveBlender))
         , fClipShader(std::move(clipShader))
+        , fAnalyticClip(analyticClip)
         , fDstReadReq(dstReadReq)
         , fSkipColorXform(skipColorXform)
         , fDither(paint.isDither()) {}
@@ -308,6 +310,19 @@ void PaintParams::handleDstRead(const KeyContext& keyContext,
     }
 }
 
+bool PaintParams::hasSameShading(const PaintParams& other) const {
+    return fColor == other.fColor &&
+           fFinalBlender == other.fFinalBlender &&
+           fShader == other.fShader &&
+           fColorFilter == other.fColorFilter &&
+           fPrimitiveBlender == other.fPrimitiveBlender &&
+           fClipShader == other.fClipShader &&
+           fAnalyticClip == other.fAnalyticClip &&
+           fDstReadReq == other.fDstReadReq &&
+           fSkipColorXform == other.fSkipColorXform &&
+           fDither == other.fDither;
+}
+
 void PaintParams::toKey(const KeyContext& keyContext,
                         PaintParamsKeyBuilder* builder,
                         PipelineDataGatherer* gatherer) const {
@@ -324,6 +339,12 @@ void PaintParams::toKey(const KeyContext& keyContext,
 
             AddToKey(keyContext, builder, gatherer, fClipShader.get());
 
+        builder->endBlock();
+    } else if (!fAnalyticClip.isEmpty()) {
+        ClipShaderBlock::BeginBlock(keyContext, builder, gatherer);
+
+            AnalyticClipBlock::AddBlock(keyContext, builder, gatherer, fAnalyticClip);
+
         builder->endBlock();
     }
 
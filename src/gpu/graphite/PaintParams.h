@@ -11,6 +11,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkPaint.h"
 #include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/DrawParams.h"
 #include <functional>  // std::function
 
 class SkColorInfo;
@@ -37,7 +38,8 @@ public:
                          sk_sp<SkBlender> primitiveBlender,
                          sk_sp<SkShader> clipShader,
                          DstReadRequirement dstReadReq,
-                         bool skipColorXform);
+                         bool skipColorXform,
+                         const AnalyticClip& analyticClip = {});
 
     PaintParams(const PaintParams&);
     ~PaintParams();
@@ -62,12 +64,20 @@ public:
     DstReadRequirement dstReadRequirement() const { return fDstReadReq; }
     bool skipColorXform() const { return fSkipColorXform; }
     bool dither() const { return fDither; }
+    const AnalyticClip& analyticClip() const { return fAnalyticClip; }
 
     /** Converts an SkColor4f to the destination color space. */
     static SkColor4f Color4fPrepForDst(SkColor4f srgb, const SkColorInfo& dstColorInfo);
 
     void toKey(const KeyContext&, PaintParamsKeyBuilder*, PipelineDataGatherer*) const;
 
+    // Returns true if 'other' has the same color and state and uses the same shader, color filter,
+    // and blender objects, so that toKey() adds the same key and data for both given the same
+    // KeyContext.
+    bool hasSameShading(const PaintParams& other) const;
+    // Returns true if toKey() can depend on the KeyContext's local-to-device transform.
+    bool usesLocalToDevice() const { return fShader || fClipShader; }
+
     void notifyImagesInUse(Recorder*, DrawContext*) const;
 
 private:
@@ -89,6 +99,8 @@ private:
     // the dest is the paint's color (or the paint's shader's computed color).
     sk_sp<SkBlender>     fPrimitiveBlender;
     sk_sp<SkShader>      fClipShader;
+    // Only used if there's no clip shader.
+    AnalyticClip         fAnalyticClip;
     DstReadRequirement   fDstReadReq;
     bool                 fSkipColorXform;
     bool                 fDither;
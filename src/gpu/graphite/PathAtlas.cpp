@@ -123,7 +123,7 @@ const TextureProxy* PathAtlas::DrawAtlasMgr::findOrCreateEntry(Recorder* recorde
 
     AtlasLocator locator;
     const TextureProxy* proxy = this->addToAtlas(recorder, shape, transform, strokeRec,
-                                                 maskSize, outPos, &locator);
+                                                 maskSize, outPos, &locator, &maskKey);
     if (!proxy) {
         return nullptr;
     }
@@ -145,7 +145,8 @@ const TextureProxy* PathAtlas::DrawAtlasMgr::addToAtlas(Recorder* recorder,
                                                         const SkStrokeRec& strokeRec,
                                                         skvx::half2 maskSize,
                                                         skvx::half2* outPos,
-                                                        AtlasLocator* locator) {
+                                                        AtlasLocator* locator,
+                                                        const skgpu::UniqueKey* maskKey) {
     // Render mask.
     SkIRect iShapeBounds = SkIRect::MakeXYWH(0, 0, maskSize.x(), maskSize.y());
     // Outset to take padding into account
@@ -171,7 +172,7 @@ const TextureProxy* PathAtlas::DrawAtlasMgr::addToAtlas(Recorder* recorder,
         return fDrawAtlas->getProxies()[locator->pageIndex()].get();
     }
 
-    if (!this->onAddToAtlas(shape, transform, strokeRec, iShapeBounds, *locator)) {
+    if (!this->onAddToAtlas(shape, transform, strokeRec, iShapeBounds, *locator, maskKey)) {
         return nullptr;
     }
 
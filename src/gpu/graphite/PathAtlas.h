@@ -99,9 +99,13 @@ public:
      *
      * `clipBounds` represents the conservative bounding box of the union of the clip stack that
      * should apply to the shape.
+     *
+     * `shape` is the shape to be drawn, so that an atlas can accept larger masks for shapes that
+     * would be expensive to draw with another renderer.
      */
     virtual bool isSuitableForAtlasing(const Rect& transformedShapeBounds,
-                                       const Rect& clipBounds) const {
+                                       const Rect& clipBounds,
+                                       const Shape& shape) const {
         return true;
     }
 
@@ -127,14 +131,16 @@ protected:
                                               const SkStrokeRec& strokeRec,
                                               skvx::half2 maskSize,
                                               skvx::half2* outPos);
-        // Adds to DrawAtlas but not the cache
+        // Adds to DrawAtlas but not the cache. 'maskKey' is passed on to onAddToAtlas() when the
+        // entry is added by findOrCreateEntry().
         const TextureProxy* addToAtlas(Recorder* recorder,
                                        const Shape& shape,
                                        const Transform& transform,
                                        const SkStrokeRec& strokeRec,
                                        skvx::half2 maskSize,
                                        skvx::half2* outPos,
-                                       AtlasLocator* locator);
+                                       AtlasLocator* locator,
+                                       const skgpu::UniqueKey* maskKey = nullptr);
         bool recordUploads(DrawContext*, Recorder*);
         void evict(PlotLocator) override;
         void postFlush(Recorder*);
@@ -145,11 +151,13 @@ protected:
                      DrawAtlas::UseStorageTextures useStorageTextures,
                      std::string_view label, const Caps*);
 
+        // 'maskKey' is the key of a cached entry, or null if the entry is not cached.
         bool virtual onAddToAtlas(const Shape&,
                                   const Transform& transform,
                                   const SkStrokeRec&,
                                   SkIRect shapeBounds,
-                                  const AtlasLocator&) = 0;
+                                  const AtlasLocator&,
+                                  const skgpu::UniqueKey* maskKey) = 0;
 
         std::unique_ptr<DrawAtlas> fDrawAtlas;
 
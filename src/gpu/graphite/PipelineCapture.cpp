@@ -0,0 +1,234 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/PipelineCapture.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkString.h"
+#include "include/gpu/graphite/Context.h"
+#include "src/core/SkKnownRuntimeEffects.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GraphicsPipeline.h"
+#include "src/gpu/graphite/GraphicsPipelineDesc.h"
+#include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PaintParamsKey.h"
+#include "src/gpu/graphite/RenderPassDesc.h"
+#include "src/gpu/graphite/Renderer.h"
+#include "src/gpu/graphite/RendererProvider.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/RuntimeEffectDictionary.h"
+#include "src/gpu/graphite/ShaderCodeDictionary.h"
+
+#include <vector>
+
+namespace skgpu::graphite {
+
+namespace {
+
+static constexpr uint32_t kCaptureMagic = SkSetFourByteTag('g', 'p', 'c', 'p');
+static constexpr uint32_t kCaptureVersion = 1;
+
+// Snippet IDs at or above this value come from user-defined runtime effects and are only
+// meaningful within the process that registered them.
+static constexpr int kFirstUnstableSnippetID =
+        SkKnownRuntimeEffects::kSkiaKnownRuntimeEffectsStart + SkKnownRuntimeEffects::kStableKeyCnt;
+
+// Each node in a PaintParamsKey is its snippet ID followed by its children, so rebuilding a key
+// only needs the child counts from the dictionary. Returns false on a malformed key.
+bool add_key_node(const ShaderCodeDictionary* dict,
+                  SkSpan<const int32_t> keyData,
+                  int* index,
+                  PaintParamsKeyBuilder* builder) {
+    if (*index >= SkTo<int>(keyData.size())) {
+        return false;
+    }
+    const int32_t id = keyData[(*index)++];
+    const ShaderSnippet* entry = id < kFirstUnstableSnippetID ? dict->getEntry(id) : nullptr;
+    if (!entry) {
+        return false;
+    }
+    builder->beginBlock(id);
+    for (int i = 0; i < entry->fNumChildren; ++i) {
+        if (!add_key_node(dict, keyData, index, builder)) {
+            return false;
+        }
+    }
+    builder->endBlock();
+    return true;
+}
+
+struct CapturedPipeline {
+    GraphicsPipelineDesc fPipelineDesc;
+    RenderPassDesc fRenderPassDesc;
+};
+
+bool read_entry(Context* context,
+                const void* data,
+                size_t size,
+                std::vector<CapturedPipeline>* pipelines) {
+    const Caps* caps = context->priv().caps();
+    ShaderCodeDictionary* dict = context->priv().shaderCodeDictionary();
+
+    SkReadBuffer buffer(data, size);
+    SkString stepName;
+    buffer.readString(&stepName);
+    const SkColorType colorType = buffer.checkRange(kUnknown_SkColorType, kLastEnum_SkColorType);
+    const Mipmapped mipmapped = buffer.readBool() ? Mipmapped::kYes : Mipmapped::kNo;
+    const Protected isProtected = buffer.readBool() ? Protected::kYes : Protected::kNo;
+    const DepthStencilFlags dsFlags = buffer.checkRange(DepthStencilFlags::kNone,
+                                                        DepthStencilFlags::kDepthStencil);
+    const bool requiresMSAA = buffer.readBool();
+    std::vector<int32_t> keyData(buffer.getArrayCount());
+    buffer.readIntArray(keyData.data(), keyData.size());
+    if (!buffer.isValid()) {
+        return false;
+    }
+
+    const RenderStep* step = context->priv().rendererProvider()->lookupByName(stepName.c_str());
+    if (!step) {
+        // The capture came from a build with different render steps; skip this pipeline.
+        return true;
+    }
+
+    UniquePaintParamsID paintID = UniquePaintParamsID::InvalidID();
+    if (!keyData.empty()) {
+        PaintParamsKeyBuilder builder(dict);
+        int index = 0;
+        while (index < SkTo<int>(keyData.size())) {
+            if (!add_key_node(dict, keyData, &index, &builder)) {
+                return true;
+            }
+        }
+        paintID = dict->findOrCreate(&builder);
+    }
+
+    TextureInfo info = caps->getDefaultSampledTextureInfo(colorType,
+                                                          mipmapped,
+                                                          isProtected,
+                                                          Renderable::kYes);
+    if (!info.isValid()) {
+        return true;
+    }
+    // The load/store ops and clear color don't affect pipeline creation.
+    RenderPassDesc renderPassDesc = RenderPassDesc::Make(caps,
+                                                         info,
+                                                         LoadOp::kClear,
+                                                         StoreOp::kStore,
+                                                         dsFlags,
+                                                         /* clearColor= */ {.0f, .0f, .0f, .0f},
+                                                         requiresMSAA,
+                                                         caps->getWriteSwizzle(colorType, info));
+    pipelines->push_back({GraphicsPipelineDesc(step, paintID), renderPassDesc});
+    return true;
+}
+
+void compile_pipelines(ResourceProvider* resourceProvider,
+                       const RuntimeEffectDictionary* rtEffectDict,
+                       SkSpan<const CapturedPipeline> pipelines) {
+    for (const CapturedPipeline& p : pipelines) {
+        sk_sp<GraphicsPipeline> pipeline = resourceProvider->findOrCreateGraphicsPipeline(
+                rtEffectDict, p.fPipelineDesc, p.fRenderPassDesc);
+        if (!pipeline) {
+            SKGPU_LOG_W("Failed to create captured GraphicsPipeline in precompile!");
+        }
+    }
+}
+
+}  // anonymous namespace
+
+void PipelineCapture::add(const ShaderCodeDictionary* dict,
+                          const RendererProvider* rendererProvider,
+                          SkSpan<const GraphicsPipelineDesc> pipelineDescs,
+                          SkColorType targetColorType,
+                          const TextureInfo& targetInfo,
+                          SkEnumBitMask<DepthStencilFlags> dsFlags,
+                          bool requiresMSAA) {
+    for (const GraphicsPipelineDesc& desc : pipelineDescs) {
+        const RenderStep* step = rendererProvider->lookup(desc.renderStepID());
+        if (!step) {
+            continue;
+        }
+        PaintParamsKey key = desc.paintParamsID().isValid() ? dict->lookup(desc.paintParamsID())
+                                                            : PaintParamsKey::Invalid();
+        SkSpan<const int32_t> keyData = key.data();
+        bool stable = true;
+        for (int32_t id : keyData) {
+            stable &= id < kFirstUnstableSnippetID;
+        }
+        if (!stable) {
+            continue;
+        }
+
+        SkBinaryWriteBuffer buffer({});
+        buffer.writeString(step->name());
+        buffer.writeUInt(targetColorType);
+        buffer.writeBool(targetInfo.mipmapped() == Mipmapped::kYes);
+        buffer.writeBool(targetInfo.isProtected() == Protected::kYes);
+        buffer.writeInt(dsFlags.value());
+        buffer.writeBool(requiresMSAA);
+        buffer.writeIntArray(keyData.data(), keyData.size());
+
+        std::string entry(buffer.bytesWritten(), '\0');
+        buffer.writeToMemory(entry.data());
+        if (!fSeen.contains(entry)) {
+            fSeen.add(entry);
+            fEntries.push_back(std::move(entry));
+        }
+    }
+}
+
+sk_sp<SkData> PipelineCapture::serialize() const {
+    SkBinaryWriteBuffer buffer({});
+    buffer.writeUInt(kCaptureMagic);
+    buffer.writeUInt(kCaptureVersion);
+    buffer.writeUInt(fEntries.size());
+    for (const std::string& entry : fEntries) {
+        buffer.writeByteArray(entry.data(), entry.size());
+    }
+    return buffer.snapshotAsData();
+}
+
+bool PipelineCapture::Precompile(Context* context, const SkData& data, SkExecutor* executor) {
+    SkReadBuffer buffer(data.data(), data.size());
+    if (buffer.readUInt() != kCaptureMagic || buffer.readUInt() != kCaptureVersion) {
+        return false;
+    }
+    const uint32_t count = buffer.readUInt();
+    if (!buffer.validateCanReadN<uint32_t>(count)) {
+        return false;
+    }
+
+    std::vector<CapturedPipeline> pipelines;
+    pipelines.reserve(count);
+    std::vector<char> entry;
+    for (uint32_t i = 0; i < count; ++i) {
+        entry.resize(buffer.getArrayCount());
+        if (!buffer.readByteArray(entry.data(), entry.size()) ||
+            !read_entry(context, entry.data(), entry.size(), &pipelines)) {
+            return false;
+        }
+    }
+
+    // Captured paint keys never reference user-defined runtime effects, so an empty dictionary
+    // is sufficient.
+    RuntimeEffectDictionary rtEffectDict;
+    ResourceProvider* resourceProvider = context->priv().resourceProvider();
+    skia_private::TArray<ResourceProvider::GraphicsPipelineRequest> requests;
+    for (const CapturedPipeline& p : pipelines) {
+        requests.push_back({&p.fPipelineDesc, &p.fRenderPassDesc});
+    }
+    resourceProvider->createGraphicsPipelinesInParallel(&rtEffectDict, requests, executor);
+    // Anything still missing (or everything, without an executor) is created here.
+    compile_pipelines(resourceProvider, &rtEffectDict, pipelines);
+    return true;
+}
+
+}  // namespace skgpu::graphite
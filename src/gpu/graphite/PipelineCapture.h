@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_PipelineCapture_DEFINED
+#define skgpu_graphite_PipelineCapture_DEFINED
+
+#include "include/core/SkColorType.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkEnumBitMask.h"
+#include "src/core/SkTHash.h"
+
+#include <string>
+
+class SkData;
+class SkExecutor;
+
+namespace skgpu::graphite {
+
+class Context;
+class GraphicsPipelineDesc;
+class RendererProvider;
+class ShaderCodeDictionary;
+class TextureInfo;
+enum class DepthStencilFlags : int;
+
+/**
+ * Records the GraphicsPipelineDesc and RenderPassDesc combinations a Recorder's draws require, in
+ * a form that is stable across processes running the same build of Skia on the same device. The
+ * serialized capture can later be handed to Precompile() so that exactly those pipelines are
+ * created ahead of time.
+ *
+ * Render steps are recorded by name and paint keys by their code snippet IDs. Pipelines whose
+ * paint key uses a user-defined runtime effect are skipped, since those snippet IDs depend on the
+ * order in which effects were first seen. RenderPassDescs are recorded as the inputs needed to
+ * rebuild them from the default texture info for the target color type, matching what the
+ * PaintOptions-based Precompile() does.
+ */
+class PipelineCapture {
+public:
+    PipelineCapture() = default;
+
+    void add(const ShaderCodeDictionary*,
+             const RendererProvider*,
+             SkSpan<const GraphicsPipelineDesc>,
+             SkColorType targetColorType,
+             const TextureInfo& targetInfo,
+             SkEnumBitMask<DepthStencilFlags>,
+             bool requiresMSAA);
+
+    int count() const { return fEntries.size(); }
+
+    sk_sp<SkData> serialize() const;
+
+    // Creates every pipeline in the serialized capture. If an executor is provided the pipelines
+    // are compiled on it in parallel, and this blocks until they are done. Returns false if the
+    // data could not be parsed; individual pipelines that fail to compile are logged and skipped.
+    static bool Precompile(Context*, const SkData&, SkExecutor*);
+
+private:
+    // Each entry is a self-contained, serialized description of one pipeline.
+    skia_private::TArray<std::string> fEntries;
+    skia_private::THashSet<std::string> fSeen;
+};
+
+} // namespace skgpu::graphite
+
+#endif // skgpu_graphite_PipelineCapture_DEFINED
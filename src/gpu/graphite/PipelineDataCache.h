@@ -29,14 +29,17 @@ public:
     PipelineDataCache() = default;
 
     const T* insert(const T& dataBlock) {
-        DataRef data{&dataBlock}; // will not be persisted, since pointer isn't from the arena.
+        // The contents are hashed once here and the hash is kept with the cached block, so neither
+        // the lookup, the add, nor growing the set hash the data again.
+        const uint32_t hash = dataBlock.hash();
+        DataRef data{&dataBlock, hash}; // will not be persisted, since pointer isn't from the arena.
         const DataRef* existing = fDataPointers.find(data);
         if (existing) {
             return existing->fPointer;
         } else {
             // Need to make a copy of dataBlock into the arena
             T* copy = T::Make(dataBlock, &fArena);
-            fDataPointers.add(DataRef{copy});
+            fDataPointers.add(DataRef{copy, hash});
             return copy;
         }
     }
@@ -57,20 +60,18 @@ public:
 private:
     struct DataRef {
         const T* fPointer;
+        uint32_t fHash;  // of the data contents
 
         bool operator==(const DataRef& o) const {
             if (!fPointer || !o.fPointer) {
                 return !fPointer && !o.fPointer;
             } else {
-                return *fPointer == *o.fPointer;
+                return fHash == o.fHash && *fPointer == *o.fPointer;
             }
         }
     };
     struct Hash {
-        // This hash operator de-references and hashes the data contents
-        size_t operator()(const DataRef& dataBlock) const {
-            return dataBlock.fPointer ? dataBlock.fPointer->hash() : 0;
-        }
+        size_t operator()(const DataRef& dataBlock) const { return dataBlock.fHash; }
     };
 
     skia_private::THashSet<DataRef, Hash> fDataPointers;
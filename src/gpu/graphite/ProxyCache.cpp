@@ -12,6 +12,10 @@
 #include "include/gpu/GpuTypes.h"
 #include "src/core/SkMipmap.h"
 #include "src/gpu/ResourceKey.h"
+#include "src/gpu/SkBackingFit.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/Image_YUVA_Graphite.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/Texture.h"
 #include "src/gpu/graphite/TextureProxy.h"
@@ -39,6 +43,15 @@ void make_bitmap_key(skgpu::UniqueKey* key, const SkBitmap& bm) {
     builder[4] = subset.fBottom;
 }
 
+void make_yuva_conversion_key(skgpu::UniqueKey* key, uint32_t imageID) {
+    SkASSERT(key);
+
+    static const skgpu::UniqueKey::Domain kYUVAConversionDomain =
+            skgpu::UniqueKey::GenerateDomain();
+    skgpu::UniqueKey::Builder builder(key, kYUVAConversionDomain, 1, "YUVAConversion");
+    builder[0] = imageID;
+}
+
 sk_sp<SkIDChangeListener> make_unique_key_invalidation_listener(const skgpu::UniqueKey& key,
                                                                 uint32_t recorderID) {
     class Listener : public SkIDChangeListener {
@@ -117,8 +130,62 @@ sk_sp<TextureProxy> ProxyCache::findOrCreateCachedProxy(Recorder* recorder,
     return view.refProxy();
 }
 
+sk_sp<Image> ProxyCache::findOrCreateConvertedYUVA(Recorder* recorder, const Image_YUVA* image) {
+    // Images that can still be rendered to would make the copy stale, and protected content must
+    // not be copied to an unprotected texture.
+    if (image->isDynamic() || image->isProtected()) {
+        return nullptr;
+    }
+
+    this->processInvalidKeyMsgs();
+
+    skgpu::UniqueKey key;
+    make_yuva_conversion_key(&key, image->uniqueID());
+    if (sk_sp<TextureProxy>* cached = fCache.find(key)) {
+        if (Resource* resource = (*cached)->texture()) {
+            resource->updateAccessTime();
+        }
+        // This matches the color info of the image made by CopyAsDraw() below.
+        const Caps* caps = recorder->priv().caps();
+        SkColorInfo colorInfo = image->imageInfo().colorInfo()
+                .makeColorType(caps->getRenderableColorType(image->colorType()))
+                .makeAlphaType(kPremul_SkAlphaType);
+        Swizzle swizzle = caps->getReadSwizzle(colorInfo.colorType(), (*cached)->textureInfo());
+        return sk_make_sp<Image>(TextureProxyView(*cached, swizzle), colorInfo);
+    }
+
+    int* drawCount = fYUVADrawCounts.find(image->uniqueID());
+    if (!drawCount) {
+        fYUVADrawCounts.insert(image->uniqueID(), 1);
+        return nullptr;
+    }
+    if (++(*drawCount) <= kYUVAConversionThreshold) {
+        return nullptr;
+    }
+
+    // Copying draws the image, which comes back here. Removing its count first makes that draw
+    // sample the planes instead of recursing.
+    fYUVADrawCounts.remove(image->uniqueID());
+    sk_sp<Image> converted = CopyAsDraw(recorder,
+                                        image,
+                                        image->bounds(),
+                                        image->imageInfo().colorInfo(),
+                                        Budgeted::kYes,
+                                        Mipmapped::kNo,
+                                        SkBackingFit::kExact,
+                                        "YUVAConversion");
+    if (fYUVADrawCounts.find(image->uniqueID())) {
+        fYUVADrawCounts.remove(image->uniqueID());
+    }
+    if (converted) {
+        fCache.set(key, converted->textureProxyView().refProxy());
+    }
+    return converted;
+}
+
 void ProxyCache::purgeAll() {
     fCache.reset();
+    fYUVADrawCounts.reset();
 }
 
 void ProxyCache::processInvalidKeyMsgs() {
@@ -9,6 +9,7 @@
 #define skgpu_graphite_ProxyCache_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkTHash.h"
 #include "src/gpu/GpuTypesPriv.h"
@@ -23,6 +24,8 @@ namespace skgpu {
 
 namespace skgpu::graphite {
 
+class Image;
+class Image_YUVA;
 class Recorder;
 class TextureProxy;
 
@@ -54,6 +57,15 @@ public:
                                                 BitmapGeneratorFn fn,
                                                 std::string_view label = {});
 
+    // Returns an RGBA copy of 'image' once it has been drawn more than kYUVAConversionThreshold
+    // times, so that later draws sample one texture instead of converting from the YUVA planes
+    // every time. Images that are only drawn a few times (like video frames) are never converted.
+    // Returns null if the image should be drawn from its planes directly.
+    //
+    // The copy is cached like other proxies in this cache, so it is budgeted by the ResourceCache
+    // and dropped when it's purged for memory or not used for a while.
+    sk_sp<Image> findOrCreateConvertedYUVA(Recorder*, const Image_YUVA*);
+
     void purgeAll();
 
 #if defined(GRAPHITE_TEST_UTILS)
@@ -75,6 +87,12 @@ private:
     };
 
     skia_private::THashMap<UniqueKey, sk_sp<TextureProxy>, UniqueKeyHash> fCache;
+
+    // How many times recently drawn YUVA images that haven't been converted yet have been drawn,
+    // keyed by the image's unique ID.
+    static constexpr int kYUVAConversionThreshold = 3;
+    static constexpr int kMaxTrackedYUVAImages = 128;
+    SkLRUCache<uint32_t, int> fYUVADrawCounts{kMaxTrackedYUVAImages};
     SkMessageBus<UniqueKeyInvalidatedMsg_Graphite, uint32_t>::Inbox fInvalidUniqueKeyInbox;
 };
 
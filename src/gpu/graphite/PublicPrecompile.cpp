@@ -17,6 +17,7 @@
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/KeyContext.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PipelineCapture.h"
 #include "src/gpu/graphite/PrecompileInternal.h"
 #include "src/gpu/graphite/RenderPassDesc.h"
 #include "src/gpu/graphite/Renderer.h"
@@ -98,6 +99,10 @@ bool Precompile(Context* context,
     return true;
 }
 
+bool Precompile(Context* context, const SkData& capturedPipelines, SkExecutor* executor) {
+    return PipelineCapture::Precompile(context, capturedPipelines, executor);
+}
+
 void Precompile(Context* context, const PaintOptions& options, DrawTypeFlags drawTypes) {
 
     ShaderCodeDictionary* dict = context->priv().shaderCodeDictionary();
@@ -140,10 +140,19 @@ bool QueueManager::addRecording(const InsertRecordingInfo& info, Context* contex
     }
 
     fCurrentCommandBuffer->addWaitSemaphores(info.fNumWaitSemaphores, info.fWaitSemaphores);
-    if (!info.fRecording->priv().addCommands(context,
-                                             fCurrentCommandBuffer.get(),
-                                             static_cast<Surface*>(info.fTargetSurface),
-                                             info.fTargetTranslation)) {
+    bool timePasses = info.fGpuTimingsProc && fSharedContext->caps()->timestampQuerySupport();
+    if (timePasses) {
+        fCurrentCommandBuffer->beginPassTimings(info.fGpuTimingsProc, info.fGpuTimingsContext);
+    }
+    bool addedCommands = info.fRecording->priv().addCommands(
+            context,
+            fCurrentCommandBuffer.get(),
+            static_cast<Surface*>(info.fTargetSurface),
+            info.fTargetTranslation);
+    if (timePasses) {
+        fCurrentCommandBuffer->endPassTimings(addedCommands);
+    }
+    if (!addedCommands) {
         if (callback) {
             callback->setFailureResult();
         }
@@ -8,13 +8,21 @@
 #include "src/gpu/graphite/RasterPathAtlas.h"
 
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "src/core/SkIPoint16.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/graphite/AtlasProvider.h"
+#include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/DrawContext.h"
+#include "src/gpu/graphite/GlobalCache.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/RasterPathUtils.h"
 #include "src/gpu/graphite/RecorderPriv.h"
+#include "src/gpu/graphite/SharedContext.h"
+
+#include <cmath>
+#include <cstring>
 
 namespace skgpu::graphite {
 
@@ -23,18 +31,48 @@ static constexpr uint32_t kDefaultAtlasDim = 4096;
 static constexpr uint32_t kSmallPathPlotWidth = 512;
 static constexpr uint32_t kSmallPathPlotHeight = 256;
 
+#if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
+// Cached masks are rendered with their fractional translation rounded to this many steps per pixel.
+// This matches the subpixel positioning of glyphs and leaves an error of at most 1/8th pixel.
+static constexpr float kSubpixelSteps = 4.f;
+
+// Computed from the integer part so that the result is exact, and so has the same fraction bits in
+// the mask key as every other translation in its step.
+static float snap_translation(float t) {
+    float integer = std::floor(t);
+    return integer + std::round((t - integer) * kSubpixelSteps) / kSubpixelSteps;
+}
+#endif
+
 RasterPathAtlas::RasterPathAtlas(Recorder* recorder)
         : PathAtlas(recorder, kDefaultAtlasDim, kDefaultAtlasDim)
-        , fCachedAtlasMgr(fWidth, fHeight, fWidth, fHeight, recorder->priv().caps())
+        , fCachedAtlasMgr(fWidth, fHeight, fWidth, fHeight, recorder->priv().caps(),
+                          /*sharedMasks=*/nullptr)
         , fSmallPathAtlasMgr(std::max(fWidth/2, kSmallPathPlotWidth),
                              std::max(fHeight/2, kSmallPathPlotHeight),
                              kSmallPathPlotWidth, kSmallPathPlotHeight,
-                             recorder->priv().caps())
-        , fUncachedAtlasMgr(fWidth, fHeight, fWidth, fHeight, recorder->priv().caps()) {
+                             recorder->priv().caps(),
+                             recorder->priv().sharedContext()->globalCache())
+        , fUncachedAtlasMgr(fWidth, fHeight, fWidth, fHeight, recorder->priv().caps(),
+                            /*sharedMasks=*/nullptr) {
     SkASSERT(recorder);
 }
 
 void RasterPathAtlas::recordUploads(DrawContext* dc) {
+    if (fCachedAtlasMgr.hasPendingMasks() ||
+        fSmallPathAtlasMgr.hasPendingMasks() ||
+        fUncachedAtlasMgr.hasPendingMasks()) {
+        SkTaskGroup taskGroup(*fRecorder->priv().caps()->executor());
+        fCachedAtlasMgr.rasterizePendingMasks(&taskGroup);
+        fSmallPathAtlasMgr.rasterizePendingMasks(&taskGroup);
+        fUncachedAtlasMgr.rasterizePendingMasks(&taskGroup);
+        taskGroup.wait();
+
+        fCachedAtlasMgr.clearPendingMasks();
+        fSmallPathAtlasMgr.clearPendingMasks();
+        fUncachedAtlasMgr.clearPendingMasks();
+    }
+
     fCachedAtlasMgr.recordUploads(dc, fRecorder);
     fSmallPathAtlasMgr.recordUploads(dc, fRecorder);
     fUncachedAtlasMgr.recordUploads(dc, fRecorder);
@@ -45,16 +83,26 @@ const TextureProxy* RasterPathAtlas::onAddShape(const Shape& shape,
                                                 const SkStrokeRec& strokeRec,
                                                 skvx::half2 maskSize,
                                                 skvx::half2* outPos) {
-    skgpu::UniqueKey maskKey;
     bool hasKey = shape.hasKey();
     if (hasKey) {
+        // The cache key includes 8 bits of subpixel translation. Snapping it first means a shape
+        // drawn at many fractional offsets is rendered into at most 16 masks.
+        Transform cachedTransform = transform;
+#if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
+        if (transform.type() <= Transform::Type::kAffine) {
+            SkM44 m = transform.matrix();
+            m.setRC(0, 3, snap_translation(m.rc(0, 3)));
+            m.setRC(1, 3, snap_translation(m.rc(1, 3)));
+            cachedTransform = Transform(m);
+        }
+#endif
         constexpr int kMaxSmallPathSize = 162;
         // Try to locate or add to cached DrawAtlas
         const TextureProxy* proxy = nullptr;
         if (maskSize.x() <= kMaxSmallPathSize && maskSize.y() <= kMaxSmallPathSize) {
             proxy = fSmallPathAtlasMgr.findOrCreateEntry(fRecorder,
                                                          shape,
-                                                         transform,
+                                                         cachedTransform,
                                                          strokeRec,
                                                          maskSize,
                                                          outPos);
@@ -62,7 +110,7 @@ const TextureProxy* RasterPathAtlas::onAddShape(const Shape& shape,
         if (!proxy) {
             proxy = fCachedAtlasMgr.findOrCreateEntry(fRecorder,
                                                       shape,
-                                                      transform,
+                                                      cachedTransform,
                                                       strokeRec,
                                                       maskSize,
                                                       outPos);
@@ -85,27 +133,95 @@ const TextureProxy* RasterPathAtlas::onAddShape(const Shape& shape,
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+RasterPathAtlas::RasterAtlasMgr::RasterAtlasMgr(size_t width, size_t height,
+                                                size_t plotWidth, size_t plotHeight,
+                                                const Caps* caps,
+                                                GlobalCache* sharedMasks)
+        : PathAtlas::DrawAtlasMgr(width, height, plotWidth, plotHeight,
+                                  DrawAtlas::UseStorageTextures::kNo,
+                                  /*label=*/"RasterPathAtlas", caps)
+        , fExecutor(caps->executor())
+        , fSharedMasks(sharedMasks) {}
+
 bool RasterPathAtlas::RasterAtlasMgr::onAddToAtlas(const Shape& shape,
                                                    const Transform& transform,
                                                    const SkStrokeRec& strokeRec,
                                                    SkIRect shapeBounds,
-                                                   const AtlasLocator& locator) {
+                                                   const AtlasLocator& locator,
+                                                   const skgpu::UniqueKey* maskKey) {
     // Rasterize path to backing pixmap.
     // This pixmap will be the size of the Plot that contains the given rect, not the entire atlas,
     // and hence the position we render at will be relative to that Plot.
     // The value of outPos is relative to the entire texture, to be used for texture coords.
     SkAutoPixmapStorage dst;
     SkIPoint renderPos = fDrawAtlas->prepForRender(locator, &dst);
+    if (dst.dimensions() != fDrawAtlas->plotSize()) {
+        return false;
+    }
+    // Offset to plot location and draw
+    shapeBounds.offset(renderPos.x()+kEntryPadding, renderPos.y()+kEntryPadding);
+
+    const bool shared = maskKey && fSharedMasks;
+    if (shared) {
+        sk_sp<SkData> mask = fSharedMasks->findPathMask(*maskKey);
+        if (mask && mask->size() == (size_t)shapeBounds.width() * shapeBounds.height()) {
+            const uint8_t* src = mask->bytes();
+            for (int y = shapeBounds.fTop; y < shapeBounds.fBottom; ++y) {
+                memcpy(dst.writable_addr8(shapeBounds.fLeft, y), src, shapeBounds.width());
+                src += shapeBounds.width();
+            }
+            return true;
+        }
+    }
+
+    if (fExecutor) {
+        // The Plot keeps its pixels until it is evicted, which can't happen before the upload
+        // that rasterizePendingMasks() precedes since the Plot is in use by this flush.
+        fPendingMasks.push_back({shape, transform, strokeRec, shapeBounds, dst,
+                                 shared ? *maskKey : skgpu::UniqueKey()});
+        return true;
+    }
 
     RasterMaskHelper helper(&dst);
     if (!helper.init(fDrawAtlas->plotSize())) {
         return false;
     }
-    // Offset to plot location and draw
-    shapeBounds.offset(renderPos.x()+kEntryPadding, renderPos.y()+kEntryPadding);
     helper.drawShape(shape, transform, strokeRec, shapeBounds);
+    if (shared) {
+        this->shareMask(*maskKey, dst, shapeBounds);
+    }
 
     return true;
 }
 
+void RasterPathAtlas::RasterAtlasMgr::shareMask(const skgpu::UniqueKey& key,
+                                                const SkPixmap& plotPixels,
+                                                SkIRect bounds) {
+    SkASSERT(fSharedMasks);
+    sk_sp<SkData> mask = SkData::MakeUninitialized((size_t)bounds.width() * bounds.height());
+    uint8_t* dst = static_cast<uint8_t*>(mask->writable_data());
+    for (int y = bounds.fTop; y < bounds.fBottom; ++y) {
+        memcpy(dst, plotPixels.addr8(bounds.fLeft, y), bounds.width());
+        dst += bounds.width();
+    }
+    fSharedMasks->addPathMask(key, std::move(mask));
+}
+
+void RasterPathAtlas::RasterAtlasMgr::rasterizePendingMasks(SkTaskGroup* taskGroup) {
+    for (const PendingMask& mask : fPendingMasks) {
+        taskGroup->add([this, &mask] {
+            SkAutoPixmapStorage dst;
+            dst.reset(mask.fPlotPixels.info(), mask.fPlotPixels.writable_addr(),
+                      mask.fPlotPixels.rowBytes());
+            RasterMaskHelper helper(&dst);
+            if (helper.init(dst.dimensions())) {
+                helper.drawShape(mask.fShape, mask.fTransform, mask.fStrokeRec, mask.fBounds);
+                if (mask.fKey.isValid()) {
+                    this->shareMask(mask.fKey, dst, mask.fBounds);
+                }
+            }
+        });
+    }
+}
+
 }  // namespace skgpu::graphite
@@ -8,10 +8,21 @@
 #ifndef skgpu_graphite_RasterPathAtlas_DEFINED
 #define skgpu_graphite_RasterPathAtlas_DEFINED
 
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkStrokeRec.h"
+#include "include/private/base/SkTArray.h"
 #include "src/gpu/graphite/PathAtlas.h"
+#include "src/gpu/graphite/geom/Shape.h"
+#include "src/gpu/graphite/geom/Transform_graphite.h"
+
+class SkExecutor;
+class SkTaskGroup;
 
 namespace skgpu::graphite {
 
+class GlobalCache;
+
 /**
  * PathAtlas class that rasterizes coverage masks on the CPU.
  *
@@ -20,7 +31,15 @@ namespace skgpu::graphite {
  *
  * Shapes are cached for future frames to avoid the cost of raster pipeline rendering. Multiple
  * textures (or Pages) are used to cache masks, so if the atlas is full we can reset a Page and
- * start adding new shapes for a future atlas render.
+ * start adding new shapes for a future atlas render. The fractional translation of cached shapes
+ * is snapped to a quarter pixel so that a shape that moves by a fraction of a pixel, like an icon
+ * in a scrolling list, reuses one of a few masks.
+ *
+ * If Caps::executor() is set, the masks added since the last upload are rasterized in parallel
+ * on it when `recordUploads()` is called, instead of as they are added.
+ *
+ * The masks of small cached shapes are also shared with the atlases of other Recorders through the
+ * GlobalCache, so a shape drawn by several Recorders is only rasterized by the first of them.
  */
 class RasterPathAtlas : public PathAtlas {
 public:
@@ -43,19 +62,44 @@ protected:
 private:
     class RasterAtlasMgr : public PathAtlas::DrawAtlasMgr {
     public:
+        // If 'sharedMasks' is set, the masks of cached entries are found in and added to it.
         RasterAtlasMgr(size_t width, size_t height,
                        size_t plotWidth, size_t plotHeight,
-                       const Caps* caps)
-            : PathAtlas::DrawAtlasMgr(width, height, plotWidth, plotHeight,
-                                      DrawAtlas::UseStorageTextures::kNo,
-                                      /*label=*/"RasterPathAtlas", caps) {}
+                       const Caps* caps,
+                       GlobalCache* sharedMasks);
+
+        bool hasPendingMasks() const { return !fPendingMasks.empty(); }
+        // Rasterizes the masks that were deferred by onAddToAtlas() on the task group's executor.
+        // The caller must wait on the group before the masks are uploaded, and then clear them.
+        void rasterizePendingMasks(SkTaskGroup*);
+        void clearPendingMasks() { fPendingMasks.clear(); }
 
     protected:
         bool onAddToAtlas(const Shape&,
                           const Transform& transform,
                           const SkStrokeRec&,
                           SkIRect shapeBounds,
-                          const AtlasLocator&) override;
+                          const AtlasLocator&,
+                          const skgpu::UniqueKey* maskKey) override;
+
+    private:
+        // A mask to be drawn into its Plot's backing pixels. The masks of a Plot are padded apart,
+        // so they can be drawn at the same time.
+        struct PendingMask {
+            Shape       fShape;
+            Transform   fTransform;
+            SkStrokeRec fStrokeRec;
+            SkIRect     fBounds;  // in the Plot's pixels
+            SkPixmap    fPlotPixels;
+            skgpu::UniqueKey fKey;  // valid if the mask should be shared once it is rasterized
+        };
+
+        // Copies the rasterized mask at 'bounds' in 'plotPixels' to fSharedMasks.
+        void shareMask(const skgpu::UniqueKey&, const SkPixmap& plotPixels, SkIRect bounds);
+
+        SkExecutor* fExecutor;
+        GlobalCache* fSharedMasks;
+        skia_private::TArray<PendingMask> fPendingMasks;
     };
 
     RasterAtlasMgr fCachedAtlasMgr;
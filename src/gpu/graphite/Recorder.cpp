@@ -32,6 +32,7 @@
 #include "src/gpu/graphite/GlobalCache.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/PathAtlas.h"
+#include "src/gpu/graphite/PipelineCapture.h"
 #include "src/gpu/graphite/PipelineData.h"
 #include "src/gpu/graphite/PipelineDataCache.h"
 #include "src/gpu/graphite/ProxyCache.h"
@@ -112,6 +113,9 @@ Recorder::Recorder(sk_sp<SharedContext> sharedContext,
     if (!fClientImageProvider) {
         fClientImageProvider = DefaultImageProvider::Make();
     }
+    if (options.fCapturePipelines) {
+        fPipelineCapture = std::make_unique<PipelineCapture>();
+    }
 
     if (context) {
         fOwnedResourceProvider = nullptr;
@@ -120,6 +124,8 @@ Recorder::Recorder(sk_sp<SharedContext> sharedContext,
         fOwnedResourceProvider = fSharedContext->makeResourceProvider(this->singleOwner(),
                                                                     fUniqueID,
                                                                     options.fGpuBudgetInBytes);
+        fOwnedResourceProvider->setResourceCacheOverBudgetPurgeLimit(
+                options.fOverBudgetPurgeLimitInBytes);
         fResourceProvider = fOwnedResourceProvider.get();
     }
     fUploadBufferManager = std::make_unique<UploadBufferManager>(fResourceProvider,
@@ -184,6 +190,20 @@ std::unique_ptr<Recording> Recorder::snap() {
         fTargetProxyCanvas.reset();
     }
 
+    // Preparing the tasks instantiates resources through the ResourceProvider and the
+    // ScratchResourceManager, which are single-threaded and are used in task order so that scratch
+    // textures are reused correctly. Compiling pipelines is the part that can run in parallel, so
+    // the missing pipelines of every task are compiled together first. Doing this for the whole
+    // Recording, rather than per DrawPass, helps Recordings with many passes of few pipelines.
+    if (fSharedContext->caps()->pipelineCompileExecutor()) {
+        skia_private::STArray<16, ResourceProvider::GraphicsPipelineRequest> requests;
+        fRootTaskList->visitPipelines([&requests](const GraphicsPipelineDesc& pipelineDesc,
+                                                  const RenderPassDesc& renderPassDesc) {
+            requests.push_back({&pipelineDesc, &renderPassDesc});
+        });
+        fResourceProvider->createGraphicsPipelinesInParallel(fRuntimeEffectDict.get(), requests);
+    }
+
     // The scratch resources only need to be tracked until prepareResources() is finished, so
     // Recorder doesn't hold a persistent manager and it can be deleted when snap() returns.
     ScratchResourceManager scratchManager{fResourceProvider, std::move(fProxyReadCounts)};
@@ -470,6 +490,11 @@ size_t Recorder::maxBudgetedBytes() const {
     return fResourceProvider->getResourceCacheLimit();
 }
 
+sk_sp<SkData> Recorder::serializeCapturedPipelines() const {
+    ASSERT_SINGLE_OWNER
+    return fPipelineCapture ? fPipelineCapture->serialize() : nullptr;
+}
+
 void Recorder::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     ASSERT_SINGLE_OWNER
     fResourceProvider->dumpMemoryStatistics(traceMemoryDump);
@@ -65,6 +65,7 @@ public:
         return fRecorder->fTextBlobCache.get();
     }
     ProxyCache* proxyCache() { return this->resourceProvider()->proxyCache(); }
+    PipelineCapture* pipelineCapture() { return fRecorder->fPipelineCapture.get(); }
 
     // NOTE: Temporary access for DrawTask to manipulate pending read counts.
     void addPendingRead(const TextureProxy*);
@@ -81,10 +82,11 @@ public:
 
     size_t getResourceCacheLimit() const;
 
+    SharedContext* sharedContext() { return fRecorder->fSharedContext.get(); }
+
 #if defined(GRAPHITE_TEST_UTILS)
     bool deviceIsRegistered(Device*) const;
     ResourceCache* resourceCache() { return fRecorder->fResourceProvider->resourceCache(); }
-    SharedContext* sharedContext() { return fRecorder->fSharedContext.get(); }
     // used by the Context that created this Recorder to set a back pointer
     void setContext(Context*);
     Context* context() { return fRecorder->fContext; }
@@ -83,6 +83,8 @@ public:
     }
 
     const RenderStep* lookup(uint32_t uniqueID) const;
+    // Unlike the unique ID, a RenderStep's name is stable across processes.
+    const RenderStep* lookupByName(std::string_view name) const;
 
 #ifdef SK_ENABLE_VELLO_SHADERS
     // Compute shader-based path renderer and compositor.
@@ -19,6 +19,8 @@
 #include "src/gpu/graphite/Texture.h"
 #endif
 
+#include <limits>
+
 namespace skgpu::graphite {
 
 #define ASSERT_SINGLE_OWNER SKGPU_ASSERT_SINGLE_OWNER(fSingleOwner)
@@ -118,6 +120,7 @@ void ResourceCache::insertResource(Resource* resource) {
 
     if (resource->budgeted() == skgpu::Budgeted::kYes) {
         fBudgetedBytes += resource->gpuMemorySize();
+        this->traceBudget();
     }
 
     this->purgeAsNeeded();
@@ -138,6 +141,7 @@ Resource* ResourceCache::findAndRefResource(const GraphiteResourceKey& key,
             resource = fResourceMap.find(key);
         }
     }
+    TRACE_CACHE_LOOKUP("skia.gpu.cache", "graphite ResourceCache lookups", resource != nullptr);
     if (resource) {
         // All resources we pull out of the cache for use should be budgeted
         SkASSERT(resource->budgeted() == skgpu::Budgeted::kYes);
@@ -400,6 +404,11 @@ void ResourceCache::purgeResource(Resource* resource) {
 }
 
 void ResourceCache::purgeAsNeeded() {
+    this->purgeAsNeeded(fOverBudgetPurgeLimit ? fOverBudgetPurgeLimit
+                                              : std::numeric_limits<size_t>::max());
+}
+
+void ResourceCache::purgeAsNeeded(size_t maxBytesToPurge) {
     ASSERT_SINGLE_OWNER
 
     if (this->overbudget() && fProxyCache) {
@@ -408,7 +417,8 @@ void ResourceCache::purgeAsNeeded() {
         // After the image cache frees resources we need to return those resources to the cache
         this->processReturnedResources();
     }
-    while (this->overbudget() && fPurgeableQueue.count()) {
+    size_t purgedBytes = 0;
+    while (this->overbudget() && fPurgeableQueue.count() && purgedBytes < maxBytesToPurge) {
         Resource* resource = fPurgeableQueue.peek();
         SkASSERT(!resource->wasDestroyed());
         SkASSERT(fResourceMap.find(resource->key()));
@@ -421,12 +431,21 @@ void ResourceCache::purgeAsNeeded() {
             break;
         }
 
+        purgedBytes += resource->gpuMemorySize();
         this->purgeResource(resource);
     }
+    if (purgedBytes) {
+        this->traceBudget();
+    }
 
     this->validate();
 }
 
+void ResourceCache::traceBudget() const {
+    TRACE_COUNTER2("skia.gpu.cache", "graphite budget", "used", fBudgetedBytes,
+                   "free", fMaxBytes > fBudgetedBytes ? fMaxBytes - fBudgetedBytes : 0);
+}
+
 void ResourceCache::purgeResourcesNotUsedSince(StdSteadyClock::time_point purgeTime) {
     ASSERT_SINGLE_OWNER
     this->purgeResources(&purgeTime);
@@ -449,6 +468,7 @@ void ResourceCache::purgeResources(const StdSteadyClock::time_point* purgeTime)
     if (fPurgeableQueue.count() &&
         purgeTime &&
         fPurgeableQueue.peek()->lastAccessTime() >= *purgeTime) {
+        this->purgeAsNeeded(std::numeric_limits<size_t>::max());
         return;
     }
 
@@ -479,8 +499,8 @@ void ResourceCache::purgeResources(const StdSteadyClock::time_point* purgeTime)
 
     // Since we called process returned resources at the start of this call, we could still end up
     // over budget even after purging resources based on purgeTime. So we call purgeAsNeeded at the
-    // end here.
-    this->purgeAsNeeded();
+    // end here. This is also where we catch up on anything the over budget purge limit deferred.
+    this->purgeAsNeeded(std::numeric_limits<size_t>::max());
 }
 
 uint32_t ResourceCache::getNextTimestamp() {
@@ -720,7 +740,7 @@ int ResourceCache::numFindableResources() const {
 void ResourceCache::setMaxBudget(size_t bytes) {
     fMaxBytes = bytes;
     this->processReturnedResources();
-    this->purgeAsNeeded();
+    this->purgeAsNeeded(std::numeric_limits<size_t>::max());
 }
 
 Resource* ResourceCache::topOfPurgeableQueue() {
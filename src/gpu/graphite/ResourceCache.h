@@ -80,6 +80,11 @@ public:
 
     size_t getMaxBudget() const { return fMaxBytes; }
 
+    // Limits how many bytes are purged each time inserting or finding a resource leaves the cache
+    // over budget. Whatever is left over is purged by the next purgeResources() or
+    // purgeResourcesNotUsedSince() call. Zero, the default, means no limit.
+    void setOverBudgetPurgeLimit(size_t bytes) { fOverBudgetPurgeLimit = bytes; }
+
     size_t currentBudgetedBytes() const { return fBudgetedBytes; }
 
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
@@ -126,8 +131,12 @@ private:
     bool inPurgeableQueue(Resource*) const;
 
     bool overbudget() const { return fBudgetedBytes > fMaxBytes; }
+    // Purges at most fOverBudgetPurgeLimit bytes, if set.
     void purgeAsNeeded();
+    void purgeAsNeeded(size_t maxBytesToPurge);
     void purgeResource(Resource*);
+    // Records the budgeted bytes as a trace counter.
+    void traceBudget() const;
     // Passing in a nullptr for purgeTime will trigger us to try and free all unlocked resources.
     void purgeResources(const StdSteadyClock::time_point* purgeTime);
 
@@ -172,6 +181,7 @@ private:
     // Our budget
     size_t fMaxBytes;
     size_t fBudgetedBytes = 0;
+    size_t fOverBudgetPurgeLimit = 0;
 
     SingleOwner* fSingleOwner = nullptr;
 
@@ -10,6 +10,8 @@
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkTileMode.h"
 #include "include/gpu/graphite/BackendTexture.h"
+#include "include/private/base/SingleOwner.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/Caps.h"
@@ -29,6 +31,10 @@
 #include "src/gpu/graphite/Texture.h"
 #include "src/sksl/SkSLCompiler.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace skgpu::graphite {
 
 // This is only used when tracing is enabled at compile time.
@@ -79,6 +85,62 @@ sk_sp<GraphicsPipeline> ResourceProvider::findOrCreateGraphicsPipeline(
     return pipeline;
 }
 
+void ResourceProvider::createGraphicsPipelinesInParallel(
+        const RuntimeEffectDictionary* runtimeDict,
+        SkSpan<const GraphicsPipelineRequest> requests,
+        SkExecutor* executor) {
+    GlobalCache* globalCache = fSharedContext->globalCache();
+    const Caps* caps = fSharedContext->caps();
+    if (!executor) {
+        executor = caps->pipelineCompileExecutor();
+    }
+    if (!executor || requests.size() < 2) {
+        return;
+    }
+    TRACE_EVENT0("skia.shaders", TRACE_FUNC);
+
+    // Only the pipelines that are missing (and distinct) are worth handing to other threads.
+    skia_private::TArray<GraphicsPipelineRequest> misses;
+    skia_private::TArray<UniqueKey> missKeys;
+    for (const GraphicsPipelineRequest& request : requests) {
+        UniqueKey key = caps->makeGraphicsPipelineKey(*request.fPipelineDesc,
+                                                      *request.fRenderPassDesc);
+        if (std::find(missKeys.begin(), missKeys.end(), key) != missKeys.end() ||
+            globalCache->findGraphicsPipeline(key)) {
+            continue;
+        }
+        misses.push_back(request);
+        missKeys.push_back(std::move(key));
+    }
+    if (misses.size() < 2) {
+        // Not worth the overhead; the caller will create it inline.
+        return;
+    }
+
+    static constexpr int kPipelinesPerBatch = 4;
+    const int batchCount = (misses.size() + kPipelinesPerBatch - 1) / kPipelinesPerBatch;
+    // ResourceProviders are made on this thread, and each is used by only one batch.
+    std::vector<std::unique_ptr<SingleOwner>> owners(batchCount);
+    std::vector<std::unique_ptr<ResourceProvider>> providers(batchCount);
+    for (int i = 0; i < batchCount; ++i) {
+        owners[i] = std::make_unique<SingleOwner>();
+        providers[i] = fSharedContext->makeResourceProvider(owners[i].get(),
+                                                            SK_InvalidGenID,
+                                                            /* resourceBudget= */ 0);
+    }
+
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(batchCount, [&](int i) {
+        const int end = std::min((i + 1) * kPipelinesPerBatch, misses.size());
+        for (int j = i * kPipelinesPerBatch; j < end; ++j) {
+            providers[i]->findOrCreateGraphicsPipeline(runtimeDict,
+                                                       *misses[j].fPipelineDesc,
+                                                       *misses[j].fRenderPassDesc);
+        }
+    });
+    taskGroup.wait();
+}
+
 sk_sp<ComputePipeline> ResourceProvider::findOrCreateComputePipeline(
         const ComputePipelineDesc& pipelineDesc) {
     auto globalCache = fSharedContext->globalCache();
@@ -17,6 +17,7 @@
 #include "src/gpu/graphite/ResourceTypes.h"
 
 struct AHardwareBuffer;
+class SkExecutor;
 struct SkSamplingOptions;
 class SkTraceMemoryDump;
 
@@ -47,6 +48,12 @@ class SharedContext;
 class Texture;
 class TextureInfo;
 
+/**
+ * ResourceProvider and its ResourceCache are not thread safe. A Recorder's provider is only used
+ * on the thread that owns the Recorder, including while snap() prepares the tasks of a Recording.
+ * Work that is handed to other threads, like createGraphicsPipelinesInParallel(), uses its own
+ * temporary providers and shares results through the thread safe GlobalCache.
+ */
 class ResourceProvider {
 public:
     virtual ~ResourceProvider();
@@ -57,6 +64,21 @@ public:
                                                          const GraphicsPipelineDesc&,
                                                          const RenderPassDesc&);
 
+    struct GraphicsPipelineRequest {
+        const GraphicsPipelineDesc* fPipelineDesc;
+        const RenderPassDesc* fRenderPassDesc;
+    };
+    // Creates the requested pipelines that aren't in the GlobalCache yet, in parallel on
+    // `executor`, and blocks until they are done. If `executor` is null, the Context's
+    // pipeline compile executor is used, and if it has none this does nothing. Each batch of
+    // pipelines is created with its own temporary ResourceProvider so that batches don't share a
+    // ResourceCache; the results are published to the GlobalCache, where
+    // findOrCreateGraphicsPipeline() will then find them. Pipelines that fail to compile are left
+    // for findOrCreateGraphicsPipeline() to report.
+    void createGraphicsPipelinesInParallel(const RuntimeEffectDictionary*,
+                                           SkSpan<const GraphicsPipelineRequest>,
+                                           SkExecutor* executor = nullptr);
+
     sk_sp<ComputePipeline> findOrCreateComputePipeline(const ComputePipelineDesc&);
 
     sk_sp<Texture> findOrCreateScratchTexture(SkISize,
@@ -85,6 +107,9 @@ public:
     ProxyCache* proxyCache() { return fResourceCache->proxyCache(); }
 
     size_t getResourceCacheLimit() const { return fResourceCache->getMaxBudget(); }
+    void setResourceCacheOverBudgetPurgeLimit(size_t bytes) {
+        fResourceCache->setOverBudgetPurgeLimit(bytes);
+    }
     size_t getResourceCacheCurrentBudgetedBytes() const {
         return fResourceCache->currentBudgetedBytes();
     }
@@ -71,6 +71,9 @@ private:
  * Once all uninstantiated resources are assigned and prepareResources() succeeds, the
  * ScratchResourceManager can be discarded. The reuse within a Recording's task graph is fixed at
  * that point and remains valid even if the recording is replayed.
+ *
+ * Since reuse depends on the order in which tasks are prepared, the ScratchResourceManager is not
+ * thread safe and tasks must be prepared one at a time, in the task graph's order.
  */
 class ScratchResourceManager {
 public:
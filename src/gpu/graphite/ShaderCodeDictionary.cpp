@@ -773,6 +773,45 @@ std::string GenerateClipShaderPreamble(const ShaderInfo& shaderInfo, const Shade
     return "";
 }
 
+//--------------------------------------------------------------------------------------------------
+static constexpr Uniform kAnalyticClipUniforms[] = {
+        { "rect",     SkSLType::kFloat4 },
+        { "radius",   SkSLType::kFloat },
+        { "inverted", SkSLType::kFloat },
+};
+
+std::string GenerateAnalyticClipExpression(const ShaderInfo& shaderInfo,
+                                           const ShaderNode* node,
+                                           const ShaderSnippet::Args& args) {
+    const ShaderSnippet* entry = node->entry();
+    std::string helperFnName = get_mangled_name(entry->fStaticFunctionName, node->keyIndex());
+    std::string code = SkSL::String::printf("%s(%.*s", helperFnName.c_str(),
+                                            (int)args.fFragCoord.size(), args.fFragCoord.data());
+    for (const Uniform& u : entry->fUniforms) {
+        code += ", ";
+        code += get_mangled_uniform_name(shaderInfo, u, node->keyIndex());
+    }
+    code.push_back(')');
+    return code;
+}
+
+std::string GenerateAnalyticClipPreamble(const ShaderInfo& shaderInfo, const ShaderNode* node) {
+    std::string helperFnName =
+            get_mangled_name(node->entry()->fStaticFunctionName, node->keyIndex());
+
+    // The coverage is the signed distance to the rounded rect, evaluated at the pixel center and
+    // anti-aliased over one pixel. Plain rects have a radius of zero.
+    return SkSL::String::printf(
+            "half4 %s(float2 pos, float4 rect, float radius, float inverted) {"
+                "float2 q = abs(pos - 0.5 * (rect.xy + rect.zw)) - 0.5 * (rect.zw - rect.xy) + "
+                           "radius;"
+                "float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;"
+                "half coverage = half(saturate(0.5 - d));"
+                "return half4(mix(coverage, 1 - coverage, half(inverted)));"
+            "}",
+            helperFnName.c_str());
+}
+
 //--------------------------------------------------------------------------------------------------
 static constexpr int kFourStopGradient = 4;
 static constexpr int kEightStopGradient = 8;
@@ -2228,6 +2267,16 @@ ShaderCodeDictionary::ShaderCodeDictionary() {
             GenerateClipShaderPreamble,
             kNumClipShaderChildren
     };
+    fBuiltInCodeSnippets[(int) BuiltInCodeSnippetID::kAnalyticClip] = {
+            "AnalyticClip",
+            SkSpan(kAnalyticClipUniforms),
+            SnippetRequirementFlags::kNone,
+            { },     // no samplers
+            "AnalyticClip",
+            GenerateAnalyticClipExpression,
+            GenerateAnalyticClipPreamble,
+            kNoChildren
+    };
 
     fBuiltInCodeSnippets[(int) BuiltInCodeSnippetID::kCompose] = {
             "Compose",
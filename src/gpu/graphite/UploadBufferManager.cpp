@@ -47,8 +47,12 @@ std::tuple<void*/*mappedPtr*/, BindBufferInfo> UploadBufferManager::makeBindInfo
     requiredAlignment = std::max(requiredAlignment, fMinAlignment);
     requiredBytes = SkAlignTo(requiredBytes, requiredAlignment);
     if (requiredBytes > kReusedBufferSize) {
-        // Create a dedicated buffer for this request.
-        sk_sp<Buffer> buffer = fResourceProvider->findOrCreateBuffer(requiredBytes,
+        // Create a dedicated buffer for this request. Its size is kept in multiples of
+        // kReusedBufferSize so that uploads of similar sizes in later Recordings find it in the
+        // ResourceCache once the command buffers that read it have finished, instead of each
+        // creating a buffer of their exact size.
+        size_t bufferSize = SkAlignTo(requiredBytes, kReusedBufferSize);
+        sk_sp<Buffer> buffer = fResourceProvider->findOrCreateBuffer(bufferSize,
                                                                      BufferType::kXferCpuToGpu,
                                                                      AccessPattern::kHostVisible,
                                                                      std::move(label));
@@ -72,6 +72,7 @@ void DawnCommandBuffer::onResetCommandBuffer() {
     fIntrinsicConstantBuffer = nullptr;
 
     fActiveGraphicsPipeline = nullptr;
+    fBoundTextureBindGroup = nullptr;
     fActiveRenderPassEncoder = nullptr;
     fActiveComputePassEncoder = nullptr;
     fCommandEncoder = nullptr;
@@ -398,6 +399,9 @@ void DawnCommandBuffer::endRenderPass() {
     SkASSERT(fActiveRenderPassEncoder);
     fActiveRenderPassEncoder.End();
     fActiveRenderPassEncoder = nullptr;
+    // Pipelines and bind groups are set per render pass.
+    fActiveGraphicsPipeline = nullptr;
+    fBoundTextureBindGroup = nullptr;
 }
 
 bool DawnCommandBuffer::addDrawPass(const DrawPass* drawPass) {
@@ -491,6 +495,11 @@ bool DawnCommandBuffer::bindGraphicsPipeline(const GraphicsPipeline* graphicsPip
     if (!wgpuPipeline) SK_UNLIKELY {
         return false;
     }
+    if (dawnGraphicsPipeline == fActiveGraphicsPipeline) {
+        // Setting the same pipeline again changes nothing, including the uniform bind group it
+        // needs.
+        return true;
+    }
     fActiveGraphicsPipeline = dawnGraphicsPipeline;
     fActiveRenderPassEncoder.SetPipeline(wgpuPipeline);
     fBoundUniformBuffersDirty = true;
@@ -560,49 +569,25 @@ void DawnCommandBuffer::bindTextureAndSamplers(
     SkASSERT(fActiveRenderPassEncoder);
     SkASSERT(fActiveGraphicsPipeline);
 
-    wgpu::BindGroup bindGroup;
-    if (command.fNumTexSamplers == 1) {
-        // Optimize for single texture.
-        SkASSERT(fActiveGraphicsPipeline->numTexturesAndSamplers() == 2);
-
-        const auto* texture =
-                static_cast<const DawnTexture*>(drawPass.getTexture(command.fTextureIndices[0]));
-        const auto* sampler =
-                static_cast<const DawnSampler*>(drawPass.getSampler(command.fSamplerIndices[0]));
-
-        bindGroup = fResourceProvider->findOrCreateSingleTextureSamplerBindGroup(sampler, texture);
-    } else {
-        std::vector<wgpu::BindGroupEntry> entries(2 * command.fNumTexSamplers);
-
-        for (int i = 0; i < command.fNumTexSamplers; ++i) {
-            const auto* texture = static_cast<const DawnTexture*>(
-                    drawPass.getTexture(command.fTextureIndices[i]));
-            const auto* sampler = static_cast<const DawnSampler*>(
-                    drawPass.getSampler(command.fSamplerIndices[i]));
-            auto& wgpuTextureView = texture->sampleTextureView();
-            auto& wgpuSampler = sampler->dawnSampler();
-
-            // Assuming shader generator assigns binding slot to sampler then texture,
-            // then the next sampler and texture, and so on, we need to use
-            // 2 * i as base binding index of the sampler and texture.
-            // TODO: https://b.corp.google.com/issues/259457090:
-            // Better configurable way of assigning samplers and textures' bindings.
-            entries[2 * i].binding = 2 * i;
-            entries[2 * i].sampler = wgpuSampler;
-
-            entries[2 * i + 1].binding = 2 * i + 1;
-            entries[2 * i + 1].textureView = wgpuTextureView;
-        }
+    SkASSERT(fActiveGraphicsPipeline->numTexturesAndSamplers() == 2 * command.fNumTexSamplers);
 
-        wgpu::BindGroupDescriptor desc;
-        const auto& groupLayouts = fActiveGraphicsPipeline->dawnGroupLayouts();
-        desc.layout = groupLayouts[DawnGraphicsPipeline::kTextureBindGroupIndex];
-        desc.entryCount = entries.size();
-        desc.entries = entries.data();
-
-        bindGroup = fSharedContext->device().CreateBindGroup(&desc);
+    skia_private::STArray<1, const DawnSampler*> samplers(command.fNumTexSamplers);
+    skia_private::STArray<1, const DawnTexture*> textures(command.fNumTexSamplers);
+    for (int i = 0; i < command.fNumTexSamplers; ++i) {
+        samplers.push_back(
+                static_cast<const DawnSampler*>(drawPass.getSampler(command.fSamplerIndices[i])));
+        textures.push_back(
+                static_cast<const DawnTexture*>(drawPass.getTexture(command.fTextureIndices[i])));
     }
 
+    const wgpu::BindGroup& bindGroup =
+            fResourceProvider->findOrCreateTextureSamplerBindGroup(samplers, textures);
+    // Consecutive draws often read the same textures, and bind groups stay bound across pipeline
+    // changes since all pipelines with the same number of textures share a layout.
+    if (bindGroup.Get() == fBoundTextureBindGroup.Get()) {
+        return;
+    }
+    fBoundTextureBindGroup = bindGroup;
     fActiveRenderPassEncoder.SetBindGroup(DawnGraphicsPipeline::kTextureBindGroupIndex, bindGroup);
 }
 
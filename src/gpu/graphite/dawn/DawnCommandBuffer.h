@@ -154,6 +154,8 @@ private:
     int fIntrinsicConstantBufferSlotsUsed = 0;
 
     const DawnGraphicsPipeline* fActiveGraphicsPipeline = nullptr;
+    // The texture bind group set in the active render pass, to skip setting it again.
+    wgpu::BindGroup fBoundTextureBindGroup;
     const DawnComputePipeline* fActiveComputePipeline = nullptr;
     const DawnSharedContext* fSharedContext;
     DawnResourceProvider* fResourceProvider;
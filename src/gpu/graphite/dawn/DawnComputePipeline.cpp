@@ -54,13 +54,14 @@ static ShaderInfo compile_shader_module(const DawnSharedContext* sharedContext,
         SkSL::ProgramSettings settings;
 
         std::string sksl = BuildComputeSkSL(caps, step);
-        if (skgpu::SkSLToWGSL(caps->shaderCaps(),
-                              sksl,
-                              SkSL::ProgramKind::kCompute,
-                              settings,
-                              &wgsl,
-                              &interface,
-                              errorHandler)) {
+        if (SkSLToBackendCached(caps,
+                                &skgpu::SkSLToWGSL,
+                                "WGSL",
+                                sksl,
+                                SkSL::ProgramKind::kCompute,
+                                settings,
+                                &wgsl,
+                                &interface)) {
             if (!DawnCompileWGSLShaderModule(sharedContext, step->name(), wgsl,
                                              &info.fModule, errorHandler)) {
                 return {};
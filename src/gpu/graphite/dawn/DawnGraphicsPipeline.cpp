@@ -295,13 +295,14 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
 
     bool hasFragmentSkSL = !fsSkSL.empty();
     if (hasFragmentSkSL) {
-        if (!skgpu::SkSLToWGSL(caps.shaderCaps(),
-                               fsSkSL,
-                               SkSL::ProgramKind::kGraphiteFragment,
-                               settings,
-                               &fsCode,
-                               &fsInterface,
-                               errorHandler)) {
+        if (!SkSLToBackendCached(&caps,
+                                 &skgpu::SkSLToWGSL,
+                                 "WGSL",
+                                 fsSkSL,
+                                 SkSL::ProgramKind::kGraphiteFragment,
+                                 settings,
+                                 &fsCode,
+                                 &fsInterface)) {
             return {};
         }
         if (!DawnCompileWGSLShaderModule(sharedContext, fsSkSLInfo.fLabel.c_str(), fsCode,
@@ -315,13 +316,14 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
                                               useStorageBuffers,
                                               localCoordsNeeded);
     const std::string& vsSkSL = vsSkSLInfo.fSkSL;
-    if (!skgpu::SkSLToWGSL(caps.shaderCaps(),
-                           vsSkSL,
-                           SkSL::ProgramKind::kGraphiteVertex,
-                           settings,
-                           &vsCode,
-                           &vsInterface,
-                           errorHandler)) {
+    if (!SkSLToBackendCached(&caps,
+                             &skgpu::SkSLToWGSL,
+                             "WGSL",
+                             vsSkSL,
+                             SkSL::ProgramKind::kGraphiteVertex,
+                             settings,
+                             &vsCode,
+                             &vsInterface)) {
         return {};
     }
     if (!DawnCompileWGSLShaderModule(sharedContext, vsSkSLInfo.fLabel.c_str(), vsCode,
@@ -419,33 +421,8 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
 
         bool hasFragmentSamplers = hasFragmentSkSL && numTexturesAndSamplers > 0;
         if (hasFragmentSamplers) {
-            if (numTexturesAndSamplers == 2) {
-                // Common case: single texture + sampler.
-                groupLayouts[1] =
-                        resourceProvider->getOrCreateSingleTextureSamplerBindGroupLayout();
-            } else {
-                std::vector<wgpu::BindGroupLayoutEntry> entries(numTexturesAndSamplers);
-                for (int i = 0; i < numTexturesAndSamplers;) {
-                    entries[i].binding = static_cast<uint32_t>(i);
-                    entries[i].visibility = wgpu::ShaderStage::Fragment;
-                    entries[i].sampler.type = wgpu::SamplerBindingType::Filtering;
-                    ++i;
-                    entries[i].binding = i;
-                    entries[i].visibility = wgpu::ShaderStage::Fragment;
-                    entries[i].texture.sampleType = wgpu::TextureSampleType::Float;
-                    entries[i].texture.viewDimension = wgpu::TextureViewDimension::e2D;
-                    entries[i].texture.multisampled = false;
-                    ++i;
-                }
-
-                wgpu::BindGroupLayoutDescriptor groupLayoutDesc;
-                if (sharedContext->caps()->setBackendLabels()) {
-                    groupLayoutDesc.label = vsSkSLInfo.fLabel.c_str();
-                }
-                groupLayoutDesc.entryCount = entries.size();
-                groupLayoutDesc.entries = entries.data();
-                groupLayouts[1] = device.CreateBindGroupLayout(&groupLayoutDesc);
-            }
+            groupLayouts[1] = resourceProvider->getOrCreateTextureSamplerBindGroupLayout(
+                    numTexturesAndSamplers);
             if (!groupLayouts[1]) {
                 return {};
             }
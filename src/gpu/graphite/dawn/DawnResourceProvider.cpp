@@ -21,6 +21,8 @@
 #include "src/gpu/graphite/dawn/DawnTexture.h"
 #include "src/sksl/SkSLCompiler.h"
 
+#include <vector>
+
 namespace skgpu::graphite {
 
 namespace {
@@ -147,6 +149,28 @@ UniqueKey make_texture_bind_group_key(const DawnSampler* sampler, const DawnText
 
     return uniqueKey;
 }
+
+UniqueKey make_texture_sampler_bind_group_key(SkSpan<const DawnSampler*> samplers,
+                                              SkSpan<const DawnTexture*> textures) {
+    static const UniqueKey::Domain kTexturesBindGroupDomain = UniqueKey::GenerateDomain();
+
+    UniqueKey uniqueKey;
+    {
+        UniqueKey::Builder builder(&uniqueKey,
+                                   kTexturesBindGroupDomain,
+                                   2 * samplers.size(),
+                                   "GraphicsPipelineTextureSamplerBindGroup");
+
+        for (size_t i = 0; i < samplers.size(); ++i) {
+            builder[2 * i] = samplers[i]->uniqueID().asUInt();
+            builder[2 * i + 1] = textures[i]->uniqueID().asUInt();
+        }
+
+        builder.finish();
+    }
+
+    return uniqueKey;
+}
 }  // namespace
 
 DawnResourceProvider::DawnResourceProvider(SharedContext* sharedContext,
@@ -155,7 +179,8 @@ DawnResourceProvider::DawnResourceProvider(SharedContext* sharedContext,
                                            size_t resourceBudget)
         : ResourceProvider(sharedContext, singleOwner, recorderID, resourceBudget)
         , fUniformBufferBindGroupCache(kMaxNumberOfCachedBufferBindGroups)
-        , fSingleTextureSamplerBindGroups(kMaxNumberOfCachedTextureBindGroups) {}
+        , fSingleTextureSamplerBindGroups(kMaxNumberOfCachedTextureBindGroups)
+        , fTextureSamplerBindGroups(kMaxNumberOfCachedTextureBindGroups) {}
 
 DawnResourceProvider::~DawnResourceProvider() = default;
 
@@ -421,6 +446,43 @@ DawnResourceProvider::getOrCreateSingleTextureSamplerBindGroupLayout() {
     return fSingleTextureSamplerBindGroupLayout;
 }
 
+const wgpu::BindGroupLayout& DawnResourceProvider::getOrCreateTextureSamplerBindGroupLayout(
+        int numTexturesAndSamplers) {
+    SkASSERT(numTexturesAndSamplers > 0 && numTexturesAndSamplers % 2 == 0);
+    if (numTexturesAndSamplers == 2) {
+        return this->getOrCreateSingleTextureSamplerBindGroupLayout();
+    }
+    if (const wgpu::BindGroupLayout* layout =
+                fTextureSamplerBindGroupLayouts.find(numTexturesAndSamplers)) {
+        return *layout;
+    }
+
+    std::vector<wgpu::BindGroupLayoutEntry> entries(numTexturesAndSamplers);
+    for (int i = 0; i < numTexturesAndSamplers;) {
+        entries[i].binding = static_cast<uint32_t>(i);
+        entries[i].visibility = wgpu::ShaderStage::Fragment;
+        entries[i].sampler.type = wgpu::SamplerBindingType::Filtering;
+        ++i;
+        entries[i].binding = i;
+        entries[i].visibility = wgpu::ShaderStage::Fragment;
+        entries[i].texture.sampleType = wgpu::TextureSampleType::Float;
+        entries[i].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+        entries[i].texture.multisampled = false;
+        ++i;
+    }
+
+    wgpu::BindGroupLayoutDescriptor groupLayoutDesc;
+    if (fSharedContext->caps()->setBackendLabels()) {
+        groupLayoutDesc.label = "Textures + samplers bind group layout";
+    }
+
+    groupLayoutDesc.entryCount = entries.size();
+    groupLayoutDesc.entries = entries.data();
+    return *fTextureSamplerBindGroupLayouts.set(
+            numTexturesAndSamplers,
+            this->dawnSharedContext()->device().CreateBindGroupLayout(&groupLayoutDesc));
+}
+
 const wgpu::Buffer& DawnResourceProvider::getOrCreateNullBuffer() {
     if (!fNullBuffer) {
         wgpu::BufferDescriptor desc;
@@ -523,4 +585,41 @@ const wgpu::BindGroup& DawnResourceProvider::findOrCreateSingleTextureSamplerBin
     return *fSingleTextureSamplerBindGroups.insert(key, bindGroup);
 }
 
+const wgpu::BindGroup& DawnResourceProvider::findOrCreateTextureSamplerBindGroup(
+        SkSpan<const DawnSampler*> samplers, SkSpan<const DawnTexture*> textures) {
+    SkASSERT(samplers.size() == textures.size());
+    if (samplers.size() == 1) {
+        return this->findOrCreateSingleTextureSamplerBindGroup(samplers[0], textures[0]);
+    }
+
+    auto key = make_texture_sampler_bind_group_key(samplers, textures);
+    auto* existingBindGroup = fTextureSamplerBindGroups.find(key);
+    if (existingBindGroup) {
+        // cache hit.
+        return *existingBindGroup;
+    }
+
+    std::vector<wgpu::BindGroupEntry> entries(2 * samplers.size());
+    for (size_t i = 0; i < samplers.size(); ++i) {
+        // The shader generator assigns the binding slot of each sampler followed by its texture.
+        // TODO: https://b.corp.google.com/issues/259457090:
+        // Better configurable way of assigning samplers and textures' bindings.
+        entries[2 * i].binding = 2 * i;
+        entries[2 * i].sampler = samplers[i]->dawnSampler();
+
+        entries[2 * i + 1].binding = 2 * i + 1;
+        entries[2 * i + 1].textureView = textures[i]->sampleTextureView();
+    }
+
+    wgpu::BindGroupDescriptor desc;
+    desc.layout = this->getOrCreateTextureSamplerBindGroupLayout(entries.size());
+    desc.entryCount = entries.size();
+    desc.entries = entries.data();
+
+    const auto& device = this->dawnSharedContext()->device();
+    auto bindGroup = device.CreateBindGroup(&desc);
+
+    return *fTextureSamplerBindGroups.insert(key, bindGroup);
+}
+
 } // namespace skgpu::graphite
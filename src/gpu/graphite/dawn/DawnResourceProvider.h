@@ -8,6 +8,7 @@
 #ifndef skgpu_graphite_DawnResourceProvider_DEFINED
 #define skgpu_graphite_DawnResourceProvider_DEFINED
 
+#include "include/core/SkSpan.h"
 #include "include/gpu/graphite/dawn/DawnTypes.h"
 #include "src/core/SkLRUCache.h"
 #include "src/core/SkTHash.h"
@@ -41,6 +42,10 @@ public:
 
     const wgpu::BindGroupLayout& getOrCreateUniformBuffersBindGroupLayout();
     const wgpu::BindGroupLayout& getOrCreateSingleTextureSamplerBindGroupLayout();
+    // Layouts with alternating sampler and texture bindings are shared by all pipelines with the
+    // same number of them, so that their bind groups can be cached independently of the pipeline.
+    const wgpu::BindGroupLayout& getOrCreateTextureSamplerBindGroupLayout(
+            int numTexturesAndSamplers);
 
     // Find the cached bind group or create a new one based on the bound buffers and their
     // binding sizes (boundBuffersAndSizes) for these uniforms (in order):
@@ -54,6 +59,11 @@ public:
     const wgpu::BindGroup& findOrCreateSingleTextureSamplerBindGroup(const DawnSampler* sampler,
                                                                      const DawnTexture* texture);
 
+    // Find or create a bind group containing the given samplers & textures, with the sampler and
+    // texture of each pair at consecutive bindings.
+    const wgpu::BindGroup& findOrCreateTextureSamplerBindGroup(
+            SkSpan<const DawnSampler*> samplers, SkSpan<const DawnTexture*> textures);
+
     const sk_sp<DawnBuffer>& getOrCreateIntrinsicConstantBuffer();
 
 private:
@@ -80,6 +90,7 @@ private:
 
     wgpu::BindGroupLayout fUniformBuffersBindGroupLayout;
     wgpu::BindGroupLayout fSingleTextureSamplerBindGroupLayout;
+    skia_private::THashMap<int, wgpu::BindGroupLayout> fTextureSamplerBindGroupLayouts;
 
     wgpu::Buffer fNullBuffer;
 
@@ -93,6 +104,7 @@ private:
 
     BindGroupCache fUniformBufferBindGroupCache;
     BindGroupCache fSingleTextureSamplerBindGroups;
+    BindGroupCache fTextureSamplerBindGroups;
 };
 
 } // namespace skgpu::graphite
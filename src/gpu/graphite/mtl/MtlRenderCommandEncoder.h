@@ -12,6 +12,8 @@
 #include "include/ports/SkCFObject.h"
 #include "src/gpu/graphite/Resource.h"
 
+#include <cstring>
+
 #import <Metal/Metal.h>
 
 namespace skgpu::graphite {
@@ -66,11 +68,22 @@ public:
     }
 
     void setFrontFacingWinding(MTLWinding winding) {
-        [(*fCommandEncoder) setFrontFacingWinding:winding];
+        if (fCurrentWinding != winding) {
+            [(*fCommandEncoder) setFrontFacingWinding:winding];
+            fCurrentWinding = winding;
+        }
     }
 
     void setViewport(const MTLViewport& viewport) {
-        [(*fCommandEncoder) setViewport:viewport];
+        if (fCurrentViewport.originX != viewport.originX ||
+            fCurrentViewport.originY != viewport.originY ||
+            fCurrentViewport.width != viewport.width ||
+            fCurrentViewport.height != viewport.height ||
+            fCurrentViewport.znear != viewport.znear ||
+            fCurrentViewport.zfar != viewport.zfar) {
+            [(*fCommandEncoder) setViewport:viewport];
+            fCurrentViewport = viewport;
+        }
     }
 
     void setVertexBuffer(id<MTLBuffer> buffer, NSUInteger offset, NSUInteger index) {
@@ -132,12 +145,19 @@ public:
         [(*fCommandEncoder) setVertexBytes:bytes
                                     length:length
                                    atIndex:index];
+        // The bytes replace any buffer bound at this index.
+        if (index < kMaxExpectedBuffers) {
+            fCurrentVertexBuffer[index] = nil;
+        }
     }
     void setFragmentBytes(const void* bytes, NSUInteger length, NSUInteger index)
             SK_API_AVAILABLE(macos(10.11), ios(8.3), tvos(9.0)) {
         [(*fCommandEncoder) setFragmentBytes:bytes
                                       length:length
                                      atIndex:index];
+        if (index < kMaxExpectedBuffers) {
+            fCurrentFragmentBuffer[index] = nil;
+        }
     }
 
     void setFragmentTexture(id<MTLTexture> texture, NSUInteger index) {
@@ -158,10 +178,13 @@ public:
     }
 
     void setBlendColor(float blendConst[4]) {
-        [(*fCommandEncoder) setBlendColorRed: blendConst[0]
-                                       green: blendConst[1]
-                                        blue: blendConst[2]
-                                       alpha: blendConst[3]];
+        if (memcmp(fCurrentBlendColor, blendConst, sizeof(fCurrentBlendColor)) != 0) {
+            [(*fCommandEncoder) setBlendColorRed: blendConst[0]
+                                           green: blendConst[1]
+                                            blue: blendConst[2]
+                                           alpha: blendConst[3]];
+            memcpy(fCurrentBlendColor, blendConst, sizeof(fCurrentBlendColor));
+        }
     }
 
     void setStencilReferenceValue(uint32_t referenceValue) {
@@ -299,6 +322,10 @@ private:
 
     MTLScissorRect fCurrentScissorRect = { 0, 0, 0, 0 };
     MTLTriangleFillMode fCurrentTriangleFillMode = (MTLTriangleFillMode)-1;
+    MTLWinding fCurrentWinding = (MTLWinding)-1;
+    // The viewport has no default until set, so this starts with an impossible width.
+    MTLViewport fCurrentViewport = { 0, 0, -1, -1, 0, 0 };
+    float fCurrentBlendColor[4] = { 0, 0, 0, 0 }; // Metal default value
 };
 
 } // namespace skgpu::graphite
@@ -137,13 +137,14 @@ sk_sp<GraphicsPipeline> MtlResourceProvider::createGraphicsPipeline(
     std::string& fsSkSL = fsSkSLInfo.fSkSL;
     const BlendInfo& blendInfo = fsSkSLInfo.fBlendInfo;
     const bool localCoordsNeeded = fsSkSLInfo.fRequiresLocalCoords;
-    if (!SkSLToMSL(fSharedContext->caps()->shaderCaps(),
-                   fsSkSL,
-                   SkSL::ProgramKind::kGraphiteFragment,
-                   settings,
-                   &fsMSL,
-                   &fsInterface,
-                   errorHandler)) {
+    if (!SkSLToBackendCached(fSharedContext->caps(),
+                             &SkSLToMSL,
+                             "MSL",
+                             fsSkSL,
+                             SkSL::ProgramKind::kGraphiteFragment,
+                             settings,
+                             &fsMSL,
+                             &fsInterface)) {
         return nullptr;
     }
 
@@ -152,13 +153,14 @@ sk_sp<GraphicsPipeline> MtlResourceProvider::createGraphicsPipeline(
                                               useStorageBuffers,
                                               localCoordsNeeded);
     const std::string& vsSkSL = vsSkSLInfo.fSkSL;
-    if (!SkSLToMSL(fSharedContext->caps()->shaderCaps(),
-                   vsSkSL,
-                   SkSL::ProgramKind::kGraphiteVertex,
-                   settings,
-                   &vsMSL,
-                   &vsInterface,
-                   errorHandler)) {
+    if (!SkSLToBackendCached(fSharedContext->caps(),
+                             &SkSLToMSL,
+                             "MSL",
+                             vsSkSL,
+                             SkSL::ProgramKind::kGraphiteVertex,
+                             settings,
+                             &vsMSL,
+                             &vsInterface)) {
         return nullptr;
     }
 
@@ -219,13 +221,14 @@ sk_sp<ComputePipeline> MtlResourceProvider::createComputePipeline(
 
         SkSL::Compiler skslCompiler;
         std::string sksl = BuildComputeSkSL(fSharedContext->caps(), pipelineDesc.computeStep());
-        if (!SkSLToMSL(fSharedContext->caps()->shaderCaps(),
-                       sksl,
-                       SkSL::ProgramKind::kCompute,
-                       settings,
-                       &msl,
-                       &interface,
-                       errorHandler)) {
+        if (!SkSLToBackendCached(fSharedContext->caps(),
+                                 &SkSLToMSL,
+                                 "MSL",
+                                 sksl,
+                                 SkSL::ProgramKind::kCompute,
+                                 settings,
+                                 &msl,
+                                 &interface)) {
             return nullptr;
         }
         library = MtlCompileShaderLibrary(this->mtlSharedContext(),
@@ -139,14 +139,40 @@ void TessellateCurvesRenderStep::writeVertices(DrawWriter* dw,
     // provide a templated WritePatches function, the iterator could also be a template arg in
     // addition to PatchWriter's traits. Whatever pattern we choose will be based more on what's
     // best for the wedge and stroke case, which have more complex loops.
+    //
+    // Consecutive quads or cubics share their end points in the path's point array, so each run of
+    // them is written as a strip, which evaluates Wang's formula for several curves at once.
+    SkPathVerb stripVerb = SkPathVerb::kMove;
+    const SkPoint* stripPts = nullptr;
+    int stripCount = 0;
+    auto writeStrip = [&]() {
+        if (stripCount > 0) {
+            if (stripVerb == SkPathVerb::kQuad) {
+                writer.writeQuadraticStrip(stripPts, stripCount);
+            } else {
+                writer.writeCubicStrip(stripPts, stripCount);
+            }
+            stripCount = 0;
+        }
+    };
     for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
-        switch (verb) {
-            case SkPathVerb::kQuad:  writer.writeQuadratic(pts); break;
-            case SkPathVerb::kConic: writer.writeConic(pts, *w); break;
-            case SkPathVerb::kCubic: writer.writeCubic(pts);     break;
-            default:                                             break;
+        if (verb == SkPathVerb::kQuad || verb == SkPathVerb::kCubic) {
+            const int ptsPerCurve = verb == SkPathVerb::kQuad ? 2 : 3;
+            if (stripCount == 0 || verb != stripVerb ||
+                pts != stripPts + stripCount * ptsPerCurve) {
+                writeStrip();
+                stripVerb = verb;
+                stripPts = pts;
+            }
+            ++stripCount;
+            continue;
+        }
+        writeStrip();
+        if (verb == SkPathVerb::kConic) {
+            writer.writeConic(pts, *w);
         }
     }
+    writeStrip();
 }
 
 void TessellateCurvesRenderStep::writeUniformsAndTextures(const DrawParams& params,
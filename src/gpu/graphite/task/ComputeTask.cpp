@@ -49,6 +49,14 @@ Task::Status ComputeTask::prepareResources(ResourceProvider* provider,
     return Status::kSuccess;
 }
 
+void ComputeTask::visitPipelines(const PipelineVisitor& visitor) const {
+    for (const auto& child : fChildTasks) {
+        if (child) {
+            child->visitPipelines(visitor);
+        }
+    }
+}
+
 Task::Status ComputeTask::addCommands(Context* ctx,
                                       CommandBuffer* commandBuffer,
                                       ReplayTargetData rtd) {
@@ -36,6 +36,8 @@ public:
                             const RuntimeEffectDictionary*) override;
     Status addCommands(Context*, CommandBuffer*, ReplayTargetData) override;
 
+    void visitPipelines(const PipelineVisitor&) const override;
+
 private:
     explicit ComputeTask(DispatchGroupList dispatchGroups);
 
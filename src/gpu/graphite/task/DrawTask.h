@@ -32,6 +32,10 @@ public:
 
     Status addCommands(Context*, CommandBuffer*, ReplayTargetData) override;
 
+    void visitPipelines(const PipelineVisitor& visitor) const override {
+        fChildTasks.visitPipelines(visitor);
+    }
+
 private:
     friend class DrawContext; // for "addTask"
 
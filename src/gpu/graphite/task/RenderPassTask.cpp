@@ -76,6 +76,14 @@ Task::Status RenderPassTask::prepareResources(ResourceProvider* resourceProvider
     return Status::kSuccess;
 }
 
+void RenderPassTask::visitPipelines(const PipelineVisitor& visitor) const {
+    for (const auto& drawPass : fDrawPasses) {
+        for (const GraphicsPipelineDesc& pipelineDesc : drawPass->pipelineDescs()) {
+            visitor(pipelineDesc, fRenderPassDesc);
+        }
+    }
+}
+
 Task::Status RenderPassTask::addCommands(Context* context,
                                          CommandBuffer* commandBuffer,
                                          ReplayTargetData replayData) {
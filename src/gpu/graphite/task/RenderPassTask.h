@@ -39,6 +39,8 @@ public:
 
     Status addCommands(Context*, CommandBuffer*, ReplayTargetData) override;
 
+    void visitPipelines(const PipelineVisitor&) const override;
+
 private:
     RenderPassTask(DrawPassList, const RenderPassDesc&, sk_sp<TextureProxy> target);
 
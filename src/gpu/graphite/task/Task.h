@@ -11,13 +11,17 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
 
+#include <functional>
+
 namespace skgpu::graphite {
 
 class CommandBuffer;
 class Context;
+class GraphicsPipelineDesc;
 class ResourceProvider;
 class RuntimeEffectDictionary;
 class ScratchResourceManager;
+struct RenderPassDesc;
 class Texture;
 
 class Task : public SkRefCnt {
@@ -53,6 +57,13 @@ public:
 
     // Returns true on success; false on failure.
     virtual Status addCommands(Context*, CommandBuffer*, ReplayTargetData) = 0;
+
+    // Visits the graphics pipelines that prepareResources() will create, including those of any
+    // child tasks, so that they can be compiled in parallel before the tasks are prepared. The
+    // descs remain valid until prepareResources() is called.
+    using PipelineVisitor =
+            std::function<void(const GraphicsPipelineDesc&, const RenderPassDesc&)>;
+    virtual void visitPipelines(const PipelineVisitor&) const {}
 };
 
 } // namespace skgpu::graphite
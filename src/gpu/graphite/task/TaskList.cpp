@@ -47,6 +47,14 @@ Status TaskList::prepareResources(ResourceProvider* resourceProvider,
     return status;
 }
 
+void TaskList::visitPipelines(const Task::PipelineVisitor& visitor) const {
+    for (const sk_sp<Task>& task : fTasks) {
+        if (task) {
+            task->visitPipelines(visitor);
+        }
+    }
+}
+
 Status TaskList::addCommands(Context* context,
                              CommandBuffer* commandBuffer,
                              Task::ReplayTargetData replayData) {
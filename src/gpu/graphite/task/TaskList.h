@@ -38,6 +38,8 @@ public:
                                   const RuntimeEffectDictionary*);
     Task::Status addCommands(Context*, CommandBuffer*, Task::ReplayTargetData);
 
+    void visitPipelines(const Task::PipelineVisitor&) const;
+
 private:
     template <typename Fn> // (Task*)->Status
     Task::Status visitTasks(Fn);
@@ -9,10 +9,12 @@
 
 #include "include/core/SkColorSpace.h"
 #include "include/gpu/graphite/Recorder.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkMasks.h"
 #include "src/gpu/graphite/AtlasProvider.h"
+#include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/DrawAtlas.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/TextureProxy.h"
@@ -350,6 +352,17 @@ std::tuple<bool, int> GlyphVector::regenerateAtlasForGraphite(int begin,
 
         // Update the atlas information in the GrStrike.
         auto glyphs = fGlyphs.subspan(begin, end - begin);
+        if (SkExecutor* executor = recorder->priv().caps()->executor()) {
+            // Rasterize the glyphs that aren't in the atlas together, instead of one at a time
+            // below. A new strike can have thousands of them, e.g. for CJK text.
+            skia_private::STArray<64, SkPackedGlyphID> missing;
+            for (const Variant& variant : glyphs) {
+                if (!atlasManager->hasGlyph(maskFormat, variant.glyph)) {
+                    missing.push_back(variant.glyph->fPackedID);
+                }
+            }
+            metricsAndImages.prerasterize(missing, executor);
+        }
         int glyphsPlacedInAtlas = 0;
         bool success = true;
         for (const Variant& variant : glyphs) {
@@ -78,6 +78,12 @@ void VulkanCaps::init(const ContextOptions& contextOptions,
     fRequiredStorageBufferAlignment =  physDevProperties.limits.minStorageBufferOffsetAlignment;
     fRequiredTransferBufferAlignment = 4;
 
+    // With timestampComputeAndGraphics, every graphics and compute queue supports timestamps.
+    // Queries can't be used in protected command buffers.
+    fTimestampPeriod = physDevProperties.limits.timestampPeriod;
+    fTimestampQuerySupport = physDevProperties.limits.timestampComputeAndGraphics &&
+                             fTimestampPeriod > 0 && !fProtectedSupport;
+
     fResourceBindingReqs.fUniformBufferLayout = Layout::kStd140;
     // TODO(skia:14639): We cannot use std430 layout for SSBOs until SkSL gracefully handles
     // implicit array stride.
@@ -366,8 +372,14 @@ TextureInfo VulkanCaps::getDefaultDepthStencilTextureInfo(SkEnumBitMask<DepthSte
     info.fFlags = (isProtected == Protected::kYes) ? VK_IMAGE_CREATE_PROTECTED_BIT : 0;
     info.fFormat = format;
     info.fImageTiling = VK_IMAGE_TILING_OPTIMAL;
-    // TODO: Passing in a discardable flag to this method, and if true, add the TRANSIENT bit.
-    info.fImageUsageFlags = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    // Depth and stencil are always cleared at the start of a render pass and discarded at the end
+    // (see RenderPassDesc::Make()), so they never need backing memory on devices with lazily
+    // allocated memory.
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    if (fSupportsMemorylessAttachments) {
+        usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
+    info.fImageUsageFlags = usage;
     info.fSharingMode = VK_SHARING_MODE_EXCLUSIVE;
     info.fAspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 
@@ -94,6 +94,9 @@ public:
     }
     uint64_t maxUniformBufferRange() const { return fMaxUniformBufferRange; }
 
+    // The number of nanoseconds per increment of a timestamp query.
+    float timestampPeriod() const { return fTimestampPeriod; }
+
     const VkPhysicalDeviceMemoryProperties2& physicalDeviceMemoryProperties2() const {
         return fPhysicalDeviceMemoryProperties2;
     }
@@ -228,6 +231,7 @@ private:
 
     uint32_t fMaxVertexAttributes;
     uint64_t fMaxUniformBufferRange;
+    float fTimestampPeriod = 0;
     VkPhysicalDeviceMemoryProperties2 fPhysicalDeviceMemoryProperties2;
 
     // ColorTypeInfo struct for use w/ external formats.
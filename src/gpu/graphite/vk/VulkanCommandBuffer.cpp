@@ -106,6 +106,10 @@ VulkanCommandBuffer::~VulkanCommandBuffer() {
         VULKAN_CALL(fSharedContext->interface(),
                     DestroyFence(fSharedContext->device(), fSubmitFence, nullptr));
     }
+    if (VK_NULL_HANDLE != fTimestampQueryPool) {
+        VULKAN_CALL(fSharedContext->interface(),
+                    DestroyQueryPool(fSharedContext->device(), fTimestampQueryPool, nullptr));
+    }
     // This should delete any command buffers as well.
     VULKAN_CALL(fSharedContext->interface(),
                 DestroyCommandPool(fSharedContext->device(), fPool, nullptr));
@@ -423,6 +427,71 @@ bool VulkanCommandBuffer::onAddRenderPass(const RenderPassDesc& renderPassDesc,
     return true;
 }
 
+bool VulkanCommandBuffer::onWriteTimestamp(int index) {
+    SkASSERT(fActive);
+    if (index >= kMaxTimestampQueries) {
+        return false;
+    }
+    if (fTimestampQueryPool == VK_NULL_HANDLE) {
+        VkQueryPoolCreateInfo createInfo;
+        memset(&createInfo, 0, sizeof(VkQueryPoolCreateInfo));
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = kMaxTimestampQueries;
+        VkResult result;
+        VULKAN_CALL_RESULT(fSharedContext,
+                           result,
+                           CreateQueryPool(fSharedContext->device(),
+                                           &createInfo,
+                                           nullptr,
+                                           &fTimestampQueryPool));
+        if (result != VK_SUCCESS) {
+            fTimestampQueryPool = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+    if (index == 0) {
+        // Queries must be reset before they are written. The first timestamp is written before a
+        // pass begins, so this is recorded outside of any render pass.
+        SkASSERT(!fActiveRenderPass);
+        VULKAN_CALL(fSharedContext->interface(),
+                    CmdResetQueryPool(fPrimaryCommandBuffer,
+                                      fTimestampQueryPool,
+                                      /*firstQuery=*/0,
+                                      kMaxTimestampQueries));
+    }
+    // Even indices start a pass and odd indices end one.
+    VkPipelineStageFlagBits stage = (index & 1) ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+                                                : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VULKAN_CALL(fSharedContext->interface(),
+                CmdWriteTimestamp(fPrimaryCommandBuffer, stage, fTimestampQueryPool, index));
+    return true;
+}
+
+bool VulkanCommandBuffer::onReadTimestamps(int count, uint64_t* outNanoseconds) {
+    SkASSERT(fTimestampQueryPool != VK_NULL_HANDLE);
+    SkASSERT(count <= kMaxTimestampQueries);
+    VkResult result;
+    VULKAN_CALL_RESULT_NOCHECK(fSharedContext->interface(),
+                               result,
+                               GetQueryPoolResults(fSharedContext->device(),
+                                                   fTimestampQueryPool,
+                                                   /*firstQuery=*/0,
+                                                   count,
+                                                   count * sizeof(uint64_t),
+                                                   outNanoseconds,
+                                                   sizeof(uint64_t),
+                                                   VK_QUERY_RESULT_64_BIT));
+    if (result != VK_SUCCESS) {
+        return false;
+    }
+    double period = fSharedContext->vulkanCaps().timestampPeriod();
+    for (int i = 0; i < count; ++i) {
+        outNanoseconds[i] = static_cast<uint64_t>(outNanoseconds[i] * period);
+    }
+    return true;
+}
+
 bool VulkanCommandBuffer::updateLoadMSAAVertexBuffer() {
     const Buffer* vertexBuffer = fResourceProvider->loadMSAAVertexBuffer();
     if (!vertexBuffer) {
@@ -1053,7 +1122,6 @@ void VulkanCommandBuffer::recordTextureAndSamplerDescSet(
         fBindTextureSamplers = false;
         return;
     }
-    // Query resource provider to obtain a descriptor set for the texture/samplers
     TArray<DescriptorData> descriptors(command.fNumTexSamplers);
     for (int i = 0; i < command.fNumTexSamplers; i++) {
         descriptors.push_back({DescriptorType::kCombinedTextureSampler,
@@ -1061,22 +1129,11 @@ void VulkanCommandBuffer::recordTextureAndSamplerDescSet(
                                /*bindingIdx=*/i,
                                PipelineStageFlags::kFragmentShader});
     }
-    sk_sp<VulkanDescriptorSet> set = fResourceProvider->findOrCreateDescriptorSet(
-            SkSpan<DescriptorData>{&descriptors.front(), descriptors.size()});
-
-    if (!set) {
-        SKGPU_LOG_E("Unable to find or create descriptor set");
-        fNumTextureSamplers = 0;
-        fTextureSamplerDescSetToBind = VK_NULL_HANDLE;
-        fBindTextureSamplers = false;
-        return;
-    }
-    // Populate the descriptor set with texture/sampler descriptors
-    TArray<VkWriteDescriptorSet> writeDescriptorSets(command.fNumTexSamplers);
-    TArray<VkDescriptorImageInfo> descriptorImageInfos(command.fNumTexSamplers);
+    TArray<const VulkanTexture*> textures(command.fNumTexSamplers);
+    TArray<const VulkanSampler*> samplers(command.fNumTexSamplers);
     for (int i = 0; i < command.fNumTexSamplers; ++i) {
-        auto texture = const_cast<VulkanTexture*>(static_cast<const VulkanTexture*>(
-                drawPass.getTexture(command.fTextureIndices[i])));
+        auto texture = static_cast<const VulkanTexture*>(
+                drawPass.getTexture(command.fTextureIndices[i]));
         auto sampler = static_cast<const VulkanSampler*>(
                 drawPass.getSampler(command.fSamplerIndices[i]));
         if (!texture || !sampler) {
@@ -1088,33 +1145,24 @@ void VulkanCommandBuffer::recordTextureAndSamplerDescSet(
             fBindTextureSamplers = false;
             return;
         }
+        textures.push_back(texture);
+        samplers.push_back(sampler);
+    }
+
+    // Query resource provider to obtain a descriptor set already populated with the
+    // texture/sampler descriptors, which is reused by other draws that read the same ones.
+    sk_sp<VulkanDescriptorSet> set = fResourceProvider->findOrCreateTextureSamplerDescriptorSet(
+            SkSpan<DescriptorData>{&descriptors.front(), descriptors.size()},
+            SkSpan<const VulkanTexture*>{textures.data(), textures.size()},
+            SkSpan<const VulkanSampler*>{samplers.data(), samplers.size()});
 
-        VkDescriptorImageInfo& textureInfo = descriptorImageInfos.push_back();
-        memset(&textureInfo, 0, sizeof(VkDescriptorImageInfo));
-        textureInfo.sampler = sampler->vkSampler();
-        textureInfo.imageView =
-                texture->getImageView(VulkanImageView::Usage::kShaderInput)->imageView();
-        textureInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        VkWriteDescriptorSet& writeInfo = writeDescriptorSets.push_back();
-        memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
-        writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeInfo.pNext = nullptr;
-        writeInfo.dstSet = *set->descriptorSet();
-        writeInfo.dstBinding = i;
-        writeInfo.dstArrayElement = 0;
-        writeInfo.descriptorCount = 1;
-        writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        writeInfo.pImageInfo = &textureInfo;
-        writeInfo.pBufferInfo = nullptr;
-        writeInfo.pTexelBufferView = nullptr;
-    }
-
-    VULKAN_CALL(fSharedContext->interface(), UpdateDescriptorSets(fSharedContext->device(),
-                                                                  command.fNumTexSamplers,
-                                                                  &writeDescriptorSets[0],
-                                                                  /*descriptorCopyCount=*/0,
-                                                                  /*pDescriptorCopies=*/nullptr));
+    if (!set) {
+        SKGPU_LOG_E("Unable to find or create descriptor set");
+        fNumTextureSamplers = 0;
+        fTextureSamplerDescSetToBind = VK_NULL_HANDLE;
+        fBindTextureSamplers = false;
+        return;
+    }
 
     // Store the updated descriptor set to be actually bound later on. This avoids binding and
     // potentially having to re-bind in cases where earlier descriptor sets change while going
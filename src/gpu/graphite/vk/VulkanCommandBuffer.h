@@ -145,6 +145,9 @@ private:
     bool onSynchronizeBufferToCpu(const Buffer*, bool* outDidResultInWork) override;
     bool onClearBuffer(const Buffer*, size_t offset, size_t size) override;
 
+    bool onWriteTimestamp(int index) override;
+    bool onReadTimestamps(int count, uint64_t* outNanoseconds) override;
+
     enum BarrierType {
         kBufferMemory_BarrierType,
         kImageMemory_BarrierType
@@ -189,6 +192,11 @@ private:
 
     VkFence fSubmitFence = VK_NULL_HANDLE;
 
+    // Timestamps for timing the passes of a command buffer, created when first needed. This times
+    // up to 64 passes per command buffer.
+    static constexpr int kMaxTimestampQueries = 128;
+    VkQueryPool fTimestampQueryPool = VK_NULL_HANDLE;
+
     // Current semaphores
     skia_private::STArray<1, VkSemaphore> fWaitSemaphores;
     skia_private::STArray<1, VkSemaphore> fSignalSemaphores;
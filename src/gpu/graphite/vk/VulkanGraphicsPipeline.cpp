@@ -600,7 +600,6 @@ sk_sp<VulkanGraphicsPipeline> VulkanGraphicsPipeline::Make(
     SkSL::Program::Interface vsInterface, fsInterface;
     SkSL::ProgramSettings settings;
     settings.fForceNoRTFlip = true; // TODO: Confirm
-    ShaderErrorHandler* errorHandler = sharedContext->caps()->shaderErrorHandler();
 
     const RenderStep* step = sharedContext->rendererProvider()->lookup(pipelineDesc.renderStepID());
     const bool useStorageBuffers = sharedContext->caps()->storageBufferPreferred();
@@ -626,13 +625,14 @@ sk_sp<VulkanGraphicsPipeline> VulkanGraphicsPipeline::Make(
     VkShaderModule fsModule = VK_NULL_HANDLE, vsModule = VK_NULL_HANDLE;
 
     if (hasFragmentSkSL) {
-        if (!skgpu::SkSLToSPIRV(sharedContext->caps()->shaderCaps(),
-                                fsSkSL,
-                                SkSL::ProgramKind::kGraphiteFragment,
-                                settings,
-                                &fsSPIRV,
-                                &fsInterface,
-                                errorHandler)) {
+        if (!SkSLToBackendCached(sharedContext->caps(),
+                                 &skgpu::SkSLToSPIRV,
+                                 "SPIR-V",
+                                 fsSkSL,
+                                 SkSL::ProgramKind::kGraphiteFragment,
+                                 settings,
+                                 &fsSPIRV,
+                                 &fsInterface)) {
             return nullptr;
         }
 
@@ -647,13 +647,14 @@ sk_sp<VulkanGraphicsPipeline> VulkanGraphicsPipeline::Make(
                                               useStorageBuffers,
                                               localCoordsNeeded);
     const std::string& vsSkSL = vsSkSLInfo.fSkSL;
-    if (!skgpu::SkSLToSPIRV(sharedContext->caps()->shaderCaps(),
-                            vsSkSL,
-                            SkSL::ProgramKind::kGraphiteVertex,
-                            settings,
-                            &vsSPIRV,
-                            &vsInterface,
-                            errorHandler)) {
+    if (!SkSLToBackendCached(sharedContext->caps(),
+                             &skgpu::SkSLToSPIRV,
+                             "SPIR-V",
+                             vsSkSL,
+                             SkSL::ProgramKind::kGraphiteVertex,
+                             settings,
+                             &vsSPIRV,
+                             &vsInterface)) {
         return nullptr;
     }
 
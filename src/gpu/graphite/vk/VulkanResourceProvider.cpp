@@ -10,6 +10,7 @@
 #include "include/core/SkSpan.h"
 #include "include/gpu/MutableTextureState.h"
 #include "include/gpu/graphite/BackendTexture.h"
+#include "include/gpu/graphite/ContextOptions.h"
 #include "include/gpu/graphite/vk/VulkanGraphiteTypes.h"
 #include "include/gpu/vk/VulkanMutableTextureState.h"
 #include "src/gpu/graphite/Buffer.h"
@@ -30,16 +31,21 @@
 #include "src/gpu/graphite/vk/VulkanTexture.h"
 #include "src/gpu/graphite/vk/VulkanYcbcrConversion.h"
 #include "src/gpu/vk/VulkanMemory.h"
+#include "src/gpu/vk/VulkanUtilsPriv.h"
 #include "src/sksl/SkSLCompiler.h"
 
 #ifdef  SK_BUILD_FOR_ANDROID
-#include "src/gpu/vk/VulkanUtilsPriv.h"
 #include <android/hardware_buffer.h>
 #endif
 
 namespace skgpu::graphite {
 
 constexpr int kMaxNumberOfCachedBufferDescSets = 1024;
+constexpr int kMaxNumberOfCachedTextureSamplerDescSets = 1024;
+
+// The persistent cache key for VkPipelineCache data. Keys for backend shader code are longer than
+// four bytes, so they can't collide with it.
+static constexpr uint32_t kPipelineCachePersistentCacheKey = SkSetFourByteTag('v', 'k', 'p', 'c');
 
 VulkanResourceProvider::VulkanResourceProvider(SharedContext* sharedContext,
                                                SingleOwner* singleOwner,
@@ -50,10 +56,12 @@ VulkanResourceProvider::VulkanResourceProvider(SharedContext* sharedContext,
         : ResourceProvider(sharedContext, singleOwner, recorderID, resourceBudget)
         , fIntrinsicUniformBuffer(std::move(intrinsicConstantUniformBuffer))
         , fLoadMSAAVertexBuffer(std::move(loadMSAAVertexBuffer))
-        , fUniformBufferDescSetCache(kMaxNumberOfCachedBufferDescSets) {}
+        , fUniformBufferDescSetCache(kMaxNumberOfCachedBufferDescSets)
+        , fTextureSamplerDescSetCache(kMaxNumberOfCachedTextureSamplerDescSets) {}
 
 VulkanResourceProvider::~VulkanResourceProvider() {
     if (fPipelineCache != VK_NULL_HANDLE) {
+        this->storePipelineCacheData();
         VULKAN_CALL(this->vulkanSharedContext()->interface(),
                     DestroyPipelineCache(this->vulkanSharedContext()->device(),
                                          fPipelineCache,
@@ -121,7 +129,7 @@ sk_sp<GraphicsPipeline> VulkanResourceProvider::createGraphicsPipeline(
                                         pipelineDesc,
                                         renderPassDesc,
                                         compatibleRenderPass,
-                                        this->pipelineCache());
+                                        this->pipelineCacheForNewPipeline());
 }
 
 sk_sp<ComputePipeline> VulkanResourceProvider::createComputePipeline(const ComputePipelineDesc&) {
@@ -406,6 +414,74 @@ sk_sp<VulkanDescriptorSet> VulkanResourceProvider::findOrCreateUniformBuffersDes
     return *fUniformBufferDescSetCache.insert(key, newDS);
 }
 
+namespace {
+UniqueKey make_texture_sampler_desc_set_key(SkSpan<const VulkanTexture*> textures,
+                                            SkSpan<const VulkanSampler*> samplers) {
+    static const UniqueKey::Domain kTextureSamplerDescSetDomain = UniqueKey::GenerateDomain();
+
+    // Each texture/sampler pair needs 2 uint32_t in the key: the texture's and the sampler's unique
+    // IDs. IDs are never reused, so a set can't be found again once one of its resources is gone.
+    UniqueKey uniqueKey;
+    UniqueKey::Builder builder(&uniqueKey, kTextureSamplerDescSetDomain, 2 * textures.size(),
+                               "TextureSamplerDescSet");
+    for (size_t i = 0; i < textures.size(); ++i) {
+        builder[2 * i] = textures[i]->uniqueID().asUInt();
+        builder[2 * i + 1] = samplers[i]->uniqueID().asUInt();
+    }
+    builder.finish();
+    return uniqueKey;
+}
+} // anonymous namespace
+
+sk_sp<VulkanDescriptorSet> VulkanResourceProvider::findOrCreateTextureSamplerDescriptorSet(
+        SkSpan<DescriptorData> requestedDescriptors,
+        SkSpan<const VulkanTexture*> textures,
+        SkSpan<const VulkanSampler*> samplers) {
+    SkASSERT(requestedDescriptors.size() == textures.size());
+    SkASSERT(textures.size() == samplers.size());
+
+    auto key = make_texture_sampler_desc_set_key(textures, samplers);
+    if (auto* existingDescSet = fTextureSamplerDescSetCache.find(key)) {
+        return *existingDescSet;
+    }
+    sk_sp<VulkanDescriptorSet> newDS = this->findOrCreateDescriptorSet(requestedDescriptors);
+    if (!newDS) {
+        return nullptr;
+    }
+
+    skia_private::TArray<VkWriteDescriptorSet> writeDescriptorSets(textures.size());
+    skia_private::TArray<VkDescriptorImageInfo> descriptorImageInfos(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        VkDescriptorImageInfo& textureInfo = descriptorImageInfos.push_back();
+        memset(&textureInfo, 0, sizeof(VkDescriptorImageInfo));
+        textureInfo.sampler = samplers[i]->vkSampler();
+        textureInfo.imageView =
+                textures[i]->getImageView(VulkanImageView::Usage::kShaderInput)->imageView();
+        textureInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet& writeInfo = writeDescriptorSets.push_back();
+        memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
+        writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writeInfo.pNext = nullptr;
+        writeInfo.dstSet = *newDS->descriptorSet();
+        writeInfo.dstBinding = requestedDescriptors[i].fBindingIndex;
+        writeInfo.dstArrayElement = 0;
+        writeInfo.descriptorCount = 1;
+        writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writeInfo.pImageInfo = &textureInfo;
+        writeInfo.pBufferInfo = nullptr;
+        writeInfo.pTexelBufferView = nullptr;
+    }
+
+    const VulkanSharedContext* sharedContext = this->vulkanSharedContext();
+    VULKAN_CALL(sharedContext->interface(), UpdateDescriptorSets(sharedContext->device(),
+                                                                 writeDescriptorSets.size(),
+                                                                 writeDescriptorSets.data(),
+                                                                 /*descriptorCopyCount=*/0,
+                                                                 /*pDescriptorCopies=*/nullptr));
+    return *fTextureSamplerDescSetCache.insert(key, newDS);
+}
+
 
 sk_sp<VulkanRenderPass> VulkanResourceProvider::findOrCreateRenderPassWithKnownKey(
             const RenderPassDesc& renderPassDesc,
@@ -439,17 +515,30 @@ sk_sp<VulkanRenderPass> VulkanResourceProvider::findOrCreateRenderPass(
 
 VkPipelineCache VulkanResourceProvider::pipelineCache() {
     if (fPipelineCache == VK_NULL_HANDLE) {
+        const VulkanSharedContext* sharedContext = this->vulkanSharedContext();
+
+        sk_sp<SkData> cached;
+        if (ContextOptions::PersistentCache* persistentCache =
+                    sharedContext->caps()->persistentCache()) {
+            uint32_t key = kPipelineCachePersistentCacheKey;
+            cached = persistentCache->load(*SkData::MakeWithoutCopy(&key, sizeof(key)));
+            if (cached && !skgpu::VulkanPipelineCacheDataIsCompatible(
+                                  *cached, sharedContext->physicalDeviceProperties())) {
+                cached = nullptr;
+            }
+        }
+
         VkPipelineCacheCreateInfo createInfo;
         memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
         createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
-        createInfo.initialDataSize = 0;
-        createInfo.pInitialData = nullptr;
+        createInfo.initialDataSize = cached ? cached->size() : 0;
+        createInfo.pInitialData = cached ? cached->data() : nullptr;
         VkResult result;
-        VULKAN_CALL_RESULT(this->vulkanSharedContext(),
+        VULKAN_CALL_RESULT(sharedContext,
                            result,
-                           CreatePipelineCache(this->vulkanSharedContext()->device(),
+                           CreatePipelineCache(sharedContext->device(),
                                                &createInfo,
                                                nullptr,
                                                &fPipelineCache));
@@ -460,6 +549,40 @@ VkPipelineCache VulkanResourceProvider::pipelineCache() {
     return fPipelineCache;
 }
 
+VkPipelineCache VulkanResourceProvider::pipelineCacheForNewPipeline() {
+    fPipelineCacheNeedsStore = true;
+    return this->pipelineCache();
+}
+
+void VulkanResourceProvider::storePipelineCacheData() {
+    const VulkanSharedContext* sharedContext = this->vulkanSharedContext();
+    ContextOptions::PersistentCache* persistentCache = sharedContext->caps()->persistentCache();
+    if (!persistentCache || !fPipelineCacheNeedsStore || fPipelineCache == VK_NULL_HANDLE) {
+        return;
+    }
+
+    uint32_t key = kPipelineCachePersistentCacheKey;
+    sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(key));
+
+    // Each Recorder has its own pipeline cache, and other processes may share the persistent
+    // cache too. Merge whatever they stored into this cache, so that storing it doesn't throw
+    // their pipelines away.
+    if (sk_sp<SkData> stored = persistentCache->load(*keyData)) {
+        skgpu::MergeVulkanPipelineCacheData(sharedContext->interface(),
+                                            sharedContext->device(),
+                                            sharedContext->physicalDeviceProperties(),
+                                            *stored,
+                                            fPipelineCache);
+    }
+
+    if (sk_sp<SkData> data = skgpu::GetVulkanPipelineCacheData(sharedContext->interface(),
+                                                               sharedContext->device(),
+                                                               fPipelineCache)) {
+        persistentCache->store(*keyData, *data);
+        fPipelineCacheNeedsStore = false;
+    }
+}
+
 sk_sp<VulkanFramebuffer> VulkanResourceProvider::createFramebuffer(
         const VulkanSharedContext* context,
         const skia_private::TArray<VkImageView>& attachmentViews,
@@ -582,7 +705,7 @@ sk_sp<VulkanGraphicsPipeline> VulkanResourceProvider::findOrCreateLoadMSAAPipeli
             &fMSAALoadShaderStageInfo[0],
             fMSAALoadPipelineLayout,
             compatibleRenderPass,
-            this->pipelineCache(),
+            this->pipelineCacheForNewPipeline(),
             renderPassDesc.fColorAttachment.fTextureInfo);
 
     if (!pipeline) {
@@ -28,7 +28,9 @@ class VulkanDescriptorSet;
 class VulkanFramebuffer;
 class VulkanGraphicsPipeline;
 class VulkanRenderPass;
+class VulkanSampler;
 class VulkanSharedContext;
+class VulkanTexture;
 class VulkanYcbcrConversion;
 
 class VulkanResourceProvider final : public ResourceProvider {
@@ -90,6 +92,14 @@ private:
             SkSpan<DescriptorData> requestedDescriptors,
             SkSpan<BindUniformBufferInfo> bindUniformBufferInfo);
 
+    // Returns a descriptor set with each texture and sampler pair written to the combined image
+    // sampler at the same index. Like uniform buffer sets, these are cached by the unique IDs of
+    // the resources, so draws reading the same textures reuse a set instead of writing a new one.
+    sk_sp<VulkanDescriptorSet> findOrCreateTextureSamplerDescriptorSet(
+            SkSpan<DescriptorData> requestedDescriptors,
+            SkSpan<const VulkanTexture*> textures,
+            SkSpan<const VulkanSampler*> samplers);
+
     sk_sp<VulkanGraphicsPipeline> findOrCreateLoadMSAAPipeline(const RenderPassDesc&);
 
     // Find or create a compatible (needed when creating a framebuffer and graphics pipeline) or
@@ -100,10 +110,17 @@ private:
     sk_sp<VulkanRenderPass> findOrCreateRenderPassWithKnownKey(
             const RenderPassDesc&, bool compatibleOnly, const GraphiteResourceKey& rpKey);
 
+    // The pipeline cache starts with the data in the Context's PersistentCache, if there is any.
     VkPipelineCache pipelineCache();
+    // Returns pipelineCache() and notes that it may have new pipelines that haven't been stored.
+    VkPipelineCache pipelineCacheForNewPipeline();
+    // Merges the pipeline cache with the copy in the PersistentCache and stores the result, if
+    // pipelines have been created since the last store.
+    void storePipelineCacheData();
 
     friend class VulkanCommandBuffer;
     VkPipelineCache fPipelineCache = VK_NULL_HANDLE;
+    bool fPipelineCacheNeedsStore = false;
 
     // Each render pass will need buffer space to record rtAdjust information. To minimize costly
     // allocation calls and searching of the resource cache, we find & store a uniform buffer upon
@@ -130,6 +147,7 @@ private:
     };
     using DescriptorSetCache = SkLRUCache<UniqueKey, sk_sp<VulkanDescriptorSet>, UniqueKeyHash>;
     DescriptorSetCache fUniformBufferDescSetCache;
+    DescriptorSetCache fTextureSamplerDescSetCache;
 };
 
 } // namespace skgpu::graphite
@@ -130,18 +130,21 @@ sk_sp<SharedContext> VulkanSharedContext::Make(const VulkanBackendContext& conte
     return sk_sp<SharedContext>(new VulkanSharedContext(context,
                                                         std::move(interface),
                                                         std::move(memoryAllocator),
-                                                        std::move(caps)));
+                                                        std::move(caps),
+                                                        physDeviceProperties));
 }
 
 VulkanSharedContext::VulkanSharedContext(const VulkanBackendContext& backendContext,
                                          sk_sp<const skgpu::VulkanInterface> interface,
                                          sk_sp<skgpu::VulkanMemoryAllocator> memoryAllocator,
-                                         std::unique_ptr<const VulkanCaps> caps)
+                                         std::unique_ptr<const VulkanCaps> caps,
+                                         const VkPhysicalDeviceProperties& physDeviceProperties)
         : skgpu::graphite::SharedContext(std::move(caps), BackendApi::kVulkan)
         , fInterface(std::move(interface))
         , fMemoryAllocator(std::move(memoryAllocator))
         , fDevice(std::move(backendContext.fDevice))
         , fQueueIndex(backendContext.fGraphicsQueueIndex)
+        , fPhysDeviceProperties(physDeviceProperties)
         , fDeviceLostContext(backendContext.fDeviceLostContext)
         , fDeviceLostProc(backendContext.fDeviceLostProc) {}
 
@@ -37,6 +37,9 @@ public:
     skgpu::VulkanMemoryAllocator* memoryAllocator() const { return fMemoryAllocator.get(); }
 
     VkDevice device() const { return fDevice; }
+    const VkPhysicalDeviceProperties& physicalDeviceProperties() const {
+        return fPhysDeviceProperties;
+    }
     uint32_t  queueIndex() const { return fQueueIndex; }
 
     std::unique_ptr<ResourceProvider> makeResourceProvider(SingleOwner*,
@@ -54,13 +57,15 @@ private:
     VulkanSharedContext(const VulkanBackendContext&,
                         sk_sp<const skgpu::VulkanInterface> interface,
                         sk_sp<skgpu::VulkanMemoryAllocator> memoryAllocator,
-                        std::unique_ptr<const VulkanCaps> caps);
+                        std::unique_ptr<const VulkanCaps> caps,
+                        const VkPhysicalDeviceProperties&);
 
     sk_sp<const skgpu::VulkanInterface> fInterface;
     sk_sp<skgpu::VulkanMemoryAllocator> fMemoryAllocator;
 
     VkDevice fDevice;
     uint32_t fQueueIndex;
+    VkPhysicalDeviceProperties fPhysDeviceProperties;
 
     mutable SkMutex fDeviceIsLostMutex;
     // TODO(b/322207523): consider refactoring to remove the mutable keyword from fDeviceIsLost.
@@ -394,18 +394,7 @@ public:
     // Write a cubic curve with its four control points.
     AI void writeCubic(float2 p0, float2 p1, float2 p2, float2 p3) {
         float n4 = wangs_formula::cubic_p4(kPrecision, p0, p1, p2, p3, fApproxTransform);
-        if constexpr (kDiscardFlatCurves) {
-            if (n4 <= 1.f) {
-                // This cubic only needs one segment (e.g. a line) but we're not filling space with
-                // fans or stroking, so nothing actually needs to be drawn.
-                return;
-            }
-        }
-        if (int numPatches = this->accountForCurve(n4)) {
-            this->chopAndWriteCubics(p0, p1, p2, p3, numPatches);
-        } else {
-            this->writeCubicPatch(p0, p1, p2, p3);
-        }
+        this->writeCubicWithN4(p0, p1, p2, p3, n4);
     }
     AI void writeCubic(const SkPoint pts[4]) {
         float4 p0p1 = float4::Load(pts);
@@ -441,18 +430,7 @@ public:
     // equivalent cubic.
     AI void writeQuadratic(float2 p0, float2 p1, float2 p2) {
         float n4 = wangs_formula::quadratic_p4(kPrecision, p0, p1, p2, fApproxTransform);
-        if constexpr (kDiscardFlatCurves) {
-            if (n4 <= 1.f) {
-                // This quad only needs one segment (e.g. a line) but we're not filling space with
-                // fans or stroking, so nothing actually needs to be drawn.
-                return;
-            }
-        }
-        if (int numPatches = this->accountForCurve(n4)) {
-            this->chopAndWriteQuads(p0, p1, p2, numPatches);
-        } else {
-            this->writeQuadPatch(p0, p1, p2);
-        }
+        this->writeQuadraticWithN4(p0, p1, p2, n4);
     }
     AI void writeQuadratic(const SkPoint pts[3]) {
         this->writeQuadratic(sk_bit_cast<float2>(pts[0]),
@@ -460,6 +438,36 @@ public:
                              sk_bit_cast<float2>(pts[2]));
     }
 
+    // Write 'count' cubics or quadratics that share their end points, the way consecutive verbs of
+    // the same type are stored in an SkPath (see wangs_formula::cubic_strip_p4). This is equivalent
+    // to calling writeCubic() or writeQuadratic() for each curve, but evaluates Wang's formula for
+    // several curves at once.
+    void writeCubicStrip(const SkPoint pts[], int count) {
+        float n4[kStripChunkSize];
+        while (count > 0) {
+            const int chunkCount = std::min(count, kStripChunkSize);
+            wangs_formula::cubic_strip_p4(kPrecision, pts, chunkCount, n4, fApproxTransform);
+            for (int i = 0; i < chunkCount; ++i, pts += 3) {
+                float4 p0p1 = float4::Load(pts);
+                float4 p2p3 = float4::Load(pts + 2);
+                this->writeCubicWithN4(p0p1.lo, p0p1.hi, p2p3.lo, p2p3.hi, n4[i]);
+            }
+            count -= chunkCount;
+        }
+    }
+    void writeQuadraticStrip(const SkPoint pts[], int count) {
+        float n4[kStripChunkSize];
+        while (count > 0) {
+            const int chunkCount = std::min(count, kStripChunkSize);
+            wangs_formula::quadratic_strip_p4(kPrecision, pts, chunkCount, n4, fApproxTransform);
+            for (int i = 0; i < chunkCount; ++i, pts += 2) {
+                float4 p0p1 = float4::Load(pts);
+                this->writeQuadraticWithN4(p0p1.lo, p0p1.hi, float2::Load(pts + 2), n4[i]);
+            }
+            count -= chunkCount;
+        }
+    }
+
     // Write a line that is automatically converted into an equivalent cubic.
     AI void writeLine(float4 p0p1) {
         // No chopping needed, a line only ever requires one segment (the minimum required already).
@@ -510,6 +518,39 @@ public:
     }
 
 private:
+    // The number of curves whose Wang's formula values the strip writers compute before writing.
+    static constexpr int kStripChunkSize = 16;
+
+    AI void writeCubicWithN4(float2 p0, float2 p1, float2 p2, float2 p3, float n4) {
+        if constexpr (kDiscardFlatCurves) {
+            if (n4 <= 1.f) {
+                // This cubic only needs one segment (e.g. a line) but we're not filling space with
+                // fans or stroking, so nothing actually needs to be drawn.
+                return;
+            }
+        }
+        if (int numPatches = this->accountForCurve(n4)) {
+            this->chopAndWriteCubics(p0, p1, p2, p3, numPatches);
+        } else {
+            this->writeCubicPatch(p0, p1, p2, p3);
+        }
+    }
+
+    AI void writeQuadraticWithN4(float2 p0, float2 p1, float2 p2, float n4) {
+        if constexpr (kDiscardFlatCurves) {
+            if (n4 <= 1.f) {
+                // This quad only needs one segment (e.g. a line) but we're not filling space with
+                // fans or stroking, so nothing actually needs to be drawn.
+                return;
+            }
+        }
+        if (int numPatches = this->accountForCurve(n4)) {
+            this->chopAndWriteQuads(p0, p1, p2, numPatches);
+        } else {
+            this->writeQuadPatch(p0, p1, p2);
+        }
+    }
+
     AI void emitPatchAttribs(VertexWriter vertexWriter,
                              const JoinAttrib& join,
                              float explicitCurveType) {
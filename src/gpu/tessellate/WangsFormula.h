@@ -128,11 +128,31 @@ public:
                     fC0 * vectors.z() + fC1 * vectors.w());
     }
 private:
+    template <int N> friend class VectorXformN;
+
     // First and second columns of 2x2 matrix
     skvx::float2 fC0;
     skvx::float2 fC1;
 };
 
+// A VectorXform with each of its entries splatted across N lanes, for mapping N vectors at once
+// that are stored as separate x and y lanes. Construct it once, outside the loop that uses it.
+template <int N>
+class VectorXformN {
+public:
+    AI VectorXformN() : VectorXformN(VectorXform()) {}
+    AI explicit VectorXformN(const VectorXform& m)
+            : fM00(m.fC0[0]), fM01(m.fC1[0]), fM10(m.fC0[1]), fM11(m.fC1[1]) {}
+
+    AI void operator()(skvx::Vec<N,float>* x, skvx::Vec<N,float>* y) const {
+        skvx::Vec<N,float> mappedX = fM00 * *x + fM01 * *y;
+        *y = fM10 * *x + fM11 * *y;
+        *x = mappedX;
+    }
+private:
+    skvx::Vec<N,float> fM00, fM01, fM10, fM11;
+};
+
 // Returns Wang's formula, raised to the 4th power, specialized for a quadratic curve.
 AI float quadratic_p4(float precision,
                       skvx::float2 p0, skvx::float2 p1, skvx::float2 p2,
@@ -207,6 +227,85 @@ AI int cubic_log2(float precision,
     return nextlog16(cubic_p4(precision, pts, vectorXform));
 }
 
+// Batched versions of quadratic_p4() and cubic_p4() that evaluate N curves at once, one per lane.
+// The control points are given as separate x and y lanes: x[i] and y[i] hold the i'th control point
+// of each curve. They return the same values as the single curve versions.
+template <int N>
+AI skvx::Vec<N,float> quadratic_p4(float precision,
+                                   const skvx::Vec<N,float> x[3],
+                                   const skvx::Vec<N,float> y[3],
+                                   const VectorXformN<N>& vectorXform = VectorXformN<N>()) {
+    skvx::Vec<N,float> vx = -2*x[1] + x[0] + x[2];
+    skvx::Vec<N,float> vy = -2*y[1] + y[0] + y[2];
+    vectorXform(&vx, &vy);
+    return (vx*vx + vy*vy) * length_term_p2<2>(precision);
+}
+
+template <int N>
+AI skvx::Vec<N,float> cubic_p4(float precision,
+                               const skvx::Vec<N,float> x[4],
+                               const skvx::Vec<N,float> y[4],
+                               const VectorXformN<N>& vectorXform = VectorXformN<N>()) {
+    skvx::Vec<N,float> v0x = -2*x[1] + x[0] + x[2];
+    skvx::Vec<N,float> v0y = -2*y[1] + y[0] + y[2];
+    skvx::Vec<N,float> v1x = -2*x[2] + x[1] + x[3];
+    skvx::Vec<N,float> v1y = -2*y[2] + y[1] + y[3];
+    vectorXform(&v0x, &v0y);
+    vectorXform(&v1x, &v1y);
+    return max(v0x*v0x + v0y*v0y, v1x*v1x + v1y*v1y) * length_term_p2<3>(precision);
+}
+
+// The number of curves that the strip functions below evaluate at once.
+constexpr int kStripBatchSize = 4;
+
+// Computes quadratic_p4() for 'count' quadratics that share their end points, the way consecutive
+// quad verbs are stored in an SkPath: quadratic i has the control points pts[2i..2i+2]. The
+// results are written to n4[0..count-1].
+AI void quadratic_strip_p4(float precision,
+                           const SkPoint pts[],
+                           int count,
+                           float n4[],
+                           const VectorXform& vectorXform = VectorXform()) {
+    using floatN = skvx::Vec<kStripBatchSize, float>;
+    const VectorXformN<kStripBatchSize> vectorXformN(vectorXform);
+    int i = 0;
+    for (; i + kStripBatchSize <= count; i += kStripBatchSize, pts += 2*kStripBatchSize) {
+        floatN x[3], y[3];
+        for (int j = 0; j < 3; ++j) {
+            x[j] = floatN{pts[j].fX, pts[2 + j].fX, pts[4 + j].fX, pts[6 + j].fX};
+            y[j] = floatN{pts[j].fY, pts[2 + j].fY, pts[4 + j].fY, pts[6 + j].fY};
+        }
+        quadratic_p4(precision, x, y, vectorXformN).store(n4 + i);
+    }
+    for (; i < count; ++i, pts += 2) {
+        n4[i] = quadratic_p4(precision, pts, vectorXform);
+    }
+}
+
+// Computes cubic_p4() for 'count' cubics that share their end points, the way consecutive cubic
+// verbs are stored in an SkPath: cubic i has the control points pts[3i..3i+3]. The results are
+// written to n4[0..count-1].
+AI void cubic_strip_p4(float precision,
+                       const SkPoint pts[],
+                       int count,
+                       float n4[],
+                       const VectorXform& vectorXform = VectorXform()) {
+    using floatN = skvx::Vec<kStripBatchSize, float>;
+    const VectorXformN<kStripBatchSize> vectorXformN(vectorXform);
+    int i = 0;
+    for (; i + kStripBatchSize <= count; i += kStripBatchSize, pts += 3*kStripBatchSize) {
+        floatN x[4], y[4];
+        for (int j = 0; j < 4; ++j) {
+            x[j] = floatN{pts[j].fX, pts[3 + j].fX, pts[6 + j].fX, pts[9 + j].fX};
+            y[j] = floatN{pts[j].fY, pts[3 + j].fY, pts[6 + j].fY, pts[9 + j].fY};
+        }
+        cubic_p4(precision, x, y, vectorXformN).store(n4 + i);
+    }
+    for (; i < count; ++i, pts += 3) {
+        n4[i] = cubic_p4(precision, pts, vectorXform);
+    }
+}
+
 // Returns the maximum number of line segments a cubic with the given device-space bounding box size
 // would ever need to be divided into, raised to the 4th power. This is simply a special case of the
 // cubic formula where we maximize its value by placing control points on specific corners of the
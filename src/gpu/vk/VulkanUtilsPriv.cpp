@@ -10,6 +10,7 @@
 #include "include/private/base/SkDebug.h"
 #include "src/gpu/vk/VulkanInterface.h"
 
+#include <cstring>
 #include <vector>
 
 namespace skgpu {
@@ -275,4 +276,79 @@ void InvokeDeviceLostCallback(const skgpu::VulkanInterface* vulkanInterface,
                    vendorBinaryData);
 }
 
+bool VulkanPipelineCacheDataIsCompatible(const SkData& data,
+                                         const VkPhysicalDeviceProperties& deviceProperties) {
+    // For version one of the header, the total header size is 16 bytes plus VK_UUID_SIZE bytes.
+    // See Section 9.6 (Pipeline Cache) in the vulkan spec to see the breakdown of these bytes.
+    static constexpr size_t kHeaderSize = 16 + VK_UUID_SIZE;
+    if (data.size() < kHeaderSize) {
+        return false;
+    }
+    uint32_t header[kHeaderSize / sizeof(uint32_t)];
+    memcpy(header, data.data(), kHeaderSize);
+    return header[0] == kHeaderSize &&
+           header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header[2] == deviceProperties.vendorID &&
+           header[3] == deviceProperties.deviceID &&
+           !memcmp(&header[4], deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+bool MergeVulkanPipelineCacheData(const skgpu::VulkanInterface* interface,
+                                  VkDevice device,
+                                  const VkPhysicalDeviceProperties& deviceProperties,
+                                  const SkData& data,
+                                  VkPipelineCache dstCache) {
+    if (dstCache == VK_NULL_HANDLE ||
+        !VulkanPipelineCacheDataIsCompatible(data, deviceProperties)) {
+        return false;
+    }
+
+    VkPipelineCacheCreateInfo createInfo;
+    memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.data();
+
+    VkPipelineCache srcCache;
+    VkResult result = SHARED_GR_VULKAN_CALL(interface,
+                                            CreatePipelineCache(device,
+                                                                &createInfo,
+                                                                nullptr,
+                                                                &srcCache));
+    if (result != VK_SUCCESS) {
+        return false;
+    }
+    result = SHARED_GR_VULKAN_CALL(interface, MergePipelineCaches(device, dstCache, 1, &srcCache));
+    SHARED_GR_VULKAN_CALL(interface, DestroyPipelineCache(device, srcCache, nullptr));
+    return result == VK_SUCCESS;
+}
+
+sk_sp<SkData> GetVulkanPipelineCacheData(const skgpu::VulkanInterface* interface,
+                                         VkDevice device,
+                                         VkPipelineCache cache) {
+    if (cache == VK_NULL_HANDLE) {
+        return nullptr;
+    }
+    size_t dataSize = 0;
+    VkResult result = SHARED_GR_VULKAN_CALL(interface,
+                                            GetPipelineCacheData(device, cache, &dataSize, nullptr));
+    if (result != VK_SUCCESS || dataSize == 0) {
+        return nullptr;
+    }
+
+    sk_sp<SkData> data = SkData::MakeUninitialized(dataSize);
+    result = SHARED_GR_VULKAN_CALL(interface,
+                                   GetPipelineCacheData(device,
+                                                        cache,
+                                                        &dataSize,
+                                                        data->writable_data()));
+    // VK_INCOMPLETE means the cache grew between the two calls, and the data is truncated.
+    if (result != VK_SUCCESS) {
+        return nullptr;
+    }
+    return data;
+}
+
 } // namespace skgpu
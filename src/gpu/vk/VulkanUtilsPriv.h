@@ -9,6 +9,8 @@
 #define skgpu_VulkanUtilsPriv_DEFINED
 
 #include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkTextureCompressionType.h"
 #include "include/gpu/vk/VulkanTypes.h"
 #include "include/private/base/SkAssert.h"
@@ -310,6 +312,30 @@ void InvokeDeviceLostCallback(const skgpu::VulkanInterface* vulkanInterface,
                               skgpu::VulkanDeviceLostProc faultProc,
                               bool supportsDeviceFaultInfoExtension);
 
+/**
+ * Returns true if data holds VkPipelineCache data with a version one header that was written by a
+ * device with the same vendor ID, device ID and pipeline cache UUID as deviceProperties.
+ */
+bool VulkanPipelineCacheDataIsCompatible(const SkData& data,
+                                         const VkPhysicalDeviceProperties& deviceProperties);
+
+/**
+ * Merges pipeline cache data, e.g. data that another process stored to a shared persistent cache,
+ * into dstCache. Returns false if the data is incompatible with the device or the merge failed.
+ */
+bool MergeVulkanPipelineCacheData(const skgpu::VulkanInterface*,
+                                  VkDevice,
+                                  const VkPhysicalDeviceProperties&,
+                                  const SkData& data,
+                                  VkPipelineCache dstCache);
+
+/**
+ * Returns the contents of cache, or null if they can't be retrieved.
+ */
+sk_sp<SkData> GetVulkanPipelineCacheData(const skgpu::VulkanInterface*,
+                                         VkDevice,
+                                         VkPipelineCache cache);
+
 }  // namespace skgpu
 
 #endif // skgpu_VulkanUtilsPriv_DEFINED
@@ -10,16 +10,21 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkYUVAInfo.h"
+#include "include/private/base/SkSemaphore.h"
+#include "src/base/SkScopeExit.h"
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkNextID.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTHash.h"
 #include "src/core/SkYUVPlanesCache.h"
 
+#include <atomic>
 #include <utility>
 
 enum SkColorType : int;
@@ -104,8 +109,97 @@ SkImage_Lazy::SkImage_Lazy(Validator* validator)
     SkASSERT(fSharedGenerator);
 }
 
+namespace {
+
+// A decode scheduled by SkImage_Lazy::schedulePrefetch(). Whichever of the executor's task and a
+// draw of the image claims it first does the decode; anyone else who finds it waits until the
+// decode is done and then looks for the pixels in the raster cache.
+class PendingDecode : public SkNVRefCnt<PendingDecode> {
+public:
+    bool claim() {
+        bool claimed = false;
+        return fClaimed.compare_exchange_strong(claimed, true);
+    }
+
+    void waitUntilDone() {
+        // Pass the signal on, so that every waiter wakes up.
+        fDone.wait();
+        fDone.signal();
+    }
+
+    void signalDone() { fDone.signal(); }
+
+private:
+    std::atomic<bool> fClaimed{false};
+    SkSemaphore fDone;
+};
+
+// The decodes that have been scheduled but not finished, keyed by image unique ID.
+class PendingDecodes {
+public:
+    static PendingDecodes* Get() {
+        static PendingDecodes* decodes = new PendingDecodes;
+        return decodes;
+    }
+
+    // Returns the new PendingDecode for 'imageID', or nullptr if it already has one.
+    sk_sp<PendingDecode> add(uint32_t imageID) {
+        SkAutoMutexExclusive lock(fMutex);
+        if (fDecodes.find(imageID)) {
+            return nullptr;
+        }
+        sk_sp<PendingDecode> decode = sk_make_sp<PendingDecode>();
+        fDecodes.set(imageID, decode);
+        return decode;
+    }
+
+    sk_sp<PendingDecode> find(uint32_t imageID) {
+        SkAutoMutexExclusive lock(fMutex);
+        sk_sp<PendingDecode>* decode = fDecodes.find(imageID);
+        return decode ? *decode : nullptr;
+    }
+
+    void finish(uint32_t imageID, PendingDecode* decode) {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            fDecodes.remove(imageID);
+        }
+        decode->signalDone();
+    }
+
+private:
+    SkMutex fMutex;
+    skia_private::THashMap<uint32_t, sk_sp<PendingDecode>> fDecodes SK_GUARDED_BY(fMutex);
+};
+
+}  // namespace
+
 bool SkImage_Lazy::getROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
                                SkImage::CachingHint chint) const {
+    auto desc = SkBitmapCacheDesc::Make(this);
+    if (SkBitmapCache::Find(desc, bitmap)) {
+        SkASSERT(bitmap->isImmutable());
+        SkASSERT(bitmap->getPixels());
+        return true;
+    }
+
+    if (sk_sp<PendingDecode> pending = PendingDecodes::Get()->find(this->uniqueID())) {
+        if (pending->claim()) {
+            // The prefetch has not started, so decode here rather than wait for the executor. The
+            // prefetch asked for the pixels to be cached, so cache them regardless of 'chint'.
+            SK_AT_SCOPE_EXIT(PendingDecodes::Get()->finish(this->uniqueID(), pending.get()));
+            return this->generateROPixels(ctx, bitmap, SkImage::kAllow_CachingHint);
+        }
+        pending->waitUntilDone();
+        if (SkBitmapCache::Find(desc, bitmap)) {
+            return true;
+        }
+    }
+    return this->generateROPixels(ctx, bitmap, chint);
+}
+
+bool SkImage_Lazy::generateROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
+                                    SkImage::CachingHint chint) const {
     auto check_output_bitmap = [bitmap]() {
         SkASSERT(bitmap->isImmutable());
         SkASSERT(bitmap->getPixels());
@@ -113,11 +207,6 @@ bool SkImage_Lazy::getROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
     };
 
     auto desc = SkBitmapCacheDesc::Make(this);
-    if (SkBitmapCache::Find(desc, bitmap)) {
-        check_output_bitmap();
-        return true;
-    }
-
     if (SkImage::kAllow_CachingHint == chint) {
         SkPixmap pmap;
         SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(desc, this->imageInfo(), &pmap);
@@ -150,6 +239,32 @@ bool SkImage_Lazy::getROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
     return true;
 }
 
+bool SkImage_Lazy::schedulePrefetch(SkExecutor* executor) const {
+    if (ScopedGenerator(fSharedGenerator)->isTextureGenerator()) {
+        return false;
+    }
+    SkBitmap bitmap;
+    if (SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), &bitmap)) {
+        return false;
+    }
+    sk_sp<PendingDecode> pending = PendingDecodes::Get()->add(this->uniqueID());
+    if (!pending) {
+        return false;
+    }
+    executor->add([image = sk_ref_sp(this), pending = std::move(pending)] {
+        if (pending->claim()) {
+            SkBitmap bitmap;
+            image->generateROPixels(nullptr, &bitmap, SkImage::kAllow_CachingHint);
+            PendingDecodes::Get()->finish(image->uniqueID(), pending.get());
+        }
+    });
+    return true;
+}
+
+bool SkImage_Lazy::hasPendingDecode() const {
+    return PendingDecodes::Get()->find(this->uniqueID()) != nullptr;
+}
+
 sk_sp<SharedGenerator> SkImage_Lazy::generator() const {
     return fSharedGenerator;
 }
@@ -286,4 +401,23 @@ sk_sp<SkImage> DeferredFromGenerator(std::unique_ptr<SkImageGenerator> generator
     return validator ? sk_make_sp<SkImage_Lazy>(&validator) : nullptr;
 }
 
+int PrefetchDecodes(SkExecutor* executor, const sk_sp<SkImage> images[], int count) {
+    if (!executor) {
+        executor = &SkExecutor::GetDefault();
+    }
+    int scheduled = 0;
+    for (int i = 0; i < count; ++i) {
+        if (images[i] && images[i]->isLazyGenerated()) {
+            auto lazy = static_cast<const SkImage_Lazy*>(images[i].get());
+            scheduled += lazy->schedulePrefetch(executor);
+        }
+    }
+    return scheduled;
+}
+
+bool IsDecodePending(const SkImage* image) {
+    return image && image->isLazyGenerated() &&
+           static_cast<const SkImage_Lazy*>(image)->hasPendingDecode();
+}
+
 }  // namespace SkImages
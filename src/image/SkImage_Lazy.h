@@ -29,6 +29,7 @@ class SharedGenerator;
 class SkBitmap;
 class SkCachedData;
 class SkData;
+class SkExecutor;
 class SkPixmap;
 enum SkColorType : int;
 struct SkIRect;
@@ -79,6 +80,13 @@ public:
     sk_sp<SkCachedData> getPlanes(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
                                   SkYUVAPixmaps* pixmaps) const;
 
+    // Schedules a decode of this image into the raster cache on 'executor'. Returns false if the
+    // image is already in the cache, already has a decode scheduled, or can't be decoded on the
+    // CPU. A draw of the image before the decode starts claims it and decodes on its own thread;
+    // a draw while it is decoding waits for it.
+    bool schedulePrefetch(SkExecutor*) const;
+    // Returns true if a decode scheduled by schedulePrefetch() has not finished yet.
+    bool hasPendingDecode() const;
 
     // Be careful with this. You need to acquire the mutex, as the generator might be shared
     // among several images.
@@ -90,6 +98,9 @@ private:
 
     class ScopedGenerator;
 
+    // Generates the pixels for getROPixels() after they were not found in the raster cache.
+    bool generateROPixels(GrDirectContext*, SkBitmap*, CachingHint) const;
+
     // Note that this->imageInfo() is not necessarily the info from the generator. It may be
     // cropped by onMakeSubset and its color type/space may be changed by
     // onMakeColorTypeAndColorSpace.
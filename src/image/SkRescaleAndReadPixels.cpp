@@ -12,6 +12,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
@@ -19,19 +20,64 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSurface.h"
+#include "include/utils/SkImageResize.h"
+#include "src/base/SkAutoMalloc.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <memory>
 #include <utility>
 
-void SkRescaleAndReadPixels(SkBitmap bmp,
-                            const SkImageInfo& resultInfo,
-                            const SkIRect& srcRect,
-                            SkImage::RescaleGamma rescaleGamma,
-                            SkImage::RescaleMode rescaleMode,
-                            SkImage::ReadPixelsCallback callback,
-                            SkImage::ReadPixelsContext context) {
+namespace {
+
+// Rows per band when a draw is split into horizontal bands to run on the default executor.
+constexpr int kMinBandHeight = 64;
+
+// Calls 'draw' with a canvas over 'dst', once for each horizontal band of 'dst' and with the
+// canvas clipped to it, on the default SkExecutor. Bands write disjoint rows, so they can run in
+// parallel with any executor. With the default trivial executor they run one after another.
+template <typename DrawFn>
+void draw_in_bands(const SkPixmap& dst, DrawFn&& draw) {
+    int bands = std::max(1, dst.height() / kMinBandHeight);
+    SkTaskGroup tasks;
+    tasks.batch(bands, [&](int band) {
+        std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(dst.info(),
+                                                                      dst.writable_addr(),
+                                                                      dst.rowBytes());
+        canvas->clipIRect(SkIRect::MakeLTRB(0, dst.height() * band / bands,
+                                            dst.width(), dst.height() * (band + 1) / bands));
+        draw(canvas.get());
+    });
+    tasks.wait();
+}
+
+// The intermediate results of the rescaling steps alternate between two buffers, which are only
+// reallocated when a step needs more pixels than they hold.
+class StepBuffers {
+public:
+    SkPixmap next(const SkImageInfo& info) {
+        fCurrent ^= 1;
+        size_t rowBytes = info.minRowBytes();
+        void* pixels = fStorage[fCurrent].reset(info.computeByteSize(rowBytes),
+                                                SkAutoMalloc::kReuse_OnShrink);
+        return SkPixmap(info, pixels, rowBytes);
+    }
+
+private:
+    SkAutoMalloc fStorage[2];
+    int fCurrent = 0;
+};
+
+// Rescales with repeated bilinear or bicubic steps of at most 2x, then writes the result to
+// 'result'.
+bool rescale_in_steps(const SkBitmap& bmp,
+                      const SkPixmap& result,
+                      const SkIRect& srcRect,
+                      SkImage::RescaleGamma rescaleGamma,
+                      SkImage::RescaleMode rescaleMode) {
+    const SkImageInfo& resultInfo = result.info();
     int srcW = srcRect.width();
     int srcH = srcRect.height();
 
@@ -73,7 +119,7 @@ void SkRescaleAndReadPixels(SkBitmap bmp,
     };
     SkSamplingOptions sampling = rescaling_to_sampling(rescaleMode);
 
-    sk_sp<SkSurface> tempSurf;
+    StepBuffers buffers;
     sk_sp<SkImage> srcImage;
     int srcX = srcRect.fLeft;
     int srcY = srcRect.fTop;
@@ -86,14 +132,17 @@ void SkRescaleAndReadPixels(SkBitmap bmp,
         // Promote to F16 color type to preserve precision.
         auto ii = SkImageInfo::Make(srcW, srcH, kRGBA_F16_SkColorType, bmp.info().alphaType(),
                                     std::move(cs));
-        auto linearSurf = SkSurfaces::Raster(ii);
-        if (!linearSurf) {
-            callback(context, nullptr);
-            return;
+        SkPixmap linear = buffers.next(ii);
+        if (!linear.addr()) {
+            return false;
         }
-        linearSurf->getCanvas()->drawImage(bmp.asImage().get(), -srcX, -srcY, sampling, &paint);
-        tempSurf = std::move(linearSurf);
-        srcImage = tempSurf->makeImageSnapshot();
+        sk_sp<SkImage> bmpImage = bmp.asImage();
+        // This is an integer translate, so don't filter, which with a cubic would blur the
+        // pixels and pull in those outside of srcRect.
+        draw_in_bands(linear, [&](SkCanvas* canvas) {
+            canvas->drawImage(bmpImage.get(), -srcX, -srcY, SkSamplingOptions(), &paint);
+        });
+        srcImage = SkImages::RasterFromPixmap(linear, nullptr, nullptr);
         srcX = 0;
         srcY = 0;
         constraint = SkCanvas::kFast_SrcRectConstraint;
@@ -122,31 +171,72 @@ void SkRescaleAndReadPixels(SkBitmap bmp,
             }
             --stepsY;
         }
-        auto ii = srcImage->imageInfo().makeWH(nextW, nextH);
-        if (!stepsX && !stepsY) {
-            // Might as well fold conversion to final info in the last step.
-            ii = resultInfo;
+        // The last step draws straight into the result, folding in the conversion to its info.
+        SkPixmap next = result;
+        if (stepsX || stepsY) {
+            next = buffers.next(srcImage->imageInfo().makeWH(nextW, nextH));
+            if (!next.addr()) {
+                return false;
+            }
         }
-        auto next = SkSurfaces::Raster(ii);
-        if (!next) {
-            callback(context, nullptr);
-            return;
+        SkRect src = SkRect::Make(SkIRect::MakeXYWH(srcX, srcY, srcW, srcH));
+        draw_in_bands(next, [&](SkCanvas* canvas) {
+            canvas->drawImageRect(srcImage.get(), src, SkRect::MakeIWH(nextW, nextH), sampling,
+                                  &paint, constraint);
+        });
+        if (!stepsX && !stepsY) {
+            return true;
         }
-        next->getCanvas()->drawImageRect(
-                srcImage.get(), SkRect::Make(SkIRect::MakeXYWH(srcX, srcY, srcW, srcH)),
-                SkRect::MakeIWH(nextW, nextH), sampling, &paint, constraint);
-        tempSurf = std::move(next);
-        srcImage = tempSurf->makeImageSnapshot();
+        srcImage = SkImages::RasterFromPixmap(next, nullptr, nullptr);
         srcX = srcY = 0;
         srcW = nextW;
         srcH = nextH;
         constraint = SkCanvas::kFast_SrcRectConstraint;
     }
 
+    return srcImage->readPixels(nullptr, result, srcX, srcY);
+}
+
+// Rescales with a single separable Mitchell filter, which is what the repeated bicubic steps
+// approximate, on the default SkExecutor.
+bool resize_directly(const SkBitmap& bmp,
+                     const SkPixmap& result,
+                     const SkIRect& srcRect,
+                     SkImage::RescaleGamma rescaleGamma) {
+    SkPixmap src;
+    if (!bmp.pixmap().extractSubset(&src, srcRect)) {
+        return false;
+    }
+    SkImageResize::Options options;
+    options.fFilter = SkImageResize::Filter::kMitchell;
+    // As with the repeated steps, only linearize known, non-linear color spaces.
+    options.fLinearLight = rescaleGamma == SkImage::RescaleGamma::kLinear &&
+                           bmp.info().colorSpace() &&
+                           !bmp.info().colorSpace()->gammaIsLinear();
+    options.fExecutor = &SkExecutor::GetDefault();
+    return SkImageResize::Resize(src, result, options);
+}
+
+}  // namespace
+
+void SkRescaleAndReadPixels(SkBitmap bmp,
+                            const SkImageInfo& resultInfo,
+                            const SkIRect& srcRect,
+                            SkImage::RescaleGamma rescaleGamma,
+                            SkImage::RescaleMode rescaleMode,
+                            SkImage::ReadPixelsCallback callback,
+                            SkImage::ReadPixelsContext context) {
     size_t rowBytes = resultInfo.minRowBytes();
     std::unique_ptr<char[]> data(new char[resultInfo.height() * rowBytes]);
     SkPixmap pm(resultInfo, data.get(), rowBytes);
-    if (srcImage->readPixels(nullptr, pm, srcX, srcY)) {
+
+    // A single separable filter replaces the repeated bicubic steps when the size changes. It
+    // also shrinks with a cubic, where the steps have to fall back to bilinear.
+    bool scaling = resultInfo.dimensions() != srcRect.size();
+    bool success = (rescaleMode == SkImage::RescaleMode::kRepeatedCubic && scaling)
+                           ? resize_directly(bmp, pm, srcRect, rescaleGamma)
+                           : rescale_in_steps(bmp, pm, srcRect, rescaleGamma, rescaleMode);
+    if (success) {
         class Result : public SkImage::AsyncReadResult {
         public:
             Result(std::unique_ptr<const char[]> data, size_t rowBytes)
@@ -5,11 +5,15 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
 #include "src/base/SkTInternalLList.h"
+#include "src/base/SkTSort.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 
 using namespace skia_private;
@@ -29,6 +33,8 @@ class PoolDiscardableMemory;
 class DiscardableMemoryPool : public SkDiscardableMemoryPool {
 public:
     DiscardableMemoryPool(size_t budget);
+    DiscardableMemoryPool(sk_sp<DiscardableMemoryPool> parent, const char name[], size_t budget,
+                          int priority);
     ~DiscardableMemoryPool() override;
 
     std::unique_ptr<SkDiscardableMemory> make(size_t bytes);
@@ -43,6 +49,10 @@ public:
     /** purges all unlocked DMs */
     void dumpPool() override;
 
+    sk_sp<SkDiscardableMemoryPool> makeChildPool(const char name[], size_t budget,
+                                                 int priority) override;
+    void dumpMemoryStatistics(SkTraceMemoryDump*) override;
+
     #if SK_LAZY_CACHE_STATS  // Defined in SkDiscardableMemoryPool.h
     int getCacheHits() override { return fCacheHits; }
     int getCacheMisses() override { return fCacheMisses; }
@@ -54,19 +64,36 @@ public:
     #endif  // SK_LAZY_CACHE_STATS
 
 private:
+    // A child pool shares the mutex of its parent, which guards both of them.
+    DiscardableMemoryPool* root() { return fParent ? fParent.get() : this; }
+    SkMutex& mutex() { return this->root()->fMutex; }
+
+    const sk_sp<DiscardableMemoryPool> fParent;
+    const SkString fName;
+    const int    fPriority;
     SkMutex      fMutex;
     size_t       fBudget;
+    // The bytes of this pool's own DMs, and for a parent, also those of its children.
     size_t       fUsed;
+    size_t       fTotalUsed;
+    size_t       fPurged;
     SkTInternalLList<PoolDiscardableMemory> fList;
+    TArray<DiscardableMemoryPool*> fChildren;
 
+    /** Purges this pool's own unlocked DMs, least recently used first, until at least 'bytes'
+        have been freed. Returns the number of bytes freed. */
+    size_t purge(size_t bytes);
     /** Function called to free memory if needed */
     void dumpDownTo(size_t budget);
+    /** Purges this pool down to its budget, and then its parent down to the parent's budget. */
+    void enforceBudgets();
     /** called by DiscardableMemoryPool upon destruction */
     void removeFromPool(PoolDiscardableMemory* dm);
     /** called by DiscardableMemoryPool::lock() */
     bool lock(PoolDiscardableMemory* dm);
     /** called by DiscardableMemoryPool::unlock() */
     void unlock(PoolDiscardableMemory* dm);
+    void dumpStatistics(SkTraceMemoryDump*);
 
     friend class PoolDiscardableMemory;
 
@@ -125,8 +152,19 @@ void PoolDiscardableMemory::unlock() {
 ////////////////////////////////////////////////////////////////////////////////
 
 DiscardableMemoryPool::DiscardableMemoryPool(size_t budget)
-    : fBudget(budget)
-    , fUsed(0) {
+        : DiscardableMemoryPool(nullptr, "", budget, 0) {}
+
+DiscardableMemoryPool::DiscardableMemoryPool(sk_sp<DiscardableMemoryPool> parent,
+                                             const char name[],
+                                             size_t budget,
+                                             int priority)
+    : fParent(std::move(parent))
+    , fName(name)
+    , fPriority(priority)
+    , fBudget(budget)
+    , fUsed(0)
+    , fTotalUsed(0)
+    , fPurged(0) {
     #if SK_LAZY_CACHE_STATS
     fCacheHits = 0;
     fCacheMisses = 0;
@@ -135,25 +173,36 @@ DiscardableMemoryPool::DiscardableMemoryPool(size_t budget)
 DiscardableMemoryPool::~DiscardableMemoryPool() {
     // PoolDiscardableMemory objects that belong to this pool are
     // always deleted before deleting this pool since each one has a
-    // ref to the pool.
+    // ref to the pool. Likewise, child pools ref their parent.
     SkASSERT(fList.isEmpty());
+    SkASSERT(fChildren.empty());
+    if (fParent) {
+        SkAutoMutexExclusive autoMutexAcquire(this->mutex());
+        for (int i = 0; i < fParent->fChildren.size(); ++i) {
+            if (fParent->fChildren[i] == this) {
+                fParent->fChildren.removeShuffle(i);
+                break;
+            }
+        }
+    }
 }
 
-void DiscardableMemoryPool::dumpDownTo(size_t budget) {
-    fMutex.assertHeld();
-    if (fUsed <= budget) {
-        return;
-    }
+size_t DiscardableMemoryPool::purge(size_t bytes) {
+    this->mutex().assertHeld();
+    size_t freed = 0;
     using Iter = SkTInternalLList<PoolDiscardableMemory>::Iter;
     Iter iter;
     PoolDiscardableMemory* cur = iter.init(fList, Iter::kTail_IterStart);
-    while ((fUsed > budget) && (cur)) {
+    while ((freed < bytes) && (cur)) {
         if (!cur->fLocked) {
             PoolDiscardableMemory* dm = cur;
             SkASSERT(dm->fPointer != nullptr);
             dm->fPointer = nullptr;
             SkASSERT(fUsed >= dm->fBytes);
             fUsed -= dm->fBytes;
+            this->root()->fTotalUsed -= dm->fBytes;
+            fPurged += dm->fBytes;
+            freed += dm->fBytes;
             cur = iter.prev();
             // Purged DMs are taken out of the list.  This saves times
             // looking them up.  Purged DMs are NOT deleted.
@@ -162,6 +211,41 @@ void DiscardableMemoryPool::dumpDownTo(size_t budget) {
             cur = iter.prev();
         }
     }
+    return freed;
+}
+
+void DiscardableMemoryPool::dumpDownTo(size_t budget) {
+    this->mutex().assertHeld();
+    if (fParent) {
+        if (fUsed > budget) {
+            this->purge(fUsed - budget);
+        }
+        return;
+    }
+    if (fTotalUsed <= budget) {
+        return;
+    }
+    // Only purge as much as it takes to get back under budget, starting with the pools with the
+    // lowest priority.
+    TArray<DiscardableMemoryPool*> pools(fChildren);
+    pools.push_back(this);
+    SkTInsertionSort(pools.begin(), pools.size(),
+                     [](const DiscardableMemoryPool* a, const DiscardableMemoryPool* b) {
+                         return a->fPriority < b->fPriority;
+                     });
+    for (DiscardableMemoryPool* pool : pools) {
+        if (fTotalUsed <= budget) {
+            break;
+        }
+        pool->purge(fTotalUsed - budget);
+    }
+}
+
+void DiscardableMemoryPool::enforceBudgets() {
+    this->dumpDownTo(fBudget);
+    if (fParent) {
+        fParent->dumpDownTo(fParent->fBudget);
+    }
 }
 
 std::unique_ptr<SkDiscardableMemory> DiscardableMemoryPool::make(size_t bytes) {
@@ -170,19 +254,21 @@ std::unique_ptr<SkDiscardableMemory> DiscardableMemoryPool::make(size_t bytes) {
         return nullptr;
     }
     auto dm = std::make_unique<PoolDiscardableMemory>(sk_ref_sp(this), std::move(addr), bytes);
-    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    SkAutoMutexExclusive autoMutexAcquire(this->mutex());
     fList.addToHead(dm.get());
     fUsed += bytes;
-    this->dumpDownTo(fBudget);
+    this->root()->fTotalUsed += bytes;
+    this->enforceBudgets();
     return dm;
 }
 
 void DiscardableMemoryPool::removeFromPool(PoolDiscardableMemory* dm) {
-    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    SkAutoMutexExclusive autoMutexAcquire(this->mutex());
     // This is called by dm's destructor.
     if (dm->fPointer != nullptr) {
         SkASSERT(fUsed >= dm->fBytes);
         fUsed -= dm->fBytes;
+        this->root()->fTotalUsed -= dm->fBytes;
         fList.remove(dm);
     } else {
         SkASSERT(!fList.isInList(dm));
@@ -191,7 +277,7 @@ void DiscardableMemoryPool::removeFromPool(PoolDiscardableMemory* dm) {
 
 bool DiscardableMemoryPool::lock(PoolDiscardableMemory* dm) {
     SkASSERT(dm != nullptr);
-    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    SkAutoMutexExclusive autoMutexAcquire(this->mutex());
     if (nullptr == dm->fPointer) {
         // May have been purged while waiting for lock.
         #if SK_LAZY_CACHE_STATS
@@ -210,24 +296,62 @@ bool DiscardableMemoryPool::lock(PoolDiscardableMemory* dm) {
 
 void DiscardableMemoryPool::unlock(PoolDiscardableMemory* dm) {
     SkASSERT(dm != nullptr);
-    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    SkAutoMutexExclusive autoMutexAcquire(this->mutex());
     dm->fLocked = false;
-    this->dumpDownTo(fBudget);
+    this->enforceBudgets();
 }
 
 size_t DiscardableMemoryPool::getRAMUsed() {
-    return fUsed;
+    return fParent ? fUsed : fTotalUsed;
 }
 void DiscardableMemoryPool::setRAMBudget(size_t budget) {
-    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    SkAutoMutexExclusive autoMutexAcquire(this->mutex());
     fBudget = budget;
-    this->dumpDownTo(fBudget);
+    this->enforceBudgets();
 }
 void DiscardableMemoryPool::dumpPool() {
-    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    SkAutoMutexExclusive autoMutexAcquire(this->mutex());
     this->dumpDownTo(0);
 }
 
+sk_sp<SkDiscardableMemoryPool> DiscardableMemoryPool::makeChildPool(const char name[],
+                                                                    size_t budget,
+                                                                    int priority) {
+    if (fParent) {
+        return nullptr;
+    }
+    auto child = sk_make_sp<DiscardableMemoryPool>(sk_ref_sp(this), name, budget, priority);
+    SkAutoMutexExclusive autoMutexAcquire(fMutex);
+    fChildren.push_back(child.get());
+    return child;
+}
+
+void DiscardableMemoryPool::dumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    SkAutoMutexExclusive autoMutexAcquire(this->mutex());
+    this->dumpStatistics(dump);
+    for (DiscardableMemoryPool* child : fChildren) {
+        child->dumpStatistics(dump);
+    }
+}
+
+void DiscardableMemoryPool::dumpStatistics(SkTraceMemoryDump* dump) {
+    this->mutex().assertHeld();
+    SkString dumpName("skia/discardable_memory_pool");
+    if (fParent) {
+        dumpName.appendf("/%s", fName.c_str());
+    }
+    dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", fUsed);
+    dump->dumpNumericValue(dumpName.c_str(), "budget_size", "bytes", fBudget);
+    dump->dumpNumericValue(dumpName.c_str(), "purged_size", "bytes", fPurged);
+    if (!fParent) {
+        dump->dumpNumericValue(dumpName.c_str(), "total_size", "bytes", fTotalUsed);
+    }
+    #if SK_LAZY_CACHE_STATS
+    dump->dumpNumericValue(dumpName.c_str(), "cache_hits", "objects", fCacheHits);
+    dump->dumpNumericValue(dumpName.c_str(), "cache_misses", "objects", fCacheMisses);
+    #endif  // SK_LAZY_CACHE_STATS
+}
+
 }  // namespace
 
 sk_sp<SkDiscardableMemoryPool> SkDiscardableMemoryPool::Make(size_t size) {
@@ -8,9 +8,14 @@
 #ifndef SkDiscardableMemoryPool_DEFINED
 #define SkDiscardableMemoryPool_DEFINED
 
+#include "include/core/SkRefCnt.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
 
+#include <cstddef>
+
+class SkTraceMemoryDump;
+
 #ifndef SK_LAZY_CACHE_STATS
     #ifdef SK_DEBUG
         #define SK_LAZY_CACHE_STATS 1
@@ -24,6 +29,12 @@
  *  budget of memory.  When the allocated memory exceeds this size,
  *  unlocked blocks of memory are purged.  If all memory is locked, it
  *  can exceed the memory-use budget.
+ *
+ *  A pool can have named child pools, for example one per client, that
+ *  allocate from it with budgets of their own. A child that goes over its
+ *  budget only purges its own memory. When the pool and its children
+ *  together go over the pool's budget, memory is purged from the lowest
+ *  priority pools first, least recently used first within each pool.
  */
 class SkDiscardableMemoryPool : public SkDiscardableMemory::Factory {
 public:
@@ -34,6 +45,23 @@ public:
     /** purges all unlocked DMs */
     virtual void dumpPool() = 0;
 
+    /**
+     *  Returns a new pool whose memory also counts against this pool's
+     *  budget. Pools with a lower priority are purged first when this pool
+     *  is over budget; this pool's own memory has priority 0. Returns
+     *  nullptr if this pool is itself a child pool, since pools only nest
+     *  one level deep.
+     */
+    virtual sk_sp<SkDiscardableMemoryPool> makeChildPool(const char name[],
+                                                         size_t budget,
+                                                         int priority) = 0;
+
+    /**
+     *  Dumps the memory used, budget and purged bytes of this pool and of
+     *  each of its child pools under "skia/discardable_memory_pool".
+     */
+    virtual void dumpMemoryStatistics(SkTraceMemoryDump*) = 0;
+
     #if SK_LAZY_CACHE_STATS
     /**
      * These two values are a count of the number of successful and
@@ -69,7 +69,7 @@ using NoCtx = const void*;
 
 #if defined(JUMPER_IS_SCALAR) || defined(JUMPER_IS_NEON) || defined(JUMPER_IS_HSW) || \
         defined(JUMPER_IS_SKX) || defined(JUMPER_IS_AVX) || defined(JUMPER_IS_SSE41) || \
-        defined(JUMPER_IS_SSE2)
+        defined(JUMPER_IS_SSE2) || defined(JUMPER_IS_WASM)
     // Honor the existing setting
 #elif !defined(__clang__) && !defined(__GNUC__)
     #define JUMPER_IS_SCALAR
@@ -89,6 +89,8 @@ using NoCtx = const void*;
     #define JUMPER_IS_LASX
 #elif SK_CPU_LSX_LEVEL >= SK_CPU_LSX_LEVEL_LSX
     #define JUMPER_IS_LSX
+#elif defined(__wasm_simd128__)
+    #define JUMPER_IS_WASM
 #else
     #define JUMPER_IS_SCALAR
 #endif
@@ -116,6 +118,8 @@ using NoCtx = const void*;
     #include <lsxintrin.h>
 #elif defined(JUMPER_IS_LSX)
     #include <lsxintrin.h>
+#elif defined(JUMPER_IS_WASM)
+    #include <wasm_simd128.h>
 #else
     #include <immintrin.h>
 #endif
@@ -911,6 +915,128 @@ namespace SK_OPTS_NS {
         _mm_storeu_ps(ptr +12, a);
     }
 
+#elif defined(JUMPER_IS_WASM)
+    template <typename T> using V = Vec<4, T>;
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    // Clang's vector extensions cover most of what we need, and wasm_simd128.h fills in the rest.
+    // The intrinsics all take and return v128_t, so we bit_cast to and from our typed vectors.
+    SI v128_t to_v128(F   v) { return sk_bit_cast<v128_t>(v); }
+    SI v128_t to_v128(I32 v) { return sk_bit_cast<v128_t>(v); }
+    SI v128_t to_v128(U32 v) { return sk_bit_cast<v128_t>(v); }
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return sk_bit_cast<F>(wasm_v128_bitselect(to_v128(t), to_v128(e), to_v128(c)));
+    }
+    SI I32 if_then_else(I32 c, I32 t, I32 e) {
+        return sk_bit_cast<I32>(wasm_v128_bitselect(to_v128(t), to_v128(e), to_v128(c)));
+    }
+
+    // pmin/pmax are the "pseudo" min and max, b < a ? b : a, which match _mm_min_ps/_mm_max_ps
+    // with the operands swapped, including returning b when either is NaN.
+    SI F   min(F a, F b)     { return sk_bit_cast<F>(wasm_f32x4_pmin(to_v128(b), to_v128(a))); }
+    SI F   max(F a, F b)     { return sk_bit_cast<F>(wasm_f32x4_pmax(to_v128(b), to_v128(a))); }
+    SI I32 min(I32 a, I32 b) { return sk_bit_cast<I32>(wasm_i32x4_min(to_v128(a), to_v128(b))); }
+    SI U32 min(U32 a, U32 b) { return sk_bit_cast<U32>(wasm_u32x4_min(to_v128(a), to_v128(b))); }
+    SI I32 max(I32 a, I32 b) { return sk_bit_cast<I32>(wasm_i32x4_max(to_v128(a), to_v128(b))); }
+    SI U32 max(U32 a, U32 b) { return sk_bit_cast<U32>(wasm_u32x4_max(to_v128(a), to_v128(b))); }
+
+    // There is no fused multiply-add in SIMD128, nor reciprocal or rsqrt estimates.
+    SI F   mad(F f, F m, F a)  { return a+f*m; }
+    SI F  nmad(F f, F m, F a)  { return a-f*m; }
+    SI F   abs_(F v)           { return sk_bit_cast<F>(wasm_f32x4_abs(to_v128(v))); }
+    SI I32 abs_(I32 v)         { return sk_bit_cast<I32>(wasm_i32x4_abs(to_v128(v))); }
+    SI F    sqrt_(F v)         { return sk_bit_cast<F>(wasm_f32x4_sqrt(to_v128(v))); }
+    SI F   rcp_approx(F v)     { return 1.0f / v; }  // use rcp_fast instead
+    SI F   rcp_precise (F v)   { return 1.0f / v; }
+    SI F   rsqrt_approx(F v)   { return 1.0f / sqrt_(v); }
+    SI F  floor_(F v)          { return sk_bit_cast<F>(wasm_f32x4_floor(to_v128(v))); }
+    SI F   ceil_(F v)          { return sk_bit_cast<F>(wasm_f32x4_ceil(to_v128(v))); }
+
+    // Round to nearest even, like _mm_cvtps_epi32() and vcvtnq_s32_f32().
+    SI I32 iround(F v) {
+        return sk_bit_cast<I32>(wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_nearest(to_v128(v))));
+    }
+    SI U32 round(F v)          { return sk_bit_cast<U32>(iround(v)); }
+    SI U32 round(F v, F scale) { return sk_bit_cast<U32>(iround(v*scale)); }
+
+    SI U16 pack(U32 v)       { return __builtin_convertvector(v, U16); }
+    SI U8  pack(U16 v)       { return __builtin_convertvector(v,  U8); }
+
+    SI bool any(I32 c) { return wasm_v128_any_true(to_v128(c)); }
+    SI bool all(I32 c) { return wasm_i32x4_all_true(to_v128(c)); }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return V<T>{p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]]};
+    }
+    SI void scatter_masked(I32 src, int* dst, U32 ix, I32 mask) {
+        I32 before = gather(dst, ix);
+        I32 after = if_then_else(mask, src, before);
+        dst[ix[0]] = after[0];
+        dst[ix[1]] = after[1];
+        dst[ix[2]] = after[2];
+        dst[ix[3]] = after[3];
+    }
+    SI void load2(const uint16_t* ptr, U16* r, U16* g) {
+        auto rg = sk_unaligned_load<Vec<8, uint16_t>>(ptr);  // r0 g0 r1 g1 r2 g2 r3 g3
+        *r = __builtin_shufflevector(rg, rg, 0, 2, 4, 6);
+        *g = __builtin_shufflevector(rg, rg, 1, 3, 5, 7);
+    }
+    SI void store2(uint16_t* ptr, U16 r, U16 g) {
+        Vec<8, uint16_t> rg = __builtin_shufflevector(r, g, 0, 4, 1, 5, 2, 6, 3, 7);
+        sk_unaligned_store(ptr, rg);
+    }
+
+    SI void load4(const uint16_t* ptr, U16* r, U16* g, U16* b, U16* a) {
+        auto rgba = sk_unaligned_load<Vec<16, uint16_t>>(ptr);  // r0 g0 b0 a0 r1 g1 b1 a1 ...
+        *r = __builtin_shufflevector(rgba, rgba, 0, 4,  8, 12);
+        *g = __builtin_shufflevector(rgba, rgba, 1, 5,  9, 13);
+        *b = __builtin_shufflevector(rgba, rgba, 2, 6, 10, 14);
+        *a = __builtin_shufflevector(rgba, rgba, 3, 7, 11, 15);
+    }
+
+    SI void store4(uint16_t* ptr, U16 r, U16 g, U16 b, U16 a) {
+        Vec<8, uint16_t> rg = __builtin_shufflevector(r, g, 0, 4, 1, 5, 2, 6, 3, 7),
+                         ba = __builtin_shufflevector(b, a, 0, 4, 1, 5, 2, 6, 3, 7);
+        Vec<16, uint16_t> rgba = __builtin_shufflevector(rg, ba, 0, 1,  8,  9, 2, 3, 10, 11,
+                                                                 4, 5, 12, 13, 6, 7, 14, 15);
+        sk_unaligned_store(ptr, rgba);
+    }
+
+    // Transposes a 4x4 matrix of floats held in four rows.
+    SI void transpose4(F* _0, F* _1, F* _2, F* _3) {
+        F rg01 = __builtin_shufflevector(*_0, *_1, 0, 4, 1, 5),  // r0 r1 g0 g1
+          ba01 = __builtin_shufflevector(*_0, *_1, 2, 6, 3, 7),  // b0 b1 a0 a1
+          rg23 = __builtin_shufflevector(*_2, *_3, 0, 4, 1, 5),  // r2 r3 g2 g3
+          ba23 = __builtin_shufflevector(*_2, *_3, 2, 6, 3, 7);  // b2 b3 a2 a3
+        *_0 = __builtin_shufflevector(rg01, rg23, 0, 1, 4, 5);
+        *_1 = __builtin_shufflevector(rg01, rg23, 2, 3, 6, 7);
+        *_2 = __builtin_shufflevector(ba01, ba23, 0, 1, 4, 5);
+        *_3 = __builtin_shufflevector(ba01, ba23, 2, 3, 6, 7);
+    }
+
+    SI void load4(const float* ptr, F* r, F* g, F* b, F* a) {
+        *r = sk_unaligned_load<F>(ptr + 0);
+        *g = sk_unaligned_load<F>(ptr + 4);
+        *b = sk_unaligned_load<F>(ptr + 8);
+        *a = sk_unaligned_load<F>(ptr +12);
+        transpose4(r, g, b, a);
+    }
+
+    SI void store4(float* ptr, F r, F g, F b, F a) {
+        transpose4(&r, &g, &b, &a);
+        sk_unaligned_store(ptr + 0, r);
+        sk_unaligned_store(ptr + 4, g);
+        sk_unaligned_store(ptr + 8, b);
+        sk_unaligned_store(ptr +12, a);
+    }
+
 #elif defined(JUMPER_IS_LASX)
     // These are __m256 and __m256i, but friendlier and strongly-typed.
     template <typename T> using V = Vec<8, T>;
@@ -1504,8 +1630,10 @@ static constexpr size_t N = sizeof(F) / sizeof(float);
     // instead of {b,a} on the stack.  Narrow stages work best for __vectorcall.
     #define ABI __vectorcall
     #define JUMPER_NARROW_STAGES 1
-#elif defined(__x86_64__) || defined(SK_CPU_ARM64) || defined(SK_CPU_LOONGARCH)
+#elif defined(__x86_64__) || defined(SK_CPU_ARM64) || defined(SK_CPU_LOONGARCH) || \
+        defined(JUMPER_IS_WASM)
     // These platforms are ideal for wider stages, and their default ABI is ideal.
+    // (WebAssembly passes arguments as locals, so there is no register pressure to worry about.)
     #define ABI
     #define JUMPER_NARROW_STAGES 0
 #else
@@ -2368,6 +2496,13 @@ STAGE(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     store(ptr, dst);
 }
 
+// Fused stages are built by SkRasterPipeline from common sequences of the stages they call, and
+// must produce exactly the same results as that sequence.
+STAGE(uniform_srcover_rgba_8888, const SkRasterPipeline_UniformSrcoverCtx* ctx) {
+    uniform_color_k(ctx->color, dx,dy,base, r,g,b,a, dr,dg,db,da);
+    srcover_rgba_8888_k(ctx->dst, dx,dy,base, r,g,b,a, dr,dg,db,da);
+}
+
 SI F clamp_01_(F v) { return min(max(0.0f, v), 1.0f); }
 
 STAGE(clamp_01, NoCtx) {
@@ -2716,6 +2851,13 @@ STAGE(byte_tables, const SkRasterPipeline_TablesCtx* tables) {
     a = from_byte(gather(tables->a, to_unorm(a, 255)));
 }
 
+// r,g,b are 8-bit unorm values (k/255); replace each with table[k], e.g. a transfer function.
+STAGE(byte_tf, const float* table) {
+    r = gather(table, to_unorm(r, 255));
+    g = gather(table, to_unorm(g, 255));
+    b = gather(table, to_unorm(b, 255));
+}
+
 SI F strip_sign(F x, U32* sign) {
     U32 bits = sk_bit_cast<U32>(x);
     *sign = bits & 0x80000000;
@@ -2908,6 +3050,11 @@ STAGE(store_8888, const SkRasterPipeline_MemoryCtx* ctx) {
            | to_unorm(a, 255) << 24;
     store(ptr, px);
 }
+STAGE(load_dst_srcover_store_8888, const SkRasterPipeline_MemoryCtx* ctx) {
+    load_8888_dst_k(ctx, dx,dy,base, r,g,b,a, dr,dg,db,da);
+    srcover_k(nullptr, dx,dy,base, r,g,b,a, dr,dg,db,da);
+    store_8888_k(ctx, dx,dy,base, r,g,b,a, dr,dg,db,da);
+}
 
 STAGE(load_rg88, const SkRasterPipeline_MemoryCtx* ctx) {
     auto ptr = ptr_at_xy<const uint16_t>(ctx, dx, dy);
@@ -3343,6 +3490,14 @@ STAGE(matrix_2x3, const float* m) {
     r = R;
     g = G;
 }
+STAGE(seed_shader_matrix_scale_translate, const float* m) {
+    seed_shader_k(nullptr, dx,dy,base, r,g,b,a, dr,dg,db,da);
+    matrix_scale_translate_k(m, dx,dy,base, r,g,b,a, dr,dg,db,da);
+}
+STAGE(seed_shader_matrix_2x3, const float* m) {
+    seed_shader_k(nullptr, dx,dy,base, r,g,b,a, dr,dg,db,da);
+    matrix_2x3_k(m, dx,dy,base, r,g,b,a, dr,dg,db,da);
+}
 STAGE(matrix_3x3, const float* m) {
     auto R = mad(r,m[0], mad(g,m[3], b*m[6])),
          G = mad(r,m[1], mad(g,m[4], b*m[7])),
@@ -3390,7 +3545,18 @@ STAGE(matrix_perspective, const float* m) {
 SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         F* r, F* g, F* b, F* a) {
     F fr, br, fg, bg, fb, bb, fa, ba;
-#if defined(JUMPER_IS_HSW)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        fr = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[0]));
+        br = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[0]));
+        fg = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[1]));
+        bg = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[1]));
+        fb = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[2]));
+        bb = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[2]));
+        fa = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[3]));
+        ba = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[3]));
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         fr = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->fs[0]), (__m256i)idx);
         br = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->bs[0]), (__m256i)idx);
@@ -3468,6 +3634,18 @@ STAGE(evenly_spaced_2_stop_gradient, const SkRasterPipeline_EvenlySpaced2StopGra
     a = mad(t, c->f[3], c->b[3]);
 }
 
+STAGE(gradient_ramp, const SkRasterPipeline_GradientRampCtx* c) {
+    // Clamp t to [0,1], sending NaN to 0, then lerp between the two nearest ramp entries.
+    F x = min(max(if_then_else(r == r, r, F0), 0.0f), 1.0f) * (float)(c->count - 1);
+    U32 i0 = trunc_(x),
+        i1 = i0 + 1;
+    F f = x - floor_(x);
+    r = lerp(gather(c->rgba[0], i0), gather(c->rgba[0], i1), f);
+    g = lerp(gather(c->rgba[1], i0), gather(c->rgba[1], i1), f);
+    b = lerp(gather(c->rgba[2], i0), gather(c->rgba[2], i1), f);
+    a = lerp(gather(c->rgba[3], i0), gather(c->rgba[3], i1), f);
+}
+
 STAGE(xy_to_unit_angle, NoCtx) {
     F X = r,
       Y = g;
@@ -4748,6 +4926,14 @@ DECLARE_IMM_BINARY_FLOAT(cmple) DECLARE_IMM_BINARY_INT(cmple) DECLARE_IMM_BINARY
 DECLARE_IMM_BINARY_FLOAT(cmpeq) DECLARE_IMM_BINARY_INT(cmpeq)
 DECLARE_IMM_BINARY_FLOAT(cmpne) DECLARE_IMM_BINARY_INT(cmpne)
 
+// A multiply by an immediate, immediately followed by an add of an immediate (as in `x * 2 - 1`),
+// is common enough to have a fused op.
+STAGE_TAIL(mad_imm_float, SkRasterPipeline_MultiplyAddConstantCtx* packed) {
+    auto ctx = SkRPCtxUtils::Unpack(packed);
+    F* dst = (F*)(base + ctx.dst);
+    dst[0] = mad(dst[0], sk_bit_cast<float>(ctx.mul), sk_bit_cast<float>(ctx.add));
+}
+
 #undef DECLARE_MULTI_IMM_BINARY_INT
 #undef DECLARE_IMM_BINARY_FLOAT
 #undef DECLARE_IMM_BINARY_INT
@@ -4948,11 +5134,31 @@ STAGE(gauss_a_to_rgba, NoCtx) {
     b = a;
 }
 
+// Samplers for the fused image shader stages below. ix_and_ptr() will clamp to the image's bounds.
+SI void sample_8888(const SkRasterPipeline_GatherCtx* ctx, F x, F y, F* r, F* g, F* b, F* a) {
+    const uint32_t* ptr;
+    U32 ix = ix_and_ptr(&ptr, ctx, x,y);
+    from_8888(gather(ptr, ix), r,g,b,a);
+}
+SI void sample_f16(const SkRasterPipeline_GatherCtx* ctx, F x, F y, F* r, F* g, F* b, F* a) {
+    const uint64_t* ptr;
+    U32 ix = ix_and_ptr(&ptr, ctx, x,y);
+    auto px = gather(ptr, ix);
+
+    U16 R,G,B,A;
+    load4((const uint16_t*)&px, &R,&G,&B,&A);
+    *r = from_half(R);
+    *g = from_half(G);
+    *b = from_half(B);
+    *a = from_half(A);
+}
+
 // A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
-STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+template <void (*sample)(const SkRasterPipeline_GatherCtx*, F, F, F*, F*, F*, F*)>
+SI void bilerp_clamp(const SkRasterPipeline_GatherCtx* ctx, F* r, F* g, F* b, F* a) {
     // (cx,cy) are the center of our sample.
-    F cx = r,
-      cy = g;
+    F cx = *r,
+      cy = *g;
 
     // All sample points are at the same fractional offset (fx,fy).
     // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
@@ -4960,7 +5166,7 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
       fy = fract(cy + 0.5f);
 
     // We'll accumulate the color of all four samples into {r,g,b,a} directly.
-    r = g = b = a = F0;
+    *r = *g = *b = *a = F0;
 
     for (float py = -0.5f; py <= +0.5f; py += 1.0f)
     for (float px = -0.5f; px <= +0.5f; px += 1.0f) {
@@ -4968,12 +5174,8 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         F x = cx + px,
           y = cy + py;
 
-        // ix_and_ptr() will clamp to the image's bounds for us.
-        const uint32_t* ptr;
-        U32 ix = ix_and_ptr(&ptr, ctx, x,y);
-
         F sr,sg,sb,sa;
-        from_8888(gather(ptr, ix), &sr,&sg,&sb,&sa);
+        sample(ctx, x,y, &sr,&sg,&sb,&sa);
 
         // In bilinear interpolation, the 4 pixels at +/- 0.5 offsets from the sample pixel center
         // are combined in direct proportion to their area overlapping that logical query pixel.
@@ -4983,18 +5185,19 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
           sy = (py > 0) ? fy : 1.0f - fy,
           area = sx * sy;
 
-        r += sr * area;
-        g += sg * area;
-        b += sb * area;
-        a += sa * area;
+        *r += sr * area;
+        *g += sg * area;
+        *b += sb * area;
+        *a += sa * area;
     }
 }
 
 // A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
-STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+template <void (*sample)(const SkRasterPipeline_GatherCtx*, F, F, F*, F*, F*, F*)>
+SI void bicubic_clamp(const SkRasterPipeline_GatherCtx* ctx, F* r, F* g, F* b, F* a) {
     // (cx,cy) are the center of our sample.
-    F cx = r,
-      cy = g;
+    F cx = *r,
+      cy = *g;
 
     // All sample points are at the same fractional offset (fx,fy).
     // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
@@ -5002,7 +5205,7 @@ STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
       fy = fract(cy + 0.5f);
 
     // We'll accumulate the color of all four samples into {r,g,b,a} directly.
-    r = g = b = a = F0;
+    *r = *g = *b = *a = F0;
 
     const float* w = ctx->weights;
     const F scaley[4] = {bicubic_wts(fy, w[0], w[4], w[ 8], w[12]),
@@ -5020,17 +5223,13 @@ STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         for (int xx = 0; xx <= 3; ++xx) {
             F scale = scalex[xx] * scaley[yy];
 
-            // ix_and_ptr() will clamp to the image's bounds for us.
-            const uint32_t* ptr;
-            U32 ix = ix_and_ptr(&ptr, ctx, sample_x, sample_y);
-
             F sr,sg,sb,sa;
-            from_8888(gather(ptr, ix), &sr,&sg,&sb,&sa);
+            sample(ctx, sample_x, sample_y, &sr,&sg,&sb,&sa);
 
-            r = mad(scale, sr, r);
-            g = mad(scale, sg, g);
-            b = mad(scale, sb, b);
-            a = mad(scale, sa, a);
+            *r = mad(scale, sr, *r);
+            *g = mad(scale, sg, *g);
+            *b = mad(scale, sb, *b);
+            *a = mad(scale, sa, *a);
 
             sample_x += 1;
         }
@@ -5038,6 +5237,19 @@ STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     }
 }
 
+STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_clamp<sample_8888>(ctx, &r,&g,&b,&a);
+}
+STAGE(bilerp_clamp_f16, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_clamp<sample_f16>(ctx, &r,&g,&b,&a);
+}
+STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bicubic_clamp<sample_8888>(ctx, &r,&g,&b,&a);
+}
+STAGE(bicubic_clamp_f16, const SkRasterPipeline_GatherCtx* ctx) {
+    bicubic_clamp<sample_f16>(ctx, &r,&g,&b,&a);
+}
+
 // ~~~~~~ skgpu::Swizzle stage ~~~~~~ //
 
 STAGE(swizzle, void* ctx) {
@@ -5474,6 +5686,10 @@ SI F sqrt_(F x) {
     __m128 lo,hi;
     split(x, &lo,&hi);
     return join<F>(__lsx_vfsqrt_s(lo), __lsx_vfsqrt_s(hi));
+#elif defined(JUMPER_IS_WASM)
+    v128_t lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(wasm_f32x4_sqrt(lo), wasm_f32x4_sqrt(hi));
 #else
     return F{
         sqrtf(x[0]), sqrtf(x[1]), sqrtf(x[2]), sqrtf(x[3]),
@@ -5505,6 +5721,10 @@ SI F floor_(F x) {
     __m128 lo,hi;
     split(x, &lo,&hi);
     return join<F>(__lsx_vfrintrm_s(lo), __lsx_vfrintrm_s(hi));
+#elif defined(JUMPER_IS_WASM)
+    v128_t lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(wasm_f32x4_floor(lo), wasm_f32x4_floor(hi));
 #else
     F roundtrip = cast<F>(cast<I32>(x));
     return roundtrip - if_then_else(roundtrip > x, F_(1), F_(0));
@@ -5515,7 +5735,7 @@ SI F floor_(F x) {
 // this multiply is:
 //     (2 * a * b + (1 << 15)) >> 16
 // The result is a number on [-1, 1).
-// Note: on neon this is a saturating multiply while the others are not.
+// Note: on neon and wasm this is a saturating multiply while the others are not.
 SI I16 scaled_mult(I16 a, I16 b) {
 #if defined(JUMPER_IS_SKX)
     return (I16)_mm256_mulhrs_epi16((__m256i)a, (__m256i)b);
@@ -5533,6 +5753,9 @@ SI I16 scaled_mult(I16 a, I16 b) {
 #elif defined(JUMPER_IS_LSX)
     I16 res = __lsx_vmuh_h(a, b);
     return __lsx_vslli_h(res, 1);
+#elif defined(JUMPER_IS_WASM)
+    // Like NEON, this saturates.
+    return sk_bit_cast<I16>(wasm_i16x8_q15mulr_sat(sk_bit_cast<v128_t>(a), sk_bit_cast<v128_t>(b)));
 #else
     const I32 roundingTerm = I32_(1 << 14);
     return cast<I16>((cast<I32>(a) * cast<I32>(b) + roundingTerm) >> 15);
@@ -6329,7 +6552,18 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         U16* r, U16* g, U16* b, U16* a) {
 
     F fr, fg, fb, fa, br, bg, bb, ba;
-#if defined(JUMPER_IS_HSW)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        fr = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[0]));
+        br = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[0]));
+        fg = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[1]));
+        bg = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[1]));
+        fb = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[2]));
+        bb = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[2]));
+        fa = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[3]));
+        ba = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[3]));
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         __m256i lo, hi;
         split(idx, &lo, &hi);
@@ -6440,6 +6674,23 @@ STAGE_GP(evenly_spaced_2_stop_gradient, const SkRasterPipeline_EvenlySpaced2Stop
                    &r,&g,&b,&a);
 }
 
+STAGE_GP(gradient_ramp, const SkRasterPipeline_GradientRampCtx* c) {
+    F t = min(max(if_then_else(x == x, x, 0.0f), 0.0f), 1.0f) * (float)(c->count - 1);
+    U32 i0 = trunc_(t),
+        i1 = i0 + 1;
+    F f = t - floor_(t);
+    auto lookup = [&](const float* ramp) {
+        F lo = gather<F>(ramp, i0),
+          hi = gather<F>(ramp, i1);
+        return mad(hi - lo, f, lo);
+    };
+    round_F_to_U16(lookup(c->rgba[0]),
+                   lookup(c->rgba[1]),
+                   lookup(c->rgba[2]),
+                   lookup(c->rgba[3]),
+                   &r,&g,&b,&a);
+}
+
 STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     // Quantize sample point and transform into lerp coordinates converting them to 16.16 fixed
     // point number.
@@ -6576,6 +6827,25 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     store_8888_(ptr, r,g,b,a);
 }
 
+// As in highp, these must match the sequence of stages they were fused from exactly.
+STAGE_PP(uniform_srcover_rgba_8888, const SkRasterPipeline_UniformSrcoverCtx* ctx) {
+    uniform_color_k(ctx->color, dx,dy, r,g,b,a, dr,dg,db,da);
+    srcover_rgba_8888_k(ctx->dst, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+STAGE_PP(load_dst_srcover_store_8888, const SkRasterPipeline_MemoryCtx* ctx) {
+    load_8888_dst_k(ctx, dx,dy, r,g,b,a, dr,dg,db,da);
+    srcover_k(nullptr, dx,dy, r,g,b,a, dr,dg,db,da);
+    store_8888_k(ctx, dx,dy, r,g,b,a, dr,dg,db,da);
+}
+STAGE_GG(seed_shader_matrix_scale_translate, const float* m) {
+    seed_shader_k(nullptr, dx,dy, x,y);
+    matrix_scale_translate_k(m, dx,dy, x,y);
+}
+STAGE_GG(seed_shader_matrix_2x3, const float* m) {
+    seed_shader_k(nullptr, dx,dy, x,y);
+    matrix_2x3_k(m, dx,dy, x,y);
+}
+
 // ~~~~~~ skgpu::Swizzle stage ~~~~~~ //
 
 STAGE_PP(swizzle, void* ctx) {
@@ -15,6 +15,7 @@
 #include "include/private/base/SkTDArray.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkPathEnums.h"
 #include "src/core/SkPathPriv.h"
 #include "src/pathops/SkOpContour.h"
@@ -25,7 +26,12 @@
 #include "src/pathops/SkPathOpsTypes.h"
 #include "src/pathops/SkPathWriter.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
@@ -210,3 +216,127 @@ bool SkOpBuilder::resolve(SkPath* result) {
     }
     return success;
 }
+
+bool SkOpBuilder::resolve(SkPath* result, SkExecutor* executor) {
+    const int count = fOps.size();
+    bool allUnion = executor && count > 1;
+    for (int index = 0; allUnion && index < count; ++index) {
+        allUnion = kUnion_SkPathOp == fOps[index] && !fPathRefs[index].isInverseFillType();
+    }
+    if (!allUnion) {
+        return this->resolve(result);
+    }
+
+    // Group the paths whose bounds overlap, directly or through other paths. The bounds of
+    // different groups don't overlap, so each group can be resolved on its own.
+    std::vector<int> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int index) {
+        while (parent[index] != index) {
+            index = parent[index] = parent[parent[index]];
+        }
+        return index;
+    };
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return fPathRefs[a].getBounds().fLeft < fPathRefs[b].getBounds().fLeft;
+    });
+    std::vector<int> active;  // paths that may still overlap the ones to their right
+    for (int index : order) {
+        const SkRect& bounds = fPathRefs[index].getBounds();
+        size_t kept = 0;
+        for (int other : active) {
+            const SkRect& otherBounds = fPathRefs[other].getBounds();
+            if (otherBounds.fRight < bounds.fLeft) {
+                continue;
+            }
+            active[kept++] = other;
+            if (otherBounds.fTop <= bounds.fBottom && bounds.fTop <= otherBounds.fBottom) {
+                parent[find(index)] = find(other);
+            }
+        }
+        active.resize(kept);
+        active.push_back(index);
+    }
+
+    std::vector<int> groupForRoot(count, -1);
+    std::vector<skia_private::TArray<SkPath>> groups;
+    for (int index = 0; index < count; ++index) {
+        int& group = groupForRoot[find(index)];
+        if (group < 0) {
+            group = SkToInt(groups.size());
+            groups.emplace_back();
+        }
+        groups[group].push_back(std::move(fPathRefs[index]));
+    }
+    this->reset();
+
+    // Paths that are alone in their group only need to be simplified. Larger groups are combined
+    // pairwise, one level at a time, until a single path is left.
+    SkTaskGroup taskGroup(*executor);
+    std::atomic<bool> failed{false};
+    std::vector<std::pair<int, int>> jobs;  // (group, pair index)
+    for (int group = 0; group < SkToInt(groups.size()); ++group) {
+        if (groups[group].size() == 1) {
+            jobs.emplace_back(group, 0);
+        }
+    }
+    taskGroup.batch(SkToInt(jobs.size()), [&](int job) {
+        SkPath& path = groups[jobs[job].first][0];
+        if (!Simplify(path, &path)) {
+            failed = true;
+        }
+    });
+    taskGroup.wait();
+
+    while (!failed) {
+        jobs.clear();
+        for (int group = 0; group < SkToInt(groups.size()); ++group) {
+            for (int pair = 0; 2 * pair + 1 < groups[group].size(); ++pair) {
+                jobs.emplace_back(group, pair);
+            }
+        }
+        if (jobs.empty()) {
+            break;
+        }
+        taskGroup.batch(SkToInt(jobs.size()), [&](int job) {
+            auto& [group, pair] = jobs[job];
+            skia_private::TArray<SkPath>& paths = groups[group];
+            if (!Op(paths[2 * pair], paths[2 * pair + 1], kUnion_SkPathOp, &paths[2 * pair])) {
+                failed = true;
+            }
+        });
+        taskGroup.wait();
+        for (skia_private::TArray<SkPath>& paths : groups) {
+            const int size = paths.size();
+            if (size > 1) {
+                for (int index = 1; 2 * index < size; ++index) {
+                    paths[index] = std::move(paths[2 * index]);
+                }
+                paths.resize_back((size + 1) / 2);
+            }
+        }
+    }
+    if (failed) {
+        return false;
+    }
+
+    if (groups.size() == 1) {
+        *result = std::move(groups[0][0]);
+        return true;
+    }
+    // Each group is simplified, and no two groups overlap, so their contours can be combined
+    // with the even-odd rule without changing what they cover.
+    SkPath sum;
+    sum.setFillType(SkPathFillType::kEvenOdd);
+    for (const skia_private::TArray<SkPath>& paths : groups) {
+        sum.addPath(paths[0]);
+    }
+    SkPath original = *result;
+    bool success = Simplify(sum, result);
+    if (!success) {
+        *result = original;
+    }
+    return success;
+}
@@ -7,15 +7,18 @@
 
 #include "src/pdf/SkDeflate.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 
 #include "zlib.h"  // NO_G3_REWRITE
 
@@ -113,6 +116,18 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
         return false;
     }
     const char* buffer = (const char*)void_buffer;
+    // When nothing is buffered, hand large writes to zlib directly rather than copying them
+    // through fInBuffer 4KB at a time.
+    if (0 == fImpl->fInBufferIndex) {
+        static constexpr size_t kMaxDirectWrite = 1 << 20;
+        while (len >= sizeof(fImpl->fInBuffer)) {
+            size_t chunk = std::min(len, kMaxDirectWrite);
+            do_deflate(Z_NO_FLUSH, &fImpl->fZStream, fImpl->fOut,
+                       (unsigned char*)const_cast<char*>(buffer), chunk);
+            len -= chunk;
+            buffer += chunk;
+        }
+    }
     while (len > 0) {
         size_t tocopy =
                 std::min(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
@@ -135,3 +150,114 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 size_t SkDeflateWStream::bytesWritten() const {
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Matches pigz: large enough that the per-block flush overhead is negligible, small enough to
+// spread a few megabytes across many threads.
+static constexpr size_t kParallelBlockSize = 128 * 1024;
+static constexpr size_t kDeflateWindowSize = 32 * 1024;
+
+// Compresses one block as raw deflate data. Every block but the last ends with a sync flush,
+// which byte-aligns the output without setting the final-block bit, so the blocks can simply be
+// concatenated.
+static bool deflate_block(const uint8_t* src, size_t size,
+                          const uint8_t* dictionary, size_t dictionarySize,
+                          bool last, int compressionLevel, SkWStream* out) {
+    z_stream zStream;
+    zStream.zalloc = &skia_alloc_func;
+    zStream.zfree = &skia_free_func;
+    zStream.opaque = nullptr;
+    zStream.next_in = nullptr;
+    zStream.avail_in = 0;
+    if (Z_OK != deflateInit2(&zStream, compressionLevel, Z_DEFLATED, -15, 8,
+                             Z_DEFAULT_STRATEGY)) {
+        return false;
+    }
+    bool ok = true;
+    if (dictionarySize > 0) {
+        ok = Z_OK == deflateSetDictionary(&zStream, dictionary, SkToUInt(dictionarySize));
+    }
+    zStream.next_in = const_cast<uint8_t*>(src);
+    zStream.avail_in = SkToUInt(size);
+    const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    unsigned char outBuffer[SKDEFLATEWSTREAM_OUTPUT_BUFFER_SIZE];
+    while (ok) {
+        zStream.next_out = outBuffer;
+        zStream.avail_out = sizeof(outBuffer);
+        int r = deflate(&zStream, flush);
+        ok = (r == Z_OK || r == Z_STREAM_END || r == Z_BUF_ERROR) &&
+             out->write(outBuffer, sizeof(outBuffer) - zStream.avail_out);
+        if (r == Z_STREAM_END || (zStream.avail_in == 0 && zStream.avail_out != 0)) {
+            break;
+        }
+    }
+    (void)deflateEnd(&zStream);
+    return ok;
+}
+
+bool SkDeflateParallel(const void* src, size_t size, SkWStream* dst, int compressionLevel,
+                       SkExecutor* executor) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    SkASSERT(compressionLevel != 0);
+    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+    if (!dst) {
+        return false;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(src);
+    const int blockCount = SkToInt(std::max<size_t>(1, (size + kParallelBlockSize - 1) /
+                                                       kParallelBlockSize));
+
+    struct Block {
+        SkDynamicMemoryWStream fCompressed;
+        uLong fAdler = 0;
+        bool fOk = false;
+    };
+    auto blocks = std::make_unique<Block[]>(blockCount);
+    auto compress = [&](int i) {
+        size_t offset = i * kParallelBlockSize;
+        size_t blockSize = std::min(kParallelBlockSize, size - offset);
+        size_t dictionarySize = std::min(offset, kDeflateWindowSize);
+        blocks[i].fOk = deflate_block(bytes + offset, blockSize,
+                                      bytes + offset - dictionarySize, dictionarySize,
+                                      i == blockCount - 1, compressionLevel,
+                                      &blocks[i].fCompressed);
+        blocks[i].fAdler = adler32(1, bytes + offset, SkToUInt(blockSize));
+    };
+    if (executor && blockCount > 1) {
+        SkTaskGroup tasks(*executor);
+        tasks.batch(blockCount, compress);
+        tasks.wait();
+    } else {
+        for (int i = 0; i < blockCount; ++i) {
+            compress(i);
+        }
+    }
+
+    // The zlib header zlib itself would write for this level (RFC 1950).
+    uint8_t header[2] = {0x78, 0x9C};
+    if (compressionLevel == 1) {
+        header[1] = 0x01;
+    } else if (compressionLevel >= 2 && compressionLevel <= 5) {
+        header[1] = 0x5E;
+    } else if (compressionLevel >= 7) {
+        header[1] = 0xDA;
+    }
+    if (!dst->write(header, sizeof(header))) {
+        return false;
+    }
+
+    uLong adler = 1;
+    for (int i = 0; i < blockCount; ++i) {
+        if (!blocks[i].fOk || !blocks[i].fCompressed.writeToAndReset(dst)) {
+            return false;
+        }
+        size_t blockSize = std::min(kParallelBlockSize, size - i * kParallelBlockSize);
+        adler = i == 0 ? blocks[i].fAdler
+                       : adler32_combine(adler, blocks[i].fAdler, (z_off_t)blockSize);
+    }
+    const uint8_t trailer[4] = {
+        (uint8_t)(adler >> 24), (uint8_t)(adler >> 16), (uint8_t)(adler >> 8), (uint8_t)adler,
+    };
+    return dst->write(trailer, sizeof(trailer));
+}
@@ -14,6 +14,8 @@
 
 #include <memory>
 
+class SkExecutor;
+
 /**
   * Wrap a stream in this class to compress the information written to
   * this stream using the Deflate algorithm.
@@ -53,4 +55,16 @@ private:
     std::unique_ptr<Impl> fImpl;
 };
 
+/**
+ *  Compresses all of src into a single zlib stream written to dst, like writing it to an
+ *  SkDeflateWStream, but splits the input into fixed-size blocks that are compressed in parallel on
+ *  the executor. Each block is primed with the 32KB of input preceding it, so the loss in
+ *  compression ratio is small; the block boundaries do not depend on scheduling, so the output is
+ *  deterministic. With a null executor the blocks are compressed serially.
+ *
+ *  Returns false if compression fails, in which case dst may have been partially written.
+ */
+bool SkDeflateParallel(const void* src, size_t size, SkWStream* dst, int compressionLevel,
+                       SkExecutor* executor);
+
 #endif  // SkFlate_DEFINED
@@ -54,6 +54,7 @@
 #include "src/core/SkDevice.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkImageContentHash.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkPaintPriv.h"
@@ -80,6 +81,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -1736,8 +1738,19 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     SkPDFIndirectReference pdfimage = pdfimagePtr ? *pdfimagePtr : SkPDFIndirectReference();
     if (!pdfimagePtr) {
         SkASSERT(imageSubset);
-        pdfimage = SkPDFSerializeImage(imageSubset.image().get(), fDocument,
-                                       fDocument->metadata().fEncodingQuality);
+        std::optional<uint64_t> contentHash = SkImageContentHash::Hash(imageSubset.image().get(),
+                                                                       fDocument->executor());
+        SkPDFIndirectReference* sameContentPtr =
+                contentHash ? fDocument->fPDFImageContentMap.find(*contentHash) : nullptr;
+        if (sameContentPtr) {
+            pdfimage = *sameContentPtr;
+        } else {
+            pdfimage = SkPDFSerializeImage(imageSubset.image().get(), fDocument,
+                                           fDocument->metadata().fEncodingQuality);
+            if (contentHash) {
+                fDocument->fPDFImageContentMap.set(*contentHash, pdfimage);
+            }
+        }
         SkASSERT((key != SkBitmapKey{{0, 0, 0, 0}, 0}));
         fDocument->fPDFBitmapMap.set(key, pdfimage);
     }
@@ -158,62 +158,90 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF\n");
 }
 
+// PDF wants a tree describing all the pages in the document.  We arbitrary
+// choose 8 (kMaxNodeSize) as the number of allowed children.  The internal
+// nodes have type "Pages" with an array of children, a parent pointer, and
+// the number of leaves below the node as "Count."  The leaves are the pages,
+// which have type "Page" and need a parent pointer. The tree is built bottom
+// up, skipping internal nodes that would have only one child.
+static constexpr size_t kMaxPageTreeNodeSize = 8;
+
+namespace {
+struct PageTreeNode {
+    std::unique_ptr<SkPDFDict> fNode;
+    SkPDFIndirectReference fReservedRef;
+    int fPageObjectDescendantCount;
+
+    static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
+        std::vector<PageTreeNode> result;
+        const size_t n = vec.size();
+        SkASSERT(n >= 1);
+        const size_t result_len = (n - 1) / kMaxPageTreeNodeSize + 1;
+        SkASSERT(result_len >= 1);
+        SkASSERT(n == 1 || result_len < n);
+        result.reserve(result_len);
+        size_t index = 0;
+        for (size_t i = 0; i < result_len; ++i) {
+            if (n != 1 && index + 1 == n) {  // No need to create a new node.
+                result.push_back(std::move(vec[index++]));
+                continue;
+            }
+            SkPDFIndirectReference parent = doc->reserveRef();
+            auto kids_list = SkPDFMakeArray();
+            int descendantCount = 0;
+            for (size_t j = 0; j < kMaxPageTreeNodeSize && index < n; ++j) {
+                PageTreeNode& node = vec[index++];
+                node.fNode->insertRef("Parent", parent);
+                kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
+                descendantCount += node.fPageObjectDescendantCount;
+            }
+            auto next = SkPDFMakeDict("Pages");
+            next->insertInt("Count", descendantCount);
+            next->insertObject("Kids", std::move(kids_list));
+            result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
+        }
+        return result;
+    }
+};
+}  // namespace
+
+static std::vector<PageTreeNode> make_leaves(std::vector<std::unique_ptr<SkPDFDict>> pages,
+                                             const SkPDFIndirectReference* pageRefs) {
+    std::vector<PageTreeNode> leaves;
+    leaves.reserve(pages.size());
+    for (size_t i = 0; i < pages.size(); ++i) {
+        leaves.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
+    }
+    return leaves;
+}
+
+// 'treeNodes' are the nodes of the lowest layer that were already written with their pages by
+// SkPDFDocument::onEndPage(), and 'pages' are the pages that ended after them.
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
+        std::vector<std::unique_ptr<SkPDFDict>> treeNodes,
+        const std::vector<SkPDFIndirectReference>& treeNodeRefs,
         std::vector<std::unique_ptr<SkPDFDict>> pages,
         const std::vector<SkPDFIndirectReference>& pageRefs) {
-    // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
-    SkASSERT(!pages.empty());
-    struct PageTreeNode {
-        std::unique_ptr<SkPDFDict> fNode;
-        SkPDFIndirectReference fReservedRef;
-        int fPageObjectDescendantCount;
-
-        static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
-            std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
-            const size_t n = vec.size();
-            SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
-            SkASSERT(result_len >= 1);
-            SkASSERT(n == 1 || result_len < n);
-            result.reserve(result_len);
-            size_t index = 0;
-            for (size_t i = 0; i < result_len; ++i) {
-                if (n != 1 && index + 1 == n) {  // No need to create a new node.
-                    result.push_back(std::move(vec[index++]));
-                    continue;
-                }
-                SkPDFIndirectReference parent = doc->reserveRef();
-                auto kids_list = SkPDFMakeArray();
-                int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
-                    PageTreeNode& node = vec[index++];
-                    node.fNode->insertRef("Parent", parent);
-                    kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
-                    descendantCount += node.fPageObjectDescendantCount;
-                }
-                auto next = SkPDFMakeDict("Pages");
-                next->insertInt("Count", descendantCount);
-                next->insertObject("Kids", std::move(kids_list));
-                result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
-            }
-            return result;
-        }
-    };
+    SkASSERT(!treeNodes.empty() || !pages.empty());
+    SkASSERT(treeNodes.size() == treeNodeRefs.size());
+    SkASSERT(treeNodes.size() * kMaxPageTreeNodeSize + pages.size() == pageRefs.size());
     std::vector<PageTreeNode> currentLayer;
-    currentLayer.reserve(pages.size());
-    SkASSERT(pages.size() == pageRefs.size());
-    for (size_t i = 0; i < pages.size(); ++i) {
-        currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
+    currentLayer.reserve(treeNodes.size() + 1);
+    for (size_t i = 0; i < treeNodes.size(); ++i) {
+        currentLayer.push_back(PageTreeNode{std::move(treeNodes[i]), treeNodeRefs[i],
+                                            (int)kMaxPageTreeNodeSize});
+    }
+    if (!pages.empty()) {
+        const SkPDFIndirectReference* leafRefs = pageRefs.data() + pageRefs.size() - pages.size();
+        std::vector<PageTreeNode> leaves = make_leaves(std::move(pages), leafRefs);
+        if (currentLayer.empty() || leaves.size() > 1) {
+            leaves = PageTreeNode::Layer(std::move(leaves), doc);
+        }  // else a single last page is a child of the next layer, as in Layer().
+        for (PageTreeNode& node : leaves) {
+            currentLayer.push_back(std::move(node));
+        }
     }
-    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
     while (currentLayer.size() > 1) {
         currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
     }
@@ -271,7 +299,7 @@ static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.h
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexExclusive autoMutexAcquire(fMutex);
@@ -400,6 +428,18 @@ void SkPDFDocument::onEndPage() {
     // 0-based page index.
     page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
     fPages.emplace_back(std::move(page));
+
+    if (fPages.size() == kMaxPageTreeNodeSize) {
+        // Write the pages as soon as they fill a node of the page tree, so that long documents
+        // don't keep every page dictionary until they are closed.
+        std::vector<PageTreeNode> node = PageTreeNode::Layer(
+                make_leaves(std::move(fPages), fPageRefs.data() + fPagesInTree), this);
+        SkASSERT(node.size() == 1);
+        fPageTreeNodes.push_back(std::move(node[0].fNode));
+        fPageTreeNodeRefs.push_back(node[0].fReservedRef);
+        fPagesInTree += kMaxPageTreeNodeSize;
+        fPages.clear();
+    }
 }
 
 void SkPDFDocument::onAbort() {
@@ -608,7 +648,7 @@ SkString SkPDFDocument::nextFontSubsetTag() {
 
 void SkPDFDocument::onClose(SkWStream* stream) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -621,7 +661,9 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    docCatalog->insertRef("Pages", generate_page_tree(this,
+                                                      std::move(fPageTreeNodes), fPageTreeNodeRefs,
+                                                      std::move(fPages), fPageRefs));
 
     if (!fNamedDestinations.empty()) {
         docCatalog->insertRef("Dests", append_destinations(this, fNamedDestinations));
@@ -152,7 +152,7 @@ public:
     SkExecutor* executor() const { return fExecutor; }
     void incrementJobCount();
     void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+    size_t currentPageIndex() { return fPagesInTree + fPages.size(); }
     size_t pageCount() { return fPageRefs.size(); }
 
     const SkMatrix& currentPageTransform() const;
@@ -165,6 +165,10 @@ public:
                            SkPDFIndirectReference,
                            SkPDFGradientShader::KeyHash> fGradientPatternMap;
     skia_private::THashMap<SkBitmapKey, SkPDFIndirectReference> fPDFBitmapMap;
+    // Images by SkImageContentHash, so distinct images with the same content are written once.
+    skia_private::THashMap<uint64_t, SkPDFIndirectReference> fPDFImageContentMap;
+    // Streams written by SkPDFStreamOutDeduped(), by a hash of their dictionary and content.
+    skia_private::THashMap<uint64_t, SkPDFIndirectReference> fStreamContentMap;
     skia_private::THashMap<SkPDFIccProfileKey,
                            SkPDFIndirectReference,
                            SkPDFIccProfileKey::Hash> fICCProfileMap;
@@ -188,8 +192,13 @@ public:
 private:
     SkPDFOffsetMap fOffsetMap;
     SkCanvas fCanvas;
+    // The pages that have ended since the last full node of the page tree was written.
     std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    // The full nodes of the page tree's lowest layer, whose pages have been written.
+    std::vector<std::unique_ptr<SkPDFDict>> fPageTreeNodes;
+    std::vector<SkPDFIndirectReference> fPageTreeNodeRefs;
+    size_t fPagesInTree = 0;
 
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
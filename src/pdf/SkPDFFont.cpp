@@ -28,12 +28,14 @@
 #include "include/core/SkString.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkBitmaskEnum.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"
@@ -111,6 +113,21 @@ static bool can_embed(const SkAdvancedTypefaceMetrics& metrics) {
     return !SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotEmbeddable_FontFlag);
 }
 
+// The metrics don't depend on the document, so they are made once per typeface and copied into
+// each document that uses it. Typeface IDs are never reused.
+static constexpr int kMaxCachedMetrics = 64;
+
+static SkMutex& metrics_cache_mutex() {
+    static SkMutex& mutex = *(new SkMutex);
+    return mutex;
+}
+
+static SkLRUCache<SkTypefaceID, std::unique_ptr<SkAdvancedTypefaceMetrics>>& metrics_cache() {
+    static auto& cache = *(new SkLRUCache<SkTypefaceID, std::unique_ptr<SkAdvancedTypefaceMetrics>>(
+            kMaxCachedMetrics));
+    return cache;
+}
+
 const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typeface,
                                                        SkPDFDocument* canon) {
     SkASSERT(typeface);
@@ -124,39 +141,51 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typefac
         canon->fTypefaceMetrics.set(id, nullptr);
         return nullptr;
     }
-    std::unique_ptr<SkAdvancedTypefaceMetrics> metrics = typeface->getAdvancedMetrics();
-    if (!metrics) {
-        metrics = std::make_unique<SkAdvancedTypefaceMetrics>();
+    std::unique_ptr<SkAdvancedTypefaceMetrics> metrics;
+    {
+        SkAutoMutexExclusive lock(metrics_cache_mutex());
+        if (std::unique_ptr<SkAdvancedTypefaceMetrics>* cached = metrics_cache().find(id)) {
+            metrics = std::make_unique<SkAdvancedTypefaceMetrics>(**cached);
+        }
     }
+    if (!metrics) {
+        metrics = typeface->getAdvancedMetrics();
+        if (!metrics) {
+            metrics = std::make_unique<SkAdvancedTypefaceMetrics>();
+        }
 
-    if (0 == metrics->fStemV || 0 == metrics->fCapHeight) {
-        SkFont font;
-        font.setHinting(SkFontHinting::kNone);
-        font.setTypeface(sk_ref_sp(typeface));
-        font.setSize(1000);  // glyph coordinate system
-        if (0 == metrics->fStemV) {
-            // Figure out a good guess for StemV - Min width of i, I, !, 1.
-            // This probably isn't very good with an italic font.
-            int16_t stemV = SHRT_MAX;
-            for (char c : {'i', 'I', '!', '1'}) {
-                uint16_t g = font.unicharToGlyph(c);
-                SkRect bounds;
-                font.getBounds(&g, 1, &bounds, nullptr);
-                stemV = std::min(stemV, SkToS16(SkScalarRoundToInt(bounds.width())));
+        if (0 == metrics->fStemV || 0 == metrics->fCapHeight) {
+            SkFont font;
+            font.setHinting(SkFontHinting::kNone);
+            font.setTypeface(sk_ref_sp(typeface));
+            font.setSize(1000);  // glyph coordinate system
+            if (0 == metrics->fStemV) {
+                // Figure out a good guess for StemV - Min width of i, I, !, 1.
+                // This probably isn't very good with an italic font.
+                int16_t stemV = SHRT_MAX;
+                for (char c : {'i', 'I', '!', '1'}) {
+                    uint16_t g = font.unicharToGlyph(c);
+                    SkRect bounds;
+                    font.getBounds(&g, 1, &bounds, nullptr);
+                    stemV = std::min(stemV, SkToS16(SkScalarRoundToInt(bounds.width())));
+                }
+                metrics->fStemV = stemV;
             }
-            metrics->fStemV = stemV;
-        }
-        if (0 == metrics->fCapHeight) {
-            // Figure out a good guess for CapHeight: average the height of M and X.
-            SkScalar capHeight = 0;
-            for (char c : {'M', 'X'}) {
-                uint16_t g = font.unicharToGlyph(c);
-                SkRect bounds;
-                font.getBounds(&g, 1, &bounds, nullptr);
-                capHeight += bounds.height();
+            if (0 == metrics->fCapHeight) {
+                // Figure out a good guess for CapHeight: average the height of M and X.
+                SkScalar capHeight = 0;
+                for (char c : {'M', 'X'}) {
+                    uint16_t g = font.unicharToGlyph(c);
+                    SkRect bounds;
+                    font.getBounds(&g, 1, &bounds, nullptr);
+                    capHeight += bounds.height();
+                }
+                metrics->fCapHeight = SkToS16(SkScalarRoundToInt(capHeight / 2));
             }
-            metrics->fCapHeight = SkToS16(SkScalarRoundToInt(capHeight / 2));
         }
+
+        SkAutoMutexExclusive lock(metrics_cache_mutex());
+        metrics_cache().insert_or_update(id, std::make_unique<SkAdvancedTypefaceMetrics>(*metrics));
     }
     // Fonts are always subset, so always prepend the subset tag.
     metrics->fPostScriptName.prepend(canon->nextFontSubsetTag());
@@ -317,18 +346,30 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                 if (!SkToBool(metrics.fFlags &
                               SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
                     SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(*face, font.glyphUsage());
-                    if (subsetFontData) {
-                        std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-                        tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
-                        descriptor->insertRef(
-                                "FontFile2",
-                                SkPDFStreamOut(std::move(tmp),
-                                               SkMemoryStream::Make(std::move(subsetFontData)),
-                                               doc, SkPDFSteamCompressionEnabled::Yes));
-                        break;
-                    }
-                    // If subsetting fails, fall back to original font data.
+                    // Subsetting is expensive, so do it (and the compression) on the
+                    // document's executor when there is one. The font outlives the job since
+                    // the document waits for all jobs before it is done with its fonts.
+                    const SkPDFFont* fontPtr = &font;
+                    SkPDFStreamGenerator subset = [fontPtr](SkPDFDict* dict)
+                            -> std::unique_ptr<SkStreamAsset> {
+                        SkTypeface* face = fontPtr->typeface();
+                        if (sk_sp<SkData> data = SkPDFSubsetFont(*face, fontPtr->glyphUsage())) {
+                            dict->insertInt("Length1", SkToInt(data->size()));
+                            return SkMemoryStream::Make(std::move(data));
+                        }
+                        // If subsetting fails, fall back to original font data.
+                        int unused;
+                        std::unique_ptr<SkStreamAsset> asset = face->openStream(&unused);
+                        if (!asset) {
+                            asset = std::make_unique<SkMemoryStream>();
+                        }
+                        dict->insertInt("Length1", asset->getLength());
+                        return asset;
+                    };
+                    descriptor->insertRef("FontFile2",
+                                          SkPDFStreamOut(nullptr, std::move(subset),
+                                                         doc, SkPDFSteamCompressionEnabled::Yes));
+                    break;
                 }
                 std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                 tmp->insertInt("Length1", fontSize);
@@ -39,5 +39,6 @@ SkPDFIndirectReference SkPDFMakeFormXObject(SkPDFDocument* doc,
     }
     group->insertBool("I", true);  // Isolated.
     dict->insertObject("Group", std::move(group));
-    return SkPDFStreamOut(std::move(dict), std::move(content), doc);
+    // Layers, masks and glyphs drawn the same way on many pages are written once.
+    return SkPDFStreamOutDeduped(std::move(dict), std::move(content), doc);
 }
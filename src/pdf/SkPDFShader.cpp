@@ -263,7 +263,9 @@ static SkPDFIndirectReference make_image_shader(SkPDFDocument* doc,
     std::unique_ptr<SkPDFDict> dict = SkPDFMakeDict();
     SkPDFUtils::PopulateTilingPatternDict(dict.get(), patternBBox,
                                           std::move(resourceDict), finalMatrix);
-    return SkPDFStreamOut(std::move(dict), std::move(imageShader), doc);
+    // The image is referenced by its content, so the same image (even from a different SkImage)
+    // tiled the same way makes the same pattern.
+    return SkPDFStreamOutDeduped(std::move(dict), std::move(imageShader), doc);
 }
 
 // Generic fallback for unsupported shaders:
@@ -10,8 +10,11 @@
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkLRUCache.h"
 #include "src/pdf/SkPDFGlyphUse.h"
 
 #include "hb.h"  // NO_G3_REWRITE
@@ -20,6 +23,7 @@
 #include <cstddef>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -103,10 +107,77 @@ sk_sp<SkData> subset_harfbuzz(const SkTypeface& typeface, const SkPDFGlyphUse& g
     return to_data(std::move(result));
 }
 
+// Documents made from the same fonts, like a batch of invoices, often use the same glyphs of the
+// same typefaces, so the subsets are kept for later documents. Typeface IDs are never reused.
+struct SubsetKey {
+    SkTypefaceID fTypefaceID;
+    std::vector<SkGlyphID> fGlyphs;
+
+    bool operator==(const SubsetKey& that) const {
+        return fTypefaceID == that.fTypefaceID && fGlyphs == that.fGlyphs;
+    }
+};
+
+struct SubsetKeyHash {
+    uint32_t operator()(const SubsetKey& key) const {
+        return SkChecksum::Hash32(key.fGlyphs.data(), key.fGlyphs.size() * sizeof(SkGlyphID),
+                                  key.fTypefaceID);
+    }
+};
+
+constexpr int kMaxCachedSubsets = 64;
+constexpr size_t kMaxCachedSubsetBytes = 16 * 1024 * 1024;
+
+class SubsetCache {
+public:
+    sk_sp<SkData> find(const SubsetKey& key) {
+        SkAutoMutexExclusive lock(fMutex);
+        sk_sp<SkData>* subset = fCache.find(key);
+        return subset ? *subset : nullptr;
+    }
+
+    void add(const SubsetKey& key, sk_sp<SkData> subset) {
+        if (subset->size() > kMaxCachedSubsetBytes) {
+            return;
+        }
+        SkAutoMutexExclusive lock(fMutex);
+        if (fCache.find(key)) {
+            return;
+        }
+        while (fCache.count() >= kMaxCachedSubsets ||
+               (fCache.count() > 0 && fBytes + subset->size() > kMaxCachedSubsetBytes)) {
+            fBytes -= (*fCache.peekLRU())->size();
+            fCache.removeLRU();
+        }
+        fBytes += subset->size();
+        fCache.insert(key, std::move(subset));
+    }
+
+private:
+    SkMutex fMutex;
+    SkLRUCache<SubsetKey, sk_sp<SkData>, SubsetKeyHash> fCache SK_GUARDED_BY(fMutex){
+            kMaxCachedSubsets};
+    size_t fBytes SK_GUARDED_BY(fMutex) = 0;
+};
+
+SubsetCache& subset_cache() {
+    static SubsetCache& cache = *(new SubsetCache);
+    return cache;
+}
+
 }  // namespace
 
 sk_sp<SkData> SkPDFSubsetFont(const SkTypeface& typeface, const SkPDFGlyphUse& glyphUsage) {
-    return subset_harfbuzz(typeface, glyphUsage);
+    SubsetKey key{typeface.uniqueID(), {}};
+    glyphUsage.getSetValues([&key](unsigned gid) { key.fGlyphs.push_back(SkToU16(gid)); });
+    if (sk_sp<SkData> subset = subset_cache().find(key)) {
+        return subset;
+    }
+    sk_sp<SkData> subset = subset_harfbuzz(typeface, glyphUsage);
+    if (subset) {
+        subset_cache().add(key, subset);
+    }
+    return subset;
 }
 
 #else
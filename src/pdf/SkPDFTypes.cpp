@@ -7,6 +7,7 @@
 
 #include "src/pdf/SkPDFTypes.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
@@ -15,6 +16,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/base/SkUTF.h"
 #include "src/base/SkUtils.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkStreamPriv.h"
 #include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
@@ -558,9 +560,22 @@ static void serialize_stream(SkPDFDict* origDict,
         stream->getLength() > kMinimumSavings)
     {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData,SkToInt(doc->metadata().fCompressionLevel));
-        SkStreamCopy(&deflateWStream, stream);
-        deflateWStream.finalize();
+        const int level = SkToInt(doc->metadata().fCompressionLevel);
+        // Big streams are split into blocks and compressed across the executor's threads.
+        static constexpr size_t kParallelDeflateThreshold = 1 << 20;
+        sk_sp<SkData> data;
+        if (doc->executor() && stream->getLength() >= kParallelDeflateThreshold &&
+            (data = SkCopyStreamToData(stream)) &&
+            SkDeflateParallel(data->data(), data->size(), &compressedData, level,
+                              doc->executor())) {
+            SkAssertResult(stream->rewind());
+        } else {
+            SkAssertResult(stream->rewind());
+            compressedData.reset();
+            SkDeflateWStream deflateWStream(&compressedData, level);
+            SkStreamCopy(&deflateWStream, stream);
+            deflateWStream.finalize();
+        }
         #ifdef SK_PDF_BASE85_BINARY
         {
             SkPDFUtils::Base85Encode(compressedData.detachAsStream(), &compressedData);
@@ -610,3 +625,60 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
     serialize_stream(dict.get(), content.get(), compress, doc, ref);
     return ref;
 }
+
+SkPDFIndirectReference SkPDFStreamOutDeduped(std::unique_ptr<SkPDFDict> dict,
+                                             std::unique_ptr<SkStreamAsset> content,
+                                             SkPDFDocument* doc,
+                                             SkPDFSteamCompressionEnabled compress) {
+    SkASSERT(dict);
+    SkASSERT(content);
+    SkDynamicMemoryWStream dictBytes;
+    dict->emitObject(&dictBytes);
+    sk_sp<SkData> dictData = dictBytes.detachAsData();
+    // Compressed and uncompressed copies of a stream are different objects.
+    uint64_t hash = SkChecksum::Hash64(dictData->data(), dictData->size(),
+                                       static_cast<uint64_t>(compress));
+    if (const void* memory = content->getMemoryBase()) {
+        hash = SkChecksum::Hash64(memory, content->getLength(), hash);
+    } else {
+        char buffer[4096];
+        while (size_t bytes = content->read(buffer, sizeof(buffer))) {
+            hash = SkChecksum::Hash64(buffer, bytes, hash);
+        }
+        SkAssertResult(content->rewind());
+    }
+
+    if (SkPDFIndirectReference* same = doc->fStreamContentMap.find(hash)) {
+        return *same;
+    }
+    SkPDFIndirectReference ref = SkPDFStreamOut(std::move(dict), std::move(content), doc, compress);
+    doc->fStreamContentMap.set(hash, ref);
+    return ref;
+}
+
+SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
+                                      SkPDFStreamGenerator generate,
+                                      SkPDFDocument* doc,
+                                      SkPDFSteamCompressionEnabled compress) {
+    SkASSERT(generate);
+    SkPDFIndirectReference ref = doc->reserveRef();
+    if (!dict) {
+        dict = SkPDFMakeDict();
+    }
+    if (SkExecutor* executor = doc->executor()) {
+        SkPDFDict* dictPtr = dict.release();
+        doc->incrementJobCount();
+        executor->add([dictPtr, generate = std::move(generate), compress, doc, ref]() {
+            std::unique_ptr<SkStreamAsset> content = generate(dictPtr);
+            SkASSERT(content);
+            serialize_stream(dictPtr, content.get(), compress, doc, ref);
+            delete dictPtr;
+            doc->signalJobComplete();
+        });
+        return ref;
+    }
+    std::unique_ptr<SkStreamAsset> content = generate(dict.get());
+    SkASSERT(content);
+    serialize_stream(dict.get(), content.get(), compress, doc, ref);
+    return ref;
+}
@@ -14,6 +14,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -206,4 +207,26 @@ SkPDFIndirectReference SkPDFStreamOut(
     std::unique_ptr<SkStreamAsset> stream,
     SkPDFDocument* doc,
     SkPDFSteamCompressionEnabled compress = SkPDFSteamCompressionEnabled::Default);
+
+// Like SkPDFStreamOut, but if the document already has a stream with the same dictionary and
+// content, returns a reference to that one instead of writing the same bytes again. For resources
+// that repeat from page to page, e.g. form XObjects for logos and table borders. The dictionary's
+// references must be to objects the document has already de-duped for this to find anything.
+SkPDFIndirectReference SkPDFStreamOutDeduped(
+    std::unique_ptr<SkPDFDict> dict,
+    std::unique_ptr<SkStreamAsset> stream,
+    SkPDFDocument* doc,
+    SkPDFSteamCompressionEnabled compress = SkPDFSteamCompressionEnabled::Default);
+
+// Produces the content of a stream, and may add entries (e.g. /Length1) to its dictionary.
+using SkPDFStreamGenerator = std::function<std::unique_ptr<SkStreamAsset>(SkPDFDict*)>;
+
+// Like SkPDFStreamOut, but the content is produced by calling `generate`. If the document has an
+// executor, both generating and compressing the content happen there, so expensive generators
+// (e.g. font subsetting) run in parallel. The generator must not touch the document.
+SkPDFIndirectReference SkPDFStreamOut(
+    std::unique_ptr<SkPDFDict> dict,
+    SkPDFStreamGenerator generate,
+    SkPDFDocument* doc,
+    SkPDFSteamCompressionEnabled compress = SkPDFSteamCompressionEnabled::Default);
 #endif
@@ -30,6 +30,7 @@
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkFontScanner.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskGamma.h"
 #include "src/core/SkScalerContext.h"
@@ -190,6 +191,8 @@ private:
     // RHEL 8             2.9.1
 };
 
+// Guards the library, and the opening and closing of faces. Each face has its own mutex for
+// everything else, since FreeType allows faces of one library to be used on different threads.
 static SkMutex& f_t_mutex() {
     static SkMutex& mutex = *(new SkMutex);
     return mutex;
@@ -207,6 +210,10 @@ public:
     FT_UShort fFTPaletteEntryCount = 0;
     std::unique_ptr<SkColor[]> fSkPalette;
 
+    // Must be locked to use fFace, its glyph slot, and any FT_Size made from it. Glyph loading
+    // for different typefaces doesn't contend on this, only for different sizes of one typeface.
+    SkMutex fMutex;
+
     static std::unique_ptr<FaceRec> Make(const SkTypeface_FreeType* typeface);
     ~FaceRec();
 
@@ -421,12 +428,19 @@ SkTypeface_FreeType::FaceRec::Make(const SkTypeface_FreeType* typeface) {
 class AutoFTAccess {
 public:
     AutoFTAccess(const SkTypeface_FreeType* tf) : fFaceRec(nullptr) {
-        f_t_mutex().acquire();
-        fFaceRec = tf->getFaceRec();
+        {
+            SkAutoMutexExclusive ac(f_t_mutex());
+            fFaceRec = tf->getFaceRec();
+        }
+        if (fFaceRec) {
+            fFaceRec->fMutex.acquire();
+        }
     }
 
     ~AutoFTAccess() {
-        f_t_mutex().release();
+        if (fFaceRec) {
+            fFaceRec->fMutex.release();
+        }
     }
 
     FT_Face face() { return fFaceRec ? fFaceRec->fFace.get() : nullptr; }
@@ -488,13 +502,13 @@ private:
     bool      fLCDIsVert;
 
     FT_Error setupSize();
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fMutex before calling this function.
     static bool getBoundsOfCurrentOutlineGlyph(FT_GlyphSlot glyph, SkRect* bounds);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fMutex before calling this function.
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
     static void updateGlyphBoundsIfSubpixel(const SkGlyph&, SkRect* bounds, bool subpixel);
     void updateGlyphBoundsIfLCD(GlyphMetrics* mx);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fMutex before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -897,14 +911,17 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-    fFaceRec = static_cast<SkTypeface_FreeType*>(this->getTypeface())->getFaceRec();
+    {
+        SkAutoMutexExclusive ac(f_t_mutex());
+        fFaceRec = static_cast<SkTypeface_FreeType*>(this->getTypeface())->getFaceRec();
+    }
 
     // load the font file
     if (nullptr == fFaceRec) {
         LOG_INFO("Could not create FT_Face.\n");
         return;
     }
+    SkAutoMutexExclusive ac(fFaceRec->fMutex);
 
     fLCDIsVert = SkToBool(fRec.fFlags & SkScalerContext::kLCD_Vertical_Flag);
 
@@ -1075,9 +1092,8 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface_FreeType> ty
 }
 
 SkScalerContext_FreeType::~SkScalerContext_FreeType() {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (fFTSize != nullptr) {
+        SkAutoMutexExclusive ac(fFaceRec->fMutex);
         FT_Done_Size(fFTSize);
     }
 
@@ -1088,7 +1104,7 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
     this face with other context (at different sizes).
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    f_t_mutex().assertHeld();
+    fFaceRec->fMutex.assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1168,7 +1184,7 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 
 SkScalerContext::GlyphMetrics SkScalerContext_FreeType::generateMetrics(const SkGlyph& glyph,
                                                                         SkArenaAlloc* alloc) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     GlyphMetrics mx(glyph.maskFormat());
 
@@ -1347,7 +1363,7 @@ SkScalerContext::GlyphMetrics SkScalerContext_FreeType::generateMetrics(const Sk
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph, void* imageBuffer) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         sk_bzero(imageBuffer, glyph.imageSize());
@@ -1420,7 +1436,7 @@ sk_sp<SkDrawable> SkScalerContext_FreeType::generateDrawable(const SkGlyph& glyp
     // It should be possible to draw the drawable straight out of the FT_Face. However, this would
     // mean locking each time any such drawable is drawn. To avoid locking, this implementation
     // creates drawables backed as pictures so that they can be played back later without locking.
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         return nullptr;
@@ -1471,7 +1487,7 @@ sk_sp<SkDrawable> SkScalerContext_FreeType::generateDrawable(const SkGlyph& glyp
 bool SkScalerContext_FreeType::generatePath(const SkGlyph& glyph, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fMutex);
 
     SkGlyphID glyphID = glyph.getGlyphID();
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
@@ -1513,7 +1529,7 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexExclusive ac(f_t_mutex());
+    SkAutoMutexExclusive ac(fFaceRec->fMutex);
 
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
@@ -1965,6 +1981,37 @@ void SkTypeface_FreeTypeStream::onGetFamilyName(SkString* familyName) const {
     *familyName = fFamilyName;
 }
 
+// Every SkData in the cache is a read-only mapping of a font file. Streams hold their own ref, so
+// evicting an entry only unmaps the file once no typeface is using it anymore.
+static constexpr int kSharedFontFileCacheCount = 64;
+
+std::unique_ptr<SkStreamAsset> SkTypeface_FreeType::MakeSharedFileStream(const char path[]) {
+    static SkMutex gMutex;
+    static SkLRUCache<SkString, sk_sp<SkData>> gCache(kSharedFontFileCacheCount);
+
+    SkString key(path);
+    {
+        SkAutoMutexExclusive lock(gMutex);
+        if (sk_sp<SkData>* data = gCache.find(key)) {
+            return SkMemoryStream::Make(*data);
+        }
+    }
+
+    sk_sp<SkData> data = SkData::MakeFromFileName(path);
+    if (!data) {
+        // The file could not be mapped, so fall back to reading it.
+        return SkStream::MakeFromFile(path);
+    }
+
+    SkAutoMutexExclusive lock(gMutex);
+    // Another thread may have mapped the file while this one was.
+    if (sk_sp<SkData>* existing = gCache.find(key)) {
+        return SkMemoryStream::Make(*existing);
+    }
+    gCache.insert(key, data);
+    return SkMemoryStream::Make(std::move(data));
+}
+
 std::unique_ptr<SkStreamAsset> SkTypeface_FreeTypeStream::onOpenStream(int* ttcIndex) const {
     *ttcIndex = fData->getIndex();
     return fData->getStream()->duplicate();
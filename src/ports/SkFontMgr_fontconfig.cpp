@@ -25,6 +25,7 @@
 #include "src/base/SkTSort.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkTypefaceCache.h"
@@ -447,7 +448,7 @@ public:
                 filename = resolvedFilename.c_str();
             }
         }
-        return SkStream::MakeFromFile(filename);
+        return SkTypeface_FreeType::MakeSharedFileStream(filename);
     }
 
     void onFilterRec(SkScalerContextRec* rec) const override {
@@ -686,6 +687,72 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         return face;
     }
 
+    // Fallback lookups are cached per (family, style, languages, block of 128 code points) since
+    // neighbouring characters nearly always resolve to the same font. A hit is only used if the
+    // typeface actually maps the character. Characters that no font covers are cached on their
+    // own. The set of fonts in fFC never changes, so the entries stay valid for the life of the
+    // font manager.
+    static constexpr int kFallbackCacheCount = 256;
+    static constexpr int kFallbackBlockShift = 7;
+    mutable SkMutex fFallbackCacheMutex;
+    mutable SkLRUCache<SkString, sk_sp<SkTypeface>> fFallbackCache
+            SK_GUARDED_BY(fFallbackCacheMutex){kFallbackCacheCount};
+
+    static SkString FallbackKey(const char familyName[], const SkFontStyle& style,
+                                const char* bcp47[], int bcp47Count, const char* unit) {
+        SkString key;
+        key.printf("%s|%d,%d,%d|", familyName ? familyName : "",
+                   style.weight(), style.width(), (int)style.slant());
+        for (int i = 0; i < bcp47Count; ++i) {
+            key.appendf("%s,", bcp47[i]);
+        }
+        key.append(unit);
+        return key;
+    }
+
+    sk_sp<SkTypeface> matchFamilyStyleCharacterUncached(const char familyName[],
+                                                        const SkFontStyle& style,
+                                                        const char* bcp47[],
+                                                        int bcp47Count,
+                                                        SkUnichar character) const {
+        SkAutoFcPattern font([&](){
+            FCLocker lock;
+
+            SkAutoFcPattern pattern;
+            if (familyName) {
+                FcValue familyNameValue;
+                familyNameValue.type = FcTypeString;
+                familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
+                FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
+            }
+            fcpattern_from_skfontstyle(style, pattern);
+
+            SkAutoFcCharSet charSet;
+            FcCharSetAddChar(charSet, character);
+            FcPatternAddCharSet(pattern, FC_CHARSET, charSet);
+
+            if (bcp47Count > 0) {
+                SkASSERT(bcp47);
+                SkAutoFcLangSet langSet;
+                for (int i = bcp47Count; i --> 0;) {
+                    FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
+                }
+                FcPatternAddLangSet(pattern, FC_LANG, langSet);
+            }
+
+            FcConfigSubstitute(fFC, pattern, FcMatchPattern);
+            FcDefaultSubstitute(pattern);
+
+            FcResult result;
+            SkAutoFcPattern font(FcFontMatch(fFC, pattern, &result));
+            if (!font || !FontAccessible(font) || !FontContainsCharacter(font, character)) {
+                font.reset();
+            }
+            return font;
+        }());
+        return createTypefaceFromFcPattern(std::move(font));
+    }
+
 public:
     /** Takes control of the reference to 'config'. */
     explicit SkFontMgr_fontconfig(FcConfig* config)
@@ -896,42 +963,34 @@ protected:
                                                   int bcp47Count,
                                                   SkUnichar character) const override
     {
-        SkAutoFcPattern font([&](){
-            FCLocker lock;
-
-            SkAutoFcPattern pattern;
-            if (familyName) {
-                FcValue familyNameValue;
-                familyNameValue.type = FcTypeString;
-                familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
-                FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
+        SkString blockKey = FallbackKey(familyName, style, bcp47, bcp47Count,
+                SkStringPrintf("b%X", (uint32_t)character >> kFallbackBlockShift).c_str());
+        SkString charKey = FallbackKey(familyName, style, bcp47, bcp47Count,
+                SkStringPrintf("c%X", (uint32_t)character).c_str());
+        sk_sp<SkTypeface> typeface;
+        {
+            SkAutoMutexExclusive lock(fFallbackCacheMutex);
+            if (sk_sp<SkTypeface>* missing = fFallbackCache.find(charKey)) {
+                SkASSERT(!*missing);
+                return nullptr;
             }
-            fcpattern_from_skfontstyle(style, pattern);
-
-            SkAutoFcCharSet charSet;
-            FcCharSetAddChar(charSet, character);
-            FcPatternAddCharSet(pattern, FC_CHARSET, charSet);
-
-            if (bcp47Count > 0) {
-                SkASSERT(bcp47);
-                SkAutoFcLangSet langSet;
-                for (int i = bcp47Count; i --> 0;) {
-                    FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
-                }
-                FcPatternAddLangSet(pattern, FC_LANG, langSet);
+            if (sk_sp<SkTypeface>* cached = fFallbackCache.find(blockKey)) {
+                typeface = *cached;
             }
+        }
+        if (typeface && typeface->unicharToGlyph(character)) {
+            return typeface;
+        }
 
-            FcConfigSubstitute(fFC, pattern, FcMatchPattern);
-            FcDefaultSubstitute(pattern);
-
-            FcResult result;
-            SkAutoFcPattern font(FcFontMatch(fFC, pattern, &result));
-            if (!font || !FontAccessible(font) || !FontContainsCharacter(font, character)) {
-                font.reset();
-            }
-            return font;
-        }());
-        return createTypefaceFromFcPattern(std::move(font));
+        typeface = this->matchFamilyStyleCharacterUncached(familyName, style, bcp47, bcp47Count,
+                                                           character);
+        SkAutoMutexExclusive lock(fFallbackCacheMutex);
+        if (typeface) {
+            fFallbackCache.insert(blockKey, typeface);
+        } else {
+            fFallbackCache.insert(charKey, nullptr);
+        }
+        return typeface;
     }
 
     sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset> stream,
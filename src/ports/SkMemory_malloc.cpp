@@ -9,6 +9,7 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFeatures.h"
 #include "include/private/base/SkMalloc.h"
+#include "src/base/SkMallocStats.h"
 
 #include <algorithm>
 #include <cstdlib>
@@ -77,13 +78,24 @@ void* sk_realloc_throw(void* addr, size_t size) {
         sk_free(addr);
         return nullptr;
     }
-    return throw_on_failure(size, realloc(addr, size));
+    if (!SkMallocStats::IsEnabled()) {
+        return throw_on_failure(size, realloc(addr, size));
+    }
+    if (addr != nullptr) {
+        SkMallocStats::RecordFree(sk_malloc_size(addr, 0));
+    }
+    void* p = throw_on_failure(size, realloc(addr, size));
+    SkMallocStats::RecordMalloc(sk_malloc_size(p, size));
+    return p;
 }
 
 void sk_free(void* p) {
     // The guard here produces a performance improvement across many tests, and many platforms.
     // Removing the check was tried in skia cl 588037.
     if (p != nullptr) {
+        if (SkMallocStats::IsEnabled()) {
+            SkMallocStats::RecordFree(sk_malloc_size(p, 0));
+        }
         free(p);
     }
 }
@@ -109,6 +121,9 @@ void* sk_malloc_flags(size_t size, unsigned flags) {
         (void)mallopt(M_THREAD_DISABLE_MEM_INIT, 0);
 #endif
     }
+    if (p != nullptr && SkMallocStats::IsEnabled()) {
+        SkMallocStats::RecordMalloc(sk_malloc_size(p, size));
+    }
     if (flags & SK_MALLOC_THROW) {
         return throw_on_failure(size, p);
     } else {
@@ -42,6 +42,14 @@ public:
     static constexpr SkTypeface::FactoryId FactoryId = SkSetFourByteTag('f','r','e','e');
     static sk_sp<SkTypeface> MakeFromStream(std::unique_ptr<SkStreamAsset>, const SkFontArguments&);
 
+    /**
+     *  Opens the font file at |path| as a memory stream over a mapping which is shared by every
+     *  stream of the same file in this process, so typefaces backed by the same file (and the
+     *  FT_Faces made from them) do not each map or read it. A small number of recently opened
+     *  files are kept mapped. Returns nullptr if the file cannot be opened.
+     */
+    static std::unique_ptr<SkStreamAsset> MakeSharedFileStream(const char path[]);
+
 protected:
     SkTypeface_FreeType(const SkFontStyle& style, bool isFixedPitch);
     ~SkTypeface_FreeType() override;
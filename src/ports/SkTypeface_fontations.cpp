@@ -19,9 +19,12 @@
 #include "include/pathops/SkPathOps.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkTHash.h"
 #include "src/ports/SkTypeface_fontations_priv.h"
 #include "src/ports/fontations/src/skpath_bridge.h"
 
+#include <array>
+
 namespace {
 
 [[maybe_unused]] static inline const constexpr bool kSkShowTextBlitCoverage = false;
@@ -291,11 +294,15 @@ bool SkTypeface_Fontations::onGlyphMaskNeedsCurrentColor() const {
 void SkTypeface_Fontations::onCharsToGlyphs(const SkUnichar* chars,
                                             int count,
                                             SkGlyphID glyphs[]) const {
-    sk_bzero(glyphs, count * sizeof(glyphs[0]));
-
-    for (int i = 0; i < count; ++i) {
-        glyphs[i] = fontations_ffi::lookup_glyph_or_zero(*fBridgeFontRef, *fMappingIndex, chars[i]);
+    if (count <= 0) {
+        return;
     }
+    // One call for all the characters, so that the charmap is looked up once instead of per
+    // character.
+    rust::Slice<const uint32_t> codepoints{reinterpret_cast<const uint32_t*>(chars),
+                                           SkToSizeT(count)};
+    rust::Slice<uint16_t> glyphSlice{glyphs, SkToSizeT(count)};
+    fontations_ffi::lookup_glyphs_or_zero(*fBridgeFontRef, *fMappingIndex, codepoints, glyphSlice);
 }
 int SkTypeface_Fontations::onCountGlyphs() const {
     return fontations_ffi::num_glyphs(*fBridgeFontRef);
@@ -311,6 +318,30 @@ void SkTypeface_Fontations::getGlyphToUnicodeMap(SkUnichar* codepointForGlyphMap
     fontations_ffi::fill_glyph_to_unicode_map(*fBridgeFontRef, codepointForGlyphSlice);
 }
 
+sk_sp<sk_fontations::SharedHintingInstance> SkTypeface_Fontations::getHintingInstance(
+        const sk_fontations::HintingInstanceKey& key) const {
+    {
+        SkAutoMutexExclusive lock(fHintingInstancesMutex);
+        if (sk_sp<sk_fontations::SharedHintingInstance>* instance = fHintingInstances.find(key)) {
+            return *instance;
+        }
+    }
+
+    // Made without holding the lock, so that other sizes aren't held up by this one.
+    auto instance = sk_make_sp<sk_fontations::SharedHintingInstance>(
+            key.fMono ? fontations_ffi::make_mono_hinting_instance(
+                                *fOutlines, key.fSize, *fBridgeNormalizedCoords)
+                      : fontations_ffi::make_hinting_instance(*fOutlines,
+                                                              key.fSize,
+                                                              *fBridgeNormalizedCoords,
+                                                              key.fLcdAntialiasing,
+                                                              key.fLcdOrientationVertical,
+                                                              key.fPreserveLinearMetrics));
+
+    SkAutoMutexExclusive lock(fHintingInstancesMutex);
+    return *fHintingInstances.insert_or_update(key, std::move(instance));
+}
+
 void SkTypeface_Fontations::onFilterRec(SkScalerContextRec* rec) const {
     // Opportunistic hinting downgrades copied from SkFontHost_FreeType.cpp
     SkFontHinting h = rec->getHinting();
@@ -363,62 +394,61 @@ public:
                                               ->getBridgeNormalizedCoords())
             , fOutlines(static_cast<SkTypeface_Fontations*>(this->getTypeface())->getOutlines())
             , fPalette(static_cast<SkTypeface_Fontations*>(this->getTypeface())->getPalette())
-            , fHintingInstance(fontations_ffi::no_hinting_instance()) {
+            , fHintingInstance(sk_make_sp<sk_fontations::SharedHintingInstance>(
+                      fontations_ffi::no_hinting_instance())) {
         fRec.getSingleMatrix(&fMatrix);
 
         SkVector scale;
         SkMatrix remainingMatrix;
         fRec.computeMatrices(
                 SkScalerContextRec::PreMatrixScale::kVertical, &scale, &remainingMatrix);
+        fScaleY = scale.fY;
 
+        const SkTypeface_Fontations* typeface =
+                static_cast<SkTypeface_Fontations*>(this->getTypeface());
         fDoLinearMetrics = this->isLinearMetrics();
         if (SkMask::kBW_Format == fRec.fMaskFormat) {
             if (fRec.getHinting() == SkFontHinting::kNone) {
-                fHintingInstance = fontations_ffi::no_hinting_instance();
                 fDoLinearMetrics = true;
             } else {
-                fHintingInstance = fontations_ffi::make_mono_hinting_instance(
-                        fOutlines, scale.fY, fBridgeNormalizedCoords);
+                fHintingInstance = typeface->getHintingInstance(
+                        {scale.fY, true /* mono */, false, false, false});
                 fDoLinearMetrics = false;
             }
         } else {
             switch (fRec.getHinting()) {
                 case SkFontHinting::kNone:
-                    fHintingInstance = fontations_ffi::no_hinting_instance();
                     fDoLinearMetrics = true;
                     break;
                 case SkFontHinting::kSlight:
                     // Unhinted metrics.
-                    fHintingInstance = fontations_ffi::make_hinting_instance(
-                            fOutlines,
-                            scale.fY,
-                            fBridgeNormalizedCoords,
-                            false /* do_lcd_antialiasing */,
-                            false /* lcd_orientation_vertical */,
-                            true /* preserve_linear_metrics */);
+                    fHintingInstance = typeface->getHintingInstance(
+                            {scale.fY,
+                             false /* mono */,
+                             false /* do_lcd_antialiasing */,
+                             false /* lcd_orientation_vertical */,
+                             true /* preserve_linear_metrics */});
                     fDoLinearMetrics = true;
                     break;
                 case SkFontHinting::kNormal:
                     // No hinting to subpixel coordinates.
-                    fHintingInstance = fontations_ffi::make_hinting_instance(
-                            fOutlines,
-                            scale.fY,
-                            fBridgeNormalizedCoords,
-                            false /* do_lcd_antialiasing */,
-                            false /* lcd_orientation_vertical */,
-                            fDoLinearMetrics /* preserve_linear_metrics */);
+                    fHintingInstance = typeface->getHintingInstance(
+                            {scale.fY,
+                             false /* mono */,
+                             false /* do_lcd_antialiasing */,
+                             false /* lcd_orientation_vertical */,
+                             fDoLinearMetrics /* preserve_linear_metrics */});
                     break;
                 case SkFontHinting::kFull:
                     // Attempt to make use of hinting to subpixel coordinates.
-                    fHintingInstance = fontations_ffi::make_hinting_instance(
-                            fOutlines,
-                            scale.fY,
-                            fBridgeNormalizedCoords,
-                            isLCD(fRec) /* do_lcd_antialiasing */,
-                            SkToBool(fRec.fFlags &
-                                     SkScalerContext::
-                                             kLCD_Vertical_Flag) /* lcd_orientation_vertical */,
-                            fDoLinearMetrics /* preserve_linear_metrics */);
+                    fHintingInstance = typeface->getHintingInstance(
+                            {scale.fY,
+                             false /* mono */,
+                             isLCD(fRec) /* do_lcd_antialiasing */,
+                             SkToBool(fRec.fFlags &
+                                      SkScalerContext::
+                                              kLCD_Vertical_Flag) /* lcd_orientation_vertical */,
+                             fDoLinearMetrics /* preserve_linear_metrics */});
             }
         }
     }
@@ -492,13 +522,11 @@ protected:
                     SkScalerContextRec::PreMatrixScale::kVertical, &scale, &remainingMatrix)) {
             return mx;
         }
-        float x_advance = 0.0f;
-        x_advance = fontations_ffi::unhinted_advance_width_or_zero(
-                fBridgeFontRef, scale.y(), fBridgeNormalizedCoords, glyph.getGlyphID());
+        float x_advance = this->unhintedAdvance(glyph.getGlyphID());
         if (!doLinearMetrics) {
             float hinted_advance = 0;
             fontations_ffi::scaler_hinted_advance_width(
-                    fOutlines, *fHintingInstance, glyph.getGlyphID(), hinted_advance);
+                    fOutlines, fHintingInstance->instance(), glyph.getGlyphID(), hinted_advance);
             // TODO(drott): Remove this workaround for fontations returning 0
             // for a space glyph without contours, compare
             // https://github.com/googlefonts/fontations/issues/905
@@ -732,7 +760,7 @@ protected:
             return false;
         }
         bool result = generateYScalePathForGlyphId(
-                glyph.getGlyphID(), path, scale.y(), *fHintingInstance);
+                glyph.getGlyphID(), path, scale.y(), fHintingInstance->instance());
         if (!result) {
             return false;
         }
@@ -842,14 +870,40 @@ protected:
     }
 
 private:
+    // Unhinted advances are looked up a block of glyphs at a time, since setting up the font's
+    // metrics tables for a lookup costs more than the lookup itself.
+    static constexpr int kAdvanceBlockSize = 64;
+    using AdvanceBlock = std::array<float, kAdvanceBlockSize>;
+
+    float unhintedAdvance(SkGlyphID glyphId) {
+        const int blockIndex = glyphId / kAdvanceBlockSize;
+        AdvanceBlock* block = fUnhintedAdvances.find(blockIndex);
+        if (!block) {
+            SkGlyphID glyphIds[kAdvanceBlockSize];
+            for (int i = 0; i < kAdvanceBlockSize; ++i) {
+                glyphIds[i] = SkToU16(blockIndex * kAdvanceBlockSize + i);
+            }
+            block = fUnhintedAdvances.set(blockIndex, AdvanceBlock());
+            fontations_ffi::unhinted_advance_widths(
+                    fBridgeFontRef,
+                    fScaleY,
+                    fBridgeNormalizedCoords,
+                    rust::Slice<const uint16_t>(glyphIds, kAdvanceBlockSize),
+                    rust::Slice<float>(block->data(), kAdvanceBlockSize));
+        }
+        return (*block)[glyphId % kAdvanceBlockSize];
+    }
+
     SkMatrix fMatrix;
+    SkScalar fScaleY = 0;
     sk_sp<SkData> fFontData = nullptr;
     const fontations_ffi::BridgeFontRef& fBridgeFontRef;
     const fontations_ffi::BridgeNormalizedCoords& fBridgeNormalizedCoords;
     const fontations_ffi::BridgeOutlineCollection& fOutlines;
     const SkSpan<const SkColor> fPalette;
-    rust::Box<fontations_ffi::BridgeHintingInstance> fHintingInstance;
+    sk_sp<sk_fontations::SharedHintingInstance> fHintingInstance;
     bool fDoLinearMetrics = false;
+    skia_private::THashMap<int, AdvanceBlock> fUnhintedAdvances;
 
     friend class sk_fontations::ColorPainter;
 };
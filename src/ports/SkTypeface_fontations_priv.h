@@ -13,8 +13,12 @@
 #include "include/core/SkSpan.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkScalerContext.h"
 #include "src/ports/fontations/src/ffi.rs.h"
 
@@ -63,6 +67,41 @@ private:
     size_t fAxisCount;
 };
 
+/** The size and hinting mode of a hinting instance. Scaler contexts of one typeface with the
+ * same key share a hinting instance, see SkTypeface_Fontations::getHintingInstance(). */
+struct HintingInstanceKey {
+    float fSize;
+    bool fMono;
+    bool fLcdAntialiasing;
+    bool fLcdOrientationVertical;
+    bool fPreserveLinearMetrics;
+
+    bool operator==(const HintingInstanceKey& that) const {
+        return fSize == that.fSize && fMono == that.fMono &&
+               fLcdAntialiasing == that.fLcdAntialiasing &&
+               fLcdOrientationVertical == that.fLcdOrientationVertical &&
+               fPreserveLinearMetrics == that.fPreserveLinearMetrics;
+    }
+
+    struct Hash {
+        uint32_t operator()(const HintingInstanceKey& key) const {
+            return SkChecksum::Hash32(&key, sizeof(key));
+        }
+    };
+};
+
+/** A reference counted hinting instance, so that it can be shared between scaler contexts. */
+class SharedHintingInstance : public SkNVRefCnt<SharedHintingInstance> {
+public:
+    explicit SharedHintingInstance(rust::Box<fontations_ffi::BridgeHintingInstance>&& instance)
+            : fInstance(std::move(instance)) {}
+
+    const fontations_ffi::BridgeHintingInstance& instance() const { return *fInstance; }
+
+private:
+    rust::Box<fontations_ffi::BridgeHintingInstance> fInstance;
+};
+
 class ColorPainter : public fontations_ffi::ColorPainterWrapper {
 public:
     ColorPainter() = delete;
@@ -223,6 +262,12 @@ public:
         return SkSpan(reinterpret_cast<const SkColor*>(fPalette.data()), fPalette.size());
     }
 
+    /** Returns the hinting instance for key, making it if a scaler context of this typeface
+     * hasn't recently asked for the same one. Making a hinting instance runs the font's hinting
+     * setup programs, which costs far more than the scaler context that needs it. */
+    sk_sp<sk_fontations::SharedHintingInstance> getHintingInstance(
+            const sk_fontations::HintingInstanceKey& key) const;
+
     static constexpr SkTypeface::FactoryId FactoryId = SkSetFourByteTag('f', 'n', 't', 'a');
 
     static sk_sp<SkTypeface> MakeFromData(sk_sp<SkData> fontData, const SkFontArguments&);
@@ -266,6 +311,13 @@ private:
 
     mutable SkOnce fGlyphMasksMayNeedCurrentColorOnce;
     mutable bool fGlyphMasksMayNeedCurrentColor;
+
+    static constexpr int kMaxHintingInstances = 8;
+    mutable SkMutex fHintingInstancesMutex;
+    mutable SkLRUCache<sk_fontations::HintingInstanceKey,
+                       sk_sp<sk_fontations::SharedHintingInstance>,
+                       sk_fontations::HintingInstanceKey::Hash>
+            fHintingInstances SK_GUARDED_BY(fHintingInstancesMutex){kMaxHintingInstances};
 };
 
 #endif  // SkTypeface_Fontations_DEFINED
@@ -85,10 +85,25 @@ unsafe fn make_mono_hinting_instance<'a>(
     Box::new(BridgeHintingInstance(hinting_instance))
 }
 
-fn lookup_glyph_or_zero(font_ref: &BridgeFontRef, map: &BridgeMappingIndex, codepoint: u32) -> u16 {
-    font_ref
-        .with_font(|f| Some(map.0.charmap(f).map(codepoint)?.to_u16()))
-        .unwrap_or_default()
+fn lookup_glyphs_or_zero(
+    font_ref: &BridgeFontRef,
+    map: &BridgeMappingIndex,
+    codepoints: &[u32],
+    glyphs: &mut [u16],
+) {
+    let mapped = font_ref.with_font(|f| {
+        let charmap = map.0.charmap(f);
+        for (codepoint, glyph) in codepoints.iter().zip(glyphs.iter_mut()) {
+            *glyph = charmap
+                .map(*codepoint)
+                .map(|glyph_id| glyph_id.to_u16())
+                .unwrap_or_default();
+        }
+        Some(())
+    });
+    if mapped.is_none() {
+        glyphs.fill(0);
+    }
 }
 
 fn num_glyphs(font_ref: &BridgeFontRef) -> u16 {
@@ -427,18 +442,25 @@ fn get_path(
         .is_some()
 }
 
-fn unhinted_advance_width_or_zero(
+fn unhinted_advance_widths(
     font_ref: &BridgeFontRef,
     size: f32,
     coords: &BridgeNormalizedCoords,
-    glyph_id: u16,
-) -> f32 {
-    font_ref
-        .with_font(|f| {
-            GlyphMetrics::new(f, Size::new(size), coords.normalized_coords.coords())
-                .advance_width(GlyphId::new(glyph_id))
-        })
-        .unwrap_or_default()
+    glyph_ids: &[u16],
+    advances: &mut [f32],
+) {
+    let measured = font_ref.with_font(|f| {
+        let metrics = GlyphMetrics::new(f, Size::new(size), coords.normalized_coords.coords());
+        for (glyph_id, advance) in glyph_ids.iter().zip(advances.iter_mut()) {
+            *advance = metrics
+                .advance_width(GlyphId::new(*glyph_id))
+                .unwrap_or_default();
+        }
+        Some(())
+    });
+    if measured.is_none() {
+        advances.fill(0.0);
+    }
 }
 
 fn scaler_hinted_advance_width(
@@ -1463,11 +1485,14 @@ mod ffi {
         ) -> Box<BridgeHintingInstance>;
         unsafe fn no_hinting_instance<'a>() -> Box<BridgeHintingInstance>;
 
-        fn lookup_glyph_or_zero(
+        /// Maps each of `codepoints` to a glyph in `glyphs`, or to zero if
+        /// the font has no glyph for it. Both slices have the same length.
+        fn lookup_glyphs_or_zero(
             font_ref: &BridgeFontRef,
             map: &BridgeMappingIndex,
-            codepoint: u32,
-        ) -> u16;
+            codepoints: &[u32],
+            glyphs: &mut [u16],
+        );
 
         fn get_path(
             outlines: &BridgeOutlineCollection,
@@ -1478,12 +1503,16 @@ mod ffi {
             path_wrapper: Pin<&mut PathWrapper>,
             scaler_metrics: &mut BridgeScalerMetrics,
         ) -> bool;
-        fn unhinted_advance_width_or_zero(
+        /// Writes the unhinted advance of each of `glyph_ids` to `advances`,
+        /// or zero for glyphs the font doesn't have. The font's metrics
+        /// tables are set up once for all of them.
+        fn unhinted_advance_widths(
             font_ref: &BridgeFontRef,
             size: f32,
             coords: &BridgeNormalizedCoords,
-            glyph_id: u16,
-        ) -> f32;
+            glyph_ids: &[u16],
+            advances: &mut [f32],
+        );
         fn scaler_hinted_advance_width(
             outlines: &BridgeOutlineCollection,
             hinting_instance: &BridgeHintingInstance,
@@ -7,18 +7,23 @@
 
 #include "include/private/SkGainmapShader.h"
 
+#include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/private/SkGainmapInfo.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkFloatingPoint.h"
 #include "src/core/SkColorFilterPriv.h"
 #include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkResourceCache.h"
 
 #include <cmath>
 #include <cstdint>
@@ -211,3 +216,129 @@ sk_sp<SkShader> SkGainmapShader::Make(const sk_sp<const SkImage>& baseImage,
     // Return a shader that will apply the gainmap and then convert to the destination color space.
     return gainmapMathShader->makeWithColorFilter(colorXformGainmapToDst);
 }
+
+// Baked images are keyed by the images, the part of the gainmap that covers the base image, the
+// bucketed HDR ratio, and the destination color space. Image IDs are never reused.
+namespace {
+static unsigned gBakedGainmapKeyNamespaceLabel;
+
+struct BakedGainmapKey : public SkResourceCache::Key {
+    BakedGainmapKey(uint32_t baseID,
+                    uint32_t gainmapID,
+                    const SkRect& gainmapRect,
+                    int ratioBucket,
+                    const SkColorSpace& dstColorSpace)
+            : fBaseID(baseID)
+            , fGainmapID(gainmapID)
+            , fGainmapRect(gainmapRect)
+            , fRatioBucket(ratioBucket)
+            , fToXYZD50Hash(dstColorSpace.toXYZD50Hash())
+            , fTransferFnHash(dstColorSpace.transferFnHash()) {
+        this->init(&gBakedGainmapKeyNamespaceLabel, /*sharedID=*/0,
+                   sizeof(fBaseID) + sizeof(fGainmapID) + sizeof(fGainmapRect) +
+                   sizeof(fRatioBucket) + sizeof(fToXYZD50Hash) + sizeof(fTransferFnHash));
+    }
+
+    uint32_t fBaseID;
+    uint32_t fGainmapID;
+    SkRect   fGainmapRect;
+    int32_t  fRatioBucket;
+    uint32_t fToXYZD50Hash;
+    uint32_t fTransferFnHash;
+};
+
+struct BakedGainmapRec : public SkResourceCache::Rec {
+    BakedGainmapRec(const BakedGainmapKey& key,
+                    const SkGainmapInfo& gainmapInfo,
+                    sk_sp<SkImage> image)
+            : fKey(key), fGainmapInfo(gainmapInfo), fImage(std::move(image)) {}
+
+    BakedGainmapKey fKey;
+    SkGainmapInfo fGainmapInfo;
+    sk_sp<SkImage> fImage;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fImage->imageInfo().computeMinByteSize();
+    }
+    const char* getCategory() const override { return "baked-gainmap"; }
+
+    struct Result {
+        const SkGainmapInfo* fGainmapInfo;
+        sk_sp<SkImage> fImage;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const BakedGainmapRec& rec = static_cast<const BakedGainmapRec&>(baseRec);
+        Result* result = static_cast<Result*>(contextData);
+        // The same images are very unlikely to be drawn with different gainmap info, but if they
+        // are, the old image is stale.
+        if (!(rec.fGainmapInfo == *result->fGainmapInfo)) {
+            return false;
+        }
+        result->fImage = rec.fImage;
+        return true;
+    }
+};
+
+// Baked images larger than this are not worth the memory, compared to applying the gainmap when
+// drawing.
+constexpr size_t kMaxBakedGainmapBytes = 32 * 1024 * 1024;
+
+// HDR ratios are rounded to this fraction of a stop.
+constexpr float kRatioBucketsPerStop = 8.f;
+}  // namespace
+
+sk_sp<SkShader> SkGainmapShader::MakeBaked(const sk_sp<const SkImage>& baseImage,
+                                           const SkRect& baseRect,
+                                           const SkSamplingOptions& baseSamplingOptions,
+                                           const sk_sp<const SkImage>& gainmapImage,
+                                           const SkRect& gainmapRect,
+                                           const SkSamplingOptions& gainmapSamplingOptions,
+                                           const SkGainmapInfo& gainmapInfo,
+                                           const SkRect& dstRect,
+                                           float dstHdrRatio,
+                                           sk_sp<SkColorSpace> dstColorSpace) {
+    auto makeUnbaked = [&]() {
+        return Make(baseImage, baseRect, baseSamplingOptions, gainmapImage, gainmapRect,
+                    gainmapSamplingOptions, gainmapInfo, dstRect, dstHdrRatio, dstColorSpace);
+    };
+    const SkImageInfo bakedInfo = SkImageInfo::Make(baseImage->dimensions(),
+                                                    kRGBA_F16_SkColorType,
+                                                    kPremul_SkAlphaType,
+                                                    dstColorSpace ? dstColorSpace
+                                                                  : SkColorSpace::MakeSRGB());
+    if (baseImage->isTextureBacked() || gainmapImage->isTextureBacked() ||
+        !(dstHdrRatio > 0.f) || bakedInfo.computeMinByteSize() > kMaxBakedGainmapBytes) {
+        return makeUnbaked();
+    }
+
+    // The part of the gainmap that covers the whole base image.
+    const SkRect baseBounds = SkRect::Make(baseImage->bounds());
+    const SkRect bakedGainmapRect =
+            SkMatrix::RectToRect(baseRect, gainmapRect).mapRect(baseBounds);
+    const int ratioBucket = sk_float_round2int(std::log2(dstHdrRatio) * kRatioBucketsPerStop);
+
+    BakedGainmapKey key(baseImage->uniqueID(), gainmapImage->uniqueID(), bakedGainmapRect,
+                        ratioBucket, *bakedInfo.colorSpace());
+    BakedGainmapRec::Result result{&gainmapInfo, nullptr};
+    if (!SkResourceCache::Find(key, BakedGainmapRec::Visitor, &result)) {
+        sk_sp<SkSurface> surface = SkSurfaces::Raster(bakedInfo);
+        if (!surface) {
+            return makeUnbaked();
+        }
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setShader(Make(baseImage, baseBounds, SkSamplingOptions(),
+                             gainmapImage, bakedGainmapRect, gainmapSamplingOptions,
+                             gainmapInfo, baseBounds,
+                             std::exp2(ratioBucket / kRatioBucketsPerStop),
+                             bakedInfo.refColorSpace()));
+        surface->getCanvas()->drawPaint(paint);
+        result.fImage = surface->makeImageSnapshot();
+        SkResourceCache::Add(new BakedGainmapRec(key, gainmapInfo, result.fImage));
+    }
+
+    const SkMatrix baseRectToDstRect = SkMatrix::RectToRect(baseRect, dstRect);
+    return result.fImage->makeShader(baseSamplingOptions, &baseRectToDstRect);
+}
@@ -675,6 +675,9 @@ bool SkImageShader::appendStages(const SkStageRec& rec, const SkShaders::MatrixR
         }
     };
 
+    // Set when the sampled colors are exactly the image's 8-bit unorm values.
+    bool sampledUnorm8 = false;
+
     auto append_misc = [&] {
         SkColorSpace* cs = upper.pm.colorSpace();
         SkAlphaType   at = upper.pm.alphaType();
@@ -698,33 +701,42 @@ bool SkImageShader::appendStages(const SkStageRec& rec, const SkShaders::MatrixR
 
         // Transform color space and alpha type to match shader convention (dst CS, premul alpha).
         if (!fRaw) {
-            alloc->make<SkColorSpaceXformSteps>(cs, at, rec.fDstCS, kPremul_SkAlphaType)->apply(p);
+            auto steps = alloc->make<SkColorSpaceXformSteps>(cs, at,
+                                                             rec.fDstCS, kPremul_SkAlphaType);
+            if (sampledUnorm8) {
+                steps->applyToUnorm8(p);
+            } else {
+                steps->apply(p);
+            }
         }
 
         return true;
     };
 
-    // Check for fast-path stages.
-    // TODO: Could we use the fast-path stages for each level when doing linear mipmap filtering?
+    // Check for fast-path stages, which sample a whole level in one stage. When doing linear
+    // mipmap filtering, they sample each of the two levels.
     SkColorType ct = upper.pm.colorType();
+    const bool is8888 = ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType,
+               isF16  = ct == kRGBA_F16_SkColorType  || ct == kRGBA_F16Norm_SkColorType;
     if (true
-        && (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType)
-        && !sampling.useCubic && sampling.filter == SkFilterMode::kLinear
-        && sampling.mipmap != SkMipmapMode::kLinear
+        && (is8888 || isF16)
+        && (sampling.useCubic || sampling.filter == SkFilterMode::kLinear)
         && fTileModeX == SkTileMode::kClamp && fTileModeY == SkTileMode::kClamp) {
 
-        p->append(SkRasterPipelineOp::bilerp_clamp_8888, upper.gather);
-        if (ct == kBGRA_8888_SkColorType) {
-            p->append(SkRasterPipelineOp::swap_rb);
+        SkRasterPipelineOp sampleOp;
+        if (sampling.useCubic) {
+            sampleOp = is8888 ? SkRasterPipelineOp::bicubic_clamp_8888
+                              : SkRasterPipelineOp::bicubic_clamp_f16;
+        } else {
+            sampleOp = is8888 ? SkRasterPipelineOp::bilerp_clamp_8888
+                              : SkRasterPipelineOp::bilerp_clamp_f16;
+        }
+        p->append(sampleOp, upper.gather);
+        if (mipmapCtx) {
+            p->append(SkRasterPipelineOp::mipmap_linear_update, mipmapCtx);
+            p->append(sampleOp, lower.gather);
+            p->append(SkRasterPipelineOp::mipmap_linear_finish, mipmapCtx);
         }
-        return append_misc();
-    }
-    if (true
-        && (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType)
-        && sampling.useCubic
-        && fTileModeX == SkTileMode::kClamp && fTileModeY == SkTileMode::kClamp) {
-
-        p->append(SkRasterPipelineOp::bicubic_clamp_8888, upper.gather);
         if (ct == kBGRA_8888_SkColorType) {
             p->append(SkRasterPipelineOp::swap_rb);
         }
@@ -785,6 +797,9 @@ bool SkImageShader::appendStages(const SkStageRec& rec, const SkShaders::MatrixR
     };
 
     sample_level(&upper);
+    sampledUnorm8 = !mipmapCtx && !sampling.useCubic && sampling.filter == SkFilterMode::kNearest &&
+                    (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType ||
+                     ct == kRGB_888x_SkColorType);
 
     if (mipmapCtx) {
         p->append(SkRasterPipelineOp::mipmap_linear_update, mipmapCtx);
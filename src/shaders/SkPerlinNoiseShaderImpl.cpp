@@ -14,14 +14,19 @@
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkPerlinNoiseShaderType.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <optional>
+#include <utility>
 
 SkPerlinNoiseShader::SkPerlinNoiseShader(SkPerlinNoiseShaderType type,
                                          SkScalar baseFrequencyX,
@@ -80,6 +85,73 @@ void SkPerlinNoiseShader::flatten(SkWriteBuffer& buffer) const {
     buffer.writeInt(fTileSize.fHeight);
 }
 
+namespace {
+static unsigned gPerlinNoiseTablesKeyNamespaceLabel;
+
+struct PerlinNoiseTablesKey : public SkResourceCache::Key {
+public:
+    explicit PerlinNoiseTablesKey(int32_t seed) : fSeed(seed) {
+        this->init(&gPerlinNoiseTablesKeyNamespaceLabel, 0, sizeof(fSeed));
+    }
+
+    const int32_t fSeed;
+};
+
+struct PaintingDataRequest {
+    SkISize fTileSize;
+    SkScalar fBaseFrequencyX;
+    SkScalar fBaseFrequencyY;
+    std::unique_ptr<SkPerlinNoiseShader::PaintingData> fResult;
+};
+
+class PerlinNoiseTablesRec : public SkResourceCache::Rec {
+public:
+    using PaintingData = SkPerlinNoiseShader::PaintingData;
+
+    PerlinNoiseTablesRec(const PerlinNoiseTablesKey& key, std::unique_ptr<PaintingData> tables)
+            : fKey(key), fTables(std::move(tables)) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + sizeof(PaintingData) +
+               fTables->getPermutationsBitmap().computeByteSize() +
+               fTables->getNoiseBitmap().computeByteSize();
+    }
+    const char* getCategory() const override { return "perlin-noise-tables"; }
+
+    // Copies the tables while the cache is locked, as it may purge them right after.
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        auto* request = static_cast<PaintingDataRequest*>(context);
+        request->fResult = std::make_unique<PaintingData>(
+                *static_cast<const PerlinNoiseTablesRec&>(baseRec).fTables,
+                request->fTileSize,
+                request->fBaseFrequencyX,
+                request->fBaseFrequencyY);
+        return true;
+    }
+
+private:
+    const PerlinNoiseTablesKey fKey;
+    const std::unique_ptr<PaintingData> fTables;
+};
+}  // namespace
+
+std::unique_ptr<SkPerlinNoiseShader::PaintingData> SkPerlinNoiseShader::getPaintingData() const {
+    // The tables only depend on the truncated seed.
+    const PerlinNoiseTablesKey key(SkScalarTruncToInt(fSeed));
+    PaintingDataRequest request = {fTileSize, fBaseFrequencyX, fBaseFrequencyY, nullptr};
+    if (SkResourceCache::Find(key, PerlinNoiseTablesRec::Visitor, &request)) {
+        return std::move(request.fResult);
+    }
+
+    auto tables = std::make_unique<PaintingData>(SkISize::Make(0, 0), fSeed, 0, 0);
+    tables->generateBitmaps();
+    auto result = std::make_unique<PaintingData>(*tables, fTileSize, fBaseFrequencyX,
+                                                 fBaseFrequencyY);
+    SkResourceCache::Add(new PerlinNoiseTablesRec(key, std::move(tables)));
+    return result;
+}
+
 bool SkPerlinNoiseShader::appendStages(const SkStageRec& rec,
                                        const SkShaders::MatrixRec& mRec) const {
     std::optional<SkShaders::MatrixRec> newMRec = mRec.apply(rec);
@@ -98,7 +170,10 @@ bool SkPerlinNoiseShader::appendStages(const SkStageRec& rec,
     ctx->stitchDataInX = fPaintingData->fStitchDataInit.fWidth;
     ctx->stitchDataInY = fPaintingData->fStitchDataInit.fHeight;
     ctx->stitching = fStitchTiles;
-    ctx->numOctaves = fNumOctaves;
+    // Each octave adds at most half as much as the one before it. Past these, the remaining
+    // octaves add up to less than a rounding error of the destination, so they are skipped.
+    const int maxOctaves = SkColorTypeMaxBitsPerChannel(rec.fDstColorType) <= 8 ? 11 : 24;
+    ctx->numOctaves = std::min(fNumOctaves, maxOctaves);
     ctx->latticeSelector = fPaintingData->fLatticeSelector;
     ctx->noiseData = &fPaintingData->fNoise[0][0][0];
 
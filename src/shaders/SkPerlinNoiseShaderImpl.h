@@ -73,13 +73,36 @@ public:
             }
         }
 
+        // Copies the tables (and bitmaps) of noise, with the frequencies and stitching of tileSize
+        // and baseFrequency{X,Y}.
+        PaintingData(const PaintingData& noise,
+                     const SkISize& tileSize,
+                     SkScalar baseFrequencyX,
+                     SkScalar baseFrequencyY)
+                : PaintingData(noise) {
+            fBaseFrequency.set(baseFrequencyX, baseFrequencyY);
+            fTileSize.set(SkScalarRoundToInt(tileSize.fWidth),
+                          SkScalarRoundToInt(tileSize.fHeight));
+            fStitchDataInit = StitchData();
+            if (!fTileSize.isEmpty()) {
+                this->stitch();
+            }
+        }
+
+        // The bitmaps own copies of the tables, so that copies of this PaintingData share them
+        // (and the GPU textures cached for them), and they outlive it.
         void generateBitmaps() {
+            if (!fPermutationsBitmap.drawsNothing()) {
+                return;
+            }
             SkImageInfo info = SkImageInfo::MakeA8(kBlockSize, 1);
-            fPermutationsBitmap.installPixels(info, fLatticeSelector, info.minRowBytes());
+            fPermutationsBitmap.allocPixels(info);
+            memcpy(fPermutationsBitmap.getPixels(), fLatticeSelector, sizeof(fLatticeSelector));
             fPermutationsBitmap.setImmutable();
 
             info = SkImageInfo::Make(kBlockSize, 4, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
-            fNoiseBitmap.installPixels(info, fNoise[0][0], info.minRowBytes());
+            fNoiseBitmap.allocPixels(info);
+            memcpy(fNoiseBitmap.getPixels(), fNoise, sizeof(fNoise));
             fNoiseBitmap.setImmutable();
         }
 
@@ -251,9 +274,9 @@ public:
     bool stitchTiles() const { return fStitchTiles; }
     SkISize tileSize() const { return fTileSize; }
 
-    std::unique_ptr<PaintingData> getPaintingData() const {
-        return std::make_unique<PaintingData>(fTileSize, fSeed, fBaseFrequencyX, fBaseFrequencyY);
-    }
+    // The tables only depend on the seed, so they are shared (with their bitmaps) through
+    // SkResourceCache by every shader with the same seed.
+    std::unique_ptr<PaintingData> getPaintingData() const;
 
     bool appendStages(const SkStageRec& rec, const SkShaders::MatrixRec& mRec) const override;
 
@@ -20,6 +20,7 @@
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkFloatBits.h"
@@ -28,15 +29,19 @@
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkReadBuffer.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkWriteBuffer.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <optional>
 #include <utility>
 
@@ -390,9 +395,9 @@ void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
         // Note: In order to handle clamps in search, the search assumes a stop conceptully placed
         // at -inf. Therefore, the max number of stops is fColorCount+1.
         for (int i = 0; i < 4; i++) {
-            // Allocate at least at for the AVX2 gather from a YMM register.
-            ctx->fs[i] = alloc->makeArray<float>(std::max(count + 1, 8));
-            ctx->bs[i] = alloc->makeArray<float>(std::max(count + 1, 8));
+            // Allocate at least 16 for the AVX-512 permute from a ZMM register (AVX2 needs 8).
+            ctx->fs[i] = alloc->makeArray<float>(std::max(count + 1, 16));
+            ctx->bs[i] = alloc->makeArray<float>(std::max(count + 1, 16));
         }
 
         if (positions == nullptr) {
@@ -526,6 +531,174 @@ void SkGradientBaseShader::AppendInterpolatedToDstStages(SkRasterPipeline* p,
             ->apply(p);
 }
 
+namespace {
+// Gradients with more stops than this are not cached as ramps, to bound the size of the keys.
+static constexpr int kMaxRampStops = 64;
+
+static unsigned gGradientRampKeyNamespaceLabel;
+
+struct GradientRampKey : public SkResourceCache::Key {
+public:
+    GradientRampKey(const SkColor4fXformer& colors,
+                    bool colorsAreOpaque,
+                    const SkGradientShader::Interpolation& interpolation,
+                    const SkColorSpace* dstCS) {
+        const int count = colors.fColors.size();
+        SkASSERT(count <= kMaxRampStops);
+
+        fFlags = (uint32_t)interpolation.fColorSpace << 16 |
+                 (uint32_t)interpolation.fHueMethod  <<  8 |
+                 (interpolation.fInPremul == SkGradientShader::Interpolation::InPremul::kYes) << 1 |
+                 colorsAreOpaque;
+        const SkColorSpace* intermediateCS = colors.fIntermediateColorSpace.get();
+        fIntermediateCSHash[0] = intermediateCS ? intermediateCS->transferFnHash() : 0;
+        fIntermediateCSHash[1] = intermediateCS ? intermediateCS->toXYZD50Hash() : 0;
+        fDstCSHash[0] = dstCS ? dstCS->transferFnHash() : 0;
+        fDstCSHash[1] = dstCS ? dstCS->toXYZD50Hash() : 0;
+        fStopCount = count;
+        for (int i = 0; i < count; ++i) {
+            memcpy(&fStops[5 * i], colors.fColors[i].vec(), 4 * sizeof(float));
+            fStops[5 * i + 4] = colors.fPositions ? colors.fPositions[i]
+                                                  : (float)i / (count - 1);
+        }
+        const char* end = reinterpret_cast<const char*>(&fStops[5 * count]);
+        this->init(&gGradientRampKeyNamespaceLabel, 0,
+                   end - reinterpret_cast<const char*>(this) - sizeof(SkResourceCache::Key));
+    }
+
+    uint32_t fFlags;
+    uint32_t fIntermediateCSHash[2];
+    uint32_t fDstCSHash[2];
+    uint32_t fStopCount;
+    float    fStops[5 * kMaxRampStops];  // r,g,b,a,t; only fStopCount are part of the key
+};
+
+// Caches null ramps too, for gradients that a ramp cannot draw accurately enough.
+class GradientRampRec : public SkResourceCache::Rec {
+public:
+    GradientRampRec(const GradientRampKey& key, sk_sp<SkData> ramp)
+            : fKey(key), fRamp(std::move(ramp)) {}
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(fKey) + (fRamp ? fRamp->size() : 0); }
+    const char* getCategory() const override { return "gradient-ramp"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        auto* result = static_cast<sk_sp<SkData>*>(context);
+        *result = static_cast<const GradientRampRec&>(baseRec).fRamp;
+        return true;
+    }
+
+private:
+    const GradientRampKey fKey;
+    const sk_sp<SkData> fRamp;
+};
+}  // namespace
+
+// Evaluates the gradient's final colors at rampSize evenly spaced t, by running the same stages
+// the gradient would otherwise run per pixel. The colors halfway between entries are evaluated too,
+// and if lerping the entries misses any of them by more than kMaxRampError (once clamped, as an
+// 8-bit destination stores them), this returns null. The ramp is stored one channel after another,
+// each with a copy of its last entry appended (see SkRasterPipeline_GradientRampCtx).
+static sk_sp<SkData> make_gradient_ramp(int rampSize,
+                                        const SkColor4fXformer& colors,
+                                        bool colorsAreOpaque,
+                                        const SkGradientShader::Interpolation& interpolation,
+                                        const SkColorSpace* dstCS) {
+    static constexpr float kMaxRampError = 0.25f / 255;
+
+    const int sampleCount = 2 * rampSize - 1;
+    AutoTMalloc<float> rgba(4 * sampleCount);
+    for (int i = 0; i < sampleCount; ++i) {
+        rgba[4 * i] = (float)i / (sampleCount - 1);
+    }
+
+    SkSTArenaAlloc<2048> alloc;
+    SkRasterPipeline p(&alloc);
+    SkRasterPipeline_MemoryCtx ctx = {rgba.get(), 0};
+    p.append(SkRasterPipelineOp::load_f32, &ctx);
+    SkGradientBaseShader::AppendGradientFillStages(&p, &alloc, colors.fColors.begin(),
+                                                   colors.fPositions, colors.fColors.size());
+    SkGradientBaseShader::AppendInterpolatedToDstStages(&p, &alloc, colorsAreOpaque, interpolation,
+                                                        colors.fIntermediateColorSpace.get(),
+                                                        dstCS);
+    p.append(SkRasterPipelineOp::store_f32, &ctx);
+    p.run(0, 0, sampleCount, 1);
+
+    auto clamp01 = [](float v) { return std::min(std::max(v, 0.0f), 1.0f); };
+    for (int i = 1; i < sampleCount; i += 2) {
+        for (int c = 0; c < 4; ++c) {
+            float lerped = 0.5f * (rgba[4 * (i - 1) + c] + rgba[4 * (i + 1) + c]);
+            if (!(std::abs(clamp01(lerped) - clamp01(rgba[4 * i + c])) <= kMaxRampError)) {
+                return nullptr;
+            }
+        }
+    }
+
+    sk_sp<SkData> ramp = SkData::MakeUninitialized(4 * (rampSize + 1) * sizeof(float));
+    float* channels = static_cast<float*>(ramp->writable_data());
+    for (int c = 0; c < 4; ++c) {
+        float* channel = channels + c * (rampSize + 1);
+        for (int i = 0; i < rampSize; ++i) {
+            channel[i] = rgba[4 * (2 * i) + c];
+        }
+        channel[rampSize] = channel[rampSize - 1];
+    }
+    return ramp;
+}
+
+// Gradients with many stops spend most of each pixel searching for the stop, and gradients
+// interpolated in another color space spend it converting to the destination. When the destination
+// only holds 8 bits per channel, the colors are instead looked up in a ramp of 256 or 1024 entries,
+// lerping between the two nearest. Ramps are shared through SkResourceCache by every gradient with
+// the same stops, interpolation and destination color space.
+static bool append_gradient_ramp(const SkStageRec& rec,
+                                 const SkColor4fXformer& colors,
+                                 bool colorsAreOpaque,
+                                 const SkGradientShader::Interpolation& interpolation) {
+    static constexpr int kMinStopsForRamp = 8;
+
+    const int count = colors.fColors.size();
+    if (SkColorTypeMaxBitsPerChannel(rec.fDstColorType) > 8 || count > kMaxRampStops ||
+        (count < kMinStopsForRamp &&
+         interpolation.fColorSpace == SkGradientShader::Interpolation::ColorSpace::kDestination)) {
+        return false;
+    }
+    if (colors.fPositions) {
+        for (int i = 1; i < count; ++i) {
+            if (colors.fPositions[i] <= colors.fPositions[i - 1]) {
+                return false;  // A hard stop, which a ramp would smear across an entry.
+            }
+        }
+    }
+
+    const GradientRampKey key(colors, colorsAreOpaque, interpolation, rec.fDstCS);
+    sk_sp<SkData> ramp;
+    if (!SkResourceCache::Find(key, GradientRampRec::Visitor, &ramp)) {
+        for (int rampSize : {256, 1024}) {
+            ramp = make_gradient_ramp(rampSize, colors, colorsAreOpaque, interpolation, rec.fDstCS);
+            if (ramp) {
+                break;
+            }
+        }
+        SkResourceCache::Add(new GradientRampRec(key, ramp));
+    }
+    if (!ramp) {
+        return false;
+    }
+
+    auto* ctx = rec.fAlloc->make<SkRasterPipeline_GradientRampCtx>();
+    const float* channels = static_cast<const float*>(ramp->data());
+    ctx->count = ramp->size() / (4 * sizeof(float)) - 1;
+    for (int c = 0; c < 4; ++c) {
+        ctx->rgba[c] = channels + c * (ctx->count + 1);
+    }
+    // The ramp may be purged from the cache while the pipeline still uses it.
+    rec.fAlloc->make<sk_sp<SkData>>(std::move(ramp));
+    rec.fPipeline->append(SkRasterPipelineOp::gradient_ramp, ctx);
+    return true;
+}
+
 bool SkGradientBaseShader::appendStages(const SkStageRec& rec,
                                         const SkShaders::MatrixRec& mRec) const {
     SkRasterPipeline* p = rec.fPipeline;
@@ -568,12 +741,14 @@ bool SkGradientBaseShader::appendStages(const SkStageRec& rec,
 
     // Transform all of the colors to destination color space, possibly premultiplied
     SkColor4fXformer xformedColors(this, rec.fDstCS);
-    AppendGradientFillStages(p, alloc,
-                             xformedColors.fColors.begin(),
-                             xformedColors.fPositions,
-                             xformedColors.fColors.size());
-    AppendInterpolatedToDstStages(p, alloc, fColorsAreOpaque, fInterpolation,
-                                  xformedColors.fIntermediateColorSpace.get(), rec.fDstCS);
+    if (!append_gradient_ramp(rec, xformedColors, fColorsAreOpaque, fInterpolation)) {
+        AppendGradientFillStages(p, alloc,
+                                 xformedColors.fColors.begin(),
+                                 xformedColors.fPositions,
+                                 xformedColors.fColors.size());
+        AppendInterpolatedToDstStages(p, alloc, fColorsAreOpaque, fInterpolation,
+                                      xformedColors.fIntermediateColorSpace.get(), rec.fDstCS);
+    }
 
     if (decal_ctx) {
         p->append(SkRasterPipelineOp::check_decal_mask, decal_ctx);
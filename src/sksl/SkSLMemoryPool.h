@@ -8,25 +8,53 @@
 #ifndef SKSL_MEMORYPOOL
 #define SKSL_MEMORYPOOL
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <optional>
 
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
 #include "src/base/SkArenaAlloc.h"
 
 namespace SkSL {
 
 class MemoryPool {
 public:
-    static std::unique_ptr<MemoryPool> Make() {
-        return std::make_unique<MemoryPool>();
-    }
+    MemoryPool() { this->reset(); }
+
+    // Returns a recycled pool when one is available, or a new pool otherwise.
+    static std::unique_ptr<MemoryPool> Make();
+
+    // Resets the pool and keeps it around for a later call to Make(). Every allocation from the
+    // pool must already have been released.
+    static void Recycle(std::unique_ptr<MemoryPool> pool);
+
     void* allocate(size_t size) {
-        return fArena.makeBytesAlignedTo(size, kAlignment);
+        fBytesAllocated += size + kAlignment - 1;
+        return fArena->makeBytesAlignedTo(size, kAlignment);
     }
     void release(void*) {
         // SkArenaAlloc does not ever attempt to reclaim space.
     }
 
+    // Frees all of the pool's allocations. The first block of the pool is grown to hold everything
+    // that was allocated since the last reset (up to kMaxRetainedBytes), so that a similar program
+    // compiled from a recycled pool can be allocated without going back to the system allocator.
+    void reset() {
+        size_t blockSize = std::max(fBlockSize, kMinBlockSize);
+        if (fBytesAllocated > blockSize) {
+            blockSize = std::min(SkAlignTo(fBytesAllocated, kMinBlockSize), kMaxRetainedBytes);
+        }
+        fArena.reset();
+        if (blockSize != fBlockSize) {
+            fBlock = std::make_unique<char[]>(blockSize);
+            fBlockSize = blockSize;
+        }
+        fArena.emplace(fBlock.get(), fBlockSize, /*firstHeapAllocation=*/32768);
+        fBytesAllocated = 0;
+    }
+
 private:
 #ifdef SK_FORCE_8_BYTE_ALIGNMENT
     // https://github.com/emscripten-core/emscripten/issues/10072
@@ -38,7 +66,14 @@ private:
     static constexpr size_t kAlignment = alignof(std::max_align_t);
 #endif
 
-    SkSTArenaAlloc<65536> fArena{/*firstHeapAllocation=*/32768};
+    static constexpr size_t kMinBlockSize = 65536;
+    static constexpr size_t kMaxRetainedBytes = 4 * 1024 * 1024;
+
+    // fBlock must outlive fArena, which allocates from it.
+    std::unique_ptr<char[]>     fBlock;
+    size_t                      fBlockSize = 0;
+    size_t                      fBytesAllocated = 0;
+    std::optional<SkArenaAlloc> fArena;
 };
 
 }  // namespace SkSL
@@ -6,15 +6,60 @@
  */
 
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/base/SkNoDestructor.h"
 #include "src/sksl/SkSLMemoryPool.h"
 #include "src/sksl/SkSLPool.h"
 
+#include <utility>
+#include <vector>
+
 #define SkVLOG(...) // SkDEBUGF(__VA_ARGS__)
 
 namespace SkSL {
 
 static thread_local MemoryPool* sMemPool = nullptr;
 
+// Pools released by finished programs, kept for reuse by later compilations. Each one holds on to
+// at most a few megabytes, and only a handful are kept, so that concurrent compilation on a few
+// threads can reuse them without retaining an unbounded amount of memory.
+static constexpr size_t kMaxRecycledPools = 4;
+
+struct RecycledPools {
+    SkMutex fMutex;
+    std::vector<std::unique_ptr<MemoryPool>> fPools SK_GUARDED_BY(fMutex);
+};
+
+static RecycledPools& recycled_pools() {
+    static SkNoDestructor<RecycledPools> sRecycledPools;
+    return *sRecycledPools;
+}
+
+std::unique_ptr<MemoryPool> MemoryPool::Make() {
+    RecycledPools& recycled = recycled_pools();
+    {
+        SkAutoMutexExclusive lock(recycled.fMutex);
+        if (!recycled.fPools.empty()) {
+            std::unique_ptr<MemoryPool> pool = std::move(recycled.fPools.back());
+            recycled.fPools.pop_back();
+            return pool;
+        }
+    }
+    return std::make_unique<MemoryPool>();
+}
+
+void MemoryPool::Recycle(std::unique_ptr<MemoryPool> pool) {
+    // Resetting the pool can free or allocate memory, so it is done outside of the lock.
+    pool->reset();
+
+    RecycledPools& recycled = recycled_pools();
+    SkAutoMutexExclusive lock(recycled.fMutex);
+    if (recycled.fPools.size() < kMaxRecycledPools) {
+        recycled.fPools.push_back(std::move(pool));
+    }
+}
+
 static MemoryPool* get_thread_local_memory_pool() {
     return sMemPool;
 }
@@ -32,6 +77,7 @@ Pool::~Pool() {
     }
 
     SkVLOG("DELETE Pool:0x%016llX\n", (uint64_t)fMemPool.get());
+    MemoryPool::Recycle(std::move(fMemPool));
 }
 
 std::unique_ptr<Pool> Pool::Create() {
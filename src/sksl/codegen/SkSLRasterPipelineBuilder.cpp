@@ -230,6 +230,18 @@ void Builder::binary_op(BuilderOp op, int32_t slots) {
             if (immOp != op) {
                 // ... discard the constants from the stack, and use an immediate-mode op.
                 this->discard_stack(slots);
+
+                // If we are adding to the result of an immediate-mode multiply, fuse the two.
+                if (immOp == BuilderOp::add_imm_float) {
+                    Instruction* mulInstruction = this->lastInstruction();
+                    if (mulInstruction && mulInstruction->fOp == BuilderOp::mul_imm_float &&
+                        mulInstruction->fSlotA == NA && mulInstruction->fImmA == slots) {
+                        mulInstruction->fOp = BuilderOp::mad_imm_float;
+                        mulInstruction->fImmC = constantValue;
+                        return;
+                    }
+                }
+
                 this->appendInstruction(immOp, {}, slots, constantValue);
                 return;
             }
@@ -309,7 +321,8 @@ bool Builder::simplifyImmediateUnmaskedOp() {
     if (popInstruction && immInstruction && pushInstruction &&
         popInstruction->fOp == BuilderOp::copy_stack_to_slots_unmasked) {
         // ... and the prior instruction was an immediate-mode op, with the same number of slots...
-        if (is_immediate_op(immInstruction->fOp) &&
+        if ((is_immediate_op(immInstruction->fOp) ||
+             immInstruction->fOp == BuilderOp::mad_imm_float) &&
             immInstruction->fImmA == popInstruction->fImmA) {
             // ... and we support multiple-slot immediates (if this op calls for it)...
             if (immInstruction->fImmA == 1 || is_multi_slot_immediate_op(immInstruction->fOp)) {
@@ -1553,6 +1566,21 @@ void Program::appendImmediateBinaryOp(TArray<Stage>* pipeline, SkArenaAlloc* all
     }
 }
 
+void Program::appendMultiplyAddImmediateOp(TArray<Stage>* pipeline, SkArenaAlloc* alloc,
+                                           SkRPOffset dst, int32_t mul, int32_t add,
+                                           int numSlots) const {
+    SkRasterPipeline_MultiplyAddConstantCtx ctx;
+    ctx.mul = mul;
+    ctx.add = add;
+    ctx.dst = dst;
+
+    SkASSERT(numSlots >= 0);
+    while (numSlots-- > 0) {
+        pipeline->push_back({ProgramOp::mad_imm_float, SkRPCtxUtils::Pack(ctx, alloc)});
+        ctx.dst += SkOpts::raster_pipeline_highp_stride * sizeof(float);
+    }
+}
+
 void Program::appendAdjacentNWayBinaryOp(TArray<Stage>* pipeline, SkArenaAlloc* alloc,
                                          ProgramOp stage,
                                          SkRPOffset dst, SkRPOffset src, int numSlots) const {
@@ -1921,6 +1949,14 @@ void Program::makeStages(TArray<Stage>* pipeline,
                                               OffsetFromBase(dst), inst.fImmB, inst.fImmA);
                 break;
             }
+            case BuilderOp::mad_imm_float: {
+                float* dst = (inst.fSlotA == NA) ? tempStackPtr - (inst.fImmA * N)
+                                                 : SlotA();
+
+                this->appendMultiplyAddImmediateOp(pipeline, alloc, OffsetFromBase(dst),
+                                                   inst.fImmB, inst.fImmC, inst.fImmA);
+                break;
+            }
             case ALL_N_WAY_BINARY_OP_CASES: {
                 float* src = tempStackPtr - (inst.fImmA * N);
                 float* dst = tempStackPtr - (inst.fImmA * 2 * N);
@@ -2673,6 +2709,14 @@ public:
                 this->imm(sk_bit_cast<float>(ctx.value), showAsFloat)};
     }
 
+    // Interprets the context value as a MultiplyAddConstantCtx structure.
+    std::tuple<std::string, std::string, std::string> multiplyAddConstantCtx(const void* v) const {
+        auto ctx = SkRPCtxUtils::Unpack((const SkRasterPipeline_MultiplyAddConstantCtx*)v);
+        return {this->offsetCtx(ctx.dst, 1),
+                this->imm(sk_bit_cast<float>(ctx.mul)),
+                this->imm(sk_bit_cast<float>(ctx.add))};
+    }
+
     // Interprets the context value as a BinaryOp structure for copy_n_slots (numSlots is dictated
     // by the op itself).
     std::tuple<std::string, std::string> binaryOpCtx(const void* v, int numSlots) const {
@@ -3056,6 +3100,10 @@ void Program::Dumper::dump(SkWStream* out, bool writeInstructionCount) {
                 std::tie(opArg1, opArg2) = this->constantCtx(stage.ctx, 1);
                 break;
 
+            case POp::mad_imm_float:
+                std::tie(opArg1, opArg2, opArg3) = this->multiplyAddConstantCtx(stage.ctx);
+                break;
+
             case POp::add_imm_int:
             case POp::mul_imm_int:
             case POp::bitwise_and_imm_int:
@@ -3611,6 +3659,10 @@ void Program::Dumper::dump(SkWStream* out, bool writeInstructionCount) {
                 opText = opArg1 + " += " + opArg2;
                 break;
 
+            case POp::mad_imm_float:
+                opText = opArg1 + " = " + opArg1 + " * " + opArg2 + " + " + opArg3;
+                break;
+
             case POp::sub_float:    case POp::sub_int:
             case POp::sub_2_floats: case POp::sub_2_ints:
             case POp::sub_3_floats: case POp::sub_3_ints:
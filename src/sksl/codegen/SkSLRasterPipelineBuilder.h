@@ -239,6 +239,11 @@ private:
                                  ProgramOp baseStage,
                                  SkRPOffset dst, int32_t value, int numSlots) const;
 
+    // Appends one fused `dst = dst * mul + add` stage per slot.
+    void appendMultiplyAddImmediateOp(skia_private::TArray<Stage>* pipeline, SkArenaAlloc* alloc,
+                                      SkRPOffset dst, int32_t mul, int32_t add,
+                                      int numSlots) const;
+
     // Appends a two-input math operation to the pipeline. `src` must be _immediately_ after `dst`
     // in memory. `baseStage` must refer to an unbounded "apply_to_n_slots" stage. A BinaryOpCtx
     // will be used to pass pointers to the destination and source; the delta between the two
@@ -74,9 +74,15 @@ std::optional<GlyphVector> GlyphVector::MakeFromBuffer(SkReadBuffer& buffer,
         return std::nullopt;
     }
 
+    // Read the IDs in one step instead of validating each one; slugs can hold many glyphs.
+    const uint32_t* packedGlyphIDs =
+            static_cast<const uint32_t*>(buffer.skip(glyphCount, sizeof(uint32_t)));
+    if (packedGlyphIDs == nullptr) {
+        return std::nullopt;
+    }
     Variant* variants = alloc->makePODArray<Variant>(glyphCount);
     for (int i = 0; i < glyphCount; i++) {
-        variants[i].packedGlyphID = SkPackedGlyphID(buffer.readUInt());
+        variants[i].packedGlyphID = SkPackedGlyphID(packedGlyphIDs[i]);
     }
     return GlyphVector{std::move(promise.value()), SkSpan(variants, glyphCount)};
 }
@@ -210,6 +210,13 @@ private:
     mutable SkStrikePromise fStrikePromise;
     mutable SkOnce fConvertIDsToPaths;
     mutable bool fPathsAreCreated{false};
+
+    // All the glyphs of the run in one path, in source space relative to the draw origin. It
+    // doesn't depend on the matrix, so a run that is zoomed or animated is drawn with one path
+    // draw without rebuilding anything.
+    mutable SkOnce fBuildOutline;
+    mutable SkPath fOutline;
+    mutable bool fHasOutline{false};
 };
 
 int PathOpSubmitter::unflattenSize() const {
@@ -246,10 +253,11 @@ std::optional<PathOpSubmitter> PathOpSubmitter::MakeFromBuffer(SkReadBuffer& buf
     const int glyphCount = SkCount(positions);
 
     // Remember, we stored an int for glyph id.
-    if (!buffer.validateCanReadN<int>(glyphCount)) { return std::nullopt; }
+    const int32_t* glyphIDs = static_cast<const int32_t*>(buffer.skip(glyphCount, sizeof(int)));
+    if (glyphIDs == nullptr) { return std::nullopt; }
     auto idsOrPaths = SkSpan(alloc->makeUniqueArray<IDOrPath>(glyphCount).release(), glyphCount);
-    for (auto& idOrPath : idsOrPaths) {
-        idOrPath.fGlyphID = SkTo<SkGlyphID>(buffer.readInt());
+    for (int i = 0; i < glyphCount; ++i) {
+        idsOrPaths[i].fGlyphID = SkTo<SkGlyphID>(glyphIDs[i]);
     }
 
     if (!buffer.isValid()) { return std::nullopt; }
@@ -331,6 +339,35 @@ PathOpSubmitter::submitDraws(SkCanvas* canvas, SkPoint drawOrigin, const SkPaint
                          || runPaint.getPathEffect()
                          || (!style.isFillStyle() && !style.isHairlineStyle())
                          || (maskFilter != nullptr && !maskFilter->asABlur(nullptr));
+    // Overlapping glyphs look the same drawn one at a time as drawn all at once when the paint
+    // overwrites what is under it. Mask filters are applied to each glyph on its own.
+    if (!needsExactCTM && maskFilter == nullptr && fIDsOrPaths.size() > 1 &&
+        SkPaintPriv::Overwrites(&runPaint, SkPaintPriv::kNone_ShaderOverrideOpacity)) {
+        fBuildOutline([&]() {
+            if (!fPathsAreCreated) {
+                return;
+            }
+            const SkPathFillType fillType = fIDsOrPaths.front().fPath.getFillType();
+            for (auto [idOrPath, pos] : SkMakeZip(fIDsOrPaths, fPositions)) {
+                if (idOrPath.fPath.getFillType() != fillType) {
+                    fOutline.reset();
+                    return;
+                }
+                SkMatrix pathMatrix = SkMatrix::Scale(fStrikeToSourceScale, fStrikeToSourceScale);
+                pathMatrix.postTranslate(pos.x(), pos.y());
+                fOutline.addPath(idOrPath.fPath, pathMatrix);
+            }
+            fOutline.setFillType(fillType);
+            fHasOutline = true;
+        });
+        if (fHasOutline) {
+            SkAutoCanvasRestore acr(canvas, true);
+            canvas->translate(drawOrigin.x(), drawOrigin.y());
+            canvas->drawPath(fOutline, runPaint);
+            return;
+        }
+    }
+
     if (!needsExactCTM) {
         SkMaskFilterBase::BlurRec blurRec;
 
@@ -503,11 +540,12 @@ std::optional<DrawableOpSubmitter> DrawableOpSubmitter::MakeFromBuffer(
     if (positions.empty()) { return std::nullopt; }
     const int glyphCount = SkCount(positions);
 
-    if (!buffer.validateCanReadN<int>(glyphCount)) { return std::nullopt; }
+    // Remember, we stored an int for glyph id.
+    const int32_t* glyphIDs = static_cast<const int32_t*>(buffer.skip(glyphCount, sizeof(int)));
+    if (glyphIDs == nullptr) { return std::nullopt; }
     auto idsOrDrawables = alloc->makePODArray<IDOrDrawable>(glyphCount);
     for (int i = 0; i < SkToInt(glyphCount); ++i) {
-        // Remember, we stored an int for glyph id.
-        idsOrDrawables[i].fGlyphID = SkTo<SkGlyphID>(buffer.readInt());
+        idsOrDrawables[i].fGlyphID = SkTo<SkGlyphID>(glyphIDs[i]);
     }
 
     SkASSERT(buffer.isValid());
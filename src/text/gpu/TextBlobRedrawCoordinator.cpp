@@ -14,6 +14,7 @@
 #include "src/core/SkStrikeCache.h"
 #include "src/text/GlyphRun.h"
 
+#include <atomic>
 #include <utility>
 
 class SkCanvas;
@@ -63,6 +64,9 @@ sk_sp<TextBlob> TextBlobRedrawCoordinator::findOrCreateBlob(const SkMatrix& view
     }
 
     if (blob == nullptr || !blob->canReuse(paint, positionMatrix)) {
+        if (canCache) {
+            fMissCount.fetch_add(1, std::memory_order_relaxed);
+        }
         if (blob != nullptr) {
             // We have to remake the blob because changes may invalidate our masks.
             this->remove(blob.get());
@@ -78,6 +82,8 @@ sk_sp<TextBlob> TextBlobRedrawCoordinator::findOrCreateBlob(const SkMatrix& view
             // that was there.
             blob = this->addOrReturnExisting(glyphRunList, blob);
         }
+    } else {
+        fHitCount.fetch_add(1, std::memory_order_relaxed);
     }
 
     return blob;
@@ -179,6 +185,10 @@ bool TextBlobRedrawCoordinator::isOverBudget() const {
     return fCurrentSize > fSizeBudget;
 }
 
+TextBlobRedrawCoordinator::Stats TextBlobRedrawCoordinator::stats() const {
+    return {fHitCount.load(std::memory_order_relaxed), fMissCount.load(std::memory_order_relaxed)};
+}
+
 void TextBlobRedrawCoordinator::internalCheckPurge(TextBlob* blob) {
     // First, purge all stale blob IDs.
     this->internalPurgeStaleBlobs();
@@ -18,6 +18,7 @@
 #include "src/text/gpu/SubRunContainer.h"
 #include "src/text/gpu/TextBlob.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -65,6 +66,14 @@ public:
 
     bool isOverBudget() const SK_EXCLUDES(fSpinLock);
 
+    // Counts of cacheable draws that reused a cached blob (hits) and that had to make a new one
+    // because none was cached or the cached one could not handle the draw (misses).
+    struct Stats {
+        int fHits = 0;
+        int fMisses = 0;
+    };
+    Stats stats() const;
+
 private:
     friend class ::GrTextBlobTestingPeer;
     using TextBlobList = SkTInternalLList<TextBlob>;
@@ -122,6 +131,10 @@ private:
     // In practice 'messageBusID' is always the unique ID of the owning GrContext
     const uint32_t fMessageBusID;
     SkMessageBus<PurgeBlobMessage, uint32_t>::Inbox fPurgeBlobInbox SK_GUARDED_BY(fSpinLock);
+
+    // Only used for reporting, so they are updated outside of the lock.
+    std::atomic<int> fHitCount{0};
+    std::atomic<int> fMissCount{0};
 };
 
 }  // namespace sktext::gpu
@@ -0,0 +1,622 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkCostAnalysisCanvas.h"
+
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkBlender.h"
+#include "include/core/SkColorFilter.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageFilter.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRSXform.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkVertices.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkBlenderBase.h"
+#include "src/core/SkDrawShadowInfo.h"
+#include "src/core/SkEffectPriv.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpList.h"
+#include "src/core/SkTHash.h"
+#include "src/effects/colorfilters/SkColorFilterBase.h"
+#include "src/shaders/SkShaderBase.h"
+#include "src/text/GlyphRun.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Rough costs, in stage-pixels. Only their sizes relative to each other matter.
+constexpr double kOpOverhead     = 256;  // Setting up any draw.
+constexpr double kPerVerb        = 16;   // Building edges for a path.
+constexpr double kPerGlyph       = 64;   // Finding and placing a glyph's mask.
+constexpr double kPerVertex      = 8;
+constexpr double kPerQuad        = 32;   // Each entry of an atlas, rect set or image set.
+constexpr int    kCoverageStages = 1;    // Scaling by antialiased or mask coverage.
+constexpr int    kMaskFilterStages  = 16;  // Blurring, roughly.
+constexpr int    kImageFilterStages = 16;  // Per filter in an image filter DAG.
+constexpr int    kLayerStages    = 2;    // Clearing a layer and reading it back to composite.
+constexpr int    kUnknownStages  = 16;   // For effects that can't be appended to a pipeline.
+
+int sampling_stages(const SkSamplingOptions& sampling) {
+    if (sampling.useCubic || sampling.isAniso()) {
+        return 16;
+    }
+    if (sampling.mipmap != SkMipmapMode::kNone) {
+        return 12;
+    }
+    return sampling.filter == SkFilterMode::kLinear ? 8 : 4;
+}
+
+int count_filters(const SkImageFilter* filter) {
+    if (!filter) {
+        return 0;
+    }
+    int count = 1;
+    for (int i = 0; i < filter->countInputs(); ++i) {
+        count += count_filters(filter->getInput(i));
+    }
+    return count;
+}
+
+}  // namespace
+
+// What's known about a draw before it's mapped to the device.
+struct SkCostAnalysisCanvas::Draw {
+    SkRect         fBounds = SkRect::MakeEmpty();  // Local, before the paint's outsets.
+    bool           fUnbounded = false;             // Covers the whole clip.
+    const SkPaint* fPaint = nullptr;
+    int            fStages = 0;                    // On top of the paint's.
+    double         fFixedCost = 0;                 // On top of kOpOverhead.
+    int64_t        fPixels = -1;                   // If known better than by fBounds.
+};
+
+// Counts the raster pipeline stages a paint's shader, color filter and blender need, once per
+// combination of them.
+class SkCostAnalysisCanvas::StageCounter {
+public:
+    int count(const SkPaint& paint, const SkMatrix& ctm) {
+        const Key key = {paint.getShader(), paint.getColorFilter(), paint.getBlender()};
+        if (const int* stages = fCache.find(key)) {
+            return *stages;
+        }
+        // Keep them alive, so their addresses aren't reused while they're keys.
+        fEffects.push_back(paint.refShader());
+        fColorFilters.push_back(paint.refColorFilter());
+        fBlenders.push_back(paint.refBlender());
+        return *fCache.set(key, CountStages(paint, ctm));
+    }
+
+private:
+    struct Key {
+        const SkShader*      fShader;
+        const SkColorFilter* fColorFilter;
+        const SkBlender*     fBlender;
+
+        bool operator==(const Key& that) const {
+            return fShader == that.fShader &&
+                   fColorFilter == that.fColorFilter &&
+                   fBlender == that.fBlender;
+        }
+    };
+
+    static int CountStages(const SkPaint& paint, const SkMatrix& ctm) {
+        SkSTArenaAlloc<2048> alloc;
+        SkRasterPipeline pipeline(&alloc);
+        const SkSurfaceProps props;
+        const SkColor4f color = paint.getColor4f();
+        const SkStageRec rec = {&pipeline, &alloc, kN32_SkColorType, nullptr, color, props};
+
+        if (const SkShader* shader = paint.getShader()) {
+            if (!as_SB(shader)->appendRootStages(rec, ctm)) {
+                return kUnknownStages;
+            }
+        } else {
+            pipeline.appendConstantColor(&alloc, color.premul().vec());
+        }
+        if (const SkColorFilter* colorFilter = paint.getColorFilter()) {
+            if (!as_CFB(colorFilter)->appendStages(rec, /*shaderIsOpaque=*/false)) {
+                return kUnknownStages;
+            }
+        }
+        if (const SkBlender* blender = paint.getBlender()) {
+            if (!as_BB(blender)->appendStages(rec)) {
+                return kUnknownStages;
+            }
+        } else {
+            pipeline.append(SkRasterPipelineOp::srcover);
+        }
+        // Loading and storing the destination.
+        return pipeline.getNumStages() + 2;
+    }
+
+    skia_private::THashMap<Key, int, SkGoodHash> fCache;
+    std::vector<sk_sp<SkShader>> fEffects;
+    std::vector<sk_sp<SkColorFilter>> fColorFilters;
+    std::vector<sk_sp<SkBlender>> fBlenders;
+};
+
+SkCostAnalysisCanvas::SkCostAnalysisCanvas(int width, int height, int heatmapCellSize)
+        : INHERITED(width, height)
+        , fHeatmapCellSize(std::max(heatmapCellSize, 0))
+        , fHeatmapDimensions(SkISize::MakeEmpty())
+        , fStageCounter(std::make_unique<StageCounter>()) {
+    if (fHeatmapCellSize > 0) {
+        fHeatmapDimensions = {(width + fHeatmapCellSize - 1) / fHeatmapCellSize,
+                              (height + fHeatmapCellSize - 1) / fHeatmapCellSize};
+        fHeatmap.assign(fHeatmapDimensions.area(), 0);
+    }
+}
+
+SkCostAnalysisCanvas::~SkCostAnalysisCanvas() = default;
+
+void SkCostAnalysisCanvas::reset() {
+    std::fill(fHeatmap.begin(), fHeatmap.end(), 0);
+    fStageCounter = std::make_unique<StageCounter>();
+    fOps.clear();
+    fNodes.clear();
+    fTotalCost = 0;
+}
+
+void SkCostAnalysisCanvas::addOp(const char* name, const Draw& draw) {
+    const SkIRect clip = this->getDeviceClipBounds();
+    SkIRect deviceBounds = clip;
+    if (!draw.fUnbounded) {
+        SkRect bounds = draw.fBounds.makeSorted();
+        SkRect storage;
+        if (draw.fPaint && draw.fPaint->canComputeFastBounds()) {
+            bounds = draw.fPaint->computeFastBounds(bounds, &storage);
+        }
+        if (!draw.fPaint || draw.fPaint->canComputeFastBounds()) {
+            SkIRect mapped = this->getLocalToDeviceAs3x3().mapRect(bounds).roundOut();
+            if (!deviceBounds.intersect(mapped)) {
+                deviceBounds.setEmpty();
+            }
+        }
+    }
+    const int64_t pixels = draw.fPixels >= 0 ? draw.fPixels
+                                             : int64_t(deviceBounds.width()) *
+                                               int64_t(deviceBounds.height());
+
+    SkPaint defaultPaint;
+    const SkPaint& paint = draw.fPaint ? *draw.fPaint : defaultPaint;
+    int stages = fStageCounter->count(paint, this->getLocalToDeviceAs3x3()) + draw.fStages;
+    if (paint.getMaskFilter()) {
+        stages += kMaskFilterStages;
+    }
+    if (const int filters = count_filters(paint.getImageFilter())) {
+        // Drawn into a layer, filtered and composited.
+        stages += kLayerStages + filters * kImageFilterStages;
+    }
+
+    const double cost = kOpOverhead + draw.fFixedCost + double(pixels) * stages;
+    fOps.push_back({(int)fOps.size(), name, fCurrentNode, deviceBounds, pixels, stages,
+                    fLayerDepth, cost});
+    fTotalCost += cost;
+    for (int node = fCurrentNode; node >= 0; node = fNodes[node].fParent) {
+        fNodes[node].fDeviceBounds.join(deviceBounds);
+        fNodes[node].fOpCount += 1;
+        fNodes[node].fCost += cost;
+    }
+
+    if (fHeatmapCellSize > 0 && !deviceBounds.isEmpty()) {
+        // Spread the cost evenly over the cells the draw covers.
+        const double costPerPixel =
+                cost / (double(deviceBounds.width()) * double(deviceBounds.height()));
+        const int s = fHeatmapCellSize;
+        for (int y = deviceBounds.fTop / s; y <= (deviceBounds.fBottom - 1) / s; ++y) {
+            const int rows = std::min(deviceBounds.fBottom, (y + 1) * s) -
+                             std::max(deviceBounds.fTop, y * s);
+            for (int x = deviceBounds.fLeft / s; x <= (deviceBounds.fRight - 1) / s; ++x) {
+                const int cols = std::min(deviceBounds.fRight, (x + 1) * s) -
+                                 std::max(deviceBounds.fLeft, x * s);
+                fHeatmap[y * fHeatmapDimensions.width() + x] += costPerPixel * rows * cols;
+            }
+        }
+    }
+}
+
+void SkCostAnalysisCanvas::pushNode(const char* name, uint32_t uniqueID) {
+    fNodes.push_back({name, fCurrentNode, uniqueID, SkIRect::MakeEmpty(), 0, 0});
+    fCurrentNode = (int)fNodes.size() - 1;
+}
+
+void SkCostAnalysisCanvas::popNode() {
+    SkASSERT(fCurrentNode >= 0);
+    fCurrentNode = fNodes[fCurrentNode].fParent;
+}
+
+std::vector<SkCostAnalysisCanvas::Op> SkCostAnalysisCanvas::mostExpensiveOps(int count) const {
+    std::vector<Op> ops = fOps;
+    const size_t n = std::min<size_t>(std::max(count, 0), ops.size());
+    std::partial_sort(ops.begin(), ops.begin() + n, ops.end(), [](const Op& a, const Op& b) {
+        return a.fCost > b.fCost || (a.fCost == b.fCost && a.fIndex < b.fIndex);
+    });
+    ops.resize(n);
+    return ops;
+}
+
+std::vector<SkCostAnalysisCanvas::Node> SkCostAnalysisCanvas::mostExpensiveNodes(
+        int count) const {
+    std::vector<Node> nodes = fNodes;
+    const size_t n = std::min<size_t>(std::max(count, 0), nodes.size());
+    // Stable, so that a node comes before the children that cost as much as it does.
+    std::stable_sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) {
+        return a.fCost > b.fCost;
+    });
+    nodes.resize(n);
+    return nodes;
+}
+
+SkBitmap SkCostAnalysisCanvas::heatmap() const {
+    SkBitmap bitmap;
+    if (fHeatmap.empty() ||
+        !bitmap.tryAllocPixels(SkImageInfo::Make(fHeatmapDimensions, kGray_8_SkColorType,
+                                                 kOpaque_SkAlphaType))) {
+        return {};
+    }
+    const double maxCost = *std::max_element(fHeatmap.begin(), fHeatmap.end());
+    for (int y = 0; y < fHeatmapDimensions.height(); ++y) {
+        uint8_t* row = bitmap.getAddr8(0, y);
+        for (int x = 0; x < fHeatmapDimensions.width(); ++x) {
+            const double cost = fHeatmap[y * fHeatmapDimensions.width() + x];
+            row[x] = maxCost > 0 ? (uint8_t)std::lround(255 * cost / maxCost) : 0;
+        }
+    }
+    return bitmap;
+}
+
+SkString SkCostAnalysisCanvas::report(int count) const {
+    SkString report;
+    report.appendf("Total cost: %.0f stage-pixels over %zu ops\n", fTotalCost, fOps.size());
+    auto percent = [this](double cost) { return fTotalCost > 0 ? 100 * cost / fTotalCost : 0; };
+    if (!fNodes.empty()) {
+        report.append("Costliest pictures and drawables:\n");
+        for (const Node& node : this->mostExpensiveNodes(count)) {
+            report.appendf("  %5.1f%% %s id=%u ops=%d bounds=[%d %d %d %d]\n",
+                           percent(node.fCost), node.fName, node.fUniqueID, node.fOpCount,
+                           node.fDeviceBounds.fLeft, node.fDeviceBounds.fTop,
+                           node.fDeviceBounds.fRight, node.fDeviceBounds.fBottom);
+        }
+    }
+    report.append("Costliest ops:\n");
+    for (const Op& op : this->mostExpensiveOps(count)) {
+        report.appendf("  %5.1f%% #%d %s pixels=%lld stages=%d layers=%d bounds=[%d %d %d %d]\n",
+                       percent(op.fCost), op.fIndex, op.fName, (long long)op.fPixels, op.fStages,
+                       op.fLayerDepth, op.fDeviceBounds.fLeft, op.fDeviceBounds.fTop,
+                       op.fDeviceBounds.fRight, op.fDeviceBounds.fBottom);
+    }
+    return report;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SkCanvas::SaveLayerStrategy SkCostAnalysisCanvas::getSaveLayerStrategy(const SaveLayerRec& rec) {
+    Draw draw;
+    if (rec.fBounds) {
+        draw.fBounds = *rec.fBounds;
+    } else {
+        draw.fUnbounded = true;
+    }
+    draw.fPaint = rec.fPaint;
+    draw.fStages = kLayerStages;
+    if (const int filters = count_filters(rec.fBackdrop)) {
+        draw.fStages += kLayerStages + filters * kImageFilterStages;
+    }
+    // The layer's filters are costed here, once, by addOp().
+    this->addOp("saveLayer", draw);
+
+    fSaveIsLayer.push_back(true);
+    fLayerDepth += 1;
+    return this->INHERITED::getSaveLayerStrategy(rec);
+}
+
+void SkCostAnalysisCanvas::willSave() {
+    fSaveIsLayer.push_back(false);
+    this->INHERITED::willSave();
+}
+
+void SkCostAnalysisCanvas::willRestore() {
+    if (!fSaveIsLayer.empty()) {
+        if (fSaveIsLayer.back()) {
+            fLayerDepth -= 1;
+        }
+        fSaveIsLayer.pop_back();
+    }
+    this->INHERITED::willRestore();
+}
+
+bool SkCostAnalysisCanvas::onDoSaveBehind(const SkRect* bounds) {
+    // Restored like any other save.
+    fSaveIsLayer.push_back(false);
+    return this->INHERITED::onDoSaveBehind(bounds);
+}
+
+void SkCostAnalysisCanvas::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                                          const SkPaint& paint) {
+    // Skip SkNoDrawCanvas, so the blob comes back through onDrawGlyphRunList().
+    this->SkCanvas::onDrawTextBlob(blob, x, y, paint);
+}
+
+void SkCostAnalysisCanvas::onDrawGlyphRunList(const sktext::GlyphRunList& glyphRunList,
+                                              const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = glyphRunList.sourceBoundsWithOrigin();
+    draw.fPaint = &paint;
+    draw.fStages = kCoverageStages;
+    draw.fFixedCost = kPerGlyph * glyphRunList.totalGlyphCount();
+    this->addOp("drawGlyphs", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                                       const SkPoint texCoords[4], SkBlendMode mode,
+                                       const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds.setBounds(cubics, 12);
+    draw.fPaint = &paint;
+    draw.fStages = (colors ? 1 : 0) + (texCoords ? 1 : 0);
+    // Patches are tessellated into a grid of vertices.
+    draw.fFixedCost = kPerVertex * 21 * 21;
+    this->addOp("drawPatch", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawPaint(const SkPaint& paint) {
+    Draw draw;
+    draw.fUnbounded = true;
+    draw.fPaint = &paint;
+    this->addOp("drawPaint", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawBehind(const SkPaint& paint) {
+    Draw draw;
+    draw.fUnbounded = true;
+    draw.fPaint = &paint;
+    this->addOp("drawBehind", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                                        const SkPaint& paint) {
+    if (count == 0) {
+        return;
+    }
+    Draw draw;
+    draw.fBounds.setBounds(pts, SkToInt(count));
+    draw.fPaint = &paint;
+    draw.fStages = paint.isAntiAlias() ? kCoverageStages : 0;
+    draw.fFixedCost = kPerVerb * count;
+    this->addOp("drawPoints", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = rect;
+    draw.fPaint = &paint;
+    this->addOp("drawRect", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = SkRect::Make(region.getBounds());
+    draw.fPaint = &paint;
+    this->addOp("drawRegion", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawOval(const SkRect& oval, const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = oval;
+    draw.fPaint = &paint;
+    draw.fStages = paint.isAntiAlias() ? kCoverageStages : 0;
+    this->addOp("drawOval", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawArc(const SkRect& oval, SkScalar, SkScalar, bool,
+                                     const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = oval;
+    draw.fPaint = &paint;
+    draw.fStages = paint.isAntiAlias() ? kCoverageStages : 0;
+    this->addOp("drawArc", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = rrect.getBounds();
+    draw.fPaint = &paint;
+    draw.fStages = paint.isAntiAlias() ? kCoverageStages : 0;
+    this->addOp("drawRRect", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect&,
+                                        const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = outer.getBounds();
+    draw.fPaint = &paint;
+    draw.fStages = paint.isAntiAlias() ? kCoverageStages : 0;
+    this->addOp("drawDRRect", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
+    Draw draw;
+    draw.fUnbounded = path.isInverseFillType();
+    draw.fBounds = path.getBounds();
+    draw.fPaint = &paint;
+    draw.fStages = paint.isAntiAlias() ? kCoverageStages : 0;
+    draw.fFixedCost = kPerVerb * path.countVerbs();
+    this->addOp("drawPath", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawImage2(const SkImage* image, SkScalar x, SkScalar y,
+                                        const SkSamplingOptions& sampling,
+                                        const SkPaint* paint) {
+    Draw draw;
+    draw.fBounds = SkRect::MakeXYWH(x, y, image->width(), image->height());
+    draw.fPaint = paint;
+    draw.fStages = sampling_stages(sampling);
+    this->addOp("drawImage", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawImageRect2(const SkImage*, const SkRect&, const SkRect& dst,
+                                            const SkSamplingOptions& sampling,
+                                            const SkPaint* paint, SrcRectConstraint constraint) {
+    Draw draw;
+    draw.fBounds = dst;
+    draw.fPaint = paint;
+    draw.fStages = sampling_stages(sampling) + (constraint == kStrict_SrcRectConstraint ? 2 : 0);
+    this->addOp("drawImageRect", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawImageLattice2(const SkImage*, const Lattice& lattice,
+                                               const SkRect& dst, SkFilterMode filter,
+                                               const SkPaint* paint) {
+    Draw draw;
+    draw.fBounds = dst;
+    draw.fPaint = paint;
+    draw.fStages = sampling_stages(SkSamplingOptions(filter));
+    draw.fFixedCost = kPerQuad * (lattice.fXCount + 1) * (lattice.fYCount + 1);
+    this->addOp("drawImageLattice", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawAtlas2(const SkImage*, const SkRSXform xforms[],
+                                        const SkRect tex[], const SkColor colors[], int count,
+                                        SkBlendMode, const SkSamplingOptions& sampling,
+                                        const SkRect* cull, const SkPaint* paint) {
+    Draw draw;
+    draw.fPixels = 0;
+    const SkMatrix& ctm = this->getLocalToDeviceAs3x3();
+    const SkIRect clip = this->getDeviceClipBounds();
+    for (int i = 0; i < count; ++i) {
+        SkMatrix matrix;
+        matrix.setRSXform(xforms[i]);
+        const SkRect bounds = matrix.mapRect(SkRect::MakeWH(tex[i].width(), tex[i].height()));
+        draw.fBounds.join(bounds);
+        SkIRect device = SkMatrix::Concat(ctm, matrix).mapRect(
+                SkRect::MakeWH(tex[i].width(), tex[i].height())).roundOut();
+        if (device.intersect(clip)) {
+            draw.fPixels += int64_t(device.width()) * int64_t(device.height());
+        }
+    }
+    if (cull) {
+        draw.fBounds = *cull;
+    }
+    draw.fPaint = paint;
+    draw.fStages = sampling_stages(sampling) + (colors ? 2 : 0);
+    draw.fFixedCost = kPerQuad * count;
+    this->addOp("drawAtlas", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawVerticesObject(const SkVertices* vertices, SkBlendMode,
+                                                const SkPaint& paint) {
+    Draw draw;
+    draw.fBounds = vertices->bounds();
+    draw.fPaint = &paint;
+    draw.fStages = 2;  // Interpolating colors or texture coordinates.
+    draw.fFixedCost = kPerVertex * vertices->approximateSize() / sizeof(SkPoint);
+    this->addOp("drawVertices", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
+    Draw draw;
+    SkDrawShadowMetrics::GetLocalBounds(path, rec, this->getLocalToDeviceAs3x3(), &draw.fBounds);
+    draw.fStages = kMaskFilterStages;
+    draw.fFixedCost = kPerVerb * path.countVerbs();
+    this->addOp("drawShadow", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
+    this->pushNode("drawDrawable", 0);
+    // Skip SkNoDrawCanvas, so the drawable draws into this canvas.
+    this->SkCanvas::onDrawDrawable(drawable, matrix);
+    this->popNode();
+}
+
+void SkCostAnalysisCanvas::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                                         const SkPaint* paint) {
+    this->pushNode("drawPicture", picture->uniqueID());
+    // Skip SkNoDrawCanvas, so the picture plays back into this canvas.
+    this->SkCanvas::onDrawPicture(picture, matrix, paint);
+    this->popNode();
+}
+
+void SkCostAnalysisCanvas::onDrawAnnotation(const SkRect&, const char[], SkData*) {}
+
+void SkCostAnalysisCanvas::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
+                                            QuadAAFlags aa, const SkColor4f& color,
+                                            SkBlendMode mode) {
+    SkPaint paint(color);
+    paint.setBlendMode(mode);
+    Draw draw;
+    if (clip) {
+        draw.fBounds.setBounds(clip, 4);
+    } else {
+        draw.fBounds = rect;
+    }
+    draw.fPaint = &paint;
+    draw.fStages = aa != kNone_QuadAAFlags ? kCoverageStages : 0;
+    this->addOp("drawEdgeAAQuad", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                               const SkMatrix[], int count, QuadAAFlags aa,
+                                               SkBlendMode mode) {
+    SkPaint paint;
+    paint.setBlendMode(mode);
+    Draw draw;
+    draw.fPixels = 0;
+    const SkMatrix& ctm = this->getLocalToDeviceAs3x3();
+    const SkIRect clip = this->getDeviceClipBounds();
+    for (int i = 0; i < count; ++i) {
+        draw.fBounds.join(rects[i]);
+        SkIRect device = ctm.mapRect(rects[i]).roundOut();
+        if (device.intersect(clip)) {
+            draw.fPixels += int64_t(device.width()) * int64_t(device.height());
+        }
+    }
+    draw.fPaint = &paint;
+    draw.fStages = (aa != kNone_QuadAAFlags ? kCoverageStages : 0) + (colors ? 1 : 0);
+    draw.fFixedCost = kPerQuad * count;
+    this->addOp("drawEdgeAARectSet", draw);
+}
+
+void SkCostAnalysisCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry set[], int count,
+                                                 const SkPoint[], const SkMatrix preViewMatrices[],
+                                                 const SkSamplingOptions& sampling,
+                                                 const SkPaint* paint,
+                                                 SrcRectConstraint constraint) {
+    Draw draw;
+    draw.fPixels = 0;
+    const SkMatrix& ctm = this->getLocalToDeviceAs3x3();
+    const SkIRect clip = this->getDeviceClipBounds();
+    for (int i = 0; i < count; ++i) {
+        SkMatrix matrix = ctm;
+        SkRect bounds = set[i].fDstRect;
+        if (set[i].fMatrixIndex >= 0) {
+            bounds = preViewMatrices[set[i].fMatrixIndex].mapRect(bounds);
+            matrix.preConcat(preViewMatrices[set[i].fMatrixIndex]);
+        }
+        draw.fBounds.join(bounds);
+        SkIRect device = matrix.mapRect(set[i].fDstRect).roundOut();
+        if (device.intersect(clip)) {
+            draw.fPixels += int64_t(device.width()) * int64_t(device.height());
+        }
+    }
+    draw.fPaint = paint;
+    draw.fStages = sampling_stages(sampling) + (constraint == kStrict_SrcRectConstraint ? 2 : 0);
+    draw.fFixedCost = kPerQuad * count;
+    this->addOp("drawEdgeAAImageSet", draw);
+}
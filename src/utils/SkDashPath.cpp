@@ -7,6 +7,7 @@
 
 #include "src/utils/SkDashPathPriv.h"
 
+#include "include/core/SkContourMeasure.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
@@ -19,6 +20,7 @@
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTo.h"
+#include "src/core/SkContourMeasureCache.h"
 #include "src/core/SkPathEnums.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkPointPriv.h"
@@ -383,12 +385,15 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
     bool specialLine = (StrokeRecApplication::kAllow == strokeRecApplication) &&
                        lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength);
 
-    SkPathMeasure   meas(*srcPtr, false, rec->getResScale());
+    // A culled path is only drawn once, so there is no point in caching its contours.
+    const sk_sp<const SkMeasuredPath> measured =
+            srcPtr == &src ? SkMeasuredPath::Make(src, false, rec->getResScale())
+                           : SkMeasuredPath::MakeUncached(*srcPtr, false, rec->getResScale());
 
-    do {
-        bool        skipFirstSegment = meas.isClosed();
+    for (const sk_sp<SkContourMeasure>& meas : *measured) {
+        bool        skipFirstSegment = meas->isClosed();
         bool        addedSegment = false;
-        SkScalar    length = meas.getLength();
+        SkScalar    length = meas->length();
         int         index = initialDashIndex;
 
         // Since the path length / dash length ratio may be arbitrarily large, we can exert
@@ -422,9 +427,9 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                                        SkDoubleToScalar(distance + dlen),
                                        dst);
                 } else {
-                    meas.getSegment(SkDoubleToScalar(distance),
-                                    SkDoubleToScalar(distance + dlen),
-                                    dst, true);
+                    (void)meas->getSegment(SkDoubleToScalar(distance),
+                                           SkDoubleToScalar(distance + dlen),
+                                           dst, true);
                 }
             }
             distance += dlen;
@@ -444,12 +449,12 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         }
 
         // extend if we ended on a segment and we need to join up with the (skipped) initial segment
-        if (meas.isClosed() && is_even(initialDashIndex) &&
+        if (meas->isClosed() && is_even(initialDashIndex) &&
             initialDashLength >= 0) {
-            meas.getSegment(0, initialDashLength, dst, !addedSegment);
+            (void)meas->getSegment(0, initialDashLength, dst, !addedSegment);
             ++segCount;
         }
-    } while (meas.nextContour());
+    }
 
     // TODO: do we still need this?
     if (segCount > 1) {
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkImageResize.h"
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+
+using namespace skia_private;
+
+namespace SkImageResize {
+
+namespace {
+
+float box(float x) { return x >= -0.5f && x < 0.5f ? 1.0f : 0.0f; }
+
+float triangle(float x) {
+    x = std::abs(x);
+    return x < 1 ? 1 - x : 0;
+}
+
+// Mitchell & Netravali's family of cubics, as in SkCubicResampler.
+template <int kB_x6, int kC_x6>
+float cubic(float x) {
+    constexpr float B = kB_x6 / 6.0f,
+                    C = kC_x6 / 6.0f;
+    x = std::abs(x);
+    if (x < 1) {
+        return ((12 - 9*B - 6*C) * x*x*x + (-18 + 12*B + 6*C) * x*x + (6 - 2*B)) / 6;
+    }
+    if (x < 2) {
+        return ((-B - 6*C) * x*x*x + (6*B + 30*C) * x*x + (-12*B - 48*C) * x + (8*B + 24*C)) / 6;
+    }
+    return 0;
+}
+
+float lanczos3(float x) {
+    if (x == 0) {
+        return 1;
+    }
+    if (std::abs(x) >= 3) {
+        return 0;
+    }
+    const float px = SK_FloatPI * x;
+    return 3 * std::sin(px) * std::sin(px / 3) / (px * px);
+}
+
+struct Kernel {
+    float fRadius;
+    float (*fEval)(float);
+};
+
+Kernel kernel(Filter filter) {
+    switch (filter) {
+        case Filter::kBox:        return {0.5f, box};
+        case Filter::kTriangle:   return {1.0f, triangle};
+        case Filter::kMitchell:   return {2.0f, cubic<2, 2>};
+        case Filter::kCatmullRom: return {2.0f, cubic<0, 3>};
+        case Filter::kLanczos3:   return {3.0f, lanczos3};
+    }
+    SkUNREACHABLE;
+}
+
+// For each destination pixel along one axis, the run of source pixels it filters and their
+// weights, which add up to 1. When shrinking, the kernel is stretched to cover every source pixel.
+class WeightTable {
+public:
+    WeightTable(int srcSize, int dstSize, Filter filter) : fStart(dstSize), fCount(dstSize) {
+        const Kernel k = kernel(filter);
+        const float scale = (float)srcSize / dstSize,
+                    stretch = std::max(scale, 1.0f),
+                    support = k.fRadius * stretch;
+        fMaxTaps = std::min(srcSize, (int)std::ceil(2 * support) + 2);
+        fWeights.reset((size_t)dstSize * fMaxTaps);
+
+        for (int i = 0; i < dstSize; ++i) {
+            // Pixel centers are at half-integers in both spaces.
+            const float center = (i + 0.5f) * scale;
+            const int first = (int)std::floor(center - support),
+                      last  = (int)std::ceil (center + support);
+            // Taps past the edges of src use the edge pixels.
+            const int lo = std::clamp(first, 0, srcSize - 1),
+                      hi = std::clamp(last,  0, srcSize - 1);
+            SkASSERT(hi - lo < fMaxTaps);
+
+            float* w = this->weights(i);
+            std::fill(w, w + hi - lo + 1, 0.0f);
+            float sum = 0;
+            for (int j = first; j <= last; ++j) {
+                const float v = k.fEval((j + 0.5f - center) / stretch);
+                w[std::clamp(j, lo, hi) - lo] += v;
+                sum += v;
+            }
+            SkASSERT(sum > 0);
+            for (int j = lo; j <= hi; ++j) {
+                w[j - lo] /= sum;
+            }
+            fStart[i] = lo;
+            fCount[i] = hi - lo + 1;
+        }
+    }
+
+    int start(int i) const { return fStart[i]; }
+    int count(int i) const { return fCount[i]; }
+    float* weights(int i) { return fWeights.get() + (size_t)i * fMaxTaps; }
+    const float* weights(int i) const { return fWeights.get() + (size_t)i * fMaxTaps; }
+
+private:
+    AutoTMalloc<int>   fStart;
+    AutoTMalloc<int>   fCount;
+    AutoTMalloc<float> fWeights;
+    int                fMaxTaps;
+};
+
+// Calls fn(first, end) for bands of [0, count) that each cover about kMinPixelsPerBand pixels
+// of width pixels each, on the executor if there is one.
+template <typename Fn>
+void for_each_band(int count, int width, SkExecutor* executor, Fn&& fn) {
+    static constexpr int kMinPixelsPerBand = 64 * 1024;
+    const int rowsPerBand = std::max(1, kMinPixelsPerBand / width);
+    const int bandCount = (count + rowsPerBand - 1) / rowsPerBand;
+    if (!executor || bandCount == 1) {
+        fn(0, count);
+        return;
+    }
+    SkTaskGroup bands(*executor);
+    bands.batch(bandCount, [&](int band) {
+        fn(band * rowsPerBand, std::min(count, (band + 1) * rowsPerBand));
+    });
+    bands.wait();
+}
+
+}  // namespace
+
+bool Resize(const SkPixmap& src, const SkPixmap& dst, const Options& options) {
+    if (src.width() <= 0 || src.height() <= 0 || dst.width() <= 0 || dst.height() <= 0 ||
+        !src.addr() || !dst.addr() ||
+        !SkImageInfoIsValid(src.info()) || !SkImageInfoIsValid(dst.info())) {
+        return false;
+    }
+
+    SkPixmap s = src,
+             d = dst;
+    sk_sp<SkColorSpace> workingCS = d.refColorSpace();
+    if (options.fLinearLight) {
+        // Untagged pixels are taken to be sRGB. If only dst is untagged, it keeps src's color
+        // space, as readPixels() would.
+        if (!d.colorSpace()) {
+            d.setColorSpace(s.colorSpace() ? s.refColorSpace() : SkColorSpace::MakeSRGB());
+        }
+        if (!s.colorSpace()) {
+            s.setColorSpace(d.refColorSpace());
+        }
+        workingCS = d.colorSpace()->makeLinearGamma();
+    }
+    // Rows are filtered as premultiplied RGBA floats.
+    auto working = [&](int width, int height) {
+        return SkImageInfo::Make(width, height, kRGBA_F32_SkColorType, kPremul_SkAlphaType,
+                                 workingCS);
+    };
+    const bool clampToUnorm = SkColorTypeIsNormalized(d.colorType());
+
+    const int sw = s.width(), sh = s.height(),
+              dw = d.width(), dh = d.height();
+    const WeightTable wx(sw, dw, options.fFilter),
+                      wy(sh, dh, options.fFilter);
+
+    // First filter each source row that some destination row needs horizontally, into rows of
+    // dw pixels...
+    const int firstRow = wy.start(0),
+              endRow   = wy.start(dh - 1) + wy.count(dh - 1);
+    AutoTMalloc<float> rows((size_t)4 * dw * (endRow - firstRow));
+    std::atomic<bool> ok = true;
+    for_each_band(endRow - firstRow, sw, options.fExecutor, [&](int y0, int y1) {
+        AutoTMalloc<float> srcRow((size_t)4 * sw);
+        for (int y = firstRow + y0; y < firstRow + y1; ++y) {
+            SkPixmap srcPixels;
+            if (!s.extractSubset(&srcPixels, SkIRect::MakeXYWH(0, y, sw, 1)) ||
+                !srcPixels.readPixels(working(sw, 1), srcRow.get(), 4 * sizeof(float) * sw)) {
+                ok = false;
+                return;
+            }
+            float* out = rows.get() + (size_t)4 * dw * (y - firstRow);
+            for (int x = 0; x < dw; ++x) {
+                const float* in = srcRow.get() + 4 * wx.start(x);
+                const float* w  = wx.weights(x);
+                skvx::float4 sum = 0;
+                for (int k = 0; k < wx.count(x); ++k) {
+                    sum += w[k] * skvx::float4::Load(in + 4 * k);
+                }
+                sum.store(out + 4 * x);
+            }
+        }
+    });
+    if (!ok) {
+        return false;
+    }
+
+    // ... then filter those rows vertically, into bands of destination rows.
+    for_each_band(dh, dw, options.fExecutor, [&](int y0, int y1) {
+        AutoTMalloc<float> band((size_t)4 * dw * (y1 - y0));
+        for (int y = y0; y < y1; ++y) {
+            float* out = band.get() + (size_t)4 * dw * (y - y0);
+            std::fill(out, out + 4 * dw, 0.0f);
+            const float* w = wy.weights(y);
+            for (int k = 0; k < wy.count(y); ++k) {
+                const float* in = rows.get() + (size_t)4 * dw * (wy.start(y) + k - firstRow);
+                for (int x = 0; x < dw; ++x) {
+                    (skvx::float4::Load(out + 4 * x) + w[k] * skvx::float4::Load(in + 4 * x))
+                            .store(out + 4 * x);
+                }
+            }
+            // Sharpening filters overshoot. Keep alpha in range and, unless dst can hold them,
+            // the colors too.
+            for (int x = 0; x < dw; ++x) {
+                skvx::float4 px = skvx::float4::Load(out + 4 * x);
+                const float a = std::clamp(px[3], 0.0f, 1.0f);
+                if (clampToUnorm) {
+                    px = skvx::pin(px, skvx::float4(0), skvx::float4(a));
+                }
+                px[3] = a;
+                px.store(out + 4 * x);
+            }
+        }
+
+        SkPixmap dstBand;
+        SkAssertResult(d.extractSubset(&dstBand, SkIRect::MakeLTRB(0, y0, dw, y1)));
+        SkPixmap(working(dw, y1 - y0), band.get(), 4 * sizeof(float) * dw).readPixels(dstBand);
+    });
+    return true;
+}
+
+}  // namespace SkImageResize
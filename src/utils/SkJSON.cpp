@@ -17,6 +17,7 @@
 #include "include/utils/SkParse.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkUTF.h"
+#include "src/base/SkVx.h"
 
 #include <cmath>
 #include <cstdint>
@@ -298,6 +299,24 @@ static inline bool is_digit(char c)    { return g_token_flags[static_cast<uint8_
 static inline bool is_numeric(char c)  { return g_token_flags[static_cast<uint8_t>(c)] & 0x10; }
 static inline bool is_eoscope(char c)  { return g_token_flags[static_cast<uint8_t>(c)] & 0x20; }
 
+// Returns the first string terminator (see is_eostring) at or after p.  Chars are scanned 16 at a
+// time while they are known to precede p_stop, which makes long strings (e.g. embedded base64
+// assets) cheap to skip.
+static inline const char* find_eostring(const char* p, const char* p_stop) {
+    using U8 = skvx::Vec<16, uint8_t>;
+
+    while (p_stop - p >= 16) {
+        const auto c = U8::Load(p);
+        if (any((c < 0x20) | (c == '"') | (c == '\\') | (c == '}') | (c == ']'))) {
+            break;
+        }
+        p += 16;
+    }
+
+    while (!is_eostring(*p)) ++p;
+    return p;
+}
+
 static inline const char* skip_ws(const char* p) {
     while (is_ws(*p)) ++p;
     return p;
@@ -730,7 +749,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            p = find_eostring(p + 1, p_stop);
 
             if (*p == '"') {
                 // Valid string found.
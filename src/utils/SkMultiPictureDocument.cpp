@@ -27,12 +27,34 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
 /*
   File format:
+      BEGINNING_OF_FILE:
+        kMagic
+        uint32_t version_number (==3)
+        {
+          skp file
+        } * page_count
+        PAGE_TABLE:
+        {
+          float sizeX
+          float sizeY
+          uint64_t offset   (of the page's skp file, from the beginning of the file)
+          uint64_t length
+        } * page_count
+        uint32_t page_count
+        uint64_t page_table_offset
+
+  Each page is written as soon as it ends, and the table at the end lets a reader find any page
+  without reading the ones before it.
+
+  Version 2 files, which can still be read, hold all the pages in one skp file:
       BEGINNING_OF_FILE:
         kMagic
         uint32_t version_number (==2)
@@ -41,31 +63,42 @@ using namespace skia_private;
           float sizeX
           float sizeY
         } * page_count
-        skp file
+        skp file (each page followed by a kEndPage annotation)
 */
 
 namespace {
 // The unique file signature for this file type.
 static constexpr char kMagic[] = "Skia Multi-Picture Doc\n\n";
+static constexpr size_t kMagicSize = sizeof(kMagic) - 1;
 
 static constexpr char kEndPage[] = "SkMultiPictureEndPage";
 
-const uint32_t kVersion = 2;
+const uint32_t kCombinedVersion = 2;
+const uint32_t kVersion = 3;
 
-static SkSize join(const TArray<SkSize>& sizes) {
-    SkSize joined = {0, 0};
-    for (SkSize s : sizes) {
-        joined = SkSize{std::max(joined.width(), s.width()), std::max(joined.height(), s.height())};
-    }
-    return joined;
+struct PageEntry {
+    SkSize fSize;
+    uint64_t fOffset;
+    uint64_t fLength;
+};
+static_assert(sizeof(PageEntry) == 24);
+
+static constexpr size_t kHeaderSize = kMagicSize + sizeof(uint32_t);
+static constexpr size_t kTrailerSize = sizeof(uint32_t) + sizeof(uint64_t);
+
+static bool write64(SkWStream* stream, uint64_t v) { return stream->write(&v, sizeof(v)); }
+
+static bool read64(SkStream* stream, uint64_t* v) {
+    return sizeof(*v) == stream->read(v, sizeof(*v));
 }
 
 struct MultiPictureDocument final : public SkDocument {
     const SkSerialProcs fProcs;
     SkPictureRecorder fPictureRecorder;
     SkSize fCurrentPageSize;
-    TArray<sk_sp<SkPicture>> fPages;
-    TArray<SkSize> fSizes;
+    TArray<PageEntry> fPages;
+    size_t fStart = 0;
+    bool fWroteHeader = false;
     std::function<void(const SkPicture*)> fOnEndPage;
     MultiPictureDocument(SkWStream* s,
                          const SkSerialProcs* procs,
@@ -76,45 +109,115 @@ struct MultiPictureDocument final : public SkDocument {
 
     ~MultiPictureDocument() override { this->close(); }
 
+    void writeHeader(SkWStream* wStream) {
+        if (!fWroteHeader) {
+            fStart = wStream->bytesWritten();
+            wStream->write(kMagic, kMagicSize);
+            wStream->write32(kVersion);
+            fWroteHeader = true;
+        }
+    }
+
     SkCanvas* onBeginPage(SkScalar w, SkScalar h) override {
         fCurrentPageSize.set(w, h);
         return fPictureRecorder.beginRecording(w, h);
     }
     void onEndPage() override {
-        fSizes.push_back(fCurrentPageSize);
         sk_sp<SkPicture> lastPage = fPictureRecorder.finishRecordingAsPicture();
-        fPages.push_back(lastPage);
+        SkWStream* wStream = this->getStream();
+        this->writeHeader(wStream);
+        const size_t offset = wStream->bytesWritten();
+        lastPage->serialize(wStream, &fProcs);
+        fPages.push_back({fCurrentPageSize,
+                          offset - fStart,
+                          wStream->bytesWritten() - offset});
         if (fOnEndPage) {
             fOnEndPage(lastPage.get());
         }
     }
     void onClose(SkWStream* wStream) override {
         SkASSERT(wStream);
-        SkASSERT(wStream->bytesWritten() == 0);
-        wStream->writeText(kMagic);
-        wStream->write32(kVersion);
-        wStream->write32(SkToU32(fPages.size()));
-        for (SkSize s : fSizes) {
-            wStream->write(&s, sizeof(s));
-        }
-        SkSize bigsize = join(fSizes);
-        SkCanvas* c = fPictureRecorder.beginRecording(SkRect::MakeSize(bigsize));
-        for (const sk_sp<SkPicture>& page : fPages) {
-            c->drawPicture(page);
-            // Annotations must include some data.
-            c->drawAnnotation(SkRect::MakeEmpty(), kEndPage, SkData::MakeWithCString("X"));
+        this->writeHeader(wStream);
+        const size_t tableOffset = wStream->bytesWritten() - fStart;
+        for (const PageEntry& page : fPages) {
+            wStream->write(&page.fSize, sizeof(page.fSize));
+            write64(wStream, page.fOffset);
+            write64(wStream, page.fLength);
         }
-        sk_sp<SkPicture> p = fPictureRecorder.finishRecordingAsPicture();
-        p->serialize(wStream, &fProcs);
+        wStream->write32(SkToU32(fPages.size()));
+        write64(wStream, tableOffset);
         fPages.clear();
-        fSizes.clear();
     }
     void onAbort() override {
         fPages.clear();
-        fSizes.clear();
     }
 };
 
+// Reads the page table of either version into pages, returning the version, or 0 if src isn't a
+// multi-picture document. Version 2 files leave src at the beginning of their skp file.
+static uint32_t read_page_table(SkStreamSeekable* src, TArray<PageEntry>* pages) {
+    pages->clear();
+    if (!src || !src->seek(0)) {
+        return 0;
+    }
+    char buffer[kMagicSize];
+    if (kMagicSize != src->read(buffer, kMagicSize) || 0 != memcmp(kMagic, buffer, kMagicSize)) {
+        return 0;
+    }
+    uint32_t versionNumber;
+    if (!src->readU32(&versionNumber)) {
+        return 0;
+    }
+    if (versionNumber == kCombinedVersion) {
+        uint32_t pageCount;
+        if (!src->readU32(&pageCount) || pageCount > INT_MAX) {
+            return 0;
+        }
+        for (uint32_t i = 0; i < pageCount; ++i) {
+            SkSize size;
+            if (sizeof(size) != src->read(&size, sizeof(size))) {
+                return 0;
+            }
+            pages->push_back({size, 0, 0});
+        }
+        return kCombinedVersion;
+    }
+    if (versionNumber != kVersion || !src->hasLength()) {
+        return 0;
+    }
+
+    const size_t length = src->getLength();
+    uint32_t pageCount;
+    uint64_t tableOffset;
+    if (length < kHeaderSize + kTrailerSize ||
+        !src->seek(length - kTrailerSize) ||
+        !src->readU32(&pageCount) ||
+        !read64(src, &tableOffset) ||
+        pageCount > INT_MAX ||
+        tableOffset < kHeaderSize ||
+        tableOffset > length - kTrailerSize ||
+        // Everything between the table and the trailer is table.
+        (length - kTrailerSize - tableOffset) != pageCount * sizeof(PageEntry) ||
+        !src->seek(static_cast<size_t>(tableOffset))) {
+        return 0;
+    }
+    pages->reserve(pageCount);
+    for (uint32_t i = 0; i < pageCount; ++i) {
+        PageEntry page;
+        if (sizeof(page.fSize) != src->read(&page.fSize, sizeof(page.fSize)) ||
+            !read64(src, &page.fOffset) ||
+            !read64(src, &page.fLength) ||
+            page.fOffset < kHeaderSize ||
+            page.fOffset > tableOffset ||
+            page.fLength > tableOffset - page.fOffset) {
+            pages->clear();
+            return 0;
+        }
+        pages->push_back(page);
+    }
+    return kVersion;
+}
+
 struct PagerCanvas : public SkNWayCanvas {
     SkPictureRecorder fRecorder;
     SkDocumentPage* fDst;
@@ -154,26 +257,11 @@ sk_sp<SkDocument> Make(SkWStream* dst,
 }
 
 int ReadPageCount(SkStreamSeekable* src) {
-    if (!src) {
-        return 0;
-    }
-    src->seek(0);
-    const size_t size = sizeof(kMagic) - 1;
-    char buffer[size];
-    if (size != src->read(buffer, size) || 0 != memcmp(kMagic, buffer, size)) {
-        src = nullptr;
-        return 0;
-    }
-    uint32_t versionNumber;
-    if (!src->readU32(&versionNumber) || versionNumber != kVersion) {
+    TArray<PageEntry> pages;
+    if (!read_page_table(src, &pages)) {
         return 0;
     }
-    uint32_t pageCount;
-    if (!src->readU32(&pageCount) || pageCount > INT_MAX) {
-        return 0;
-    }
-    // leave stream position right here.
-    return SkTo<int>(pageCount);
+    return pages.size();
 }
 
 bool ReadPageSizes(SkStreamSeekable* stream,
@@ -182,17 +270,13 @@ bool ReadPageSizes(SkStreamSeekable* stream,
     if (!dstArray || dstArrayCount < 1) {
         return false;
     }
-    int pageCount = ReadPageCount(stream);
-    if (pageCount < 1 || pageCount != dstArrayCount) {
+    TArray<PageEntry> pages;
+    if (!read_page_table(stream, &pages) || pages.size() != dstArrayCount) {
         return false;
     }
-    for (int i = 0; i < pageCount; ++i) {
-        SkSize& s = dstArray[i].fSize;
-        if (sizeof(s) != stream->read(&s, sizeof(s))) {
-            return false;
-        }
+    for (int i = 0; i < dstArrayCount; ++i) {
+        dstArray[i].fSize = pages[i].fSize;
     }
-    // leave stream position right here.
     return true;
 }
 
@@ -200,9 +284,32 @@ bool Read(SkStreamSeekable* src,
           SkDocumentPage* dstArray,
           int dstArrayCount,
           const SkDeserialProcs* procs) {
-    if (!ReadPageSizes(src, dstArray, dstArrayCount)) {
+    if (!dstArray || dstArrayCount < 1) {
+        return false;
+    }
+    TArray<PageEntry> pages;
+    const uint32_t version = read_page_table(src, &pages);
+    if (!version || pages.size() != dstArrayCount) {
         return false;
     }
+    for (int i = 0; i < dstArrayCount; ++i) {
+        dstArray[i].fSize = pages[i].fSize;
+    }
+
+    if (version == kVersion) {
+        // Read in order, in case procs expect to see shared data the first time it's used.
+        for (int i = 0; i < dstArrayCount; ++i) {
+            if (!src->seek(static_cast<size_t>(pages[i].fOffset))) {
+                return false;
+            }
+            dstArray[i].fPicture = SkPicture::MakeFromStream(src, procs);
+            if (!dstArray[i].fPicture) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     SkSize joined = {0.0f, 0.0f};
     for (int i = 0; i < dstArrayCount; ++i) {
         joined = SkSize{std::max(joined.width(), dstArray[i].fSize.width()),
@@ -224,4 +331,61 @@ bool Read(SkStreamSeekable* src,
     }
     return true;
 }
+
+std::unique_ptr<Reader> Reader::Make(sk_sp<SkData> data, const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    TArray<PageEntry> pages;
+    const uint32_t version = read_page_table(&stream, &pages);
+    if (!version || pages.empty()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Reader> reader(new Reader(procs));
+    reader->fSizes.reserve(pages.size());
+    for (const PageEntry& page : pages) {
+        reader->fSizes.push_back(page.fSize);
+    }
+    if (version == kVersion) {
+        reader->fData = std::move(data);
+        reader->fOffsets.reserve(pages.size());
+        for (const PageEntry& page : pages) {
+            reader->fOffsets.push_back({static_cast<size_t>(page.fOffset), static_cast<size_t>(page.fLength)});
+        }
+        return reader;
+    }
+
+    // Older files have to be read all at once.
+    std::vector<SkDocumentPage> combined(pages.size());
+    if (!Read(&stream, combined.data(), pages.size(), procs)) {
+        return nullptr;
+    }
+    for (SkDocumentPage& page : combined) {
+        reader->fPictures.push_back(std::move(page.fPicture));
+    }
+    return reader;
+}
+
+Reader::Reader(const SkDeserialProcs* procs) : fProcs(procs ? *procs : SkDeserialProcs()) {}
+
+Reader::~Reader() = default;
+
+SkSize Reader::pageSize(int index) const {
+    SkASSERT(0 <= index && index < this->pageCount());
+    return fSizes[index];
+}
+
+sk_sp<SkPicture> Reader::readPage(int index) const {
+    if (index < 0 || index >= this->pageCount()) {
+        return nullptr;
+    }
+    if (!fPictures.empty()) {
+        return fPictures[index];
+    }
+    const auto [offset, length] = fOffsets[index];
+    return SkPicture::MakeFromData(SkData::MakeSubset(fData.get(), offset, length).get(), &fProcs);
+}
+
 }  // namespace SkMultiPictureDocument
@@ -13,7 +13,7 @@
 namespace SkMultiPictureDocument {
 /**
  *  Additional API allows one to read the array of page-sizes without parsing
- *  the entire file.  Used by DM.
+ *  the entire file.
  */
 bool ReadPageSizes(SkStreamSeekable* src,
                    SkDocumentPage* dstArray,
@@ -393,6 +393,15 @@ void SkNWayCanvas::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
     }
 }
 
+void SkNWayCanvas::onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                       const SkMatrix preViewMatrices[], int count,
+                                       QuadAAFlags aa, SkBlendMode mode) {
+    Iter iter(fList);
+    while (iter.next()) {
+        iter->experimental_DrawEdgeAARectSet(rects, colors, preViewMatrices, count, aa, mode);
+    }
+}
+
 void SkNWayCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry set[], int count,
                                          const SkPoint dstClips[], const SkMatrix preViewMatrices[],
                                          const SkSamplingOptions& sampling, const SkPaint* paint,
@@ -15,6 +15,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkSurface.h" // IWYU pragma: keep
 #include "include/core/SkSurfaceProps.h"
+#include "src/core/SkCanvasPriv.h"
 
 #include <optional>
 
@@ -254,6 +255,13 @@ void SkPaintFilterCanvas::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint cli
     }
 }
 
+void SkPaintFilterCanvas::onDrawEdgeAARectSet(const SkRect rects[], const SkColor4f colors[],
+                                              const SkMatrix preViewMatrices[], int count,
+                                              QuadAAFlags aa, SkBlendMode mode) {
+    // Each rect has its own color, so each is filtered on its own.
+    SkCanvasPriv::DrawEdgeAARectSetAsQuads(this, rects, colors, preViewMatrices, count, aa, mode);
+}
+
 void SkPaintFilterCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry set[], int count,
                                                 const SkPoint dstClips[],
                                                 const SkMatrix preViewMatrices[],
@@ -0,0 +1,583 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkPictureDamage.h"
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRSXform.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkVertices.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTo.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/chromium/Slug.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkDrawShadowInfo.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecords.h"
+#include "src/core/SkTHash.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+using namespace skia_private;
+
+namespace {
+
+// Hashes everything about an op that can change what it draws. Ops that can't be hashed this
+// way (their contents can change without the op changing) are reported as such.
+class OpHasher {
+public:
+    explicit OpHasher(uint32_t seed) : fHash(seed) {}
+
+    uint32_t hash() const { return fHash; }
+    bool hashable() const { return fHashable; }
+
+    template <typename T>
+    void operator()(const T& op) {
+        this->add(T::kType);
+        this->hashOp(op);
+    }
+
+private:
+    void addBytes(const void* data, size_t bytes) {
+        fHash = SkChecksum::Hash32(data, bytes, fHash);
+    }
+
+    // Only for types without padding, whose equal values have equal bytes (up to -0 and NaN,
+    // which just fail to match).
+    template <typename T,
+              typename = std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                                          std::is_same_v<T, SkRect> ||
+                                          std::is_same_v<T, SkIRect> ||
+                                          std::is_same_v<T, SkPoint> ||
+                                          std::is_same_v<T, SkColor4f>>>
+    void add(const T& pod) {
+        this->addBytes(&pod, sizeof(T));
+    }
+
+    template <typename T>
+    void addArray(const T* array, int count) {
+        this->add(count);
+        if (array && count > 0) {
+            this->addBytes(array, count * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    void addArray(const SkRecords::PODArray<T>& array, int count) {
+        this->addArray(static_cast<const T*>(array), count);
+    }
+
+    void addPtr(const void* ptr) { this->add(reinterpret_cast<uintptr_t>(ptr)); }
+
+    void add(const SkMatrix& m) {
+        SkScalar values[9];
+        m.get9(values);
+        this->addArray(values, 9);
+    }
+    void add(const SkM44& m) {
+        SkScalar values[16];
+        m.getColMajor(values);
+        this->addArray(values, 16);
+    }
+    void add(const SkRRect& rrect) {
+        this->add(rrect.getType());
+        this->add(rrect.rect());
+        for (auto corner : {SkRRect::kUpperLeft_Corner, SkRRect::kUpperRight_Corner,
+                            SkRRect::kLowerRight_Corner, SkRRect::kLowerLeft_Corner}) {
+            this->add(rrect.radii(corner));
+        }
+    }
+    void add(const SkPath& path) {
+        this->add(path.getFillType());
+        this->addArray(SkPathPriv::VerbData(path), path.countVerbs());
+        this->addArray(SkPathPriv::PointData(path), path.countPoints());
+        this->addArray(SkPathPriv::ConicWeightData(path), SkPathPriv::ConicWeightCnt(path));
+    }
+    void add(const SkRegion& region) {
+        AutoSTMalloc<64, char> storage(region.writeToMemory(nullptr));
+        this->addBytes(storage.get(), region.writeToMemory(storage.get()));
+    }
+    void add(const SkSamplingOptions& sampling) {
+        this->add(sampling.maxAniso);
+        this->add(sampling.useCubic);
+        this->add(sampling.cubic.B);
+        this->add(sampling.cubic.C);
+        this->add(sampling.filter);
+        this->add(sampling.mipmap);
+    }
+    void add(const SkPaint& paint) {
+        this->add(paint.getColor4f());
+        this->add(paint.getStyle());
+        this->add(paint.getStrokeWidth());
+        this->add(paint.getStrokeMiter());
+        this->add(paint.getStrokeCap());
+        this->add(paint.getStrokeJoin());
+        this->add(paint.isAntiAlias());
+        this->add(paint.isDither());
+        // Effects are immutable, and both pictures hold refs to theirs while we compare them,
+        // so the same pointer means the same effect.
+        this->addPtr(paint.getShader());
+        this->addPtr(paint.getColorFilter());
+        this->addPtr(paint.getImageFilter());
+        this->addPtr(paint.getMaskFilter());
+        this->addPtr(paint.getPathEffect());
+        this->addPtr(paint.getBlender());
+    }
+    template <typename T>
+    void add(const SkRecords::Optional<T>& optional) {
+        this->add(optional != nullptr);
+        if (optional) {
+            this->add(*optional);
+        }
+    }
+    void add(const SkImage* image) { this->add(image ? image->uniqueID() : 0); }
+
+    // Ops without anything to hash beyond their type.
+    void hashOp(const SkRecords::Save&) {}
+    void hashOp(const SkRecords::Restore&) {}
+    void hashOp(const SkRecords::ResetClip&) {}
+
+    void hashOp(const SkRecords::SaveLayer& op) {
+        this->add(op.bounds);
+        this->add(op.paint);
+        this->addPtr(op.backdrop.get());
+        this->add(op.saveLayerFlags);
+        this->add(op.backdropScale);
+        this->add(op.filters.size());
+        for (size_t i = 0; i < op.filters.size(); ++i) {
+            this->addPtr(op.filters[i].get());
+        }
+    }
+    void hashOp(const SkRecords::SaveBehind& op) { this->add(op.subset); }
+    void hashOp(const SkRecords::SetMatrix& op) { this->add(op.matrix); }
+    void hashOp(const SkRecords::SetM44& op) { this->add(op.matrix); }
+    void hashOp(const SkRecords::Concat& op) { this->add(op.matrix); }
+    void hashOp(const SkRecords::Concat44& op) { this->add(op.matrix); }
+    void hashOp(const SkRecords::Translate& op) {
+        this->add(op.dx);
+        this->add(op.dy);
+    }
+    void hashOp(const SkRecords::Scale& op) {
+        this->add(op.sx);
+        this->add(op.sy);
+    }
+    void hashOp(const SkRecords::ClipPath& op) {
+        this->add(op.path);
+        this->add(op.opAA.op());
+        this->add(op.opAA.aa());
+    }
+    void hashOp(const SkRecords::ClipRRect& op) {
+        this->add(op.rrect);
+        this->add(op.opAA.op());
+        this->add(op.opAA.aa());
+    }
+    void hashOp(const SkRecords::ClipRect& op) {
+        this->add(op.rect);
+        this->add(op.opAA.op());
+        this->add(op.opAA.aa());
+    }
+    void hashOp(const SkRecords::ClipRegion& op) {
+        this->add(op.region);
+        this->add(op.op);
+    }
+    void hashOp(const SkRecords::ClipShader& op) {
+        this->addPtr(op.shader.get());
+        this->add(op.op);
+    }
+
+    void hashOp(const SkRecords::DrawArc& op) {
+        this->add(op.paint);
+        this->add(op.oval);
+        this->add(op.startAngle);
+        this->add(op.sweepAngle);
+        this->add(op.useCenter);
+    }
+    void hashOp(const SkRecords::DrawDRRect& op) {
+        this->add(op.paint);
+        this->add(op.outer);
+        this->add(op.inner);
+    }
+    void hashOp(const SkRecords::DrawImage& op) {
+        this->add(op.paint);
+        this->add(op.image.get());
+        this->add(op.left);
+        this->add(op.top);
+        this->add(op.sampling);
+    }
+    void hashOp(const SkRecords::DrawImageLattice& op) {
+        this->add(op.paint);
+        this->add(op.image.get());
+        this->addArray(op.xDivs, op.xCount);
+        this->addArray(op.yDivs, op.yCount);
+        this->addArray(op.flags, op.flags ? op.flagCount : 0);
+        this->addArray(op.colors, op.colors ? op.flagCount : 0);
+        this->add(op.src);
+        this->add(op.dst);
+        this->add(op.filter);
+    }
+    void hashOp(const SkRecords::DrawImageRect& op) {
+        this->add(op.paint);
+        this->add(op.image.get());
+        this->add(op.src);
+        this->add(op.dst);
+        this->add(op.sampling);
+        this->add(op.constraint);
+    }
+    void hashOp(const SkRecords::DrawOval& op) {
+        this->add(op.paint);
+        this->add(op.oval);
+    }
+    void hashOp(const SkRecords::DrawPaint& op) { this->add(op.paint); }
+    void hashOp(const SkRecords::DrawBehind& op) { this->add(op.paint); }
+    void hashOp(const SkRecords::DrawPath& op) {
+        this->add(op.paint);
+        this->add(op.path);
+    }
+    void hashOp(const SkRecords::DrawPicture& op) {
+        this->add(op.paint);
+        this->add(op.picture ? op.picture->uniqueID() : 0);
+        this->add(op.matrix);
+    }
+    void hashOp(const SkRecords::DrawPoints& op) {
+        this->add(op.paint);
+        this->add(op.mode);
+        this->addArray(op.pts, SkToInt(op.count));
+    }
+    void hashOp(const SkRecords::DrawRRect& op) {
+        this->add(op.paint);
+        this->add(op.rrect);
+    }
+    void hashOp(const SkRecords::DrawRect& op) {
+        this->add(op.paint);
+        this->add(op.rect);
+    }
+    void hashOp(const SkRecords::DrawRegion& op) {
+        this->add(op.paint);
+        this->add(op.region);
+    }
+    void hashOp(const SkRecords::DrawTextBlob& op) {
+        this->add(op.paint);
+        this->add(op.blob ? op.blob->uniqueID() : 0);
+        this->add(op.x);
+        this->add(op.y);
+    }
+    void hashOp(const SkRecords::DrawSlug& op) {
+        this->add(op.paint);
+        this->add(op.slug ? op.slug->uniqueID() : 0);
+    }
+    void hashOp(const SkRecords::DrawPatch& op) {
+        this->add(op.paint);
+        this->addArray(op.cubics, op.cubics ? 12 : 0);
+        this->addArray(op.colors, op.colors ? 4 : 0);
+        this->addArray(op.texCoords, op.texCoords ? 4 : 0);
+        this->add(op.bmode);
+    }
+    void hashOp(const SkRecords::DrawAtlas& op) {
+        this->add(op.paint);
+        this->add(op.atlas.get());
+        this->addArray(op.xforms, op.count);
+        this->addArray(op.texs, op.count);
+        this->addArray(op.colors, op.colors ? op.count : 0);
+        this->add(op.mode);
+        this->add(op.sampling);
+        this->add(op.cull);
+    }
+    void hashOp(const SkRecords::DrawVertices& op) {
+        this->add(op.paint);
+        this->add(op.vertices ? op.vertices->uniqueID() : 0);
+        this->add(op.bmode);
+    }
+    void hashOp(const SkRecords::DrawShadowRec& op) {
+        this->add(op.path);
+        this->addBytes(&op.rec, sizeof(op.rec));
+    }
+    void hashOp(const SkRecords::DrawEdgeAAQuad& op) {
+        this->add(op.rect);
+        this->addArray(op.clip, op.clip ? 4 : 0);
+        this->add(op.aa);
+        this->add(op.color);
+        this->add(op.mode);
+    }
+    void hashOp(const SkRecords::DrawEdgeAARectSet& op) {
+        this->addArray(op.rects, op.count);
+        this->addArray(op.colors, op.count);
+        if (op.preViewMatrices) {
+            for (int i = 0; i < op.count; ++i) {
+                this->add(op.preViewMatrices[i]);
+            }
+        }
+        this->add(op.aa);
+        this->add(op.mode);
+    }
+    void hashOp(const SkRecords::DrawEdgeAAImageSet& op) {
+        this->add(op.paint);
+        int clipCount = 0,
+            matrixCount = 0;
+        for (int i = 0; i < op.count; ++i) {
+            const SkCanvas::ImageSetEntry& entry = op.set[i];
+            this->add(entry.fImage.get());
+            this->add(entry.fSrcRect);
+            this->add(entry.fDstRect);
+            this->add(entry.fMatrixIndex);
+            this->add(entry.fAlpha);
+            this->add(entry.fAAFlags);
+            this->add(entry.fHasClip);
+            clipCount += entry.fHasClip ? 4 : 0;
+            matrixCount = std::max(matrixCount, entry.fMatrixIndex + 1);
+        }
+        this->addArray(op.dstClips, clipCount);
+        for (int i = 0; i < matrixCount; ++i) {
+            this->add(op.preViewMatrices[i]);
+        }
+        this->add(op.sampling);
+        this->add(op.constraint);
+    }
+
+    // Drawables draw whatever they draw at playback, and meshes reference mutable buffers.
+    template <typename T>
+    void hashOp(const T&) { fHashable = false; }
+
+    uint32_t fHash;
+    bool     fHashable = true;
+};
+
+static uint32_t combine(uint32_t state, uint32_t hash) {
+    const uint32_t pair[2] = {state, hash};
+    return SkChecksum::Hash32(pair, sizeof(pair));
+}
+
+// Identifies a draw, or a layer's save or restore, by a hash of the op and all the state it's
+// drawn with. Draws also include their bounds, to make false matches even less likely.
+struct DamageKey {
+    uint32_t fHash;
+    SkRect   fBounds;
+
+    bool operator==(const DamageKey& that) const {
+        return 0 == memcmp(this, &that, sizeof(DamageKey));
+    }
+};
+static_assert(sizeof(DamageKey) == sizeof(uint32_t) + sizeof(SkRect));
+
+struct DamageOp {
+    DamageKey fKey;
+    SkRect    fBounds;      // What's damaged if this op isn't matched.
+    bool      fComparable;
+};
+
+// Walks a record, tracking a hash of the matrix, clip and layer state, and collects a DamageOp
+// for each draw and for each layer's save and restore.
+class DamageCollector {
+public:
+    DamageCollector(const SkRect* bounds, TArray<DamageOp>* ops) : fBounds(bounds), fOps(ops) {}
+
+    void setIndex(int index) { fIndex = index; }
+
+    template <typename T>
+    void operator()(const T& op) {
+        if constexpr (std::is_same_v<T, SkRecords::NoOp> ||
+                      std::is_same_v<T, SkRecords::DrawAnnotation>) {
+            return;
+        } else if constexpr (std::is_same_v<T, SkRecords::Save>) {
+            fSaveStack.push_back({fState, false});
+        } else if constexpr (std::is_same_v<T, SkRecords::SaveLayer> ||
+                             std::is_same_v<T, SkRecords::SaveBehind>) {
+            // A layer's bounds grow and shrink with its contents, whose own ops already damage
+            // what changed, so they're left out of its key.
+            fSaveStack.push_back({fState, true});
+            fState = this->push(op, /*keyBounds=*/false);
+        } else if constexpr (std::is_same_v<T, SkRecords::Restore>) {
+            if (fSaveStack.empty()) {
+                return;
+            }
+            const SaveState save = fSaveStack.back();
+            fSaveStack.pop_back();
+            fState = save.fState;
+            if (save.fIsLayer) {
+                // The layer is composited back here.
+                this->push(op, /*keyBounds=*/false);
+            }
+        } else if constexpr ((T::kTags & SkRecords::kDraw_Tag) != 0) {
+            this->push(op, /*keyBounds=*/true);
+        } else {
+            // Matrix and clip changes only matter through the draws that follow them.
+            OpHasher hasher(fState);
+            hasher(op);
+            fState = combine(fState, hasher.hash());
+        }
+    }
+
+private:
+    template <typename T>
+    uint32_t push(const T& op, bool keyBounds) {
+        OpHasher hasher(fState);
+        hasher(op);
+        const uint32_t hash = combine(fState, hasher.hash());
+        const SkRect& bounds = fBounds[fIndex];
+        fOps->push_back({{hash, keyBounds ? bounds : SkRect::MakeEmpty()},
+                         bounds,
+                         hasher.hashable()});
+        return hash;
+    }
+
+    struct SaveState {
+        uint32_t fState;
+        bool     fIsLayer;
+    };
+
+    const SkRect*     fBounds;
+    TArray<DamageOp>* fOps;
+    TArray<SaveState> fSaveStack;
+    uint32_t          fState = 0;
+    int               fIndex = 0;
+};
+
+// Returns false if the picture can't be compared op by op.
+static bool collect_ops(const SkPicture* picture, TArray<DamageOp>* ops) {
+    if (!picture) {
+        return true;
+    }
+    const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture));
+    if (!big) {
+        // Anything else SkPictureRecorder makes is empty.
+        return picture->approximateOpCount() == 0;
+    }
+    const SkRecord& record = *big->record();
+    AutoTArray<SkRect> bounds(record.count());
+    AutoTMalloc<SkBBoxHierarchy::Metadata> meta(record.count());
+    SkRecordFillBounds(picture->cullRect(), record, bounds.data(), meta);
+
+    DamageCollector collector(bounds.data(), ops);
+    for (int i = 0; i < record.count(); ++i) {
+        collector.setIndex(i);
+        record.visit(i, collector);
+    }
+    return true;
+}
+
+}  // namespace
+
+namespace SkPictureDamage {
+
+SkRegion Compute(const SkPicture* before, const SkPicture* after) {
+    TArray<DamageOp> beforeOps, afterOps;
+    if (!collect_ops(before, &beforeOps) || !collect_ops(after, &afterOps)) {
+        SkRect bounds = SkRect::MakeEmpty();
+        for (const SkPicture* picture : {before, after}) {
+            if (picture) {
+                bounds.join(picture->cullRect());
+            }
+        }
+        return SkRegion(bounds.roundOut());
+    }
+
+    struct Candidates {
+        TArray<int> fIndices;  // Indices into beforeOps, in increasing order.
+        int         fNext = 0;
+    };
+    struct KeyHash {
+        uint32_t operator()(const DamageKey& key) const {
+            return SkChecksum::Hash32(&key, sizeof(key));
+        }
+    };
+    THashMap<DamageKey, Candidates, KeyHash> candidates;
+    for (int i = 0; i < beforeOps.size(); ++i) {
+        if (beforeOps[i].fComparable) {
+            Candidates* c = candidates.find(beforeOps[i].fKey);
+            if (!c) {
+                c = candidates.set(beforeOps[i].fKey, Candidates());
+            }
+            c->fIndices.push_back(i);
+        }
+    }
+
+    // Greedily match ops of after to ops of before, in order. Every op touching a pixel outside
+    // the damage is then matched to an identical op, drawn with identical state, in the same
+    // order, so that pixel comes out the same.
+    TArray<bool> beforeMatched;
+    beforeMatched.push_back_n(beforeOps.size(), false);
+    TArray<SkIRect> damage;
+    int lastMatched = -1;
+    for (const DamageOp& op : afterOps) {
+        Candidates* c = op.fComparable ? candidates.find(op.fKey) : nullptr;
+        while (c && c->fNext < c->fIndices.size() && c->fIndices[c->fNext] <= lastMatched) {
+            c->fNext++;
+        }
+        if (c && c->fNext < c->fIndices.size()) {
+            lastMatched = c->fIndices[c->fNext++];
+            beforeMatched[lastMatched] = true;
+        } else {
+            damage.push_back(op.fBounds.roundOut());
+        }
+    }
+    for (int i = 0; i < beforeOps.size(); ++i) {
+        if (!beforeMatched[i]) {
+            damage.push_back(beforeOps[i].fBounds.roundOut());
+        }
+    }
+
+    SkRegion region;
+    region.setRects(damage.data(), damage.size());
+    return region;
+}
+
+void Redraw(SkCanvas* canvas,
+            const SkPicture* picture,
+            const SkRegion& damage,
+            const SkMatrix* matrix,
+            SkColor4f clearColor) {
+    if (!canvas || damage.isEmpty()) {
+        return;
+    }
+    SkMatrix toDevice = canvas->getTotalMatrix();
+    if (matrix) {
+        toDevice.preConcat(*matrix);
+    }
+
+    SkRegion deviceDamage;
+    if (toDevice.isTranslate() && SkScalarIsInt(toDevice.getTranslateX()) &&
+                                  SkScalarIsInt(toDevice.getTranslateY())) {
+        damage.translate(SkScalarRoundToInt(toDevice.getTranslateX()),
+                         SkScalarRoundToInt(toDevice.getTranslateY()),
+                         &deviceDamage);
+    } else {
+        TArray<SkIRect> rects;
+        for (SkRegion::Iterator iter(damage); !iter.done(); iter.next()) {
+            rects.push_back(toDevice.mapRect(SkRect::Make(iter.rect())).roundOut());
+        }
+        deviceDamage.setRects(rects.data(), rects.size());
+    }
+
+    canvas->save();
+    canvas->clipRegion(deviceDamage);
+    canvas->drawColor(clearColor, SkBlendMode::kSrc);
+    if (picture) {
+        canvas->drawPicture(picture, matrix, nullptr);
+    }
+    canvas->restore();
+}
+
+}  // namespace SkPictureDamage
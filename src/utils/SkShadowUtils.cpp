@@ -78,6 +78,9 @@ struct AmbientVerticesFactory {
         return true;
     }
 
+    // The ambient shadow of a rotated shape is the rotated ambient shadow of the shape.
+    bool isRotationInvariant() const { return true; }
+
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
                                    SkVector* translate) const {
         SkPoint3 zParams = SkPoint3::Make(0, 0, fOccluderHeight);
@@ -143,6 +146,14 @@ struct SpotVerticesFactory {
         SK_ABORT("Uninitialized occluder type?");
     }
 
+    // Whether the shadow of a rotated shape is the rotated shadow of the shape. That holds when
+    // the mesh is made with the light centered over the shape (see makeVertices()), but not when
+    // the umbra is cut out for a particular light position, or the light is directional.
+    bool isRotationInvariant() const {
+        return fOccluderType == OccluderType::kPointTransparent ||
+               fOccluderType == OccluderType::kPointOpaqueNoUmbra;
+    }
+
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
                                    SkVector* translate) const {
         bool transparent = fOccluderType == OccluderType::kPointTransparent ||
@@ -173,6 +184,34 @@ struct SpotVerticesFactory {
     }
 };
 
+/**
+ * If the 2x2 part of 'matrix' is that of 'cached' followed by a rotation (to within a tenth of a
+ * pixel across a 1000 pixel shape), returns that rotation.
+ */
+bool rotation_between(const SkMatrix& cached, const SkMatrix& matrix, SkMatrix* rotation) {
+    static constexpr SkScalar kTolerance = 1e-4f;
+    SkMatrix inverse;
+    if (!SkMatrix::MakeAll(cached.getScaleX(), cached.getSkewX(), 0,
+                           cached.getSkewY(), cached.getScaleY(), 0,
+                           0, 0, 1).invert(&inverse)) {
+        return false;
+    }
+    SkMatrix r = SkMatrix::MakeAll(matrix.getScaleX(), matrix.getSkewX(), 0,
+                                   matrix.getSkewY(), matrix.getScaleY(), 0,
+                                   0, 0, 1);
+    r.preConcat(inverse);
+    // [cos -sin]
+    // [sin  cos]
+    if (!SkScalarNearlyEqual(r.getScaleX(), r.getScaleY(), kTolerance) ||
+        !SkScalarNearlyEqual(r.getSkewX(), -r.getSkewY(), kTolerance) ||
+        !SkScalarNearlyEqual(r.getScaleX() * r.getScaleX() + r.getSkewY() * r.getSkewY(), 1,
+                             kTolerance)) {
+        return false;
+    }
+    *rotation = r;
+    return true;
+}
+
 /**
  * This manages a set of tessellations for a given shape in the cache. Because SkResourceCache
  * records are immutable this is not itself a Rec. When we need to update it we return this on
@@ -184,8 +223,8 @@ public:
     size_t size() const { return fAmbientSet.size() + fSpotSet.size(); }
 
     sk_sp<SkVertices> find(const AmbientVerticesFactory& ambient, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fAmbientSet.find(ambient, matrix, translate);
+                           SkVector* translate, SkMatrix* rotation) const {
+        return fAmbientSet.find(ambient, matrix, translate, rotation);
     }
 
     sk_sp<SkVertices> add(const SkPath& devPath, const AmbientVerticesFactory& ambient,
@@ -194,8 +233,8 @@ public:
     }
 
     sk_sp<SkVertices> find(const SpotVerticesFactory& spot, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fSpotSet.find(spot, matrix, translate);
+                           SkVector* translate, SkMatrix* rotation) const {
+        return fSpotSet.find(spot, matrix, translate, rotation);
     }
 
     sk_sp<SkVertices> add(const SkPath& devPath, const SpotVerticesFactory& spot,
@@ -209,9 +248,13 @@ private:
     public:
         size_t size() const { return fSize; }
 
+        // On success, the vertices should be drawn rotated by 'rotation', then translated by
+        // 'translate'.
         sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                               SkVector* translate) const {
-            for (int i = 0; i < MAX_ENTRIES; ++i) {
+                               SkVector* translate, SkMatrix* rotation) const {
+            // Prefer an exact match over one that needs rotating.
+            int rotated = -1;
+            for (int i = 0; i < fCount; ++i) {
                 if (fEntries[i].fFactory.isCompatible(factory, translate)) {
                     const SkMatrix& m = fEntries[i].fMatrix;
                     if (matrix.hasPerspective() || m.hasPerspective()) {
@@ -222,11 +265,20 @@ private:
                                matrix.getSkewX() != m.getSkewX() ||
                                matrix.getScaleY() != m.getScaleY() ||
                                matrix.getSkewY() != m.getSkewY()) {
+                        if (rotated < 0 && factory.isRotationInvariant() &&
+                            rotation_between(m, matrix, rotation)) {
+                            rotated = i;
+                        }
                         continue;
                     }
+                    rotation->reset();
                     return fEntries[i].fVertices;
                 }
             }
+            if (rotated >= 0) {
+                SkAssertResult(fEntries[rotated].fFactory.isCompatible(factory, translate));
+                return fEntries[rotated].fVertices;
+            }
             return nullptr;
         }
 
@@ -291,8 +343,8 @@ public:
 
     template <typename FACTORY>
     sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fTessellations->find(factory, matrix, translate);
+                           SkVector* translate, SkMatrix* rotation) const {
+        return fTessellations->find(factory, matrix, translate, rotation);
     }
 
 private:
@@ -302,7 +354,7 @@ private:
 
 /**
  * Used by FindVisitor to determine whether a cache entry can be reused and if so returns the
- * vertices and a translation vector. If the CachedTessellations does not contain a suitable
+ * vertices, a rotation and a translation vector. If the CachedTessellations does not contain a suitable
  * mesh then we inform SkResourceCache to destroy the Rec and we return the CachedTessellations
  * to the caller. The caller will update it and reinsert it back into the cache.
  */
@@ -312,9 +364,10 @@ struct FindContext {
             : fViewMatrix(viewMatrix), fFactory(factory) {}
     const SkMatrix* const fViewMatrix;
     // If this is valid after Find is called then we found the vertices and they should be drawn
-    // with fTranslate applied.
+    // with fRotation and then fTranslate applied.
     sk_sp<SkVertices> fVertices;
     SkVector fTranslate = {0, 0};
+    SkMatrix fRotation;
 
     // If this is valid after Find then the caller should add the vertices to the tessellation set
     // and create a new CachedTessellationsRec and insert it into SkResourceCache.
@@ -326,14 +379,15 @@ struct FindContext {
 /**
  * Function called by SkResourceCache when a matching cache key is found. The FACTORY and matrix of
  * the FindContext are used to determine if the vertices are reusable. If so the vertices and
- * necessary translation vector are set on the FindContext.
+ * necessary rotation and translation vector are set on the FindContext.
  */
 template <typename FACTORY>
 bool FindVisitor(const SkResourceCache::Rec& baseRec, void* ctx) {
     FindContext<FACTORY>* findContext = (FindContext<FACTORY>*)ctx;
     const CachedTessellationsRec& rec = static_cast<const CachedTessellationsRec&>(baseRec);
     findContext->fVertices =
-            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTranslate);
+            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTranslate,
+                     &findContext->fRotation);
     if (findContext->fVertices) {
         return true;
     }
@@ -411,7 +465,7 @@ private:
 template <typename FACTORY>
 bool draw_shadow(const FACTORY& factory,
                  std::function<void(const SkVertices*, SkBlendMode, const SkPaint&,
-                 SkScalar tx, SkScalar ty, bool)> drawProc, ShadowedPath& path, SkColor color) {
+                 const SkMatrix& transform, bool)> drawProc, ShadowedPath& path, SkColor color) {
     FindContext<FACTORY> context(&path.viewMatrix(), &factory);
 
     SkResourceCache::Key* key = nullptr;
@@ -464,7 +518,8 @@ bool draw_shadow(const FACTORY& factory,
                                                                 SkColorFilterPriv::MakeGaussian()));
 
     drawProc(vertices.get(), SkBlendMode::kModulate, paint,
-             context.fTranslate.fX, context.fTranslate.fY, path.viewMatrix().hasPerspective());
+             SkMatrix::Translate(context.fTranslate) * context.fRotation,
+             path.viewMatrix().hasPerspective());
 
     return true;
 }
@@ -600,15 +655,14 @@ void SkDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
 
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
     auto drawVertsProc = [this](const SkVertices* vertices, SkBlendMode mode, const SkPaint& paint,
-                                SkScalar tx, SkScalar ty, bool hasPerspective) {
+                                const SkMatrix& transform, bool hasPerspective) {
         if (vertices->priv().vertexCount()) {
             // For perspective shadows we've already computed the shadow in world space,
-            // and we can't translate it without changing it. Otherwise we concat the
-            // change in translation from the cached version.
+            // and we can't transform it without changing it. Otherwise we concat the
+            // change in rotation and translation from the cached version.
             SkAutoDeviceTransformRestore adr(
                     this,
-                    hasPerspective ? SkMatrix::I()
-                                   : this->localToDevice() * SkMatrix::Translate(tx, ty));
+                    hasPerspective ? SkMatrix::I() : this->localToDevice() * transform);
             // The vertex colors for a tesselated shadow polygon are always either opaque black
             // or transparent and their real contribution to the final blended color is via
             // their alpha. We can skip expensive per-vertex color conversion for this.
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkTextMeasurer.h"
+
+#include "include/core/SkFont.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypeface.h"
+#include "src/base/SkUTF.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkFontPriv.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTHash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <tuple>
+
+class SkTextMeasurer::Impl {
+public:
+    Impl(const SkFont& font, const SkPaint* paint)
+            : Impl(font.refTypeface(), SkStrikeSpec::MakeCanonicalized(font, paint)) {}
+
+    // Calls fn(advance) with the unscaled advance of each glyph of text, in order. Returns false
+    // if text isn't valid in encoding, after calling fn for the glyphs before the invalid one.
+    template <typename Fn>
+    bool forEachAdvance(const void* text, size_t byteLength, SkTextEncoding encoding, Fn&& fn) {
+        switch (encoding) {
+            case SkTextEncoding::kUTF8: {
+                const char* ptr = static_cast<const char*>(text);
+                const char* end = ptr + byteLength;
+                while (ptr < end) {
+                    // Runs of ASCII skip UTF-8 decoding, and go straight to the Latin-1 table.
+                    using Bytes = skvx::Vec<16, uint8_t>;
+                    if (end - ptr >= 16 && !any(Bytes::Load(ptr) & 0x80)) {
+                        for (int i = 0; i < 16; ++i) {
+                            fn(this->latin1Advance(static_cast<uint8_t>(ptr[i])));
+                        }
+                        ptr += 16;
+                        continue;
+                    }
+                    SkUnichar uni = SkUTF::NextUTF8(&ptr, end);
+                    if (uni < 0) {
+                        return false;
+                    }
+                    fn(this->advance(uni));
+                }
+                return true;
+            }
+            case SkTextEncoding::kUTF16: {
+                const uint16_t* ptr = static_cast<const uint16_t*>(text);
+                const uint16_t* end = ptr + (byteLength >> 1);
+                if (byteLength & 1) {
+                    return false;
+                }
+                while (ptr < end) {
+                    // Latin-1 code units are never surrogates, so they're characters as they are.
+                    using Units = skvx::Vec<8, uint16_t>;
+                    if (end - ptr >= 8 && !any(Units::Load(ptr) & 0xff00)) {
+                        for (int i = 0; i < 8; ++i) {
+                            fn(this->latin1Advance(ptr[i]));
+                        }
+                        ptr += 8;
+                        continue;
+                    }
+                    SkUnichar uni = SkUTF::NextUTF16(&ptr, end);
+                    if (uni < 0) {
+                        return false;
+                    }
+                    fn(this->advance(uni));
+                }
+                return true;
+            }
+            case SkTextEncoding::kUTF32: {
+                // Like SkFont, characters aren't validated.
+                const int32_t* chars = static_cast<const int32_t*>(text);
+                for (size_t i = 0; i < (byteLength >> 2); ++i) {
+                    fn(this->advance(chars[i]));
+                }
+                return true;
+            }
+            case SkTextEncoding::kGlyphID: {
+                const SkGlyphID* glyphs = static_cast<const SkGlyphID*>(text);
+                for (size_t i = 0; i < (byteLength >> 1); ++i) {
+                    fn(this->glyphAdvance(glyphs[i]));
+                }
+                return true;
+            }
+        }
+        SkUNREACHABLE;
+    }
+
+    SkScalar scale() const { return fScale; }
+
+private:
+    Impl(sk_sp<SkTypeface> typeface, std::tuple<SkStrikeSpec, SkScalar> strikeSpecAndScale)
+            : fTypeface(std::move(typeface))
+            , fScale(std::get<1>(strikeSpecAndScale))
+            , fMetrics(std::get<0>(strikeSpecAndScale)) {
+        // NaN marks a character that hasn't been looked up yet.
+        for (float& advance : fLatin1Advances) {
+            advance = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+
+    float latin1Advance(unsigned uni) {
+        SkASSERT(uni < std::size(fLatin1Advances));
+        float advance = fLatin1Advances[uni];
+        if (std::isnan(advance)) {
+            advance = fLatin1Advances[uni] = this->lookUpAdvance(uni);
+        }
+        return advance;
+    }
+
+    float advance(SkUnichar uni) {
+        if (static_cast<uint32_t>(uni) < std::size(fLatin1Advances)) {
+            return this->latin1Advance(uni);
+        }
+        if (const float* advance = fAdvances.find(uni)) {
+            return *advance;
+        }
+        return *fAdvances.set(uni, this->lookUpAdvance(uni));
+    }
+
+    float glyphAdvance(SkGlyphID glyph) {
+        if (const float* advance = fGlyphAdvances.find(glyph)) {
+            return *advance;
+        }
+        return *fGlyphAdvances.set(glyph, fMetrics.glyph(glyph)->advanceX());
+    }
+
+    float lookUpAdvance(SkUnichar uni) {
+        return fMetrics.glyph(fTypeface->unicharToGlyph(uni))->advanceX();
+    }
+
+    const sk_sp<SkTypeface> fTypeface;
+    const SkScalar fScale;
+    // Holds on to the strike, so that looking up a glyph we haven't seen doesn't search the
+    // strike cache.
+    SkBulkGlyphMetrics fMetrics;
+
+    float fLatin1Advances[256];
+    skia_private::THashMap<SkUnichar, float> fAdvances;
+    skia_private::THashMap<SkGlyphID, float> fGlyphAdvances;
+};
+
+SkTextMeasurer::SkTextMeasurer(const SkFont& font, const SkPaint* paint)
+        : fImpl(std::make_unique<Impl>(font, paint)) {}
+
+SkTextMeasurer::~SkTextMeasurer() = default;
+
+SkScalar SkTextMeasurer::measureText(const void* text, size_t byteLength,
+                                     SkTextEncoding encoding) {
+    if (!text || byteLength == 0) {
+        return 0;
+    }
+    // Summed unscaled and scaled once, like SkFont::measureText(), so the results match.
+    SkScalar width = 0;
+    if (!fImpl->forEachAdvance(text, byteLength, encoding,
+                               [&](float advance) { width += advance; })) {
+        return 0;
+    }
+    return width * fImpl->scale();
+}
+
+int SkTextMeasurer::getWidths(const void* text, size_t byteLength, SkTextEncoding encoding,
+                              SkScalar widths[], int maxWidthCount) {
+    if (!text || byteLength == 0) {
+        return 0;
+    }
+    const int count = SkFontPriv::CountTextElements(text, byteLength, encoding);
+    if (count <= 0 || !widths || count > maxWidthCount) {
+        return std::max(count, 0);
+    }
+    const SkScalar scale = fImpl->scale();
+    SkScalar* cursor = widths;
+    SkAssertResult(fImpl->forEachAdvance(text, byteLength, encoding,
+                                         [&](float advance) { *cursor++ = advance * scale; }));
+    SkASSERT(cursor == widths + count);
+    return count;
+}
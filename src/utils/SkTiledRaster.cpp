@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkTiledRaster.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <memory>
+
+namespace SkTiledRaster {
+
+static void draw_tile(const SkPicture* picture,
+                      const SkPixmap& dst,
+                      const SkMatrix* matrix,
+                      const SkSurfaceProps* props,
+                      const SkIRect& tile) {
+    // The canvas spans all of dst so device coordinates are identical to an untiled draw; the
+    // clip keeps each tile's writes disjoint from every other tile's.
+    std::unique_ptr<SkCanvas> canvas =
+            SkCanvas::MakeRasterDirect(dst.info(), dst.writable_addr(), dst.rowBytes(), props);
+    if (!canvas) {
+        return;
+    }
+    canvas->clipIRect(tile);
+    canvas->drawPicture(picture, matrix, nullptr);
+}
+
+// Calls drawTile(index, tile) for each tile of bounds, on the executor if there is one.
+template <typename Fn>
+static void for_each_tile(const SkIRect& bounds, const Options& options, Fn&& drawTile) {
+    const int tileW = options.fTileSize.width()  > 0 ? options.fTileSize.width()  : bounds.width();
+    const int tileH = options.fTileSize.height() > 0 ? options.fTileSize.height() : bounds.height();
+    const int tilesX = (bounds.width()  + tileW - 1) / tileW;
+    const int tilesY = (bounds.height() + tileH - 1) / tileH;
+    const int tileCount = tilesX * tilesY;
+
+    auto tileRect = [&](int index) {
+        int x = bounds.fLeft + (index % tilesX) * tileW,
+            y = bounds.fTop  + (index / tilesX) * tileH;
+        SkIRect tile = SkIRect::MakeXYWH(x, y, tileW, tileH);
+        SkAssertResult(tile.intersect(bounds));
+        return tile;
+    };
+
+    if (!options.fExecutor || tileCount == 1) {
+        for (int i = 0; i < tileCount; ++i) {
+            drawTile(i, tileRect(i));
+        }
+        return;
+    }
+
+    SkTaskGroup tasks(*options.fExecutor);
+    tasks.batch(tileCount, [&](int i) {
+        drawTile(i, tileRect(i));
+    });
+    tasks.wait();
+}
+
+bool DrawPicture(const SkPicture* picture,
+                 const SkPixmap& dst,
+                 const SkMatrix* matrix,
+                 const SkSurfaceProps* props,
+                 const Options& options) {
+    if (!dst.addr() || dst.info().isEmpty() ||
+        !SkCanvas::MakeRasterDirect(dst.info(), dst.writable_addr(), dst.rowBytes(), props)) {
+        return false;
+    }
+    if (!picture) {
+        return true;
+    }
+
+    for_each_tile(dst.bounds(), options, [&](int, const SkIRect& tile) {
+        draw_tile(picture, dst, matrix, props, tile);
+    });
+    return true;
+}
+
+void PlaybackTiles(const SkPicture* picture,
+                   const SkIRect& bounds,
+                   const SkMatrix* matrix,
+                   const TileCanvasFactory& makeCanvas,
+                   const Options& options) {
+    if (!picture || bounds.isEmpty() || !makeCanvas) {
+        return;
+    }
+
+    for_each_tile(bounds, options, [&](int index, const SkIRect& tile) {
+        SkCanvas* canvas = makeCanvas(index, tile);
+        if (!canvas) {
+            return;
+        }
+        SkAutoCanvasRestore acr(canvas, /*doSave=*/true);
+        canvas->translate(-tile.fLeft, -tile.fTop);
+        canvas->clipIRect(tile);
+        canvas->drawPicture(picture, matrix, nullptr);
+    });
+}
+
+bool DrawPicture(const SkPicture* picture,
+                 SkSurface* surface,
+                 const SkMatrix* matrix,
+                 const Options& options) {
+    if (!surface) {
+        return false;
+    }
+    // Give any outstanding snapshot its own copy of the pixels before we write to them directly.
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+
+    SkPixmap pm;
+    if (!surface->peekPixels(&pm)) {
+        return false;
+    }
+    return DrawPicture(picture, pm, matrix, &surface->props(), options);
+}
+
+}  // namespace SkTiledRaster
@@ -43,6 +43,7 @@
 #include "src/core/SkDraw.h"
 #include "src/core/SkFontPriv.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkImageContentHash.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkRasterClip.h"
@@ -122,7 +123,8 @@ HRESULT SkXPSDevice::createId(wchar_t* buffer, size_t bufferSize, wchar_t sep) {
 SkXPSDevice::SkXPSDevice(SkISize s)
         : SkClipStackDevice(SkImageInfo::MakeUnknown(s.width(), s.height()), SkSurfaceProps())
         , fCurrentPage(0)
-        , fTopTypefaces(&fTypefaces) {}
+        , fTopTypefaces(&fTypefaces)
+        , fTopImageResources(&fImageResources) {}
 
 SkXPSDevice::~SkXPSDevice() {}
 
@@ -634,32 +636,39 @@ HRESULT SkXPSDevice::createXpsImageBrush(
         const SkTileMode (&xy)[2],
         const SkAlpha alpha,
         IXpsOMTileBrush** xpsBrush) {
-    SkDynamicMemoryWStream write;
-    if (!SkPngEncoder::Encode(&write, bitmap, {})) {
-        HRM(E_FAIL, "Unable to encode bitmap as png.");
-    }
-    SkTScopedComPtr<IStream> read;
-    HRM(SkIStream::CreateFromSkStream(write.detachAsStream(), &read),
-        "Could not create stream from png data.");
-
-    const size_t size =
-        std::size(L"/Documents/1/Resources/Images/" L_GUID_ID L".png");
-    wchar_t buffer[size];
-    wchar_t id[GUID_ID_LEN];
-    HR(this->createId(id, GUID_ID_LEN));
-    swprintf_s(buffer, size, L"/Documents/1/Resources/Images/%s.png", id);
-
-    SkTScopedComPtr<IOpcPartUri> imagePartUri;
-    HRM(this->fXpsFactory->CreatePartUri(buffer, &imagePartUri),
-        "Could not create image part uri.");
-
+    const uint64_t contentHash = SkImageContentHash::Hash(bitmap);
     SkTScopedComPtr<IXpsOMImageResource> imageResource;
-    HRM(this->fXpsFactory->CreateImageResource(
-            read.get(),
-            XPS_IMAGE_TYPE_PNG,
-            imagePartUri.get(),
-            &imageResource),
-        "Could not create image resource.");
+    if (SkTScopedComPtr<IXpsOMImageResource>* same = fTopImageResources->find(contentHash)) {
+        imageResource.reset(SkRefComPtr(same->get()));
+    } else {
+        SkDynamicMemoryWStream write;
+        if (!SkPngEncoder::Encode(&write, bitmap, {})) {
+            HRM(E_FAIL, "Unable to encode bitmap as png.");
+        }
+        SkTScopedComPtr<IStream> read;
+        HRM(SkIStream::CreateFromSkStream(write.detachAsStream(), &read),
+            "Could not create stream from png data.");
+
+        const size_t size =
+            std::size(L"/Documents/1/Resources/Images/" L_GUID_ID L".png");
+        wchar_t buffer[size];
+        wchar_t id[GUID_ID_LEN];
+        HR(this->createId(id, GUID_ID_LEN));
+        swprintf_s(buffer, size, L"/Documents/1/Resources/Images/%s.png", id);
+
+        SkTScopedComPtr<IOpcPartUri> imagePartUri;
+        HRM(this->fXpsFactory->CreatePartUri(buffer, &imagePartUri),
+            "Could not create image part uri.");
+
+        HRM(this->fXpsFactory->CreateImageResource(
+                read.get(),
+                XPS_IMAGE_TYPE_PNG,
+                imagePartUri.get(),
+                &imageResource),
+            "Could not create image resource.");
+        fTopImageResources->set(contentHash, SkTScopedComPtr<IXpsOMImageResource>(
+                                                     SkRefComPtr(imageResource.get())));
+    }
 
     XPS_RECT bitmapRect = {
         0.0, 0.0,
@@ -1979,6 +1988,7 @@ sk_sp<SkDevice> SkXPSDevice::createDevice(const CreateInfo& info, const SkPaint*
     dev->fCurrentUnitsPerMeter = this->fCurrentUnitsPerMeter;
     dev->fCurrentPixelsPerMeter = this->fCurrentPixelsPerMeter;
     dev->fTopTypefaces = this->fTopTypefaces;
+    dev->fTopImageResources = this->fTopImageResources;
     SkAssertResult(dev->createCanvasForLayer());
     return dev;
 }
@@ -24,6 +24,7 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkTArray.h"
+#include "src/core/SkTHash.h"
 #include "src/core/SkBitmapDevice.h"
 #include "src/core/SkClipStackDevice.h"
 #include "src/utils/SkBitSet.h"
@@ -132,6 +133,13 @@ private:
     skia_private::TArray<TypefaceUse, true> fTypefaces;
     skia_private::TArray<TypefaceUse, true>* fTopTypefaces;
 
+    // Image resources by SkImageContentHash, so an image drawn on many pages (or drawn from many
+    // SkImages) is written into the package once. Layers share their top device's.
+    using ImageResourceMap =
+            skia_private::THashMap<uint64_t, SkTScopedComPtr<IXpsOMImageResource>>;
+    ImageResourceMap fImageResources;
+    ImageResourceMap* fTopImageResources;
+
     /** Creates a GUID based id and places it into buffer.
         buffer should have space for at least GUID_ID_LEN wide characters.
         The string will always be wchar null terminated.
@@ -8,10 +8,15 @@
 #include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedImageFormat.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
@@ -21,8 +26,10 @@
 #include "tools/Resources.h"
 
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <utility>
 
@@ -272,3 +279,74 @@ DEF_TEST(AndroidCodec_PQ, r) {
     static constexpr skcms_Matrix3x3 kExpected = SkNamedGamut::kRec2020;
     REPORTER_ASSERT(r, 0 == memcmp(&matrix, &kExpected, sizeof(skcms_Matrix3x3)));
 }
+
+DEF_TEST(AndroidCodec_getThumbnails, r) {
+    const char* path = "images/mandrill_512_q075.jpg";
+    auto data = GetResourceAsData(path);
+    if (!data) {
+        return;
+    }
+    auto codec = SkAndroidCodec::MakeFromCodec(SkCodec::MakeFromData(data));
+    if (!codec) {
+        ERRORF(r, "Failed to create codec from %s", path);
+        return;
+    }
+
+    SkBitmap full;
+    full.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(full.info(), full.getPixels(),
+                                                              full.rowBytes()));
+
+    // Sizes that need a DCT scale, halvings of that and a final resample, in more than one color
+    // type.
+    const SkImageInfo infos[] = {
+            SkImageInfo::MakeN32Premul(200, 200),
+            SkImageInfo::Make(100, 70, kRGBA_F16_SkColorType, kPremul_SkAlphaType),
+            SkImageInfo::MakeN32Premul(37, 37),
+            SkImageInfo::MakeN32Premul(512, 512),
+    };
+    constexpr int kCount = std::size(infos);
+    SkBitmap serial[kCount], parallel[kCount];
+    SkPixmap serialPixmaps[kCount], parallelPixmaps[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        serial[i].allocPixels(infos[i]);
+        parallel[i].allocPixels(infos[i]);
+        serialPixmaps[i] = serial[i].pixmap();
+        parallelPixmaps[i] = parallel[i].pixmap();
+    }
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getThumbnails(serialPixmaps));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getThumbnails(parallelPixmaps,
+                                                                  executor.get()));
+
+    for (int i = 0; i < kCount; ++i) {
+        SkBitmap expected;
+        expected.allocPixels(infos[i].makeColorType(kN32_SkColorType));
+        full.pixmap().scalePixels(expected.pixmap(),
+                                  SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kLinear));
+        SkBitmap actual;
+        actual.allocPixels(expected.info());
+        serial[i].readPixels(actual.pixmap());
+
+        // The thumbnails should be close to resampling the full decode, and the same whether
+        // or not they were made in parallel.
+        bool same = true;
+        double error = 0;
+        for (int y = 0; y < infos[i].height(); ++y) {
+            for (int x = 0; x < infos[i].width(); ++x) {
+                same &= serial[i].getColor4f(x, y) == parallel[i].getColor4f(x, y);
+                SkColor a = actual.getColor(x, y), b = expected.getColor(x, y);
+                error += std::abs((int)SkColorGetR(a) - (int)SkColorGetR(b)) +
+                         std::abs((int)SkColorGetG(a) - (int)SkColorGetG(b)) +
+                         std::abs((int)SkColorGetB(a) - (int)SkColorGetB(b));
+            }
+        }
+        error /= 3.0 * infos[i].width() * infos[i].height();
+        REPORTER_ASSERT(r, same, "thumbnail %d", i);
+        REPORTER_ASSERT(r, error < 4, "thumbnail %d: mean error %g", i, error);
+    }
+
+    REPORTER_ASSERT(r, SkCodec::kInvalidParameters == codec->getThumbnails({}));
+    SkPixmap empty;
+    REPORTER_ASSERT(r, SkCodec::kInvalidParameters == codec->getThumbnails({&empty, 1}));
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkAnimationDecoder.h"
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Decodes each frame on its own, letting the codec decode the frames it requires.
+std::vector<SkBitmap> decode_frames(sk_sp<SkData> data) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(std::move(data));
+    std::vector<SkBitmap> frames;
+    if (!codec) {
+        return frames;
+    }
+    const SkImageInfo info = codec->getInfo()
+                                     .makeColorType(kN32_SkColorType)
+                                     .makeAlphaType(kPremul_SkAlphaType);
+    const int count = std::max(1, codec->getFrameCount());
+    for (int i = 0; i < count; ++i) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+        SkCodec::Options options;
+        options.fFrameIndex = i;
+        SkCodec::Result result = codec->getPixels(bitmap.pixmap(), &options);
+        if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput &&
+            result != SkCodec::kErrorInInput) {
+            bitmap.reset();
+        }
+        frames.push_back(bitmap);
+    }
+    return frames;
+}
+
+bool same_pixels(const sk_sp<SkImage>& image, const SkBitmap& expected) {
+    if (!image || expected.drawsNothing()) {
+        return !image && expected.drawsNothing();
+    }
+    SkBitmap actual;
+    actual.allocPixels(expected.info());
+    if (!image->readPixels(actual.pixmap(), 0, 0)) {
+        return false;
+    }
+    for (int y = 0; y < expected.height(); ++y) {
+        if (memcmp(actual.getAddr(0, y), expected.getAddr(0, y), expected.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // anonymous namespace
+
+// Frames from SkAnimationDecoder, played in order and out of order, with and without an executor,
+// must match the frames decoded one at a time.
+DEF_TEST(AnimationDecoder_Frames, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (const char* name : {"images/required.gif", "images/alphabetAnim.gif",
+                             "images/randPixelsAnim.gif", "images/stoplight.webp",
+                             "images/required.webp", "images/mandrill_512_q075.jpg"}) {
+        sk_sp<SkData> data = GetResourceAsData(name);
+        if (!data) {
+            continue;
+        }
+        const std::vector<SkBitmap> expected = decode_frames(data);
+        if (expected.empty()) {
+            // The codec isn't available.
+            continue;
+        }
+        const int count = static_cast<int>(expected.size());
+
+        for (SkExecutor* exec : {executor.get(), static_cast<SkExecutor*>(nullptr)}) {
+            for (int windowSize : {1, 3, count}) {
+                std::unique_ptr<SkAnimationDecoder> decoder =
+                        SkAnimationDecoder::Make(data, exec, windowSize);
+                REPORTER_ASSERT(r, decoder, "%s", name);
+                if (!decoder) {
+                    continue;
+                }
+                REPORTER_ASSERT(r, decoder->getFrameCount() == count, "%s", name);
+
+                // Play the animation twice, and then jump around.
+                std::vector<int> order;
+                for (int i = 0; i < 2 * count; ++i) {
+                    order.push_back(i % count);
+                }
+                for (int i = 0; i < count; ++i) {
+                    order.push_back((i * 7 + 3) % count);
+                }
+                for (int index : order) {
+                    sk_sp<SkImage> frame = decoder->getFrame(index);
+                    REPORTER_ASSERT(r, same_pixels(frame, expected[index]),
+                                    "%s: frame %d, window %d, executor %d", name, index,
+                                    windowSize, exec != nullptr);
+                }
+                REPORTER_ASSERT(r, !decoder->getFrame(count));
+            }
+        }
+
+        // Images outlive the window, and the decoder.
+        std::unique_ptr<SkAnimationDecoder> decoder =
+                SkAnimationDecoder::Make(data, executor.get(), 1);
+        sk_sp<SkImage> first = decoder->getFrame(0);
+        decoder->getFrame(count - 1);
+        decoder.reset();
+        REPORTER_ASSERT(r, same_pixels(first, expected[0]), "%s", name);
+    }
+
+    REPORTER_ASSERT(r, !SkAnimationDecoder::Make(nullptr, executor.get(), 4));
+    REPORTER_ASSERT(r, !SkAnimationDecoder::Make(SkData::MakeEmpty(), executor.get(), 4));
+}
@@ -6,7 +6,9 @@
  */
 
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkMalloc.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkMallocStats.h"
 #include "tests/Test.h"
 
 #include <cstddef>
@@ -140,6 +142,34 @@ DEF_TEST(ArenaAllocIsEmpty, r) {
     }
 }
 
+DEF_TEST(ArenaAllocResetRetainsBlock, r) {
+    static int created = 0,
+               destroyed = 0;
+    struct Node {
+        Node() { created++; }
+        ~Node() { destroyed++; }
+        char filler[64];
+    };
+
+    SkArenaAllocWithReset arena{64};
+    for (int frame = 0; frame < 3; ++frame) {
+        // After the first reset, everything fits in one retained block, one object after another.
+        char* nodes[100];
+        for (char*& node : nodes) {
+            node = (char*)arena.make<Node>();
+        }
+        bool contiguous = true;
+        for (int i = 2; i < 100; ++i) {
+            contiguous &= nodes[i] - nodes[i - 1] == nodes[1] - nodes[0];
+        }
+        REPORTER_ASSERT(r, contiguous == (frame > 0));
+        arena.reset();
+        REPORTER_ASSERT(r, arena.isEmpty());
+        REPORTER_ASSERT(r, created == destroyed);
+    }
+    REPORTER_ASSERT(r, created == 300);
+}
+
 DEF_TEST(ArenaAllocWithMultipleBlocks, r) {
     // Make sure that multiple blocks are handled correctly.
     static int created = 0,
@@ -243,3 +273,25 @@ DEF_TEST(SkFibBlockSizes, r) {
         REPORTER_ASSERT(r, lastSize == 1346269u * 1024);
     }
 }
+
+DEF_TEST(ArenaAlloc_MallocStats, r) {
+    SkMallocStats::Reset();
+    SkMallocStats::SetEnabled(true);
+    {
+        void* p = sk_malloc_throw(1000);
+        sk_free(p);
+
+        SkArenaAlloc arena{0};
+        arena.makeArrayDefault<char>(5000);
+    }
+    SkMallocStats::SetEnabled(false);
+
+    // Other tests may allocate at the same time, so only lower bounds can be checked.
+    SkMallocStats::Stats stats = SkMallocStats::Snapshot();
+    REPORTER_ASSERT(r, stats.fMallocCount >= 2);
+    REPORTER_ASSERT(r, stats.fMallocBytes >= 6000);
+    REPORTER_ASSERT(r, stats.fFreeCount >= 2);
+    REPORTER_ASSERT(r, stats.fPeakLiveBytes >= 5000);
+    REPORTER_ASSERT(r, stats.fArenaBlockCount >= 1);
+    REPORTER_ASSERT(r, stats.fPeakArenaBytes >= 5000);
+}
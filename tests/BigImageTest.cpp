@@ -11,7 +11,9 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -61,6 +63,7 @@ namespace skgpu { namespace graphite { class Recorder; } }
 #include <atomic>
 #include <functional>
 #include <initializer_list>
+#include <memory>
 #include <string.h>
 #include <utility>
 
@@ -569,6 +572,95 @@ void tiled_image_caching_test(GrDirectContext* dContext,
 #endif
 }
 
+// Wraps an image, and counts how often it is decoded.
+class CountingImageGenerator : public SkImageGenerator {
+public:
+    CountingImageGenerator(sk_sp<SkImage> image, int* decodeCount)
+            : SkImageGenerator(image->imageInfo())
+            , fImage(std::move(image))
+            , fDecodeCount(decodeCount) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        ++*fDecodeCount;
+        return fImage->readPixels(nullptr, info, pixels, rowBytes, 0, 0);
+    }
+
+private:
+    sk_sp<SkImage> fImage;
+    int* fDecodeCount;
+};
+
+// In this test we draw a lazy image twice, purging its decoded pixels from the CPU cache in
+// between, and check that only the first draw decodes it. The tiles of the second draw are found
+// in the GPU cache by their IDs.
+void lazy_tiled_image_caching_test(GrDirectContext* dContext,
+                                   skgpu::graphite::Recorder* recorder,
+                                   skiatest::Reporter* reporter) {
+    static const int kImageSize = 4096;
+    static const int kOverrideMaxTextureSize = 1024;
+
+    int decodeCount = 0;
+    sk_sp<SkImage> img = SkImages::DeferredFromGenerator(std::make_unique<CountingImageGenerator>(
+            make_big_bitmap_image(kImageSize,
+                                  /* whiteBandWidth= */ 0,
+                                  /* desiredLineWidth= */ 16,
+                                  /* desiredDepth= */ 7),
+            &decodeCount));
+
+    auto destII = SkImageInfo::Make(kImageSize, kImageSize,
+                                    kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType);
+
+    sk_sp<SkSurface> surface;
+
+#if defined(SK_GANESH)
+    if (dContext) {
+        surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, destII);
+    }
+#endif
+
+#if defined(SK_GRAPHITE)
+    if (recorder) {
+        surface = SkSurfaces::RenderTarget(recorder, destII);
+    }
+#endif
+
+    if (!surface) {
+        return;
+    }
+
+    SkCanvas* canvas = surface->getCanvas();
+
+#if defined(SK_GANESH) && defined(GR_TEST_UTILS)
+    gOverrideMaxTextureSizeGanesh = kOverrideMaxTextureSize;
+#endif
+#if defined(SK_GRAPHITE) && defined(GRAPHITE_TEST_UTILS)
+    gOverrideMaxTextureSizeGraphite = kOverrideMaxTextureSize;
+#endif
+    for (int i = 0; i < 2; ++i) {
+        SkGraphics::PurgeResourceCache();
+        canvas->clear(SK_ColorBLACK);
+
+        SkTiledImageUtils::DrawImage(canvas, img,
+                                     /* x= */ 0, /* y= */ 0,
+                                     SkSamplingOptions(SkFilterMode::kNearest, SkMipmapMode::kNone),
+                                     /* paint= */ nullptr,
+                                     SkCanvas::kFast_SrcRectConstraint);
+    }
+
+    REPORTER_ASSERT(reporter, decodeCount == 1, "Expected: 1 Actual: %d", decodeCount);
+
+    // reset to default behavior
+#if defined(SK_GANESH) && defined(GR_TEST_UTILS)
+    gOverrideMaxTextureSizeGanesh = 0;
+#endif
+#if defined(SK_GRAPHITE) && defined(GRAPHITE_TEST_UTILS)
+    gOverrideMaxTextureSizeGraphite = 0;
+#endif
+}
+
 } // anonymous namespace
 
 #if defined(SK_GANESH)
@@ -593,6 +685,15 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(TiledDrawCacheTest_Ganesh,
     tiled_image_caching_test(dContext, /* recorder= */ nullptr, reporter);
 }
 
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(LazyTiledDrawCacheTest_Ganesh,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+
+    lazy_tiled_image_caching_test(dContext, /* recorder= */ nullptr, reporter);
+}
+
 #endif // SK_GANESH
 
 #if defined(SK_GRAPHITE)
@@ -618,4 +719,14 @@ DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(TiledDrawCacheTest_Graphite,
     tiled_image_caching_test(/* dContext= */ nullptr, recorder.get(), reporter);
 }
 
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(LazyTiledDrawCacheTest_Graphite,
+                                         reporter,
+                                         context,
+                                         CtsEnforcement::kNextRelease) {
+    std::unique_ptr<skgpu::graphite::Recorder> recorder =
+            context->makeRecorder(ToolUtils::CreateTestingRecorderOptions());
+
+    lazy_tiled_image_caching_test(/* dContext= */ nullptr, recorder.get(), reporter);
+}
+
 #endif // SK_GRAPHITE
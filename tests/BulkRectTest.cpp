@@ -9,6 +9,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
@@ -23,6 +24,7 @@
 #include "include/gpu/GrTypes.h"
 #include "include/private/SkColorData.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/core/SkAutoPixmapStorage.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/Swizzle.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -371,6 +373,59 @@ static void run_test(GrDirectContext* dContext, skiatest::Reporter* reporter, Bu
 
 }
 
+// Draws a grid of non-AA rects, each with its own color, in one batch that is large enough to be
+// drawn with instances when the caps support it, and checks that every rect lands where it should.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BulkFillRectPixelsTest,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNextRelease) {
+    auto dContext = ctxInfo.directContext();
+    std::unique_ptr<skgpu::ganesh::SurfaceDrawContext> sdc = new_SDC(dContext);
+
+    static constexpr int kCellSize = 16;
+    static constexpr int kGridSize = 128 / kCellSize;
+    static constexpr int kNumQuads = kGridSize * kGridSize;
+
+    auto colorForCell = [](int i) -> uint32_t {
+        // Opaque, and distinct for every cell (RGBA_8888 in memory)
+        return 0xFF000000 | ((i * 37) & 0xFF) << 16 | ((i * 11) & 0xFF) << 8 | (255 - i);
+    };
+
+    GrQuadSetEntry quads[kNumQuads];
+    for (int i = 0; i < kNumQuads; ++i) {
+        quads[i].fRect = SkRect::MakeXYWH((i % kGridSize) * kCellSize, (i / kGridSize) * kCellSize,
+                                          kCellSize, kCellSize);
+        quads[i].fColor = SkPMColor4f::FromBytes_RGBA(colorForCell(i));
+        quads[i].fLocalMatrix = SkMatrix::I();
+        quads[i].fAAFlags = GrQuadAAFlags::kNone;
+    }
+
+    sdc->clear(SK_PMColor4fTRANSPARENT);
+    GrPaint paint;
+    paint.setXPFactory(GrXPFactory::FromBlendMode(SkBlendMode::kSrcOver));
+    skgpu::ganesh::FillRectOp::AddFillRectOps(sdc.get(), nullptr, dContext, std::move(paint),
+                                              GrAAType::kNone, SkMatrix::I(), quads, kNumQuads);
+
+    SkAutoPixmapStorage readback;
+    readback.alloc(SkImageInfo::Make(sdc->width(), sdc->height(), kRGBA_8888_SkColorType,
+                                     kPremul_SkAlphaType));
+    if (!sdc->readPixels(dContext, readback, {0, 0})) {
+        ERRORF(reporter, "Could not read pixels");
+        return;
+    }
+    for (int y = 0; y < sdc->height(); ++y) {
+        for (int x = 0; x < sdc->width(); ++x) {
+            uint32_t expected = colorForCell((y / kCellSize) * kGridSize + x / kCellSize);
+            uint32_t actual = *readback.addr32(x, y);
+            if (actual != expected) {
+                ERRORF(reporter, "Expected 0x%08x at (%d, %d), got 0x%08x", expected, x, y,
+                       actual);
+                return;
+            }
+        }
+    }
+}
+
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BulkFillRectTest,
                                        reporter,
                                        ctxInfo,
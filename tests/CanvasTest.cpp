@@ -13,6 +13,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkDocument.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -21,6 +22,7 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkRegion.h"
@@ -37,6 +39,7 @@
 #include "include/private/base/SkTemplates.h"
 #include "include/utils/SkNWayCanvas.h"
 #include "include/utils/SkPaintFilterCanvas.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecords.h"
@@ -47,6 +50,7 @@
 #include <initializer_list>
 #include <memory>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -751,6 +755,34 @@ DEF_TEST(Canvas_saveLayer_colorSpace, reporter) {
     REPORTER_ASSERT(reporter, pm.getColor(0, 0) == SK_ColorBLUE);
 }
 
+// Raster layers reuse the pixels of earlier layers, which must not show through in later ones.
+DEF_TEST(Canvas_saveLayer_reusedPixelsAreClear, reporter) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    SkCanvas canvas(bitmap);
+
+    for (int size : {64, 60, 64, 33}) {
+        canvas.clear(SK_ColorWHITE);
+        canvas.saveLayer(SkRect::MakeWH(size, size), nullptr);
+        canvas.restore();
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                if (bitmap.getColor(x, y) != SK_ColorWHITE) {
+                    ERRORF(reporter, "size %d at (%d, %d): 0x%08x", size, x, y,
+                           bitmap.getColor(x, y));
+                    return;
+                }
+            }
+        }
+
+        // Leave the layer's pixels dirty for the next one.
+        canvas.saveLayer(SkRect::MakeWH(size, size), nullptr);
+        canvas.drawColor(SK_ColorRED);
+        canvas.restore();
+        REPORTER_ASSERT(reporter, bitmap.getColor(0, 0) == SK_ColorRED);
+    }
+}
+
 // Draw a lot of rectangles with different colors. On the GPU, the different colors make this
 // relatively difficult to batch.
 void test_many_draws(skiatest::Reporter* reporter, SkSurface* surface) {
@@ -788,3 +820,145 @@ DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(TestManyDrawsGraphite, reporter, contex
     test_many_draws(reporter, surface.get());
 }
 #endif
+
+// Rotated and scaled atlas sprites are filled as two triangles rather than as a path. They must
+// cover exactly the pixels that drawing each sprite as a rect does, with no seams or double blends
+// along the diagonal, and sprites entirely outside the clip must not affect the rest.
+DEF_TEST(Canvas_drawAtlas_transformedSprites, r) {
+    SkBitmap atlasBitmap;
+    atlasBitmap.allocN32Pixels(32, 32);
+    for (int y = 0; y < 32; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            *atlasBitmap.getAddr32(x, y) = SkPreMultiplyARGB(0xc0, x * 8, y * 8, 0x80);
+        }
+    }
+    sk_sp<SkImage> atlas = atlasBitmap.asImage();
+
+    std::vector<SkRSXform> xforms;
+    std::vector<SkRect> textures;
+    std::vector<SkColor> colors;
+    SkRandom rand;
+    for (int i = 0; i < 40; ++i) {
+        xforms.push_back(SkRSXform::MakeFromRadians(rand.nextRangeF(0.25f, 2),
+                                                    rand.nextRangeF(0, 6.3f),
+                                                    rand.nextRangeF(50, 150),
+                                                    rand.nextRangeF(50, 150),
+                                                    0, 0));
+        const float l = rand.nextRangeF(0, 16),
+                    t = rand.nextRangeF(0, 16);
+        textures.push_back(SkRect::MakeLTRB(l, t, l + rand.nextRangeF(4, 16),
+                                                  t + rand.nextRangeF(4, 16)));
+        colors.push_back(rand.nextU() | 0x80000000);
+    }
+    // One more sprite, far outside the clip. (The others stay inside it, where the path filler
+    // doesn't chop their edges.)
+    xforms.push_back(SkRSXform::Make(0.5f, 0.5f, 500, 500));
+    textures.push_back(SkRect::MakeWH(8, 8));
+    colors.push_back(SK_ColorRED);
+
+    for (bool useColors : {false, true}) {
+        const SkImageInfo info = SkImageInfo::MakeN32Premul(200, 200);
+        SkBitmap batched, expected;
+        batched.allocPixels(info);
+        expected.allocPixels(info);
+        batched.eraseColor(SK_ColorWHITE);
+        expected.eraseColor(SK_ColorWHITE);
+
+        SkCanvas batchedCanvas(batched);
+        batchedCanvas.drawAtlas(atlas.get(), xforms.data(), textures.data(),
+                                useColors ? colors.data() : nullptr, (int)xforms.size(),
+                                SkBlendMode::kModulate, SkSamplingOptions(), nullptr, nullptr);
+
+        SkCanvas expectedCanvas(expected);
+        for (size_t i = 0; i < xforms.size(); ++i) {
+            expectedCanvas.save();
+            SkMatrix mx;
+            mx.setRSXform(xforms[i]);
+            mx.preTranslate(-textures[i].fLeft, -textures[i].fTop);
+            expectedCanvas.concat(mx);
+            SkPaint paint;
+            paint.setShader(atlas->makeShader(SkSamplingOptions()));
+            if (useColors) {
+                paint.setShader(SkShaders::Blend(SkBlendMode::kModulate,
+                                                 SkShaders::Color(colors[i]), paint.refShader()));
+            }
+            expectedCanvas.drawRect(textures[i], paint);
+            expectedCanvas.restore();
+        }
+
+        int mismatches = 0;
+        for (int y = 0; y < 200; ++y) {
+            for (int x = 0; x < 200; ++x) {
+                mismatches += *batched.getAddr32(x, y) != *expected.getAddr32(x, y);
+            }
+        }
+        REPORTER_ASSERT(r, mismatches == 0, "colors %d: %d pixels differ", useColors, mismatches);
+    }
+}
+
+DEF_TEST(Canvas_drawEdgeAARectSet, r) {
+    std::vector<SkRect> rects;
+    std::vector<SkColor4f> colors;
+    std::vector<SkMatrix> matrices;
+    SkRandom rand;
+    for (int i = 0; i < 50; ++i) {
+        const float l = rand.nextRangeF(-20, 180),
+                    t = rand.nextRangeF(-20, 180);
+        rects.push_back(SkRect::MakeLTRB(l, t, l + rand.nextRangeF(1, 40),
+                                               t + rand.nextRangeF(1, 40)));
+        colors.push_back({rand.nextF(), rand.nextF(), rand.nextF(), rand.nextRangeF(0.5f, 1)});
+        matrices.push_back(SkMatrix::RotateDeg(rand.nextRangeF(-30, 30), {100, 100}));
+    }
+
+    auto draw_set = [&](SkCanvas* canvas, bool useMatrices) {
+        canvas->experimental_DrawEdgeAARectSet(rects.data(), colors.data(),
+                                               useMatrices ? matrices.data() : nullptr,
+                                               (int)rects.size(), SkCanvas::kAll_QuadAAFlags,
+                                               SkBlendMode::kSrcOver);
+    };
+
+    for (bool useMatrices : {false, true}) {
+        const SkImageInfo info = SkImageInfo::MakeN32Premul(200, 200);
+        SkBitmap expected;
+        expected.allocPixels(info);
+        expected.eraseColor(SK_ColorWHITE);
+        SkCanvas expectedCanvas(expected);
+        for (size_t i = 0; i < rects.size(); ++i) {
+            expectedCanvas.save();
+            if (useMatrices) {
+                expectedCanvas.concat(matrices[i]);
+            }
+            expectedCanvas.experimental_DrawEdgeAAQuad(rects[i], nullptr,
+                                                       SkCanvas::kAll_QuadAAFlags, colors[i],
+                                                       SkBlendMode::kSrcOver);
+            expectedCanvas.restore();
+        }
+
+        // Directly, and recorded into a picture.
+        SkPictureRecorder recorder;
+        draw_set(recorder.beginRecording(SkRect::MakeWH(200, 200)), useMatrices);
+        sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+        REPORTER_ASSERT(r, picture->approximateOpCount() == 1);
+
+        for (bool usePicture : {false, true}) {
+            SkBitmap batched;
+            batched.allocPixels(info);
+            batched.eraseColor(SK_ColorWHITE);
+            SkCanvas batchedCanvas(batched);
+            if (usePicture) {
+                batchedCanvas.drawPicture(picture);
+            } else {
+                draw_set(&batchedCanvas, useMatrices);
+            }
+
+            int mismatches = 0;
+            for (int y = 0; y < 200; ++y) {
+                for (int x = 0; x < 200; ++x) {
+                    mismatches += *batched.getAddr32(x, y) != *expected.getAddr32(x, y);
+                }
+            }
+            REPORTER_ASSERT(r, mismatches == 0, "matrices %d picture %d: %d pixels differ",
+                            useMatrices, usePicture, mismatches);
+        }
+    }
+}
@@ -756,6 +756,86 @@ static void test_quickContains(skiatest::Reporter* reporter) {
     }
 }
 
+// The element-by-element walk quickContains used to do, as a reference for its shortcuts.
+static bool linear_quick_contains(const SkClipStack& stack, const SkRect& rect) {
+    SkClipStack::Iter iter(stack, SkClipStack::Iter::kTop_IterStart);
+    for (const SkClipStack::Element* element = iter.prev(); element; element = iter.prev()) {
+        if (SkClipOp::kIntersect != element->getOp() && !element->isReplaceOp()) {
+            return false;
+        }
+        if (element->isInverseFilled()) {
+            if (SkRect::Intersects(element->getBounds(), rect)) {
+                return false;
+            }
+        } else if (!element->contains(rect)) {
+            return false;
+        }
+        if (element->isReplaceOp()) {
+            break;
+        }
+    }
+    return true;
+}
+
+static void test_quickContains_deep_stack(skiatest::Reporter* reporter) {
+    static const SkRect kTestRects[] = {
+        SkRect::MakeLTRB(150, 150, 160, 160),
+        SkRect::MakeLTRB(100, 100, 200, 200),
+        SkRect::MakeLTRB(60, 60, 240, 240),
+        SkRect::MakeLTRB(0, 0, 300, 300),
+        SkRect::MakeLTRB(98.5f, 120, 101, 130),
+    };
+    auto check = [&](const SkClipStack& stack) {
+        for (const SkRect& r : kTestRects) {
+            REPORTER_ASSERT(reporter, stack.quickContains(r) == linear_quick_contains(stack, r));
+            SkRRect rr = SkRRect::MakeRect(r);
+            REPORTER_ASSERT(reporter, stack.quickContains(rr) == linear_quick_contains(stack, r));
+        }
+    };
+
+    // Nested scroll views: each level clips to a slightly smaller rect, with an occasional rrect
+    // or path mask on top of it.
+    SkClipStack stack;
+    for (int i = 0; i < 100; ++i) {
+        stack.save();
+        SkRect r = SkRect::MakeLTRB(i, i, 300 - i, 300 - i);
+        switch (i % 10) {
+            case 3:
+                stack.clipRRect(SkRRect::MakeRectXY(r, 4, 4), SkMatrix::I(),
+                                SkClipOp::kIntersect, true);
+                break;
+            case 7: {
+                SkPath path;
+                path.addCircle(150, 150, 150 - i);
+                stack.clipPath(path, SkMatrix::I(), SkClipOp::kIntersect, true);
+                break;
+            }
+            default:
+                stack.clipRect(r, SkMatrix::I(), SkClipOp::kIntersect, i & 1);
+                break;
+        }
+        check(stack);
+    }
+    while (stack.getSaveCount() > 0) {
+        stack.restore();
+        check(stack);
+    }
+
+    // Only rects, down to a replace op and after a difference op.
+    for (int i = 0; i < 50; ++i) {
+        stack.save();
+        stack.clipRect(SkRect::MakeLTRB(i, 2 * i, 300 - i, 300 - 2 * i), SkMatrix::I(),
+                       SkClipOp::kIntersect, false);
+        check(stack);
+    }
+    stack.save();
+    stack.replaceClip(SkRect::MakeLTRB(50, 50, 250, 250), false);
+    check(stack);
+    stack.clipRect(SkRect::MakeLTRB(140, 140, 145, 145), SkMatrix::I(), SkClipOp::kDifference,
+                   false);
+    check(stack);
+}
+
 static void set_region_to_stack(const SkClipStack& stack, const SkIRect& bounds, SkRegion* region) {
     region->setRect(bounds);
     SkClipStack::Iter iter(stack, SkClipStack::Iter::kBottom_IterStart);
@@ -885,6 +965,7 @@ DEF_TEST(ClipStack, reporter) {
     test_rect_inverse_fill(reporter);
     test_path_replace(reporter);
     test_quickContains(reporter);
+    test_quickContains_deep_stack(reporter);
     test_invfill_diff_bug(reporter);
     test_is_rrect_deep_rect_stack(reporter);
 }
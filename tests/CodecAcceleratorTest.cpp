@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkEncodedImageFormat.h"
+#include "include/codec/SkWbmpDecoder.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+#include "tests/Test.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+class FakeAccelerator : public SkCodecs::Accelerator {
+public:
+    bool decode(const SkCodec& codec, SkStream* encoded, const SkPixmap& dst) override {
+        fCalls++;
+        fSawWholeStream = encoded && encoded->getLength() == codec.getEncodedData()->getLength();
+        if (!fAccept) {
+            return false;
+        }
+        dst.erase(SK_ColorGREEN);
+        return true;
+    }
+
+    bool fAccept = true;
+    int fCalls = 0;
+    bool fSawWholeStream = false;
+};
+
+// A 4x2 WBMP, with the top row white and the bottom row black.
+sk_sp<SkData> make_wbmp() {
+    static const uint8_t kWbmp[] = {0x00, 0x00, 4, 2, 0xF0, 0x00};
+    return SkData::MakeWithoutCopy(kWbmp, sizeof(kWbmp));
+}
+
+}  // namespace
+
+DEF_TEST(Codec_Accelerator, r) {
+    auto accelerator = sk_make_sp<FakeAccelerator>();
+    SkCodecs::RegisterAccelerator(SkEncodedImageFormat::kWBMP, accelerator);
+
+    std::unique_ptr<SkCodec> codec = SkWbmpDecoder::Decode(make_wbmp(), nullptr);
+    REPORTER_ASSERT(r, codec);
+    SkBitmap bm;
+    bm.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType));
+
+    // Taken by the accelerator.
+    REPORTER_ASSERT(r, codec->getPixels(bm.pixmap()) == SkCodec::kSuccess);
+    REPORTER_ASSERT(r, accelerator->fCalls == 1);
+    REPORTER_ASSERT(r, accelerator->fSawWholeStream);
+    REPORTER_ASSERT(r, bm.getColor(0, 1) == SK_ColorGREEN);
+
+    // Declined, so decoded in software, from the start of the stream.
+    accelerator->fAccept = false;
+    REPORTER_ASSERT(r, codec->getPixels(bm.pixmap()) == SkCodec::kSuccess);
+    REPORTER_ASSERT(r, accelerator->fCalls == 2);
+    REPORTER_ASSERT(r, bm.getColor(0, 0) == SK_ColorWHITE);
+    REPORTER_ASSERT(r, bm.getColor(0, 1) == SK_ColorBLACK);
+
+    // Only whole images are offered.
+    SkCodec::Options options;
+    const SkIRect subset = SkIRect::MakeWH(2, 2);
+    options.fSubset = &subset;
+    codec->getPixels(bm.pixmap(), &options);
+    REPORTER_ASSERT(r, accelerator->fCalls == 2);
+
+    // Unregistered.
+    accelerator->fAccept = true;
+    SkCodecs::RegisterAccelerator(SkEncodedImageFormat::kWBMP, nullptr);
+    REPORTER_ASSERT(r, codec->getPixels(bm.pixmap()) == SkCodec::kSuccess);
+    REPORTER_ASSERT(r, accelerator->fCalls == 2);
+    REPORTER_ASSERT(r, bm.getColor(0, 1) == SK_ColorBLACK);
+}
@@ -9,11 +9,13 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkDebug.h"
+#include "src/codec/SkIncrementalDecoder.h"
 #include "tests/CodecPriv.h"
 #include "tests/FakeStreams.h"
 #include "tests/Test.h"
@@ -156,6 +158,67 @@ DEF_TEST(Codec_partial, r) {
     test_partial(r, "images/color_wheel.gif");
 }
 
+// Each step of an SkIncrementalDecoder reports the rows it changed: the rows below the previous
+// step for a top-down image, or every row decoded so far for an interlaced one.
+static void test_incremental_decoder(skiatest::Reporter* r, const char* name, bool rewritesRows) {
+    sk_sp<SkData> file = GetResourceAsData(name);
+    SkBitmap truth;
+    if (!file || !create_truth(file, &truth)) {
+        return;
+    }
+    constexpr size_t kIncrement = 1000;
+    HaltingStream* stream = new HaltingStream(file, file->size() / 2);
+    auto codec = SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream));
+    if (!codec) {
+        ERRORF(r, "Failed to create codec for %s", name);
+        return;
+    }
+    const SkImageInfo info = standardize_info(codec.get());
+    SkCodec::Result result;
+    auto decoder = SkIncrementalDecoder::Make(std::move(codec), info, nullptr, &result);
+    if (!decoder) {
+        ERRORF(r, "Failed to start incremental decode of %s: %d", name, (int)result);
+        return;
+    }
+
+    int steps = 0;
+    int previousBottom = 0;
+    while (true) {
+        SkIRect changed;
+        result = decoder->decode(&changed);
+        steps++;
+        if (!changed.isEmpty()) {
+            REPORTER_ASSERT(r, changed.left() == 0 && changed.right() == info.width());
+            REPORTER_ASSERT(r, changed.top() == (rewritesRows ? 0 : previousBottom),
+                            "%s: step %d changed rows %d to %d", name, steps, changed.top(),
+                            changed.bottom());
+            REPORTER_ASSERT(r, changed.bottom() == decoder->rowsDecoded());
+            previousBottom = changed.bottom();
+        }
+        if (result != SkCodec::kIncompleteInput) {
+            break;
+        }
+        if (stream->isAllDataReceived()) {
+            ERRORF(r, "Failed to completely decode %s", name);
+            return;
+        }
+        stream->addNewData(kIncrement);
+    }
+    REPORTER_ASSERT(r, result == SkCodec::kSuccess);
+    REPORTER_ASSERT(r, steps > 1, "%s was decoded in one step", name);
+    REPORTER_ASSERT(r, decoder->isFinished() && decoder->rowsDecoded() == info.height());
+    compare_bitmaps(r, truth, decoder->bitmap());
+
+    // A finished decode changes nothing more.
+    SkIRect changed;
+    REPORTER_ASSERT(r, decoder->decode(&changed) == SkCodec::kSuccess && changed.isEmpty());
+}
+
+DEF_TEST(Codec_incrementalDecoder, r) {
+    test_incremental_decoder(r, "images/plane.png", false);
+    test_incremental_decoder(r, "images/plane_interlaced.png", true);
+}
+
 DEF_TEST(Codec_partialWuffs, r) {
     const char* path = "images/alphabetAnim.gif";
     auto file = GetResourceAsData(path);
@@ -2081,3 +2081,45 @@ DEF_TEST(Codec_jpeg_can_return_data_from_original_stream, r) {
     REPORTER_ASSERT(r, encodedData->size() == expectedBytes);
     REPORTER_ASSERT(r, SkJpegDecoder::IsJpeg(encodedData->data(), encodedData->size()));
 }
+
+// Codecs read streams held in memory (here, a mapped file) in place, and other streams through a
+// buffer. Both must decode every frame the same way, including after a rewind.
+DEF_TEST(Codec_in_place_memory_matches_file_stream, r) {
+    for (const char* path : {"images/ducky.png", "images/plane_interlaced.png",
+                             "images/randPixelsAnim.gif", "images/flightAnim.gif",
+                             "images/dog.jpg", "images/baby_tux.webp"}) {
+        std::unique_ptr<SkStreamAsset> memoryStream = GetResourceAsStream(path);
+        std::unique_ptr<SkStreamAsset> fileStream = GetResourceAsStream(path, true);
+        if (!memoryStream || !fileStream) {
+            SkDebugf("Missing resource '%s'\n", path);
+            continue;
+        }
+        REPORTER_ASSERT(r, memoryStream->getMemoryBase() && !fileStream->getMemoryBase());
+        std::unique_ptr<SkCodec> memoryCodec = SkCodec::MakeFromStream(std::move(memoryStream));
+        std::unique_ptr<SkCodec> fileCodec = SkCodec::MakeFromStream(std::move(fileStream));
+        if (!memoryCodec || !fileCodec) {
+            // The decoder for this format is not included.
+            continue;
+        }
+
+        const SkImageInfo info = memoryCodec->getInfo().makeColorType(kN32_SkColorType)
+                                                       .makeAlphaType(kPremul_SkAlphaType);
+        const int frameCount = memoryCodec->getFrameCount();
+        REPORTER_ASSERT(r, frameCount == fileCodec->getFrameCount(), "%s", path);
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int frame = 0; frame < frameCount; ++frame) {
+                SkCodec::Options options;
+                options.fFrameIndex = frame;
+                SkBitmap fromMemory, fromFile;
+                fromMemory.allocPixels(info);
+                fromFile.allocPixels(info);
+                REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                                   memoryCodec->getPixels(fromMemory.pixmap(), &options));
+                REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                                   fileCodec->getPixels(fromFile.pixmap(), &options));
+                REPORTER_ASSERT(r, ToolUtils::equal_pixels(fromMemory, fromFile),
+                                "%s frame %d", path, frame);
+            }
+        }
+    }
+}
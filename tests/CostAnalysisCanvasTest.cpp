@@ -0,0 +1,153 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTileMode.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/utils/SkCostAnalysisCanvas.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+static sk_sp<SkShader> make_gradient() {
+    const SkPoint pts[] = {{0, 0}, {100, 0}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    return SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp);
+}
+
+DEF_TEST(CostAnalysisCanvas_Ops, r) {
+    SkCostAnalysisCanvas canvas(100, 100);
+    SkPaint gradient;
+    gradient.setShader(make_gradient());
+
+    canvas.drawRect(SkRect::MakeWH(10, 10), SkPaint());        // 0
+    canvas.drawRect(SkRect::MakeWH(50, 50), SkPaint());        // 1
+    canvas.drawRect(SkRect::MakeWH(50, 50), gradient);         // 2
+    canvas.drawRect(SkRect::MakeXYWH(90, 90, 50, 50), SkPaint());  // 3, clipped to 10x10
+    canvas.drawRect(SkRect::MakeXYWH(200, 0, 50, 50), SkPaint());  // 4, clipped out
+
+    const auto& ops = canvas.ops();
+    REPORTER_ASSERT(r, ops.size() == 5);
+    REPORTER_ASSERT(r, ops[1].fPixels == 2500);
+    REPORTER_ASSERT(r, ops[0].fCost < ops[1].fCost);
+    REPORTER_ASSERT(r, ops[1].fStages < ops[2].fStages);
+    REPORTER_ASSERT(r, ops[1].fCost < ops[2].fCost);
+    REPORTER_ASSERT(r, ops[3].fDeviceBounds == SkIRect::MakeLTRB(90, 90, 100, 100));
+    REPORTER_ASSERT(r, ops[3].fCost == ops[0].fCost);
+    REPORTER_ASSERT(r, ops[4].fPixels == 0);
+
+    double total = 0;
+    for (const auto& op : ops) {
+        total += op.fCost;
+    }
+    REPORTER_ASSERT(r, canvas.totalCost() == total);
+
+    const auto ranked = canvas.mostExpensiveOps(2);
+    REPORTER_ASSERT(r, ranked.size() == 2);
+    REPORTER_ASSERT(r, ranked[0].fIndex == 2);
+    REPORTER_ASSERT(r, ranked[1].fIndex == 1);
+    REPORTER_ASSERT(r, canvas.mostExpensiveOps(10).size() == 5);
+
+    // The transform counts.
+    canvas.reset();
+    REPORTER_ASSERT(r, canvas.ops().empty() && canvas.totalCost() == 0);
+    canvas.scale(2, 2);
+    canvas.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    REPORTER_ASSERT(r, canvas.ops()[0].fPixels == 400);
+}
+
+DEF_TEST(CostAnalysisCanvas_Layers, r) {
+    SkCostAnalysisCanvas canvas(100, 100);
+    canvas.save();
+    canvas.saveLayer(nullptr, nullptr);
+    canvas.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    canvas.save();
+    canvas.translate(1, 1);  // Makes the save real.
+    canvas.saveLayer(SkRect::MakeWH(20, 20), nullptr);
+    canvas.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    canvas.restore();
+    canvas.restore();
+    canvas.restore();
+    canvas.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    canvas.restore();
+
+    const auto& ops = canvas.ops();
+    REPORTER_ASSERT(r, ops.size() == 5);
+    REPORTER_ASSERT(r, !strcmp(ops[0].fName, "saveLayer"));
+    REPORTER_ASSERT(r, ops[0].fPixels == 10000);
+    REPORTER_ASSERT(r, ops[0].fLayerDepth == 0);
+    REPORTER_ASSERT(r, ops[1].fLayerDepth == 1);
+    REPORTER_ASSERT(r, !strcmp(ops[2].fName, "saveLayer"));
+    REPORTER_ASSERT(r, ops[2].fDeviceBounds == SkIRect::MakeLTRB(1, 1, 21, 21));
+    REPORTER_ASSERT(r, ops[3].fLayerDepth == 2);
+    REPORTER_ASSERT(r, ops[4].fLayerDepth == 0);
+}
+
+DEF_TEST(CostAnalysisCanvas_Nodes, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording(100, 100);
+    c->drawRect(SkRect::MakeXYWH(0, 0, 10, 10), SkPaint());
+    c->drawRect(SkRect::MakeXYWH(20, 20, 10, 10), SkPaint());
+    sk_sp<SkPicture> inner = recorder.finishRecordingAsPicture();
+
+    c = recorder.beginRecording(100, 100);
+    c->drawRect(SkRect::MakeWH(100, 100), SkPaint());
+    c->translate(50, 50);
+    c->drawPicture(inner);
+    sk_sp<SkPicture> outer = recorder.finishRecordingAsPicture();
+
+    SkCostAnalysisCanvas canvas(100, 100);
+    canvas.drawPicture(outer);
+    canvas.drawRect(SkRect::MakeWH(5, 5), SkPaint());
+
+    const auto& nodes = canvas.nodes();
+    REPORTER_ASSERT(r, nodes.size() == 2);
+    REPORTER_ASSERT(r, nodes[0].fParent == -1 && nodes[0].fUniqueID == outer->uniqueID());
+    REPORTER_ASSERT(r, nodes[1].fParent == 0 && nodes[1].fUniqueID == inner->uniqueID());
+    REPORTER_ASSERT(r, nodes[0].fOpCount == 3);
+    REPORTER_ASSERT(r, nodes[1].fOpCount == 2);
+    REPORTER_ASSERT(r, nodes[1].fDeviceBounds == SkIRect::MakeLTRB(50, 50, 80, 80));
+    REPORTER_ASSERT(r, nodes[0].fCost > nodes[1].fCost);
+    REPORTER_ASSERT(r, nodes[0].fCost < canvas.totalCost());
+
+    const auto& ops = canvas.ops();
+    REPORTER_ASSERT(r, ops.size() == 4);
+    REPORTER_ASSERT(r, ops[0].fNode == 0);
+    REPORTER_ASSERT(r, ops[1].fNode == 1 && ops[2].fNode == 1);
+    REPORTER_ASSERT(r, ops[3].fNode == -1);
+
+    REPORTER_ASSERT(r, canvas.mostExpensiveNodes(1)[0].fUniqueID == outer->uniqueID());
+    REPORTER_ASSERT(r, canvas.report().contains("drawPicture"));
+}
+
+DEF_TEST(CostAnalysisCanvas_Heatmap, r) {
+    REPORTER_ASSERT(r, SkCostAnalysisCanvas(100, 100).heatmap().empty());
+
+    SkCostAnalysisCanvas canvas(100, 90, 32);
+    canvas.drawRect(SkRect::MakeWH(32, 32), SkPaint());
+    canvas.drawRect(SkRect::MakeWH(32, 32), SkPaint());
+    canvas.drawRect(SkRect::MakeXYWH(64, 64, 32, 16), SkPaint());
+
+    SkBitmap heatmap = canvas.heatmap();
+    REPORTER_ASSERT(r, heatmap.dimensions() == SkISize::Make(4, 3));
+    REPORTER_ASSERT(r, heatmap.colorType() == kGray_8_SkColorType);
+    REPORTER_ASSERT(r, *heatmap.getAddr8(0, 0) == 255);
+    REPORTER_ASSERT(r, *heatmap.getAddr8(2, 2) > 0 && *heatmap.getAddr8(2, 2) < 255);
+    REPORTER_ASSERT(r, *heatmap.getAddr8(1, 1) == 0);
+    REPORTER_ASSERT(r, *heatmap.getAddr8(3, 2) == 0);
+}
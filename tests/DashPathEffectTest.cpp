@@ -145,3 +145,31 @@ DEF_TEST(DashCrazy_crbug_875494, r) {
     skpathutils::FillPathWithPaint(path, paint, &path2, &cull);
 }
 
+
+// Dashed curves are cached by the source path and the dash, and match the uncached result.
+DEF_TEST(DashPathEffect_CachedCurves, r) {
+    const SkScalar intervals[] = {5, 3};
+    sk_sp<SkPathEffect> dash = SkDashPathEffect::Make(intervals, 2, 1);
+    const SkPath circle = SkPath::Circle(50, 50, 40);
+    SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+    rec.setStrokeStyle(2);
+
+    SkPath first, second;
+    REPORTER_ASSERT(r, dash->filterPath(&first, circle, &rec, nullptr));
+    REPORTER_ASSERT(r, dash->filterPath(&second, circle, &rec, nullptr));
+    REPORTER_ASSERT(r, first.getGenerationID() == second.getGenerationID());
+
+    // Volatile paths are never cached.
+    SkPath volatileCircle = circle;
+    volatileCircle.setIsVolatile(true);
+    SkPath uncached;
+    REPORTER_ASSERT(r, dash->filterPath(&uncached, volatileCircle, &rec, nullptr));
+    REPORTER_ASSERT(r, uncached.getGenerationID() != first.getGenerationID());
+    REPORTER_ASSERT(r, uncached == first);
+
+    // A different phase is a different entry.
+    sk_sp<SkPathEffect> shifted = SkDashPathEffect::Make(intervals, 2, 2);
+    SkPath third;
+    REPORTER_ASSERT(r, shifted->filterPath(&third, circle, &rec, nullptr));
+    REPORTER_ASSERT(r, third != first);
+}
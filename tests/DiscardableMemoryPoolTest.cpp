@@ -6,11 +6,15 @@
  */
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 #include "tests/Test.h"
 
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <string>
 
 DEF_TEST(DiscardableMemoryPool, reporter) {
     sk_sp<SkDiscardableMemoryPool> pool(SkDiscardableMemoryPool::Make(1));
@@ -36,3 +40,65 @@ DEF_TEST(DiscardableMemoryPool, reporter) {
     REPORTER_ASSERT(reporter, !dm2->lock());
     REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
 }
+
+DEF_TEST(DiscardableMemoryPool_ChildPools, reporter) {
+    sk_sp<SkDiscardableMemoryPool> pool(SkDiscardableMemoryPool::Make(1000));
+    sk_sp<SkDiscardableMemoryPool> low = pool->makeChildPool("low", 1000, -1);
+    sk_sp<SkDiscardableMemoryPool> high = pool->makeChildPool("high", 300, 1);
+    REPORTER_ASSERT(reporter, low && high);
+    REPORTER_ASSERT(reporter, !low->makeChildPool("nested", 100, 0));
+
+    // A child over its own budget only purges its own memory.
+    std::unique_ptr<SkDiscardableMemory> low1(low->create(400));
+    low1->unlock();
+    std::unique_ptr<SkDiscardableMemory> high1(high->create(200));
+    high1->unlock();
+    std::unique_ptr<SkDiscardableMemory> high2(high->create(200));
+    high2->unlock();
+    REPORTER_ASSERT(reporter, !high1->lock());
+    REPORTER_ASSERT(reporter, low1->lock());
+    low1->unlock();
+    REPORTER_ASSERT(reporter, 400 == low->getRAMUsed());
+    REPORTER_ASSERT(reporter, 200 == high->getRAMUsed());
+    REPORTER_ASSERT(reporter, 600 == pool->getRAMUsed());
+
+    // When the parent is over budget, the lowest priority pool is purged first, and only as much
+    // as needed.
+    std::unique_ptr<SkDiscardableMemory> low2(low->create(200));
+    low2->unlock();
+    std::unique_ptr<SkDiscardableMemory> own(pool->create(300));
+    own->unlock();
+    REPORTER_ASSERT(reporter, !low1->lock());
+    REPORTER_ASSERT(reporter, low2->lock());
+    low2->unlock();
+    REPORTER_ASSERT(reporter, high2->lock());
+    high2->unlock();
+    REPORTER_ASSERT(reporter, own->lock());
+    own->unlock();
+    REPORTER_ASSERT(reporter, 700 == pool->getRAMUsed());
+
+    struct StatsDump : public SkTraceMemoryDump {
+        void dumpNumericValue(const char* dumpName, const char* valueName, const char*,
+                              uint64_t value) override {
+            fValues[std::string(dumpName) + ":" + valueName] = value;
+        }
+        void setMemoryBacking(const char*, const char*, const char*) override {}
+        void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+        LevelOfDetail getRequestedDetails() const override {
+            return SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail;
+        }
+        std::map<std::string, uint64_t> fValues;
+    } dump;
+    pool->dumpMemoryStatistics(&dump);
+    REPORTER_ASSERT(reporter, dump.fValues["skia/discardable_memory_pool:size"] == 300);
+    REPORTER_ASSERT(reporter, dump.fValues["skia/discardable_memory_pool:total_size"] == 700);
+    REPORTER_ASSERT(reporter, dump.fValues["skia/discardable_memory_pool/low:size"] == 200);
+    REPORTER_ASSERT(reporter, dump.fValues["skia/discardable_memory_pool/low:purged_size"] == 400);
+    REPORTER_ASSERT(reporter, dump.fValues["skia/discardable_memory_pool/high:size"] == 200);
+    REPORTER_ASSERT(reporter, dump.fValues["skia/discardable_memory_pool/high:budget_size"] == 300);
+
+    pool->dumpPool();
+    REPORTER_ASSERT(reporter, 0 == pool->getRAMUsed());
+    REPORTER_ASSERT(reporter, 0 == low->getRAMUsed());
+    REPORTER_ASSERT(reporter, 0 == high->getRAMUsed());
+}
@@ -166,6 +166,13 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas,
     REPORTER_ASSERT(reporter, result);
     check(reporter, atlas.get(), 2, 4, 2);
 
+    skgpu::AtlasStats stats = atlas->stats();
+    REPORTER_ASSERT(reporter, stats.fActivePages == 2);
+    REPORTER_ASSERT(reporter, stats.fPlotsInUse == kNumPlots * kNumPlots + 1);
+    REPORTER_ASSERT(reporter, stats.fOccupancy > 0.6f && stats.fOccupancy < 0.7f);
+    REPORTER_ASSERT(reporter, stats.fPagesActivated == 2);
+    REPORTER_ASSERT(reporter, stats.fEvictedPlots == 0);
+
     // Simulate a lot of draws using only the first plot. The last texture should be compacted.
     for (int i = 0; i < 512; ++i) {
         atlas->setLastUseToken(atlasLocators[0], uploadTarget.tokenTracker()->nextDrawToken());
@@ -175,6 +182,11 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas,
     }
 
     check(reporter, atlas.get(), 1, 4, 1);
+
+    stats = atlas->stats();
+    REPORTER_ASSERT(reporter, stats.fActivePages == 1);
+    REPORTER_ASSERT(reporter, stats.fPlotsInUse == kNumPlots * kNumPlots);
+    REPORTER_ASSERT(reporter, stats.fOccupancy == 1.f);
 }
 
 // This test verifies that the AtlasTextOp::onPrepare method correctly handles a failure
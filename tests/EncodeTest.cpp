@@ -15,6 +15,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -28,6 +29,7 @@
 #include "include/encode/SkWebpEncoder.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
@@ -343,6 +345,75 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngExecutor, r) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(700, 500, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType));
+    SkRandom random;
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            *bitmap.getAddr32(x, y) = random.nextULessThan(4) == 0
+                    ? random.nextU()
+                    : SkColorSetARGB(0xFF, (x * 3) & 0xFF, (y * 5) & 0xFF, (x + y) & 0xFF);
+        }
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkAlphaType alphaType : {kUnpremul_SkAlphaType, kOpaque_SkAlphaType}) {
+        SkPixmap src = bitmap.pixmap();
+        src.reset(src.info().makeAlphaType(alphaType), src.addr(), src.rowBytes());
+        for (auto filters : {SkPngEncoder::FilterFlag::kAll, SkPngEncoder::FilterFlag::kZero,
+                             SkPngEncoder::FilterFlag::kPaeth}) {
+            SkPngEncoder::Options options;
+            options.fFilterFlags = filters;
+            SkDynamicMemoryWStream serial, parallel;
+            REPORTER_ASSERT(r, SkPngEncoder::Encode(&serial, src, options));
+            options.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkPngEncoder::Encode(&parallel, src, options));
+
+            SkBitmap bm0, bm1;
+            SkImages::DeferredFromEncodedData(serial.detachAsData())->asLegacyBitmap(&bm0);
+            SkImages::DeferredFromEncodedData(parallel.detachAsData())->asLegacyBitmap(&bm1);
+            REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0));
+        }
+    }
+}
+
+// Encoding strips in parallel changes the Huffman tables, but not the pixels.
+DEF_TEST(Encode_JpegExecutor, r) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(700, 900, kRGBA_8888_SkColorType, kOpaque_SkAlphaType));
+    SkRandom random;
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            *bitmap.getAddr32(x, y) = random.nextULessThan(4) == 0
+                    ? random.nextU() | 0xFF000000
+                    : SkColorSetARGB(0xFF, (x * 3) & 0xFF, (y * 5) & 0xFF, (x + y) & 0xFF);
+        }
+    }
+    SkBitmap gray;
+    gray.allocPixels(bitmap.info().makeColorType(kGray_8_SkColorType));
+    SkAssertResult(bitmap.readPixels(gray.pixmap()));
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const SkBitmap* src : {&bitmap, &gray}) {
+        for (auto downsample : {SkJpegEncoder::Downsample::k420, SkJpegEncoder::Downsample::k422,
+                                SkJpegEncoder::Downsample::k444}) {
+            SkJpegEncoder::Options options;
+            options.fQuality = 90;
+            options.fDownsample = downsample;
+            SkDynamicMemoryWStream serial, parallel;
+            REPORTER_ASSERT(r, SkJpegEncoder::Encode(&serial, src->pixmap(), options));
+            options.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkJpegEncoder::Encode(&parallel, src->pixmap(), options));
+
+            SkBitmap bm0, bm1;
+            SkImages::DeferredFromEncodedData(serial.detachAsData())->asLegacyBitmap(&bm0);
+            SkImages::DeferredFromEncodedData(parallel.detachAsData())->asLegacyBitmap(&bm1);
+            REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0));
+        }
+    }
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
@@ -453,6 +524,79 @@ DEF_TEST(Encode_WebpOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm2, bm3, 50));
 }
 
+// Premultiplied and BGRA pixels are encoded as if they had been converted to unpremultiplied
+// RGBA first.
+DEF_TEST(Encode_WebpPremulAndBGRA, r) {
+    SkBitmap bitmap;
+    if (!ToolUtils::GetResourceAsBitmap("images/google_chrome.ico", &bitmap)) {
+        return;
+    }
+
+    for (auto compression : {SkWebpEncoder::Compression::kLossless,
+                             SkWebpEncoder::Compression::kLossy}) {
+        SkWebpEncoder::Options options;
+        options.fCompression = compression;
+        for (SkColorType colorType : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType}) {
+            for (SkAlphaType alphaType : {kPremul_SkAlphaType, kUnpremul_SkAlphaType}) {
+                SkBitmap src;
+                src.allocPixels(bitmap.info().makeColorType(colorType).makeAlphaType(alphaType));
+                SkAssertResult(bitmap.readPixels(src.pixmap()));
+                SkBitmap unpremul;
+                unpremul.allocPixels(src.info()
+                                             .makeColorType(kRGBA_8888_SkColorType)
+                                             .makeAlphaType(kUnpremul_SkAlphaType));
+                SkAssertResult(src.readPixels(unpremul.pixmap()));
+
+                SkDynamicMemoryWStream dst, expected;
+                REPORTER_ASSERT(r, SkWebpEncoder::Encode(&dst, src.pixmap(), options));
+                REPORTER_ASSERT(r, SkWebpEncoder::Encode(&expected, unpremul.pixmap(), options));
+                REPORTER_ASSERT(r, dst.detachAsData()->equals(expected.detachAsData().get()),
+                                "color type %d alpha type %d", colorType, alphaType);
+            }
+        }
+    }
+}
+
+DEF_TEST(Encode_WebpSpeed, r) {
+    SkBitmap bitmap;
+    if (!ToolUtils::GetResourceAsBitmap("images/mandrill_512.png", &bitmap)) {
+        return;
+    }
+
+    auto encode = [&](SkWebpEncoder::Compression compression, int method, bool multithreaded) {
+        SkWebpEncoder::Options options;
+        options.fCompression = compression;
+        options.fMethod = method;
+        options.fMultithreaded = multithreaded;
+        SkDynamicMemoryWStream stream;
+        return SkWebpEncoder::Encode(&stream, bitmap.pixmap(), options) ? stream.detachAsData()
+                                                                         : nullptr;
+    };
+
+    sk_sp<SkData> lossless = encode(SkWebpEncoder::Compression::kLossless, -1, false);
+    sk_sp<SkData> losslessFast = encode(SkWebpEncoder::Compression::kLosslessFast, -1, true);
+    sk_sp<SkData> losslessSmall = encode(SkWebpEncoder::Compression::kLossless, 6, true);
+    sk_sp<SkData> lossyFast = encode(SkWebpEncoder::Compression::kLossy, 0, false);
+    sk_sp<SkData> lossySmall = encode(SkWebpEncoder::Compression::kLossy, 6, true);
+    REPORTER_ASSERT(r, lossless && losslessFast && losslessSmall && lossyFast && lossySmall);
+    REPORTER_ASSERT(r, !encode(SkWebpEncoder::Compression::kLossy, 7, false));
+    if (!lossless || !losslessFast || !losslessSmall || !lossyFast || !lossySmall) {
+        return;
+    }
+    REPORTER_ASSERT(r, losslessFast->size() >= lossless->size());
+    REPORTER_ASSERT(r, losslessSmall->size() <= lossless->size());
+
+    SkBitmap bm0, bm1, bm2, bm3, bm4;
+    SkImages::DeferredFromEncodedData(lossless)->asLegacyBitmap(&bm0);
+    SkImages::DeferredFromEncodedData(losslessFast)->asLegacyBitmap(&bm1);
+    SkImages::DeferredFromEncodedData(losslessSmall)->asLegacyBitmap(&bm2);
+    SkImages::DeferredFromEncodedData(lossyFast)->asLegacyBitmap(&bm3);
+    SkImages::DeferredFromEncodedData(lossySmall)->asLegacyBitmap(&bm4);
+    REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0));
+    REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
+    REPORTER_ASSERT(r, almost_equals(bm3, bm4, 50));
+}
+
 DEF_TEST(Encode_WebpAnimated, r) {
     const int frameCount = 3;
     const int width = 16;
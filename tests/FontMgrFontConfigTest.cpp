@@ -124,3 +124,48 @@ DEF_TEST(FontMgrFontConfig, reporter) {
         REPORTER_ASSERT(reporter, success);
     }
 }
+
+DEF_TEST(FontMgrFontConfig_SharedFileStream, reporter) {
+    FcConfig* config = build_fontconfig_with_fontfile("/fonts/Distortable.ttf");
+
+    sk_sp<SkFontMgr> fontMgr(SkFontMgr_New_FontConfig(config));
+    sk_sp<SkTypeface> typeface(fontMgr->legacyMakeTypeface("Distortable", SkFontStyle()));
+    if (!typeface) {
+        ERRORF(reporter, "Could not find typeface. FcVersion: %d", FcGetVersion());
+        return;
+    }
+
+    // Streams of the same file share one mapping instead of each reading the file.
+    std::unique_ptr<SkStreamAsset> first = typeface->openStream(nullptr);
+    std::unique_ptr<SkStreamAsset> second = typeface->openStream(nullptr);
+    REPORTER_ASSERT(reporter, first && second);
+    if (!first || !second) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, first->getMemoryBase());
+    REPORTER_ASSERT(reporter, first->getMemoryBase() == second->getMemoryBase());
+    REPORTER_ASSERT(reporter, first->getLength() == second->getLength());
+}
+
+DEF_TEST(FontMgrFontConfig_MatchCharacterCache, reporter) {
+    FcConfig* config = build_fontconfig_with_fontfile("/fonts/Distortable.ttf");
+    sk_sp<SkFontMgr> fontMgr(SkFontMgr_New_FontConfig(config));
+
+    // Characters of the same block resolve to the same cached typeface.
+    sk_sp<SkTypeface> first = fontMgr->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                                                 nullptr, 0, 'a');
+    sk_sp<SkTypeface> second = fontMgr->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                                                  nullptr, 0, 'b');
+    if (!first) {
+        ERRORF(reporter, "Could not find typeface. FcVersion: %d", FcGetVersion());
+        return;
+    }
+    REPORTER_ASSERT(reporter, first == second);
+    REPORTER_ASSERT(reporter, first->unicharToGlyph('b'));
+
+    // A character that no font has stays unmatched when it is looked up again.
+    for (int i = 0; i < 2; ++i) {
+        REPORTER_ASSERT(reporter, !fontMgr->matchFamilyStyleCharacter(nullptr, SkFontStyle(),
+                                                                      nullptr, 0, 0x1F600));
+    }
+}
@@ -96,8 +96,10 @@ static SkColor4f draw_1x1_gainmap(sk_sp<SkImage> baseImage,
     return result;
 }
 
+using MakeGainmapShaderProc = decltype(&SkGainmapShader::Make);
+
 // Verify that the gainmap shader correctly applies the base, gainmap, and destination rectangles.
-DEF_TEST(GainmapShader_rects, r) {
+static void test_gainmap_rects(skiatest::Reporter* r, MakeGainmapShaderProc makeShader) {
     SkColor4f sdrColors[5][2] = {
             {{-1.f, -1.f, -1.f, 1.0f}, {-1.f, -1.f, -1.f, 1.0f}},
             {{1.0f, 1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 0.5f, 1.0f}},
@@ -132,16 +134,16 @@ DEF_TEST(GainmapShader_rects, r) {
     canvasBitmap.eraseColor(SK_ColorTRANSPARENT);
     const auto canvasRect = SkRect::MakeXYWH(1.f, 1.f, 2.f, 4.f);
 
-    sk_sp<SkShader> shader = SkGainmapShader::Make(sdrImage,
-                                                   sdrImageRect,
-                                                   SkSamplingOptions(),
-                                                   gainmapImage,
-                                                   gainmapImageRect,
-                                                   SkSamplingOptions(),
-                                                   gainmapInfo,
-                                                   canvasRect,
-                                                   gainmapInfo.fDisplayRatioHdr,
-                                                   canvasInfo.refColorSpace());
+    sk_sp<SkShader> shader = makeShader(sdrImage,
+                                        sdrImageRect,
+                                        SkSamplingOptions(),
+                                        gainmapImage,
+                                        gainmapImageRect,
+                                        SkSamplingOptions(),
+                                        gainmapInfo,
+                                        canvasRect,
+                                        gainmapInfo.fDisplayRatioHdr,
+                                        canvasInfo.refColorSpace());
     SkPaint paint;
     paint.setShader(shader);
     SkCanvas canvas(canvasBitmap);
@@ -187,6 +189,18 @@ DEF_TEST(GainmapShader_rects, r) {
     }
 }
 
+DEF_TEST(GainmapShader_rects, r) {
+    test_gainmap_rects(r, SkGainmapShader::Make);
+}
+
+// The baked image covers the whole base image, so this also checks that the part of the gainmap
+// that covers it is found from the rectangles. The HDR ratio of 2 is exactly on a bucket.
+DEF_TEST(GainmapShader_bakedRects, r) {
+    test_gainmap_rects(r, SkGainmapShader::MakeBaked);
+    // The second time the baked image comes from the cache.
+    test_gainmap_rects(r, SkGainmapShader::MakeBaked);
+}
+
 DEF_TEST(GainmapShader_baseImageIsHdr, r) {
     SkColor4f hdrColors[4][2] = {
             {{1.0f, 1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 0.5f, 1.0f}},
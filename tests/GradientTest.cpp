@@ -42,9 +42,12 @@
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <string>
+#include <utility>
 
 // #if defined(SK_GRAPHITE)
 // #include "include/gpu/graphite/Context.h"
@@ -616,3 +619,76 @@ DEF_TEST(Gradient, reporter) {
     test_sweep_fuzzer(reporter);
     test_unsorted_degenerate(reporter);
 }
+
+// On 8-bit destinations, gradients with many stops or a special interpolation color space may be
+// drawn from a sampled color ramp. Compare them against the same gradients drawn into F16, which
+// still evaluates every stop per pixel.
+DEF_TEST(Gradient_ramp, reporter) {
+    constexpr int kW = 509;
+    const SkPoint pts[] = {{0, 0}, {kW, 0}};
+
+    SkColor4f manyColors[12];
+    float manyPos[12];
+    for (int i = 0; i < 12; ++i) {
+        manyColors[i] = {(i * 37 % 12) / 11.0f, (i * 5 % 12) / 11.0f, (i % 3) / 2.0f,
+                         i % 4 ? 1.0f : 0.5f};
+        manyPos[i] = (i + (i & 1) * 0.3f) / 11.3f;
+    }
+    manyPos[0] = 0;
+    const SkColor4f fewColors[] = {SkColors::kRed, SkColors::kBlue, {0, 1, 0, 0.5f}};
+
+    using Interpolation = SkGradientShader::Interpolation;
+    Interpolation oklab;
+    oklab.fColorSpace = Interpolation::ColorSpace::kOKLab;
+    Interpolation hsl;
+    hsl.fColorSpace = Interpolation::ColorSpace::kHSL;
+    hsl.fInPremul = Interpolation::InPremul::kYes;
+
+    struct {
+        const SkColor4f* colors;
+        const float*     pos;
+        int              count;
+        Interpolation    interpolation;
+    } tests[] = {
+        {manyColors, nullptr, 12, {}},
+        {manyColors, manyPos, 12, {}},
+        {fewColors,  nullptr,  3, oklab},
+        {fewColors,  nullptr,  3, hsl},
+    };
+
+    for (const auto& test : tests) {
+        for (SkTileMode mode : {SkTileMode::kClamp, SkTileMode::kRepeat, SkTileMode::kMirror}) {
+            SkPaint paint;
+            paint.setShader(SkGradientShader::MakeLinear(pts, test.colors, SkColorSpace::MakeSRGB(),
+                                                         test.pos, test.count, mode,
+                                                         test.interpolation, nullptr));
+            SkBitmap expected, actual;
+            for (auto [bitmap, ct] : {std::make_pair(&expected, kRGBA_F16_SkColorType),
+                                      std::make_pair(&actual, kN32_SkColorType)}) {
+                bitmap->allocPixels(SkImageInfo::Make(kW + 100, 1, ct, kPremul_SkAlphaType,
+                                                      SkColorSpace::MakeSRGB()));
+                bitmap->eraseColor(SK_ColorTRANSPARENT);
+                SkCanvas canvas(*bitmap);
+                canvas.translate(-50, 0);
+                canvas.drawPaint(paint);
+            }
+            SkBitmap expected8888;
+            expected8888.allocPixels(actual.info());
+            SkAssertResult(expected.readPixels(expected8888.pixmap()));
+
+            for (int x = 0; x < actual.width(); ++x) {
+                SkPMColor e = *expected8888.getAddr32(x, 0),
+                          a = *actual.getAddr32(x, 0);
+                int diff = 0;
+                for (int shift : {0, 8, 16, 24}) {
+                    diff = std::max(diff, std::abs((int)(e >> shift & 0xff) -
+                                                   (int)(a >> shift & 0xff)));
+                }
+                if (diff > 2) {
+                    ERRORF(reporter, "pixel %d: expected %08x, got %08x", x, e, a);
+                    break;
+                }
+            }
+        }
+    }
+}
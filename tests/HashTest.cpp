@@ -8,7 +8,9 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkTHash.h"
+#include "src/core/SkTSwissHash.h"
 #include "tests/Test.h"
 
 #include <cstdint>
@@ -231,9 +233,10 @@ DEF_TEST(HashSetCtorOneElem, r) {
     REPORTER_ASSERT(r, !set.contains("three"));
 }
 
-template <typename T>
+template <typename T, template <typename, typename, typename> class Table = THashTable>
 static void test_hash_set(skiatest::Reporter* r) {
-    THashSet<T> set;
+    using Set = THashSet<T, SkGoodHash, Table>;
+    Set set;
 
     set.add(T("Hello"));
     set.add(T("World"));
@@ -245,12 +248,12 @@ static void test_hash_set(skiatest::Reporter* r) {
     REPORTER_ASSERT(r, *set.find(T("Hello")) == T("Hello"));
 
     // Test walking the set with iterators, using preincrement (++iter).
-    for (typename THashSet<T>::Iter iter = set.begin(); iter != set.end(); ++iter) {
+    for (typename Set::Iter iter = set.begin(); iter != set.end(); ++iter) {
         REPORTER_ASSERT(r, *iter == T("Hello") || *iter == T("World"));
     }
 
     // Test walking the set with iterators, using postincrement (iter++).
-    for (typename THashSet<T>::Iter iter = set.begin(); iter != set.end(); iter++) {
+    for (typename Set::Iter iter = set.begin(); iter != set.end(); iter++) {
         REPORTER_ASSERT(r, *iter == T("Hello") || *iter == T("World"));
     }
 
@@ -261,7 +264,7 @@ static void test_hash_set(skiatest::Reporter* r) {
 
     // Ensure that iteration works equally well on a const set.
     const auto& cset = set;
-    for (typename THashSet<T>::Iter iter = cset.begin(); iter != cset.end(); iter++) {
+    for (typename Set::Iter iter = cset.begin(); iter != cset.end(); iter++) {
         REPORTER_ASSERT(r, *iter == T("Hello") || *iter == T("World"));
     }
 
@@ -270,7 +273,7 @@ static void test_hash_set(skiatest::Reporter* r) {
         REPORTER_ASSERT(r, entry == T("Hello") || entry == T("World"));
     }
 
-    THashSet<T> clone = set;
+    Set clone = set;
     REPORTER_ASSERT(r, clone.count() == 2);
     REPORTER_ASSERT(r, clone.contains(T("Hello")));
     REPORTER_ASSERT(r, clone.contains(T("World")));
@@ -489,3 +492,87 @@ DEF_TEST(HashSetSwap, r) {
     a.swap(THashSet<std::string_view>());
     REPORTER_ASSERT(r, a.empty());
 }
+
+DEF_TEST(SwissHashSetWithSkString, r) {
+    test_hash_set<SkString, TSwissHashTable>(r);
+}
+
+DEF_TEST(SwissHashSetWithStdString, r) {
+    test_hash_set<std::string, TSwissHashTable>(r);
+}
+
+template <typename HashK>
+static void test_swiss_matches_thash(skiatest::Reporter* r, int keyRange) {
+    // Mirror random edits into both tables, with few enough keys that many are removed and
+    // added back, leaving tombstones behind.
+    THashMap<int, std::string, HashK> expected;
+    TSwissHashMap<int, std::string, HashK> map;
+    SkRandom rand;
+    for (int i = 0; i < 20000; i++) {
+        const int key = rand.nextULessThan(keyRange);
+        if (rand.nextBool()) {
+            std::string val = std::to_string(i);
+            expected.set(key, val);
+            REPORTER_ASSERT(r, *map.set(key, val) == val);
+        } else {
+            REPORTER_ASSERT(r, map.removeIfExists(key) == expected.removeIfExists(key));
+        }
+        REPORTER_ASSERT(r, map.count() == expected.count());
+    }
+
+    for (int key = 0; key < keyRange; key++) {
+        std::string* want = expected.find(key);
+        std::string* got = map.find(key);
+        REPORTER_ASSERT(r, !want == !got);
+        REPORTER_ASSERT(r, !want || *want == *got);
+    }
+    int visited = 0;
+    for (const auto& [key, val] : map) {
+        REPORTER_ASSERT(r, expected.find(key) && *expected.find(key) == val);
+        visited++;
+    }
+    REPORTER_ASSERT(r, visited == expected.count());
+
+    TSwissHashMap<int, std::string, HashK> copy = map;
+    REPORTER_ASSERT(r, copy.count() == map.count());
+    expected.foreach([&](int key, const std::string& val) {
+        REPORTER_ASSERT(r, copy.find(key) && *copy.find(key) == val);
+    });
+    TSwissHashMap<int, std::string, HashK> moved = std::move(copy);
+    REPORTER_ASSERT(r, moved.count() == map.count());
+    REPORTER_ASSERT(r, copy.empty());
+}
+
+DEF_TEST(SwissHashMatchesTHash, r) {
+    // Every key collides with a quarter of the others, so probing runs through many groups.
+    struct PoorHash {
+        uint32_t operator()(int key) const { return key & 3; }
+    };
+    for (int keyRange : {10, 100, 1000}) {
+        test_swiss_matches_thash<SkGoodHash>(r, keyRange);
+        test_swiss_matches_thash<PoorHash>(r, keyRange);
+    }
+}
+
+DEF_TEST(SwissHashTableGrowsAndShrinks, r) {
+    TSwissHashSet<int> s;
+    REPORTER_ASSERT(r, s.approxBytesUsed() == 0);
+    for (int i = 0; i < 1000; i++) {
+        s.add(i);
+    }
+    // Tables stay at least 1/2 full (but for tombstones) as they grow...
+    REPORTER_ASSERT(r, s.approxBytesUsed() <= 2 * 1000 * 8 / 7 * (sizeof(int) + 1));
+    for (int i = 0; i < 1000; i++) {
+        s.remove(i);
+    }
+    // ... and at least 1/4 full as they shrink.
+    REPORTER_ASSERT(r, s.approxBytesUsed() <= 64 * (sizeof(int) + 1));
+
+    // Adding and removing the same key keeps reusing the same slot.
+    const size_t bytes = s.approxBytesUsed();
+    for (int i = 0; i < 1000; i++) {
+        s.add(7);
+        s.remove(7);
+    }
+    REPORTER_ASSERT(r, s.approxBytesUsed() == bytes);
+}
@@ -5,14 +5,17 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 #include "tests/Test.h"
 
 #include <cstddef>
+#include <atomic>
 #include <cstdint>
 
 namespace {
@@ -154,3 +157,41 @@ DEF_TEST(ImageCache_doubleAdd, r) {
     REPORTER_ASSERT(r, cache.find(key, TestingRec::Visitor, &value));
     REPORTER_ASSERT(r, 2 == value || 3 == value);
 }
+
+DEF_TEST(ImageCache_sharded, reporter) {
+    static const size_t defLimit = DIM * DIM * 4 * COUNT + 1024;    // 1K slop
+    static const int kShardCount = 4;
+
+    {
+        SkResourceCache cache(defLimit, kShardCount);
+        REPORTER_ASSERT(reporter, cache.shardCount() == kShardCount);
+        test_cache(reporter, cache, true);
+    }
+    {
+        SkResourceCache cache(defLimit, kShardCount);
+        test_cache_purge_shared_id(reporter, cache);
+    }
+    {
+        // Many threads adding and finding at once must leave the shards' accounting consistent.
+        SkResourceCache cache(defLimit, kShardCount);
+        auto executor = SkExecutor::MakeFIFOThreadPool(kShardCount);
+        SkTaskGroup(*executor).batch(COUNT * 100, [&](int i) {
+            TestingKey key(i % (COUNT * 10));
+            intptr_t value = -1;
+            if (!cache.find(key, TestingRec::Visitor, &value)) {
+                cache.add(new TestingRec(key, i % (COUNT * 10)));
+            } else {
+                REPORTER_ASSERT(reporter, value == i % (COUNT * 10));
+            }
+        });
+
+        std::atomic<size_t> visitedBytes{0};
+        cache.visitAll([](const SkResourceCache::Rec& rec, void* context) {
+            static_cast<std::atomic<size_t>*>(context)->fetch_add(rec.bytesUsed());
+        }, &visitedBytes);
+        REPORTER_ASSERT(reporter, visitedBytes == cache.getTotalBytesUsed());
+
+        cache.purgeAll();
+        REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() == 0);
+    }
+}
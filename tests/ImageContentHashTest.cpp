@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkImageContentHash.h"
+#include "tests/Test.h"
+#include "tools/SkSharingProc.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+static SkBitmap make_noise(const SkImageInfo& info, size_t rowBytes, uint32_t seed) {
+    SkBitmap bm;
+    bm.allocPixels(info, rowBytes);
+    SkRandom random(seed);
+    for (int y = 0; y < info.height(); ++y) {
+        uint32_t* row = bm.getAddr32(0, y);
+        for (int x = 0; x < info.width(); ++x) {
+            row[x] = random.nextU() | 0xFF000000;
+        }
+    }
+    return bm;
+}
+
+DEF_TEST(ImageContentHash_Pixmap, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(37, 23);
+    SkBitmap a = make_noise(info, info.minRowBytes(), 1);
+    SkBitmap padded = make_noise(info, info.minRowBytes() + 12, 1);
+    const uint64_t hash = SkImageContentHash::Hash(a.pixmap());
+
+    // Row padding doesn't count.
+    REPORTER_ASSERT(r, SkImageContentHash::Hash(padded.pixmap()) == hash);
+
+    // Pixels do.
+    *padded.getAddr32(36, 22) ^= 1;
+    REPORTER_ASSERT(r, SkImageContentHash::Hash(padded.pixmap()) != hash);
+
+    // So does how they're interpreted.
+    SkPixmap unpremul(info.makeAlphaType(kUnpremul_SkAlphaType), a.getPixels(), a.rowBytes());
+    REPORTER_ASSERT(r, SkImageContentHash::Hash(unpremul) != hash);
+    SkPixmap narrower(info.makeWH(info.width() - 1, info.height()), a.getPixels(), a.rowBytes());
+    REPORTER_ASSERT(r, SkImageContentHash::Hash(narrower) != hash);
+}
+
+DEF_TEST(ImageContentHash_Parallel, r) {
+    // Big enough to hash in several bands.
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(1000, 700);
+    SkBitmap bm = make_noise(info, info.minRowBytes() + 4, 2);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(3);
+    REPORTER_ASSERT(r, SkImageContentHash::Hash(bm.pixmap(), executor.get()) ==
+                       SkImageContentHash::Hash(bm.pixmap()));
+}
+
+DEF_TEST(ImageContentHash_Image, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkImage> a = make_noise(info, info.minRowBytes(), 3).asImage();
+    sk_sp<SkImage> b = make_noise(info, info.minRowBytes(), 3).asImage();
+    REPORTER_ASSERT(r, a->uniqueID() != b->uniqueID());
+    REPORTER_ASSERT(r, SkImageContentHash::Hash(a.get()) == SkImageContentHash::Hash(b.get()));
+    REPORTER_ASSERT(r, !SkImageContentHash::Hash(nullptr));
+}
+
+DEF_TEST(SkSharingProc_DedupesContent, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkImage> images[] = {
+        make_noise(info, info.minRowBytes(), 4).asImage(),
+        make_noise(info, info.minRowBytes(), 4).asImage(),  // The same pixels as the first.
+        make_noise(info, info.minRowBytes(), 5).asImage(),
+        make_noise(info, info.minRowBytes(), 5).asImage(),  // The same pixels as the third.
+    };
+
+    SkSharingSerialContext ctx;
+    auto inFileId = [&](SkImage* image) {
+        sk_sp<SkData> data = SkSharingSerialContext::serializeImage(image, &ctx);
+        int fid = -1;
+        if (data && data->size() == sizeof(fid)) {
+            memcpy(&fid, data->data(), sizeof(fid));
+        }
+        return fid;
+    };
+    REPORTER_ASSERT(r, inFileId(images[0].get()) == -1);  // Encoded.
+    REPORTER_ASSERT(r, inFileId(images[1].get()) == 0);
+    REPORTER_ASSERT(r, inFileId(images[2].get()) == -1);  // Encoded.
+    REPORTER_ASSERT(r, inFileId(images[3].get()) == 1);
+    REPORTER_ASSERT(r, inFileId(images[1].get()) == 0);
+    REPORTER_ASSERT(r, ctx.fSerializedImageCount == 2);
+}
@@ -31,6 +31,7 @@
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilterTypes.h"
+#include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/gpu/ganesh/GrColorInfo.h" // IWYU pragma: keep
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
@@ -81,8 +82,7 @@ static void test_find_existing(skiatest::Reporter* reporter,
     SkImageFilterCacheKey key2(0, SkMatrix::I(), clip, subset->uniqueID(), subset->subset());
 
     SkIPoint offset = SkIPoint::Make(3, 4);
-    auto filter = make_filter();
-    cache->set(key1, filter.get(), skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
+    cache->set(key1, skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
 
     skif::FilterResult foundImage;
     REPORTER_ASSERT(reporter, cache->get(key1, &foundImage));
@@ -111,8 +111,7 @@ static void test_dont_find_if_diff_key(skiatest::Reporter* reporter,
     SkImageFilterCacheKey key4(0, SkMatrix::I(), clip1, subset->uniqueID(), subset->subset());
 
     SkIPoint offset = SkIPoint::Make(3, 4);
-    auto filter = make_filter();
-    cache->set(key0, filter.get(), skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
+    cache->set(key0, skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
 
     skif::FilterResult foundImage;
     REPORTER_ASSERT(reporter, !cache->get(key1, &foundImage));
@@ -132,22 +131,19 @@ static void test_internal_purge(skiatest::Reporter* reporter, const sk_sp<SkSpec
     SkImageFilterCacheKey key2(1, SkMatrix::I(), clip, image->uniqueID(), image->subset());
 
     SkIPoint offset = SkIPoint::Make(3, 4);
-    auto filter1 = make_filter();
-    cache->set(key1, filter1.get(), skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
+    cache->set(key1, skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
 
     skif::FilterResult foundImage;
     REPORTER_ASSERT(reporter, cache->get(key1, &foundImage));
 
     // This should knock the first one out of the cache
-    auto filter2 = make_filter();
-    cache->set(key2, filter2.get(),
-               skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
+    cache->set(key2, skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
 
     REPORTER_ASSERT(reporter, cache->get(key2, &foundImage));
     REPORTER_ASSERT(reporter, !cache->get(key1, &foundImage));
 }
 
-// Exercise the purgeByKey and purge methods
+// Exercise the purgeByFilterID and purge methods
 static void test_explicit_purging(skiatest::Reporter* reporter,
                                   const sk_sp<SkSpecialImage>& image,
                                   const sk_sp<SkSpecialImage>& subset) {
@@ -159,19 +155,15 @@ static void test_explicit_purging(skiatest::Reporter* reporter,
     SkImageFilterCacheKey key2(1, SkMatrix::I(), clip, subset->uniqueID(), image->subset());
 
     SkIPoint offset = SkIPoint::Make(3, 4);
-    auto filter1 = make_filter();
-    auto filter2 = make_filter();
-    cache->set(key1, filter1.get(),
-               skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
-    cache->set(key2, filter2.get(),
-               skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
+    cache->set(key1, skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
+    cache->set(key2, skif::FilterResult(image, skif::LayerSpace<SkIPoint>(offset)));
     SkDEBUGCODE(REPORTER_ASSERT(reporter, 2 == cache->count());)
 
     skif::FilterResult foundImage;
     REPORTER_ASSERT(reporter, cache->get(key1, &foundImage));
     REPORTER_ASSERT(reporter, cache->get(key2, &foundImage));
 
-    cache->purgeByImageFilter(filter1.get());
+    cache->purgeByFilterID(key1.fUniqueID);
     SkDEBUGCODE(REPORTER_ASSERT(reporter, 1 == cache->count());)
 
     REPORTER_ASSERT(reporter, !cache->get(key1, &foundImage));
@@ -203,6 +195,82 @@ DEF_TEST(ImageFilterCache_RasterBacked, reporter) {
 }
 
 
+// Separately created filters with the same parameters share a content ID, and so do raster images
+// with the same pixels, so their cached results can be reused by each other.
+DEF_TEST(ImageFilterCache_ContentID, reporter) {
+    sk_sp<SkImageFilter> filter1 = make_filter();
+    sk_sp<SkImageFilter> filter2 = make_filter();
+    REPORTER_ASSERT(reporter, as_IFB(filter1)->uniqueID() != as_IFB(filter2)->uniqueID());
+    REPORTER_ASSERT(reporter, as_IFB(filter1)->contentID() == as_IFB(filter2)->contentID());
+
+    sk_sp<SkImageFilter> blur1 = SkImageFilters::Blur(2, 2, nullptr);
+    sk_sp<SkImageFilter> blur2 = SkImageFilters::Blur(3, 3, nullptr);
+    REPORTER_ASSERT(reporter, as_IFB(blur1)->contentID() != as_IFB(blur2)->contentID());
+    REPORTER_ASSERT(reporter, as_IFB(blur1)->contentID() != as_IFB(filter1)->contentID());
+
+    auto make_layer = [](SkColor color) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::Make(kFullSize, kFullSize, kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType));
+        bm.eraseColor(color);
+        return bm;
+    };
+    const SkIRect full = SkIRect::MakeWH(kFullSize, kFullSize);
+    SkBitmap blue1 = make_layer(SK_ColorBLUE), blue2 = make_layer(SK_ColorBLUE),
+             red = make_layer(SK_ColorRED);
+    sk_sp<SkSpecialImage> blueImg1 = SkSpecialImages::MakeFromRaster(full, blue1, {});
+    sk_sp<SkSpecialImage> blueImg2 = SkSpecialImages::MakeFromRaster(full, blue2, {});
+    sk_sp<SkSpecialImage> redImg = SkSpecialImages::MakeFromRaster(full, red, {});
+    REPORTER_ASSERT(reporter, blueImg1->uniqueID() != blueImg2->uniqueID());
+    REPORTER_ASSERT(reporter, blueImg1->contentID() == blueImg2->contentID());
+    REPORTER_ASSERT(reporter, blueImg1->contentID() != redImg->contentID());
+
+    // Immutable pixels are already identified by their generation ID.
+    blue2.setImmutable();
+    sk_sp<SkSpecialImage> immutableImg = SkSpecialImages::MakeFromRaster(full, blue2, {});
+    REPORTER_ASSERT(reporter, immutableImg->contentID() == immutableImg->uniqueID());
+}
+
+DEF_TEST(ImageFilterCache_Stats, reporter) {
+    SkBitmap srcBM = create_bm();
+    sk_sp<SkSpecialImage> image = SkSpecialImages::MakeFromRaster(
+            SkIRect::MakeWH(kFullSize, kFullSize), srcBM, SkSurfaceProps());
+    const size_t kCacheSize = image->getSize() + 10;
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(kCacheSize));
+
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey key1(0, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    SkImageFilterCacheKey key2(1, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+    SkImageFilterCacheKey key3(2, SkMatrix::I(), clip, image->uniqueID(), image->subset());
+
+    skif::FilterResult foundImage;
+    cache->set(key1, skif::FilterResult(image));
+    REPORTER_ASSERT(reporter, cache->get(key1, &foundImage));
+    REPORTER_ASSERT(reporter, !cache->get(key2, &foundImage));
+
+    // Replaces key1 in the cache.
+    cache->set(key2, skif::FilterResult(image));
+
+    // Larger than the whole cache, so it is rejected instead of evicting key2.
+    SkBitmap largeBM;
+    largeBM.allocN32Pixels(2 * kFullSize, 2 * kFullSize);
+    largeBM.eraseColor(SK_ColorTRANSPARENT);
+    sk_sp<SkSpecialImage> largeImage = SkSpecialImages::MakeFromRaster(
+            SkIRect::MakeWH(2 * kFullSize, 2 * kFullSize), largeBM, SkSurfaceProps());
+    cache->set(key3, skif::FilterResult(largeImage));
+    REPORTER_ASSERT(reporter, !cache->get(key3, &foundImage));
+    REPORTER_ASSERT(reporter, cache->get(key2, &foundImage));
+
+    SkImageFilterCache::Stats stats = cache->stats();
+    REPORTER_ASSERT(reporter, stats.fEntryCount == 1);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed == image->getSize());
+    REPORTER_ASSERT(reporter, stats.fByteLimit == kCacheSize);
+    REPORTER_ASSERT(reporter, stats.fHits == 2);
+    REPORTER_ASSERT(reporter, stats.fMisses == 2);
+    REPORTER_ASSERT(reporter, stats.fEvictions == 1);
+    REPORTER_ASSERT(reporter, stats.fRejections == 1);
+}
+
 // Shared test code for both the raster and gpu-backed image cases
 static void test_image_backed(skiatest::Reporter* reporter,
                               GrRecordingContext* rContext,
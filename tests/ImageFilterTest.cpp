@@ -16,6 +16,7 @@
 #include "include/core/SkData.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
@@ -857,6 +858,53 @@ DEF_TEST(ImageFilterDrawTiled, reporter) {
     }
 }
 
+DEF_TEST(ImageFilterTileByteLimit, reporter) {
+    // Filtering in tiles to stay under SkGraphics' byte limit should exactly match filtering the
+    // whole output at once, for both saveLayer filters and filtered image draws.
+    const int width = 600, height = 600;
+    SkBitmap sourceBitmap;
+    sourceBitmap.allocN32Pixels(width, height);
+    {
+        SkCanvas canvas(sourceBitmap);
+        canvas.clear(SK_ColorTRANSPARENT);
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        canvas.drawCircle(300, 300, 200, paint);
+        paint.setColor(SK_ColorBLUE);
+        canvas.drawRect(SkRect::MakeXYWH(100, 250, 400, 100), paint);
+    }
+    sk_sp<SkImage> sourceImage = sourceBitmap.asImage();
+
+    sk_sp<SkImageFilter> filter = SkImageFilters::Offset(
+            7, -5, SkImageFilters::Blur(6, 4, SkImageFilters::Dilate(2, 3, nullptr)));
+
+    auto draw = [&](size_t byteLimit, bool saveLayer, SkBitmap* result) {
+        size_t prevLimit = SkGraphics::SetImageFilterTileByteLimit(byteLimit);
+        result->allocN32Pixels(width, height);
+        SkCanvas canvas(*result);
+        canvas.clear(SK_ColorTRANSPARENT);
+        SkPaint paint;
+        paint.setImageFilter(filter);
+        if (saveLayer) {
+            canvas.saveLayer(nullptr, &paint);
+            canvas.drawImage(sourceImage, 0, 0);
+            canvas.restore();
+        } else {
+            canvas.drawImage(sourceImage, 0, 0, SkSamplingOptions(), &paint);
+        }
+        SkGraphics::SetImageFilterTileByteLimit(prevLimit);
+    };
+
+    for (bool saveLayer : {false, true}) {
+        SkBitmap untiled, tiled;
+        draw(/*byteLimit=*/0, saveLayer, &untiled);
+        // Small enough to need the smallest tiles.
+        draw(/*byteLimit=*/1, saveLayer, &tiled);
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(untiled, tiled),
+                        "saveLayer: %d", saveLayer);
+    }
+}
+
 static void draw_saveLayer_picture(int width, int height, int tileSize,
                                    SkBBHFactory* factory, SkBitmap* result) {
 
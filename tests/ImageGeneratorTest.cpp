@@ -6,11 +6,13 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
@@ -20,10 +22,12 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
+#include "include/private/base/SkSemaphore.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/image/SkImageGeneratorPriv.h"
 #include "tests/Test.h"
 
+#include <atomic>
 #include <memory>
 
 #if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
@@ -133,3 +137,98 @@ DEF_TEST(PictureImageGenerator, reporter) {
     }
 }
 
+
+namespace {
+
+// Fills the image with a color and counts how often it was asked to, optionally waiting for
+// 'release' to be signaled after signaling 'started'.
+class CountingGenerator : public SkImageGenerator {
+public:
+    CountingGenerator(SkColor color, std::atomic<int>* decodes,
+                      SkSemaphore* started = nullptr, SkSemaphore* release = nullptr)
+            : SkImageGenerator(SkImageInfo::MakeN32Premul(16, 16))
+            , fColor(color)
+            , fDecodes(decodes)
+            , fStarted(started)
+            , fRelease(release) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        if (fStarted) {
+            fStarted->signal();
+            fRelease->wait();
+        }
+        fDecodes->fetch_add(1);
+        SkBitmap bitmap;
+        bitmap.installPixels(info, pixels, rowBytes);
+        bitmap.eraseColor(fColor);
+        return true;
+    }
+
+private:
+    SkColor fColor;
+    std::atomic<int>* fDecodes;
+    SkSemaphore* fStarted;
+    SkSemaphore* fRelease;
+};
+
+}  // namespace
+
+DEF_TEST(ImageGenerator_PrefetchDecodes, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+
+    constexpr int kCount = 8;
+    std::atomic<int> decodes[kCount];
+    sk_sp<SkImage> images[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        decodes[i] = 0;
+        images[i] = SkImages::DeferredFromGenerator(
+                std::make_unique<CountingGenerator>(SkColorSetRGB(0, 0, 30 * i), &decodes[i]));
+    }
+    REPORTER_ASSERT(reporter, SkImages::PrefetchDecodes(executor.get(), images, kCount) == kCount);
+    // Images with a decode scheduled are not scheduled again.
+    REPORTER_ASSERT(reporter, SkImages::PrefetchDecodes(executor.get(), images, kCount) <= kCount);
+
+    // Whether the draws find the decodes done, in progress, or not started, each image is decoded
+    // once, and drawn correctly.
+    SkBitmap dst;
+    dst.allocN32Pixels(16 * kCount, 16);
+    SkCanvas canvas(dst);
+    for (int i = 0; i < kCount; ++i) {
+        canvas.drawImage(images[i], 16 * i, 0);
+    }
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, dst.getColor(16 * i + 8, 8) == SkColorSetRGB(0, 0, 30 * i));
+        REPORTER_ASSERT(reporter, !SkImages::IsDecodePending(images[i].get()));
+    }
+    executor.reset();
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(reporter, decodes[i] == 1, "image %d decoded %d times", i,
+                        decodes[i].load());
+    }
+    // Decoded images are found in the cache and not scheduled again.
+    REPORTER_ASSERT(reporter, SkImages::PrefetchDecodes(nullptr, images, kCount) == 0);
+}
+
+DEF_TEST(ImageGenerator_PrefetchDecodesPending, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+
+    std::atomic<int> decodes{0};
+    SkSemaphore started, release;
+    sk_sp<SkImage> image = SkImages::DeferredFromGenerator(
+            std::make_unique<CountingGenerator>(SK_ColorGREEN, &decodes, &started, &release));
+    REPORTER_ASSERT(reporter, SkImages::PrefetchDecodes(executor.get(), &image, 1) == 1);
+
+    // While the decode runs, a client can draw a placeholder instead of waiting.
+    started.wait();
+    REPORTER_ASSERT(reporter, SkImages::IsDecodePending(image.get()));
+    release.signal();
+
+    SkBitmap dst;
+    dst.allocN32Pixels(16, 16);
+    SkCanvas(dst).drawImage(image, 0, 0);
+    REPORTER_ASSERT(reporter, dst.getColor(8, 8) == SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, !SkImages::IsDecodePending(image.get()));
+    REPORTER_ASSERT(reporter, decodes == 1);
+}
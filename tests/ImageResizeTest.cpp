@@ -0,0 +1,157 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/utils/SkImageResize.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+
+using Filter = SkImageResize::Filter;
+
+static constexpr Filter kFilters[] = {
+    Filter::kBox, Filter::kTriangle, Filter::kMitchell, Filter::kCatmullRom, Filter::kLanczos3,
+};
+
+static SkBitmap make_noise(int w, int h, SkColorType ct = kN32_SkColorType) {
+    SkRandom rand;
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::Make(w, h, ct, kPremul_SkAlphaType, SkColorSpace::MakeSRGB()));
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            bm.erase(rand.nextU() | 0xff000000, SkIRect::MakeXYWH(x, y, 1, 1));
+        }
+    }
+    return bm;
+}
+
+static int max_diff(const SkPixmap& a, const SkPixmap& b, int inset = 0) {
+    int diff = 0;
+    for (int y = inset; y < a.height() - inset; ++y) {
+        for (int x = inset; x < a.width() - inset; ++x) {
+            SkColor ca = a.getColor(x, y),
+                    cb = b.getColor(x, y);
+            for (int shift : {0, 8, 16, 24}) {
+                diff = std::max(diff, std::abs((int)(ca >> shift & 0xff) -
+                                               (int)(cb >> shift & 0xff)));
+            }
+        }
+    }
+    return diff;
+}
+
+DEF_TEST(ImageResize_flat, r) {
+    // Every filter's weights add up to 1, so a solid color stays that color.
+    SkBitmap src;
+    src.allocN32Pixels(37, 23);
+    src.eraseColor(0xff3366cc);
+    for (Filter filter : kFilters) {
+        for (auto [w, h] : {std::make_pair(100, 7), std::make_pair(5, 60), std::make_pair(37, 23)}) {
+            SkBitmap dst;
+            dst.allocN32Pixels(w, h);
+            REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), dst.pixmap(), {filter}));
+            SkBitmap expected;
+            expected.allocN32Pixels(w, h);
+            expected.eraseColor(0xff3366cc);
+            REPORTER_ASSERT(r, max_diff(dst.pixmap(), expected.pixmap()) <= 1);
+        }
+    }
+}
+
+DEF_TEST(ImageResize_identity, r) {
+    // Without scaling, a box filter picks each source pixel exactly.
+    SkBitmap src = make_noise(31, 17);
+    SkBitmap dst;
+    dst.allocPixels(src.info());
+    REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), dst.pixmap(), {Filter::kBox}));
+    REPORTER_ASSERT(r, max_diff(src.pixmap(), dst.pixmap()) == 0);
+}
+
+DEF_TEST(ImageResize_matchesScalePixels, r) {
+    // Enlarging with a triangle filter is bilinear sampling, and shrinking by an integer factor
+    // with a box filter averages blocks of pixels, both of which scalePixels() also does.
+    SkBitmap src = make_noise(40, 30);
+
+    SkBitmap big, bigExpected;
+    big.allocPixels(src.info().makeWH(100, 90));
+    bigExpected.allocPixels(big.info());
+    REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), big.pixmap(), {Filter::kTriangle}));
+    REPORTER_ASSERT(r, src.pixmap().scalePixels(bigExpected.pixmap(),
+                                                SkSamplingOptions(SkFilterMode::kLinear)));
+    REPORTER_ASSERT(r, max_diff(big.pixmap(), bigExpected.pixmap(), 3) <= 1);
+
+    SkBitmap small;
+    small.allocPixels(src.info().makeWH(20, 15));
+    REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), small.pixmap(), {Filter::kBox}));
+    SkBitmap halved;
+    halved.allocPixels(small.info());
+    for (int y = 0; y < 15; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            SkColor4f sum = {0, 0, 0, 0};
+            for (auto [dx, dy] : {std::make_pair(0, 0), std::make_pair(1, 0),
+                                  std::make_pair(0, 1), std::make_pair(1, 1)}) {
+                SkColor4f c = src.getColor4f(2 * x + dx, 2 * y + dy);
+                sum = {sum.fR + c.fR / 4, sum.fG + c.fG / 4, sum.fB + c.fB / 4, sum.fA + c.fA / 4};
+            }
+            halved.erase(sum, SkIRect::MakeXYWH(x, y, 1, 1));
+        }
+    }
+    REPORTER_ASSERT(r, max_diff(small.pixmap(), halved.pixmap()) <= 1);
+}
+
+DEF_TEST(ImageResize_linearLight, r) {
+    // Averaging black and white light gives sRGB 188, rather than the 128 of averaging encodings.
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::MakeN32Premul(2, 1, SkColorSpace::MakeSRGB()));
+    *src.getAddr32(0, 0) = SkPreMultiplyColor(SK_ColorBLACK);
+    *src.getAddr32(1, 0) = SkPreMultiplyColor(SK_ColorWHITE);
+
+    SkBitmap dst;
+    dst.allocPixels(src.info().makeWH(1, 1));
+    SkImageResize::Options options;
+    options.fFilter = Filter::kBox;
+    REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), dst.pixmap(), options));
+    REPORTER_ASSERT(r, std::abs((int)SkColorGetG(dst.getColor(0, 0)) - 128) <= 1);
+
+    options.fLinearLight = true;
+    REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), dst.pixmap(), options));
+    REPORTER_ASSERT(r, std::abs((int)SkColorGetG(dst.getColor(0, 0)) - 188) <= 1);
+}
+
+DEF_TEST(ImageResize_executor, r) {
+    // Filtering bands of rows in parallel gives exactly the same result.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkColorType ct : {kN32_SkColorType, kRGBA_F16_SkColorType}) {
+        SkBitmap src = make_noise(700, 500, ct);
+        for (auto [w, h] : {std::make_pair(300, 200), std::make_pair(1000, 800)}) {
+            SkBitmap serial, parallel;
+            serial.allocPixels(src.info().makeWH(w, h));
+            parallel.allocPixels(serial.info());
+
+            SkImageResize::Options options;
+            options.fFilter = Filter::kLanczos3;
+            REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), serial.pixmap(), options));
+            options.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkImageResize::Resize(src.pixmap(), parallel.pixmap(), options));
+            REPORTER_ASSERT(r, !memcmp(serial.getPixels(), parallel.getPixels(),
+                                       serial.computeByteSize()));
+        }
+    }
+}
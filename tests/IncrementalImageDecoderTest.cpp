@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/GrIncrementalImageDecoder.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/FakeStreams.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+
+struct GrContextOptions;
+
+namespace {
+
+// Returns the first row in [top, bottom) that differs between the bitmaps, or -1.
+int first_different_row(const SkBitmap& a, const SkBitmap& b, int top, int bottom) {
+    for (int y = top; y < bottom; ++y) {
+        if (memcmp(a.getAddr(0, y), b.getAddr(0, y), a.info().minRowBytes())) {
+            return y;
+        }
+    }
+    return -1;
+}
+
+SkBitmap read_back(GrDirectContext* dContext, SkImage* image) {
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(image->dimensions()));
+    if (!image->readPixels(dContext, bitmap.pixmap(), 0, 0)) {
+        return SkBitmap();
+    }
+    return bitmap;
+}
+
+}  // anonymous namespace
+
+// Decodes images as their data arrives, checking the texture after each step, and that an image
+// made at the first step keeps its pixels after later steps change the texture.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrIncrementalImageDecoder_Upload,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNextRelease) {
+    auto dContext = ctxInfo.directContext();
+
+    for (const char* name : {"images/plane.png", "images/plane_interlaced.png"}) {
+        sk_sp<SkData> data = GetResourceAsData(name);
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> truthCodec = SkCodec::MakeFromData(data);
+        if (!truthCodec) {
+            continue;
+        }
+        const SkImageInfo info = SkImageInfo::MakeN32Premul(truthCodec->dimensions());
+        SkBitmap truth;
+        truth.allocPixels(info);
+        REPORTER_ASSERT(reporter, SkCodec::kSuccess == truthCodec->getPixels(truth.pixmap()));
+
+        HaltingStream* stream = new HaltingStream(data, data->size() / 2);
+        std::unique_ptr<GrIncrementalImageDecoder> decoder = GrIncrementalImageDecoder::Make(
+                dContext, SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream)), info);
+        if (!decoder) {
+            ERRORF(reporter, "%s: could not start the decode", name);
+            continue;
+        }
+        REPORTER_ASSERT(reporter, !decoder->makeImage());
+
+        sk_sp<SkImage> firstImage;
+        SkBitmap firstPixels;
+        SkCodec::Result result;
+        while (true) {
+            result = decoder->decode();
+            sk_sp<SkImage> image = decoder->makeImage();
+            REPORTER_ASSERT(reporter, image && image->dimensions() == info.dimensions());
+            if (!image) {
+                break;
+            }
+            SkBitmap pixels = read_back(dContext, image.get());
+            REPORTER_ASSERT(reporter, !pixels.drawsNothing());
+            if (pixels.drawsNothing()) {
+                break;
+            }
+            if (!firstImage) {
+                firstImage = image;
+                firstPixels = pixels;
+            }
+            if (result != SkCodec::kIncompleteInput) {
+                break;
+            }
+
+            // Rows that haven't been decoded are transparent, and for an image that is not
+            // interlaced the decoded rows are final.
+            const int rows = decoder->rowsDecoded();
+            SkBitmap blank;
+            blank.allocPixels(info);
+            blank.eraseColor(SK_ColorTRANSPARENT);
+            REPORTER_ASSERT(reporter, first_different_row(pixels, blank, rows, info.height()) < 0,
+                            "%s: rows below %d are not blank", name, rows);
+            if (!strstr(name, "interlaced")) {
+                const int row = first_different_row(pixels, truth, 0, rows);
+                REPORTER_ASSERT(reporter, row < 0, "%s: row %d differs", name, row);
+            }
+
+            if (stream->isAllDataReceived()) {
+                break;
+            }
+            stream->addNewData(1000);
+        }
+        REPORTER_ASSERT(reporter, result == SkCodec::kSuccess, "%s: %d", name, (int)result);
+        SkBitmap final = read_back(dContext, decoder->makeImage().get());
+        const int row = first_different_row(final, truth, 0, info.height());
+        REPORTER_ASSERT(reporter, row < 0, "%s: row %d differs", name, row);
+
+        SkBitmap firstAgain = read_back(dContext, firstImage.get());
+        REPORTER_ASSERT(reporter,
+                        first_different_row(firstAgain, firstPixels, 0, info.height()) < 0,
+                        "%s: an earlier image changed", name);
+    }
+}
@@ -15,6 +15,7 @@
 #include "tests/Test.h"
 
 #include <cstring>
+#include <string>
 #include <string_view>
 
 using namespace skjson;
@@ -535,3 +536,47 @@ DEF_TEST(JSON_Writable, r) {
     REPORTER_ASSERT(r, root.toString() ==
         SkString(R"({"null":42,"num":"foo","new":true,"newobj":{"newprop":-1}})"));
 }
+
+DEF_TEST(JSON_LongStrings, r) {
+    // Exercise string terminators at every offset, across and away from the end of the input.
+    for (size_t len = 0; len < 48; ++len) {
+        const std::string plain(len, 'x');
+        for (const char* suffix : {"", ", 1", ", \"yyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyy\""}) {
+            const std::string json = "[\"" + plain + "\"" + suffix + "]";
+            const DOM dom(json.c_str(), json.size());
+            REPORTER_ASSERT(r, dom.root().is<ArrayValue>());
+            const ArrayValue& array = dom.root().as<ArrayValue>();
+            REPORTER_ASSERT(r, array.size() == 2u || !*suffix);
+            REPORTER_ASSERT(r, array[0].is<StringValue>());
+            REPORTER_ASSERT(r, array[0].as<StringValue>().str() == plain);
+        }
+
+        for (size_t i = 0; i < len; ++i) {
+            std::string str = plain;
+
+            // Scope terminators are plain string chars.
+            for (char c : {'}', ']'}) {
+                str[i] = c;
+                const std::string json = "{\"k\": \"" + str + "\"}";
+                const DOM dom(json.c_str(), json.size());
+                REPORTER_ASSERT(r, dom.root()["k"].is<StringValue>());
+                REPORTER_ASSERT(r, dom.root()["k"].as<StringValue>().str() == str);
+            }
+
+            // Escapes.
+            const std::string escaped = plain.substr(0, i) + "\\\"" + plain.substr(i);
+            const std::string unescaped = plain.substr(0, i) + "\"" + plain.substr(i);
+            const std::string json = "[\"" + escaped + "\"]";
+            const DOM dom(json.c_str(), json.size());
+            REPORTER_ASSERT(r, dom.root().is<ArrayValue>());
+            const ArrayValue& array = dom.root().as<ArrayValue>();
+            REPORTER_ASSERT(r, array[0].is<StringValue>());
+            REPORTER_ASSERT(r, array[0].as<StringValue>().str() == unescaped);
+
+            // Control chars are invalid.
+            str[i] = '\n';
+            const std::string invalid = "[\"" + str + "\"]";
+            REPORTER_ASSERT(r, DOM(invalid.c_str(), invalid.size()).root().is<NullValue>());
+        }
+    }
+}
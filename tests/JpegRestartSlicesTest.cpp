@@ -0,0 +1,152 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkYUVAPixmaps.h"
+#include "src/codec/SkJpegRestartSlices.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+
+#include <cstring>
+#include <memory>
+
+// A 512x509 4:2:0 JPEG with a restart marker every 12 MCUs, so that only every third MCU row
+// starts a restart interval.
+static constexpr char kRestartImage[] = "images/mandrill_restart_interval.jpg";
+
+DEF_TEST(JpegRestartSlices_Boundaries, r) {
+    sk_sp<SkData> data = GetResourceAsData(kRestartImage);
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkJpegRestartSlices> slices = SkJpegRestartSlices::Make(data->bytes(),
+                                                                            data->size());
+    REPORTER_ASSERT(r, slices);
+    if (!slices) {
+        return;
+    }
+    REPORTER_ASSERT(r, slices->width() == 512 && slices->height() == 509);
+    REPORTER_ASSERT(r, slices->needsVerticalContext());
+    // 32 MCU rows, split every 3 MCU rows.
+    REPORTER_ASSERT(r, slices->boundaryCount() == 12);
+    for (int i = 0; i + 1 < slices->boundaryCount(); ++i) {
+        REPORTER_ASSERT(r, slices->boundaryRow(i) == 48 * i);
+    }
+    REPORTER_ASSERT(r, slices->boundaryRow(slices->boundaryCount() - 1) == 509);
+
+    // A slice is a JPEG of its own rows.
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(slices->makeSlice(2, 5));
+    REPORTER_ASSERT(r, codec && codec->dimensions() == SkISize::Make(512, 144));
+
+    // Truncated images, and images without restart markers, can't be sliced.
+    REPORTER_ASSERT(r, !SkJpegRestartSlices::Make(data->bytes(), data->size() / 2));
+    sk_sp<SkData> other = GetResourceAsData("images/mandrill_512_q075.jpg");
+    REPORTER_ASSERT(r, !other || !SkJpegRestartSlices::Make(other->bytes(), other->size()));
+}
+
+// Decoding in slices on an executor must give exactly the same pixels as decoding the whole image.
+DEF_TEST(JpegRestartSlices_GetPixels, r) {
+    sk_sp<SkData> data = GetResourceAsData(kRestartImage);
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    const SkColorType colorTypes[] = {kN32_SkColorType, kRGB_565_SkColorType,
+                                      kRGBA_F16_SkColorType};
+    for (SkColorType colorType : colorTypes) {
+        for (bool xform : {false, true}) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+            REPORTER_ASSERT(r, codec);
+            if (!codec) {
+                return;
+            }
+            SkImageInfo info = codec->getInfo().makeColorType(colorType);
+            if (xform) {
+                info = info.makeColorSpace(SkColorSpace::MakeSRGB()->makeColorSpin());
+            }
+            SkBitmap serial, sliced;
+            serial.allocPixels(info);
+            sliced.allocPixels(info);
+
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(serial.pixmap()));
+            SkCodec::Options options;
+            options.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(sliced.pixmap(), &options));
+
+            bool same = true;
+            for (int y = 0; y < info.height(); ++y) {
+                same &= !memcmp(serial.getAddr(0, y), sliced.getAddr(0, y), info.minRowBytes());
+            }
+            REPORTER_ASSERT(r, same, "color type %d, xform %d", colorType, xform);
+        }
+    }
+}
+
+DEF_TEST(JpegRestartSlices_GetYUVAPlanes, r) {
+    sk_sp<SkData> data = GetResourceAsData(kRestartImage);
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+    SkYUVAPixmapInfo yuvaPixmapInfo;
+    REPORTER_ASSERT(r, codec->queryYUVAInfo(SkYUVAPixmapInfo::SupportedDataTypes::All(),
+                                            &yuvaPixmapInfo));
+    SkYUVAPixmaps serial = SkYUVAPixmaps::Allocate(yuvaPixmapInfo);
+    SkYUVAPixmaps sliced = SkYUVAPixmaps::Allocate(yuvaPixmapInfo);
+    REPORTER_ASSERT(r, serial.isValid() && sliced.isValid());
+    if (!serial.isValid() || !sliced.isValid()) {
+        return;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkCodec::Options options;
+    options.fExecutor = executor.get();
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getYUVAPlanes(serial));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getYUVAPlanes(sliced, options));
+
+    for (int i = 0; i < serial.numPlanes(); ++i) {
+        const SkPixmap& a = serial.plane(i);
+        const SkPixmap& b = sliced.plane(i);
+        bool same = true;
+        for (int y = 0; y < a.height(); ++y) {
+            same &= !memcmp(a.addr(0, y), b.addr(0, y), a.info().minRowBytes());
+        }
+        REPORTER_ASSERT(r, same, "plane %d", i);
+    }
+}
+
+// A truncated image can't be sliced, and is decoded as far as it goes.
+DEF_TEST(JpegRestartSlices_Incomplete, r) {
+    sk_sp<SkData> data = GetResourceAsData(kRestartImage);
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkCodec> codec =
+            SkCodec::MakeFromData(SkData::MakeSubset(data.get(), 0, data->size() / 2));
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkCodec::Options options;
+    options.fExecutor = executor.get();
+    SkBitmap bitmap;
+    bitmap.allocPixels(codec->getInfo());
+    REPORTER_ASSERT(r, SkCodec::kIncompleteInput == codec->getPixels(bitmap.pixmap(), &options));
+}
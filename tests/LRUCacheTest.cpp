@@ -70,3 +70,23 @@ DEF_TEST(LRUCacheRandom, r) {
     }
     REPORTER_ASSERT(r, 0 == instances);
 }
+
+DEF_TEST(LRUCacheRemoveLRU, r) {
+    int instances = 0;
+    {
+        SkLRUCache<int, std::unique_ptr<Value>> test(10);
+        REPORTER_ASSERT(r, !test.peekLRU());
+        test.removeLRU();
+        for (int i = 0; i < 3; i++) {
+            test.insert(i, std::make_unique<Value>(i, &instances));
+        }
+        // Finding 0 makes 1 the least recently used.
+        test.find(0);
+        REPORTER_ASSERT(r, 1 == (*test.peekLRU())->fValue);
+        test.removeLRU();
+        REPORTER_ASSERT(r, 2 == instances);
+        REPORTER_ASSERT(r, !test.find(1));
+        REPORTER_ASSERT(r, 2 == (*test.peekLRU())->fValue);
+    }
+    REPORTER_ASSERT(r, 0 == instances);
+}
@@ -27,6 +27,9 @@
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
 
+#include <cstdint>
+#include <cstring>
+
 static void make_bitmap(SkBitmap* bm, int width, int height) {
     bm->allocN32Pixels(width, height);
     bm->eraseColor(SK_ColorWHITE);
@@ -235,6 +238,47 @@ DEF_TEST(MipMap_F16, reporter) {
     sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
 }
 
+// Levels built on first use must match the eagerly built ones, whichever level is asked for first.
+DEF_TEST(MipMap_Lazy, reporter) {
+    SkRandom rand;
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kAlpha_8_SkColorType, kRGBA_F16_SkColorType}) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::Make(301, 200, ct, kPremul_SkAlphaType));
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        for (int y = 0; y < bm.height(); ++y) {
+            auto row = static_cast<uint16_t*>(bm.getAddr(0, y));
+            for (size_t i = 0; i < bm.info().minRowBytes() / 2; ++i) {
+                // Keeps F16 pixels finite, between 0.125 and 0.25.
+                row[i] = ct == kRGBA_F16_SkColorType ? 0x3000 + (rand.nextU() & 0x3ff)
+                                                     : rand.nextU() & 0xffff;
+            }
+        }
+
+        sk_sp<SkMipmap> eager(SkMipmap::Build(bm, nullptr));
+        sk_sp<SkMipmap> lazy(SkMipmap::BuildLazy(bm, nullptr));
+        REPORTER_ASSERT(reporter, eager && lazy);
+        if (!eager || !lazy) {
+            return;
+        }
+        REPORTER_ASSERT(reporter, eager->countLevels() == lazy->countLevels());
+
+        // Ask for a small level first, which has to build every level above it.
+        for (int i : {3, 0, 1, 2, 4, 5, 6, 7}) {
+            SkMipmap::Level eagerLevel, lazyLevel;
+            REPORTER_ASSERT(reporter, eager->getLevel(i, &eagerLevel));
+            REPORTER_ASSERT(reporter, lazy->getLevel(i, &lazyLevel));
+            const SkPixmap& e = eagerLevel.fPixmap;
+            const SkPixmap& l = lazyLevel.fPixmap;
+            REPORTER_ASSERT(reporter, e.dimensions() == l.dimensions());
+            for (int y = 0; y < e.height(); ++y) {
+                REPORTER_ASSERT(reporter,
+                                !memcmp(e.addr(0, y), l.addr(0, y), e.info().minRowBytes()),
+                                "color type %d, level %d, row %d", ct, i, y);
+            }
+        }
+    }
+}
+
 static void fill_in_mips(SkMipmapBuilder* builder, sk_sp<SkImage> img) {
     int count = builder->countLevels();
     for (int i = 0; i < count; ++i) {
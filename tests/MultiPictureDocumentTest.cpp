@@ -10,6 +10,7 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkData.h"
 #include "include/core/SkDocument.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImage.h"
@@ -23,6 +24,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSerialProcs.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkSurface.h"
@@ -182,6 +184,94 @@ DEF_TEST(SkMultiPictureDocument_Serialize_and_deserialize, reporter) {
 }
 
 
+static void draw_page(SkCanvas* canvas, int page) {
+    canvas->drawColor(page % 2 ? SK_ColorWHITE : SK_ColorLTGRAY);
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawRect(SkRect::MakeXYWH(10 + page, 20, 5 * page, 30), paint);
+}
+
+static bool page_matches(sk_sp<SkPicture> picture, int page, SkSize size) {
+    if (!picture) {
+        return false;
+    }
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(size.toCeil());
+    auto actual = SkSurfaces::Raster(info);
+    actual->getCanvas()->drawPicture(picture);
+    auto expected = SkSurfaces::Raster(info);
+    draw_page(expected->getCanvas(), page);
+    return ToolUtils::equal_pixels(actual->makeImageSnapshot().get(),
+                                   expected->makeImageSnapshot().get());
+}
+
+DEF_TEST(SkMultiPictureDocument_Reader, reporter) {
+    static constexpr int kPageCount = 7;
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc = SkMultiPictureDocument::Make(&stream);
+    for (int i = 0; i < kPageCount; ++i) {
+        draw_page(doc->beginPage(100 + i, 80), i);
+        doc->endPage();
+    }
+    doc->close();
+    sk_sp<SkData> data = stream.detachAsData();
+
+    auto reader = SkMultiPictureDocument::Reader::Make(data);
+    REPORTER_ASSERT(reporter, reader);
+    REPORTER_ASSERT(reporter, reader->pageCount() == kPageCount);
+    // Out of order, and again.
+    for (int i : {5, 0, 6, 2, 5, 1, 4, 3}) {
+        REPORTER_ASSERT(reporter, reader->pageSize(i) == SkSize::Make(100 + i, 80));
+        REPORTER_ASSERT(reporter, page_matches(reader->readPage(i), i, reader->pageSize(i)),
+                        "Page %d is wrong", i);
+    }
+    REPORTER_ASSERT(reporter, !reader->readPage(kPageCount));
+
+    // The stream API reads the same thing.
+    SkMemoryStream memoryStream(data);
+    REPORTER_ASSERT(reporter, SkMultiPictureDocument::ReadPageCount(&memoryStream) == kPageCount);
+    std::vector<SkDocumentPage> pages(kPageCount);
+    REPORTER_ASSERT(reporter,
+                    SkMultiPictureDocument::Read(&memoryStream, pages.data(), kPageCount));
+    for (int i = 0; i < kPageCount; ++i) {
+        REPORTER_ASSERT(reporter, page_matches(pages[i].fPicture, i, pages[i].fSize));
+    }
+
+    // A truncated file is rejected rather than misread.
+    REPORTER_ASSERT(reporter, !SkMultiPictureDocument::Reader::Make(
+                                      SkData::MakeSubset(data.get(), 0, data->size() - 1)));
+    REPORTER_ASSERT(reporter, !SkMultiPictureDocument::Reader::Make(SkData::MakeEmpty()));
+}
+
+DEF_TEST(SkMultiPictureDocument_ReadVersion2, reporter) {
+    // Written the way documents were before pages were stored separately.
+    static constexpr int kPageCount = 3;
+    SkDynamicMemoryWStream stream;
+    stream.writeText("Skia Multi-Picture Doc\n\n");
+    stream.write32(2);
+    stream.write32(kPageCount);
+    for (int i = 0; i < kPageCount; ++i) {
+        SkSize size = SkSize::Make(60 + i, 50);
+        stream.write(&size, sizeof(size));
+    }
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(60 + kPageCount, 50));
+    for (int i = 0; i < kPageCount; ++i) {
+        draw_page(canvas, i);
+        canvas->drawAnnotation(SkRect::MakeEmpty(), "SkMultiPictureEndPage",
+                               SkData::MakeWithCString("X"));
+    }
+    recorder.finishRecordingAsPicture()->serialize(&stream);
+
+    auto reader = SkMultiPictureDocument::Reader::Make(stream.detachAsData());
+    REPORTER_ASSERT(reporter, reader);
+    REPORTER_ASSERT(reporter, reader->pageCount() == kPageCount);
+    for (int i = kPageCount - 1; i >= 0; --i) {
+        REPORTER_ASSERT(reporter, reader->pageSize(i) == SkSize::Make(60 + i, 50));
+        REPORTER_ASSERT(reporter, page_matches(reader->readPage(i), i, reader->pageSize(i)),
+                        "Page %d is wrong", i);
+    }
+}
+
 #if defined(SK_GANESH) && defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
 
 #include "include/android/AHardwareBufferUtils.h"
@@ -12,6 +12,7 @@
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrBackendSurface.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/private/base/SkTDArray.h"
@@ -49,7 +50,6 @@ class GrDstProxyView;
 class GrRecordingContext;
 class SkArenaAlloc;
 enum class GrXferBarrierFlags;
-struct GrContextOptions;
 
 // We create Ops that write a value into a range of a buffer. We create ranges from
 // kNumOpPositions starting positions x kRanges canonical ranges. We repeat each range kNumRepeats
@@ -199,6 +199,38 @@ private:
 
     using INHERITED = GrOp;
 };
+
+/** An op of another class than TestOp, which never combines with anything. */
+class OtherOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    static GrOp::Owner Make(GrRecordingContext* context, const SkRect& bounds) {
+        return GrOp::Make<OtherOp>(context, bounds);
+    }
+
+    const char* name() const override { return "OtherOp"; }
+
+private:
+    friend class ::GrOp;  // for ctor
+
+    explicit OtherOp(const SkRect& bounds) : INHERITED(ClassID()) {
+        this->setBounds(bounds, HasAABloat::kNo, IsHairline::kNo);
+    }
+
+    void onPrePrepare(GrRecordingContext*,
+                      const GrSurfaceProxyView& writeView,
+                      GrAppliedClip*,
+                      const GrDstProxyView&,
+                      GrXferBarrierFlags renderPassXferBarriers,
+                      GrLoadOp colorLoadOp) override {}
+
+    void onPrepare(GrOpFlushState*) override {}
+
+    void onExecute(GrOpFlushState*, const SkRect& chainBounds) override {}
+
+    using INHERITED = GrOp;
+};
 }  // namespace
 
 /**
@@ -300,3 +332,66 @@ DEF_GANESH_TEST(OpChainTest, reporter, /*ctxInfo*/, CtsEnforcement::kApiLevel_T)
         }
     }
 }
+
+/**
+ * Tests that ops of other classes between two combinable ops don't count against
+ * GrContextOptions::fMaxOpCombineDistance, but do limit how far back the OpsTask looks in total.
+ */
+DEF_GANESH_TEST(OpsTaskCombineDistanceTest, reporter, /*ctxInfo*/, CtsEnforcement::kNextRelease) {
+    static constexpr int kMaxOpCombineDistance = 2;
+    // The OpsTask skips up to four times the distance in chains of other classes of ops.
+    static constexpr int kMaxSkippedOps = 4 * kMaxOpCombineDistance - 1;
+    static constexpr SkISize kDims = {64, 1};
+
+    GrContextOptions options;
+    options.fMaxOpCombineDistance = kMaxOpCombineDistance;
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr, options);
+    SkASSERT(dContext);
+    const GrCaps* caps = dContext->priv().caps();
+    const GrBackendFormat format = caps->getDefaultBackendFormat(GrColorType::kRGBA_8888,
+                                                                 GrRenderable::kYes);
+    auto proxy = dContext->priv().proxyProvider()->createProxy(format,
+                                                               kDims,
+                                                               GrRenderable::kYes,
+                                                               1,
+                                                               skgpu::Mipmapped::kNo,
+                                                               SkBackingFit::kExact,
+                                                               skgpu::Budgeted::kNo,
+                                                               GrProtected::kNo,
+                                                               /*label=*/"OpsTaskCombineDistanceTest",
+                                                               GrInternalSurfaceFlags::kNone);
+    SkASSERT(proxy);
+    skgpu::Swizzle writeSwizzle = caps->getWriteSwizzle(format, GrColorType::kRGBA_8888);
+    GrDrawingManager* drawingMgr = dContext->priv().drawingManager();
+
+    Combinable combinable;
+    std::fill_n(combinable.begin(), kNumCombinableValues, GrOp::CombineResult::kMerged);
+    int result[kDims.width()];
+
+    for (int numSkippedOps : {kMaxSkippedOps, kMaxSkippedOps + 1}) {
+        skgpu::ganesh::OpsTask opsTask(drawingMgr,
+                                       GrSurfaceProxyView(proxy, kTopLeft_GrSurfaceOrigin,
+                                                          writeSwizzle),
+                                       dContext->priv().auditTrail(),
+                                       sk_make_sp<GrArenas>());
+        auto addOp = [&](GrOp::Owner op) {
+            opsTask.addOp(drawingMgr, std::move(op), GrTextureResolveManager(drawingMgr), *caps);
+        };
+        // None of the ops overlap, so only the distance keeps the two TestOps from merging.
+        addOp(TestOp::Make(dContext.get(), 0, {0, 1}, result, &combinable));
+        for (int i = 0; i < numSkippedOps; ++i) {
+            addOp(OtherOp::Make(dContext.get(), SkRect::MakeXYWH(2 + 2 * i, 0, 1, 1)));
+        }
+        addOp(TestOp::Make(dContext.get(), 1, {32, 1}, result, &combinable));
+        opsTask.makeClosed(dContext.get());
+
+        int expectedChains = numSkippedOps <= kMaxSkippedOps ? numSkippedOps + 1
+                                                             : numSkippedOps + 2;
+        REPORTER_ASSERT(reporter, opsTask.numOpChains() == expectedChains,
+                        "skipped %d: expected %d chains, got %d",
+                        numSkippedOps, expectedChains, opsTask.numOpChains());
+
+        opsTask.endFlush(drawingMgr);
+        opsTask.disown(drawingMgr);
+    }
+}
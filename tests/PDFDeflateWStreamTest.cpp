@@ -8,6 +8,8 @@
 #include "include/core/SkTypes.h"
 
 #ifdef SK_SUPPORT_PDF
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkDebug.h"
@@ -21,6 +23,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "zlib.h"
@@ -177,4 +180,34 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+DEF_TEST(SkPDF_DeflateParallel, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom random(654321);
+    // Sizes straddling the 128KB block size, with mostly-compressible content.
+    for (uint32_t size : {0u, 1u, 5000u, 131072u, 131073u, 700000u}) {
+        AutoTMalloc<uint8_t> buffer(size);
+        for (uint32_t j = 0; j < size; ++j) {
+            buffer[j] = random.nextULessThan(8) == 0 ? random.nextU() & 0xff : (j / 64) & 0xff;
+        }
+        sk_sp<SkData> outputs[2];
+        for (int withExecutor = 0; withExecutor < 2; ++withExecutor) {
+            SkDynamicMemoryWStream compressedStream;
+            REPORTER_ASSERT(r, SkDeflateParallel(buffer.get(), size, &compressedStream, -1,
+                                                 withExecutor ? executor.get() : nullptr));
+            outputs[withExecutor] = compressedStream.detachAsData();
+
+            SkMemoryStream compressed(outputs[withExecutor]);
+            std::unique_ptr<SkStreamAsset> decompressed(stream_inflate(r, &compressed));
+            if (!decompressed || decompressed->getLength() != size) {
+                ERRORF(r, "Decompression of %u bytes failed.", size);
+                continue;
+            }
+            sk_sp<SkData> bytes = SkData::MakeFromStream(decompressed.get(), size);
+            REPORTER_ASSERT(r, size == 0 || 0 == memcmp(bytes->data(), buffer.get(), size));
+        }
+        // The output does not depend on how the blocks were scheduled.
+        REPORTER_ASSERT(r, outputs[0]->equals(outputs[1].get()));
+    }
+}
+
 #endif
@@ -13,9 +13,13 @@
 #include "include/core/SkFont.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
 #include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/core/SkTileMode.h"
 #include "include/docs/SkPDFDocument.h"
 #include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
@@ -25,6 +29,7 @@
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <string_view>
 
 static void test_empty(skiatest::Reporter* reporter) {
     SkDynamicMemoryWStream stream;
@@ -251,6 +256,68 @@ DEF_TEST(SkPDF_multiple_pages, r) {
     }
 }
 
+static int count_occurrences(const SkString& haystack, const char* needle) {
+    // Not strstr(), since compressed streams can hold zeros.
+    const std::string_view bytes(haystack.c_str(), haystack.size());
+    int count = 0;
+    for (size_t i = bytes.find(needle); i != std::string_view::npos; i = bytes.find(needle, i + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+// Pages are written as they fill nodes of the page tree; check that the tree still holds every
+// page, whether or not the last node is full.
+DEF_TEST(SkPDF_page_tree, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_page_tree, r);
+    for (int n : {1, 2, 8, 9, 16, 17, 65}) {
+        SkDynamicMemoryWStream wStream;
+        auto doc = SkPDF::MakeDocument(&wStream);
+        for (int i = 0; i < n; ++i) {
+            doc->beginPage(612, 792)->drawColor(SK_ColorRED);
+        }
+        doc->close();
+        sk_sp<SkData> data = wStream.detachAsData();
+        SkString pdf(static_cast<const char*>(data->data()), data->size());
+
+        REPORTER_ASSERT(r, count_occurrences(pdf, "/Type /Page\n") == n, "%d pages", n);
+        SkString rootCount = SkStringPrintf("/Count %d\n", n);
+        REPORTER_ASSERT(r, count_occurrences(pdf, rootCount.c_str()) == 1, "%d pages", n);
+    }
+}
+
+// Layers and image patterns drawn the same way on every page are written once.
+DEF_TEST(SkPDF_dedupe_repeated_content, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_dedupe_repeated_content, r);
+    constexpr int kPages = 5;
+    SkDynamicMemoryWStream wStream;
+    auto doc = SkPDF::MakeDocument(&wStream);
+    for (int i = 0; i < kPages; ++i) {
+        // A fresh SkImage each page, as if each page decoded its own copy of the logo.
+        SkBitmap bm;
+        bm.allocN32Pixels(8, 8);
+        bm.eraseColor(SK_ColorBLUE);
+        *bm.getAddr32(3, 3) = SK_ColorRED;
+        SkPaint tiled;
+        tiled.setShader(bm.asImage()->makeShader(SkTileMode::kRepeat, SkTileMode::kRepeat,
+                                                 SkSamplingOptions()));
+
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        canvas->saveLayerAlphaf(nullptr, 0.5f);
+        canvas->drawRect(SkRect::MakeXYWH(36, 36, 100, 20), SkPaint());
+        canvas->restore();
+        canvas->drawRect(SkRect::MakeXYWH(36, 700, 540, 50), tiled);
+        doc->endPage();
+    }
+    doc->close();
+    sk_sp<SkData> data = wStream.detachAsData();
+    SkString pdf(static_cast<const char*>(data->data()), data->size());
+
+    REPORTER_ASSERT(r, count_occurrences(pdf, "/Type /Page\n") == kPages);
+    REPORTER_ASSERT(r, count_occurrences(pdf, "/Subtype /Form") == 1);
+    REPORTER_ASSERT(r, count_occurrences(pdf, "/PatternType 1") == 1);
+}
+
 // Test to make sure that jobs launched by PDF backend don't cause a segfault
 // after calling abort().
 DEF_TEST(SkPDF_abort_jobs, rep) {
@@ -267,3 +334,37 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+// Font subsetting and page content compression run on the executor when there is one. Make sure
+// the resulting document has the same objects as one made serially.
+DEF_TEST(SkPDF_executor_fonts, rep) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_executor_fonts, rep);
+    sk_sp<SkTypeface> typeface = ToolUtils::CreateTypefaceFromResource("fonts/Roboto-Regular.ttf");
+    if (!typeface) {
+        INFOF(rep, "Could not load fonts/Roboto-Regular.ttf; skipping.");
+        return;
+    }
+    auto makePDF = [&](SkExecutor* executor) {
+        SkPDF::Metadata metadata;
+        metadata.fExecutor = executor;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        SkFont font(typeface, 12);
+        for (int i = 0; i < 10; ++i) {
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            for (int line = 0; line < 40; ++line) {
+                canvas->drawString("The quick brown fox jumps over the lazy dog.",
+                                   36, 36 + 18 * line, font, SkPaint());
+            }
+            doc->endPage();
+        }
+        doc->close();
+        return stream.detachAsData();
+    };
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    sk_sp<SkData> serial = makePDF(nullptr);
+    sk_sp<SkData> parallel = makePDF(executor.get());
+    // Objects may be written in a different order, but they are the same objects.
+    REPORTER_ASSERT(rep, serial->size() == parallel->size());
+    REPORTER_ASSERT(rep, contains(parallel->bytes(), parallel->size(), "/FontFile2"));
+}
@@ -274,6 +274,29 @@ DEF_TEST(pathbuilder_genid, r) {
     REPORTER_ASSERT(r, p1.getGenerationID() != p2.getGenerationID());
 }
 
+DEF_TEST(pathbuilder_detach_trims, r) {
+    // The builder's arrays grow geometrically, but the detached path shouldn't keep the slack.
+    constexpr int N = 1000;
+    SkPathBuilder builder;
+    builder.moveTo(0, 0);
+    for (int i = 1; i < N; ++i) {
+        builder.lineTo(i, i % 7);
+    }
+    SkPath path = builder.detach();
+    REPORTER_ASSERT(r, path.countPoints() == N);
+
+    const size_t tightBytes = N * (sizeof(SkPoint) + sizeof(uint8_t));
+    const size_t bytesUsed = path.approximateBytesUsed();
+    REPORTER_ASSERT(r, bytesUsed <= sizeof(SkPath) + 256 + tightBytes + tightBytes / 8,
+                    "%zu bytes for %zu bytes of points and verbs", bytesUsed, tightBytes);
+
+    // Shrinking a tight path that is shared doesn't copy it.
+    SkPath tight = SkPath::Polygon({{0, 0}, {10, 0}, {10, 10}, {0, 10}, {5, 5}}, true);
+    SkPath copy = tight;
+    SkPathPriv::ShrinkToFit(&copy);
+    REPORTER_ASSERT(r, copy.getGenerationID() == tight.getGenerationID());
+}
+
 DEF_TEST(pathbuilder_addPolygon, reporter) {
     SkPoint pts[] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}};
 
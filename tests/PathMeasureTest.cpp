@@ -12,6 +12,8 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "src/core/SkContourMeasureCache.h"
 #include "src/core/SkPathMeasurePriv.h"
 #include "src/core/SkPathPriv.h"
 #include "tests/Test.h"
@@ -356,3 +358,58 @@ DEF_TEST(contour_measure, reporter) {
 
     test_shrink(reporter);
 }
+
+// The chord lengths of a curve are computed in batches, including the ones padded past the end of
+// a batch and the ones whose squared length overflows a float.
+DEF_TEST(ContourMeasure_CurveChords, reporter) {
+    for (SkScalar scale : {1.f, 1e20f}) {
+        SkPath path;
+        path.moveTo(0, 0);
+        path.cubicTo(0, 100 * scale, 100 * scale, 100 * scale, 100 * scale, 0);
+        path.quadTo(150 * scale, -100 * scale, 200 * scale, 0);
+        path.conicTo(250 * scale, 100 * scale, 300 * scale, 0, 0.5f);
+
+        SkContourMeasureIter iter(path, false);
+        sk_sp<SkContourMeasure> cm = iter.next();
+        REPORTER_ASSERT(reporter, cm);
+        REPORTER_ASSERT(reporter, SkIsFinite(cm->length()));
+
+        // Each curve is longer than its chord and shorter than its control polygon. The cubic's
+        // polygon is 300 long, and the quad's and conic's are each 2 * sqrt(50^2 + 100^2).
+        REPORTER_ASSERT(reporter, cm->length() > 300 * scale);
+        REPORTER_ASSERT(reporter, cm->length() < (300 + 4 * SkScalarSqrt(12500)) * scale);
+
+        // The length is a whole number of segments, so the end of the contour can be reached.
+        SkPoint pos;
+        REPORTER_ASSERT(reporter, cm->getPosTan(cm->length(), &pos, nullptr));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(pos.fX, 300 * scale, scale * 1e-3f));
+    }
+}
+
+DEF_TEST(ContourMeasure_Cache, reporter) {
+    SkPath path;
+    path.addCircle(0, 0, 100);
+    path.addCircle(0, 0, 10);
+
+    sk_sp<const SkMeasuredPath> measured = SkMeasuredPath::Make(path, false);
+    REPORTER_ASSERT(reporter, measured->count() == 2);
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(measured->length(), 220 * SK_ScalarPI, 2.f));
+
+    // The same path, or a copy of it, shares the measured contours.
+    SkPath copy = path;
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(copy, false) == measured);
+    // Other measuring parameters do not.
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(path, true) != measured);
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(path, false, 2) != measured);
+
+    // Once the path changes, its contours are measured again.
+    path.lineTo(1000, 0);
+    sk_sp<const SkMeasuredPath> changed = SkMeasuredPath::Make(path, false);
+    REPORTER_ASSERT(reporter, changed != measured);
+    REPORTER_ASSERT(reporter, changed->count() == 3);
+
+    // Volatile paths are never cached.
+    path.setIsVolatile(true);
+    REPORTER_ASSERT(reporter, SkMeasuredPath::Make(path, false) !=
+                              SkMeasuredPath::Make(path, false));
+}
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkRect.h"
@@ -364,3 +365,51 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+DEF_TEST(SkOpBuilderExecutor, reporter) {
+    // Clusters of overlapping circles and self-intersecting quads, spread over a grid so that
+    // the clusters don't overlap each other.
+    SkOpBuilder serial, parallel;
+    uint32_t seed = 1;
+    auto next = [&seed](int range) {
+        seed = seed * 1664525 + 1013904223;
+        return (float)((seed >> 8) % range);
+    };
+    for (int cluster = 0; cluster < 12; ++cluster) {
+        const float cx = 50 + (cluster % 4) * 200;
+        const float cy = 50 + (cluster / 4) * 200;
+        for (int index = 0; index < 9; ++index) {
+            const float x = cx + next(100), y = cy + next(100);
+            SkPath path;
+            if (index % 3 == 0) {
+                path.addCircle(x, y, 10 + next(30),
+                               (index & 1) ? SkPathDirection::kCW : SkPathDirection::kCCW);
+            } else {
+                path.moveTo(x, y);
+                path.lineTo(x + 40, y + 5);
+                path.lineTo(x + 10, y + 35);
+                path.lineTo(x + 30, y - 20);
+                path.close();
+            }
+            serial.add(path, kUnion_SkPathOp);
+            parallel.add(path, kUnion_SkPathOp);
+        }
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkPath serialResult, parallelResult;
+    REPORTER_ASSERT(reporter, serial.resolve(&serialResult));
+    REPORTER_ASSERT(reporter, parallel.resolve(&parallelResult, executor.get()));
+    int pixelDiff = comparePaths(reporter, __FUNCTION__, serialResult, parallelResult);
+    REPORTER_ASSERT(reporter, pixelDiff == 0);
+
+    // Other operators are resolved in order, as by resolve().
+    SkPath circle1, circle2, expected, result;
+    circle1.addCircle(5, 6, 4);
+    circle2.addCircle(7, 4, 8);
+    Op(circle2, circle1, kDifference_SkPathOp, &expected);
+    parallel.add(circle2, kUnion_SkPathOp);
+    parallel.add(circle1, kDifference_SkPathOp);
+    REPORTER_ASSERT(reporter, parallel.resolve(&result, executor.get()));
+    REPORTER_ASSERT(reporter, comparePaths(reporter, __FUNCTION__, expected, result) == 0);
+}
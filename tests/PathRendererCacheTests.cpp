@@ -19,6 +19,7 @@
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrRecordingContext.h"
 #include "include/gpu/GrTypes.h"
+#include "include/gpu/mock/GrMockTypes.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkPathPriv.h"
 #include "src/gpu/SkBackingFit.h"
@@ -27,12 +28,14 @@
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrResourceCache.h"
 #include "src/gpu/ganesh/GrStyle.h"
+#include "src/gpu/ganesh/GrThreadSafeCache.h"
 #include "src/gpu/ganesh/GrUserStencilSettings.h"
 #include "src/gpu/ganesh/PathRenderer.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/effects/GrPorterDuffXferProcessor.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
 #include "src/gpu/ganesh/ops/SoftwarePathRenderer.h"
+#include "src/gpu/ganesh/ops/TessellationPathRenderer.h"
 #include "src/gpu/ganesh/ops/TriangulatingPathRenderer.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
@@ -214,3 +217,77 @@ DEF_GANESH_TEST(SoftwarePathRendererCacheTest,
     test_path(reporter, create_concave_path, createPR, kExpectedResources, true,
               GrAAType::kCoverage, std::move(style));
 }
+
+// Test that the tessellation path renderer reuses the patches of a stroke across matrices of a
+// similar scale, and that deleting the original path invalidates them.
+DEF_GANESH_TEST(TessellationPathRendererStrokeCacheTest,
+                reporter,
+                /* options */,
+                CtsEnforcement::kNever) {
+    GrMockOptions mockOptions;
+    mockOptions.fDrawInstancedSupport = true;
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(&mockOptions);
+    if (!dContext ||
+        !skgpu::ganesh::TessellationPathRenderer::IsSupported(*dContext->priv().caps())) {
+        return;
+    }
+    auto sdc = skgpu::ganesh::SurfaceDrawContext::Make(dContext.get(),
+                                                       GrColorType::kRGBA_8888,
+                                                       nullptr,
+                                                       SkBackingFit::kApprox,
+                                                       {800, 800},
+                                                       SkSurfaceProps(),
+                                                       /*label=*/{},
+                                                       /* sampleCnt= */ 1,
+                                                       skgpu::Mipmapped::kNo,
+                                                       GrProtected::kNo,
+                                                       kTopLeft_GrSurfaceOrigin);
+    if (!sdc) {
+        return;
+    }
+
+    GrThreadSafeCache* threadSafeCache = dContext->priv().threadSafeCache();
+    const int initialEntries = threadSafeCache->numEntries();
+    skgpu::ganesh::TessellationPathRenderer pathRenderer;
+    SkPaint paint;
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(4);
+    const GrStyle style(paint);
+    SkPath path = create_concave_path();
+    path.cubicTo(150, 300, 50, 300, 100, 0);
+
+    auto draw = [&](const SkMatrix& matrix) {
+        GrPaint grPaint;
+        grPaint.setXPFactory(GrPorterDuffXPFactory::Get(SkBlendMode::kSrc));
+        SkIRect clipConservativeBounds = SkIRect::MakeWH(sdc->width(), sdc->height());
+        GrStyledShape shape(path, style);
+        skgpu::ganesh::PathRenderer::DrawPathArgs args{dContext.get(),
+                                                       std::move(grPaint),
+                                                       &GrUserStencilSettings::kUnused,
+                                                       sdc.get(),
+                                                       nullptr,
+                                                       &clipConservativeBounds,
+                                                       &matrix,
+                                                       &shape,
+                                                       GrAAType::kNone,
+                                                       false};
+        pathRenderer.drawPath(args);
+        dContext->flushAndSubmit();
+    };
+
+    // Translations, rotations, and zooming out a little all reuse the first tessellation.
+    draw(SkMatrix::I());
+    draw(SkMatrix::Translate(30, 40));
+    draw(SkMatrix::RotateDeg(30, {100, 100}).postScale(0.9f, 0.9f));
+    draw(SkMatrix::Scale(0.75f, 0.75f));
+    REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == initialEntries + 1);
+
+    // Zooming in needs more segments.
+    draw(SkMatrix::Scale(3, 3));
+    REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == initialEntries + 2);
+
+    // Resetting the path changes its genID, which invalidates both entries.
+    path.reset();
+    dContext->priv().getResourceCache()->purgeAsNeeded();
+    REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == initialEntries);
+}
@@ -101,14 +101,17 @@ DEF_TEST(PictureNegativeSpace, r) {
     SkPictureRecorder recorder;
 
     SkRect cull = {-200,-200,+200,+200};
+    // Antialiased, so that SkRecordOptimize doesn't cull the first rect under the second.
+    SkPaint paint;
+    paint.setAntiAlias(true);
 
     {
         sk_sp<SkBBoxHierarchy> bbh = factory();
         auto canvas = recorder.beginRecording(cull, bbh);
             canvas->save();
             canvas->clipRect(cull);
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
+            canvas->drawRect({-20,-20,-10,-10}, paint);
+            canvas->drawRect({-20,-20,-10,-10}, paint);
             canvas->restore();
         auto pic = recorder.finishRecordingAsPicture();
         REPORTER_ASSERT(r, pic->approximateOpCount() == 5);
@@ -118,8 +121,8 @@ DEF_TEST(PictureNegativeSpace, r) {
     {
         auto canvas = recorder.beginRecording(cull, &factory);
             canvas->clipRect(cull);
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
-            canvas->drawRect({-20,-20,-10,-10}, SkPaint{});
+            canvas->drawRect({-20,-20,-10,-10}, paint);
+            canvas->drawRect({-20,-20,-10,-10}, paint);
         auto pic = recorder.finishRecordingAsPicture();
         REPORTER_ASSERT(r, pic->approximateOpCount() == 3);
         REPORTER_ASSERT(r, pic->cullRect() == (SkRect{-20,-20,-10,-10}));
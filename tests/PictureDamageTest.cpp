@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/utils/SkPictureDamage.h"
+#include "tests/Test.h"
+#include "tools/ToolUtils.h"
+
+#include <array>
+
+namespace {
+
+// A grid of widgets, each a background, a gauge and a layer with a label-ish path.
+struct Dashboard {
+    std::array<float, 6> fValues = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f};
+    int                  fHighlighted = -1;
+};
+
+SkRect widget_rect(int i) {
+    return SkRect::MakeXYWH(10 + (i % 3) * 100, 10 + (i / 3) * 100, 90, 90);
+}
+
+sk_sp<SkPicture> record(const Dashboard& dashboard, SkBBHFactory* bbh = nullptr) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(310, 210), bbh);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < (int)dashboard.fValues.size(); ++i) {
+        const SkRect rect = widget_rect(i);
+        canvas->save();
+        canvas->translate(rect.left(), rect.top());
+
+        paint.setColor(i == dashboard.fHighlighted ? SK_ColorYELLOW : SK_ColorLTGRAY);
+        canvas->drawRoundRect(SkRect::MakeWH(90, 90), 8, 8, paint);
+
+        paint.setColor(SK_ColorBLUE);
+        canvas->drawRect(SkRect::MakeXYWH(10, 60, 70 * dashboard.fValues[i], 20), paint);
+
+        SkPaint layerPaint;
+        layerPaint.setAlphaf(0.5f);
+        canvas->saveLayer(nullptr, &layerPaint);
+        paint.setColor(SK_ColorBLACK);
+        canvas->drawPath(SkPath::Circle(45, 30, 5 + 20 * dashboard.fValues[i]), paint);
+        canvas->restore();
+
+        canvas->restore();
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
+void draw(SkBitmap* bitmap, const SkPicture* picture, const SkMatrix* matrix) {
+    SkCanvas canvas(*bitmap);
+    canvas.drawColor(SK_ColorWHITE, SkBlendMode::kSrc);
+    canvas.drawPicture(picture, matrix, nullptr);
+}
+
+}  // namespace
+
+DEF_TEST(PictureDamage_Compute, r) {
+    Dashboard dashboard;
+    sk_sp<SkPicture> before = record(dashboard);
+
+    // Identical content recorded again is not damaged at all.
+    REPORTER_ASSERT(r, SkPictureDamage::Compute(before.get(), record(dashboard).get()).isEmpty());
+
+    // Changing one widget only damages that widget.
+    dashboard.fValues[4] = 0.9f;
+    SkRegion damage = SkPictureDamage::Compute(before.get(), record(dashboard).get());
+    REPORTER_ASSERT(r, !damage.isEmpty());
+    REPORTER_ASSERT(r, widget_rect(4).roundOut().contains(damage.getBounds()));
+    dashboard.fValues[4] = 0.5f;
+
+    // Changing a widget's background damages exactly its bounds.
+    dashboard.fHighlighted = 1;
+    damage = SkPictureDamage::Compute(before.get(), record(dashboard).get());
+    REPORTER_ASSERT(r, damage.getBounds() == widget_rect(1).roundOut());
+
+    // A missing picture damages everything the other one draws.
+    damage = SkPictureDamage::Compute(nullptr, before.get());
+    REPORTER_ASSERT(r, damage.getBounds() == SkIRect::MakeLTRB(10, 10, 300, 200));
+    REPORTER_ASSERT(r, SkPictureDamage::Compute(nullptr, nullptr).isEmpty());
+
+    // Pictures that can't be compared op by op damage their whole cull rect.
+    SkDeserialProcs procs;
+    procs.fLazyPicturePlayback = true;
+    sk_sp<SkPicture> lazy = SkPicture::MakeFromData(before->serialize().get(), &procs);
+    REPORTER_ASSERT(r, lazy);
+    damage = SkPictureDamage::Compute(before.get(), lazy.get());
+    REPORTER_ASSERT(r, damage.getBounds() == lazy->cullRect().roundOut());
+}
+
+DEF_TEST(PictureDamage_Redraw, r) {
+    SkRTreeFactory factory;
+    for (SkBBHFactory* bbh : {(SkBBHFactory*)nullptr, (SkBBHFactory*)&factory}) {
+        for (SkMatrix matrix : {SkMatrix::I(), SkMatrix::Scale(1.5f, 1.5f)}) {
+            SkBitmap retained, expected;
+            retained.allocN32Pixels(480, 320);
+            expected.allocN32Pixels(480, 320);
+
+            Dashboard dashboard;
+            sk_sp<SkPicture> previous = record(dashboard, bbh);
+            draw(&retained, previous.get(), &matrix);
+
+            for (int frame = 0; frame < 6; ++frame) {
+                dashboard.fValues[frame] = 1 - dashboard.fValues[frame];
+                dashboard.fHighlighted = (frame * 4) % 6;
+                sk_sp<SkPicture> next = record(dashboard, bbh);
+
+                SkRegion damage = SkPictureDamage::Compute(previous.get(), next.get());
+                SkCanvas canvas(retained);
+                SkPictureDamage::Redraw(&canvas, next.get(), damage, &matrix, SkColors::kWhite);
+
+                draw(&expected, next.get(), &matrix);
+                REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, retained), "frame %d", frame);
+                previous = next;
+            }
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkDrawable.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
@@ -25,6 +26,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
@@ -37,6 +39,7 @@
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -896,11 +899,14 @@ DEF_TEST(Picture_nested_op_count, r) {
     auto make_pic = [](int n, const sk_sp<SkPicture>& pic) {
         SkPictureRecorder rec;
         SkCanvas* c = rec.beginRecording({0,0, 100,100});
+        // Antialiased, so that SkRecordOptimize doesn't cull the rects under each other.
+        SkPaint paint;
+        paint.setAntiAlias(true);
         for (int i = 0; i < n; i++) {
             if (pic) {
                 c->drawPicture(pic);
             } else {
-                c->drawRect({0,0, 100,100}, SkPaint{});
+                c->drawRect({0,0, 100,100}, paint);
             }
         }
         return rec.finishRecordingAsPicture();
@@ -924,3 +930,91 @@ DEF_TEST(Picture_nested_op_count, r) {
     check(make_pic(10, leaf1),  10,  10);
     check(make_pic(10, leaf10), 10, 100);
 }
+
+DEF_TEST(Picture_LazyPlayback, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording({0, 0, 64, 64});
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawRect({4, 4, 30, 30}, paint);
+    canvas->save();
+    canvas->translate(20, 20);
+    paint.setColor(SK_ColorRED);
+    canvas->drawPath(SkPath::Circle(16, 16, 12), paint);
+    canvas->restore();
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    sk_sp<SkData> data = picture->serialize();
+
+    SkDeserialProcs procs;
+    procs.fLazyPicturePlayback = true;
+    sk_sp<SkPicture> lazy = SkPicture::MakeFromData(data.get(), &procs);
+    REPORTER_ASSERT(r, lazy);
+    if (!lazy) {
+        return;
+    }
+    REPORTER_ASSERT(r, !SkPicturePriv::AsSkBigPicture(lazy));
+    REPORTER_ASSERT(r, lazy->cullRect() == picture->cullRect());
+    REPORTER_ASSERT(r, lazy->approximateOpCount() >= picture->approximateOpCount());
+
+    auto draw = [](const SkPicture& pic) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(64, 64);
+        bitmap.eraseColor(SK_ColorWHITE);
+        SkCanvas(bitmap).drawPicture(&pic);
+        return bitmap;
+    };
+    SkBitmap expected = draw(*picture);
+    SkBitmap actual = draw(*lazy);
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+
+    // A lazy picture serializes like any other picture.
+    sk_sp<SkPicture> roundTrip = SkPicture::MakeFromData(lazy->serialize().get());
+    REPORTER_ASSERT(r, roundTrip && SkPicturePriv::AsSkBigPicture(roundTrip));
+}
+
+DEF_TEST(Picture_ReuseRecordStorage, r) {
+    SkPictureRecorder recorder;
+    recorder.setReuseRecordStorage(true);
+
+    auto record_frame = [&](int rects) {
+        SkCanvas* canvas = recorder.beginRecording({0, 0, 100, 100});
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < rects; ++i) {
+            paint.setColor(i % 2 ? SK_ColorRED : SK_ColorBLUE);
+            canvas->drawRect(SkRect::MakeXYWH(i, i, 10, 10), paint);
+        }
+        return recorder.finishRecordingAsPicture();
+    };
+    auto record_of = [](const sk_sp<SkPicture>& pic) {
+        const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(pic);
+        return big ? big->record() : nullptr;
+    };
+
+    sk_sp<SkPicture> first = record_frame(20);
+    const SkRecord* firstRecord = record_of(first);
+    REPORTER_ASSERT(r, firstRecord && first->approximateOpCount() == 20);
+
+    // The first picture is still alive, so its storage can't be reused yet.
+    sk_sp<SkPicture> second = record_frame(10);
+    REPORTER_ASSERT(r, record_of(second) && record_of(second) != firstRecord);
+    REPORTER_ASSERT(r, first->approximateOpCount() == 20);
+    REPORTER_ASSERT(r, second->approximateOpCount() == 10);
+
+    // Once it's gone, the next recording picks its storage back up.
+    const SkRecord* secondRecord = record_of(second);
+    second = nullptr;
+    sk_sp<SkPicture> third = record_frame(5);
+    REPORTER_ASSERT(r, record_of(third) == secondRecord);
+    REPORTER_ASSERT(r, third->approximateOpCount() == 5);
+
+    // Drawables hand their storage back the same way.
+    third = nullptr;
+    recorder.beginRecording({0, 0, 100, 100})->drawColor(SK_ColorGREEN);
+    sk_sp<SkDrawable> drawable = recorder.finishRecordingAsDrawable();
+    drawable = nullptr;
+    sk_sp<SkPicture> fourth = record_frame(3);
+    REPORTER_ASSERT(r, record_of(fourth) == secondRecord);
+    REPORTER_ASSERT(r, fourth->approximateOpCount() == 3);
+}
@@ -9,6 +9,7 @@
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkDynamicRTree.h"
 #include "src/core/SkRTree.h"
 #include "tests/Test.h"
 
@@ -53,7 +54,7 @@ static bool verify_query(SkRect query, SkRect rects[], const std::vector<int>& f
 }
 
 static void run_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rects[],
-                        const SkRTree& tree) {
+                        const SkBBoxHierarchy& tree) {
     for (size_t i = 0; i < NUM_QUERIES; ++i) {
         std::vector<int> hits;
         SkRect query = random_rect(rand);
@@ -79,21 +80,61 @@ DEF_TEST(RTree, reporter) {
         ++expectedDepthMax;
     }
 
+    SkRandom rand;
+    AutoTArray<SkRect> rects(NUM_RECTS);
+    for (auto bulkLoad : {SkRTreeFactory::BulkLoad::kInsertionOrder,
+                          SkRTreeFactory::BulkLoad::kHilbert}) {
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            SkRTree rtree(bulkLoad);
+            REPORTER_ASSERT(reporter, 0 == rtree.getCount());
+
+            for (int j = 0; j < NUM_RECTS; j++) {
+                rects[j] = random_rect(rand);
+            }
+
+            rtree.insert(rects.data(), NUM_RECTS);
+
+            run_queries(reporter, rand, rects.data(), rtree);
+            REPORTER_ASSERT(reporter, NUM_RECTS == rtree.getCount());
+            REPORTER_ASSERT(reporter, expectedDepthMin <= rtree.getDepth() &&
+                                      expectedDepthMax >= rtree.getDepth());
+        }
+    }
+}
+
+DEF_TEST(DynamicRTree, reporter) {
     SkRandom rand;
     AutoTArray<SkRect> rects(NUM_RECTS);
     for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
-        SkRTree rtree;
+        SkDynamicRTree rtree;
         REPORTER_ASSERT(reporter, 0 == rtree.getCount());
 
         for (int j = 0; j < NUM_RECTS; j++) {
             rects[j] = random_rect(rand);
         }
-
         rtree.insert(rects.data(), NUM_RECTS);
-
+        REPORTER_ASSERT(reporter, NUM_RECTS == rtree.getCount());
         run_queries(reporter, rand, rects.data(), rtree);
+
+        // Move some rects, and remove and re-add others, checking queries still match.
+        for (int j = 0; j < NUM_RECTS / 4; j++) {
+            const int index = rand.nextULessThan(NUM_RECTS);
+            rects[index] = random_rect(rand);
+            if (rand.nextBool()) {
+                rtree.update(index, rects[index]);
+            } else {
+                REPORTER_ASSERT(reporter, rtree.remove(index));
+                REPORTER_ASSERT(reporter, !rtree.remove(index));
+                rtree.insert(index, rects[index]);
+            }
+        }
         REPORTER_ASSERT(reporter, NUM_RECTS == rtree.getCount());
-        REPORTER_ASSERT(reporter, expectedDepthMin <= rtree.getDepth() &&
-                                  expectedDepthMax >= rtree.getDepth());
+        run_queries(reporter, rand, rects.data(), rtree);
+
+        for (int j = 0; j < NUM_RECTS; j++) {
+            REPORTER_ASSERT(reporter, rtree.remove(j));
+        }
+        REPORTER_ASSERT(reporter, 0 == rtree.getCount());
+        REPORTER_ASSERT(reporter, 0 == rtree.getDepth());
     }
 }
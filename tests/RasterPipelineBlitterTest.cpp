@@ -0,0 +1,189 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurfaceProps.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkCoreBlitters.h"
+#include "src/core/SkMask.h"
+#include "tests/Test.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct Run {
+    int16_t  fWidth;
+    SkAlpha  fAlpha;
+};
+
+// Builds the runs/alpha arrays blitAntiH() expects: each run's alpha is at the run's offset.
+void blit_runs(SkBlitter* blitter, int x, int y, const std::vector<Run>& runs) {
+    int width = 0;
+    for (const Run& run : runs) {
+        width += run.fWidth;
+    }
+    std::vector<int16_t> runArray(width + 1, 0);
+    std::vector<SkAlpha> alphaArray(width + 1, 0);
+    int offset = 0;
+    for (const Run& run : runs) {
+        runArray[offset] = run.fWidth;
+        alphaArray[offset] = run.fAlpha;
+        offset += run.fWidth;
+    }
+    blitter->blitAntiH(x, y, alphaArray.data(), runArray.data());
+}
+
+}  // anonymous namespace
+
+// blitAntiH() gathers adjacent runs into one pipeline call. Each pixel must come out exactly as
+// it does when its run is blitted on its own.
+DEF_TEST(RasterPipelineBlitter_BatchedAntiH, r) {
+    const std::vector<Run> runs = {
+        {3, 0x00}, {1, 0x40}, {2, 0xff}, {1, 0x80}, {20, 0xff}, {1, 0x10},
+        {4, 0x00}, {5, 0xc0}, {1, 0xff}, {1, 0x01},
+    };
+    constexpr int kX = 5, kY = 2;
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 4);
+
+    for (SkColor color : {SK_ColorBLUE, SkColorSetARGB(0x80, 0x20, 0xc0, 0x40)}) {
+        for (bool highp : {false, true}) {
+            SkBitmap batched, reference;
+            batched.allocPixels(info);
+            reference.allocPixels(info);
+            batched.eraseColor(SkColorSetARGB(0xff, 0x30, 0x60, 0x90));
+            reference.eraseColor(SkColorSetARGB(0xff, 0x30, 0x60, 0x90));
+
+            SkPaint paint;
+            paint.setColor(color);
+            if (highp) {
+                // Hue blending has no lowp implementation.
+                paint.setBlendMode(SkBlendMode::kHue);
+            }
+
+            SkSTArenaAlloc<4096> alloc;
+            SkBlitter* batchedBlitter = SkCreateRasterPipelineBlitter(
+                    batched.pixmap(), paint, SkMatrix::I(), &alloc, nullptr, SkSurfaceProps());
+            SkBlitter* referenceBlitter = SkCreateRasterPipelineBlitter(
+                    reference.pixmap(), paint, SkMatrix::I(), &alloc, nullptr, SkSurfaceProps());
+            REPORTER_ASSERT(r, batchedBlitter && referenceBlitter);
+            if (!batchedBlitter || !referenceBlitter) {
+                return;
+            }
+
+            blit_runs(batchedBlitter, kX, kY, runs);
+            int x = kX;
+            for (const Run& run : runs) {
+                blit_runs(referenceBlitter, x, kY, {run});
+                x += run.fWidth;
+            }
+
+            for (int y = 0; y < info.height(); ++y) {
+                for (int x = 0; x < info.width(); ++x) {
+                    if (*batched.getAddr32(x, y) != *reference.getAddr32(x, y)) {
+                        ERRORF(r, "color %08x highp %d, (%d, %d): batched %08x, reference %08x",
+                               color, highp, x, y,
+                               *batched.getAddr32(x, y), *reference.getAddr32(x, y));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// The solid color blitters specialized on dst format must blend exactly like the raster pipeline
+// into 1010102 and A16. The raster pipeline blends 565 in lowp with 8-bit math, and converts to
+// half floats a little differently than skvx, so those may be off by one step.
+DEF_TEST(SolidColorBlitter_MatchesRasterPipeline, r) {
+    const std::vector<Run> runs = {
+        {2, 0x00}, {1, 0x40}, {3, 0xff}, {1, 0x80}, {12, 0xff}, {1, 0x10}, {4, 0xc0},
+    };
+    uint8_t maskPixels[4 * 6];
+    for (int i = 0; i < 24; ++i) {
+        maskPixels[i] = (uint8_t)(i * 37 % 256);
+    }
+    const SkIRect maskBounds = SkIRect::MakeXYWH(8, 10, 6, 4);
+    const SkMask mask(maskPixels, maskBounds, 6, SkMask::kA8_Format);
+
+    const struct {
+        SkColorType fColorType;
+        float       fTolerance;
+    } kFormats[] = {
+        {kRGBA_1010102_SkColorType, 0},
+        {kBGRA_1010102_SkColorType, 0},
+        {kRGB_101010x_SkColorType,  0},
+        {kRGB_565_SkColorType,      1 / 31.0f},
+        {kA16_unorm_SkColorType,    0},
+        {kRGBA_F16Norm_SkColorType, 1 / 1024.0f},
+        {kRGBA_F16_SkColorType,     1 / 1024.0f},
+    };
+    for (auto [ct, tolerance] : kFormats) {
+        const SkImageInfo info = SkImageInfo::Make(32, 16, ct, kPremul_SkAlphaType,
+                                                   SkColorSpace::MakeSRGB());
+        for (SkColor color : {SK_ColorBLUE, SkColorSetARGB(0x80, 0x20, 0xc0, 0x40)}) {
+            for (SkBlendMode mode : {SkBlendMode::kSrc, SkBlendMode::kSrcOver}) {
+                SkBitmap solid, reference;
+                solid.allocPixels(info);
+                reference.allocPixels(info);
+                solid.eraseColor(SkColorSetARGB(0xc0, 0x30, 0x60, 0x90));
+                reference.eraseColor(SkColorSetARGB(0xc0, 0x30, 0x60, 0x90));
+
+                SkPaint paint;
+                paint.setColor(color);
+                paint.setBlendMode(mode);
+
+                SkSTArenaAlloc<4096> alloc;
+                SkBlitter* solidBlitter = SkCreateSolidColorBlitter(solid.pixmap(), paint, &alloc);
+                SkBlitter* referenceBlitter = SkCreateRasterPipelineBlitter(
+                        reference.pixmap(), paint, SkMatrix::I(), &alloc, nullptr,
+                        SkSurfaceProps());
+                REPORTER_ASSERT(r, solidBlitter && referenceBlitter);
+                if (!solidBlitter || !referenceBlitter) {
+                    return;
+                }
+
+                for (SkBlitter* blitter : {solidBlitter, referenceBlitter}) {
+                    blitter->blitRect(1, 1, 20, 2);
+                    blit_runs(blitter, 3, 4, runs);
+                    blitter->blitV(30, 2, 10, 0x60);
+                    blitter->blitAntiH2(24, 8, 0x20, 0xe0);
+                    blitter->blitAntiV2(27, 8, 0xff, 0x50);
+                    blitter->blitMask(mask, maskBounds);
+                }
+
+                const SkImageInfo f32 = info.makeColorType(kRGBA_F32_SkColorType);
+                std::vector<SkColor4f> solidF32(info.width() * info.height()),
+                                       referenceF32(solidF32.size());
+                REPORTER_ASSERT(r, solid.readPixels(f32, solidF32.data(), f32.minRowBytes(), 0, 0));
+                REPORTER_ASSERT(r, reference.readPixels(f32, referenceF32.data(),
+                                                        f32.minRowBytes(), 0, 0));
+                for (size_t i = 0; i < solidF32.size(); ++i) {
+                    for (int c = 0; c < 4; ++c) {
+                        float diff = std::abs(solidF32[i][c] - referenceF32[i][c]);
+                        if (diff > tolerance * 1.01f) {
+                            ERRORF(r, "color type %d, color %08x, mode %d, pixel %zu, channel %d: "
+                                      "%g vs %g", ct, color, (int)mode, i, c,
+                                   solidF32[i][c], referenceF32[i][c]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
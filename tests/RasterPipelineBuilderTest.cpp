@@ -603,6 +603,36 @@ cmpne_2_floats                 $0..1 = notEqual($0..1, $2..3)
 )");
 }
 
+DEF_TEST(RasterPipelineBuilderFusedMultiplyAdd, r) {
+    using BuilderOp = SkSL::RP::BuilderOp;
+
+    SkSL::RP::Builder builder;
+    builder.push_slots(two_slots_at(0));
+    builder.push_constant_f(2.0f);
+    builder.push_duplicates(1);
+    builder.binary_op(BuilderOp::mul_n_floats, 2);
+    builder.push_constant_f(1.0f);
+    builder.push_duplicates(1);
+    builder.binary_op(BuilderOp::sub_n_floats, 2);
+    builder.pop_slots_unmasked(two_slots_at(2));
+    builder.push_slots(one_slot_at(4));
+    builder.push_constant_f(0.5f);
+    builder.binary_op(BuilderOp::mul_n_floats, 1);
+    builder.push_constant_f(0.25f);
+    builder.binary_op(BuilderOp::add_n_floats, 1);
+    builder.pop_slots_unmasked(one_slot_at(4));
+    std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/5,
+                                                                /*numUniformSlots=*/0,
+                                                                /*numImmutableSlots=*/0);
+    check(r, *program,
+R"(copy_2_slots_unmasked          $0..1 = v0..1
+mad_imm_float                  $0 = $0 * 0x40000000 (2.0) + 0xBF800000 (-1.0)
+mad_imm_float                  $1 = $1 * 0x40000000 (2.0) + 0xBF800000 (-1.0)
+copy_2_slots_unmasked          v2..3 = $0..1
+mad_imm_float                  v4 = v4 * 0x3F000000 (0.5) + 0x3E800000 (0.25)
+)");
+}
+
 DEF_TEST(RasterPipelineBuilderBinaryIntOps, r) {
     using BuilderOp = SkSL::RP::BuilderOp;
 
@@ -551,3 +551,41 @@ DEF_TEST(ReadPixels_InvalidRowBytes, reporter) {
         REPORTER_ASSERT(reporter, !surf->readPixels(dstII, storage.get(), badRowBytes, 0, 0));
     }
 }
+
+// Large conversions are split into bands of rows; they must match converting one row at a time.
+DEF_TEST(ReadPixels_LargeBands, reporter) {
+    constexpr int kW = 1000, kH = 700;
+    auto srcII = SkImageInfo::Make(kW, kH, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType,
+                                   SkColorSpace::MakeSRGB());
+    SkBitmap src;
+    src.allocPixels(srcII, (kW + 3) * 4);
+    uint32_t seed = 1;
+    for (int y = 0; y < kH; ++y) {
+        uint32_t* row = src.getAddr32(0, y);
+        for (int x = 0; x < kW; ++x) {
+            seed = seed * 1664525 + 1013904223;
+            row[x] = seed;
+        }
+    }
+
+    auto p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3);
+    for (SkColorType dstCT : {kRGBA_F16_SkColorType, kBGRA_8888_SkColorType,
+                              kAlpha_8_SkColorType}) {
+        auto dstII = SkImageInfo::Make(kW, kH, dstCT, kPremul_SkAlphaType, p3);
+        SkBitmap whole, rows;
+        whole.allocPixels(dstII);
+        rows.allocPixels(dstII);
+        REPORTER_ASSERT(reporter, src.readPixels(whole.pixmap()));
+        for (int y = 0; y < kH; ++y) {
+            SkPixmap dstRow;
+            SkAssertResult(rows.pixmap().extractSubset(&dstRow, SkIRect::MakeXYWH(0, y, kW, 1)));
+            REPORTER_ASSERT(reporter, src.readPixels(dstRow, 0, y));
+        }
+        for (int y = 0; y < kH; ++y) {
+            if (0 != memcmp(whole.getAddr(0, y), rows.getAddr(0, y), whole.info().minRowBytes())) {
+                ERRORF(reporter, "color type %d differs at row %d", dstCT, y);
+                break;
+            }
+        }
+    }
+}
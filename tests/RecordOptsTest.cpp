@@ -426,3 +426,71 @@ DEF_TEST(savelayer_srcmode_alpha, r) {
     do_savelayer_srcmode(r, 0x80FF0000);
 }
 
+
+DEF_TEST(RecordOpts_CullOccludedDraws, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint opaque;
+    SkPaint translucent;
+    translucent.setAlpha(0x80);
+    SkPaint antialiased;
+    antialiased.setAntiAlias(true);
+
+    recorder.drawRect(SkRect::MakeXYWH(10, 10, 20, 20), opaque);       // 0: culled by 2
+    recorder.drawRect(SkRect::MakeXYWH(10, 10, 20, 20), antialiased);  // 1: AA fringe shows
+    recorder.drawRect(SkRect::MakeXYWH(0, 0, 50, 50), opaque);         // 2
+    recorder.drawRect(SkRect::MakeXYWH(0, 0, 60, 60), translucent);    // 3: not opaque
+    recorder.drawRect(SkRect::MakeXYWH(5, 5, 10, 10), opaque);         // 4: covers nothing whole
+    recorder.save();                                                    // 5: ends the run
+    recorder.drawRect(SkRect::MakeXYWH(0, 0, 100, 100), opaque);       // 6
+    recorder.restore();                                                 // 7
+
+    REPORTER_ASSERT(r, 1 == SkRecordCullOccludedDraws(&record));
+    assert_type<SkRecords::NoOp>(r, record, 0);
+    for (int i = 1; i <= 4; ++i) {
+        assert_type<SkRecords::DrawRect>(r, record, i);
+    }
+
+    // An opaque DrawPaint covers everything drawn before it under the same clip.
+    recorder.drawOval(SkRect::MakeWH(30, 30), opaque);                 // 8
+    recorder.drawPaint(opaque);                                         // 9
+    REPORTER_ASSERT(r, 1 == SkRecordCullOccludedDraws(&record));
+    assert_type<SkRecords::NoOp>(r, record, 8);
+    assert_type<SkRecords::Restore>(r, record, 7);
+}
+
+DEF_TEST(RecordOpts_NoopRedundantClips, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    recorder.clipRect(SkRect::MakeWH(100, 100));                       // 0
+    recorder.clipRect(SkRect::MakeWH(200, 200));                       // 1: contains 0
+    recorder.clipRect(SkRect::MakeWH(50, 50));                         // 2: shrinks the clip
+    recorder.clipRect(SkRect::MakeWH(60, 60), true);                   // 3: antialiased
+    recorder.clipRect(SkRect::MakeWH(80, 80));                         // 4: follows an AA clip
+
+    REPORTER_ASSERT(r, 1 == SkRecordNoopRedundantClips(&record));
+    assert_type<SkRecords::ClipRect>(r, record, 0);
+    assert_type<SkRecords::NoOp>(r, record, 1);
+    for (int i = 2; i <= 4; ++i) {
+        assert_type<SkRecords::ClipRect>(r, record, i);
+    }
+}
+
+DEF_TEST(RecordOpts_OptimizeStats, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    recorder.clipRect(SkRect::MakeWH(100, 100));
+    recorder.clipRect(SkRect::MakeWH(100, 100));
+    recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    recorder.drawRect(SkRect::MakeWH(20, 20), SkPaint());
+
+    SkRecordOptimizeStats stats;
+    SkRecordOptimize(&record, &stats);
+    REPORTER_ASSERT(r, stats.fRemovedClips == 1);
+    REPORTER_ASSERT(r, stats.fCulledDraws == 1);
+    REPORTER_ASSERT(r, stats.fRemovedOps == 2);
+    REPORTER_ASSERT(r, record.count() == 2);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkRegionDecoder.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+static bool same_region(const SkBitmap& full, const SkIRect& region, const SkBitmap& decoded) {
+    const size_t rowBytes = region.width() * decoded.bytesPerPixel();
+    for (int y = 0; y < region.height(); ++y) {
+        if (memcmp(full.getAddr(region.left(), region.top() + y), decoded.getAddr(0, y),
+                   rowBytes)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Regions decoded in any order, resuming or starting part way down the image, must match the same
+// regions of the whole image.
+DEF_TEST(RegionDecoder_Tiles, r) {
+    const char* images[] = {
+            "images/mandrill_restart_interval.jpg",
+            "images/mandrill_512_q075.jpg",
+            "images/mandrill_h1v1.jpg",
+            "images/mandrill_512.png",
+            "images/plane_interlaced.png",
+    };
+    for (const char* path : images) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        if (!codec) {
+            // The decoder for this format is not built.
+            continue;
+        }
+        for (bool xform : {false, true}) {
+            SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+            if (xform) {
+                info = info.makeColorSpace(SkColorSpace::MakeSRGB()->makeColorSpin());
+            }
+            SkBitmap full;
+            full.allocPixels(info);
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(full.pixmap()), "%s", path);
+
+            std::unique_ptr<SkRegionDecoder> decoder = SkRegionDecoder::Make(data, 3);
+            REPORTER_ASSERT(r, decoder, "%s", path);
+            if (!decoder) {
+                continue;
+            }
+            REPORTER_ASSERT(r, decoder->getInfo().dimensions() == info.dimensions());
+
+            // Tiles that don't line up with MCU rows, including ones at the right and bottom
+            // edges, in a random order with repeats.
+            std::vector<SkIRect> tiles;
+            for (int y = 0; y < info.height(); y += 61) {
+                for (int x = 0; x < info.width(); x += 150) {
+                    tiles.push_back(SkIRect::MakeXYWH(x, y, 150, 61));
+                    tiles.back().intersect(SkIRect::MakeSize(info.dimensions()));
+                }
+            }
+            SkRandom random;
+            for (int i = 0; i < 3 * SkToInt(tiles.size()); ++i) {
+                const SkIRect& tile = tiles[random.nextULessThan(tiles.size())];
+                SkBitmap bitmap;
+                bitmap.allocPixels(info.makeDimensions(tile.size()));
+                REPORTER_ASSERT(r,
+                                SkCodec::kSuccess == decoder->decodeRegion(bitmap.pixmap(), tile),
+                                "%s", path);
+                REPORTER_ASSERT(r, same_region(full, tile, bitmap), "%s xform %d tile %d %d",
+                                path, xform, tile.left(), tile.top());
+            }
+        }
+    }
+}
+
+DEF_TEST(RegionDecoder_InvalidRegion, r) {
+    sk_sp<SkData> data = GetResourceAsData("images/mandrill_512_q075.jpg");
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkRegionDecoder> decoder = SkRegionDecoder::Make(data, 1);
+    if (!decoder) {
+        return;
+    }
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    REPORTER_ASSERT(r, SkCodec::kInvalidParameters ==
+                               decoder->decodeRegion(bitmap.pixmap(),
+                                                     SkIRect::MakeXYWH(480, 0, 64, 64)));
+    REPORTER_ASSERT(r, SkCodec::kInvalidParameters ==
+                               decoder->decodeRegion(bitmap.pixmap(),
+                                                     SkIRect::MakeXYWH(0, 0, 32, 64)));
+    REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                               decoder->decodeRegion(bitmap.pixmap(),
+                                                     SkIRect::MakeXYWH(448, 448, 64, 64)));
+}
@@ -584,3 +584,62 @@ DEF_TEST(region_very_large, reporter) {
     REPORTER_ASSERT(reporter, smallRegion.contains(499, 0));
     REPORTER_ASSERT(reporter, smallRegion.contains(499, 499));
 }
+
+// Checks every op pixel by pixel, on regions that often have bands covered by only one of them, or
+// intervals side by side, where the scanlines are combined without merging their edges.
+DEF_TEST(Region_ops_per_pixel, reporter) {
+    constexpr int kSize = 24;
+    const SkRegion::Op ops[] = {
+        SkRegion::kDifference_Op,
+        SkRegion::kIntersect_Op,
+        SkRegion::kUnion_Op,
+        SkRegion::kXOR_Op,
+        SkRegion::kReverseDifference_Op,
+    };
+
+    SkRandom rand;
+    auto rand_rgn = [&](int left, int right) {
+        SkRegion rgn;
+        for (int i = 0; i < 4; ++i) {
+            SkIRect r = SkIRect::MakeLTRB(left + rand.nextULessThan(right - left),
+                                          rand.nextULessThan(kSize),
+                                          left + rand.nextULessThan(right - left),
+                                          rand.nextULessThan(kSize));
+            r.sort();
+            rgn.op(r, SkRegion::kXOR_Op);
+        }
+        return rgn;
+    };
+
+    for (int i = 0; i < 500; ++i) {
+        // Every other pair lies side by side, or touches, in x.
+        const bool sideBySide = i & 1;
+        const SkRegion a = rand_rgn(0, sideBySide ? kSize / 2 : kSize);
+        const SkRegion b = rand_rgn(sideBySide ? kSize / 2 : 0, kSize);
+
+        for (SkRegion::Op op : ops) {
+            SkRegion result;
+            result.op(a, b, op);
+            SkRegion inPlace = a;
+            inPlace.op(b, op);
+            REPORTER_ASSERT(reporter, result == inPlace);
+
+            for (int y = 0; y < kSize; ++y) {
+                for (int x = 0; x < kSize; ++x) {
+                    const bool inA = a.contains(x, y);
+                    const bool inB = b.contains(x, y);
+                    bool expected = false;
+                    switch (op) {
+                        case SkRegion::kDifference_Op:        expected = inA && !inB; break;
+                        case SkRegion::kIntersect_Op:         expected = inA && inB;  break;
+                        case SkRegion::kUnion_Op:             expected = inA || inB;  break;
+                        case SkRegion::kXOR_Op:               expected = inA != inB;  break;
+                        case SkRegion::kReverseDifference_Op: expected = inB && !inA; break;
+                        default: break;
+                    }
+                    REPORTER_ASSERT(reporter, result.contains(x, y) == expected);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "src/image/SkRescaleAndReadPixels.h"
+#include "tests/Test.h"
+
+#include <cstdlib>
+#include <memory>
+
+namespace {
+
+struct ReadContext {
+    std::unique_ptr<const SkImage::AsyncReadResult> fResult;
+};
+
+void read_callback(SkImage::ReadPixelsContext context,
+                   std::unique_ptr<const SkImage::AsyncReadResult> result) {
+    static_cast<ReadContext*>(context)->fResult = std::move(result);
+}
+
+bool close_to(SkColor a, SkColor b, int tolerance) {
+    return std::abs((int)SkColorGetR(a) - (int)SkColorGetR(b)) <= tolerance &&
+           std::abs((int)SkColorGetG(a) - (int)SkColorGetG(b)) <= tolerance &&
+           std::abs((int)SkColorGetB(a) - (int)SkColorGetB(b)) <= tolerance &&
+           std::abs((int)SkColorGetA(a) - (int)SkColorGetA(b)) <= tolerance;
+}
+
+}  // namespace
+
+// The left half of the source rect is blue and the right half is white, with a red border outside
+// of it that must not bleed in. Every rescaling mode, step count and gamma keeps the two halves.
+DEF_TEST(RescaleAndReadPixels_Raster, reporter) {
+    static constexpr int kSrcSize = 300;
+    static constexpr SkIRect kSrcRect = SkIRect::MakeLTRB(10, 10, kSrcSize - 10, kSrcSize - 10);
+
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::Make(kSrcSize, kSrcSize, kRGBA_8888_SkColorType,
+                                      kPremul_SkAlphaType, SkColorSpace::MakeSRGB()));
+    src.eraseColor(SK_ColorRED);
+    src.erase(SK_ColorBLUE, SkIRect::MakeLTRB(kSrcRect.fLeft, kSrcRect.fTop,
+                                              kSrcSize / 2, kSrcRect.fBottom));
+    src.erase(SK_ColorWHITE, SkIRect::MakeLTRB(kSrcSize / 2, kSrcRect.fTop,
+                                               kSrcRect.fRight, kSrcRect.fBottom));
+
+    for (SkISize size : {SkISize{35, 20}, SkISize{140, 560}, SkISize{280, 280}, SkISize{900, 700}}) {
+        for (auto mode : {SkImage::RescaleMode::kNearest,
+                          SkImage::RescaleMode::kRepeatedLinear,
+                          SkImage::RescaleMode::kRepeatedCubic}) {
+            for (auto gamma : {SkImage::RescaleGamma::kSrc, SkImage::RescaleGamma::kLinear}) {
+                SkImageInfo resultInfo = SkImageInfo::Make(size, kRGBA_8888_SkColorType,
+                                                           kPremul_SkAlphaType,
+                                                           SkColorSpace::MakeSRGB());
+                ReadContext context;
+                SkRescaleAndReadPixels(src, resultInfo, kSrcRect, gamma, mode, read_callback,
+                                       &context);
+                if (!context.fResult) {
+                    ERRORF(reporter, "%dx%d mode %d gamma %d: no result", size.width(),
+                           size.height(), (int)mode, (int)gamma);
+                    continue;
+                }
+                SkPixmap result(resultInfo, context.fResult->data(0),
+                                context.fResult->rowBytes(0));
+                // Check a column inside each half, away from the middle, and the rows at the
+                // edges, where the red border would show up if it bled in.
+                for (int y : {0, size.height() / 2, size.height() - 1}) {
+                    SkColor left = result.getColor(size.width() / 8, y);
+                    SkColor right = result.getColor(size.width() - 1 - size.width() / 8, y);
+                    REPORTER_ASSERT(reporter, close_to(left, SK_ColorBLUE, 2),
+                                    "%dx%d mode %d gamma %d: left 0x%08x at y %d",
+                                    size.width(), size.height(), (int)mode, (int)gamma, left, y);
+                    REPORTER_ASSERT(reporter, close_to(right, SK_ColorWHITE, 2),
+                                    "%dx%d mode %d gamma %d: right 0x%08x at y %d",
+                                    size.width(), size.height(), (int)mode, (int)gamma, right, y);
+                }
+            }
+        }
+    }
+}
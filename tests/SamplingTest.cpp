@@ -5,12 +5,20 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkSamplingPriv.h"
@@ -18,6 +26,8 @@
 #include "tools/DecodeUtils.h"
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <initializer_list>
 
 // In general, sampling under identity matrix should not affect the pixels. However,
@@ -62,3 +72,59 @@ DEF_TEST(sampling_with_identity_matrix, r) {
         }
     }
 }
+
+// Clamped 8888 and F16 images are sampled by fused stages, one per mip level. Away from the edges
+// of the image, they must match the generic stages, used for repeat tiling.
+DEF_TEST(sampling_fused_clamp_stages, r) {
+    SkRandom rand;
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType, kRGBA_F16_SkColorType}) {
+        SkBitmap src;
+        src.allocPixels(SkImageInfo::Make(64, 64, ct, kPremul_SkAlphaType));
+        for (int y = 0; y < src.height(); ++y) {
+            for (int x = 0; x < src.width(); ++x) {
+                float a = rand.nextF();
+                src.erase(SkColor4f{rand.nextF() * a, rand.nextF() * a, rand.nextF() * a, a}
+                                  .toSkColor(),
+                          SkIRect::MakeXYWH(x, y, 1, 1));
+            }
+        }
+        sk_sp<SkImage> image = src.asImage();
+
+        const SkSamplingOptions samplings[] = {
+            SkSamplingOptions(SkFilterMode::kLinear),
+            SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kLinear),
+            SkSamplingOptions(SkCubicResampler::Mitchell()),
+            SkSamplingOptions(SkCubicResampler::CatmullRom()),
+        };
+        for (const SkSamplingOptions& sampling : samplings) {
+            for (float scale : {0.37f, 1.7f}) {
+                SkBitmap dst[2];
+                int i = 0;
+                for (SkTileMode tm : {SkTileMode::kClamp, SkTileMode::kRepeat}) {
+                    SkPaint paint;
+                    paint.setShader(image->makeShader(tm, tm, sampling,
+                                                      SkMatrix::Scale(scale, scale)));
+                    dst[i].allocPixels(SkImageInfo::Make(40, 40, kRGBA_F32_SkColorType,
+                                                         kPremul_SkAlphaType));
+                    SkCanvas(dst[i++]).drawPaint(paint);
+                }
+
+                // Stay away from the edges, where clamping and repeating differ.
+                const int margin = 8,
+                          limit = std::min(dst[0].width(), SkScalarFloorToInt(64 * scale)) - margin;
+                float maxDiff = 0;
+                for (int y = margin; y < limit; ++y) {
+                    for (int x = margin; x < limit; ++x) {
+                        SkColor4f c0 = dst[0].getColor4f(x, y),
+                                  c1 = dst[1].getColor4f(x, y);
+                        for (int c = 0; c < 4; ++c) {
+                            maxDiff = std::max(maxDiff, std::abs(c0[c] - c1[c]));
+                        }
+                    }
+                }
+                REPORTER_ASSERT(r, maxDiff < 1e-4f, "ct %d scale %g maxDiff %g",
+                                ct, scale, maxDiff);
+            }
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontArguments.h"
 #include "include/core/SkFontMetrics.h"
@@ -1039,3 +1040,35 @@ DEF_TEST(ReadBuffer_empty, reporter) {
     REPORTER_ASSERT(reporter, data->size() == 0);
     REPORTER_ASSERT(reporter, reader.readInt() == 321);
 }
+
+DEF_TEST(Serialization_ParallelEncoding, reporter) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(200, 200));
+    for (int i = 0; i < 6; ++i) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(8 + i, 8);
+        bitmap.eraseColor(SkColorSetARGB(0xFF, 40 * i, 0, 0));
+        canvas->drawImage(bitmap.asImage(), 10 * i, 0);
+    }
+    SkFont font = ToolUtils::DefaultFont();
+    canvas->drawString("typefaces", 0, 100, font, SkPaint());
+    font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Bold()));
+    canvas->drawString("too", 0, 150, font, SkPaint());
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    // Encodes images as their raw pixels, which needs no codecs and is safe to do concurrently.
+    SkSerialProcs procs;
+    procs.fImageProc = [](SkImage* image, void*) -> sk_sp<SkData> {
+        SkBitmap bitmap;
+        if (!image->asLegacyBitmap(&bitmap)) {
+            return nullptr;
+        }
+        return SkData::MakeWithCopy(bitmap.getPixels(), bitmap.computeByteSize());
+    };
+    sk_sp<SkData> serial = picture->serialize(&procs);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(3);
+    procs.fExecutor = executor.get();
+    sk_sp<SkData> parallel = picture->serialize(&procs);
+    REPORTER_ASSERT(reporter, serial && parallel && serial->equals(parallel.get()));
+}
@@ -30,10 +30,17 @@
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/private/base/SkAssert.h"
+#include "src/shaders/SkPerlinNoiseShaderImpl.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #if defined(SK_GANESH) || defined(SK_GRAPHITE)
@@ -104,6 +111,69 @@ DEF_TEST(ComposeShaderSingle, reporter) {
     canvas.drawRRect(rr, p);
 }
 
+// Perlin noise shaders with the same seed share their tables, and the bitmaps made from them.
+DEF_TEST(PerlinNoise_sharedTables, reporter) {
+    using PaintingData = SkPerlinNoiseShader::PaintingData;
+    const SkISize tileSize = {30, 20};
+    auto paintingData = [](const sk_sp<SkShader>& shader) {
+        return static_cast<const SkPerlinNoiseShader*>(shader.get())->getPaintingData();
+    };
+
+    std::unique_ptr<PaintingData> a = paintingData(SkShaders::MakeTurbulence(0.05f, 0.1f, 3, 7)),
+                                  b = paintingData(SkShaders::MakeFractalNoise(
+                                          0.07f, 0.02f, 2, 7.5f, &tileSize)),
+                                  c = paintingData(SkShaders::MakeTurbulence(0.05f, 0.1f, 3, 8));
+    REPORTER_ASSERT(reporter, a->getPermutationsBitmap().getGenerationID() ==
+                              b->getPermutationsBitmap().getGenerationID());
+    REPORTER_ASSERT(reporter, a->getNoiseBitmap().getGenerationID() ==
+                              b->getNoiseBitmap().getGenerationID());
+    REPORTER_ASSERT(reporter, a->getNoiseBitmap().getGenerationID() !=
+                              c->getNoiseBitmap().getGenerationID());
+
+    // The shared tables match tables built from scratch, with b's own frequencies and stitching.
+    const PaintingData expected(tileSize, 7.5f, 0.07f, 0.02f);
+    REPORTER_ASSERT(reporter, !memcmp(b->fLatticeSelector, expected.fLatticeSelector,
+                                      sizeof(expected.fLatticeSelector)));
+    REPORTER_ASSERT(reporter, !memcmp(b->fNoise, expected.fNoise, sizeof(expected.fNoise)));
+    REPORTER_ASSERT(reporter, !memcmp(b->getNoiseBitmap().getPixels(), expected.fNoise,
+                                      sizeof(expected.fNoise)));
+    REPORTER_ASSERT(reporter, b->fBaseFrequency == expected.fBaseFrequency);
+    REPORTER_ASSERT(reporter, b->fStitchDataInit == expected.fStitchDataInit);
+    REPORTER_ASSERT(reporter, a->fStitchDataInit == SkPerlinNoiseShader::StitchData());
+}
+
+// The raster backend skips octaves too small to change the destination. Drawing into 8888 must
+// still match drawing into F32, which evaluates more of them.
+DEF_TEST(PerlinNoise_octaves, reporter) {
+    for (const sk_sp<SkShader>& shader : {SkShaders::MakeTurbulence(0.03f, 0.05f, 200, 3),
+                                          SkShaders::MakeFractalNoise(0.03f, 0.05f, 200, 3)}) {
+        SkPaint paint;
+        paint.setShader(shader);
+
+        SkBitmap expected, actual;
+        for (auto [bitmap, ct] : {std::make_pair(&expected, kRGBA_F32_SkColorType),
+                                  std::make_pair(&actual, kRGBA_8888_SkColorType)}) {
+            bitmap->allocPixels(SkImageInfo::Make(64, 64, ct, kPremul_SkAlphaType));
+            SkCanvas(*bitmap).drawPaint(paint);
+        }
+        SkBitmap expected8888;
+        expected8888.allocPixels(actual.info());
+        SkAssertResult(expected.readPixels(expected8888.pixmap()));
+
+        int maxDiff = 0;
+        for (int y = 0; y < actual.height(); ++y) {
+            for (int x = 0; x < actual.width(); ++x) {
+                const uint8_t* e = static_cast<const uint8_t*>(expected8888.getAddr(x, y));
+                const uint8_t* a = static_cast<const uint8_t*>(actual.getAddr(x, y));
+                for (int c = 0; c < 4; ++c) {
+                    maxDiff = std::max(maxDiff, std::abs(e[c] - a[c]));
+                }
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 1, "maxDiff %d", maxDiff);
+    }
+}
+
 // Tests that nested blending will render as expected.
 static void test_nested_blends(skiatest::Reporter* reporter, SkSurface* surface) {
     auto [redEffect, redError] = SkRuntimeEffect::MakeForShader(SkString(R"(
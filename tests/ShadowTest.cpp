@@ -5,8 +5,11 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkPoint3.h"
@@ -23,6 +26,11 @@
 #include "src/utils/SkShadowTessellator.h"
 #include "tests/Test.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 
 enum ExpectVerts {
@@ -219,4 +227,52 @@ DEF_TEST(ShadowBounds, reporter) {
     check_bounds(reporter, path);
 }
 
+DEF_TEST(ShadowUtils_rotatedCache, reporter) {
+    // A cached shadow mesh may be reused, rotated, for the same shape drawn at another angle. That
+    // must look the same as tessellating the rotated shape from scratch.
+    auto make_pentagon = [] {
+        SkPath pentagon;
+        for (int i = 0; i < 5; ++i) {
+            const float theta = 2 * SK_FloatPI * i / 5;
+            const SkPoint pt = {100 + 40 * std::cos(theta), 100 + 40 * std::sin(theta)};
+            i == 0 ? pentagon.moveTo(pt) : pentagon.lineTo(pt);
+        }
+        return pentagon.close();
+    };
+
+    for (uint32_t flags : {(uint32_t)SkShadowFlags::kNone_ShadowFlag,
+                           (uint32_t)SkShadowFlags::kTransparentOccluder_ShadowFlag}) {
+        auto draw = [&](SkBitmap* bitmap, const SkPath& path, float degrees) {
+            bitmap->allocN32Pixels(200, 200);
+            bitmap->eraseColor(SK_ColorWHITE);
+            SkCanvas canvas(*bitmap);
+            canvas.rotate(degrees, 100, 100);
+            SkShadowUtils::DrawShadow(&canvas, path, {0, 0, 8}, {60, 40, 300}, 80,
+                                      0x40000000, 0x60000000, flags);
+            // Where the occluder is opaque, the mesh may have a hole underneath it.
+            SkPaint paint;
+            paint.setColor(SK_ColorGRAY);
+            canvas.drawPath(path, paint);
+        };
+        // A new path has a new generation ID, so it is tessellated afresh.
+        SkPath pentagon = make_pentagon();
+        SkBitmap first, cached, uncached;
+        draw(&first, pentagon, 10);
+        draw(&cached, pentagon, 47);
+        draw(&uncached, make_pentagon(), 47);
+
+        int maxDiff = 0;
+        for (int y = 0; y < 200; ++y) {
+            for (int x = 0; x < 200; ++x) {
+                SkColor a = cached.getColor(x, y),
+                        b = uncached.getColor(x, y);
+                maxDiff = std::max({maxDiff,
+                                    std::abs((int)SkColorGetR(a) - (int)SkColorGetR(b)),
+                                    std::abs((int)SkColorGetA(a) - (int)SkColorGetA(b))});
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 3, "flags %u: max diff %d", flags, maxDiff);
+    }
+}
+
 #endif // !defined(SK_ENABLE_OPTIMIZE_SIZE)
@@ -9,8 +9,12 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkRefCnt.h"
 #include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
 #include "tests/Test.h"
 
+#include <cmath>
 #include <cstdint>
 
 DEF_TEST(SkColorSpaceXformSteps, r) {
@@ -174,3 +178,51 @@ DEF_TEST(SkColorSpaceXformSteps, r) {
                 (t&16) ? " true" : "false");
     }
 }
+
+DEF_TEST(SkColorSpaceXformSteps_unorm8, r) {
+    // Every 8-bit value, in each of r, g and b.
+    uint32_t src[256];
+    for (int i = 0; i < 256; ++i) {
+        src[i] = 0xff000000 | (uint32_t)i << 16 | (uint32_t)(255 - i) << 8 | (uint32_t)(i ^ 0x5a);
+    }
+
+    auto srgb = SkColorSpace::MakeSRGB(),
+         p3   = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDisplayP3),
+         rec  = SkColorSpace::MakeRGB(SkNamedTransferFn::kRec2020, SkNamedGamut::kRec2020),
+         pq   = SkColorSpace::MakeRGB(SkNamedTransferFn::kPQ, SkNamedGamut::kRec2020);
+    struct {
+        sk_sp<SkColorSpace> src, dst;
+        SkAlphaType         srcAT;
+    } tests[] = {
+        { srgb, p3,   kOpaque_SkAlphaType   },
+        { srgb, p3,   kUnpremul_SkAlphaType },
+        { rec,  srgb, kOpaque_SkAlphaType   },
+        { pq,   srgb, kUnpremul_SkAlphaType },
+        { srgb, p3,   kPremul_SkAlphaType   },  // Falls back to apply().
+    };
+    for (const auto& t : tests) {
+        SkColorSpaceXformSteps steps(t.src.get(), t.srcAT, t.dst.get(), kPremul_SkAlphaType);
+
+        float dst[256 * 4];
+        SkRasterPipeline_MemoryCtx srcCtx = {src, 0},
+                                   dstCtx = {dst, 0};
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipelineOp::load_8888, &srcCtx);
+        steps.applyToUnorm8(&p);
+        p.append(SkRasterPipelineOp::store_f32, &dstCtx);
+        p.run(0, 0, 256, 1);
+
+        for (int i = 0; i < 256; ++i) {
+            float expected[4] = {(src[i] >>  0 & 0xff) / 255.0f,
+                                 (src[i] >>  8 & 0xff) / 255.0f,
+                                 (src[i] >> 16 & 0xff) / 255.0f,
+                                 1.0f};
+            steps.apply(expected);
+            for (int c = 0; c < 4; ++c) {
+                // The encode step is still evaluated approximately, as in apply(SkRasterPipeline*).
+                REPORTER_ASSERT(r, fabsf(dst[4*i + c] - expected[c]) < 2e-3f,
+                                "%d %d: %g vs %g", i, c, dst[4*i + c], expected[c]);
+            }
+        }
+    }
+}
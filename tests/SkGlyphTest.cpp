@@ -17,6 +17,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTo.h"
 #include "include/effects/SkRuntimeEffect.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkCanvasPriv.h"
@@ -28,6 +29,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
 #include <optional>
@@ -192,6 +194,67 @@ DEF_TEST(SkGlyph_SendWithImage, reporter) {
     REPORTER_ASSERT(reporter, !dstGlyph->setImageHasBeenCalled());
 }
 
+DEF_TEST(SkGlyph_SendImageRuns, reporter) {
+    // The runs of the first image make it smaller to send, but the second has none, so it is sent
+    // as is. Both have to arrive intact.
+    uint8_t runsImage[9][8];
+    memset(runsImage, 0, sizeof(runsImage));
+    memset(runsImage[4], 0xff, sizeof(runsImage[4]));
+    runsImage[5][3] = 0x80;
+    uint8_t noRunsImage[9][8];
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            noRunsImage[y][x] = SkTo<uint8_t>(y * 8 + x);
+        }
+    }
+
+    for (auto imageData : {runsImage, noRunsImage}) {
+        SkArenaAlloc alloc{256};
+        SkGlyph srcGlyph{SkPackedGlyphID{(SkGlyphID)12}};
+        SkGlyphTestPeer::SetGlyph1(&srcGlyph);
+        srcGlyph.setImage(&alloc, imageData);
+
+        SkBinaryWriteBuffer writeBuffer({});
+        srcGlyph.flattenMetrics(writeBuffer);
+        const size_t metricsSize = writeBuffer.bytesWritten();
+        srcGlyph.flattenImage(writeBuffer);
+        const size_t imageBytesSent = writeBuffer.bytesWritten() - metricsSize;
+        if (imageData == runsImage) {
+            REPORTER_ASSERT(reporter, imageBytesSent < srcGlyph.imageSize());
+        }
+
+        sk_sp<SkData> data = writeBuffer.snapshotAsData();
+        SkReadBuffer readBuffer{data->data(), data->size()};
+        std::optional<SkGlyph> dstGlyph = SkGlyph::MakeFromBuffer(readBuffer);
+        REPORTER_ASSERT(reporter, dstGlyph.has_value());
+        dstGlyph->addImageFromBuffer(readBuffer, &alloc);
+        REPORTER_ASSERT(reporter, readBuffer.isValid());
+        REPORTER_ASSERT(reporter, dstGlyph->setImageHasBeenCalled());
+        REPORTER_ASSERT(reporter,
+                        !memcmp(imageData, dstGlyph->image(), srcGlyph.imageSize()));
+    }
+
+    // Runs that decode to more or less than the image size are rejected.
+    for (size_t runLength : {71, 73}) {
+        SkArenaAlloc alloc{256};
+        SkGlyph srcGlyph{SkPackedGlyphID{(SkGlyphID)12}};
+        SkGlyphTestPeer::SetGlyph1(&srcGlyph);
+
+        SkBinaryWriteBuffer badWriteBuffer({});
+        srcGlyph.flattenMetrics(badWriteBuffer);
+        const uint8_t runs[] = {SkTo<uint8_t>(128 + runLength - 3), 0xff};
+        badWriteBuffer.writeByteArray(runs, sizeof(runs));
+
+        sk_sp<SkData> data = badWriteBuffer.snapshotAsData();
+        SkReadBuffer badReadBuffer{data->data(), data->size()};
+        std::optional<SkGlyph> dstGlyph = SkGlyph::MakeFromBuffer(badReadBuffer);
+        REPORTER_ASSERT(reporter, dstGlyph.has_value());
+        dstGlyph->addImageFromBuffer(badReadBuffer, &alloc);
+        REPORTER_ASSERT(reporter, !badReadBuffer.isValid());
+        REPORTER_ASSERT(reporter, !dstGlyph->setImageHasBeenCalled());
+    }
+}
+
 DEF_TEST(SkGlyph_SendWithPath, reporter) {
     SkArenaAlloc alloc{256};
     SkGlyph srcGlyph{SkPackedGlyphID{(SkGlyphID)12}};
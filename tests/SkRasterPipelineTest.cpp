@@ -11,11 +11,13 @@
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineContextUtils.h"
+#include "src/core/SkRasterPipelineProfile.h"
 #include "src/gpu/Swizzle.h"
 #include "src/sksl/tracing/SkSLTraceHook.h"
 #include "tests/Test.h"
 
 #include <cmath>
+#include <functional>
 #include <numeric>
 
 using namespace skia_private;
@@ -3269,6 +3271,37 @@ DEF_TEST(SkRasterPipeline_lowp, r) {
     }
 }
 
+DEF_TEST(SkRasterPipeline_Profile, r) {
+    uint32_t rgba[64] = {};
+    SkRasterPipeline_MemoryCtx ptr = { rgba, 0 };
+
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipelineOp::load_8888,  &ptr);
+    p.append(SkRasterPipelineOp::swap_rb);
+    p.append(SkRasterPipelineOp::force_opaque);
+    p.append(SkRasterPipelineOp::store_8888, &ptr);
+
+    // Other tests may run pipelines while profiling is on; they are recorded too, but can only
+    // add to the counts checked here.
+    SkRasterPipelineProfile::SetEnabled(true);
+    p.run(0,0,64,1);
+    auto compiled = p.compile();
+    compiled(0,0,16,2);
+    SkRasterPipelineProfile::SetEnabled(false);
+    // Pipelines compiled while profiling keep recording.
+    compiled(0,0,16,1);
+
+    bool found = false;
+    for (const SkRasterPipelineProfile::Stats& stats : SkRasterPipelineProfile::Snapshot()) {
+        if (stats.fStages.equals("load_8888,swap_rb,force_opaque,store_8888")) {
+            found = true;
+            REPORTER_ASSERT(r, stats.fRuns >= 3);
+            REPORTER_ASSERT(r, stats.fPixels >= 64 + 32 + 16);
+        }
+    }
+    REPORTER_ASSERT(r, found);
+}
+
 DEF_TEST(SkRasterPipeline_swizzle, r) {
     // This takes the lowp code path
     {
@@ -3344,6 +3377,114 @@ DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
     p.run(0,0,1,1);
 }
 
+using BuildStagesFn = std::function<void(SkRasterPipeline*, SkArenaAlloc*,
+                                         SkRasterPipeline_MemoryCtx*)>;
+
+// Builds `head` followed by `tail` twice: once by appending them to one pipeline, which lets
+// SkRasterPipeline fuse stages across the boundary, and once by extend()-ing a separate `tail`
+// pipeline, which copies its stages verbatim. Both must produce identical pixels.
+static void test_fused_stages(skiatest::Reporter* r,
+                              const BuildStagesFn& head,
+                              const BuildStagesFn& tail,
+                              int stagesSaved) {
+    constexpr int kWidth = 37;
+    for (bool highp : {false, true}) {
+        uint32_t fusedPixels[kWidth], unfusedPixels[kWidth];
+        for (int i = 0; i < kWidth; i++) {
+            fusedPixels[i] = unfusedPixels[i] = (uint32_t)(i * 37 & 0xff) << 0
+                                              | (uint32_t)(i * 91 & 0xff) << 8
+                                              | (uint32_t)(i * 53 & 0xff) << 16
+                                              | (uint32_t)(i * 17 & 0xff) << 24;
+        }
+        SkRasterPipeline_MemoryCtx fusedCtx = {fusedPixels, 0},
+                                   unfusedCtx = {unfusedPixels, 0};
+
+        SkSTArenaAlloc<1024> alloc;
+        SkRasterPipeline fused(&alloc), unfused(&alloc), unfusedTail(&alloc);
+        if (highp) {
+            // unpremul has no lowp implementation; every head below overwrites its output.
+            fused.append(SkRasterPipelineOp::unpremul);
+            unfused.append(SkRasterPipelineOp::unpremul);
+        }
+        head(&fused, &alloc, &fusedCtx);
+        tail(&fused, &alloc, &fusedCtx);
+        head(&unfused, &alloc, &unfusedCtx);
+        tail(&unfusedTail, &alloc, &unfusedCtx);
+        unfused.extend(unfusedTail);
+
+        REPORTER_ASSERT(r, fused.getNumStages() == unfused.getNumStages() - stagesSaved,
+                        "highp=%d: %d fused stages, %d unfused stages",
+                        highp, fused.getNumStages(), unfused.getNumStages());
+        fused.run(0,0,kWidth,1);
+        unfused.run(0,0,kWidth,1);
+        for (int i = 0; i < kWidth; i++) {
+            if (fusedPixels[i] != unfusedPixels[i]) {
+                ERRORF(r, "highp=%d, pixel %d: fused %08x, unfused %08x",
+                       highp, i, fusedPixels[i], unfusedPixels[i]);
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_FusedStages, r) {
+    static constexpr float kColor[4] = {0.25f, 0.5f, 0.125f, 0.75f};
+    static constexpr float kCoverage = 0.6f;
+    static constexpr float kScaleTranslate[4] = {1 / 37.0f, 1.0f, 0.1f, 0.0f};
+    static constexpr float kAffine[6] = {1 / 40.0f, 0.25f, 0.0f, 0.1f, 1.0f, 0.2f};
+    static const SkRasterPipeline_EvenlySpaced2StopGradientCtx kGradient = {
+            {0.5f, 0.25f, 1.0f, 0.0f},
+            {0.0f, 0.5f, 0.0f, 1.0f},
+    };
+
+    BuildStagesFn constantColor = [](SkRasterPipeline* p, SkArenaAlloc* alloc,
+                                     SkRasterPipeline_MemoryCtx*) {
+        p->appendConstantColor(alloc, kColor);
+    };
+
+    // A solid SrcOver blit: the clamp is dropped and the color is fused into srcover_rgba_8888.
+    test_fused_stages(r, constantColor,
+                      [](SkRasterPipeline* p, SkArenaAlloc*, SkRasterPipeline_MemoryCtx* dst) {
+                          p->append(SkRasterPipelineOp::clamp_01);
+                          p->append(SkRasterPipelineOp::srcover_rgba_8888, dst);
+                      },
+                      /*stagesSaved=*/2);
+
+    // An anti-aliased SrcOver blit: load_8888_dst, srcover, and store_8888 become one stage.
+    test_fused_stages(r,
+                      [](SkRasterPipeline* p, SkArenaAlloc* alloc,
+                         SkRasterPipeline_MemoryCtx* dst) {
+                          p->appendConstantColor(alloc, kColor);
+                          p->append(SkRasterPipelineOp::scale_1_float,
+                                    const_cast<float*>(&kCoverage));
+                          p->append(SkRasterPipelineOp::load_8888_dst, dst);
+                      },
+                      [](SkRasterPipeline* p, SkArenaAlloc*, SkRasterPipeline_MemoryCtx* dst) {
+                          p->append(SkRasterPipelineOp::srcover);
+                          p->append(SkRasterPipelineOp::store_8888, dst);
+                      },
+                      /*stagesSaved=*/2);
+
+    // Gradient shaders: seed_shader is fused with the matrix that follows it.
+    for (const float* matrix : {kScaleTranslate, kAffine}) {
+        test_fused_stages(r,
+                          [](SkRasterPipeline* p, SkArenaAlloc*, SkRasterPipeline_MemoryCtx*) {
+                              p->append(SkRasterPipelineOp::seed_shader);
+                          },
+                          [matrix](SkRasterPipeline* p, SkArenaAlloc*,
+                                   SkRasterPipeline_MemoryCtx* dst) {
+                              p->append(matrix == kAffine
+                                                ? SkRasterPipelineOp::matrix_2x3
+                                                : SkRasterPipelineOp::matrix_scale_translate,
+                                        const_cast<float*>(matrix));
+                              p->append(SkRasterPipelineOp::evenly_spaced_2_stop_gradient,
+                                        const_cast<SkRasterPipeline_EvenlySpaced2StopGradientCtx*>(
+                                                &kGradient));
+                              p->append(SkRasterPipelineOp::store_8888, dst);
+                          },
+                          /*stagesSaved=*/1);
+    }
+}
+
 // Helper struct that can be used to scrape stack addresses at different points in a pipeline
 class StackCheckerCtx : SkRasterPipeline_CallbackCtx {
 public:
@@ -14,6 +14,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
@@ -1241,6 +1242,52 @@ DEF_TEST(SkRuntimeShaderBuilderSetUniforms, r) {
     auto shader = b.makeShader();
 }
 
+DEF_TEST(SkRuntimeUniformBlock, r) {
+    const char* kSource = R"(
+        uniform half4 color;
+        half4 main(float2 p) { return color; }
+    )";
+
+    sk_sp<SkRuntimeEffect> effect = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    REPORTER_ASSERT(r, effect);
+
+    REPORTER_ASSERT(r, !SkRuntimeUniformBlock::Make(effect, SkData::MakeEmpty()));
+    sk_sp<SkRuntimeUniformBlock> block = SkRuntimeUniformBlock::Make(effect);
+    REPORTER_ASSERT(r, block);
+    REPORTER_ASSERT(r, !block->set("color", 1.0f));
+    REPORTER_ASSERT(r, !block->set("missing", SkColors::kRed));
+
+    sk_sp<SkSurface> surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(2, 2));
+    SkPaint paint;
+    paint.setShader(block->makeShader());
+
+    // The same paint draws with whatever the block holds when it's drawn.
+    for (SkColor4f color : {SkColors::kRed, SkColors::kGreen, SkColors::kBlue}) {
+        REPORTER_ASSERT(r, block->set("color", color));
+        surface->getCanvas()->drawPaint(paint);
+        SkColor pixel;
+        SkImageInfo info = SkImageInfo::Make(1, 1, kBGRA_8888_SkColorType, kUnpremul_SkAlphaType);
+        REPORTER_ASSERT(r, surface->readPixels(info, &pixel, sizeof(pixel), 0, 0));
+        REPORTER_ASSERT(r, pixel == color.toSkColor(), "Expected 0x%08x, got 0x%08x",
+                        color.toSkColor(), pixel);
+    }
+
+    // Once no draw holds on to the values, setting them doesn't allocate.
+    const void* before = block->uniforms()->data();
+    REPORTER_ASSERT(r, block->set("color", SkColors::kWhite));
+    REPORTER_ASSERT(r, block->uniforms()->data() == before);
+
+    // But values a draw (or anyone else) holds on to don't change.
+    sk_sp<const SkData> held = block->uniforms();
+    REPORTER_ASSERT(r, block->set("color", SkColors::kBlack));
+    REPORTER_ASSERT(r, !memcmp(held->data(), &SkColors::kWhite, sizeof(SkColor4f)));
+    REPORTER_ASSERT(r, !memcmp(block->uniforms()->data(), &SkColors::kBlack, sizeof(SkColor4f)));
+
+    REPORTER_ASSERT(r, block->setUniforms(held));
+    REPORTER_ASSERT(r, !block->setUniforms(SkData::MakeEmpty()));
+    REPORTER_ASSERT(r, !memcmp(block->uniforms()->data(), &SkColors::kWhite, sizeof(SkColor4f)));
+}
+
 DEF_TEST(SkRuntimeEffectThreaded, r) {
     // This tests that we can safely use SkRuntimeEffect::MakeForShader from more than one thread,
     // and also that programs don't refer to shared structures owned by the compiler.
@@ -1262,6 +1309,61 @@ DEF_TEST(SkRuntimeEffectThreaded, r) {
     }
 }
 
+DEF_SERIAL_TEST(SkRuntimeEffectCache, r) {
+    static constexpr char kSource[] = "half4 main(float2 p) { return half4(half2(p), 0, 1); }";
+    const int prevLimit = SkGraphics::SetRuntimeEffectCacheCountLimit(0);
+
+    // With no cache, every call compiles a new effect.
+    sk_sp<SkRuntimeEffect> a = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    sk_sp<SkRuntimeEffect> b = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    REPORTER_ASSERT(r, a && b && a != b);
+
+    // With a cache, the same SkSL, program kind and options return the same effect.
+    SkGraphics::SetRuntimeEffectCacheCountLimit(100);
+    a = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    b = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    REPORTER_ASSERT(r, a && a == b);
+
+    SkRuntimeEffect::Options unoptimized;
+    unoptimized.forceUnoptimized = true;
+    b = SkRuntimeEffect::MakeForShader(SkString(kSource), unoptimized).effect;
+    REPORTER_ASSERT(r, b && a != b);
+
+    static constexpr char kBlender[] = "half4 main(half4 src, half4 dst) { return src; }";
+    sk_sp<SkRuntimeEffect> blender = SkRuntimeEffect::MakeForBlender(SkString(kBlender)).effect;
+    REPORTER_ASSERT(r, blender && blender->allowBlender());
+    REPORTER_ASSERT(r, !SkRuntimeEffect::MakeForShader(SkString(kBlender)).effect);
+
+    // Errors are reported every time.
+    for (int i = 0; i < 2; ++i) {
+        auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString("half4 main() {"));
+        REPORTER_ASSERT(r, !effect && !error.isEmpty());
+    }
+
+    // The cache can be shared by several threads.
+    std::thread threads[8];
+    for (auto& thread : threads) {
+        thread = std::thread([r, a]() {
+            for (int i = 0; i < 10; ++i) {
+                auto effect = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+                REPORTER_ASSERT(r, effect == a);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Purging or disabling the cache drops the effects.
+    SkGraphics::PurgeAllCaches();
+    REPORTER_ASSERT(r, SkRuntimeEffect::MakeForShader(SkString(kSource)).effect != a);
+    a = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    SkGraphics::SetRuntimeEffectCacheCountLimit(0);
+    REPORTER_ASSERT(r, SkRuntimeEffect::MakeForShader(SkString(kSource)).effect != a);
+
+    SkGraphics::SetRuntimeEffectCacheCountLimit(prevLimit);
+}
+
 DEF_TEST(SkRuntimeEffectAllowsPrivateAccess, r) {
     SkRuntimeEffect::Options defaultOptions;
     SkRuntimeEffect::Options optionsWithAccess;
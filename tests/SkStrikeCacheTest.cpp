@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
@@ -16,10 +17,13 @@
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <vector>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
     SkStrikeCache cache;
 
@@ -58,6 +62,42 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
         REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
     }
     REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(SkStrikeCache_Threaded, Reporter) {
+    SkStrikeCache cache;
 
+    static constexpr int kStrikeCount = 32;
+    static constexpr int kThreadCount = 4;
+
+    SkFont font = ToolUtils::DefaultPortableFont();
+    SkPaint defaultPaint;
+    std::vector<SkStrikeSpec> specs;
+    for (int i = 0; i < kStrikeCount; ++i) {
+        font.setSize(8 + i);
+        specs.push_back(SkStrikeSpec::MakeMask(
+                font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I()));
+    }
 
+    // Every thread asks for every strike, so each strike is found or created by several threads.
+    auto executor = SkExecutor::MakeFIFOThreadPool(kThreadCount);
+    SkTaskGroup(*executor).batch(kThreadCount * kStrikeCount, [&](int i) {
+        const SkStrikeSpec& spec = specs[i % kStrikeCount];
+        sk_sp<SkStrike> strike = spec.findOrCreateStrike(&cache);
+        REPORTER_ASSERT(Reporter, strike->getDescriptor() == spec.descriptor());
+    });
+
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == kStrikeCount);
+    for (const SkStrikeSpec& spec : specs) {
+        REPORTER_ASSERT(Reporter, cache.findStrike(spec.descriptor()) != nullptr);
+    }
+
+    // Shrinking the count budget is enforced across all the shards.
+    cache.setCacheCountLimit(kStrikeCount / 2);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() <= kStrikeCount / 2);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
 }
@@ -43,6 +43,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <memory>
@@ -195,6 +196,52 @@ public:
     }
 };
 
+DEF_TEST(SkStrike_PrerasterizeImages, reporter) {
+    SkFont font = ToolUtils::DefaultPortableFont();
+    font.setSize(24);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+
+    STArray<128, SkPackedGlyphID> glyphIDs;
+    for (SkUnichar c = ' '; c < 0x7f; ++c) {
+        glyphIDs.push_back(SkPackedGlyphID{font.unicharToGlyph(c)});
+    }
+    // Repeated glyphs are only rasterized once.
+    glyphIDs.push_back(glyphIDs.front());
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+    SkStrikeCache strikeCache;
+    SkStrike expected{&strikeCache, strikeSpec, strikeSpec.createScalerContext(), nullptr,
+                      nullptr};
+    SkStrike actual{&strikeCache, strikeSpec, strikeSpec.createScalerContext(), nullptr,
+                    nullptr};
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    actual.prerasterizeImages(glyphIDs, executor.get());
+
+    for (SkPackedGlyphID glyphID : glyphIDs) {
+        SkGlyph* glyph = SkStrikeTestingPeer::GetGlyph(&actual, glyphID);
+        REPORTER_ASSERT(reporter, glyph->setImageHasBeenCalled());
+    }
+
+    TArray<const SkGlyph*> expectedGlyphs(glyphIDs.size()), actualGlyphs(glyphIDs.size());
+    expectedGlyphs.resize(glyphIDs.size());
+    actualGlyphs.resize(glyphIDs.size());
+    expected.prepareImages(glyphIDs, expectedGlyphs.data());
+    actual.prepareImages(glyphIDs, actualGlyphs.data());
+    for (int i = 0; i < glyphIDs.size(); ++i) {
+        const SkGlyph* e = expectedGlyphs[i];
+        const SkGlyph* a = actualGlyphs[i];
+        REPORTER_ASSERT(reporter, e->iRect() == a->iRect());
+        REPORTER_ASSERT(reporter, (e->image() == nullptr) == (a->image() == nullptr));
+        if (e->image() && a->image()) {
+            REPORTER_ASSERT(reporter, memcmp(e->image(), a->image(), e->imageSize()) == 0);
+        }
+    }
+}
+
 DEF_TEST(SkStrike_FlattenByType, reporter) {
     std::vector<SkGlyph> imagesToSend;
     std::vector<SkGlyph> pathsToSend;
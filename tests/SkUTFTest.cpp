@@ -5,10 +5,12 @@
 #include "src/base/SkUTF.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <vector>
 
 DEF_TEST(SkUTF_UTF16, reporter) {
     // Test non-basic-multilingual-plane unicode.
@@ -146,3 +148,55 @@ DEF_TEST(SkUTF_NextUTF8_ToUTF8, r) {
 #undef LEADING_THREE_BYTE
 #undef LEADING_FOUR_BYTE
 #undef INVALID_BYTE
+
+// Long enough runs of ASCII are counted and converted a block at a time.
+DEF_TEST(SkUTF_LongText, r) {
+    static const char* kStrings[] = {
+        "The quick brown fox jumps over the lazy dog, then the lazy dog gets up and leaves.",
+        "0123456789abcdef\xC3\xA9""0123456789abcdef\xE2\x80\x94\xF0\x9F\x98\x80 and more ASCII",
+        "\xF0\x9F\x98\x80""0123456789abcdefghijklmnopqrstuvwxyz",
+    };
+    for (const char* utf8 : kStrings) {
+        const size_t length = strlen(utf8);
+
+        // Decode one character at a time, to check the block paths against.
+        std::vector<uint16_t> expected16;
+        int count = 0;
+        for (const char* ptr = utf8; ptr < utf8 + length; ++count) {
+            uint16_t units[2];
+            size_t unitCount = SkUTF::ToUTF16(SkUTF::NextUTF8(&ptr, utf8 + length), units);
+            expected16.insert(expected16.end(), units, units + unitCount);
+        }
+        const int length16 = (int)expected16.size();
+        REPORTER_ASSERT(r, SkUTF::CountUTF8(utf8, length) == count);
+        REPORTER_ASSERT(r, SkUTF::CountUTF16(expected16.data(), length16 * 2) == count);
+        REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16(nullptr, 0, utf8, length) == length16);
+        REPORTER_ASSERT(r, SkUTF::UTF16ToUTF8(nullptr, 0, expected16.data(), length16) ==
+                           (int)length);
+
+        // Every capacity, so that the output is cut off inside and outside of blocks.
+        for (int capacity = 0; capacity <= length16; ++capacity) {
+            std::vector<uint16_t> utf16(length16 + 1, 0xFFFF);
+            REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16(utf16.data(), capacity, utf8, length) ==
+                               length16);
+            REPORTER_ASSERT(r, std::equal(utf16.begin(), utf16.begin() + capacity,
+                                          expected16.begin()));
+            REPORTER_ASSERT(r, utf16[capacity] == 0xFFFF);
+        }
+        for (int capacity = 0; capacity <= (int)length; ++capacity) {
+            std::vector<char> roundTrip(length + 1, '!');
+            REPORTER_ASSERT(r, SkUTF::UTF16ToUTF8(roundTrip.data(), capacity, expected16.data(),
+                                                  length16) == (int)length);
+            REPORTER_ASSERT(r, 0 == memcmp(roundTrip.data(), utf8, capacity));
+            REPORTER_ASSERT(r, roundTrip[capacity] == '!');
+        }
+    }
+
+    // Invalid text just past a block of ASCII.
+    static constexpr char kBadUTF8[] = "0123456789abcdef\x80";
+    REPORTER_ASSERT(r, SkUTF::CountUTF8(kBadUTF8, strlen(kBadUTF8)) == -1);
+    REPORTER_ASSERT(r, SkUTF::UTF8ToUTF16(nullptr, 0, kBadUTF8, strlen(kBadUTF8)) == -1);
+    static constexpr uint16_t kBadUTF16[] = {'0', '1', '2', '3', '4', '5', '6', 0xDC00, '8'};
+    REPORTER_ASSERT(r, SkUTF::CountUTF16(kBadUTF16, sizeof(kBadUTF16)) == -1);
+    REPORTER_ASSERT(r, SkUTF::UTF16ToUTF8(nullptr, 0, kBadUTF16, std::size(kBadUTF16)) == -1);
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkRect.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+
+class AutoSparseStrips {
+public:
+    explicit AutoSparseStrips(bool enabled)
+            : fWasEnabled(SkGraphics::SetSparseStripPathRasterizer(enabled)) {}
+    ~AutoSparseStrips() { SkGraphics::SetSparseStripPathRasterizer(fWasEnabled); }
+
+private:
+    bool fWasEnabled;
+};
+
+SkBitmap draw(int size, const std::function<void(SkCanvas*)>& drawFn) {
+    AutoSparseStrips autoStrips(true);
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(size, size));
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    drawFn(&canvas);
+    return bitmap;
+}
+
+int coverage(SkColor color) {
+    return 255 - SkColorGetR(color);
+}
+
+struct Errors {
+    int fMax = 0;
+    double fMean = 0;
+};
+
+// Compares the sparse strip fill of a path to its coverage sampled on a grid in each pixel, for
+// every 'step'th pixel in x and y. 'clip' is applied as a non-AA clip.
+Errors compare_to_samples(const SkPath& path,
+                          const SkIRect& clip,
+                          int size,
+                          int samples,
+                          int step = 1) {
+    SkBitmap strips = draw(size, [&](SkCanvas* canvas) {
+        canvas->clipIRect(clip);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        canvas->drawPath(path, paint);
+    });
+    Errors errors;
+    int count = 0;
+    for (int y = 0; y < size; y += step) {
+        for (int x = 0; x < size; x += step) {
+            const int actual = coverage(strips.getColor(x, y));
+            const bool corners[] = {path.contains(x, y), path.contains(x + 1, y),
+                                    path.contains(x, y + 1), path.contains(x + 1, y + 1)};
+            const bool uniform = corners[0] == corners[1] && corners[0] == corners[2] &&
+                                 corners[0] == corners[3];
+            int expected = 0;
+            if (uniform && actual == (corners[0] && clip.contains(x, y) ? 255 : 0)) {
+                // Skip sampling pixels that are clearly inside or outside of the path.
+                expected = actual;
+            } else if (clip.contains(x, y)) {
+                int inside = 0;
+                for (int j = 0; j < samples; ++j) {
+                    for (int i = 0; i < samples; ++i) {
+                        inside += path.contains(x + (i + 0.5f) / samples,
+                                                y + (j + 0.5f) / samples);
+                    }
+                }
+                expected = inside * 255 / (samples * samples);
+            }
+            int error = std::abs(expected - actual);
+            errors.fMax = std::max(errors.fMax, error);
+            errors.fMean += error;
+            count++;
+        }
+    }
+    errors.fMean /= count;
+    return errors;
+}
+
+// Paths without self intersections should be within the flattening tolerance (1/16 of a pixel)
+// and the accuracy of a 32x32 sample grid (1/32 of a pixel) of their exact coverage.
+void check_coverage(skiatest::Reporter* r,
+                    const char* name,
+                    const SkPath& path,
+                    const SkIRect& clip = SkIRect::MakeWH(64, 64)) {
+    Errors errors = compare_to_samples(path, clip, 64, 32);
+    REPORTER_ASSERT(r, errors.fMax <= 24, "%s: max error %d", name, errors.fMax);
+}
+
+SkPath star(int points, SkScalar cx, SkScalar cy, SkScalar outer, SkScalar inner) {
+    SkPath path;
+    for (int i = 0; i < 2 * points; ++i) {
+        SkScalar angle = SK_ScalarPI * i / points;
+        SkScalar radius = (i & 1) ? inner : outer;
+        SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+        i == 0 ? path.moveTo(pt) : path.lineTo(pt);
+    }
+    path.close();
+    return path;
+}
+
+// A star polygon whose edges cross each other.
+SkPath self_intersecting_star(int points, SkScalar cx, SkScalar cy, SkScalar radius) {
+    SkPath path;
+    for (int i = 0; i < points; ++i) {
+        SkScalar angle = SK_ScalarPI * 2 * (i * (points / 2)) / points;
+        SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+        i == 0 ? path.moveTo(pt) : path.lineTo(pt);
+    }
+    path.close();
+    return path;
+}
+
+SkPath random_polygon(int edges, SkScalar size) {
+    SkRandom rand;
+    SkPath path;
+    path.moveTo(size / 2, size / 2);
+    for (int i = 0; i < edges; ++i) {
+        path.lineTo(rand.nextRangeF(0, size), rand.nextRangeF(0, size));
+    }
+    return path;
+}
+
+}  // anonymous namespace
+
+DEF_TEST(SparseStripPathRasterizer_Coverage, r) {
+    check_coverage(r, "star", star(9, 31.6f, 32.3f, 29, 11.5f));
+    check_coverage(r, "circle", SkPath::Circle(32.4f, 31.7f, 27.3f));
+
+    SkPath curves;
+    curves.moveTo(4, 40);
+    curves.cubicTo(10, -10, 50, -10, 60, 40);
+    curves.quadTo(32, 70, 4, 40);
+    check_coverage(r, "curves", curves);
+
+    // Both rings wind the same way, so only even-odd leaves a hole.
+    SkPath rings = SkPath::Circle(32, 32, 28);
+    rings.addCircle(32.5f, 31.5f, 14);
+    check_coverage(r, "nonzero rings", rings);
+    rings.setFillType(SkPathFillType::kEvenOdd);
+    check_coverage(r, "even-odd rings", rings);
+
+    // The triangle crosses the left, top and right edges of the bitmap.
+    SkPath offscreen;
+    offscreen.moveTo(-40.3f, 50.2f);
+    offscreen.lineTo(30.1f, -25.6f);
+    offscreen.lineTo(101.7f, 60.9f);
+    offscreen.close();
+    check_coverage(r, "offscreen", offscreen);
+    check_coverage(r, "clipped", offscreen, SkIRect::MakeLTRB(2, 1, 40, 58));
+}
+
+// Pixels where edges cross only approximate their coverage, so self-intersecting paths are
+// checked on average.
+DEF_TEST(SparseStripPathRasterizer_SelfIntersecting, r) {
+    for (SkPathFillType fillType : {SkPathFillType::kWinding, SkPathFillType::kEvenOdd}) {
+        SkPath paths[] = {self_intersecting_star(7, 32.5f, 31.25f, 30), random_polygon(50, 64)};
+        for (SkPath& path : paths) {
+            path.setFillType(fillType);
+            Errors errors = compare_to_samples(path, SkIRect::MakeWH(64, 64), 64, 16);
+            REPORTER_ASSERT(r, errors.fMean <= 4, "mean error %g", errors.fMean);
+        }
+    }
+}
+
+// A path with enough tiles to be rasterized in batches of tile rows.
+DEF_TEST(SparseStripPathRasterizer_ManyEdges, r) {
+    SkPath path = random_polygon(1000, 300);
+    Errors errors = compare_to_samples(path, SkIRect::MakeWH(300, 300), 300, 8, /*step=*/7);
+    REPORTER_ASSERT(r, errors.fMean <= 8, "mean error %g", errors.fMean);
+}
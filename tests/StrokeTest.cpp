@@ -13,12 +13,14 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkStrokeRec.h"
 #include "src/base/SkFloatBits.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkPathPriv.h"
 #include "tests/Test.h"
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 static bool equal(const SkRect& a, const SkRect& b) {
     return  SkScalarNearlyEqual(a.left(), b.left()) &&
@@ -186,9 +188,58 @@ static void test_big_stroke(skiatest::Reporter* reporter) {
     skpathutils::FillPathWithPaint(path, paint, &strokeAndFillPath);
 }
 
+// Paths with enough contours are split into parts that are stroked in parallel. The stroke should be
+// exactly the strokes of the contours, in order. (Open contours that end in a line are left out,
+// since the cap at their end depends on whether they end the path.)
+static void test_stroke_many_contours(skiatest::Reporter* reporter) {
+    SkRandom rand;
+    auto pt = [&] { return SkPoint{rand.nextRangeF(0, 500), rand.nextRangeF(0, 500)}; };
+
+    SkPath path;
+    std::vector<SkPath> contours;
+    for (int i = 0; i < 600; ++i) {
+        SkPath contour;
+        contour.moveTo(pt());
+        for (int j = 0; j < 5; ++j) {
+            switch (rand.nextULessThan(4)) {
+                case 0: contour.lineTo(pt()); break;
+                case 1: contour.quadTo(pt(), pt()); break;
+                case 2: contour.conicTo(pt(), pt(), rand.nextRangeF(0.25f, 2)); break;
+                case 3: contour.cubicTo(pt(), pt(), pt()); break;
+            }
+        }
+        if (rand.nextBool()) {
+            contour.close();
+        } else {
+            contour.cubicTo(pt(), pt(), pt());
+        }
+        path.addPath(contour);
+        contours.push_back(contour);
+    }
+
+    for (SkPaint::Cap cap : {SkPaint::kButt_Cap, SkPaint::kRound_Cap, SkPaint::kSquare_Cap}) {
+        for (SkPaint::Join join : {SkPaint::kMiter_Join, SkPaint::kRound_Join}) {
+            SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+            rec.setStrokeStyle(9);
+            rec.setStrokeParams(cap, join, 4);
+
+            SkPath expected;
+            for (const SkPath& contour : contours) {
+                SkPath stroke;
+                rec.applyToPath(&stroke, contour);
+                expected.addPath(stroke, SkPath::kAppend_AddPathMode);
+            }
+            SkPath stroke;
+            REPORTER_ASSERT(reporter, rec.applyToPath(&stroke, path));
+            REPORTER_ASSERT(reporter, stroke == expected);
+        }
+    }
+}
+
 DEF_TEST(Stroke, reporter) {
     test_strokecubic(reporter);
     test_strokerect(reporter);
     test_strokerec_equality(reporter);
     test_big_stroke(reporter);
+    test_stroke_many_contours(reporter);
 }
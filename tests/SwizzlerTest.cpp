@@ -10,6 +10,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkSwizzle.h"
+#include "src/base/SkRandom.h"
 #include "src/codec/SkSampler.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "tests/Test.h"
@@ -160,6 +161,55 @@ DEF_TEST(PublicSwizzleOpts, r) {
     REPORTER_ASSERT(r, dst == 0xFA04B0CE);
 }
 
+// Each count covers a different mix of vector loops and tails, and the extra byte of src lets
+// the loads start at an odd address.
+DEF_TEST(SwizzleOpts_16BitAndIndex, r) {
+    SkRandom rand;
+    uint8_t src[8 * 67 + 1];
+    for (uint8_t& byte : src) {
+        byte = rand.nextU() & 0xFF;
+    }
+    uint32_t table[256];
+    for (uint32_t& color : table) {
+        color = rand.nextU();
+    }
+
+    auto pack = [](uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+        return a << 24 | b << 16 | g << 8 | r;
+    };
+    uint32_t dst[67];
+    for (int count = 0; count <= 67; ++count) {
+        for (int offset : {0, 1}) {
+            const uint8_t* s = src + offset;
+            bool rgba = true, bgra = true, rgb1 = true, bgr1 = true, index = true;
+
+            SkOpts::RGBA16_to_RGBA(dst, s, count);
+            for (int i = 0; i < count; ++i) {
+                rgba &= dst[i] == pack(s[8*i + 0], s[8*i + 2], s[8*i + 4], s[8*i + 6]);
+            }
+            SkOpts::RGBA16_to_BGRA(dst, s, count);
+            for (int i = 0; i < count; ++i) {
+                bgra &= dst[i] == pack(s[8*i + 4], s[8*i + 2], s[8*i + 0], s[8*i + 6]);
+            }
+            SkOpts::RGB16_to_RGB1(dst, s, count);
+            for (int i = 0; i < count; ++i) {
+                rgb1 &= dst[i] == pack(s[6*i + 0], s[6*i + 2], s[6*i + 4], 0xFF);
+            }
+            SkOpts::RGB16_to_BGR1(dst, s, count);
+            for (int i = 0; i < count; ++i) {
+                bgr1 &= dst[i] == pack(s[6*i + 4], s[6*i + 2], s[6*i + 0], 0xFF);
+            }
+            SkOpts::index_to_8888(dst, s, count, table);
+            for (int i = 0; i < count; ++i) {
+                index &= dst[i] == table[s[i]];
+            }
+            REPORTER_ASSERT(r, rgba && bgra && rgb1 && bgr1 && index,
+                            "count %d, offset %d: %d %d %d %d %d", count, offset, rgba, bgra,
+                            rgb1, bgr1, index);
+        }
+    }
+}
+
 using fn_reciprocal = float (*)(float);
 static void test_reciprocal_alpha(
         skiatest::Reporter* reporter,
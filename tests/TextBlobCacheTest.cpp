@@ -185,6 +185,11 @@ static void text_blob_cache_inner(skiatest::Reporter* reporter, GrDirectContext*
     draw(canvas, 2, blobs);
     draw(canvasNoLCD, 2, blobs);
 
+    // Every blob is cacheable, so each first draw must have been counted as a miss.
+    sktext::gpu::TextBlobRedrawCoordinator::Stats stats =
+            dContext->priv().getTextBlobCache()->stats();
+    REPORTER_ASSERT(reporter, stats.fMisses >= blobs.size());
+
     // test draw after free
     dContext->freeGpuResources();
     draw(canvas, 1, blobs);
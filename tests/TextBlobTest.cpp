@@ -35,7 +35,9 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <initializer_list>
 #include <string>
+#include <vector>
 
 using namespace skia_private;
 
@@ -150,7 +152,8 @@ public:
 
         {
             SkRect r1 = SkRect::MakeXYWH(10, 10, 20, 20);
-            builder.allocRunPos(font, 16, &r1);
+            const SkTextBlobBuilder::RunBuffer& buffer = builder.allocRunPos(font, 16, &r1);
+            memset(buffer.pos, 0, sizeof(SkScalar) * 16 * 2);
             sk_sp<SkTextBlob> blob(builder.make());
             REPORTER_ASSERT(reporter, blob->bounds() == r1);
         }
@@ -162,7 +165,8 @@ public:
 
             builder.allocRun(font, 16, 0, 0, &r1);
             builder.allocRunPosH(font, 16, 0, &r2);
-            builder.allocRunPos(font, 16, &r3);
+            const SkTextBlobBuilder::RunBuffer& buffer = builder.allocRunPos(font, 16, &r3);
+            memset(buffer.pos, 0, sizeof(SkScalar) * 16 * 2);
 
             sk_sp<SkTextBlob> blob(builder.make());
             REPORTER_ASSERT(reporter, blob->bounds() == SkRect::MakeXYWH(0, 5, 65, 65));
@@ -382,6 +386,16 @@ static void add_run(SkTextBlobBuilder* builder, const char text[], SkScalar x, S
     (void)font.textToGlyphs(text, strlen(text), SkTextEncoding::kUTF8, buffer.glyphs, glyphCount);
 }
 
+static void AddPosRun(SkTextBlobBuilder* builder, const SkFont& font,
+                      std::initializer_list<SkPoint> points) {
+    const SkTextBlobBuilder::RunBuffer& buffer = builder->allocRunPos(font, points.size());
+    int i = 0;
+    for (SkPoint point : points) {
+        buffer.glyphs[i] = i;
+        buffer.points()[i++] = point;
+    }
+}
+
 static sk_sp<SkImage> render(const SkTextBlob* blob) {
     SkASSERT(blob);
     auto surf = SkSurfaces::Raster(
@@ -471,13 +485,99 @@ DEF_TEST(TextBlob_MakeAsDrawText, reporter) {
     int runs = 0;
     for(SkTextBlobRunIterator it(blob.get()); !it.done(); it.next()) {
         REPORTER_ASSERT(reporter, it.glyphCount() == strlen(text));
-        REPORTER_ASSERT(reporter, it.positioning() == SkTextBlobRunIterator::kFull_Positioning);
+        // The glyphs are all on the baseline, so they're stored with horizontal positioning.
+        REPORTER_ASSERT(reporter,
+                        it.positioning() == SkTextBlobRunIterator::kHorizontal_Positioning);
         runs += 1;
     }
     REPORTER_ASSERT(reporter, runs == 1);
 
 }
 
+DEF_TEST(TextBlob_compactFullPositioning, reporter) {
+    SkFont font = ToolUtils::DefaultFont();
+    SkTextBlobBuilder builder;
+
+    // Glyphs on one baseline, with text and clusters that have to move with the run.
+    const char text[] = "Hello";
+    const SkTextBlobBuilder::RunBuffer& buffer = builder.allocRunTextPos(font, 3, 5);
+    for (int i = 0; i < 3; ++i) {
+        buffer.glyphs[i] = i + 1;
+        buffer.pos[i * 2] = 10.f * i;
+        buffer.pos[i * 2 + 1] = 20;
+        buffer.clusters[i] = i * 2;
+    }
+    memcpy(buffer.utf8text, text, 5);
+
+    // Glyphs that aren't on one baseline stay fully positioned.
+    AddPosRun(&builder, font, {{0, 30}, {10, 31}});
+    // A following run (in another font, so that it isn't merged with the last), that has to move
+    // down over the storage freed by the first.
+    SkFont otherFont = font;
+    otherFont.setSize(font.getSize() + 1);
+    AddPosRun(&builder, otherFont, {{5, 40}, {15, 40}});
+
+    sk_sp<SkTextBlob> blob = builder.make();
+    SkTextBlobRunIterator it(blob.get());
+
+    REPORTER_ASSERT(reporter, it.positioning() == SkTextBlobRunIterator::kHorizontal_Positioning);
+    REPORTER_ASSERT(reporter, it.glyphCount() == 3);
+    REPORTER_ASSERT(reporter, it.offset() == SkPoint::Make(0, 20));
+    for (int i = 0; i < 3; ++i) {
+        REPORTER_ASSERT(reporter, it.glyphs()[i] == i + 1);
+        REPORTER_ASSERT(reporter, it.pos()[i] == 10.f * i);
+        REPORTER_ASSERT(reporter, it.clusters()[i] == SkToU32(i * 2));
+    }
+    REPORTER_ASSERT(reporter, it.textSize() == 5);
+    REPORTER_ASSERT(reporter, !memcmp(it.text(), text, 5));
+
+    it.next();
+    REPORTER_ASSERT(reporter, it.positioning() == SkTextBlobRunIterator::kFull_Positioning);
+    REPORTER_ASSERT(reporter, it.points()[1] == SkPoint::Make(10, 31));
+
+    it.next();
+    REPORTER_ASSERT(reporter, it.positioning() == SkTextBlobRunIterator::kHorizontal_Positioning);
+    REPORTER_ASSERT(reporter, it.offset() == SkPoint::Make(0, 40));
+    REPORTER_ASSERT(reporter, it.pos()[0] == 5 && it.pos()[1] == 15);
+
+    it.next();
+    REPORTER_ASSERT(reporter, it.done());
+}
+
+DEF_TEST(TextBlob_builderReuse, reporter) {
+    SkFont font = ToolUtils::DefaultFont();
+    SkTextBlobBuilder builder;
+
+    // Runs that are reset are dropped.
+    AddPosRun(&builder, font, {{0, 0}, {10, 0}});
+    builder.reset();
+    REPORTER_ASSERT(reporter, !builder.make());
+
+    // Blobs from a reused builder only have their own runs, and outlive the builder's storage.
+    std::vector<sk_sp<SkTextBlob>> blobs;
+    for (int runCount = 1; runCount < 20; ++runCount) {
+        for (int i = 0; i < runCount; ++i) {
+            // Alternate fonts, so that the runs aren't merged.
+            font.setSize(10 + i % 2);
+            AddPosRun(&builder, font, {{0, SkIntToScalar(runCount)}, {10, SkIntToScalar(i)}});
+        }
+        blobs.push_back(builder.make());
+        if (runCount % 2) {
+            AddPosRun(&builder, font, {{0, 0}});
+            builder.reset();
+        }
+    }
+    for (int runCount = 1; runCount < 20; ++runCount) {
+        int runs = 0;
+        for (SkTextBlobRunIterator it(blobs[runCount - 1].get()); !it.done(); it.next()) {
+            REPORTER_ASSERT(reporter, it.points()[0] == SkPoint::Make(0, runCount));
+            REPORTER_ASSERT(reporter, it.points()[1] == SkPoint::Make(10, runs));
+            runs += 1;
+        }
+        REPORTER_ASSERT(reporter, runs == runCount);
+    }
+}
+
 DEF_TEST(TextBlob_iter, reporter) {
     sk_sp<SkTypeface> tf = ToolUtils::CreateTestTypeface(nullptr, SkFontStyle::BoldItalic());
 
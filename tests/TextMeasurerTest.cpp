@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkFont.h"
+#include "include/core/SkFontTypes.h"
+#include "include/core/SkScalar.h"
+#include "include/utils/SkTextMeasurer.h"
+#include "src/base/SkUTF.h"
+#include "tests/Test.h"
+#include "tools/fonts/FontToolUtils.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Every encoding of every string, long enough to take the ASCII and Latin-1 fast paths and with
+// characters that don't.
+static const char* kStrings[] = {
+    "",
+    "a",
+    "Hello, World!",
+    "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog.",
+    "Caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9\x65 \xC3\xA0 la fran\xC3\xA7\x61ise, s'il vous pla\xC3\xAEt",
+    "mixed \xE2\x80\x94 dashes \xE2\x80\x94 and \xF0\x9F\x98\x80 emoji, then plain ASCII to finish",
+};
+
+static void check_matches_font(skiatest::Reporter* r, const SkFont& font,
+                               SkTextMeasurer* measurer, const void* text, size_t byteLength,
+                               SkTextEncoding encoding) {
+    const SkScalar expectedWidth = font.measureText(text, byteLength, encoding);
+    // Measure twice, the second time with everything cached.
+    for (int pass = 0; pass < 2; ++pass) {
+        REPORTER_ASSERT(r, measurer->measureText(text, byteLength, encoding) == expectedWidth);
+    }
+
+    const int count = font.countText(text, byteLength, encoding);
+    std::vector<SkGlyphID> glyphs(count);
+    font.textToGlyphs(text, byteLength, encoding, glyphs.data(), count);
+    std::vector<SkScalar> expectedWidths(count);
+    font.getWidths(glyphs.data(), count, expectedWidths.data());
+
+    std::vector<SkScalar> widths(count);
+    REPORTER_ASSERT(r, measurer->getWidths(text, byteLength, encoding, widths.data(), count) ==
+                       count);
+    REPORTER_ASSERT(r, widths == expectedWidths);
+    // Too small an array just returns the count.
+    if (count > 0) {
+        REPORTER_ASSERT(r, measurer->getWidths(text, byteLength, encoding, widths.data(),
+                                               count - 1) == count);
+    }
+}
+
+DEF_TEST(TextMeasurer_MatchesFont, r) {
+    for (SkScalar size : {12.f, 97.f, 300.f}) {  // 300 is measured with a scaled down strike.
+        SkFont font(ToolUtils::DefaultPortableTypeface(), size);
+        SkTextMeasurer measurer(font);
+
+        for (const char* utf8 : kStrings) {
+            const size_t length = strlen(utf8);
+            check_matches_font(r, font, &measurer, utf8, length, SkTextEncoding::kUTF8);
+
+            const int count = SkUTF::CountUTF8(utf8, length);
+            std::vector<SkUnichar> utf32;
+            for (const char* ptr = utf8; ptr < utf8 + length;) {
+                utf32.push_back(SkUTF::NextUTF8(&ptr, utf8 + length));
+            }
+            REPORTER_ASSERT(r, (int)utf32.size() == count);
+            check_matches_font(r, font, &measurer, utf32.data(), utf32.size() * sizeof(SkUnichar),
+                               SkTextEncoding::kUTF32);
+
+            std::vector<uint16_t> utf16;
+            for (SkUnichar uni : utf32) {
+                uint16_t units[2];
+                size_t unitCount = SkUTF::ToUTF16(uni, units);
+                utf16.insert(utf16.end(), units, units + unitCount);
+            }
+            check_matches_font(r, font, &measurer, utf16.data(), utf16.size() * sizeof(uint16_t),
+                               SkTextEncoding::kUTF16);
+
+            std::vector<SkGlyphID> glyphs(count);
+            font.textToGlyphs(utf8, length, SkTextEncoding::kUTF8, glyphs.data(), count);
+            check_matches_font(r, font, &measurer, glyphs.data(), glyphs.size() * sizeof(SkGlyphID),
+                               SkTextEncoding::kGlyphID);
+        }
+    }
+}
+
+DEF_TEST(TextMeasurer_InvalidText, r) {
+    SkFont font(ToolUtils::DefaultPortableTypeface(), 12);
+    SkTextMeasurer measurer(font);
+
+    // A stray continuation byte, after enough ASCII to take the fast path first.
+    static constexpr char kBadUTF8[] = "0123456789abcdefghij\x80";
+    REPORTER_ASSERT(r, measurer.measureText(kBadUTF8, strlen(kBadUTF8), SkTextEncoding::kUTF8) ==
+                       0);
+    SkScalar widths[32];
+    REPORTER_ASSERT(r, measurer.getWidths(kBadUTF8, strlen(kBadUTF8), SkTextEncoding::kUTF8,
+                                          widths, 32) == 0);
+
+    // An unpaired surrogate.
+    static constexpr uint16_t kBadUTF16[] = {'a', 'b', 0xD800, 'c'};
+    REPORTER_ASSERT(r, measurer.measureText(kBadUTF16, sizeof(kBadUTF16),
+                                            SkTextEncoding::kUTF16) == 0);
+}
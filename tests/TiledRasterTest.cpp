@@ -0,0 +1,185 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/utils/SkTiledRaster.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+#include "tools/ToolUtils.h"
+
+#include <memory>
+
+static sk_sp<SkPicture> make_picture(SkBBHFactory* bbh) {
+    const SkRect bounds = SkRect::MakeWH(300, 200);
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(bounds, bbh);
+
+    SkRandom rand;
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 50; ++i) {
+        paint.setColor(rand.nextU() | 0xFF000000);
+        SkRect r = SkRect::MakeXYWH(rand.nextRangeF(-20, 280), rand.nextRangeF(-20, 180),
+                                    rand.nextRangeF(5, 90), rand.nextRangeF(5, 90));
+        if (i % 3 == 0) {
+            canvas->drawOval(r, paint);
+        } else {
+            canvas->drawRect(r, paint);
+        }
+    }
+
+    // A dithered gradient and a layer straddle many tiles; both depend on device coordinates.
+    const SkPoint pts[] = {{0, 0}, {300, 200}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    SkPaint gradient;
+    gradient.setDither(true);
+    gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                    SkTileMode::kClamp));
+    canvas->saveLayerAlpha(nullptr, 0x80);
+    canvas->drawCircle(150, 100, 90, gradient);
+    canvas->restore();
+
+    SkPath path;
+    path.moveTo(10, 190).cubicTo(100, -50, 200, 250, 290, 10);
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(7);
+    canvas->drawPath(path, paint);
+
+    return recorder.finishRecordingAsPicture();
+}
+
+static SkBitmap draw_reference(const SkPicture* picture, const SkMatrix* matrix) {
+    SkBitmap bm;
+    bm.allocN32Pixels(300, 200);
+    bm.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bm);
+    canvas.drawPicture(picture, matrix, nullptr);
+    return bm;
+}
+
+DEF_TEST(TiledRaster_MatchesUntiled, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    SkRTreeFactory rtree;
+    const SkMatrix matrices[] = {SkMatrix::I(), SkMatrix::RotateDeg(7, {150, 100})};
+    for (SkBBHFactory* bbh : {static_cast<SkBBHFactory*>(nullptr),
+                              static_cast<SkBBHFactory*>(&rtree)}) {
+        sk_sp<SkPicture> picture = make_picture(bbh);
+        for (const SkMatrix& matrix : matrices) {
+            SkBitmap expected = draw_reference(picture.get(), &matrix);
+
+            for (SkISize tileSize : {SkISize{37, 53}, SkISize{64, 64}, SkISize{512, 512}}) {
+                for (SkExecutor* exec : {static_cast<SkExecutor*>(nullptr), executor.get()}) {
+                    SkBitmap actual;
+                    actual.allocN32Pixels(300, 200);
+                    actual.eraseColor(SK_ColorWHITE);
+
+                    SkTiledRaster::Options options;
+                    options.fTileSize = tileSize;
+                    options.fExecutor = exec;
+                    REPORTER_ASSERT(r, SkTiledRaster::DrawPicture(picture.get(),
+                                                                  actual.pixmap(),
+                                                                  &matrix,
+                                                                  nullptr,
+                                                                  options));
+                    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual),
+                                    "tile %dx%d, bbh %d, executor %d",
+                                    tileSize.width(), tileSize.height(),
+                                    bbh != nullptr, exec != nullptr);
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(TiledRaster_SurfacePreservesSnapshot, r) {
+    sk_sp<SkSurface> surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(300, 200));
+    REPORTER_ASSERT(r, surface);
+    surface->getCanvas()->clear(SK_ColorGREEN);
+    sk_sp<SkImage> before = surface->makeImageSnapshot();
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkTiledRaster::Options options;
+    options.fTileSize = {100, 100};
+    options.fExecutor = executor.get();
+    sk_sp<SkPicture> picture = make_picture(nullptr);
+    REPORTER_ASSERT(r, SkTiledRaster::DrawPicture(picture.get(), surface.get(), nullptr, options));
+
+    SkPixmap pm;
+    REPORTER_ASSERT(r, before->peekPixels(&pm));
+    REPORTER_ASSERT(r, pm.getColor(0, 0) == SK_ColorGREEN);
+    REPORTER_ASSERT(r, pm.getColor(150, 100) == SK_ColorGREEN);
+
+    sk_sp<SkImage> after = surface->makeImageSnapshot();
+    REPORTER_ASSERT(r, !ToolUtils::equal_pixels(before.get(), after.get()));
+}
+
+DEF_TEST(TiledRaster_PlaybackTiles, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // Nest the picture, so that the nested one is replayed from several tiles at once.
+    SkRTreeFactory rtree;
+    sk_sp<SkPicture> inner = make_picture(&rtree);
+    SkPictureRecorder recorder;
+    SkCanvas* outerCanvas = recorder.beginRecording(SkRect::MakeWH(300, 200), &rtree);
+    outerCanvas->drawPicture(inner);
+    outerCanvas->drawRect({100, 60, 180, 140}, SkPaint());
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkBitmap expected = draw_reference(picture.get(), nullptr);
+
+    // Tile origins are multiples of 16, so dithering matches the untiled draw.
+    constexpr SkISize kTileSize = {80, 80};
+    constexpr int kTilesX = 4, kTilesY = 3;
+    SkBitmap tiles[kTilesX * kTilesY];
+    std::unique_ptr<SkCanvas> canvases[kTilesX * kTilesY];
+    for (int i = 0; i < kTilesX * kTilesY; ++i) {
+        tiles[i].allocN32Pixels(kTileSize.width(), kTileSize.height());
+        tiles[i].eraseColor(SK_ColorWHITE);
+        canvases[i] = std::make_unique<SkCanvas>(tiles[i]);
+    }
+
+    SkTiledRaster::Options options;
+    options.fTileSize = kTileSize;
+    options.fExecutor = executor.get();
+    SkIRect seen[kTilesX * kTilesY];
+    SkTiledRaster::PlaybackTiles(picture.get(), SkIRect::MakeWH(300, 200), nullptr,
+                                 [&](int index, const SkIRect& tile) {
+                                     seen[index] = tile;
+                                     return canvases[index].get();
+                                 },
+                                 options);
+
+    for (int i = 0; i < kTilesX * kTilesY; ++i) {
+        const SkIRect tile = seen[i];
+        SkIRect expectedTile = SkIRect::MakeXYWH((i % kTilesX) * kTileSize.width(),
+                                                 (i / kTilesX) * kTileSize.height(),
+                                                 kTileSize.width(), kTileSize.height());
+        REPORTER_ASSERT(r, expectedTile.intersect(SkIRect::MakeWH(300, 200)));
+        REPORTER_ASSERT(r, tile == expectedTile);
+        SkPixmap want, got;
+        REPORTER_ASSERT(r, expected.pixmap().extractSubset(&want, tile));
+        REPORTER_ASSERT(r, tiles[i].pixmap().extractSubset(&got, SkIRect::MakeSize(tile.size())));
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(want, got), "tile %d", i);
+    }
+}
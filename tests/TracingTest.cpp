@@ -187,8 +187,36 @@ static void test_trace_objects() {
     delete rect;
 }
 
+static void test_trace_cache_lookups() {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+
+    // Cache lookups are counted while the category is enabled, and the hits and misses are
+    // recorded as a two-part counter once every TraceHitRateSampler::kPeriod lookups.
+    for (int i = 0; i < 4096; ++i) {
+        TRACE_CACHE_LOOKUP("skia", "cache lookups", i % 3 != 0 || i > 2048);
+    }
+}
+
 DEF_TEST(Tracing, reporter) {
     test_trace_simple();
     test_trace_counters();
     test_trace_objects();
+    test_trace_cache_lookups();
+}
+
+DEF_TEST(Tracing_HitRateSampler, reporter) {
+    using Sampler = skia_private::TraceHitRateSampler;
+    Sampler sampler;
+    int reports = 0;
+    for (uint32_t i = 0; i < 3 * Sampler::kPeriod; ++i) {
+        int hits = -1, misses = -1;
+        // Every fourth lookup misses.
+        if (sampler.sample(i % 4 != 0, &hits, &misses)) {
+            reports++;
+            REPORTER_ASSERT(reporter, i % Sampler::kPeriod == Sampler::kPeriod - 1);
+            REPORTER_ASSERT(reporter, hits == (int)Sampler::kPeriod * 3 / 4, "%d", hits);
+            REPORTER_ASSERT(reporter, misses == (int)Sampler::kPeriod / 4, "%d", misses);
+        }
+    }
+    REPORTER_ASSERT(reporter, reports == 3);
 }
@@ -6,9 +6,12 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
@@ -23,6 +26,7 @@
 #include "include/core/SkTypes.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/private/base/SkTemplates.h"
@@ -33,12 +37,14 @@
 #include "src/core/SkPathPriv.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/GrColorInfo.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/GrFPArgs.h"
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
 #include "src/gpu/ganesh/GrFragmentProcessors.h"
 #include "src/gpu/ganesh/GrPaint.h"
 #include "src/gpu/ganesh/GrStyle.h"
+#include "src/gpu/ganesh/GrThreadSafeCache.h"
 #include "src/gpu/ganesh/GrUserStencilSettings.h"
 #include "src/gpu/ganesh/PathRenderer.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
@@ -52,9 +58,12 @@
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
+#include "tools/gpu/ContextType.h"
+#include "tools/gpu/GrContextFactory.h"
 
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <map>
 #include <memory>
@@ -912,6 +921,125 @@ DEF_GANESH_TEST_FOR_ALL_CONTEXTS(TriangulatingPathRendererTests,
     test_path(ctx, sdc.get(), create_path_47(), SkMatrix(), GrAAType::kCoverage);
 }
 
+static SkPath create_star(SkScalar radius) {
+    SkPath path;
+    path.moveTo(radius, 0);
+    for (int i = 1; i < 5; ++i) {
+        SkScalar angle = i * 4 * SK_ScalarPI / 5;
+        path.lineTo(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    path.close();
+    return path;
+}
+
+static bool draw_stars(GrDirectContext* ctx, SkBitmap* bitmap) {
+    static constexpr int kSize = 256;
+    auto sdc = skgpu::ganesh::SurfaceDrawContext::Make(ctx,
+                                                       GrColorType::kRGBA_8888,
+                                                       nullptr,
+                                                       SkBackingFit::kExact,
+                                                       {kSize, kSize},
+                                                       SkSurfaceProps(),
+                                                       /*label=*/{},
+                                                       /* sampleCnt= */ 1,
+                                                       skgpu::Mipmapped::kNo,
+                                                       GrProtected::kNo,
+                                                       kTopLeft_GrSurfaceOrigin);
+    if (!sdc) {
+        return false;
+    }
+    sdc->clear(SK_PMColor4fTRANSPARENT);
+
+    // The non-AA stars of each size share a cached triangulation.
+    const SkPath stars[] = {create_star(10), create_star(22)};
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            SkMatrix matrix = SkMatrix::Translate(16 + 32 * x, 16 + 32 * y);
+            GrAAType aaType = (x + y) % 2 ? GrAAType::kCoverage : GrAAType::kNone;
+            test_path(ctx, sdc.get(), stars[y % 2], matrix, aaType,
+                      create_linear_gradient_processor(ctx, SkMatrix::Scale(kSize, kSize)));
+        }
+    }
+
+    bitmap->allocPixels(SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                          kPremul_SkAlphaType));
+    return sdc->readPixels(ctx, bitmap->pixmap(), {0, 0});
+}
+
+// AA triangulations are cached in device space, and shared by draws that only move the path by
+// whole quarter pixels.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(TriangulatingPathRenderer_AACache,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto ctx = ctxInfo.directContext();
+    auto sdc = skgpu::ganesh::SurfaceDrawContext::Make(ctx,
+                                                       GrColorType::kRGBA_8888,
+                                                       nullptr,
+                                                       SkBackingFit::kExact,
+                                                       {256, 256},
+                                                       SkSurfaceProps(),
+                                                       /*label=*/{},
+                                                       /* sampleCnt= */ 1,
+                                                       skgpu::Mipmapped::kNo,
+                                                       GrProtected::kNo,
+                                                       kTopLeft_GrSurfaceOrigin);
+    if (!sdc) {
+        return;
+    }
+    sdc->clear(SK_PMColor4fTRANSPARENT);
+    GrThreadSafeCache* threadSafeCache = ctx->priv().threadSafeCache();
+    const int initialEntries = threadSafeCache->numEntries();
+
+    const SkPath star = create_star(20);
+    for (SkVector translate : {SkVector{30, 30}, SkVector{100.5f, 60.25f}, SkVector{150, 180}}) {
+        test_path(ctx, sdc.get(), star, SkMatrix::Translate(translate), GrAAType::kCoverage);
+    }
+    ctx->flushAndSubmit();
+    REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == initialEntries + 1);
+
+    // A different sub-quarter pixel offset needs a different triangulation.
+    test_path(ctx, sdc.get(), star, SkMatrix::Translate(30.1f, 30), GrAAType::kCoverage);
+    ctx->flushAndSubmit();
+    REPORTER_ASSERT(reporter, threadSafeCache->numEntries() == initialEntries + 2);
+}
+
+// Triangulating on the executor's threads at flush time must not change what is drawn.
+DEF_GANESH_TEST(TriangulatingPathRenderer_ParallelOpPreparation,
+                reporter,
+                options,
+                CtsEnforcement::kNever) {
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(4);
+
+    GrContextOptions serialOptions = options;
+    serialOptions.fExecutor = nullptr;
+    sk_gpu_test::GrContextFactory serialFactory(serialOptions);
+
+    GrContextOptions parallelOptions = options;
+    parallelOptions.fExecutor = threadPool.get();
+    parallelOptions.fAllowParallelOpPreparation = true;
+    sk_gpu_test::GrContextFactory parallelFactory(parallelOptions);
+
+    for (int i = 0; i < skgpu::kContextTypeCount; ++i) {
+        skgpu::ContextType ctxType = static_cast<skgpu::ContextType>(i);
+        if (!skgpu::IsRenderingContext(ctxType)) {
+            continue;
+        }
+        GrDirectContext* serialContext = serialFactory.get(ctxType);
+        GrDirectContext* parallelContext = parallelFactory.get(ctxType);
+        if (!serialContext || !parallelContext) {
+            continue;
+        }
+        SkBitmap expected, actual;
+        if (!draw_stars(serialContext, &expected)) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, draw_stars(parallelContext, &actual));
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(expected, actual),
+                        "%s", skgpu::ContextTypeName(ctxType));
+    }
+}
+
 #endif // defined(SK_GANESH)
 
 namespace {
@@ -1470,4 +1598,60 @@ DEF_TEST(Triangulator_Crbug337080025, r) {
     REPORTER_ASSERT(r, vertexCount == 0);
 }
 
+static float triangles_area(const SimplerVertexAllocator& alloc, int vertexCount) {
+    const SkPoint* pts = reinterpret_cast<const SkPoint*>(alloc.fVertexData.get());
+    float area = 0;
+    for (int i = 0; i + 2 < vertexCount; i += 3) {
+        area += SkScalarAbs((pts[i + 1] - pts[i]).cross(pts[i + 2] - pts[i])) / 2;
+    }
+    return area;
+}
+
+// Single convex polygons skip the simplification stage, and the triangulators can build their
+// meshes in a reused scratch arena. Neither should change the triangulation.
+DEF_TEST(Triangulator_ConvexAndScratch, r) {
+    struct {
+        SkPath fPath;
+        float fArea;
+    } shapes[] = {
+        {SkPath::Rect({0, 0, 10, 20}), 200},
+        {SkPath::Circle(5, 5, 20), SK_ScalarPI * 400},
+        {SkPath::RRect({0, 0, 30, 10}, 3, 3), 300 - (4 - SK_ScalarPI) * 9},
+        {SkPath::Polygon({{0, 0}, {10, 2}, {12, 10}, {3, 14}}, true), 107},
+        {SkPath::Polygon({{0, 0}, {1000, 0}, {1000.001f, 1}, {1000, 2}, {0, 2}}, true), 2000},
+        // Not convex, so it still goes through the simplification.
+        {SkPath::Polygon({{0, 0}, {10, 0}, {5, 5}, {10, 10}, {0, 10}}, true), 75},
+    };
+    const SkRect clipBounds = SkRect::MakeLTRB(-50, -50, 50, 50);
+    SkArenaAllocWithReset scratch(GrTriangulator::kArenaDefaultChunkSize);
+    for (const auto& shape : shapes) {
+        for (int i = 0; i < 2; ++i) {
+            SimplerVertexAllocator alloc;
+            bool isLinear;
+            int vertexCount = i == 0 ? GrTriangulator::PathToTriangles(
+                                               shape.fPath, GrPathUtils::kDefaultTolerance,
+                                               clipBounds, &alloc, &isLinear)
+                                     : GrTriangulator::PathToTriangles(
+                                               shape.fPath, GrPathUtils::kDefaultTolerance,
+                                               clipBounds, &alloc, &isLinear, &scratch);
+            REPORTER_ASSERT(r, vertexCount > 0);
+            float area = triangles_area(alloc, vertexCount);
+            REPORTER_ASSERT(r, SkScalarNearlyEqual(area, shape.fArea, shape.fArea / 100),
+                            "area %g, expected %g", area, shape.fArea);
+            REPORTER_ASSERT(r, scratch.isEmpty());
+        }
+
+        SimplerVertexAllocator alloc, scratchAlloc;
+        int vertexCount = GrAATriangulator::PathToAATriangles(
+                shape.fPath, GrPathUtils::kDefaultTolerance, clipBounds, &alloc);
+        int scratchVertexCount = GrAATriangulator::PathToAATriangles(
+                shape.fPath, GrPathUtils::kDefaultTolerance, clipBounds, &scratchAlloc, &scratch);
+        REPORTER_ASSERT(r, vertexCount > 0);
+        REPORTER_ASSERT(r, vertexCount == scratchVertexCount);
+        REPORTER_ASSERT(r, !memcmp(alloc.fVertexData.get(), scratchAlloc.fVertexData.get(),
+                                   vertexCount * (sizeof(SkPoint) + sizeof(float))));
+        REPORTER_ASSERT(r, scratch.isEmpty());
+    }
+}
+
 #endif // SK_ENABLE_OPTIMIZE_SIZE
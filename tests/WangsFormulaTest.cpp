@@ -10,6 +10,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
+#include "src/base/SkFloatBits.h"
 #include "src/base/SkRandom.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkGeometry.h"
@@ -322,6 +323,35 @@ DEF_TEST(wangs_formula_vectorXforms, r) {
     });
 }
 
+// Ensure the strip versions, which evaluate several curves at once, match the single curve ones.
+DEF_TEST(wangs_formula_strips, r) {
+    SkRandom rand;
+    // Enough curves for a few full batches and a partial one.
+    constexpr int kNumCurves = 4 * wangs_formula::kStripBatchSize + 3;
+    SkPoint pts[3 * kNumCurves + 1];
+    for (int i = -10; i <= 30; i += 4) {
+        for (SkPoint& p : pts) {
+            p.set(std::ldexp(1 + rand.nextF(), i), std::ldexp(1 + rand.nextF(), i));
+        }
+        for_random_matrices(&rand, [&](const SkMatrix& m) {
+            wangs_formula::VectorXform xform(m);
+            float n4[kNumCurves];
+            for (int count : {0, 1, wangs_formula::kStripBatchSize, kNumCurves}) {
+                wangs_formula::cubic_strip_p4(kPrecision, pts, count, n4, xform);
+                for (int j = 0; j < count; ++j) {
+                    float expected = wangs_formula::cubic_p4(kPrecision, pts + 3*j, xform);
+                    REPORTER_ASSERT(r, SkFloat2Bits(n4[j]) == SkFloat2Bits(expected));
+                }
+                wangs_formula::quadratic_strip_p4(kPrecision, pts, count, n4, xform);
+                for (int j = 0; j < count; ++j) {
+                    float expected = wangs_formula::quadratic_p4(kPrecision, pts + 2*j, xform);
+                    REPORTER_ASSERT(r, SkFloat2Bits(n4[j]) == SkFloat2Bits(expected));
+                }
+            }
+        });
+    }
+}
+
 DEF_TEST(wangs_formula_worst_case_cubic, r) {
     {
         SkPoint worstP[] = {{0,0}, {100,100}, {0,0}, {0,0}};
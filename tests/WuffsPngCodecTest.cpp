@@ -0,0 +1,171 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if defined(SK_CODEC_DECODES_PNG_WITH_WUFFS)
+
+#include "include/codec/SkAndroidCodec.h"
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkEncodedImageFormat.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkStream.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/codec/SkPngCodec.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+static constexpr const char* kImages[] = {
+        "images/mandrill_512.png",         // RGB with cHRM
+        "images/mandrill_64.png",          // RGB with an ICC profile
+        "images/plane.png",                // RGBA
+        "images/plane_interlaced.png",     // interlaced RGBA
+        "images/index8.png",               // palette with tRNS
+        "images/3x3.png",                  // 1 bit palette
+        "images/grayscale.png",            // gray with gAMA
+        "images/color_wheel.png",          // RGBA with sBIT
+        "images/example_3.png",            // 16 bit RGB, which libpng decodes
+};
+
+static std::unique_ptr<SkCodec> make_libpng_codec(sk_sp<SkData> data) {
+    SkCodec::Result result;
+    return SkPngCodec::MakeFromStream(SkMemoryStream::Make(std::move(data)), &result);
+}
+
+// Unpremultiplying and premultiplying can round differently in Wuffs and in SkSwizzler.
+static bool close_enough(const SkBitmap& a, const SkBitmap& b) {
+    for (int y = 0; y < a.height(); ++y) {
+        const uint8_t* rowA = static_cast<const uint8_t*>(a.getAddr(0, y));
+        const uint8_t* rowB = static_cast<const uint8_t*>(b.getAddr(0, y));
+        for (size_t i = 0; i < a.info().minRowBytes(); ++i) {
+            if (SkTAbs(rowA[i] - rowB[i]) > 1) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+DEF_TEST(WuffsPngCodec_MatchesLibpng, r) {
+    for (const char* path : kImages) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        std::unique_ptr<SkCodec> reference = make_libpng_codec(data);
+        REPORTER_ASSERT(r, codec && reference, "%s", path);
+        if (!codec || !reference) {
+            continue;
+        }
+        REPORTER_ASSERT(r, codec->getEncodedFormat() == SkEncodedImageFormat::kPNG);
+        REPORTER_ASSERT(r, codec->dimensions() == reference->dimensions(), "%s", path);
+        REPORTER_ASSERT(r, codec->getInfo().alphaType() == reference->getInfo().alphaType(),
+                        "%s", path);
+        REPORTER_ASSERT(r, SkColorSpace::Equals(codec->getInfo().colorSpace(),
+                                                reference->getInfo().colorSpace()),
+                        "%s", path);
+
+        const SkImageInfo infos[] = {
+                reference->getInfo().makeColorType(kN32_SkColorType),
+                reference->getInfo().makeColorType(kRGBA_8888_SkColorType)
+                        .makeAlphaType(kUnpremul_SkAlphaType),
+                reference->getInfo().makeColorType(kN32_SkColorType)
+                        .makeColorSpace(SkColorSpace::MakeSRGB()->makeColorSpin()),
+                reference->getInfo().makeColorType(kGray_8_SkColorType),
+        };
+        for (const SkImageInfo& info : infos) {
+            SkBitmap expected;
+            expected.allocPixels(info);
+            if (reference->getPixels(expected.pixmap()) != SkCodec::kSuccess) {
+                // e.g. kGray_8 for a color image.
+                continue;
+            }
+            SkBitmap actual;
+            actual.allocPixels(info);
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(actual.pixmap()),
+                            "%s color type %d", path, info.colorType());
+            REPORTER_ASSERT(r, close_enough(expected, actual), "%s color type %d", path,
+                            info.colorType());
+        }
+    }
+}
+
+// SkAndroidCodec samples and crops with an incremental decode, which decodes into a buffer.
+DEF_TEST(WuffsPngCodec_SampledSubset, r) {
+    for (const char* path : kImages) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        auto codec = SkAndroidCodec::MakeFromCodec(SkCodec::MakeFromData(data));
+        auto reference = SkAndroidCodec::MakeFromCodec(make_libpng_codec(data));
+        if (!codec || !reference) {
+            ERRORF(r, "Could not create codecs for %s", path);
+            continue;
+        }
+        SkIRect subset = SkIRect::MakeLTRB(codec->getInfo().width() / 4,
+                                           codec->getInfo().height() / 3,
+                                           codec->getInfo().width(),
+                                           codec->getInfo().height() * 3 / 4);
+        if (subset.isEmpty()) {
+            subset = SkIRect::MakeSize(codec->getInfo().dimensions());
+        }
+        for (int sampleSize : {1, 3}) {
+            SkAndroidCodec::AndroidOptions options;
+            options.fSampleSize = sampleSize;
+            options.fSubset = &subset;
+            const SkISize size = reference->getSampledSubsetDimensions(sampleSize, subset);
+            const SkImageInfo info =
+                    reference->getInfo().makeColorType(kN32_SkColorType).makeDimensions(size);
+            SkBitmap expected, actual;
+            expected.allocPixels(info);
+            actual.allocPixels(info);
+            REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                               reference->getAndroidPixels(info, expected.getPixels(),
+                                                           expected.rowBytes(), &options));
+            REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                               codec->getAndroidPixels(info, actual.getPixels(),
+                                                       actual.rowBytes(), &options),
+                            "%s sample size %d", path, sampleSize);
+            REPORTER_ASSERT(r, close_enough(expected, actual), "%s sample size %d", path,
+                            sampleSize);
+        }
+    }
+}
+
+DEF_TEST(WuffsPngCodec_Incomplete, r) {
+    sk_sp<SkData> data = GetResourceAsData("images/plane.png");
+    if (!data) {
+        return;
+    }
+    // Enough for the header, but not all of the image data.
+    sk_sp<SkData> truncated = SkData::MakeSubset(data.get(), 0, data->size() / 2);
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(truncated);
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+    SkBitmap bitmap;
+    bitmap.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType));
+    REPORTER_ASSERT(r, SkCodec::kIncompleteInput == codec->getPixels(bitmap.pixmap()));
+
+    // Nothing but the signature and part of IHDR.
+    codec = SkCodec::MakeFromData(SkData::MakeSubset(data.get(), 0, 20));
+    REPORTER_ASSERT(r, !codec);
+}
+
+#endif  // SK_CODEC_DECODES_PNG_WITH_WUFFS
@@ -9,6 +9,7 @@
 #include "include/codec/SkEncodedOrigin.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkScalar.h"
@@ -18,13 +19,16 @@
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
 #include "include/effects/SkColorMatrix.h"
+#include "include/encode/SkEncoder.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkRandom.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -207,6 +211,113 @@ DEF_TEST(Jpeg_YUV_Encode, r) {
     }
 }
 
+static SkYUVAPixmaps make_yuva(SkISize dimensions,
+                               SkYUVAInfo::PlaneConfig planeConfig,
+                               SkYUVAInfo::Subsampling subsampling) {
+    SkYUVAInfo yuvaInfo(dimensions, planeConfig, subsampling, kJPEG_Full_SkYUVColorSpace);
+    SkYUVAPixmaps pixmaps = SkYUVAPixmaps::Allocate(
+            SkYUVAPixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8, nullptr));
+    SkRandom random;
+    for (int i = 0; i < pixmaps.numPlanes(); ++i) {
+        const SkPixmap& plane = pixmaps.plane(i);
+        for (int y = 0; y < plane.height(); ++y) {
+            uint8_t* row = static_cast<uint8_t*>(plane.writable_addr(0, y));
+            for (int x = 0; x < plane.width() * plane.info().bytesPerPixel(); ++x) {
+                row[x] = static_cast<uint8_t>(x * (i + 2) + y * 3 + random.nextULessThan(16));
+            }
+        }
+    }
+    return pixmaps;
+}
+
+static sk_sp<SkData> encode_yuva(const SkYUVAPixmaps& pixmaps,
+                                 const SkJpegEncoder::Options& options) {
+    SkDynamicMemoryWStream stream;
+    if (!SkJpegEncoder::Encode(&stream, pixmaps, nullptr, options)) {
+        return nullptr;
+    }
+    return stream.detachAsData();
+}
+
+// The planes are passed to libjpeg as raw data, however they are laid out, and however many rows
+// are encoded at a time.
+DEF_TEST(Jpeg_YUV_EncodeRawData, r) {
+    for (auto subsampling : {SkYUVAInfo::Subsampling::k420, SkYUVAInfo::Subsampling::k422,
+                             SkYUVAInfo::Subsampling::k444, SkYUVAInfo::Subsampling::k410}) {
+        const SkISize dimensions = {301, 203};
+        SkYUVAPixmaps planar =
+                make_yuva(dimensions, SkYUVAInfo::PlaneConfig::kY_U_V, subsampling);
+
+        // The same pixels, with U and V interleaved.
+        SkYUVAPixmaps interleaved =
+                make_yuva(dimensions, SkYUVAInfo::PlaneConfig::kY_UV, subsampling);
+        SkAssertResult(planar.plane(0).readPixels(interleaved.plane(0)));
+        for (int y = 0; y < interleaved.plane(1).height(); ++y) {
+            uint8_t* uv = static_cast<uint8_t*>(interleaved.plane(1).writable_addr(0, y));
+            for (int x = 0; x < interleaved.plane(1).width(); ++x) {
+                uv[2 * x + 0] = *static_cast<const uint8_t*>(planar.plane(1).addr(x, y));
+                uv[2 * x + 1] = *static_cast<const uint8_t*>(planar.plane(2).addr(x, y));
+            }
+        }
+
+        SkJpegEncoder::Options options;
+        sk_sp<SkData> encoded = encode_yuva(planar, options);
+        REPORTER_ASSERT(r, encoded);
+        if (!encoded) {
+            continue;
+        }
+        sk_sp<SkData> encodedInterleaved = encode_yuva(interleaved, options);
+        REPORTER_ASSERT(r, encodedInterleaved && encoded->equals(encodedInterleaved.get()));
+
+        SkDynamicMemoryWStream stream;
+        std::unique_ptr<SkEncoder> encoder = SkJpegEncoder::Make(&stream, planar, nullptr, options);
+        REPORTER_ASSERT(r, encoder);
+        for (int y = 0; y < dimensions.height(); y += 7) {
+            REPORTER_ASSERT(r, encoder->encodeRows(7));
+        }
+        REPORTER_ASSERT(r, encoded->equals(stream.detachAsData().get()));
+
+        REPORTER_ASSERT(r, decode_yuva(r, SkMemoryStream::Make(encoded)).yuvaInfo() ==
+                           planar.yuvaInfo());
+    }
+}
+
+static bool same_planes(const SkYUVAPixmaps& a, const SkYUVAPixmaps& b) {
+    if (a.yuvaInfo() != b.yuvaInfo()) {
+        return false;
+    }
+    for (int i = 0; i < a.numPlanes(); ++i) {
+        for (int y = 0; y < a.plane(i).height(); ++y) {
+            if (memcmp(a.plane(i).addr(0, y), b.plane(i).addr(0, y),
+                       a.plane(i).info().minRowBytes())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Encoding strips in parallel changes the Huffman tables, but not the pixels.
+DEF_TEST(Jpeg_YUV_EncodeExecutor, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (auto subsampling : {SkYUVAInfo::Subsampling::k420, SkYUVAInfo::Subsampling::k422,
+                             SkYUVAInfo::Subsampling::k444, SkYUVAInfo::Subsampling::k440}) {
+        SkYUVAPixmaps pixmaps =
+                make_yuva({301, 1000}, SkYUVAInfo::PlaneConfig::kY_U_V, subsampling);
+        SkJpegEncoder::Options options;
+        sk_sp<SkData> serial = encode_yuva(pixmaps, options);
+        options.fExecutor = executor.get();
+        sk_sp<SkData> parallel = encode_yuva(pixmaps, options);
+        REPORTER_ASSERT(r, serial && parallel);
+        if (!serial || !parallel) {
+            continue;
+        }
+        REPORTER_ASSERT(r, !serial->equals(parallel.get()));
+        REPORTER_ASSERT(r, same_planes(decode_yuva(r, SkMemoryStream::Make(serial)),
+                                       decode_yuva(r, SkMemoryStream::Make(parallel))));
+    }
+}
+
 // Be sure that the two matrices are inverses of each other
 // (i.e. rgb2yuv and yuv2rgb
 DEF_TEST(YUVMath, reporter) {
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/ContextPriv.h"
+
+#include <vector>
+
+namespace skgpu::graphite {
+
+namespace {
+
+struct TimingsResult {
+    bool fCalled = false;
+    std::vector<GpuPassTiming> fTimings;
+};
+
+void timings_proc(GpuTimingsContext context, SkSpan<const GpuPassTiming> timings) {
+    auto result = static_cast<TimingsResult*>(context);
+    result->fCalled = true;
+    result->fTimings.assign(timings.begin(), timings.end());
+}
+
+}  // namespace
+
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(GpuPassTimingsTest, reporter, context,
+                                   CtsEnforcement::kNextRelease) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(),
+                                                        SkImageInfo::MakeN32Premul(16, 16));
+    if (!surface) {
+        ERRORF(reporter, "Could not make surface");
+        return;
+    }
+    surface->getCanvas()->drawColor(SK_ColorRED);
+    std::unique_ptr<Recording> recording = recorder->snap();
+
+    TimingsResult result;
+    InsertRecordingInfo info;
+    info.fRecording = recording.get();
+    info.fGpuTimingsContext = &result;
+    info.fGpuTimingsProc = timings_proc;
+    REPORTER_ASSERT(reporter, context->insertRecording(info));
+    context->submit(SyncToCpu::kYes);
+
+    if (!context->priv().caps()->timestampQuerySupport()) {
+        REPORTER_ASSERT(reporter, !result.fCalled);
+        return;
+    }
+    REPORTER_ASSERT(reporter, result.fCalled);
+    REPORTER_ASSERT(reporter, result.fTimings.size() == 1);
+    for (const GpuPassTiming& timing : result.fTimings) {
+        REPORTER_ASSERT(reporter, timing.fType == GpuPassTiming::Type::kRender);
+    }
+}
+
+}  // namespace skgpu::graphite
@@ -434,6 +434,43 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(GraphitePurgeAsNeededResourcesTest, reporter,
     REPORTER_ASSERT(reporter, resourceCache->currentBudgetedBytes() == 0);
 }
 
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(GraphiteOverBudgetPurgeLimitTest, reporter, context,
+                                   CtsEnforcement::kNextRelease) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    ResourceProvider* resourceProvider = recorder->priv().resourceProvider();
+    ResourceCache* resourceCache = resourceProvider->resourceCache();
+    const SharedContext* sharedContext = resourceProvider->sharedContext();
+
+    resourceCache->setMaxBudget(10);
+    resourceCache->setOverBudgetPurgeLimit(3);
+
+    auto timeBeforeResources = skgpu::StdSteadyClock::now();
+    for (int i = 0; i < 5; ++i) {
+        add_new_purgeable_resource(reporter, sharedContext, resourceCache, /*gpuMemorySize=*/2);
+    }
+    REPORTER_ASSERT(reporter, resourceCache->getResourceCount() == 5);
+    REPORTER_ASSERT(reporter, resourceCache->currentBudgetedBytes() == 10);
+
+    // Going 6 bytes over budget should only purge resources until at least 3 bytes are freed.
+    auto resourceSize6 = add_new_resource(reporter,
+                                          sharedContext,
+                                          resourceCache,
+                                          /*gpuMemorySize=*/6);
+    REPORTER_ASSERT(reporter, resourceCache->getResourceCount() == 4);
+    REPORTER_ASSERT(reporter, resourceCache->currentBudgetedBytes() == 12);
+
+    // Deferred cleanup gets us back under budget, even if nothing is old enough to purge by time.
+    resourceCache->purgeResourcesNotUsedSince(timeBeforeResources);
+    REPORTER_ASSERT(reporter, resourceCache->getResourceCount() == 3);
+    REPORTER_ASSERT(reporter, resourceCache->currentBudgetedBytes() == 10);
+
+    resourceCache->setOverBudgetPurgeLimit(0);
+    resourceSize6.reset();
+    resourceCache->purgeResources();
+    REPORTER_ASSERT(reporter, resourceCache->getResourceCount() == 0);
+    REPORTER_ASSERT(reporter, resourceCache->currentBudgetedBytes() == 0);
+}
+
 DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(GraphiteZeroSizedResourcesTest, reporter, context,
                                    CtsEnforcement::kNextRelease) {
     std::unique_ptr<Recorder> recorder = context->makeRecorder();
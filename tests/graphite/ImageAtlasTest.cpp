@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/AtlasProvider.h"
+#include "src/gpu/graphite/ImageAtlas.h"
+#include "src/gpu/graphite/Image_Graphite.h"
+#include "src/gpu/graphite/RecorderPriv.h"
+
+#include <vector>
+
+namespace skgpu::graphite {
+
+namespace {
+
+constexpr int kImageSize = 8;
+constexpr int kGridSize = 8;
+constexpr int kCellSize = 2 * kImageSize;
+
+SkColor image_color(int i) {
+    return SkColorSetRGB(31 * i & 0xff, 255 - 17 * i & 0xff, 127 + 53 * i & 0xff);
+}
+
+}  // namespace
+
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(ImageAtlasTest, reporter, context,
+                                         CtsEnforcement::kNextRelease) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    ImageAtlas* atlas = recorder->priv().atlasProvider()->getImageAtlas();
+
+    std::vector<sk_sp<SkImage>> images;
+    for (int i = 0; i < kGridSize * kGridSize; ++i) {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(kImageSize, kImageSize);
+        bitmap.eraseColor(image_color(i));
+        bitmap.setImmutable();
+        images.push_back(bitmap.asImage());
+    }
+
+    // Different small images are copied into the same texture.
+    SkIPoint pos0, pos1;
+    sk_sp<Image> atlasImage0 = atlas->findOrAddImage(images[0].get(), &pos0);
+    sk_sp<Image> atlasImage1 = atlas->findOrAddImage(images[1].get(), &pos1);
+    REPORTER_ASSERT(reporter, atlasImage0 && atlasImage1);
+    if (!atlasImage0 || !atlasImage1) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, atlasImage0->textureProxyView().proxy() ==
+                              atlasImage1->textureProxyView().proxy());
+    REPORTER_ASSERT(reporter, pos0 != pos1);
+
+    // Scaling each image up with linear filtering must not blend in its neighbors in the atlas.
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(
+            recorder.get(), SkImageInfo::MakeN32Premul(kGridSize * kCellSize,
+                                                       kGridSize * kCellSize));
+    if (!surface) {
+        ERRORF(reporter, "Could not make surface");
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    for (int i = 0; i < kGridSize * kGridSize; ++i) {
+        SkRect dst = SkRect::MakeXYWH(i % kGridSize * kCellSize, i / kGridSize * kCellSize,
+                                      kCellSize, kCellSize);
+        canvas->drawImageRect(images[i], dst, SkSamplingOptions(SkFilterMode::kLinear));
+    }
+
+    SkBitmap result;
+    result.allocPixels(surface->imageInfo());
+    if (!surface->readPixels(result, 0, 0)) {
+        ERRORF(reporter, "readPixels failed");
+        return;
+    }
+    for (int i = 0; i < kGridSize * kGridSize; ++i) {
+        for (int y = 0; y < kCellSize; ++y) {
+            for (int x = 0; x < kCellSize; ++x) {
+                SkColor color = result.getColor(i % kGridSize * kCellSize + x,
+                                                i / kGridSize * kCellSize + y);
+                if (color != image_color(i)) {
+                    ERRORF(reporter, "Image %d at (%d, %d): expected 0x%08x, got 0x%08x",
+                           i, x, y, image_color(i), color);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace skgpu::graphite
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/IncrementalImageDecoder.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
+#include "tests/FakeStreams.h"
+#include "tools/Resources.h"
+
+#include <cstring>
+#include <memory>
+
+using namespace skgpu::graphite;
+
+namespace {
+
+bool same_rows(const SkBitmap& a, const SkBitmap& b) {
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr(0, y), b.getAddr(0, y), a.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SkBitmap read_back(Recorder* recorder, const sk_sp<SkImage>& image) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(image->dimensions());
+    SkBitmap bitmap;
+    bitmap.allocPixels(info);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder, info);
+    if (!surface) {
+        return SkBitmap();
+    }
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    surface->getCanvas()->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
+    if (!surface->readPixels(bitmap.pixmap(), 0, 0)) {
+        return SkBitmap();
+    }
+    return bitmap;
+}
+
+}  // anonymous namespace
+
+// Decodes images as their data arrives, checking that the final image matches a full decode and
+// that an image made at the first step keeps its pixels after later steps change the texture.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(IncrementalImageDecoder_Upload, reporter, context,
+                                         CtsEnforcement::kNextRelease) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    for (const char* name : {"images/plane.png", "images/plane_interlaced.png"}) {
+        sk_sp<SkData> data = GetResourceAsData(name);
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> truthCodec = SkCodec::MakeFromData(data);
+        if (!truthCodec) {
+            continue;
+        }
+        const SkImageInfo info = SkImageInfo::MakeN32Premul(truthCodec->dimensions());
+        SkBitmap truth;
+        truth.allocPixels(info);
+        REPORTER_ASSERT(reporter, SkCodec::kSuccess == truthCodec->getPixels(truth.pixmap()));
+
+        HaltingStream* stream = new HaltingStream(data, data->size() / 2);
+        std::unique_ptr<IncrementalImageDecoder> decoder = IncrementalImageDecoder::Make(
+                recorder.get(), SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream)), info);
+        if (!decoder) {
+            ERRORF(reporter, "%s: could not start the decode", name);
+            continue;
+        }
+        REPORTER_ASSERT(reporter, !decoder->makeImage());
+
+        sk_sp<SkImage> firstImage;
+        SkBitmap firstPixels;
+        SkCodec::Result result;
+        int steps = 0;
+        while (true) {
+            result = decoder->decode();
+            steps++;
+            if (!firstImage) {
+                firstImage = decoder->makeImage();
+                REPORTER_ASSERT(reporter, firstImage);
+                if (!firstImage) {
+                    break;
+                }
+                firstPixels = read_back(recorder.get(), firstImage);
+            }
+            if (result != SkCodec::kIncompleteInput || stream->isAllDataReceived()) {
+                break;
+            }
+            stream->addNewData(1000);
+        }
+        REPORTER_ASSERT(reporter, result == SkCodec::kSuccess, "%s: %d", name, (int)result);
+        REPORTER_ASSERT(reporter, steps > 1, "%s: decoded in one step", name);
+
+        sk_sp<SkImage> image = decoder->makeImage();
+        REPORTER_ASSERT(reporter, image && image->dimensions() == info.dimensions());
+        if (!image || !firstImage) {
+            continue;
+        }
+        SkBitmap final = read_back(recorder.get(), image);
+        REPORTER_ASSERT(reporter, !final.drawsNothing() && same_rows(final, truth),
+                        "%s: the final image differs", name);
+
+        SkBitmap firstAgain = read_back(recorder.get(), firstImage);
+        REPORTER_ASSERT(reporter, !firstAgain.drawsNothing() && same_rows(firstAgain, firstPixels),
+                        "%s: an earlier image changed", name);
+    }
+}
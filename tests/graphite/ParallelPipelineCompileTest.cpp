@@ -0,0 +1,126 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
+
+namespace {
+
+SkExecutor* pipeline_executor() {
+    static std::unique_ptr<SkExecutor> gExecutor = SkExecutor::MakeFIFOThreadPool(4);
+    return gExecutor.get();
+}
+
+void set_pipeline_executor(skgpu::graphite::ContextOptions* options) {
+    options->fPipelineCompileExecutor = pipeline_executor();
+}
+
+}  // anonymous namespace
+
+// Draws that need several new pipelines in one Recording should render the same with their
+// pipelines compiled on an executor.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(ParallelPipelineCompileTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           set_pipeline_executor,
+                                           true,
+                                           CtsEnforcement::kNextRelease) {
+    using namespace skgpu::graphite;
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    SkImageInfo ii = SkImageInfo::Make(32, 32, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    // A solid rect, a gradient rrect, and a blended oval all need different pipelines.
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(0, 0, 8, 8), paint);
+
+    const SkPoint pts[] = {{16, 0}, {32, 0}};
+    const SkColor colors[] = {SK_ColorBLUE, SK_ColorBLUE};
+    SkPaint gradient;
+    gradient.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(16, 0, 16, 16), 2, 2), gradient);
+
+    SkPaint multiply;
+    multiply.setColor(SK_ColorGREEN);
+    multiply.setBlendMode(SkBlendMode::kMultiply);
+    canvas->drawOval(SkRect::MakeXYWH(0, 16, 16, 16), multiply);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+    if (!surface->readPixels(bitmap.pixmap(), 0, 0)) {
+        ERRORF(reporter, "readPixels failed");
+        return;
+    }
+    REPORTER_ASSERT(reporter, bitmap.getColor(4, 4) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, bitmap.getColor(24, 8) == SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, bitmap.getColor(8, 24) == SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, bitmap.getColor(24, 24) == SK_ColorWHITE);
+}
+
+// The pipelines of a Recording are compiled together, so a Recording with several render passes of
+// one pipeline each also compiles them on the executor.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(ParallelPipelineCompileTest_ManyPasses,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           set_pipeline_executor,
+                                           true,
+                                           CtsEnforcement::kNextRelease) {
+    using namespace skgpu::graphite;
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    SkImageInfo ii = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+
+    const SkBlendMode blendModes[] = {SkBlendMode::kSrcOver,
+                                      SkBlendMode::kScreen,
+                                      SkBlendMode::kLighten};
+    sk_sp<SkSurface> surfaces[std::size(blendModes)];
+    for (size_t i = 0; i < std::size(blendModes); ++i) {
+        surfaces[i] = SkSurfaces::RenderTarget(recorder.get(), ii);
+        if (!surfaces[i]) {
+            ERRORF(reporter, "Could not make surface %zu", i);
+            return;
+        }
+        SkCanvas* canvas = surfaces[i]->getCanvas();
+        canvas->clear(SK_ColorBLACK);
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        paint.setBlendMode(blendModes[i]);
+        canvas->drawOval(SkRect::MakeWH(16, 16), paint);
+    }
+
+    for (size_t i = 0; i < std::size(blendModes); ++i) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(ii);
+        if (!surfaces[i]->readPixels(bitmap.pixmap(), 0, 0)) {
+            ERRORF(reporter, "readPixels failed");
+            return;
+        }
+        // Red over black gives red with each of the blend modes.
+        REPORTER_ASSERT(reporter, bitmap.getColor(8, 8) == SK_ColorRED, "blend mode %d",
+                        static_cast<int>(blendModes[i]));
+        REPORTER_ASSERT(reporter, bitmap.getColor(0, 0) == SK_ColorBLACK);
+    }
+}
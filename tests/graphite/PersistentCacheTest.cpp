@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/base/SkSpinlock.h"
+
+#include <map>
+#include <string>
+
+namespace {
+
+class TestPersistentCache final : public skgpu::graphite::ContextOptions::PersistentCache {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        SkAutoSpinlock lock(fSpinlock);
+        ++fLoads;
+        auto iter = fEntries.find(as_string(key));
+        if (iter == fEntries.end()) {
+            return nullptr;
+        }
+        ++fHits;
+        return iter->second;
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        SkAutoSpinlock lock(fSpinlock);
+        ++fStores;
+        fEntries[as_string(key)] = SkData::MakeWithCopy(data.data(), data.size());
+    }
+
+    void reset() {
+        SkAutoSpinlock lock(fSpinlock);
+        fEntries.clear();
+        fLoads = fHits = fStores = 0;
+    }
+
+    int fLoads = 0;
+    int fHits = 0;
+    int fStores = 0;
+
+private:
+    static std::string as_string(const SkData& data) {
+        return std::string(static_cast<const char*>(data.data()), data.size());
+    }
+
+    SkSpinlock fSpinlock;
+    std::map<std::string, sk_sp<SkData>> fEntries;
+};
+
+TestPersistentCache gPersistentCache;
+
+void set_persistent_cache(skgpu::graphite::ContextOptions* options) {
+    gPersistentCache.reset();
+    options->fPersistentCache = &gPersistentCache;
+}
+
+void draw_and_submit(skgpu::graphite::Context* context, SkColor color) {
+    std::unique_ptr<skgpu::graphite::Recorder> recorder = context->makeRecorder();
+    SkImageInfo ii = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    SkPaint paint;
+    paint.setColor(color);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 8), paint);
+    std::unique_ptr<skgpu::graphite::Recording> recording = recorder->snap();
+    context->insertRecording({recording.get()});
+    context->submit(skgpu::graphite::SyncToCpu::kYes);
+}
+
+}  // anonymous namespace
+
+// Pipelines created by the Context should store their backend shader code in the client's cache,
+// and every stored entry must be retrievable with the key it was stored under.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(PersistentCacheTest,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           testContext,
+                                           set_persistent_cache,
+                                           true,
+                                           CtsEnforcement::kNextRelease) {
+    draw_and_submit(context, SK_ColorRED);
+
+    REPORTER_ASSERT(reporter, gPersistentCache.fStores > 0);
+    REPORTER_ASSERT(reporter, gPersistentCache.fLoads >= gPersistentCache.fStores);
+
+    // Drawing the same thing again either reuses the in-memory pipeline or reads the cache; it
+    // never needs to store anything new.
+    const int stores = gPersistentCache.fStores;
+    draw_and_submit(context, SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, gPersistentCache.fStores == stores);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#if defined(SK_GRAPHITE)
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "include/gpu/graphite/precompile/Precompile.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GlobalCache.h"
+
+using namespace skgpu::graphite;
+
+namespace {
+
+sk_sp<SkData> capture_draws(Context* context) {
+    RecorderOptions options;
+    options.fCapturePipelines = true;
+    std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+
+    SkImageInfo ii = SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    SkCanvas* canvas = surface->getCanvas();
+
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeWH(16, 16), paint);
+
+    const SkPoint pts[] = {{0, 0}, {64, 64}};
+    const SkColor colors[] = {SK_ColorBLUE, SK_ColorGREEN};
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(8, 8, 40, 40), 6, 6), paint);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    context->insertRecording({recording.get()});
+    context->submit(SyncToCpu::kYes);
+
+    return recorder->serializeCapturedPipelines();
+}
+
+}  // anonymous namespace
+
+// Pipelines captured from real draws can be recreated from their serialized form, serially and on
+// an executor.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(PipelineCaptureTest, reporter, context,
+                                         CtsEnforcement::kNextRelease) {
+    // Recorders that aren't capturing have nothing to serialize.
+    REPORTER_ASSERT(reporter, !context->makeRecorder()->serializeCapturedPipelines());
+
+    GlobalCache* globalCache = context->priv().globalCache();
+    globalCache->resetGraphicsPipelines();
+
+    sk_sp<SkData> capture = capture_draws(context);
+    REPORTER_ASSERT(reporter, capture && capture->size() > 0);
+    if (!capture) {
+        return;
+    }
+    const int drawnPipelines = globalCache->numGraphicsPipelines();
+    REPORTER_ASSERT(reporter, drawnPipelines > 0);
+
+    globalCache->resetGraphicsPipelines();
+    REPORTER_ASSERT(reporter, Precompile(context, *capture));
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() > 0);
+
+    globalCache->resetGraphicsPipelines();
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    REPORTER_ASSERT(reporter, Precompile(context, *capture, executor.get()));
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() > 0);
+
+    // Garbage is rejected rather than misinterpreted.
+    const char garbage[] = "not a pipeline capture";
+    REPORTER_ASSERT(reporter, !Precompile(context, *SkData::MakeWithoutCopy(garbage,
+                                                                            sizeof(garbage))));
+}
+
+#endif // SK_GRAPHITE
@@ -8,8 +8,13 @@
 #include "tests/Test.h"
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
 #include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
 #include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/ContextPriv.h"
@@ -489,4 +494,40 @@ DEF_CONDITIONAL_GRAPHITE_TEST_FOR_ALL_CONTEXTS(ProxyCacheTest10,
     REPORTER_ASSERT(r, regenerated);
 }
 
+// A YUVA image is only converted to a cached RGBA copy after it has been drawn a few times, and
+// later draws then reuse that copy.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(ProxyCacheYUVAConversionTest, r, context,
+                                   CtsEnforcement::kNextRelease) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    ProxyCache* proxyCache = recorder->priv().proxyCache();
+
+    SkYUVAInfo yuvaInfo({64, 64},
+                        SkYUVAInfo::PlaneConfig::kY_U_V,
+                        SkYUVAInfo::Subsampling::k420,
+                        kJPEG_Full_SkYUVColorSpace);
+    SkYUVAPixmapInfo pixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8,
+                                /*rowBytes=*/nullptr);
+    SkYUVAPixmaps pixmaps = SkYUVAPixmaps::Allocate(pixmapInfo);
+    for (int i = 0; i < pixmaps.numPlanes(); ++i) {
+        pixmaps.plane(i).erase(SK_ColorGRAY);
+    }
+    sk_sp<SkImage> image = SkImages::TextureFromYUVAPixmaps(recorder.get(), pixmaps);
+    sk_sp<SkSurface> surface =
+            SkSurfaces::RenderTarget(recorder.get(), SkImageInfo::MakeN32Premul(64, 64));
+    if (!image || !surface) {
+        ERRORF(r, "Could not make YUVA image or surface");
+        return;
+    }
+
+    const int numCached = proxyCache->numCached();
+    for (int i = 0; i < 3; ++i) {
+        surface->getCanvas()->drawImage(image, 0, 0);
+        REPORTER_ASSERT(r, proxyCache->numCached() == numCached);
+    }
+    surface->getCanvas()->drawImage(image, 0, 0);
+    REPORTER_ASSERT(r, proxyCache->numCached() == numCached + 1);
+    surface->getCanvas()->drawImage(image, 0, 0);
+    REPORTER_ASSERT(r, proxyCache->numCached() == numCached + 1);
+}
+
 }  // namespace skgpu::graphite
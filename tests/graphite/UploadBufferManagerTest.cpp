@@ -8,6 +8,7 @@
 #include "tests/Test.h"
 
 #include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/gpu/graphite/Recording.h"
 #include "src/gpu/graphite/Buffer.h"
@@ -125,4 +126,31 @@ DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(UploadBufferManagerTest, reporter, cont
                     memcmp(alBufferMap, expectedAlBufferMap1, sizeof(expectedAlBufferMap1)) == 0);
 }
 
+// Dedicated buffers for large uploads are sized in blocks, so that an upload of a similar size in a
+// later Recording can reuse the buffer once the GPU has finished reading it.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(UploadBufferManagerReuseTest, reporter, context,
+                                         CtsEnforcement::kNextRelease) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    UploadBufferManager* bufferManager = recorder->priv().uploadBufferManager();
+
+    auto [writer0, bufferInfo0] = bufferManager->getTextureUploadWriter((64 << 10) + 1, 1);
+    REPORTER_ASSERT(reporter, bufferInfo0.fBuffer);
+    if (!bufferInfo0.fBuffer) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, bufferInfo0.fBuffer->size() == (128 << 10));
+    const Buffer* firstBuffer = bufferInfo0.fBuffer;
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    context->insertRecording(insertInfo);
+    context->submit(SyncToCpu::kYes);
+    recording.reset();
+
+    auto [writer1, bufferInfo1] = bufferManager->getTextureUploadWriter((96 << 10) + 3, 1);
+    REPORTER_ASSERT(reporter, bufferInfo1.fBuffer == firstBuffer);
+    REPORTER_ASSERT(reporter, bufferInfo1.fOffset == 0);
+}
+
 }  // namespace skgpu::graphite
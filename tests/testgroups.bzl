@@ -97,6 +97,7 @@ CORE_TESTS = [
     "RRectInPathTest.cpp",
     "RTreeTest.cpp",
     "RandomTest.cpp",
+    "RasterPipelineBlitterTest.cpp",
     "ReadPixelsTest.cpp",
     "RecorderTest.cpp",
     "RecordingXfermodeTest.cpp",
@@ -135,6 +136,7 @@ CORE_TESTS = [
     "SkVxTest.cpp",
     "SkXmpTest.cpp",
     "SortTest.cpp",
+    "SparseStripTest.cpp",
     "SrcOverTest.cpp",
     "StreamTest.cpp",
     "StringTest.cpp",
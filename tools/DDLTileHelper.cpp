@@ -18,6 +18,7 @@
 #include "include/private/chromium/GrSurfaceCharacterization.h"
 #include "include/private/chromium/SkImageChromium.h"
 #include "src/base/SkRandom.h"
+#include "src/base/SkTime.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDeferredDisplayListPriv.h"
@@ -51,6 +52,8 @@ DDLTileHelper::TileData::~TileData() {}
 void DDLTileHelper::TileData::createDDL(const SkPicture* picture) {
     SkASSERT(!fDisplayList && picture);
 
+    double startMs = SkTime::GetMSecs();
+
     auto recordingChar = fPlaybackChar.createResized(fClip.width(), fClip.height());
     SkASSERT(recordingChar.isValid());
 
@@ -69,6 +72,9 @@ void DDLTileHelper::TileData::createDDL(const SkPicture* picture) {
     recordingCanvas->drawPicture(picture);
 
     fDisplayList = recorder.detach();
+
+    fRecordMs += SkTime::GetMSecs() - startMs;
+    ++fNumRecords;
 }
 
 void DDLTileHelper::createComposeDDL() {
@@ -157,6 +163,8 @@ void DDLTileHelper::TileData::drawSKPDirectly(GrDirectContext* dContext,
 void DDLTileHelper::TileData::draw(GrDirectContext* direct) {
     SkASSERT(fDisplayList && !fTileSurface);
 
+    double startMs = SkTime::GetMSecs();
+
     fTileSurface = this->makeWrappedTileDest(direct);
     if (fTileSurface) {
         skgpu::ganesh::DrawDDL(fTileSurface, fDisplayList);
@@ -164,6 +172,9 @@ void DDLTileHelper::TileData::draw(GrDirectContext* direct) {
         // We can't snap an image here bc, since we're using wrapped backend textures for the
         // surfaces, that would incur a copy.
     }
+
+    fReplayMs += SkTime::GetMSecs() - startMs;
+    ++fNumReplays;
 }
 
 void DDLTileHelper::TileData::reset() {
@@ -173,6 +184,11 @@ void DDLTileHelper::TileData::reset() {
     fTileSurface = nullptr;
 }
 
+void DDLTileHelper::TileData::resetTimes() {
+    fRecordMs = fReplayMs = 0;
+    fNumRecords = fNumReplays = 0;
+}
+
 sk_sp<SkImage> DDLTileHelper::TileData::makePromiseImageForDst(
                                                 sk_sp<GrContextThreadSafeProxy> threadSafeProxy) {
     SkASSERT(fCallbackContext);
@@ -357,6 +373,26 @@ void DDLTileHelper::resetAllTiles() {
     fComposeDDL.reset();
 }
 
+void DDLTileHelper::dumpTileTimes() const {
+    for (int i = 0; i < this->numTiles(); ++i) {
+        const TileData& tile = fTiles[i];
+        if (!tile.initialized()) {
+            continue;
+        }
+        SkIRect clip = tile.clipRect();
+        SkDebugf("tile %d (%d, %d, %dx%d): record %.3f ms, replay %.3f ms\n",
+                 tile.id(), clip.fLeft, clip.fTop, clip.width(), clip.height(),
+                 tile.numRecords() ? tile.recordMs() / tile.numRecords() : 0.0,
+                 tile.numReplays() ? tile.replayMs() / tile.numReplays() : 0.0);
+    }
+}
+
+void DDLTileHelper::resetTileTimes() {
+    for (int i = 0; i < this->numTiles(); ++i) {
+        fTiles[i].resetTimes();
+    }
+}
+
 void DDLTileHelper::createBackendTextures(SkTaskGroup* taskGroup, GrDirectContext* direct) {
 
     if (taskGroup) {
@@ -71,6 +71,15 @@ public:
 
         GrDeferredDisplayList* ddl() { return fDisplayList.get(); }
 
+        // The total time spent recording this tile's DDLs (in 'createDDL') and replaying them
+        // (in 'draw'), and how many times each was done, since the tile was created or the
+        // times were last reset.
+        double recordMs() const { return fRecordMs; }
+        double replayMs() const { return fReplayMs; }
+        int numRecords() const { return fNumRecords; }
+        int numReplays() const { return fNumReplays; }
+        void resetTimes();
+
         sk_sp<SkImage> makePromiseImageForDst(sk_sp<GrContextThreadSafeProxy>);
         void dropCallbackContext() { fCallbackContext.reset(); }
 
@@ -98,6 +107,11 @@ public:
         sk_sp<SkSurface>              fTileSurface;
 
         sk_sp<GrDeferredDisplayList>  fDisplayList;
+
+        double                        fRecordMs = 0;
+        double                        fReplayMs = 0;
+        int                           fNumRecords = 0;
+        int                           fNumReplays = 0;
     };
 
     DDLTileHelper(GrDirectContext*,
@@ -133,6 +147,11 @@ public:
 
     int numTiles() const { return fNumXDivisions * fNumYDivisions; }
 
+    // Print the average recording and replay time of each tile, to find the tiles that hold
+    // back the others when recording in parallel.
+    void dumpTileTimes() const;
+    void resetTileTimes();
+
     void createBackendTextures(SkTaskGroup*, GrDirectContext*);
     void deleteBackendTextures(SkTaskGroup*, GrDirectContext*);
 
@@ -289,6 +289,20 @@ protected:
                                                                     color,
                                                                     mode);
     }
+
+    void onDrawEdgeAARectSet(const SkRect rects[],
+                             const SkColor4f colors[],
+                             const SkMatrix preViewMatrices[],
+                             int count,
+                             SkCanvas::QuadAAFlags aaFlags,
+                             SkBlendMode mode) override {
+        fRecorder.getRecordingCanvas()->experimental_DrawEdgeAARectSet(rects,
+                                                                       colors,
+                                                                       preViewMatrices,
+                                                                       count,
+                                                                       aaFlags,
+                                                                       mode);
+    }
 #endif
 
     void onDrawAnnotation(const SkRect& rect, const char key[], SkData* value) override {
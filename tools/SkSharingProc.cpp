@@ -15,6 +15,9 @@
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkPngEncoder.h"
+#include "src/core/SkImageContentHash.h"
+
+#include <optional>
 
 namespace {
     sk_sp<SkData> collectNonTextureImagesProc(SkImage* img, void* ctx) {
@@ -46,13 +49,25 @@ sk_sp<SkData> SkSharingSerialContext::serializeImage(SkImage* img, void* ctx) {
     // find out if we have already serialized this, and if so, what its in-file id is.
     int* fid = context->fImageMap.find(id);
     if (!fid) {
-        // When not present, add its id to the map and return its usual serialized form.
-        context->fImageMap[id] = context->fImageMap.count(); // Next in-file id
         // encode the image or it's non-texture replacement if one was collected
         sk_sp<SkImage>* replacementImage = context->fNonTexMap.find(id);
         if (replacementImage) {
             img = replacementImage->get();
         }
+        // If we have already serialized a different image with the same content, refer to that.
+        std::optional<uint64_t> contentHash = SkImageContentHash::Hash(img);
+        if (contentHash) {
+            if (int* contentFid = context->fContentMap.find(*contentHash)) {
+                fid = context->fImageMap.set(id, *contentFid);
+                return SkData::MakeWithCopy(fid, sizeof(*fid));
+            }
+        }
+        // When not present, add its id to the map and return its usual serialized form.
+        int newFid = context->fSerializedImageCount++;
+        context->fImageMap[id] = newFid;
+        if (contentHash) {
+            context->fContentMap[*contentHash] = newFid;
+        }
         return SkPngEncoder::Encode(nullptr, img, {});
     }
     // if present, return only the in-file id we registered the first time we serialized it.
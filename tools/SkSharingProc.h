@@ -18,7 +18,9 @@
 
 /**
  * This serial proc serializes each image it encounters only once, using their uniqueId as the
- * property for sameness.
+ * property for sameness. Distinct images with the same content (e.g. the same file decoded twice)
+ * are also only serialized once, when their content can be hashed cheaply (see
+ * SkImageContentHash).
  *
  * It's most basic usage involves setting your imageProc to SkSharingSerialContext::serializeImage
  * and creating an SkSharingSerialContext in an appropriate scope to outlive all the images that
@@ -53,6 +55,12 @@ struct SkSharingSerialContext {
     // The keys are ids of original images, not of non-texture copies
     skia_private::THashMap<uint32_t, int> fImageMap;
 
+    // A map from the content hashes of the images serialized so far to their ids within the file
+    skia_private::THashMap<uint64_t, int> fContentMap;
+
+    // The number of images serialized so far, which is the next id within the file
+    int fSerializedImageCount = 0;
+
     // A serial proc that shares images between subpictures
     // To use this, create an instance of SkSerialProcs and populate it this way.
     // The client must retain ownership of the context.
@@ -607,6 +607,16 @@ void DebugCanvas::onDrawEdgeAAQuad(const SkRect&    rect,
     this->addDrawCommand(new DrawEdgeAAQuadCommand(rect, clip, aa, color, mode));
 }
 
+void DebugCanvas::onDrawEdgeAARectSet(const SkRect      rects[],
+                                      const SkColor4f   colors[],
+                                      const SkMatrix    preViewMatrices[],
+                                      int               count,
+                                      QuadAAFlags       aa,
+                                      SkBlendMode       mode) {
+    // Shown as the individual quads, each of which can be stepped through.
+    SkCanvasPriv::DrawEdgeAARectSetAsQuads(this, rects, colors, preViewMatrices, count, aa, mode);
+}
+
 void DebugCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry set[],
                                         int                 count,
                                         const SkPoint       dstClips[],
@@ -214,6 +214,12 @@ protected:
                           QuadAAFlags,
                           const SkColor4f&,
                           SkBlendMode) override;
+    void onDrawEdgeAARectSet(const SkRect[],
+                             const SkColor4f[],
+                             const SkMatrix[],
+                             int count,
+                             QuadAAFlags,
+                             SkBlendMode) override;
     void onDrawEdgeAAImageSet2(const ImageSetEntry[],
                                int count,
                                const SkPoint[],
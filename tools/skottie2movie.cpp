@@ -7,13 +7,16 @@
 
 #include "experimental/ffmpeg/SkVideoEncoder.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "include/private/base/SkTPin.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skresources/include/SkResources.h"
 #include "src/base/SkTime.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkOSPath.h"
 
 #include "tools/CodecUtils.h"
@@ -25,6 +28,10 @@
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "modules/skshaper/utils/FactoryHelpers.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #if defined(SK_BUILD_FOR_MAC) && defined(SK_FONTMGR_CORETEXT_AVAILABLE)
 #include "include/ports/SkFontMgr_mac_ct.h"
 #elif defined(SK_BUILD_FOR_UNIX) && defined(SK_FONTMGR_FONTCONFIG_AVAILABLE)
@@ -41,6 +48,7 @@ static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(loop, l, false, "loop mode for profiling");
 static DEFINE_int(set_dst_width, 0, "set destination width (height will be computed)");
 static DEFINE_bool2(gpu, g, false, "use GPU for rendering");
+static DEFINE_int(threads, 0, "Number of threads rasterizing frames on the CPU (0 -> cores count).");
 
 static void produce_frame(SkSurface* surf, skottie::Animation* anim, double frame) {
     anim->seekFrame(frame);
@@ -124,6 +132,14 @@ int main(int argc, char** argv) {
     sk_sp<SkSurface> surf;
     sk_sp<SkData> data;
 
+    // Without a GPU, frames are seeked and recorded on this thread, in order, and then a batch of
+    // them is rasterized in parallel, one surface per frame in the batch.
+    const int thread_count = FLAGS_threads > 0
+            ? FLAGS_threads
+            : std::max(1, (int)std::thread::hardware_concurrency());
+    std::unique_ptr<SkExecutor> executor;
+    std::vector<sk_sp<SkSurface>> cpu_surfs;
+
     const auto info = SkImageInfo::MakeN32Premul(dim);
     do {
         double loop_start = SkTime::GetSecs();
@@ -147,13 +163,57 @@ int main(int argc, char** argv) {
                     grctx = nullptr;
                 }
             }
-            if (!surf) {
-                surf = SkSurfaces::Raster(info);
+            if (surf) {
+                surf->getCanvas()->scale(scale, scale);
+            }
+        }
+        if (!surf && cpu_surfs.empty()) {
+            for (int i = 0; i < thread_count; ++i) {
+                cpu_surfs.push_back(SkSurfaces::Raster(info));
+                cpu_surfs.back()->getCanvas()->scale(scale, scale);
+            }
+            if (thread_count > 1) {
+                executor = SkExecutor::MakeFIFOThreadPool(thread_count);
+            }
+        }
+
+        for (int first = 0; !surf && first <= frames; first += thread_count) {
+            const int count = std::min(thread_count, frames + 1 - first);
+
+            // Frame pictures stay valid as the animation moves on to the next frame.
+            std::vector<sk_sp<SkPicture>> pictures(count);
+            for (int i = 0; i < count; ++i) {
+                const double frame = (first + i) * fps_scale;
+                if (FLAGS_verbose) {
+                    SkDebugf("rendering frame %g\n", frame);
+                }
+                animation->seekFrame(frame);
+                pictures[i] = animation->makeFramePicture();
+            }
+
+            auto rasterize = [&](int i) {
+                SkCanvas* canvas = cpu_surfs[i]->getCanvas();
+                canvas->clear(SK_ColorWHITE);
+                canvas->drawPicture(pictures[i]);
+            };
+            if (executor) {
+                SkTaskGroup tg(*executor);
+                tg.batch(count, rasterize);
+                tg.wait();
+            } else {
+                for (int i = 0; i < count; ++i) {
+                    rasterize(i);
+                }
+            }
+
+            for (int i = 0; i < count; ++i) {
+                SkPixmap pm;
+                SkAssertResult(cpu_surfs[i]->peekPixels(&pm));
+                encoder.addFrame(pm);
             }
-            surf->getCanvas()->scale(scale, scale);
         }
 
-        for (int i = 0; i <= frames; ++i) {
+        for (int i = 0; surf && i <= frames; ++i) {
             const double frame = i * fps_scale;
             if (FLAGS_verbose) {
                 SkDebugf("rendering frame %g\n", frame);
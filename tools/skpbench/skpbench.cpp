@@ -7,6 +7,7 @@
 
 #include "bench/BigPath.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkDocument.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
@@ -20,6 +21,7 @@
 #include "include/private/chromium/GrDeferredDisplayList.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkTaskGroup.h"
+#include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/SkGr.h"
@@ -36,6 +38,7 @@
 #include "tools/gpu/FlushFinishTracker.h"
 #include "tools/gpu/GpuTimer.h"
 #include "tools/gpu/GrContextFactory.h"
+#include "tools/trace/EventTracingPriv.h"
 
 #if defined(SK_ENABLE_SVG)
 #include "modules/skshaper/utils/FactoryHelpers.h"
@@ -84,6 +87,13 @@ static DEFINE_int(verbosity, 4, "level of verbosity (0=none to 5=debug)");
 static DEFINE_bool(suppressHeader, false, "don't print a header row before the results");
 static DEFINE_double(scale, 1, "Scale the size of the canvas and the zoom level by this factor.");
 static DEFINE_bool(dumpSamples, false, "print the individual samples to stdout");
+static DEFINE_bool(frameStats, false,
+                   "print per-frame percentiles (p50/p90/p99/max) and the cpu/sync split to stdout");
+static DEFINE_double(longFrameMs, 0,
+                     "if > 0, save frames slower than this many ms to --longFrameDir as .mskp files, "
+                     "and replay each one in its own trace section (see --trace)");
+static DEFINE_string(longFrameDir, "long_frames", "directory to save long frames in");
+static DEFINE_int(maxLongFrames, 10, "maximum number of long frames to save");
 
 static const char header[] =
 "   accum    median       max       min   stddev  samples  sample_ms  clock  metric  config    bench";
@@ -106,6 +116,54 @@ struct Sample {
     duration   fDuration;
 };
 
+// Per-frame timings, recorded while benchmarking with --frameStats or --longFrameMs. A frame is one
+// draw of an SKP (or of one MSKP page), with its flush and submit. 'sync' is the part of it spent
+// blocked on the GPU finishing earlier frames (see GpuSync), and the rest is CPU time, so a frame
+// that is bound by the GPU shows up as a long sync.
+class FrameLog {
+public:
+    explicit FrameLog(SkString name) : fName(std::move(name)) {}
+
+    void record(const SkPicture* frame, Sample::duration total, Sample::duration sync) {
+        fFrames.push_back({total, sync});
+        if (FLAGS_longFrameMs > 0 && ms(total) > FLAGS_longFrameMs) {
+            ++fLongFrameCount;
+            if ((int)fLongFrames.size() < FLAGS_maxLongFrames) {
+                fLongFrames.push_back({sk_ref_sp(frame), (int)fFrames.size() - 1, ms(total)});
+            }
+        }
+    }
+
+    void print() const;
+
+    // Saves each long frame to --longFrameDir as a one page MSKP, and draws it once more in a
+    // trace section of its own. This happens after benchmarking so that it isn't timed.
+    void saveLongFrames(GrDirectContext*, SkSurface*) const;
+
+private:
+    static double ms(Sample::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    struct Frame {
+        Sample::duration fTotal;
+        Sample::duration fSync;
+    };
+    struct LongFrame {
+        sk_sp<SkPicture> fPicture;
+        int fIndex;
+        double fMs;
+    };
+
+    const SkString fName;
+    std::vector<Frame> fFrames;
+    std::vector<LongFrame> fLongFrames;
+    int fLongFrameCount = 0;
+};
+
+// Set while the timed frames of run_benchmark() are drawn.
+static FrameLog* gFrameLog = nullptr;
+
 class GpuSync {
 public:
     GpuSync() {}
@@ -131,6 +189,7 @@ enum class ExitErr {
 };
 
 static void flush_with_sync(GrDirectContext*, GpuSync&);
+static void flush_and_submit(GrDirectContext*, GpuSync&);
 static void draw_skp_and_flush_with_sync(GrDirectContext*, SkSurface*, const SkPicture*, GpuSync&);
 static sk_sp<SkPicture> create_warmup_skp();
 static sk_sp<SkPicture> create_skp_from_svg(SkStream*, const char* filename);
@@ -303,6 +362,8 @@ static void run_ddl_benchmark(sk_gpu_test::TestContext* testContext,
     GpuSync gpuSync;
     ddl_sample(dContext, &tiles, gpuSync, nullptr, recordingTaskGroup.get(),
                gpuTaskGroup.get(), &startStopTime, newSKP.get());
+    // Don't count the warmup sample in the per-tile times.
+    tiles.resetTileTimes();
 
     clock::duration cumulativeDuration = std::chrono::milliseconds(0);
 
@@ -328,6 +389,10 @@ static void run_ddl_benchmark(sk_gpu_test::TestContext* testContext,
         testContext->makeCurrent();
     }
 
+    if (FLAGS_verbosity >= 5) {
+        tiles.dumpTileTimes();
+    }
+
     if (!FLAGS_png.isEmpty()) {
         // The user wants to see the final result
         skgpu::ganesh::DrawDDL(dstSurface, tiles.composeDDL());
@@ -349,7 +414,8 @@ static void run_ddl_benchmark(sk_gpu_test::TestContext* testContext,
 static void run_benchmark(GrDirectContext* context,
                           sk_sp<SkSurface> surface,
                           SkpProducer* skpp,
-                          std::vector<Sample>* samples) {
+                          std::vector<Sample>* samples,
+                          FrameLog* frameLog) {
     using clock = std::chrono::high_resolution_clock;
     const Sample::duration sampleDuration = std::chrono::milliseconds(FLAGS_sampleMs);
     const clock::duration benchDuration = std::chrono::milliseconds(FLAGS_duration);
@@ -360,6 +426,7 @@ static void run_benchmark(GrDirectContext* context,
         i += skpp->drawAndFlushAndSync(context, surface.get(), gpuSync);
     } while(i < kNumFlushesToPrimeCache);
 
+    gFrameLog = frameLog;
     clock::time_point now = clock::now();
     const clock::time_point endTime = now + benchDuration;
 
@@ -374,6 +441,7 @@ static void run_benchmark(GrDirectContext* context,
             sample.fDuration = now - sampleStart;
         } while (sample.fDuration < sampleDuration);
     } while (now < endTime || 0 == samples->size() % 2);
+    gFrameLog = nullptr;
 
     // Make sure the gpu has finished all its work before we exit this function and delete the
     // fence.
@@ -491,11 +559,95 @@ void print_result(const std::vector<Sample>& samples, const char* config, const
     fflush(stdout);
 }
 
+void FrameLog::print() const {
+    if (fFrames.empty()) {
+        return;
+    }
+    std::vector<double> total, cpu, sync;
+    for (const Frame& frame : fFrames) {
+        total.push_back(ms(frame.fTotal));
+        cpu.push_back(ms(frame.fTotal - frame.fSync));
+        sync.push_back(ms(frame.fSync));
+    }
+    std::sort(total.begin(), total.end());
+    std::sort(cpu.begin(), cpu.end());
+    std::sort(sync.begin(), sync.end());
+    // Nearest-rank percentiles.
+    auto percentile = [](const std::vector<double>& values, double p) {
+        size_t rank = (size_t)std::ceil(p * values.size());
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+    };
+
+    printf("Frames: %zu  p50 %.4g  p90 %.4g  p99 %.4g  max %.4g ms  "
+           "cpu p50 %.4g  p99 %.4g ms  sync p50 %.4g  p99 %.4g ms",
+           total.size(), percentile(total, .5), percentile(total, .9), percentile(total, .99),
+           total.back(), percentile(cpu, .5), percentile(cpu, .99), percentile(sync, .5),
+           percentile(sync, .99));
+    if (FLAGS_longFrameMs > 0) {
+        printf("  long (> %g ms) %i", FLAGS_longFrameMs, fLongFrameCount);
+    }
+    printf("  %s\n", fName.c_str());
+    fflush(stdout);
+}
+
+void FrameLog::saveLongFrames(GrDirectContext* context, SkSurface* surface) const {
+    if (fLongFrames.empty()) {
+        return;
+    }
+    SkString dir(FLAGS_longFrameDir[0]);
+    if (!mkdir_p(dir)) {
+        exitf(ExitErr::kIO, "failed to create directory for long frames \"%s\"", dir.c_str());
+    }
+
+    GpuSync gpuSync;
+    for (const LongFrame& frame : fLongFrames) {
+        SkString name = SkStringPrintf("%s_frame%i", fName.c_str(), frame.fIndex);
+        SkString path = SkOSPath::Join(dir.c_str(), SkStringPrintf("%s.mskp", name.c_str()).c_str());
+        {
+            SkFILEWStream stream(path.c_str());
+            if (!stream.isValid()) {
+                exitf(ExitErr::kIO, "failed to open \"%s\" for writing", path.c_str());
+            }
+            SkSharingSerialContext sharingCtx;
+            SkSerialProcs procs;
+            procs.fImageProc = SkSharingSerialContext::serializeImage;
+            procs.fImageCtx = &sharingCtx;
+            sk_sp<SkDocument> doc = SkMultiPictureDocument::Make(
+                    &stream, &procs, [&sharingCtx](const SkPicture* pic) {
+                        SkSharingSerialContext::collectNonTextureImagesFromPicture(pic,
+                                                                                   &sharingCtx);
+                    });
+            const SkRect& cull = frame.fPicture->cullRect();
+            SkCanvas* page = doc->beginPage(cull.width(), cull.height());
+            page->translate(-cull.x(), -cull.y());
+            page->drawPicture(frame.fPicture);
+            doc->close();
+        }
+
+        // With --trace perfetto, this gives the frame a trace file of its own. The replay may not
+        // be as slow as the original frame if that was caused by something that has since warmed
+        // up, but the saved .mskp reproduces it in other tools.
+        TRACE_EVENT_API_NEW_TRACE_SECTION(TRACE_STR_COPY(name.c_str()));
+        {
+            TRACE_EVENT0("skia", "LongFrameReplay");
+            draw_skp_and_flush_with_sync(context, surface, frame.fPicture.get(), gpuSync);
+            context->submit(GrSyncCpu::kYes);
+        }
+
+        if (FLAGS_verbosity >= 3) {
+            fprintf(stderr, "saved %.3f ms frame %i to %s\n", frame.fMs, frame.fIndex,
+                    path.c_str());
+        }
+    }
+    TRACE_EVENT_API_NEW_TRACE_SECTION("skpbench");
+}
+
 int main(int argc, char** argv) {
     CommandLineFlags::SetUsage(
             "Use skpbench.py instead. "
             "You usually don't want to use this program directly.");
     CommandLineFlags::Parse(argc, argv);
+    initializeEventTracingForTools();
 
     if (!FLAGS_suppressHeader) {
         printf("%s\n", header);
@@ -628,14 +780,21 @@ int main(int argc, char** argv) {
     if (FLAGS_scale != 1) {
         canvas->scale(FLAGS_scale, FLAGS_scale);
     }
+    std::unique_ptr<FrameLog> frameLog;
+    if (FLAGS_frameStats || FLAGS_longFrameMs > 0) {
+        if (FLAGS_gpuClock || FLAGS_ddl) {
+            exitf(ExitErr::kUsage, "--frameStats and --longFrameMs need the cpu clock and no DDLs");
+        }
+        frameLog = std::make_unique<FrameLog>(srcname);
+    }
     if (!FLAGS_gpuClock) {
         if (FLAGS_ddl) {
             run_ddl_benchmark(testCtx, ctx, surface, skp.get(), &samples);
         } else if (!mskp) {
             auto s = std::make_unique<StaticSkp>(skp);
-            run_benchmark(ctx, surface, s.get(), &samples);
+            run_benchmark(ctx, surface, s.get(), &samples, frameLog.get());
         } else {
-            run_benchmark(ctx, surface, mskp.get(), &samples);
+            run_benchmark(ctx, surface, mskp.get(), &samples, frameLog.get());
         }
     } else {
         if (FLAGS_ddl) {
@@ -647,6 +806,12 @@ int main(int argc, char** argv) {
         run_gpu_time_benchmark(testCtx->gpuTimer(), ctx, surface, skp.get(), &samples);
     }
     print_result(samples, config->getTag().c_str(), srcname.c_str());
+    if (frameLog) {
+        if (FLAGS_frameStats) {
+            frameLog->print();
+        }
+        frameLog->saveLongFrames(ctx, surface.get());
+    }
 
     // Save a proof (if one was requested).
     if (!FLAGS_png.isEmpty()) {
@@ -668,7 +833,10 @@ int main(int argc, char** argv) {
 
 static void flush_with_sync(GrDirectContext* context, GpuSync& gpuSync) {
     gpuSync.waitIfNeeded();
+    flush_and_submit(context, gpuSync);
+}
 
+static void flush_and_submit(GrDirectContext* context, GpuSync& gpuSync) {
     GrFlushInfo flushInfo;
     flushInfo.fFinishedProc = sk_gpu_test::FlushFinishTracker::FlushFinished;
     flushInfo.fFinishedContext = gpuSync.newFlushTracker(context);
@@ -680,9 +848,20 @@ static void flush_with_sync(GrDirectContext* context, GpuSync& gpuSync) {
 static void draw_skp_and_flush_with_sync(GrDirectContext* context, SkSurface* surface,
                                          const SkPicture* skp, GpuSync& gpuSync) {
     auto canvas = surface->getCanvas();
-    canvas->drawPicture(skp);
+    if (!gFrameLog) {
+        canvas->drawPicture(skp);
+        flush_with_sync(context, gpuSync);
+        return;
+    }
 
-    flush_with_sync(context, gpuSync);
+    using clock = std::chrono::high_resolution_clock;
+    clock::time_point start = clock::now();
+    canvas->drawPicture(skp);
+    clock::time_point syncStart = clock::now();
+    gpuSync.waitIfNeeded();
+    clock::time_point syncEnd = clock::now();
+    flush_and_submit(context, gpuSync);
+    gFrameLog->record(skp, clock::now() - start, syncEnd - syncStart);
 }
 
 static sk_sp<SkPicture> create_warmup_skp() {
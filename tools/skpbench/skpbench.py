@@ -56,6 +56,14 @@ __argparse.add_argument('--gpu',
   help="perform timing on the gpu clock instead of cpu (gpu work only)")
 __argparse.add_argument('--fps',
   action='store_true', help="use fps instead of ms")
+__argparse.add_argument('--frame-stats',
+  action='store_true',
+  help="print per-frame percentiles (p50/p90/p99/max) and the cpu/sync split")
+__argparse.add_argument('--long-frame-ms',
+  type=float,
+  help="save frames slower than this many ms as .mskp files in --long-frame-dir")
+__argparse.add_argument('--long-frame-dir',
+  help="directory to save long frames in")
 __argparse.add_argument('--pr',
   help="comma- or space-separated list of GPU path renderers, including: "
        "[[~]all [~]default [~]dashline [~]msaa [~]aaconvex "
@@ -145,6 +153,12 @@ class SKPBench:
     ARGV.extend(['--gpuClock', 'true'])
   if FLAGS.fps:
     ARGV.extend(['--fps', 'true'])
+  if FLAGS.frame_stats:
+    ARGV.extend(['--frameStats', 'true'])
+  if FLAGS.long_frame_ms:
+    ARGV.extend(['--longFrameMs', str(FLAGS.long_frame_ms)])
+  if FLAGS.long_frame_dir:
+    ARGV.extend(['--longFrameDir', FLAGS.long_frame_dir])
   if FLAGS.pr:
     ARGV.extend(['--pr'] + re.split(r'[ ,]', FLAGS.pr))
   if FLAGS.cc:
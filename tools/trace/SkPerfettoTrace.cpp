@@ -141,6 +141,9 @@ SkEventTracer::Handle SkPerfettoTrace::addTraceEvent(char phase,
         }
     } else if (TRACE_EVENT_PHASE_END == phase) {
         TRACE_EVENT_END(category);
+    } else if (TRACE_EVENT_PHASE_COUNTER == phase) {
+        this->triggerCounterEvent(categoryEnabledFlag, name, numArgs, argNames, argTypes,
+                                  argValues);
     }
 
     if (TRACE_EVENT_PHASE_INSTANT == phase) {
@@ -224,6 +227,36 @@ void SkPerfettoTrace::triggerTraceEvent(const uint8_t* categoryEnabledFlag, cons
     }
 }
 
+void SkPerfettoTrace::triggerCounterEvent(const uint8_t* categoryEnabledFlag,
+                                          const char* eventName, int numArgs,
+                                          const char** argNames, const uint8_t* argTypes,
+                                          const uint64_t* argValues) {
+    perfetto::DynamicCategory category{ this->getCategoryGroupName(categoryEnabledFlag) };
+    for (int i = 0; i < numArgs; ++i) {
+        // Multi-part counters get one track per part, like the Android framework shim does.
+        std::string trackName = eventName;
+        if (numArgs > 1) {
+            trackName = trackName + "-" + argNames[i];
+        }
+        auto track = perfetto::CounterTrack(perfetto::DynamicString{trackName.c_str()});
+        switch (argTypes[i]) {
+            case TRACE_VALUE_TYPE_BOOL:
+            case TRACE_VALUE_TYPE_UINT:
+                TRACE_COUNTER(category, track, static_cast<int64_t>(argValues[i]));
+                break;
+            case TRACE_VALUE_TYPE_INT:
+                TRACE_COUNTER(category, track, sk_bit_cast<int64_t>(argValues[i]));
+                break;
+            case TRACE_VALUE_TYPE_DOUBLE:
+                TRACE_COUNTER(category, track, sk_bit_cast<double>(argValues[i]));
+                break;
+            default:
+                // Counters only have numeric values.
+                break;
+        }
+    }
+}
+
 namespace {
 /* Define a template to help handle all the possible TRACE_EVENT_BEGIN macro call
  * combinations with 2 arguments of all the types supported by SetTraceValue.
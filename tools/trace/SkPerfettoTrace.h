@@ -71,6 +71,14 @@ private:
     void triggerTraceEvent(const uint8_t* categoryEnabledFlag, const char* eventName,
                            const char* arg1Name, const uint8_t& arg1Type, const uint64_t& arg1Val,
                            const char* arg2Name, const uint8_t& arg2Type, const uint64_t& arg2Val);
+
+    /** Records the value of each argument of a counter event on its own Perfetto counter track,
+     * named after the event (and the argument, when there are several), so that counters like
+     * cache sizes show up as graphs in the Perfetto UI.
+     */
+    void triggerCounterEvent(const uint8_t* categoryEnabledFlag, const char* eventName,
+                             int numArgs, const char** argNames, const uint8_t* argTypes,
+                             const uint64_t* argValues);
 };
 
 #endif
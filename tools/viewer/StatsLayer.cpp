@@ -24,10 +24,14 @@
 #include "tools/fonts/FontToolUtils.h"
 
 #include <algorithm>
+#include <cmath>
 #include <string>
+#include <vector>
 
 StatsLayer::StatsLayer()
-    : fCurrentMeasurement(-1)
+    : fHistorySize(0)
+    , fHistoryNext(0)
+    , fCurrentMeasurement(-1)
     , fLastTotalBegin(0)
     , fCumulativeMeasurementTime(0)
     , fCumulativeMeasurementCount(0)
@@ -40,6 +44,8 @@ void StatsLayer::resetMeasurements() {
         memset(fTimers[i].fTimes, 0, sizeof(fTimers[i].fTimes));
     }
     memset(fTotalTimes, 0, sizeof(fTotalTimes));
+    fHistorySize = 0;
+    fHistoryNext = 0;
     fCurrentMeasurement = -1;
     fLastTotalBegin = 0;
     fCumulativeMeasurementTime = 0;
@@ -73,6 +79,10 @@ void StatsLayer::onPrePaint() {
         fTotalTimes[fCurrentMeasurement] = SkTime::GetMSecs() - fLastTotalBegin;
         fCumulativeMeasurementTime += fTotalTimes[fCurrentMeasurement];
         fCumulativeMeasurementCount++;
+
+        fHistory[fHistoryNext] = fTotalTimes[fCurrentMeasurement];
+        fHistoryNext = (fHistoryNext + 1) % kHistoryCount;
+        fHistorySize = std::min(fHistorySize + 1, kHistoryCount);
     }
     fCurrentMeasurement = (fCurrentMeasurement + 1) & (kMeasurementCount - 1);
     SkASSERT(fCurrentMeasurement >= 0 && fCurrentMeasurement < kMeasurementCount);
@@ -96,7 +106,7 @@ void StatsLayer::onPaint(SkSurface* surface) {
     static const float kPixelPerMS = 2.0f;
     static const int kDisplayWidth = 192;
     static const int kGraphHeight = 100;
-    static const int kTextHeight = 60;
+    static const int kTextHeight = 74;
     static const int kDisplayHeight = kGraphHeight + kTextHeight;
     static const int kDisplayPadding = 10;
     static const int kGraphPadding = 3;
@@ -178,11 +188,25 @@ void StatsLayer::onPaint(SkSurface* surface) {
     canvas->drawString(SkStringPrintf("%4.3f ms -> %4.3f ms", time, measure),
                        rect.fLeft + 3, rect.fTop + 14, font, paint);
 
+    if (fHistorySize > 0) {
+        std::vector<double> history(fHistory, fHistory + fHistorySize);
+        std::sort(history.begin(), history.end());
+        // Nearest-rank percentiles.
+        auto percentile = [&history](double p) {
+            int rank = (int)std::ceil(p * history.size());
+            return history[std::clamp(rank, 1, (int)history.size()) - 1];
+        };
+        canvas->drawString(SkStringPrintf("p50 %.1f p90 %.1f p99 %.1f max %.1f",
+                                          percentile(.5), percentile(.9), percentile(.99),
+                                          history.back()),
+                           rect.fLeft + 3, rect.fTop + 28, font, paint);
+    }
+
     for (int timer = 0; timer < fTimers.size(); ++timer) {
         paint.setColor(fTimers[timer].fLabelColor);
         canvas->drawString(SkStringPrintf("%s: %4.3f ms", fTimers[timer].fLabel.c_str(),
                                           sumTimes[timer] / std::max(1, count)),
-                           rect.fLeft + 3, rect.fTop + 28 + (14 * timer), font, paint);
+                           rect.fLeft + 3, rect.fTop + 42 + (14 * timer), font, paint);
     }
 
     canvas->restore();
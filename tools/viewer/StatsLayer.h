@@ -41,6 +41,12 @@ private:
     };
     skia_private::TArray<TimerData> fTimers;
     double fTotalTimes[kMeasurementCount];
+    // A longer history of frame times than the graph shows, for the percentiles. Tail latency is
+    // hidden by the averages.
+    static const int kHistoryCount = 1024;
+    double fHistory[kHistoryCount];
+    int fHistorySize;
+    int fHistoryNext;
     int fCurrentMeasurement;
     double fLastTotalBegin;
     double fCumulativeMeasurementTime;